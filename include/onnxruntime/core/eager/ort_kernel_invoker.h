@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "core/common/common.h"
@@ -43,11 +46,26 @@ class ORTInvoker {
                         const int version = -1);
 
  private:
+  struct CachedKernel;
+
+  // Finds the kernel created for the op with the same attributes and input types, or creates and caches it.
+  common::Status GetOrCreateKernel(const std::string& op_name,
+                                   const std::vector<OrtValue>& inputs,
+                                   size_t output_count,
+                                   const NodeAttributes* attributes,
+                                   const std::string& domain,
+                                   int version,
+                                   std::shared_ptr<const CachedKernel>& cached_kernel);
+
   std::shared_ptr<IExecutionProvider> execution_provider_;
   const logging::Logger& logger_;
   // custom ops for current execution provider
   // we need the op schema to resolve the output type during invoke
   const IOnnxRuntimeOpSchemaRegistryList& custom_op_registries_;
+
+  // the graph is resolved and the kernel is created once per op, attributes and input types
+  std::mutex kernel_cache_mutex_;
+  std::unordered_map<std::string, std::shared_ptr<const CachedKernel>> kernel_cache_;
 };
 
 #ifdef __GNUC__
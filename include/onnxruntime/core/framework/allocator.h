@@ -20,7 +20,12 @@ struct OrtArenaCfg {
                   initial_chunk_size_bytes(-1),
                   max_dead_bytes_per_chunk(-1),
                   initial_growth_chunk_size_bytes(-1),
-                  max_power_of_two_extend_bytes(-1) {}
+                  max_power_of_two_extend_bytes(-1),
+                  slab_max_alloc_bytes(-1),
+                  slab_region_bytes(-1),
+                  slab_thread_cache_blocks(-1),
+                  huge_page_bytes(-1),
+                  numa_node(-1) {}
   OrtArenaCfg(size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes,
               int max_dead_bytes_per_chunk, int initial_growth_chunk_size_bytes,
               int64_t max_power_of_two_extend_bytes)
@@ -29,7 +34,12 @@ struct OrtArenaCfg {
         initial_chunk_size_bytes(initial_chunk_size_bytes),
         max_dead_bytes_per_chunk(max_dead_bytes_per_chunk),
         initial_growth_chunk_size_bytes(initial_growth_chunk_size_bytes),
-        max_power_of_two_extend_bytes(max_power_of_two_extend_bytes) {}
+        max_power_of_two_extend_bytes(max_power_of_two_extend_bytes),
+        slab_max_alloc_bytes(-1),
+        slab_region_bytes(-1),
+        slab_thread_cache_blocks(-1),
+        huge_page_bytes(-1),
+        numa_node(-1) {}
 
   size_t max_mem;                         // use 0 to allow ORT to choose the default
   int arena_extend_strategy;              // use -1 to allow ORT to choose the default, 0 = kNextPowerOfTwo, 1 = kSameAsRequested
@@ -37,6 +47,11 @@ struct OrtArenaCfg {
   int max_dead_bytes_per_chunk;           // use -1 to allow ORT to choose the default
   int initial_growth_chunk_size_bytes;    // use -1 to allow ORT to choose the default
   int64_t max_power_of_two_extend_bytes;  // use -1 to allow ORT to choose the default
+  int slab_max_alloc_bytes;               // use -1 or 0 to disable the small allocation slab cache
+  int64_t slab_region_bytes;              // use -1 to allow ORT to choose the default
+  int slab_thread_cache_blocks;           // use -1 or 0 to disable per-thread slab cache magazines
+  int64_t huge_page_bytes;                // CPU only. use -1 or 0 for regular pages, 2MB or 1GB to back regions with huge pages
+  int numa_node;                          // CPU only, requires huge_page_bytes. use -1 to not bind regions to a NUMA node
 };
 
 namespace onnxruntime {
@@ -94,6 +109,14 @@ class IAllocator {
   // Each implementation of IAllocator can override and provide their own implementation
   virtual void GetStats(AllocatorStats* /*stats*/) { return; }
 
+  // An allocator that orders its memory on a stream, e.g. a CUDA allocator on a cudaMallocAsync pool, returns true
+  // and allocates the memory used on `stream` in StreamOrderedAlloc(). The memory is freed with Free().
+  // DetachStream() is called once the work of a run on `stream` is synchronized, as the stream may be destroyed
+  // before the memory allocated on it is freed.
+  virtual bool IsStreamOrdered() const { return false; }
+  virtual void* StreamOrderedAlloc(size_t size, Stream* /*stream*/) { return Alloc(size); }
+  virtual void DetachStream(Stream* /*stream*/) {}
+
   static bool CalcMemSizeForArray(size_t nmemb, size_t size, size_t* out) noexcept {
     return CalcMemSizeForArrayWithAlignment(nmemb, size, 0, out);
   }
@@ -203,6 +203,15 @@ class IExecutionProvider {
    */
   virtual bool IsGraphCaptureEnabled() const { return false; }
 
+  /**
+     Select the graph that the following OnRunStart, OnRunEnd, IsGraphCaptured
+     and ReplayGraph calls of the current thread refer to. An execution provider
+     that keeps several captured graphs, such as the CUDA execution provider,
+     captures and replays one graph per key. A key of -1 disables the capture and
+     replay for the run.
+   */
+  virtual void SetGraphCaptureKey(int64_t /*graph_key*/) {}
+
   /**
      Indicate whether the graph has been captured and instantiated. Currently
      only CUDA execution provider supports it.
@@ -215,6 +224,40 @@ class IExecutionProvider {
    */
   virtual common::Status ReplayGraph() { return Status::OK(); }
 
+  /**
+     Begin capturing the work that the current thread issues to the device for the
+     kernels of this execution provider as the graph segment with the given key,
+     for a model that can't be captured as a whole. Returns false if the segment
+     can't be captured now, in which case its kernels run as usual. Currently only
+     CUDA execution provider supports it.
+   */
+  virtual bool BeginGraphSegmentCapture(int64_t /*segment_key*/) { return false; }
+
+  /**
+     End the capture started by BeginGraphSegmentCapture and instantiate the graph
+     segment. The captured work hasn't run, ReplayGraphSegment runs it.
+   */
+  virtual common::Status EndGraphSegmentCapture(int64_t /*segment_key*/) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Graph segments are not supported by ", type_);
+  }
+
+  /**
+     Run a captured graph segment. Unlike ReplayGraph, it doesn't wait for the work
+     to complete, so the kernels launched after it are ordered with it as usual.
+   */
+  virtual common::Status ReplayGraphSegment(int64_t /*segment_key*/) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Graph segments are not supported by ", type_);
+  }
+
+  /**
+     Return the bytes of device memory the initializers of this execution provider
+     may occupy. The initializers beyond it stay in host memory and are copied to
+     the device ahead of the nodes that read them in each run, see WeightStreamer.
+     0 keeps all the initializers on the device. Currently only CUDA execution
+     provider supports it.
+   */
+  virtual size_t GetWeightStreamingBudget() const { return 0; }
+
   /**
      Called when session creation is complete
      This provides an opportunity for execution providers to optionally synchronize and
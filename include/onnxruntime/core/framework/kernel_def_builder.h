@@ -86,6 +86,7 @@ class KernelDef {
 #ifdef ENABLE_STRIDED_TENSORS
   const std::vector<int>& MayStridedInput() const { return may_strided_inputs_; }
   const std::vector<std::pair<int, int>>& MayStridedOutput() const { return may_strided_output_map_; }
+  const std::optional<int>& VariadicMayStridedOutput() const { return variadic_may_strided_output_; }
 #endif
 
   OrtMemType OutputMemoryType(size_t output_index) const {
@@ -147,6 +148,9 @@ class KernelDef {
 
   // An element <i, j> means j-th output can be a strided tensor, which share the data from i-th input.
   std::vector<std::pair<int, int>> may_strided_output_map_;
+
+  // The input that every output can share the data from as a strided tensor, for kernels with variadic outputs.
+  std::optional<int> variadic_may_strided_output_;
 #endif
 
   // The memory types of inputs/outputs of this kernel
@@ -270,6 +274,12 @@ class KernelDefBuilder {
      from input_index-th input.
    */
   KernelDefBuilder& MayStridedOutput(int input_index, int output_index);
+
+  /**
+     Specify that every output can be strided tensor, and share the data from input_index-th input.
+     This is effectively applying MayStridedOutput(input_index, i) for i >= 0
+   */
+  KernelDefBuilder& VariadicMayStridedOutput(int input_index);
 #endif
 
   /**
@@ -103,10 +103,12 @@ class KernelRegistry {
   // type value for each type constraint is provided in type_constraints.
   //
   // Either kernel_type_str_resolver or type_constraints is provided and not both.
+  //
+  // The reason of a mismatch is formatted to error_str if it is not nullptr.
   static bool VerifyKernelDef(const Node& node, const KernelDef& kernel_def,
                               const IKernelTypeStrResolver* kernel_type_str_resolver,
                               const TypeConstraintMap* type_constraints,
-                              std::string& error_str);
+                              std::string* error_str);
 
   static std::string GetMapKey(std::string_view op_name, std::string_view domain, std::string_view provider) {
     std::string key(op_name);
@@ -129,6 +129,22 @@ class OpKernel {
     return Status::OK();
   }
 
+  // Override this function to use pre-packed weights that were persisted to a file by an earlier session
+  // instead of calling PrePack(). The kernel must set up the same state that PrePack() sets up for the tensor,
+  // and use the buffers like in UseSharedPrePackedBuffers(). The buffers are read only.
+  // @param tensor: The constant initialized tensor that the buffers were packed from
+  // @param prepacked_buffers: The buffers PrePack() returned in its PrePackedWeights for the tensor, in the same order
+  // @param input_idx: The input index of the tensor in this kernel
+  // @param used_persisted_buffers: Boolean flag set by the kernel implementation indicating
+  // that the provided weight has been used by the kernel. If not set, PrePack() is called instead.
+  virtual Status UsePersistedPrePackedBuffers(const Tensor& /*tensor*/,
+                                              std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                              int /*input_idx*/,
+                                              /*out*/ bool& used_persisted_buffers) {
+    used_persisted_buffers = false;
+    return Status::OK();
+  }
+
   const OrtDevice GetDevice(OrtMemType mem_type) const;
   const OpKernelInfo& Info() const {
     return *op_kernel_info_;
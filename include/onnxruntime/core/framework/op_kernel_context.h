@@ -107,6 +107,21 @@ class OpKernelContext {
   // false.
   virtual bool TryGetInferredOutputShape(int index, TensorShape& shape) const;
 
+  /**
+  Returns whether the input at `index` is dead once this kernel has run: the execution plan releases its buffer
+  after the kernel and nothing else reads it, so the kernel may overwrite it.
+  */
+  virtual bool IsInputDeadAfterKernel(int index) const;
+
+  /**
+  Fetch the output tensor at `output_index` with the given shape, writing it into the buffer of the input at
+  `input_index` if that input is dead after this kernel and has the same shape, type and location.
+  Otherwise the output is allocated as with Output(output_index, shape).
+  @remarks Only use this if the kernel computes correct results with the output aliasing the input,
+           e.g. element-wise kernels that read each input element before writing the output element.
+  */
+  Tensor* OutputMayReuseInput(int output_index, int input_index, const TensorShape& shape);
+
   const logging::Logger& Logger() const {
     return *logger_;
   }
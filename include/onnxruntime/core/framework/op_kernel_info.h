@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "core/framework/config_options.h"
 #include "core/framework/execution_provider.h"
 #include "core/framework/kernel_def_builder.h"
 #include "core/framework/ort_value.h"
@@ -28,7 +29,8 @@ class OpKernelInfo : public OpNodeProtoHelper<ProtoHelperNodeContext> {
                         const std::unordered_map<int, OrtValue>& constant_initialized_tensors,
                         const OrtValueNameIdxMap& mlvalue_name_idx_map,
                         const DataTransferManager& data_transfer_mgr,
-                        const AllocatorMap& allocators = {});
+                        const AllocatorMap& allocators = {},
+                        const ConfigOptions& config_options = EmptyConfigOptions());
 
   OpKernelInfo(const OpKernelInfo& other);
 
@@ -50,6 +52,12 @@ class OpKernelInfo : public OpNodeProtoHelper<ProtoHelperNodeContext> {
 
   const AllocatorMap& GetAllocators() const { return allocators_; }
 
+  // The session config entries, for kernels whose implementation can be selected by them.
+  // Empty for kernels created outside of a session state, e.g. for constant folding.
+  const ConfigOptions& GetConfigOptions() const noexcept { return config_options_; }
+
+  static const ConfigOptions& EmptyConfigOptions();
+
  private:
   ORT_DISALLOW_MOVE(OpKernelInfo);
   ORT_DISALLOW_ASSIGNMENT(OpKernelInfo);
@@ -64,6 +72,7 @@ class OpKernelInfo : public OpNodeProtoHelper<ProtoHelperNodeContext> {
   const DataTransferManager& data_transfer_mgr_;
   ProtoHelperNodeContext proto_helper_context_;
   const AllocatorMap& allocators_;
+  const ConfigOptions& config_options_;
 };
 
 }  // namespace onnxruntime
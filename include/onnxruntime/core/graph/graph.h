@@ -399,7 +399,12 @@ class Node {
   bool ClearAttribute(const std::string& attr_name);
 
   /** Gets the Node's mutable attributes. */
-  NodeAttributes& GetMutableAttributes() noexcept { return attributes_; }
+  NodeAttributes& GetMutableAttributes() noexcept {
+#if !defined(ORT_MINIMAL_BUILD)
+    inferred_def_versions_.clear();
+#endif
+    return attributes_;
+  }
 
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
@@ -659,6 +664,12 @@ class Node {
   // Graph instances for subgraphs that are owned by this Node
   std::vector<std::unique_ptr<Graph>> subgraphs_;
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // The schema and the versions of the input and output defs the Node was last type and shape inferred with, so that
+  // Graph::Resolve skips the inferencing of the nodes nothing changed for. Cleared when the attributes change.
+  InlinedVector<uint64_t> inferred_def_versions_;
+#endif
+
   // Can be saved? The node cannot be saved anymore if removable attributes have been cleared.
   bool can_be_saved_;
 };
@@ -5,6 +5,7 @@
 
 #include "core/graph/graph.h"
 #include "core/framework/session_options.h"
+#include <mutex>
 #include <unordered_set>
 
 namespace onnxruntime {
@@ -115,6 +116,14 @@ class GraphViewer {
   */
   const std::vector<NodeIndex>& GetNodesInTopologicalOrder(ExecutionOrder order = ExecutionOrder::DEFAULT) const;
 
+#if !defined(ORT_MINIMAL_BUILD)
+  /** Estimates the peak number of bytes held by node outputs if the nodes run in the given order.
+  An output is counted from when its node runs until its last consumer has run. Graph outputs are never released.
+  @remarks Dims without a fixed value count as 1, and outputs without a tensor shape are ignored.
+  */
+  size_t EstimatePeakMemoryUsage(gsl::span<const NodeIndex> order) const;
+#endif
+
   /**
   Gets the NodeIndex values for the root nodes in the Graph.
   The root nodes are the topmost nodes in the Graph that receive inputs from the Graph inputs
@@ -204,6 +213,11 @@ class GraphViewer {
 #if !defined(ORT_MINIMAL_BUILD)
   // The NodeIndex values of the graph nodes sorted in topological order with priority.
   std::vector<NodeIndex> nodes_in_topological_order_with_priority_;
+
+  // The NodeIndex values of the graph nodes sorted in a topological order that greedily minimizes the estimated
+  // peak size of live tensors. Computed on first use as it is rarely needed.
+  mutable std::vector<NodeIndex> nodes_in_memory_efficient_topological_order_;
+  mutable std::once_flag memory_efficient_topological_order_flag_;
 #endif
 
   // Graph root nodes.
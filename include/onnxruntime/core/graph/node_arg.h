@@ -122,6 +122,9 @@ class NodeArg {
   void SetType(const ONNX_NAMESPACE::TypeProto& type_proto);
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
+  // Gives the node arg a new version. Called when its type or shape, or the value of the initializer it is, changes.
+  void UpdateVersion() noexcept;
+
   // Node arg PType.
   const std::string* type_;
 
@@ -130,5 +133,9 @@ class NodeArg {
 
   // Flag indicates whether <*this> node arg exists or not.
   bool exists_;
+
+  // Unique across the node args of the process and renewed on each change, so that Graph::Resolve can tell which
+  // nodes have the inputs and outputs they were last inferred with.
+  uint64_t version_;
 };
 }  // namespace onnxruntime
@@ -9,6 +9,8 @@
 
 /* Modifications Copyright (c) Microsoft. */
 
+#include <algorithm>
+#include <chrono>
 #include <type_traits>
 
 #pragma once
@@ -53,6 +55,7 @@
 #include "core/platform/ort_mutex.h"
 #include "core/platform/ort_spin_lock.h"
 #include "core/platform/Barrier.h"
+#include "core/platform/threadpool.h"
 
 // ORT thread pool overview
 // ------------------------
@@ -78,6 +81,9 @@
 //
 //   This spin-then-block behavior is configured via a flag provided
 //   when creating the thread pool, and by the constant spin_count.
+//   With ThreadOptions::adaptive_spinning_, each worker instead learns
+//   how long it usually waits for its next task, and spins only if
+//   that wait is short (see AdaptiveSpinBudget).
 //
 // - Although all tasks are simple void()->void functions,
 //   conceptually there are three different kinds:
@@ -231,6 +237,10 @@ class ThreadPoolProfiler {
   void LogCoreAndBlock(std::ptrdiff_t){};
   void LogThreadId(int){};
   void LogRun(int){};
+  void LogSpin(int, bool, uint64_t){};
+  bool IsTracing() const { return false; }
+  void LogTrace(int, ThreadPoolTraceEvent::Type, const onnxruntime::TimePoint&, std::ptrdiff_t){};
+  void DrainTrace(const std::function<void(const ThreadPoolTraceEvent&)>&){};
   std::string DumpChildThreadStat() { return {}; }
 };
 #else
@@ -257,6 +267,14 @@ class ThreadPoolProfiler {
   void LogCoreAndBlock(std::ptrdiff_t block_size);  // called in main thread to log core and block size for task breakdown
   void LogThreadId(int thread_idx);                 // called in child thread to log its id
   void LogRun(int thread_idx);                      // called in child thread to log num of run
+  // called in child thread after spinning for spin_ns, found_work is false if it goes on to block
+  void LogSpin(int thread_idx, bool found_work, uint64_t spin_ns);
+  // timeline of the threads, recorded between Start and Stop and kept until drained
+  bool IsTracing() const { return tracing_.load(std::memory_order_acquire); }
+  // called in any thread to record an event from start to now. thread_idx is -1 for threads outside the pool
+  void LogTrace(int thread_idx, ThreadPoolTraceEvent::Type type, const onnxruntime::TimePoint& start,
+                std::ptrdiff_t arg);
+  void DrainTrace(const std::function<void(const ThreadPoolTraceEvent&)>& fn);
   std::string DumpChildThreadStat();                // return all child statitics collected so far
 
  private:
@@ -284,6 +302,9 @@ class ThreadPoolProfiler {
   struct ORT_ALIGN_TO_AVOID_FALSE_SHARING ChildThreadStat {
     std::thread::id thread_id_;
     uint64_t num_run_ = 0;
+    uint64_t num_spin_hit_ = 0;  // idle periods ended by work found while spinning
+    uint64_t num_park_ = 0;      // idle periods ended by blocking
+    uint64_t spin_ns_ = 0;
     onnxruntime::TimePoint last_logged_point_ = Clock::now();
     int32_t core_ = -1;  // core that the child thread is running on
   };
@@ -292,6 +313,19 @@ class ThreadPoolProfiler {
 #endif  // _MSC_VER
   std::vector<ChildThreadStat> child_thread_stats_;
   std::string thread_pool_name_;
+
+  // events of one thread, or of all threads outside the pool for the last ring.
+  // when full the oldest events are overwritten.
+  struct TraceRing {
+    static constexpr uint64_t kCapacity = 1 << 12;
+    OrtSpinLock lock;
+    std::vector<ThreadPoolTraceEvent> events;  // GUARDED_BY(lock)
+    uint64_t head = 0;                         // GUARDED_BY(lock)
+    uint64_t tail = 0;                         // GUARDED_BY(lock)
+  };
+  std::atomic<bool> tracing_{false};
+  OrtMutex trace_mutex_;
+  std::vector<std::unique_ptr<TraceRing>> trace_rings_;  // GUARDED_BY(trace_mutex_), allocated by the first Start
 };
 #endif
 
@@ -335,8 +369,12 @@ class ExtendedThreadPoolInterface : public Eigen::ThreadPoolInterface {
   //
   // [ Note that this 20% overhead is more than paid for when we have
   // two loops execute in series in a parallel section. ]
+  //
+  // high_priority has the same meaning as
+  // ThreadPoolParallelSection::high_priority for the implicit section.
   virtual void RunInParallel(std::function<void(unsigned idx)> fn,
-                             unsigned n, std::ptrdiff_t block_size) = 0;
+                             unsigned n, std::ptrdiff_t block_size,
+                             bool high_priority) = 0;
   virtual void StartProfiling() = 0;
   virtual std::string StopProfiling() = 0;
 };
@@ -359,6 +397,14 @@ class ThreadPoolParallelSection {
   // and in the dispatcher.
   unsigned current_dop{0};
 
+  // Set by the caller before starting the section.  While high
+  // priority sections are active, the workers they use are held back
+  // from normal priority sections: those get a lower degree of
+  // parallelism for new loops, and their workers leave the section
+  // between loops.  This lets a latency critical session share a pool
+  // with a throughput oriented one.
+  bool high_priority{false};
+
   // State shared between the main thread and worker threads
   // -------------------------------------------------------
 
@@ -730,6 +776,30 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     return profiler_.Stop();
   }
 
+  bool IsTracing() const {
+    return profiler_.IsTracing();
+  }
+
+  void LogTrace(ThreadPoolTraceEvent::Type type, const onnxruntime::TimePoint& start, std::ptrdiff_t arg) {
+    profiler_.LogTrace(CurrentThreadId(), type, start, arg);
+  }
+
+  void DrainTrace(const std::function<void(const ThreadPoolTraceEvent&)>& fn) {
+    profiler_.DrainTrace(fn);
+  }
+
+  void EnableBusyTimeTracking() {
+    track_busy_time_.store(true, std::memory_order_relaxed);
+  }
+
+  uint64_t GetBusyTimeNs() const {
+    uint64_t busy_ns = 0;
+    for (size_t i = 0; i < worker_data_.size(); ++i) {
+      busy_ns += worker_data_[i].busy_ns.load(std::memory_order_relaxed);
+    }
+    return busy_ns;
+  }
+
   struct Tag {
     constexpr Tag() : v_(0) {
     }
@@ -774,6 +844,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         num_threads_(num_threads),
         allow_spinning_(allow_spinning),
         set_denormal_as_zero_(thread_options.set_denormal_as_zero),
+        adaptive_spinning_(allow_spinning && thread_options.adaptive_spinning_),
         worker_data_(num_threads),
         all_coprimes_(num_threads),
         blocked_(0),
@@ -942,6 +1013,10 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       onnxruntime::concurrency::SpinPause();
     }
 
+    if (ps.high_priority && ps.current_dop > 1) {
+      high_priority_workers_.fetch_sub(ps.current_dop - 1, std::memory_order_relaxed);
+    }
+
     // Clear status to allow the ThreadPoolParallelSection to be
     // re-used.
     ps.tasks_finished = 0;
@@ -1095,6 +1170,14 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       assert(par_idx < preferred_workers.size());
       unsigned q_idx = preferred_workers[par_idx] % num_threads_;
       assert(q_idx < num_threads_);
+      if (ps.high_priority && worker_data_[q_idx].GetStatus() == WorkerData::ThreadStatus::Active) {
+        // The preferred worker is busy, possibly with a long running
+        // normal priority task.  Do not queue behind it.
+        int idle_idx = IdleWorkerIndex(pt);
+        if (idle_idx != -1) {
+          q_idx = static_cast<unsigned>(idle_idx);
+        }
+      }
       WorkerData& td = worker_data_[q_idx];
       Queue& q = td.queue;
       unsigned w_idx;
@@ -1171,6 +1254,21 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     // single-loop parallel sections, current_dop=1.
     unsigned current_dop = ps.current_dop;
 
+    // Leave the workers used by high priority sections to them.  The
+    // loops run here claim iterations dynamically, so summoning fewer
+    // workers than requested only changes how the work is shared.
+    if (ps.high_priority) {
+      if (current_dop < new_dop) {
+        high_priority_workers_.fetch_add(new_dop - current_dop, std::memory_order_relaxed);
+      }
+    } else {
+      const unsigned reserved = high_priority_workers_.load(std::memory_order_relaxed);
+      if (reserved != 0) {
+        const unsigned available = reserved < num_threads_ ? num_threads_ - reserved : 0;
+        new_dop = std::min(new_dop, available + 1);
+      }
+    }
+
     if (current_dop < new_dop) {
       unsigned extra_needed = new_dop - current_dop;
 
@@ -1256,9 +1354,16 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
 
     // Increase the worker count if needed.  Each worker will pick up
     // loops to execute from the current parallel section.
-    std::function<void(unsigned)> worker_fn = [&ps](unsigned par_idx) {
+    std::function<void(unsigned)> worker_fn = [&ps, this](unsigned par_idx) {
       while (ps.active) {
         if (ps.current_loop.load() == nullptr) {
+          // Give the thread back to the pool between loops if high
+          // priority work needs it.  The remaining loops of the section
+          // run with fewer workers, which is safe because the main
+          // thread claims any iterations the workers do not.
+          if (!ps.high_priority && high_priority_workers_.load(std::memory_order_relaxed) != 0) {
+            break;
+          }
           onnxruntime::concurrency::SpinPause();
         } else {
           ps.workers_in_loop++;
@@ -1279,11 +1384,16 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     profiler_.LogEndAndStart(ThreadPoolProfiler::RUN);
 
     // Wait for workers to exit the loop
+    const bool tracing = profiler_.IsTracing();
+    const auto wait_start = tracing ? std::chrono::high_resolution_clock::now() : onnxruntime::TimePoint{};
     ps.current_loop = 0;
     while (ps.workers_in_loop) {
       onnxruntime::concurrency::SpinPause();
     }
     profiler_.LogEnd(ThreadPoolProfiler::WAIT);
+    if (tracing) {
+      LogTrace(ThreadPoolTraceEvent::WAIT, wait_start, 0);
+    }
   }
 
   // Run a single parallel loop _without_ a parallel section.  This is a
@@ -1298,18 +1408,25 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   //  2. run fn(...) itself.
   // For all other threads:
   //  1. run fn(...);
-  void RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) override {
+  void RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size,
+                     bool high_priority) override {
     ORT_ENFORCE(n <= num_threads_ + 1, "More work items than threads");
     profiler_.LogStartAndCoreAndBlock(block_size);
     PerThread* pt = GetPerThread();
     ThreadPoolParallelSection ps;
+    ps.high_priority = high_priority;
     StartParallelSectionInternal(*pt, ps);
     RunInParallelInternal(*pt, ps, n, true, fn);  // select dispatcher and do job distribution;
     profiler_.LogEndAndStart(ThreadPoolProfiler::DISTRIBUTION);
     fn(0);  // run fn(0)
     profiler_.LogEndAndStart(ThreadPoolProfiler::RUN);
+    const bool tracing = profiler_.IsTracing();
+    const auto wait_start = tracing ? std::chrono::high_resolution_clock::now() : onnxruntime::TimePoint{};
     EndParallelSectionInternal(*pt, ps);  // wait for all
     profiler_.LogEnd(ThreadPoolProfiler::WAIT);
+    if (tracing) {
+      LogTrace(ThreadPoolTraceEvent::WAIT, wait_start, 0);
+    }
   }
 
   int NumThreads() const final {
@@ -1395,6 +1512,14 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     std::unique_ptr<Thread> thread;
     Queue queue;
 
+    // Moving average of the time this worker waited for its next task,
+    // used for adaptive spinning.  Only accessed by the worker.
+    int64_t idle_ns_average{0};
+
+    // Time this worker spent running tasks while busy time tracking is
+    // enabled.  Only written by the worker.
+    std::atomic<uint64_t> busy_ns{0};
+
     // Each thread has a status, available read-only without locking, and protected
     // by the mutex field below for updates.  The status is used for three
     // purposes:
@@ -1493,11 +1618,20 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   const unsigned num_threads_;
   const bool allow_spinning_;
   const bool set_denormal_as_zero_;
+  const bool adaptive_spinning_;
   Eigen::MaxSizeVector<WorkerData> worker_data_;
   Eigen::MaxSizeVector<Eigen::MaxSizeVector<unsigned>> all_coprimes_;
   std::atomic<unsigned> blocked_;  // Count of blocked workers, used as a termination condition
   std::atomic<bool> done_;
 
+  // Number of workers summoned by the active high priority parallel
+  // sections.  Normal priority sections leave this many workers free.
+  std::atomic<unsigned> high_priority_workers_{0};
+
+  // Whether the workers measure the time they spend running tasks, see
+  // EnableBusyTimeTracking.
+  std::atomic<bool> track_busy_time_{false};
+
   // SpinLoopStatus indicates whether the main worker spinning (inner) loop should exit immediately when there is
   // no work available (kIdle) or whether it should follow the configured spin-then-block policy (kBusy).
   // This lets the ORT session layer hint to the thread pool that it should stop spinning in between
@@ -1521,6 +1655,30 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     }
   }
 
+  // Adaptive spinning: spinning avoids the OS wake-up latency, but
+  // only pays off if work arrives soon.  A worker spins for up to
+  // twice the idle time it predicts, which bounds the CPU wasted on
+  // a misprediction, if that prediction is below kMaxAdaptiveSpinNs.
+  // Longer idle periods, such as the gaps between requests, are not
+  // worth spinning for, and the worker blocks after a short spin
+  // that still catches the next loop of the same parallel section.
+  static constexpr int64_t kMinAdaptiveSpinNs = 10 * 1000;
+  static constexpr int64_t kMaxAdaptiveSpinNs = 1000 * 1000;
+
+  // The clock is read once every this many spin iterations.
+  static constexpr int kAdaptiveSpinCheckInterval = 64;
+
+  static int64_t AdaptiveSpinBudget(int64_t idle_ns_average) {
+    if (idle_ns_average > kMaxAdaptiveSpinNs) {
+      return kMinAdaptiveSpinNs;
+    }
+    return std::min(std::max(2 * idle_ns_average, kMinAdaptiveSpinNs), kMaxAdaptiveSpinNs);
+  }
+
+  static int64_t ElapsedNs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - since).count();
+  }
+
   // Main worker thread loop.
   void WorkerLoop(int thread_id) {
     PerThread* pt = GetPerThread();
@@ -1542,6 +1700,13 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     while (!should_exit) {
       Task t = q.PopFront();
       if (!t) {
+        std::chrono::steady_clock::time_point idle_start;
+        int64_t spin_budget_ns = 0;
+        if (adaptive_spinning_) {
+          idle_start = std::chrono::steady_clock::now();
+          spin_budget_ns = AdaptiveSpinBudget(td.idle_ns_average);
+        }
+
         // Spin waiting for work.
         for (int i = 0; i < spin_count && !done_; i++) {
           if (((i + 1) % steal_count == 0)) {
@@ -1554,9 +1719,17 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
           if (spin_loop_status_.load(std::memory_order_relaxed) == SpinLoopStatus::kIdle) {
             break;
           }
+          if (adaptive_spinning_ && (i + 1) % kAdaptiveSpinCheckInterval == 0 &&
+              ElapsedNs(idle_start) > spin_budget_ns) {
+            break;
+          }
           onnxruntime::concurrency::SpinPause();
         }
 
+        if (adaptive_spinning_) {
+          profiler_.LogSpin(thread_id, static_cast<bool>(t), static_cast<uint64_t>(ElapsedNs(idle_start)));
+        }
+
         // Attempt to block
         if (!t) {
           td.SetBlocked(  // Pre-block test
@@ -1621,11 +1794,22 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
           if (!t) t = q.PopFront();
           if (!t) t = Steal(StealAttemptKind::TRY_ALL);
         }
+
+        // learn the time until work arrived, whether it was found spinning or after blocking
+        if (adaptive_spinning_ && t) {
+          td.idle_ns_average += (ElapsedNs(idle_start) - td.idle_ns_average) / 4;
+        }
       }
 
       if (t) {
         td.SetActive();
-        t();
+        if (track_busy_time_.load(std::memory_order_relaxed)) {
+          const auto run_start = std::chrono::steady_clock::now();
+          t();
+          td.busy_ns.fetch_add(static_cast<uint64_t>(ElapsedNs(run_start)), std::memory_order_relaxed);
+        } else {
+          t();
+        }
         profiler_.LogRun(thread_id);
         td.SetSpinning();
       }
@@ -1688,6 +1872,25 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     return -1;
   }
 
+  // Returns the index of a worker that is not running user code, or -1
+  // if all of them are.
+  int IdleWorkerIndex(PerThread& pt) {
+    const unsigned size = num_threads_;
+    unsigned r = Rand(&pt.rand);
+    unsigned inc = all_coprimes_[size - 1][r % all_coprimes_[size - 1].size()];
+    unsigned victim = r % size;
+    for (unsigned i = 0; i < size; i++) {
+      if (worker_data_[victim].GetStatus() != WorkerData::ThreadStatus::Active) {
+        return victim;
+      }
+      victim += inc;
+      if (victim >= size) {
+        victim -= size;
+      }
+    }
+    return -1;
+  }
+
   static EIGEN_STRONG_INLINE uint64_t GlobalThreadIdHash() {
     return std::hash<std::thread::id>()(std::this_thread::get_id());
   }
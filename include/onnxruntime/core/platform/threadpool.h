@@ -136,6 +136,37 @@ class ExtendedThreadPoolInterface;
 class LoopCounter;
 class ThreadPoolParallelSection;
 
+// An event on the timeline of a thread pool, recorded while the pool is profiled.
+struct ThreadPoolTraceEvent {
+  enum Type : uint8_t {
+    WORK_ITEM = 0,  // a work item of a parallel loop. arg is its index
+    BLOCK,          // a block of iterations run by a work item. arg is its first iteration
+    STEAL,          // a block of iterations taken from the share of another work item. arg is its first iteration
+    WAIT,           // the thread starting a parallel loop waiting for the other threads to finish it
+  };
+
+  static const char* GetName(Type type) {
+    switch (type) {
+      case WORK_ITEM:
+        return "work_item";
+      case BLOCK:
+        return "block";
+      case STEAL:
+        return "steal";
+      case WAIT:
+        return "wait";
+      default:
+        return "unknown";
+    }
+  }
+
+  Type type = WORK_ITEM;
+  int thread_id = -1;  // logging::GetThreadId() of the thread the event happened on
+  TimePoint start;
+  TimePoint end;
+  std::ptrdiff_t arg = 0;
+};
+
 class ThreadPool {
  public:
 #ifdef _WIN32
@@ -213,6 +244,38 @@ class ThreadPool {
     ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ParallelSection);
   };
 
+  // Priority of the parallel loops run by a thread, see SchedulingScope.
+  enum class Priority : uint8_t {
+    kNormal,
+    kHigh,
+  };
+
+  // Sets the priority and the concurrency quota of the parallel loops
+  // the current thread runs, in any thread pool, until the scope is
+  // exited.  InferenceSession::Run enters one per Run so that sessions
+  // sharing the environment's thread pools can be configured
+  // differently.
+  //
+  // While high priority loops are running, normal priority loops get
+  // only the workers not used by them, and workers helping a normal
+  // priority parallel section leave it between loops.
+  //
+  // max_degree_of_parallelism caps the degree of parallelism of each
+  // loop, including the current thread.  0 means no cap.
+  //
+  // Scopes may be nested; the previous settings are restored on exit.
+  // Loops run by the threads of an inter-op pool are not affected.
+  class SchedulingScope {
+   public:
+    SchedulingScope(Priority priority, int max_degree_of_parallelism);
+    ~SchedulingScope();
+
+   private:
+    Priority previous_priority_;
+    int previous_max_degree_of_parallelism_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SchedulingScope);
+  };
+
   // The below API allows to disable spinning
   // This is used to support real-time scenarios where
   // spinning between relatively infrequent requests
@@ -254,6 +317,14 @@ class ThreadPool {
   static void TryParallelFor(ThreadPool* tp, std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
                              const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn);
 
+  // Same as TryParallelFor, but always uses work-stealing scheduling: each thread starts with an equal share of
+  // [0, total), and threads that run out of work split the largest remaining share and take its second half.
+  // Prefer this for loops whose iterations have very different costs, e.g. ragged attention heads, where fixed
+  // blocks leave threads idle at the end of the loop.  Pools created with ThreadOptions::work_stealing_loops_
+  // use this scheduling for all TryParallelFor calls.
+  static void TryWorkStealingParallelFor(ThreadPool* tp, std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
+                                         const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn);
+
   // Directly schedule the 'total' tasks to the underlying threadpool, without
   // cutting them by halves
 
@@ -366,6 +437,21 @@ class ThreadPool {
   static void StartProfiling(concurrency::ThreadPool* tp);
   static std::string StopProfiling(concurrency::ThreadPool* tp);
 
+  // Passes the timeline events recorded since the last call to fn, oldest first for each thread. Events are only
+  // recorded while profiling, into a buffer per thread that keeps the latest ones.
+  static void DrainTraceEvents(concurrency::ThreadPool* tp,
+                               const std::function<void(const ThreadPoolTraceEvent&)>& fn);
+
+  // Makes the threads of the pool add the time they spend running tasks to a counter of their own, for the
+  // utilization metrics of the sessions using it. Tracking stays enabled for the lifetime of the pool.
+  static void EnableBusyTimeTracking(concurrency::ThreadPool* tp);
+
+  // Total time the threads of the pool spent running tasks since busy time tracking was enabled.
+  static uint64_t GetBusyTimeNs(const concurrency::ThreadPool* tp);
+
+  // Number of threads created in the pool, 0 if tp is null.
+  static int GetNumThreads(const concurrency::ThreadPool* tp);
+
  private:
   friend class LoopCounter;
 
@@ -377,6 +463,11 @@ class ThreadPool {
   // thread in the pool. Returns -1 otherwise.
   int CurrentThreadId() const;
 
+  // Returns the number of threads, including the current one, that a loop
+  // run by the current thread may use: NumThreads() + 1, capped by the
+  // quota of the current SchedulingScope.
+  int NumThreadsIncMain() const;
+
   // Run fn with up to n degree-of-parallelism enlisting the thread pool for
   // help.  The degree-of-parallelism includes the caller, and so if n==1
   // then the function will run directly in the caller.  The fork-join
@@ -393,6 +484,10 @@ class ThreadPool {
   void ParallelForFixedBlockSizeScheduling(std::ptrdiff_t total, std::ptrdiff_t block_size,
                                            const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>& fn);
 
+  // Runs fn over [0, total) with work-stealing scheduling, calling it with ranges of at most grain iterations.
+  void WorkStealingParallelFor(std::ptrdiff_t total, std::ptrdiff_t grain,
+                               const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>& fn);
+
   // Return whether or not the calling thread should run a loop of
   // num_iterations divided in chunks of block_size in parallel.  If not,
   // the caller should run the loop sequentially.
@@ -415,6 +510,12 @@ class ThreadPool {
 
   std::string StopProfiling();
 
+  // Whether timeline events are being recorded
+  bool IsTracing() const;
+
+  // Records an event on the timeline of the calling thread, which ends now
+  void LogTrace(ThreadPoolTraceEvent::Type type, const TimePoint& start, std::ptrdiff_t arg);
+
   ThreadOptions thread_options_;
 
   // If a thread pool is created with degree_of_parallelism != 1 then an underlying
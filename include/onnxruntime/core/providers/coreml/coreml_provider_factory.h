@@ -28,9 +28,19 @@ enum COREMLFlags {
   // dynamic shapes. However, the performance may be negatively impacted if inputs have dynamic shapes.
   COREML_FLAG_ONLY_ALLOW_STATIC_INPUT_SHAPES = 0x008,
 
+  // Create an MLProgram. By default it will create a NeuralNetwork model. Requires Core ML 5 or later
+  // (macOS 12 / iOS 15). The MLProgram computes in fp16, which the Apple Neural Engine requires, unless
+  // COREML_FLAG_USE_CPU_ONLY is also set, in which case it computes in fp32.
+  COREML_FLAG_CREATE_MLPROGRAM = 0x010,
+
+  // Keep the compiled CoreML model in the caches directory of the app, keyed by a hash of the CoreML model and the OS
+  // version, and load it from there in later sessions instead of compiling the CoreML model again.
+  // The cache is in <NSCachesDirectory>/onnxruntime/coreml, which the OS may purge when the device runs low on storage.
+  COREML_FLAG_CACHE_COMPILED_MODEL = 0x020,
+
   // Keep COREML_FLAG_LAST at the end of the enum definition
   // And assign the last COREMLFlag to it
-  COREML_FLAG_LAST = COREML_FLAG_ONLY_ALLOW_STATIC_INPUT_SHAPES,
+  COREML_FLAG_LAST = COREML_FLAG_CACHE_COMPILED_MODEL,
 };
 
 #ifdef __cplusplus
@@ -37,4 +37,10 @@ struct OrtCUDAProviderOptionsV2 {
                                                                                                                // The strict mode has better accuracy but lower performance.
   int prefer_nhwc = 0;                                                                                         // make the CUDA EP NHWC preferred
   int use_ep_level_unified_stream = 0;                                                                         // flag specifying if ep level stream is used or not
+  const char* cudnn_conv_algo_cache_path = nullptr;                                                            // file of the algorithms found by the exhaustive cudnn conv algo search, shared by processes.
+                                                                                                               // (owned by the instance when set by UpdateCUDAProviderOptions)
+  int cuda_graph_max_count = 8;                                                                                // max number of CUDA graphs captured for different input shapes or graph ids.
+  int use_cuda_mempool = 0;                                                                                    // flag specifying if the device memory is allocated from a cudaMallocAsync pool instead of the arena.
+  size_t cuda_mempool_release_threshold = std::numeric_limits<size_t>::max();                                  // bytes of unused memory the pool keeps instead of returning them to the device.
+  size_t weight_streaming_budget = 0;                                                                          // bytes of device memory for initializers, beyond which they stay in pinned host memory and are prefetched. 0 disables it.
 };
@@ -46,4 +46,5 @@ struct OrtTensorRTProviderOptionsV2 {
   const char* trt_profile_max_shapes{nullptr};           // Specify the range of the input shapes to build the engine with
   const char* trt_profile_opt_shapes{nullptr};           // Specify the range of the input shapes to build the engine with
   int trt_cuda_graph_enable{0};                          // Enable CUDA graph in ORT TRT
+  int trt_background_engine_build{0};                    // Rebuild engines for new input shape ranges without blocking the runs that fit the current engine. Default 0 = false, nonzero = true
 };
@@ -88,6 +88,23 @@ class Environment {
    */
   Status CreateAndRegisterAllocatorV2(const std::string& provider_type, const OrtMemoryInfo& mem_info, const std::unordered_map<std::string, std::string>& options, const OrtArenaCfg* arena_cfg = nullptr);
 
+  /**
+   * Creates a pool of activation blocks that sessions with "session.use_env_activation_pool" enabled take the memory
+   * pattern buffer of a Run from, for the device of mem_info. Only CPU is supported.
+   * Return an error if a pool for the same device is already registered.
+   * @param max_bytes upper limit of the memory held by the pool
+   * @param admission_timeout_ms how long a Run waits for room in the pool before it allocates its activations
+   *        from the session allocator instead
+   */
+  Status CreateAndRegisterActivationPool(const OrtMemoryInfo& mem_info, size_t max_bytes, int64_t admission_timeout_ms);
+
+  /**
+   * Returns the list of activation pools registered in this env.
+   */
+  const std::vector<AllocatorPtr>& GetRegisteredActivationPools() const {
+    return activation_pools_;
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Environment);
   Status Initialize(std::unique_ptr<logging::LoggingManager> logging_manager,
@@ -99,5 +116,6 @@ class Environment {
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
   bool create_global_thread_pools_{false};
   std::vector<AllocatorPtr> shared_allocators_;
+  std::vector<AllocatorPtr> activation_pools_;
 };
 }  // namespace onnxruntime
@@ -300,6 +300,11 @@ ORT_RUNTIME_CLASS(Op);
 ORT_RUNTIME_CLASS(OpAttr);
 ORT_RUNTIME_CLASS(Logger);
 ORT_RUNTIME_CLASS(ShapeInferContext);
+ORT_RUNTIME_CLASS(RunPipeline);
+ORT_RUNTIME_CLASS(RequestBatcher);
+ORT_RUNTIME_CLASS(PreparedRun);
+ORT_RUNTIME_CLASS(SwappableSession);
+ORT_RUNTIME_CLASS(PrePackedWeights);
 
 #ifdef _WIN32
 typedef _Return_type_success_(return == 0) OrtStatus* OrtStatusPtr;
@@ -324,6 +329,24 @@ typedef void(ORT_API_CALL* OrtLoggingFunction)(
     void* param, OrtLoggingLevel severity, const char* category, const char* logid, const char* code_location,
     const char* message);
 
+/** \brief Receives the spans of the traced Runs of a session
+ *
+ * Called on the thread that executed the span when it ends, see OrtApi::SetTraceSpanFunction.
+ *
+ * \param param The `trace_span_param` given to OrtApi::SetTraceSpanFunction
+ * \param trace_context The "run.trace_context" config entry of the RunOptions of the Run, "" if it isn't set
+ * \param span_id Id of the span, unique within the process
+ * \param parent_span_id Id of the parent span, 0 for the span of the Run
+ * \param name Name of the span: the session log id for a Run, the graph name for a subgraph, or the node name
+ * \param kind One of "run", "subgraph", "partition" (a node compiled by an execution provider) or "memcpy"
+ * \param provider Execution provider of a partition or copy, "" otherwise
+ * \param start_time_ns Start of the span in nanoseconds since the Unix epoch
+ * \param end_time_ns End of the span in nanoseconds since the Unix epoch
+ */
+typedef void(ORT_API_CALL* OrtTraceSpanFunction)(
+    void* param, const char* trace_context, uint64_t span_id, uint64_t parent_span_id, const char* name,
+    const char* kind, const char* provider, int64_t start_time_ns, int64_t end_time_ns);
+
 /** \brief Graph optimization level
  *
  * Refer to https://www.onnxruntime.ai/docs/performance/graph-optimizations.html#graph-optimization-levels
@@ -708,6 +731,14 @@ typedef OrtStatus*(ORT_API_CALL* RegisterCustomOpsFn)(OrtSessionOptions* options
  */
 typedef void (*RunAsyncCallbackFn)(void* user_data, OrtValue** outputs, size_t num_outputs, OrtStatusPtr status);
 
+/** \brief Callback function returning the write position of an output bound with OrtApi::BindOutputToRingBuffer
+ *
+ * \param[in] user_data User specific data that passed back to the callback
+ * \param[in] num_bytes Size of the output produced by the current Run
+ * \return Write position in units of the stride of the ring buffer
+ */
+typedef size_t (*OrtRingBufferPositionFn)(void* user_data, size_t num_bytes);
+
 /** \brief The C API
  *
  * All C API functions are defined inside this structure as pointers to functions.
@@ -2770,6 +2801,17 @@ struct OrtApi {
    *  Use -1 to allow ORT to choose the default 1GB for max_power_of_two_extend_bytes.
    *  Ultimately, the allocation size is determined by the allocation memory request.
    *  Further allocation sizes are governed by the arena extend strategy.
+   * "slab_max_alloc_bytes": Requests up to this size (at most 16384) are served from per size class free lists
+   *  in front of the arena, without taking the arena lock. Use 0 to disable. Default is 0 (disabled).
+   * "slab_region_bytes": Size of the region reserved for the slab cache when it is enabled.
+   *  Use -1 to allow ORT to choose the default of 4MB.
+   * "slab_thread_cache_blocks": Number of slab cache blocks per size class each thread may keep for itself.
+   *  Blocks move between a thread and the shared slab cache in batches. Use 0 to disable. Default is 0 (disabled).
+   * "huge_page_bytes": CPU arenas only. Back the arena regions with huge pages of this size, 2097152 (2MB) or
+   *  1073741824 (1GB). Explicit huge pages are used if the OS has them reserved, otherwise transparent huge pages
+   *  (Linux) or regular pages. Use 0 for regular pages. Default is 0.
+   * "numa_node": CPU arenas only, requires "huge_page_bytes". Bind the memory of the arena regions to this NUMA node,
+   *  usually the node the intra op threads are pinned to. Default is to not bind.
    *
    * \param[in] arena_config_keys Keys to configure the arena
    * \param[in] arena_config_values Values to configure the arena
@@ -3626,6 +3668,9 @@ struct OrtApi {
    * XNNPACK supported keys:
    *   "intra_op_num_threads": number of thread-pool size to use for XNNPACK execution provider.
    *      default value is 0, which means to use the session thread-pool size.
+   *   "enable_subgraph_compile": set to "1" to compile the regions of supported nodes with static shapes into
+   *      XNNPACK subgraphs, which XNNPACK fuses and runs as a whole, instead of running a kernel per node.
+   *      Disabled by default.
    *
    * \since Version 1.12.
    */
@@ -4515,6 +4560,578 @@ struct OrtApi {
    * \since Version 1.17.
    */
   ORT_API2_STATUS(ReadOpAttr, _In_ const OrtOpAttr* op_attr, _In_ OrtOpAttrType type, _Inout_ void* data, _In_ size_t len, _Out_ size_t* out);
+
+  /** \brief Compact the memory arena of a session
+   *
+   * Coalesces the free memory of the arena based allocator matching `mem_info` and releases every
+   * arena region that has no memory in use back to the device. Unlike the
+   * "memory.enable_memory_arena_shrinkage" run option this can be called at any time the session is idle,
+   * which keeps the resident memory of long running processes bounded.
+   *
+   * \param[in] sess Session that owns the arena. No Run may be in progress on it.
+   * \param[in] mem_info Memory info identifying the arena, e.g. the one returned by ::AllocatorGetInfo.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(CompactArena, _Inout_ OrtSession* sess, _In_ const OrtMemoryInfo* mem_info);
+
+  /** \brief Create an activation pool shared by the sessions of an environment
+   *
+   * Sessions created with the "session.use_env_activation_pool" config entry set to "1" take the buffer the memory
+   * pattern of a Run needs from this pool and return it when the Run completes. The memory held for activations
+   * is then bounded by `max_bytes` and depends on the number of concurrent Runs, not on the number of sessions.
+   * If the pool is full, a Run waits for another Run to return its buffer. After `admission_timeout_ms` it
+   * allocates its activations from the session allocator instead.
+   *
+   * \param[in] env ::OrtEnv instance
+   * \param[in] mem_info Memory info of the device. Only CPU is supported.
+   * \param[in] max_bytes Upper limit of the memory held by the pool
+   * \param[in] admission_timeout_ms Time in milliseconds a Run waits for room in the pool
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(CreateAndRegisterActivationPool, _Inout_ OrtEnv* env, _In_ const OrtMemoryInfo* mem_info,
+                  size_t max_bytes, int64_t admission_timeout_ms);
+
+  /** \brief Bind an output to a caller owned ring buffer
+   *
+   * On every Run the output is written at `base` + `position_fn`(`user_data`, size of the output) * `stride_bytes`.
+   * If the node producing the output runs on the device of `mem_info` it writes there directly, otherwise the output
+   * is copied there at the end of the Run. The output must fit in `capacity_bytes` from `base`.
+   * OrtApi::GetBoundOutputValues returns a tensor that views the buffer at the position of the last Run, so the
+   * binding does not need to be updated between Runs.
+   *
+   * \param[in] binding_ptr
+   * \param[in] name Name of a tensor output of the model
+   * \param[in] mem_info Location of the buffer
+   * \param[in] base Start of the buffer
+   * \param[in] capacity_bytes Size of the buffer
+   * \param[in] stride_bytes Distance in bytes between two write positions
+   * \param[in] position_fn Callback returning the write position for the current Run
+   * \param[in] user_data Passed to `position_fn`
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(BindOutputToRingBuffer, _Inout_ OrtIoBinding* binding_ptr, _In_ const char* name,
+                  _In_ const OrtMemoryInfo* mem_info, _Inout_ void* base, size_t capacity_bytes, size_t stride_bytes,
+                  _In_ OrtRingBufferPositionFn position_fn, _In_opt_ void* user_data);
+
+  /// \name OrtRunPipeline
+  /// @{
+
+  /** \brief Create a pipeline that keeps several Runs of a session in flight
+   *
+   * The copies of the inputs of a Run to the device, the compute of the previous Run and the copies of the outputs
+   * of the Run before it back to CPU overlap. The copies are issued on copy streams owned by the pipeline. Each of the
+   * `depth` Runs in flight has its own device buffers for the inputs, reused by later Runs with the same input shapes.
+   *
+   * \param[in] session An initialized session
+   * \param[in] run_options Used for every Run of the pipeline. Optional.
+   * \param[in] input_names Names of the inputs passed to OrtApi::RunPipelineSubmit, in that order
+   * \param[in] input_len Number of inputs
+   * \param[in] output_names Names of the outputs returned to the callback, in that order
+   * \param[in] output_names_len Number of outputs
+   * \param[in] depth Maximum number of Runs in flight, 2 or more to overlap stages
+   * \param[out] out Must be released with OrtApi::ReleaseRunPipeline, before the session is released
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(CreateRunPipeline, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  size_t depth, _Outptr_ OrtRunPipeline** out);
+
+  /** \brief Queue a Run on a pipeline
+   *
+   * Blocks while `depth` Runs are in flight. The callback is invoked on a thread of the pipeline once the outputs
+   * are on CPU, in submission order. The output values passed to it are owned by the caller and must be released
+   * with OrtApi::ReleaseValue; the array holding them is only valid during the callback.
+   *
+   * \param[in] pipeline
+   * \param[in] inputs Inputs in the order of the input names. They may be on any device and must not be modified
+   *   until the callback is invoked.
+   * \param[in] input_len Number of inputs
+   * \param[in] callback Invoked with the outputs or the error of the Run
+   * \param[in] user_data Passed to `callback`
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(RunPipelineSubmit, _Inout_ OrtRunPipeline* pipeline,
+                  _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                  _In_ RunAsyncCallbackFn callback, _In_opt_ void* user_data);
+
+  /** \brief Wait until all Runs submitted to a pipeline have completed
+   *
+   * \param[in] pipeline
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(RunPipelineWait, _Inout_ OrtRunPipeline* pipeline);
+
+  /** \brief Release an ::OrtRunPipeline, waiting for the Runs in flight
+   *
+   * \since Version 1.17.
+   */
+  ORT_CLASS_RELEASE(RunPipeline);
+
+  /// @}
+  /// \name OrtRequestBatcher
+  /// @{
+
+  /** \brief Create a dynamic batcher of requests to a session
+   *
+   * Requests submitted with OrtApi::RequestBatcherSubmit are concatenated along `batch_axis` and run together once
+   * they add up to `max_batch_size` samples, or once the first of them has waited `max_delay_us`. Each request gets
+   * its slice of the outputs along `batch_axis`.
+   * Inputs of the requests in a batch may differ in other dimensions, e.g. ragged sequences. They are zero padded to
+   * the largest size in the batch, rounded up to the smallest of `padding_buckets` that fits. The outputs keep the
+   * padded sizes.
+   *
+   * \param[in] session An initialized session
+   * \param[in] run_options Used for every Run of the batcher. Optional.
+   * \param[in] input_names Names of the inputs passed to OrtApi::RequestBatcherSubmit, in that order
+   * \param[in] input_len Number of inputs
+   * \param[in] output_names Names of the outputs returned to the callbacks, in that order
+   * \param[in] output_names_len Number of outputs
+   * \param[in] batch_axis Axis of the inputs and outputs that holds the samples
+   * \param[in] max_batch_size Maximum number of samples in a batch, unless a single request has more
+   * \param[in] max_delay_us Maximum time in microseconds a request waits for others to batch with
+   * \param[in] padding_buckets Sorted sizes to pad ragged dimensions to. Optional.
+   * \param[in] num_padding_buckets Number of padding buckets
+   * \param[out] out Must be released with OrtApi::ReleaseRequestBatcher, before the session is released
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(CreateRequestBatcher, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  size_t batch_axis, size_t max_batch_size, int64_t max_delay_us,
+                  _In_reads_(num_padding_buckets) const int64_t* padding_buckets, size_t num_padding_buckets,
+                  _Outptr_ OrtRequestBatcher** out);
+
+  /** \brief Submit a request to a batcher
+   *
+   * The callback is invoked on a thread of the batcher once the batch of the request has run. The output values
+   * passed to it are owned by the caller and must be released with OrtApi::ReleaseValue; the array holding them is
+   * only valid during the callback.
+   *
+   * \param[in] batcher
+   * \param[in] inputs CPU tensors in the order of the input names, with the same size on the batch axis
+   * \param[in] input_len Number of inputs
+   * \param[in] callback Invoked with the outputs or the error of the request
+   * \param[in] user_data Passed to `callback`
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(RequestBatcherSubmit, _Inout_ OrtRequestBatcher* batcher,
+                  _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                  _In_ RunAsyncCallbackFn callback, _In_opt_ void* user_data);
+
+  /** \brief Release an ::OrtRequestBatcher, running the pending requests first
+   *
+   * \since Version 1.17.
+   */
+  ORT_CLASS_RELEASE(RequestBatcher);
+
+  /// @}
+
+  /** \brief Run a function for each index of a range in the intra-op thread pool of a kernel call
+   *
+   * Lets custom ops and execution providers with their own kernels parallelize their work in the parallel sections
+   * of the ORT intra-op thread pool, rather than in a thread pool of their own whose workers would compete with the
+   * ones of ORT for the cores. `fn` runs sequentially in the calling thread if the session has no intra-op thread
+   * pool.
+   *
+   * \param[in] context Kernel context
+   * \param[in] fn Called with `usr_data` for each index in [0, total), concurrently from several threads
+   * \param[in] total Number of indices
+   * \param[in] num_batch Number of batches to split the indices into. 0 schedules each index on its own.
+   * \param[in] usr_data Passed to `fn`
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(KernelContext_ParallelFor, _In_ const OrtKernelContext* context, _In_ void (*fn)(void*, size_t),
+                  _In_ size_t total, _In_ size_t num_batch, _In_opt_ void* usr_data);
+
+  /** \brief Get the degree of parallelism of the intra-op thread pool of a kernel call
+   *
+   * The number of threads, including the calling one, that OrtApi::KernelContext_ParallelFor may run `fn` in
+   * concurrently. 1 if the session has no intra-op thread pool.
+   *
+   * \param[in] context Kernel context
+   * \param[out] out Degree of parallelism
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(KernelContext_GetDegreeOfParallelism, _In_ const OrtKernelContext* context, _Out_ int* out);
+
+  /** \brief Get a snapshot of the metrics collected while a session runs
+   *
+   * The session collects metrics if the "session.metrics_sampling_rate" session config entry is set: latency
+   * histograms of its Runs and of the kernels of each node, measured in the sampled fraction of the Runs, the
+   * allocator peak and allocation counters and the time its thread pools spend running tasks. Unlike profiling, the
+   * memory used is fixed and the overhead is low enough to leave them enabled in production.
+   *
+   * The snapshot is in the Prometheus text exposition format, with the p50, p90 and p99 latencies summarized per
+   * session, node and op type, so it can be served as is by a metrics endpoint. Counters are cumulative since the
+   * session was created.
+   *
+   * \param[in] session
+   * \param[in] allocator
+   * \param[out] out Null terminated string of the snapshot, allocated using `allocator`. Must be freed using `allocator`
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(SessionGetMetricsSnapshot, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /** \brief Set a function receiving tracing spans of the Runs of the session
+   *
+   * Every Run of the session reports a span covering the Run, with child spans for the subgraphs executed by control
+   * flow nodes, the nodes compiled by execution providers and the copies between devices. The spans of a Run share the
+   * trace context set in the "run.trace_context" config entry of its RunOptions, such as a W3C traceparent header, so
+   * `trace_span_function` can export them as OpenTelemetry spans of the request that caused the Run.
+   *
+   * Unlike profiling, the spans are reported as they end and nothing is buffered by the session. The function is
+   * called from the threads executing the Run, it must be thread safe and should return quickly.
+   *
+   * \param[in] options
+   * \param[in] trace_span_function The function receiving the spans. nullptr disables tracing.
+   * \param[in] trace_span_param A pointer to arbitrary data passed as the ::OrtTraceSpanFunction `param` parameter to
+   *                         `trace_span_function`. This parameter is optional.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(SetTraceSpanFunction, _Inout_ OrtSessionOptions* options,
+                  _In_opt_ OrtTraceSpanFunction trace_span_function, _In_opt_ void* trace_span_param);
+
+  /** \brief Get the kernel variants the nodes of a session dispatched to in their last Run
+   *
+   * The session records them if the "session.record_kernel_dispatch" session config entry is "1". Each kernel reports
+   * the implementation it chose for its inputs and the device, e.g. the MLAS GEMM kernel of a MatMul ("avx2",
+   * "avx512vnni", "amx", ...), the path of MatMulNBits, the kernel of an attention op ("flash", "memory_efficient",
+   * "unfused", ...) or the implementation selected by a tunable op. Nodes of subgraphs are included.
+   *
+   * The result is a JSON array with an object for each node which reported a dispatch, in the order the nodes first
+   * ran: `{"node_name": ..., "op_type": ..., "provider": ..., "calls": ..., "dispatch": {"<key>": "<value>", ...}}`.
+   * A key the kernel dispatched with several values in one call, e.g. over the batches of a MatMul, lists them
+   * separated by ','.
+   *
+   * \param[in] session
+   * \param[in] allocator
+   * \param[out] out Null terminated JSON string, allocated using `allocator`. Must be freed using `allocator`
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(SessionGetKernelDispatches, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /** \brief Get the time the session spent in each phase of its creation
+   *
+   * The phases are those of loading the model: parsing it ("model_parse") and building the graph ("graph_build"),
+   * and those of initializing the session: resolving the graph ("graph_resolve"), each graph transformer
+   * ("graph_transformer"), partitioning the graph ("partitioning"), compiling the nodes of each execution provider
+   * ("ep_compile"), creating the execution plan ("execution_plan"), loading the initializers ("initializer_load"),
+   * creating the kernels ("kernel_creation") and prepacking their weights ("prepacking"). The whole of Load and
+   * Initialize are the "load" and "initialize" phases. When profiling is enabled the phases are in the profile too.
+   *
+   * The result is a JSON object with the phases in the order they began, and their totals by phase:
+   * `{"phases": [{"phase": ..., "name": ..., "start_us": ..., "duration_us": ..., "depth": ...}],
+   *   "summary": {"<phase>": {"count": ..., "total_us": ...}}, "total_us": ...}`
+   * where "name" is what the phase worked on, e.g. the name of the transformer or the execution provider, and
+   * "depth" the number of phases it's nested in. start_us is relative to the start of the first phase.
+   *
+   * \param[in] session
+   * \param[in] allocator
+   * \param[out] out Null terminated JSON string, allocated using `allocator`. Must be freed using `allocator`
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(SessionGetStartupTimings, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /** \brief Run a batch of independent requests with the same input and output names
+   *
+   * Equivalent to calling OrtApi::Run for each request, but the names are converted and resolved once for the
+   * batch, which matters for many small requests. The requests run concurrently on the intra op thread pool if it
+   * has more than one thread and the session supports concurrent runs, sequentially otherwise.
+   *
+   * \param[in] session
+   * \param[in] run_options If nullptr, will use a default ::OrtRunOptions
+   * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names
+   * \param[in] inputs Array of input_len * batch_size ::OrtValue%s, the inputs of request i are
+   *            inputs[i * input_len] to inputs[i * input_len + input_len - 1]
+   * \param[in] input_len Number of elements in the input_names array
+   * \param[in] output_names Array of null terminated UTF8 encoded strings of the output names
+   * \param[in] output_names_len Number of elements in the output_names array
+   * \param[in,out] outputs Array of output_names_len * batch_size ::OrtValue%s, laid out as inputs. A nullptr is set
+   *                 to an ::OrtValue allocated by onnxruntime if its request succeeds, as in OrtApi::Run
+   * \param[in] batch_size Number of requests
+   * \param[out] statuses Array of batch_size ::OrtStatus pointers, set to nullptr for the requests which succeeded and
+   *             to an ::OrtStatus to be released with OrtApi::ReleaseStatus for the others
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   * An error is returned only if the arguments are invalid for all the requests, and statuses are then not set.
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(RunBatch, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len* batch_size) const OrtValue* const* inputs, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Inout_updates_all_(output_names_len* batch_size) OrtValue** outputs, size_t batch_size,
+                  _Out_writes_all_(batch_size) OrtStatus** statuses);
+
+  /// \name OrtPreparedRun
+  /// @{
+
+  /** \brief Prepare runs of a session with fixed input and output names, and inputs of fixed types and shapes
+   *
+   * OrtApi::Run resolves the names, validates the inputs against the model and looks up the version of the model
+   * specialized for their shapes on every call, which for small models takes as long as running them. A prepared run
+   * does that once, and OrtApi::RunPrepared only checks that its inputs have the element types, shapes and devices of
+   * the inputs given here, so that they may differ by their data only.
+   *
+   * The prepared run must be released before the session. It may be run by several threads at once.
+   *
+   * \param[in] session
+   * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names
+   * \param[in] inputs Array of tensors of input_len ::OrtValue%s, whose element types, shapes and devices the inputs of
+   *            the runs must have. Their data isn't used.
+   * \param[in] input_len Number of elements in the input_names and inputs arrays
+   * \param[in] output_names Array of null terminated UTF8 encoded strings of the output names
+   * \param[in] output_names_len Number of elements in the output_names array
+   * \param[out] out Must be freed by OrtApi::ReleasePreparedRun
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(CreatePreparedRun, _Inout_ OrtSession* session,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Outptr_ OrtPreparedRun** out);
+
+  /** \brief Run a run prepared by OrtApi::CreatePreparedRun
+   *
+   * \param[in] session The session the run was prepared with
+   * \param[in] run_options If nullptr, will use a default ::OrtRunOptions
+   * \param[in] prepared_run
+   * \param[in] inputs Array of ::OrtValue%s in the order of the input names of the prepared run, of the element types,
+   *            shapes and devices it was prepared for
+   * \param[in] input_len Number of elements in the inputs array
+   * \param[in,out] outputs Array of ::OrtValue%s in the order of the output names of the prepared run, as in
+   *                OrtApi::Run
+   * \param[in] output_len Number of elements in the outputs array
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(RunPrepared, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _In_ const OrtPreparedRun* prepared_run,
+                  _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                  _Inout_updates_all_(output_len) OrtValue** outputs, size_t output_len);
+
+  /** \brief Release an ::OrtPreparedRun
+   *
+   * \since Version 1.17.
+   */
+  ORT_CLASS_RELEASE(PreparedRun);
+
+  /// @}
+
+  /** \brief Clone an initialized session for another worker thread
+   *
+   * The clone shares the model, the kernels, execution plans, initializers and prepacked weights, the execution
+   * providers and their allocators, and the thread pools of the session, so creating it costs no more memory than
+   * the run state of its runs. It has its own logger, metrics and run counters. Its kernels log and profile through
+   * the session it was cloned from, and it doesn't create versions of the model specialized for the shapes of its
+   * inputs.
+   *
+   * A session can't be cloned if one of its execution providers doesn't support concurrent runs or captures graphs.
+   * The clone must be released before the session it was cloned from.
+   *
+   * \param[in] session An initialized session
+   * \param[out] out Must be freed by OrtApi::ReleaseSession
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(CloneSession, _In_ const OrtSession* session, _Outptr_ OrtSession** out);
+
+  /// \name OrtSwappableSession
+  /// @{
+
+  /** \brief Create a session whose model can be replaced while it runs
+   *
+   * OrtApi::SwappableSessionSwap creates and initializes the session of a new model on a background thread, warms it
+   * up with zero filled inputs of the shapes of the inputs of recent runs, then makes the runs that start afterwards
+   * use it while the runs in flight finish on the previous session. The initializers of the new model with the
+   * element type, shape and content of an initializer of the current model are shared with the current session.
+   *
+   * \param[in] env
+   * \param[in] model_path The model of the first session, which is created before returning
+   * \param[in] options The options of the sessions of all the models. If nullptr, the default options are used.
+   * \param[in] max_warmup_shapes Number of distinct sets of input shapes recorded from the runs to warm up the new
+   *            sessions. 0 disables the warm up.
+   * \param[in] warmup_max_degree_of_parallelism Maximum degree of parallelism of the warm up runs, so that they take
+   *            few threads from the runs of the current session when the intra op thread pool is shared. 0 means no
+   *            limit.
+   * \param[out] out Must be released with OrtApi::ReleaseSwappableSession
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(CreateSwappableSession, _In_ const OrtEnv* env, _In_ const ORTCHAR_T* model_path,
+                  _In_opt_ const OrtSessionOptions* options, size_t max_warmup_shapes,
+                  int warmup_max_degree_of_parallelism, _Outptr_ OrtSwappableSession** out);
+
+  /** \brief Run the current model of a swappable session, as OrtApi::Run
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(SwappableSessionRun, _Inout_ OrtSwappableSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Inout_updates_all_(output_names_len) OrtValue** outputs);
+
+  /** \brief Start replacing the model of a swappable session
+   *
+   * Returns once the new session is being created on a background thread. Fails if a swap is in progress.
+   *
+   * \param[in] session
+   * \param[in] model_path The new model
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(SwappableSessionSwap, _Inout_ OrtSwappableSession* session, _In_ const ORTCHAR_T* model_path);
+
+  /** \brief Wait for the swap in progress, if any
+   *
+   * \param[in] session
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   * The error of the last swap, in which case the model wasn't replaced.
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(SwappableSessionWaitForSwap, _Inout_ OrtSwappableSession* session);
+
+  /** \brief Release an ::OrtSwappableSession, waiting for the swap in progress
+   *
+   * \since Version 1.17.
+   */
+  ORT_CLASS_RELEASE(SwappableSession);
+
+  /// @}
+
+  /** \brief Create a session running an ensemble of models linked by named edges
+   *
+   * The models are composed into one model, so that the ensemble is optimized and planned as a whole: the members
+   * share the memory arena and plan of the session, the values passing along edges are neither copied nor moved
+   * off their device, and independent members run concurrently if the execution mode of the options is
+   * ::ExecutionMode::ORT_PARALLEL. The session is an ordinary ::OrtSession.
+   *
+   * The values of member m are named "m/<value>" in the session. Its inputs are the inputs of the members without
+   * an edge and its outputs the outputs of the members that feed no edge. The members must import the same version
+   * of the opsets they share, and members with external data must be in the directory of the first member.
+   *
+   * \param[in] env
+   * \param[in] member_names Names of the members
+   * \param[in] member_paths Paths of the ONNX models of the members
+   * \param[in] num_members Number of elements in the member_names and member_paths arrays
+   * \param[in] edge_producers Name of the member producing the value of each edge
+   * \param[in] edge_outputs Name of the output of the producer each edge passes on
+   * \param[in] edge_consumers Name of the member consuming the value of each edge
+   * \param[in] edge_inputs Name of the input of the consumer each edge feeds
+   * \param[in] num_edges Number of elements in the edge arrays
+   * \param[in] options If nullptr, will use the default options
+   * \param[out] out Must be freed by OrtApi::ReleaseSession
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(CreateEnsembleSession, _In_ const OrtEnv* env,
+                  _In_reads_(num_members) const char* const* member_names,
+                  _In_reads_(num_members) const ORTCHAR_T* const* member_paths, size_t num_members,
+                  _In_reads_(num_edges) const char* const* edge_producers,
+                  _In_reads_(num_edges) const char* const* edge_outputs,
+                  _In_reads_(num_edges) const char* const* edge_consumers,
+                  _In_reads_(num_edges) const char* const* edge_inputs, size_t num_edges,
+                  _In_opt_ const OrtSessionOptions* options, _Outptr_ OrtSession** out);
+
+  /** \brief Allocate a scratch buffer for a kernel call
+   *
+   * The buffer is allocated by the allocator of the session for the device of `mem_info`, which is the memory arena
+   * of the device unless it is disabled, so a custom op can get the temporary memory of each call without going
+   * through the system allocator. It must be freed with the OrtAllocator::Free of the allocator that
+   * OrtApi::KernelContext_GetAllocator returns for the same `mem_info`, before the kernel call returns.
+   *
+   * \param[in] context Kernel context
+   * \param[in] mem_info Memory info of the device to allocate the buffer on
+   * \param[in] size Size of the buffer in bytes
+   * \param[out] out The buffer. nullptr if `size` is 0.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(KernelContext_GetScratchBuffer, _In_ const OrtKernelContext* context,
+                  _In_ const OrtMemoryInfo* mem_info, _In_ size_t size, _Outptr_result_maybenull_ void** out);
+
+  /** \brief Hand a buffer packed by OrtCustomOp::KernelPrePack over to the session to be shared
+   *
+   * The buffer must be allocated with the allocator passed to OrtCustomOp::KernelPrePack, and is owned by the
+   * session once added. The kernel gets the buffers of the weight to use, either the ones it added or the ones a
+   * kernel of another session packed identically, in OrtCustomOp::KernelUseSharedPrePackedBuffers, in the order
+   * they were added.
+   *
+   * \param[in] prepacked_weights The ::OrtPrePackedWeights passed to OrtCustomOp::KernelPrePack
+   * \param[in] buffer Packed buffer
+   * \param[in] size Size of the buffer in bytes
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.17.
+   */
+  ORT_API2_STATUS(PrePackedWeights_AddBuffer, _Inout_ OrtPrePackedWeights* prepacked_weights, _In_ void* buffer,
+                  _In_ size_t size);
 };
 
 /*
@@ -4612,6 +5229,23 @@ struct OrtCustomOp {
   // Get start range
   int(ORT_API_CALL* GetStartVersion)(_In_ const struct OrtCustomOp* op);
   int(ORT_API_CALL* GetEndVersion)(_In_ const struct OrtCustomOp* op);
+
+  // Optional. Called once for each input of the node that is a constant initializer when the session is initialized,
+  // so that the kernel can pack the weight into the layout it computes with once, instead of at each call. The
+  // packed buffers must be allocated with `allocator`. Set `is_packed` to 1 if the kernel packed the weight, in
+  // which case the initializer may be released and the input is not available to the compute callback anymore.
+  // `prepacked_weights` is not nullptr if the session shares the packed weights: the kernel must then hand its
+  // buffers over with OrtApi::PrePackedWeights_AddBuffer and use the ones passed to
+  // KernelUseSharedPrePackedBuffers. Ops without KernelUseSharedPrePackedBuffers aren't pre-packed in that case.
+  OrtStatusPtr(ORT_API_CALL* KernelPrePack)(_In_ void* op_kernel, _In_ const OrtValue* tensor, _In_ int input_index,
+                                            _Inout_ OrtAllocator* allocator,
+                                            _In_opt_ OrtPrePackedWeights* prepacked_weights, _Out_ int* is_packed);
+
+  // Optional. Called after KernelPrePack packed the input with a non null `prepacked_weights`, with the shared
+  // buffers the kernel must use for the input. They are owned by the session and valid while the kernel exists.
+  OrtStatusPtr(ORT_API_CALL* KernelUseSharedPrePackedBuffers)(_In_ void* op_kernel, _In_ int input_index,
+                                                              _In_reads_(num_buffers) void* const* buffers,
+                                                              _In_ size_t num_buffers);
 };
 
 /*
@@ -522,6 +522,10 @@ ORT_DEFINE_RELEASE(Status);
 ORT_DEFINE_RELEASE(OpAttr);
 ORT_DEFINE_RELEASE(Op);
 ORT_DEFINE_RELEASE(KernelInfo);
+ORT_DEFINE_RELEASE(RunPipeline);
+ORT_DEFINE_RELEASE(RequestBatcher);
+ORT_DEFINE_RELEASE(PreparedRun);
+ORT_DEFINE_RELEASE(SwappableSession);
 
 #undef ORT_DEFINE_RELEASE
 
@@ -721,6 +725,8 @@ struct Env : detail::Base<OrtEnv> {
   Env& CreateAndRegisterAllocator(const OrtMemoryInfo* mem_info, const OrtArenaCfg* arena_cfg);  ///< Wraps OrtApi::CreateAndRegisterAllocator
 
   Env& CreateAndRegisterAllocatorV2(const std::string& provider_type, const OrtMemoryInfo* mem_info, const std::unordered_map<std::string, std::string>& options, const OrtArenaCfg* arena_cfg);  ///< Wraps OrtApi::CreateAndRegisterAllocatorV2
+
+  Env& CreateAndRegisterActivationPool(const OrtMemoryInfo* mem_info, size_t max_bytes, int64_t admission_timeout_ms);  ///< Wraps OrtApi::CreateAndRegisterActivationPool
 };
 
 /** \brief Custom Op Domain
@@ -985,6 +991,7 @@ struct ModelMetadata : detail::Base<OrtModelMetadata> {
 };
 
 struct IoBinding;
+struct PreparedRun;
 
 namespace detail {
 
@@ -1029,6 +1036,27 @@ struct ConstSessionImpl : Base<T> {
   uint64_t GetProfilingStartTimeNs() const;  ///< Wraps OrtApi::SessionGetProfilingStartTimeNs
   ModelMetadata GetModelMetadata() const;    ///< Wraps OrtApi::SessionGetModelMetadata
 
+  /** \brief Returns a snapshot of the session metrics in the Prometheus text format
+   *
+   * \return a instance of smart pointer that would deallocate the buffer when out of scope.
+   *  The OrtAllocator instances must be valid at the point of memory release.
+   */
+  AllocatedStringPtr GetMetricsSnapshotAllocated(OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetMetricsSnapshot
+
+  /** \brief Returns the kernel variants the nodes dispatched to in their last Run, as JSON
+   *
+   * \return a instance of smart pointer that would deallocate the buffer when out of scope.
+   *  The OrtAllocator instances must be valid at the point of memory release.
+   */
+  AllocatedStringPtr GetKernelDispatchesAllocated(OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetKernelDispatches
+
+  /** \brief Returns the time the session spent in each phase of its creation, as JSON
+   *
+   * \return a instance of smart pointer that would deallocate the buffer when out of scope.
+   *  The OrtAllocator instances must be valid at the point of memory release.
+   */
+  AllocatedStringPtr GetStartupTimingsAllocated(OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetStartupTimings
+
   TypeInfo GetInputTypeInfo(size_t index) const;                   ///< Wraps OrtApi::SessionGetInputTypeInfo
   TypeInfo GetOutputTypeInfo(size_t index) const;                  ///< Wraps OrtApi::SessionGetOutputTypeInfo
   TypeInfo GetOverridableInitializerTypeInfo(size_t index) const;  ///< Wraps OrtApi::SessionGetOverridableInitializerTypeInfo
@@ -1067,6 +1095,40 @@ struct SessionImpl : ConstSessionImpl<T> {
 
   void Run(const RunOptions& run_options, const IoBinding&);  ///< Wraps OrtApi::RunWithBinding
 
+  /** \brief Run a run prepared with this session
+   *
+   * Wraps OrtApi::RunPrepared
+   *
+   * \param[in] run_options
+   * \param[in] prepared_run
+   * \param[in] input_values Array of Value objects in the order of the input names of prepared_run
+   * \param[in] input_count Number of elements in the input_values array
+   * \param[in,out] output_values Array of Value objects in the order of the output names of prepared_run, filled as
+   *                in Run
+   * \param[in] output_count Number of elements in the output_values array
+   */
+  void Run(const RunOptions& run_options, const PreparedRun& prepared_run, const Value* input_values,
+           size_t input_count, Value* output_values, size_t output_count);
+
+  /** \brief Run a batch of independent requests with the same input and output names
+   *
+   * Wraps OrtApi::RunBatch
+   *
+   * \param[in] run_options
+   * \param[in] input_names Array of C style strings of length input_count that is the list of input names
+   * \param[in] input_values Array of input_count * batch_size Value objects, the inputs of each request in turn
+   * \param[in] input_count Number of inputs of a request
+   * \param[in] output_names Array of C style strings of length output_count that is the list of output names
+   * \param[in,out] output_values Array of output_count * batch_size Value objects, the outputs of each request in
+   *                turn, filled as in Run
+   * \param[in] output_count Number of outputs of a request
+   * \param[in] batch_size Number of requests
+   * \return The Status of each request
+   */
+  std::vector<Status> RunBatch(const RunOptions& run_options, const char* const* input_names, const Value* input_values,
+                               size_t input_count, const char* const* output_names, Value* output_values,
+                               size_t output_count, size_t batch_size);
+
   /** \brief Run the model asynchronously in a thread owned by intra op thread pool
    *
    * Wraps OrtApi::RunAsync
@@ -1096,6 +1158,8 @@ struct SessionImpl : ConstSessionImpl<T> {
    *  The OrtAllocator instances must be valid at the point of memory release.
    */
   AllocatedStringPtr EndProfilingAllocated(OrtAllocator* allocator);  ///< Wraps OrtApi::SessionEndProfiling
+
+  void CompactArena(const OrtMemoryInfo* mem_info);  ///< Wraps OrtApi::CompactArena
 };
 
 }  // namespace detail
@@ -1114,6 +1178,22 @@ struct Session : detail::SessionImpl<OrtSession> {
   Session(const Env& env, const void* model_data, size_t model_data_length, const SessionOptions& options);  ///< Wraps OrtApi::CreateSessionFromArray
   Session(const Env& env, const void* model_data, size_t model_data_length, const SessionOptions& options,
           OrtPrepackedWeightsContainer* prepacked_weights_container);  ///< Wraps OrtApi::CreateSessionFromArrayWithPrepackedWeightsContainer
+  explicit Session(OrtSession* p) : SessionImpl<OrtSession>{p} {}                     ///< Takes ownership of a pointer created by C Api
+
+  /** \brief Clone the session for another worker thread, sharing its kernels and weights
+   *
+   * Wraps OrtApi::CloneSession. The clone must be destroyed before this session.
+   */
+  Session Clone() const;
+
+  /** \brief Create a session running an ensemble of models linked by named edges
+   *
+   * Wraps OrtApi::CreateEnsembleSession
+   */
+  static Session CreateEnsemble(const Env& env, const char* const* member_names, const ORTCHAR_T* const* member_paths,
+                                size_t num_members, const char* const* edge_producers, const char* const* edge_outputs,
+                                const char* const* edge_consumers, const char* const* edge_inputs, size_t num_edges,
+                                const SessionOptions& options);
 
   ConstSession GetConst() const { return ConstSession{this->p_}; }
   UnownedSession GetUnowned() const { return UnownedSession{this->p_}; }
@@ -1838,6 +1918,8 @@ struct IoBindingImpl : ConstIoBindingImpl<T> {
   void BindInput(const char* name, const Value&);
   void BindOutput(const char* name, const Value&);
   void BindOutput(const char* name, const OrtMemoryInfo*);
+  void BindOutputToRingBuffer(const char* name, const OrtMemoryInfo* mem_info, void* base, size_t capacity_bytes,
+                              size_t stride_bytes, OrtRingBufferPositionFn position_fn, void* user_data);  ///< Wraps OrtApi::BindOutputToRingBuffer
   void ClearBoundInputs();
   void ClearBoundOutputs();
   void SynchronizeInputs();
@@ -1859,6 +1941,62 @@ struct IoBinding : detail::IoBindingImpl<OrtIoBinding> {
   UnownedIoBinding GetUnowned() const { return UnownedIoBinding{this->p_}; }
 };
 
+/** \brief Wrapper around ::OrtRunPipeline
+ *
+ */
+struct RunPipeline : detail::Base<OrtRunPipeline> {
+  explicit RunPipeline(std::nullptr_t) {}  ///< Create an empty object, must be assigned a valid one to be used
+  RunPipeline(Session& session, const RunOptions& run_options, const char* const* input_names, size_t input_count,
+              const char* const* output_names, size_t output_count, size_t depth);  ///< Wraps OrtApi::CreateRunPipeline
+
+  void Submit(const Value* input_values, size_t input_count, RunAsyncCallbackFn callback,
+              void* user_data);  ///< Wraps OrtApi::RunPipelineSubmit
+  void Wait();                   ///< Wraps OrtApi::RunPipelineWait
+};
+
+/** \brief Wrapper around ::OrtRequestBatcher
+ *
+ */
+struct RequestBatcher : detail::Base<OrtRequestBatcher> {
+  explicit RequestBatcher(std::nullptr_t) {}  ///< Create an empty object, must be assigned a valid one to be used
+  RequestBatcher(Session& session, const RunOptions& run_options, const char* const* input_names, size_t input_count,
+                 const char* const* output_names, size_t output_count, size_t batch_axis, size_t max_batch_size,
+                 int64_t max_delay_us, const int64_t* padding_buckets = nullptr,
+                 size_t num_padding_buckets = 0);  ///< Wraps OrtApi::CreateRequestBatcher
+
+  void Submit(const Value* input_values, size_t input_count, RunAsyncCallbackFn callback,
+              void* user_data);  ///< Wraps OrtApi::RequestBatcherSubmit
+};
+
+/** \brief Wrapper around ::OrtPreparedRun
+ *
+ */
+struct PreparedRun : detail::Base<OrtPreparedRun> {
+  explicit PreparedRun(std::nullptr_t) {}  ///< Create an empty object, must be assigned a valid one to be used
+  PreparedRun(Session& session, const char* const* input_names, const Value* input_values, size_t input_count,
+              const char* const* output_names, size_t output_count);  ///< Wraps OrtApi::CreatePreparedRun
+};
+
+/** \brief Wrapper around ::OrtSwappableSession
+ *
+ */
+struct SwappableSession : detail::Base<OrtSwappableSession> {
+  explicit SwappableSession(std::nullptr_t) {}  ///< Create an empty object, must be assigned a valid one to be used
+  SwappableSession(const Env& env, const ORTCHAR_T* model_path, const SessionOptions& options,
+                   size_t max_warmup_shapes = 8,
+                   int warmup_max_degree_of_parallelism = 1);  ///< Wraps OrtApi::CreateSwappableSession
+
+  /** \brief Run the current model, as Session::Run
+   *
+   * Wraps OrtApi::SwappableSessionRun
+   */
+  std::vector<Value> Run(const RunOptions& run_options, const char* const* input_names, const Value* input_values,
+                         size_t input_count, const char* const* output_names, size_t output_count);
+
+  void Swap(const ORTCHAR_T* model_path);  ///< Wraps OrtApi::SwappableSessionSwap
+  void WaitForSwap();                      ///< Wraps OrtApi::SwappableSessionWaitForSwap
+};
+
 /*! \struct Ort::ArenaCfg
  * \brief it is a structure that represents the configuration of an arena based allocator
  * \details Please see docs/C_API.md for details
@@ -2056,6 +2194,10 @@ struct KernelContext {
   Logger GetLogger() const;
   OrtAllocator* GetAllocator(const OrtMemoryInfo& memory_info) const;
   OrtKernelContext* GetOrtKernelContext() const { return ctx_; }
+  void ParallelFor(void (*fn)(void*, size_t), size_t total, size_t num_batch, void* usr_data) const;
+  int GetDegreeOfParallelism() const;
+  /// Wraps OrtApi::KernelContext_GetScratchBuffer. Free with the allocator from GetAllocator(memory_info).
+  void* GetScratchBuffer(const OrtMemoryInfo& memory_info, size_t size) const;
 
  private:
   OrtKernelContext* ctx_;
@@ -2282,6 +2424,8 @@ struct CustomOpBase : OrtCustomOp {
     }
 
     SetShapeInferFn<TOp>(0);
+    SetPrePackFn<TKernel>(0);
+    SetUseSharedPrePackedBuffersFn<TKernel>(0);
 
     OrtCustomOp::GetStartVersion = [](const OrtCustomOp* this_) {
       return static_cast<const TOp*>(this_)->start_ver_;
@@ -2350,6 +2494,45 @@ struct CustomOpBase : OrtCustomOp {
     return {};
   }
 
+  // The kernel pre-packs its constant inputs if it has a method
+  //   Status PrePack(ConstValue tensor, int input_index, OrtAllocator* allocator,
+  //                  OrtPrePackedWeights* prepacked_weights, bool& is_packed)
+  // see OrtCustomOp::KernelPrePack
+  template <typename K>
+  decltype(&K::PrePack) SetPrePackFn(decltype(&K::PrePack)) {
+    OrtCustomOp::KernelPrePack = [](void* op_kernel, const OrtValue* tensor, int input_index, OrtAllocator* allocator,
+                                    OrtPrePackedWeights* prepacked_weights, int* is_packed) -> OrtStatusPtr {
+      bool packed = false;
+      Status status = static_cast<K*>(op_kernel)->PrePack(ConstValue{tensor}, input_index, allocator,
+                                                          prepacked_weights, packed);
+      *is_packed = packed ? 1 : 0;
+      return status.release();
+    };
+    return {};
+  }
+
+  template <typename K>
+  void SetPrePackFn(...) {
+    OrtCustomOp::KernelPrePack = {};
+  }
+
+  // The kernel uses pre-packed buffers shared between sessions if it has a method
+  //   Status UseSharedPrePackedBuffers(int input_index, void* const* buffers, size_t num_buffers)
+  // see OrtCustomOp::KernelUseSharedPrePackedBuffers
+  template <typename K>
+  decltype(&K::UseSharedPrePackedBuffers) SetUseSharedPrePackedBuffersFn(decltype(&K::UseSharedPrePackedBuffers)) {
+    OrtCustomOp::KernelUseSharedPrePackedBuffers = [](void* op_kernel, int input_index, void* const* buffers,
+                                                      size_t num_buffers) -> OrtStatusPtr {
+      return static_cast<K*>(op_kernel)->UseSharedPrePackedBuffers(input_index, buffers, num_buffers).release();
+    };
+    return {};
+  }
+
+  template <typename K>
+  void SetUseSharedPrePackedBuffersFn(...) {
+    OrtCustomOp::KernelUseSharedPrePackedBuffers = {};
+  }
+
   template <typename C>
   void SetShapeInferFn(...) {
     OrtCustomOp::InferOutputShapeFn = {};
@@ -336,6 +336,14 @@ inline void IoBindingImpl<T>::BindOutput(const char* name, const OrtMemoryInfo*
   ThrowOnError(GetApi().BindOutputToDevice(this->p_, name, mem_info));
 }
 
+template <typename T>
+inline void IoBindingImpl<T>::BindOutputToRingBuffer(const char* name, const OrtMemoryInfo* mem_info, void* base,
+                                                     size_t capacity_bytes, size_t stride_bytes,
+                                                     OrtRingBufferPositionFn position_fn, void* user_data) {
+  ThrowOnError(GetApi().BindOutputToRingBuffer(this->p_, name, mem_info, base, capacity_bytes, stride_bytes,
+                                               position_fn, user_data));
+}
+
 template <typename T>
 inline void IoBindingImpl<T>::ClearBoundInputs() {
   GetApi().ClearBoundInputs(this->p_);
@@ -424,6 +432,73 @@ inline IoBinding::IoBinding(Session& session) {
   ThrowOnError(GetApi().CreateIoBinding(session, &this->p_));
 }
 
+inline RunPipeline::RunPipeline(Session& session, const RunOptions& run_options, const char* const* input_names,
+                                size_t input_count, const char* const* output_names, size_t output_count,
+                                size_t depth) {
+  ThrowOnError(GetApi().CreateRunPipeline(session, run_options, input_names, input_count, output_names, output_count,
+                                          depth, &this->p_));
+}
+
+inline void RunPipeline::Submit(const Value* input_values, size_t input_count, RunAsyncCallbackFn callback,
+                                void* user_data) {
+  auto ort_input_values = reinterpret_cast<const OrtValue* const*>(input_values);
+  ThrowOnError(GetApi().RunPipelineSubmit(this->p_, ort_input_values, input_count, callback, user_data));
+}
+
+inline void RunPipeline::Wait() {
+  ThrowOnError(GetApi().RunPipelineWait(this->p_));
+}
+
+inline RequestBatcher::RequestBatcher(Session& session, const RunOptions& run_options, const char* const* input_names,
+                                      size_t input_count, const char* const* output_names, size_t output_count,
+                                      size_t batch_axis, size_t max_batch_size, int64_t max_delay_us,
+                                      const int64_t* padding_buckets, size_t num_padding_buckets) {
+  ThrowOnError(GetApi().CreateRequestBatcher(session, run_options, input_names, input_count, output_names,
+                                             output_count, batch_axis, max_batch_size, max_delay_us, padding_buckets,
+                                             num_padding_buckets, &this->p_));
+}
+
+inline void RequestBatcher::Submit(const Value* input_values, size_t input_count, RunAsyncCallbackFn callback,
+                                   void* user_data) {
+  auto ort_input_values = reinterpret_cast<const OrtValue* const*>(input_values);
+  ThrowOnError(GetApi().RequestBatcherSubmit(this->p_, ort_input_values, input_count, callback, user_data));
+}
+
+inline PreparedRun::PreparedRun(Session& session, const char* const* input_names, const Value* input_values,
+                                size_t input_count, const char* const* output_names, size_t output_count) {
+  auto ort_input_values = reinterpret_cast<const OrtValue* const*>(input_values);
+  ThrowOnError(GetApi().CreatePreparedRun(session, input_names, ort_input_values, input_count, output_names,
+                                          output_count, &this->p_));
+}
+
+inline SwappableSession::SwappableSession(const Env& env, const ORTCHAR_T* model_path, const SessionOptions& options,
+                                          size_t max_warmup_shapes, int warmup_max_degree_of_parallelism) {
+  ThrowOnError(GetApi().CreateSwappableSession(env, model_path, options, max_warmup_shapes,
+                                               warmup_max_degree_of_parallelism, &this->p_));
+}
+
+inline std::vector<Value> SwappableSession::Run(const RunOptions& run_options, const char* const* input_names,
+                                                const Value* input_values, size_t input_count,
+                                                const char* const* output_names, size_t output_count) {
+  std::vector<Value> output_values;
+  output_values.reserve(output_count);
+  for (size_t i = 0; i < output_count; i++)
+    output_values.emplace_back(nullptr);
+  auto ort_input_values = reinterpret_cast<const OrtValue* const*>(input_values);
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values.data());
+  ThrowOnError(GetApi().SwappableSessionRun(this->p_, run_options, input_names, ort_input_values, input_count,
+                                            output_names, output_count, ort_output_values));
+  return output_values;
+}
+
+inline void SwappableSession::Swap(const ORTCHAR_T* model_path) {
+  ThrowOnError(GetApi().SwappableSessionSwap(this->p_, model_path));
+}
+
+inline void SwappableSession::WaitForSwap() {
+  ThrowOnError(GetApi().SwappableSessionWaitForSwap(this->p_));
+}
+
 inline ArenaCfg::ArenaCfg(size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes, int max_dead_bytes_per_chunk) {
   ThrowOnError(GetApi().CreateArenaCfg(max_mem, arena_extend_strategy, initial_chunk_size_bytes, max_dead_bytes_per_chunk, &p_));
 }
@@ -539,6 +614,12 @@ inline Env& Env::CreateAndRegisterAllocatorV2(const std::string& provider_type,
   return *this;
 }
 
+inline Env& Env::CreateAndRegisterActivationPool(const OrtMemoryInfo* mem_info, size_t max_bytes,
+                                                 int64_t admission_timeout_ms) {
+  ThrowOnError(GetApi().CreateAndRegisterActivationPool(p_, mem_info, max_bytes, admission_timeout_ms));
+  return *this;
+}
+
 inline CustomOpDomain::CustomOpDomain(const char* domain) {
   ThrowOnError(GetApi().CreateCustomOpDomain(domain, &p_));
 }
@@ -928,6 +1009,27 @@ inline uint64_t ConstSessionImpl<T>::GetProfilingStartTimeNs() const {
   return out;
 }
 
+template <typename T>
+inline AllocatedStringPtr ConstSessionImpl<T>::GetMetricsSnapshotAllocated(OrtAllocator* allocator) const {
+  char* out = nullptr;
+  ThrowOnError(GetApi().SessionGetMetricsSnapshot(this->p_, allocator, &out));
+  return AllocatedStringPtr(out, detail::AllocatedFree(allocator));
+}
+
+template <typename T>
+inline AllocatedStringPtr ConstSessionImpl<T>::GetKernelDispatchesAllocated(OrtAllocator* allocator) const {
+  char* out = nullptr;
+  ThrowOnError(GetApi().SessionGetKernelDispatches(this->p_, allocator, &out));
+  return AllocatedStringPtr(out, detail::AllocatedFree(allocator));
+}
+
+template <typename T>
+inline AllocatedStringPtr ConstSessionImpl<T>::GetStartupTimingsAllocated(OrtAllocator* allocator) const {
+  char* out = nullptr;
+  ThrowOnError(GetApi().SessionGetStartupTimings(this->p_, allocator, &out));
+  return AllocatedStringPtr(out, detail::AllocatedFree(allocator));
+}
+
 template <typename T>
 inline ModelMetadata ConstSessionImpl<T>::GetModelMetadata() const {
   OrtModelMetadata* out;
@@ -981,6 +1083,35 @@ inline void SessionImpl<T>::Run(const RunOptions& run_options, const IoBinding&
   ThrowOnError(GetApi().RunWithBinding(this->p_, run_options, io_binding));
 }
 
+template <typename T>
+inline void SessionImpl<T>::Run(const RunOptions& run_options, const PreparedRun& prepared_run,
+                                const Value* input_values, size_t input_count, Value* output_values,
+                                size_t output_count) {
+  static_assert(sizeof(Value) == sizeof(OrtValue*), "Value is really just an array of OrtValue* in memory, so we can reinterpret_cast safely");
+  auto ort_input_values = reinterpret_cast<const OrtValue* const*>(input_values);
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  ThrowOnError(GetApi().RunPrepared(this->p_, run_options, prepared_run, ort_input_values, input_count,
+                                    ort_output_values, output_count));
+}
+
+template <typename T>
+inline std::vector<Status> SessionImpl<T>::RunBatch(const RunOptions& run_options, const char* const* input_names,
+                                                    const Value* input_values, size_t input_count,
+                                                    const char* const* output_names, Value* output_values,
+                                                    size_t output_count, size_t batch_size) {
+  auto ort_input_values = reinterpret_cast<const OrtValue* const*>(input_values);
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  std::vector<OrtStatus*> ort_statuses(batch_size, nullptr);
+  ThrowOnError(GetApi().RunBatch(this->p_, run_options, input_names, ort_input_values, input_count, output_names,
+                                 output_count, ort_output_values, batch_size, ort_statuses.data()));
+  std::vector<Status> statuses;
+  statuses.reserve(batch_size);
+  for (OrtStatus* ort_status : ort_statuses) {
+    statuses.emplace_back(ort_status);
+  }
+  return statuses;
+}
+
 template <typename T>
 inline void SessionImpl<T>::RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
                                      const char* const* output_names, Value* output_values, size_t output_count, RunAsyncCallbackFn callback, void* user_data) {
@@ -998,6 +1129,11 @@ inline AllocatedStringPtr SessionImpl<T>::EndProfilingAllocated(OrtAllocator* al
   return AllocatedStringPtr(out, detail::AllocatedFree(allocator));
 }
 
+template <typename T>
+inline void SessionImpl<T>::CompactArena(const OrtMemoryInfo* mem_info) {
+  ThrowOnError(GetApi().CompactArena(this->p_, mem_info));
+}
+
 }  // namespace detail
 
 inline SessionOptions::SessionOptions() {
@@ -1044,6 +1180,23 @@ inline Session::Session(const Env& env, const void* model_data, size_t model_dat
                                                                             prepacked_weights_container, &this->p_));
 }
 
+inline Session Session::Clone() const {
+  OrtSession* out;
+  ThrowOnError(GetApi().CloneSession(this->p_, &out));
+  return Session{out};
+}
+
+inline Session Session::CreateEnsemble(const Env& env, const char* const* member_names,
+                                       const ORTCHAR_T* const* member_paths, size_t num_members,
+                                       const char* const* edge_producers, const char* const* edge_outputs,
+                                       const char* const* edge_consumers, const char* const* edge_inputs,
+                                       size_t num_edges, const SessionOptions& options) {
+  OrtSession* out;
+  ThrowOnError(GetApi().CreateEnsembleSession(env, member_names, member_paths, num_members, edge_producers,
+                                              edge_outputs, edge_consumers, edge_inputs, num_edges, options, &out));
+  return Session{out};
+}
+
 inline AllocatedStringPtr ModelMetadata::GetProducerNameAllocated(OrtAllocator* allocator) const {
   char* out;
   ThrowOnError(GetApi().ModelMetadataGetProducerName(p_, allocator, &out));
@@ -1652,6 +1805,23 @@ inline Logger KernelContext::GetLogger() const {
   return Logger{out};
 }
 
+inline void KernelContext::ParallelFor(void (*fn)(void*, size_t), size_t total, size_t num_batch,
+                                       void* usr_data) const {
+  ThrowOnError(GetApi().KernelContext_ParallelFor(ctx_, fn, total, num_batch, usr_data));
+}
+
+inline int KernelContext::GetDegreeOfParallelism() const {
+  int out = 1;
+  ThrowOnError(GetApi().KernelContext_GetDegreeOfParallelism(ctx_, &out));
+  return out;
+}
+
+inline void* KernelContext::GetScratchBuffer(const OrtMemoryInfo& memory_info, size_t size) const {
+  void* out = nullptr;
+  ThrowOnError(GetApi().KernelContext_GetScratchBuffer(ctx_, &memory_info, size, &out));
+  return out;
+}
+
 inline OpAttr::OpAttr(const char* name, const void* data, int len, OrtOpAttrType type) {
   Ort::ThrowOnError(GetApi().CreateOpAttr(name, data, len, type, &p_));
 }
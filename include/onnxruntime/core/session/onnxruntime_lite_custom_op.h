@@ -853,6 +853,9 @@ struct OrtLiteCustomOp : public OrtCustomOp {
 
     OrtCustomOp::InferOutputShapeFn = {};
 
+    OrtCustomOp::KernelPrePack = {};
+    OrtCustomOp::KernelUseSharedPrePackedBuffers = {};
+
     OrtCustomOp::GetStartVersion = [](const OrtCustomOp* op) {
       auto self = reinterpret_cast<const OrtLiteCustomOp*>(op);
       return self->start_ver_;
@@ -1038,6 +1041,8 @@ struct OrtLiteCustomStruct : public OrtLiteCustomOp {
     };
 
     SetShapeInfer<CustomOp>(0);
+    SetPrePack<CustomOp>(0);
+    SetUseSharedPrePackedBuffers<CustomOp>(0);
   }
 
   template <typename... Args>
@@ -1075,6 +1080,38 @@ struct OrtLiteCustomStruct : public OrtLiteCustomOp {
   void SetShapeInfer(...) {
     OrtCustomOp::InferOutputShapeFn = {};
   }
+
+  // see CustomOpBase::SetPrePackFn for the signature of CustomOp::PrePack
+  template <typename C>
+  decltype(&C::PrePack) SetPrePack(decltype(&C::PrePack)) {
+    OrtCustomOp::KernelPrePack = [](void* op_kernel, const OrtValue* tensor, int input_index, OrtAllocator* allocator,
+                                    OrtPrePackedWeights* prepacked_weights, int* is_packed) -> OrtStatusPtr {
+      auto kernel = reinterpret_cast<Kernel*>(op_kernel);
+      bool packed = false;
+      Status status = kernel->custom_op_->PrePack(ConstValue{tensor}, input_index, allocator, prepacked_weights,
+                                                  packed);
+      *is_packed = packed ? 1 : 0;
+      return status.release();
+    };
+    return {};
+  }
+
+  template <typename C>
+  void SetPrePack(...) {}
+
+  // see CustomOpBase::SetUseSharedPrePackedBuffersFn for the signature of CustomOp::UseSharedPrePackedBuffers
+  template <typename C>
+  decltype(&C::UseSharedPrePackedBuffers) SetUseSharedPrePackedBuffers(decltype(&C::UseSharedPrePackedBuffers)) {
+    OrtCustomOp::KernelUseSharedPrePackedBuffers = [](void* op_kernel, int input_index, void* const* buffers,
+                                                      size_t num_buffers) -> OrtStatusPtr {
+      auto kernel = reinterpret_cast<Kernel*>(op_kernel);
+      return kernel->custom_op_->UseSharedPrePackedBuffers(input_index, buffers, num_buffers).release();
+    };
+    return {};
+  }
+
+  template <typename C>
+  void SetUseSharedPrePackedBuffers(...) {}
 };  // struct OrtLiteCustomStruct
 
 /////////////////////////// CreateLiteCustomOp ////////////////////////////
@@ -30,3 +30,33 @@ static const char* const kOrtRunOptionsConfigEnableMemoryArenaShrinkage = "memor
 // Per default it will be set to '0'
 // Taking CUDA EP as an example, it omit triggering cudaStreamSynchronize on the compute stream.
 static const char* const kOrtRunOptionsConfigDisableSynchronizeExecutionProviders = "disable_synchronize_execution_providers";
+
+// Overrides the session's "session.intra_op.priority" for this Run.
+// "normal" or "high". By default the session setting is used.
+static const char* const kOrtRunOptionsConfigIntraOpPriority = "run.intra_op.priority";
+
+// Overrides the session's "session.intra_op.max_degree_of_parallelism" for this Run.
+// A non-negative integer, "0" means no limit. By default the session setting is used.
+static const char* const kOrtRunOptionsConfigIntraOpMaxDegreeOfParallelism = "run.intra_op.max_degree_of_parallelism";
+
+// Selects the CUDA graph that this Run captures or replays when the CUDA graph is enabled for the EP.
+// A non-negative integer; runs with the same id share a graph, so they must bind inputs and outputs of the same shapes
+// at the same addresses. "-1" runs the model without capturing or replaying a graph.
+// By default, the graph is selected by the shapes of the inputs, so each input shape has its own graph.
+static const char* const kOrtRunOptionsConfigCudaGraphId = "gpu_graph_id";
+
+// Trace context of the Run passed to the OrtTraceSpanFunction of the session with each span of the Run, so the spans
+// can be attached to the distributed trace of the request, e.g. a W3C traceparent header
+// "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01". It isn't interpreted by onnxruntime.
+// By default it is empty.
+static const char* const kOrtRunOptionsConfigTraceContext = "run.trace_context";
+
+// The state context of the Run when the session declares state variables, see "session.state_variables". The Runs
+// with the same context read the state the previous one computed and run one after the other, and the Runs with
+// different contexts, e.g. one per stream of a streaming speech recognizer, run concurrently.
+// By default the Run is in the "" context.
+static const char* const kOrtRunOptionsConfigStateContext = "run.state_context";
+
+// Set to "1" to release the state of the state context of the Run once it completes, e.g. at the end of a stream.
+// By default the state is kept for the next Run.
+static const char* const kOrtRunOptionsConfigEndStateContext = "run.state_context.end";
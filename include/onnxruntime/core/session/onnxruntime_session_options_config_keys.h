@@ -20,10 +20,27 @@
 // If the config value is set to "1" then the prepacking is disabled, otherwise prepacking is enabled (default value)
 static const char* const kOrtSessionOptionsConfigDisablePrepacking = "session.disable_prepacking";
 
+// Path of a file to persist the pre-packed weights of CPU kernels to.
+// The first session writes the weights it packs to the file, and later sessions memory map the file and use the
+// weights in it instead of packing them again, which shortens their initialization. Processes using the same file
+// share the physical memory of the weights. Weights are looked up by kernel and the contents of the initializer,
+// so the file can be shared by several models, and the file is ignored on a CPU with other instruction set
+// extensions. Only kernels that implement OpKernel::UsePersistedPrePackedBuffers() use the file.
+// Not used for initializers shared with a PrepackedWeightsContainer. Empty: disabled. [DEFAULT]
+static const char* const kOrtSessionOptionsConfigPrepackedWeightsFile = "session.prepacked_weights_file";
+
 // A value of "1" means allocators registered in the env will be used. "0" means the allocators created in the session
 // will be used. Use this to override the usage of env allocators on a per session level.
 static const char* const kOrtSessionOptionsConfigUseEnvAllocators = "session.use_env_allocators";
 
+// Key for using the activation pools registered with the environment (see OrtApi::CreateAndRegisterActivationPool).
+// When enabled, each Run takes the single buffer its memory pattern needs from the pool, waiting for other Runs to
+// return theirs if the pool is full, so the activation memory of many sessions is bounded by the pool size.
+// Requires memory pattern optimization. Has no effect on subgraphs.
+// "0": default, the memory pattern buffer is allocated from the session allocator.
+// "1": use the environment activation pool of the device if one is registered.
+static const char* const kOrtSessionOptionsConfigUseEnvActivationPool = "session.use_env_activation_pool";
+
 // Set to 'ORT' (case sensitive) to load an ORT format model.
 // If unset, model type will default to ONNX unless inferred from filename ('.ort' == ORT format) or bytes to be ORT
 static const char* const kOrtSessionOptionsConfigLoadModelFormat = "session.load_model_format";
@@ -67,6 +84,41 @@ static const char* const kOrtSessionOptionsEnableQuantQDQCleanup = "session.enab
 // GeluApproximation has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimization.enable_gelu_approximation";
 
+// Enable or disable the fusion of chains of element-wise nodes assigned to the CPU EP into FusedElementwise nodes.
+// "0": disable; "1": enable. The default is "0".
+static const char* const kOrtSessionOptionsEnableElementwiseChainFusion =
+    "optimization.enable_elementwise_chain_fusion";
+
+// Enable or disable the fusion of DequantizeLinear nodes of float 8 tensors, MatMul and QuantizeLinear nodes assigned
+// to the CUDA EP into GemmFloat8. "0": disable; "1": enable. The default is "0".
+// GemmFloat8 requires a GPU with float 8 tensor cores (compute capability 8.9 or higher), which graph optimization
+// can't check, so it is disabled by default.
+static const char* const kOrtSessionOptionsEnableGemmFloat8Fusion = "optimization.enable_gemm_float8_fusion";
+
+// Convert the Attention and MultiHeadAttention nodes assigned to the CUDA EP whose mask has the sequence lengths with
+// shape (batch_size), and the token-wise nodes around them such as MatMul and LayerNormalization, to packing mode, so
+// they only compute the real tokens of batches that are padded on the right. "0": disable; "1": enable.
+// The default is "0". The padding positions of the outputs of the converted nodes are zeros after the conversion.
+static const char* const kOrtSessionOptionsEnablePackingMode = "optimization.enable_packing_mode";
+
+// Convert the float nodes assigned to the CUDA, ROCm or DML EP whose ops are safe to run in reduced precision,
+// such as MatMul, Conv and the element-wise arithmetic, to float16 or bfloat16. Numerically sensitive ops such as
+// reductions, Softmax and the normalizations stay in float. The inputs and outputs of the model do not change.
+// "": disable; "fp16": convert to float16; "bf16": convert to bfloat16. The default is "".
+// The EP must have reduced precision kernels for the converted ops, which bfloat16 does not have for all of them.
+static const char* const kOrtSessionOptionsMixedPrecisionType = "optimization.mixed_precision_type";
+
+// Comma-separated op types that must stay in float when "optimization.mixed_precision_type" is set, in addition to
+// the ones that are never converted, e.g. "Add,Gemm".
+static const char* const kOrtSessionOptionsMixedPrecisionFp32Ops = "optimization.mixed_precision_fp32_ops";
+
+// Enable the level 3 NHWC layout transformer for fp32 Conv, FusedConv, MaxPool, AveragePool and GlobalAveragePool
+// nodes on the CPU EP, so chains of these ops run in channels last layout with transposes only at the chain boundary.
+// The NCHWc layout transformer is not registered when this is enabled.
+// "0": disable. (default)
+// "1": enable.
+static const char* const kOrtSessionOptionsEnableNhwcFp32 = "optimization.enable_nhwc_fp32";
+
 // This setting controls whether to enable AheadOfTime function inlining.
 // AOT function inlining examines the graph and attempts to inline as many locally defined functions in the model
 // as possible with the help of enabled execution providers.
@@ -77,6 +129,13 @@ static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimizati
 // Its default value is "0".
 static const char* const kOrtSessionOptionsDisableAheadOfTimeFunctionInlining = "session.disable_aot_function_inlining";
 
+// This setting controls whether graph partitioning moves regions of nodes assigned to a device execution provider,
+// such as CUDA, to the CPU execution provider when the estimated cost of copying their inputs and outputs between
+// CPU and the device is higher than what running them on the device saves. The estimate needs static shapes.
+// "0": disable; "1": enable.
+// Its default value is "0".
+static const char* const kOrtSessionOptionsCostBasedCpuFallback = "session.cost_based_cpu_fallback";
+
 #ifdef ENABLE_TRAINING
 // Specifies a list of op types for memory footprint reduction.
 // The value should be a ","-delimited list of pair of
@@ -91,18 +150,74 @@ static const char* const kOrtSessionOptionsMemoryOptimizerEnabler = "optimizatio
 // Specifies the config for detecting subgraphs for memory footprint reduction.
 // The value should be a string contains int separated using commas. The default value is "0:0".
 static const char* const kOrtSessionOptionsMemoryOptimizerProbeConfig = "optimization.enable_memory_probe_recompute_config";
+
+// Specifies a memory budget for the activations stashed from the forward pass for the backward pass. The memory
+// optimizer then picks more recompute subgraphs, those that recompute the fewest elements per byte saved, until the
+// stashed activations fit in the budget, in addition to the subgraphs of "optimization.memory_optimizer_config".
+// The value should be in the format of <budget in bytes>[:<dim param>=<dim value>,...], where the dim values are used
+// to estimate the size of the activations with symbolic dimensions, for example "1073741824:batch=8,seq_len=512".
+// Activations of unknown size are not considered. Its default value is "", disabling the automatic mode.
+static const char* const kOrtSessionOptionsMemoryOptimizerBudget = "optimization.memory_optimizer_budget";
+
+// Specifies the minimum size of the activations stashed from the forward pass for the backward pass that are
+// offloaded to host memory on device execution providers: copied to host memory after they are produced and copied
+// back just before their first backward consumer, instead of being held in device memory. Activations recomputed per
+// "optimization.memory_optimizer_config" are not offloaded.
+// The value has the format of "optimization.memory_optimizer_budget", <min size in bytes>[:<dim param>=<dim value>,...].
+// Its default value is "", disabling activation offload.
+static const char* const kOrtSessionOptionsActivationOffloadConfig = "optimization.activation_offload_config";
 #endif
 
 // Enable or disable using device allocator for allocating initialized tensor memory. "1": enable; "0": disable. The default is "0".
 // Using device allocators means the memory allocation is made using malloc/new.
 static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "session.use_device_allocator_for_initializers";
 
+// Size in bytes of the chunks in which initializers with external data in a file are copied to a non-CPU device.
+// Each chunk is read from the file into a staging buffer and copied to the device, so loading a model whose weights
+// don't fit in host memory needs host memory for a few chunks only. If the execution provider has a pinned memory
+// allocator and device streams, the chunks are read into two pinned buffers in turn and copied asynchronously, so
+// reading a chunk overlaps the copy of the previous one.
+// "0": copy the whole tensor at once (default).
+// The device memory of the execution provider must be addressable by byte offsets, as it is for CUDA and ROCm.
+static const char* const kOrtSessionOptionsExternalInitializerCopyChunkSize =
+    "session.external_initializer_copy_chunk_size";
+
+// Use the intra op thread pool to unpack initializers, create the CPU kernels and pre-pack their weights in parallel
+// when the session is initialized. "0": disable (default). "1": enable.
+// Pre-packing stays serial when pre-packed weights are shared through a container or a pre-packed weights file.
+static const char* const kOrtSessionOptionsParallelInitialization = "session.parallel_initialization";
+
+// Share the CPU initializers stored in the model between processes that load the same model.
+// Each initializer of at least 4KB whose data is in the model rather than an external file is unpacked into a
+// named shared memory segment identified by the hash of its type, shape and data. Other processes map the same
+// segment instead of unpacking their own copy, so the physical memory is used once. The mapping is copy-on-write.
+// Initializers with external data are already memory mapped from their file and pre-packed weights are shared by
+// kOrtSessionOptionsConfigPrepackedWeightsFile. "0": disable (default). "1": enable.
+// On Linux and macOS the segments stay in /dev/shm until the system restarts or they are removed with shm_unlink.
+static const char* const kOrtSessionOptionsShareInitializersAcrossProcesses =
+    "session.share_initializers_across_processes";
+
 // Configure whether to allow the inter_op/intra_op threads spinning a number of times before blocking
 // "0": thread will block if found no job to run
 // "1": default, thread will spin a number of times before blocking
 static const char* const kOrtSessionOptionsConfigAllowInterOpSpinning = "session.inter_op.allow_spinning";
 static const char* const kOrtSessionOptionsConfigAllowIntraOpSpinning = "session.intra_op.allow_spinning";
 
+// Scheduling priority of the parallel loops that Runs of this session submit to the intra op thread pool.
+// Mostly useful with the global thread pools shared by the sessions of an environment: while loops of a "high"
+// priority session run, loops of "normal" priority sessions only get the threads not used by them.
+// Can be overridden per Run with kOrtRunOptionsConfigIntraOpPriority.
+// "normal": default
+// "high"
+static const char* const kOrtSessionOptionsConfigIntraOpPriority = "session.intra_op.priority";
+
+// Maximum degree of parallelism, including the calling thread, of the parallel loops that Runs of this session
+// submit to the intra op thread pool. Bounds the share of a shared thread pool a single session can take.
+// Can be overridden per Run with kOrtRunOptionsConfigIntraOpMaxDegreeOfParallelism.
+// "0": default, no limit
+static const char* const kOrtSessionOptionsConfigIntraOpMaxDegreeOfParallelism =
+    "session.intra_op.max_degree_of_parallelism";
+
 // Key for using model bytes directly for ORT format
 // If a session is created using an input byte array contains the ORT format model data,
 // By default we will copy the model bytes at the time of session creation to ensure the model bytes
@@ -121,6 +236,18 @@ static const char* const kOrtSessionOptionsConfigUseORTModelBytesDirectly = "ses
 static const char* const kOrtSessionOptionsConfigUseORTModelBytesForInitializers =
     "session.use_ort_model_bytes_for_initializers";
 
+/// <summary>
+/// Key for using the memory mapped ONNX model file directly for initializers.
+/// When an ONNX model is loaded from a file, the file is memory mapped and the raw data of the initializers of the
+/// main graph is referenced in place instead of being copied by protobuf parsing, like
+/// `session.use_ort_model_bytes_for_initializers` does for ORT format models. This reduces the load time and the
+/// peak memory usage of models with large embedded weights.
+/// The mapping is kept for the duration of the InferenceSession. Not used if optimized_model_filepath is set.
+/// "0": disable (default). "1": enable.
+/// </summary>
+static const char* const kOrtSessionOptionsConfigUseOnnxModelFileForInitializers =
+    "session.use_onnx_model_file_for_initializers";
+
 // This should only be specified when exporting an ORT format model for use on a different platform.
 // If the ORT format model will be used on ARM platforms set to "1". For other platforms set to "0"
 // Available since version 1.11.
@@ -132,6 +259,22 @@ static const char* const kOrtSessionOptionsQDQIsInt8Allowed = "session.qdqisint8
 // platforms.
 static const char* const kOrtSessionOptionsAvx2PrecisionMode = "session.x64quantprecision";
 
+// Allows the CPU MatMul kernel for float to compute in bfloat16 on x64 processors with AMX-BF16 or AVX512-BF16,
+// e.g. Intel Sapphire Rapids. The constant weight is converted to bfloat16 when it is pre-packed and the other input
+// is converted on the fly, with the products accumulated in float. This is several times faster but the results
+// have the precision of bfloat16 products. Has no effect on processors without bfloat16 support.
+// "0": disable (default). "1": enable.
+static const char* const kOrtSessionOptionsMlasGemmFastMathBf16 = "mlas.enable_gemm_fastmath_bfloat16";
+
+// Makes the CPU MatMul kernel for float keep a copy of its pre-packed constant weight on each NUMA node, bound to the
+// memory of the node, and each GEMM thread read the copy of the node it runs on. On multi-socket servers this avoids
+// the threads of the other sockets reading the weights across the interconnect, at the cost of a copy of the packed
+// weights per node. Pin the intra-op threads to the processors of the nodes with
+// kOrtSessionOptionsConfigIntraOpThreadAffinities, so a thread keeps running on the node whose copy it reads.
+// Only applies to weights of at least 2MB once packed, on systems with more than one NUMA node.
+// "0": disable (default). "1": enable.
+static const char* const kOrtSessionOptionsMlasGemmNumaReplicas = "mlas.gemm_numa_weight_replicas";
+
 // Specifies how minimal build graph optimizations are handled in a full build.
 // These optimizations are at the extended level or higher.
 // Possible values and their effects are:
@@ -162,6 +305,162 @@ static const char* const kOrtSessionOptionsConfigNnapiEpPartitioningStopOps = "e
 // Available since version 1.11.
 static const char* const kOrtSessionOptionsConfigDynamicBlockBase = "session.dynamic_block_base";
 
+// Enables work-stealing scheduling of the parallel loops of the per session intra op thread pool.
+// Each thread starts with an equal share of a loop's iterations and threads that run out of work take half of
+// the largest remaining share. This keeps all threads busy until the end of loops whose iterations have very
+// different costs. Takes precedence over "session.dynamic_block_base" for those loops.
+// "0": default, disabled.
+// "1": enabled.
+static const char* const kOrtSessionOptionsConfigWorkStealingLoops = "session.intra_op.work_stealing_loops";
+
+// Makes the spinning of the per session intra op threads adaptive, if "session.intra_op.allow_spinning" is "1".
+// Each thread learns how long it usually waits for its next task, and spins only if that wait is short, e.g.
+// between the loops of one request, blocking after a short spin during the longer gaps between requests.
+// This keeps most of the latency benefit of spinning without burning idle CPU on shared hosts.
+// The spin and block counts are reported by the thread pool profiler.
+// "0": default, spin for a fixed number of iterations.
+// "1": adaptive spinning.
+static const char* const kOrtSessionOptionsConfigIntraOpAdaptiveSpinning = "session.intra_op.adaptive_spinning";
+
+// Controls the default size of the per session intra op thread pool on hybrid CPUs, e.g. with performance and
+// efficiency cores. Has no effect if the number of intra op threads is set.
+// "1": default, create one thread per performance core, with affinity to it if affinities are set by default.
+// "0": create one thread per core of any efficiency class.
+static const char* const kOrtSessionOptionsConfigIntraOpPreferPerformanceCores =
+    "session.intra_op.prefer_performance_cores";
+
+// Confines the default per session intra op thread pool to the cores that share one last level cache, e.g. one
+// CCX of an AMD EPYC CPU, so many sessions on one host don't thrash each other's caches. Has no effect if the
+// number of intra op threads is set, or if all cores share one cache.
+// "-1": default, use the cores of all cache domains.
+// "auto": assign sessions to the cache domains round robin.
+// "<n>": use the cores of cache domain n, modulo the number of domains.
+static const char* const kOrtSessionOptionsConfigIntraOpCacheDomain = "session.intra_op.cache_domain";
+
+// Enables shape bucketing of the memory pattern cache.
+// Dynamic input dims are rounded up to the next power of two before a cached memory pattern is looked up, so one
+// pattern serves all Runs in a bucket, e.g. all sequence lengths between 65 and 128. The pattern is re-recorded
+// once if a later Run in the bucket needs more memory than the Run it was recorded from.
+// "0": disabled. Memory patterns are only reused for identical input shapes. [DEFAULT]
+// "1": enabled.
+static const char* const kOrtSessionOptionsMemoryPatternBucketing = "session.memory_pattern_bucketing";
+
+// Comma separated list of symbolic dimension names (dim_param) to bucket when memory pattern bucketing is enabled,
+// e.g. "batch_size,sequence_length". If empty, every input dim without a fixed value is bucketed. [DEFAULT]
+static const char* const kOrtSessionOptionsMemoryPatternBucketDims = "session.memory_pattern_bucket_dims";
+
+// Maximum number of memory patterns cached per graph. The least recently used pattern is evicted once the limit
+// is reached. "0" means unbounded. [DEFAULT]
+static const char* const kOrtSessionOptionsMemoryPatternCacheSize = "session.memory_pattern_cache_size";
+
+// Runs the kernels of an execution plan that has a single logic stream and no synchronization through a flat array of
+// kernels and value releases built when the session is initialized, on the thread calling Run. The per kernel checks
+// for profiling, metrics, tracing and memory timelines are skipped, which speeds up models of many small nodes. The
+// Runs that are profiled, sampled for metrics, traced or record their memory go through the regular executor.
+// "0": disabled. [DEFAULT]
+// "1": enabled.
+static const char* const kOrtSessionOptionsLeanExecutor = "session.lean_executor";
+
+// Copies the small feeds a Run copies from CPU to the same device through one host staging buffer, with a single
+// transfer to a device buffer the copied feeds are views of, instead of one transfer per feed. Speeds up the models
+// with many small inputs on the devices where each transfer has a launch and synchronization cost, e.g. CUDA. The
+// feeds of up to 64KB are coalesced, unless the device allocates in stream order.
+// "0": disabled. [DEFAULT]
+// "1": enabled.
+static const char* const kOrtSessionOptionsCoalesceFeedCopies = "session.coalesce_feed_copies";
+
+// Declares state variables: graph inputs the session feeds, when a Run doesn't, with the value the paired graph output
+// had in the previous Run, so that streaming and autoregressive models don't return their state (RNN hidden states,
+// KV caches, conv caches) to the caller to feed it back. The value is a comma separated list of "<input>:<output>"
+// pairs, e.g. "h_in:h_out,c_in:c_out". The state is kept on the device the input is consumed on, without a copy to
+// the host, and is fetched by the Runs whether or not the caller fetches the output. The first Run of a state context
+// feeds the inputs, unless they have initializers for their initial value, and a Run that feeds them resets the state.
+// The Runs share their state by "run.state_context". The default is "" (none).
+static const char* const kOrtSessionOptionsStateVariables = "session.state_variables";
+
+// Save a static memory plan when saving an ORT format model.
+// The plan is computed from the inferred shapes and places every planned activation at a fixed offset within a
+// single buffer per device. It requires every graph input to have a fixed shape and a single stream execution plan.
+// When the ORT format model is loaded with memory patterns enabled, Runs with the recorded input shapes use the
+// plan and skip tracing the memory pattern on the first Run.
+// "0": disable. [DEFAULT]
+// "1": enable.
+static const char* const kOrtSessionOptionsSaveStaticMemoryPlan = "session.save_static_memory_plan";
+
+// Save an ORT format model as a session snapshot. "0": disable (default). "1": enable.
+// In addition to the static memory plan (see kOrtSessionOptionsSaveStaticMemoryPlan), the model records a pre-packed
+// weights file named after it, "<model file name>.prepacked" in the same directory. A session created from the model
+// uses that file unless kOrtSessionOptionsConfigPrepackedWeightsFile is set: the first session writes it, and later
+// sessions map the pre-packed weights instead of packing them. With kOrtSessionOptionsConfigUseORTModelBytesDirectly
+// and kOrtSessionOptionsConfigUseORTModelBytesForInitializers, no weights are copied or packed at session creation.
+static const char* const kOrtSessionOptionsSaveSessionSnapshot = "session.save_session_snapshot";
+
+// Directory of a cache of optimized models. When an ONNX model is loaded from a file or bytes, the session looks
+// for an ORT format model in the directory with a name derived from the hash of the model bytes, the ORT version,
+// the graph optimization level, the disabled optimizers, the free dimension overrides, the session config entries
+// and the execution providers and their options. If the file exists it is loaded instead of the ONNX model, so the
+// graph transformers and the partitioning of nodes to the CPU, CUDA and ROCm execution providers don't run again.
+// Otherwise the session saves the model it optimized to the file.
+// Sessions with execution providers that compile nodes, models with external initializers and sessions that set
+// optimized_model_filepath don't use the cache. The default is "" (disabled).
+static const char* const kOrtSessionOptionsOptimizationCacheDir = "session.optimization_cache_dir";
+
+// Directory of a cache of TunableOp tuning results. When the session is initialized, each execution provider which
+// supports TunableOp loads the results in the directory with a name derived from the execution provider and its
+// validators, i.e. the ORT version and build config, the runtime and library versions and the device model and
+// architecture, and TunableOp is enabled. Results that don't validate are ignored. When the session is destroyed the
+// results of the execution providers with tuning enabled are saved to the files, so the kernels tuned by one process
+// are selected without tuning again by the next one on the same kind of device. The default is "" (disabled).
+static const char* const kOrtSessionOptionsTuningResultsCacheDir = "session.tuning_results_cache_dir";
+
+// Collects metrics continuously while the session runs, to be scraped with OrtApi::SessionGetMetricsSnapshot:
+// histograms of the latencies of the Runs and of the kernels of each node, the allocator peak and allocation counts
+// and the time the session thread pools spend running tasks. The value is the fraction of the Runs the kernel
+// latencies are measured in, between 0 and 1, e.g. "0.01" measures them in one Run in 100. The Run latencies and
+// the counters are collected in every Run. The default is "" (disabled).
+static const char* const kOrtSessionOptionsMetricsSamplingRate = "session.metrics_sampling_rate";
+
+// Records the allocations and frees of the tensors of the Runs, with the node that allocated them, the stream, the
+// device and whether they were planned in the memory pattern or allocated dynamically. The value is a file path
+// prefix: the timeline of each recorded Run is written to "<prefix>_<session id>_<run number>.json" as a Chrome
+// trace, and the tensors live at the peak of each device to "<prefix>_<session id>_<run number>_peak.txt".
+// The report is also written for a Run which fails, e.g. when a device runs out of memory. The default is ""
+// (disabled).
+static const char* const kOrtSessionOptionsMemoryTimelineFilePrefix = "session.memory_timeline_file_prefix";
+
+// The number of Runs the memory timeline is recorded for, starting with the first one. The default is "1".
+static const char* const kOrtSessionOptionsMemoryTimelineMaxRuns = "session.memory_timeline_max_runs";
+
+// Records the variant of its kernel each node dispatched to in its last Run: the MLAS GEMM kernel of a MatMul, e.g.
+// "avx512vnni" or "amx", the path of MatMulNBits, the kernel an attention op chose, e.g. "flash" or
+// "memory_efficient", or the implementation a tunable op selected. Retrieve them with
+// OrtApi::SessionGetKernelDispatches. Profiles include the dispatches of the kernel events in the "dispatch" arg
+// whether or not this is set. "0": disabled (default), "1": enabled.
+static const char* const kOrtSessionOptionsRecordKernelDispatch = "session.record_kernel_dispatch";
+
+// Adds the hardware performance counters of each kernel to its event in the profile, as the "hw_counters" arg, e.g.
+// {"cycles":1200,"instructions":3400,"llc_misses":12,"branch_misses":3}. Only on Linux, where they are read with
+// perf_event_open(2) for the user space of the thread running the kernel: the work it hands to the intra op thread
+// pool isn't counted, set intra_op_num_threads to 1 to attribute all of it. If the counters can't be opened, e.g.
+// because of /proc/sys/kernel/perf_event_paranoid, a warning is logged and the profile is written without them.
+// "": disabled (default), "1": cycles, instructions, llc_misses and branch_misses, or a comma separated list of
+// "cycles", "instructions", "llc_misses", "llc_load_misses", "l1d_load_misses", "dtlb_load_misses" and
+// "branch_misses".
+static const char* const kOrtSessionOptionsProfileHardwareCounters = "session.profile_hardware_counters";
+
+// Maximum number of versions of the model specialized for concrete input shapes that a session creates.
+// A run whose input shapes were seen in kOrtSessionOptionsShapeSpecializationMinRuns runs uses a session created from
+// the model with the dims of the inputs fixed to those shapes. All shapes in it are known, so the shape computations
+// (Shape -> Gather -> Concat -> Reshape etc.) are constant folded and the memory is planned statically. Runs with other
+// shapes use the original session. The session keeps a copy of the model to create the specializations from.
+// Only sessions of ONNX format models that use the CPU execution provider only and no custom ops are specialized.
+// The default is "0" (disabled).
+static const char* const kOrtSessionOptionsShapeSpecializationMaxCount = "session.shape_specialization_max_count";
+
+// Number of runs with the same input shapes after which a session with kOrtSessionOptionsShapeSpecializationMaxCount
+// set creates the version of the model specialized for them. The default is "3".
+static const char* const kOrtSessionOptionsShapeSpecializationMinRuns = "session.shape_specialization_min_runs";
+
 // This option allows to decrease CPU usage between infrequent
 // requests and forces any TP threads spinning stop immediately when the last of
 // concurrent Run() call returns.
@@ -180,7 +479,9 @@ static const char* const kOrtSessionOptionsConfigStrictShapeTypeInference = "ses
 // is used for development purpose.
 static const char* const kOrtSessionOptionsConfigStrictAllowReleasedOpsetsOnly = "session.allow_released_opsets_only";
 
-// The file saves configuration for partitioning node among logic streams
+// The file saves configuration for partitioning node among logic streams.
+// Its "type" selects the partitioner: "DeviceBasedPartitioner" (default) groups nodes by device,
+// "CostBasedPartitioner" also spreads independent CPU branches over several streams based on node costs.
 static const char* const kNodePartitionConfigFile = "session.node_partition_config_file";
 
 // This Option allows setting affinities for intra op threads.
@@ -249,4 +550,10 @@ static const char* const kOrtSessionOptionEpContextFilePath = "ep.context_file_p
 // Flag to specify whether to dump the EP context into the Onnx model.
 // "0": dump the EP context into separate file, keep the file name in the Onnx model.
 // "1": dump the EP context into the Onnx model. (default).
-static const char* const kOrtSessionOptionEpContextEmbedMode = "ep.context_embed_mode";
\ No newline at end of file
+static const char* const kOrtSessionOptionEpContextEmbedMode = "ep.context_embed_mode";
+// Share the EP contexts loaded from Onnx models with EP context across the sessions of the process which enable it.
+// The sessions use a single EP backend, and the graphs of a context binary which a session doesn't use are kept for
+// the other sessions, e.g. the prefill and decode graphs of a LLM in one context binary share the weights on the device.
+// "0": disable. (default)
+// "1": enable.
+static const char* const kOrtSessionOptionShareEpContexts = "ep.share_ep_contexts";
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2023, Oracle and/or its affiliates. All rights reserved.
+ * Licensed under the MIT License.
+ */
+#include <jni.h>
+#include <string.h>
+#include <stdlib.h>
+#include "onnxruntime/core/session/onnxruntime_c_api.h"
+#include "OrtJniUtil.h"
+#include "ai_onnxruntime_OrtSession_PreparedRun.h"
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_PreparedRun
+ * Method:    createPreparedRun
+ * Signature: (JJ[Ljava/lang/String;[JJ[Ljava/lang/String;J)J
+ *
+ * The names are converted from Java strings once here, rather than on every run as in OrtSession.run. inputHandles
+ * are tensors of the types and shapes of the inputs of the runs, e.g. the first inputs, their data isn't used.
+ */
+JNIEXPORT jlong JNICALL Java_ai_onnxruntime_OrtSession_00024PreparedRun_createPreparedRun
+    (JNIEnv* jniEnv, jclass jclazz, jlong apiHandle, jlong sessionHandle, jobjectArray inputNamesArr,
+     jlongArray inputHandlesArr, jlong numInputs, jobjectArray outputNamesArr, jlong numOutputs) {
+  (void)jclazz;  // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*)apiHandle;
+  OrtSession* session = (OrtSession*)sessionHandle;
+  OrtPreparedRun* preparedRun = NULL;
+
+  const char** inputNames = allocarray(numInputs, sizeof(char*));
+  if (inputNames == NULL) {
+    throwOrtException(jniEnv, 1, "Not enough memory");
+    return 0;
+  }
+  jobject* javaInputStrings = allocarray(numInputs, sizeof(jobject));
+  if (javaInputStrings == NULL) {
+    throwOrtException(jniEnv, 1, "Not enough memory");
+    goto cleanup_input_names;
+  }
+  const OrtValue** inputValuePtrs = allocarray(numInputs, sizeof(OrtValue*));
+  if (inputValuePtrs == NULL) {
+    throwOrtException(jniEnv, 1, "Not enough memory");
+    goto cleanup_java_input_strings;
+  }
+  const char** outputNames = allocarray(numOutputs, sizeof(char*));
+  if (outputNames == NULL) {
+    throwOrtException(jniEnv, 1, "Not enough memory");
+    goto cleanup_input_values;
+  }
+  jobject* javaOutputStrings = allocarray(numOutputs, sizeof(jobject));
+  if (javaOutputStrings == NULL) {
+    throwOrtException(jniEnv, 1, "Not enough memory");
+    goto cleanup_output_names;
+  }
+
+  // The handles are copied as on 32-bit systems a long is larger than a pointer, see OrtSession.run.
+  jlong* inputHandles = (*jniEnv)->GetLongArrayElements(jniEnv, inputHandlesArr, NULL);
+  for (int i = 0; i < numInputs; i++) {
+    javaInputStrings[i] = (*jniEnv)->GetObjectArrayElement(jniEnv, inputNamesArr, i);
+    inputNames[i] = (*jniEnv)->GetStringUTFChars(jniEnv, javaInputStrings[i], NULL);
+    inputValuePtrs[i] = (const OrtValue*)inputHandles[i];
+  }
+  (*jniEnv)->ReleaseLongArrayElements(jniEnv, inputHandlesArr, inputHandles, JNI_ABORT);
+
+  for (int i = 0; i < numOutputs; i++) {
+    javaOutputStrings[i] = (*jniEnv)->GetObjectArrayElement(jniEnv, outputNamesArr, i);
+    outputNames[i] = (*jniEnv)->GetStringUTFChars(jniEnv, javaOutputStrings[i], NULL);
+  }
+
+  checkOrtStatus(jniEnv, api, api->CreatePreparedRun(session, (const char* const*)inputNames,
+                                                      (const OrtValue* const*)inputValuePtrs, numInputs,
+                                                      (const char* const*)outputNames, numOutputs, &preparedRun));
+
+  for (int i = 0; i < numOutputs; i++) {
+    (*jniEnv)->ReleaseStringUTFChars(jniEnv, javaOutputStrings[i], outputNames[i]);
+  }
+  for (int i = 0; i < numInputs; i++) {
+    (*jniEnv)->ReleaseStringUTFChars(jniEnv, javaInputStrings[i], inputNames[i]);
+  }
+
+  // Note these gotos are in a specific order so they mirror the allocation pattern above.
+  free(javaOutputStrings);
+cleanup_output_names:
+  free((void*)outputNames);
+cleanup_input_values:
+  free((void*)inputValuePtrs);
+cleanup_java_input_strings:
+  free(javaInputStrings);
+cleanup_input_names:
+  free((void*)inputNames);
+
+  return (jlong)preparedRun;
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_PreparedRun
+ * Method:    run
+ * Signature: (JJJJ[JJ[Lai/onnxruntime/OnnxValue;[JJJ)[Z
+ *
+ * As OrtSession.run, the outputs with a handle in outputHandlesArr are written into the tensors they refer to, e.g.
+ * tensors of direct ByteBuffers the caller reuses across runs, and the others are returned in outputValuesArr. The
+ * returned array tells which outputs are owned by ORT.
+ */
+JNIEXPORT jbooleanArray JNICALL Java_ai_onnxruntime_OrtSession_00024PreparedRun_run
+    (JNIEnv* jniEnv, jobject jobj, jlong apiHandle, jlong sessionHandle, jlong allocatorHandle,
+     jlong preparedRunHandle, jlongArray inputHandlesArr, jlong numInputs, jobjectArray outputValuesArr,
+     jlongArray outputHandlesArr, jlong numOutputs, jlong runOptionsHandle) {
+  (void)jobj;  // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*)apiHandle;
+  OrtAllocator* allocator = (OrtAllocator*)allocatorHandle;
+  OrtSession* session = (OrtSession*)sessionHandle;
+  const OrtPreparedRun* preparedRun = (const OrtPreparedRun*)preparedRunHandle;
+  OrtRunOptions* runOptions = (OrtRunOptions*)runOptionsHandle;
+
+  jbooleanArray outputArray = NULL;
+
+  const OrtValue** inputValuePtrs = allocarray(numInputs, sizeof(OrtValue*));
+  if (inputValuePtrs == NULL) {
+    throwOrtException(jniEnv, 1, "Not enough memory");
+    return outputArray;
+  }
+  OrtValue** outputValues = allocarray(numOutputs, sizeof(OrtValue*));
+  if (outputValues == NULL) {
+    throwOrtException(jniEnv, 1, "Not enough memory");
+    goto cleanup_input_values;
+  }
+
+  jlong* inputHandles = (*jniEnv)->GetLongArrayElements(jniEnv, inputHandlesArr, NULL);
+  for (int i = 0; i < numInputs; i++) {
+    inputValuePtrs[i] = (const OrtValue*)inputHandles[i];
+  }
+  (*jniEnv)->ReleaseLongArrayElements(jniEnv, inputHandlesArr, inputHandles, JNI_ABORT);
+
+  jlong* outputHandles = (*jniEnv)->GetLongArrayElements(jniEnv, outputHandlesArr, NULL);
+  for (int i = 0; i < numOutputs; i++) {
+    outputValues[i] = (OrtValue*)outputHandles[i];
+  }
+  (*jniEnv)->ReleaseLongArrayElements(jniEnv, outputHandlesArr, outputHandles, JNI_ABORT);
+
+  OrtErrorCode code = checkOrtStatus(jniEnv, api, api->RunPrepared(session, runOptions, preparedRun,
+                                                                   (const OrtValue* const*)inputValuePtrs, numInputs,
+                                                                   outputValues, numOutputs));
+  if (code != ORT_OK) {
+    goto cleanup_output_values;
+  }
+
+  // Java boolean arrays are initialized to false.
+  outputArray = (*jniEnv)->NewBooleanArray(jniEnv, safecast_int64_to_jsize(numOutputs));
+  jboolean* boolArr = (*jniEnv)->GetBooleanArrayElements(jniEnv, outputArray, NULL);
+
+  // Convert the outputs ORT allocated into ONNXValues
+  for (int i = 0; i < numOutputs; i++) {
+    if (outputValues[i] != NULL && (*jniEnv)->GetObjectArrayElement(jniEnv, outputValuesArr, i) == NULL) {
+      jobject onnxValue = convertOrtValueToONNXValue(jniEnv, api, allocator, outputValues[i]);
+      if (onnxValue == NULL) {
+        break;  // go to cleanup, exception thrown
+      }
+      boolArr[i] = 1;
+      (*jniEnv)->SetObjectArrayElement(jniEnv, outputValuesArr, i, onnxValue);
+    }
+  }
+
+  (*jniEnv)->ReleaseBooleanArrayElements(jniEnv, outputArray, boolArr, 0);
+
+cleanup_output_values:
+  free(outputValues);
+cleanup_input_values:
+  free((void*)inputValuePtrs);
+
+  return outputArray;
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_PreparedRun
+ * Method:    close
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024PreparedRun_close
+    (JNIEnv* jniEnv, jobject jobj, jlong apiHandle, jlong handle) {
+  (void)jniEnv; (void)jobj;  // Required JNI parameters not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*)apiHandle;
+  api->ReleasePreparedRun((OrtPreparedRun*)handle);
+}
@@ -9,7 +9,9 @@
 #include "run_options_helper.h"
 #include "session_options_helper.h"
 #include "tensor_helper.h"
+#include <memory>
 #include <string>
+#include <vector>
 
 Napi::FunctionReference InferenceSessionWrap::constructor;
 
@@ -31,6 +33,7 @@ Napi::Object InferenceSessionWrap::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function func = DefineClass(
       env, "InferenceSession",
       {InstanceMethod("loadModel", &InferenceSessionWrap::LoadModel), InstanceMethod("run", &InferenceSessionWrap::Run),
+       InstanceMethod("runAsync", &InferenceSessionWrap::RunAsync),
        InstanceMethod("dispose", &InferenceSessionWrap::Dispose),
        InstanceAccessor("inputNames", &InferenceSessionWrap::GetInputNames, nullptr, napi_default, nullptr),
        InstanceAccessor("outputNames", &InferenceSessionWrap::GetOutputNames, nullptr, napi_default, nullptr)});
@@ -60,7 +63,7 @@ Napi::Value InferenceSessionWrap::LoadModel(const Napi::CallbackInfo &info) {
   ORT_NAPI_THROW_TYPEERROR_IF(argsLength == 0, env, "Expect argument: model file path or buffer.");
 
   try {
-    defaultRunOptions_.reset(new Ort::RunOptions{});
+    defaultRunOptions_ = std::make_shared<Ort::RunOptions>();
     Ort::SessionOptions sessionOptions;
 
     if (argsLength == 2 && info[0].IsString() && info[1].IsObject()) {
@@ -146,7 +149,121 @@ Napi::Value InferenceSessionWrap::GetOutputNames(const Napi::CallbackInfo &info)
   return scope.Escape(CreateNapiArrayFrom(env, outputNames_));
 }
 
-Napi::Value InferenceSessionWrap::Run(const Napi::CallbackInfo &info) {
+namespace {
+
+// the feeds and fetches of a run, converted from its JavaScript arguments
+struct RunArgs {
+  std::vector<std::string> inputNames;
+  std::vector<Ort::Value> inputValues;
+  std::vector<std::string> outputNames;
+  std::vector<Ort::Value> outputValues;
+  // whether each output was preallocated by the caller, and is written in place
+  std::vector<bool> reuseOutput;
+};
+
+RunArgs ParseRunArgs(Napi::Env env, const std::vector<std::string> &inputNames,
+                     const std::vector<std::string> &outputNames, Napi::Object feed, Napi::Object fetch) {
+  RunArgs args;
+  // the tensors wrap the data of the typed arrays, the memory info is copied into them
+  auto memoryInfo = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  for (auto &name : inputNames) {
+    if (feed.Has(name)) {
+      args.inputNames.push_back(name);
+      args.inputValues.push_back(NapiValueToOrtValue(env, feed.Get(name), memoryInfo));
+    }
+  }
+  for (auto &name : outputNames) {
+    if (fetch.Has(name)) {
+      auto value = fetch.Get(name);
+      args.outputNames.push_back(name);
+      args.reuseOutput.push_back(!value.IsNull());
+      args.outputValues.emplace_back(value.IsNull() ? Ort::Value{nullptr}
+                                                    : NapiValueToOrtValue(env, value, memoryInfo));
+    }
+  }
+  return args;
+}
+
+// does not touch JavaScript values, so that it can run on a worker thread
+void RunSession(Ort::Session &session, const Ort::RunOptions &runOptions, RunArgs &args) {
+  std::vector<const char *> inputNames_cstr;
+  inputNames_cstr.reserve(args.inputNames.size());
+  for (auto &name : args.inputNames) {
+    inputNames_cstr.push_back(name.c_str());
+  }
+  std::vector<const char *> outputNames_cstr;
+  outputNames_cstr.reserve(args.outputNames.size());
+  for (auto &name : args.outputNames) {
+    outputNames_cstr.push_back(name.c_str());
+  }
+
+  size_t inputCount = inputNames_cstr.size();
+  size_t outputCount = outputNames_cstr.size();
+  session.Run(runOptions, inputCount == 0 ? nullptr : &inputNames_cstr[0],
+              inputCount == 0 ? nullptr : &args.inputValues[0], inputCount,
+              outputCount == 0 ? nullptr : &outputNames_cstr[0], outputCount == 0 ? nullptr : &args.outputValues[0],
+              outputCount);
+}
+
+Napi::Object CreateRunResult(Napi::Env env, RunArgs &args, Napi::Object fetch) {
+  Napi::Object result = Napi::Object::New(env);
+  for (size_t i = 0; i < args.outputNames.size(); i++) {
+    const auto &name = args.outputNames[i];
+    // a preallocated output was written in place, the caller's tensor is returned as is
+    result.Set(name, args.reuseOutput[i] ? fetch.Get(name) : OrtValueToNapiValue(env, args.outputValues[i]));
+  }
+  return result;
+}
+
+// runs a session on a thread of the libuv thread pool, so that concurrent runs from one event loop neither block it
+// nor each other. The size of the pool is set with the UV_THREADPOOL_SIZE environment variable.
+class RunWorker : public Napi::AsyncWorker {
+public:
+  RunWorker(Napi::Env env, std::shared_ptr<Ort::Session> session, std::shared_ptr<Ort::RunOptions> runOptions,
+            Napi::Object feed, Napi::Object fetch, RunArgs args)
+      : Napi::AsyncWorker(env), deferred_(Napi::Promise::Deferred::New(env)), session_(std::move(session)),
+        runOptions_(std::move(runOptions)), args_(std::move(args)) {
+    // the typed arrays the feeds and the preallocated fetches wrap are kept alive until the run completes
+    feed_ = Napi::Persistent(feed);
+    fetch_ = Napi::Persistent(fetch);
+  }
+
+  Napi::Promise GetPromise() const { return deferred_.Promise(); }
+
+protected:
+  void Execute() override {
+    try {
+      RunSession(*session_, *runOptions_, args_);
+    } catch (std::exception const &e) {
+      SetError(e.what());
+    }
+  }
+
+  void OnOK() override {
+    Napi::Env env = Env();
+    Napi::HandleScope scope(env);
+    try {
+      deferred_.Resolve(CreateRunResult(env, args_, fetch_.Value()));
+    } catch (Napi::Error const &e) {
+      deferred_.Reject(e.Value());
+    }
+  }
+
+  void OnError(Napi::Error const &e) override { deferred_.Reject(e.Value()); }
+
+private:
+  Napi::Promise::Deferred deferred_;
+  // shared with the session wrap, so that disposing of it doesn't release the session while it runs
+  std::shared_ptr<Ort::Session> session_;
+  std::shared_ptr<Ort::RunOptions> runOptions_;
+  Napi::ObjectReference feed_;
+  Napi::ObjectReference fetch_;
+  RunArgs args_;
+};
+
+} // namespace
+
+void InferenceSessionWrap::ValidateRunArguments(const Napi::CallbackInfo &info) {
   Napi::Env env = info.Env();
   ORT_NAPI_THROW_ERROR_IF(!this->initialized_, env, "Session is not initialized.");
   ORT_NAPI_THROW_ERROR_IF(this->disposed_, env, "Session already disposed.");
@@ -155,58 +272,52 @@ Napi::Value InferenceSessionWrap::Run(const Napi::CallbackInfo &info) {
                               "Expect inputs(feed) and outputs(fetch) to be objects.");
   ORT_NAPI_THROW_TYPEERROR_IF(info.Length() > 2 && (!info[2].IsObject() || info[2].IsNull()), env,
                               "'runOptions' must be an object.");
+}
+
+std::shared_ptr<Ort::RunOptions> InferenceSessionWrap::GetRunOptions(const Napi::CallbackInfo &info) {
+  if (info.Length() <= 2) {
+    return defaultRunOptions_;
+  }
+  auto runOptions = std::make_shared<Ort::RunOptions>();
+  ParseRunOptions(info[2].As<Napi::Object>(), *runOptions);
+  return runOptions;
+}
+
+Napi::Value InferenceSessionWrap::Run(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  ValidateRunArguments(info);
 
   Napi::EscapableHandleScope scope(env);
 
   auto feed = info[0].As<Napi::Object>();
   auto fetch = info[1].As<Napi::Object>();
 
-  std::vector<const char *> inputNames_cstr;
-  std::vector<Ort::Value> inputValues;
-  std::vector<const char *> outputNames_cstr;
-  std::vector<Ort::Value> outputValues;
-  std::vector<bool> reuseOutput;
-  size_t inputIndex = 0;
-  size_t outputIndex = 0;
-  OrtMemoryInfo *memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault).release();
-
   try {
-    for (auto &name : inputNames_) {
-      if (feed.Has(name)) {
-        inputIndex++;
-        inputNames_cstr.push_back(name.c_str());
-        auto value = feed.Get(name);
-        inputValues.push_back(NapiValueToOrtValue(env, value, memory_info));
-      }
-    }
-    for (auto &name : outputNames_) {
-      if (fetch.Has(name)) {
-        outputIndex++;
-        outputNames_cstr.push_back(name.c_str());
-        auto value = fetch.Get(name);
-        reuseOutput.push_back(!value.IsNull());
-        outputValues.emplace_back(value.IsNull() ? Ort::Value{nullptr} : NapiValueToOrtValue(env, value, memory_info));
-      }
-    }
-
-    Ort::RunOptions runOptions{nullptr};
-    if (info.Length() > 2) {
-      runOptions = Ort::RunOptions{};
-      ParseRunOptions(info[2].As<Napi::Object>(), runOptions);
-    }
-
-    session_->Run(runOptions == nullptr ? *defaultRunOptions_.get() : runOptions,
-                  inputIndex == 0 ? nullptr : &inputNames_cstr[0], inputIndex == 0 ? nullptr : &inputValues[0],
-                  inputIndex, outputIndex == 0 ? nullptr : &outputNames_cstr[0],
-                  outputIndex == 0 ? nullptr : &outputValues[0], outputIndex);
+    RunArgs args = ParseRunArgs(env, inputNames_, outputNames_, feed, fetch);
+    auto runOptions = GetRunOptions(info);
+    RunSession(*session_, *runOptions, args);
+    return scope.Escape(CreateRunResult(env, args, fetch));
+  } catch (Napi::Error const &e) {
+    throw e;
+  } catch (std::exception const &e) {
+    ORT_NAPI_THROW_ERROR(env, e.what());
+  }
+}
 
-    Napi::Object result = Napi::Object::New(env);
+Napi::Value InferenceSessionWrap::RunAsync(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  ValidateRunArguments(info);
 
-    for (size_t i = 0; i < outputIndex; i++) {
-      result.Set(outputNames_[i], OrtValueToNapiValue(env, outputValues[i]));
-    }
+  auto feed = info[0].As<Napi::Object>();
+  auto fetch = info[1].As<Napi::Object>();
 
-    return scope.Escape(result);
+  try {
+    RunArgs args = ParseRunArgs(env, inputNames_, outputNames_, feed, fetch);
+    auto worker = new RunWorker(env, session_, GetRunOptions(info), feed, fetch, std::move(args));
+    auto promise = worker->GetPromise();
+    // the worker is deleted once it completes
+    worker->Queue();
+    return promise;
   } catch (Napi::Error const &e) {
     throw e;
   } catch (std::exception const &e) {
@@ -219,8 +330,9 @@ Napi::Value InferenceSessionWrap::Dispose(const Napi::CallbackInfo &info) {
   ORT_NAPI_THROW_ERROR_IF(!this->initialized_, env, "Session is not initialized.");
   ORT_NAPI_THROW_ERROR_IF(this->disposed_, env, "Session already disposed.");
 
-  this->defaultRunOptions_.reset(nullptr);
-  this->session_.reset(nullptr);
+  // the runs started by runAsync keep the session until they complete
+  this->defaultRunOptions_.reset();
+  this->session_.reset();
 
   this->disposed_ = true;
   return env.Undefined();
@@ -7,6 +7,8 @@
 
 #include <memory>
 #include <napi.h>
+#include <string>
+#include <vector>
 
 // class InferenceSessionWrap is a N-API object wrapper for native InferenceSession.
 class InferenceSessionWrap : public Napi::ObjectWrap<InferenceSessionWrap> {
@@ -55,6 +57,16 @@ private:
    */
   Napi::Value Run(const Napi::CallbackInfo &info);
 
+  /**
+   * [async] run the model on a thread of the libuv thread pool.
+   * The tensors of the feeds and of the preallocated fetches must not be modified until the run completes.
+   * @param arg0 input object: all keys must present, value is object
+   * @param arg1 output object: at least one key must present, value can be null.
+   * @returns a promise of an object that every output specified will present and value must be object
+   * @throw error if the arguments are invalid. the promise is rejected if status code != 0
+   */
+  Napi::Value RunAsync(const Napi::CallbackInfo &info);
+
   /**
    * [sync] dispose the session.
    * @param nothing
@@ -63,6 +75,11 @@ private:
    */
   Napi::Value Dispose(const Napi::CallbackInfo &info);
 
+  // throw if the session can't run or the arguments of Run or RunAsync are invalid
+  void ValidateRunArguments(const Napi::CallbackInfo &info);
+  // the run options of the arguments of Run or RunAsync, or the default ones
+  std::shared_ptr<Ort::RunOptions> GetRunOptions(const Napi::CallbackInfo &info);
+
   // private members
 
   // persistent constructor
@@ -71,8 +88,9 @@ private:
   // session objects
   bool initialized_;
   bool disposed_;
-  std::unique_ptr<Ort::Session> session_;
-  std::unique_ptr<Ort::RunOptions> defaultRunOptions_;
+  // shared with the runs started by RunAsync
+  std::shared_ptr<Ort::Session> session_;
+  std::shared_ptr<Ort::RunOptions> defaultRunOptions_;
 
   // input/output metadata
   std::vector<std::string> inputNames_;
@@ -180,13 +180,17 @@ Ort::Value NapiValueToOrtValue(Napi::Env env, Napi::Value value, OrtMemoryInfo *
                                 "Tensor.data must be a typed array (", DATA_TYPE_TYPEDARRAY_MAP[elemType], ") for ",
                                 tensorTypeString, " tensors, but got typed array (", typedArrayType, ").");
 
-    char *buffer = reinterpret_cast<char *>(tensorDataTypedArray.ArrayBuffer().Data());
-    size_t bufferByteOffset = tensorDataTypedArray.ByteOffset();
+    // the tensor wraps the memory of the typed array. napi_get_typedarray_info returns its data at its byte offset
+    // whether it views an ArrayBuffer or a SharedArrayBuffer, which ArrayBuffer().Data() doesn't accept.
+    void *buffer = nullptr;
+    napi_status status = napi_get_typedarray_info(env, tensorDataTypedArray, nullptr, nullptr, &buffer, nullptr,
+                                                  nullptr);
+    NAPI_THROW_IF_FAILED(env, status, Ort::Value{nullptr});
     // there is a bug in TypedArray::ElementSize(): https://github.com/nodejs/node-addon-api/pull/705
     // TODO: change to TypedArray::ByteLength() in next node-addon-api release.
     size_t bufferByteLength = tensorDataTypedArray.ElementLength() * DATA_TYPE_ELEMENT_SIZE_MAP[elemType];
-    return Ort::Value::CreateTensor(memory_info, buffer + bufferByteOffset, bufferByteLength,
-                                    dims.empty() ? nullptr : &dims[0], dims.size(), elemType);
+    return Ort::Value::CreateTensor(memory_info, buffer, bufferByteLength, dims.empty() ? nullptr : &dims[0],
+                                    dims.size(), elemType);
   }
 }
 
@@ -245,10 +249,30 @@ Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value &value) {
     returnValue.Set("data", Napi::Value(env, stringArray));
   } else {
     // number data
-    // TODO: optimize memory
-    auto arrayBuffer = Napi::ArrayBuffer::New(env, size * DATA_TYPE_ELEMENT_SIZE_MAP[elemType]);
+    const size_t byteLength = size * DATA_TYPE_ELEMENT_SIZE_MAP[elemType];
+    napi_value arrayBuffer = nullptr;
     if (size > 0) {
-      memcpy(arrayBuffer.Data(), value.GetTensorRawData(), size * DATA_TYPE_ELEMENT_SIZE_MAP[elemType]);
+      // the array buffer wraps the memory of the tensor and owns the tensor, unless the runtime doesn't allow
+      // external buffers, e.g. with the V8 memory cage of Electron
+      void *data = value.GetTensorMutableRawData();
+      auto ownedValue = std::make_unique<Ort::Value>(std::move(value));
+      napi_status status = napi_create_external_arraybuffer(
+          env, data, byteLength,
+          [](napi_env /*env*/, void * /*data*/, void *hint) { delete static_cast<Ort::Value *>(hint); },
+          ownedValue.get(), &arrayBuffer);
+      if (status == napi_ok) {
+        ownedValue.release();
+      } else {
+        value = std::move(*ownedValue);
+        arrayBuffer = nullptr;
+      }
+    }
+    if (arrayBuffer == nullptr) {
+      auto copy = Napi::ArrayBuffer::New(env, byteLength);
+      if (size > 0) {
+        memcpy(copy.Data(), value.GetTensorRawData(), byteLength);
+      }
+      arrayBuffer = copy;
     }
     napi_value typedArrayData;
     napi_status status =
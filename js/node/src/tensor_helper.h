@@ -11,5 +11,7 @@
 // convert a Javascript OnnxValue object to an OrtValue object
 Ort::Value NapiValueToOrtValue(Napi::Env env, Napi::Value value, OrtMemoryInfo *memory_info);
 
-// convert an OrtValue object to a Javascript OnnxValue object
+// convert an OrtValue object to a Javascript OnnxValue object. where the runtime allows external buffers, the data of
+// a numeric tensor is not copied: value is moved into the ArrayBuffer of the result, which releases it when garbage
+// collected.
 Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value &value);
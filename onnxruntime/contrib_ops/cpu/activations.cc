@@ -34,6 +34,17 @@ ONNX_OPERATOR_KERNEL_EX(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Gelu<float>);
 
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    Gelu,
+    kMSDomain,
+    1,
+    MLFloat16,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gelu<MLFloat16>);
+#endif
+
 ONNX_OPERATOR_KERNEL_EX(
     QuickGelu,
     kMSDomain,
@@ -79,16 +79,7 @@ class Gelu : public OpKernel {
           T* p_output = output_data + start;
           int64_t count = std::min(length_per_task, elem_count - start);
 
-          for (int64_t i = 0; i < count; i++) {
-            T value = p_input[i];
-            p_output[i] = value * static_cast<T>(M_SQRT1_2);
-          }
-
-          MlasComputeErf(p_output, p_output, narrow<size_t>(count));
-
-          for (int64_t i = 0; i < count; i++) {
-            p_output[i] = 0.5f * p_input[i] * (p_output[i] + 1.0f);
-          }
+          MlasComputeGelu(p_input, p_output, narrow<size_t>(count));
         },
         0);
     return Status::OK();
@@ -96,7 +87,7 @@ class Gelu : public OpKernel {
 };
 
 // Implement a new one instead of inheriting from ElementWiseRangedTransform so that we can call
-// MlasComputeLogistic instead of using Eigen for better perf.
+// MlasComputeSwish instead of using Eigen for better perf.
 template <typename T>
 class QuickGelu : public OpKernel {
  public:
@@ -118,15 +109,8 @@ class QuickGelu : public OpKernel {
           const T* p_input = input_data + start;
           T* p_output = output_data + start;
           int64_t count = std::min(length_per_task, elem_count - start);
-          for (int64_t i = 0; i < count; i++) {
-            p_output[i] = p_input[i] * alpha_;
-          }
-
-          MlasComputeLogistic(p_output, p_output, onnxruntime::narrow<size_t>(count));
 
-          for (int64_t i = 0; i < count; i++) {
-            p_output[i] = p_input[i] * p_output[i];
-          }
+          MlasComputeSwish(p_input, p_output, onnxruntime::narrow<size_t>(count), alpha_);
         },
         0);
     return Status::OK();
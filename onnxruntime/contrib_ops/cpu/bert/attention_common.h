@@ -82,6 +82,7 @@ struct PackedAttentionParameters {
   int token_count;
   bool has_relative_position_bias;
   bool broadcast_res_pos_bias;
+  bool is_unidirectional;  // causal within each sequence
 };
 
 // Parameters deduced from node attributes and inputs/outputs.
@@ -9,6 +9,9 @@
 #include "core/common/common.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+
+#include <type_traits>
 
 namespace onnxruntime {
 namespace contrib {
@@ -53,13 +56,27 @@ class AttentionCPUBase : public AttentionBase {
     // Total sequence length including that of past state: T = P + L
     const int total_sequence_length = past_sequence_length + kv_sequence_length;
 
+    bool causal = (is_unidirectional_ && sequence_length > 1);
+
+    // Without a mask or bias the attention probs are never needed as a whole, so compute the attention
+    // block by block. The causal mask aligns the last query with the last key, so it requires L == S.
+    if constexpr (std::is_same_v<T, float>) {
+      const bool has_present = present != nullptr || (present_key != nullptr && present_value != nullptr);
+      if (mask_index == nullptr && relative_position_bias == nullptr &&
+          (!causal || kv_sequence_length == sequence_length) &&
+          (past_sequence_length == 0 || has_present)) {
+        ApplyFlashAttention(Q, K, V, past, past_key, past_value, output, present, present_key, present_value,
+                            causal, batch_size, sequence_length, kv_sequence_length, past_sequence_length,
+                            qk_head_size == 0 ? v_head_size : qk_head_size, v_head_size, v_hidden_size, tp);
+        return Status::OK();
+      }
+    }
+
     // Compute the attention score.
     size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * total_sequence_length * sizeof(T);
     auto attention_probs = allocator->Alloc(bytes);
     BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
 
-    bool causal = (is_unidirectional_ && sequence_length > 1);
-
     void* mask_data = nullptr;
     if (mask_index != nullptr || causal) {
       size_t mask_data_bytes = SafeInt<size_t>(batch_size) * sequence_length * total_sequence_length * sizeof(T);
@@ -105,6 +122,103 @@ class AttentionCPUBase : public AttentionBase {
   }
 
  private:
+  // Computes output(B, S, N, H_v) = Softmax(alpha x Q x K') x V with MlasFlashAttention, after concatenating
+  // the past and current K and V into the present state.
+  void ApplyFlashAttention(const float* Q,            // Q data with shape BxNxSxH
+                           const float* K,            // K data with shape BxNxLxH
+                           const float* V,            // V value with size BxNxLxH_v
+                           const Tensor* past,        // past state
+                           const Tensor* past_key,    // past K input tensor (if not using past state)
+                           const Tensor* past_value,  // past V input tensor (if not using past state)
+                           Tensor* output,            // output tensor
+                           Tensor* present,           // present state
+                           Tensor* present_key,       // present K output tensor (if separating present KV)
+                           Tensor* present_value,     // present V output tensor (if separating present KV)
+                           bool causal,               // has causal (unidirectional) mask
+                           int batch_size,            // batch size (B)
+                           int sequence_length,       // sequence length of Q (S)
+                           int kv_sequence_length,    // sequence length of K or V (L)
+                           int past_sequence_length,  // sequence length of past state (P)
+                           int head_size,             // head size of Q or K (H)
+                           int v_head_size,           // head size of V (H_v)
+                           int v_hidden_size,         // hidden size of V (D_v)
+                           ThreadPool* tp) const {
+    const int total_sequence_length = past_sequence_length + kv_sequence_length;  // T = P + L
+
+    const float* k = K;
+    const float* v = V;
+
+    const float* past_k = nullptr;
+    const float* past_v = nullptr;
+    float* present_k = nullptr;
+    float* present_v = nullptr;
+    if (present != nullptr) {
+      // The past and present states hold K followed by V.
+      if (past != nullptr) {
+        past_k = past->Data<float>();
+        past_v = past_k + SafeInt<ptrdiff_t>(batch_size) * num_heads_ * past_sequence_length * v_head_size;
+      }
+      present_k = present->MutableData<float>();
+      present_v = present_k + SafeInt<ptrdiff_t>(batch_size) * num_heads_ * total_sequence_length * v_head_size;
+    } else if (present_key != nullptr && present_value != nullptr) {
+      past_k = past_key != nullptr ? past_key->Data<float>() : nullptr;
+      past_v = past_value != nullptr ? past_value->Data<float>() : nullptr;
+      present_k = present_key->MutableData<float>();
+      present_v = present_value->MutableData<float>();
+    }
+
+    if (present_k != nullptr) {
+      // Concatenate past and current K and V: (BxNx)PxH, (BxNx)LxH -> (BxNx)TxH
+      const size_t past_k_chunk_length = static_cast<size_t>(past_sequence_length) * head_size;
+      const size_t present_k_chunk_length = static_cast<size_t>(total_sequence_length) * head_size;
+      const size_t past_v_chunk_length = static_cast<size_t>(past_sequence_length) * v_head_size;
+      const size_t present_v_chunk_length = static_cast<size_t>(total_sequence_length) * v_head_size;
+      const double cost = static_cast<double>(total_sequence_length) * (head_size + v_head_size);
+
+      ThreadPool::TryParallelFor(tp, SafeInt<ptrdiff_t>(batch_size) * num_heads_, cost,
+                                 [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                                   for (std::ptrdiff_t i = begin; i != end; ++i) {
+                                     ConcatStateChunk(past_k, K + (present_k_chunk_length - past_k_chunk_length) * i,
+                                                      present_k, past_k_chunk_length, present_k_chunk_length, i);
+                                     ConcatStateChunk(past_v, V + (present_v_chunk_length - past_v_chunk_length) * i,
+                                                      present_v, past_v_chunk_length, present_v_chunk_length, i);
+                                   }
+                                 });
+      k = present_k;
+      v = present_v;
+    }
+
+    MLAS_FLASH_ATTENTION_PARAMS params;
+    params.BatchSize = static_cast<size_t>(batch_size);
+    params.NumHeads = static_cast<size_t>(num_heads_);
+    params.KvNumHeads = static_cast<size_t>(num_heads_);
+    params.SequenceLength = static_cast<size_t>(sequence_length);
+    params.KvSequenceLength = static_cast<size_t>(total_sequence_length);
+    params.HeadSize = static_cast<size_t>(head_size);
+    params.VHeadSize = static_cast<size_t>(v_head_size);
+    params.Scale = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+    params.Causal = causal;
+    params.Q = Q;
+    params.ldq = params.HeadSize;
+    params.QHeadStride = params.SequenceLength * params.HeadSize;
+    params.QBatchStride = params.NumHeads * params.QHeadStride;
+    params.K = k;
+    params.ldk = params.HeadSize;
+    params.KHeadStride = params.KvSequenceLength * params.HeadSize;
+    params.KBatchStride = params.NumHeads * params.KHeadStride;
+    params.V = v;
+    params.ldv = params.VHeadSize;
+    params.VHeadStride = params.KvSequenceLength * params.VHeadSize;
+    params.VBatchStride = params.NumHeads * params.VHeadStride;
+    // The output is BxSxNxH_v, so the heads are interleaved within each row of D_v.
+    params.Output = output->MutableData<float>();
+    params.ldo = static_cast<size_t>(v_hidden_size);
+    params.OutputHeadStride = params.VHeadSize;
+    params.OutputBatchStride = params.SequenceLength * params.ldo;
+
+    MlasFlashAttention(&params, tp);
+  }
+
   // Helper function to compute the attention probs. It does 2 things:
   //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T) +
   //                                1 x mask_data(B, N, S, T)
@@ -23,10 +23,6 @@ ONNX_OPERATOR_KERNEL_EX(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     BiasGelu<float, false>);
 
-// FastGelu uses approximation for Gelu. The formula is 0.5 * (1 + Tanh(x * (C * x * x + B))) * x.
-static constexpr float B = 0.7978845608028654f;    // sqrt(2.0 / M_PI)
-static constexpr float C = 0.035677408136300125f;  // 0.044715 * sqrt(2.0 / M_PI)
-
 template <typename T, bool use_approximation>
 Status BiasGelu<T, use_approximation>::Compute(OpKernelContext* context) const {
   ORT_RETURN_IF_ERROR(bias_gelu_helper::CheckInputs(context));
@@ -55,16 +51,7 @@ Status BiasGelu<T, use_approximation>::Compute(OpKernelContext* context) const {
             T* p_output = output_data + start;
             int64_t count = std::min(length_per_task, elem_count - start);
 
-            for (int64_t i = 0; i < count; i++) {
-              T value = p_input[i];
-              p_output[i] = value * (static_cast<T>(C) * value * value + static_cast<T>(B));
-            }
-
-            MlasComputeTanh(p_output, p_output, narrow<size_t>(count));
-
-            for (int64_t i = 0; i < count; i++) {
-              p_output[i] = 0.5f * p_input[i] * (p_output[i] + 1.0f);
-            }
+            MlasComputeFastGelu(p_input, p_output, narrow<size_t>(count));
           },
           0);
     }
@@ -74,12 +61,6 @@ Status BiasGelu<T, use_approximation>::Compute(OpKernelContext* context) const {
   const T* bias_data = bias->Data<T>();
   int64_t bias_len = bias->Shape().Size();
 
-  AllocatorPtr alloc;
-  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
-  BufferUniquePtr buffer = BufferUniquePtr(alloc->Alloc(SafeInt<size_t>(sizeof(T)) * elem_count),
-                                           BufferDeleter(alloc));
-  T* tmp_data = static_cast<T*>(buffer.get());
-
   int64_t task_count = elem_count / bias_len;
 
   concurrency::ThreadPool::TryBatchParallelFor(
@@ -87,9 +68,8 @@ Status BiasGelu<T, use_approximation>::Compute(OpKernelContext* context) const {
       [&](ptrdiff_t task_idx) {
         const T* p_input = input_data + task_idx * bias_len;
         T* p_output = output_data + task_idx * bias_len;
-        T* p_tmp = tmp_data + task_idx * bias_len;
 
-        AddBiasGelu(p_input, bias_data, p_tmp, p_output, bias_len);
+        AddBiasGelu(p_input, bias_data, p_output, bias_len);
       },
       0);
 
@@ -98,31 +78,17 @@ Status BiasGelu<T, use_approximation>::Compute(OpKernelContext* context) const {
 
 template <typename T, bool use_approximation>
 void BiasGelu<T, use_approximation>::AddBiasGelu(
-    const T* input, const T* bias, T* temp, T* output, int64_t count) const {
-  if (use_approximation) {
-    for (int64_t i = 0; i < count; i++) {
-      T value = input[i] + bias[i];
-      output[i] = value * (static_cast<T>(C) * value * value + static_cast<T>(B));
-      temp[i] = value * 0.5f;
-    }
-
-    MlasComputeTanh(output, output, narrow<size_t>(count));
+    const T* input, const T* bias, T* output, int64_t count) const {
+  // The biased row is written to the output and the activation is computed in place
+  // while the row is still in the cache.
+  for (int64_t i = 0; i < count; i++) {
+    output[i] = input[i] + bias[i];
+  }
 
-    for (int64_t i = 0; i < count; i++) {
-      output[i] = temp[i] * (output[i] + 1.0f);
-    }
+  if (use_approximation) {
+    MlasComputeFastGelu(output, output, narrow<size_t>(count));
   } else {  // BiasGelu
-    for (int64_t i = 0; i < count; i++) {
-      T value = input[i] + bias[i];
-      output[i] = value * static_cast<T>(M_SQRT1_2);
-      temp[i] = value * 0.5f;
-    }
-
-    MlasComputeErf(output, output, narrow<size_t>(count));
-
-    for (int64_t i = 0; i < count; i++) {
-      output[i] = temp[i] * (output[i] + 1.0f);
-    }
+    MlasComputeGelu(output, output, narrow<size_t>(count));
   }
 }
 
@@ -0,0 +1,341 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/bert/group_query_attention.h"
+#include "contrib_ops/cpu/bert/group_query_attention_helper.h"
+#include "contrib_ops/cpu/bert/rotary_embedding_helper.h"
+
+#include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+#include <vector>
+
+using onnxruntime::concurrency::ThreadPool;
+
+namespace onnxruntime {
+namespace contrib {
+
+// These ops are internal-only, so register outside of onnx
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    GroupQueryAttention,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T_CACHE", {DataTypeImpl::GetTensorType<float>(), DataTypeImpl::GetTensorType<uint8_t>()})
+        .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>())
+        .MayInplace(3, 1)
+        .MayInplace(4, 2),
+    GroupQueryAttention<float>);
+
+template <typename T>
+GroupQueryAttention<T>::GroupQueryAttention(const OpKernelInfo& info) : OpKernel(info) {
+  int64_t num_heads = 0;
+  int64_t kv_num_heads = 0;
+  ORT_ENFORCE(info.GetAttr("num_heads", &num_heads).IsOK() && num_heads > 0);
+  ORT_ENFORCE(info.GetAttr("kv_num_heads", &kv_num_heads).IsOK() && kv_num_heads > 0 && num_heads % kv_num_heads == 0);
+  num_heads_ = static_cast<int>(num_heads);
+  kv_num_heads_ = static_cast<int>(kv_num_heads);
+  local_window_size_ = static_cast<int>(info.GetAttrOrDefault<int64_t>("local_window_size", -1));
+  scale_ = info.GetAttrOrDefault<float>("scale", 0.0f);
+  kv_cache_bit_width_ = static_cast<int>(info.GetAttrOrDefault<int64_t>("kv_cache_bit_width", 0));
+  ORT_ENFORCE(kv_cache_bit_width_ == 0 || kv_cache_bit_width_ == 8 || kv_cache_bit_width_ == 4,
+              "kv_cache_bit_width must be 0, 8 or 4, got ", kv_cache_bit_width_);
+  do_rotary_ = info.GetAttrOrDefault<int64_t>("do_rotary", 0) == 1;
+  rotary_interleaved_ = info.GetAttrOrDefault<int64_t>("rotary_interleaved", 0) == 1;
+}
+
+template <typename T>
+Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
+  const Tensor* query = context->Input<Tensor>(0);
+  const Tensor* key = context->Input<Tensor>(1);
+  const Tensor* value = context->Input<Tensor>(2);
+  const Tensor* past_key = context->Input<Tensor>(3);
+  const Tensor* past_value = context->Input<Tensor>(4);
+  const Tensor* seqlens_k = context->Input<Tensor>(5);
+  const Tensor* total_seqlen = context->Input<Tensor>(6);
+  const Tensor* cos_cache = context->Input<Tensor>(7);
+  const Tensor* sin_cache = context->Input<Tensor>(8);
+  const Tensor* block_tables = context->Input<Tensor>(9);
+
+  // A paged kv cache is a pool of blocks (num_blocks, N_kv, block_size, H) in past_key and past_value, shared
+  // by the whole batch. The rows of a batch are found through its row of block_tables.
+  const bool paged_kv = block_tables != nullptr;
+  ORT_RETURN_IF(paged_kv && (past_key == nullptr || past_value == nullptr),
+                "GroupQueryAttention with block_tables requires the past_key and past_value block pools");
+
+  // A quantized kv cache holds rows of kv_row_size bytes in place of head_size elements.
+  const bool quantized_kv = kv_cache_bit_width_ != 0;
+  int kv_row_size = 0;
+  if (quantized_kv && query->Shape().NumDimensions() == 3) {
+    const size_t query_head_size = static_cast<size_t>(query->Shape()[2] / num_heads_);
+    kv_row_size = static_cast<int>(MlasKvCacheQuantRowSize(query_head_size, static_cast<size_t>(kv_cache_bit_width_)));
+  }
+
+  GroupQueryAttentionParameters parameters;
+  ORT_RETURN_IF_ERROR(group_query_attention_helper::CheckInputs(query,
+                                                                key,
+                                                                value,
+                                                                paged_kv ? nullptr : past_key,
+                                                                paged_kv ? nullptr : past_value,
+                                                                &parameters,
+                                                                num_heads_,
+                                                                kv_num_heads_,
+                                                                seqlens_k,
+                                                                total_seqlen,
+                                                                false,
+                                                                scale_,
+                                                                kv_row_size));
+
+  const int batch_size = parameters.batch_size;
+  const int sequence_length = parameters.sequence_length;
+  const int head_size = parameters.head_size;
+  const int past_buffer_length = parameters.seqlen_past_kv_cache;
+  const int present_buffer_length = parameters.seqlen_present_kv_cache;
+
+  // The block pools have (num_blocks, N_kv, block_size, H) and each batch has max_blocks blocks in block_tables.
+  int num_blocks = 0;
+  int block_size = 0;
+  int max_blocks = 0;
+  if (paged_kv) {
+    const auto& pool_dims = past_key->Shape();
+    const int64_t row_dim = quantized_kv ? kv_row_size : head_size;
+    ORT_RETURN_IF(pool_dims.NumDimensions() != 4 || pool_dims != past_value->Shape() || pool_dims[1] != kv_num_heads_ ||
+                      pool_dims[2] <= 0 || pool_dims[3] != row_dim,
+                  "past_key and past_value must both have the shape (num_blocks, ", kv_num_heads_, ", block_size, ",
+                  row_dim, ") with block_tables, got ", pool_dims, " and ", past_value->Shape());
+    const auto& table_dims = block_tables->Shape();
+    ORT_RETURN_IF(table_dims.NumDimensions() != 2 || table_dims[0] != batch_size,
+                  "block_tables must have the shape (batch_size, max_blocks_per_sequence), got ", table_dims);
+    num_blocks = static_cast<int>(pool_dims[0]);
+    block_size = static_cast<int>(pool_dims[2]);
+    max_blocks = static_cast<int>(table_dims[1]);
+  }
+
+  // The number of rows each batch may hold in the present state.
+  const int max_kv_length = paged_kv ? max_blocks * block_size : present_buffer_length;
+
+  // The rotary caches hold the cos and sin of every position, (max_sequence_length, head_size / 2).
+  int max_rotary_positions = 0;
+  if (do_rotary_) {
+    ORT_RETURN_IF(cos_cache == nullptr || sin_cache == nullptr,
+                  "GroupQueryAttention with do_rotary requires the cos_cache and sin_cache inputs");
+    const auto& cos_dims = cos_cache->Shape();
+    ORT_RETURN_IF(cos_dims.NumDimensions() != 2 || cos_dims != sin_cache->Shape() || head_size % 2 != 0 ||
+                      cos_dims[1] != head_size / 2,
+                  "cos_cache and sin_cache must both have the shape (max_sequence_length, head_size / 2), got ",
+                  cos_dims, " and ", sin_cache->Shape());
+    max_rotary_positions = static_cast<int>(cos_dims[0]);
+  }
+
+  TensorShapeVector output_shape{batch_size, sequence_length, parameters.hidden_size};
+  Tensor* output = context->Output(0, output_shape);
+
+  TensorShape present_shape = paged_kv ? past_key->Shape()
+                                       : TensorShape({batch_size, kv_num_heads_, present_buffer_length,
+                                                      quantized_kv ? kv_row_size : head_size});
+  Tensor* present_key = context->Output(1, present_shape);
+  Tensor* present_value = context->Output(2, present_shape);
+  ORT_RETURN_IF(present_key == nullptr || present_value == nullptr,
+                "GroupQueryAttention requires the present_key and present_value outputs");
+
+  for (const Tensor* cache : {past_key, past_value, static_cast<const Tensor*>(present_key),
+                              static_cast<const Tensor*>(present_value)}) {
+    if (quantized_kv) {
+      ORT_RETURN_IF_NOT(cache == nullptr || cache->IsDataType<uint8_t>(),
+                        "GroupQueryAttention with kv_cache_bit_width requires a uint8 kv cache");
+    } else {
+      ORT_RETURN_IF_NOT(cache == nullptr || cache->IsDataType<T>(),
+                        "GroupQueryAttention requires the kv cache to have the type of the query");
+    }
+  }
+
+  // The cache is addressed in bytes so that float and quantized rows share the append below.
+  const uint8_t* past_key_data = past_key != nullptr ? static_cast<const uint8_t*>(past_key->DataRaw()) : nullptr;
+  const uint8_t* past_value_data = past_value != nullptr ? static_cast<const uint8_t*>(past_value->DataRaw()) : nullptr;
+  uint8_t* present_key_data = static_cast<uint8_t*>(present_key->MutableDataRaw());
+  uint8_t* present_value_data = static_cast<uint8_t*>(present_value->MutableDataRaw());
+
+  // When the present state shares the buffer of the past state, only the new tokens are written.
+  const bool kv_share_buffer = past_key_data == present_key_data && past_value_data == present_value_data;
+
+  // seqlens_k holds the past sequence length of each batch when generating tokens. A prompt has no past.
+  const int32_t* seqlens_k_data = seqlens_k->Data<int32_t>();
+  const int32_t* block_table_data = paged_kv ? block_tables->Data<int32_t>() : nullptr;
+  std::vector<int32_t> total_seqlens(batch_size);
+  for (int b = 0; b < batch_size; b++) {
+    const int past_seqlen = parameters.is_prompt ? 0 : seqlens_k_data[b];
+    ORT_RETURN_IF(past_seqlen < 0 || past_seqlen + sequence_length > max_kv_length ||
+                      (!paged_kv && !kv_share_buffer && past_seqlen > past_buffer_length),
+                  "seqlens_k[", b, "] = ", past_seqlen, " is out of range of the kv cache");
+    ORT_RETURN_IF(do_rotary_ && past_seqlen + sequence_length > max_rotary_positions,
+                  "The positions of batch ", b, " exceed the ", max_rotary_positions, " positions of cos_cache");
+    total_seqlens[b] = past_seqlen + sequence_length;
+    for (int block = 0; paged_kv && block * block_size < total_seqlens[b]; block++) {
+      const int32_t block_index = block_table_data[static_cast<size_t>(b) * max_blocks + block];
+      ORT_RETURN_IF(block_index < 0 || block_index >= num_blocks,
+                    "block_tables[", b, ", ", block, "] = ", block_index, " is out of range of the block pools");
+    }
+  }
+
+  ThreadPool* tp = context->GetOperatorThreadPool();
+
+  // Rotates a head of the new token s of batch b, which is at the position that follows the past sequence.
+  const int half_head_size = head_size / 2;
+  auto rotate_head = [&](const T* input, int b, int s, T* output) {
+    const size_t cache_offset = static_cast<size_t>(total_seqlens[b] - sequence_length + s) * half_head_size;
+    rotary_embedding_helper::RotateHead(input, cos_cache->Data<T>() + cache_offset, sin_cache->Data<T>() + cache_offset,
+                                        output, head_size, rotary_interleaved_);
+  };
+
+  // The query is rotated into a temporary buffer, the key as it is appended to the present state.
+  const T* query_data = query->Data<T>();
+  IAllocatorUniquePtr<T> rotated_query;
+  if (do_rotary_) {
+    AllocatorPtr allocator;
+    ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+    const size_t query_size = SafeInt<size_t>(batch_size) * sequence_length * parameters.hidden_size;
+    rotated_query = IAllocator::MakeUniquePtr<T>(allocator, query_size);
+    T* rotated_query_data = rotated_query.get();
+    ThreadPool::TryParallelFor(tp, SafeInt<ptrdiff_t>(batch_size) * sequence_length * num_heads_,
+                               static_cast<double>(head_size) * 4, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                                 for (std::ptrdiff_t i = begin; i != end; ++i) {
+                                   const int b = static_cast<int>(i / num_heads_ / sequence_length);
+                                   const int s = static_cast<int>(i / num_heads_ % sequence_length);
+                                   const size_t offset = static_cast<size_t>(i) * head_size;
+                                   rotate_head(query_data + offset, b, s, rotated_query_data + offset);
+                                 }
+                               });
+    query_data = rotated_query_data;
+  }
+
+  // Append the new K and V (BxSxN_kvxH) to the past state in the present state (BxN_kvxS*xH), or to the blocks of
+  // the paged cache, quantizing the new rows when the cache is quantized.
+  const T* key_data = key->Data<T>();
+  const T* value_data = value->Data<T>();
+  const size_t kv_hidden_size = static_cast<size_t>(parameters.kv_hidden_size);
+  const size_t bytes_per_row = quantized_kv ? static_cast<size_t>(kv_row_size)
+                                             : static_cast<size_t>(SafeInt<size_t>(head_size) * sizeof(T));
+  const size_t bytes_per_head = SafeInt<size_t>(present_buffer_length) * bytes_per_row;
+  const size_t past_bytes_per_head = SafeInt<size_t>(past_buffer_length) * bytes_per_row;
+  const double cost = static_cast<double>(paged_kv ? sequence_length : present_buffer_length) * head_size;
+
+  // The blocks of a paged cache that is not updated in place are carried over as a whole.
+  if (paged_kv && !kv_share_buffer) {
+    memcpy(present_key_data, past_key_data, past_key->SizeInBytes());
+    memcpy(present_value_data, past_value_data, past_value->SizeInBytes());
+  }
+
+  // Returns the byte offset of row t of kv head n of batch b in the present state.
+  auto present_row_offset = [&](int b, int n, int t) -> size_t {
+    if (paged_kv) {
+      const size_t block = static_cast<size_t>(block_table_data[static_cast<size_t>(b) * max_blocks + t / block_size]);
+      return ((block * kv_num_heads_ + n) * block_size + t % block_size) * bytes_per_row;
+    }
+    return ((static_cast<size_t>(b) * kv_num_heads_ + n) * present_buffer_length + t) * bytes_per_row;
+  };
+
+  ThreadPool::TryParallelFor(tp, SafeInt<ptrdiff_t>(batch_size) * kv_num_heads_, cost,
+                             [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                               // The rotated new row of a key head, before it is quantized.
+                               std::vector<T> rotated_key;
+                               if (do_rotary_ && quantized_kv) {
+                                 rotated_key.resize(head_size);
+                               }
+                               for (std::ptrdiff_t i = begin; i != end; ++i) {
+                                 const int b = static_cast<int>(i / kv_num_heads_);
+                                 const int n = static_cast<int>(i % kv_num_heads_);
+                                 const int past_seqlen = total_seqlens[b] - sequence_length;
+                                 if (!paged_kv && !kv_share_buffer && past_seqlen > 0) {
+                                   const size_t present_offset = SafeInt<size_t>(i) * bytes_per_head;
+                                   const size_t past_offset = SafeInt<size_t>(i) * past_bytes_per_head;
+                                   memcpy(present_key_data + present_offset, past_key_data + past_offset,
+                                          past_seqlen * bytes_per_row);
+                                   memcpy(present_value_data + present_offset, past_value_data + past_offset,
+                                          past_seqlen * bytes_per_row);
+                                 }
+                                 for (int s = 0; s < sequence_length; s++) {
+                                   const size_t row_offset = present_row_offset(b, n, past_seqlen + s);
+                                   uint8_t* present_k = present_key_data + row_offset;
+                                   uint8_t* present_v = present_value_data + row_offset;
+                                   const size_t token = static_cast<size_t>(b) * sequence_length + s;
+                                   const size_t offset = token * kv_hidden_size + static_cast<size_t>(n) * head_size;
+                                   if (quantized_kv) {
+                                     const size_t row_length = static_cast<size_t>(head_size);
+                                     const size_t bit_width = static_cast<size_t>(kv_cache_bit_width_);
+                                     const T* new_key = key_data + offset;
+                                     if (do_rotary_) {
+                                       rotate_head(new_key, b, s, rotated_key.data());
+                                       new_key = rotated_key.data();
+                                     }
+                                     MlasQuantizeKvCacheRows(new_key, row_length, present_k, bytes_per_row, 1, row_length,
+                                                             bit_width);
+                                     MlasQuantizeKvCacheRows(value_data + offset, row_length, present_v, bytes_per_row, 1,
+                                                             row_length, bit_width);
+                                   } else {
+                                     if (do_rotary_) {
+                                       rotate_head(key_data + offset, b, s, reinterpret_cast<T*>(present_k));
+                                     } else {
+                                       memcpy(present_k, key_data + offset, bytes_per_row);
+                                     }
+                                     memcpy(present_v, value_data + offset, bytes_per_row);
+                                   }
+                                 }
+                               }
+                             });
+
+  // Causal attention of the BSNH query over the valid rows of the present state.
+  MLAS_FLASH_ATTENTION_PARAMS params;
+  params.BatchSize = static_cast<size_t>(batch_size);
+  params.NumHeads = static_cast<size_t>(num_heads_);
+  params.KvNumHeads = static_cast<size_t>(kv_num_heads_);
+  params.SequenceLength = static_cast<size_t>(sequence_length);
+  params.KvSequenceLength = static_cast<size_t>(max_kv_length);
+  params.HeadSize = static_cast<size_t>(head_size);
+  params.VHeadSize = static_cast<size_t>(head_size);
+  params.Scale = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+  params.Causal = true;
+  params.LocalWindowSize = local_window_size_;
+  params.KvSequenceLengths = total_seqlens.data();
+  params.Q = query_data;
+  params.ldq = static_cast<size_t>(parameters.hidden_size);
+  params.QHeadStride = params.HeadSize;
+  params.QBatchStride = params.SequenceLength * params.ldq;
+  // The strides of a quantized cache are in bytes, those of a float cache in elements.
+  params.ldk = quantized_kv ? bytes_per_row : params.HeadSize;
+  params.KHeadStride = (paged_kv ? static_cast<size_t>(block_size) : params.KvSequenceLength) * params.ldk;
+  params.KBatchStride = params.KvNumHeads * params.KHeadStride;
+  params.ldv = params.ldk;
+  params.VHeadStride = params.KHeadStride;
+  params.VBatchStride = params.KBatchStride;
+  if (paged_kv) {
+    // The batch strides are then the strides between the blocks of the pools.
+    params.BlockTables = block_table_data;
+    params.BlockTableStride = static_cast<size_t>(max_blocks);
+    params.KvBlockSize = static_cast<size_t>(block_size);
+  }
+  if (quantized_kv) {
+    params.K = nullptr;
+    params.V = nullptr;
+    params.KvBitWidth = static_cast<size_t>(kv_cache_bit_width_);
+    params.QuantizedK = present_key_data;
+    params.QuantizedV = present_value_data;
+  } else {
+    params.K = reinterpret_cast<const T*>(present_key_data);
+    params.V = reinterpret_cast<const T*>(present_value_data);
+  }
+  params.Output = output->MutableData<T>();
+  params.ldo = params.ldq;
+  params.OutputHeadStride = params.HeadSize;
+  params.OutputBatchStride = params.QBatchStride;
+
+  MlasFlashAttention(&params, tp);
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
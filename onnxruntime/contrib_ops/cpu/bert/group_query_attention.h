@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+template <typename T>
+class GroupQueryAttention final : public OpKernel {
+ public:
+  GroupQueryAttention(const OpKernelInfo& info);
+  Status Compute(OpKernelContext* context) const override;
+
+ protected:
+  int num_heads_;            // number of attention heads of Q
+  int kv_num_heads_;         // number of attention heads of K or V
+  int local_window_size_;    // left window size for local attention, -1 when unused
+  float scale_;              // the scale of Q*K', 0 means 1/sqrt(head_size)
+  int kv_cache_bit_width_;   // 8 or 4 when the kv cache is quantized, 0 for a kv cache of type T
+  bool do_rotary_;           // apply rotary embedding to Q and K
+  bool rotary_interleaved_;  // rotate the interleaved pairs of a head instead of its two halves
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -22,10 +22,13 @@ Status CheckInputs(const Tensor* query,
                    const Tensor* seqlens_k,
                    const Tensor* total_seqlen,
                    bool is_past_bsnh,
-                   float scale) {
+                   float scale,
+                   int past_row_size) {
   // Note: Here S* is past_cache_sequence_length, S- is past_sequence_length, S+ is sequence_length
   //     past_key                   : (B, N_k, S*, H) or (B, N_k, S-, H)
   //     past_value                 : (B, N_k, S*, H) or (B, N_k, S-, H)
+  // The last dimension of past_key and past_value is past_row_size instead of H when it is positive,
+  // which is the case for a quantized kv cache.
   // no packing for q/k/v:
   //     query            (Q)       : (B, S, D)
   //     key              (K)       : (B, S, D_kv)
@@ -115,14 +118,15 @@ Status CheckInputs(const Tensor* query,
       past_sequence_length = static_cast<int>(past_key_dims[1]);
     }
 
-    if (past_key_dims[3] != head_size) {
+    const int64_t past_head_dim = past_row_size > 0 ? past_row_size : head_size;
+    if (past_key_dims[3] != past_head_dim) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
-                             "Input 'past_key' dimension 3 should be same as head_size, got ",
+                             "Input 'past_key' dimension 3 should be ", past_head_dim, ", got ",
                              past_key_dims[3]);
     }
-    if (past_value_dims[3] != head_size) {
+    if (past_value_dims[3] != past_head_dim) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
-                             "Input 'past_value' dimension 3 should be same as head_size, got ",
+                             "Input 'past_value' dimension 3 should be ", past_head_dim, ", got ",
                              past_value_dims[3]);
     }
   } else if (past_key != nullptr || past_value != nullptr) {
@@ -215,12 +219,14 @@ Status CheckInputs(const Tensor* query,
                    const Tensor* total_seqlen,
                    bool is_past_bsnh,
                    float scale,
+                   int past_row_size,
                    int max_threads_per_block) {
   if (max_threads_per_block > 0 && num_heads > max_threads_per_block) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "num_heads should be no larger than ", max_threads_per_block);
   }
 
-  return CheckInputs(query, key, value, past_key, past_value, parameters, num_heads, kv_num_heads, seqlens_k, total_seqlen, is_past_bsnh, scale);
+  return CheckInputs(query, key, value, past_key, past_value, parameters, num_heads, kv_num_heads, seqlens_k, total_seqlen, is_past_bsnh, scale,
+                     past_row_size);
 }
 
 }  // namespace group_query_attention_helper
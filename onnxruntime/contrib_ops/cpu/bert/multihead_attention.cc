@@ -15,6 +15,7 @@
 #include "core/providers/cpu/tensor/reshape_helper.h"
 
 #include <unsupported/Eigen/SpecialFunctions>
+#include <optional>
 #include <vector>
 
 using onnxruntime::concurrency::ThreadPool;
@@ -269,6 +270,24 @@ Status MultiHeadAttention<T>::Compute(OpKernelContext* context) const {
     ORT_NOT_IMPLEMENTED("Packed KV not implemented for CPU");
   }
 
+  // The past key and value of cross attention may be shared by several consecutive batches of query, like the
+  // beams of beam search. Those batches are folded into the sequence dimension of query, which leaves the memory
+  // layout of query and output unchanged.
+  const auto& query_dims = query->Shape().GetDims();
+  const int64_t output_batch_size = query_dims[0];
+  const int64_t output_sequence_length = query_dims[1];
+  std::optional<Tensor> folded_query;
+  if (query_dims.size() == 3 && key != nullptr && value != nullptr &&
+      key->Shape().NumDimensions() == 4 && value->Shape().NumDimensions() == 4) {
+    const int64_t kv_batch_size = key->Shape()[0];
+    if (kv_batch_size > 0 && kv_batch_size != query_dims[0] && query_dims[0] % kv_batch_size == 0) {
+      folded_query.emplace(query->DataType(),
+                           TensorShape({kv_batch_size, query_dims[0] / kv_batch_size * query_dims[1], query_dims[2]}),
+                           const_cast<void*>(query->DataRaw()), query->Location());
+      query = &folded_query.value();
+    }
+  }
+
   AttentionParameters parameters = {};
   constexpr float scale = 1.0f;
   bool past_present_share_buffer = false;
@@ -298,8 +317,8 @@ Status MultiHeadAttention<T>::Compute(OpKernelContext* context) const {
   int v_hidden_size = parameters.v_hidden_size;
 
   std::vector<int64_t> output_shape(3);
-  output_shape[0] = static_cast<int64_t>(batch_size);
-  output_shape[1] = static_cast<int64_t>(q_sequence_length);
+  output_shape[0] = output_batch_size;
+  output_shape[1] = output_sequence_length;
   output_shape[2] = static_cast<int64_t>(parameters.v_hidden_size);
   Tensor* output = context->Output(0, output_shape);
 
@@ -126,6 +126,29 @@ Status CheckInputs(const T* input,
   return Status::OK();
 }
 
+// Rotates one head of head_size elements at the position whose rows of head_size / 2 elements of the cos and sin
+// caches are cos_data and sin_data. The output must not overlap the input.
+template <typename T>
+void RotateHead(const T* input_data, const T* cos_data, const T* sin_data, T* output_data, int head_size,
+                bool interleaved) {
+  const int half_head_size = head_size / 2;
+  int cache_idx = 0;
+  T sign = 0;
+  int j = 0;
+  for (int i = 0; i < head_size; i++) {
+    if (interleaved) {
+      cache_idx = (i / 2) % half_head_size;
+      sign = (i % 2 == 0) ? static_cast<T>(-1) : static_cast<T>(1);
+      j = (i % 2 == 0) ? i + 1 : i - 1;  // i - sign
+    } else {
+      cache_idx = i % half_head_size;
+      sign = (i < half_head_size) ? static_cast<T>(-1) : static_cast<T>(1);
+      j = (i + half_head_size) % head_size;
+    }
+    output_data[i] = input_data[i] * cos_data[cache_idx] + sign * input_data[j] * sin_data[cache_idx];
+  }
+}
+
 }  // namespace rotary_embedding_helper
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -0,0 +1,287 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/fused_elementwise.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+
+#include "core/common/narrow.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+using onnxruntime::concurrency::ThreadPool;
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+namespace {
+
+// Number of output elements computed by each step before moving to the next one.
+constexpr size_t kBlockSize = 1024;
+
+enum class InputKind {
+  Full,    // has the output shape
+  Scalar,  // has a single element
+  Row,     // has the size of the last dimension of the output, and is broadcast along the other dimensions
+};
+
+struct Operand {
+  const float* data;
+  bool is_scalar;
+};
+
+bool GetOpCode(const std::string& op_type, FusedElementwise::OpCode& op, bool& is_binary) {
+  using OpCode = FusedElementwise::OpCode;
+  static const std::pair<const char*, OpCode> binary_ops[] = {
+      {"Add", OpCode::Add}, {"Sub", OpCode::Sub}, {"Mul", OpCode::Mul}, {"Div", OpCode::Div}, {"Max", OpCode::Max},
+      {"Min", OpCode::Min}};
+  static const std::pair<const char*, OpCode> unary_ops[] = {
+      {"Neg", OpCode::Neg}, {"Abs", OpCode::Abs}, {"Relu", OpCode::Relu}, {"Sigmoid", OpCode::Sigmoid},
+      {"Tanh", OpCode::Tanh}, {"Exp", OpCode::Exp}, {"Sqrt", OpCode::Sqrt}, {"Reciprocal", OpCode::Reciprocal},
+      {"Erf", OpCode::Erf}};
+
+  for (const auto& entry : binary_ops) {
+    if (op_type == entry.first) {
+      op = entry.second;
+      is_binary = true;
+      return true;
+    }
+  }
+  for (const auto& entry : unary_ops) {
+    if (op_type == entry.first) {
+      op = entry.second;
+      is_binary = false;
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename Op>
+void ComputeBinary(const Operand& a, const Operand& b, float* output, size_t count, Op op) {
+  if (a.is_scalar && b.is_scalar) {
+    std::fill(output, output + count, op(*a.data, *b.data));
+  } else if (a.is_scalar) {
+    const float x = *a.data;
+    for (size_t i = 0; i < count; i++) {
+      output[i] = op(x, b.data[i]);
+    }
+  } else if (b.is_scalar) {
+    const float y = *b.data;
+    for (size_t i = 0; i < count; i++) {
+      output[i] = op(a.data[i], y);
+    }
+  } else {
+    for (size_t i = 0; i < count; i++) {
+      output[i] = op(a.data[i], b.data[i]);
+    }
+  }
+}
+
+template <typename Op>
+void ComputeUnary(const float* input, float* output, size_t count, Op op) {
+  for (size_t i = 0; i < count; i++) {
+    output[i] = op(input[i]);
+  }
+}
+
+void ComputeStep(FusedElementwise::OpCode op, const Operand& a, const Operand& b, float* output, size_t count) {
+  using OpCode = FusedElementwise::OpCode;
+
+  // A unary op of a scalar input is computed on the broadcast value. The unary ops follow Min in OpCode.
+  const float* input = a.data;
+  if (a.is_scalar && op >= OpCode::Neg) {
+    std::fill(output, output + count, *a.data);
+    input = output;
+  }
+
+  switch (op) {
+    case OpCode::Add:
+      ComputeBinary(a, b, output, count, [](float x, float y) { return x + y; });
+      break;
+    case OpCode::Sub:
+      ComputeBinary(a, b, output, count, [](float x, float y) { return x - y; });
+      break;
+    case OpCode::Mul:
+      ComputeBinary(a, b, output, count, [](float x, float y) { return x * y; });
+      break;
+    case OpCode::Div:
+      ComputeBinary(a, b, output, count, [](float x, float y) { return x / y; });
+      break;
+    case OpCode::Max:
+      ComputeBinary(a, b, output, count, [](float x, float y) { return std::max(x, y); });
+      break;
+    case OpCode::Min:
+      ComputeBinary(a, b, output, count, [](float x, float y) { return std::min(x, y); });
+      break;
+    case OpCode::Neg:
+      ComputeUnary(input, output, count, [](float x) { return -x; });
+      break;
+    case OpCode::Abs:
+      ComputeUnary(input, output, count, [](float x) { return std::abs(x); });
+      break;
+    case OpCode::Relu:
+      ComputeUnary(input, output, count, [](float x) { return std::max(x, 0.0f); });
+      break;
+    case OpCode::Sigmoid:
+      MlasComputeLogistic(input, output, count);
+      break;
+    case OpCode::Tanh:
+      MlasComputeTanh(input, output, count);
+      break;
+    case OpCode::Exp:
+      MlasComputeExp(input, output, count);
+      break;
+    case OpCode::Sqrt:
+      ComputeUnary(input, output, count, [](float x) { return std::sqrt(x); });
+      break;
+    case OpCode::Reciprocal:
+      ComputeUnary(input, output, count, [](float x) { return 1.0f / x; });
+      break;
+    case OpCode::Erf:
+      MlasComputeErf(input, output, count);
+      break;
+  }
+}
+
+// Copies elements [offset, offset + count) of a row input broadcast to the output into buffer.
+void BroadcastRow(const float* row, size_t row_size, size_t offset, size_t count, float* buffer) {
+  size_t start = offset % row_size;
+  while (count > 0) {
+    const size_t length = std::min(count, row_size - start);
+    std::copy_n(row + start, length, buffer);
+    buffer += length;
+    count -= length;
+    start = 0;
+  }
+}
+
+}  // namespace
+
+FusedElementwise::FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+  const auto ops = info.GetAttrsOrDefault<std::string>("ops");
+  const auto operands = info.GetAttrsOrDefault<int64_t>("operands");
+  ORT_ENFORCE(!ops.empty(), "FusedElementwise requires at least one op.");
+  ORT_ENFORCE(operands.size() == 2 * ops.size(), "FusedElementwise requires two operands per op.");
+
+  const int64_t num_inputs = static_cast<int64_t>(info.GetInputCount());
+  steps_.reserve(ops.size());
+  for (size_t i = 0; i < ops.size(); i++) {
+    Step step;
+    bool is_binary = false;
+    ORT_ENFORCE(GetOpCode(ops[i], step.op, is_binary), "FusedElementwise does not support op ", ops[i]);
+
+    // Each step can only use the inputs and the results of the steps before it.
+    const int64_t num_values = num_inputs + static_cast<int64_t>(i);
+    step.lhs = operands[2 * i];
+    step.rhs = operands[2 * i + 1];
+    ORT_ENFORCE(step.lhs >= 0 && step.lhs < num_values, "Invalid operand ", step.lhs, " for op ", i);
+    if (is_binary) {
+      ORT_ENFORCE(step.rhs >= 0 && step.rhs < num_values, "Invalid operand ", step.rhs, " for op ", i);
+    } else {
+      ORT_ENFORCE(step.rhs == -1, "Unary op ", i, " must have -1 as second operand.");
+    }
+    steps_.push_back(step);
+  }
+}
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  const int num_inputs = context->InputCount();
+
+  // The output has the shape of the first input.
+  const TensorShape& output_shape = context->Input<Tensor>(0)->Shape();
+  const size_t output_size = onnxruntime::narrow<size_t>(output_shape.Size());
+  const size_t num_dims = output_shape.NumDimensions();
+  const size_t row_size = num_dims > 0 ? onnxruntime::narrow<size_t>(output_shape[num_dims - 1]) : 1;
+
+  std::vector<InputKind> input_kinds(num_inputs);
+  std::vector<const float*> input_data(num_inputs);
+  size_t num_row_inputs = 0;
+  for (int i = 0; i < num_inputs; i++) {
+    const Tensor* input = context->Input<Tensor>(i);
+    const TensorShape& shape = input->Shape();
+    input_data[i] = input->Data<float>();
+    if (static_cast<size_t>(shape.Size()) == output_size) {
+      input_kinds[i] = InputKind::Full;
+    } else if (shape.Size() == 1) {
+      input_kinds[i] = InputKind::Scalar;
+    } else if (shape.NumDimensions() > 0 && static_cast<size_t>(shape.Size()) == row_size &&
+               static_cast<size_t>(shape[shape.NumDimensions() - 1]) == row_size) {
+      input_kinds[i] = InputKind::Row;
+      num_row_inputs++;
+    } else {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input ", i, " with shape ", shape,
+                             " can not be broadcast to the output shape ", output_shape);
+    }
+  }
+
+  Tensor* output = context->Output(0, output_shape);
+  if (output_size == 0) {
+    return Status::OK();
+  }
+  float* output_data = output->MutableData<float>();
+
+  const size_t num_steps = steps_.size();
+  const size_t num_blocks = (output_size + kBlockSize - 1) / kBlockSize;
+  const TensorOpCost cost{static_cast<double>(num_inputs * kBlockSize * sizeof(float)),
+                          static_cast<double>(kBlockSize * sizeof(float)),
+                          static_cast<double>(num_steps * kBlockSize)};
+
+  ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(num_blocks), cost,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        // The last step writes to the output, the others and the broadcast rows to this buffer.
+        std::vector<float> buffer((num_steps - 1 + num_row_inputs) * kBlockSize);
+        float* step_buffer = buffer.data();
+        float* row_buffer = step_buffer + (num_steps - 1) * kBlockSize;
+        std::vector<Operand> values(num_inputs + num_steps);
+
+        for (std::ptrdiff_t block = begin; block != end; ++block) {
+          const size_t offset = static_cast<size_t>(block) * kBlockSize;
+          const size_t count = std::min(kBlockSize, output_size - offset);
+
+          size_t row_index = 0;
+          for (int i = 0; i < num_inputs; i++) {
+            switch (input_kinds[i]) {
+              case InputKind::Full:
+                values[i] = {input_data[i] + offset, false};
+                break;
+              case InputKind::Scalar:
+                values[i] = {input_data[i], true};
+                break;
+              case InputKind::Row: {
+                float* row = row_buffer + row_index++ * kBlockSize;
+                BroadcastRow(input_data[i], row_size, offset, count, row);
+                values[i] = {row, false};
+                break;
+              }
+            }
+          }
+
+          for (size_t s = 0; s < num_steps; s++) {
+            const Step& step = steps_[s];
+            float* step_output = s + 1 == num_steps ? output_data + offset : step_buffer + s * kBlockSize;
+            const Operand& lhs = values[step.lhs];
+            const Operand& rhs = step.rhs >= 0 ? values[step.rhs] : lhs;
+            ComputeStep(step.op, lhs, rhs, step_output, count);
+            values[num_inputs + s] = {step_output, false};
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Runs a chain of element-wise ops created by ElementwiseChainFusion. The output is computed block by block, and
+// each op of the chain runs over the whole block before the next one, so that the intermediate values stay in cache
+// instead of making a pass over memory per op.
+class FusedElementwise final : public OpKernel {
+ public:
+  enum class OpCode {
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Max,
+    Min,
+    Neg,
+    Abs,
+    Relu,
+    Sigmoid,
+    Tanh,
+    Exp,
+    Sqrt,
+    Reciprocal,
+    Erf,
+  };
+
+  // The operands index the inputs of the node followed by the results of the previous steps.
+  // rhs is -1 for unary ops.
+  struct Step {
+    OpCode op;
+    int64_t lhs;
+    int64_t rhs;
+  };
+
+  explicit FusedElementwise(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  std::vector<Step> steps_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
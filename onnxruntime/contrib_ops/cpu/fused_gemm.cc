@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <type_traits>
+
 #include "core/providers/cpu/math/gemm.h"
 
 namespace onnxruntime {
@@ -14,6 +16,9 @@ class FusedGemm final : public Gemm<T> {
  public:
   FusedGemm(const OpKernelInfo& info) : Gemm<T>(info) {
     std::string activation = info.GetAttrOrDefault<std::string>("activation", "");
+    if (GetMlasActivation(info, activation, this->mlas_activation_)) {
+      return;
+    }
     NodeAttributes attrs;
     for (const auto& p : info.node().GetAttributes()) {
       if (p.first.size() > ACTIVATION_NAME_PREFIX_LEN && p.first.compare(0, ACTIVATION_NAME_PREFIX_LEN, ACTIVATION_NAME_PREFIX) == 0) {
@@ -22,6 +27,43 @@ class FusedGemm final : public Gemm<T> {
     }
     ORT_THROW_IF_ERROR(functors::ElementWiseRangedTransform<T>::Create(activation, attrs, this->activation_));
   }
+
+ private:
+  // Returns true if the activation is applied by MLAS to the GEMM output blocks of the float kernel.
+  static bool GetMlasActivation(const OpKernelInfo& info, const std::string& activation_type,
+                                std::optional<MLAS_ACTIVATION>& activation) {
+    if constexpr (!std::is_same_v<T, float>) {
+      return false;
+    }
+
+    MLAS_ACTIVATION mlas_activation;
+    if (activation_type == "Relu") {
+      mlas_activation.ActivationKind = MlasReluActivation;
+    } else if (activation_type == "Tanh") {
+      mlas_activation.ActivationKind = MlasTanhActivation;
+    } else if (activation_type == "Sigmoid") {
+      mlas_activation.ActivationKind = MlasLogisticActivation;
+    } else if (activation_type == "LeakyRelu") {
+      mlas_activation.ActivationKind = MlasLeakyReluActivation;
+      mlas_activation.Parameters.LeakyRelu.alpha = info.GetAttrOrDefault<float>("activation_alpha", 0.01f);
+    } else if (activation_type == "HardSigmoid") {
+      mlas_activation.ActivationKind = MlasHardSigmoidActivation;
+      mlas_activation.Parameters.HardSigmoid.alpha = info.GetAttrOrDefault<float>("activation_alpha", 0.2f);
+      mlas_activation.Parameters.HardSigmoid.beta = info.GetAttrOrDefault<float>("activation_beta", 0.5f);
+    } else if (activation_type == "Gelu") {
+      mlas_activation.ActivationKind = MlasGeluActivation;
+    } else if (activation_type == "FastGelu") {
+      mlas_activation.ActivationKind = MlasFastGeluActivation;
+    } else if (activation_type == "QuickGelu" && info.GetAttrOrDefault<float>("activation_alpha", 1.702f) == 1.0f) {
+      // QuickGelu(x) = x * Sigmoid(alpha * x), which is Silu for an alpha of one.
+      mlas_activation.ActivationKind = MlasSiluActivation;
+    } else {
+      return false;
+    }
+
+    activation = mlas_activation;
+    return true;
+  }
 };
 
 ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
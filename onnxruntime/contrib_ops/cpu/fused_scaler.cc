@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+
+#include "core/common/narrow.h"
+#include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Imputer followed by Scaler on float features. Each row of features is imputed and scaled in one pass, without the
+// intermediate imputed tensor.
+template <typename T>
+class FusedScaler final : public OpKernel {
+ public:
+  explicit FusedScaler(const OpKernelInfo& info)
+      : OpKernel(info),
+        imputed_values_(info.GetAttrsOrDefault<float>("imputed_value_floats")),
+        replaced_value_(info.GetAttrOrDefault<float>("replaced_value_float", 0.f)),
+        offset_(info.GetAttrsOrDefault<float>("offset")),
+        scale_(info.GetAttrsOrDefault<float>("scale")) {
+    ORT_ENFORCE(!imputed_values_.empty(), "Empty imputed_value_floats in attributes");
+    ORT_ENFORCE(!scale_.empty(), "Empty scale in attributes");
+    ORT_ENFORCE(scale_.size() == offset_.size(),
+                "Scale size: (", scale_.size(), ") != (", offset_.size(), ")");
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  std::vector<float> imputed_values_;
+  float replaced_value_;
+  std::vector<float> offset_;
+  std::vector<float> scale_;
+};
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    FusedScaler,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()).MayInplace(0, 0),
+    FusedScaler<float>);
+
+template <typename T>
+Status FusedScaler<T>::Compute(OpKernelContext* context) const {
+  const Tensor& X = *context->Input<Tensor>(0);
+  const TensorShape& x_shape = X.Shape();
+  const auto x_dims = x_shape.GetDims();
+  if (x_dims.empty()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid argument: input has empty dimensions.");
+  }
+
+  Tensor& Y = *context->Output(0, x_shape);
+  const size_t stride = onnxruntime::narrow<size_t>(x_dims.size() == 1 ? x_dims[0] : x_dims[1]);
+  if (x_shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  // As in Scaler, offset and scale have one value per feature or a single value, read with a step of 0. As in
+  // Imputer, the first imputed value is used for every feature unless there is one per feature.
+  size_t scale_step;
+  if (offset_.size() == stride && scale_.size() == stride) {
+    scale_step = 1;
+  } else if (offset_.size() == 1 && scale_.size() == 1) {
+    scale_step = 0;
+  } else {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Either both scale and offset can be of feature size (", stride, ") or 1");
+  }
+  const size_t imputed_step = imputed_values_.size() == stride ? 1 : 0;
+  const bool replace_nan = std::isnan(replaced_value_);
+
+  const T* x_data = X.Data<T>();
+  T* y_data = Y.MutableData<T>();
+  const auto row_count = static_cast<std::ptrdiff_t>(onnxruntime::narrow<size_t>(x_shape.Size()) / stride);
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), row_count,
+      TensorOpCost{static_cast<double>(stride * sizeof(T)), static_cast<double>(stride * sizeof(T)),
+                   static_cast<double>(stride) * 3.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const T* x = x_data + row * stride;
+          T* y = y_data + row * stride;
+          for (size_t c = 0; c < stride; ++c) {
+            T value = x[c];
+            if (replace_nan ? std::isnan(value) : value == replaced_value_) {
+              value = imputed_values_[c * imputed_step];
+            }
+            y[c] = (value - offset_[c * scale_step]) * scale_[c * scale_step];
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
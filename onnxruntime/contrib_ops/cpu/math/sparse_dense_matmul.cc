@@ -3,8 +3,11 @@
 
 #if !defined(DISABLE_SPARSE_TENSORS)
 
+#include <algorithm>
+
 #include "core/framework/sparse_tensor.h"
 #include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/providers/cpu/math/matmul_helper.h"
 #include "core/util/math.h"
@@ -119,8 +122,7 @@ struct SparseToDenseCsr {
     ConstEigenMatrixMapRowMajor<T> map_B(B.Data<T>(), narrow<Eigen::Index>(b_dims[0]), narrow<Eigen::Index>(b_dims[1]));
     EigenMatrixMapRowMajor<T> output_map(output.MutableData<T>(), narrow<Eigen::Index>(out_dims[0]),
                                          narrow<Eigen::Index>(out_dims[1]));
-    // XXX: Consider re-writing it as a parallel loop as Eigen requires it to use OpenMP
-    // XXX: Consider vectorization
+    // A is only multiplied here when transposed. See SparseToDenseCsrRows otherwise.
     SparseDenseMatMulImpl(ctx, map_A, map_B, output_map);
   }
 };
@@ -135,6 +137,72 @@ inline constexpr float Mul<float>(float a_value, float alpha, float b_value) {
   return a_value * alpha * b_value;
 }
 
+// Handle CSR sparse format when A is not transposed. Each row of the output is the sum of the rows of B selected by
+// the non-zeros of the same row of A, so the rows are computed in parallel, and the inner loop runs over the
+// contiguous values of a row of B and of the output unless B is transposed. Eigen runs the same product on one thread.
+template <typename T>
+struct SparseToDenseCsrRows {
+  void operator()(const ComputeCtx& ctx, const SparseTensor& A, const Tensor& B, Tensor& output,
+                  concurrency::ThreadPool* thread_pool) const {
+    const auto& b_dims = B.Shape().GetDims();
+    const auto& out_dims = output.Shape().GetDims();
+    auto csr_view = A.AsCsr();
+    const int64_t* outer = csr_view.Outer().Data<int64_t>();
+    const int64_t* inner = csr_view.Inner().Data<int64_t>();
+    const T* a_values = A.Values().Data<T>();
+    const T* b_data = B.Data<T>();
+    T* out_data = output.MutableData<T>();
+
+    const auto num_rows = narrow<std::ptrdiff_t>(out_dims[0]);
+    const auto N = narrow<size_t>(out_dims[1]);
+    const auto ldb = narrow<size_t>(b_dims[1]);
+    const bool trans_B = ctx.trans_B;
+    const float alpha = ctx.alpha;
+
+    const double nnz_per_row = static_cast<double>(A.NumValues()) / std::max<std::ptrdiff_t>(num_rows, 1);
+    const TensorOpCost cost{nnz_per_row * N * sizeof(T), static_cast<double>(N * sizeof(T)), nnz_per_row * N * 2};
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool, num_rows, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t m = begin; m < end; ++m) {
+            T* out_row = out_data + m * N;
+            std::fill_n(out_row, N, T{});
+            for (int64_t i = outer[m]; i < outer[m + 1]; ++i) {
+              const auto k = narrow<size_t>(inner[i]);
+              const T a_value = a_values[i];
+              if (trans_B) {
+                const T* b_column = b_data + k;
+                for (size_t n = 0; n < N; ++n) {
+                  out_row[n] += Mul(a_value, alpha, b_column[n * ldb]);
+                }
+              } else {
+                const T* b_row = b_data + k * ldb;
+                for (size_t n = 0; n < N; ++n) {
+                  out_row[n] += Mul(a_value, alpha, b_row[n]);
+                }
+              }
+            }
+          }
+        });
+  }
+};
+
+// Verifies that the outer indices of the CSR tensor are non-decreasing from 0 to NNZ and that its inner indices,
+// which index the columns of the dense shape, are within it.
+Status ValidateCsrIndices(const SparseTensor& A) {
+  auto csr_view = A.AsCsr();
+  const auto outer = csr_view.Outer().DataAsSpan<int64_t>();
+  const auto inner = csr_view.Inner().DataAsSpan<int64_t>();
+  const auto num_cols = A.DenseShape().GetDims()[1];
+
+  ORT_RETURN_IF_NOT(outer.front() == 0 && outer.back() == static_cast<int64_t>(inner.size()),
+                    "CSR outer indices must start at 0 and end at NNZ: ", inner.size());
+  ORT_RETURN_IF_NOT(std::is_sorted(outer.begin(), outer.end()), "CSR outer indices must be non-decreasing");
+  for (const auto k : inner) {
+    ORT_RETURN_IF_NOT(k >= 0 && k < num_cols, "CSR inner index: ", k, " is out of bounds of columns: ", num_cols);
+  }
+  return Status::OK();
+}
+
 // Inspired by TensorFlow SparseTensorDenseMatmul
 template <typename T>
 struct SparseToDenseCoo {
@@ -223,7 +291,12 @@ Status SparseToDenseMatMul::Compute(OpKernelContext* ctx) const {
     ORT_RETURN_IF_NOT(A->Values().Shape().Size() == csr_view.Inner().Shape().Size(),
                       "Expecting the same number NNZ == size of Inner indices");
     ORT_RETURN_IF_NOT((A_shape.GetDims()[0] + 1) == csr_view.Outer().Shape().Size(), "Outer size must be M + 1");
-    t_disp.Invoke<SparseToDenseCsr>(compute_ctx, *A, *B, *output);
+    ORT_RETURN_IF_ERROR(ValidateCsrIndices(*A));
+    if (compute_ctx.trans_A) {
+      t_disp.Invoke<SparseToDenseCsr>(compute_ctx, *A, *B, *output);
+    } else {
+      t_disp.Invoke<SparseToDenseCsrRows>(compute_ctx, *A, *B, *output, ctx->GetOperatorThreadPool());
+    }
   } else {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Currently support only COO and CSR(x64) formats");
   }
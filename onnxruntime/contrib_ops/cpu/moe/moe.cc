@@ -0,0 +1,308 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/moe/moe.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+using onnxruntime::concurrency::ThreadPool;
+
+namespace onnxruntime {
+namespace contrib {
+
+// These ops are internal-only, so register outside of onnx
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    MoE,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    MoE<float>);
+
+namespace {
+
+// Experts with at least this many rows run their GEMMs one after another on the thread pool. Below it, each GEMM is
+// too small to split, so the experts run in parallel with one thread each.
+constexpr int64_t kMinRowsForThreadedGemm = 64;
+
+Status CheckInputs(MoEParameters& parameters,
+                   const Tensor* input,
+                   const Tensor* router_probs,
+                   const Tensor* fc1_experts_weights,
+                   const Tensor* fc2_experts_weights,
+                   const Tensor* fc1_experts_bias_optional,
+                   const Tensor* fc2_experts_bias_optional,
+                   int64_t k) {
+  const auto& input_dims = input->Shape().GetDims();
+  const auto& router_probs_dims = router_probs->Shape().GetDims();
+  const auto& fc1_experts_weights_dims = fc1_experts_weights->Shape().GetDims();
+  const auto& fc2_experts_weights_dims = fc2_experts_weights->Shape().GetDims();
+
+  if (input_dims.size() != 2 && input_dims.size() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "input must be 2D or 3D, got ", input_dims.size());
+  }
+  if (router_probs_dims.size() != 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "router_probs_dims must be 2D, got ",
+                           router_probs_dims.size());
+  }
+  if (fc1_experts_weights_dims.size() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "fc1_experts_weights_dims must be 3D, got ",
+                           fc1_experts_weights_dims.size());
+  }
+  if (fc2_experts_weights_dims.size() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "fc2_experts_weights_dims must be 3D, got ",
+                           fc2_experts_weights_dims.size());
+  }
+
+  int64_t num_rows = input_dims.size() == 2 ? input_dims[0] : input_dims[0] * input_dims[1];
+  int64_t hidden_size = input_dims[input_dims.size() - 1];
+  int64_t num_experts = router_probs_dims[1];
+  int64_t inter_size = fc1_experts_weights_dims[2];
+
+  if (router_probs_dims[0] != num_rows) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "router_probs_dims[0] must be equal to num_rows, got ",
+                           router_probs_dims[0], " and ", num_rows);
+  }
+  if (fc1_experts_weights_dims[0] != num_experts || fc2_experts_weights_dims[0] != num_experts) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "fc1_experts_weights_dims[0] and fc2_experts_weights_dims[0] must be equal to num_experts, "
+                           "got ", fc1_experts_weights_dims[0], ", ", fc2_experts_weights_dims[0],
+                           " and ", num_experts);
+  }
+  if (fc1_experts_weights_dims[1] != hidden_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "fc1_experts_weights_dims[1] must be equal to hidden_size, got ",
+                           fc1_experts_weights_dims[1], " and ", hidden_size);
+  }
+  if (fc2_experts_weights_dims[1] != inter_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "fc2_experts_weights_dims[1] must be equal to inter_size, got ",
+                           fc2_experts_weights_dims[1], " and ", inter_size);
+  }
+  if (fc2_experts_weights_dims[2] != hidden_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "fc2_experts_weights_dims[2] must be equal to hidden_size, got ",
+                           fc2_experts_weights_dims[2], " and ", hidden_size);
+  }
+  if ((fc1_experts_bias_optional == nullptr) != (fc2_experts_bias_optional == nullptr)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "fc1_experts_bias and fc2_experts_bias must be both set or both not set");
+  }
+  if (fc1_experts_bias_optional != nullptr) {
+    const auto& fc1_experts_bias_dims = fc1_experts_bias_optional->Shape().GetDims();
+    const auto& fc2_experts_bias_dims = fc2_experts_bias_optional->Shape().GetDims();
+    if (fc1_experts_bias_dims.size() != 2 || fc1_experts_bias_dims[0] != num_experts ||
+        fc1_experts_bias_dims[1] != inter_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "fc1_experts_bias must have shape (num_experts, inter_size), got ",
+                             fc1_experts_bias_optional->Shape());
+    }
+    if (fc2_experts_bias_dims.size() != 2 || fc2_experts_bias_dims[0] != num_experts ||
+        fc2_experts_bias_dims[1] != hidden_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "fc2_experts_bias must have shape (num_experts, hidden_size), got ",
+                             fc2_experts_bias_optional->Shape());
+    }
+  }
+  if (k < 1 || k > num_experts) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "k must be in the range [1, num_experts], got ", k,
+                           " and ", num_experts);
+  }
+
+  parameters.num_rows = num_rows;
+  parameters.num_experts = num_experts;
+  parameters.hidden_size = hidden_size;
+  parameters.inter_size = inter_size;
+  return Status::OK();
+}
+
+// Adds the bias of an expert to its fc1 output and applies the activation in place.
+void ApplyBiasActivation(float* data, const float* bias, int64_t rows, int64_t cols,
+                         MoEActivationType activation_type) {
+  for (int64_t r = 0; r < rows; r++) {
+    float* row = data + r * cols;
+    for (int64_t c = 0; c < cols; c++) {
+      float x = row[c] + (bias != nullptr ? bias[c] : 0.0f);
+      switch (activation_type) {
+        case MoEActivationType::Relu:
+          x = std::max(x, 0.0f);
+          break;
+        case MoEActivationType::Gelu:
+          // Same tanh approximation as the CUDA kernel.
+          x = 0.5f * x * (1.0f + std::tanh(0.7978845608028654f * x * (1.0f + 0.044715f * x * x)));
+          break;
+        case MoEActivationType::Silu:
+          x = x / (1.0f + std::exp(-x));
+          break;
+        case MoEActivationType::Identity:
+          break;
+      }
+      row[c] = x;
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+MoE<T>::MoE(const OpKernelInfo& info) : OpKernel(info) {
+  ORT_ENFORCE(info.GetAttr<int64_t>("k", &k_).IsOK());
+
+  std::string activation_type_str;
+  ORT_ENFORCE(info.GetAttr<std::string>("activation_type", &activation_type_str).IsOK());
+  if (activation_type_str == "relu") {
+    activation_type_ = MoEActivationType::Relu;
+  } else if (activation_type_str == "gelu") {
+    activation_type_ = MoEActivationType::Gelu;
+  } else if (activation_type_str == "silu") {
+    activation_type_ = MoEActivationType::Silu;
+  } else if (activation_type_str == "identity") {
+    activation_type_ = MoEActivationType::Identity;
+  } else {
+    ORT_THROW("Unsupported MoE activation type: ", activation_type_str);
+  }
+}
+
+template <typename T>
+Status MoE<T>::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* router_probs = context->Input<Tensor>(1);
+  const Tensor* fc1_experts_weights = context->Input<Tensor>(2);
+  const Tensor* fc2_experts_weights = context->Input<Tensor>(3);
+  const Tensor* fc1_experts_bias_optional = context->Input<Tensor>(4);
+  const Tensor* fc2_experts_bias_optional = context->Input<Tensor>(5);
+
+  MoEParameters parameters = {};
+  ORT_RETURN_IF_ERROR(CheckInputs(parameters, input, router_probs, fc1_experts_weights, fc2_experts_weights,
+                                  fc1_experts_bias_optional, fc2_experts_bias_optional, k_));
+
+  Tensor* output = context->Output(0, input->Shape());
+
+  const int64_t num_rows = parameters.num_rows;
+  const int64_t num_experts = parameters.num_experts;
+  const int64_t hidden_size = parameters.hidden_size;
+  const int64_t inter_size = parameters.inter_size;
+  const int64_t num_expanded_rows = num_rows * k_;
+  if (num_rows == 0) {
+    return Status::OK();
+  }
+
+  const T* input_data = input->Data<T>();
+  const T* router_probs_data = router_probs->Data<T>();
+  const T* fc1_weights_data = fc1_experts_weights->Data<T>();
+  const T* fc2_weights_data = fc2_experts_weights->Data<T>();
+  const T* fc1_bias_data = fc1_experts_bias_optional == nullptr ? nullptr : fc1_experts_bias_optional->Data<T>();
+  const T* fc2_bias_data = fc2_experts_bias_optional == nullptr ? nullptr : fc2_experts_bias_optional->Data<T>();
+  T* output_data = output->MutableData<T>();
+
+  // Top-k gating: the scale of a selected expert is its softmax probability. Ties go to the lower expert index.
+  std::vector<int64_t> expert_for_row(onnxruntime::narrow<size_t>(num_expanded_rows));
+  std::vector<float> expert_scales(onnxruntime::narrow<size_t>(num_expanded_rows));
+  std::vector<int64_t> rows_per_expert(onnxruntime::narrow<size_t>(num_experts), 0);
+  std::vector<float> probs(onnxruntime::narrow<size_t>(num_experts));
+  for (int64_t row = 0; row < num_rows; row++) {
+    const T* logits = router_probs_data + row * num_experts;
+    const float max_logit = *std::max_element(logits, logits + num_experts);
+    float sum = 0.0f;
+    for (int64_t e = 0; e < num_experts; e++) {
+      probs[e] = std::exp(logits[e] - max_logit);
+      sum += probs[e];
+    }
+    for (int64_t i = 0; i < k_; i++) {
+      const int64_t expert = std::max_element(probs.begin(), probs.end()) - probs.begin();
+      expert_for_row[row * k_ + i] = expert;
+      expert_scales[row * k_ + i] = probs[expert] / sum;
+      rows_per_expert[expert]++;
+      probs[expert] = -std::numeric_limits<float>::infinity();
+    }
+  }
+
+  // Group the expanded rows by expert, so that the rows of an expert are contiguous from expert_offsets[e].
+  std::vector<int64_t> expert_offsets(onnxruntime::narrow<size_t>(num_experts) + 1, 0);
+  std::vector<int64_t> active_experts;
+  for (int64_t e = 0; e < num_experts; e++) {
+    expert_offsets[e + 1] = expert_offsets[e] + rows_per_expert[e];
+    if (rows_per_expert[e] > 0) {
+      active_experts.push_back(e);
+    }
+  }
+  std::vector<int64_t> dest_row(onnxruntime::narrow<size_t>(num_expanded_rows));
+  {
+    std::vector<int64_t> next_row(expert_offsets.begin(), expert_offsets.end() - 1);
+    for (int64_t i = 0; i < num_expanded_rows; i++) {
+      dest_row[i] = next_row[expert_for_row[i]]++;
+    }
+  }
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+  auto permuted_input = IAllocator::MakeUniquePtr<T>(allocator, SafeInt<size_t>(num_expanded_rows) * hidden_size);
+  auto fc1_output = IAllocator::MakeUniquePtr<T>(allocator, SafeInt<size_t>(num_expanded_rows) * inter_size);
+  auto fc2_output = IAllocator::MakeUniquePtr<T>(allocator, SafeInt<size_t>(num_expanded_rows) * hidden_size);
+
+  for (int64_t i = 0; i < num_expanded_rows; i++) {
+    std::copy_n(input_data + (i / k_) * hidden_size, hidden_size, permuted_input.get() + dest_row[i] * hidden_size);
+  }
+
+  ThreadPool* tp = context->GetOperatorThreadPool();
+  auto run_expert = [&](int64_t expert, ThreadPool* gemm_tp) {
+    const int64_t first_row = expert_offsets[expert];
+    const size_t rows = onnxruntime::narrow<size_t>(rows_per_expert[expert]);
+    T* fc1_rows = fc1_output.get() + first_row * inter_size;
+    MlasGemm(CblasNoTrans, CblasNoTrans, rows, onnxruntime::narrow<size_t>(inter_size),
+             onnxruntime::narrow<size_t>(hidden_size), 1.0f, permuted_input.get() + first_row * hidden_size,
+             onnxruntime::narrow<size_t>(hidden_size), fc1_weights_data + expert * hidden_size * inter_size,
+             onnxruntime::narrow<size_t>(inter_size), 0.0f, fc1_rows, onnxruntime::narrow<size_t>(inter_size),
+             gemm_tp);
+    ApplyBiasActivation(fc1_rows, fc1_bias_data == nullptr ? nullptr : fc1_bias_data + expert * inter_size,
+                        rows_per_expert[expert], inter_size, activation_type_);
+    MlasGemm(CblasNoTrans, CblasNoTrans, rows, onnxruntime::narrow<size_t>(hidden_size),
+             onnxruntime::narrow<size_t>(inter_size), 1.0f, fc1_rows, onnxruntime::narrow<size_t>(inter_size),
+             fc2_weights_data + expert * inter_size * hidden_size, onnxruntime::narrow<size_t>(hidden_size), 0.0f,
+             fc2_output.get() + first_row * hidden_size, onnxruntime::narrow<size_t>(hidden_size), gemm_tp);
+  };
+
+  const int64_t num_active_experts = static_cast<int64_t>(active_experts.size());
+  if (num_expanded_rows >= kMinRowsForThreadedGemm * num_active_experts) {
+    for (int64_t expert : active_experts) {
+      run_expert(expert, tp);
+    }
+  } else {
+    ThreadPool::TrySimpleParallelFor(tp, static_cast<std::ptrdiff_t>(num_active_experts),
+                                     [&](std::ptrdiff_t i) { run_expert(active_experts[i], nullptr); });
+  }
+
+  // Sum the expert outputs of each row weighted by their scales.
+  const double cost = static_cast<double>(k_ * hidden_size * 2);
+  ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_rows), cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t row = begin; row < end; row++) {
+          T* output_row = output_data + row * hidden_size;
+          std::fill_n(output_row, hidden_size, 0.0f);
+          for (int64_t i = row * k_; i < (row + 1) * k_; i++) {
+            const float scale = expert_scales[i];
+            const T* expert_row = fc2_output.get() + dest_row[i] * hidden_size;
+            const T* bias = fc2_bias_data == nullptr ? nullptr : fc2_bias_data + expert_for_row[i] * hidden_size;
+            for (int64_t c = 0; c < hidden_size; c++) {
+              output_row[c] += scale * (expert_row[c] + (bias != nullptr ? bias[c] : 0.0f));
+            }
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
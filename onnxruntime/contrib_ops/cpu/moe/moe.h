@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+enum class MoEActivationType {
+  Relu,
+  Gelu,
+  Silu,
+  Identity,
+};
+
+struct MoEParameters {
+  int64_t num_rows;
+  int64_t num_experts;
+  int64_t hidden_size;
+  int64_t inter_size;
+};
+
+// Mixture of experts on CPU. Rows are grouped by the experts they are routed to, so that each active expert runs
+// one GEMM over its rows for each of the two layers, and experts that no row selects are not touched.
+template <typename T>
+class MoE final : public OpKernel {
+ public:
+  MoE(const OpKernelInfo& info);
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t k_;
+  MoEActivationType activation_type_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -11,11 +11,46 @@
 #include "core/platform/threadpool.h"
 #include "core/mlas/inc/mlas.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+
 using onnxruntime::concurrency::ThreadPool;
 
 namespace onnxruntime {
 namespace contrib {
 
+namespace {
+
+// Attention probabilities are quantized to uint8 with this scale and a zero point of 0.
+constexpr float kProbabilityScale = 1.0f / 255.0f;
+
+// exp(-x) is looked up for x in [0, kExpTableSize / kExpTableStepsPerUnit). Scores further below the maximum of
+// their row get a probability of 0, which is below the resolution of the quantized probabilities anyway.
+constexpr int kExpTableStepsPerUnit = 64;
+constexpr int kExpTableSize = 1024;
+
+const std::array<float, kExpTableSize>& ExpLookupTable() {
+  static const std::array<float, kExpTableSize> table = []() {
+    std::array<float, kExpTableSize> t{};
+    for (int i = 0; i < kExpTableSize; i++) {
+      t[i] = std::exp(-static_cast<float>(i) / kExpTableStepsPerUnit);
+    }
+    return t;
+  }();
+  return table;
+}
+
+float GetSymmetricScale(const float* data, size_t size) {
+  float min;
+  float max;
+  MlasFindMinMaxElement(data, &min, &max, size);
+  const float max_abs = std::max(std::abs(min), std::abs(max));
+  return max_abs > 0.0f ? max_abs / 127.0f : 1.0f;
+}
+
+}  // namespace
+
 template <typename T>
 class QAttention : public OpKernel, public AttentionCPUBase {
  public:
@@ -32,10 +67,23 @@ class QAttention : public OpKernel, public AttentionCPUBase {
                                    /*out*/ bool& used_shared_buffers) override;
 
  private:
+  // Computes output(B, S, N, H) = Softmax(alpha x Q x K') x V with Q, K, V and the attention probabilities
+  // quantized to 8 bits, one head at a time.
+  void ComputeQuantizedAttention(const float* Q,  // Q data with shape BxNxSxH
+                                 const float* K,  // K data with shape BxNxSxH
+                                 const float* V,  // V data with shape BxNxSxH
+                                 float* output,   // output data with shape BxSxNxH
+                                 int batch_size,
+                                 int sequence_length,
+                                 int head_size,
+                                 AllocatorPtr allocator,
+                                 ThreadPool* tp) const;
+
   IAllocatorUniquePtr<void> packed_weights_;
   size_t packed_weights_size_;
   TensorShape weight_shape_;
   bool weights_is_signed_;
+  bool quantized_attention_;
 };
 
 // These ops are internal-only, so register outside of onnx
@@ -54,6 +102,7 @@ ONNX_OPERATOR_TYPED_KERNEL_EX(
 
 template <typename T>
 QAttention<T>::QAttention(const OpKernelInfo& info) : OpKernel(info), AttentionCPUBase(info, true) {
+  quantized_attention_ = info.GetAttrOrDefault<int64_t>("quantized_attention", 0) != 0;
 }
 
 template <typename T>
@@ -287,6 +336,14 @@ Status QAttention<T>::Compute(OpKernelContext* context) const {
     MlasGemmBatch(gemm_shape, gemm_data_vec.data(), loop_len, tp);
   }
 
+  // Without a mask or a past state, both matrix multiplications of the attention can be done in 8 bits.
+  if (quantized_attention_ && mask_index == nullptr && past_tensor == nullptr && context->OutputCount() == 1) {
+    ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+    ComputeQuantizedAttention(Q, K, V, output->MutableData<T>(), batch_size, sequence_length, head_size,
+                              allocator, tp);
+    return Status::OK();
+  }
+
   // Compute the attention score and apply the score to V
   return ApplyAttention(Q, K, V, mask_index, past_tensor, nullptr /* past_key */, nullptr /* past_value*/,
                         output, nullptr /* present_key */, nullptr /* present_value */,
@@ -294,5 +351,128 @@ Status QAttention<T>::Compute(OpKernelContext* context) const {
                         head_size, head_size, hidden_size, nullptr /* rel_pos_bias */, context);
 }
 
+template <typename T>
+void QAttention<T>::ComputeQuantizedAttention(const float* Q,
+                                              const float* K,
+                                              const float* V,
+                                              float* output,
+                                              int batch_size,
+                                              int sequence_length,
+                                              int head_size,
+                                              AllocatorPtr allocator,
+                                              ThreadPool* tp) const {
+  const size_t S = static_cast<size_t>(sequence_length);
+  const size_t H = static_cast<size_t>(head_size);
+  const size_t head_chunk_length = S * H;
+  const size_t output_ld = static_cast<size_t>(num_heads_) * H;
+  const float alpha = scale_ == 0.0f ? 1.0f / std::sqrt(static_cast<float>(head_size)) : scale_;
+  const bool causal = is_unidirectional_;
+  const auto& exp_table = ExpLookupTable();
+
+  // Q is quantized to uint8 with a zero point of 128, K and V to int8 with a zero point of 0.
+  constexpr uint8_t q_zero_point = 128;
+  const uint8_t zero_point = 0;
+
+  const double cost = static_cast<double>(S) * S * H * 2;
+  ThreadPool::TryParallelFor(tp, SafeInt<ptrdiff_t>(batch_size) * num_heads_, cost, [&](std::ptrdiff_t begin,
+                                                                                          std::ptrdiff_t end) {
+    auto q_quant = IAllocator::MakeUniquePtr<uint8_t>(allocator, head_chunk_length);
+    auto k_quant = IAllocator::MakeUniquePtr<int8_t>(allocator, head_chunk_length);
+    auto k_transposed = IAllocator::MakeUniquePtr<int8_t>(allocator, head_chunk_length);
+    auto v_quant = IAllocator::MakeUniquePtr<int8_t>(allocator, head_chunk_length);
+    auto scores = IAllocator::MakeUniquePtr<int32_t>(allocator, S * S);
+    auto probs = IAllocator::MakeUniquePtr<uint8_t>(allocator, S * S);
+    auto exp_row = IAllocator::MakeUniquePtr<float>(allocator, S);
+    auto out_acc = IAllocator::MakeUniquePtr<int32_t>(allocator, head_chunk_length);
+
+    for (std::ptrdiff_t i = begin; i != end; ++i) {
+      const float* q = Q + head_chunk_length * i;
+      const float* k = K + head_chunk_length * i;
+      const float* v = V + head_chunk_length * i;
+
+      const float q_scale = GetSymmetricScale(q, head_chunk_length);
+      const float k_scale = GetSymmetricScale(k, head_chunk_length);
+      const float v_scale = GetSymmetricScale(v, head_chunk_length);
+      MlasQuantizeLinear(q, q_quant.get(), head_chunk_length, q_scale, q_zero_point);
+      MlasQuantizeLinear(k, k_quant.get(), head_chunk_length, k_scale, static_cast<int8_t>(0));
+      MlasQuantizeLinear(v, v_quant.get(), head_chunk_length, v_scale, static_cast<int8_t>(0));
+
+      // K' (H x S) is the right hand side of the first multiplication.
+      for (size_t s = 0; s < S; s++) {
+        for (size_t h = 0; h < H; h++) {
+          k_transposed.get()[h * S + s] = k_quant.get()[s * H + h];
+        }
+      }
+
+      // scores(S, S) = Q(S, H) x K'(H, S) in int32
+      MLAS_GEMM_QUANT_SHAPE_PARAMS score_shape;
+      score_shape.M = S;
+      score_shape.N = S;
+      score_shape.K = H;
+      score_shape.BIsSigned = true;
+
+      MLAS_GEMM_QUANT_DATA_PARAMS score_params;
+      score_params.A = q_quant.get();
+      score_params.lda = H;
+      score_params.ZeroPointA = q_zero_point;
+      score_params.B = k_transposed.get();
+      score_params.ldb = S;
+      score_params.ZeroPointB = &zero_point;
+      score_params.C = scores.get();
+      score_params.ldc = S;
+      MlasGemm(score_shape, score_params, nullptr);
+
+      // Softmax of each row with exp looked up from the distance to the row maximum, quantized to uint8.
+      const float score_scale = alpha * q_scale * k_scale * kExpTableStepsPerUnit;
+      for (size_t s = 0; s < S; s++) {
+        const int32_t* score_row = scores.get() + s * S;
+        uint8_t* prob_row = probs.get() + s * S;
+        const size_t valid_length = causal ? s + 1 : S;
+
+        const int32_t max_score = *std::max_element(score_row, score_row + valid_length);
+        float sum = 0.0f;
+        for (size_t t = 0; t < valid_length; t++) {
+          const float index = static_cast<float>(max_score - score_row[t]) * score_scale;
+          const float e = index < kExpTableSize - 0.5f ? exp_table[static_cast<int>(index + 0.5f)] : 0.0f;
+          exp_row.get()[t] = e;
+          sum += e;
+        }
+
+        // sum >= 1 because the maximum maps to exp(0).
+        const float prob_multiplier = 1.0f / (sum * kProbabilityScale);
+        for (size_t t = 0; t < valid_length; t++) {
+          prob_row[t] = static_cast<uint8_t>(exp_row.get()[t] * prob_multiplier + 0.5f);
+        }
+        std::fill(prob_row + valid_length, prob_row + S, static_cast<uint8_t>(0));
+      }
+
+      // output(S, H) = probs(S, S) x V(S, H), dequantized into the (B, S, N, H) output.
+      const std::ptrdiff_t batch_index = i / num_heads_;
+      const std::ptrdiff_t head_index = i % num_heads_;
+      const float output_scale = kProbabilityScale * v_scale;
+      MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR output_processor(
+          output + batch_index * S * output_ld + head_index * H, output_ld, &output_scale, nullptr);
+
+      MLAS_GEMM_QUANT_SHAPE_PARAMS output_shape;
+      output_shape.M = S;
+      output_shape.N = H;
+      output_shape.K = S;
+      output_shape.BIsSigned = true;
+
+      MLAS_GEMM_QUANT_DATA_PARAMS output_params;
+      output_params.A = probs.get();
+      output_params.lda = S;
+      output_params.ZeroPointA = 0;
+      output_params.B = v_quant.get();
+      output_params.ldb = H;
+      output_params.ZeroPointB = &zero_point;
+      output_params.C = out_acc.get();
+      output_params.ldc = H;
+      output_params.OutputProcessor = &output_processor;
+      MlasGemm(output_shape, output_params, nullptr);
+    }
+  });
+}
+
 }  // namespace contrib
 }  // namespace onnxruntime
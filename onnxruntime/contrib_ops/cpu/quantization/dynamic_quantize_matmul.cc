@@ -3,6 +3,7 @@
 
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
+#include "core/framework/kernel_dispatch.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
 #include "core/providers/cpu/math/matmul_helper.h"
@@ -11,6 +12,8 @@
 #include "core/util/qmath.h"
 
 #include <algorithm>
+#include <cmath>
+#include <vector>
 
 namespace onnxruntime {
 namespace contrib {
@@ -35,6 +38,67 @@ void ScaleOutput(const Tensor& scale, Tensor& output) {
 
   BroadcastLooper(broadcast_helper, funcs);
 }
+
+// Converts the int32 output of QGEMM to float when each row of A has its own scale.
+class PerRowScaleBiasOutputProcessor : public MLAS_QGEMM_OUTPUT_PROCESSOR {
+ public:
+  PerRowScaleBiasOutputProcessor(float* output,
+                                 size_t ldo,
+                                 const float* a_row_scales,
+                                 const float* b_scales,
+                                 bool is_b_scale_per_column,
+                                 const float* bias)
+      : output_(output),
+        ldo_(ldo),
+        a_row_scales_(a_row_scales),
+        b_scales_(b_scales),
+        is_b_scale_per_column_(is_b_scale_per_column),
+        bias_(bias) {}
+
+  void Process(const int32_t* C, size_t start_m, size_t start_n, size_t count_m, size_t count_n,
+               size_t ldc) const override {
+    for (size_t m = start_m; m < start_m + count_m; m++) {
+      const int32_t* c = C + m * ldc;
+      float* y = output_ + m * ldo_;
+      const float a_scale = a_row_scales_[m];
+      for (size_t n = start_n; n < start_n + count_n; n++) {
+        const float scale = a_scale * (is_b_scale_per_column_ ? b_scales_[n] : b_scales_[0]);
+        y[n] = static_cast<float>(c[n]) * scale + (bias_ != nullptr ? bias_[n] : 0.0f);
+      }
+    }
+  }
+
+ private:
+  float* output_;
+  size_t ldo_;
+  const float* a_row_scales_;
+  const float* b_scales_;
+  bool is_b_scale_per_column_;
+  const float* bias_;
+};
+
+// Quantizes each row of A symmetrically with its own scale. The zero point is 128 for all rows, so that QGEMM can
+// still use a single zero point for A.
+constexpr uint8_t kPerRowZeroPoint = 128;
+
+void QuantizePerRow(const float* a_data, uint8_t* a_data_quant, float* a_row_scales, size_t rows, size_t K,
+                    concurrency::ThreadPool* thread_pool) {
+  const TensorOpCost unit_cost{static_cast<double>(K * sizeof(float)), static_cast<double>(K * sizeof(uint8_t)),
+                               static_cast<double>(K) * 3.0};
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(rows), unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t row = begin; row < end; row++) {
+          const float* input = a_data + row * K;
+          float min;
+          float max;
+          MlasFindMinMaxElement(input, &min, &max, K);
+          const float max_abs = std::max(std::abs(min), std::abs(max));
+          const float scale = max_abs > 0.0f ? max_abs / 127.0f : 1.0f;
+          a_row_scales[row] = scale;
+          MlasQuantizeLinear(input, a_data_quant + row * K, K, scale, kPerRowZeroPoint);
+        }
+      });
+}
 }  // namespace
 
 class MatMulIntegerToFloatBase : public MatMulIntegerBase {
@@ -54,7 +118,8 @@ class MatMulIntegerToFloatBase : public MatMulIntegerBase {
                        const Tensor* b_tensor,
                        const Tensor* b_scale,
                        const Tensor* b_zp,
-                       const Tensor* bias_tensor) const;
+                       const Tensor* bias_tensor,
+                       const float* a_row_scales = nullptr) const;
 };
 
 Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
@@ -66,7 +131,8 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
                                                const Tensor* b_tensor,
                                                const Tensor* b_scale_tensor,
                                                const Tensor* b_zp_tensor,
-                                               const Tensor* bias_tensor) const {
+                                               const Tensor* bias_tensor,
+                                               const float* a_row_scales) const {
   MatMulComputeHelper helper;
   ORT_RETURN_IF_ERROR(helper.Compute(a_shape,
                                      b_tensor ? b_tensor->Shape() : b_shape_,
@@ -126,18 +192,33 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
 
   const size_t num_gemms = helper.OutputOffsets().size();
   std::vector<MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR> gemm_scale_procs;
-  gemm_scale_procs.reserve(num_gemms);
+  std::vector<PerRowScaleBiasOutputProcessor> gemm_row_scale_procs;
+  if (a_row_scales != nullptr) {
+    gemm_row_scale_procs.reserve(num_gemms);
+  } else {
+    gemm_scale_procs.reserve(num_gemms);
+  }
   std::vector<MLAS_GEMM_QUANT_DATA_PARAMS> gemm_data_vec(num_gemms);
 
   for (size_t gemm_idx = 0; gemm_idx < num_gemms; gemm_idx++) {
-    gemm_scale_procs.emplace_back(y_data + helper.OutputOffsets()[gemm_idx],
-                                  gemm_shape.N,
-                                  b_scale_data + helper.RightScaleOffsets()[gemm_idx],
-                                  bias_data,
-                                  MLAS_QGEMM_OUTPUT_MODE::ZeroMode,
-                                  is_b_scale_per_column ? MLAS_QUANTIZATION_GRANULARITY::PerColumn : MLAS_QUANTIZATION_GRANULARITY::PerMatrix);
     auto& params = gemm_data_vec[gemm_idx];
-    params.OutputProcessor = &(gemm_scale_procs[gemm_idx]);
+    if (a_row_scales != nullptr) {
+      gemm_row_scale_procs.emplace_back(y_data + helper.OutputOffsets()[gemm_idx],
+                                        gemm_shape.N,
+                                        a_row_scales + helper.LeftOffsets()[gemm_idx] / gemm_shape.K,
+                                        b_scale_data + helper.RightScaleOffsets()[gemm_idx],
+                                        is_b_scale_per_column,
+                                        bias_data);
+      params.OutputProcessor = &(gemm_row_scale_procs[gemm_idx]);
+    } else {
+      gemm_scale_procs.emplace_back(y_data + helper.OutputOffsets()[gemm_idx],
+                                    gemm_shape.N,
+                                    b_scale_data + helper.RightScaleOffsets()[gemm_idx],
+                                    bias_data,
+                                    MLAS_QGEMM_OUTPUT_MODE::ZeroMode,
+                                    is_b_scale_per_column ? MLAS_QUANTIZATION_GRANULARITY::PerColumn : MLAS_QUANTIZATION_GRANULARITY::PerMatrix);
+      params.OutputProcessor = &(gemm_scale_procs[gemm_idx]);
+    }
     params.A = a_data + helper.LeftOffsets()[gemm_idx];
     params.lda = gemm_shape.K;
     params.ZeroPointA = a_zp;
@@ -150,6 +231,7 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
     params.ldc = gemm_shape.N;
   }
 
+  RecordKernelDispatch("mlas_qgemm", MlasGemmQuantGetKernelName(gemm_shape.AIsSigned, gemm_shape.BIsSigned));
   MlasGemmBatch(gemm_shape, gemm_data_vec.data(), num_gemms, ctx->GetOperatorThreadPool());
 
   return Status::OK();
@@ -157,7 +239,9 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
 
 class DynamicQuantizeMatMul final : public MatMulIntegerToFloatBase {
  public:
-  DynamicQuantizeMatMul(const OpKernelInfo& info) : MatMulIntegerToFloatBase(info) {}
+  DynamicQuantizeMatMul(const OpKernelInfo& info) : MatMulIntegerToFloatBase(info) {
+    per_row_quantization_ = info.GetAttrOrDefault<int64_t>("per_row_quantization", 0) != 0;
+  }
 
   Status Compute(OpKernelContext* context) const override;
 
@@ -171,6 +255,9 @@ class DynamicQuantizeMatMul final : public MatMulIntegerToFloatBase {
 
  protected:
   int GetBIdx() const override { return IN_B; }
+
+ private:
+  bool per_row_quantization_;
 };
 
 class MatMulIntegerToFloat final : public MatMulIntegerToFloatBase {
@@ -205,20 +292,29 @@ Status DynamicQuantizeMatMul::Compute(OpKernelContext* ctx) const {
   const Tensor* b_scale_tensor = ctx->Input<Tensor>(IN_B_SCALE);
   const Tensor* b_zp_tensor = ctx->Input<Tensor>(IN_B_ZERO_POINT);
 
-  // calculate quantization parameter of a
   const float* a_data = a->Data<float>();
   int64_t num_of_elements = a->Shape().Size();
 
-  float a_scale;
-  uint8_t a_zero_point;
-  GetQuantizationParameter(a_data, num_of_elements, a_scale, a_zero_point, ctx->GetOperatorThreadPool());
-
   AllocatorPtr allocator;
   ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
   uint8_t* a_data_quant = static_cast<uint8_t*>(allocator->Alloc(SafeInt<size_t>(num_of_elements) * sizeof(uint8_t)));
   BufferUniquePtr a_buffer_quant_holder(a_data_quant, BufferDeleter(std::move(allocator)));
 
-  ParQuantizeLinearStd(a_data, a_data_quant, narrow<size_t>(num_of_elements), a_scale, a_zero_point, ctx->GetOperatorThreadPool());
+  float a_scale = 1.0f;
+  uint8_t a_zero_point = kPerRowZeroPoint;
+  std::vector<float> a_row_scales;
+  const size_t a_rank = a->Shape().NumDimensions();
+  const int64_t K = a_rank > 0 ? a->Shape()[a_rank - 1] : 1;
+  if (per_row_quantization_ && K > 0) {
+    // Each row is quantized right after its min and max are found, while it is still in cache.
+    const size_t rows = narrow<size_t>(num_of_elements / K);
+    a_row_scales.resize(rows);
+    QuantizePerRow(a_data, a_data_quant, a_row_scales.data(), rows, narrow<size_t>(K), ctx->GetOperatorThreadPool());
+  } else {
+    // calculate quantization parameter of a
+    GetQuantizationParameter(a_data, num_of_elements, a_scale, a_zero_point, ctx->GetOperatorThreadPool());
+    ParQuantizeLinearStd(a_data, a_data_quant, narrow<size_t>(num_of_elements), a_scale, a_zero_point, ctx->GetOperatorThreadPool());
+  }
 
   bool is_b_scale_supported = IsBQuantParamSupported(b_scale_tensor->Shape(), b ? b->Shape() : b_shape_);
   ORT_RETURN_IF_ERROR(ComputeCommon(
@@ -231,7 +327,8 @@ Status DynamicQuantizeMatMul::Compute(OpKernelContext* ctx) const {
       b,
       is_b_scale_supported ? b_scale_tensor : nullptr,
       b_zp_tensor,
-      ctx->Input<Tensor>(IN_BIAS)));
+      ctx->Input<Tensor>(IN_BIAS),
+      a_row_scales.empty() ? nullptr : a_row_scales.data()));
 
   if (!is_b_scale_supported) {
     ScaleOutput(*b_scale_tensor, *ctx->Output<Tensor>(0));
@@ -3,6 +3,7 @@
 
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
+#include "core/framework/kernel_dispatch.h"
 #include "core/framework/op_kernel.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/mlas/inc/mlas_qnbit.h"
@@ -161,6 +162,7 @@ Status MatMulNBits::Compute(OpKernelContext* ctx) const {
     auto ws_size = MlasSQNBitsGemmBatchWorkspaceSize(M, N, K, max_len, gemm_params.data());
     // workspace for activation process(dynamic quantization and others)
     auto ws_ptr = IAllocator::MakeUniquePtr<int8_t>(allocator, ws_size);
+    RecordKernelDispatch("matmul_nbits", "packed_b");
     MlasSQNBitsGemmBatchPackedB(M, N, K, max_len, gemm_params.data(), ws_ptr.get(),
                                 thread_pool);
     return Status::OK();
@@ -192,7 +194,13 @@ Status MatMulNBits::Compute(OpKernelContext* ctx) const {
   const size_t K = static_cast<size_t>(helper.K());
   const size_t lda = helper.Lda(false);
 
-  if (MlasIsSQNBitGemmAvailable(nbits_, block_size_)) {
+  // any compute type is at least as accurate as int8, and fp32 is the most accurate
+  MLAS_SQNBIT_COMPUTE_TYPE compute_type = static_cast<MLAS_SQNBIT_COMPUTE_TYPE>(accuracy_level_);
+  if (compute_type != CompInt8 || !MlasIsSQNBitGemmAvailable(nbits_, block_size_, compute_type)) {
+    compute_type = CompFp32;
+  }
+
+  if (MlasIsSQNBitGemmAvailable(nbits_, block_size_, compute_type)) {
     // number of bytes or elements between adjacent matrices
     size_t b_data_matrix_stride_in_bytes, b_scale_matrix_stride, b_zero_point_matrix_stride_in_bytes;
     MlasBlockwiseQuantizedBufferSizes(static_cast<int>(nbits_), static_cast<int>(block_size_), /* columnwise */ true,
@@ -217,7 +225,8 @@ Status MatMulNBits::Compute(OpKernelContext* ctx) const {
       data[i].ldc = N;
     }
 
-    MlasSQNBitGemmBatch(M, N, K, batch_count, nbits_, block_size_, data.data(), thread_pool);
+    RecordKernelDispatch("matmul_nbits", compute_type == CompInt8 ? "sqnbit_gemm_comp_int8" : "sqnbit_gemm");
+    MlasSQNBitGemmBatch(M, N, K, batch_count, nbits_, block_size_, compute_type, data.data(), thread_pool);
 
     return Status::OK();
   }
@@ -256,6 +265,8 @@ Status MatMulNBits::Compute(OpKernelContext* ctx) const {
     data[i].alpha = 1.f;
     data[i].beta = 0.0f;
   }
+  RecordKernelDispatch("matmul_nbits", "dequantize_sgemm");
+  RecordKernelDispatch("mlas_sgemm", MlasSgemmGetKernelName());
   MlasGemmBatch(CblasNoTrans, CblasTrans,
                 M, N, K, data.data(), batch_count, thread_pool);
 
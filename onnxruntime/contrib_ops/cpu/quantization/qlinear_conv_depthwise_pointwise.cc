@@ -0,0 +1,436 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/nn/conv_attributes.h"
+#include "core/common/safeint.h"
+#include "core/providers/common.h"
+#include "core/util/math.h"
+#include "core/util/math_cpuonly.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+using ConvPadVector = ConvAttributes::ConvPadVector;
+
+// Computes a depthwise QLinearConv followed by a 1x1 pointwise QLinearConv with
+// the fused MLAS routine, which keeps the intermediate activation of a tile of
+// output pixels in cache instead of writing the whole tensor to memory.
+template <typename ActType>
+class QLinearConvDepthwisePointwise : public OpKernel {
+ public:
+  explicit QLinearConvDepthwisePointwise(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
+    channels_last_ = (info.GetAttrOrDefault<int64_t>("channels_last", static_cast<int64_t>(0)) != 0);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+ private:
+  enum InputTensors : int {
+    IN_X = 0,
+    IN_X_SCALE = 1,
+    IN_X_ZERO_POINT = 2,
+    IN_DW_W = 3,
+    IN_DW_W_SCALE = 4,
+    IN_DW_W_ZERO_POINT = 5,
+    IN_MID_SCALE = 6,
+    IN_MID_ZERO_POINT = 7,
+    IN_PW_W = 8,
+    IN_PW_W_SCALE = 9,
+    IN_PW_W_ZERO_POINT = 10,
+    IN_Y_SCALE = 11,
+    IN_Y_ZERO_POINT = 12,
+    IN_DW_BIAS = 13,
+    IN_PW_BIAS = 14
+  };
+
+  // The packed filter buffer starts with the sum of the weights of each output
+  // channel, which folds the zero point of the activation into the bias.
+  static size_t PackedFilterOffset(size_t output_channels) {
+    constexpr size_t alignment = 64;
+    return (SafeInt<size_t>(sizeof(int32_t)) * output_channels + alignment - 1) / alignment * alignment;
+  }
+
+  static Status PackFilter(const Tensor& W, bool is_depthwise, AllocatorPtr alloc,
+                           IAllocatorUniquePtr<void>& packed_W, size_t& packed_W_size) {
+    const auto& shape = W.Shape();
+    ORT_RETURN_IF_NOT(shape.NumDimensions() > 2, "QLinearConvDepthwisePointwise : filter must have a spatial rank");
+
+    const size_t output_channels = static_cast<size_t>(shape[0]);
+    const size_t input_channels = static_cast<size_t>(shape[1]);
+    const size_t kernel_size = static_cast<size_t>(shape.SizeFromDimension(2));
+    constexpr bool is_signed = std::is_signed<ActType>::value;
+
+    size_t filter_size;
+    if (is_depthwise) {
+      ORT_RETURN_IF_NOT(input_channels == 1, "QLinearConvDepthwisePointwise : depthwise filter must have one input channel");
+      filter_size = MlasConvSymPackWSize(output_channels, 1, 1, kernel_size, is_signed);
+    } else {
+      ORT_RETURN_IF_NOT(kernel_size == 1, "QLinearConvDepthwisePointwise : pointwise filter must be 1x1");
+      filter_size = MlasConvSymPointwisePackWSize(input_channels, output_channels, is_signed);
+    }
+    ORT_RETURN_IF(filter_size == 0, "QLinearConvDepthwisePointwise : filter shape ", shape,
+                  " is not supported on this platform");
+
+    const size_t filter_offset = PackedFilterOffset(output_channels);
+    packed_W_size = filter_offset + filter_size;
+    packed_W = IAllocator::MakeUniquePtr<void>(alloc, packed_W_size, true);
+
+    auto* packed_data = static_cast<uint8_t*>(packed_W.get());
+    memset(packed_data, 0, filter_offset);
+
+    const auto* Wdata = W.Data<int8_t>();
+    auto* W_sums = reinterpret_cast<int32_t*>(packed_data);
+    const size_t kernel_dim = input_channels * kernel_size;
+    for (size_t oc = 0; oc < output_channels; oc++) {
+      W_sums[oc] = std::accumulate(Wdata + oc * kernel_dim, Wdata + (oc + 1) * kernel_dim, int32_t{0});
+    }
+
+    MlasConvSymPackW(is_depthwise ? output_channels : 1,
+                     is_depthwise ? 1 : input_channels,
+                     is_depthwise ? 1 : output_channels,
+                     kernel_size,
+                     Wdata,
+                     reinterpret_cast<int8_t*>(packed_data + filter_offset),
+                     filter_size,
+                     is_signed);
+
+    return Status::OK();
+  }
+
+  // Returns the bias of each output channel with the zero point of the input
+  // activation folded in, as expected by the symmetric convolution kernels.
+  static std::vector<int32_t> ComputeBias(const Tensor* B, const void* packed_W, size_t output_channels,
+                                          ActType input_zero_point) {
+    const auto* W_sums = static_cast<const int32_t*>(packed_W);
+    const auto* Bdata = B != nullptr ? B->Data<int32_t>() : nullptr;
+    const int32_t zero_point_fixup =
+        MlasConvSymFixupInputZeroPoint(input_zero_point, std::is_signed<ActType>::value);
+
+    std::vector<int32_t> bias(output_channels);
+    for (size_t oc = 0; oc < output_channels; oc++) {
+      bias[oc] = (Bdata != nullptr ? Bdata[oc] : 0) - W_sums[oc] * zero_point_fixup;
+    }
+    return bias;
+  }
+
+  static std::vector<float> ComputeScale(OpKernelContext* context, int input_scale_idx, int filter_scale_idx,
+                                         int output_scale_idx, int64_t output_channels) {
+    const Tensor* X_scale = context->Input<Tensor>(input_scale_idx);
+    const Tensor* W_scale = context->Input<Tensor>(filter_scale_idx);
+    const Tensor* Y_scale = context->Input<Tensor>(output_scale_idx);
+    ORT_ENFORCE(IsScalarOr1ElementVector(X_scale) && IsScalarOr1ElementVector(Y_scale),
+                "QLinearConvDepthwisePointwise : activation scale must be a scalar or 1D tensor of size 1");
+    const int64_t W_scale_size = W_scale->Shape().Size();
+    ORT_ENFORCE(W_scale->Shape().NumDimensions() <= 1 && (W_scale_size == 1 || W_scale_size == output_channels),
+                "QLinearConvDepthwisePointwise : filter scale shape invalid");
+
+    const float X_scale_value = *(X_scale->Data<float>());
+    const float Y_scale_value = *(Y_scale->Data<float>());
+    const auto* W_scale_data = W_scale->Data<float>();
+
+    std::vector<float> output_scales(static_cast<size_t>(W_scale_size));
+    for (size_t i = 0; i < output_scales.size(); i++) {
+      output_scales[i] = X_scale_value * W_scale_data[i] / Y_scale_value;
+    }
+    return output_scales;
+  }
+
+  static ActType GetZeroPoint(OpKernelContext* context, int input_idx) {
+    const Tensor* zero_point = context->Input<Tensor>(input_idx);
+    ORT_ENFORCE(IsScalarOr1ElementVector(zero_point),
+                "QLinearConvDepthwisePointwise : activation zero point must be a scalar or 1D tensor of size 1");
+    return *(zero_point->Data<ActType>());
+  }
+
+  static bool IsSymmetricFilter(OpKernelContext* context, int input_idx) {
+    const Tensor* zero_point = context->Input<Tensor>(input_idx);
+    const auto* zero_point_data = zero_point->Data<int8_t>();
+    return std::all_of(zero_point_data, zero_point_data + zero_point->Shape().Size(), [](int8_t v) { return v == 0; });
+  }
+
+  ConvAttributes conv_attrs_;
+  bool channels_last_{false};
+  TensorShape dw_W_shape_;
+  TensorShape pw_W_shape_;
+  IAllocatorUniquePtr<void> packed_dw_W_buffer_;
+  IAllocatorUniquePtr<void> packed_pw_W_buffer_;
+};
+
+#define REGISTER_QLINEARCONVDEPTHWISEPOINTWISE_KERNEL(T)                \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                        \
+      QLinearConvDepthwisePointwise,                                    \
+      kMSDomain,                                                        \
+      1,                                                                \
+      T,                                                                \
+      kCpuExecutionProvider,                                            \
+      KernelDefBuilder()                                                \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<T>())       \
+          .TypeConstraint("T2", DataTypeImpl::GetTensorType<int8_t>())  \
+          .TypeConstraint("T3", DataTypeImpl::GetTensorType<int32_t>()), \
+      QLinearConvDepthwisePointwise<T>);
+
+REGISTER_QLINEARCONVDEPTHWISEPOINTWISE_KERNEL(uint8_t);
+REGISTER_QLINEARCONVDEPTHWISEPOINTWISE_KERNEL(int8_t);
+
+template <typename ActType>
+Status QLinearConvDepthwisePointwise<ActType>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                                                       /*out*/ bool& is_packed,
+                                                       /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  if (input_idx != InputTensors::IN_DW_W && input_idx != InputTensors::IN_PW_W) {
+    return Status::OK();
+  }
+
+  const bool is_depthwise = (input_idx == InputTensors::IN_DW_W);
+  auto& packed_W_buffer = is_depthwise ? packed_dw_W_buffer_ : packed_pw_W_buffer_;
+  size_t packed_W_size = 0;
+  ORT_RETURN_IF_ERROR(PackFilter(tensor, is_depthwise, alloc, packed_W_buffer, packed_W_size));
+  (is_depthwise ? dw_W_shape_ : pw_W_shape_) = tensor.Shape();
+
+  if (prepacked_weights != nullptr) {
+    prepacked_weights->buffers_.push_back(std::move(packed_W_buffer));
+    prepacked_weights->buffer_sizes_.push_back(packed_W_size);
+  }
+
+  is_packed = true;
+  return Status::OK();
+}
+
+template <typename ActType>
+Status QLinearConvDepthwisePointwise<ActType>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                                         int input_idx,
+                                                                         /*out*/ bool& used_shared_buffers) {
+  if (input_idx == InputTensors::IN_DW_W) {
+    packed_dw_W_buffer_ = std::move(prepacked_buffers[0]);
+    used_shared_buffers = true;
+  } else if (input_idx == InputTensors::IN_PW_W) {
+    packed_pw_W_buffer_ = std::move(prepacked_buffers[0]);
+    used_shared_buffers = true;
+  }
+
+  return Status::OK();
+}
+
+template <typename ActType>
+Status QLinearConvDepthwisePointwise<ActType>::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(InputTensors::IN_X);
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  // Handle filters that were not packed because prepacking is disabled.
+  IAllocatorUniquePtr<void> local_dw_W_buffer;
+  IAllocatorUniquePtr<void> local_pw_W_buffer;
+  const void* packed_dw_W = packed_dw_W_buffer_.get();
+  const void* packed_pw_W = packed_pw_W_buffer_.get();
+  TensorShape dw_W_shape = dw_W_shape_;
+  TensorShape pw_W_shape = pw_W_shape_;
+  size_t packed_W_size;
+  if (packed_dw_W == nullptr) {
+    const Tensor* W = context->Input<Tensor>(InputTensors::IN_DW_W);
+    ORT_RETURN_IF_ERROR(PackFilter(*W, true, alloc, local_dw_W_buffer, packed_W_size));
+    packed_dw_W = local_dw_W_buffer.get();
+    dw_W_shape = W->Shape();
+  }
+  if (packed_pw_W == nullptr) {
+    const Tensor* W = context->Input<Tensor>(InputTensors::IN_PW_W);
+    ORT_RETURN_IF_ERROR(PackFilter(*W, false, alloc, local_pw_W_buffer, packed_W_size));
+    packed_pw_W = local_pw_W_buffer.get();
+    pw_W_shape = W->Shape();
+  }
+
+  const int64_t N = X->Shape()[0];
+  const int64_t C = dw_W_shape[0];
+  const int64_t M = pw_W_shape[0];
+
+  ORT_RETURN_IF_NOT(conv_attrs_.group == C && pw_W_shape[1] == C,
+                    "QLinearConvDepthwisePointwise : channel count mismatch between the depthwise and pointwise filters");
+  ORT_RETURN_IF_NOT(IsSymmetricFilter(context, InputTensors::IN_DW_W_ZERO_POINT) &&
+                        IsSymmetricFilter(context, InputTensors::IN_PW_W_ZERO_POINT),
+                    "QLinearConvDepthwisePointwise : filter zero points must be zero");
+
+  const ActType X_zero_point_value = GetZeroPoint(context, InputTensors::IN_X_ZERO_POINT);
+  const ActType mid_zero_point_value = GetZeroPoint(context, InputTensors::IN_MID_ZERO_POINT);
+  const ActType Y_zero_point_value = GetZeroPoint(context, InputTensors::IN_Y_ZERO_POINT);
+
+  const std::vector<float> dw_scales = ComputeScale(context, InputTensors::IN_X_SCALE, InputTensors::IN_DW_W_SCALE,
+                                                    InputTensors::IN_MID_SCALE, C);
+  const std::vector<float> pw_scales = ComputeScale(context, InputTensors::IN_MID_SCALE, InputTensors::IN_PW_W_SCALE,
+                                                    InputTensors::IN_Y_SCALE, M);
+
+  const std::vector<int32_t> dw_bias = ComputeBias(context->Input<Tensor>(InputTensors::IN_DW_BIAS), packed_dw_W,
+                                                   static_cast<size_t>(C), X_zero_point_value);
+  const std::vector<int32_t> pw_bias = ComputeBias(context->Input<Tensor>(InputTensors::IN_PW_BIAS), packed_pw_W,
+                                                   static_cast<size_t>(M), mid_zero_point_value);
+
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), dw_W_shape, channels_last_));
+
+  TensorShapeVector kernel_shape;
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(dw_W_shape, kernel_shape));
+
+  const size_t kernel_rank = kernel_shape.size();
+
+  ConvPadVector pads(conv_attrs_.pads);
+  if (pads.empty()) {
+    pads.resize(kernel_rank * 2, 0);
+  }
+  TensorShapeVector dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(kernel_rank, 1);
+  }
+  TensorShapeVector strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(kernel_rank, 1);
+  }
+
+  const size_t spatial_dim_start = channels_last_ ? 1 : 2;
+  const size_t spatial_dim_end = spatial_dim_start + kernel_rank;
+
+  TensorShapeVector Y_dims({N});
+  if (!channels_last_) {
+    Y_dims.push_back(M);
+  }
+  TensorShape input_shape = X->Shape().Slice(spatial_dim_start, spatial_dim_end);
+  ORT_RETURN_IF_ERROR(conv_attrs_.InferPadsAndOutputShape(input_shape, kernel_shape, strides, dilations, pads, Y_dims));
+  if (channels_last_) {
+    Y_dims.push_back(M);
+  }
+  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+  TensorShape output_shape = Y->Shape().Slice(spatial_dim_start, spatial_dim_end);
+
+  // Bail out early if one of the dimensions is zero.
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  const int64_t input_image_size = input_shape.Size();
+  const int64_t output_image_size = output_shape.Size();
+  const int64_t kernel_size = TensorShape(kernel_shape).Size();
+
+  const int64_t X_offset = C * input_image_size;
+  const int64_t Y_offset = M * output_image_size;
+
+  const auto* Xdata = X->Data<ActType>();
+  auto* Ydata = Y->MutableData<ActType>();
+
+  BufferUniquePtr transpose_input_buffer;
+  BufferUniquePtr transpose_output_buffer;
+
+  // Allocate temporary buffers for transposing to channels last format.
+  if (!channels_last_) {
+    auto* transpose_input = alloc->Alloc(SafeInt<size_t>(sizeof(ActType)) * X_offset);
+    transpose_input_buffer = BufferUniquePtr(transpose_input, BufferDeleter(alloc));
+    auto* transpose_output = alloc->Alloc(SafeInt<size_t>(sizeof(ActType)) * Y_offset);
+    transpose_output_buffer = BufferUniquePtr(transpose_output, BufferDeleter(alloc));
+  }
+
+  auto* indirection_data = alloc->Alloc(SafeInt<size_t>(sizeof(const ActType*)) * kernel_size * output_image_size);
+  BufferUniquePtr indirection_buffer(indirection_data, BufferDeleter(alloc));
+  std::vector<ActType> padding_data(static_cast<size_t>(C), X_zero_point_value);
+
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  // Partition the output pixels into slices of at least 64K multiply-adds
+  // that are a multiple of the kernel stride, with enough slices to balance
+  // the threads.
+  const int64_t compute_stride = MlasConvSymDepthwisePointwiseGetKernelOutputCnt(std::is_signed<ActType>::value);
+  const int32_t degree_of_par = concurrency::ThreadPool::DegreeOfParallelism(thread_pool);
+  const int64_t complexity = C * (kernel_size + M);
+  int64_t stride_m = std::max<int64_t>((64 * 1024 + complexity - 1) / complexity, 1);
+  stride_m = std::min(stride_m, (output_image_size + degree_of_par - 1) / degree_of_par);
+  stride_m = (stride_m + compute_stride - 1) / compute_stride * compute_stride;
+  const int64_t task_count = (output_image_size + stride_m - 1) / stride_m;
+
+  for (int64_t image_id = 0; image_id < N; ++image_id) {
+    const auto* input_data = Xdata;
+    auto* output_data = Ydata;
+
+    if (!channels_last_) {
+      // Transpose the input from channels first (NCHW) to channels last (NHWC).
+      MlasTranspose(
+          Xdata,
+          static_cast<ActType*>(transpose_input_buffer.get()),
+          static_cast<size_t>(C),
+          static_cast<size_t>(input_image_size));
+      input_data = static_cast<ActType*>(transpose_input_buffer.get());
+      output_data = static_cast<ActType*>(transpose_output_buffer.get());
+    }
+
+    auto conv_worker = [&](ptrdiff_t batch) {
+      const int64_t output_start = static_cast<int64_t>(batch) * stride_m;
+      const int64_t output_count = std::min(stride_m, output_image_size - output_start);
+
+      auto* worker_indirection_buffer =
+          static_cast<ActType const**>(indirection_buffer.get()) + output_start * kernel_size;
+      math::Im2col<ActType, StorageOrder::NHWC>()(
+          input_data,
+          C,
+          input_shape.GetDims().data(),
+          output_shape.GetDims().data(),
+          kernel_shape.data(),
+          strides.data(),
+          dilations.data(),
+          pads.data(),
+          static_cast<ptrdiff_t>(kernel_rank),
+          output_start,
+          output_count,
+          worker_indirection_buffer,
+          padding_data.data());
+
+      MLAS_CONV_SYM_PARAMS dw_params = {};
+      dw_params.InputIndirection = reinterpret_cast<void const**>(worker_indirection_buffer);
+      dw_params.Filter = static_cast<const uint8_t*>(packed_dw_W) + PackedFilterOffset(static_cast<size_t>(C));
+      dw_params.InputChannels = static_cast<size_t>(C);
+      dw_params.OutputChannels = static_cast<size_t>(C);
+      dw_params.OutputCount = static_cast<size_t>(output_count);
+      dw_params.KernelSize = static_cast<size_t>(kernel_size);
+      dw_params.Bias = dw_bias.data();
+      dw_params.Scale = dw_scales.data();
+      dw_params.PerChannelScale = dw_scales.size() > 1;
+      dw_params.OutputZeroPoint = mid_zero_point_value;
+      dw_params.InputIsSigned = std::is_signed<ActType>::value;
+
+      MLAS_CONV_SYM_PARAMS pw_params = {};
+      pw_params.Filter = static_cast<const uint8_t*>(packed_pw_W) + PackedFilterOffset(static_cast<size_t>(M));
+      pw_params.Output = output_data + output_start * M;
+      pw_params.OutputChannels = static_cast<size_t>(M);
+      pw_params.Bias = pw_bias.data();
+      pw_params.Scale = pw_scales.data();
+      pw_params.PerChannelScale = pw_scales.size() > 1;
+      pw_params.OutputZeroPoint = Y_zero_point_value;
+      pw_params.InputIsSigned = std::is_signed<ActType>::value;
+
+      MlasConvSymDepthwisePointwise(dw_params, pw_params);
+    };
+
+    concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, onnxruntime::narrow<ptrdiff_t>(task_count), conv_worker);
+
+    if (!channels_last_) {
+      // Transpose the output from channels last (NHWC) to channels first (NCHW).
+      MlasTranspose(
+          output_data,
+          Ydata,
+          static_cast<size_t>(output_image_size),
+          static_cast<size_t>(M));
+    }
+
+    Xdata += X_offset;
+    Ydata += Y_offset;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
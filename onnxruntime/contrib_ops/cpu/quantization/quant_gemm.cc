@@ -3,6 +3,7 @@
 
 #include "core/common/safeint.h"
 #include "core/common/narrow.h"
+#include "core/framework/kernel_dispatch.h"
 #include "core/providers/cpu/math/gemm_base.h"
 #include "core/providers/cpu/math/gemm_helper.h"
 #include "core/providers/cpu/quantization/matmul_integer_base.h"
@@ -110,6 +111,7 @@ class QGemm : protected GemmBase, public MatMulIntegerBase {
     std::optional<MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR> requant_proc_ptr;
     SetPostProcessor(y_zp, N, output_scales, y, gemm_param, scale_bias_proc_ptr, requant_proc_ptr);
 
+    RecordKernelDispatch("mlas_qgemm", MlasGemmQuantGetKernelName(a_is_signed, b_is_signed));
     MlasGemmBatch(gemm_shape, &gemm_param, 1, context->GetOperatorThreadPool());
     return Status::OK();
   }
@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/common.h"
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Gather(table, indices, axis=0) followed by ReduceSum or ReduceMean of each bag, the last axis of the indices. The
+// gathered rows are summed as they are read instead of being written to an intermediate tensor.
+class EmbeddingBag final : public OpKernel {
+ public:
+  explicit EmbeddingBag(const OpKernelInfo& info) : OpKernel(info) {
+    const auto mode = info.GetAttrOrDefault<std::string>("mode", "sum");
+    ORT_ENFORCE(mode == "sum" || mode == "mean", "EmbeddingBag mode must be sum or mean, got ", mode);
+    mean_ = mode == "mean";
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  template <typename Tind>
+  Status ComputeImpl(OpKernelContext* context, const Tensor& table, const Tensor& indices) const;
+
+  bool mean_;
+};
+
+ONNX_OPERATOR_KERNEL_EX(
+    EmbeddingBag,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("Tind", BuildKernelDefConstraints<int32_t, int64_t>()),
+    EmbeddingBag);
+
+template <typename Tind>
+Status EmbeddingBag::ComputeImpl(OpKernelContext* context, const Tensor& table, const Tensor& indices) const {
+  const auto& table_shape = table.Shape();
+  const auto& indices_shape = indices.Shape();
+  const int64_t num_rows = table_shape[0];
+  const int64_t dim = table_shape[1];
+  const int64_t bag_size = indices_shape[indices_shape.NumDimensions() - 1];
+
+  TensorShapeVector output_dims(indices_shape.GetDims().begin(), indices_shape.GetDims().end() - 1);
+  output_dims.push_back(dim);
+  Tensor* output = context->Output(0, output_dims);
+
+  const int64_t num_bags = output->Shape().SizeToDimension(output_dims.size() - 1);
+  if (num_bags == 0 || dim == 0) {
+    return Status::OK();
+  }
+
+  const Tind* indices_data = indices.Data<Tind>();
+  const int64_t num_indices = indices_shape.Size();
+  for (int64_t i = 0; i < num_indices; ++i) {
+    const int64_t idx = static_cast<int64_t>(indices_data[i]);
+    if (idx < -num_rows || idx >= num_rows) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "indices element out of data bounds, idx=", idx,
+                             " must be within the inclusive range [", -num_rows, ",", num_rows - 1, "]");
+    }
+  }
+
+  const float* table_data = table.Data<float>();
+  float* output_data = output->MutableData<float>();
+  const float scale = mean_ && bag_size > 0 ? 1.0f / static_cast<float>(bag_size) : 1.0f;
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), narrow<std::ptrdiff_t>(num_bags),
+      static_cast<double>(SafeInt<int64_t>(bag_size) * dim),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t bag = first; bag < last; ++bag) {
+          MlasEmbeddingBag(table_data, narrow<size_t>(num_rows), narrow<size_t>(dim),
+                           indices_data + bag * bag_size, narrow<size_t>(bag_size), scale,
+                           output_data + bag * dim);
+        }
+      });
+
+  return Status::OK();
+}
+
+Status EmbeddingBag::Compute(OpKernelContext* context) const {
+  const Tensor* table = context->Input<Tensor>(0);
+  const Tensor* indices = context->Input<Tensor>(1);
+
+  ORT_RETURN_IF_NOT(table->Shape().NumDimensions() == 2, "table must be a 2D tensor, got shape ", table->Shape());
+  ORT_RETURN_IF_NOT(indices->Shape().NumDimensions() >= 1, "indices must have rank larger than zero.");
+
+  if (indices->IsDataType<int32_t>()) {
+    return ComputeImpl<int32_t>(context, *table, *indices);
+  }
+  return ComputeImpl<int64_t>(context, *table, *indices);
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -8,6 +8,8 @@
 #include "core/framework/op_kernel.h"
 #include "re2/re2.h"
 
+#include <string_view>
+
 namespace onnxruntime {
 namespace contrib {
 
@@ -36,6 +38,9 @@ class Tokenizer final : public OpKernel {
   int64_t mincharnum_{0};
   bool char_tokenezation_{false};
   std::vector<std::unique_ptr<re2::RE2>> separators_;
+  // The separators without regular expression operators, which are searched for as plain strings.
+  // Empty for the other separators.
+  std::vector<std::string> literal_separators_;
   std::unique_ptr<re2::RE2> regex_;
 };
 
@@ -52,6 +57,11 @@ ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
 namespace tokenizer_details {
 constexpr char start_text = 0x2;
 constexpr char end_text = 0x3;
+
+// A non-empty pattern without any of the RE2 operators only matches itself.
+inline bool IsLiteralPattern(const std::string& pattern) {
+  return !pattern.empty() && pattern.find_first_of("\\^$.|?*+()[]{}") == std::string::npos;
+}
 }  // namespace tokenizer_details
 
 using namespace tokenizer_details;
@@ -99,6 +109,7 @@ Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
           ORT_THROW("Can not digest separators: ", sep, " ", regex->error());
         }
         separators_.push_back(std::move(regex));
+        literal_separators_.push_back(IsLiteralPattern(sep) ? sep : std::string());
       }
     } else {
       // Use tokenexp
@@ -171,7 +182,7 @@ Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
       assert(result);
       (void)result;
       assert(token_idx + tlen <= str_len);
-      *(output_data + output_index) = s.substr(token_idx, tlen);
+      (output_data + output_index)->assign(s.data() + token_idx, tlen);
       ++output_index;
       token_idx += tlen;
       ++tokens;
@@ -196,8 +207,12 @@ Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
                                                size_t N, size_t C,
                                                gsl::span<const int64_t> input_dims) const {
   using namespace re2;
-  std::vector<std::vector<StringPiece>> rows;
-  rows.reserve(N * C);
+  // The tokens of all the rows, row i ends at row_ends[i]
+  std::vector<StringPiece> rows;
+  std::vector<size_t> row_ends;
+  row_ends.reserve(N * C);
+  std::vector<StringPiece> row;
+  std::vector<StringPiece> tokens;
 
   // We do not constraint the search to match
   // on the beginning or end of the string
@@ -219,10 +234,12 @@ Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
                     "Input string contains invalid utf8 chars: " + s);
     }
 
-    std::vector<StringPiece> row{s};
+    row.assign(1, StringPiece(s));
 
-    for (const auto& sep : separators_) {
-      std::vector<StringPiece> tokens;
+    for (size_t sep_idx = 0; sep_idx < separators_.size(); ++sep_idx) {
+      const auto& sep = separators_[sep_idx];
+      const std::string& literal_sep = literal_separators_[sep_idx];
+      tokens.clear();
       for (const auto& text : row) {
         const auto end_pos = text.length();
         size_t start_pos = 0;
@@ -230,7 +247,15 @@ Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
 
         bool match = true;
         do {
-          match = sep->Match(text, start_pos, end_pos, anchor, &submatch, 1);
+          if (!literal_sep.empty()) {
+            const size_t match_pos = std::string_view(text.data(), text.length()).find(literal_sep, start_pos);
+            match = match_pos != std::string_view::npos;
+            if (match) {
+              submatch = StringPiece(text.data() + match_pos, literal_sep.length());
+            }
+          } else {
+            match = sep->Match(text, start_pos, end_pos, anchor, &submatch, 1);
+          }
           if (match) {
             // Record  pos/len
             assert(submatch.data() != nullptr);
@@ -273,7 +298,8 @@ Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
       row.swap(tokens);
     }  // separators_
     max_tokens = std::max(max_tokens, row.size());
-    rows.push_back(std::move(row));
+    rows.insert(rows.end(), row.begin(), row.end());
+    row_ends.push_back(rows.size());
     ++curr_input;
   }
 
@@ -301,8 +327,9 @@ Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
   const size_t max_output_index = N * C * max_tokens;
 #endif
   size_t output_index = 0;
+  size_t row_begin = 0;
   curr_input = input_data;
-  for (auto& row : rows) {
+  for (const size_t row_end : row_ends) {
 #ifdef _DEBUG
     size_t c_idx = output_index;
 #endif
@@ -311,15 +338,16 @@ Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
       ++output_index;
     }
     // Output tokens for this row
-    for (const auto& token : row) {
-      (output_data + output_index)->assign(token.data(), token.size());
+    for (size_t t = row_begin; t < row_end; ++t) {
+      (output_data + output_index)->assign(rows[t].data(), rows[t].size());
       ++output_index;
     }
     if (mark_) {
       (output_data + output_index)->assign(&end_text, 1);
       ++output_index;
     }
-    const size_t pads = max_tokens - (static_cast<size_t>(mark_) * 2) - row.size();
+    const size_t pads = max_tokens - (static_cast<size_t>(mark_) * 2) - (row_end - row_begin);
+    row_begin = row_end;
     for (size_t p = 0; p < pads; ++p) {
       *(output_data + output_index) = pad_value_;
       ++output_index;
@@ -337,10 +365,10 @@ Status Tokenizer::TokenExpression(OpKernelContext* ctx,
                                   size_t N, size_t C,
                                   gsl::span<const int64_t> input_dims) const {
   using namespace re2;
-  // Represents a token that will be output after
-  // first is the index, second is the size;
-  std::vector<std::vector<StringPiece>> tokens;
-  tokens.reserve(N * C);
+  // The tokens of all the rows, row i ends at row_ends[i]
+  std::vector<StringPiece> tokens;
+  std::vector<size_t> row_ends;
+  row_ends.reserve(N * C);
 
   size_t max_tokens = 0;
   auto X = ctx->Input<Tensor>(0);
@@ -362,8 +390,7 @@ Status Tokenizer::TokenExpression(OpKernelContext* ctx,
                     "Input string contains invalid utf8 chars: " + s);
     }
 
-    tokens.emplace_back();
-    auto& row = tokens.back();
+    const size_t row_begin = tokens.size();
 
     StringPiece text(s);
     const auto end_pos = s.length();
@@ -387,7 +414,7 @@ Status Tokenizer::TokenExpression(OpKernelContext* ctx,
                         "Match contains invalid utf8 chars: " + std::string{submatch});
         }
         if (utf8_chars >= size_t(mincharnum_)) {
-          row.push_back(submatch);
+          tokens.push_back(submatch);
           start_pos = match_pos + token_len;
         } else {
           size_t bytes = 0;
@@ -396,7 +423,8 @@ Status Tokenizer::TokenExpression(OpKernelContext* ctx,
         }
       }
     } while (match);
-    max_tokens = std::max(max_tokens, row.size());
+    max_tokens = std::max(max_tokens, tokens.size() - row_begin);
+    row_ends.push_back(tokens.size());
     ++curr_input;
   }
 
@@ -426,7 +454,8 @@ Status Tokenizer::TokenExpression(OpKernelContext* ctx,
 #endif
   curr_input = input_data;
   size_t output_index = 0;
-  for (const auto& row : tokens) {
+  size_t row_begin = 0;
+  for (const size_t row_end : row_ends) {
     assert(curr_input != last);
 #ifdef _DEBUG
     size_t c_idx = output_index;
@@ -436,15 +465,16 @@ Status Tokenizer::TokenExpression(OpKernelContext* ctx,
       ++output_index;
     }
     // Output tokens for this row
-    for (const auto& token : row) {
-      (output_data + output_index)->assign(token.data(), token.length());
+    for (size_t t = row_begin; t < row_end; ++t) {
+      (output_data + output_index)->assign(tokens[t].data(), tokens[t].length());
       ++output_index;
     }
     if (mark_) {
       (output_data + output_index)->assign(&end_text, 1);
       ++output_index;
     }
-    const size_t pads = max_tokens - (static_cast<size_t>(mark_) * 2) - row.size();
+    const size_t pads = max_tokens - (static_cast<size_t>(mark_) * 2) - (row_end - row_begin);
+    row_begin = row_end;
     for (size_t p = 0; p < pads; ++p) {
       *(output_data + output_index) = pad_value_;
       ++output_index;
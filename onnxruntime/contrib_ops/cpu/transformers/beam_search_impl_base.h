@@ -226,6 +226,10 @@ Status BeamSearchBase<T>::Initialize() {
   ORT_RETURN_IF(parameters_->num_return_sequences > parameters_->num_beams,
                 "'num_return_sequences' has to be smaller or equal to 'num_beams'.");
 
+  // Cross attention of CUDA kernels requires key and value with the batch size of query.
+  ORT_RETURN_IF(parameters_->broadcast_encoder_outputs && IsCuda(),
+                "'broadcast_encoder_outputs' is not supported in CUDA.");
+
   ORT_RETURN_IF_ERROR(CheckInputs(this->context_));
 
   // This flag will be updated later when the scores output exists.
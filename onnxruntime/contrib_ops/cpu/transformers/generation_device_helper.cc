@@ -30,6 +30,10 @@ Status TopK(const Tensor* input, const int axis, const unsigned k, bool largest,
     return GetTopK<float>(input, axis, k, largest, sorted, allocator, threadpool, output_values, output_indices);
   }
 
+  if (input->IsDataType<MLFloat16>()) {
+    return GetTopK<MLFloat16>(input, axis, k, largest, sorted, allocator, threadpool, output_values, output_indices);
+  }
+
   return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
                          "BeamSearch op: An implementation for the input type ",
                          input->DataType(), " is not supported yet");
@@ -555,7 +559,53 @@ Status DeviceCopy(gsl::span<T> target, gsl::span<const T> source, Stream* /*stre
   return Status::OK();
 }
 
-// Copy present state to past state for GPT model
+// Reorders the beams of a state tensor in place, so that beam j holds the block of beam beam_indices[j].
+// The state is outer blocks of beam_count beams each. Only beams whose parent changed are copied, and a parent block
+// that is also overwritten is staged in a scratch buffer first.
+template <typename T>
+void PickBeamsInPlace(gsl::span<T> state,
+                      size_t outer,
+                      size_t block_size,
+                      gsl::span<const int32_t> beam_indices,
+                      AllocatorPtr allocator) {
+  const size_t beam_count = beam_indices.size();
+  std::vector<int32_t> staged_slot(beam_count, -1);
+  int32_t num_staged = 0;
+  for (size_t j = 0; j < beam_count; j++) {
+    const int32_t parent = beam_indices[j];
+    if (parent != static_cast<int32_t>(j) && beam_indices[parent] != parent && staged_slot[parent] < 0) {
+      staged_slot[parent] = num_staged++;
+    }
+  }
+
+  IAllocatorUniquePtr<T> scratch;
+  if (num_staged > 0) {
+    scratch = IAllocator::MakeUniquePtr<T>(allocator, SafeInt<size_t>(outer) * num_staged * block_size);
+  }
+  gsl::span<T> scratch_span = gsl::make_span<T>(scratch.get(), scratch ? SafeInt<size_t>(outer) * num_staged * block_size : 0);
+
+  for (size_t o = 0; o < outer; o++) {
+    gsl::span<T> beams = state.subspan(o * SafeInt<size_t>(beam_count) * block_size, beam_count * block_size);
+    for (size_t k = 0; k < beam_count; k++) {
+      if (staged_slot[k] >= 0) {
+        gsl::copy(beams.subspan(k * block_size, block_size),
+                  scratch_span.subspan((o * num_staged + staged_slot[k]) * SafeInt<size_t>(block_size), block_size));
+      }
+    }
+    for (size_t j = 0; j < beam_count; j++) {
+      const int32_t parent = beam_indices[j];
+      if (parent == static_cast<int32_t>(j)) {
+        continue;
+      }
+      gsl::span<const T> source = staged_slot[parent] >= 0
+                                      ? scratch_span.subspan((o * num_staged + staged_slot[parent]) * SafeInt<size_t>(block_size), block_size)
+                                      : beams.subspan(parent * SafeInt<size_t>(block_size), block_size);
+      gsl::copy(source, beams.subspan(j * block_size, block_size));
+    }
+  }
+}
+
+// Reorder present state in place to get past state for GPT model
 template <typename T>
 void PickGptPastState(const std::vector<OrtValue>& last_outputs,
                       std::vector<OrtValue>& next_inputs,
@@ -565,34 +615,18 @@ void PickGptPastState(const std::vector<OrtValue>& last_outputs,
                       AllocatorPtr allocator) {
   int num_present_tensors = static_cast<int>(last_outputs.size()) - gpt_subgraph_first_present_output_idx;
   for (ptrdiff_t i = 0; i < num_present_tensors; ++i) {
-    const OrtValue& present = last_outputs[gpt_subgraph_first_present_output_idx + i];
+    // The present is not read after the feeds are updated, so its buffer becomes the past.
+    OrtValue present = last_outputs[gpt_subgraph_first_present_output_idx + i];
 
     // shape is like (2, batch_beam_size, 12, past_seq_len, 64)
-    const TensorShape& past_shape = present.Get<Tensor>().Shape();
+    Tensor* present_tensor = present.GetMutable<Tensor>();
+    const TensorShape& past_shape = present_tensor->Shape();
     auto block_size_per_beam = past_shape[2] * past_shape[3] * past_shape[4];
-    auto past_key_size = past_shape[1] * past_shape[2] * past_shape[3] * past_shape[4];
-
-    // Create a tensor with same shape.
-    // TODO(tianleiwu): allocate one buffer for all layers
-    OrtValue past;
-    auto past_type = DataTypeImpl::GetType<T>();
-    Tensor::InitOrtValue(past_type, past_shape, allocator, past);
-
-    gsl::span<T> past_span = gsl::make_span<T>(past.GetMutable<Tensor>()->MutableData<T>(), onnxruntime::narrow<size_t>(past_shape.Size()));
-    gsl::span<const T> present_span = gsl::make_span<const T>(present.Get<Tensor>().Data<T>(), onnxruntime::narrow<size_t>(past_shape.Size()));
-    for (size_t j = 0; j < beam_indices.size(); j++) {
-      int32_t beam_index = beam_indices[j];
-      gsl::span<const T> present_key = present_span.subspan(beam_index * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::span<const T> present_value = present_span.subspan(past_key_size + beam_index * SafeInt<size_t>(block_size_per_beam),
-                                                              onnxruntime::narrow<size_t>(block_size_per_beam));
-
-      gsl::span<T> past_key = past_span.subspan(j * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::span<T> past_value = past_span.subspan(past_key_size + j * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::copy(present_key, past_key);
-      gsl::copy(present_value, past_value);
-    }
 
-    next_inputs[gpt_subgraph_first_past_input_idx + i] = past;
+    gsl::span<T> present_span = gsl::make_span<T>(present_tensor->MutableData<T>(), onnxruntime::narrow<size_t>(past_shape.Size()));
+    PickBeamsInPlace<T>(present_span, 2, onnxruntime::narrow<size_t>(block_size_per_beam), beam_indices, allocator);
+
+    next_inputs[gpt_subgraph_first_past_input_idx + i] = present;
   }
 }
 
@@ -756,7 +790,7 @@ Status CreateEncoderInputs(
   return Status::OK();
 }
 
-// Copy present state to past state for T5 model
+// Reorder present state in place to get past state for T5 model
 template <typename T>
 void PickT5PastState(const std::vector<OrtValue>& last_outputs,
                      std::vector<OrtValue>& next_inputs,
@@ -766,27 +800,18 @@ void PickT5PastState(const std::vector<OrtValue>& last_outputs,
                      int t5_decoder_first_present_output_idx,
                      AllocatorPtr allocator) {
   for (ptrdiff_t i = 0; i < num_present_tensors; ++i) {
-    const OrtValue& present = last_outputs[t5_decoder_first_present_output_idx + i];
+    // The present is not read after the feeds are updated, so its buffer becomes the past.
+    OrtValue present = last_outputs[t5_decoder_first_present_output_idx + i];
 
     // shape is like (batch_beam_size, 12, past_seq_len, 64)
-    const TensorShape& past_shape = present.Get<Tensor>().Shape();
+    Tensor* present_tensor = present.GetMutable<Tensor>();
+    const TensorShape& past_shape = present_tensor->Shape();
     auto block_size_per_beam = past_shape[1] * past_shape[2] * past_shape[3];
 
-    // Create a tensor with same shape.
-    // TODO(tianleiwu): allocate one buffer for all layers
-    OrtValue past;
-    Tensor::InitOrtValue(DataTypeImpl::GetType<T>(), past_shape, allocator, past);
-
-    gsl::span<T> past_span = gsl::make_span<T>(past.GetMutable<Tensor>()->MutableData<T>(), onnxruntime::narrow<size_t>(past_shape.Size()));
-    gsl::span<const T> present_span = gsl::make_span<const T>(present.Get<Tensor>().Data<T>(), onnxruntime::narrow<size_t>(past_shape.Size()));
-    for (size_t j = 0; j < beam_indices.size(); j++) {
-      int32_t beam_index = beam_indices[j];
-      gsl::span<const T> present_beam = present_span.subspan(beam_index * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::span<T> past_beam = past_span.subspan(j * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::copy(present_beam, past_beam);
-    }
+    gsl::span<T> present_span = gsl::make_span<T>(present_tensor->MutableData<T>(), onnxruntime::narrow<size_t>(past_shape.Size()));
+    PickBeamsInPlace<T>(present_span, 1, onnxruntime::narrow<size_t>(block_size_per_beam), beam_indices, allocator);
 
-    next_inputs[t5_decoder_first_past_input_idx + i] = past;
+    next_inputs[t5_decoder_first_past_input_idx + i] = present;
   }
 }
 
@@ -177,6 +177,13 @@ struct IGenerationParameters {
   int min_tokens_to_keep = 1;
   bool custom_sampling = false;
 
+  // Parameters for speculative decoding and prompt state reuse in GreedySearch and Sampling
+  int speculative_tokens = 0;
+  int prefix_cache_size = 0;
+
+  // Parameters for encoder decoder models in BeamSearch
+  bool broadcast_encoder_outputs = false;
+
   // Parameters for whisper model
   bool decoder_output_cross_qk = false;
   gsl::span<const int32_t> extra_decoding_ids;
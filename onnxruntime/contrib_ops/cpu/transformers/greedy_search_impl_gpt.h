@@ -3,10 +3,12 @@
 
 #pragma once
 #include <algorithm>
+#include <numeric>
 #include <vector>
 
 #include "core/common/span_utils.h"
 #include "contrib_ops/cpu/transformers/greedy_search_impl_base.h"
+#include "contrib_ops/cpu/transformers/prefix_cache.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -79,6 +81,11 @@ class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
   }
 #endif
 
+  // Reuse the past state of earlier prompts kept by the node. The cache is used on CPU only.
+  void SetPrefixCache(PrefixCache* prefix_cache) {
+    prefix_cache_ = prefix_cache;
+  }
+
   // Execute beam search in iterations util stopping criteria is reached.
   // In each iteration, GPT subgraph is called, and next token for each sequence is generated.
   Status Execute(const FeedsFetchesManager* init_run_feeds_fetches_manager,
@@ -101,6 +108,34 @@ class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
       gsl::span<const int32_t> next_tokens,
       int past_sequence_length);
 
+  // Drop the rows of finished sequences from the subgraph feeds, the past state and the position ids.
+  // active_rows maps each subgraph row to its batch row.
+  Status CompactFinishedRows(std::vector<OrtValue>& feeds,
+                             std::vector<OrtValue>& fetches,
+                             OrtValue& position_ids,
+                             GreedySearchState<T>& greedy_state,
+                             std::vector<int32_t>& active_rows,
+                             std::vector<OrtValue>& past_buffers);
+
+  // Look up draft tokens for the next subgraph call, and append them to the input ids, the position ids and the
+  // attention mask. draft_tokens is left empty when the sequence has no match.
+  Status AppendDraftTokens(std::vector<OrtValue>& feeds,
+                           GreedySearchState<T>& greedy_state,
+                           int current_length,
+                           std::vector<int32_t>& draft_tokens);
+
+  // Generate a token from the logits after each draft token, and stop at the first one that differs from the draft.
+  // The accepted draft tokens are counted in current_length and iteration_counter, and the past state and the
+  // attention mask drop the rejected ones.
+  Status VerifyDraftTokens(std::vector<OrtValue>& feeds,
+                           std::vector<OrtValue>& fetches,
+                           gsl::span<const int32_t> draft_tokens,
+                           gsl::span<int32_t>& next_tokens,
+                           GreedySearchState<T>& greedy_state,
+                           ISamplingState<T>& sampling_state,
+                           int& current_length,
+                           int& iteration_counter);
+
   const SessionState* init_run_decoder_session_state_ = nullptr;
   GptSubgraph* init_run_gpt_subgraph_ = nullptr;
   GptSubgraph& gpt_subgraph_;
@@ -116,6 +151,8 @@ class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
 
   const void* cuda_device_prop_ = nullptr;
   int cuda_device_arch_ = 0;
+
+  PrefixCache* prefix_cache_ = nullptr;
 };
 
 template <typename T, typename ParametersT>
@@ -187,6 +224,223 @@ Status GreedySearchGpt<T, ParametersT>::UpdateFeeds(
                             false);
 }
 
+// Copies the slices of source along axis that are listed in rows, in order, to target. The rows must be
+// increasing so that target may be the buffer of source.
+inline void GatherRows(const Tensor& source, size_t axis, gsl::span<const int32_t> rows, void* target) {
+  const TensorShape& shape = source.Shape();
+  const size_t outer = static_cast<size_t>(shape.SizeToDimension(axis));
+  const size_t count = static_cast<size_t>(shape[axis]);
+  const size_t row_bytes = static_cast<size_t>(shape.SizeFromDimension(axis + 1)) * source.DataType()->Size();
+  const uint8_t* source_data = static_cast<const uint8_t*>(source.DataRaw());
+  uint8_t* target_data = static_cast<uint8_t*>(target);
+  for (size_t o = 0; o < outer; o++) {
+    for (size_t j = 0; j < rows.size(); j++) {
+      memmove(target_data + (o * rows.size() + j) * row_bytes,
+              source_data + (o * count + static_cast<size_t>(rows[j])) * row_bytes,
+              row_bytes);
+    }
+  }
+}
+
+// Looks up at most max_tokens draft tokens for a sequence. They are the tokens that followed the latest earlier
+// occurrence of the last kMaxNgramSize tokens of the sequence, or of a shorter suffix when that does not occur.
+inline void LookupDraftTokens(gsl::span<const int32_t> sequence, size_t max_tokens, std::vector<int32_t>& draft_tokens) {
+  constexpr size_t kMaxNgramSize = 3;
+  draft_tokens.clear();
+  const size_t length = sequence.size();
+  if (length < 2 || max_tokens == 0) {
+    return;
+  }
+
+  for (size_t ngram_size = std::min(kMaxNgramSize, length - 1); ngram_size > 0; ngram_size--) {
+    const auto suffix = sequence.subspan(length - ngram_size);
+    for (size_t start = length - ngram_size; start-- > 0;) {
+      if (std::equal(suffix.begin(), suffix.end(), sequence.begin() + start)) {
+        const size_t end = std::min(start + ngram_size + max_tokens, length);
+        draft_tokens.assign(sequence.begin() + start + ngram_size, sequence.begin() + end);
+        return;
+      }
+    }
+  }
+}
+
+template <typename T, typename ParametersT>
+Status GreedySearchGpt<T, ParametersT>::CompactFinishedRows(std::vector<OrtValue>& feeds,
+                                                            std::vector<OrtValue>& fetches,
+                                                            OrtValue& position_ids,
+                                                            GreedySearchState<T>& greedy_state,
+                                                            std::vector<int32_t>& active_rows,
+                                                            std::vector<OrtValue>& past_buffers) {
+  // The subgraph rows to keep, which are increasing.
+  std::vector<int32_t> keep;
+  for (size_t j = 0; j < active_rows.size(); j++) {
+    if (!greedy_state.eos_meet[active_rows[j]]) {
+      keep.push_back(static_cast<int32_t>(j));
+    }
+  }
+  const int64_t new_batch_size = static_cast<int64_t>(keep.size());
+
+  // The attention mask has (batch_size, current_length - 1) until the feeds are updated.
+  const Tensor& mask = feeds[2].Get<Tensor>();
+  OrtValue new_mask;
+  Tensor::InitOrtValue(mask.DataType(), TensorShape({new_batch_size, mask.Shape()[1]}), this->temp_space_allocator_,
+                       new_mask);
+  GatherRows(mask, 0, keep, new_mask.GetMutable<Tensor>()->MutableDataRaw());
+  feeds[2] = new_mask;
+
+  int32_t* positions = greedy_state.next_positions.data();
+  for (size_t j = 0; j < keep.size(); j++) {
+    positions[j] = positions[keep[j]];
+  }
+  Tensor::InitOrtValue(DataTypeImpl::GetType<int32_t>(), TensorShape({new_batch_size, 1}), positions,
+                       this->temp_space_allocator_->Info(), position_ids);
+
+  // The past state has (2, batch_size, num_heads, past_sequence_length, head_size) per layer. A shared buffer
+  // is compacted in place and keeps its owner in past_buffers; otherwise the presents are gathered into new
+  // tensors before they become the next past state.
+  const int first_past = gpt_subgraph_.GetFirstPastInputIndex();
+  const int first_present = gpt_subgraph_.GetFirstPresentOutputIndex();
+  for (int layer = 0; layer < gpt_subgraph_.num_layers; layer++) {
+    OrtValue& present_value = fetches[static_cast<size_t>(first_present) + layer];
+    const Tensor& present = present_value.Get<Tensor>();
+    TensorShape shape = present.Shape();
+    shape[1] = new_batch_size;
+    if (gpt_subgraph_.past_present_share_buffer_) {
+      OrtValue& past_value = feeds[static_cast<size_t>(first_past) + layer];
+      if (past_buffers.size() < static_cast<size_t>(gpt_subgraph_.num_layers)) {
+        past_buffers.push_back(past_value);
+      }
+      void* data = past_value.GetMutable<Tensor>()->MutableDataRaw();
+      GatherRows(present, 1, keep, data);
+      const OrtMemoryInfo location = present.Location();
+      MLDataType type = present.DataType();
+      Tensor::InitOrtValue(type, shape, data, location, past_value);
+      Tensor::InitOrtValue(type, shape, data, location, present_value);
+    } else {
+      OrtValue new_present;
+      Tensor::InitOrtValue(present.DataType(), shape, this->temp_space_allocator_, new_present);
+      GatherRows(present, 1, keep, new_present.GetMutable<Tensor>()->MutableDataRaw());
+      present_value = new_present;
+    }
+  }
+
+  for (size_t j = 0; j < keep.size(); j++) {
+    active_rows[j] = active_rows[keep[j]];
+  }
+  active_rows.resize(keep.size());
+  return Status::OK();
+}
+
+template <typename T, typename ParametersT>
+Status GreedySearchGpt<T, ParametersT>::AppendDraftTokens(std::vector<OrtValue>& feeds,
+                                                          GreedySearchState<T>& greedy_state,
+                                                          int current_length,
+                                                          std::vector<int32_t>& draft_tokens) {
+  // Each draft token is followed by a generated token, which shall also fit in max_length.
+  const int max_tokens = std::min(this->parameters_->speculative_tokens,
+                                  this->parameters_->max_length - current_length - 1);
+  LookupDraftTokens(greedy_state.sequences.GetSequence(0), static_cast<size_t>(std::max(max_tokens, 0)),
+                    draft_tokens);
+  if (draft_tokens.empty()) {
+    return Status::OK();
+  }
+
+  const int64_t input_length = 1 + static_cast<int64_t>(draft_tokens.size());
+  auto int32_type = DataTypeImpl::GetType<int32_t>();
+
+  OrtValue input_ids;
+  Tensor::InitOrtValue(int32_type, TensorShape({1, input_length}), this->temp_space_allocator_, input_ids);
+  int32_t* input_ids_data = input_ids.GetMutable<Tensor>()->MutableData<int32_t>();
+  input_ids_data[0] = *feeds[0].Get<Tensor>().Data<int32_t>();
+  std::copy(draft_tokens.begin(), draft_tokens.end(), input_ids_data + 1);
+  feeds[0] = input_ids;
+
+  // The position ids owned by next_positions stay at the first input token for the next UpdateFeeds.
+  OrtValue position_ids;
+  Tensor::InitOrtValue(int32_type, TensorShape({1, input_length}), this->temp_space_allocator_, position_ids);
+  int32_t* position_data = position_ids.GetMutable<Tensor>()->MutableData<int32_t>();
+  std::iota(position_data, position_data + input_length, greedy_state.next_positions[0]);
+  feeds[1] = position_ids;
+
+  const Tensor& mask = feeds[2].Get<Tensor>();
+  const int64_t mask_length = mask.Shape()[1];
+  OrtValue attention_mask;
+  Tensor::InitOrtValue(int32_type, TensorShape({1, mask_length + input_length - 1}), this->temp_space_allocator_,
+                       attention_mask);
+  int32_t* mask_data = attention_mask.GetMutable<Tensor>()->MutableData<int32_t>();
+  std::copy_n(mask.Data<int32_t>(), mask_length, mask_data);
+  std::fill_n(mask_data + mask_length, input_length - 1, 1);
+  feeds[2] = attention_mask;
+  return Status::OK();
+}
+
+template <typename T, typename ParametersT>
+Status GreedySearchGpt<T, ParametersT>::VerifyDraftTokens(std::vector<OrtValue>& feeds,
+                                                          std::vector<OrtValue>& fetches,
+                                                          gsl::span<const int32_t> draft_tokens,
+                                                          gsl::span<int32_t>& next_tokens,
+                                                          GreedySearchState<T>& greedy_state,
+                                                          ISamplingState<T>& sampling_state,
+                                                          int& current_length,
+                                                          int& iteration_counter) {
+  // The logits processing uses the last position of its input, so the logits after the i-th input token are viewed
+  // as logits of i + 1 positions. Each token is generated with the counter it would have without drafts.
+  Tensor* logits = fetches[0].GetMutable<Tensor>();
+  ORT_RETURN_IF_NOT(logits->Shape()[1] == static_cast<int64_t>(draft_tokens.size()) + 1,
+                    "speculative_tokens requires the decoder subgraph to output the logits of all input tokens");
+  const int64_t vocab_size = logits->Shape()[2];
+  const OrtMemoryInfo location = logits->Location();
+  size_t accepted = 0;
+  for (;;) {
+    OrtValue logits_view;
+    Tensor::InitOrtValue(logits->DataType(), TensorShape({1, static_cast<int64_t>(accepted) + 1, vocab_size}),
+                         logits->MutableDataRaw(), location, logits_view);
+    ORT_RETURN_IF_ERROR(this->GenerateNextToken(logits_view,
+                                                next_tokens,
+                                                greedy_state,
+                                                sampling_state,
+                                                iteration_counter + static_cast<int>(accepted),
+                                                this->parameters_->eos_token_id));
+    if (greedy_state.eos_meet[0] || accepted == draft_tokens.size() || next_tokens[0] != draft_tokens[accepted]) {
+      break;
+    }
+    accepted++;
+  }
+
+  current_length += static_cast<int>(accepted);
+  iteration_counter += static_cast<int>(accepted);
+  greedy_state.next_positions[0] += static_cast<int32_t>(accepted);
+  if (accepted == draft_tokens.size()) {
+    return Status::OK();
+  }
+
+  // The past state of the next call has the first input token and the accepted draft tokens, and the attention mask
+  // has (1, current_length - 1) until the feeds are updated.
+  std::vector<int32_t> kept(static_cast<size_t>(current_length));
+  std::iota(kept.begin(), kept.end(), 0);
+
+  const Tensor& mask = feeds[2].Get<Tensor>();
+  OrtValue new_mask;
+  Tensor::InitOrtValue(mask.DataType(), TensorShape({1, static_cast<int64_t>(current_length)}),
+                       this->temp_space_allocator_, new_mask);
+  GatherRows(mask, 1, kept, new_mask.GetMutable<Tensor>()->MutableDataRaw());
+  feeds[2] = new_mask;
+
+  // The present state has (2, 1, num_heads, current_length + rejected, head_size) per layer.
+  const int first_present = gpt_subgraph_.GetFirstPresentOutputIndex();
+  for (int layer = 0; layer < gpt_subgraph_.num_layers; layer++) {
+    OrtValue& present_value = fetches[static_cast<size_t>(first_present) + layer];
+    const Tensor& present = present_value.Get<Tensor>();
+    TensorShape shape = present.Shape();
+    shape[3] = static_cast<int64_t>(current_length);
+    OrtValue new_present;
+    Tensor::InitOrtValue(present.DataType(), shape, this->temp_space_allocator_, new_present);
+    GatherRows(present, 3, kept, new_present.GetMutable<Tensor>()->MutableDataRaw());
+    present_value = new_present;
+  }
+  return Status::OK();
+}
+
 template <typename T, typename ParametersT>
 Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_run_feeds_fetches_manager,
                                                 const FeedsFetchesManager& feeds_fetches_manager) {
@@ -254,6 +508,41 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
                            parameters->max_length,
                            parameters->sequence_length);
 
+  // On CPU, a prompt without padding that starts with cached tokens feeds only the rest of it to the first subgraph
+  // call, with the cached rows as the past state. That call uses the decoder subgraph since it has a past state, and
+  // its present state is cached for later prompts.
+  const int first_past = gpt_subgraph_.GetFirstPastInputIndex();
+  const int first_present = gpt_subgraph_.GetFirstPresentOutputIndex();
+  gsl::span<const int32_t> initial_mask = feeds[2].Get<Tensor>().DataAsSpan<int32_t>();
+  const bool use_prefix_cache = prefix_cache_ != nullptr && !this->IsCuda() && parameters->BatchBeamSize() == 1 &&
+                                !gpt_subgraph_.past_present_share_buffer_ &&
+                                std::all_of(initial_mask.begin(), initial_mask.end(), [](int32_t m) { return m == 1; });
+  int cached_length = 0;
+  if (use_prefix_cache) {
+    std::vector<OrtValue> past_state;
+    cached_length = static_cast<int>(prefix_cache_->Lookup(input_ids, this->temp_space_allocator_, past_state));
+    if (cached_length > 0) {
+      const int64_t input_length = static_cast<int64_t>(parameters->sequence_length) - cached_length;
+      auto int32_type = DataTypeImpl::GetType<int32_t>();
+
+      OrtValue suffix_ids;
+      Tensor::InitOrtValue(int32_type, TensorShape({1, input_length}), this->temp_space_allocator_, suffix_ids);
+      int32_t* suffix_ids_data = suffix_ids.GetMutable<Tensor>()->MutableData<int32_t>();
+      std::copy(input_ids.begin() + cached_length, input_ids.end(), suffix_ids_data);
+      feeds[0] = suffix_ids;
+
+      OrtValue suffix_positions;
+      Tensor::InitOrtValue(int32_type, TensorShape({1, input_length}), this->temp_space_allocator_, suffix_positions);
+      int32_t* suffix_positions_data = suffix_positions.GetMutable<Tensor>()->MutableData<int32_t>();
+      std::iota(suffix_positions_data, suffix_positions_data + input_length, cached_length);
+      feeds[1] = suffix_positions;
+
+      for (int layer = 0; layer < gpt_subgraph_.num_layers; layer++) {
+        feeds[static_cast<size_t>(first_past) + layer] = past_state[layer];
+      }
+    }
+  }
+
 #ifdef DEBUG_GENERATION
   const IConsoleDumper* dumper = this->GetConsoleDumper();
 #endif
@@ -268,6 +557,24 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
                        this->temp_space_allocator_->Info(),
                        position_ids);
 
+  // On CPU, the sequences that have finished are dropped from the subgraph batch, so that the remaining steps only
+  // run the active rows. The logits of the active rows are scattered back to the full batch for the logits
+  // processing, where the finished rows are padded as before.
+  const size_t batch_beam_size = static_cast<size_t>(parameters->BatchBeamSize());
+  const bool compact_finished_rows = !this->IsCuda() && parameters->num_beams == 1;
+  std::vector<int32_t> active_rows(batch_beam_size);
+  std::iota(active_rows.begin(), active_rows.end(), 0);
+  std::vector<int32_t> active_next_tokens;
+  std::vector<OrtValue> past_buffers;
+  OrtValue full_logits;
+
+  // On CPU, a single sequence looks up draft tokens in its earlier text, and the decoder subgraph verifies them with
+  // the next token in one call. The tokens are generated from the logits as before and the drafts are accepted only
+  // while they match, so the sequences do not change.
+  const bool speculate = parameters->speculative_tokens > 0 && !this->IsCuda() && batch_beam_size == 1 &&
+                         !gpt_subgraph_.past_present_share_buffer_;
+  std::vector<int32_t> draft_tokens;
+
   int current_length = parameters->sequence_length;
   int iteration_counter = 0;
   while (current_length < parameters->max_length) {
@@ -282,7 +589,8 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
 
     // For the first iteration use the init_run_decoder subgraph (if present)
     if (iteration_counter++ == 0 &&
-        init_run_decoder_session_state_ != nullptr) {
+        init_run_decoder_session_state_ != nullptr &&
+        cached_length == 0) {
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
       const_cast<SessionState*>(this->init_run_decoder_session_state_)->IncrementGraphExecutionCounter();
 #endif
@@ -312,15 +620,43 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
 
     ORT_RETURN_IF_ERROR(status);
 
-    const OrtValue& logits = fetches[0];
+    if (use_prefix_cache && iteration_counter == 1) {
+      prefix_cache_->Insert(input_ids, std::vector<OrtValue>(fetches.begin() + first_present,
+                                                             fetches.begin() + first_present + gpt_subgraph_.num_layers));
+    }
+
+    const OrtValue* logits = &fetches[0];
+    if (active_rows.size() < batch_beam_size) {
+      const Tensor& active_logits = fetches[0].Get<Tensor>();
+      const TensorShape& logits_shape = active_logits.Shape();
+      if (!full_logits.IsAllocated()) {
+        Tensor::InitOrtValue(active_logits.DataType(),
+                             TensorShape({static_cast<int64_t>(batch_beam_size), logits_shape[1], logits_shape[2]}),
+                             this->temp_space_allocator_, full_logits);
+        Tensor* full = full_logits.GetMutable<Tensor>();
+        memset(full->MutableDataRaw(), 0, full->SizeInBytes());
+      }
+      const size_t row_bytes = static_cast<size_t>(logits_shape.SizeFromDimension(1)) * active_logits.DataType()->Size();
+      uint8_t* full_data = static_cast<uint8_t*>(full_logits.GetMutable<Tensor>()->MutableDataRaw());
+      const uint8_t* active_data = static_cast<const uint8_t*>(active_logits.DataRaw());
+      for (size_t j = 0; j < active_rows.size(); j++) {
+        memcpy(full_data + static_cast<size_t>(active_rows[j]) * row_bytes, active_data + j * row_bytes, row_bytes);
+      }
+      logits = &full_logits;
+    }
     gsl::span<int32_t> next_tokens;
 
-    ORT_RETURN_IF_ERROR(this->GenerateNextToken(logits,
-                                                next_tokens,
-                                                greedy_state,
-                                                sampling_state,
-                                                iteration_counter,
-                                                parameters->eos_token_id));
+    if (draft_tokens.empty()) {
+      ORT_RETURN_IF_ERROR(this->GenerateNextToken(*logits,
+                                                  next_tokens,
+                                                  greedy_state,
+                                                  sampling_state,
+                                                  iteration_counter,
+                                                  parameters->eos_token_id));
+    } else {
+      ORT_RETURN_IF_ERROR(VerifyDraftTokens(feeds, fetches, draft_tokens, next_tokens, greedy_state, sampling_state,
+                                            current_length, iteration_counter));
+    }
 
     // When all batches are finished, stop earlier to avoid wasting computation.
     gsl::span<bool>& eos_meet = greedy_state.eos_meet;
@@ -361,10 +697,34 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
     if (current_length < parameters->max_length) {
       bool increase_position = (iteration_counter > 1);
 
+      // Compacting copies the past state, so it waits until an eighth of the active rows have finished.
+      if (compact_finished_rows) {
+        const size_t finished = static_cast<size_t>(
+            std::count_if(active_rows.begin(), active_rows.end(),
+                          [&](int32_t row) { return greedy_state.eos_meet[row]; }));
+        if (finished > 0 && finished * 8 >= active_rows.size()) {
+          ORT_RETURN_IF_ERROR(CompactFinishedRows(feeds, fetches, position_ids, greedy_state, active_rows,
+                                                  past_buffers));
+        }
+      }
+
+      gsl::span<const int32_t> subgraph_next_tokens = ReinterpretAsSpan<const int32_t>(next_tokens);
+      if (active_rows.size() < batch_beam_size) {
+        active_next_tokens.resize(active_rows.size());
+        for (size_t j = 0; j < active_rows.size(); j++) {
+          active_next_tokens[j] = next_tokens[active_rows[j]];
+        }
+        subgraph_next_tokens = active_next_tokens;
+      }
+
       ORT_RETURN_IF_ERROR(UpdateFeeds(fetches, feeds, current_length,
                                       position_ids, increase_position,
-                                      ReinterpretAsSpan<const int32_t>(next_tokens),
+                                      subgraph_next_tokens,
                                       current_length - 1));
+
+      if (speculate) {
+        ORT_RETURN_IF_ERROR(AppendDraftTokens(feeds, greedy_state, current_length, draft_tokens));
+      }
     }
     if (gpt_subgraph_.past_present_share_buffer_) {
       // clear fetched values before presents[]
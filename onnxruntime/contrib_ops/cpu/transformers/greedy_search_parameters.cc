@@ -15,6 +15,10 @@ void GreedySearchParameters::ParseFromAttributes(const OpKernelInfo& info) {
   decoder_start_token_id = static_cast<int>(info.GetAttrOrDefault<int64_t>("decoder_start_token_id", -1));
   no_repeat_ngram_size = static_cast<int>(info.GetAttrOrDefault<int64_t>("no_repeat_ngram_size", 0));
   vocab_size = static_cast<int>(info.GetAttrOrDefault<int64_t>("vocab_size", -1));
+  speculative_tokens = static_cast<int>(info.GetAttrOrDefault<int64_t>("speculative_tokens", 0));
+  ORT_ENFORCE(speculative_tokens >= 0, "speculative_tokens shall be no less than 0, got ", speculative_tokens);
+  prefix_cache_size = static_cast<int>(info.GetAttrOrDefault<int64_t>("prefix_cache_size", 0));
+  ORT_ENFORCE(prefix_cache_size >= 0, "prefix_cache_size shall be no less than 0, got ", prefix_cache_size);
 }
 
 void GreedySearchParameters::ParseFromInputs(OpKernelContext* context) {
@@ -50,22 +50,25 @@ template <typename T>
 void RepetitionPenaltyLogitsProcessor<T>::Process(const ISequences* sequences,
                                                   NextTokenScores<T>& next_token_scores) {
   const int batch_beam_size = next_token_scores.batch_beam_size;
+  penalized_.resize(static_cast<size_t>(next_token_scores.vocab_size));
   for (int i = 0; i < batch_beam_size; i++) {
     gsl::span<T> beam_token_scores = next_token_scores.GetScores(i);
     gsl::span<const int32_t> sequence = sequences->GetSequence(i);
 
-    // Find unique word IDs in sequence.
-    std::unordered_set<int32_t> unique_word_ids;
-    for (const auto& word_id : sequence) {
-      unique_word_ids.insert(word_id);
-    }
+    // Each distinct word is penalized once.
+    for (const int32_t word_id : sequence) {
+      if (!penalized_[word_id]) {
+        penalized_[word_id] = 1;
+        T score = beam_token_scores[word_id];
 
-    for (const int32_t word_id : unique_word_ids) {
-      T score = beam_token_scores[word_id];
+        // If score < 0, then repetition penalty > 1.0 has to multiplied to reduce the previous token probability,
+        // This assumes that scores are either positive (like ctrl) or negative (like GPT-2), but not a mixture.
+        beam_token_scores[word_id] = (score < 0 ? score * penalty_ : score / penalty_);
+      }
+    }
 
-      // If score < 0, then repetition penalty > 1.0 has to multiplied to reduce the previous token probability,
-      // This assumes that scores are either positive (like ctrl) or negative (like GPT-2), but not a mixture.
-      beam_token_scores[word_id] = (score < 0 ? score * penalty_ : score / penalty_);
+    for (const int32_t word_id : sequence) {
+      penalized_[word_id] = 0;
     }
   }
 
@@ -95,132 +98,108 @@ void NoRepeatNGramLogitsProcessor<T>::Process(const ISequences* sequences,
     gsl::span<const int32_t> prefix = sequence.subspan(sequence.size() - prefix_length);
     ORT_ENFORCE(prefix.size() == narrow<size_t>(prefix_length));
 
-    std::unordered_set<int32_t> blocked_word_ids;
-    for (int j = 0; j <= static_cast<int>(sequence.size()) - ngram_size_; j++) {
-      // Here we use naive algorithm for matching. The complexity is O(batch_beam_size * ngram_size * sequence_length)
-      // TODO(tianleiwu): build N-Gram index (hash table with prefix of length NGram - 1 as key,
-      //                  and list of last word of NGram as value) for fast matching.
-      if (ngram_size_ == 1 || SpanEq(prefix, sequence.subspan(j, prefix_length))) {
-        blocked_word_ids.insert(sequence[static_cast<gsl::index>(j) + prefix_length]);
+    // The words that follow an earlier occurrence of the prefix are blocked. Each window of prefix_length words is
+    // compared by a rolling hash, and then word by word when the hashes are equal.
+    const int last_start = static_cast<int>(sequence.size()) - ngram_size_;
+    if (prefix_length == 0) {
+      for (int j = 0; j <= last_start; j++) {
+        beam_token_scores[sequence[j]] = std::numeric_limits<T>::lowest();
       }
+      continue;
     }
 
-    for (const int32_t word_id : blocked_word_ids) {
-      beam_token_scores[word_id] = std::numeric_limits<T>::lowest();
+    constexpr uint64_t kHashBase = 1000003;
+    uint64_t leading_power = 1;
+    uint64_t prefix_hash = 0;
+    uint64_t window_hash = 0;
+    for (gsl::index k = 0; k < prefix_length; k++) {
+      if (k > 0) {
+        leading_power *= kHashBase;
+      }
+      prefix_hash = prefix_hash * kHashBase + static_cast<uint32_t>(prefix[k]);
+      window_hash = window_hash * kHashBase + static_cast<uint32_t>(sequence[k]);
     }
-  }
-
-#ifdef DEBUG_GENERATION
-  DumpScores("NoRepeatNGramLogitsProcessor", next_token_scores);
-#endif
-}
-
-template <typename T>
-VocabMaskLogitsProcessor<T>::VocabMaskLogitsProcessor(const gsl::span<const int32_t>& vocab_mask)
-    : vocab_mask_(vocab_mask) {
-}
-
-template <typename T>
-void VocabMaskLogitsProcessor<T>::Process(const ISequences* /*sequences*/,
-                                          NextTokenScores<T>& next_token_scores) {
-  assert(!vocab_mask_.empty());
 
-  // Process vocabulary mask and set tokens with mask value 0 to -inf.
-  T* p = next_token_scores.scores.data();
-  // next_token_scores shape (batch_size * num_beams, vocab_size)
-  // vocab_mask shape (vocab_size).
-  for (int i = 0; i < next_token_scores.batch_beam_size; i++) {
-    for (int j = 0; j < next_token_scores.vocab_size; j++, p++) {
-      if (vocab_mask_[j] == 0) {
-        *p = std::numeric_limits<T>::lowest();
+    for (int j = 0; j <= last_start; j++) {
+      if (j > 0) {
+        window_hash = (window_hash - static_cast<uint32_t>(sequence[j - 1]) * leading_power) * kHashBase +
+                      static_cast<uint32_t>(sequence[static_cast<gsl::index>(j) + prefix_length - 1]);
+      }
+      if (window_hash == prefix_hash && SpanEq(prefix, sequence.subspan(j, prefix_length))) {
+        beam_token_scores[sequence[static_cast<gsl::index>(j) + prefix_length]] = std::numeric_limits<T>::lowest();
       }
     }
   }
 
 #ifdef DEBUG_GENERATION
-  DumpScores("VocabMaskLogitsProcessor", next_token_scores);
+  DumpScores("NoRepeatNGramLogitsProcessor", next_token_scores);
 #endif
 }
 
 template <typename T>
-PrefixVocabMaskLogitsProcessor<T>::PrefixVocabMaskLogitsProcessor(const gsl::span<const int32_t>& prefix_vocab_mask,
-                                                                  int batch_size)
-    : prefix_vocab_mask_(prefix_vocab_mask),
+VocabLogitsProcessor<T>::VocabLogitsProcessor(const gsl::span<const int32_t>& vocab_mask,
+                                              const gsl::span<const int32_t>& prefix_vocab_mask,
+                                              float temperature,
+                                              const gsl::span<const int32_t>& presence_mask,
+                                              float presence_penalty,
+                                              int batch_size)
+    : vocab_mask_(vocab_mask),
+      prefix_vocab_mask_(prefix_vocab_mask),
+      temperature_(temperature),
+      presence_mask_(presence_mask),
+      presence_penalty_(presence_penalty),
       batch_size_(batch_size) {
 }
 
 template <typename T>
-void PrefixVocabMaskLogitsProcessor<T>::Process(const ISequences* /*sequences*/,
-                                                NextTokenScores<T>& next_token_scores) {
-  assert(!prefix_vocab_mask_.empty());
+bool VocabLogitsProcessor<T>::IsIdentity() const {
+  return vocab_mask_.empty() && prefix_vocab_mask_.empty() && temperature_ == 1.0f &&
+         (presence_mask_.empty() || presence_penalty_ == 0.0f);
+}
 
+template <typename T>
+void VocabLogitsProcessor<T>::Process(const ISequences* /*sequences*/,
+                                      NextTokenScores<T>& next_token_scores) {
   // next_token_scores shape (batch_size * num_beams, vocab_size)
-  int num_beams = next_token_scores.batch_beam_size / batch_size_;
+  // vocab_mask shape (vocab_size), prefix_vocab_mask and presence_mask shape (batch_size, vocab_size).
+  const int vocab_size = next_token_scores.vocab_size;
+  const int num_beams = next_token_scores.batch_beam_size / batch_size_;
   assert(num_beams * batch_size_ == next_token_scores.batch_beam_size);
 
-  // Process prefix vocabulary mask and set tokens with mask value 0 to -inf.
-  // prefix_vocab_mask shape (batch_size, vocab_size).
-  T* p = next_token_scores.scores.data();
-  for (int i = 0; i < batch_size_; i++) {
-    size_t prefix_vocab_mask_offset = SafeInt<size_t>(i) * next_token_scores.vocab_size;
-    for (int j = 0; j < num_beams; j++) {
-      for (int k = 0; k < next_token_scores.vocab_size; k++, p++) {
-        if (prefix_vocab_mask_[prefix_vocab_mask_offset + static_cast<size_t>(k)] == 0) {
-          *p = std::numeric_limits<T>::lowest();
-        }
+  const bool use_vocab_mask = !vocab_mask_.empty();
+  const bool use_prefix_vocab_mask = is_first_step_ && !prefix_vocab_mask_.empty();
+  const bool use_temperature = temperature_ != 1.0f;
+  const bool use_presence_penalty = !presence_mask_.empty() && presence_penalty_ != 0.0f;
+  const T lowest = std::numeric_limits<T>::lowest();
+
+  for (int i = 0; i < next_token_scores.batch_beam_size; i++) {
+    T* p = next_token_scores.GetScores(i).data();
+    const size_t batch_offset = SafeInt<size_t>(i / num_beams) * vocab_size;
+    const int32_t* vocab_mask = vocab_mask_.data();
+    const int32_t* prefix_vocab_mask = use_prefix_vocab_mask ? prefix_vocab_mask_.data() + batch_offset : nullptr;
+    const int32_t* presence_mask = use_presence_penalty ? presence_mask_.data() + batch_offset : nullptr;
+
+    // Tokens with mask value 0 are set to the lowest value before the temperature, as in separate passes.
+    for (int j = 0; j < vocab_size; j++) {
+      T score = p[j];
+      if (use_vocab_mask && vocab_mask[j] == 0) {
+        score = lowest;
+      }
+      if (use_prefix_vocab_mask && prefix_vocab_mask[j] == 0) {
+        score = lowest;
+      }
+      if (use_temperature) {
+        score /= temperature_;
       }
+      if (use_presence_penalty) {
+        score -= presence_mask[j] * presence_penalty_;
+      }
+      p[j] = score;
     }
   }
 
 #ifdef DEBUG_GENERATION
-  DumpScores("PrefixVocabMaskLogitsProcessor", next_token_scores);
-#endif
-}
-
-template <typename T>
-TemperatureLogitsProcessor<T>::TemperatureLogitsProcessor(float temperature) : temperature_(temperature) {
-}
-
-template <typename T>
-void TemperatureLogitsProcessor<T>::Process(const ISequences* /*sequences*/,
-                                            NextTokenScores<T>& next_token_scores) {
-  if (temperature_ == 1.0f) {
-    return;
-  }
-
-  T* p = next_token_scores.scores.data();
-  for (size_t i = 0; i < next_token_scores.scores.size(); i++) {
-    *p /= temperature_;
-    ++p;
-  }
-
-#ifdef DEBUG_GENERATION
-  DumpScores("TemperatureLogitsProcessor", next_token_scores);
-#endif
-}
-
-template <typename T>
-PresencePenaltyLogitsProcessor<T>::PresencePenaltyLogitsProcessor(const gsl::span<const int32_t>& presence_mask,
-                                                                  float presence_penalty)
-    : presence_mask_(presence_mask), presence_penalty_(presence_penalty) {
-}
-
-template <typename T>
-void PresencePenaltyLogitsProcessor<T>::Process(const ISequences*,
-                                                NextTokenScores<T>& next_token_scores) {
-  if (presence_penalty_ == 0.0f) {
-    return;
-  }
-
-  assert(!presence_mask_.empty());
-
-  T* p = next_token_scores.scores.data();
-  for (size_t i = 0; i < next_token_scores.scores.size(); i++) {
-    *p -= presence_mask_[i] * presence_penalty_;
-  }
-
-#ifdef DEBUG_GENERATION
-  DumpScores("PresencePenaltyLogitsProcessor", next_token_scores);
+  DumpScores("VocabLogitsProcessor", next_token_scores);
 #endif
 }
 
@@ -240,11 +219,13 @@ void LogitsProcessorList::Process(const ISequences* sequences,
                                   gsl::span<float>& next_token_scores,
                                   int step) {
   NextTokenScores<float> input_scores = {next_token_scores, batch_beam_size_, vocab_size_};
+
+  // Prefix vocab mask is applied to first iteration only.
+  if (vocab_processor_ != nullptr) {
+    vocab_processor_->SetFirstStep(step <= 1);
+  }
+
   for (size_t i = 0; i < processor_list_.size(); i++) {
-    // Prefix vocab mask is applied to first iteration only.
-    if (step > 1 && processor_list_[i] == prefix_vocab_mask_processor_.get()) {
-      continue;
-    }
     processor_list_[i]->Process(sequences, input_scores);
   }
 }
@@ -67,6 +67,9 @@ class RepetitionPenaltyLogitsProcessor : public ILogitsProcessor<T> {
 
  private:
   float penalty_;
+
+  // Flags of the words of a sequence that are penalized, which are cleared after each sequence.
+  std::vector<uint8_t> penalized_;
 };
 
 template <typename T>
@@ -81,41 +84,34 @@ class NoRepeatNGramLogitsProcessor : public ILogitsProcessor<T> {
   int ngram_size_;
 };
 
+// Applies the vocabulary mask, the prefix vocabulary mask, the temperature and the presence penalty, in that order,
+// in one pass over each row of scores. The prefix vocabulary mask is applied in the first step only.
 template <typename T>
-class VocabMaskLogitsProcessor : public ILogitsProcessor<T> {
+class VocabLogitsProcessor : public ILogitsProcessor<T> {
  public:
-  VocabMaskLogitsProcessor(const gsl::span<const int32_t>& vocab_mask);
+  VocabLogitsProcessor(const gsl::span<const int32_t>& vocab_mask,
+                       const gsl::span<const int32_t>& prefix_vocab_mask,
+                       float temperature,
+                       const gsl::span<const int32_t>& presence_mask,
+                       float presence_penalty,
+                       int batch_size);
 
-  void Process(const ISequences* sequences,
-               NextTokenScores<T>& next_token_scores) override;
-
- private:
-  gsl::span<const int32_t> vocab_mask_;
-};
+  // Returns true when none of the parameters changes the scores.
+  bool IsIdentity() const;
 
-template <typename T>
-class PrefixVocabMaskLogitsProcessor : public ILogitsProcessor<T> {
- public:
-  PrefixVocabMaskLogitsProcessor(const gsl::span<const int32_t>& vocab_mask, int batch_size);
+  void SetFirstStep(bool is_first_step) { is_first_step_ = is_first_step; }
 
   void Process(const ISequences* sequences,
                NextTokenScores<T>& next_token_scores) override;
 
  private:
+  gsl::span<const int32_t> vocab_mask_;
   gsl::span<const int32_t> prefix_vocab_mask_;
-  const int batch_size_;
-};
-
-template <typename T>
-class TemperatureLogitsProcessor : public ILogitsProcessor<T> {
- public:
-  TemperatureLogitsProcessor(float temperature);
-
-  void Process(const ISequences* sequences,
-               NextTokenScores<T>& next_token_scores) override;
-
- private:
   float temperature_;
+  gsl::span<const int32_t> presence_mask_;
+  float presence_penalty_;
+  const int batch_size_;
+  bool is_first_step_ = true;
 };
 
 // template <typename T>
@@ -133,20 +129,6 @@ class TemperatureLogitsProcessor : public ILogitsProcessor<T> {
 //   onnxruntime::concurrency::ThreadPool* thread_pool_;
 // };
 
-template <typename T>
-class PresencePenaltyLogitsProcessor : public ILogitsProcessor<T> {
- public:
-  PresencePenaltyLogitsProcessor(const gsl::span<const int32_t>& presence_mask,
-                                 float presence_penalty);
-
-  void Process(const ISequences* sequences,
-               NextTokenScores<T>& next_token_scores) override;
-
- private:
-  gsl::span<const int32_t> presence_mask_;
-  float presence_penalty_;
-};
-
 template <typename T>
 class TimestampLogitsProcessor : public ILogitsProcessor<T> {
  public:
@@ -301,34 +283,24 @@ class LogitsProcessorList : public ILogitsProcessorList {
       processor_list_.push_back(no_repeat_ngram_processor_.get());
     }
 
-    if (!parameters.vocab_mask.empty()) {
-      vocab_mask_processor_ = std::make_unique<VocabMaskLogitsProcessor<float>>(parameters.vocab_mask);
-      processor_list_.push_back(vocab_mask_processor_.get());
-    }
-
-    if (!parameters.prefix_vocab_mask.empty()) {
-      prefix_vocab_mask_processor_ = std::make_unique<
-          PrefixVocabMaskLogitsProcessor<float>>(parameters.prefix_vocab_mask,
-                                                 parameters.batch_size);
-      processor_list_.push_back(prefix_vocab_mask_processor_.get());
-    }
-
     if (parameters.min_length > 0) {
       min_length_processor_ = std::make_unique<MinLengthLogitsProcessor<float>>(parameters.min_length,
                                                                                 parameters.eos_token_id);
       processor_list_.push_back(min_length_processor_.get());
     }
 
-    if (parameters.temperature > 0) {
-      temperature_processor_ = std::make_unique<TemperatureLogitsProcessor<float>>(parameters.temperature);
-      processor_list_.push_back(temperature_processor_.get());
-    }
-
-    if (!parameters.presence_mask.empty()) {
-      presence_penalty_processor_ = std::make_unique<
-          PresencePenaltyLogitsProcessor<float>>(parameters.presence_mask,
-                                                 parameters.presence_penalty);
-      processor_list_.push_back(presence_penalty_processor_.get());
+    // The masks run after the minimum length. Both only set scores to the lowest value, so the scores are the same.
+    vocab_processor_ = std::make_unique<VocabLogitsProcessor<float>>(
+        parameters.vocab_mask,
+        parameters.prefix_vocab_mask,
+        parameters.temperature > 0 ? parameters.temperature : 1.0f,
+        parameters.presence_mask,
+        parameters.presence_penalty,
+        parameters.batch_size);
+    if (vocab_processor_->IsIdentity()) {
+      vocab_processor_.reset();
+    } else {
+      processor_list_.push_back(vocab_processor_.get());
     }
 
     // Add timestamp processor for whisper model
@@ -348,11 +320,8 @@ class LogitsProcessorList : public ILogitsProcessorList {
 
   std::unique_ptr<RepetitionPenaltyLogitsProcessor<float>> repetition_penalty_processor_;
   std::unique_ptr<NoRepeatNGramLogitsProcessor<float>> no_repeat_ngram_processor_;
-  std::unique_ptr<VocabMaskLogitsProcessor<float>> vocab_mask_processor_;
-  std::unique_ptr<PrefixVocabMaskLogitsProcessor<float>> prefix_vocab_mask_processor_;
   std::unique_ptr<MinLengthLogitsProcessor<float>> min_length_processor_;
-  std::unique_ptr<TemperatureLogitsProcessor<float>> temperature_processor_;
-  std::unique_ptr<PresencePenaltyLogitsProcessor<float>> presence_penalty_processor_;
+  std::unique_ptr<VocabLogitsProcessor<float>> vocab_processor_;
   std::unique_ptr<TimestampLogitsProcessor<float>> timestamp_processor_;
 };
 
@@ -0,0 +1,129 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include "core/common/safeint.h"
+#include "core/framework/tensor.h"
+#include "contrib_ops/cpu/transformers/prefix_cache.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+namespace {
+// FNV-1a hash, which is updated one token at a time so that the hashes of all block prefixes take one pass.
+constexpr uint64_t kHashSeed = 14695981039346656037ULL;
+
+inline uint64_t HashToken(uint64_t hash, int32_t token) {
+  const uint32_t value = static_cast<uint32_t>(token);
+  for (int shift = 0; shift < 32; shift += 8) {
+    hash ^= (value >> shift) & 0xFF;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+}  // namespace
+
+size_t PrefixCache::Lookup(gsl::span<const int32_t> prompt, AllocatorPtr allocator, std::vector<OrtValue>& past_state) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+
+  // A shorter prefix may be stored by an entry that was not the last one to store a longer prefix, so every block
+  // is looked up.
+  size_t prefix_length = 0;
+  EntryList::iterator prefix_entry = entries_.end();
+  uint64_t hash = kHashSeed;
+  for (size_t i = 0; i < prompt.size(); i++) {
+    hash = HashToken(hash, prompt[i]);
+    const size_t length = i + 1;
+    if (length % kBlockSize != 0 || length == prompt.size()) {
+      continue;
+    }
+
+    auto block = blocks_.find(hash);
+    if (block != blocks_.end()) {
+      const std::vector<int32_t>& tokens = block->second->tokens;
+      if (tokens.size() >= length && std::equal(tokens.begin(), tokens.begin() + length, prompt.begin())) {
+        prefix_length = length;
+        prefix_entry = block->second;
+      }
+    }
+  }
+
+  if (prefix_length == 0) {
+    return 0;
+  }
+
+  entries_.splice(entries_.begin(), entries_, prefix_entry);
+
+  // Each cached tensor has (2, 1, num_heads, cached_length, head_size), of which the leading rows are copied.
+  past_state.clear();
+  for (const OrtValue& present_value : prefix_entry->present_state) {
+    const Tensor& present = present_value.Get<Tensor>();
+    const TensorShape& shape = present.Shape();
+    TensorShape past_shape = shape;
+    past_shape[3] = static_cast<int64_t>(prefix_length);
+
+    OrtValue past_value;
+    Tensor::InitOrtValue(present.DataType(), past_shape, allocator, past_value);
+    const size_t outer = static_cast<size_t>(shape.SizeToDimension(3));
+    const size_t row_bytes = SafeInt<size_t>(shape[4]) * present.DataType()->Size();
+    const size_t source_bytes = row_bytes * static_cast<size_t>(shape[3]);
+    const size_t target_bytes = row_bytes * prefix_length;
+    const uint8_t* source = static_cast<const uint8_t*>(present.DataRaw());
+    uint8_t* target = static_cast<uint8_t*>(past_value.GetMutable<Tensor>()->MutableDataRaw());
+    for (size_t o = 0; o < outer; o++) {
+      memcpy(target + o * target_bytes, source + o * source_bytes, target_bytes);
+    }
+    past_state.push_back(past_value);
+  }
+
+  return prefix_length;
+}
+
+void PrefixCache::Insert(gsl::span<const int32_t> prompt, const std::vector<OrtValue>& present_state) {
+  if (max_entries_ == 0 || prompt.size() <= kBlockSize) {
+    return;
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+
+  for (auto entry = entries_.begin(); entry != entries_.end(); ++entry) {
+    if (entry->tokens.size() == prompt.size() && std::equal(prompt.begin(), prompt.end(), entry->tokens.begin())) {
+      entries_.splice(entries_.begin(), entries_, entry);
+      return;
+    }
+  }
+
+  if (entries_.size() == max_entries_) {
+    Erase(std::prev(entries_.end()));
+  }
+
+  entries_.push_front(Entry{std::vector<int32_t>(prompt.begin(), prompt.end()), present_state});
+  uint64_t hash = kHashSeed;
+  for (size_t i = 0; i < prompt.size(); i++) {
+    hash = HashToken(hash, prompt[i]);
+    if ((i + 1) % kBlockSize == 0) {
+      blocks_[hash] = entries_.begin();
+    }
+  }
+}
+
+void PrefixCache::Erase(EntryList::iterator entry) {
+  uint64_t hash = kHashSeed;
+  for (size_t i = 0; i < entry->tokens.size(); i++) {
+    hash = HashToken(hash, entry->tokens[i]);
+    if ((i + 1) % kBlockSize == 0) {
+      auto block = blocks_.find(hash);
+      if (block != blocks_.end() && block->second == entry) {
+        blocks_.erase(block);
+      }
+    }
+  }
+  entries_.erase(entry);
+}
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "core/common/gsl.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+// Keeps the present state that the GPT subgraph computed for the prompts of earlier calls, so that a later prompt
+// starting with the same tokens only runs the subgraph on the rest of it.
+// Prompts are split into blocks of kBlockSize tokens, and the state is looked up by the hash of the tokens up to the
+// end of each block. The cached tensors are never written: a call that reuses them gets a copy of the leading rows as
+// its past state, and its subgraph calls produce new present tensors.
+class PrefixCache {
+ public:
+  static constexpr size_t kBlockSize = 16;
+
+  explicit PrefixCache(size_t max_entries) : max_entries_(max_entries) {}
+
+  // Finds the longest cached prefix of prompt that is a whole number of blocks and shorter than prompt, and copies
+  // its state into past_state, one (2, 1, num_heads, prefix_length, head_size) tensor per layer.
+  // Returns the prefix length, or 0 when no prefix is cached.
+  size_t Lookup(gsl::span<const int32_t> prompt, AllocatorPtr allocator, std::vector<OrtValue>& past_state);
+
+  // Stores the present state of prompt, one (2, 1, num_heads, prompt_length, head_size) tensor per layer.
+  // The least recently used prompt is dropped when the cache is full.
+  void Insert(gsl::span<const int32_t> prompt, const std::vector<OrtValue>& present_state);
+
+ private:
+  struct Entry {
+    std::vector<int32_t> tokens;
+    std::vector<OrtValue> present_state;
+  };
+  using EntryList = std::list<Entry>;
+
+  void Erase(EntryList::iterator entry);
+
+  const size_t max_entries_;
+
+  OrtMutex mutex_;
+
+  // Entries from the most to the least recently used, and the entry that last stored each block prefix hash.
+  EntryList entries_;
+  std::unordered_map<uint64_t, EntryList::iterator> blocks_;
+};
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
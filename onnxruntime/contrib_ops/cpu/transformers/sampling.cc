@@ -42,6 +42,10 @@ void Sampling::Init(const OpKernelInfo& info) {
   parameters_.ParseFromAttributes(info);
   parameters_.vocab_size = (parameters_.vocab_size == 0 ? -1 : parameters_.vocab_size);
 
+  if (parameters_.prefix_cache_size > 0) {
+    prefix_cache_ = std::make_unique<PrefixCache>(static_cast<size_t>(parameters_.prefix_cache_size));
+  }
+
   // Model_type could be either 0 (GPT-2) or 1 (encoder-decoder like T5)
   ORT_ENFORCE(parameters_.model_type == IGenerationParameters::kModelTypeGpt);
 
@@ -142,6 +146,7 @@ Status Sampling::Compute(OpKernelContext* ctx) const {
 #ifdef USE_CUDA
       ORT_RETURN_IF_ERROR(impl.InitializeCuda(reorder_past_state_func_, gpu_device_prop_, gpu_device_arch_));
 #endif
+      impl.SetPrefixCache(prefix_cache_.get());
       ORT_RETURN_IF_ERROR(impl.Initialize());
 
       return impl.Execute(init_run_decoder_feeds_fetches_manager_, *decoder_feeds_fetches_manager_);
@@ -166,6 +171,7 @@ Status Sampling::Compute(OpKernelContext* ctx) const {
 #ifdef USE_CUDA
       ORT_RETURN_IF_ERROR(impl.InitializeCuda(reorder_past_state_func_, gpu_device_prop_, gpu_device_arch_));
 #endif
+      impl.SetPrefixCache(prefix_cache_.get());
       ORT_RETURN_IF_ERROR(impl.Initialize());
 
       return impl.Execute(init_run_decoder_feeds_fetches_manager_, *decoder_feeds_fetches_manager_);
@@ -19,6 +19,10 @@ void SamplingParameters::ParseFromAttributes(const OpKernelInfo& info) {
   presence_penalty = info.GetAttrOrDefault<float>("presence_penalty", 0.0f);
   custom_sampling = static_cast<int>(info.GetAttrOrDefault<int64_t>("custom", 0));
   vocab_size = static_cast<int>(info.GetAttrOrDefault<int64_t>("vocab_size", -1));
+  speculative_tokens = static_cast<int>(info.GetAttrOrDefault<int64_t>("speculative_tokens", 0));
+  ORT_ENFORCE(speculative_tokens >= 0, "speculative_tokens shall be no less than 0, got ", speculative_tokens);
+  prefix_cache_size = static_cast<int>(info.GetAttrOrDefault<int64_t>("prefix_cache_size", 0));
+  ORT_ENFORCE(prefix_cache_size >= 0, "prefix_cache_size shall be no less than 0, got ", prefix_cache_size);
 }
 
 void SamplingParameters::ParseFromInputs(OpKernelContext* context) {
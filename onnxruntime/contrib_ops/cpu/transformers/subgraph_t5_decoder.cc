@@ -156,7 +156,8 @@ Status T5DecoderSubgraph::CreateInitialFeeds(
     int cur_len,
     transformers::Sequences& sequences,
     int past_present_share_buffer_max_seq_len,
-    bool need_cache_indir) {
+    bool need_cache_indir,
+    bool broadcast_encoder_outputs) {
   ORT_ENFORCE(session_state_ != nullptr, "Setup must be called before CreateInitialFeeds");
 
   // Allocate subgraph inputs from same device as inputs of encoder subgraph.
@@ -202,16 +203,22 @@ Status T5DecoderSubgraph::CreateInitialFeeds(
   decoder_feeds.push_back(input_ids);
 
   // The encoder_attention_mask is copied from the second input of encoder.
-  OrtValue expanded_decoder_attention_masks;
-  ORT_RETURN_IF_ERROR(expand_buffer_int32_func(stream,
-                                               encoder_feeds[1],
-                                               num_beam,
-                                               allocator,
-                                               expanded_decoder_attention_masks,
-                                               false,
-                                               0 /*max_sequence_length*/));
-
-  decoder_feeds.push_back(expanded_decoder_attention_masks);
+  // With broadcast_encoder_outputs, the encoder_attention_mask and the past key/value for cross attention keep
+  // the batch size of encoder, and the decoder broadcasts them over beams.
+  if (broadcast_encoder_outputs) {
+    decoder_feeds.push_back(encoder_feeds[1]);
+  } else {
+    OrtValue expanded_decoder_attention_masks;
+    ORT_RETURN_IF_ERROR(expand_buffer_int32_func(stream,
+                                                 encoder_feeds[1],
+                                                 num_beam,
+                                                 allocator,
+                                                 expanded_decoder_attention_masks,
+                                                 false,
+                                                 0 /*max_sequence_length*/));
+
+    decoder_feeds.push_back(expanded_decoder_attention_masks);
+  }
 
   if (!past_present_share_buffer_) {
     past_present_share_buffer_max_seq_len = 0;
@@ -242,6 +249,9 @@ Status T5DecoderSubgraph::CreateInitialFeeds(
                                                      0 /*max_sequence_length*/));
       }
       decoder_feeds.push_back(expanded_hidden_states);
+    } else if (broadcast_encoder_outputs && j >= static_cast<size_t>(2) + 2 * static_cast<size_t>(num_layers)) {
+      // Encoder fetches have logits and encoder_hidden_states before the past key/value for self attention.
+      decoder_feeds.push_back(encoder_fetches[j]);
     } else {
       // past key/value for cross attention does not need to be initialized with max_seq_len since they are static.
       bool use_max_seq_len = (j - first_past_input_index_) < 2 * static_cast<size_t>(num_layers);
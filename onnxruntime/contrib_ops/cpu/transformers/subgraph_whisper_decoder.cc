@@ -152,7 +152,8 @@ Status WhisperDecoderSubgraph::CreateInitialFeeds(
     int cur_len,
     transformers::Sequences& sequences,
     int past_present_share_buffer_max_seq_len,
-    bool need_cache_indir) {
+    bool need_cache_indir,
+    bool broadcast_encoder_outputs) {
   ORT_ENFORCE(session_state_ != nullptr, "Setup must be called before CreateInitialFeeds");
 
   // Allocate subgraph inputs from same device as inputs of encoder subgraph.
@@ -228,6 +229,9 @@ Status WhisperDecoderSubgraph::CreateInitialFeeds(
                                                      0 /*max_sequence_length*/));
       }
       decoder_feeds.push_back(expanded_hidden_states);
+    } else if (broadcast_encoder_outputs && j >= static_cast<size_t>(2) + 2 * static_cast<size_t>(num_layers)) {
+      // Encoder fetches have logits and encoder_hidden_states before the past key/value for self attention.
+      decoder_feeds.push_back(encoder_fetches[j]);
     } else {
       // past key/value for cross attention does not need to be initialized with max_seq_len since they are static.
       bool use_max_seq_len = (j - first_past_input_index_) <= 2 * static_cast<size_t>(num_layers);
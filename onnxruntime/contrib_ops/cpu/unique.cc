@@ -8,6 +8,10 @@
 #pragma warning(disable : 4996)
 #endif
 #include "unique.h"
+
+#include <algorithm>
+#include <vector>
+
 #include "core/common/inlined_containers.h"
 #include "core/providers/cpu/tensor/utils.h"
 
@@ -37,50 +41,38 @@ Status Unique<float>::Compute(OpKernelContext* ctx) const {
   Tensor* output_idx = ctx->Output(1, input->Shape());
   int64_t* output_idx_data = output_idx->MutableData<int64_t>();
 
-  struct ElementData {
-    int64_t input_pos_;  // original index
-    int64_t output_pos_;
-    int64_t count_;  // number of times encountered
-  };
-
-  // XXX: Refactoring for less memory allocations. unordered_map
-  // used originally for float uniqueness, is this correct?
-  using IndexingMap = InlinedHashMap<float, ElementData>;
-  IndexingMap mapped_indices;
-  mapped_indices.reserve(onnxruntime::narrow<size_t>(num_elements));
+  // the map only holds the output position of each value, the first occurrences and their counts are kept in order
+  // of output position so the outputs are copied without walking the map
+  InlinedHashMap<float, int64_t> output_positions;
+  output_positions.reserve(onnxruntime::narrow<size_t>(num_elements));
+  std::vector<float> uniques;
+  std::vector<int64_t> counts;
 
   // processing
   for (int64_t i = 0; i < num_elements; ++i) {
-    float value = input_data[i];
-
-    const auto original_index = i;
-    const auto num_unique = static_cast<int64_t>(mapped_indices.size());
-    auto insert_result = mapped_indices.emplace(value, ElementData{original_index, num_unique, 1});
+    const float value = input_data[i];
+    const auto num_unique = static_cast<int64_t>(uniques.size());
+    auto insert_result = output_positions.emplace(value, num_unique);
     if (insert_result.second) {
+      uniques.push_back(value);
+      counts.push_back(1);
       output_idx_data[i] = num_unique;
     } else {
       // Seen before
-      output_idx_data[i] = insert_result.first->second.output_pos_;
-      insert_result.first->second.count_++;
+      const int64_t output_pos = insert_result.first->second;
+      output_idx_data[i] = output_pos;
+      counts[onnxruntime::narrow<size_t>(output_pos)]++;
     }
   }
 
   // 'uniques' output
-  TensorShape output_shape({static_cast<int64_t>(mapped_indices.size())});
+  TensorShape output_shape({static_cast<int64_t>(uniques.size())});
   Tensor* output_uniques = ctx->Output(0, output_shape);
-  float* output_uniques_data = output_uniques->MutableData<float>();
+  std::copy(uniques.begin(), uniques.end(), output_uniques->MutableData<float>());
 
   // 'counts' output
   Tensor* output_counts = ctx->Output(2, output_shape);
-  int64_t* output_counts_data = output_counts->MutableData<int64_t>();
-
-  for (const auto& e : mapped_indices) {
-    // 'uniques' data
-    const auto output_pos = e.second.output_pos_;
-    output_uniques_data[output_pos] = e.first;
-    // 'counts' data
-    output_counts_data[output_pos] = e.second.count_;
-  }
+  std::copy(counts.begin(), counts.end(), output_counts->MutableData<int64_t>());
 
   return Status::OK();
 }
@@ -302,6 +302,13 @@ Status Attention<T>::ComputeInternal(OpKernelContext* context) const {
     data.out_accum = reinterpret_cast<CudaT*>(out_accum_buffer.get());
   }
 
+  if (IsRecordingKernelDispatch()) {
+    RecordKernelDispatch("attention_kernel", use_flash_attention              ? "flash"
+                                             : fused_runner != nullptr        ? "trt_fused"
+                                             : use_memory_efficient_attention ? "memory_efficient"
+                                                                              : "unfused");
+  }
+
   return QkvToContext<CudaT>(device_prop, cublas, context->GetComputeStream(), parameters, data);
 }
 
@@ -606,12 +606,17 @@ template <typename T, unsigned TPB>
 __global__ void SoftmaxKernelSmallWithCumSeqLen(const T* input,
                                                 const T* rel_pos_bias, const bool broadcast_rel_pos_bias,
                                                 const int* cum_seq_length, const int sequence_length,
-                                                T* output) {
+                                                const bool causal, T* output) {
   __shared__ int end_position;
 
   if (threadIdx.x == 0) {
     const int batch = blockIdx.y;
     end_position = cum_seq_length[batch + 1] - cum_seq_length[batch];
+
+    // Input dimension is BxNxSxS and blockIdx.x is the index within N*S, so the query is at blockIdx.x % S.
+    if (causal) {
+      end_position = min(end_position, static_cast<int>(blockIdx.x) % sequence_length + 1);
+    }
   }
   __syncthreads();
 
@@ -624,12 +629,17 @@ template <typename T, unsigned TPB>
 __global__ void SoftmaxKernelWithCumSeqLen(const T* input,
                                            const T* rel_pos_bias, const bool broadcast_rel_pos_bias,
                                            const int* cum_seq_length, const int sequence_length,
-                                           T* output) {
+                                           const bool causal, T* output) {
   __shared__ int end_position;
 
   if (threadIdx.x == 0) {
     const int batch = blockIdx.y;
     end_position = cum_seq_length[batch + 1] - cum_seq_length[batch];
+
+    // Input dimension is BxNxSxS and blockIdx.x is the index within N*S, so the query is at blockIdx.x % S.
+    if (causal) {
+      end_position = min(end_position, static_cast<int>(blockIdx.x) % sequence_length + 1);
+    }
   }
   __syncthreads();
 
@@ -695,6 +705,7 @@ Status ComputeSoftmaxWithCumSeqLength(
     const int batch_size,
     const int sequence_length,
     const int num_heads,
+    const bool causal,
     T* output, cudaStream_t stream) {
   const dim3 grid(sequence_length * num_heads, batch_size, 1);
 
@@ -702,37 +713,37 @@ Status ComputeSoftmaxWithCumSeqLength(
     const int blockSize = 32;
     SoftmaxKernelSmallWithCumSeqLen<T, blockSize>
         <<<grid, blockSize, 0, stream>>>(input, rel_pos_bias, broadcast_rel_pos_bias,
-                                         cum_seq_length, sequence_length, output);
+                                         cum_seq_length, sequence_length, causal, output);
 
   } else if (sequence_length <= 64) {
     const int blockSize = 64;
     SoftmaxKernelSmallWithCumSeqLen<T, blockSize>
         <<<grid, blockSize, 0, stream>>>(input, rel_pos_bias, broadcast_rel_pos_bias,
-                                         cum_seq_length, sequence_length, output);
+                                         cum_seq_length, sequence_length, causal, output);
   } else if (sequence_length <= 128) {
     const int blockSize = 128;
     SoftmaxKernelSmallWithCumSeqLen<T, blockSize>
         <<<grid, blockSize, 0, stream>>>(input, rel_pos_bias, broadcast_rel_pos_bias,
-                                         cum_seq_length, sequence_length, output);
+                                         cum_seq_length, sequence_length, causal, output);
   } else if (sequence_length <= 256) {
     const int blockSize = 256;
     SoftmaxKernelSmallWithCumSeqLen<T, blockSize>
         <<<grid, blockSize, 0, stream>>>(input, rel_pos_bias, broadcast_rel_pos_bias,
-                                         cum_seq_length, sequence_length, output);
+                                         cum_seq_length, sequence_length, causal, output);
   } else if (sequence_length <= 512) {
     const int blockSize = 512;
     SoftmaxKernelSmallWithCumSeqLen<T, blockSize>
         <<<grid, blockSize, 0, stream>>>(input, rel_pos_bias, broadcast_rel_pos_bias,
-                                         cum_seq_length, sequence_length, output);
+                                         cum_seq_length, sequence_length, causal, output);
   } else if (sequence_length <= 1024) {
     const int blockSize = 1024;
     SoftmaxKernelSmallWithCumSeqLen<T, blockSize>
         <<<grid, blockSize, 0, stream>>>(input, rel_pos_bias, broadcast_rel_pos_bias,
-                                         cum_seq_length, sequence_length, output);
+                                         cum_seq_length, sequence_length, causal, output);
   } else {
     SoftmaxKernelWithCumSeqLen<T, 1024>
         <<<grid, 1024, 0, stream>>>(input, rel_pos_bias, broadcast_rel_pos_bias,
-                                    cum_seq_length, sequence_length, output);
+                                    cum_seq_length, sequence_length, causal, output);
   }
 
   return CUDA_CALL(cudaGetLastError());
@@ -903,6 +914,7 @@ template Status ComputeSoftmaxWithCumSeqLength<float>(
     const int batch_size,
     const int sequence_length,
     const int num_heads,
+    const bool causal,
     float* output, cudaStream_t stream);
 
 template Status ComputeSoftmaxWithCumSeqLength<half>(
@@ -913,6 +925,7 @@ template Status ComputeSoftmaxWithCumSeqLength<half>(
     const int batch_size,
     const int sequence_length,
     const int num_heads,
+    const bool causal,
     half* output, cudaStream_t stream);
 
 template Status ComputeSoftmaxWithMask1D<float>(cudaStream_t stream,
@@ -21,6 +21,7 @@ Status ComputeSoftmaxWithCumSeqLength(
     const int batch_size,
     const int sequence_length,
     const int num_heads,
+    const bool causal,
     T* output, cudaStream_t stream);
 
 template <typename T>
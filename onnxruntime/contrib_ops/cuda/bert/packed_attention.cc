@@ -46,8 +46,10 @@ MHARunner* TrtFusedAttention<T>::GetFusedRunner(const cudaDeviceProp& device_pro
                                                 const PackedAttentionParameters& parameters) const {
   MHARunner* fused_runner = nullptr;
 
+  // The causal kernels of TensorRT don't take the cumulative sequence length of packed inputs.
   bool use_fused_runner = !disable_fused_runner_ &&
                           !parameters.has_relative_position_bias &&
+                          !parameters.is_unidirectional &&
                           parameters.hidden_size == parameters.v_hidden_size;
 
   if (!use_fused_runner) {
@@ -92,6 +94,7 @@ PackedAttention<T>::PackedAttention(const OpKernelInfo& info) : TrtFusedAttentio
   num_heads_ = static_cast<int32_t>(num_heads);
 
   scale_ = info.GetAttrOrDefault<float>("scale", 0.0f);
+  is_unidirectional_ = info.GetAttrOrDefault<int64_t>("unidirectional", 0) == 1;
 
   if (!info.GetAttrs<int64_t>("qkv_hidden_sizes", qkv_hidden_sizes_).IsOK()) {
     qkv_hidden_sizes_.clear();
@@ -254,6 +257,7 @@ Status PackedAttention<T>::CheckInputs(const TensorShape& input_shape,
   parameters.token_count = static_cast<int32_t>(token_count);
   parameters.has_relative_position_bias = nullptr != relative_position_bias;
   parameters.broadcast_res_pos_bias = broadcast_res_pos_bias;
+  parameters.is_unidirectional = is_unidirectional_;
 
   return Status::OK();
 }
@@ -52,6 +52,7 @@ class PackedAttention final : public TrtFusedAttention<T>, public CudaKernel {
  private:
   int num_heads_;                          // number of attention heads
   float scale_;                            // scale for softmax. Default is 0.0f, which will be replaced by 1/sqrt(num_heads) later
+  bool is_unidirectional_;                 // whether each token only attends to the previous tokens of its sequence
   std::vector<int64_t> qkv_hidden_sizes_;  // Q, K, V hidden sizes parsed from the qkv_hidden_sizes attribute.
 };
 
@@ -515,7 +515,7 @@ Status FusedScaledDotProductAttentionCutlass(
   p.max_sequence_length = parameters.sequence_length;
   p.qk_head_size = parameters.head_size;
   p.v_head_size = parameters.v_head_size;
-  p.causal = false;
+  p.causal = parameters.is_unidirectional;
   p.scale = parameters.scale == 0.0f ? 1.f / sqrt(static_cast<float>(qk_head_size))
                                      : parameters.scale;
   p.seqlen_k_ptr = nullptr;
@@ -613,6 +613,7 @@ Status UnfusedScaledDotProductAttention(
       batch_size,
       sequence_length,
       num_heads,
+      parameters.is_unidirectional,
       attention_score, stream));
 
   DUMP_TENSOR_D("PackedAttention unfused Softmax", attention_score, batch_size * num_heads, sequence_length, sequence_length);
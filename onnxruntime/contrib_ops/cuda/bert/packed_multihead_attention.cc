@@ -41,6 +41,7 @@ PackedMultiHeadAttention<T>::PackedMultiHeadAttention(const OpKernelInfo& info)
   num_heads_ = static_cast<int32_t>(num_heads);
 
   scale_ = info.GetAttrOrDefault<float>("scale", 0.0f);
+  is_unidirectional_ = info.GetAttrOrDefault<int64_t>("unidirectional", 0) == 1;
 
 #if USE_FLASH_ATTENTION
   disable_flash_attention_ = sizeof(T) != 2 || onnxruntime::ParseEnvironmentVariableWithDefault<bool>(
@@ -213,6 +214,7 @@ Status PackedMultiHeadAttention<T>::CheckInputs(const TensorShape& query_shape,
   parameters.token_count = static_cast<int32_t>(token_count);
   parameters.has_relative_position_bias = (nullptr != relative_position_bias);
   parameters.broadcast_res_pos_bias = broadcast_res_pos_bias;
+  parameters.is_unidirectional = is_unidirectional_;
 
   return Status::OK();
 }
@@ -29,6 +29,7 @@ class PackedMultiHeadAttention final : public TrtFusedAttention<T>, public CudaK
 
   int num_heads_;  // number of attention heads
   float scale_;    // the scale for softmax in memory efficient attention or unfused attention.
+  bool is_unidirectional_;  // whether each token only attends to the previous tokens of its sequence
 
   bool disable_memory_efficient_attention_;
   bool disable_flash_attention_;
@@ -639,8 +639,7 @@ Status FlashAttention(
           sequence_length,
           sequence_length,
           scale,
-          false  // is causal
-          ));
+          parameters.is_unidirectional));
 
   DUMP_TENSOR_INIT();
   DUMP_TENSOR_D("q(BSNH)", reinterpret_cast<const T*>(query), parameters.token_count, num_heads, qk_head_size);
@@ -691,7 +690,7 @@ Status FusedAttentionCutlass(
   p.max_sequence_length = parameters.sequence_length;
   p.qk_head_size = parameters.head_size;
   p.v_head_size = parameters.v_head_size;
-  p.causal = false;
+  p.causal = parameters.is_unidirectional;
   p.scale = parameters.scale == 0.0f ? 1.f / sqrt(static_cast<float>(qk_head_size))
                                      : parameters.scale;
   p.seqlen_k_ptr = nullptr;
@@ -796,6 +795,7 @@ Status UnfusedAttention(
       batch_size,
       sequence_length,
       num_heads,
+      parameters.is_unidirectional,
       attention_score, stream));
 
   DUMP_TENSOR_D("Softmax", attention_score, batch_size, num_heads, sequence_length, sequence_length);
@@ -61,8 +61,144 @@ static TensorShape InferMatmulOutputShape(
   return TensorShape(shape_Y);
 };
 
+// The output is computed in chunks of at least this many rows, so that the GEMM of a chunk stays efficient.
+constexpr int64_t kMinOverlapChunkRows = 64;
+
+// Returns whether a tensor is a matrix, possibly with leading dimensions of 1, whose rows are contiguous.
+static bool IsMatrix(const TensorShape& shape) {
+  return shape.NumDimensions() >= 2 && shape.SizeToDimension(shape.NumDimensions() - 2) == 1;
+}
+
+// Returns whether the shards along a device mesh are in the order of the ranks of the NCCL communicator, which
+// NCCL's reduce-scatter and all-gather assume.
+static bool IsCommunicatorMesh(const DeviceMesh& device_mesh, int world_size) {
+  if (device_mesh.device_mesh_shape.size() != 1 ||
+      device_mesh.device_mesh_elements.size() != static_cast<size_t>(world_size)) {
+    return false;
+  }
+  for (size_t i = 0; i < device_mesh.device_mesh_elements.size(); ++i) {
+    if (device_mesh.device_mesh_elements[i] != static_cast<int64_t>(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 template <typename T>
 DistributedMatMul<T>::DistributedMatMul(const OpKernelInfo& info) : DistributedKernel(info) {
+  overlap_chunks_ = info.GetAttrOrDefault<int64_t>("overlap_chunks", 4);
+  ORT_ENFORCE(overlap_chunks_ >= 1, "overlap_chunks must be positive.");
+}
+
+template <typename T>
+DistributedMatMul<T>::~DistributedMatMul() {
+  for (cudaEvent_t event : chunk_events_) {
+    cudaEventDestroy(event);
+  }
+  if (comm_done_event_ != nullptr) {
+    cudaEventDestroy(comm_done_event_);
+  }
+  if (comm_stream_ != nullptr) {
+    cudaStreamDestroy(comm_stream_);
+  }
+}
+
+template <typename T>
+Status DistributedMatMul<T>::InitializeCommStream() const {
+  std::lock_guard<std::mutex> lock(comm_stream_mutex_);
+  if (comm_stream_ != nullptr) {
+    return Status::OK();
+  }
+
+  std::vector<cudaEvent_t> chunk_events(gsl::narrow<size_t>(overlap_chunks_));
+  for (auto& event : chunk_events) {
+    CUDA_RETURN_IF_ERROR(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+  }
+  CUDA_RETURN_IF_ERROR(cudaEventCreateWithFlags(&comm_done_event_, cudaEventDisableTiming));
+  chunk_events_ = std::move(chunk_events);
+
+  // The NCCL kernels run on the SMs the GEMMs leave, so the communication stream has the greatest priority.
+  int least_priority = 0;
+  int greatest_priority = 0;
+  CUDA_RETURN_IF_ERROR(cudaDeviceGetStreamPriorityRange(&least_priority, &greatest_priority));
+  CUDA_RETURN_IF_ERROR(cudaStreamCreateWithPriority(&comm_stream_, cudaStreamNonBlocking, greatest_priority));
+  return Status::OK();
+}
+
+template <typename T>
+Status DistributedMatMul<T>::MatMulAllReduce(OpKernelContext* context, const Tensor* A, const Tensor* B,
+                                             Tensor* Y) const {
+  const auto& shape_A = A->Shape();
+  const auto& shape_B = B->Shape();
+  const size_t rank_A = shape_A.NumDimensions();
+  const int64_t rows = shape_A.SizeToDimension(rank_A - 1);
+  const int64_t num_chunks = std::min(overlap_chunks_, rows / kMinOverlapChunkRows);
+
+  // The rows of A can only be split if B is a matrix, which is not broadcast along the leading dimensions of A.
+  if (num_chunks <= 1 || !IsMatrix(shape_B)) {
+    ORT_RETURN_IF_ERROR(onnxruntime::cuda::FuncMatMul<T>(
+        this, context, A, B, 1.0, false, false, false, false, Y));
+    return FuncAllReduce(nccl_->Comm(), Stream(context), Y, Y);
+  }
+
+  ORT_RETURN_IF_ERROR(InitializeCommStream());
+
+  const int64_t K = shape_A[rank_A - 1];
+  const int64_t N = shape_B[shape_B.NumDimensions() - 1];
+  const int64_t chunk_rows = (rows + num_chunks - 1) / num_chunks;
+  cudaStream_t compute_stream = Stream(context);
+
+  const Tensor matrix_B(B->DataType(), TensorShape({K, N}), const_cast<void*>(B->DataRaw()), B->Location());
+  const T* data_A = A->Data<T>();
+  T* data_Y = Y->MutableData<T>();
+  int64_t chunk = 0;
+  for (int64_t row = 0; row < rows; row += chunk_rows, ++chunk) {
+    const int64_t chunk_size = std::min(chunk_rows, rows - row);
+    const Tensor chunk_A(A->DataType(), TensorShape({chunk_size, K}), const_cast<T*>(data_A + row * K),
+                         A->Location());
+    Tensor chunk_Y(Y->DataType(), TensorShape({chunk_size, N}), data_Y + row * N, Y->Location());
+    ORT_RETURN_IF_ERROR(onnxruntime::cuda::FuncMatMul<T>(
+        this, context, &chunk_A, &matrix_B, 1.0, false, false, false, false, &chunk_Y));
+
+    // The all-reduce of the chunk waits for its GEMM, and runs while the GEMM of the next chunk does.
+    CUDA_RETURN_IF_ERROR(cudaEventRecord(chunk_events_[chunk], compute_stream));
+    CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(comm_stream_, chunk_events_[chunk], 0));
+    ORT_RETURN_IF_ERROR(FuncAllReduce(nccl_->Comm(), comm_stream_, &chunk_Y, &chunk_Y));
+  }
+
+  // The kernels after this one read Y on the compute stream.
+  CUDA_RETURN_IF_ERROR(cudaEventRecord(comm_done_event_, comm_stream_));
+  CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(compute_stream, comm_done_event_, 0));
+  return Status::OK();
+}
+
+template <typename T>
+Status DistributedMatMul<T>::MatMulReduceScatter(OpKernelContext* context, const Tensor* A, const Tensor* B,
+                                                 const TensorShape& partial_shape_Y, Tensor* Y) const {
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+  auto partial_Y = Tensor::Create(Y->DataType(), partial_shape_Y, alloc);
+  ORT_RETURN_IF_ERROR(onnxruntime::cuda::FuncMatMul<T>(
+      this, context, A, B, 1.0, false, false, false, false, partial_Y.get()));
+
+  // Each rank only receives the sum of its rows, which moves half the data of an all-reduce.
+  NCCL_RETURN_IF_ERROR(ncclReduceScatter(partial_Y->DataRaw(), Y->MutableDataRaw(), Y->Shape().Size(),
+                                         GetNcclDataType(Y->DataType()), ncclSum, nccl_->Comm(), Stream(context)));
+  return Status::OK();
+}
+
+template <typename T>
+Status DistributedMatMul<T>::MatMulAllGather(OpKernelContext* context, const Tensor* A, const Tensor* B,
+                                             const TensorShape& shard_shape_Y, Tensor* Y) const {
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+  auto shard_Y = Tensor::Create(Y->DataType(), shard_shape_Y, alloc);
+  ORT_RETURN_IF_ERROR(onnxruntime::cuda::FuncMatMul<T>(
+      this, context, A, B, 1.0, false, false, false, false, shard_Y.get()));
+
+  NCCL_RETURN_IF_ERROR(ncclAllGather(shard_Y->DataRaw(), Y->MutableDataRaw(), shard_shape_Y.Size(),
+                                     GetNcclDataType(Y->DataType()), nccl_->Comm(), Stream(context)));
+  return Status::OK();
 }
 
 template <typename T>
@@ -114,10 +250,7 @@ Status DistributedMatMul<T>::ComputeInternal(OpKernelContext* context) const {
       auto tmp_tensor_shard_A = ReshardTensor(this, context, spec_A, tmp_spec_A, nccl_->Rank(), tensor_shard_A);
 
       auto tensor_shard_Y = context->Output(0, tensor_shard_shape_Y);
-      ORT_ENFORCE(onnxruntime::cuda::FuncMatMul<T>(
-                      this, context, tmp_tensor_shard_A.get(), tensor_shard_B, 1.0, false, false, false, false, tensor_shard_Y) == Status::OK());
-      ORT_ENFORCE(FuncAllReduce(
-                      nccl_->Comm(), Stream(context), tensor_shard_Y, tensor_shard_Y) == Status::OK());
+      ORT_RETURN_IF_ERROR(MatMulAllReduce(context, tmp_tensor_shard_A.get(), tensor_shard_B, tensor_shard_Y));
     } else {
       // Case 1-3
       ORT_THROW("Not supported yet.");
@@ -128,6 +261,7 @@ Status DistributedMatMul<T>::ComputeInternal(OpKernelContext* context) const {
   //  1. shard on -1: MatMul(RS, RR) -> MatMul(RS, SR) -> MatMul(RS, SR) + AllReduce -> RR
   //  2. shard on -2: MatMul(SR, RR) -> SR
   //  3. shard on other axis: : MatMul(SRR, RRR) -> MatMul(SRR, SRR) -> SRR
+  //  4. shard on -2: MatMul(SR, RR) -> MatMul(SR, RR) + AllGather -> RR
   if (spec_A.HasShard() && spec_B.HasNoShard()) {
     if (spec_A.OnlyShardAxis(-1) && spec_Y.HasNoShard()) {
       // Case 2-1
@@ -138,11 +272,7 @@ Status DistributedMatMul<T>::ComputeInternal(OpKernelContext* context) const {
       TensorPartitionSpec new_spec_B = CreateTensorShardSpec(spec_B.device_mesh, 0, -2, rank_B);
       auto tensor_reshard_B = ShardTensor(this, context, new_spec_B, nccl_->Rank(), tensor_shard_B);
 
-      ORT_ENFORCE(onnxruntime::cuda::FuncMatMul<T>(
-                      this, context, tensor_shard_A, tensor_reshard_B.get(), 1.0, false, false, false, false, tensor_shard_Y) == Status::OK());
-
-      ORT_ENFORCE(FuncAllReduce(
-                      nccl_->Comm(), Stream(context), tensor_shard_Y, tensor_shard_Y) == Status::OK());
+      ORT_RETURN_IF_ERROR(MatMulAllReduce(context, tensor_shard_A, tensor_reshard_B.get(), tensor_shard_Y));
       return Status::OK();
     } else if (spec_A.OnlyShardAxis(-2) && spec_Y.OnlyShardAxis(-2)) {
       // Case 2-2
@@ -150,6 +280,14 @@ Status DistributedMatMul<T>::ComputeInternal(OpKernelContext* context) const {
       ORT_ENFORCE(onnxruntime::cuda::FuncMatMul<T>(
                       this, context, tensor_shard_A, tensor_shard_B, 1.0, false, false, false, false, tensor_shard_Y) == Status::OK());
       return Status::OK();
+    } else if (spec_A.OnlyShardAxis(-2) && spec_Y.HasNoShard() && IsMatrix(tensor_shape_Y) &&
+               IsCommunicatorMesh(spec_A.device_mesh, nccl_->Size())) {
+      // Case 2-4
+      // MatMul(SR, RR) -> MatMul(SR, RR) + AllGather -> RR
+      auto tensor_shard_Y = context->Output(0, tensor_shard_shape_Y);
+      const auto shard_shape_Y = ComputeShardShape(tensor_shape_Y, -2, nccl_->Size());
+      ORT_RETURN_IF_ERROR(MatMulAllGather(context, tensor_shard_A, tensor_shard_B, shard_shape_Y, tensor_shard_Y));
+      return Status::OK();
     } else if (spec_A.GetPartitionAxis() < gsl::narrow<int64_t>(tensor_shape_A.NumDimensions()) - 2 && normalized_spec_A.GetPartitionAxis() == spec_Y.GetPartitionAxis()) {
       // Case 2-3
       if (normalized_shape_B[normalized_spec_A.GetPartitionAxis()] == 1) {
@@ -189,6 +327,8 @@ Status DistributedMatMul<T>::ComputeInternal(OpKernelContext* context) const {
   //  3. shard on (-2, -1): MatMul(SR, RS) -> MatMul(RS, SR) + AllReduce -> RR
   //  4. shard on (-2, -2): MatMul(SR, SR) -> MatMul(RS, SR) + AllReduce -> RR
   //  5. shard on other axes
+  //  6. shard on (-1, -2): MatMul(RS, SR) -> MatMul(RS, SR) + ReduceScatter -> SR
+  // The all-reduces are chunked along the rows of Y to overlap with the GEMM of the next chunk.
   if (spec_A.HasShard() && spec_B.HasShard()) {
     if (spec_A.OnlyShardAxis(-1) && spec_B.OnlyShardAxis(-1)) {
       // Case 3-1
@@ -197,10 +337,7 @@ Status DistributedMatMul<T>::ComputeInternal(OpKernelContext* context) const {
         auto tmp_spec_B = CreateTensorShardSpec(spec_B.device_mesh, 0, -2, rank_B);
         auto tmp_tensor_shard_B = ReshardTensor(this, context, spec_B, tmp_spec_B, nccl_->Rank(), tensor_shard_B);
         auto tensor_shard_Y = context->Output(0, tensor_shard_shape_Y);
-        ORT_ENFORCE(onnxruntime::cuda::FuncMatMul<T>(
-                        this, context, tensor_shard_A, tmp_tensor_shard_B.get(), 1.0, false, false, false, false, tensor_shard_Y) == Status::OK());
-        ORT_ENFORCE(FuncAllReduce(
-                        nccl_->Comm(), Stream(context), tensor_shard_Y, tensor_shard_Y) == Status::OK());
+        ORT_RETURN_IF_ERROR(MatMulAllReduce(context, tensor_shard_A, tmp_tensor_shard_B.get(), tensor_shard_Y));
       } else if (spec_Y.OnlyShardAxis(-1)) {
         // Cas 3-1-2
         auto tmp_spec_A = TensorPartitionSpec::CreateAllReplica(spec_A);
@@ -215,12 +352,15 @@ Status DistributedMatMul<T>::ComputeInternal(OpKernelContext* context) const {
       // Case 3-2
       auto tensor_shard_Y = context->Output(0, tensor_shard_shape_Y);
 
-      auto status = onnxruntime::cuda::FuncMatMul<T>(
-          this, context, tensor_shard_A, tensor_shard_B, 1.0, false, false, false, false, tensor_shard_Y);
+      auto status = MatMulAllReduce(context, tensor_shard_A, tensor_shard_B, tensor_shard_Y);
       ORT_ENFORCE(status == Status::OK(), status.ErrorMessage());
+    } else if (spec_A.OnlyShardAxis(-1) && spec_B.OnlyShardAxis(-2) && spec_Y.OnlyShardAxis(-2) &&
+               IsMatrix(tensor_shape_Y) && IsCommunicatorMesh(spec_Y.device_mesh, nccl_->Size())) {
+      // Case 3-6
+      // MatMul(RS, SR) -> MatMul(RS, SR) + ReduceScatter -> SR
+      auto tensor_shard_Y = context->Output(0, tensor_shard_shape_Y);
 
-      status = FuncAllReduce(
-          nccl_->Comm(), Stream(context), tensor_shard_Y, tensor_shard_Y);
+      auto status = MatMulReduceScatter(context, tensor_shard_A, tensor_shard_B, tensor_shape_Y, tensor_shard_Y);
       ORT_ENFORCE(status == Status::OK(), status.ErrorMessage());
     } else if (spec_A.OnlyShardAxis(-2) && spec_B.OnlyShardAxis(-1)) {
       // Case 3-3:
@@ -238,11 +378,8 @@ Status DistributedMatMul<T>::ComputeInternal(OpKernelContext* context) const {
       // Allocate Y[RR]
       auto tensor_shard_Y = context->Output(0, tensor_shard_shape_Y);
 
-      // Run local MatMul(A[RS], B[SR])
-      ORT_ENFORCE(onnxruntime::cuda::FuncMatMul<T>(
-                      this, context, tmp_tensor_shard_A.get(), tmp_tensor_shard_B.get(), 1.0, false, false, false, false, tensor_shard_Y) == Status::OK());
-      ORT_ENFORCE(FuncAllReduce(
-                      nccl_->Comm(), Stream(context), tensor_shard_Y, tensor_shard_Y) == Status::OK());
+      // Run local MatMul(A[RS], B[SR]) and AllReduce
+      ORT_RETURN_IF_ERROR(MatMulAllReduce(context, tmp_tensor_shard_A.get(), tmp_tensor_shard_B.get(), tensor_shard_Y));
     } else if (spec_A.OnlyShardAxis(-2) && spec_B.OnlyShardAxis(-2)) {
       // Case 3-4
       // MatMul(SR, SR) -> MatMul(RS, SR) + AllReduce -> RR
@@ -3,9 +3,11 @@
 #include "sharding.h"
 
 #include <algorithm>
+#include <mutex>
 #include <tuple>
 #include <optional>
 #include <string>
+#include <vector>
 #include <nccl.h>
 #include <sstream>
 
@@ -21,8 +23,33 @@ template <typename T>
 class DistributedMatMul final : public DistributedKernel {
  public:
   explicit DistributedMatMul(const OpKernelInfo& info);
+  ~DistributedMatMul();
 
   Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  // Computes Y = MatMul(A, B) and all-reduces Y. The rows of Y are computed in chunks, and the all-reduce of a chunk
+  // runs on the communication stream while the next chunk is computed.
+  Status MatMulAllReduce(OpKernelContext* context, const Tensor* A, const Tensor* B, Tensor* Y) const;
+
+  // Computes the partial sum MatMul(A, B), of shape partial_shape_Y, and reduce-scatters it along its rows into Y,
+  // the shard of this rank.
+  Status MatMulReduceScatter(OpKernelContext* context, const Tensor* A, const Tensor* B,
+                             const TensorShape& partial_shape_Y, Tensor* Y) const;
+
+  // Computes the rows of Y of this rank, MatMul(A, B) of shape shard_shape_Y with A sharded along its rows, and
+  // all-gathers them into Y.
+  Status MatMulAllGather(OpKernelContext* context, const Tensor* A, const Tensor* B,
+                         const TensorShape& shard_shape_Y, Tensor* Y) const;
+
+  Status InitializeCommStream() const;
+
+  int64_t overlap_chunks_;
+  // Created by the first run, on the device of the run.
+  mutable std::mutex comm_stream_mutex_;
+  mutable cudaStream_t comm_stream_ = nullptr;
+  mutable std::vector<cudaEvent_t> chunk_events_;
+  mutable cudaEvent_t comm_done_event_ = nullptr;
 };
 
 #endif
@@ -4,19 +4,21 @@
 #include "core/common/status.h"
 #include "core/providers/cuda/nn/conv.h"
 #include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/activation/activations_impl.h"
+#include "core/providers/cuda/math/clip_impl.h"
+#include "contrib_ops/cuda/fused_conv_graph.h"
 
 namespace onnxruntime {
 namespace contrib {
 namespace cuda {
 
-template <typename T>
-class FusedConv : public onnxruntime::cuda::Conv<T, false> {
+template <typename T, bool NHWC>
+class FusedConv : public onnxruntime::cuda::Conv<T, NHWC> {
  public:
-  using Base = onnxruntime::cuda::Conv<T, false>;
-  FusedConv(const OpKernelInfo& info) : onnxruntime::cuda::Conv<T, false>(info) {
-    std::string activation;
-    ORT_THROW_IF_ERROR(info.GetAttr<std::string>("activation", &activation));
-    ORT_THROW_IF_ERROR(MapMode(activation));
+  using Base = onnxruntime::cuda::Conv<T, NHWC>;
+  FusedConv(const OpKernelInfo& info) : onnxruntime::cuda::Conv<T, NHWC>(info) {
+    std::string activation = info.GetAttrOrDefault<std::string>("activation", "");
+    ORT_THROW_IF_ERROR(MapMode(activation, info.GetAttrsOrDefault<float>("activation_params")));
     CUDNN_CALL_THROW(cudnnCreateActivationDescriptor(&activation_desc_));
     CUDNN_CALL_THROW(cudnnSetActivationDescriptor(
         activation_desc_, activation_mode_, cudnnNanPropagation_t::CUDNN_NOT_PROPAGATE_NAN,
@@ -39,6 +41,62 @@ class FusedConv : public onnxruntime::cuda::Conv<T, false> {
     if (Base::s_.Y->Shape().Size() == 0) {
       return Status::OK();
     }
+
+    // Z has the shape and format of Y, but UpdateState describes it as NCHW.
+    const cudnnTensorDescriptor_t z_tensor = NHWC ? Base::s_.y_tensor : Base::s_.z_tensor;
+    if (NHWC && nullptr != Base::s_.z_data) {
+      ORT_RETURN_IF_NOT(context->Input<Tensor>(3)->Shape() == Base::s_.Y->Shape() && !Base::s_.post_slicing_required,
+                        "Z must have the shape of Y");
+    }
+
+    bool fused = false;
+    ORT_RETURN_IF_ERROR(ComputeWithGraph(context, cudnnHandle, z_tensor, fused));
+    if (!fused) {
+      ORT_RETURN_IF_ERROR(ComputeWithLegacyApi(context, cudnnHandle, z_tensor));
+    }
+
+    if (Base::s_.post_slicing_required) {
+      ORT_RETURN_IF_ERROR(onnxruntime::cuda::SliceOutUnwantedOutputSection(
+          this->Stream(context), Base::s_.y_data, Base::s_.y_dims_with_adjusted_pads, Base::s_.Y->MutableDataRaw(),
+          Base::s_.y_dims.GetDims(), Base::s_.slice_starts, Base::s_.slice_ends, Base::s_.slice_axes, Base::s_.element_size));
+    }
+    return Status::OK();
+  }
+
+ private:
+  // Runs the convolution and its epilogue as a single kernel of the cuDNN graph API if an engine supports them. The
+  // plans are built once for each shape of X and W.
+  Status ComputeWithGraph(OpKernelContext* context, cudnnHandle_t cudnnHandle, cudnnTensorDescriptor_t z_tensor,
+                          bool& fused) const {
+    bool has_z = nullptr != Base::s_.z_data;
+    bool has_b = nullptr != Base::s_.b_data;
+    TensorShapeVector key = Base::s_.last_x_dims.AsShapeVector();
+    const auto w_dims = Base::s_.last_w_dims.GetDims();
+    key.insert(key.end(), w_dims.begin(), w_dims.end());
+    if (!plans_.contains(key)) {
+      plans_.insert(key, CudnnFusedConvPlan::Create(cudnnHandle, Base::s_.x_tensor, Base::s_.w_desc,
+                                                    Base::s_.conv_desc, has_b ? Base::s_.b_tensor : nullptr,
+                                                    has_z ? z_tensor : nullptr, Base::s_.y_tensor, activation_));
+    }
+
+    const std::shared_ptr<CudnnFusedConvPlan>& plan = plans_.at(key);
+    if (plan == nullptr ||
+        !CudnnFusedConvPlan::IsAligned(Base::s_.x_data) || !CudnnFusedConvPlan::IsAligned(Base::s_.w_data) ||
+        !CudnnFusedConvPlan::IsAligned(Base::s_.b_data) || !CudnnFusedConvPlan::IsAligned(Base::s_.z_data) ||
+        !CudnnFusedConvPlan::IsAligned(Base::s_.y_data)) {
+      return Status::OK();
+    }
+
+    IAllocatorUniquePtr<void> workspace = this->template GetScratchBuffer<void>(plan->WorkspaceSize(),
+                                                                                context->GetComputeStream());
+    ORT_RETURN_IF_ERROR(plan->Execute(cudnnHandle, Base::s_.x_data, Base::s_.w_data, Base::s_.b_data,
+                                      Base::s_.z_data, Base::s_.y_data, workspace.get()));
+    fused = true;
+    return Status::OK();
+  }
+
+  Status ComputeWithLegacyApi(OpKernelContext* context, cudnnHandle_t cudnnHandle,
+                              cudnnTensorDescriptor_t z_tensor) const {
     bool has_z = nullptr != Base::s_.z_data;
     bool has_b = nullptr != Base::s_.b_data;
     typedef typename onnxruntime::cuda::ToCudaType<T>::MappedType CudaT;
@@ -56,7 +114,7 @@ class FusedConv : public onnxruntime::cuda::Conv<T, false> {
                                                               workspace.get(),
                                                               Base::s_.workspace_bytes,
                                                               has_z ? &alpha : &beta,
-                                                              has_z ? Base::s_.z_tensor : Base::s_.y_tensor,
+                                                              has_z ? z_tensor : Base::s_.y_tensor,
                                                               has_z ? Base::s_.z_data : Base::s_.y_data,
                                                               Base::s_.b_tensor,
                                                               has_b ? Base::s_.b_data : Base::s_.b_zero,
@@ -82,24 +140,54 @@ class FusedConv : public onnxruntime::cuda::Conv<T, false> {
                                              &alpha, Base::s_.y_tensor, Base::s_.y_data));
       }
       if (has_z) {
-        CUDNN_RETURN_IF_ERROR(cudnnAddTensor(cudnnHandle, &alpha, Base::s_.z_tensor, Base::s_.z_data,
+        CUDNN_RETURN_IF_ERROR(cudnnAddTensor(cudnnHandle, &alpha, z_tensor, Base::s_.z_data,
                                              &alpha, Base::s_.y_tensor, Base::s_.y_data));
       }
-      CUDNN_RETURN_IF_ERROR(cudnnActivationForward(cudnnHandle, activation_desc_, &alpha, Base::s_.y_tensor,
-                                                   Base::s_.y_data, &beta, Base::s_.y_tensor, Base::s_.y_data));
+      // cudnnActivationForward doesn't support the identity.
+      if (activation_mode_ != CUDNN_ACTIVATION_IDENTITY) {
+        CUDNN_RETURN_IF_ERROR(cudnnActivationForward(cudnnHandle, activation_desc_, &alpha, Base::s_.y_tensor,
+                                                     Base::s_.y_data, &beta, Base::s_.y_tensor, Base::s_.y_data));
+      }
     }
-    if (Base::s_.post_slicing_required) {
-      ORT_RETURN_IF_ERROR(onnxruntime::cuda::SliceOutUnwantedOutputSection(
-          this->Stream(context), Base::s_.y_data, Base::s_.y_dims_with_adjusted_pads, Base::s_.Y->MutableDataRaw(),
-          Base::s_.y_dims.GetDims(), Base::s_.slice_starts, Base::s_.slice_ends, Base::s_.slice_axes, Base::s_.element_size));
+
+    // cuDNN has no activation mode for these.
+    const size_t count = static_cast<size_t>(TensorShape(Base::s_.y_dims_with_adjusted_pads).Size());
+    if (activation_.kind == FusedConvActivation::Kind::LeakyRelu) {
+      onnxruntime::cuda::CtxLeakyRelu ctx{activation_.alpha};
+      onnxruntime::cuda::Impl_LeakyRelu<CudaT>(this->Stream(context), reinterpret_cast<const CudaT*>(Base::s_.y_data),
+                                               reinterpret_cast<CudaT*>(Base::s_.y_data), &ctx, count);
+    } else if (activation_.kind == FusedConvActivation::Kind::Clip) {
+      onnxruntime::cuda::ClipImpl<T>(this->Stream(context), reinterpret_cast<const T*>(Base::s_.y_data),
+                                     reinterpret_cast<T*>(Base::s_.y_data), nullptr, nullptr,
+                                     static_cast<T>(activation_.min), static_cast<T>(activation_.max), count);
     }
     return Status::OK();
   }
 
- private:
-  Status MapMode(const std::string& activaton_mode) {
-    if (activaton_mode == "Relu") {
+  Status MapMode(const std::string& activaton_mode, const std::vector<float>& activation_params) {
+    if (activaton_mode.empty()) {
+      activation_.kind = FusedConvActivation::Kind::None;
+      activation_mode_ = cudnnActivationMode_t::CUDNN_ACTIVATION_IDENTITY;
+    } else if (activaton_mode == "Relu") {
+      activation_.kind = FusedConvActivation::Kind::Relu;
       activation_mode_ = cudnnActivationMode_t::CUDNN_ACTIVATION_RELU;
+    } else if (activaton_mode == "Sigmoid") {
+      activation_.kind = FusedConvActivation::Kind::Sigmoid;
+      activation_mode_ = cudnnActivationMode_t::CUDNN_ACTIVATION_SIGMOID;
+    } else if (activaton_mode == "Tanh") {
+      activation_.kind = FusedConvActivation::Kind::Tanh;
+      activation_mode_ = cudnnActivationMode_t::CUDNN_ACTIVATION_TANH;
+    } else if (activaton_mode == "LeakyRelu") {
+      ORT_RETURN_IF_NOT(activation_params.size() == 1, "LeakyRelu activation expects alpha");
+      activation_.kind = FusedConvActivation::Kind::LeakyRelu;
+      activation_.alpha = activation_params[0];
+      activation_mode_ = cudnnActivationMode_t::CUDNN_ACTIVATION_IDENTITY;
+    } else if (activaton_mode == "Clip") {
+      ORT_RETURN_IF_NOT(activation_params.size() == 2, "Clip activation expects min and max");
+      activation_.kind = FusedConvActivation::Kind::Clip;
+      activation_.min = activation_params[0];
+      activation_.max = activation_params[1];
+      activation_mode_ = cudnnActivationMode_t::CUDNN_ACTIVATION_IDENTITY;
     } else {
       return ORT_MAKE_STATUS(
           StatusCategory::ONNXRUNTIME, StatusCode::INVALID_ARGUMENT,
@@ -107,18 +195,38 @@ class FusedConv : public onnxruntime::cuda::Conv<T, false> {
     }
     return Status::OK();
   }
+
+  FusedConvActivation activation_;
   cudnnActivationMode_t activation_mode_;
   cudnnActivationDescriptor_t activation_desc_ = nullptr;
+
+  // the plans of the graph API for each shape of X and W, or nullptr if cuDNN has no engine for the graph
+  constexpr static size_t kMaxCachedPlans = 64;
+  mutable onnxruntime::cuda::lru_unordered_map<TensorShapeVector, std::shared_ptr<CudnnFusedConvPlan>,
+                                               onnxruntime::cuda::tensor_shape_vector_hash>
+      plans_{kMaxCachedPlans};
 };
 
-ONNX_OPERATOR_TYPED_KERNEL_EX(
-    FusedConv,
-    kMSDomain,
-    1,
-    float,
-    kCudaExecutionProvider,
-    (*KernelDefBuilder::Create()).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
-    FusedConv<float>);
+#define REGISTER_KERNEL_TYPED(T)                                                            \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                            \
+      FusedConv,                                                                            \
+      kMSDomain,                                                                            \
+      1,                                                                                    \
+      T,                                                                                    \
+      kCudaExecutionProvider,                                                               \
+      (*KernelDefBuilder::Create()).TypeConstraint("T", DataTypeImpl::GetTensorType<T>()),  \
+      FusedConv<T, false>);                                                                 \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                            \
+      NhwcFusedConv,                                                                        \
+      kMSDomain,                                                                            \
+      1,                                                                                    \
+      T,                                                                                    \
+      kCudaExecutionProvider,                                                               \
+      (*KernelDefBuilder::Create()).TypeConstraint("T", DataTypeImpl::GetTensorType<T>()),  \
+      FusedConv<T, true>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
 
 }  // namespace cuda
 }  // namespace contrib
@@ -0,0 +1,412 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cuda/fused_conv_graph.h"
+
+#include <array>
+#include <cstdint>
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+#define RETURN_IF_CUDNN_FAILED(expr)       \
+  do {                                     \
+    const cudnnStatus_t _status = (expr);  \
+    if (_status != CUDNN_STATUS_SUCCESS) { \
+      return _status;                      \
+    }                                      \
+  } while (0)
+
+namespace {
+
+// The unique ids of the tensors of the graph. The variant pack binds the data pointers to the ones that aren't virtual.
+enum : int64_t {
+  kXId = 1,
+  kWId,
+  kBId,
+  kZId,
+  kYId,
+  kConvOutputId,
+  kBiasOutputId,
+  kZOutputId,
+};
+
+// ORT allocates tensors with a larger alignment, so this only excludes views into other buffers.
+constexpr int64_t kAlignment = 16;
+
+cudnnStatus_t CreateDescriptor(std::vector<cudnnBackendDescriptor_t>& descriptors, cudnnBackendDescriptorType_t type,
+                               cudnnBackendDescriptor_t& desc) {
+  RETURN_IF_CUDNN_FAILED(cudnnBackendCreateDescriptor(type, &desc));
+  descriptors.push_back(desc);
+  return CUDNN_STATUS_SUCCESS;
+}
+
+cudnnStatus_t CreateTensor(std::vector<cudnnBackendDescriptor_t>& descriptors, int64_t id, cudnnDataType_t data_type,
+                           const std::vector<int64_t>& dims, const std::vector<int64_t>& strides, bool is_virtual,
+                           cudnnBackendDescriptor_t& tensor) {
+  RETURN_IF_CUDNN_FAILED(CreateDescriptor(descriptors, CUDNN_BACKEND_TENSOR_DESCRIPTOR, tensor));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(tensor, CUDNN_ATTR_TENSOR_DATA_TYPE, CUDNN_TYPE_DATA_TYPE, 1,
+                                                  &data_type));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(tensor, CUDNN_ATTR_TENSOR_DIMENSIONS, CUDNN_TYPE_INT64,
+                                                  static_cast<int64_t>(dims.size()), dims.data()));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(tensor, CUDNN_ATTR_TENSOR_STRIDES, CUDNN_TYPE_INT64,
+                                                  static_cast<int64_t>(strides.size()), strides.data()));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(tensor, CUDNN_ATTR_TENSOR_UNIQUE_ID, CUDNN_TYPE_INT64, 1, &id));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(tensor, CUDNN_ATTR_TENSOR_BYTE_ALIGNMENT, CUDNN_TYPE_INT64, 1,
+                                                  &kAlignment));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(tensor, CUDNN_ATTR_TENSOR_IS_VIRTUAL, CUDNN_TYPE_BOOLEAN, 1,
+                                                  &is_virtual));
+  return cudnnBackendFinalize(tensor);
+}
+
+cudnnStatus_t GetTensorLayout(cudnnTensorDescriptor_t desc, cudnnDataType_t& data_type, std::vector<int64_t>& dims,
+                              std::vector<int64_t>& strides) {
+  std::array<int, CUDNN_DIM_MAX> dim_values;
+  std::array<int, CUDNN_DIM_MAX> stride_values;
+  int rank = 0;
+  RETURN_IF_CUDNN_FAILED(cudnnGetTensorNdDescriptor(desc, CUDNN_DIM_MAX, &data_type, &rank, dim_values.data(),
+                                                    stride_values.data()));
+  dims.assign(dim_values.begin(), dim_values.begin() + rank);
+  strides.assign(stride_values.begin(), stride_values.begin() + rank);
+  return CUDNN_STATUS_SUCCESS;
+}
+
+cudnnStatus_t GetFilterLayout(cudnnFilterDescriptor_t desc, cudnnDataType_t& data_type, std::vector<int64_t>& dims,
+                              std::vector<int64_t>& strides) {
+  std::array<int, CUDNN_DIM_MAX> dim_values;
+  cudnnTensorFormat_t format;
+  int rank = 0;
+  RETURN_IF_CUDNN_FAILED(cudnnGetFilterNdDescriptor(desc, CUDNN_DIM_MAX, &data_type, &format, &rank,
+                                                    dim_values.data()));
+  dims.assign(dim_values.begin(), dim_values.begin() + rank);
+
+  // The dimensions are (K, C, spatial dimensions) in both formats, the strides follow the order in memory.
+  strides.assign(rank, 1);
+  if (format == CUDNN_TENSOR_NHWC) {
+    int64_t stride = dims[1];
+    for (int i = rank - 1; i >= 2; --i) {
+      strides[i] = stride;
+      stride *= dims[i];
+    }
+    strides[0] = stride;
+  } else {
+    for (int i = rank - 2; i >= 0; --i) {
+      strides[i] = strides[i + 1] * dims[i + 1];
+    }
+  }
+
+  return CUDNN_STATUS_SUCCESS;
+}
+
+cudnnStatus_t CreatePointwiseOp(std::vector<cudnnBackendDescriptor_t>& descriptors, cudnnPointwiseMode_t mode,
+                                cudnnDataType_t math_precision, const FusedConvActivation* activation,
+                                cudnnBackendDescriptor_t x, cudnnBackendDescriptor_t b, cudnnBackendDescriptor_t y,
+                                cudnnBackendDescriptor_t& op) {
+  cudnnBackendDescriptor_t pointwise;
+  RETURN_IF_CUDNN_FAILED(CreateDescriptor(descriptors, CUDNN_BACKEND_POINTWISE_DESCRIPTOR, pointwise));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(pointwise, CUDNN_ATTR_POINTWISE_MODE, CUDNN_TYPE_POINTWISE_MODE, 1,
+                                                  &mode));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(pointwise, CUDNN_ATTR_POINTWISE_MATH_PREC, CUDNN_TYPE_DATA_TYPE, 1,
+                                                  &math_precision));
+
+  // LeakyRelu and Clip are a ReLU whose clips and slope below the lower clip are set.
+  if (activation != nullptr && activation->kind == FusedConvActivation::Kind::LeakyRelu) {
+    const double slope = activation->alpha;
+    RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(pointwise, CUDNN_ATTR_POINTWISE_RELU_LOWER_CLIP_SLOPE,
+                                                    CUDNN_TYPE_DOUBLE, 1, &slope));
+  } else if (activation != nullptr && activation->kind == FusedConvActivation::Kind::Clip) {
+    const double lower_clip = activation->min;
+    const double upper_clip = activation->max;
+    RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(pointwise, CUDNN_ATTR_POINTWISE_RELU_LOWER_CLIP,
+                                                    CUDNN_TYPE_DOUBLE, 1, &lower_clip));
+    RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(pointwise, CUDNN_ATTR_POINTWISE_RELU_UPPER_CLIP,
+                                                    CUDNN_TYPE_DOUBLE, 1, &upper_clip));
+  }
+  RETURN_IF_CUDNN_FAILED(cudnnBackendFinalize(pointwise));
+
+  RETURN_IF_CUDNN_FAILED(CreateDescriptor(descriptors, CUDNN_BACKEND_OPERATION_POINTWISE_DESCRIPTOR, op));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(op, CUDNN_ATTR_OPERATION_POINTWISE_PW_DESCRIPTOR,
+                                                  CUDNN_TYPE_BACKEND_DESCRIPTOR, 1, &pointwise));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(op, CUDNN_ATTR_OPERATION_POINTWISE_XDESC,
+                                                  CUDNN_TYPE_BACKEND_DESCRIPTOR, 1, &x));
+  if (b != nullptr) {
+    RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(op, CUDNN_ATTR_OPERATION_POINTWISE_BDESC,
+                                                    CUDNN_TYPE_BACKEND_DESCRIPTOR, 1, &b));
+  }
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(op, CUDNN_ATTR_OPERATION_POINTWISE_YDESC,
+                                                  CUDNN_TYPE_BACKEND_DESCRIPTOR, 1, &y));
+  return cudnnBackendFinalize(op);
+}
+
+cudnnPointwiseMode_t GetActivationMode(FusedConvActivation::Kind kind) {
+  switch (kind) {
+    case FusedConvActivation::Kind::Sigmoid:
+      return CUDNN_POINTWISE_SIGMOID_FWD;
+    case FusedConvActivation::Kind::Tanh:
+      return CUDNN_POINTWISE_TANH_FWD;
+    default:
+      return CUDNN_POINTWISE_RELU_FWD;
+  }
+}
+
+}  // namespace
+
+CudnnFusedConvPlan::~CudnnFusedConvPlan() {
+  for (auto it = descriptors_.rbegin(); it != descriptors_.rend(); ++it) {
+    cudnnBackendDestroyDescriptor(*it);
+  }
+}
+
+std::unique_ptr<CudnnFusedConvPlan> CudnnFusedConvPlan::Create(cudnnHandle_t handle,
+                                                               cudnnTensorDescriptor_t x,
+                                                               cudnnFilterDescriptor_t w,
+                                                               cudnnConvolutionDescriptor_t conv,
+                                                               cudnnTensorDescriptor_t b,
+                                                               cudnnTensorDescriptor_t z,
+                                                               cudnnTensorDescriptor_t y,
+                                                               const FusedConvActivation& activation) {
+  std::unique_ptr<CudnnFusedConvPlan> plan{new CudnnFusedConvPlan()};
+  const cudnnStatus_t status = plan->Build(handle, x, w, conv, b, z, y, activation);
+  if (status != CUDNN_STATUS_SUCCESS) {
+    LOGS_DEFAULT(VERBOSE) << "The cuDNN graph API has no engine for the fused convolution: "
+                          << cudnnGetErrorString(status);
+    return nullptr;
+  }
+
+  return plan;
+}
+
+cudnnStatus_t CudnnFusedConvPlan::Build(cudnnHandle_t handle,
+                                        cudnnTensorDescriptor_t x,
+                                        cudnnFilterDescriptor_t w,
+                                        cudnnConvolutionDescriptor_t conv,
+                                        cudnnTensorDescriptor_t b,
+                                        cudnnTensorDescriptor_t z,
+                                        cudnnTensorDescriptor_t y,
+                                        const FusedConvActivation& activation) {
+  has_bias_ = b != nullptr;
+  has_z_ = z != nullptr;
+
+  cudnnDataType_t data_type;
+  std::vector<int64_t> dims;
+  std::vector<int64_t> strides;
+  cudnnBackendDescriptor_t x_tensor;
+  cudnnBackendDescriptor_t w_tensor;
+  cudnnBackendDescriptor_t b_tensor = nullptr;
+  cudnnBackendDescriptor_t z_tensor = nullptr;
+  cudnnBackendDescriptor_t y_tensor;
+  RETURN_IF_CUDNN_FAILED(GetTensorLayout(x, data_type, dims, strides));
+  RETURN_IF_CUDNN_FAILED(CreateTensor(descriptors_, kXId, data_type, dims, strides, false, x_tensor));
+  RETURN_IF_CUDNN_FAILED(GetFilterLayout(w, data_type, dims, strides));
+  RETURN_IF_CUDNN_FAILED(CreateTensor(descriptors_, kWId, data_type, dims, strides, false, w_tensor));
+  if (has_bias_) {
+    RETURN_IF_CUDNN_FAILED(GetTensorLayout(b, data_type, dims, strides));
+    RETURN_IF_CUDNN_FAILED(CreateTensor(descriptors_, kBId, data_type, dims, strides, false, b_tensor));
+  }
+  if (has_z_) {
+    RETURN_IF_CUDNN_FAILED(GetTensorLayout(z, data_type, dims, strides));
+    RETURN_IF_CUDNN_FAILED(CreateTensor(descriptors_, kZId, data_type, dims, strides, false, z_tensor));
+  }
+  std::vector<int64_t> y_dims;
+  std::vector<int64_t> y_strides;
+  RETURN_IF_CUDNN_FAILED(GetTensorLayout(y, data_type, y_dims, y_strides));
+  RETURN_IF_CUDNN_FAILED(CreateTensor(descriptors_, kYId, data_type, y_dims, y_strides, false, y_tensor));
+
+  // The intermediate values of the graph are virtual tensors with the layout of y, which the last op writes.
+  const cudnnDataType_t compute_type = data_type == CUDNN_DATA_DOUBLE ? CUDNN_DATA_DOUBLE : CUDNN_DATA_FLOAT;
+  int num_epilogue_ops = (has_bias_ ? 1 : 0) + (has_z_ ? 1 : 0) +
+                         (activation.kind != FusedConvActivation::Kind::None ? 1 : 0);
+  auto get_output_tensor = [&](int64_t id, cudnnBackendDescriptor_t& tensor) {
+    if (num_epilogue_ops-- == 0) {
+      tensor = y_tensor;
+      return CUDNN_STATUS_SUCCESS;
+    }
+
+    return CreateTensor(descriptors_, id, compute_type, y_dims, y_strides, true, tensor);
+  };
+
+  std::array<int, CUDNN_DIM_MAX> pad_values;
+  std::array<int, CUDNN_DIM_MAX> stride_values;
+  std::array<int, CUDNN_DIM_MAX> dilation_values;
+  int spatial_rank = 0;
+  cudnnConvolutionMode_t mode;
+  cudnnDataType_t conv_compute_type;
+  RETURN_IF_CUDNN_FAILED(cudnnGetConvolutionNdDescriptor(conv, CUDNN_DIM_MAX - 2, &spatial_rank, pad_values.data(),
+                                                         stride_values.data(), dilation_values.data(), &mode,
+                                                         &conv_compute_type));
+  const int64_t spatial_dims = spatial_rank;
+  const std::vector<int64_t> pads(pad_values.begin(), pad_values.begin() + spatial_rank);
+  const std::vector<int64_t> conv_strides(stride_values.begin(), stride_values.begin() + spatial_rank);
+  const std::vector<int64_t> dilations(dilation_values.begin(), dilation_values.begin() + spatial_rank);
+
+  cudnnBackendDescriptor_t conv_desc;
+  RETURN_IF_CUDNN_FAILED(CreateDescriptor(descriptors_, CUDNN_BACKEND_CONVOLUTION_DESCRIPTOR, conv_desc));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(conv_desc, CUDNN_ATTR_CONVOLUTION_COMP_TYPE, CUDNN_TYPE_DATA_TYPE, 1,
+                                                  &conv_compute_type));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(conv_desc, CUDNN_ATTR_CONVOLUTION_CONV_MODE,
+                                                  CUDNN_TYPE_CONVOLUTION_MODE, 1, &mode));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(conv_desc, CUDNN_ATTR_CONVOLUTION_SPATIAL_DIMS, CUDNN_TYPE_INT64, 1,
+                                                  &spatial_dims));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(conv_desc, CUDNN_ATTR_CONVOLUTION_DILATIONS, CUDNN_TYPE_INT64,
+                                                  spatial_dims, dilations.data()));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(conv_desc, CUDNN_ATTR_CONVOLUTION_FILTER_STRIDES, CUDNN_TYPE_INT64,
+                                                  spatial_dims, conv_strides.data()));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(conv_desc, CUDNN_ATTR_CONVOLUTION_PRE_PADDINGS, CUDNN_TYPE_INT64,
+                                                  spatial_dims, pads.data()));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(conv_desc, CUDNN_ATTR_CONVOLUTION_POST_PADDINGS, CUDNN_TYPE_INT64,
+                                                  spatial_dims, pads.data()));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendFinalize(conv_desc));
+
+  std::vector<cudnnBackendDescriptor_t> ops;
+  cudnnBackendDescriptor_t conv_output;
+  cudnnBackendDescriptor_t conv_op;
+  RETURN_IF_CUDNN_FAILED(get_output_tensor(kConvOutputId, conv_output));
+  RETURN_IF_CUDNN_FAILED(CreateDescriptor(descriptors_, CUDNN_BACKEND_OPERATION_CONVOLUTION_FORWARD_DESCRIPTOR,
+                                          conv_op));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(conv_op, CUDNN_ATTR_OPERATION_CONVOLUTION_FORWARD_X,
+                                                  CUDNN_TYPE_BACKEND_DESCRIPTOR, 1, &x_tensor));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(conv_op, CUDNN_ATTR_OPERATION_CONVOLUTION_FORWARD_W,
+                                                  CUDNN_TYPE_BACKEND_DESCRIPTOR, 1, &w_tensor));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(conv_op, CUDNN_ATTR_OPERATION_CONVOLUTION_FORWARD_Y,
+                                                  CUDNN_TYPE_BACKEND_DESCRIPTOR, 1, &conv_output));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(conv_op, CUDNN_ATTR_OPERATION_CONVOLUTION_FORWARD_CONV_DESC,
+                                                  CUDNN_TYPE_BACKEND_DESCRIPTOR, 1, &conv_desc));
+  if (compute_type == CUDNN_DATA_DOUBLE) {
+    const double alpha = 1.0;
+    const double beta = 0.0;
+    RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(conv_op, CUDNN_ATTR_OPERATION_CONVOLUTION_FORWARD_ALPHA,
+                                                    CUDNN_TYPE_DOUBLE, 1, &alpha));
+    RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(conv_op, CUDNN_ATTR_OPERATION_CONVOLUTION_FORWARD_BETA,
+                                                    CUDNN_TYPE_DOUBLE, 1, &beta));
+  } else {
+    const float alpha = 1.0f;
+    const float beta = 0.0f;
+    RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(conv_op, CUDNN_ATTR_OPERATION_CONVOLUTION_FORWARD_ALPHA,
+                                                    CUDNN_TYPE_FLOAT, 1, &alpha));
+    RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(conv_op, CUDNN_ATTR_OPERATION_CONVOLUTION_FORWARD_BETA,
+                                                    CUDNN_TYPE_FLOAT, 1, &beta));
+  }
+  RETURN_IF_CUDNN_FAILED(cudnnBackendFinalize(conv_op));
+  ops.push_back(conv_op);
+
+  cudnnBackendDescriptor_t value = conv_output;
+  if (has_bias_) {
+    cudnnBackendDescriptor_t bias_output;
+    cudnnBackendDescriptor_t bias_op;
+    RETURN_IF_CUDNN_FAILED(get_output_tensor(kBiasOutputId, bias_output));
+    RETURN_IF_CUDNN_FAILED(CreatePointwiseOp(descriptors_, CUDNN_POINTWISE_ADD, compute_type, nullptr, value, b_tensor,
+                                             bias_output, bias_op));
+    ops.push_back(bias_op);
+    value = bias_output;
+  }
+
+  if (has_z_) {
+    cudnnBackendDescriptor_t z_output;
+    cudnnBackendDescriptor_t z_op;
+    RETURN_IF_CUDNN_FAILED(get_output_tensor(kZOutputId, z_output));
+    RETURN_IF_CUDNN_FAILED(CreatePointwiseOp(descriptors_, CUDNN_POINTWISE_ADD, compute_type, nullptr, value, z_tensor,
+                                             z_output, z_op));
+    ops.push_back(z_op);
+    value = z_output;
+  }
+
+  if (activation.kind != FusedConvActivation::Kind::None) {
+    cudnnBackendDescriptor_t activation_op;
+    RETURN_IF_CUDNN_FAILED(CreatePointwiseOp(descriptors_, GetActivationMode(activation.kind), compute_type,
+                                             &activation, value, nullptr, y_tensor, activation_op));
+    ops.push_back(activation_op);
+  }
+
+  cudnnBackendDescriptor_t op_graph;
+  RETURN_IF_CUDNN_FAILED(CreateDescriptor(descriptors_, CUDNN_BACKEND_OPERATIONGRAPH_DESCRIPTOR, op_graph));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(op_graph, CUDNN_ATTR_OPERATIONGRAPH_OPS,
+                                                  CUDNN_TYPE_BACKEND_DESCRIPTOR, static_cast<int64_t>(ops.size()),
+                                                  ops.data()));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(op_graph, CUDNN_ATTR_OPERATIONGRAPH_HANDLE, CUDNN_TYPE_HANDLE, 1,
+                                                  &handle));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendFinalize(op_graph));
+
+  cudnnBackendDescriptor_t heuristics;
+  const cudnnBackendHeurMode_t heuristics_mode = CUDNN_HEUR_MODE_INSTANT;
+  RETURN_IF_CUDNN_FAILED(CreateDescriptor(descriptors_, CUDNN_BACKEND_ENGINEHEUR_DESCRIPTOR, heuristics));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(heuristics, CUDNN_ATTR_ENGINEHEUR_OPERATION_GRAPH,
+                                                  CUDNN_TYPE_BACKEND_DESCRIPTOR, 1, &op_graph));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(heuristics, CUDNN_ATTR_ENGINEHEUR_MODE, CUDNN_TYPE_HEUR_MODE, 1,
+                                                  &heuristics_mode));
+  RETURN_IF_CUDNN_FAILED(cudnnBackendFinalize(heuristics));
+
+  int64_t engine_count = 0;
+  RETURN_IF_CUDNN_FAILED(cudnnBackendGetAttribute(heuristics, CUDNN_ATTR_ENGINEHEUR_RESULTS,
+                                                  CUDNN_TYPE_BACKEND_DESCRIPTOR, 0, &engine_count, nullptr));
+  std::vector<cudnnBackendDescriptor_t> engine_configs(static_cast<size_t>(engine_count));
+  for (auto& engine_config : engine_configs) {
+    RETURN_IF_CUDNN_FAILED(CreateDescriptor(descriptors_, CUDNN_BACKEND_ENGINECFG_DESCRIPTOR, engine_config));
+  }
+  RETURN_IF_CUDNN_FAILED(cudnnBackendGetAttribute(heuristics, CUDNN_ATTR_ENGINEHEUR_RESULTS,
+                                                  CUDNN_TYPE_BACKEND_DESCRIPTOR, engine_count, &engine_count,
+                                                  engine_configs.data()));
+
+  // Take the first engine in the order of the heuristics that builds a plan for the graph.
+  for (int64_t i = 0; i < engine_count; ++i) {
+    cudnnBackendDescriptor_t plan;
+    RETURN_IF_CUDNN_FAILED(CreateDescriptor(descriptors_, CUDNN_BACKEND_EXECUTION_PLAN_DESCRIPTOR, plan));
+    RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(plan, CUDNN_ATTR_EXECUTION_PLAN_HANDLE, CUDNN_TYPE_HANDLE, 1,
+                                                    &handle));
+    RETURN_IF_CUDNN_FAILED(cudnnBackendSetAttribute(plan, CUDNN_ATTR_EXECUTION_PLAN_ENGINE_CONFIG,
+                                                    CUDNN_TYPE_BACKEND_DESCRIPTOR, 1, &engine_configs[i]));
+    if (cudnnBackendFinalize(plan) == CUDNN_STATUS_SUCCESS) {
+      int64_t count = 0;
+      RETURN_IF_CUDNN_FAILED(cudnnBackendGetAttribute(plan, CUDNN_ATTR_EXECUTION_PLAN_WORKSPACE_SIZE,
+                                                      CUDNN_TYPE_INT64, 1, &count, &workspace_size_));
+      plan_ = plan;
+      return CUDNN_STATUS_SUCCESS;
+    }
+  }
+
+  return CUDNN_STATUS_NOT_SUPPORTED;
+}
+
+bool CudnnFusedConvPlan::IsAligned(const void* data) {
+  return reinterpret_cast<uintptr_t>(data) % kAlignment == 0;
+}
+
+Status CudnnFusedConvPlan::Execute(cudnnHandle_t handle, const void* x, const void* w, const void* b, const void* z,
+                                   void* y, void* workspace) const {
+  std::array<int64_t, 5> ids;
+  std::array<void*, 5> data;
+  int64_t count = 0;
+  auto bind = [&](int64_t id, const void* value) {
+    ids[count] = id;
+    data[count] = const_cast<void*>(value);
+    ++count;
+  };
+  bind(kXId, x);
+  bind(kWId, w);
+  if (has_bias_) {
+    bind(kBId, b);
+  }
+  if (has_z_) {
+    bind(kZId, z);
+  }
+  bind(kYId, y);
+
+  cudnnBackendDescriptor_t variant_pack = nullptr;
+  CUDNN_RETURN_IF_ERROR(cudnnBackendCreateDescriptor(CUDNN_BACKEND_VARIANT_PACK_DESCRIPTOR, &variant_pack));
+  auto destroy_variant_pack = gsl::finally([variant_pack]() { cudnnBackendDestroyDescriptor(variant_pack); });
+  CUDNN_RETURN_IF_ERROR(cudnnBackendSetAttribute(variant_pack, CUDNN_ATTR_VARIANT_PACK_UNIQUE_IDS, CUDNN_TYPE_INT64,
+                                                 count, ids.data()));
+  CUDNN_RETURN_IF_ERROR(cudnnBackendSetAttribute(variant_pack, CUDNN_ATTR_VARIANT_PACK_DATA_POINTERS,
+                                                 CUDNN_TYPE_VOID_PTR, count, data.data()));
+  CUDNN_RETURN_IF_ERROR(cudnnBackendSetAttribute(variant_pack, CUDNN_ATTR_VARIANT_PACK_WORKSPACE, CUDNN_TYPE_VOID_PTR,
+                                                 1, &workspace));
+  CUDNN_RETURN_IF_ERROR(cudnnBackendFinalize(variant_pack));
+  CUDNN_RETURN_IF_ERROR(cudnnBackendExecute(handle, plan_, variant_pack));
+  return Status::OK();
+}
+
+#undef RETURN_IF_CUDNN_FAILED
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/cudnn_common.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// The activation that FusedConv applies after the bias and Z are added.
+struct FusedConvActivation {
+  enum class Kind {
+    None,
+    Relu,
+    LeakyRelu,
+    Clip,
+    Sigmoid,
+    Tanh,
+  };
+
+  Kind kind = Kind::None;
+  float alpha = 0.0f;  // LeakyRelu
+  float min = 0.0f;    // Clip
+  float max = 0.0f;    // Clip
+};
+
+// An execution plan of the cuDNN graph API for a convolution followed by the addition of the bias, the addition of Z
+// and the activation. cuDNN fuses the whole graph into the epilogue of the convolution kernel, so each of them doesn't
+// need a launch and a pass over the output of its own like with cudnnConvolutionBiasActivationForward and its
+// fallback, which support a few activations and layouts only.
+class CudnnFusedConvPlan {
+ public:
+  ~CudnnFusedConvPlan();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CudnnFusedConvPlan);
+
+  // Builds the plan for the descriptors of the legacy API that the Conv kernel set. b and z may be nullptr. Returns
+  // nullptr if no engine of cuDNN supports the graph, e.g. for data types or GPUs without runtime fusion.
+  static std::unique_ptr<CudnnFusedConvPlan> Create(cudnnHandle_t handle,
+                                                    cudnnTensorDescriptor_t x,
+                                                    cudnnFilterDescriptor_t w,
+                                                    cudnnConvolutionDescriptor_t conv,
+                                                    cudnnTensorDescriptor_t b,
+                                                    cudnnTensorDescriptor_t z,
+                                                    cudnnTensorDescriptor_t y,
+                                                    const FusedConvActivation& activation);
+
+  size_t WorkspaceSize() const { return static_cast<size_t>(workspace_size_); }
+
+  // Whether data has the alignment that the plans are built for.
+  static bool IsAligned(const void* data);
+
+  Status Execute(cudnnHandle_t handle, const void* x, const void* w, const void* b, const void* z, void* y,
+                 void* workspace) const;
+
+ private:
+  CudnnFusedConvPlan() = default;
+
+  cudnnStatus_t Build(cudnnHandle_t handle,
+                      cudnnTensorDescriptor_t x,
+                      cudnnFilterDescriptor_t w,
+                      cudnnConvolutionDescriptor_t conv,
+                      cudnnTensorDescriptor_t b,
+                      cudnnTensorDescriptor_t z,
+                      cudnnTensorDescriptor_t y,
+                      const FusedConvActivation& activation);
+
+  // The descriptors the plan was built from, which live as long as the plan.
+  std::vector<cudnnBackendDescriptor_t> descriptors_;
+  cudnnBackendDescriptor_t plan_ = nullptr;
+  int64_t workspace_size_ = 0;
+  bool has_bias_ = false;
+  bool has_z_ = false;
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -57,13 +57,28 @@ int32_t GetTypeAndShape(const TValue* input,
                         TensorShape& shape,
                         bool swap = false) {
   shape = input->Shape();
-  ORT_ENFORCE(shape.NumDimensions() == 2);
+  ORT_ENFORCE(shape.NumDimensions() >= 2);
+  if (shape.NumDimensions() > 2) {
+    // The leading dimensions of A and Y are flattened into M.
+    const size_t rank = shape.NumDimensions();
+    shape = TensorShape({shape.SizeToDimension(rank - 1), shape[rank - 1]});
+  }
   if (swap) {
     std::swap(shape[0], shape[1]);
   }
   return input->GetElementType();
 }
 
+// The shape of Y keeps the leading dimensions of A when A has more than 2 dimensions.
+static TensorShape GetOutputShape(const TensorShape& shape_A, int M, int N) {
+  if (shape_A.NumDimensions() <= 2) {
+    return TensorShape({M, N});
+  }
+  TensorShapeVector dims = shape_A.AsShapeVector();
+  dims.back() = N;
+  return TensorShape(dims);
+}
+
 Status GemmFloat8::ComputeInternal(OpKernelContext* ctx) const {
   const Tensor* input_A = nullptr;
   const Tensor* input_B = nullptr;
@@ -96,6 +111,10 @@ Status GemmFloat8::ComputeInternal(OpKernelContext* ctx) const {
     }
   }
 
+  ORT_RETURN_IF_NOT(input_B->Shape().NumDimensions() == 2, "B must be a 2-D tensor.");
+  ORT_RETURN_IF_NOT(input_A->Shape().NumDimensions() == 2 || (input_A->Shape().NumDimensions() > 2 && !transA_),
+                    "A must be a 2-D tensor, or have more dimensions if transA is 0.");
+
   auto first_type = input_A->GetElementType();
 #if !defined(DISABLE_FLOAT8_TYPES)
   bool is_float8 = first_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E4M3FN || first_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E5M2;
@@ -122,8 +141,7 @@ Status GemmFloat8::ComputeRowMajor(
   int M, N, K, lda, ldb, ldd;
   SetParams(shape_A, shape_B, M, N, K, lda, ldb, ldd);
 
-  TensorShape dimensions{M, N};
-  Tensor* Y = ctx->Output(0, dimensions);
+  Tensor* Y = ctx->Output(0, GetOutputShape(input_A->Shape(), M, N));
   dtype_Y = GetTypeAndShape(Y, shape_Y);
   dtype_C = has_bias ? GetTypeAndShape(input_C, shape_C)
                      : ONNX_NAMESPACE::TensorProto_DataType_FLOAT;
@@ -153,8 +171,7 @@ Status GemmFloat8::ComputeColMajor(
   std::swap(shape_A[0], shape_A[1]);
   std::swap(shape_B[0], shape_B[1]);
 
-  TensorShape dimensions{M, N};
-  Tensor* Y = ctx->Output(0, dimensions);
+  Tensor* Y = ctx->Output(0, GetOutputShape(input_A->Shape(), M, N));
   dtype_Y = GetTypeAndShape(Y, shape_Y);
   dtype_C = has_bias ? GetTypeAndShape(input_C, shape_C, true)
                      : ONNX_NAMESPACE::TensorProto_DataType_FLOAT;
@@ -180,10 +197,9 @@ Status GemmFloat8::ComputeGemm(
     const void* p_scale_y, void* p_output_y, int M, int N, int K, int lda,
     int ldb, int ldd, bool row_major_compute) const {
   cudaStream_t stream = Stream(ctx);
-  CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream));
-
-  cublasLtHandle_t cublasLt;
-  CUBLAS_RETURN_IF_ERROR(cublasLtCreate(&cublasLt));
+  cublasLtHandle_t cublasLt = CublasLtHandle();
+  // The optional output amaxY receives the maximum absolute value of the result before it is scaled by scaleY.
+  Tensor* amax_Y = ctx->Output(1, TensorShape({}));
 
   cublasLtMatmulDesc_t operationDesc = nullptr;
   cublasLtMatrixLayout_t Adesc = nullptr, Bdesc = nullptr, Cdesc = nullptr,
@@ -196,6 +212,7 @@ Status GemmFloat8::ComputeGemm(
   cudaDataType_t scale_cuda_type =
       onnxruntime::cuda::ToCudaDataType(ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT);
   cudaDataType_t bias_cuda_type = onnxruntime::cuda::ToCudaDataType(dtype_C);
+  const void* bias = has_bias ? p_input_c : p_output_y;
 
   cublasComputeType_t compute_type;
   switch (d_cuda_type) {
@@ -280,13 +297,26 @@ Status GemmFloat8::ComputeGemm(
     CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(
         operationDesc, CUBLASLT_MATMUL_DESC_D_SCALE_POINTER, &p_scale_y,
         sizeof(p_scale_b)));
+    if (amax_Y != nullptr) {
+      void* p_amax_y = amax_Y->MutableDataRaw();
+      CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(
+          operationDesc, CUBLASLT_MATMUL_DESC_AMAX_D_POINTER, &p_amax_y,
+          sizeof(p_amax_y)));
+    }
+#else
+    ORT_RETURN_IF(amax_Y != nullptr, "CUDA >= 11.8 is required to compute amaxY.");
 #endif
 
     // float 8
 #if !defined(DISABLE_FLOAT8_TYPES)
     if (dtype_Y == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT8E4M3FN ||
         dtype_Y == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT8E5M2) {
-      // For FP8 output, cuBLAS requires C_type to be same as bias_type
+      // For FP8 output, cuBLAS requires C_type to be same as bias_type, and C to be float 16 or bfloat 16.
+      // C is not read without bias, as beta is 0.
+      if (!has_bias) {
+        bias_cuda_type = CUDA_R_16BF;
+        bias = nullptr;
+      }
       CUBLAS_RETURN_IF_ERROR(
           cublasLtMatrixLayoutCreate(&Cdesc, bias_cuda_type, M, N, ldd));
       CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(
@@ -301,6 +331,7 @@ Status GemmFloat8::ComputeGemm(
         cublasLtMatrixLayoutCreate(&Cdesc, d_cuda_type, M, N, ldd));
 #endif
   } else {
+    ORT_RETURN_IF(amax_Y != nullptr, "amaxY is only computed when A and B are float 8.");
     CUBLAS_RETURN_IF_ERROR(
         cublasLtMatrixLayoutCreate(&Cdesc, d_cuda_type, M, N, ldd));
   }
@@ -320,9 +351,7 @@ Status GemmFloat8::ComputeGemm(
 
   // See
   // https://docs.nvidia.com/cuda/cublas/index.html?highlight=cublasLtMatmulPreferenceAttributes_t#cublasltmatmulpreferenceattributes-t
-  // The workspace should be allocated once from OpKernelContext assuming
-  // only one cuda function is running at a time (which is not necessarily true
-  // with H100).
+  // The workspace comes from the allocator of the execution provider, ordered on the compute stream.
   size_t workspaceSize = static_cast<size_t>(1 << 25);  // suggested fixed value 32Mb
   cublasLtMatmulPreference_t preference = nullptr;
   cublasLtMatmulPreferenceCreate(&preference);
@@ -362,12 +391,8 @@ Status GemmFloat8::ComputeGemm(
       "index.html?highlight=cublasLtMatmulAlgoGetHeuristic#"
       "cublasltmatmulalgogetheuristic. CUDA>=11.8 is required to use float 8 types.");
 
-  void* workspace = nullptr;
-  if (workspaceSize > 0) {
-    CUDA_RETURN_IF_ERROR(cudaMalloc(reinterpret_cast<void**>(&workspace), workspaceSize));
-  }
+  auto workspace = GetScratchBuffer<void>(workspaceSize, ctx->GetComputeStream());
   // https://docs.nvidia.com/cuda/cublas/index.html?highlight=cublasLtMatmul#cublasltmatmul
-  const void* bias = has_bias ? p_input_c : p_output_y;
   cuda_status = cublasLtMatmul(
       cublasLt, operationDesc, static_cast<const void*>(&alpha_), /* alpha */
       p_input_a,                                                  /* A */
@@ -376,7 +401,7 @@ Status GemmFloat8::ComputeGemm(
       bias,                                                       /* C */
       Cdesc, p_output_y,                                          /* Y */
       Ddesc, &heuristicResult.algo,                               /* algo */
-      workspace,                                                  /* workspace */
+      workspace.get(),                                            /* workspace */
       workspaceSize, stream);                                     /* stream */
   ORT_ENFORCE(
       cuda_status == CUBLAS_STATUS_SUCCESS,
@@ -399,17 +424,12 @@ Status GemmFloat8::ComputeGemm(
       ", rowMajorCompute=", (row_major_compute ? 1 : 0),
       ". CUDA>=11.8 is required to use float 8 types.");
 
-  if (workspaceSize > 0) {
-    CUDA_RETURN_IF_ERROR(cudaFree(workspace));
-  }
-
   CUBLAS_RETURN_IF_ERROR(cublasLtMatmulPreferenceDestroy(preference));
   CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutDestroy(Ddesc));
   CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutDestroy(Cdesc));
   CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutDestroy(Bdesc));
   CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutDestroy(Adesc));
   CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescDestroy(operationDesc));
-  CUBLAS_RETURN_IF_ERROR(cublasLtDestroy(cublasLt));
   return Status::OK();
 }
 
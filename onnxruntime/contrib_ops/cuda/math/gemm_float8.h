@@ -11,7 +11,7 @@ namespace contrib {
 namespace cuda {
 
 // Calls https://docs.nvidia.com/cuda/cublas/index.html#cublasltmatmul.
-// D = alpha*(A*B)
+// D = scaleY*(alpha*scaleA*scaleB*(A*B) + beta*C), the optional output amaxY being max(abs(D)) before scaleY.
 class GemmFloat8 final : public onnxruntime::cuda::CudaKernel {
  public:
   GemmFloat8(const OpKernelInfo& info);
@@ -11,6 +11,7 @@
 #include "core/providers/cuda/cuda_kernel.h"
 #include "core/providers/cuda/shared_inc/fpgeneric.h"
 #include "core/providers/cpu/math/matmul_helper.h"
+#include "core/providers/cuda/tunable/cuda_tunable.h"
 #include "matmul_nbits.cuh"
 #include "dequantize_blockwise.cuh"
 
@@ -34,6 +35,11 @@ class MatMulNBits final : public CudaKernel {
 
   Status ComputeInternal(OpKernelContext* context) const override;
 
+  // Dequantizes B into a scratch buffer and multiplies with cuBLAS.
+  Status ComputeDequantizeGemm(OpKernelContext* ctx, const MatMulComputeHelper& helper, Tensor* Y) const;
+
+  int64_t BlockSize() const { return block_size_; }
+
  private:
   int64_t K_;
   int64_t N_;
@@ -42,6 +48,86 @@ class MatMulNBits final : public CudaKernel {
   bool column_wise_quant_blk_{true};
 };
 
+// The fp16 tensor core gemm is used up to this M, larger products are faster with cuBLAS on the dequantized weight.
+constexpr int kMaxGemmM = 4096;
+
+inline int DefaultGemmTileM(int m) {
+  return m <= 32 ? 32 : (m <= 128 ? 64 : 128);
+}
+
+template <typename T>
+struct MatMul4BitsParams : OpParams {
+  MatMul4BitsParams(const MatMulNBits<T>* kernel, OpKernelContext* ctx, const MatMulComputeHelper& helper, Tensor* Y)
+      : OpParams(kernel->GetTuningContext(), ctx->GetComputeStream()),
+        kernel_(kernel),
+        ctx_(ctx),
+        helper_(helper),
+        y_(Y),
+        m_(SafeInt<int>(helper.M())),
+        n_(SafeInt<int>(helper.N())),
+        k_(SafeInt<int>(helper.K())),
+        block_size_(SafeInt<int>(kernel->BlockSize())),
+        has_zero_points_(ctx->Input<Tensor>(3) != nullptr) {}
+
+  std::string Signature() const override {
+    return MakeString(m_, "_", n_, "_", k_, "_", block_size_, (has_zero_points_ ? "_zp" : ""));
+  }
+
+  const MatMulNBits<T>* kernel_;
+  OpKernelContext* ctx_;
+  const MatMulComputeHelper& helper_;
+  Tensor* y_;
+  int m_;
+  int n_;
+  int k_;
+  int block_size_;
+  bool has_zero_points_;
+};
+
+template <typename T>
+bool RunMatMul4BitsGemm(const MatMul4BitsParams<T>& params, int tile_m) {
+  typedef typename ToCudaType<T>::MappedType CudaT;
+  const Tensor* zero_points = params.ctx_->Input<Tensor>(3);
+  const auto& device_prop = params.kernel_->GetDeviceProp();
+  return TryMatMul4BitsGemm(
+      reinterpret_cast<CudaT*>(params.y_->MutableData<T>()),
+      reinterpret_cast<const CudaT*>(params.ctx_->Input<Tensor>(0)->Data<T>()),
+      params.ctx_->Input<Tensor>(1)->Data<uint8_t>(),
+      reinterpret_cast<const CudaT*>(params.ctx_->Input<Tensor>(2)->Data<T>()),
+      zero_points == nullptr ? nullptr : zero_points->Data<uint8_t>(),
+      params.m_,
+      params.n_,
+      params.k_,
+      params.block_size_,
+      tile_m,
+      device_prop.major * 10 + device_prop.minor,
+      params.StreamHandle());
+}
+
+template <typename T>
+Status DequantizeGemmOp(const MatMul4BitsParams<T>* params) {
+  return params->kernel_->ComputeDequantizeGemm(params->ctx_, params->helper_, params->y_);
+}
+
+template <typename T, int tile_m>
+Status MatMul4BitsGemmOp(const MatMul4BitsParams<T>* params) {
+  TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(tile_m > 32 && params->m_ <= tile_m / 4,
+                                            "tile_m ", tile_m, " is too large for M ", params->m_);
+  TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(!RunMatMul4BitsGemm(*params, tile_m), "unsupported arguments");
+  return Status::OK();
+}
+
+template <typename T>
+class MatMul4BitsTunableOp : public TunableOp<MatMul4BitsParams<T>> {
+ public:
+  MatMul4BitsTunableOp() {
+    this->RegisterOp(DequantizeGemmOp<T>);
+    this->RegisterOp(MatMul4BitsGemmOp<T, 32>);
+    this->RegisterOp(MatMul4BitsGemmOp<T, 64>);
+    this->RegisterOp(MatMul4BitsGemmOp<T, 128>);
+  }
+};
+
 template <typename T>
 Status MatMulNBits<T>::ComputeInternal(OpKernelContext* ctx) const {
   const Tensor* a = ctx->Input<Tensor>(0);
@@ -79,36 +165,73 @@ Status MatMulNBits<T>::ComputeInternal(OpKernelContext* ctx) const {
       SafeInt<int>(block_size_),
       SafeInt<int>(GetDeviceProp().sharedMemPerBlock),
       static_cast<cudaStream_t>(ctx->GetComputeStream()->GetHandle()));
-  if (!is_4bit_done) {
-    int64_t K_padded = (K_ + block_size_ - 1) / block_size_ * block_size_;
-    IAllocatorUniquePtr<T> b_data_ptr = GetScratchBuffer<T>(N_ * K_padded, ctx->GetComputeStream());
-    auto* b_data = b_data_ptr.get();
-    if (column_wise_quant_blk_) {
-      // column-wise block
-      ORT_RETURN_IF_ERROR(Dequantize4Bits(
-          reinterpret_cast<CudaT*>(b_data),
-          blob_data,
-          reinterpret_cast<const CudaT*>(scales_data),
-          zero_points_data,
-          SafeInt<int>(K_padded),
-          SafeInt<int>(N_),
-          SafeInt<int>(block_size_),
-          static_cast<cudaStream_t>(ctx->GetComputeStream()->GetHandle())));
-    } else {
-      // row-wise block
-      K_padded = K_;
-
-      ORT_RETURN_IF_ERROR(DequantizeBlockwise4b(
-          reinterpret_cast<CudaT*>(b_data),
-          blob_data,
-          reinterpret_cast<const CudaT*>(scales_data),
-          zero_points_data,
-          SafeInt<int>(block_size_),
-          column_wise_quant_blk_,
-          SafeInt<int>(K_),
-          SafeInt<int>(N_),
-          static_cast<cudaStream_t>(ctx->GetComputeStream()->GetHandle())));
+  if (is_4bit_done) {
+    return Status::OK();
+  }
+
+  if constexpr (std::is_same<T, MLFloat16>::value) {
+    if (helper.OutputOffsets().size() == 1) {
+      MatMul4BitsParams<T> params(this, ctx, helper, Y);
+      if (params.tuning_ctx->IsTunableOpEnabled()) {
+        static MatMul4BitsTunableOp<T> matmul_4bits{};
+        return matmul_4bits(&params);
+      }
+
+      if (params.m_ <= kMaxGemmM && RunMatMul4BitsGemm(params, DefaultGemmTileM(params.m_))) {
+        return Status::OK();
+      }
     }
+  }
+
+  return ComputeDequantizeGemm(ctx, helper, Y);
+}
+
+template <typename T>
+Status MatMulNBits<T>::ComputeDequantizeGemm(OpKernelContext* ctx, const MatMulComputeHelper& helper,
+                                             Tensor* Y) const {
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* b = ctx->Input<Tensor>(1);
+  const Tensor* scales = ctx->Input<Tensor>(2);
+  const Tensor* zero_points = ctx->Input<Tensor>(3);
+
+  const auto* a_data = a->Data<T>();
+  const uint8_t* blob_data = b->Data<uint8_t>();
+  const auto* scales_data = scales->Data<T>();
+  const auto* zero_points_data = zero_points == nullptr ? nullptr : zero_points->Data<uint8_t>();
+
+  typedef typename ToCudaType<T>::MappedType CudaT;
+
+  constexpr bool transa = false;
+
+  int64_t K_padded = (K_ + block_size_ - 1) / block_size_ * block_size_;
+  IAllocatorUniquePtr<T> b_data_ptr = GetScratchBuffer<T>(N_ * K_padded, ctx->GetComputeStream());
+  auto* b_data = b_data_ptr.get();
+  if (column_wise_quant_blk_) {
+    // column-wise block
+    ORT_RETURN_IF_ERROR(Dequantize4Bits(
+        reinterpret_cast<CudaT*>(b_data),
+        blob_data,
+        reinterpret_cast<const CudaT*>(scales_data),
+        zero_points_data,
+        SafeInt<int>(K_padded),
+        SafeInt<int>(N_),
+        SafeInt<int>(block_size_),
+        static_cast<cudaStream_t>(ctx->GetComputeStream()->GetHandle())));
+  } else {
+    // row-wise block
+    K_padded = K_;
+
+    ORT_RETURN_IF_ERROR(DequantizeBlockwise4b(
+        reinterpret_cast<CudaT*>(b_data),
+        blob_data,
+        reinterpret_cast<const CudaT*>(scales_data),
+        zero_points_data,
+        SafeInt<int>(block_size_),
+        column_wise_quant_blk_,
+        SafeInt<int>(K_),
+        SafeInt<int>(N_),
+        static_cast<cudaStream_t>(ctx->GetComputeStream()->GetHandle())));
+  }
 #if 0
   cudaStreamSynchronize(static_cast<cudaStream_t>(ctx->GetComputeStream()->GetHandle()));
   T* b_data_cpu = new T[K_ * N_];
@@ -116,27 +239,26 @@ Status MatMulNBits<T>::ComputeInternal(OpKernelContext* ctx) const {
   delete[] b_data_cpu;
 #endif
 
-    const CudaT alpha = ToCudaType<T>::FromFloat(1.f);
-    const CudaT zero = ToCudaType<T>::FromFloat(0.f);
+  const CudaT alpha = ToCudaType<T>::FromFloat(1.f);
+  const CudaT zero = ToCudaType<T>::FromFloat(0.f);
 
-    if (helper.OutputOffsets().size() == 1) {
-      CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
-          GetCublasHandle(ctx),
-          CUBLAS_OP_T,
-          CUBLAS_OP_N,
-          SafeInt<int>(helper.N()),
-          SafeInt<int>(helper.M()),
-          SafeInt<int>(helper.K()),
-          &alpha,
-          reinterpret_cast<const CudaT*>(b_data),
-          SafeInt<int>(K_padded),
-          reinterpret_cast<const CudaT*>(a_data),
-          helper.Lda(transa),
-          &zero,
-          reinterpret_cast<CudaT*>(Y->MutableData<T>()),
-          helper.Ldc(),
-          GetDeviceProp()));
-    }
+  if (helper.OutputOffsets().size() == 1) {
+    CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
+        GetCublasHandle(ctx),
+        CUBLAS_OP_T,
+        CUBLAS_OP_N,
+        SafeInt<int>(helper.N()),
+        SafeInt<int>(helper.M()),
+        SafeInt<int>(helper.K()),
+        &alpha,
+        reinterpret_cast<const CudaT*>(b_data),
+        SafeInt<int>(K_padded),
+        reinterpret_cast<const CudaT*>(a_data),
+        helper.Lda(transa),
+        &zero,
+        reinterpret_cast<CudaT*>(Y->MutableData<T>()),
+        helper.Ldc(),
+        GetDeviceProp()));
   }
 
   return Status::OK();
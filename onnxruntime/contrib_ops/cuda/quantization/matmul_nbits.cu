@@ -6,6 +6,7 @@
 #include <cublas_v2.h>
 #include <cuda_fp16.h>
 #include <math_constants.h>
+#include <mma.h>
 #include "core/providers/cuda/cu_inc/common.cuh"
 #include "core/providers/cuda/cuda_common.h"
 #include "matmul_nbits.cuh"
@@ -348,6 +349,245 @@ template bool TryMatMul4Bits<half>(
     int shared_mem_per_block,
     cudaStream_t stream);
 
+constexpr int kGemmTileN = 64;
+constexpr int kGemmTileK = 32;
+constexpr int kGemmWarpsM = 2;
+constexpr int kGemmWarpsN = 2;
+constexpr int kGemmThreads = kGemmWarpsM * kGemmWarpsN * kWarpSize;
+// a row of a tile in shared memory is padded by 8 halfs to avoid bank conflicts
+constexpr int kGemmTileLd = kGemmTileK + 8;
+
+// kernel for 4bits quantized gemm on fp16 tensor cores, i.e., computing A(M, K) x B(K, N) for M > 1
+// B(K, N) is quantized blockwise with 4bits and stored as [N, (K + block_size - 1)/block_size, blob]
+// The thread block size is kGemmThreads and grid size is (N/kGemmTileN, M/tile_m)
+// Each thread block computes a [tile_m, kGemmTileN] tile of the output. The [kGemmTileK, kGemmTileN] tiles of B are
+// dequantized into shared memory, so the fp16 weight is never written to global memory, and the next tiles of A and
+// B are loaded into registers while the current ones are multiplied.
+template <int tile_m, bool has_zero_point>
+__global__ void __launch_bounds__(kGemmThreads) MatMulFloatInt4GemmKernel(
+    half* output,
+    const half* a_data,
+    const uint8_t* b_data_quant,
+    const half* scales_data,
+    const uint8_t* zero_points,
+    int m,
+    int n,
+    int k,
+    int blocks_per_K,
+    int block_size) {
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 700
+  using namespace nvcuda;
+
+  constexpr int kFragsM = tile_m / kGemmWarpsM / 16;
+  constexpr int kFragsN = kGemmTileN / kGemmWarpsN / 16;
+  // each thread loads 8 elements of A and 8 elements of B at a time
+  constexpr int kALoads = tile_m * kGemmTileK / 8 / kGemmThreads;
+  constexpr int kBLoads = kGemmTileN * kGemmTileK / 8 / kGemmThreads;
+  constexpr int kLoadsPerRow = kGemmTileK / 8;
+  constexpr int kABytes = tile_m * kGemmTileLd * sizeof(half);
+  constexpr int kBBytes = kGemmTileN * kGemmTileLd * sizeof(half);
+  constexpr int kCBytes = tile_m * kGemmTileN * sizeof(float);
+  constexpr int kSharedBytes = kABytes + kBBytes > kCBytes ? kABytes + kBBytes : kCBytes;
+
+  // the tiles of A and B, reused for the output tile once the products are done
+  __shared__ __align__(32) char shared_buffer[kSharedBytes];
+  half* a_tile = reinterpret_cast<half*>(shared_buffer);
+  half* b_tile = reinterpret_cast<half*>(shared_buffer + kABytes);  // [kGemmTileN, kGemmTileLd], i.e. column major
+  float* c_tile = reinterpret_cast<float*>(shared_buffer);
+
+  const int m_start = blockIdx.y * tile_m;
+  const int n_start = blockIdx.x * kGemmTileN;
+  const int warp_id = threadIdx.x / kWarpSize;
+  const int warp_m = warp_id / kGemmWarpsN;
+  const int warp_n = warp_id % kGemmWarpsN;
+  const int b_row_bytes = blocks_per_K * block_size / 2;
+  const int b_zp_k = (blocks_per_K + 1) / 2;
+
+  uint4 a_regs[kALoads];
+  uint4 b_regs[kBLoads];
+
+  auto load_tiles = [&](int k_start) {
+#pragma unroll
+    for (int i = 0; i < kALoads; i++) {
+      const int idx = threadIdx.x + i * kGemmThreads;
+      const int row = m_start + idx / kLoadsPerRow;
+      const int col = k_start + idx % kLoadsPerRow * 8;
+      a_regs[i] = (row < m && col < k) ? *(reinterpret_cast<const uint4*>(a_data + row * k + col))
+                                       : make_uint4(0, 0, 0, 0);
+    }
+#pragma unroll
+    for (int i = 0; i < kBLoads; i++) {
+      const int idx = threadIdx.x + i * kGemmThreads;
+      const int col = n_start + idx / kLoadsPerRow;
+      const int row = k_start + idx % kLoadsPerRow * 8;
+      if (col < n && row < k) {
+        // the 8 elements are in the same quantization block
+        const uint32_t value = *(reinterpret_cast<const uint32_t*>(b_data_quant + col * b_row_bytes + row / 2));
+        const int block_id = row / block_size;
+        const float scale = __half2float(scales_data[col * blocks_per_K + block_id]);
+        float zp = 8.f;
+        if constexpr (has_zero_point) {
+          zp = static_cast<float>((zero_points[col * b_zp_k + block_id / 2] >> ((block_id & 1) * 4)) & 0x0f);
+        }
+        half2* dequantized = reinterpret_cast<half2*>(&b_regs[i]);
+#pragma unroll
+        for (int j = 0; j < 4; j++) {
+          dequantized[j] = __floats2half2_rn((static_cast<float>((value >> (8 * j)) & 0x0f) - zp) * scale,
+                                             (static_cast<float>((value >> (8 * j + 4)) & 0x0f) - zp) * scale);
+        }
+      } else {
+        b_regs[i] = make_uint4(0, 0, 0, 0);
+      }
+    }
+  };
+
+  wmma::fragment<wmma::accumulator, 16, 16, 16, float> acc[kFragsM][kFragsN];
+#pragma unroll
+  for (int i = 0; i < kFragsM; i++) {
+#pragma unroll
+    for (int j = 0; j < kFragsN; j++) {
+      wmma::fill_fragment(acc[i][j], 0.f);
+    }
+  }
+
+  load_tiles(0);
+  for (int k_start = 0; k_start < k; k_start += kGemmTileK) {
+#pragma unroll
+    for (int i = 0; i < kALoads; i++) {
+      const int idx = threadIdx.x + i * kGemmThreads;
+      *(reinterpret_cast<uint4*>(a_tile + idx / kLoadsPerRow * kGemmTileLd + idx % kLoadsPerRow * 8)) = a_regs[i];
+    }
+#pragma unroll
+    for (int i = 0; i < kBLoads; i++) {
+      const int idx = threadIdx.x + i * kGemmThreads;
+      *(reinterpret_cast<uint4*>(b_tile + idx / kLoadsPerRow * kGemmTileLd + idx % kLoadsPerRow * 8)) = b_regs[i];
+    }
+    __syncthreads();
+
+    if (k_start + kGemmTileK < k) {
+      load_tiles(k_start + kGemmTileK);
+    }
+
+#pragma unroll
+    for (int kk = 0; kk < kGemmTileK; kk += 16) {
+      wmma::fragment<wmma::matrix_a, 16, 16, 16, half, wmma::row_major> a_frags[kFragsM];
+      wmma::fragment<wmma::matrix_b, 16, 16, 16, half, wmma::col_major> b_frags[kFragsN];
+#pragma unroll
+      for (int i = 0; i < kFragsM; i++) {
+        wmma::load_matrix_sync(a_frags[i], a_tile + ((warp_m * kFragsM + i) * 16) * kGemmTileLd + kk, kGemmTileLd);
+      }
+#pragma unroll
+      for (int j = 0; j < kFragsN; j++) {
+        wmma::load_matrix_sync(b_frags[j], b_tile + ((warp_n * kFragsN + j) * 16) * kGemmTileLd + kk, kGemmTileLd);
+      }
+#pragma unroll
+      for (int i = 0; i < kFragsM; i++) {
+#pragma unroll
+        for (int j = 0; j < kFragsN; j++) {
+          wmma::mma_sync(acc[i][j], a_frags[i], b_frags[j], acc[i][j]);
+        }
+      }
+    }
+    __syncthreads();
+  }
+
+#pragma unroll
+  for (int i = 0; i < kFragsM; i++) {
+#pragma unroll
+    for (int j = 0; j < kFragsN; j++) {
+      wmma::store_matrix_sync(c_tile + ((warp_m * kFragsM + i) * 16) * kGemmTileN + (warp_n * kFragsN + j) * 16,
+                              acc[i][j], kGemmTileN, wmma::mem_row_major);
+    }
+  }
+  __syncthreads();
+
+  for (int idx = threadIdx.x; idx < tile_m * kGemmTileN; idx += kGemmThreads) {
+    const int row = m_start + idx / kGemmTileN;
+    const int col = n_start + idx % kGemmTileN;
+    if (row < m && col < n) {
+      output[row * n + col] = __float2half(c_tile[idx]);
+    }
+  }
+#endif
+}
+
+template <class T>
+bool TryMatMul4BitsGemm(
+    T* output,
+    const T* a_data,
+    const uint8_t* b_data_quant,
+    const T* scales_data,
+    const uint8_t* zero_points,
+    int m,
+    int n,
+    int k,
+    int block_size,
+    int tile_m,
+    int sm,
+    cudaStream_t stream) {
+  if constexpr (!std::is_same<T, half>::value) {
+    return false;
+  } else {
+    if (sm < 70 || k % 8 != 0 || block_size < 16 || block_size % 8 != 0) {
+      return false;
+    }
+    dim3 blocks((n + kGemmTileN - 1) / kGemmTileN, (m + tile_m - 1) / tile_m);
+    dim3 threads(kGemmThreads);
+    int blocks_per_K = (k + block_size - 1) / block_size;
+
+#define MatMulFloatInt4GemmKernelDispatch(tile_m)                                                              \
+  if (nullptr != zero_points) {                                                                                \
+    MatMulFloatInt4GemmKernel<tile_m, true><<<blocks, threads, 0, stream>>>(                                   \
+        output, a_data, b_data_quant, scales_data, zero_points, m, n, k, blocks_per_K, block_size);            \
+  } else {                                                                                                     \
+    MatMulFloatInt4GemmKernel<tile_m, false><<<blocks, threads, 0, stream>>>(                                  \
+        output, a_data, b_data_quant, scales_data, zero_points, m, n, k, blocks_per_K, block_size);            \
+  }
+
+    if (32 == tile_m) {
+      MatMulFloatInt4GemmKernelDispatch(32);
+    } else if (64 == tile_m) {
+      MatMulFloatInt4GemmKernelDispatch(64);
+    } else if (128 == tile_m) {
+      MatMulFloatInt4GemmKernelDispatch(128);
+    } else {
+      return false;
+    }
+
+#undef MatMulFloatInt4GemmKernelDispatch
+
+    return true;
+  }
+}
+
+template bool TryMatMul4BitsGemm<float>(
+    float* output,
+    const float* a_data,
+    const uint8_t* b_data_quant,
+    const float* scales_data,
+    const uint8_t* zero_points,
+    int m,
+    int n,
+    int k,
+    int block_size,
+    int tile_m,
+    int sm,
+    cudaStream_t stream);
+
+template bool TryMatMul4BitsGemm<half>(
+    half* output,
+    const half* a_data,
+    const uint8_t* b_data_quant,
+    const half* scales_data,
+    const uint8_t* zero_points,
+    int m,
+    int n,
+    int k,
+    int block_size,
+    int tile_m,
+    int sm,
+    cudaStream_t stream);
+
 }  // namespace cuda
 }  // namespace contrib
 }  // namespace onnxruntime
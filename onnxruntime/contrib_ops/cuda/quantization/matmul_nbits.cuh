@@ -22,6 +22,23 @@ bool TryMatMul4Bits(
     int shared_mem_per_block,
     cudaStream_t stream);
 
+// Computes the product for M > 1 on fp16 tensor cores, dequantizing B in shared memory. tile_m is the number of rows
+// of the output each thread block computes: 32, 64 or 128. Returns false if the arguments are not supported.
+template <class T>
+bool TryMatMul4BitsGemm(
+    T* output,
+    const T* a_data,
+    const uint8_t* b_data_quant,
+    const T* scales_data,
+    const uint8_t* zero_points,
+    int m,
+    int n,
+    int k,
+    int block_size,
+    int tile_m,
+    int sm,
+    cudaStream_t stream);
+
 }  // namespace cuda
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -143,23 +143,27 @@ Status Sample(AllocatorPtr& allocator,
 #endif
 
   // Multinomial sampling
+  // The random numbers of all steps are copied to the device in the first step.
   gsl::span<float>& d_sampled = sampling_state->d_sampled;
   gsl::span<float>& h_sampled_all = sampling_state->h_sampled_all;
+  if (step == 1) {
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(d_sampled.data(),
+                                         h_sampled_all.data(),
+                                         h_sampled_all.size_bytes(),
+                                         cudaMemcpyHostToDevice,
+                                         cuda_stream));
+  }
   size_t sample_offset = (static_cast<size_t>(step) - 1) * static_cast<size_t>(parameters->batch_size);
-  CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(d_sampled.data(),
-                                       h_sampled_all.data() + sample_offset,
-                                       sizeof(float) * parameters->batch_size,
-                                       cudaMemcpyHostToDevice,
-                                       cuda_stream));
+  float* step_sampled = d_sampled.data() + sample_offset;
 
 #ifdef DEBUG_GENERATION
-  dumper->Print("d_sampled", d_sampled.data(), parameters->batch_size, 1);
+  dumper->Print("d_sampled", step_sampled, parameters->batch_size, 1);
 #endif
 
   gsl::span<int32_t>& d_indices = sampling_state->d_indices;
   gsl::span<int>& presence_mask = sampling_state->d_presence_mask;
   cuda::TorchMultinomialKernelLauncher(d_softmaxed_score.data(),
-                                       d_sampled.data(),
+                                       step_sampled,
                                        d_indices.data(),
                                        parameters->batch_size,
                                        parameters->vocab_size,
@@ -176,11 +180,14 @@ Status Sample(AllocatorPtr& allocator,
                                        cudaMemcpyDeviceToHost,
                                        cuda_stream));
 
+#ifdef DEBUG_GENERATION
+  // The filtered scores are only used for the filtered_logits output of the debug build.
   CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(sampling_state->h_softmaxed_score.data(),
                                        sampling_state->d_softmaxed_score.data(),
                                        sampling_state->h_softmaxed_score.size_bytes(),
                                        cudaMemcpyDeviceToHost,
                                        cuda_stream));
+#endif
 
   CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(cuda_stream));
 
@@ -7,13 +7,15 @@ namespace onnxruntime {
 namespace contrib {
 namespace js {
 
+using onnxruntime::js::JsepSupportedFloatTypes;
+
 ONNX_OPERATOR_KERNEL_EX(
     Gelu,
     kMSDomain,
     1,
     kJsExecutionProvider,
     (*KernelDefBuilder::Create())
-        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+        .TypeConstraint("T", JsepSupportedFloatTypes()),
     Gelu);
 
 }  // namespace js
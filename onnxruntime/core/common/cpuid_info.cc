@@ -22,6 +22,10 @@
 #define HWCAP_ASIMDDP (1 << 20)
 #endif
 
+#ifndef HWCAP_SVE
+#define HWCAP_SVE (1 << 22)
+#endif
+
 #ifndef HWCAP2_I8MM
 #define HWCAP2_I8MM (1 << 13)
 #endif
@@ -147,6 +151,7 @@ void CPUIDInfo::ArmLinuxInit() {
   has_arm_neon_dot_ = cpuinfo_has_arm_neon_dot();
   has_fp16_ = cpuinfo_has_arm_neon_fp16_arith();
   has_arm_neon_i8mm_ = cpuinfo_has_arm_i8mm();
+  has_arm_sve_ = cpuinfo_has_arm_sve();
   has_arm_sve_i8mm_ = cpuinfo_has_arm_sve() && cpuinfo_has_arm_i8mm();
 
   const uint32_t core_cnt = cpuinfo_get_cores_count();
@@ -175,6 +180,7 @@ void CPUIDInfo::ArmLinuxInit() {
   has_fp16_ |= has_arm_neon_dot_;
 
   has_arm_neon_i8mm_ = ((getauxval(AT_HWCAP2) & HWCAP2_I8MM) != 0);
+  has_arm_sve_ = ((getauxval(AT_HWCAP) & HWCAP_SVE) != 0);
   has_arm_sve_i8mm_ = ((getauxval(AT_HWCAP2) & HWCAP2_SVEI8MM) != 0);
 
 #endif
@@ -277,6 +283,7 @@ void CPUIDInfo::ArmWindowsInit() {
   has_fp16_ |= has_arm_neon_dot_;
   /* TODO: implement them when hw+sw is available for testing these features */
   has_arm_neon_i8mm_ = false;
+  has_arm_sve_ = false;
   has_arm_sve_i8mm_ = false;
 }
 
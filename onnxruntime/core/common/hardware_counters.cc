@@ -0,0 +1,237 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/hardware_counters.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <sstream>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "core/common/string_utils.h"
+
+namespace onnxruntime {
+namespace profiling {
+
+namespace {
+
+std::atomic<uint64_t> next_instance_id{1};
+
+struct ThreadCache {
+  uint64_t instance_id = 0;
+  const std::vector<int>* counters = nullptr;
+};
+
+// the counters of the instance the calling thread read last, so that a thread running the kernels of one session
+// doesn't take the lock
+thread_local ThreadCache thread_cache;
+
+#if defined(__linux__)
+// the value followed by PERF_FORMAT_TOTAL_TIME_ENABLED and PERF_FORMAT_TOTAL_TIME_RUNNING
+struct CounterValue {
+  uint64_t value;
+  uint64_t time_enabled;
+  uint64_t time_running;
+};
+
+void SetEventConfig(HardwareCounters::Counter counter, perf_event_attr& attr) {
+  auto cache_miss = [](uint64_t cache) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  };
+  attr.type = PERF_TYPE_HARDWARE;
+  switch (counter) {
+    case HardwareCounters::kCycles:
+      attr.config = PERF_COUNT_HW_CPU_CYCLES;
+      break;
+    case HardwareCounters::kInstructions:
+      attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+      break;
+    case HardwareCounters::kLlcMisses:
+      attr.config = PERF_COUNT_HW_CACHE_MISSES;
+      break;
+    case HardwareCounters::kLlcLoadMisses:
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = cache_miss(PERF_COUNT_HW_CACHE_LL);
+      break;
+    case HardwareCounters::kL1dLoadMisses:
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = cache_miss(PERF_COUNT_HW_CACHE_L1D);
+      break;
+    case HardwareCounters::kDtlbLoadMisses:
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = cache_miss(PERF_COUNT_HW_CACHE_DTLB);
+      break;
+    case HardwareCounters::kBranchMisses:
+    default:
+      attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+      break;
+  }
+}
+
+// Opens counter for the calling thread, returning -1 and setting error if it fails.
+int OpenCounter(HardwareCounters::Counter counter, std::string* error) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  SetEventConfig(counter, attr);
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  // the user space only, which the default perf_event_paranoid allows
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+
+  const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0 /* calling thread */, -1 /* any cpu */,
+                                          -1 /* no group */, 0UL));
+  if (fd < 0 && error != nullptr) {
+    *error = std::strerror(errno);
+  }
+  return fd;
+}
+#endif
+
+}  // namespace
+
+Status HardwareCounters::Create(const std::string& names, std::unique_ptr<HardwareCounters>& counters,
+                                std::string& warnings) {
+  std::vector<Counter> requested;
+  if (names == "1") {
+    requested = {kCycles, kInstructions, kLlcMisses, kBranchMisses};
+  } else {
+    for (const auto& name : utils::SplitString(names, ",")) {
+      auto it = std::find(kNames.begin(), kNames.end(), name);
+      if (it == kNames.end()) {
+        std::ostringstream known;
+        for (const char* known_name : kNames) {
+          known << (known.tellp() > 0 ? ", " : "") << known_name;
+        }
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unknown hardware counter '", name,
+                               "'. Known counters: ", known.str(), ".");
+      }
+      const auto counter = static_cast<Counter>(it - kNames.begin());
+      if (std::find(requested.begin(), requested.end(), counter) == requested.end()) {
+        requested.push_back(counter);
+      }
+    }
+  }
+  if (requested.empty()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "No hardware counter given.");
+  }
+
+#if defined(__linux__)
+  // the counters the CPU or the OS doesn't provide fail the same way on every thread
+  std::vector<Counter> available;
+  std::ostringstream unavailable;
+  for (Counter counter : requested) {
+    std::string error;
+    const int fd = OpenCounter(counter, &error);
+    if (fd < 0) {
+      unavailable << (unavailable.tellp() > 0 ? ", " : "") << kNames[counter] << " (" << error << ")";
+      continue;
+    }
+    close(fd);
+    available.push_back(counter);
+  }
+  ORT_RETURN_IF(available.empty(), "None of the hardware counters can be opened: ", unavailable.str(),
+                ". Check /proc/sys/kernel/perf_event_paranoid.");
+  warnings = unavailable.tellp() > 0 ? "Hardware counters not available: " + unavailable.str() : std::string();
+  counters.reset(new HardwareCounters(std::move(available)));
+  return Status::OK();
+#else
+  ORT_UNUSED_PARAMETER(counters);
+  ORT_UNUSED_PARAMETER(warnings);
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Hardware counters are only supported on Linux.");
+#endif
+}
+
+HardwareCounters::HardwareCounters(std::vector<Counter> counters)
+    : counters_(std::move(counters)), instance_id_(next_instance_id++) {
+}
+
+HardwareCounters::~HardwareCounters() {
+#if defined(__linux__)
+  for (const auto& [thread_id, fds] : threads_) {
+    for (int fd : fds) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+  }
+#endif
+}
+
+HardwareCounters::ThreadCounters HardwareCounters::Open() const {
+  ThreadCounters fds;
+#if defined(__linux__)
+  for (Counter counter : counters_) {
+    fds.push_back(OpenCounter(counter, nullptr));
+  }
+#endif
+  return fds;
+}
+
+const HardwareCounters::ThreadCounters& HardwareCounters::GetThreadCounters() const {
+  if (thread_cache.instance_id == instance_id_) {
+    return *thread_cache.counters;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = threads_.find(std::this_thread::get_id());
+  if (it == threads_.end()) {
+    it = threads_.emplace(std::this_thread::get_id(), Open()).first;
+  }
+  thread_cache = {instance_id_, &it->second};
+  return it->second;
+}
+
+bool HardwareCounters::Read(Sample& sample) const {
+#if defined(__linux__)
+  const ThreadCounters& fds = GetThreadCounters();
+  bool any = false;
+  for (size_t i = 0; i < fds.size(); ++i) {
+    CounterValue value{};
+    if (fds[i] >= 0 && read(fds[i], &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value))) {
+      sample.values[i] = value.value;
+      sample.time_enabled[i] = value.time_enabled;
+      sample.time_running[i] = value.time_running;
+      any = true;
+    } else {
+      sample.time_running[i] = 0;
+    }
+  }
+  return any;
+#else
+  ORT_UNUSED_PARAMETER(sample);
+  return false;
+#endif
+}
+
+std::string HardwareCounters::ToJson(const Sample& begin, const Sample& end) const {
+  std::ostringstream json;
+  json << "{";
+  bool first = true;
+  for (size_t i = 0; i < counters_.size(); ++i) {
+    const uint64_t running = end.time_running[i] - begin.time_running[i];
+    if (end.time_running[i] == 0 || running == 0) {
+      // not opened on this thread, or not scheduled while the kernel ran
+      continue;
+    }
+    const uint64_t enabled = end.time_enabled[i] - begin.time_enabled[i];
+    double value = static_cast<double>(end.values[i] - begin.values[i]);
+    if (running < enabled) {
+      // multiplexed with the other counters
+      value *= static_cast<double>(enabled) / static_cast<double>(running);
+    }
+    json << (first ? "" : ",") << "\"" << kNames[counters_[i]] << "\":" << static_cast<uint64_t>(value);
+    first = false;
+  }
+  json << "}";
+  return json.str();
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
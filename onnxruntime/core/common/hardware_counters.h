@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+
+namespace onnxruntime {
+namespace profiling {
+
+// Hardware performance counters of the threads running the kernels, added to the kernel events of the profiler as
+// the "hw_counters" arg. Enabled with kOrtSessionOptionsProfileHardwareCounters.
+//
+// Linux only: the counters are opened with perf_event_open(2) for each thread the first time it runs a kernel, and
+// count the user space of that thread, so /proc/sys/kernel/perf_event_paranoid must be 2 or less. The work a kernel
+// hands to the threads of the intra op thread pool isn't counted; set intra_op_num_threads to 1 to attribute all of
+// it to the nodes. When the CPU has fewer counters than requested the OS multiplexes them, and the counts are scaled
+// by the time each counter ran.
+class HardwareCounters {
+ public:
+  enum Counter {
+    kCycles,
+    kInstructions,
+    // the misses of the last level cache, as the CPU defines them
+    kLlcMisses,
+    kLlcLoadMisses,
+    kL1dLoadMisses,
+    kDtlbLoadMisses,
+    kBranchMisses,
+    kNumCounters,
+  };
+
+  // The names of the counters in kOrtSessionOptionsProfileHardwareCounters and in the profile
+  static constexpr std::array<const char*, kNumCounters> kNames{
+      "cycles", "instructions", "llc_misses", "llc_load_misses", "l1d_load_misses", "dtlb_load_misses",
+      "branch_misses"};
+
+  // the values of the counters of a thread, in the order they were requested
+  struct Sample {
+    std::array<uint64_t, kNumCounters> values{};
+    std::array<uint64_t, kNumCounters> time_enabled{};
+    std::array<uint64_t, kNumCounters> time_running{};
+  };
+
+  // names: a comma separated list of kNames, or "1" for cycles, instructions, llc_misses and branch_misses. Fails
+  // for an unknown name, or if none of the counters can be opened on this platform. The counters the CPU doesn't
+  // have are left out and listed in warnings.
+  static Status Create(const std::string& names, std::unique_ptr<HardwareCounters>& counters,
+                       std::string& warnings);
+
+  ~HardwareCounters();
+
+  // Reads the counters of the calling thread, opening them if it didn't read them before. Returns false if they
+  // can't be opened on this thread.
+  bool Read(Sample& sample) const;
+
+  // The counts from begin to end as a JSON object, e.g. {"cycles":1200,"instructions":3400}
+  std::string ToJson(const Sample& begin, const Sample& end) const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(HardwareCounters);
+
+ private:
+  // the file descriptors of the counters of a thread, -1 for those which failed to open on it
+  using ThreadCounters = std::vector<int>;
+
+  explicit HardwareCounters(std::vector<Counter> counters);
+
+  // Opens the counters of the calling thread
+  ThreadCounters Open() const;
+
+  const ThreadCounters& GetThreadCounters() const;
+
+  // the counters opened on every thread
+  std::vector<Counter> counters_;
+  // identifies this instance in the cache of the threads, as an address may be reused
+  const uint64_t instance_id_;
+
+  mutable std::mutex mutex_;
+  mutable std::unordered_map<std::thread::id, ThreadCounters> threads_;
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -81,10 +81,30 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
 
   EventRecord event(category, logging::GetProcessId(),
                     logging::GetThreadId(), event_name, ts, dur, {event_args.begin(), event_args.end()});
+  // TODO: sync_gpu if needed.
+  AddEvent(std::move(event));
+
+  for (const auto& ep_profiler : ep_profilers_) {
+    ep_profiler->Stop(ts);
+  }
+}
+
+void Profiler::RecordEvent(EventCategory category,
+                           int thread_id,
+                           const std::string& event_name,
+                           const TimePoint& start_time,
+                           const TimePoint& end_time,
+                           std::unordered_map<std::string, std::string>&& event_args) {
+  long long dur = TimeDiffMicroSeconds(start_time, end_time);
+  long long ts = TimeDiffMicroSeconds(profiling_start_time_, start_time);
+  AddEvent(EventRecord(category, logging::GetProcessId(), thread_id, std::string(event_name), ts, dur,
+                       std::move(event_args)));
+}
+
+void Profiler::AddEvent(EventRecord&& event) {
   if (profile_with_logger_) {
     custom_logger_->SendProfileEvent(event);
   } else {
-    // TODO: sync_gpu if needed.
     std::lock_guard<OrtMutex> lock(mutex_);
     if (events_.size() < max_num_events_) {
       events_.emplace_back(std::move(event));
@@ -96,10 +116,6 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
       }
     }
   }
-
-  for (const auto& ep_profiler : ep_profilers_) {
-    ep_profiler->Stop(ts);
-  }
 }
 
 std::string Profiler::EndProfiling() {
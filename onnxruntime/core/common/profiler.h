@@ -9,6 +9,7 @@
 #include <iostream>
 #include <tuple>
 
+#include "core/common/hardware_counters.h"
 #include "core/common/profiler_common.h"
 #include "core/common/logging/logging.h"
 #include "core/platform/ort_mutex.h"
@@ -80,6 +81,16 @@ class Profiler {
                              const std::initializer_list<std::pair<std::string, std::string>>& event_args = {},
                              bool sync_gpu = false);
 
+  /*
+  Record a single event from start_time to end_time that happened on another thread, e.g. a thread of a thread pool.
+  */
+  void RecordEvent(EventCategory category,
+                   int thread_id,
+                   const std::string& event_name,
+                   const TimePoint& start_time,
+                   const TimePoint& end_time,
+                   std::unordered_map<std::string, std::string>&& event_args = {});
+
   /*
   Write profile data to the given stream in chrome format defined below.
   https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/preview#
@@ -110,6 +121,20 @@ class Profiler {
     global_max_num_events_.store(new_max_num_events);
   }
 
+  /*
+  Set the hardware counters read around each kernel, added to its event as the "hw_counters" arg.
+  */
+  void SetHardwareCounters(std::unique_ptr<HardwareCounters> hardware_counters) {
+    hardware_counters_ = std::move(hardware_counters);
+  }
+
+  /*
+  Return the hardware counters read around each kernel, or nullptr if none are.
+  */
+  const HardwareCounters* GetHardwareCounters() const {
+    return hardware_counters_.get();
+  }
+
   void AddEpProfilers(std::unique_ptr<EpProfiler> ep_profiler) {
     if (ep_profiler) {
       ep_profilers_.push_back(std::move(ep_profiler));
@@ -122,6 +147,8 @@ class Profiler {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Profiler);
 
+  void AddEvent(EventRecord&& event);
+
   /**
    * The maximum number of profiler records to collect.
    * This value is used to initialize the per-profiler maximum.
@@ -156,6 +183,7 @@ class Profiler {
 #endif
 
   std::vector<std::unique_ptr<EpProfiler>> ep_profilers_;
+  std::unique_ptr<HardwareCounters> hardware_counters_;
 };
 
 }  // namespace profiling
@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/startup_timings.h"
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+
+namespace onnxruntime {
+
+namespace {
+
+thread_local StartupTimings* current_timings = nullptr;
+
+long long MicroSeconds(const TimePoint& begin, const TimePoint& end) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+}
+
+void WriteJsonString(std::ostringstream& json, const std::string& value) {
+  json << '"';
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      json << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      json << ' ';
+    } else {
+      json << c;
+    }
+  }
+  json << '"';
+}
+
+}  // namespace
+
+std::vector<StartupTimings::Phase> StartupTimings::GetPhases() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return phases_;
+}
+
+std::string StartupTimings::ToJson() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const TimePoint start = phases_.empty() ? TimePoint() : phases_.front().start;
+  TimePoint end = start;
+  std::map<std::string, std::pair<size_t, long long>> summary;
+
+  std::ostringstream json;
+  json << "{\"phases\":[";
+  for (size_t i = 0; i < phases_.size(); ++i) {
+    const Phase& phase = phases_[i];
+    end = std::max(end, phase.end);
+    const long long duration_us = MicroSeconds(phase.start, phase.end);
+    auto& [count, total_us] = summary[phase.phase];
+    ++count;
+    total_us += duration_us;
+
+    json << (i > 0 ? "," : "") << "{\"phase\":";
+    WriteJsonString(json, phase.phase);
+    json << ",\"name\":";
+    WriteJsonString(json, phase.name);
+    json << ",\"start_us\":" << MicroSeconds(start, phase.start) << ",\"duration_us\":" << duration_us
+         << ",\"depth\":" << phase.depth << "}";
+  }
+  json << "],\"summary\":{";
+  bool first = true;
+  for (const auto& [phase, totals] : summary) {
+    json << (first ? "" : ",");
+    WriteJsonString(json, phase);
+    json << ":{\"count\":" << totals.first << ",\"total_us\":" << totals.second << "}";
+    first = false;
+  }
+  json << "},\"total_us\":" << MicroSeconds(start, end) << "}";
+  return json.str();
+}
+
+size_t StartupTimings::Begin(std::string_view phase, std::string_view name) {
+  const TimePoint now = std::chrono::high_resolution_clock::now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  phases_.push_back({std::string(phase), std::string(name), now, now, depth_++});
+  return phases_.size() - 1;
+}
+
+void StartupTimings::End(size_t index) {
+  const TimePoint now = std::chrono::high_resolution_clock::now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  phases_[index].end = now;
+  --depth_;
+}
+
+StartupTimings* StartupTimings::Current() {
+  return current_timings;
+}
+
+StartupTimingsScope::StartupTimingsScope(StartupTimings* timings) : previous_(current_timings) {
+  current_timings = timings;
+}
+
+StartupTimingsScope::~StartupTimingsScope() {
+  current_timings = previous_;
+}
+
+StartupPhase::StartupPhase(std::string_view phase, std::string_view name) : timings_(current_timings) {
+  if (timings_ != nullptr) {
+    index_ = timings_->Begin(phase, name);
+  }
+}
+
+StartupPhase::~StartupPhase() {
+  if (timings_ != nullptr) {
+    timings_->End(index_);
+  }
+}
+
+}  // namespace onnxruntime
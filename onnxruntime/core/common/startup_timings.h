@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+// The time a session spent in each phase of its creation: loading the model, resolving the graph, each graph
+// transformer, partitioning, compiling the nodes of the EPs, creating the kernels, loading the initializers and
+// prepacking them. InferenceSession makes its timings current on the calling thread while it loads and initializes
+// the model, and the code of each phase opens a StartupPhase, which does nothing while no timings are current.
+class StartupTimings {
+ public:
+  struct Phase {
+    // e.g. "graph_transformer"
+    std::string phase;
+    // what the phase worked on, e.g. the name of the transformer, or empty
+    std::string name;
+    TimePoint start;
+    TimePoint end;
+    // the number of phases this one is nested in
+    int depth;
+  };
+
+  StartupTimings() = default;
+
+  // The phases in the order they began
+  std::vector<Phase> GetPhases() const;
+
+  // A JSON object with the phases in the order they began, and their totals by phase, e.g. of all the Resolves:
+  // {"phases": [{"phase": ..., "name": ..., "start_us": ..., "duration_us": ..., "depth": ...}],
+  //  "summary": {"<phase>": {"count": ..., "total_us": ...}}, "total_us": ...}
+  // A nested phase counts in the totals of the phases it's nested in too.
+  std::string ToJson() const;
+
+  // The timings of the current StartupTimingsScope of the calling thread, nullptr if none
+  static StartupTimings* Current();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(StartupTimings);
+
+ private:
+  friend class StartupPhase;
+
+  size_t Begin(std::string_view phase, std::string_view name);
+  void End(size_t index);
+
+  mutable std::mutex mutex_;
+  std::vector<Phase> phases_;
+  int depth_ = 0;
+};
+
+// Makes timings current on the calling thread for the lifetime of the scope. timings may be nullptr.
+class StartupTimingsScope {
+ public:
+  explicit StartupTimingsScope(StartupTimings* timings);
+  ~StartupTimingsScope();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(StartupTimingsScope);
+
+ private:
+  StartupTimings* previous_;
+};
+
+// Times a phase of the creation of the session in the current StartupTimings of the calling thread, if any.
+class StartupPhase {
+ public:
+  explicit StartupPhase(std::string_view phase, std::string_view name = {});
+  ~StartupPhase();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(StartupPhase);
+
+ private:
+  StartupTimings* const timings_;
+  size_t index_ = 0;
+};
+
+}  // namespace onnxruntime
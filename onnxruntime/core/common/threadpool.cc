@@ -13,15 +13,18 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 
 #include "core/platform/threadpool.h"
 #include "core/common/common.h"
 #include "core/common/cpuid_info.h"
+#include "core/common/logging/logging.h"
 #include "core/common/eigen_common_wrapper.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
 #include "core/platform/ort_mutex.h"
+#include "core/platform/ort_spin_lock.h"
 #if !defined(ORT_MINIMAL_BUILD)
 #ifdef _WIN32
 #include "processthreadsapi.h"
@@ -64,7 +67,19 @@ ThreadPoolProfiler::~ThreadPoolProfiler() {
 }
 
 void ThreadPoolProfiler::Start() {
+  {
+    // the rings are never freed before the profiler, so LogTrace can use them without the lock once tracing
+    std::lock_guard<OrtMutex> trace_guard(trace_mutex_);
+    if (trace_rings_.empty()) {
+      trace_rings_.resize(static_cast<size_t>(num_threads_) + 1);
+      for (auto& ring : trace_rings_) {
+        ring = std::make_unique<TraceRing>();
+        ring->events.resize(TraceRing::kCapacity);
+      }
+    }
+  }
   enabled_ = true;
+  tracing_.store(true, std::memory_order_release);
 }
 
 ThreadPoolProfiler::MainThreadStat& ThreadPoolProfiler::GetMainThreadStat() {
@@ -77,6 +92,7 @@ ThreadPoolProfiler::MainThreadStat& ThreadPoolProfiler::GetMainThreadStat() {
 
 std::string ThreadPoolProfiler::Stop() {
   ORT_ENFORCE(enabled_, "Profiler not started yet");
+  tracing_ = false;
   std::ostringstream ss;
   ss << "{\"main_thread\": {"
      << "\"thread_pool_name\": \""
@@ -230,11 +246,58 @@ void ThreadPoolProfiler::LogRun(int thread_idx) {
   }
 }
 
+void ThreadPoolProfiler::LogSpin(int thread_idx, bool found_work, uint64_t spin_ns) {
+  if (enabled_) {
+    auto& stat = child_thread_stats_[thread_idx];
+    if (found_work) {
+      stat.num_spin_hit_++;
+    } else {
+      stat.num_park_++;
+    }
+    stat.spin_ns_ += spin_ns;
+  }
+}
+
+void ThreadPoolProfiler::LogTrace(int thread_idx, ThreadPoolTraceEvent::Type type, const onnxruntime::TimePoint& start,
+                                  std::ptrdiff_t arg) {
+  if (!IsTracing()) {
+    return;
+  }
+  static thread_local int tid = static_cast<int>(logging::GetThreadId());
+  const auto end = Clock::now();
+  TraceRing& ring = *trace_rings_[thread_idx >= 0 && thread_idx < num_threads_ ? thread_idx : num_threads_];
+  std::lock_guard<OrtSpinLock> guard(ring.lock);
+  ring.events[ring.head % TraceRing::kCapacity] = {type, tid, start, end, arg};
+  if (++ring.head - ring.tail > TraceRing::kCapacity) {
+    ring.tail = ring.head - TraceRing::kCapacity;
+  }
+}
+
+void ThreadPoolProfiler::DrainTrace(const std::function<void(const ThreadPoolTraceEvent&)>& fn) {
+  std::lock_guard<OrtMutex> trace_guard(trace_mutex_);
+  std::vector<ThreadPoolTraceEvent> events;
+  for (auto& ring : trace_rings_) {
+    // copy out under the lock so writers are blocked for as short as possible
+    events.clear();
+    {
+      std::lock_guard<OrtSpinLock> guard(ring->lock);
+      for (uint64_t i = ring->tail; i < ring->head; ++i) {
+        events.push_back(ring->events[i % TraceRing::kCapacity]);
+      }
+      ring->tail = ring->head;
+    }
+    std::for_each(events.begin(), events.end(), fn);
+  }
+}
+
 std::string ThreadPoolProfiler::DumpChildThreadStat() {
   std::stringstream ss;
   for (int i = 0; i < num_threads_; ++i) {
     ss << "\"" << child_thread_stats_[i].thread_id_ << "\": {"
        << "\"num_run\": " << child_thread_stats_[i].num_run_ << ", "
+       << "\"num_spin_hit\": " << child_thread_stats_[i].num_spin_hit_ << ", "
+       << "\"num_park\": " << child_thread_stats_[i].num_park_ << ", "
+       << "\"spin_us\": " << child_thread_stats_[i].spin_ns_ / 1000 << ", "
        << "\"core\": " << child_thread_stats_[i].core_ << "}"
        << (i == num_threads_ - 1 ? "" : ",");
   }
@@ -365,6 +428,105 @@ class alignas(CACHE_LINE_BYTES) LoopCounter {
   const unsigned _num_shards;
 };
 
+// A work-stealing loop counter gives each work item its own range of iterations, initially an equal share of
+// the loop.  A work item claims blocks of grain iterations from the front of its range.  Once its range is empty
+// it steals the back half of the largest remaining range, or all of it if it is no larger than a block, and
+// continues with that.  Compared with LoopCounter, work moves to idle threads in pieces that shrink as the loop
+// nears its end, so loops whose iterations have very different costs do not finish with a few threads running
+// the last expensive blocks while the others wait.
+//
+// The ranges of work items that never start (e.g. because fewer workers joined the loop than requested) are
+// stolen like any other, so all iterations run as long as one work item does.
+
+struct alignas(CACHE_LINE_BYTES) StealingRange {
+  OrtSpinLock lock;
+  // updated under lock, read without it when looking for a victim
+  ::std::atomic<uint64_t> start{0};
+  ::std::atomic<uint64_t> end{0};
+};
+
+class StealingLoopCounter {
+ public:
+  StealingLoopCounter(uint64_t num_iterations, unsigned num_work_items, uint64_t grain)
+      : _ranges(std::make_unique<StealingRange[]>(num_work_items)),
+        _num_ranges(num_work_items),
+        _grain(grain) {
+    for (unsigned i = 0; i < _num_ranges; i++) {
+      // relaxed stores; synchronization with worker threads is provided via the thread pool
+      _ranges[i].start.store(num_iterations / _num_ranges * i + std::min<uint64_t>(i, num_iterations % _num_ranges),
+                             ::std::memory_order_relaxed);
+      _ranges[i].end.store(num_iterations / _num_ranges * (i + 1) +
+                               std::min<uint64_t>(i + 1, num_iterations % _num_ranges),
+                           ::std::memory_order_relaxed);
+    }
+  }
+
+  // Claim up to grain iterations for work item idx.  Returns false once no iterations are left to claim.
+  // stolen is set if the iterations were taken from the range of another work item.
+  bool ClaimIterations(unsigned idx, uint64_t& my_start, uint64_t& my_end, bool& stolen) {
+    StealingRange& mine = _ranges[idx];
+    stolen = false;
+    do {
+      std::lock_guard<OrtSpinLock> guard(mine.lock);
+      const uint64_t start = mine.start.load(::std::memory_order_relaxed);
+      const uint64_t end = mine.end.load(::std::memory_order_relaxed);
+      if (start < end) {
+        my_start = start;
+        my_end = std::min(end, start + _grain);
+        mine.start.store(my_end, ::std::memory_order_relaxed);
+        return true;
+      }
+    } while ((stolen = Steal(mine)));
+    return false;
+  }
+
+ private:
+  // Move part of another range into mine, which is empty.  Returns false once all ranges are empty.
+  bool Steal(StealingRange& mine) {
+    for (;;) {
+      StealingRange* victim = nullptr;
+      uint64_t victim_size = 0;
+      for (unsigned i = 0; i < _num_ranges; i++) {
+        const uint64_t start = _ranges[i].start.load(::std::memory_order_relaxed);
+        const uint64_t end = _ranges[i].end.load(::std::memory_order_relaxed);
+        if (start < end && end - start > victim_size) {
+          victim = &_ranges[i];
+          victim_size = end - start;
+        }
+      }
+      if (victim == nullptr) {
+        return false;
+      }
+
+      uint64_t stolen_start = 0;
+      uint64_t stolen_end = 0;
+      {
+        std::lock_guard<OrtSpinLock> guard(victim->lock);
+        const uint64_t start = victim->start.load(::std::memory_order_relaxed);
+        const uint64_t end = victim->end.load(::std::memory_order_relaxed);
+        if (start >= end) {
+          continue;  // emptied by its owner or another thief in the meantime
+        }
+        stolen_start = end - start > _grain ? start + (end - start) / 2 : start;
+        stolen_end = end;
+        victim->end.store(stolen_start, ::std::memory_order_relaxed);
+        if (stolen_start == start) {
+          victim->start.store(stolen_start, ::std::memory_order_relaxed);
+        }
+      }
+
+      std::lock_guard<OrtSpinLock> guard(mine.lock);
+      mine.start.store(stolen_start, ::std::memory_order_relaxed);
+      mine.end.store(stolen_end, ::std::memory_order_relaxed);
+      return true;
+    }
+  }
+
+  std::unique_ptr<StealingRange[]> _ranges;
+  const unsigned _num_ranges;
+  const uint64_t _grain;
+};
+
 #ifdef _MSC_VER
 #pragma warning(pop) /* Padding added in LoopCounterShard, LoopCounter */
 #endif
@@ -420,18 +582,24 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
     // Split the work across threads in the pool.  Each work item will run a loop claiming iterations,
     // hence we need at most one for each thread, even if the number of blocks of iterations is larger.
     auto num_blocks = total / block_size;
-    auto num_threads_inc_main = NumThreads() + 1;
+    auto num_threads_inc_main = NumThreadsIncMain();
     int num_work_items = static_cast<int>(std::min(static_cast<std::ptrdiff_t>(num_threads_inc_main), num_blocks));
     assert(num_work_items > 0);
 
     LoopCounter lc(total, d_of_p, block_size);
+    const bool tracing = IsTracing();
     std::function<void(unsigned)> run_work = [&](unsigned idx) {
       unsigned my_home_shard = lc.GetHomeShard(idx);
       unsigned my_shard = my_home_shard;
       uint64_t my_iter_start, my_iter_end;
       while (lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end, block_size)) {
+        const auto block_start = tracing ? std::chrono::high_resolution_clock::now() : TimePoint{};
         fn(static_cast<std::ptrdiff_t>(my_iter_start),
            static_cast<std::ptrdiff_t>(my_iter_end));
+        if (tracing) {
+          LogTrace(my_shard == my_home_shard ? ThreadPoolTraceEvent::BLOCK : ThreadPoolTraceEvent::STEAL,
+                   block_start, static_cast<std::ptrdiff_t>(my_iter_start));
+        }
       }
     };
     // Run the work in the thread pool (and in the current thread).  Synchronization with helping
@@ -443,14 +611,20 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
     std::ptrdiff_t base_block_size = static_cast<std::ptrdiff_t>(std::max(1LL, std::llroundl(static_cast<long double>(total) / num_of_blocks)));
     alignas(CACHE_LINE_BYTES) std::atomic<std::ptrdiff_t> left{total};
     LoopCounter lc(total, d_of_p, base_block_size);
+    const bool tracing = IsTracing();
     std::function<void(unsigned)> run_work = [&](unsigned idx) {
       std::ptrdiff_t b = base_block_size;
       unsigned my_home_shard = lc.GetHomeShard(idx);
       unsigned my_shard = my_home_shard;
       uint64_t my_iter_start, my_iter_end;
       while (lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end, b)) {
+        const auto block_start = tracing ? std::chrono::high_resolution_clock::now() : TimePoint{};
         fn(static_cast<std::ptrdiff_t>(my_iter_start),
            static_cast<std::ptrdiff_t>(my_iter_end));
+        if (tracing) {
+          LogTrace(my_shard == my_home_shard ? ThreadPoolTraceEvent::BLOCK : ThreadPoolTraceEvent::STEAL,
+                   block_start, static_cast<std::ptrdiff_t>(my_iter_start));
+        }
         auto todo = left.fetch_sub(static_cast<std::ptrdiff_t>(my_iter_end - my_iter_start), std::memory_order_relaxed);
         if (b > 1) {
           b = static_cast<std::ptrdiff_t>(std::max(1LL, std::llroundl(static_cast<long double>(todo) / num_of_blocks)));
@@ -459,10 +633,41 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
     };
     // Distribute task among all threads in the pool, reduce number of work items if
     // num_of_blocks is smaller than number of threads.
-    RunInParallel(run_work, std::min(NumThreads() + 1, num_of_blocks), base_block_size);
+    RunInParallel(run_work, std::min(NumThreadsIncMain(), num_of_blocks), base_block_size);
   }
 }
 
+void ThreadPool::WorkStealingParallelFor(const std::ptrdiff_t total, const std::ptrdiff_t grain,
+                                         const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>& fn) {
+  if (total <= 0)
+    return;
+
+  if (total <= grain) {
+    fn(0, total);
+    return;
+  }
+
+  const auto num_blocks = (total + grain - 1) / grain;
+  const int num_work_items = static_cast<int>(std::min(static_cast<std::ptrdiff_t>(NumThreadsIncMain()), num_blocks));
+  StealingLoopCounter lc(static_cast<uint64_t>(total), static_cast<unsigned>(num_work_items),
+                         static_cast<uint64_t>(grain));
+  const bool tracing = IsTracing();
+  std::function<void(unsigned)> run_work = [&](unsigned idx) {
+    uint64_t my_iter_start, my_iter_end;
+    bool stolen;
+    while (lc.ClaimIterations(idx, my_iter_start, my_iter_end, stolen)) {
+      const auto block_start = tracing ? std::chrono::high_resolution_clock::now() : TimePoint{};
+      fn(static_cast<std::ptrdiff_t>(my_iter_start),
+         static_cast<std::ptrdiff_t>(my_iter_end));
+      if (tracing) {
+        LogTrace(stolen ? ThreadPoolTraceEvent::STEAL : ThreadPoolTraceEvent::BLOCK,
+                 block_start, static_cast<std::ptrdiff_t>(my_iter_start));
+      }
+    }
+  };
+  RunInParallel(run_work, num_work_items, grain);
+}
+
 void ThreadPool::SimpleParallelFor(std::ptrdiff_t total, const std::function<void(std::ptrdiff_t)>& fn) {
   ParallelForFixedBlockSizeScheduling(total, 1, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
     for (std::ptrdiff_t idx = first; idx < last; idx++) {
@@ -485,6 +690,14 @@ void ThreadPool::StartProfiling() {
   }
 }
 
+bool ThreadPool::IsTracing() const {
+  return extended_eigen_threadpool_ && extended_eigen_threadpool_->IsTracing();
+}
+
+void ThreadPool::LogTrace(ThreadPoolTraceEvent::Type type, const TimePoint& start, std::ptrdiff_t arg) {
+  extended_eigen_threadpool_->LogTrace(type, start, arg);
+}
+
 std::string ThreadPool::StopProfiling() {
   if (underlying_threadpool_) {
     return underlying_threadpool_->StopProfiling();
@@ -495,6 +708,23 @@ std::string ThreadPool::StopProfiling() {
 
 namespace {
 thread_local std::optional<ThreadPoolParallelSection> current_parallel_section;
+
+// settings of the innermost ThreadPool::SchedulingScope of the thread
+thread_local ThreadPool::Priority current_priority = ThreadPool::Priority::kNormal;
+thread_local int current_max_degree_of_parallelism = 0;
+}  // namespace
+
+ThreadPool::SchedulingScope::SchedulingScope(Priority priority, int max_degree_of_parallelism)
+    : previous_priority_(current_priority),
+      previous_max_degree_of_parallelism_(current_max_degree_of_parallelism) {
+  ORT_ENFORCE(max_degree_of_parallelism >= 0, "Invalid maximum degree of parallelism: ", max_degree_of_parallelism);
+  current_priority = priority;
+  current_max_degree_of_parallelism = max_degree_of_parallelism;
+}
+
+ThreadPool::SchedulingScope::~SchedulingScope() {
+  current_priority = previous_priority_;
+  current_max_degree_of_parallelism = previous_max_degree_of_parallelism_;
 }
 
 ThreadPool::ParallelSection::ParallelSection(ThreadPool* tp) {
@@ -504,6 +734,7 @@ ThreadPool::ParallelSection::ParallelSection(ThreadPool* tp) {
   if (tp && tp->underlying_threadpool_) {
     current_parallel_section.emplace();
     ps_ = &*current_parallel_section;
+    ps_->high_priority = current_priority == Priority::kHigh;
     tp_->underlying_threadpool_->StartParallelSection(*ps_);
   }
 }
@@ -516,14 +747,23 @@ ThreadPool::ParallelSection::~ParallelSection() {
 }
 
 void ThreadPool::RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) {
-  if (underlying_threadpool_) {
+  // n is 1 if the quota of the current SchedulingScope leaves no room for helpers
+  if (underlying_threadpool_ && n > 1) {
+    if (IsTracing()) {
+      fn = [this, inner = std::move(fn)](unsigned idx) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        inner(idx);
+        LogTrace(ThreadPoolTraceEvent::WORK_ITEM, start, static_cast<std::ptrdiff_t>(idx));
+      };
+    }
     if (current_parallel_section.has_value()) {
       underlying_threadpool_->RunInParallelSection(*current_parallel_section,
                                                    std::move(fn),
                                                    n, block_size);
     } else {
       underlying_threadpool_->RunInParallel(std::move(fn),
-                                            n, block_size);
+                                            n, block_size,
+                                            current_priority == Priority::kHigh);
     }
   } else {
     fn(0);
@@ -551,6 +791,17 @@ bool ThreadPool::ShouldParallelizeLoop(const std::ptrdiff_t num_iterations,
 
 using CostModel = Eigen::TensorCostModel<Eigen::ThreadPoolDevice>;
 
+// Block size of a work-stealing loop: the smallest number of iterations whose cost the cost model considers
+// worth a task.  Ranges are split on demand, so unlike CalculateParallelForBlock there is no need to balance the
+// number of blocks between the threads up front.
+static ptrdiff_t WorkStealingGrain(const ptrdiff_t n, const Eigen::TensorOpCost& cost) {
+  const double grain_f = 1.0 / CostModel::taskSize(1, cost);
+  if (!(grain_f < static_cast<double>(n))) {
+    return n;
+  }
+  return std::max<ptrdiff_t>(1, static_cast<ptrdiff_t>(grain_f));
+}
+
 // Calculates block size based on (1) the iteration cost and (2) parallel
 // efficiency. We want blocks to be not too small to mitigate parallelization
 // overheads; not too large to mitigate tail effect and potential load
@@ -622,10 +873,33 @@ void ThreadPool::ParallelFor(std::ptrdiff_t n, const TensorOpCost& c,
     return;
   }
 
+  if (thread_options_.work_stealing_loops_) {
+    WorkStealingParallelFor(n, WorkStealingGrain(n, cost), f);
+    return;
+  }
+
   ptrdiff_t block = CalculateParallelForBlock(n, cost, nullptr, d_of_p);
   ParallelForFixedBlockSizeScheduling(n, block, f);
 }
 
+void ThreadPool::TryWorkStealingParallelFor(ThreadPool* tp, std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
+                                            const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn) {
+  ORT_ENFORCE(total >= 0);
+  if (tp == nullptr) {
+    fn(0, total);
+    return;
+  }
+
+  Eigen::TensorOpCost cost{cost_per_unit.bytes_loaded, cost_per_unit.bytes_stored, cost_per_unit.compute_cycles};
+  if (!tp->ShouldParallelizeLoop(total) ||
+      CostModel::numThreads(static_cast<double>(total), cost, DegreeOfParallelism(tp)) == 1) {
+    fn(0, total);
+    return;
+  }
+
+  tp->WorkStealingParallelFor(total, WorkStealingGrain(total, cost), fn);
+}
+
 void ThreadPool::ParallelFor(std::ptrdiff_t total, double cost_per_unit,
                              const std::function<void(std::ptrdiff_t first, std::ptrdiff_t)>& fn) {
   ParallelFor(total, TensorOpCost{0, 0, static_cast<double>(cost_per_unit)}, fn);
@@ -640,9 +914,9 @@ int ThreadPool::DegreeOfParallelism(const concurrency::ThreadPool* tp) {
   // tp, plus 1 for the thread entering a loop.
   if (tp) {
     if (tp->force_hybrid_ || CPUIDInfo::GetCPUIDInfo().IsHybrid()) {
-      return ((tp->NumThreads() + 1)) * TaskGranularityFactor;
+      return tp->NumThreadsIncMain() * TaskGranularityFactor;
     } else {
-      return ((tp->NumThreads() + 1));
+      return tp->NumThreadsIncMain();
     }
   } else {
     return 1;
@@ -663,6 +937,30 @@ std::string ThreadPool::StopProfiling(concurrency::ThreadPool* tp) {
   }
 }
 
+void ThreadPool::DrainTraceEvents(concurrency::ThreadPool* tp,
+                                  const std::function<void(const ThreadPoolTraceEvent&)>& fn) {
+  if (tp && tp->extended_eigen_threadpool_) {
+    tp->extended_eigen_threadpool_->DrainTrace(fn);
+  }
+}
+
+void ThreadPool::EnableBusyTimeTracking(concurrency::ThreadPool* tp) {
+  if (tp && tp->extended_eigen_threadpool_) {
+    tp->extended_eigen_threadpool_->EnableBusyTimeTracking();
+  }
+}
+
+uint64_t ThreadPool::GetBusyTimeNs(const concurrency::ThreadPool* tp) {
+  if (tp && tp->extended_eigen_threadpool_) {
+    return tp->extended_eigen_threadpool_->GetBusyTimeNs();
+  }
+  return 0;
+}
+
+int ThreadPool::GetNumThreads(const concurrency::ThreadPool* tp) {
+  return tp ? tp->NumThreads() : 0;
+}
+
 void ThreadPool::EnableSpinning() {
   if (extended_eigen_threadpool_) {
     extended_eigen_threadpool_->EnableSpinning();
@@ -684,6 +982,14 @@ int ThreadPool::NumThreads() const {
   }
 }
 
+int ThreadPool::NumThreadsIncMain() const {
+  const int num_threads_inc_main = NumThreads() + 1;
+  if (current_max_degree_of_parallelism > 0) {
+    return std::min(num_threads_inc_main, current_max_degree_of_parallelism);
+  }
+  return num_threads_inc_main;
+}
+
 // Return ID of the current thread within this pool.  Returns -1 for a thread outside the
 // current pool.
 int ThreadPool::CurrentThreadId() const {
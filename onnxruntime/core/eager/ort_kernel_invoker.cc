@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/eager/ort_kernel_invoker.h"
+
+#include <algorithm>
+
 #include "core/optimizer/optimizer_execution_frame.h"
 #include "core/common/logging/logging.h"
 #include "core/graph/model.h"
@@ -13,46 +16,90 @@ namespace onnxruntime {
 
 #define ORT_EAGER_ONNX_OPSET_VERSION 14
 
-common::Status ORTInvoker::Invoke(const std::string& op_name,
-                                  // optional inputs / outputs?
-                                  const std::vector<OrtValue>& inputs,
-                                  std::vector<OrtValue>& outputs,
-                                  const NodeAttributes* attributes,
-                                  const std::string& domain,
-                                  const int version) {
+struct ORTInvoker::CachedKernel {
+  std::unique_ptr<Model> model;
+  const Node* node{};
+  const KernelCreateInfo* kernel_create_info{};
+  std::function<bool(const std::string&)> is_sparse_initializer_func;
+  // the kernel refers to the value maps of the info it is created with
+  std::unique_ptr<OptimizerExecutionFrame::Info> info;
+  std::unique_ptr<const OpKernel> kernel;
+};
+
+static std::string GetKernelCacheKey(const std::string& op_name,
+                                     const std::vector<OrtValue>& inputs,
+                                     size_t output_count,
+                                     const NodeAttributes* attributes,
+                                     const std::string& domain) {
+  std::string key = domain + ":" + op_name + ":" + std::to_string(output_count) + ":";
+  for (const auto& input : inputs) {
+    key += std::to_string(input.Get<Tensor>().GetElementType()) + ",";
+  }
+
+  if (attributes != nullptr) {
+    // the serialized attributes include their names, so sorting them makes the key independent of the map order
+    std::vector<const std::string*> names;
+    names.reserve(attributes->size());
+    for (const auto& attribute : *attributes) {
+      names.push_back(&attribute.first);
+    }
+    std::sort(names.begin(), names.end(), [](const std::string* a, const std::string* b) { return *a < *b; });
+    for (const auto* name : names) {
+      key += attributes->at(*name).SerializeAsString();
+    }
+  }
+
+  return key;
+}
+
+common::Status ORTInvoker::GetOrCreateKernel(const std::string& op_name,
+                                             const std::vector<OrtValue>& inputs,
+                                             size_t output_count,
+                                             const NodeAttributes* attributes,
+                                             const std::string& domain,
+                                             const int version,
+                                             std::shared_ptr<const CachedKernel>& cached_kernel) {
+  std::string key = GetKernelCacheKey(op_name, inputs, output_count, attributes, domain);
+
+  std::lock_guard<std::mutex> lock(kernel_cache_mutex_);
+  auto it = kernel_cache_.find(key);
+  if (it != kernel_cache_.end()) {
+    cached_kernel = it->second;
+    return Status::OK();
+  }
+
   std::unordered_map<std::string, int> domain_version_map = {{kOnnxDomain, ORT_EAGER_ONNX_OPSET_VERSION},
                                                              {kMSDomain, 1}};
+  auto entry = std::make_shared<CachedKernel>();
   // create a graph
-  Model model("test",
-              false,
-              ModelMetaData(),
-              ORT_TSTR(""),
-              custom_op_registries_,
-              domain_version_map,
-              {},
-              logger_);
+  entry->model = std::make_unique<Model>("test",
+                                         false,
+                                         ModelMetaData(),
+                                         ORT_TSTR(""),
+                                         custom_op_registries_,
+                                         domain_version_map,
+                                         std::vector<ONNX_NAMESPACE::FunctionProto>{},
+                                         logger_);
 
   std::vector<onnxruntime::NodeArg*> input_args;
   std::vector<onnxruntime::NodeArg*> output_args;
 
   input_args.reserve(inputs.size());
-  output_args.reserve(outputs.size());
+  output_args.reserve(output_count);
 
-  Graph& graph = model.MainGraph();
-  std::unordered_map<std::string, OrtValue> initializer_map;
+  Graph& graph = entry->model->MainGraph();
   size_t i = 0;
 
-  for (auto input : inputs) {
+  for (const auto& input : inputs) {
     std::string name = "I" + std::to_string(i++);
     const Tensor& input_tensor = input.Get<Tensor>();
     ONNX_NAMESPACE::TypeProto input_tensor_type;
     input_tensor_type.mutable_tensor_type()->set_elem_type(input_tensor.GetElementType());
     auto& arg = graph.GetOrCreateNodeArg(name, &input_tensor_type);
     input_args.push_back(&arg);
-    initializer_map[name] = input;
   }
 
-  for (i = 0; i < outputs.size(); ++i) {
+  for (i = 0; i < output_count; ++i) {
     auto& arg = graph.GetOrCreateNodeArg("O" + std::to_string(i), nullptr);
     output_args.push_back(&arg);
   }
@@ -61,36 +108,66 @@ common::Status ORTInvoker::Invoke(const std::string& op_name,
   ORT_RETURN_IF_ERROR(graph.Resolve());
 
   node.SetExecutionProviderType(execution_provider_->Type());
-  std::vector<const Node*> frame_nodes{&node};
+  entry->node = &node;
+  entry->is_sparse_initializer_func = [](std::string const&) { return false; };
+
+  // The kernel is shared by the later invocations with other input values, so it is created without constant inputs.
+  entry->info = std::make_unique<OptimizerExecutionFrame::Info>(std::vector<const Node*>{&node},
+                                                                std::unordered_map<std::string, OrtValue>{},
+                                                                graph.ModelPath(), *execution_provider_,
+                                                                entry->is_sparse_initializer_func);
+  ORT_RETURN_IF_ERROR(entry->info->TryFindKernel(&node, &entry->kernel_create_info));
+  if (!entry->kernel_create_info) {
+    ORT_THROW("Could not find kernel name:", op_name, ", domain:", domain, ", version:", version);
+  }
 
-  OptimizerExecutionFrame::Info info({&node}, initializer_map, graph.ModelPath(), *execution_provider_, [](std::string const&) { return false; });
-  const KernelCreateInfo* kernel_create_info = nullptr;
-  ORT_RETURN_IF_ERROR(info.TryFindKernel(&node, &kernel_create_info));
-  if (!kernel_create_info) {
+  entry->kernel = entry->info->CreateKernel(&node);
+  if (!entry->kernel) {
     ORT_THROW("Could not find kernel name:", op_name, ", domain:", domain, ", version:", version);
   }
+
+  cached_kernel = entry;
+  kernel_cache_.emplace(std::move(key), std::move(entry));
+  return Status::OK();
+}
+
+common::Status ORTInvoker::Invoke(const std::string& op_name,
+                                  // optional inputs / outputs?
+                                  const std::vector<OrtValue>& inputs,
+                                  std::vector<OrtValue>& outputs,
+                                  const NodeAttributes* attributes,
+                                  const std::string& domain,
+                                  const int version) {
+  std::shared_ptr<const CachedKernel> cached_kernel;
+  ORT_RETURN_IF_ERROR(
+      GetOrCreateKernel(op_name, inputs, outputs.size(), attributes, domain, version, cached_kernel));
+  const Node& node = *cached_kernel->node;
+
   // check whether the inputs are contiguous tensor
-  const auto& may_strided_inputs = kernel_create_info->kernel_def->MayStridedInput();
-  for (i = 0; i < inputs.size(); ++i) {
+  const auto& may_strided_inputs = cached_kernel->kernel_create_info->kernel_def->MayStridedInput();
+  for (size_t i = 0; i < inputs.size(); ++i) {
     const Tensor& input_tensor = inputs[i].Get<Tensor>();
     if (!input_tensor.IsContiguous() && std::find(may_strided_inputs.begin(), may_strided_inputs.end(),
                                                   static_cast<int>(i)) == may_strided_inputs.end())
       ORT_THROW("kernel name:", op_name, "'s ", i, "th input doesn't support non-contiguous tensor.");
   }
 
-  auto kernel = info.CreateKernel(&node);
-  if (!kernel) {
-    ORT_THROW("Could not find kernel name:", op_name, ", domain:", domain, ", version:", version);
+  std::unordered_map<std::string, OrtValue> feeds;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    feeds[node.InputDefs()[i]->Name()] = inputs[i];
   }
 
+  OptimizerExecutionFrame::Info info({&node}, feeds, cached_kernel->model->MainGraph().ModelPath(),
+                                     *execution_provider_, cached_kernel->is_sparse_initializer_func);
+
   std::vector<int> fetch_mlvalue_idxs;
   for (const auto* node_out : node.OutputDefs()) {
     fetch_mlvalue_idxs.push_back(info.GetMLValueIndex(node_out->Name()));
   }
 
   OptimizerExecutionFrame frame(info, fetch_mlvalue_idxs, outputs);
-  OpKernelContext op_kernel_context(&frame, kernel.get(), nullptr, nullptr, logger_);
-  ORT_RETURN_IF_ERROR(kernel->Compute(&op_kernel_context));
+  OpKernelContext op_kernel_context(&frame, cached_kernel->kernel.get(), nullptr, nullptr, logger_);
+  ORT_RETURN_IF_ERROR(cached_kernel->kernel->Compute(&op_kernel_context));
 
   return frame.GetOutputs(outputs);
 }
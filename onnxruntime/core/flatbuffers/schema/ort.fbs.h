@@ -98,6 +98,18 @@ struct OpIdKernelTypeStrArgsEntryBuilder;
 struct KernelTypeStrResolver;
 struct KernelTypeStrResolverBuilder;
 
+struct StaticMemoryPlanBlock;
+struct StaticMemoryPlanBlockBuilder;
+
+struct StaticMemoryPlanBuffer;
+struct StaticMemoryPlanBufferBuilder;
+
+struct StaticMemoryPlanInput;
+struct StaticMemoryPlanInputBuilder;
+
+struct StaticMemoryPlan;
+struct StaticMemoryPlanBuilder;
+
 struct InferenceSession;
 struct InferenceSessionBuilder;
 
@@ -2979,12 +2991,325 @@ inline flatbuffers::Offset<KernelTypeStrResolver> CreateKernelTypeStrResolverDir
       op_kernel_type_str_args__);
 }
 
+struct StaticMemoryPlanBlock FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef StaticMemoryPlanBlockBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_VALUE_NAME = 4,
+    VT_OFFSET = 6,
+    VT_SIZE = 8
+  };
+  const flatbuffers::String *value_name() const {
+    return GetPointer<const flatbuffers::String *>(VT_VALUE_NAME);
+  }
+  uint64_t offset() const {
+    return GetField<uint64_t>(VT_OFFSET, 0);
+  }
+  uint64_t size() const {
+    return GetField<uint64_t>(VT_SIZE, 0);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_VALUE_NAME) &&
+           verifier.VerifyString(value_name()) &&
+           VerifyField<uint64_t>(verifier, VT_OFFSET) &&
+           VerifyField<uint64_t>(verifier, VT_SIZE) &&
+           verifier.EndTable();
+  }
+};
+
+struct StaticMemoryPlanBlockBuilder {
+  typedef StaticMemoryPlanBlock Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_value_name(flatbuffers::Offset<flatbuffers::String> value_name) {
+    fbb_.AddOffset(StaticMemoryPlanBlock::VT_VALUE_NAME, value_name);
+  }
+  void add_offset(uint64_t offset) {
+    fbb_.AddElement<uint64_t>(StaticMemoryPlanBlock::VT_OFFSET, offset, 0);
+  }
+  void add_size(uint64_t size) {
+    fbb_.AddElement<uint64_t>(StaticMemoryPlanBlock::VT_SIZE, size, 0);
+  }
+  explicit StaticMemoryPlanBlockBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  StaticMemoryPlanBlockBuilder &operator=(const StaticMemoryPlanBlockBuilder &);
+  flatbuffers::Offset<StaticMemoryPlanBlock> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<StaticMemoryPlanBlock>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<StaticMemoryPlanBlock> CreateStaticMemoryPlanBlock(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::String> value_name = 0,
+    uint64_t offset = 0,
+    uint64_t size = 0) {
+  StaticMemoryPlanBlockBuilder builder_(_fbb);
+  builder_.add_size(size);
+  builder_.add_offset(offset);
+  builder_.add_value_name(value_name);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<StaticMemoryPlanBlock> CreateStaticMemoryPlanBlockDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const char *value_name = nullptr,
+    uint64_t offset = 0,
+    uint64_t size = 0) {
+  auto value_name__ = value_name ? _fbb.CreateString(value_name) : 0;
+  return onnxruntime::fbs::CreateStaticMemoryPlanBlock(
+      _fbb,
+      value_name__,
+      offset,
+      size);
+}
+
+struct StaticMemoryPlanBuffer FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef StaticMemoryPlanBufferBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_DEVICE_TYPE = 4,
+    VT_DEVICE_MEM_TYPE = 6,
+    VT_DEVICE_ID = 8,
+    VT_SIZE = 10,
+    VT_BLOCKS = 12
+  };
+  int8_t device_type() const {
+    return GetField<int8_t>(VT_DEVICE_TYPE, 0);
+  }
+  int8_t device_mem_type() const {
+    return GetField<int8_t>(VT_DEVICE_MEM_TYPE, 0);
+  }
+  int16_t device_id() const {
+    return GetField<int16_t>(VT_DEVICE_ID, 0);
+  }
+  uint64_t size() const {
+    return GetField<uint64_t>(VT_SIZE, 0);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::fbs::StaticMemoryPlanBlock>> *blocks() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::fbs::StaticMemoryPlanBlock>> *>(VT_BLOCKS);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<int8_t>(verifier, VT_DEVICE_TYPE) &&
+           VerifyField<int8_t>(verifier, VT_DEVICE_MEM_TYPE) &&
+           VerifyField<int16_t>(verifier, VT_DEVICE_ID) &&
+           VerifyField<uint64_t>(verifier, VT_SIZE) &&
+           VerifyOffset(verifier, VT_BLOCKS) &&
+           verifier.VerifyVector(blocks()) &&
+           verifier.VerifyVectorOfTables(blocks()) &&
+           verifier.EndTable();
+  }
+};
+
+struct StaticMemoryPlanBufferBuilder {
+  typedef StaticMemoryPlanBuffer Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_device_type(int8_t device_type) {
+    fbb_.AddElement<int8_t>(StaticMemoryPlanBuffer::VT_DEVICE_TYPE, device_type, 0);
+  }
+  void add_device_mem_type(int8_t device_mem_type) {
+    fbb_.AddElement<int8_t>(StaticMemoryPlanBuffer::VT_DEVICE_MEM_TYPE, device_mem_type, 0);
+  }
+  void add_device_id(int16_t device_id) {
+    fbb_.AddElement<int16_t>(StaticMemoryPlanBuffer::VT_DEVICE_ID, device_id, 0);
+  }
+  void add_size(uint64_t size) {
+    fbb_.AddElement<uint64_t>(StaticMemoryPlanBuffer::VT_SIZE, size, 0);
+  }
+  void add_blocks(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::fbs::StaticMemoryPlanBlock>>> blocks) {
+    fbb_.AddOffset(StaticMemoryPlanBuffer::VT_BLOCKS, blocks);
+  }
+  explicit StaticMemoryPlanBufferBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  StaticMemoryPlanBufferBuilder &operator=(const StaticMemoryPlanBufferBuilder &);
+  flatbuffers::Offset<StaticMemoryPlanBuffer> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<StaticMemoryPlanBuffer>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<StaticMemoryPlanBuffer> CreateStaticMemoryPlanBuffer(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    int8_t device_type = 0,
+    int8_t device_mem_type = 0,
+    int16_t device_id = 0,
+    uint64_t size = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::fbs::StaticMemoryPlanBlock>>> blocks = 0) {
+  StaticMemoryPlanBufferBuilder builder_(_fbb);
+  builder_.add_size(size);
+  builder_.add_blocks(blocks);
+  builder_.add_device_id(device_id);
+  builder_.add_device_mem_type(device_mem_type);
+  builder_.add_device_type(device_type);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<StaticMemoryPlanBuffer> CreateStaticMemoryPlanBufferDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    int8_t device_type = 0,
+    int8_t device_mem_type = 0,
+    int16_t device_id = 0,
+    uint64_t size = 0,
+    const std::vector<flatbuffers::Offset<onnxruntime::fbs::StaticMemoryPlanBlock>> *blocks = nullptr) {
+  auto blocks__ = blocks ? _fbb.CreateVector<flatbuffers::Offset<onnxruntime::fbs::StaticMemoryPlanBlock>>(*blocks) : 0;
+  return onnxruntime::fbs::CreateStaticMemoryPlanBuffer(
+      _fbb,
+      device_type,
+      device_mem_type,
+      device_id,
+      size,
+      blocks__);
+}
+
+struct StaticMemoryPlanInput FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef StaticMemoryPlanInputBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_NAME = 4,
+    VT_DIMS = 6
+  };
+  const flatbuffers::String *name() const {
+    return GetPointer<const flatbuffers::String *>(VT_NAME);
+  }
+  const flatbuffers::Vector<int64_t> *dims() const {
+    return GetPointer<const flatbuffers::Vector<int64_t> *>(VT_DIMS);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_NAME) &&
+           verifier.VerifyString(name()) &&
+           VerifyOffset(verifier, VT_DIMS) &&
+           verifier.VerifyVector(dims()) &&
+           verifier.EndTable();
+  }
+};
+
+struct StaticMemoryPlanInputBuilder {
+  typedef StaticMemoryPlanInput Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_name(flatbuffers::Offset<flatbuffers::String> name) {
+    fbb_.AddOffset(StaticMemoryPlanInput::VT_NAME, name);
+  }
+  void add_dims(flatbuffers::Offset<flatbuffers::Vector<int64_t>> dims) {
+    fbb_.AddOffset(StaticMemoryPlanInput::VT_DIMS, dims);
+  }
+  explicit StaticMemoryPlanInputBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  StaticMemoryPlanInputBuilder &operator=(const StaticMemoryPlanInputBuilder &);
+  flatbuffers::Offset<StaticMemoryPlanInput> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<StaticMemoryPlanInput>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<StaticMemoryPlanInput> CreateStaticMemoryPlanInput(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::String> name = 0,
+    flatbuffers::Offset<flatbuffers::Vector<int64_t>> dims = 0) {
+  StaticMemoryPlanInputBuilder builder_(_fbb);
+  builder_.add_dims(dims);
+  builder_.add_name(name);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<StaticMemoryPlanInput> CreateStaticMemoryPlanInputDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const char *name = nullptr,
+    const std::vector<int64_t> *dims = nullptr) {
+  auto name__ = name ? _fbb.CreateString(name) : 0;
+  auto dims__ = dims ? _fbb.CreateVector<int64_t>(*dims) : 0;
+  return onnxruntime::fbs::CreateStaticMemoryPlanInput(
+      _fbb,
+      name__,
+      dims__);
+}
+
+struct StaticMemoryPlan FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef StaticMemoryPlanBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_INPUTS = 4,
+    VT_BUFFERS = 6
+  };
+  const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::fbs::StaticMemoryPlanInput>> *inputs() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::fbs::StaticMemoryPlanInput>> *>(VT_INPUTS);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::fbs::StaticMemoryPlanBuffer>> *buffers() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::fbs::StaticMemoryPlanBuffer>> *>(VT_BUFFERS);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_INPUTS) &&
+           verifier.VerifyVector(inputs()) &&
+           verifier.VerifyVectorOfTables(inputs()) &&
+           VerifyOffset(verifier, VT_BUFFERS) &&
+           verifier.VerifyVector(buffers()) &&
+           verifier.VerifyVectorOfTables(buffers()) &&
+           verifier.EndTable();
+  }
+};
+
+struct StaticMemoryPlanBuilder {
+  typedef StaticMemoryPlan Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_inputs(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::fbs::StaticMemoryPlanInput>>> inputs) {
+    fbb_.AddOffset(StaticMemoryPlan::VT_INPUTS, inputs);
+  }
+  void add_buffers(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::fbs::StaticMemoryPlanBuffer>>> buffers) {
+    fbb_.AddOffset(StaticMemoryPlan::VT_BUFFERS, buffers);
+  }
+  explicit StaticMemoryPlanBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  StaticMemoryPlanBuilder &operator=(const StaticMemoryPlanBuilder &);
+  flatbuffers::Offset<StaticMemoryPlan> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<StaticMemoryPlan>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<StaticMemoryPlan> CreateStaticMemoryPlan(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::fbs::StaticMemoryPlanInput>>> inputs = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::fbs::StaticMemoryPlanBuffer>>> buffers = 0) {
+  StaticMemoryPlanBuilder builder_(_fbb);
+  builder_.add_buffers(buffers);
+  builder_.add_inputs(inputs);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<StaticMemoryPlan> CreateStaticMemoryPlanDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<flatbuffers::Offset<onnxruntime::fbs::StaticMemoryPlanInput>> *inputs = nullptr,
+    const std::vector<flatbuffers::Offset<onnxruntime::fbs::StaticMemoryPlanBuffer>> *buffers = nullptr) {
+  auto inputs__ = inputs ? _fbb.CreateVector<flatbuffers::Offset<onnxruntime::fbs::StaticMemoryPlanInput>>(*inputs) : 0;
+  auto buffers__ = buffers ? _fbb.CreateVector<flatbuffers::Offset<onnxruntime::fbs::StaticMemoryPlanBuffer>>(*buffers) : 0;
+  return onnxruntime::fbs::CreateStaticMemoryPlan(
+      _fbb,
+      inputs__,
+      buffers__);
+}
+
 struct InferenceSession FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   typedef InferenceSessionBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_ORT_VERSION = 4,
     VT_MODEL = 6,
-    VT_KERNEL_TYPE_STR_RESOLVER = 10
+    VT_KERNEL_TYPE_STR_RESOLVER = 10,
+    VT_STATIC_MEMORY_PLAN = 12,
+    VT_PREPACKED_WEIGHTS_FILE = 14
   };
   const flatbuffers::String *ort_version() const {
     return GetPointer<const flatbuffers::String *>(VT_ORT_VERSION);
@@ -2995,6 +3320,12 @@ struct InferenceSession FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const onnxruntime::fbs::KernelTypeStrResolver *kernel_type_str_resolver() const {
     return GetPointer<const onnxruntime::fbs::KernelTypeStrResolver *>(VT_KERNEL_TYPE_STR_RESOLVER);
   }
+  const onnxruntime::fbs::StaticMemoryPlan *static_memory_plan() const {
+    return GetPointer<const onnxruntime::fbs::StaticMemoryPlan *>(VT_STATIC_MEMORY_PLAN);
+  }
+  const flatbuffers::String *prepacked_weights_file() const {
+    return GetPointer<const flatbuffers::String *>(VT_PREPACKED_WEIGHTS_FILE);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_ORT_VERSION) &&
@@ -3003,6 +3334,10 @@ struct InferenceSession FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            verifier.VerifyTable(model()) &&
            VerifyOffset(verifier, VT_KERNEL_TYPE_STR_RESOLVER) &&
            verifier.VerifyTable(kernel_type_str_resolver()) &&
+           VerifyOffset(verifier, VT_STATIC_MEMORY_PLAN) &&
+           verifier.VerifyTable(static_memory_plan()) &&
+           VerifyOffset(verifier, VT_PREPACKED_WEIGHTS_FILE) &&
+           verifier.VerifyString(prepacked_weights_file()) &&
            verifier.EndTable();
   }
 };
@@ -3020,6 +3355,12 @@ struct InferenceSessionBuilder {
   void add_kernel_type_str_resolver(flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver) {
     fbb_.AddOffset(InferenceSession::VT_KERNEL_TYPE_STR_RESOLVER, kernel_type_str_resolver);
   }
+  void add_static_memory_plan(flatbuffers::Offset<onnxruntime::fbs::StaticMemoryPlan> static_memory_plan) {
+    fbb_.AddOffset(InferenceSession::VT_STATIC_MEMORY_PLAN, static_memory_plan);
+  }
+  void add_prepacked_weights_file(flatbuffers::Offset<flatbuffers::String> prepacked_weights_file) {
+    fbb_.AddOffset(InferenceSession::VT_PREPACKED_WEIGHTS_FILE, prepacked_weights_file);
+  }
   explicit InferenceSessionBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -3036,8 +3377,12 @@ inline flatbuffers::Offset<InferenceSession> CreateInferenceSession(
     flatbuffers::FlatBufferBuilder &_fbb,
     flatbuffers::Offset<flatbuffers::String> ort_version = 0,
     flatbuffers::Offset<onnxruntime::fbs::Model> model = 0,
-    flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0) {
+    flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0,
+    flatbuffers::Offset<onnxruntime::fbs::StaticMemoryPlan> static_memory_plan = 0,
+    flatbuffers::Offset<flatbuffers::String> prepacked_weights_file = 0) {
   InferenceSessionBuilder builder_(_fbb);
+  builder_.add_prepacked_weights_file(prepacked_weights_file);
+  builder_.add_static_memory_plan(static_memory_plan);
   builder_.add_kernel_type_str_resolver(kernel_type_str_resolver);
   builder_.add_model(model);
   builder_.add_ort_version(ort_version);
@@ -3048,13 +3393,18 @@ inline flatbuffers::Offset<InferenceSession> CreateInferenceSessionDirect(
     flatbuffers::FlatBufferBuilder &_fbb,
     const char *ort_version = nullptr,
     flatbuffers::Offset<onnxruntime::fbs::Model> model = 0,
-    flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0) {
+    flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0,
+    flatbuffers::Offset<onnxruntime::fbs::StaticMemoryPlan> static_memory_plan = 0,
+    const char *prepacked_weights_file = nullptr) {
   auto ort_version__ = ort_version ? _fbb.CreateString(ort_version) : 0;
+  auto prepacked_weights_file__ = prepacked_weights_file ? _fbb.CreateString(prepacked_weights_file) : 0;
   return onnxruntime::fbs::CreateInferenceSession(
       _fbb,
       ort_version__,
       model,
-      kernel_type_str_resolver);
+      kernel_type_str_resolver,
+      static_memory_plan,
+      prepacked_weights_file__);
 }
 
 inline bool VerifyTypeInfoValue(flatbuffers::Verifier &verifier, const void *obj, TypeInfoValue type) {
@@ -98,6 +98,21 @@ class TensorSeq {
     Add(std::move(value));
   }
 
+  // Inserts the tensor before the element at index i, or appends it if i is Size().
+  void InsertAt(size_t i, Tensor&& tensor) {
+    ORT_ENFORCE(i <= tensors_.size());
+    ORT_ENFORCE(IsSameDataType(tensor),
+                "TensorSeq: tensor to be added has a different data type.");
+    OrtValue value;
+    Tensor::InitOrtValue(std::move(tensor), value);
+    tensors_.insert(tensors_.begin() + i, std::move(value));
+  }
+
+  void EraseAt(size_t i) {
+    ORT_ENFORCE(i < tensors_.size());
+    tensors_.erase(tensors_.begin() + i);
+  }
+
   static void InitOrtValue(const TensorSeq& source_tensor_seq, std::shared_ptr<IAllocator> allocator, OrtValue& ort_value) {
     auto target_tensor_seq = std::make_unique<TensorSeq>(source_tensor_seq.DataType());
     target_tensor_seq->Reserve(source_tensor_seq.Size());
@@ -0,0 +1,126 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/activation_pool.h"
+
+#include "core/common/logging/logging.h"
+#include "core/common/safeint.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace onnxruntime {
+
+namespace {
+// the pool must never be mistaken for a BFCArena, which code checking for OrtArenaAllocator casts to
+OrtMemoryInfo PoolMemoryInfo(const OrtMemoryInfo& block_info) {
+  return OrtMemoryInfo(block_info.name, OrtAllocatorType::OrtDeviceAllocator, block_info.device, block_info.id,
+                       block_info.mem_type);
+}
+}  // namespace
+
+ActivationPool::ActivationPool(AllocatorPtr block_allocator, size_t max_bytes,
+                               std::chrono::milliseconds admission_timeout)
+    : IAllocator(PoolMemoryInfo(block_allocator->Info())),
+      block_allocator_(std::move(block_allocator)),
+      max_bytes_(max_bytes),
+      admission_timeout_(admission_timeout) {
+  ORT_ENFORCE(max_bytes_ > 0, "Activation pool size must be positive.");
+  stats_.bytes_limit = static_cast<int64_t>(max_bytes_);
+}
+
+ActivationPool::~ActivationPool() {
+  if (!in_use_blocks_.empty()) {
+    LOGS_DEFAULT(ERROR) << "Activation pool destroyed with " << in_use_blocks_.size() << " blocks in use.";
+  }
+
+  for (auto& entry : free_blocks_) {
+    block_allocator_->Free(entry.second);
+  }
+}
+
+void* ActivationPool::Alloc(size_t size) {
+  if (size == 0) return nullptr;
+
+  const size_t block_size = (SafeInt<size_t>(size) + kBlockGranularity - 1) / kBlockGranularity * kBlockGranularity;
+  if (block_size > max_bytes_) {
+    ORT_THROW("Requested activation block of ", block_size, " bytes exceeds the activation pool size of ",
+              max_bytes_, " bytes.");
+  }
+
+  std::unique_lock<OrtMutex> lock(mutex_);
+  const auto deadline = std::chrono::steady_clock::now() + admission_timeout_;
+
+  for (;;) {
+    void* block = nullptr;
+    size_t taken_size = block_size;
+
+    auto best_fit = free_blocks_.lower_bound(block_size);
+    if (best_fit != free_blocks_.end()) {
+      taken_size = best_fit->first;
+      block = best_fit->second;
+      free_blocks_.erase(best_fit);
+    } else if (static_cast<size_t>(stats_.bytes_in_use) + block_size <= max_bytes_) {
+      // there is room once the cached blocks that are too small are released
+      EvictFreeBlocksLocked(block_size);
+      block = block_allocator_->Alloc(block_size);
+      if (block == nullptr) {
+        ORT_THROW("Failed to allocate an activation block of ", block_size, " bytes.");
+      }
+      pool_bytes_ += block_size;
+      stats_.total_allocated_bytes = static_cast<int64_t>(pool_bytes_);
+    }
+
+    if (block != nullptr) {
+      in_use_blocks_.emplace(block, taken_size);
+      ++stats_.num_allocs;
+      stats_.bytes_in_use += static_cast<int64_t>(taken_size);
+      stats_.max_bytes_in_use = std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
+      stats_.max_alloc_size = std::max(stats_.max_alloc_size, static_cast<int64_t>(taken_size));
+      return block;
+    }
+
+    // the pool is full of blocks used by other Runs. wait for one of them to finish.
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) {
+      ORT_THROW("Timed out waiting for ", block_size, " bytes in the activation pool. ", stats_.bytes_in_use,
+                " of ", max_bytes_, " bytes are used by other runs.");
+    }
+    block_returned_.wait_for(lock, deadline - now);
+  }
+}
+
+void ActivationPool::Free(void* p) {
+  if (p == nullptr) return;
+
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = in_use_blocks_.find(p);
+    ORT_ENFORCE(it != in_use_blocks_.end(), "Pointer was not allocated from this activation pool: ", p);
+    stats_.bytes_in_use -= static_cast<int64_t>(it->second);
+    free_blocks_.emplace(it->second, p);
+    in_use_blocks_.erase(it);
+  }
+
+  block_returned_.notify_all();
+}
+
+void ActivationPool::GetStats(AllocatorStats* stats) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  *stats = stats_;
+}
+
+void ActivationPool::EvictFreeBlocksLocked(size_t bytes_needed) {
+  // all cached blocks are smaller than bytes_needed, otherwise one of them would have been reused.
+  // evict the largest ones first to free the most memory with the fewest calls into the block allocator.
+  while (pool_bytes_ + bytes_needed > max_bytes_ && !free_blocks_.empty()) {
+    auto largest = std::prev(free_blocks_.end());
+    block_allocator_->Free(largest->second);
+    pool_bytes_ -= largest->first;
+    free_blocks_.erase(largest);
+  }
+
+  stats_.total_allocated_bytes = static_cast<int64_t>(pool_bytes_);
+}
+
+}  // namespace onnxruntime
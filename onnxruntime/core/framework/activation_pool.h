@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <unordered_map>
+
+#include "core/framework/allocator.h"
+#include "core/framework/allocator_stats.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+// Pool of activation blocks shared by the sessions of an environment.
+//
+// A Run that has a memory pattern needs one block per device, of the pattern's peak size. Sessions that share
+// the pool take this block from it instead of from their own arena and give it back when the Run ends, so the
+// memory held for activations is bounded by the pool size and scales with the number of concurrent Runs rather
+// than with the number of sessions.
+//
+// Returned blocks stay cached and are handed out best-fit. If no cached block is large enough, a new one is
+// allocated as long as the pool stays within max_bytes, evicting cached blocks that are too small if needed.
+// Otherwise Alloc() waits for another Run to return its block. After admission_timeout it throws, and the
+// ExecutionFrame falls back to allocating the activations individually from the session allocator.
+class ActivationPool : public IAllocator {
+ public:
+  ActivationPool(AllocatorPtr block_allocator, size_t max_bytes, std::chrono::milliseconds admission_timeout);
+
+  ~ActivationPool() override;
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+  void GetStats(AllocatorStats* stats) override;
+
+  // block sizes are rounded up to this so that Runs of models with similar peaks can share blocks
+  static constexpr size_t kBlockGranularity = 64 * 1024;
+
+ private:
+  void EvictFreeBlocksLocked(size_t bytes_needed);
+
+  const AllocatorPtr block_allocator_;
+  const size_t max_bytes_;
+  const std::chrono::milliseconds admission_timeout_;
+
+  OrtMutex mutex_;
+  OrtCondVar block_returned_;
+  std::multimap<size_t, void*> free_blocks_;          // cached blocks by size. GUARDED_BY(mutex_)
+  std::unordered_map<void*, size_t> in_use_blocks_;  // GUARDED_BY(mutex_)
+  size_t pool_bytes_ = 0;                            // bytes of cached and in use blocks. GUARDED_BY(mutex_)
+  AllocatorStats stats_;                             // GUARDED_BY(mutex_)
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ActivationPool);
+};
+
+}  // namespace onnxruntime
@@ -5,6 +5,8 @@
 #include <list>
 #include <algorithm>
 #include <deque>
+#include <functional>
+#include <queue>
 #include <sstream>
 #include <ctime>
 #include <iomanip>
@@ -97,7 +99,10 @@ std::ostream& operator<<(std::ostream& out, std::pair<const SequentialExecutionP
     if (0 <= index && static_cast<size_t>(index) < plan_size) {
       auto& elt_plan = plan.allocation_plan[index];
       out << elt_plan.alloc_kind;
-      if (elt_plan.alloc_kind == AllocKind::kReuse) out << " " << elt_plan.reused_buffer;
+      if (elt_plan.alloc_kind == AllocKind::kReuse) {
+        out << " " << elt_plan.reused_buffer;
+        if (elt_plan.is_sub_buffer) out << " at offset " << elt_plan.sub_buffer_offset;
+      }
       auto& loc = elt_plan.location;
       out << ", " << loc.ToString();
     } else {
@@ -205,6 +210,11 @@ class PlannerImpl {
   // ort_value_info_ is indexed by an OrtValueIndex
   std::vector<OrtValueInfo> ort_value_info_;
 
+  // Inputs of Concat nodes that are written in place in the Concat output, mapped to the Concat output and the byte
+  // offset of their slice of it. concat_outputs_ contains the outputs that have such inputs.
+  InlinedHashMap<OrtValueIndex, std::pair<OrtValueIndex, size_t>> concat_sub_buffers_;
+  InlinedHashSet<OrtValueIndex> concat_outputs_;
+
   // FreeBufferInfo is used to track information about ml-values whose buffers are
   // free to be reused.
   struct FreeBufferInfo {
@@ -327,6 +337,13 @@ class PlannerImpl {
         // we _must_ reuse this input to satisfy aliasing requirement: (e.g., for reshape)
         if ((0 <= pair.first) && (static_cast<size_t>(pair.first) < input_args.size())) {
           auto p_input_arg = input_args[pair.first];
+#ifdef ENABLE_STRIDED_TENSORS
+          // a strided input can't be aliased by a contiguous output. the output is a strided tensor below if
+          // the kernel supports that, otherwise the kernel copies the input to a buffer of its own.
+          if (p_input_arg->Exists() && AllocPlan(Index(p_input_arg->Name())).is_strided_tensor) {
+            continue;
+          }
+#endif
           if (p_input_arg->Exists()) {
             *reusable_input = Index(p_input_arg->Name());
             return true;
@@ -359,7 +376,8 @@ class PlannerImpl {
             auto input_arg_index = Index(p_input_arg->Name());
             auto original = Buffer(input_arg_index);
             if (1 == UseCount(original)) {
-              if (SameSize(*p_input_arg, *p_output_arg)) {
+              // a tensor sequence has no shape, its elements are held by the sequence and not by its buffer
+              if (SameSize(*p_input_arg, *p_output_arg) || SameSequenceType(*p_input_arg, *p_output_arg)) {
                 // we can reuse this input since it is its last use and permitted for in-place update
                 *reusable_input = input_arg_index;  // or original; both should be okay
                 return true;
@@ -374,35 +392,45 @@ class PlannerImpl {
     // If any output of the kernel can support strided tensor, and all its consumers' inputs also support
     // strided tensors at the corresponding position, this output will generate a strided tensor
     // and share the data from the corresponding input specified in MayStridedOutputsMap.
-    const auto& may_strided_outputs_map = ci.kernel_def->MayStridedOutput();
-    for (auto& pair : may_strided_outputs_map) {
-      if (pair.second == output_arg_num && pair.first >= 0 && static_cast<size_t>(pair.first) < input_args.size() &&
-          input_args[pair.first]->Exists()) {
-        bool can_strided = true;
-        for (auto it = node.OutputNodesBegin(); it != node.OutputNodesEnd(); ++it) {
-          const KernelCreateInfo& output_node_ci = GetKernelCreateInfo(kernel_create_info_map_, it->Index());
-          if (!output_node_ci.kernel_def) {
-            can_strided = false;
-            break;
-          }
-          const auto& may_strided_inputs = output_node_ci.kernel_def->MayStridedInput();
-          for (size_t i = 0; i < it->InputDefs().size(); ++i) {
-            if (it->InputDefs()[i] == p_output_arg && std::find(may_strided_inputs.begin(), may_strided_inputs.end(),
-                                                                static_cast<int>(i)) == may_strided_inputs.end()) {
-              can_strided = false;
-              break;
-            }
-          }
-          if (!can_strided) {
-            break;
-          }
+    // The first consumer that doesn't support strided tensors makes the kernel write a contiguous output instead.
+    auto can_strided = [&]() {
+      for (auto it = node.OutputNodesBegin(); it != node.OutputNodesEnd(); ++it) {
+        const KernelCreateInfo& output_node_ci = GetKernelCreateInfo(kernel_create_info_map_, it->Index());
+        if (!output_node_ci.kernel_def) {
+          return false;
         }
-        if (can_strided) {
-          *reusable_input = Index(input_args[pair.first]->Name());
-          *is_strided_tensor = true;
-          return true;
+        const auto& may_strided_inputs = output_node_ci.kernel_def->MayStridedInput();
+        for (size_t i = 0; i < it->InputDefs().size(); ++i) {
+          if (it->InputDefs()[i] == p_output_arg && std::find(may_strided_inputs.begin(), may_strided_inputs.end(),
+                                                              static_cast<int>(i)) == may_strided_inputs.end()) {
+            return false;
+          }
         }
       }
+      return true;
+    };
+
+    int strided_input_index = -1;
+    for (auto& pair : ci.kernel_def->MayStridedOutput()) {
+      if (pair.second == output_arg_num) {
+        strided_input_index = pair.first;
+        break;
+      }
+    }
+    if (strided_input_index < 0 && ci.kernel_def->VariadicMayStridedOutput().has_value()) {
+      strided_input_index = *ci.kernel_def->VariadicMayStridedOutput();
+    }
+
+    // A view of a strided input would be planned on the input's underlying buffer rather than on the view, which
+    // loses the input's byte offset, so such an output is written contiguously instead. The same goes for an input
+    // that is placed at an offset into another buffer.
+    if (strided_input_index >= 0 && static_cast<size_t>(strided_input_index) < input_args.size() &&
+        input_args[strided_input_index]->Exists() &&
+        !AllocPlan(Index(input_args[strided_input_index]->Name())).is_strided_tensor &&
+        !AllocPlan(Index(input_args[strided_input_index]->Name())).is_sub_buffer && can_strided()) {
+      *reusable_input = Index(input_args[strided_input_index]->Name());
+      *is_strided_tensor = true;
+      return true;
     }
 #endif
 
@@ -541,6 +569,139 @@ class PlannerImpl {
     return ci.kernel_def->HasExternalOutputs();
   }
 
+  // Returns the size in bytes of a tensor with a static shape, or nullopt if the shape is not static. If axis is
+  // given, the dims before it must be 1 so that a slice of the tensor along axis is contiguous.
+  std::optional<size_t> StaticSizeInBytes(const onnxruntime::NodeArg& arg, std::optional<int64_t> axis = {}) const {
+    const auto* shape = context_->GetShape(arg);
+    if (shape == nullptr || arg.TypeAsProto()->tensor_type().elem_type() ==
+                                ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+      return std::nullopt;
+    }
+
+    const int rank = shape->dim_size();
+    const int64_t contiguous_axis = axis.has_value() && *axis < 0 ? *axis + rank : axis.value_or(0);
+    if (contiguous_axis < 0 || (rank > 0 && contiguous_axis >= rank)) {
+      return std::nullopt;
+    }
+
+    SafeInt<size_t> size = GetElementSize(arg.Type());
+    for (int i = 0; i < rank; ++i) {
+      const auto& dim = shape->dim(i);
+      if (!utils::HasDimValue(dim) || dim.dim_value() < 0 || (i < contiguous_axis && dim.dim_value() != 1)) {
+        return std::nullopt;
+      }
+      size *= dim.dim_value();
+    }
+    return size;
+  }
+
+  // Returns true if the value produced by node can be placed in a buffer chosen by the planner, which means the
+  // kernel does not require the output to alias one of its inputs.
+  bool CanPlaceOutput(const Node& node) {
+    const KernelCreateInfo& ci = GetKernelCreateInfo(kernel_create_info_map_, node.Index());
+    return ci.kernel_def != nullptr && node.GetExecutionProviderType() == kCpuExecutionProvider &&
+           !node.ContainsSubgraph() && !ci.kernel_def->HasExternalOutputs() && GetAliasMap(node, ci).empty() &&
+           !ci.kernel_def->VariadicAlias().has_value();
+  }
+
+  // Finds the inputs of CPU Concat nodes that their producers can write in place in the Concat output, so the Concat
+  // does not copy them. The slice of the output for an input is contiguous only if the dims before the concat axis
+  // are 1. The inputs are placed in order until the first one whose size is not known at planning time.
+  void ComputeConcatSubBuffers() {
+    concat_sub_buffers_.clear();
+    concat_outputs_.clear();
+    if (!IsSingleStream() || context_->IsParallelExecutionEnabled() || !context_->GetEnableMemoryReuse()) {
+      return;
+    }
+
+    const auto& graph_outputs = graph_viewer_.GetOutputs();
+    auto is_graph_output = [&graph_outputs](const NodeArg* arg) {
+      return std::find(graph_outputs.begin(), graph_outputs.end(), arg) != graph_outputs.end();
+    };
+
+    for (auto node_index : graph_viewer_.GetNodesInTopologicalOrder(context_->GetExecutionOrder())) {
+      const auto* pnode = graph_viewer_.GetNode(node_index);
+      if (pnode == nullptr || pnode->OpType() != "Concat" || pnode->Domain() != kOnnxDomain ||
+          !CanPlaceOutput(*pnode)) {
+        continue;
+      }
+
+      const auto& attrs = pnode->GetAttributes();
+      const auto axis_attr = attrs.find("axis");
+      const NodeArg* output = pnode->OutputDefs()[0];
+      if (axis_attr == attrs.end() || !output->Exists() || IsNonTensor(*output) || is_graph_output(output) ||
+          !StaticSizeInBytes(*output, axis_attr->second.i()).has_value()) {
+        continue;
+      }
+
+      const auto output_idx = Index(output->Name());
+      const auto& output_location = AllocPlan(output_idx).location;
+      InlinedHashSet<const NodeArg*> seen_inputs;
+      size_t offset = 0;
+      for (const NodeArg* input : pnode->InputDefs()) {
+        const auto input_size = StaticSizeInBytes(*input);
+        if (!input_size.has_value()) {
+          break;
+        }
+
+        const auto input_idx = Index(input->Name());
+        const Node* producer = graph_viewer_.GetProducerNode(input->Name());
+        if (seen_inputs.insert(input).second && input->Type() == output->Type() && producer != nullptr &&
+            CanPlaceOutput(*producer) && concat_outputs_.count(input_idx) == 0 && !is_graph_output(input) &&
+            graph_viewer_.GetConsumerNodes(input->Name()).size() == 1 &&
+            AllocPlan(input_idx).location == output_location) {
+          concat_sub_buffers_[input_idx] = std::make_pair(output_idx, offset);
+          concat_outputs_.insert(output_idx);
+        }
+        offset += *input_size;
+      }
+    }
+  }
+
+  // Returns true and the byte offset into the Split input if the output_arg_num-th output of a CPU Split node can be
+  // a view of the input, which needs the slices of the input to be contiguous and of sizes known at planning time.
+  bool FindSplitSubBuffer(const Node& node, int output_arg_num, OrtValueIndex* input, size_t* offset) {
+    if (node.OpType() != "Split" || node.Domain() != kOnnxDomain ||
+        node.GetExecutionProviderType() != kCpuExecutionProvider) {
+      return false;
+    }
+
+    const NodeArg* input_arg = node.InputDefs()[0];
+    const auto input_idx = Index(input_arg->Name());
+    const auto& input_plan = AllocPlan(input_idx);
+    const auto& attrs = node.GetAttributes();
+    const auto axis_attr = attrs.find("axis");
+    if (input_plan.alloc_kind != AllocKind::kAllocate || Buffer(input_idx) != input_idx ||
+#ifdef ENABLE_STRIDED_TENSORS
+        input_plan.is_strided_tensor ||
+#endif
+        !StaticSizeInBytes(*input_arg, axis_attr == attrs.end() ? 0 : axis_attr->second.i()).has_value()) {
+      return false;
+    }
+
+    const auto& output_defs = node.OutputDefs();
+    size_t output_offset = 0;
+    for (int i = 0; i < output_arg_num; ++i) {
+      if (!output_defs[i]->Exists()) {
+        return false;
+      }
+      const auto output_size = StaticSizeInBytes(*output_defs[i]);
+      if (!output_size.has_value()) {
+        return false;
+      }
+      output_offset += *output_size;
+    }
+
+    if (output_defs[output_arg_num]->Type() != input_arg->Type() ||
+        !StaticSizeInBytes(*output_defs[output_arg_num]).has_value()) {
+      return false;
+    }
+
+    *input = input_idx;
+    *offset = output_offset;
+    return true;
+  }
+
   Status ComputePlanForInputsAndWeights() {
     auto setup_preexisting = [this](const NodeArg* node_arg) {
       auto input_index = Index(node_arg->Name());
@@ -1336,6 +1497,7 @@ class PlannerImpl {
       // use parallel execution context to generate a baseline first (no memory sharing)
       context_ = gsl::not_null<const ISequentialPlannerContext*>(&no_mem_reuse_context);
     }
+    ComputeConcatSubBuffers();
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
     // copy the use counts to a vector, before computing reuse
     std::vector<int> ort_value_usecount;
@@ -1398,6 +1560,7 @@ class PlannerImpl {
         // The the OrtValue indexed by current may reuse the memory in the OrtValue indexed by reused.
         OrtValueIndex reused;
         bool is_strided_tensor = false;
+        size_t sub_buffer_offset = 0;
         if (has_external_outputs) {
           ORT_ENFORCE(!IsNonTensor(*node_output), "Only tensors are supported for external outputs for now.");
           AllocPlan(current).alloc_kind = AllocKind::kAllocatedExternally;
@@ -1437,6 +1600,15 @@ class PlannerImpl {
               }
             }
           }
+        } else if (concat_sub_buffers_.count(current) > 0) {
+          // the producer writes the value in place in its slice of the Concat output
+          const auto& sub_buffer = concat_sub_buffers_[current];
+          Reuse(sub_buffer.first, current, AllocKind::kReuse);
+          AllocPlan(current).is_sub_buffer = true;
+          AllocPlan(current).sub_buffer_offset = sub_buffer.second;
+        } else if (concat_outputs_.count(current) > 0) {
+          // the buffer is in use from when the first input placed in it is produced, so it can't be a free one
+          AllocPlan(current).alloc_kind = AllocKind::kAllocate;
         } else if (!context_->IsParallelExecutionEnabled() &&
                    FindReusableInput(*pnode, static_cast<int>(output_arg_def_index), &reused, &is_strided_tensor)) {
           // Re-using inputs is applicable for tensors, sequence tensors,
@@ -1444,6 +1616,11 @@ class PlannerImpl {
           // possible candidates for re-use
           Reuse(reused, current, AllocKind::kReuse);
           ort_value_info_[current].is_inplace_reuse = true;
+          // a value sharing the buffer of a sub-buffer value has the same offset into the underlying buffer
+          if (AllocPlan(reused).is_sub_buffer) {
+            AllocPlan(current).is_sub_buffer = true;
+            AllocPlan(current).sub_buffer_offset = AllocPlan(reused).sub_buffer_offset;
+          }
 #ifdef ENABLE_STRIDED_TENSORS
           if (is_strided_tensor) AllocPlan(current).is_strided_tensor = true;
 #else
@@ -1454,6 +1631,12 @@ class PlannerImpl {
 #endif
         } else if (IsNonTensor(*node_output)) {
           AllocPlan(current).alloc_kind = AllocKind::kAllocate;
+        } else if (!context_->IsParallelExecutionEnabled() && context_->GetEnableMemoryReuse() &&
+                   FindSplitSubBuffer(*pnode, static_cast<int>(output_arg_def_index), &reused, &sub_buffer_offset)) {
+          // the output is a view of its slice of the Split input, so the Split does not copy it
+          Reuse(reused, current, AllocKind::kReuse);
+          AllocPlan(current).is_sub_buffer = true;
+          AllocPlan(current).sub_buffer_offset = sub_buffer_offset;
         } else if (!context_->IsParallelExecutionEnabled() &&
                    FindReusableTensor(*node_output, &reused)) {
           // Reuse an available (dead) buffer for this output, this is only for sequential execution.
@@ -1521,8 +1704,15 @@ class PlannerImpl {
         if (!node_output->Exists()) continue;
         // OrtValue index of the considered output NodeArg.
         const auto current = Index(node_output->Name());
-        if (AllocPlan(current).alloc_kind == AllocKind::kAllocate) {
-          AllocPlan(current).program_counter.AddStart(program_counter);
+        const auto& alloc_plan = AllocPlan(current);
+        // the buffer of a Concat output is in use from when the first input placed in it is produced
+        const auto buffer = alloc_plan.alloc_kind == AllocKind::kReuse && alloc_plan.is_sub_buffer
+                                ? alloc_plan.reused_buffer
+                                : current;
+        auto& buffer_program_counter = AllocPlan(buffer).program_counter;
+        if (AllocPlan(buffer).alloc_kind == AllocKind::kAllocate &&
+            buffer_program_counter.Starts().size() == buffer_program_counter.Ends().size()) {
+          buffer_program_counter.AddStart(program_counter);
         }
       }
 
@@ -1742,6 +1932,71 @@ class PlannerImpl {
     return Status::OK();
   }
 
+  // Find the node inputs that are dead once the node has run: the node statically releases their buffer and reads
+  // it through a single input only. A kernel may write an output of the same shape and type into such a buffer.
+  // This must run after GenerateDeallocationPlan.
+  Status ComputeDyingInputs() {
+    plan_.node_dying_inputs.resize(plan_.node_release_list.size());
+    InlinedHashSet<OrtValueIndex> released;
+    InlinedHashMap<OrtValueIndex, int> buffer_reads;
+    for (size_t node_index = 0; node_index < plan_.node_release_list.size(); ++node_index) {
+      const auto& release_list = plan_.node_release_list[node_index];
+      const auto* node = graph_viewer_.GetNode(node_index);
+      if (release_list.empty() || node == nullptr) {
+        continue;
+      }
+
+      released.clear();
+      for (auto action_idx : release_list) {
+        const auto& release_action = plan_.release_actions[action_idx];
+        // a ref counted release may happen after a consumer on another stream, so it isn't known to be dead here
+        if (release_action.ref_count == 1) {
+          released.insert(static_cast<OrtValueIndex>(release_action.value_index));
+        }
+      }
+      if (released.empty()) {
+        continue;
+      }
+
+      buffer_reads.clear();
+      auto count_read = [&](const NodeArg& input, size_t /*arg_idx*/) {
+        if (input.Exists()) {
+          OrtValueIndex value_idx;
+          ORT_RETURN_IF_ERROR(ort_value_name_idx_map_.GetIdx(input.Name(), value_idx));
+          ++buffer_reads[Buffer(value_idx)];
+        }
+        return Status::OK();
+      };
+      ORT_RETURN_IF_ERROR(Node::ForEachWithIndex(node->InputDefs(), count_read));
+      ORT_RETURN_IF_ERROR(Node::ForEachWithIndex(node->ImplicitInputDefs(), count_read));
+
+      const auto& input_defs = node->InputDefs();
+      for (size_t i = 0, end = input_defs.size(); i < end; ++i) {
+        const auto& input = *input_defs[i];
+        if (!input.Exists() || IsNonTensor(input)) {
+          continue;
+        }
+
+        auto value_idx = Index(input.Name());
+        const auto& alloc_plan = AllocPlan(value_idx);
+        // only values that own their buffer. a value sharing a buffer may have a different shape or be strided.
+        if (Buffer(value_idx) != value_idx || alloc_plan.alloc_kind != AllocKind::kAllocate) {
+          continue;
+        }
+#ifdef ENABLE_STRIDED_TENSORS
+        if (alloc_plan.is_strided_tensor) {
+          continue;
+        }
+#endif
+        if (released.count(value_idx) > 0 && buffer_reads[value_idx] == 1) {
+          plan_.node_dying_inputs[node_index].push_back(static_cast<int>(i));
+        }
+      }
+    }
+
+    return Status::OK();
+  }
+
 #ifndef ORT_ENABLE_STREAM
   void PartitionIntoStreams(const logging::Logger& /*logger*/,
                             const ExecutionProviders& /*execution_providers*/,
@@ -1749,7 +2004,7 @@ class PlannerImpl {
     if (graph_viewer_.NumberOfNodes() > 0) {
       stream_nodes_.push_back({});
       node_stream_map_.resize(SafeInt<size_t>(graph_viewer_.MaxNodeIndex()) + 1);
-      for (auto node_index : graph_viewer_.GetNodesInTopologicalOrder()) {
+      for (auto node_index : graph_viewer_.GetNodesInTopologicalOrder(context_->GetExecutionOrder())) {
         stream_nodes_[0].push_back(node_index);
         node_stream_map_[node_index] = 0;
       }
@@ -2110,6 +2365,14 @@ class PlannerImpl {
     return !utils::HasTensorType(type_proto);
   }
 
+  static bool SameSequenceType(const onnxruntime::NodeArg& arg1, const onnxruntime::NodeArg& arg2) {
+    const auto* type_proto1 = arg1.TypeAsProto();
+    const auto* type_proto2 = arg2.TypeAsProto();
+    return type_proto1 != nullptr && type_proto2 != nullptr &&
+           type_proto1->value_case() == ONNX_NAMESPACE::TypeProto::kSequenceType &&
+           arg1.Type() == arg2.Type();
+  }
+
 #if !defined(DISABLE_OPTIONAL_TYPE)
   static bool IsOptionalType(const onnxruntime::NodeArg& nodearg) {
     const auto* type_proto = nodearg.TypeAsProto();
@@ -2149,6 +2412,18 @@ Status PlannerImpl::CreatePlan(
 #endif
     const PathString& partition_config_file,
     const logging::Logger& logger) {
+#if !defined(ORT_MINIMAL_BUILD)
+  if (context_->GetExecutionOrder() == ExecutionOrder::MEMORY_EFFICIENT &&
+      logger.OutputIsEnabled(logging::Severity::kVERBOSE, logging::DataType::SYSTEM)) {
+    const auto default_peak = graph_viewer_.EstimatePeakMemoryUsage(graph_viewer_.GetNodesInTopologicalOrder());
+    const auto memory_efficient_peak = graph_viewer_.EstimatePeakMemoryUsage(
+        graph_viewer_.GetNodesInTopologicalOrder(ExecutionOrder::MEMORY_EFFICIENT));
+    LOGS(logger, VERBOSE) << "Estimated peak bytes of live node outputs for graph " << graph_viewer_.Name()
+                          << ": " << default_peak << " with the default order, " << memory_efficient_peak
+                          << " with the memory efficient order.";
+  }
+#endif
+
   // 1. partition graph into streams
   PartitionIntoStreams(logger, execution_providers_, this->parent_node_ ? PathString{} : partition_config_file);
 
@@ -2184,6 +2459,9 @@ Status PlannerImpl::CreatePlan(
   // convert information in the freelist_ into a deallocation plan in required format
   ORT_RETURN_IF_ERROR(GenerateDeallocationPlan());
 
+  // find the inputs a kernel may overwrite as nothing reads them after the kernel runs
+  ORT_RETURN_IF_ERROR(ComputeDyingInputs());
+
   // generate program counter
 #ifdef ENABLE_TRAINING
   ORT_RETURN_IF_ERROR(CalculateProgramCounter());
@@ -2406,6 +2684,335 @@ void DeviceBasedPartitioner::SaveConfig() const {
   }
 }
 
+/*
+CostBasedPartitioner spreads the CPU nodes of wide graphs, e.g. the towers of a recommendation model, over several
+streams, so that independent branches run concurrently on the inter op threads in ORT_PARALLEL mode.
+Nodes placed on other devices get one stream per device type, as with DeviceBasedPartitioner.
+Its config in json format:
+------------------------------------------------------
+{
+"type":"CostBasedPartitioner",
+"num_streams":4,
+"sync_cost":5.0,
+"profile_file":"onnxruntime_profile.json",
+"node_costs":{"node_1":120.5,"node_2":3.0}
+}
+------------------------------------------------------
+All fields but "type" are optional. Costs are in microseconds.
+"num_streams" is the maximum number of CPU streams, the number of physical cores by default.
+"sync_cost" is the cost of waiting on a node of another stream.
+"profile_file" is the output of a previous profiled Run, whose node kernel durations are used as node costs.
+"node_costs" gives node costs explicitly, overriding the profile.
+Nodes without a cost get a static estimate from their FLOP count.
+
+Nodes are list scheduled: among the nodes whose inputs are all scheduled, the one with the longest path to the end
+of the graph goes first, onto the stream where it can start earliest.
+*/
+class CostBasedPartitioner : public IGraphPartitioner {
+ public:
+  CostBasedPartitioner(const logging::Logger& logger,
+                       const PathString& config_file) : IGraphPartitioner(logger, config_file) {
+    Initialize();
+  }
+
+  Status PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
+                        const ExecutionProviders& execution_providers,
+                        std::vector<InlinedVector<NodeIndex>>& stream_nodes,
+                        ExecutionOrder execution_order) override;
+
+  const char* Type() const override { return "CostBasedPartitioner"; }
+  size_t Streams() const override { return num_streams_used_; }
+
+ private:
+  void Initialize();
+  void LoadProfile(const std::string& profile_file);
+  double NodeCost(const Node& node) const;
+
+  // assumed throughput for static estimates, in FLOPs per microsecond
+  static constexpr double kStaticFlopsPerMicrosecond = 10000.0;
+
+  size_t max_cpu_streams_ = 0;
+  double sync_cost_ = 5.0;
+  InlinedHashMap<std::string, double> node_costs_;
+  size_t num_streams_used_ = 0;
+};
+
+namespace {
+// number of elements of a fully static shape, or -1
+double NumElements(const NodeArg* arg) {
+  if (arg == nullptr || !arg->Exists() || arg->Shape() == nullptr) {
+    return -1.0;
+  }
+  double num_elements = 1.0;
+  for (const auto& dim : arg->Shape()->dim()) {
+    if (!utils::HasDimValue(dim)) {
+      return -1.0;
+    }
+    num_elements *= static_cast<double>(dim.dim_value());
+  }
+  return num_elements;
+}
+
+double EstimateNodeFlops(const Node& node) {
+  double output_elements = 0.0;
+  for (const auto* output : node.OutputDefs()) {
+    output_elements += std::max(NumElements(output), 0.0);
+  }
+  if (output_elements == 0.0) {
+    // dynamic shapes: treat the node as a cheap elementwise op of moderate size
+    return 1024.0;
+  }
+
+  const auto& op_type = node.OpType();
+  const auto& inputs = node.InputDefs();
+  if ((op_type == "MatMul" || op_type == "Gemm" || op_type == "FusedMatMul" || op_type == "MatMulInteger") &&
+      !inputs.empty() && inputs[0]->Shape() != nullptr && inputs[0]->Shape()->dim_size() > 0) {
+    const auto& shape = *inputs[0]->Shape();
+    // the reduced dimension is the last one of A, or the first one for a transposed Gemm input
+    const auto trans_a = node.GetAttributes().find("transA");
+    const bool transposed = op_type == "Gemm" && trans_a != node.GetAttributes().end() && trans_a->second.i() != 0;
+    const auto& k_dim = shape.dim(transposed ? 0 : shape.dim_size() - 1);
+    if (utils::HasDimValue(k_dim)) {
+      return 2.0 * output_elements * static_cast<double>(k_dim.dim_value());
+    }
+  } else if ((op_type == "Conv" || op_type == "FusedConv" || op_type == "ConvInteger") && inputs.size() > 1) {
+    // weight is [M, C/group, k1, k2, ...], each output element needs C/group * k1 * k2 ... MACs
+    const double weight_elements = NumElements(inputs[1]);
+    const auto* weight_shape = inputs[1]->Shape();
+    if (weight_elements > 0.0 && weight_shape->dim_size() > 0 && weight_shape->dim(0).dim_value() > 0) {
+      return 2.0 * output_elements * weight_elements / static_cast<double>(weight_shape->dim(0).dim_value());
+    }
+  }
+  return output_elements;
+}
+
+// node name used to match config entries. same as DeviceBasedPartitioner, but unnamed nodes use their index.
+std::string PartitionNodeName(const Node& node) {
+  return node.Name().empty() ? node.OpType() + "_" + std::to_string(node.Index()) : node.Name();
+}
+}  // namespace
+
+double CostBasedPartitioner::NodeCost(const Node& node) const {
+  auto it = node_costs_.find(PartitionNodeName(node));
+  if (it != node_costs_.end()) {
+    return it->second;
+  }
+  return EstimateNodeFlops(node) / kStaticFlopsPerMicrosecond;
+}
+
+Status CostBasedPartitioner::PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
+                                            const ExecutionProviders& execution_providers,
+                                            std::vector<InlinedVector<NodeIndex>>& stream_nodes,
+                                            ExecutionOrder execution_order) {
+  const auto& p_graph_nodes = graph_viewer.GetNodesInTopologicalOrder(execution_order);
+  const size_t max_node_index = graph_viewer.MaxNodeIndex();
+
+  std::vector<double> cost(max_node_index, 0.0);
+  std::vector<double> rank(max_node_index, 0.0);
+  std::vector<OrtDevice::DeviceType> device_type(max_node_index, OrtDevice::CPU);
+  std::vector<size_t> num_pending_inputs(max_node_index, 0);
+
+  const auto for_each_consumer = [&graph_viewer](const Node& node, const std::function<void(const Node&)>& fn) {
+    for (auto it = node.OutputNodesBegin(), end = node.OutputNodesEnd(); it != end; ++it) {
+      // skip nodes filtered out of the graph viewer
+      if (graph_viewer.GetNode(it->Index()) != nullptr) {
+        fn(*it);
+      }
+    }
+  };
+
+  for (auto node_index : p_graph_nodes) {
+    const auto* node = graph_viewer.GetNode(node_index);
+    const auto* ep = execution_providers.Get(*node);
+    device_type[node_index] = ep->GetOrtDeviceByMemType(OrtMemType::OrtMemTypeDefault).Type();
+    cost[node_index] = NodeCost(*node);
+    for_each_consumer(*node, [&](const Node& consumer) { ++num_pending_inputs[consumer.Index()]; });
+  }
+
+  // upward rank: the cost of the longest path from the start of a node to the end of the graph
+  for (auto it = p_graph_nodes.rbegin(); it != p_graph_nodes.rend(); ++it) {
+    double longest_tail = 0.0;
+    for_each_consumer(*graph_viewer.GetNode(*it), [&](const Node& consumer) {
+      longest_tail = std::max(longest_tail, rank[consumer.Index()]);
+    });
+    rank[*it] = cost[*it] + longest_tail;
+  }
+
+  const size_t max_cpu_streams = max_cpu_streams_ > 0
+                                     ? max_cpu_streams_
+                                     : static_cast<size_t>(std::max(1, Env::Default().GetNumPhysicalCpuCores()));
+
+  // streams are created on first use. the CPU ones are found through cpu_streams, the others by device type.
+  std::vector<InlinedVector<NodeIndex>> streams;
+  std::vector<double> stream_end;
+  InlinedVector<size_t> cpu_streams;
+  InlinedHashMap<OrtDevice::DeviceType, size_t> device_streams;
+  std::vector<size_t> node_stream(max_node_index, 0);
+  std::vector<double> node_end(max_node_index, 0.0);
+
+  const auto new_stream = [&]() {
+    streams.emplace_back();
+    stream_end.push_back(0.0);
+    return streams.size() - 1;
+  };
+
+  // the earliest start of a node on a stream: when the stream is free and the node's inputs are ready there
+  const auto earliest_start = [&](const Node& node, size_t stream, double stream_free) {
+    double start = stream_free;
+    for (auto it = node.InputNodesBegin(), end = node.InputNodesEnd(); it != end; ++it) {
+      const NodeIndex producer = it->Index();
+      if (graph_viewer.GetNode(producer) != nullptr) {
+        start = std::max(start, node_end[producer] + (node_stream[producer] == stream ? 0.0 : sync_cost_));
+      }
+    }
+    return start;
+  };
+
+  // ready nodes by rank. ties go to the earlier node of the execution order, which keeps the schedule stable.
+  std::vector<size_t> order_position(max_node_index, 0);
+  for (size_t i = 0; i < p_graph_nodes.size(); ++i) {
+    order_position[p_graph_nodes[i]] = i;
+  }
+  const auto lower_priority = [&](NodeIndex a, NodeIndex b) {
+    return rank[a] != rank[b] ? rank[a] < rank[b] : order_position[a] > order_position[b];
+  };
+  std::priority_queue<NodeIndex, std::vector<NodeIndex>, decltype(lower_priority)> ready(lower_priority);
+  for (auto node_index : p_graph_nodes) {
+    if (num_pending_inputs[node_index] == 0) {
+      ready.push(node_index);
+    }
+  }
+
+  while (!ready.empty()) {
+    const NodeIndex node_index = ready.top();
+    ready.pop();
+    const auto& node = *graph_viewer.GetNode(node_index);
+
+    size_t best_stream = 0;
+    double best_start = 0.0;
+    if (device_type[node_index] == OrtDevice::CPU) {
+      bool found = false;
+      for (size_t stream : cpu_streams) {
+        const double start = earliest_start(node, stream, stream_end[stream]);
+        if (!found || start < best_start) {
+          found = true;
+          best_stream = stream;
+          best_start = start;
+        }
+      }
+      // only open another stream if the node would start earlier on it
+      if (cpu_streams.size() < max_cpu_streams) {
+        const size_t candidate = streams.size();
+        const double start = earliest_start(node, candidate, 0.0);
+        if (!found || start < best_start) {
+          best_stream = new_stream();
+          best_start = start;
+          cpu_streams.push_back(best_stream);
+        }
+      }
+    } else {
+      auto it = device_streams.find(device_type[node_index]);
+      if (it == device_streams.end()) {
+        it = device_streams.emplace(device_type[node_index], new_stream()).first;
+      }
+      best_stream = it->second;
+      best_start = earliest_start(node, best_stream, stream_end[best_stream]);
+    }
+
+    streams[best_stream].push_back(node_index);
+    node_stream[node_index] = best_stream;
+    node_end[node_index] = best_start + cost[node_index];
+    stream_end[best_stream] = node_end[node_index];
+
+    for_each_consumer(node, [&](const Node& consumer) {
+      if (--num_pending_inputs[consumer.Index()] == 0) {
+        ready.push(consumer.Index());
+      }
+    });
+  }
+
+  size_t num_scheduled = 0;
+  for (const auto& stream : streams) {
+    num_scheduled += stream.size();
+  }
+  ORT_RETURN_IF_NOT(num_scheduled == p_graph_nodes.size(), "CostBasedPartitioner scheduled ", num_scheduled,
+                    " of ", p_graph_nodes.size(), " nodes");
+
+  double critical_path = 0.0;
+  for (double end : stream_end) {
+    critical_path = std::max(critical_path, end);
+  }
+  LOGS(logger_, INFO) << "CostBasedPartitioner placed " << p_graph_nodes.size() << " nodes on " << streams.size()
+                      << " streams, " << cpu_streams.size() << " of them CPU. Estimated makespan: "
+                      << critical_path << "us";
+
+  num_streams_used_ = streams.size();
+  stream_nodes = std::move(streams);
+  return Status::OK();
+}
+
+void CostBasedPartitioner::Initialize() {
+  std::ifstream if_stream(config_file_);
+  if (!if_stream.is_open()) {
+    LOGS(logger_, WARNING) << "Unable to read the CostBasedPartitioner config. Using static cost estimates.";
+    return;
+  }
+  ORT_TRY {
+    json json_config = json::parse(if_stream);
+    if (json_config.contains("num_streams")) {
+      max_cpu_streams_ = json_config["num_streams"].get<size_t>();
+    }
+    if (json_config.contains("sync_cost")) {
+      sync_cost_ = json_config["sync_cost"].get<double>();
+    }
+    if (json_config.contains("profile_file")) {
+      LoadProfile(json_config["profile_file"].get<std::string>());
+    }
+    if (json_config.contains("node_costs")) {
+      for (const auto& entry : json_config["node_costs"].items()) {
+        node_costs_[entry.key()] = entry.value().get<double>();
+      }
+    }
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      LOGS(logger_, WARNING) << "Caught exception when reading CostBasedPartitioner config: " << ex.what();
+    });
+  }
+}
+
+void CostBasedPartitioner::LoadProfile(const std::string& profile_file) {
+  std::ifstream if_stream(profile_file);
+  if (!if_stream.is_open()) {
+    LOGS(logger_, WARNING) << "Unable to read profile file " << profile_file;
+    return;
+  }
+
+  // the profiler writes an array of chrome trace events. kernel executions are "Node" events
+  // named "<node name>_kernel_time", with their duration in microseconds.
+  constexpr std::string_view kKernelTimeSuffix = "_kernel_time";
+  InlinedHashMap<std::string, std::pair<double, size_t>> durations;
+  json events = json::parse(if_stream);
+  for (const auto& event : events) {
+    if (!event.contains("cat") || event["cat"] != "Node" || !event.contains("name") || !event.contains("dur")) {
+      continue;
+    }
+    const std::string name = event["name"].get<std::string>();
+    if (name.size() <= kKernelTimeSuffix.size() ||
+        name.compare(name.size() - kKernelTimeSuffix.size(), kKernelTimeSuffix.size(), kKernelTimeSuffix) != 0) {
+      continue;
+    }
+    auto& duration = durations[name.substr(0, name.size() - kKernelTimeSuffix.size())];
+    duration.first += event["dur"].get<double>();
+    ++duration.second;
+  }
+
+  // a profile usually covers several runs, use the mean
+  for (const auto& entry : durations) {
+    node_costs_[entry.first] = entry.second.first / static_cast<double>(entry.second.second);
+  }
+}
+
 std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(const logging::Logger& logger,
                                                                              const PathString& config_file) {
   // use device based partitioner by default
@@ -2420,6 +3027,8 @@ std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(con
           auto type = json_config["type"];
           if (type == "DeviceBasedPartitioner") {
             partitioner_type = IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition;
+          } else if (type == "CostBasedPartitioner") {
+            partitioner_type = IGraphPartitioner::GraphPartitioningStrategy::CostBasedPartition;
           }
         }
       } catch (const std::exception& ex) {
@@ -2431,6 +3040,9 @@ std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(con
   if (partitioner_type == IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition) {
     LOGS(logger, INFO) << "Use DeviceBasedPartition as default";
     return std::make_unique<DeviceBasedPartitioner>(logger, config_file);
+  } else if (partitioner_type == IGraphPartitioner::GraphPartitioningStrategy::CostBasedPartition) {
+    LOGS(logger, INFO) << "Use CostBasedPartition";
+    return std::make_unique<CostBasedPartitioner>(logger, config_file);
   }  // else if other partitioner types ...
   ORT_THROW("Failed to create partitioner");
 }
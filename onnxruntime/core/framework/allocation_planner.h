@@ -82,9 +82,11 @@ class IGraphPartitioner {
   // DeviceBasedPartitioner is the default, who partitions a graph based off device information.
   // i.e., given a graph which has CPU EP nodes, Cuda EP nodes and TRT EP nodes,
   // it will be partitioned as two sequences, one is for CPU EP nodes, another is for TRT and Cuda nodes.
-  // We will add more optimized partitioner later.
+  // CostBasedPartitioner additionally spreads CPU nodes over several streams to shorten the critical path,
+  // using profiled or estimated node costs.
   enum GraphPartitioningStrategy {
     DeviceBasedPartition = 0,
+    CostBasedPartition,
     Unknown,
   };
   virtual ~IGraphPartitioner() = default;
@@ -5,6 +5,7 @@
 
 #include <string>
 #include <sstream>
+#include <vector>
 
 namespace onnxruntime {
 
@@ -22,6 +23,13 @@ struct AllocatorStats {
                                   // is known. Certain allocator may return 0 to indicate the limit is
                                   // unknown.
   int64_t bytes_limit;
+  int64_t num_slab_allocs;     // Number of allocations served by the small allocation slab cache (not in num_allocs)
+  int64_t slab_bytes_in_use;   // Number of slab cache bytes in use (not included in bytes_in_use)
+  int64_t slab_region_bytes;   // Size of the region backing the slab cache (included in total_allocated_bytes)
+  int64_t num_regions;         // Number of memory regions currently held (Relevant only for arena based allocators)
+  int64_t largest_free_chunk;  // Size of the largest free chunk (Relevant only for arena based allocators)
+  // Free bytes per size bin, indexed by bin number. Empty for allocators without bins.
+  std::vector<int64_t> free_bytes_per_bin;
 
   AllocatorStats() { Clear(); }
 
@@ -35,6 +43,12 @@ struct AllocatorStats {
     this->max_alloc_size = 0;
     this->bytes_limit = 0;
     this->total_allocated_bytes = 0;
+    this->num_slab_allocs = 0;
+    this->slab_bytes_in_use = 0;
+    this->slab_region_bytes = 0;
+    this->num_regions = 0;
+    this->largest_free_chunk = 0;
+    this->free_bytes_per_bin.clear();
   }
 
   std::string DebugString() const {
@@ -47,7 +61,19 @@ struct AllocatorStats {
        << "NumReserves:              " << this->num_reserves << "\n"
        << "NumArenaExtensions:       " << this->num_arena_extensions << "\n"
        << "NumArenaShrinkages:       " << this->num_arena_shrinkages << "\n"
-       << "MaxAllocSize:             " << this->max_alloc_size << "\n";
+       << "MaxAllocSize:             " << this->max_alloc_size << "\n"
+       << "NumSlabAllocs:            " << this->num_slab_allocs << "\n"
+       << "SlabInUse:                " << this->slab_bytes_in_use << "\n"
+       << "SlabRegionSize:           " << this->slab_region_bytes << "\n"
+       << "NumRegions:               " << this->num_regions << "\n"
+       << "LargestFreeChunk:         " << this->largest_free_chunk << "\n";
+    if (!this->free_bytes_per_bin.empty()) {
+      ss << "FreeBytesPerBin:         ";
+      for (int64_t free_bytes : this->free_bytes_per_bin) {
+        ss << " " << free_bytes;
+      }
+      ss << "\n";
+    }
     return ss.str();
   }
 };
@@ -32,6 +32,15 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
     int64_t max_power_of_two_extend_bytes = info.arena_cfg.max_power_of_two_extend_bytes == -1
                                                 ? BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES
                                                 : info.arena_cfg.max_power_of_two_extend_bytes;
+    int slab_max_alloc_bytes = info.arena_cfg.slab_max_alloc_bytes == -1
+                                   ? BFCArena::DEFAULT_SLAB_MAX_ALLOC_BYTES
+                                   : info.arena_cfg.slab_max_alloc_bytes;
+    int64_t slab_region_bytes = info.arena_cfg.slab_region_bytes == -1
+                                    ? BFCArena::DEFAULT_SLAB_REGION_BYTES
+                                    : info.arena_cfg.slab_region_bytes;
+    int slab_thread_cache_blocks = info.arena_cfg.slab_thread_cache_blocks == -1
+                                       ? BFCArena::DEFAULT_SLAB_THREAD_CACHE_BLOCKS
+                                       : info.arena_cfg.slab_thread_cache_blocks;
     ArenaExtendStrategy arena_extend_str;
     switch (info.arena_cfg.arena_extend_strategy) {
       case static_cast<int>(ArenaExtendStrategy::kSameAsRequested):
@@ -68,7 +77,10 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
                                      initial_chunk_size_bytes,
                                      max_dead_bytes_per_chunk,
                                      initial_growth_chunk_size_bytes,
-                                     max_power_of_two_extend_bytes));
+                                     max_power_of_two_extend_bytes,
+                                     slab_max_alloc_bytes,
+                                     slab_region_bytes,
+                                     slab_thread_cache_blocks));
     }
   } else {
     return device_allocator;
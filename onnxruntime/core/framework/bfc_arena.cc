@@ -3,6 +3,7 @@
 
 #include "core/framework/allocator.h"
 #include "core/framework/bfc_arena.h"
+#include <algorithm>
 #include <type_traits>
 
 namespace onnxruntime {
@@ -12,7 +13,10 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                    int initial_chunk_size_bytes,
                    int max_dead_bytes_per_chunk,
                    int initial_growth_chunk_size_bytes,
-                   int64_t max_power_of_two_extend_bytes)
+                   int64_t max_power_of_two_extend_bytes,
+                   int slab_max_alloc_bytes,
+                   int64_t slab_region_bytes,
+                   int slab_thread_cache_blocks)
     : IAllocator(OrtMemoryInfo(resource_allocator->Info().name,
                                OrtAllocatorType::OrtArenaAllocator,
                                resource_allocator->Info().device,
@@ -32,7 +36,10 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                      << " initial_growth_chunk_size_bytes: " << initial_growth_chunk_size_bytes_
                      << " max_power_of_two_extend_bytes: " << max_power_of_two_extend_bytes_
                      << " memory limit: " << total_memory
-                     << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy);
+                     << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy)
+                     << " slab_max_alloc_bytes: " << slab_max_alloc_bytes
+                     << " slab_region_bytes: " << slab_region_bytes
+                     << " slab_thread_cache_blocks: " << slab_thread_cache_blocks;
 
   // static_cast<std::underlying_type_t<ArenaExtendStrategy>>(arena_extend_strategy); doesn't work on this compiler
 
@@ -75,6 +82,24 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       ORT_ENFORCE(BinForSize(bin_size * 2) != BinFromIndex(b));
     }
   }
+
+  if (slab_max_alloc_bytes > 0) {
+    ORT_ENFORCE(slab_max_alloc_bytes <= MAX_SLAB_MAX_ALLOC_BYTES,
+                "slab_max_alloc_bytes must not exceed ", MAX_SLAB_MAX_ALLOC_BYTES, ". Got ", slab_max_alloc_bytes);
+    ORT_ENFORCE(slab_region_bytes > 0, "slab_region_bytes must be positive when the slab cache is enabled");
+    ORT_ENFORCE(slab_thread_cache_blocks >= 0, "slab_thread_cache_blocks must not be negative");
+    // Round the region to whole pages. It counts against the memory limit like any other region.
+    const size_t region_bytes = SafeInt<size_t>(
+        (static_cast<size_t>(slab_region_bytes) + SlabCache::kPageSize - 1) / SlabCache::kPageSize) *
+                                SlabCache::kPageSize;
+    ORT_ENFORCE(region_bytes <= memory_limit_, "slab_region_bytes of ", region_bytes,
+                " exceeds the arena memory limit of ", memory_limit_);
+    void* region = device_allocator_->Alloc(region_bytes);
+    ORT_ENFORCE(region != nullptr, "Failed to allocate the slab cache region of ", region_bytes, " bytes");
+    slab_cache_ = std::make_shared<SlabCache>(region, region_bytes, static_cast<size_t>(slab_max_alloc_bytes),
+                                              static_cast<size_t>(slab_thread_cache_blocks));
+    stats_.total_allocated_bytes += static_cast<int64_t>(region_bytes);
+  }
 }
 
 BFCArena::~BFCArena() {
@@ -86,6 +111,10 @@ BFCArena::~BFCArena() {
     device_allocator_->Free(reserve_chunk.first);
   }
 
+  if (slab_cache_) {
+    device_allocator_->Free(slab_cache_->region());
+  }
+
   for (BinNum b = 0; b < kNumBins; b++) {
     BinFromIndex(b)->~Bin();
   }
@@ -268,7 +297,206 @@ size_t BFCArena::RoundedBytes(size_t bytes) {
   return rounded_bytes;
 }
 
+namespace {
+// number of power of two size classes, starting at kMinAllocationSize, needed to cover max_alloc_bytes
+int NumSlabClasses(size_t max_alloc_bytes, size_t min_allocation_size) {
+  int num_classes = 1;
+  while ((min_allocation_size << (num_classes - 1)) < max_alloc_bytes) {
+    ++num_classes;
+  }
+  return num_classes;
+}
+
+std::atomic<uint64_t> next_slab_cache_id{1};
+}  // namespace
+
+// Holds the magazines of one thread. An entry is keyed by the id of the SlabCache it belongs to and keeps a weak
+// reference to it, so blocks can be handed back on thread exit if the cache is still alive.
+struct BFCArena::SlabCache::ThreadMagazines {
+  struct Entry {
+    uint64_t cache_id;
+    std::weak_ptr<SlabCache> cache;
+    Magazines magazines;
+  };
+
+  ~ThreadMagazines() {
+    for (auto& entry : entries) {
+      if (auto cache = entry.cache.lock()) {
+        for (int c = 0; c < cache->num_classes_; ++c) {
+          auto& magazine = entry.magazines[c];
+          cache->FlushMagazine(c, magazine, magazine.size());
+        }
+      }
+    }
+  }
+
+  std::vector<Entry> entries;
+  // index of the most recently used entry
+  size_t last = 0;
+};
+
+BFCArena::SlabCache::SlabCache(void* region, size_t region_bytes, size_t max_alloc_bytes,
+                               size_t thread_cache_blocks)
+    : region_(static_cast<char*>(region)),
+      region_bytes_(region_bytes),
+      num_pages_(region_bytes / kPageSize),
+      num_classes_(NumSlabClasses(max_alloc_bytes, kMinAllocationSize)),
+      thread_cache_blocks_(thread_cache_blocks),
+      id_(next_slab_cache_id.fetch_add(1, std::memory_order_relaxed)),
+      page_class_(std::make_unique<std::atomic<int>[]>(num_pages_)) {
+  ORT_ENFORCE(region_bytes % kPageSize == 0);
+  ORT_ENFORCE(num_classes_ <= kMaxNumClasses);
+  for (size_t i = 0; i < num_pages_; ++i) {
+    page_class_[i].store(-1, std::memory_order_relaxed);
+  }
+}
+
+int BFCArena::SlabCache::ClassForSize(size_t bytes) const {
+  if (bytes > ClassToSize(num_classes_ - 1)) {
+    return -1;
+  }
+  // round up to the next power of two size class
+  int size_class = 0;
+  while (ClassToSize(size_class) < bytes) {
+    ++size_class;
+  }
+  return size_class;
+}
+
+BFCArena::SlabCache::Magazines& BFCArena::SlabCache::GetThreadMagazines() {
+  thread_local ThreadMagazines thread_magazines;
+  auto& entries = thread_magazines.entries;
+  if (thread_magazines.last < entries.size() && entries[thread_magazines.last].cache_id == id_) {
+    return entries[thread_magazines.last].magazines;
+  }
+
+  for (size_t i = 0; i < entries.size(); ++i) {
+    if (entries[i].cache_id == id_) {
+      thread_magazines.last = i;
+      return entries[i].magazines;
+    }
+  }
+
+  // drop entries of caches that no longer exist before adding a new one. their blocks were released with the region.
+  entries.erase(std::remove_if(entries.begin(), entries.end(),
+                               [](const ThreadMagazines::Entry& entry) { return entry.cache.expired(); }),
+                entries.end());
+  auto& entry = entries.emplace_back();
+  entry.cache_id = id_;
+  entry.cache = weak_from_this();
+  for (auto& magazine : entry.magazines) {
+    magazine.reserve(thread_cache_blocks_ + 1);
+  }
+  thread_magazines.last = entries.size() - 1;
+  return entry.magazines;
+}
+
+bool BFCArena::SlabCache::AddPageLocked(int size_class, SizeClass& sc) {
+  // grab a fresh page from the region and split it into blocks of this size class
+  const size_t page = next_page_.fetch_add(1, std::memory_order_relaxed);
+  if (page >= num_pages_) {
+    return false;
+  }
+  page_class_[page].store(size_class, std::memory_order_release);
+  const size_t block_size = ClassToSize(size_class);
+  char* page_start = region_ + page * kPageSize;
+  const size_t blocks_per_page = kPageSize / block_size;
+  sc.free_blocks.reserve(sc.free_blocks.size() + blocks_per_page);
+  // push in reverse so blocks are handed out in address order
+  for (size_t i = blocks_per_page; i > 0; --i) {
+    sc.free_blocks.push_back(page_start + (i - 1) * block_size);
+  }
+  return true;
+}
+
+bool BFCArena::SlabCache::RefillMagazine(int size_class, std::vector<void*>& magazine, size_t count) {
+  SizeClass& sc = classes_[size_class];
+  std::lock_guard<OrtMutex> lock(sc.mutex);
+  if (sc.free_blocks.empty() && !AddPageLocked(size_class, sc)) {
+    return false;
+  }
+  const size_t n = std::min(count, sc.free_blocks.size());
+  magazine.insert(magazine.end(), sc.free_blocks.end() - n, sc.free_blocks.end());
+  sc.free_blocks.resize(sc.free_blocks.size() - n);
+  return true;
+}
+
+void BFCArena::SlabCache::FlushMagazine(int size_class, std::vector<void*>& magazine, size_t count) {
+  if (count == 0) {
+    return;
+  }
+  SizeClass& sc = classes_[size_class];
+  std::lock_guard<OrtMutex> lock(sc.mutex);
+  sc.free_blocks.insert(sc.free_blocks.end(), magazine.end() - count, magazine.end());
+  magazine.resize(magazine.size() - count);
+}
+
+void* BFCArena::SlabCache::Alloc(int size_class) {
+  void* p = nullptr;
+  if (thread_cache_blocks_ > 0) {
+    auto& magazine = GetThreadMagazines()[size_class];
+    if (magazine.empty() && !RefillMagazine(size_class, magazine, std::max<size_t>(thread_cache_blocks_ / 2, 1))) {
+      return nullptr;
+    }
+    p = magazine.back();
+    magazine.pop_back();
+  } else {
+    SizeClass& sc = classes_[size_class];
+    std::lock_guard<OrtMutex> lock(sc.mutex);
+    if (sc.free_blocks.empty() && !AddPageLocked(size_class, sc)) {
+      return nullptr;
+    }
+    p = sc.free_blocks.back();
+    sc.free_blocks.pop_back();
+  }
+  num_allocs_.fetch_add(1, std::memory_order_relaxed);
+  bytes_in_use_.fetch_add(static_cast<int64_t>(ClassToSize(size_class)), std::memory_order_relaxed);
+  return p;
+}
+
+size_t BFCArena::SlabCache::BlockSize(const void* p) const {
+  const size_t page = static_cast<size_t>(static_cast<const char*>(p) - region_) / kPageSize;
+  const int size_class = page_class_[page].load(std::memory_order_acquire);
+  ORT_ENFORCE(size_class >= 0, "Pointer ", p, " was not allocated from the slab cache");
+  return ClassToSize(size_class);
+}
+
+void BFCArena::SlabCache::Free(void* p) {
+  const size_t page = static_cast<size_t>(static_cast<char*>(p) - region_) / kPageSize;
+  const int size_class = page_class_[page].load(std::memory_order_acquire);
+  ORT_ENFORCE(size_class >= 0, "Pointer ", p, " was not allocated from the slab cache");
+  if (thread_cache_blocks_ > 0) {
+    // the block goes to the freeing thread's magazine. once it overflows half of it is handed back in one batch.
+    auto& magazine = GetThreadMagazines()[size_class];
+    magazine.push_back(p);
+    if (magazine.size() > thread_cache_blocks_) {
+      FlushMagazine(size_class, magazine, magazine.size() / 2);
+    }
+  } else {
+    SizeClass& sc = classes_[size_class];
+    std::lock_guard<OrtMutex> lock(sc.mutex);
+    sc.free_blocks.push_back(p);
+  }
+  bytes_in_use_.fetch_sub(static_cast<int64_t>(ClassToSize(size_class)), std::memory_order_relaxed);
+}
+
+void BFCArena::SlabCache::GetStats(AllocatorStats* stats) const {
+  stats->num_slab_allocs = num_allocs_.load(std::memory_order_relaxed);
+  stats->slab_bytes_in_use = bytes_in_use_.load(std::memory_order_relaxed);
+  stats->slab_region_bytes = static_cast<int64_t>(region_bytes_);
+}
+
 void* BFCArena::Alloc(size_t size) {
+  // Small stream-less requests are served by the slab cache without taking lock_.
+  if (slab_cache_ && size != 0) {
+    const int size_class = slab_cache_->ClassForSize(size);
+    if (size_class >= 0) {
+      void* p = slab_cache_->Alloc(size_class);
+      if (p != nullptr) {
+        return p;
+      }
+    }
+  }
   return AllocateRawInternal(size, false, nullptr, false, nullptr);
 }
 
@@ -293,6 +521,10 @@ void* BFCArena::Reserve(size_t size) {
 }
 
 size_t BFCArena::RequestedSize(const void* ptr) {
+  // the slab cache does not track requested sizes so the block size is reported
+  if (slab_cache_ && slab_cache_->Owns(ptr)) {
+    return slab_cache_->BlockSize(ptr);
+  }
   std::lock_guard<OrtMutex> lock(lock_);
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
@@ -301,6 +533,9 @@ size_t BFCArena::RequestedSize(const void* ptr) {
 }
 
 size_t BFCArena::AllocatedSize(const void* ptr) {
+  if (slab_cache_ && slab_cache_->Owns(ptr)) {
+    return slab_cache_->BlockSize(ptr);
+  }
   std::lock_guard<OrtMutex> lock(lock_);
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
@@ -379,6 +614,26 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<OrtMutex> lock(lock_);
   *stats = stats_;
+  if (slab_cache_) {
+    slab_cache_->GetStats(stats);
+  }
+
+  // Fragmentation metrics. Free chunks are kept sorted by size within a bin, so the largest free chunk
+  // is the last one of the highest non-empty bin.
+  stats->num_regions = static_cast<int64_t>(region_manager_.regions().size());
+  stats->largest_free_chunk = 0;
+  stats->free_bytes_per_bin.assign(kNumBins, 0);
+  for (BinNum b = 0; b < kNumBins; b++) {
+    const Bin* bin = BinFromIndex(b);
+    int64_t free_bytes = 0;
+    for (ChunkHandle h : bin->free_chunks) {
+      free_bytes += static_cast<int64_t>(ChunkFromHandle(h)->size);
+    }
+    stats->free_bytes_per_bin[b] = free_bytes;
+    if (!bin->free_chunks.empty()) {
+      stats->largest_free_chunk = static_cast<int64_t>(ChunkFromHandle(*bin->free_chunks.rbegin())->size);
+    }
+  }
 }
 
 BFCArena::Chunk* BFCArena::SplitFreeChunkFromBin(BFCArena::Bin::FreeChunkSet* free_chunks,
@@ -496,6 +751,10 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
+  if (slab_cache_ && slab_cache_->Owns(p)) {
+    slab_cache_->Free(p);
+    return;
+  }
   std::lock_guard<OrtMutex> lock(lock_);
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
@@ -510,16 +769,70 @@ void BFCArena::Free(void* p) {
 
 Status BFCArena::Shrink() {
   std::lock_guard<OrtMutex> lock(lock_);
+  ReleaseFreeRegions();
+  return Status::OK();
+}
+
+Status BFCArena::Compact() {
+  std::lock_guard<OrtMutex> lock(lock_);
+
+  // The caller guarantees that no work is in flight, so the stream a free chunk was last used on no longer matters.
+  // Dropping it lets neighbouring free chunks from different streams merge, and lets whole regions become one chunk.
+  for (const auto& region : region_manager_.regions()) {
+    ChunkHandle h = region_manager_.get_handle(region.ptr());
+    while (h != kInvalidChunkHandle) {
+      Chunk* c = ChunkFromHandle(h);
+      if (!c->in_use()) {
+        c->stream = nullptr;
+        c->stream_timestamp = 0;
+      }
+      h = c->next;
+    }
+  }
+
+  for (const auto& region : region_manager_.regions()) {
+    ChunkHandle h = region_manager_.get_handle(region.ptr());
+    while (h != kInvalidChunkHandle) {
+      Chunk* c = ChunkFromHandle(h);
+      if (!c->in_use() && c->next != kInvalidChunkHandle && !ChunkFromHandle(c->next)->in_use()) {
+        RemoveFreeChunkFromBin(h);
+        while (c->next != kInvalidChunkHandle && !ChunkFromHandle(c->next)->in_use()) {
+          RemoveFreeChunkFromBin(c->next);
+          Merge(h, c->next);
+          c = ChunkFromHandle(h);
+        }
+        InsertFreeChunkIntoBin(h);
+      }
+      h = c->next;
+    }
+  }
+
+  ReleaseFreeRegions();
+  return Status::OK();
+}
+
+void BFCArena::ReleaseFreeRegions() {
   auto num_regions = region_manager_.regions().size();
   std::vector<void*> region_ptrs;
   std::vector<size_t> region_sizes;
   region_ptrs.reserve(num_regions);
   region_sizes.reserve(num_regions);
 
-  for (const auto& region : region_manager_.regions()) {
-    if (consider_first_allocation_region_for_shrinkage_ || region.id() != 0) {
-      region_ptrs.push_back(region.ptr());
-      region_sizes.push_back(region.memory_size());
+  // Visit the most recently added regions first. With kNextPowerOfTwo they are the largest ones,
+  // so the bulk of the resident memory goes back to the device allocator first.
+  const auto& regions = region_manager_.regions();
+  std::vector<const AllocationRegion*> regions_by_age;
+  regions_by_age.reserve(num_regions);
+  for (const auto& region : regions) {
+    regions_by_age.push_back(&region);
+  }
+  std::sort(regions_by_age.begin(), regions_by_age.end(),
+            [](const AllocationRegion* a, const AllocationRegion* b) { return a->id() > b->id(); });
+
+  for (const AllocationRegion* region : regions_by_age) {
+    if (consider_first_allocation_region_for_shrinkage_ || region->id() != 0) {
+      region_ptrs.push_back(region->ptr());
+      region_sizes.push_back(region->memory_size());
     }
   }
 
@@ -569,8 +882,6 @@ Status BFCArena::Shrink() {
   // Will affect how the arena grows if the arena extend strategy is kNextPowerOfTwo
   // In case the extend strategy is kSameAsRequested, the arena growth is exactly the size of the memory request itself
   curr_region_allocation_bytes_ = initial_growth_chunk_size_bytes_;
-
-  return Status::OK();
 }
 
 void BFCArena::DeallocateRawInternal(void* ptr) {
@@ -16,6 +16,7 @@ limitations under the License.
 
 #pragma once
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <sstream>
@@ -61,6 +62,10 @@ class BFCArena : public IAllocator {
   static const int DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES = 2 * 1024 * 1024;
   static const int64_t DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES = 1024 * 1024 * 1024;  // 1GB
   static const size_t DEFAULT_MAX_MEM = std::numeric_limits<size_t>::max();
+  static const int DEFAULT_SLAB_MAX_ALLOC_BYTES = 0;  // slab cache disabled
+  static const int64_t DEFAULT_SLAB_REGION_BYTES = 4 * 1024 * 1024;
+  static const int DEFAULT_SLAB_THREAD_CACHE_BLOCKS = 0;  // per-thread magazines disabled
+  static constexpr int MAX_SLAB_MAX_ALLOC_BYTES = 16 * 1024;
 
   enum ArenaType {
     BaseArena,
@@ -73,7 +78,10 @@ class BFCArena : public IAllocator {
            int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
            int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
            int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
-           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES);
+           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+           int slab_max_alloc_bytes = DEFAULT_SLAB_MAX_ALLOC_BYTES,
+           int64_t slab_region_bytes = DEFAULT_SLAB_REGION_BYTES,
+           int slab_thread_cache_blocks = DEFAULT_SLAB_THREAD_CACHE_BLOCKS);
 
   ~BFCArena() override;
 
@@ -93,6 +101,12 @@ class BFCArena : public IAllocator {
   // and the allocation request.
   Status Shrink();
 
+  // Coalesces all adjacent free chunks, including ones last used on different streams, and then frees
+  // every allocation region left without a chunk in use, most recently added regions first.
+  // Intended for long running processes to return memory while the arena is idle:
+  // the caller must ensure no allocation from this arena is pending on any stream.
+  Status Compact();
+
   void* Reserve(size_t size) override;
 
   void GetStats(AllocatorStats* stats) override;
@@ -362,6 +376,93 @@ class BFCArena : public IAllocator {
     std::vector<AllocationRegion> regions_;
   };
 
+  // SlabCache serves small, stream-less allocations from fixed-size free lists.
+  //
+  // A single contiguous region is obtained from the device allocator when the arena is created. The region is
+  // carved into pages on demand and each page is dedicated to one power-of-two size class between
+  // kMinAllocationSize and max_alloc_bytes. Every size class has its own mutex, so small allocations never
+  // take BFCArena::lock_ and never split or merge chunks. Ownership of a pointer is a range check against the
+  // region, which keeps Free() cheap. When the region is exhausted allocations fall back to the BFC bins.
+  //
+  // The free lists live in host memory so the cache works for device memory that is not host accessible.
+  //
+  // If thread_cache_blocks is positive every thread additionally keeps a magazine of up to that many blocks per
+  // size class. Alloc() and Free() only touch the calling thread's magazine; blocks move between the magazine and
+  // the shared per size class free list in batches of half a magazine, so concurrent Run() calls rarely contend.
+  // Blocks in a thread's magazine are returned to the shared free list when the thread exits.
+  //
+  // This class is thread-safe.
+  class SlabCache : public std::enable_shared_from_this<SlabCache> {
+   public:
+    static constexpr size_t kPageSize = 64 * 1024;
+    static constexpr int kMaxNumClasses = 7;  // kMinAllocationSize << 6 == MAX_SLAB_MAX_ALLOC_BYTES
+
+    SlabCache(void* region, size_t region_bytes, size_t max_alloc_bytes, size_t thread_cache_blocks);
+
+    // Returns the size class for 'bytes' or -1 if the request is too large for the cache.
+    int ClassForSize(size_t bytes) const;
+
+    static size_t ClassToSize(int size_class) { return kMinAllocationSize << size_class; }
+
+    // Returns nullptr if there is no free block left for 'size_class'.
+    void* Alloc(int size_class);
+
+    void Free(void* p);
+
+    bool Owns(const void* p) const {
+      return p >= region_ && p < region_ + region_bytes_;
+    }
+
+    size_t BlockSize(const void* p) const;
+
+    void* region() const { return region_; }
+    size_t region_bytes() const { return region_bytes_; }
+
+    void GetStats(AllocatorStats* stats) const;
+
+   private:
+    struct SizeClass {
+      OrtMutex mutex;
+      std::vector<void*> free_blocks;
+    };
+
+    using Magazines = std::array<std::vector<void*>, kMaxNumClasses>;
+    // thread_local registry of the magazines a thread holds for each live SlabCache. see bfc_arena.cc
+    struct ThreadMagazines;
+
+    // Returns the calling thread's magazines for this cache, creating them on first use.
+    Magazines& GetThreadMagazines();
+
+    // Moves up to 'count' blocks of 'size_class' from the shared free list to 'magazine', carving a new page if
+    // needed. Returns false if the region is exhausted and no block could be moved.
+    bool RefillMagazine(int size_class, std::vector<void*>& magazine, size_t count);
+
+    // Moves the last 'count' blocks of 'magazine' to the shared free list of 'size_class'.
+    void FlushMagazine(int size_class, std::vector<void*>& magazine, size_t count);
+
+    // Adds one fresh page to the shared free list of 'size_class'. Requires the size class mutex to be held.
+    bool AddPageLocked(int size_class, SizeClass& sc);
+
+    char* const region_;
+    const size_t region_bytes_;
+    const size_t num_pages_;
+    const int num_classes_;
+    const size_t thread_cache_blocks_;
+    // distinguishes this cache from a later one allocated at the same address
+    const uint64_t id_;
+
+    // next page of the region that has not been handed to a size class yet
+    std::atomic<size_t> next_page_{0};
+    // size class each page was handed to. only valid for pages below next_page_.
+    std::unique_ptr<std::atomic<int>[]> page_class_;
+    std::array<SizeClass, kMaxNumClasses> classes_;
+
+    std::atomic<int64_t> num_allocs_{0};
+    std::atomic<int64_t> bytes_in_use_{0};
+
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SlabCache);
+  };
+
   // Returns 'bytes' rounded up to the next highest kMinAllocationSize.
   size_t RoundedBytes(size_t bytes);
 
@@ -390,6 +491,10 @@ class BFCArena : public IAllocator {
   // possible.
   void FreeAndMaybeCoalesce(ChunkHandle h);
 
+  // Frees the allocation regions that have no chunk in use. Shared by Shrink() and Compact().
+  // REQUIRES: lock_ is held.
+  void ReleaseFreeRegions();
+
   BFCArena::ChunkHandle Coalesce(ChunkHandle h);
 
   // Adds the chunk 'h' to the proper free bin.
@@ -504,6 +609,10 @@ class BFCArena : public IAllocator {
 
   std::unordered_map<void*, size_t> reserved_chunks_;
 
+  // Optional front-end for small allocations. Immutable after construction.
+  // Shared ownership lets thread-local magazines detect that the cache has been destroyed.
+  std::shared_ptr<SlabCache> slab_cache_;
+
   const int initial_chunk_size_bytes_;
   const int max_dead_bytes_per_chunk_;
   const int initial_growth_chunk_size_bytes_;
@@ -0,0 +1,322 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/cost_based_cpu_fallback.h"
+
+#include <optional>
+#include <queue>
+
+#include "core/common/gsl.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/data_types.h"
+#include "core/framework/kernel_registry_manager.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/framework/utils.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// The costs are in units of one tensor element processed by a CPU kernel. The constants are rough estimates for a
+// discrete GPU attached over PCIe. They only need to order the choices, not to predict the run time.
+constexpr double kDeviceSpeedup = 10.0;
+constexpr double kCopyCostPerByte = 0.25;
+// The launch and synchronization of one copy, which dominates for small values.
+constexpr double kCopyLatency = 10000.0;
+
+struct RegionCosts {
+  double on_device;
+  double on_cpu;
+};
+
+std::optional<int64_t> StaticElementCount(const NodeArg& arg) {
+  const auto* shape = arg.Shape();
+  if (shape == nullptr) {
+    return std::nullopt;
+  }
+
+  int64_t count = 1;
+  for (const auto& dim : shape->dim()) {
+    if (!utils::HasDimValue(dim) || dim.dim_value() < 0) {
+      return std::nullopt;
+    }
+    count *= dim.dim_value();
+  }
+  return count;
+}
+
+std::optional<int64_t> StaticDim(const NodeArg& arg, int axis) {
+  const auto* shape = arg.Shape();
+  if (shape == nullptr) {
+    return std::nullopt;
+  }
+
+  const int rank = shape->dim_size();
+  axis = axis < 0 ? axis + rank : axis;
+  if (axis < 0 || axis >= rank || !utils::HasDimValue(shape->dim(axis))) {
+    return std::nullopt;
+  }
+  return shape->dim(axis).dim_value();
+}
+
+std::optional<double> CopyCost(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  const auto count = StaticElementCount(arg);
+  if (type == nullptr || !type->has_tensor_type() || !count.has_value() ||
+      type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+    return std::nullopt;
+  }
+
+  const auto* tensor_type = DataTypeImpl::TypeFromProto(*type)->AsTensorType();
+  if (tensor_type == nullptr) {
+    return std::nullopt;
+  }
+  return kCopyLatency +
+         kCopyCostPerByte * static_cast<double>(*count) * static_cast<double>(tensor_type->GetElementType()->Size());
+}
+
+// Estimated cost of running the node on CPU: the number of elements it reads and writes, plus the multiply-adds of the
+// ops that compute dot products.
+std::optional<double> ComputeCost(const Node& node) {
+  double cost = 0.0;
+  bool known_sizes = true;
+  const auto add_elements = [&cost, &known_sizes](const NodeArg& arg, size_t) {
+    const auto count = StaticElementCount(arg);
+    known_sizes = known_sizes && count.has_value();
+    cost += static_cast<double>(count.value_or(0));
+    return Status::OK();
+  };
+  ORT_IGNORE_RETURN_VALUE(Node::ForEachWithIndex(node.InputDefs(), add_elements));
+  ORT_IGNORE_RETURN_VALUE(Node::ForEachWithIndex(node.OutputDefs(), add_elements));
+  if (!known_sizes) {
+    return std::nullopt;
+  }
+
+  const auto& inputs = node.InputDefs();
+  const auto& op_type = node.OpType();
+  std::optional<int64_t> reduction_size;
+  if (op_type == "MatMul" || op_type == "FusedMatMul") {
+    reduction_size = StaticDim(*inputs[0], -1);
+  } else if (op_type == "Gemm") {
+    const auto& attributes = node.GetAttributes();
+    const auto trans_a = attributes.find("transA");
+    reduction_size = StaticDim(*inputs[0], trans_a != attributes.end() && trans_a->second.i() != 0 ? 0 : 1);
+  } else if ((op_type == "Conv" || op_type == "ConvTranspose") && inputs.size() > 1) {
+    const auto weight_size = StaticElementCount(*inputs[1]);
+    const auto channels = StaticDim(*inputs[1], 0);
+    if (weight_size.has_value() && channels.has_value() && *channels > 0) {
+      reduction_size = *weight_size / *channels;
+    }
+  }
+
+  if (reduction_size.has_value()) {
+    cost += static_cast<double>(*StaticElementCount(*node.OutputDefs()[0])) * static_cast<double>(*reduction_size);
+  }
+  return cost;
+}
+
+const KernelCreateInfo* FindKernel(const Node& node, const KernelRegistryManager& kernel_registry_mgr) {
+  const KernelCreateInfo* kci = nullptr;
+  ORT_IGNORE_RETURN_VALUE(kernel_registry_mgr.SearchKernelRegistry(node, &kci));
+  return kci;
+}
+
+// Returns true if producer writes arg to the memory of the device of provider_type.
+bool ProducedOnDevice(const Node& producer, const NodeArg& arg, const std::string& provider_type,
+                      const KernelRegistryManager& kernel_registry_mgr) {
+  if (producer.GetExecutionProviderType() != provider_type) {
+    return false;
+  }
+
+  const auto& outputs = producer.OutputDefs();
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    if (outputs[i] == &arg) {
+      return !utils::IsOutputOnCpu(producer, FindKernel(producer, kernel_registry_mgr), i);
+    }
+  }
+  return false;
+}
+
+// Returns true if consumer reads arg from the memory of the device of provider_type.
+bool ConsumedOnDevice(const Node& consumer, const NodeArg& arg, const std::string& provider_type,
+                      const KernelRegistryManager& kernel_registry_mgr) {
+  if (consumer.GetExecutionProviderType() != provider_type) {
+    return false;
+  }
+
+  const KernelCreateInfo* kci = FindKernel(consumer, kernel_registry_mgr);
+  const auto& inputs = consumer.InputDefs();
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (inputs[i] == &arg && !utils::IsInputOnCpu(consumer, kci, i)) {
+      return true;
+    }
+  }
+
+  // implicit inputs are copied to the device of the node that has the subgraph
+  for (const NodeArg* implicit_input : consumer.ImplicitInputDefs()) {
+    if (implicit_input == &arg) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Estimates the cost of running the region on its device and on CPU, including the copies of the values that cross
+// the boundary of the region. Values that are on neither CPU nor the device of the region are treated as on CPU.
+std::optional<RegionCosts> EstimateRegionCosts(const Graph& graph, gsl::span<Node* const> region,
+                                               const InlinedHashSet<NodeIndex>& region_nodes,
+                                               const std::string& provider_type,
+                                               const KernelRegistryManager& kernel_registry_mgr) {
+  RegionCosts costs{0.0, 0.0};
+  for (const Node* node : region) {
+    const auto compute_cost = ComputeCost(*node);
+    if (!compute_cost.has_value()) {
+      return std::nullopt;
+    }
+    costs.on_device += *compute_cost / kDeviceSpeedup;
+    costs.on_cpu += *compute_cost;
+  }
+
+  // a value is copied once, however many nodes on the other side of the boundary use it
+  InlinedHashSet<const NodeArg*> boundary_args;
+  const auto add_copy = [&costs](const NodeArg& arg, bool copied_on_device, bool copied_on_cpu) {
+    if (!copied_on_device && !copied_on_cpu) {
+      return true;
+    }
+
+    const auto copy_cost = CopyCost(arg);
+    if (!copy_cost.has_value()) {
+      return false;
+    }
+    costs.on_device += copied_on_device ? *copy_cost : 0.0;
+    costs.on_cpu += copied_on_cpu ? *copy_cost : 0.0;
+    return true;
+  };
+
+  for (const Node* node : region) {
+    const KernelCreateInfo* kci = FindKernel(*node, kernel_registry_mgr);
+
+    // inputs the kernel reads from CPU memory are on CPU either way, and initializers are copied once per session
+    const auto& inputs = node->InputDefs();
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      const NodeArg& input = *inputs[i];
+      if (!input.Exists() || utils::IsInputOnCpu(*node, kci, i) || graph.IsInitializedTensor(input.Name())) {
+        continue;
+      }
+
+      const Node* producer = graph.GetProducerNode(input.Name());
+      if ((producer != nullptr && region_nodes.count(producer->Index()) > 0) || !boundary_args.insert(&input).second) {
+        continue;
+      }
+
+      const bool on_device = producer != nullptr &&
+                             ProducedOnDevice(*producer, input, provider_type, kernel_registry_mgr);
+      if (!add_copy(input, !on_device, on_device)) {
+        return std::nullopt;
+      }
+    }
+
+    // graph outputs are assumed to be fetched to CPU
+    const auto& outputs = node->OutputDefs();
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      const NodeArg& output = *outputs[i];
+      if (!output.Exists() || utils::IsOutputOnCpu(*node, kci, i)) {
+        continue;
+      }
+
+      bool needed_on_device = false;
+      bool needed_on_cpu = graph.IsOutput(&output);
+      for (const Node* consumer : graph.GetConsumerNodes(output.Name())) {
+        if (region_nodes.count(consumer->Index()) > 0) {
+          continue;
+        }
+        if (ConsumedOnDevice(*consumer, output, provider_type, kernel_registry_mgr)) {
+          needed_on_device = true;
+        } else {
+          needed_on_cpu = true;
+        }
+      }
+
+      if (!add_copy(output, needed_on_cpu, needed_on_device)) {
+        return std::nullopt;
+      }
+    }
+  }
+
+  return costs;
+}
+
+}  // namespace
+
+Status FallbackDeviceRegionsToCpu(Graph& graph, const KernelRegistryManager& kernel_registry_mgr, bool& modified) {
+  const auto can_move = [&kernel_registry_mgr](const Node& node) {
+    const auto& provider_type = node.GetExecutionProviderType();
+    return !provider_type.empty() && !utils::ProviderIsCpuBased(provider_type) && !node.ContainsSubgraph() &&
+           KernelRegistryManager::HasImplementationOf(kernel_registry_mgr, node, provider_type) &&
+           KernelRegistryManager::HasImplementationOf(kernel_registry_mgr, node, kCpuExecutionProvider);
+  };
+
+  // Moving a region changes the copies of its neighbors, so the regions are visited again until none is moved.
+  // Every move reduces the number of nodes on a device, so this ends.
+  bool moved_region = true;
+  while (moved_region) {
+    moved_region = false;
+
+    GraphViewer graph_viewer(graph);
+    InlinedHashSet<NodeIndex> visited;
+    for (NodeIndex node_index : graph_viewer.GetNodesInTopologicalOrder()) {
+      Node& start_node = *graph.GetNode(node_index);
+      if (visited.count(node_index) > 0 || !can_move(start_node)) {
+        continue;
+      }
+
+      // the region is the nodes of the same provider that can be moved and are connected to the start node
+      const std::string provider_type = start_node.GetExecutionProviderType();
+      InlinedVector<Node*> region;
+      InlinedHashSet<NodeIndex> region_nodes;
+      std::queue<Node*> pending;
+      pending.push(&start_node);
+      visited.insert(node_index);
+      while (!pending.empty()) {
+        Node* node = pending.front();
+        pending.pop();
+        region.push_back(node);
+        region_nodes.insert(node->Index());
+
+        const auto add_neighbor = [&](const Node& neighbor) {
+          if (neighbor.GetExecutionProviderType() == provider_type && visited.count(neighbor.Index()) == 0 &&
+              can_move(neighbor)) {
+            visited.insert(neighbor.Index());
+            pending.push(graph.GetNode(neighbor.Index()));
+          }
+        };
+        for (auto it = node->InputNodesBegin(), end = node->InputNodesEnd(); it != end; ++it) {
+          add_neighbor(*it);
+        }
+        for (auto it = node->OutputNodesBegin(), end = node->OutputNodesEnd(); it != end; ++it) {
+          add_neighbor(*it);
+        }
+      }
+
+      const auto costs = EstimateRegionCosts(graph, region, region_nodes, provider_type, kernel_registry_mgr);
+      if (!costs.has_value() || costs->on_cpu >= costs->on_device) {
+        continue;
+      }
+
+      LOGS_DEFAULT(INFO) << "Moving " << region.size() << " node(s) connected to " << start_node.Name() << " from "
+                         << provider_type << " to " << kCpuExecutionProvider << ". Estimated cost "
+                         << costs->on_cpu << " instead of " << costs->on_device << ".";
+      for (Node* node : region) {
+        node->SetExecutionProviderType(kCpuExecutionProvider);
+      }
+      moved_region = true;
+      modified = true;
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
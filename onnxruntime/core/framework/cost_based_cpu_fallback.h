@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/status.h"
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+
+class KernelRegistryManager;
+
+/**
+  Moves connected regions of nodes assigned to a device execution provider, such as CUDA, to the CPU execution
+  provider when running them on CPU is estimated to be cheaper. A region on the device that is surrounded by nodes on
+  CPU needs copies of its inputs to and of its outputs from the device, which often cost more than the region saves.
+
+  The estimate uses the static shapes of the values, so regions with values of unknown size are not moved. Only nodes
+  that run a kernel of the device execution provider and that have a CPU kernel are moved. Nested subgraphs are not
+  changed.
+  @param graph The partitioned graph.
+  @param kernel_registry_mgr The kernel registries of the session, which must include the CPU kernels.
+  @param modified Set to true if any node was moved.
+  */
+Status FallbackDeviceRegionsToCpu(Graph& graph, const KernelRegistryManager& kernel_registry_mgr, bool& modified);
+
+}  // namespace onnxruntime
@@ -198,6 +198,17 @@ bool IExecutionFrame::TryGetInferredShape(int /*index*/, TensorShape& /*shape*/)
   return false;
 }
 
+bool IExecutionFrame::IsNodeInputDeadAfterNode(const Node& /*node*/, int /*input_index*/) const {
+  // Without an execution plan nothing is known about the lifetime of the inputs.
+  return false;
+}
+
+Status IExecutionFrame::TryReuseNodeInputForOutput(int /*input_arg_index*/, int /*output_arg_index*/,
+                                                   const TensorShape& /*shape*/, OrtValue*& p_ort_value) {
+  p_ort_value = nullptr;
+  return Status::OK();
+}
+
 AllocatorPtr IExecutionFrame::GetAllocator(const OrtDevice& info) const {
   return GetAllocatorImpl(info);
 }
@@ -348,6 +359,7 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
       device_streams_(device_streams),
 #endif
       session_state_(session_state),
+      memory_timeline_(MemoryTimeline::Current()),
       mem_patterns_(nullptr) {
   Init(
       feed_mlvalue_idxs, feeds, session_state.GetInitializedTensors(),
@@ -397,7 +409,13 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
 
     // if there are some traditional ml value type in inputs disable the memory pattern optimization.
     if (all_tensors) {
-      mem_patterns_ = session_state.GetMemoryPatternGroup(feeds, feed_mlvalue_idxs, inferred_shapes_);
+      mem_pattern_entry_ = session_state.GetMemoryPatternGroup(feeds, feed_mlvalue_idxs);
+      if (mem_pattern_entry_) {
+        mem_patterns_ = &mem_pattern_entry_->patterns;
+        if (mem_pattern_entry_->has_inferred_shapes) {
+          inferred_shapes_ = &mem_pattern_entry_->inferred_shapes;
+        }
+      }
       // if no existing patterns, generate one in this execution frame
       if (!mem_patterns_) {
         planner_.emplace(*session_state.GetExecutionPlan());
@@ -409,7 +427,11 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
           const auto& location = mem_patterns_->locations[i];
           ORT_ENFORCE(buffers_.find(location) == buffers_.end());
           if (mem_patterns_->patterns[i].PeakSize() > 0) {
-            AllocatorPtr alloc = GetAllocator(location);
+            // an environment activation pool, if the session uses one, may block until another Run returns its buffer
+            AllocatorPtr alloc = session_state.GetActivationPool(location);
+            if (!alloc) {
+              alloc = GetAllocator(location);
+            }
             void* buffer = nullptr;
             // it's possible we can't allocate the large block. if we have memory patterns we know we have successfully
             // executed once before, so if there's an arena involved it probably has smaller blocks available.
@@ -461,6 +483,12 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
 
             if (buffer != nullptr) {
               buffers_[location] = BufferUniquePtr(buffer, BufferDeleter(alloc));
+              if (memory_timeline_ != nullptr) {
+                RecordTimelineAllocation(-1 - static_cast<int>(i), "memory pattern buffer " + location.ToString(),
+                                         mem_patterns_->patterns[i].PeakSize(), location,
+                                         alloc->Info().alloc_type == OrtArenaAllocator,
+                                         MemoryTimeline::AllocationKind::kPatternBuffer);
+              }
             }
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
             // Record activation memory pattern
@@ -483,7 +511,12 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
   }
 }
 
-ExecutionFrame::~ExecutionFrame() = default;
+ExecutionFrame::~ExecutionFrame() {
+  // the outputs and the memory pattern buffers live until the end of the execution
+  if (memory_timeline_ != nullptr) {
+    memory_timeline_->RecordFrees(this);
+  }
+}
 
 Status ExecutionFrame::CopyTensor(const Tensor& src, Tensor& dest) const {
   return session_state_.GetDataTransferMgr().CopyTensor(src, dest);
@@ -499,6 +532,26 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBuffer(OrtValue& ort_value, i
   return AllocateMLValueTensorSelfOwnBufferHelper(ort_value, ort_value_index, element_type, location, shape);
 }
 
+int ExecutionFrame::GetValueStreamIndex(int ort_value_idx) const {
+#ifdef ORT_ENABLE_STREAM
+  const auto& value_to_stream_map = const_cast<SessionState&>(session_state_).GetExecutionPlan()->GetValueToStreamMap();
+  auto it = value_to_stream_map.find(ort_value_idx);
+  if (it != value_to_stream_map.end()) {
+    return static_cast<int>(it->second);
+  }
+#else
+  ORT_UNUSED_PARAMETER(ort_value_idx);
+#endif
+  return -1;
+}
+
+void ExecutionFrame::RecordTimelineAllocation(int ort_value_idx, const std::string& name, size_t size,
+                                              const OrtDevice& location, bool arena,
+                                              MemoryTimeline::AllocationKind kind) {
+  memory_timeline_->RecordAllocation(this, ort_value_idx, name, size, location, arena,
+                                     ort_value_idx >= 0 ? GetValueStreamIndex(ort_value_idx) : -1, kind);
+}
+
 Stream* ExecutionFrame::GetValueStream(int ort_value_idx) const {
 #ifdef ORT_ENABLE_STREAM
   const auto& value_to_stream_map = const_cast<SessionState&>(session_state_).GetExecutionPlan()->GetValueToStreamMap();
@@ -548,12 +601,21 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
       if (block) {
         auto it = buffers_.find(location);
         if (it != buffers_.end()) {
-          // if the block is not correct, log message then fall back to default behavior
-          if (block->size_ == size) {
+          // if the block is not correct, log message then fall back to default behavior.
+          // with shape bucketing the patterns may come from larger shapes in the same bucket so a block that is
+          // large enough is fine.
+          if (block->size_ == size ||
+              (size < block->size_ && session_state_.GetEnableMemoryPatternBucketing())) {
             void* buffer = it->second.get();
             auto status = AllocateTensorWithPreAllocateBufferHelper(
                 ort_value, static_cast<void*>(static_cast<char*>(buffer) + block->offset_), element_type, location,
                 shape);
+            if (memory_timeline_ != nullptr && status.IsOK()) {
+              std::string name;
+              ORT_RETURN_IF_ERROR(ort_value_idx_map_.GetName(ort_value_index, name));
+              RecordTimelineAllocation(ort_value_index, name, block->size_, location, false,
+                                       MemoryTimeline::AllocationKind::kPlanned);
+            }
             return status;
           } else {
             // the block size may vary especially if the model has NonZero ops, or different sequence lengths are
@@ -575,25 +637,50 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
   if (!alloc) alloc = GetAllocator(location);
   ORT_ENFORCE(alloc && alloc.get() != nullptr, "Failed to get allocator for ", location.ToString());
 
-  Stream* current_stream = GetValueStream(ort_value_index);
-  if (current_stream) {
+  std::string timeline_name;
+  const bool arena = alloc->Info().alloc_type == OrtArenaAllocator;
+  if (memory_timeline_ != nullptr) {
+    ORT_RETURN_IF_ERROR(ort_value_idx_map_.GetName(ort_value_index, timeline_name));
+  }
+
+  // the timeline records the allocation that failed, which is most likely where the device ran out of memory
+  ORT_TRY {
+    Stream* current_stream = GetValueStream(ort_value_index);
+    if (current_stream) {
 #ifdef ORT_ENABLE_STREAM
-    auto stream_aware_alloc = AsStreamBasedAllocator(alloc);
-    if (stream_aware_alloc) {
-      size_t buffer_size = Tensor::CalculateTensorStorageSize(element_type, shape);
-      // the reused memory must from same EP
-      auto wait_handle = this->session_state_.GetStreamHandleRegistryInstance().GetWaitHandle(
-          current_stream->GetDevice().Type(), current_stream->GetDevice().Type());
-      void* p_data = stream_aware_alloc->AllocOnStream(buffer_size, current_stream, wait_handle);
-      Tensor::InitOrtValue(element_type, shape, p_data, std::move(alloc), ort_value);
+      auto stream_aware_alloc = AsStreamBasedAllocator(alloc);
+      if (stream_aware_alloc) {
+        size_t buffer_size = Tensor::CalculateTensorStorageSize(element_type, shape);
+        // the reused memory must from same EP
+        auto wait_handle = this->session_state_.GetStreamHandleRegistryInstance().GetWaitHandle(
+            current_stream->GetDevice().Type(), current_stream->GetDevice().Type());
+        void* p_data = stream_aware_alloc->AllocOnStream(buffer_size, current_stream, wait_handle);
+        Tensor::InitOrtValue(element_type, shape, p_data, std::move(alloc), ort_value);
+      } else if (alloc->IsStreamOrdered()) {
+        size_t buffer_size = Tensor::CalculateTensorStorageSize(element_type, shape);
+        void* p_data = alloc->StreamOrderedAlloc(buffer_size, current_stream);
+        Tensor::InitOrtValue(element_type, shape, p_data, std::move(alloc), ort_value);
+      } else {
+        Tensor::InitOrtValue(element_type, shape, std::move(alloc), ort_value);
+      }
+#else
+      ORT_THROW("Ort value is associated with a Stream but Stream is not enabled in the build.");
+#endif
     } else {
       Tensor::InitOrtValue(element_type, shape, std::move(alloc), ort_value);
     }
-#else
-    ORT_THROW("Ort value is associated with a Stream but Stream is not enabled in the build.");
-#endif
-  } else {
-    Tensor::InitOrtValue(element_type, shape, std::move(alloc), ort_value);
+  }
+  ORT_CATCH(...) {
+    if (memory_timeline_ != nullptr) {
+      memory_timeline_->RecordFailedAllocation(timeline_name, size, location, GetValueStreamIndex(ort_value_index));
+    }
+    ORT_RETHROW;
+  }
+  if (memory_timeline_ != nullptr) {
+    RecordTimelineAllocation(ort_value_index, timeline_name, size, location, arena,
+                             per_alloc_plan.alloc_kind == AllocKind::kAllocateOutput
+                                 ? MemoryTimeline::AllocationKind::kOutput
+                                 : MemoryTimeline::AllocationKind::kDynamic);
   }
 
   // trace the memory allocation.
@@ -669,6 +756,39 @@ Status ExecutionFrame::AllocateTensorWithPreAllocateBufferHelper(OrtValue& ort_v
   return Status::OK();
 }
 
+Status ExecutionFrame::AllocateSubBufferTensor(OrtValue& ort_value, int ort_value_index, int ort_value_index_reuse,
+                                               size_t offset, MLDataType element_type, const OrtDevice& location,
+                                               const TensorShape& shape) {
+  // The buffer is allocated by the first value placed in it, e.g. by the first input of a Concat that is written in
+  // place, so it is allocated with the shape of the value it belongs to which is known before the value is produced.
+  OrtValue& reuse_value = GetMutableMLValue(ort_value_index_reuse);
+  if (!reuse_value.IsAllocated()) {
+    std::string name;
+    ORT_RETURN_IF_ERROR(ort_value_idx_map_.GetName(ort_value_index_reuse, name));
+    const auto* node_arg = session_state_.GetGraphViewer().GetNodeArg(name);
+    ORT_RETURN_IF_NOT(node_arg != nullptr && node_arg->Shape() != nullptr,
+                      "The shape of ", name, " is required to place values in its buffer.");
+    const TensorShape reuse_shape = utils::GetTensorShapeFromTensorShapeProto(*node_arg->Shape());
+    ORT_RETURN_IF_ERROR(AllocateAsPerAllocationPlan(reuse_value, ort_value_index_reuse, &reuse_shape));
+  }
+
+  // The placement was planned with the static shapes. Fall back to a buffer of its own if the value does not fit,
+  // in which case the kernel that produces or consumes it copies the data.
+  Tensor& reuse_tensor = *reuse_value.GetMutable<Tensor>();
+  size_t required_bytes = 0;
+  if (reuse_tensor.DataType() == element_type &&
+      IAllocator::CalcMemSizeForArray(static_cast<size_t>(shape.Size()), element_type->Size(), &required_bytes) &&
+      offset + required_bytes <= reuse_tensor.SizeInBytes()) {
+    void* buffer = static_cast<uint8_t*>(reuse_tensor.MutableDataRaw()) + offset;
+    return AllocateTensorWithPreAllocateBufferHelper(ort_value, buffer, element_type, location, shape);
+  }
+
+  LOGS(session_state_.Logger(), WARNING) << "Shape " << shape << " of OrtValue " << ort_value_index
+                                         << " does not fit at offset " << offset << " into the buffer of OrtValue "
+                                         << ort_value_index_reuse << ". Allocating a buffer for it instead.";
+  return AllocateMLValueTensorSelfOwnBuffer(ort_value, ort_value_index, element_type, location, shape);
+}
+
 static Status AllocateTraditionalMLValue(OrtValue& ort_value, const NonTensorTypeBase& type) {
   auto creator = type.GetCreateFunc();
   ort_value.Init(creator(), &type, type.GetDeleteFunc());
@@ -760,6 +880,13 @@ Status ExecutionFrame::AllocateAsPerAllocationPlan(OrtValue& ort_value, int ort_
       case AllocKind::kReuse: {
         int reuse_mlvalue_index = per_alloc_plan.reused_buffer;
 
+        if (per_alloc_plan.is_sub_buffer) {
+          ORT_RETURN_IF_ERROR(AllocateSubBufferTensor(ort_value, ort_value_index, reuse_mlvalue_index,
+                                                      per_alloc_plan.sub_buffer_offset, ml_data_type, alloc_info,
+                                                      *shape));
+          break;
+        }
+
         ORT_RETURN_IF_ERROR(AllocateReusedOrtValueIfNotAllocatedHelper(reuse_mlvalue_index, shape));
 
         bool is_strided_tensor = false;
@@ -864,6 +991,9 @@ void ExecutionFrame::VerifyOutputSizes(int output_index, const Node& node, const
 Status ExecutionFrame::ReleaseMLValueImpl(int ort_value_idx) {
   ORT_RETURN_IF_ERROR(IExecutionFrame::ReleaseMLValueImpl(ort_value_idx));
   TraceFree(ort_value_idx);
+  if (memory_timeline_ != nullptr) {
+    memory_timeline_->RecordFree(this, ort_value_idx);
+  }
   return Status::OK();
 }
 
@@ -891,6 +1021,24 @@ void ExecutionFrame::TraceAllocate(int ort_value_idx, size_t size) {
 void ExecutionFrame::TraceFree(int ort_value_idx) {
   // don't trace free on output tensors.
   if (planner_.has_value() && !IsOutput(ort_value_idx)) {
+    {
+      // a buffer a kernel wrote an output into in place is free once the last value sharing it is released.
+      std::lock_guard<std::mutex> lock(in_place_mutex_);
+      auto owner_it = in_place_buffer_owners_.find(ort_value_idx);
+      if (owner_it != in_place_buffer_owners_.end()) {
+        ort_value_idx = owner_it->second;
+        in_place_buffer_owners_.erase(owner_it);
+      }
+
+      auto count_it = in_place_share_counts_.find(ort_value_idx);
+      if (count_it != in_place_share_counts_.end()) {
+        if (--count_it->second > 0) {
+          return;
+        }
+        in_place_share_counts_.erase(count_it);
+      }
+    }
+
     const SequentialExecutionPlan* p_seq_exec_plan = session_state_.GetExecutionPlan();
     const auto& alloc_plan = p_seq_exec_plan->allocation_plan;
     ORT_ENFORCE(ort_value_idx >= 0 && static_cast<size_t>(ort_value_idx) < alloc_plan.size());
@@ -913,6 +1061,89 @@ void ExecutionFrame::TraceFree(int ort_value_idx) {
   }
 }
 
+bool ExecutionFrame::IsInMemoryPatternBuffer(const Tensor& tensor) const {
+  const auto& device = tensor.Location().device;
+  auto it = buffers_.find(device);
+  const auto* pattern = mem_patterns_ ? mem_patterns_->GetPatterns(device) : nullptr;
+  if (it == buffers_.end() || pattern == nullptr) {
+    return false;
+  }
+
+  const char* data = static_cast<const char*>(tensor.DataRaw());
+  const char* buffer = static_cast<const char*>(it->second.get());
+  return data >= buffer && data < buffer + pattern->PeakSize();
+}
+
+bool ExecutionFrame::IsNodeInputDeadAfterNode(const Node& node, int input_index) const {
+  const SequentialExecutionPlan* p_seq_exec_plan = session_state_.GetExecutionPlan();
+  if (p_seq_exec_plan == nullptr || node.Index() >= p_seq_exec_plan->node_dying_inputs.size()) {
+    return false;
+  }
+
+  const auto& dying_inputs = p_seq_exec_plan->node_dying_inputs[node.Index()];
+  return std::find(dying_inputs.begin(), dying_inputs.end(), input_index) != dying_inputs.end();
+}
+
+Status ExecutionFrame::TryReuseNodeInputForOutput(int input_arg_index, int output_arg_index,
+                                                  const TensorShape& shape, OrtValue*& p_ort_value) {
+  p_ort_value = nullptr;
+
+  const int input_idx = GetNodeIdxToMLValueIdx(input_arg_index);
+  const int output_idx = GetNodeIdxToMLValueIdx(output_arg_index);
+  if (input_idx == NodeIndexInfo::kInvalidEntry || output_idx == NodeIndexInfo::kInvalidEntry) {
+    return Status::OK();
+  }
+
+  OrtValue& output = GetMutableMLValue(output_idx);
+  const OrtValue& input = GetMutableMLValue(input_idx);
+  const auto& output_plan = GetAllocationPlan(output_idx);
+
+  // only an output that would get a buffer of its own. graph outputs are returned to the caller and outputs the
+  // plan already reuses a buffer for are taken care of.
+  if (output.IsAllocated() || output_plan.alloc_kind != AllocKind::kAllocate ||
+      !input.IsTensor() || !input.IsAllocated() || !output_plan.value_type->IsTensorType()) {
+    return Status::OK();
+  }
+
+#ifdef ENABLE_STRIDED_TENSORS
+  if (output_plan.is_strided_tensor) {
+    return Status::OK();
+  }
+#endif
+
+  const Tensor& input_tensor = input.Get<Tensor>();
+  if (input_tensor.Shape() != shape ||
+      input_tensor.DataType() != output_plan.value_type->AsTensorType()->GetElementType() ||
+      input_tensor.Location().device != output_plan.location ||
+      GetValueStream(input_idx) != GetValueStream(output_idx)) {
+    return Status::OK();
+  }
+
+  // The memory pattern keeps the block of the input alive until the output is released only if the output was
+  // also written in place when the pattern was traced. In that case the output has no block of its own.
+  if (mem_patterns_ && IsInMemoryPatternBuffer(input_tensor)) {
+    const auto* pattern = mem_patterns_->GetPatterns(output_plan.location);
+    if (pattern != nullptr && pattern->GetBlock(output_idx) != nullptr) {
+      return Status::OK();
+    }
+  }
+
+  if (planner_.has_value()) {
+    std::lock_guard<std::mutex> lock(in_place_mutex_);
+    auto owner_it = in_place_buffer_owners_.find(input_idx);
+    const int owner = owner_it != in_place_buffer_owners_.end() ? owner_it->second : input_idx;
+    in_place_buffer_owners_[output_idx] = owner;
+    // the owner itself counts as one of the values sharing the buffer
+    auto count_it = in_place_share_counts_.try_emplace(owner, 1).first;
+    ++count_it->second;
+  }
+
+  // share the tensor. the input is released after the kernel runs, leaving the output as the only user.
+  output = input;
+  p_ort_value = &output;
+  return Status::OK();
+}
+
 // generate memory pattern based on the tracing of memory allocation/free in current execution
 // return error if the planner is not setup.
 Status ExecutionFrame::GeneratePatterns(MemoryPatternGroup& out) {
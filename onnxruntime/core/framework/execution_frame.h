@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -10,6 +11,7 @@
 #include "core/common/logging/logging.h"
 #include "core/common/status.h"
 #include "core/framework/iexecutor.h"
+#include "core/framework/memory_timeline.h"
 #include "core/framework/ort_value.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/ort_value_pattern_planner.h"
@@ -23,6 +25,7 @@ class DataTransferManager;
 class SessionState;
 class OrtValueNameIdxMap;
 struct MemoryPatternGroup;
+struct MemoryPatternCacheEntry;
 class NodeIndexInfo;
 class Stream;
 #ifdef ORT_ENABLE_STREAM
@@ -80,6 +83,16 @@ class IExecutionFrame {
   // If the retrieval is successful, this function returns true and false otherwise.
   virtual bool TryGetInferredShape(int index, TensorShape& shape) const;
 
+  // Returns true if the execution plan releases the buffer of the input at `input_index` of `node` right after the
+  // node runs and nothing else reads it, so the kernel may write an output into it.
+  virtual bool IsNodeInputDeadAfterNode(const Node& node, int input_index) const;
+
+  // Make the node output at `output_arg_index` share the tensor of the node input at `input_arg_index` so the kernel
+  // writes the output in place. Only valid for an input IsNodeInputDeadAfterNode returned true for.
+  // p_ort_value is set to nullptr if the input can't be reused, in which case the output is allocated as usual.
+  virtual Status TryReuseNodeInputForOutput(int input_arg_index, int output_arg_index, const TensorShape& shape,
+                                            OrtValue*& p_ort_value);
+
   /**
    * write the output values to the 'fetches' vector
    * Don't access the values after SessionState is destroyed
@@ -168,6 +181,11 @@ class ExecutionFrame final : public IExecutionFrame {
   // If the retrival is sucessful, this function returns true and false otherwise.
   bool TryGetInferredShape(int index, TensorShape& shape) const override;
 
+  bool IsNodeInputDeadAfterNode(const Node& node, int input_index) const override;
+
+  Status TryReuseNodeInputForOutput(int input_arg_index, int output_arg_index, const TensorShape& shape,
+                                    OrtValue*& p_ort_value) override;
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Return the size of virtual memory allocated in runtime.
   // The memory is usually used for activations in forward and backward passes.
@@ -210,31 +228,59 @@ class ExecutionFrame final : public IExecutionFrame {
   Status AllocateTensorWithPreAllocateBufferHelper(OrtValue& ort_value, void* pBuffer, MLDataType element_type,
                                                    const OrtDevice& location, const TensorShape& shape);
 
+  // Places the tensor of ort_value at offset bytes into the buffer of the OrtValue at ort_value_index_reuse.
+  Status AllocateSubBufferTensor(OrtValue& ort_value, int ort_value_index, int ort_value_index_reuse, size_t offset,
+                                 MLDataType element_type, const OrtDevice& location, const TensorShape& shape);
+
   void TraceAllocate(int ort_value_idx, size_t size);
   void TraceFree(int ort_value_idx);
 
+  // returns true if the data of the tensor lives in one of the memory pattern buffers
+  bool IsInMemoryPatternBuffer(const Tensor& tensor) const;
+
   const AllocPlanPerValue& GetAllocationPlan(int ort_value_idx);
 
   Stream* GetValueStream(int ort_value_idx) const;
 
+  // the index of the stream of the value in the execution plan, -1 if it has none
+  int GetValueStreamIndex(int ort_value_idx) const;
+
+  // records the allocation of a value, or of a memory pattern buffer with a negative index, in memory_timeline_
+  void RecordTimelineAllocation(int ort_value_idx, const std::string& name, size_t size, const OrtDevice& location,
+                                bool arena, MemoryTimeline::AllocationKind kind);
+
 #ifdef ORT_ENABLE_STREAM
   const DeviceStreamCollection* device_streams_;
 #endif
 
   const SessionState& session_state_;
 
+  // the timeline of the Run recording the allocations, if kOrtSessionOptionsMemoryTimelineFilePrefix is set
+  MemoryTimeline* const memory_timeline_;
+
   // map of index to custom allocator
   InlinedHashMap<int, IExecutor::CustomAllocator> custom_allocators_;
 
   // If we already have cached memory pattern on these input shapes
   // Use this mem pattern that create a big chunk for all the internal
   // kernel's input/output tensors.
+  // mem_pattern_entry_ keeps the cache entry alive if SessionState evicts it during the Run.
+  std::shared_ptr<const MemoryPatternCacheEntry> mem_pattern_entry_;
   const MemoryPatternGroup* mem_patterns_;
 
   // If no cached memory pattern, and we enable the memory pattern optimization
   // use this planner_ to trace the memory allocation in current executor.
   std::optional<OrtValuePatternPlanner> planner_;
 
+  // When a kernel writes an output in place the output shares the buffer of a traced value, so the planner_ must
+  // only see that value freed once the last value sharing the buffer is released.
+  // in_place_buffer_owners_ maps a value written in place to the traced value owning its buffer and
+  // in_place_share_counts_ holds the number of live values sharing the buffer of an owner.
+  // Only used while tracing. kernels on different streams may run concurrently so the maps are guarded.
+  InlinedHashMap<int, int> in_place_buffer_owners_;
+  InlinedHashMap<int, int> in_place_share_counts_;
+  std::mutex in_place_mutex_;
+
   // Big chunks on different locations that will be used by mem_pattern.
   InlinedHashMap<OrtDevice, BufferUniquePtr> buffers_;
 
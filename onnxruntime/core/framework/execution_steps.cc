@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 #include "core/framework/execution_steps.h"
+#include "core/framework/graph_segment_capture.h"
 #include "core/framework/sequential_executor.h"
 namespace onnxruntime {
 BarrierStep::BarrierStep(size_t id, NodeIndex node_index) : SequentialExecutionPlan::ExecutionStep(node_index),
@@ -61,7 +62,20 @@ Status LaunchKernelStep::Execute(StreamExecutionContext& ctx,
     return Status::OK();
   }
 #endif
-  onnxruntime::Status status = ExecuteKernel(ctx, node_index_, stream_idx, terminate_flag, session_scope);
+#ifdef ORT_ENABLE_STREAM
+  if (const auto* weight_streamer = ctx.GetSessionState().GetWeightStreamer(); weight_streamer != nullptr) {
+    const auto status = weight_streamer->PrefetchForKernel(ctx, node_index_, stream_idx);
+    if (!status.IsOK()) {
+      continue_flag = false;
+      return status;
+    }
+  }
+#endif
+  const auto* graph_segments = ctx.GetSessionState().GetGraphSegmentCapture();
+  onnxruntime::Status status =
+      graph_segments != nullptr
+          ? graph_segments->ExecuteKernel(ctx, node_index_, stream_idx, terminate_flag, session_scope)
+          : ExecuteKernel(ctx, node_index_, stream_idx, terminate_flag, session_scope);
   continue_flag = status.IsOK();
   return status;
 }
@@ -53,6 +53,8 @@ class LaunchKernelStep : public SequentialExecutionPlan::ExecutionStep {
                  bool& continue_flag) override;
 
   std::string ToString() const override;
+
+  bool IsKernelLaunch() const override { return true; }
 };
 
 class ActivateNotificationStep : public SequentialExecutionPlan::ExecutionStep {
@@ -6,7 +6,9 @@
 #include <cassert>
 #include <functional>
 
+#include "core/common/startup_timings.h"
 #include "core/framework/compute_capability.h"
+#include "core/framework/cost_based_cpu_fallback.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/func_kernel.h"
 #include "core/framework/kernel_lookup.h"
@@ -458,7 +460,10 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
         nodes_and_viewers.push_back(IExecutionProvider::FusedNodeAndGraph{*node, *viewers.back()});
       }
 
-      ORT_RETURN_IF_ERROR(current_ep.Compile(nodes_and_viewers, node_compute_funcs));
+      {
+        StartupPhase phase("ep_compile", type);
+        ORT_RETURN_IF_ERROR(current_ep.Compile(nodes_and_viewers, node_compute_funcs));
+      }
 
       if (node_compute_funcs.size() != nodes_to_compile.size()) {
         return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, type, " did not return correct number of compiled functions");
@@ -636,7 +641,8 @@ static Status InlineFunctionsAOTImpl(const ExecutionProviders& execution_provide
 
 static Status PartitionOnnxFormatModel(const PartitionParams& partition_params, GraphPartitioner::Mode mode,
                                        const ExecutionProviders& execution_providers,
-                                       KernelRegistryManager& kernel_registry_manager) {
+                                       KernelRegistryManager& kernel_registry_manager,
+                                       bool cost_based_cpu_fallback) {
   bool modified_graph = false;
 
   auto& graph = partition_params.graph.get();
@@ -664,6 +670,13 @@ static Status PartitionOnnxFormatModel(const PartitionParams& partition_params,
     }
   } while (modified_graph);
 
+  // the assignments are kept as is when saving to ORT format, as they are redone when the model is loaded
+  if (cost_based_cpu_fallback && mode == GraphPartitioner::Mode::kNormal &&
+      execution_providers.Get(kCpuExecutionProvider) != nullptr) {
+    bool moved_nodes = false;
+    ORT_RETURN_IF_ERROR(FallbackDeviceRegionsToCpu(graph, kernel_registry_manager, moved_nodes));
+  }
+
   return Status::OK();
 }
 
@@ -751,8 +764,11 @@ static Status PartitionOrtFormatModelImpl(const PartitionParams& partition_param
   for (const auto& compilation_entry : compilation_entries) {
     Node& node = compilation_entry.fused_node;
     std::vector<NodeComputeInfo> single_node_compute_func;
-    ORT_RETURN_IF_ERROR(current_ep.Compile({IExecutionProvider::FusedNodeAndGraph{node, *compilation_entry.viewer}},
-                                           single_node_compute_func));
+    {
+      StartupPhase phase("ep_compile", current_ep.Type());
+      ORT_RETURN_IF_ERROR(current_ep.Compile({IExecutionProvider::FusedNodeAndGraph{node, *compilation_entry.viewer}},
+                                             single_node_compute_func));
+    }
 
     ORT_RETURN_IF(single_node_compute_func.empty(), "single_node_compute_func should have 1 element.");
     auto& func_mgr = partition_params.func_mgr.get();
@@ -885,7 +901,7 @@ Status GraphPartitioner::Partition(Graph& graph, FuncManager& func_mgr,
   if (mode == Mode::kNormal || mode == Mode::kAssignOnly) {
 #if !defined(ORT_MINIMAL_BUILD)
     ORT_RETURN_IF_ERROR(PartitionOnnxFormatModel(partition_params, mode,
-                                                 providers_, kernel_registry_mgr_));
+                                                 providers_, kernel_registry_mgr_, cost_based_cpu_fallback_));
 #else
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "ONNX models are not supported in this build.");
 #endif  //! defined(ORT_MINIMAL_BUILD)
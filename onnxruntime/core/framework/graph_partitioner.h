@@ -23,9 +23,13 @@ class GraphPartitioner {
   };
 
   // The order of providers represents the user preference.
-  GraphPartitioner(KernelRegistryManager& kernel_registry_mgr, const ExecutionProviders& providers)
+  // If cost_based_cpu_fallback is true, regions that are estimated to be cheaper on CPU than on a device including the
+  // copies to and from the device are moved to CPU after partitioning. See FallbackDeviceRegionsToCpu.
+  GraphPartitioner(KernelRegistryManager& kernel_registry_mgr, const ExecutionProviders& providers,
+                   bool cost_based_cpu_fallback = false)
       : kernel_registry_mgr_(kernel_registry_mgr),
-        providers_(providers) {
+        providers_(providers),
+        cost_based_cpu_fallback_(cost_based_cpu_fallback) {
   }
 
   // Run partitioning.
@@ -61,6 +65,7 @@ class GraphPartitioner {
 
   KernelRegistryManager& kernel_registry_mgr_;
   const ExecutionProviders& providers_;
+  const bool cost_based_cpu_fallback_;
 };
 
 }  // namespace onnxruntime
@@ -0,0 +1,436 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/graph_segment_capture.h"
+
+#include <cstring>
+#include <string_view>
+
+#include "core/framework/execution_provider.h"
+#include "core/framework/execution_steps.h"
+#include "core/framework/sequential_executor.h"
+#include "core/framework/session_state.h"
+#include "core/framework/stream_execution_context.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Runs of a segment before its capture, so that the arena holds all the memory the segment needs.
+constexpr int kMinRegularRunsBeforeCapture = 2;
+
+// A single kernel launch isn't worth a graph.
+constexpr size_t kMinSegmentSize = 2;
+
+// Kernels that synchronize with the host, whose output shapes depend on the data, or that draw random numbers, which
+// a replay would repeat.
+bool IsCapturableOpType(std::string_view op_type) {
+  static const InlinedHashSet<std::string_view> non_capturable_op_types = {
+      "MemcpyFromHost", "MemcpyToHost", "NonZero", "NonMaxSuppression", "Unique", "Compress",
+      "RandomNormal", "RandomNormalLike", "RandomUniform", "RandomUniformLike", "Multinomial",
+      "BeamSearch", "GreedySearch", "Sampling"};
+  return non_capturable_op_types.count(op_type) == 0;
+}
+
+}  // namespace
+
+GraphSegmentCapture::GraphSegmentCapture(const SessionState& session_state, IExecutionProvider& ep)
+    : session_state_(session_state), ep_(ep) {
+  const auto& graph_viewer = session_state.GetGraphViewer();
+  const auto& plan = *session_state.GetExecutionPlan();
+  const auto& value_plans = plan.allocation_plan;
+  const auto& name_idx_map = session_state.GetOrtValueNameIdxMap();
+  const auto& node_index_info = session_state.GetNodeIndexInfo();
+  const auto& constant_initializers = session_state.GetConstantInitializedTensors();
+
+  auto value_index = [&name_idx_map](const NodeArg& arg) {
+    int idx = -1;
+    ORT_THROW_IF_ERROR(name_idx_map.GetIdx(arg.Name(), idx));
+    return idx;
+  };
+
+  // the replays keep tensors alive and copy them, so the segments only hold tensors
+  auto are_tensors = [&](ConstPointerContainer<std::vector<NodeArg*>> args) {
+    for (const auto* arg : args) {
+      if (arg->Exists()) {
+        const auto* type = value_plans[value_index(*arg)].value_type;
+        if (type == nullptr || !type->IsTensorType()) {
+          return false;
+        }
+      }
+    }
+    return true;
+  };
+
+  std::vector<bool> is_capturable(graph_viewer.MaxNodeIndex(), false);
+  for (const auto& node : graph_viewer.Nodes()) {
+    is_capturable[node.Index()] = node.GetExecutionProviderType() == ep.Type() && !node.ContainsSubgraph() &&
+                                  IsCapturableOpType(node.OpType()) &&
+                                  are_tensors(node.InputDefs()) && are_tensors(node.OutputDefs());
+  }
+
+  // Split the kernel launches of the logic streams at the nodes that can't be captured. A node whose output shares the
+  // buffer of a value that its segment neither produces nor reads can't be captured either, as the segment couldn't
+  // keep the buffer alive, so the segments are built again until there are no such nodes.
+  std::vector<InlinedVector<NodeIndex>> node_groups;
+  bool is_changed = true;
+  while (is_changed) {
+    is_changed = false;
+    node_groups.clear();
+    for (const auto& logic_stream : plan.execution_plan) {
+      InlinedVector<NodeIndex> group;
+      for (const auto& step : logic_stream->steps_) {
+        if (step->IsKernelLaunch() && is_capturable[step->GetNodeIndex()]) {
+          group.push_back(step->GetNodeIndex());
+          continue;
+        }
+        if (group.size() >= kMinSegmentSize) {
+          node_groups.push_back(std::move(group));
+        }
+        group.clear();
+      }
+      if (group.size() >= kMinSegmentSize) {
+        node_groups.push_back(std::move(group));
+      }
+    }
+
+    for (const auto& group : node_groups) {
+      InlinedHashSet<int> used_values;
+      for (NodeIndex node_index : group) {
+        const Node& node = *graph_viewer.GetNode(node_index);
+        for (const auto* arg : node.InputDefs()) {
+          if (arg->Exists()) used_values.insert(value_index(*arg));
+        }
+        for (const auto* arg : node.OutputDefs()) {
+          if (arg->Exists()) used_values.insert(value_index(*arg));
+        }
+      }
+      for (NodeIndex node_index : group) {
+        for (const auto* arg : graph_viewer.GetNode(node_index)->OutputDefs()) {
+          if (!arg->Exists()) continue;
+          const auto& value_plan = value_plans[value_index(*arg)];
+          if (value_plan.alloc_kind == AllocKind::kReuse && used_values.count(value_plan.reused_buffer) == 0) {
+            is_capturable[node_index] = false;
+            is_changed = true;
+          }
+        }
+      }
+    }
+  }
+
+  InlinedHashSet<std::string_view> graph_outputs;
+  for (const auto* output : graph_viewer.GetOutputs()) {
+    graph_outputs.insert(output->Name());
+  }
+
+  node_segments_.assign(graph_viewer.MaxNodeIndex(), -1);
+  for (auto& group : node_groups) {
+    auto segment = std::make_unique<Segment>();
+    const InlinedHashSet<NodeIndex> segment_nodes(group.begin(), group.end());
+    InlinedHashSet<int> produced_values;
+    InlinedHashSet<int> input_values;
+
+    for (NodeIndex node_index : group) {
+      const Node& node = *graph_viewer.GetNode(node_index);
+      const int node_offset = node_index_info.GetNodeOffset(node_index);
+
+      const auto& input_defs = node.InputDefs();
+      for (size_t i = 0; i < input_defs.size(); ++i) {
+        if (!input_defs[i]->Exists()) continue;
+        const int idx = value_index(*input_defs[i]);
+        if (produced_values.count(idx) == 0 && constant_initializers.count(idx) == 0 &&
+            input_values.insert(idx).second) {
+          segment->input_frame_indices.push_back(node_offset + static_cast<int>(i));
+        }
+      }
+
+      const int output_offset = node_offset + static_cast<int>(input_defs.size() + node.ImplicitInputDefs().size());
+      const auto& output_defs = node.OutputDefs();
+      for (size_t i = 0; i < output_defs.size(); ++i) {
+        if (!output_defs[i]->Exists()) continue;
+        const int idx = value_index(*output_defs[i]);
+        produced_values.insert(idx);
+
+        bool is_read_after_segment = graph_outputs.count(output_defs[i]->Name()) > 0;
+        for (auto edge = node.OutputEdgesBegin(); edge != node.OutputEdgesEnd(); ++edge) {
+          if (edge->GetSrcArgIndex() == static_cast<int>(i) && segment_nodes.count(edge->GetNode().Index()) == 0) {
+            is_read_after_segment = true;
+          }
+        }
+        if (is_read_after_segment) {
+          segment->outputs.push_back({node_index, static_cast<int>(i), output_offset + static_cast<int>(i),
+                                      value_plans[idx].alloc_kind == AllocKind::kShare});
+        }
+      }
+
+      node_segments_[node_index] = static_cast<int>(segments_.size());
+    }
+
+    segment->nodes = std::move(group);
+    segments_.push_back(std::move(segment));
+  }
+
+  LOGS(session_state.Logger(), INFO) << "The nodes of " << ep.Type() << " are captured in " << segments_.size()
+                                     << " graph segments.";
+}
+
+GraphSegmentCapture::~GraphSegmentCapture() = default;
+
+Status GraphSegmentCapture::ExecuteKernel(StreamExecutionContext& ctx, NodeIndex node_index, size_t stream_idx,
+                                          const bool& terminate_flag, SessionScope& session_scope) const {
+  const int segment_idx = node_segments_[node_index];
+  if (segment_idx < 0) {
+    return onnxruntime::ExecuteKernel(ctx, node_index, stream_idx, terminate_flag, session_scope);
+  }
+
+  const Segment& segment = *segments_[segment_idx];
+  Mode& mode = ctx.GetGraphSegmentModes()[segment_idx];
+  if (node_index == segment.nodes.front()) {
+    ORT_RETURN_IF_ERROR(BeginSegment(ctx, segment_idx, stream_idx, mode));
+  }
+
+  switch (mode) {
+    case Mode::kReplay:
+      // the replay at the first node of the segment did the work of all of its nodes
+      ctx.RecycleNodeInputs(node_index);
+      return Status::OK();
+    case Mode::kCapture: {
+      Status status = onnxruntime::ExecuteKernel(ctx, node_index, stream_idx, terminate_flag, session_scope);
+      if (!status.IsOK() || node_index == segment.nodes.back()) {
+        Status capture_status = EndCapture(ctx, segment_idx, stream_idx, status.IsOK());
+        mode = Mode::kRegular;
+        return status.IsOK() ? capture_status : status;
+      }
+      return status;
+    }
+    default:
+      return onnxruntime::ExecuteKernel(ctx, node_index, stream_idx, terminate_flag, session_scope);
+  }
+}
+
+void GraphSegmentCapture::OnKernelComputed(StreamExecutionContext& ctx, NodeIndex node_index) const {
+  const int segment_idx = node_segments_[node_index];
+  if (segment_idx < 0 || ctx.GetGraphSegmentModes()[segment_idx] != Mode::kCapture) {
+    return;
+  }
+
+  // The graph writes to the buffers of all the values the capture produced, including the ones that are released
+  // right after this node, so they are kept out of the arena as long as the graph.
+  Segment& segment = *segments_[segment_idx];
+  const Node& node = *session_state_.GetGraphViewer().GetNode(node_index);
+  const int output_offset = session_state_.GetNodeIndexInfo().GetNodeOffset(node_index) +
+                            static_cast<int>(node.InputDefs().size() + node.ImplicitInputDefs().size());
+  auto& frame = ctx.GetExecutionFrame();
+  for (size_t i = 0; i < node.OutputDefs().size(); ++i) {
+    const OrtValue* value = frame.GetNodeInputOrOutputMLValue(output_offset + static_cast<int>(i));
+    if (value != nullptr && value->IsAllocated()) {
+      segment.captured_values.push_back(*value);
+    }
+  }
+}
+
+Status GraphSegmentCapture::BeginSegment(StreamExecutionContext& ctx, size_t segment_idx, size_t stream_idx,
+                                         Mode& mode) const {
+  Segment& segment = *segments_[segment_idx];
+  std::lock_guard<OrtMutex> lock(segment.mutex);
+
+  mode = Mode::kRegular;
+  if (segment.is_disabled || segment.is_capturing) {
+    return Status::OK();
+  }
+
+  if (segment.is_captured) {
+    if (InputsMatchCapture(ctx, segment)) {
+      mode = Mode::kReplay;
+      return Replay(ctx, segment_idx, stream_idx);
+    }
+    return Status::OK();
+  }
+
+  if (segment.regular_runs < kMinRegularRunsBeforeCapture) {
+    ++segment.regular_runs;
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF_ERROR(PrepareCapture(ctx, segment, stream_idx));
+  if (segment.is_disabled || !ep_.BeginGraphSegmentCapture(static_cast<int64_t>(segment_idx))) {
+    // try again in a later run, e.g. when no other run is using the device
+    RestoreReplacedValues(ctx, segment);
+    segment.captured_inputs.clear();
+    return Status::OK();
+  }
+
+  LOGS(ctx.GetLogger(), INFO) << "Capturing graph segment " << segment_idx << " of " << segment.nodes.size()
+                              << " nodes of " << ep_.Type();
+  segment.is_capturing = true;
+  mode = Mode::kCapture;
+  return Status::OK();
+}
+
+Status GraphSegmentCapture::PrepareCapture(StreamExecutionContext& ctx, Segment& segment, size_t stream_idx) const {
+  auto& frame = ctx.GetExecutionFrame();
+  segment.captured_inputs.clear();
+  segment.replaced_values.clear();
+
+  // The capture reads copies of the inputs that it owns, as the tensors of the frame may be released, or owned by the
+  // user, once the run completes. The kernels read the inputs in CPU memory when they are launched, so the capture
+  // only keeps their values to compare the inputs of the replays to.
+  for (int frame_index : segment.input_frame_indices) {
+    OrtValue* value = frame.GetMutableNodeInputOrOutputMLValue(frame_index);
+    if (value == nullptr || !value->IsTensor() || value->Get<Tensor>().IsDataTypeString()) {
+      segment.is_disabled = true;
+      return Status::OK();
+    }
+
+    const Tensor& tensor = value->Get<Tensor>();
+    OrtValue captured;
+    Tensor::InitOrtValue(tensor.DataType(), tensor.Shape(), session_state_.GetAllocator(tensor.Location().device),
+                         captured);
+    ORT_RETURN_IF_ERROR(CopyTensor(ctx, tensor, *captured.GetMutable<Tensor>(), stream_idx));
+    if (tensor.Location().device.Type() != OrtDevice::CPU) {
+      segment.replaced_values.emplace_back(frame_index, *value);
+      *value = captured;
+    }
+    segment.captured_inputs.push_back(std::move(captured));
+  }
+
+  // Outputs that exist before the segment runs, such as the fetches the user provided, are replaced by tensors of the
+  // capture too, and receive a copy of the captured outputs.
+  for (const auto& output : segment.outputs) {
+    OrtValue* value = frame.GetMutableNodeInputOrOutputMLValue(output.frame_index);
+    if (value != nullptr && value->IsAllocated() && !output.is_shared) {
+      const Tensor& tensor = value->Get<Tensor>();
+      OrtValue owned;
+      Tensor::InitOrtValue(tensor.DataType(), tensor.Shape(), session_state_.GetAllocator(tensor.Location().device),
+                           owned);
+      segment.replaced_values.emplace_back(output.frame_index, *value);
+      *value = std::move(owned);
+    }
+  }
+
+  return Status::OK();
+}
+
+void GraphSegmentCapture::RestoreReplacedValues(StreamExecutionContext& ctx, Segment& segment) const {
+  auto& frame = ctx.GetExecutionFrame();
+  for (auto& replaced : segment.replaced_values) {
+    // a value the segment read last is released already
+    OrtValue* value = frame.GetMutableNodeInputOrOutputMLValue(replaced.first);
+    if (value->IsAllocated()) {
+      *value = std::move(replaced.second);
+    }
+  }
+  segment.replaced_values.clear();
+}
+
+Status GraphSegmentCapture::EndCapture(StreamExecutionContext& ctx, size_t segment_idx, size_t stream_idx,
+                                       bool is_computed) const {
+  Segment& segment = *segments_[segment_idx];
+  std::lock_guard<OrtMutex> lock(segment.mutex);
+  segment.is_capturing = false;
+
+  Status status = ep_.EndGraphSegmentCapture(static_cast<int64_t>(segment_idx));
+  if (!is_computed || !status.IsOK()) {
+    // A kernel that the capture doesn't support, e.g. one that synchronizes with the host, fails the capture. The work
+    // of the segment didn't run, so neither does the rest of this run.
+    LOGS(ctx.GetLogger(), WARNING) << "Failed to capture graph segment " << segment_idx << " of " << ep_.Type()
+                                   << ", it will run without graph capture.";
+    segment.is_disabled = true;
+    RestoreReplacedValues(ctx, segment);
+    segment.captured_inputs.clear();
+    segment.captured_values.clear();
+    return status;
+  }
+
+  auto& frame = ctx.GetExecutionFrame();
+  segment.captured_outputs.clear();
+  for (const auto& output : segment.outputs) {
+    segment.captured_outputs.push_back(*frame.GetNodeInputOrOutputMLValue(output.frame_index));
+  }
+
+  // the work issued to a capturing stream doesn't run until the graph is replayed
+  ORT_RETURN_IF_ERROR(ep_.ReplayGraphSegment(static_cast<int64_t>(segment_idx)));
+
+  // Hand the rest of the run its own copies of the outputs, as the captured ones are rewritten by the next replay.
+  RestoreReplacedValues(ctx, segment);
+  for (size_t i = 0; i < segment.outputs.size(); ++i) {
+    OrtValue& value = *frame.GetMutableNodeInputOrOutputMLValue(segment.outputs[i].frame_index);
+    if (value.Get<Tensor>().DataRaw() == segment.captured_outputs[i].Get<Tensor>().DataRaw()) {
+      value = OrtValue();
+    }
+  }
+  ORT_RETURN_IF_ERROR(CopyOutputs(ctx, segment, stream_idx));
+
+  segment.is_captured = true;
+  return Status::OK();
+}
+
+bool GraphSegmentCapture::InputsMatchCapture(StreamExecutionContext& ctx, const Segment& segment) const {
+  const auto& frame = ctx.GetExecutionFrame();
+  for (size_t i = 0; i < segment.input_frame_indices.size(); ++i) {
+    const OrtValue* value = frame.GetNodeInputOrOutputMLValue(segment.input_frame_indices[i]);
+    if (value == nullptr || !value->IsTensor()) {
+      return false;
+    }
+
+    const Tensor& tensor = value->Get<Tensor>();
+    const Tensor& captured = segment.captured_inputs[i].Get<Tensor>();
+    if (tensor.DataType() != captured.DataType() || tensor.Shape() != captured.Shape() ||
+        tensor.Location().device != captured.Location().device) {
+      return false;
+    }
+    if (tensor.Location().device.Type() == OrtDevice::CPU &&
+        std::memcmp(tensor.DataRaw(), captured.DataRaw(), tensor.SizeInBytes()) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Status GraphSegmentCapture::Replay(StreamExecutionContext& ctx, size_t segment_idx, size_t stream_idx) const {
+  Segment& segment = *segments_[segment_idx];
+  const auto& frame = ctx.GetExecutionFrame();
+  for (size_t i = 0; i < segment.input_frame_indices.size(); ++i) {
+    const Tensor& tensor = frame.GetNodeInputOrOutputMLValue(segment.input_frame_indices[i])->Get<Tensor>();
+    Tensor& captured = *segment.captured_inputs[i].GetMutable<Tensor>();
+    if (tensor.Location().device.Type() != OrtDevice::CPU && tensor.DataRaw() != captured.DataRaw()) {
+      ORT_RETURN_IF_ERROR(CopyTensor(ctx, tensor, captured, stream_idx));
+    }
+  }
+
+  ORT_RETURN_IF_ERROR(ep_.ReplayGraphSegment(static_cast<int64_t>(segment_idx)));
+  return CopyOutputs(ctx, segment, stream_idx);
+}
+
+Status GraphSegmentCapture::CopyOutputs(StreamExecutionContext& ctx, const Segment& segment, size_t stream_idx) const {
+  auto& frame = ctx.GetExecutionFrame();
+  const auto& graph_viewer = session_state_.GetGraphViewer();
+  for (size_t i = 0; i < segment.outputs.size(); ++i) {
+    const auto& output = segment.outputs[i];
+    const Tensor& captured = segment.captured_outputs[i].Get<Tensor>();
+    OrtValue* value = nullptr;
+    ORT_RETURN_IF_ERROR(frame.GetOrCreateNodeOutputMLValue(output.output_index, output.frame_index, &captured.Shape(),
+                                                           value, *graph_viewer.GetNode(output.node_index)));
+    Tensor& tensor = *value->GetMutable<Tensor>();
+    // an output that shares the buffer of a feed holds the data already
+    if (!output.is_shared && tensor.DataRaw() != captured.DataRaw()) {
+      ORT_RETURN_IF_ERROR(CopyTensor(ctx, captured, tensor, stream_idx));
+    }
+  }
+  return Status::OK();
+}
+
+Status GraphSegmentCapture::CopyTensor(StreamExecutionContext& ctx, const Tensor& src, Tensor& dst,
+                                       size_t stream_idx) const {
+  if (src.Location().device.Type() == OrtDevice::CPU && dst.Location().device.Type() == OrtDevice::CPU) {
+    std::memcpy(dst.MutableDataRaw(), src.DataRaw(), src.SizeInBytes());
+    return Status::OK();
+  }
+
+  // the copies are ordered with the replays in the stream of the segment
+  Stream* stream = ctx.GetDeviceStream(stream_idx);
+  return stream != nullptr ? session_state_.GetDataTransferMgr().CopyTensorAsync(src, dst, *stream)
+                           : session_state_.GetDataTransferMgr().CopyTensor(src, dst);
+}
+
+}  // namespace onnxruntime
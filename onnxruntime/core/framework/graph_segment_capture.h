@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/ort_value.h"
+#include "core/graph/basic_types.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class IExecutionProvider;
+class SessionScope;
+class SessionState;
+class StreamExecutionContext;
+class Tensor;
+
+/**
+ * Captures the kernels of an execution provider with graph capture support, e.g. the CUDA execution provider with
+ * CUDA graphs, in segments, for a model that can't be captured as a whole. The nodes that can't be captured run as
+ * usual between the segments: the nodes of other execution providers, the copies between devices, which synchronize
+ * with the host, and the nodes whose output shapes depend on the data, such as NonZero or NonMaxSuppression.
+ *
+ * A segment is a maximal sequence of consecutive kernel launches of a logic stream of the execution plan on nodes that
+ * can be captured. A segment runs as usual for its first runs, so that the arena holds the memory it needs, the next
+ * run captures it, and the following runs replay it.
+ *
+ * The capture reads its inputs from copies that it owns and keeps all the values it writes alive with the graph, so
+ * no other tensor is ever placed at an address the graph uses. A replay copies the inputs into the captured ones and
+ * the outputs the rest of the plan reads out of the captured ones, in the order of the stream, so concurrent runs can
+ * replay the same segment. A segment runs as usual when the shapes of its inputs or the values of its inputs in CPU
+ * memory differ from the captured ones.
+ */
+class GraphSegmentCapture {
+ public:
+  // How a run executes a segment.
+  enum class Mode : uint8_t {
+    kRegular,
+    kCapture,
+    kReplay,
+  };
+
+  GraphSegmentCapture(const SessionState& session_state, IExecutionProvider& ep);
+  ~GraphSegmentCapture();
+
+  size_t NumSegments() const { return segments_.size(); }
+
+  // Runs the kernel of a node, as part of its segment if it has one.
+  Status ExecuteKernel(StreamExecutionContext& ctx, NodeIndex node_index, size_t stream_idx,
+                       const bool& terminate_flag, SessionScope& session_scope) const;
+
+  // Called once the kernel of a node computed, before its inputs are released, to keep the values of segments being
+  // captured alive.
+  void OnKernelComputed(StreamExecutionContext& ctx, NodeIndex node_index) const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(GraphSegmentCapture);
+
+ private:
+  struct Output {
+    NodeIndex node_index;
+    int output_index;
+    int frame_index;
+    // the output is the buffer of a feed, so it holds the data without a copy
+    bool is_shared;
+  };
+
+  struct Segment {
+    InlinedVector<NodeIndex> nodes;
+    // the frame entries of the values the segment reads that are produced before it, one per value
+    InlinedVector<int> input_frame_indices;
+    // the values produced by the segment that the rest of the plan reads
+    InlinedVector<Output> outputs;
+
+    // the state shared by the runs
+    OrtMutex mutex;
+    int regular_runs = 0;
+    bool is_capturing = false;
+    bool is_captured = false;
+    bool is_disabled = false;
+    InlinedVector<OrtValue> captured_inputs;   // parallel to input_frame_indices
+    InlinedVector<OrtValue> captured_values;   // every value the capture wrote, kept alive as long as the graph
+    InlinedVector<OrtValue> captured_outputs;  // parallel to outputs
+    // the frame entries that tensors of the capture replace while it runs, with their values
+    InlinedVector<std::pair<int, OrtValue>> replaced_values;
+  };
+
+  Status BeginSegment(StreamExecutionContext& ctx, size_t segment_idx, size_t stream_idx, Mode& mode) const;
+  Status PrepareCapture(StreamExecutionContext& ctx, Segment& segment, size_t stream_idx) const;
+  void RestoreReplacedValues(StreamExecutionContext& ctx, Segment& segment) const;
+  Status EndCapture(StreamExecutionContext& ctx, size_t segment_idx, size_t stream_idx, bool is_computed) const;
+  bool InputsMatchCapture(StreamExecutionContext& ctx, const Segment& segment) const;
+  Status Replay(StreamExecutionContext& ctx, size_t segment_idx, size_t stream_idx) const;
+  Status CopyOutputs(StreamExecutionContext& ctx, const Segment& segment, size_t stream_idx) const;
+  Status CopyTensor(StreamExecutionContext& ctx, const Tensor& src, Tensor& dst, size_t stream_idx) const;
+
+  const SessionState& session_state_;
+  IExecutionProvider& ep_;
+  std::vector<std::unique_ptr<Segment>> segments_;
+  // the segment of each node, or -1
+  std::vector<int> node_segments_;
+};
+
+}  // namespace onnxruntime
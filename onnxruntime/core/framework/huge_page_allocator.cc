@@ -0,0 +1,232 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/huge_page_allocator.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <fstream>
+#include <string>
+
+#include "core/common/logging/logging.h"
+#include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
+
+#if defined(_WIN32)
+#include <Windows.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#endif
+
+namespace onnxruntime {
+
+#if defined(__linux__)
+namespace {
+// values from <linux/mempolicy.h>, spelled out to not depend on libnuma headers
+constexpr int kMpolBind = 2;
+constexpr int kMaxNumaNodes = 1024;
+
+int HugeTlbFlags(size_t huge_page_bytes) {
+  const int log2_page_size = huge_page_bytes == HugePageCPUAllocator::kHugePage1GB ? 30 : 21;
+  return MAP_HUGETLB | (log2_page_size << MAP_HUGE_SHIFT);
+}
+
+void BindToNumaNode(void* p, size_t size, int numa_node) {
+  constexpr size_t kBitsPerWord = sizeof(unsigned long) * 8;
+  unsigned long node_mask[kMaxNumaNodes / kBitsPerWord] = {};
+  node_mask[numa_node / kBitsPerWord] = 1UL << (numa_node % kBitsPerWord);
+  // the kernel expects the number of bits in the mask plus one
+  if (syscall(SYS_mbind, p, size, kMpolBind, node_mask, kMaxNumaNodes + 1, 0) != 0) {
+    LOGS_DEFAULT(WARNING) << "Unable to bind " << size << " bytes to NUMA node " << numa_node
+                          << ". errno: " << errno;
+  }
+}
+}  // namespace
+#endif
+
+HugePageCPUAllocator::HugePageCPUAllocator(const OrtMemoryInfo& memory_info, size_t huge_page_bytes, int numa_node)
+    : IAllocator(memory_info), huge_page_bytes_(huge_page_bytes), numa_node_(numa_node) {
+  ORT_ENFORCE(huge_page_bytes_ == kHugePage2MB || huge_page_bytes_ == kHugePage1GB,
+              "Huge page size must be 2MB or 1GB. Got ", huge_page_bytes_);
+#if defined(__linux__)
+  ORT_ENFORCE(numa_node_ >= -1 && numa_node_ < kMaxNumaNodes, "Invalid NUMA node: ", numa_node_);
+#else
+  ORT_ENFORCE(numa_node_ >= -1, "Invalid NUMA node: ", numa_node_);
+#endif
+}
+
+HugePageCPUAllocator::~HugePageCPUAllocator() {
+  for (const auto& entry : mapped_sizes_) {
+    UnmapPages(entry.first, entry.second);
+  }
+}
+
+int HugePageCPUAllocator::GetNumaNodeCount() {
+#if defined(__linux__)
+  // a list of ranges of the online node ids, e.g. "0-1" or "0,2-3"
+  std::ifstream online("/sys/devices/system/node/online");
+  std::string list;
+  if (!std::getline(online, list)) {
+    return 1;
+  }
+
+  int highest_node = 0;
+  int value = 0;
+  bool has_digits = false;
+  for (const char c : list) {
+    if (c >= '0' && c <= '9') {
+      value = value * 10 + (c - '0');
+      has_digits = true;
+      if (value >= kMaxNumaNodes) {
+        return kMaxNumaNodes;
+      }
+    } else {
+      if (has_digits) {
+        highest_node = std::max(highest_node, value);
+      }
+      value = 0;
+      has_digits = false;
+    }
+  }
+  if (has_digits) {
+    highest_node = std::max(highest_node, value);
+  }
+  return highest_node + 1;
+#elif defined(_WIN32)
+  ULONG highest_node = 0;
+  if (!GetNumaHighestNodeNumber(&highest_node)) {
+    return 1;
+  }
+  return static_cast<int>(highest_node) + 1;
+#else
+  return 1;
+#endif
+}
+
+void* HugePageCPUAllocator::Alloc(size_t size) {
+  if (size == 0) return nullptr;
+
+  // keep the padding MLAS kernels may read past the end of a buffer, as AllocatorDefaultAlloc does
+  SafeInt<size_t> padded_size = SafeInt<size_t>(size) + MLAS_SYMM_QGEMM_BUF_OVERRUN;
+  const size_t mapped_size = ((padded_size + huge_page_bytes_ - 1) / huge_page_bytes_) * huge_page_bytes_;
+
+  void* p = MapPages(mapped_size);
+  if (p == nullptr) {
+    ORT_THROW_EX(std::bad_alloc);
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  mapped_sizes_[p] = mapped_size;
+  return p;
+}
+
+void HugePageCPUAllocator::Free(void* p) {
+  if (p == nullptr) return;
+
+  size_t mapped_size = 0;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = mapped_sizes_.find(p);
+    ORT_ENFORCE(it != mapped_sizes_.end(), "Pointer was not allocated by this allocator: ", p);
+    mapped_size = it->second;
+    mapped_sizes_.erase(it);
+  }
+
+  UnmapPages(p, mapped_size);
+}
+
+#if defined(__linux__)
+void* HugePageCPUAllocator::MapPages(size_t mapped_size) {
+  constexpr int kProt = PROT_READ | PROT_WRITE;
+  constexpr int kFlags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+  // explicit huge pages are only available if the administrator reserved a pool of them
+  void* p = mmap(nullptr, mapped_size, kProt, kFlags | HugeTlbFlags(huge_page_bytes_), -1, 0);
+  if (p == MAP_FAILED) {
+    LOGS_DEFAULT(VERBOSE) << "No explicit huge pages of " << huge_page_bytes_
+                          << " bytes available. Using transparent huge pages.";
+
+    // transparent huge pages are 2MB. over-map so the start can be aligned to a huge page boundary,
+    // otherwise the kernel backs only the aligned middle part of the range with huge pages.
+    constexpr size_t kAlignment = kHugePage2MB;
+    void* raw = mmap(nullptr, mapped_size + kAlignment, kProt, kFlags, -1, 0);
+    if (raw == MAP_FAILED) {
+      return nullptr;
+    }
+
+    const uintptr_t raw_addr = reinterpret_cast<uintptr_t>(raw);
+    const uintptr_t aligned_addr = (raw_addr + kAlignment - 1) & ~(uintptr_t{kAlignment} - 1);
+    const size_t head = aligned_addr - raw_addr;
+    const size_t tail = kAlignment - head;
+    if (head > 0) {
+      munmap(raw, head);
+    }
+    if (tail > 0) {
+      munmap(reinterpret_cast<void*>(aligned_addr + mapped_size), tail);
+    }
+
+    p = reinterpret_cast<void*>(aligned_addr);
+    if (madvise(p, mapped_size, MADV_HUGEPAGE) != 0) {
+      LOGS_DEFAULT(VERBOSE) << "madvise(MADV_HUGEPAGE) failed. errno: " << errno;
+    }
+  }
+
+  // bind before the pages are first touched so they are faulted in on the requested node
+  if (numa_node_ >= 0) {
+    BindToNumaNode(p, mapped_size, numa_node_);
+  }
+
+  return p;
+}
+
+void HugePageCPUAllocator::UnmapPages(void* p, size_t mapped_size) {
+  munmap(p, mapped_size);
+}
+
+#elif defined(_WIN32)
+void* HugePageCPUAllocator::MapPages(size_t mapped_size) {
+  const auto virtual_alloc = [this, mapped_size](DWORD allocation_type) -> void* {
+    if (numa_node_ >= 0) {
+      return VirtualAllocExNuma(GetCurrentProcess(), nullptr, mapped_size, allocation_type, PAGE_READWRITE,
+                                static_cast<DWORD>(numa_node_));
+    }
+    return VirtualAlloc(nullptr, mapped_size, allocation_type, PAGE_READWRITE);
+  };
+
+  // large pages need SeLockMemoryPrivilege. mapped_size is a multiple of 2MB, which is what
+  // GetLargePageMinimum() returns on x64.
+  void* p = nullptr;
+  const size_t large_page_minimum = GetLargePageMinimum();
+  if (large_page_minimum != 0 && mapped_size % large_page_minimum == 0) {
+    p = virtual_alloc(MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES);
+  }
+
+  if (p == nullptr) {
+    LOGS_DEFAULT(VERBOSE) << "Large pages are not available. Using regular pages.";
+    p = virtual_alloc(MEM_RESERVE | MEM_COMMIT);
+  }
+
+  return p;
+}
+
+void HugePageCPUAllocator::UnmapPages(void* p, size_t /*mapped_size*/) {
+  VirtualFree(p, 0, MEM_RELEASE);
+}
+
+#else
+void* HugePageCPUAllocator::MapPages(size_t mapped_size) {
+  return AllocatorDefaultAlloc(mapped_size);
+}
+
+void HugePageCPUAllocator::UnmapPages(void* p, size_t /*mapped_size*/) {
+  AllocatorDefaultFree(p);
+}
+#endif
+
+}  // namespace onnxruntime
@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <unordered_map>
+
+#include "core/framework/allocator.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+// CPU device allocator that maps every allocation directly from the OS, backed by huge pages and optionally bound
+// to a NUMA node. It is meant to sit behind a BFCArena, so that each arena region is a handful of huge pages
+// instead of thousands of 4KB pages, which cuts TLB misses for large weight and activation buffers.
+//
+// Linux: explicit huge pages (MAP_HUGETLB) are used if the system has a pool of the requested page size,
+// otherwise transparent huge pages are requested with madvise(MADV_HUGEPAGE). NUMA binding uses mbind().
+// Windows: large pages (MEM_LARGE_PAGES) are used if the process holds SeLockMemoryPrivilege, otherwise regular
+// pages. NUMA binding uses VirtualAllocExNuma().
+// Other platforms fall back to AllocatorDefaultAlloc() and ignore both settings.
+class HugePageCPUAllocator : public IAllocator {
+ public:
+  static constexpr size_t kHugePage2MB = size_t{2} * 1024 * 1024;
+  static constexpr size_t kHugePage1GB = size_t{1024} * 1024 * 1024;
+
+  // huge_page_bytes must be kHugePage2MB or kHugePage1GB. numa_node of -1 disables NUMA binding.
+  HugePageCPUAllocator(const OrtMemoryInfo& memory_info, size_t huge_page_bytes, int numa_node);
+
+  HugePageCPUAllocator(size_t huge_page_bytes, int numa_node)
+      : HugePageCPUAllocator(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator), huge_page_bytes, numa_node) {}
+
+  ~HugePageCPUAllocator() override;
+
+  // Returns the highest NUMA node id of the system plus one, i.e. the number of valid numa_node values, or 1 if the
+  // nodes are not known.
+  static int GetNumaNodeCount();
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+
+ private:
+  void* MapPages(size_t mapped_size);
+  void UnmapPages(void* p, size_t mapped_size);
+
+  const size_t huge_page_bytes_;
+  const int numa_node_;
+
+  OrtMutex mutex_;
+  // size of every live mapping, needed to unmap it
+  std::unordered_map<void*, size_t> mapped_sizes_;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(HugePageCPUAllocator);
+};
+
+}  // namespace onnxruntime
@@ -189,6 +189,12 @@ KernelDefBuilder& KernelDefBuilder::MayStridedOutput(int input_index, int output
   kernel_def_->may_strided_output_map_.emplace_back(input_index, output_index);
   return *this;
 }
+
+KernelDefBuilder& KernelDefBuilder::VariadicMayStridedOutput(int input_index) {
+  ORT_ENFORCE(input_index >= 0);
+  kernel_def_->variadic_may_strided_output_ = input_index;
+  return *this;
+}
 #endif
 
 }  // namespace onnxruntime
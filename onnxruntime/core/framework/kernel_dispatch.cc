@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/kernel_dispatch.h"
+
+#include <algorithm>
+
+#include "core/graph/graph.h"
+#include "nlohmann/json.hpp"
+
+using json = nlohmann::json;
+
+namespace onnxruntime {
+
+namespace {
+
+thread_local KernelDispatchRecorder* current_recorder = nullptr;
+// the scope of the kernel running on the thread, nullptr outside of a kernel
+thread_local KernelDispatchScope* current_kernel_scope = nullptr;
+
+}  // namespace
+
+bool IsRecordingKernelDispatch() noexcept {
+  return current_kernel_scope != nullptr;
+}
+
+void RecordKernelDispatch(const char* key, const char* value) {
+  KernelDispatchScope* scope = current_kernel_scope;
+  if (scope == nullptr) {
+    return;
+  }
+
+  auto& dispatches = scope->dispatches_;
+  auto it = std::find_if(dispatches.begin(), dispatches.end(), [&](const auto& entry) { return entry.first == key; });
+  if (it == dispatches.end()) {
+    dispatches.emplace_back(key, value);
+    return;
+  }
+  // e.g. the batches of a MatMul taking different paths
+  for (size_t begin = 0; begin <= it->second.size();) {
+    size_t end = it->second.find(',', begin);
+    end = end == std::string::npos ? it->second.size() : end;
+    if (it->second.compare(begin, end - begin, value) == 0) {
+      return;
+    }
+    begin = end + 1;
+  }
+  it->second.append(",").append(value);
+}
+
+void KernelDispatchRecorder::Record(const Node& node, Dispatches dispatches) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto [it, inserted] = node_indices_.emplace(&node, nodes_.size());
+  if (inserted) {
+    nodes_.push_back({node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name(),
+                      node.OpType(), node.GetExecutionProviderType(), 0, {}});
+  }
+  auto& entry = nodes_[it->second];
+  ++entry.calls;
+  entry.dispatches = std::move(dispatches);
+}
+
+std::string KernelDispatchRecorder::ToJson() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  json nodes = json::array();
+  for (const auto& entry : nodes_) {
+    json dispatch = json::object();
+    for (const auto& [key, value] : entry.dispatches) {
+      dispatch[key] = value;
+    }
+    nodes.push_back({{"node_name", entry.node_name},
+                     {"op_type", entry.op_type},
+                     {"provider", entry.provider},
+                     {"calls", entry.calls},
+                     {"dispatch", std::move(dispatch)}});
+  }
+  return nodes.dump();
+}
+
+KernelDispatchRecorder* KernelDispatchRecorder::Current() {
+  return current_recorder;
+}
+
+KernelDispatchScope::KernelDispatchScope(KernelDispatchRecorder* recorder, const Node* node)
+    : recorder_(recorder), node_(node), previous_recorder_(current_recorder), previous_scope_(current_kernel_scope) {
+  current_recorder = recorder;
+  // the control flow kernels run their subgraphs from their Compute, whose kernels get their own scope
+  current_kernel_scope = node != nullptr ? this : nullptr;
+}
+
+KernelDispatchScope::~KernelDispatchScope() {
+  current_recorder = previous_recorder_;
+  current_kernel_scope = previous_scope_;
+  if (recorder_ != nullptr && node_ != nullptr && !dispatches_.empty()) {
+    recorder_->Record(*node_, std::move(dispatches_));
+  }
+}
+
+std::string KernelDispatchScope::ToString() const {
+  std::string result;
+  for (const auto& [key, value] : dispatches_) {
+    result.append(result.empty() ? "" : ";").append(key).append("=").append(value);
+  }
+  return result;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+class Node;
+
+// Whether the kernel running on the calling thread records the variant it dispatches to. Kernels check it before
+// computing a value that is costly, e.g. the signature of a tunable op.
+bool IsRecordingKernelDispatch() noexcept;
+
+// Records the variant of the kernel running on the calling thread that key dispatched to, e.g. key "mlas_sgemm" and
+// value "avx512f", or key "attention_kernel" and value "flash". Called from Compute, before the work is handed to
+// other threads. Does nothing unless IsRecordingKernelDispatch(). A key recorded with several values in one call of
+// the kernel keeps them all, separated by ','.
+void RecordKernelDispatch(const char* key, const char* value);
+
+// The variants the nodes of a session dispatched to in their last Run, enabled with
+// kOrtSessionOptionsRecordKernelDispatch. The nodes of subgraphs are included.
+class KernelDispatchRecorder {
+ public:
+  using Dispatches = std::vector<std::pair<std::string, std::string>>;
+
+  KernelDispatchRecorder() = default;
+
+  // Replaces the dispatches recorded for node by those of its last call.
+  void Record(const Node& node, Dispatches dispatches);
+
+  // A JSON array with an object for each node that recorded dispatches, in the order they first ran:
+  // {"node_name": ..., "op_type": ..., "provider": ..., "calls": <number of calls recorded>,
+  //  "dispatch": {<key>: <value>, ...}}
+  std::string ToJson() const;
+
+  // The recorder of the current KernelDispatchScope of the calling thread, nullptr if none
+  static KernelDispatchRecorder* Current();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(KernelDispatchRecorder);
+
+ private:
+  struct NodeDispatches {
+    std::string node_name;
+    std::string op_type;
+    std::string provider;
+    uint64_t calls;
+    Dispatches dispatches;
+  };
+
+  mutable std::mutex mutex_;
+  std::vector<NodeDispatches> nodes_;
+  std::unordered_map<const Node*, size_t> node_indices_;
+};
+
+// Makes recorder current on the calling thread for the lifetime of the scope. With a node, the scope collects the
+// dispatches recorded by the kernel of the node, and hands them to recorder when it ends. recorder may be nullptr to
+// only collect them, e.g. for the profiler.
+class KernelDispatchScope {
+ public:
+  KernelDispatchScope(KernelDispatchRecorder* recorder, const Node* node);
+  ~KernelDispatchScope();
+
+  // The dispatches collected so far, as "key=value;key=value"
+  std::string ToString() const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(KernelDispatchScope);
+
+ private:
+  friend void RecordKernelDispatch(const char* key, const char* value);
+
+  KernelDispatchRecorder* const recorder_;
+  const Node* const node_;
+  KernelDispatchRecorder::Dispatches dispatches_;
+  KernelDispatchRecorder* previous_recorder_;
+  KernelDispatchScope* previous_scope_;
+};
+
+}  // namespace onnxruntime
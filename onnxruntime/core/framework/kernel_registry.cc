@@ -15,7 +15,7 @@ namespace onnxruntime {
 
 namespace {
 bool IsTypeProtoCompatible(gsl::span<const MLDataType> enabled_types, const ONNX_NAMESPACE::TypeProto& actual_type,
-                           std::string& mismatch_reason) {
+                           std::string* mismatch_reason) {
   const bool is_type_compatible = std::any_of(
       enabled_types.begin(), enabled_types.end(),
       [&actual_type](const DataTypeImpl* expected_type) {
@@ -24,6 +24,10 @@ bool IsTypeProtoCompatible(gsl::span<const MLDataType> enabled_types, const ONNX
       });
 
   if (!is_type_compatible) {
+    if (mismatch_reason == nullptr) {
+      return false;
+    }
+
     std::ostringstream ostr;
     ostr << "This op has been implemented only for the following types (";
     for (const auto& enabled_type : enabled_types) {
@@ -32,7 +36,7 @@ bool IsTypeProtoCompatible(gsl::span<const MLDataType> enabled_types, const ONNX
     ostr << "),";
     const char* actual_type_str = DataTypeImpl::ToString(DataTypeImpl::TypeFromProto(actual_type));
     ostr << " but the node in the model has the following type (" << actual_type_str << ")";
-    mismatch_reason = ostr.str();
+    *mismatch_reason = ostr.str();
     return false;
   }
 
@@ -43,7 +47,7 @@ bool IsTypeProtoCompatible(gsl::span<const MLDataType> enabled_types, const ONNX
 bool MatchKernelDefTypes(const Node& node,
                          const std::unordered_map<std::string, std::vector<MLDataType>>& kernel_type_constraints,
                          const IKernelTypeStrResolver& kernel_type_str_resolver,
-                         std::string& mismatch_reason) {
+                         std::string* mismatch_reason) {
   const auto actual_inputs = node.InputDefs();
   const auto actual_outputs = node.OutputDefs();
   const auto& actual_input_arg_counts = node.InputArgCount();
@@ -116,7 +120,8 @@ bool MatchKernelDefTypes(const std::unordered_map<std::string, std::vector<MLDat
 }
 }  // namespace
 
-static bool VerifyVersion(int since_ver, const KernelDef& kernel_def, std::string& error_str) {
+// error_str may be nullptr, as formatting the error costs more than the check
+static bool VerifyVersion(int since_ver, const KernelDef& kernel_def, std::string* error_str) {
   // check if version matches
   int kernel_start_version;
   int kernel_end_version;
@@ -131,13 +136,13 @@ static bool VerifyVersion(int since_ver, const KernelDef& kernel_def, std::strin
       (kernel_end_version != INT_MAX &&
        kernel_start_version <= since_ver && kernel_end_version >= since_ver);
 
-  if (!valid_version) {
+  if (!valid_version && error_str != nullptr) {
     std::ostringstream ostr;
     ostr << " Version mismatch."
          << " node_version: " << since_ver
          << " kernel start version: " << kernel_start_version
          << " kernel_end_version: " << kernel_end_version;
-    error_str = ostr.str();
+    *error_str = ostr.str();
   }
   return valid_version;
 }
@@ -146,7 +151,7 @@ bool KernelRegistry::VerifyKernelDef(const Node& node,
                                      const KernelDef& kernel_def,
                                      const IKernelTypeStrResolver* kernel_type_str_resolver,
                                      const TypeConstraintMap* type_constraint_values,
-                                     std::string& error_str) {
+                                     std::string* error_str) {
   // check if version matches
   bool valid_version = VerifyVersion(node.SinceVersion(), kernel_def, error_str);
 
@@ -159,15 +164,15 @@ bool KernelRegistry::VerifyKernelDef(const Node& node,
 
   bool matched = type_constraint_values ? MatchKernelDefTypes(kernel_type_constraints, *type_constraint_values)
                                         : MatchKernelDefTypes(node, kernel_type_constraints, *kernel_type_str_resolver,
-                                                              mismatch_reason);
+                                                              error_str != nullptr ? &mismatch_reason : nullptr);
 
-  if (!matched) {
+  if (!matched && error_str != nullptr) {
     std::ostringstream ostr;
     ostr << "Kernel found kernel"
          << " in the supported version range"
          << " (node_version: " << node.SinceVersion() << ")."
          << " However the types are incompatible. " << mismatch_reason;
-    error_str = ostr.str();
+    *error_str = ostr.str();
   }
 
   return matched;
@@ -189,21 +194,26 @@ Status KernelRegistry::TryFindKernelImpl(const Node& node,
   auto range = kernel_creator_fn_map_.equal_range(GetMapKey(node.OpType(), node.Domain(), expected_provider));
   if (out) *out = nullptr;
 
-  std::vector<std::string> verify_kernel_def_error_strs;
-
   for (auto i = range.first; i != range.second; ++i) {
-    std::string error_str;
-    if (VerifyKernelDef(node, *i->second.kernel_def, kernel_type_str_resolver, type_constraints, error_str)) {
+    if (VerifyKernelDef(node, *i->second.kernel_def, kernel_type_str_resolver, type_constraints, nullptr)) {
       if (out) {
         *out = &i->second;
       }
       return Status::OK();
     }
-
-    verify_kernel_def_error_strs.push_back(error_str);
   }
 
-  if (!verify_kernel_def_error_strs.empty()) {
+  // the errors of the kernels that don't match are only formatted when none does, as most lookups succeed after
+  // skipping the kernels for other versions or types
+  if (range.first != range.second) {
+    std::vector<std::string> verify_kernel_def_error_strs;
+    for (auto i = range.first; i != range.second; ++i) {
+      std::string error_str;
+      ORT_IGNORE_RETURN_VALUE(
+          VerifyKernelDef(node, *i->second.kernel_def, kernel_type_str_resolver, type_constraints, &error_str));
+      verify_kernel_def_error_strs.push_back(error_str);
+    }
+
     std::ostringstream oss;
     oss << "Op with name (" << node.Name() << ")"
         << " domain (" << node.Domain() << ")"
@@ -235,7 +245,7 @@ Status KernelRegistry::TryFindKernel(const Node& node, ProviderType exec_provide
 
 static bool KernelDefCompatible(int version, const KernelDef& kernel_def,
                                 const KernelRegistry::TypeConstraintMap& type_constraint_values,
-                                std::string& error_str) {
+                                std::string* error_str) {
   if (!VerifyVersion(version, kernel_def, error_str)) {
     return false;
   }
@@ -243,13 +253,13 @@ static bool KernelDefCompatible(int version, const KernelDef& kernel_def,
   const auto& kernel_type_constraints = kernel_def.TypeConstraints();
   bool matched = MatchKernelDefTypes(kernel_type_constraints, type_constraint_values);
 
-  if (!matched) {
+  if (!matched && error_str != nullptr) {
     std::ostringstream ostr;
     ostr << "Kernel found kernel"
          << " in the supported version range"
          << " (node_version: " << version << ")."
          << " However the types are incompatible.";
-    error_str = ostr.str();
+    *error_str = ostr.str();
   }
 
   return matched;
@@ -264,21 +274,23 @@ Status KernelRegistry::TryFindKernel(ProviderType exec_provider,
   auto range = kernel_creator_fn_map_.equal_range(GetMapKey(op_type, domain, exec_provider));
   if (out) *out = nullptr;
 
-  std::vector<std::string> verify_kernel_def_error_strs;
-
   for (auto i = range.first; i != range.second; ++i) {
-    std::string error_str;
-    if (KernelDefCompatible(version, *i->second.kernel_def, type_constraints, error_str)) {
+    if (KernelDefCompatible(version, *i->second.kernel_def, type_constraints, nullptr)) {
       if (out) {
         *out = &i->second;
       }
       return Status::OK();
     }
-
-    verify_kernel_def_error_strs.push_back(error_str);
   }
 
-  if (!verify_kernel_def_error_strs.empty()) {
+  if (range.first != range.second) {
+    std::vector<std::string> verify_kernel_def_error_strs;
+    for (auto i = range.first; i != range.second; ++i) {
+      std::string error_str;
+      ORT_IGNORE_RETURN_VALUE(KernelDefCompatible(version, *i->second.kernel_def, type_constraints, &error_str));
+      verify_kernel_def_error_strs.push_back(error_str);
+    }
+
     std::ostringstream oss;
     oss << "Op type (" << op_type << ")"
         << " domain (" << domain << ")"
@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+
+#include "core/common/gsl.h"
+#include "core/common/inlined_containers.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/**
+ * Memoizes what a kernel derives from the shapes of its inputs and the values of its shape inputs, such as its output
+ * shapes, across the Runs of a session, for the kernels for which deriving it costs more than the lookup, e.g. Slice.
+ *
+ * The key is built by the kernel from the dims of its inputs and the values it reads, each prefixed by their count so
+ * that different splits of the same numbers don't collide. The kernel is shared by the concurrent Runs of the
+ * session, so the cache is guarded by a mutex. It keeps the kMaxEntries most recently inserted entries, which serve
+ * the few distinct shapes a node typically sees, e.g. a decoder's prefill and decode steps.
+ */
+template <typename T>
+class KernelShapeCache {
+ public:
+  using Key = InlinedVector<int64_t, 16>;
+
+  static constexpr size_t kMaxEntries = 4;
+
+  static void AppendToKey(gsl::span<const int64_t> values, Key& key) {
+    key.push_back(static_cast<int64_t>(values.size()));
+    key.insert(key.end(), values.begin(), values.end());
+  }
+
+  // Copies the value cached for the key to value. Returns false if there is none.
+  bool Find(const Key& key, T& value) const {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    const auto it = std::find_if(entries_.begin(), entries_.end(),
+                                 [&key](const auto& entry) { return entry.first == key; });
+    if (it == entries_.end()) {
+      return false;
+    }
+    value = it->second;
+    return true;
+  }
+
+  void Insert(Key key, T value) const {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    if (std::any_of(entries_.begin(), entries_.end(), [&key](const auto& entry) { return entry.first == key; })) {
+      // inserted by a concurrent Run
+      return;
+    }
+    if (entries_.size() == kMaxEntries) {
+      entries_.erase(entries_.begin());
+    }
+    entries_.emplace_back(std::move(key), std::move(value));
+  }
+
+ private:
+  mutable OrtMutex mutex_;
+  mutable InlinedVector<std::pair<Key, T>, kMaxEntries> entries_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/lean_execution_plan.h"
+
+#include "core/framework/op_kernel.h"
+#include "core/framework/sequential_execution_plan.h"
+#include "core/framework/session_state.h"
+
+namespace onnxruntime {
+
+std::unique_ptr<LeanExecutionPlan> LeanExecutionPlan::Create(const SessionState& session_state) {
+#ifdef USE_CANN
+  // the CANN execution provider runs OnRunStart on the thread of each logic stream
+  ORT_UNUSED_PARAMETER(session_state);
+  return nullptr;
+#else
+  if (session_state.GetGraphSegmentCapture() != nullptr || session_state.GetWeightStreamer() != nullptr) {
+    return nullptr;
+  }
+
+  const auto* execution_plan = session_state.GetExecutionPlan();
+  if (execution_plan == nullptr) {
+    return nullptr;
+  }
+
+  // the plan of a graph without nodes has no stream with steps, and runs lean as an empty array
+  std::unique_ptr<LeanExecutionPlan> plan(new LeanExecutionPlan());
+  bool has_stream = false;
+  for (size_t i = 0; i < execution_plan->execution_plan.size(); ++i) {
+    const auto& logic_stream = execution_plan->execution_plan[i];
+    if (logic_stream == nullptr || logic_stream->steps_.empty()) {
+      continue;
+    }
+    if (has_stream) {
+      return nullptr;
+    }
+    has_stream = true;
+    plan->stream_index_ = i;
+
+    plan->kernels_.reserve(logic_stream->steps_.size());
+    for (const auto& step : logic_stream->steps_) {
+      if (!step->IsKernelLaunch()) {
+        return nullptr;
+      }
+
+      const NodeIndex node_index = step->GetNodeIndex();
+      const OpKernel* kernel = session_state.GetKernel(node_index);
+      if (kernel == nullptr || kernel->IsAsync() || kernel->KernelDef().OpName() == "YieldOp" ||
+          kernel->KernelDef().AllocateInputsContiguously()) {
+        return nullptr;
+      }
+
+      KernelRecord record{kernel, plan->released_values_.size(), 0};
+      if (node_index < execution_plan->node_release_list.size()) {
+        for (const auto release_idx : execution_plan->node_release_list[node_index]) {
+          const auto& release_action = execution_plan->release_actions[release_idx];
+          // a count of 0 means the value is never released, above 1 it is read on several streams
+          if (release_action.ref_count > 1) {
+            return nullptr;
+          }
+          if (release_action.ref_count == 1) {
+            plan->released_values_.push_back(static_cast<int>(release_action.value_index));
+          }
+        }
+      }
+      record.release_end = plan->released_values_.size();
+      plan->kernels_.push_back(record);
+    }
+  }
+
+  return plan;
+#endif
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+
+namespace onnxruntime {
+
+class OpKernel;
+class SessionState;
+
+/**
+ * The kernels of an execution plan that runs on a single logic stream and does nothing between its kernels but
+ * release their inputs, flattened into an array of records when the session is initialized. The executor runs them
+ * one after the other, without stepping through the plan, counting the references of the released values or
+ * checking for the instrumentation of the run at each kernel, see kOrtSessionOptionsLeanExecutor.
+ *
+ * Nothing in the records depends on the shapes of the values, so the plan serves the Runs with any feed shapes.
+ */
+class LeanExecutionPlan {
+ public:
+  struct KernelRecord {
+    const OpKernel* kernel;
+    // the OrtValue indices released once the kernel computed are ReleasedValues()[release_begin, release_end)
+    size_t release_begin;
+    size_t release_end;
+  };
+
+  // Returns nullptr if the execution plan of the session state can't run lean: it has more than one logic stream,
+  // synchronizes with notifications or barriers, releases values by reference counting, or has async kernels,
+  // YieldOp or kernels that need their inputs allocated contiguously, or the session captures graph segments or
+  // streams its weights. Must be called once the kernels are created.
+  static std::unique_ptr<LeanExecutionPlan> Create(const SessionState& session_state);
+
+  // the index of the logic stream of the execution plan the kernels are in
+  size_t StreamIndex() const noexcept { return stream_index_; }
+
+  gsl::span<const KernelRecord> Kernels() const noexcept { return kernels_; }
+
+  gsl::span<const int> ReleasedValues() const noexcept { return released_values_; }
+
+ private:
+  LeanExecutionPlan() = default;
+
+  size_t stream_index_ = 0;
+  std::vector<KernelRecord> kernels_;
+  std::vector<int> released_values_;
+};
+
+}  // namespace onnxruntime
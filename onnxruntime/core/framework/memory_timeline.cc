@@ -0,0 +1,284 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/memory_timeline.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <set>
+
+#include "core/graph/graph.h"
+#include "nlohmann/json.hpp"
+
+using json = nlohmann::json;
+
+namespace onnxruntime {
+
+namespace {
+
+thread_local MemoryTimeline* current_timeline = nullptr;
+thread_local const Node* current_node = nullptr;
+
+const char* KindName(MemoryTimeline::AllocationKind kind) {
+  switch (kind) {
+    case MemoryTimeline::AllocationKind::kPatternBuffer:
+      return "pattern_buffer";
+    case MemoryTimeline::AllocationKind::kPlanned:
+      return "planned";
+    case MemoryTimeline::AllocationKind::kDynamic:
+      return "dynamic";
+    case MemoryTimeline::AllocationKind::kOutput:
+      return "output";
+  }
+  return "";
+}
+
+}  // namespace
+
+MemoryTimeline::MemoryTimeline(int64_t run_id, std::map<std::string, size_t> initializer_bytes)
+    : run_id_(run_id), initializer_bytes_(std::move(initializer_bytes)), start_(std::chrono::steady_clock::now()) {
+}
+
+int64_t MemoryTimeline::Now() const {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count();
+}
+
+void MemoryTimeline::AddAllocation(Allocation allocation, const void* owner, int value_index) {
+  if (current_node != nullptr) {
+    allocation.node_name = current_node->Name().empty() ? MakeString(current_node->OpType(), "_", current_node->Index())
+                                                        : current_node->Name();
+    allocation.op_type = current_node->OpType();
+  }
+
+  const int64_t time_ns = Now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  const size_t index = allocations_.size();
+  const bool failed = allocation.failed;
+  allocations_.push_back(std::move(allocation));
+  events_.push_back({time_ns, index, false});
+  if (!failed) {
+    live_[{owner, value_index}] = index;
+  }
+}
+
+void MemoryTimeline::RecordAllocation(const void* owner, int value_index, std::string_view tensor_name, size_t bytes,
+                                      const OrtDevice& device, bool arena, int stream, AllocationKind kind) {
+  AddAllocation({std::string(tensor_name), bytes, device.ToString(), arena, stream, kind, {}, {}, false}, owner,
+                value_index);
+}
+
+void MemoryTimeline::RecordFailedAllocation(std::string_view tensor_name, size_t bytes, const OrtDevice& device,
+                                            int stream) {
+  AddAllocation({std::string(tensor_name), bytes, device.ToString(), false, stream, AllocationKind::kDynamic, {}, {},
+                 true},
+                nullptr, 0);
+}
+
+void MemoryTimeline::RecordFree(const void* owner, int value_index) {
+  const int64_t time_ns = Now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = live_.find({owner, value_index});
+  if (it != live_.end()) {
+    events_.push_back({time_ns, it->second, true});
+    live_.erase(it);
+  }
+}
+
+void MemoryTimeline::RecordFrees(const void* owner) {
+  const int64_t time_ns = Now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto it = live_.lower_bound({owner, std::numeric_limits<int>::min()});
+       it != live_.end() && it->first.first == owner;) {
+    events_.push_back({time_ns, it->second, true});
+    it = live_.erase(it);
+  }
+}
+
+Status MemoryTimeline::Write(const std::string& file_prefix) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // the bytes of each device over time. The planned tensors are counted apart as their pattern buffer is counted
+  // already.
+  struct DeviceTimeline {
+    int pid;
+    size_t allocated = 0;
+    size_t planned = 0;
+    std::set<size_t> live;
+    size_t peak = 0;
+    int64_t peak_time_ns = 0;
+    size_t peak_allocation = 0;
+    std::vector<size_t> live_at_peak;
+  };
+  std::map<std::string, DeviceTimeline> devices;
+  auto get_device = [&](const std::string& device) -> DeviceTimeline& {
+    auto it = devices.find(device);
+    if (it == devices.end()) {
+      it = devices.emplace(device, DeviceTimeline{static_cast<int>(devices.size()) + 1}).first;
+    }
+    return it->second;
+  };
+  for (const auto& [device, bytes] : initializer_bytes_) {
+    get_device(device);
+  }
+
+  json trace_events = json::array();
+  std::vector<size_t> failed;
+  int64_t end_time_ns = 0;
+  for (const auto& event : events_) {
+    const Allocation& allocation = allocations_[event.allocation];
+    DeviceTimeline& device = get_device(allocation.device);
+    const double ts = static_cast<double>(event.time_ns) / 1000.0;
+    end_time_ns = std::max(end_time_ns, event.time_ns);
+    if (allocation.failed) {
+      failed.push_back(event.allocation);
+      trace_events.push_back({{"name", "failed allocation of " + allocation.tensor_name},
+                              {"ph", "i"},
+                              {"s", "p"},
+                              {"ts", ts},
+                              {"pid", device.pid},
+                              {"tid", 0},
+                              {"args", {{"bytes", allocation.bytes}, {"node", allocation.node_name}}}});
+      continue;
+    }
+
+    size_t& counter = allocation.kind == AllocationKind::kPlanned ? device.planned : device.allocated;
+    if (event.is_free) {
+      counter -= allocation.bytes;
+      device.live.erase(event.allocation);
+    } else {
+      counter += allocation.bytes;
+      device.live.insert(event.allocation);
+    }
+
+    json lifetime{{"name", allocation.tensor_name},
+                  {"cat", KindName(allocation.kind)},
+                  {"ph", event.is_free ? "e" : "b"},
+                  {"id", event.allocation},
+                  {"ts", ts},
+                  {"pid", device.pid},
+                  {"tid", 0}};
+    if (!event.is_free) {
+      lifetime["args"] = {{"bytes", allocation.bytes},
+                          {"node", allocation.node_name},
+                          {"op_type", allocation.op_type},
+                          {"stream", allocation.stream},
+                          {"arena", allocation.arena}};
+    }
+    trace_events.push_back(std::move(lifetime));
+    trace_events.push_back({{"name", "bytes"},
+                            {"ph", "C"},
+                            {"ts", ts},
+                            {"pid", device.pid},
+                            {"tid", 0},
+                            {"args", {{"allocated", device.allocated}, {"planned tensors", device.planned}}}});
+
+    if (!event.is_free && allocation.kind != AllocationKind::kPlanned && device.allocated > device.peak) {
+      device.peak = device.allocated;
+      device.peak_time_ns = event.time_ns;
+      device.peak_allocation = event.allocation;
+      device.live_at_peak.assign(device.live.begin(), device.live.end());
+    }
+  }
+
+  // the allocations nothing freed, e.g. of a Run which failed, end with the timeline
+  for (const auto& [device_name, device] : devices) {
+    for (size_t allocation : device.live) {
+      trace_events.push_back({{"name", allocations_[allocation].tensor_name},
+                              {"cat", KindName(allocations_[allocation].kind)},
+                              {"ph", "e"},
+                              {"id", allocation},
+                              {"ts", static_cast<double>(end_time_ns) / 1000.0},
+                              {"pid", device.pid},
+                              {"tid", 0}});
+    }
+    trace_events.push_back({{"name", "process_name"},
+                            {"ph", "M"},
+                            {"pid", device.pid},
+                            {"args", {{"name", "memory " + device_name}}}});
+  }
+
+  const std::string trace_path = file_prefix + ".json";
+  std::ofstream trace_file(trace_path, std::ios::out | std::ios::trunc);
+  ORT_RETURN_IF_NOT(trace_file.good(), "Failed to open the memory timeline file ", trace_path);
+  trace_file << json{{"traceEvents", std::move(trace_events)}, {"displayTimeUnit", "ns"}}.dump() << std::endl;
+  ORT_RETURN_IF_NOT(trace_file.good(), "Failed to write the memory timeline file ", trace_path);
+
+  const std::string report_path = file_prefix + "_peak.txt";
+  std::ofstream report(report_path, std::ios::out | std::ios::trunc);
+  ORT_RETURN_IF_NOT(report.good(), "Failed to open the memory peak report ", report_path);
+
+  auto write_allocations = [&](std::vector<size_t> indices, size_t total) {
+    std::sort(indices.begin(), indices.end(),
+              [&](size_t a, size_t b) { return allocations_[a].bytes > allocations_[b].bytes; });
+    report << "  " << std::setw(14) << "bytes" << std::setw(8) << "share" << "  " << std::left << std::setw(16)
+           << "kind" << std::right << std::setw(7) << "stream" << std::setw(7) << "arena" << "  " << std::left
+           << std::setw(40) << "node" << "tensor" << std::right << "\n";
+    for (size_t index : indices) {
+      const Allocation& allocation = allocations_[index];
+      report << "  " << std::setw(14) << allocation.bytes << std::setw(7) << std::fixed << std::setprecision(1)
+             << (total > 0 ? 100.0 * static_cast<double>(allocation.bytes) / static_cast<double>(total) : 0.0)
+             << "%  " << std::left << std::setw(16) << KindName(allocation.kind) << std::right << std::setw(7)
+             << allocation.stream << std::setw(7) << (allocation.arena ? "yes" : "no") << "  " << std::left
+             << std::setw(40) << (allocation.node_name.empty() ? "-" : allocation.node_name) << allocation.tensor_name
+             << std::right << "\n";
+    }
+  };
+
+  report << "Memory peaks of Run " << run_id_ << "\n";
+  for (const auto& [device_name, device] : devices) {
+    auto initializers = initializer_bytes_.find(device_name);
+    report << "\n"
+           << device_name << ": peak of " << device.peak << " bytes allocated for the Run at " << std::fixed
+           << std::setprecision(3) << static_cast<double>(device.peak_time_ns) / 1e6 << " ms";
+    if (device.peak > 0 && !allocations_[device.peak_allocation].node_name.empty()) {
+      report << " in node " << allocations_[device.peak_allocation].node_name << " ("
+             << allocations_[device.peak_allocation].op_type << ")";
+    }
+    report << ", plus " << (initializers != initializer_bytes_.end() ? initializers->second : 0)
+           << " bytes of initializers\n";
+    if (device.peak == 0) {
+      continue;
+    }
+
+    std::vector<size_t> allocated, planned;
+    for (size_t index : device.live_at_peak) {
+      (allocations_[index].kind == AllocationKind::kPlanned ? planned : allocated).push_back(index);
+    }
+    report << " allocations live at the peak:\n";
+    write_allocations(std::move(allocated), device.peak);
+    if (!planned.empty()) {
+      report << " tensors live at the peak in the memory pattern buffers:\n";
+      write_allocations(std::move(planned), device.peak);
+    }
+  }
+
+  if (!failed.empty()) {
+    report << "\nfailed allocations:\n";
+    for (size_t index : failed) {
+      const Allocation& allocation = allocations_[index];
+      report << "  " << allocation.bytes << " bytes on " << allocation.device << " for " << allocation.tensor_name
+             << (allocation.node_name.empty() ? "" : " in node " + allocation.node_name) << "\n";
+    }
+  }
+  ORT_RETURN_IF_NOT(report.good(), "Failed to write the memory peak report ", report_path);
+  return Status::OK();
+}
+
+MemoryTimeline* MemoryTimeline::Current() {
+  return current_timeline;
+}
+
+MemoryTimelineScope::MemoryTimelineScope(MemoryTimeline* timeline, const Node* node)
+    : previous_timeline_(current_timeline), previous_node_(current_node) {
+  current_timeline = timeline;
+  current_node = node;
+}
+
+MemoryTimelineScope::~MemoryTimelineScope() {
+  current_timeline = previous_timeline_;
+  current_node = previous_node_;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,116 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/framework/ortdevice.h"
+
+namespace onnxruntime {
+
+class Node;
+
+// Records the allocations and frees of the tensors of a Run, of the main graph and of its subgraphs, with the node
+// that ran when the tensor was allocated. Enabled with kOrtSessionOptionsMemoryTimelineFilePrefix.
+//
+// Unlike the MemoryInfo of ORT_MEMORY_PROFILE builds, which replays the offsets of the memory patterns, it records
+// the sizes allocated as the Run goes, so dynamic shapes and allocations the planner didn't plan are included. The
+// scratch buffers kernels allocate from the allocators directly are not.
+//
+// Write() emits the timeline as a Chrome trace, which Perfetto also loads: a counter of the allocated bytes of each
+// device and the lifetime of each tensor. Next to it a report lists, for each device, the tensors live at the peak.
+class MemoryTimeline {
+ public:
+  enum class AllocationKind {
+    // a buffer of the memory pattern, holding the planned tensors
+    kPatternBuffer,
+    // a tensor placed in a buffer of the memory pattern, allocating nothing itself
+    kPlanned,
+    // a tensor allocated from the allocator of its device when it was produced
+    kDynamic,
+    // an output of the graph, allocated from the allocator of its device
+    kOutput,
+  };
+
+  // initializer_bytes: the bytes of the initializers of the session, by device, reported as the baseline of the peak
+  MemoryTimeline(int64_t run_id, std::map<std::string, size_t> initializer_bytes);
+
+  // Records an allocation which owner, e.g. the execution frame, frees by value_index later. The node is the node
+  // of the current MemoryTimelineScope of the calling thread.
+  void RecordAllocation(const void* owner, int value_index, std::string_view tensor_name, size_t bytes,
+                        const OrtDevice& device, bool arena, int stream, AllocationKind kind);
+
+  // Records an allocation that threw, most likely because the device is out of memory.
+  void RecordFailedAllocation(std::string_view tensor_name, size_t bytes, const OrtDevice& device, int stream);
+
+  // Does nothing if the allocation of value_index by owner wasn't recorded or was freed already.
+  void RecordFree(const void* owner, int value_index);
+
+  // Frees the allocations of owner that are still live.
+  void RecordFrees(const void* owner);
+
+  // Writes the trace to <file_prefix>.json and the report of the peaks to <file_prefix>_peak.txt.
+  Status Write(const std::string& file_prefix) const;
+
+  // The timeline of the current MemoryTimelineScope of the calling thread, nullptr if none
+  static MemoryTimeline* Current();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MemoryTimeline);
+
+ private:
+  struct Allocation {
+    std::string tensor_name;
+    size_t bytes;
+    std::string device;
+    bool arena;
+    int stream;
+    AllocationKind kind;
+    std::string node_name;
+    std::string op_type;
+    bool failed;
+  };
+
+  struct Event {
+    int64_t time_ns;
+    size_t allocation;
+    bool is_free;
+  };
+
+  int64_t Now() const;
+  void AddAllocation(Allocation allocation, const void* owner, int value_index);
+
+  const int64_t run_id_;
+  const std::map<std::string, size_t> initializer_bytes_;
+  const std::chrono::steady_clock::time_point start_;
+
+  mutable std::mutex mutex_;
+  std::vector<Allocation> allocations_;
+  std::vector<Event> events_;
+  // the live allocations by owner and value index
+  std::map<std::pair<const void*, int>, size_t> live_;
+};
+
+// Makes timeline current on the calling thread for the lifetime of the scope, with the node whose kernel runs on it.
+// timeline and node may be nullptr.
+class MemoryTimelineScope {
+ public:
+  MemoryTimelineScope(MemoryTimeline* timeline, const Node* node);
+  ~MemoryTimelineScope();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MemoryTimelineScope);
+
+ private:
+  MemoryTimeline* previous_timeline_;
+  const Node* previous_node_;
+};
+
+}  // namespace onnxruntime
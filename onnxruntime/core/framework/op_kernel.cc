@@ -69,6 +69,27 @@ bool OpKernelContext::TryGetInferredOutputShape(int index, TensorShape& shape) c
   return execution_frame_->TryGetInferredShape(GetOutputArgIndex(index), shape);
 }
 
+bool OpKernelContext::IsInputDeadAfterKernel(int index) const {
+  if (index < 0 || index >= InputCount())
+    return false;
+
+  return execution_frame_->IsNodeInputDeadAfterNode(kernel_->Node(), index);
+}
+
+Tensor* OpKernelContext::OutputMayReuseInput(int output_index, int input_index, const TensorShape& shape) {
+  if (output_index >= 0 && output_index < OutputCount() && IsInputDeadAfterKernel(input_index)) {
+    OrtValue* p_ml_value = nullptr;
+    Status status = execution_frame_->TryReuseNodeInputForOutput(GetInputArgIndex(input_index),
+                                                                 GetOutputArgIndex(output_index), shape, p_ml_value);
+    ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
+    if (p_ml_value) {
+      return p_ml_value->GetMutable<Tensor>();
+    }
+  }
+
+  return Output(output_index, shape);
+}
+
 OrtValue* OpKernelContext::OutputMLValue(int index, const TensorShape& shape) {
   if (index < 0 || index >= OutputCount())
     return nullptr;
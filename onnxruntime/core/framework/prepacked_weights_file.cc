@@ -0,0 +1,253 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/prepacked_weights_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "core/common/cpuid_info.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensor.h"
+#include "core/graph/graph.h"
+#include "onnxruntime_config.h"
+
+namespace onnxruntime {
+
+/*
+File layout, all integers little endian as written by the host:
+  "ORTPACK1", uint32 fingerprint size, fingerprint
+  buffers, each aligned to kAlignment bytes from the start of the file
+  index: uint64 number of weights, for each weight
+         uint32 key size, key, uint32 number of buffers, for each buffer uint64 offset, uint64 size
+  uint64 offset of the index
+*/
+namespace {
+constexpr char kMagic[8] = {'O', 'R', 'T', 'P', 'A', 'C', 'K', '1'};
+// MLAS packed buffers are read with aligned vector loads
+constexpr size_t kAlignment = 64;
+
+// Identifies the runtime and the instruction set extensions the packed layouts depend on
+const std::string& Fingerprint() {
+  static const std::string fingerprint = []() {
+    const auto& cpu = CPUIDInfo::GetCPUIDInfo();
+    std::ostringstream ss;
+    ss << ORT_VERSION << ";" << sizeof(void*) << ";"
+       << cpu.HasSSE3() << cpu.HasSSE4_1() << cpu.HasAVX() << cpu.HasAVX2() << cpu.HasF16C()
+       << cpu.HasAVX512f() << cpu.HasAVX512Skylake() << cpu.HasAVX512_BF16() << cpu.HasAMX_BF16()
+       << cpu.HasArmNeonDot() << cpu.HasArmNeon_I8MM() << cpu.HasArmSVE_I8MM() << cpu.HasFp16VectorAcceleration();
+    return ss.str();
+  }();
+  return fingerprint;
+}
+
+void HashBytes(const void* data, size_t size, uint32_t (&hash)[4]) {
+  // MurmurHash3 takes an int length
+  constexpr size_t kChunk = size_t{1} << 30;
+  const char* p = static_cast<const char*>(data);
+  do {
+    const size_t len = std::min(size, kChunk);
+    MurmurHash3::x86_128(p, static_cast<int>(len), hash[0], &hash);
+    p += len;
+    size -= len;
+  } while (size > 0);
+}
+
+template <typename T>
+void Write(std::ofstream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+}  // namespace
+
+Status PrepackedWeightsFile::Open(const PathString& path, const logging::Logger& logger,
+                                  std::unique_ptr<PrepackedWeightsFile>& file) {
+  file.reset(new PrepackedWeightsFile(path));
+
+  size_t length = 0;
+  if (!std::filesystem::exists(std::filesystem::path(path)) ||
+      !Env::Default().GetFileLength(path.c_str(), length).IsOK() || length == 0) {
+    return Status::OK();
+  }
+  ORT_RETURN_IF_ERROR(Env::Default().MapFileIntoMemory(path.c_str(), 0, length, file->mapping_));
+
+  // an unusable file is not an error, it is rewritten with the weights packed by this session
+  auto status = file->ParseMapping(length);
+  if (!status.IsOK()) {
+    LOGS(logger, WARNING) << "Ignoring pre-packed weights file " << PathToUTF8String(path) << ": "
+                          << status.ErrorMessage();
+    file->mapped_weights_.clear();
+    file->mapping_.reset();
+  }
+  return Status::OK();
+}
+
+Status PrepackedWeightsFile::ParseMapping(size_t length) {
+  const char* const base = mapping_.get();
+  size_t pos = 0;
+  const auto read = [&](void* value, size_t size) -> Status {
+    ORT_RETURN_IF(size > length || pos > length - size, "The file is truncated");
+    std::memcpy(value, base + pos, size);
+    pos += size;
+    return Status::OK();
+  };
+
+  char magic[sizeof(kMagic)];
+  ORT_RETURN_IF_ERROR(read(magic, sizeof(magic)));
+  ORT_RETURN_IF(std::memcmp(magic, kMagic, sizeof(kMagic)) != 0, "Not a pre-packed weights file");
+  uint32_t fingerprint_size = 0;
+  ORT_RETURN_IF_ERROR(read(&fingerprint_size, sizeof(fingerprint_size)));
+  std::string fingerprint(fingerprint_size, '\0');
+  ORT_RETURN_IF_ERROR(read(fingerprint.data(), fingerprint_size));
+  ORT_RETURN_IF(fingerprint != Fingerprint(), "The file was written by another version or for another CPU");
+
+  uint64_t index_offset = 0;
+  ORT_RETURN_IF(length < sizeof(index_offset), "The file is truncated");
+  pos = length - sizeof(index_offset);
+  ORT_RETURN_IF_ERROR(read(&index_offset, sizeof(index_offset)));
+  ORT_RETURN_IF(index_offset > length - sizeof(index_offset), "The index is out of bounds");
+  pos = static_cast<size_t>(index_offset);
+
+  uint64_t num_weights = 0;
+  ORT_RETURN_IF_ERROR(read(&num_weights, sizeof(num_weights)));
+  for (uint64_t w = 0; w < num_weights; ++w) {
+    uint32_t key_size = 0;
+    ORT_RETURN_IF_ERROR(read(&key_size, sizeof(key_size)));
+    std::string key(key_size, '\0');
+    ORT_RETURN_IF_ERROR(read(key.data(), key_size));
+    uint32_t num_buffers = 0;
+    ORT_RETURN_IF_ERROR(read(&num_buffers, sizeof(num_buffers)));
+
+    std::vector<gsl::span<const char>> buffers;
+    for (uint32_t b = 0; b < num_buffers; ++b) {
+      uint64_t offset = 0, size = 0;
+      ORT_RETURN_IF_ERROR(read(&offset, sizeof(offset)));
+      ORT_RETURN_IF_ERROR(read(&size, sizeof(size)));
+      ORT_RETURN_IF(offset > index_offset || size > index_offset - offset, "A buffer is out of bounds");
+      buffers.emplace_back(size > 0 ? base + offset : nullptr, static_cast<size_t>(size));
+    }
+    mapped_weights_.emplace(std::move(key), std::move(buffers));
+  }
+  return Status::OK();
+}
+
+bool PrepackedWeightsFile::GetWeight(const std::string& key, std::vector<BufferUniquePtr>& buffers) const {
+  auto it = mapped_weights_.find(key);
+  if (it == mapped_weights_.end()) {
+    return false;
+  }
+  buffers.clear();
+  for (const auto& buffer : it->second) {
+    // BufferDeleter is nullptr because the buffers are owned by the mapping
+    buffers.emplace_back(const_cast<char*>(buffer.data()), BufferDeleter(nullptr));
+  }
+  return true;
+}
+
+const PrePackedWeights& PrepackedWeightsFile::AddWeight(const std::string& key, PrePackedWeights&& weights) {
+  ORT_ENFORCE(weights.buffers_.size() == weights.buffer_sizes_.size());
+  return added_weights_.insert_or_assign(key, std::move(weights)).first->second;
+}
+
+Status PrepackedWeightsFile::Save() const {
+  if (added_weights_.empty()) {
+    return Status::OK();
+  }
+
+  std::filesystem::path path(path_);
+  std::filesystem::path tmp_path(path_ + ToPathString(".tmp" + std::to_string(Env::Default().GetSelfPid())));
+  std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+  ORT_RETURN_IF_NOT(out, "Failed to open ", tmp_path.string(), " for writing");
+
+  const std::string& fingerprint = Fingerprint();
+  out.write(kMagic, sizeof(kMagic));
+  Write(out, static_cast<uint32_t>(fingerprint.size()));
+  out.write(fingerprint.data(), static_cast<std::streamsize>(fingerprint.size()));
+
+  // buffers first, remembering where they went for the index
+  std::vector<std::pair<const std::string*, std::vector<std::pair<uint64_t, uint64_t>>>> index;
+  uint64_t pos = sizeof(kMagic) + sizeof(uint32_t) + fingerprint.size();
+  const auto write_buffer = [&](const void* data, size_t size) {
+    if (data == nullptr || size == 0) {
+      return std::make_pair(uint64_t{0}, uint64_t{0});
+    }
+    static const char padding[kAlignment] = {};
+    const uint64_t padding_size = (kAlignment - pos % kAlignment) % kAlignment;
+    out.write(padding, static_cast<std::streamsize>(padding_size));
+    pos += padding_size;
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    auto entry = std::make_pair(pos, static_cast<uint64_t>(size));
+    pos += size;
+    return entry;
+  };
+  for (const auto& [key, buffers] : mapped_weights_) {
+    if (added_weights_.count(key)) {
+      continue;
+    }
+    auto& entry = index.emplace_back(&key, std::vector<std::pair<uint64_t, uint64_t>>{});
+    for (const auto& buffer : buffers) {
+      entry.second.push_back(write_buffer(buffer.data(), buffer.size()));
+    }
+  }
+  for (const auto& [key, weights] : added_weights_) {
+    auto& entry = index.emplace_back(&key, std::vector<std::pair<uint64_t, uint64_t>>{});
+    for (size_t b = 0; b < weights.buffers_.size(); ++b) {
+      entry.second.push_back(write_buffer(weights.buffers_[b].get(), weights.buffer_sizes_[b]));
+    }
+  }
+
+  const uint64_t index_offset = pos;
+  Write(out, static_cast<uint64_t>(index.size()));
+  for (const auto& [key, buffers] : index) {
+    Write(out, static_cast<uint32_t>(key->size()));
+    out.write(key->data(), static_cast<std::streamsize>(key->size()));
+    Write(out, static_cast<uint32_t>(buffers.size()));
+    for (const auto& [offset, size] : buffers) {
+      Write(out, offset);
+      Write(out, size);
+    }
+  }
+  Write(out, index_offset);
+  out.close();
+  ORT_RETURN_IF_NOT(out, "Failed to write ", tmp_path.string());
+
+  std::error_code ec;
+  std::filesystem::rename(tmp_path, path, ec);
+  if (ec) {
+    std::filesystem::remove(tmp_path, ec);
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to replace ", path.string(), " with ", tmp_path.string());
+  }
+  return Status::OK();
+}
+
+std::string PrepackedWeightsFile::GenerateKey(const Node& node, int input_idx, const Tensor& tensor) {
+  uint32_t hash[4] = {0, 0, 0, 0};
+
+  // attributes like transB change the packed layout. hash them in name order to be independent of the map order
+  std::vector<const std::string*> attr_names;
+  for (const auto& attr : node.GetAttributes()) {
+    attr_names.push_back(&attr.first);
+  }
+  std::sort(attr_names.begin(), attr_names.end(), [](const auto* a, const auto* b) { return *a < *b; });
+  for (const auto* name : attr_names) {
+    const std::string attr = node.GetAttributes().at(*name).SerializeAsString();
+    HashBytes(attr.data(), attr.size(), hash);
+  }
+
+  const auto dims = tensor.Shape().GetDims();
+  HashBytes(dims.data(), dims.size_bytes(), hash);
+  HashBytes(tensor.DataRaw(), tensor.SizeInBytes(), hash);
+
+  std::ostringstream ss;
+  ss << node.Domain() << "+" << node.OpType() << "+" << node.SinceVersion() << "+" << node.GetExecutionProviderType()
+     << "+" << input_idx << "+" << DataTypeImpl::ToString(tensor.DataType()) << "+" << std::hex << std::setfill('0');
+  for (uint32_t h : hash) {
+    ss << std::setw(8) << h;
+  }
+  return ss.str();
+}
+
+}  // namespace onnxruntime
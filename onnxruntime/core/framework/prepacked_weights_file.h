@@ -0,0 +1,68 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/common/logging/logging.h"
+#include "core/common/path_string.h"
+#include "core/framework/buffer_deleter.h"
+#include "core/framework/prepacked_weights.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+class Node;
+class Tensor;
+
+/**
+ * A file of pre-packed weights, written by a session after packing its weights and memory mapped by later
+ * sessions of the same model so they can skip PrePack().
+ *
+ * Weights are looked up by a key that identifies the kernel, its attributes and the contents of the packed
+ * tensor, so a file can be shared by several models. The file is only used on a CPU with the same instruction set
+ * extensions as the one that wrote it, as the packed layouts are specific to the kernels MLAS selects for the CPU.
+ *
+ * The mapping is read only and shared, so processes that load the same model share the physical pages of the
+ * pre-packed weights.
+ */
+class PrepackedWeightsFile {
+ public:
+  // Maps the file at path. A missing file, or one written by another CPU or version, is treated as empty and is
+  // replaced by Save().
+  static Status Open(const PathString& path, const logging::Logger& logger,
+                     std::unique_ptr<PrepackedWeightsFile>& file);
+
+  // Returns pointers into the mapping for the buffers of the weight with the key. The buffers must not be freed
+  // or written to, and remain valid for the lifetime of this instance.
+  bool GetWeight(const std::string& key, std::vector<BufferUniquePtr>& buffers) const;
+
+  // Keeps a weight packed by this session, to be written by Save().
+  const PrePackedWeights& AddWeight(const std::string& key, PrePackedWeights&& weights);
+
+  // Writes the mapped and added weights to the file if any weights were added.
+  // The new file replaces the old one atomically, so other processes keep their mapping of the old file.
+  Status Save() const;
+
+  // Key of the weight for input_idx of the kernel of node packed from tensor, which must not be a string tensor
+  static std::string GenerateKey(const Node& node, int input_idx, const Tensor& tensor);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrepackedWeightsFile);
+
+ private:
+  explicit PrepackedWeightsFile(const PathString& path) : path_(path) {}
+
+  Status ParseMapping(size_t length);
+
+  const PathString path_;
+  Env::MappedMemoryPtr mapping_;
+  // buffers of the weights in mapping_
+  std::unordered_map<std::string, std::vector<gsl::span<const char>>> mapped_weights_;
+  std::unordered_map<std::string, PrePackedWeights> added_weights_;
+};
+
+}  // namespace onnxruntime
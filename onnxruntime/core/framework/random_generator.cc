@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/framework/random_generator.h"
+
+#include <algorithm>
+
 #include "core/framework/random_seed.h"
 
 namespace onnxruntime {
@@ -16,4 +19,52 @@ PhiloxGenerator& PhiloxGenerator::Default() {
   return generator;
 }
 
+void PhiloxEngine::Generate(uint64_t seed, uint64_t subsequence, uint64_t counter, size_t count, uint32_t* output) {
+  constexpr uint32_t kMultiplier0 = 0xD2511F53;
+  constexpr uint32_t kMultiplier1 = 0xCD9E8D57;
+  constexpr uint32_t kKeyIncrement0 = 0x9E3779B9;
+  constexpr uint32_t kKeyIncrement1 = 0xBB67AE85;
+  constexpr int kNumRounds = 10;
+  // the rounds are applied to a batch of counters at a time, in loops that compilers vectorize
+  constexpr size_t kBatchSize = 16;
+
+  uint32_t x0[kBatchSize];
+  uint32_t x1[kBatchSize];
+  uint32_t x2[kBatchSize];
+  uint32_t x3[kBatchSize];
+  for (size_t begin = 0; begin < count; begin += kBatchSize) {
+    const size_t batch_size = std::min(kBatchSize, count - begin);
+    for (size_t i = 0; i < batch_size; ++i) {
+      const uint64_t batch_counter = counter + begin + i;
+      x0[i] = static_cast<uint32_t>(batch_counter);
+      x1[i] = static_cast<uint32_t>(batch_counter >> 32);
+      x2[i] = static_cast<uint32_t>(subsequence);
+      x3[i] = static_cast<uint32_t>(subsequence >> 32);
+    }
+
+    uint32_t key0 = static_cast<uint32_t>(seed);
+    uint32_t key1 = static_cast<uint32_t>(seed >> 32);
+    for (int round = 0; round < kNumRounds; ++round) {
+      for (size_t i = 0; i < batch_size; ++i) {
+        const uint64_t product0 = static_cast<uint64_t>(kMultiplier0) * x0[i];
+        const uint64_t product1 = static_cast<uint64_t>(kMultiplier1) * x2[i];
+        x0[i] = static_cast<uint32_t>(product1 >> 32) ^ x1[i] ^ key0;
+        x1[i] = static_cast<uint32_t>(product1);
+        x2[i] = static_cast<uint32_t>(product0 >> 32) ^ x3[i] ^ key1;
+        x3[i] = static_cast<uint32_t>(product0);
+      }
+      key0 += kKeyIncrement0;
+      key1 += kKeyIncrement1;
+    }
+
+    uint32_t* batch_output = output + begin * kNumOutputs;
+    for (size_t i = 0; i < batch_size; ++i) {
+      batch_output[i * kNumOutputs] = x0[i];
+      batch_output[i * kNumOutputs + 1] = x1[i];
+      batch_output[i * kNumOutputs + 2] = x2[i];
+      batch_output[i * kNumOutputs + 3] = x3[i];
+    }
+  }
+}
+
 }  // namespace onnxruntime
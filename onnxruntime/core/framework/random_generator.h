@@ -4,6 +4,7 @@
 #pragma once
 
 #include <atomic>
+#include <stddef.h>
 #include <stdint.h>
 #include <utility>
 
@@ -84,4 +85,29 @@ class PhiloxGenerator {
   uint64_t offset_;
 };
 
+/**
+ * Philox_4x32_10 engine, which maps a 64-bit key and a 128-bit counter to four 32-bit random numbers as the curand
+ * Philox4_32_10 generator does. Any block of the sequence is computed from its counter alone, so a CPU kernel can
+ * generate the random numbers of disjoint ranges of its output in parallel and still produce the same sequence for
+ * the seed and offset it got from a PhiloxGenerator, whatever the number of threads.
+ */
+class PhiloxEngine {
+ public:
+  static constexpr size_t kNumOutputs = 4;
+
+  /**
+   * Computes the kNumOutputs random numbers of each of the count counters starting at counter to output.
+   * counter is the low 64 bits of the 128-bit counter, subsequence its high 64 bits.
+   */
+  static void Generate(uint64_t seed, uint64_t subsequence, uint64_t counter, size_t count, uint32_t* output);
+
+  /**
+   * Maps a random number to a float in (0, 1], as curand_uniform does.
+   */
+  static float ToUniformFloat(uint32_t value) {
+    constexpr float k2Pow32Inv = 2.3283064e-10f;
+    return static_cast<float>(value) * k2Pow32Inv + k2Pow32Inv / 2.0f;
+  }
+};
+
 }  // namespace onnxruntime
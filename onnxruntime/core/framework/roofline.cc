@@ -0,0 +1,220 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/roofline.h"
+
+#include <unordered_set>
+
+#include "core/common/cpuid_info.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Shape of the input, also when it is a constant initializer that was released after pre-packing
+const TensorShape* GetInputShape(const OpKernelContextInternal& context, const OpKernel& kernel, int index) {
+  if (index >= context.InputCount()) {
+    return nullptr;
+  }
+  const Tensor* tensor = nullptr;
+  if (!kernel.Info().TryGetConstantInput(index, &tensor)) {
+    const OrtValue* value = context.GetInputMLValue(index);
+    if (value == nullptr || !value->IsTensor()) {
+      return nullptr;
+    }
+    tensor = &value->Get<Tensor>();
+  }
+  return &tensor->Shape();
+}
+
+const TensorShape* GetOutputShape(OpKernelContextInternal& context, int index) {
+  if (index >= context.OutputCount()) {
+    return nullptr;
+  }
+  const OrtValue* value = context.GetOutputMLValue(index);
+  return value != nullptr && value->IsTensor() ? &value->Get<Tensor>().Shape() : nullptr;
+}
+
+uint64_t Size(const TensorShape& shape) {
+  const int64_t size = shape.Size();
+  return size > 0 ? static_cast<uint64_t>(size) : 0;
+}
+
+// the size of a dimension counted from the end, or 1 if the shape has fewer dimensions
+uint64_t DimFromEnd(const TensorShape& shape, size_t index) {
+  return shape.NumDimensions() > index ? static_cast<uint64_t>(shape[shape.NumDimensions() - 1 - index]) : 1;
+}
+
+// Ops counted as one operation per output element. Transcendental functions take more instructions than that, but
+// how many depends on the kernel, so they are counted like the arithmetic ops.
+const std::unordered_set<std::string>& ElementwiseOps() {
+  static const std::unordered_set<std::string> ops{
+      "Abs", "Add", "BiasGelu", "Ceil", "Clip", "Div", "Elu", "Erf", "Exp", "FastGelu", "Floor", "Gelu",
+      "HardSigmoid", "HardSwish", "LeakyRelu", "Log", "Max", "Mean", "Min", "Mod", "Mul", "Neg", "Pow",
+      "PRelu", "QuickGelu", "Reciprocal", "Relu", "Round", "Selu", "Sigmoid", "Sign", "Softplus", "Sqrt", "Sub",
+      "Sum", "Tanh", "ThresholdedRelu", "Where", "BiasAdd", "FusedElementwise"};
+  return ops;
+}
+
+// Ops counted as one operation per input element
+const std::unordered_set<std::string>& ReductionOps() {
+  static const std::unordered_set<std::string> ops{
+      "ArgMax", "ArgMin", "GlobalAveragePool", "GlobalMaxPool", "ReduceL1", "ReduceL2", "ReduceLogSum",
+      "ReduceLogSumExp", "ReduceMax", "ReduceMean", "ReduceMin", "ReduceProd", "ReduceSum", "ReduceSumSquare"};
+  return ops;
+}
+
+// Normalizations and the operations they take per input element: the passes computing the statistics plus the
+// normalization itself
+const std::unordered_map<std::string, uint64_t>& NormalizationOps() {
+  static const std::unordered_map<std::string, uint64_t> ops{
+      {"Softmax", 4}, {"LogSoftmax", 4}, {"BatchNormalization", 2}, {"InstanceNormalization", 7},
+      {"LayerNormalization", 7}, {"SimplifiedLayerNormalization", 5}, {"SkipLayerNormalization", 8},
+      {"SkipSimplifiedLayerNormalization", 6}, {"GroupNorm", 7}};
+  return ops;
+}
+
+uint64_t MatMulFlops(const TensorShape& a, const TensorShape& y, bool trans_a) {
+  // Y[..., M, N] = A[..., M, K] x B[..., K, N]
+  const uint64_t k = a.NumDimensions() == 1 ? DimFromEnd(a, 0) : DimFromEnd(a, trans_a ? 1 : 0);
+  return 2 * Size(y) * k;
+}
+
+std::optional<uint64_t> AttentionFlops(OpKernelContextInternal& context, const OpKernel& kernel,
+                                       const std::string& op_type) {
+  const TensorShape* query = GetInputShape(context, kernel, 0);
+  const TensorShape* output = GetOutputShape(context, 0);
+  if (query == nullptr || output == nullptr || output->NumDimensions() != 3) {
+    return std::nullopt;
+  }
+
+  // Q x K^T and the product of the probabilities with V, each 2 * B * S * L * hidden size
+  const uint64_t batch = static_cast<uint64_t>((*output)[0]);
+  const uint64_t sequence_length = static_cast<uint64_t>((*output)[1]);
+  const uint64_t v_hidden_size = static_cast<uint64_t>((*output)[2]);
+  uint64_t total_sequence_length = sequence_length;
+  uint64_t flops = 0;
+
+  if (op_type == "Attention") {
+    // the QKV projection of input [B, S, D] by weights [D, D_q + D_k + D_v], then the past of [2, B, N, P, H]
+    const TensorShape* weights = GetInputShape(context, kernel, 1);
+    if (weights == nullptr || weights->NumDimensions() != 2) {
+      return std::nullopt;
+    }
+    flops += 2 * Size(*query) * static_cast<uint64_t>((*weights)[1]);
+    if (const TensorShape* past = GetInputShape(context, kernel, 4); past != nullptr && past->NumDimensions() == 5) {
+      total_sequence_length += static_cast<uint64_t>((*past)[3]);
+    }
+  } else {
+    // the present key output of [B, N_kv, L, H] holds the past and new keys, otherwise the key input of [B, L, D] or
+    // [B, N, L, H] has them. Without either the query packs the keys of the same length.
+    if (const TensorShape* present_key = GetOutputShape(context, 1);
+        present_key != nullptr && present_key->NumDimensions() == 4) {
+      total_sequence_length = static_cast<uint64_t>((*present_key)[2]);
+    } else if (const TensorShape* key = GetInputShape(context, kernel, 1); key != nullptr && Size(*key) > 0) {
+      if (key->NumDimensions() == 3) {
+        total_sequence_length = static_cast<uint64_t>((*key)[1]);
+      } else if (key->NumDimensions() == 4) {
+        total_sequence_length = static_cast<uint64_t>((*key)[2]);
+      } else {
+        return std::nullopt;
+      }
+    }
+  }
+
+  // the key hidden size is the query hidden size, the value hidden size is the output hidden size
+  const uint64_t qk_hidden_size = op_type == "Attention" ? v_hidden_size
+                                  : query->NumDimensions() == 3 ? static_cast<uint64_t>((*query)[2])
+                                                                 : v_hidden_size;
+  flops += 2 * batch * sequence_length * total_sequence_length * (qk_hidden_size + v_hidden_size);
+  return flops;
+}
+
+}  // namespace
+
+std::optional<uint64_t> EstimateKernelFlops(OpKernelContextInternal& context, const OpKernel& kernel) {
+  const auto& node = kernel.Node();
+  const std::string& op_type = node.OpType();
+  const TensorShape* y = GetOutputShape(context, 0);
+  if (y == nullptr) {
+    return std::nullopt;
+  }
+
+  if (op_type == "MatMul" || op_type == "MatMulInteger" || op_type == "QLinearMatMul" ||
+      op_type == "MatMulIntegerToFloat" || op_type == "DynamicQuantizeMatMul" || op_type == "MatMulNBits" ||
+      op_type == "FusedMatMul") {
+    const TensorShape* a = GetInputShape(context, kernel, 0);
+    if (a == nullptr) {
+      return std::nullopt;
+    }
+    const bool trans_a = op_type == "FusedMatMul" && kernel.Info().GetAttrOrDefault<int64_t>("transA", 0) != 0;
+    return MatMulFlops(*a, *y, trans_a);
+  }
+
+  if (op_type == "Gemm") {
+    const TensorShape* a = GetInputShape(context, kernel, 0);
+    if (a == nullptr || a->NumDimensions() != 2) {
+      return std::nullopt;
+    }
+    const bool trans_a = kernel.Info().GetAttrOrDefault<int64_t>("transA", 0) != 0;
+    // plus the scaling and the addition of C
+    const bool has_c = GetInputShape(context, kernel, 2) != nullptr;
+    return 2 * Size(*y) * static_cast<uint64_t>((*a)[trans_a ? 0 : 1]) + (has_c ? 2 * Size(*y) : 0);
+  }
+
+  if (op_type == "Conv" || op_type == "FusedConv" || op_type == "NhwcConv" || op_type == "NhwcFusedConv" ||
+      op_type == "ConvInteger" || op_type == "QLinearConv" || op_type == "ConvTranspose") {
+    // each output element of Conv sums C / group * kernel size products, each input element of ConvTranspose is
+    // scattered to M / group * kernel size outputs; either way the weights of an output or input channel
+    const TensorShape* w = GetInputShape(context, kernel, op_type == "QLinearConv" ? 3 : 1);
+    const TensorShape* x = GetInputShape(context, kernel, 0);
+    if (w == nullptr || x == nullptr || w->NumDimensions() < 1 || (*w)[0] == 0) {
+      return std::nullopt;
+    }
+    const uint64_t weights_per_channel = Size(*w) / static_cast<uint64_t>((*w)[0]);
+    return 2 * (op_type == "ConvTranspose" ? Size(*x) : Size(*y)) * weights_per_channel;
+  }
+
+  if (op_type == "Attention" || op_type == "MultiHeadAttention" || op_type == "GroupQueryAttention") {
+    return AttentionFlops(context, kernel, op_type);
+  }
+
+  if (ElementwiseOps().count(op_type) != 0) {
+    return Size(*y);
+  }
+
+  if (ReductionOps().count(op_type) != 0) {
+    const TensorShape* x = GetInputShape(context, kernel, 0);
+    return x != nullptr ? std::optional<uint64_t>(Size(*x)) : std::nullopt;
+  }
+
+  if (auto it = NormalizationOps().find(op_type); it != NormalizationOps().end()) {
+    const TensorShape* x = GetInputShape(context, kernel, 0);
+    return x != nullptr ? std::optional<uint64_t>(it->second * Size(*x)) : std::nullopt;
+  }
+
+  return std::nullopt;
+}
+
+std::unordered_map<std::string, std::string> GetCpuPeakInfo() {
+  const auto& cpuid_info = CPUIDInfo::GetCPUIDInfo();
+
+  // two FMA units of the widest vector width, an FMA being 2 operations per lane
+  int fp32_lanes = 4;
+  if (cpuid_info.HasAVX512f()) {
+    fp32_lanes = 16;
+  } else if (cpuid_info.HasAVX2()) {
+    fp32_lanes = 8;
+  }
+  const int fma_units = cpuid_info.HasAVX2() || cpuid_info.HasArmNeonDot() ? 2 : 1;
+
+  return {
+      {"device", "cpu"},
+      {"num_cores", std::to_string(Env::Default().GetNumPhysicalCpuCores())},
+      {"fp32_flops_per_cycle_per_core", std::to_string(2 * fp32_lanes * fma_units)},
+  };
+}
+
+}  // namespace onnxruntime
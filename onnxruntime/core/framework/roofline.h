@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace onnxruntime {
+
+class OpKernel;
+class OpKernelContextInternal;
+
+// Estimates used to place the kernels of a profile on a roofline plot: with the bytes the kernel read and wrote,
+// which the profiler already reports per node, the achieved FLOP/s and bytes/s show whether a kernel is bound by
+// compute or by memory and how far it is from the peak of the device.
+
+// Number of arithmetic operations a kernel performed, counting a multiply-add as 2, computed from the shapes of the
+// inputs and outputs of the call that just ran. Covers the matrix multiplications, convolutions, attention,
+// element-wise ops, reductions and normalizations; nullopt for other op types.
+std::optional<uint64_t> EstimateKernelFlops(OpKernelContextInternal& context, const OpKernel& kernel);
+
+// Peak of the CPU the process runs on, recorded in the profile so its summary can compute the fraction of the peak
+// the kernels reached. The clock frequency and memory bandwidth aren't reported by CPUID, so the peak is given per
+// cycle: "fp32_flops_per_cycle_per_core" (vector FMA width times the FMA units) and "num_cores".
+std::unordered_map<std::string, std::string> GetCpuPeakInfo();
+
+}  // namespace onnxruntime
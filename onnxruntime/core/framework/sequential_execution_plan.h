@@ -35,6 +35,11 @@ struct AllocPlanPerValue {
   // reused_buffer is valid only if alloc_kind == kReuse. It indicates
   // which OrtValue's buffer must be reused for this OrtValue.
   OrtValueIndex reused_buffer{0};
+  // is_sub_buffer is valid only if alloc_kind == kReuse. It indicates that the OrtValue is placed at
+  // sub_buffer_offset bytes into the buffer of reused_buffer rather than at its start, e.g. an input of Concat that is
+  // written in place in the Concat output, or an output of Split that is a view of the Split input.
+  bool is_sub_buffer{false};
+  size_t sub_buffer_offset{0};
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   IntervalT life_interval{0, 0};
   IntervalT allocate_interval{0, 0};
@@ -117,6 +122,8 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
                            const bool& terminate_flag,
                            bool& continue_flag) = 0;
     virtual std::string ToString() const = 0;
+    // whether the step runs the kernel of its node
+    virtual bool IsKernelLaunch() const { return false; }
     inline NodeIndex GetNodeIndex() { return node_index_; }
 
    protected:
@@ -156,6 +163,11 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
   // indexed by node index
   // elements in node_release_list[i] is the index in release_actions.
   std::vector<std::vector<size_t>> node_release_list;
+  // for each node, the positions in Node::InputDefs() of the inputs whose buffer is released right after the
+  // kernel execution and is not read through any other input of the node. nothing reads such a buffer once the
+  // node is done, so the kernel may write an output into it (see OpKernelContext::OutputMayReuseInput).
+  // indexed by node index
+  std::vector<InlinedVector<int>> node_dying_inputs;
   // for each notification, what is the stream-idx of the its owner.
   std::vector<size_t> notification_owners;
   // key: notification index.
@@ -4,6 +4,7 @@
 #include "core/framework/sequential_executor.h"
 
 #include <chrono>
+#include <optional>
 #include <thread>
 #include <vector>
 #include <sstream>
@@ -11,9 +12,16 @@
 #include "core/common/logging/logging.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/execution_frame.h"
+#include "core/framework/graph_segment_capture.h"
+#include "core/framework/kernel_dispatch.h"
+#include "core/framework/lean_execution_plan.h"
+#include "core/framework/memory_timeline.h"
+#include "core/framework/session_metrics.h"
 #include "core/framework/stream_execution_context.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/roofline.h"
+#include "core/framework/trace_span.h"
 #include "core/framework/utils.h"
 
 #if defined DEBUG_NODE_INPUTS_OUTPUTS
@@ -180,6 +188,28 @@ class SessionScope {
       session_start_ = session_state.Profiler().Start();
     }
 
+    if (auto* metrics = session_state_.GetMetrics(); metrics != nullptr && metrics->SampleRun()) {
+      metrics_ = metrics;
+    }
+
+    // the executor of a subgraph runs within the kernel of its control flow node, which made the span of the Run or
+    // of the enclosing subgraph current
+    if (const auto* parent_span = tracing::TraceSpan::Current(); parent_span != nullptr) {
+      const auto& graph_viewer = session_state_.GetGraphViewer();
+      if (graph_viewer.IsSubgraph()) {
+        const auto& parent_node = *graph_viewer.ParentNode();
+        span_.emplace(*parent_span,
+                      MakeString(parent_node.Name().empty() ? parent_node.OpType() : parent_node.Name(), "/",
+                                 graph_viewer.Name()),
+                      "subgraph");
+        parent_span = &*span_;
+      }
+      parent_span_ = parent_span;
+    }
+
+    memory_timeline_ = MemoryTimeline::Current();
+    kernel_dispatch_recorder_ = KernelDispatchRecorder::Current();
+
     auto& logger = session_state_.Logger();
     LOGS(logger, VERBOSE) << "Begin execution";
     const SequentialExecutionPlan& seq_exec_plan = *session_state_.GetExecutionPlan();
@@ -241,6 +271,18 @@ class SessionScope {
 #endif
   }
 
+  // Whether the kernels of this execution are profiled, sampled for metrics, traced, record their allocations or
+  // dispatched variants, or run with instrumentation compiled in. Only the executions that aren't run a lean plan.
+  bool IsInstrumented() const {
+#if defined(CONCURRENCY_VISUALIZER) || defined(ENABLE_NVTX_PROFILE) || defined(DEBUG_NODE_INPUTS_OUTPUTS) || \
+    defined(ONNXRUNTIME_ENABLE_INSTRUMENT) || (!defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE))
+    return true;
+#else
+    return session_state_.Profiler().IsEnabled() || metrics_ != nullptr || parent_span_ != nullptr ||
+           memory_timeline_ != nullptr || kernel_dispatch_recorder_ != nullptr;
+#endif
+  }
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   void SetFlushMemoryInfoFlag(bool flush_memory_info) {
     flush_memory_info_ = flush_memory_info;
@@ -250,6 +292,16 @@ class SessionScope {
  private:
   const SessionState& session_state_;
   TimePoint session_start_;
+  // the metrics to record the kernel latencies in if this Run is sampled, otherwise nullptr
+  SessionMetrics* metrics_ = nullptr;
+  // the span of this subgraph execution, if it is traced
+  std::optional<tracing::TraceSpan> span_;
+  // the parent of the spans of the kernels, the span of the Run for the main graph. nullptr if not traced.
+  const tracing::TraceSpan* parent_span_ = nullptr;
+  // the timeline of the Run the kernels record their allocations in, nullptr if not recorded
+  MemoryTimeline* memory_timeline_ = nullptr;
+  // the recorder of the variants the kernels dispatch to, nullptr if not recorded
+  KernelDispatchRecorder* kernel_dispatch_recorder_ = nullptr;
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   const ExecutionFrame& frame_;
   // Whether memory profiler need create events and flush to file.
@@ -334,6 +386,32 @@ class KernelScope {
     node_compute_range_.Begin();
 #endif
 
+    if (const auto* parent_span = session_scope_.parent_span_; parent_span != nullptr) {
+      // the kernels run on inter op threads too, so the span is made current on the thread running the kernel
+      const auto& node = kernel_.Node();
+      const bool is_memcpy = node.OpType() == "MemcpyFromHost" || node.OpType() == "MemcpyToHost";
+      if (is_memcpy || node.NodeType() == Node::Type::Fused) {
+        span_.emplace(*parent_span, node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name(),
+                      is_memcpy ? "memcpy" : "partition", node.GetExecutionProviderType().c_str());
+        parent_span = &*span_;
+      }
+      current_span_scope_.emplace(parent_span);
+    }
+
+    if (session_scope_.memory_timeline_ != nullptr) {
+      // the allocations of the kernel are attributed to its node, on the thread running it
+      memory_timeline_scope_.emplace(session_scope_.memory_timeline_, &kernel_.Node());
+    }
+
+    if (session_scope_.kernel_dispatch_recorder_ != nullptr || session_state_.Profiler().IsEnabled()) {
+      // the variants the kernel dispatches to, recorded on the thread running it
+      kernel_dispatch_scope_.emplace(session_scope_.kernel_dispatch_recorder_, &kernel_.Node());
+    }
+
+    if (session_scope_.metrics_ != nullptr) {
+      metrics_begin_time_ = std::chrono::steady_clock::now();
+    }
+
     if (session_state_.Profiler().IsEnabled()) {
       auto& node = kernel.Node();
       node_name_ = node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name();
@@ -349,6 +427,11 @@ class KernelScope {
       CalculateTotalInputSizes(&kernel_context, &kernel_,
                                input_activation_sizes_, input_parameter_sizes_,
                                node_name_, input_type_shape_);
+      // last, so that the counts are of the kernel only
+      if (const auto* hardware_counters = profiler.GetHardwareCounters();
+          hardware_counters != nullptr && hardware_counters->Read(hardware_counters_begin_)) {
+        hardware_counters_ = hardware_counters;
+      }
     }
   }
 
@@ -359,10 +442,32 @@ class KernelScope {
     node_compute_range_.End();
 #endif
 
+    current_span_scope_.reset();
+    span_.reset();
+    memory_timeline_scope_.reset();
+    std::string dispatch;
+    if (kernel_dispatch_scope_.has_value()) {
+      dispatch = kernel_dispatch_scope_->ToString();
+      kernel_dispatch_scope_.reset();
+    }
+
+    if (session_scope_.metrics_ != nullptr) {
+      const auto elapsed = std::chrono::steady_clock::now() - metrics_begin_time_;
+      session_scope_.metrics_->RecordNode(
+          kernel_.Node().Index(),
+          static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
     if (session_state_.Profiler().IsEnabled()) {
       auto& profiler = session_state_.Profiler();
+      std::string hw_counters;
+      if (profiling::HardwareCounters::Sample end; hardware_counters_ != nullptr && hardware_counters_->Read(end)) {
+        hw_counters = hardware_counters_->ToJson(hardware_counters_begin_, end);
+      }
       std::string output_type_shape_;
       CalculateTotalOutputSizes(&kernel_context_, total_output_sizes_, node_name_, output_type_shape_);
+      // empty if the op type has no estimate
+      const auto flops = EstimateKernelFlops(kernel_context_, kernel_);
       profiler.EndTimeAndRecordEvent(profiling::NODE_EVENT,
                                      node_name_ + "_kernel_time",
                                      kernel_begin_time_,
@@ -374,11 +479,28 @@ class KernelScope {
                                          {"activation_size", std::to_string(input_activation_sizes_)},
                                          {"parameter_size", std::to_string(input_parameter_sizes_)},
                                          {"output_size", std::to_string(total_output_sizes_)},
+                                         {"flops", flops.has_value() ? std::to_string(*flops) : std::string()},
+                                         {"bytes", std::to_string(input_activation_sizes_ + input_parameter_sizes_ +
+                                                                  total_output_sizes_)},
                                          {"input_type_shape", input_type_shape_},
                                          {"output_type_shape", output_type_shape_},
+                                         {"dispatch", dispatch},
+                                         {"hw_counters", hw_counters},
                                          {"thread_scheduling_stats",
                                           concurrency::ThreadPool::StopProfiling(session_state_.GetThreadPool())},
                                      });
+      // timeline of the intra op threads while the kernel ran
+      concurrency::ThreadPool::DrainTraceEvents(
+          session_state_.GetThreadPool(), [&](const concurrency::ThreadPoolTraceEvent& e) {
+            std::unordered_map<std::string, std::string> args{{"node_name", node_name_}};
+            if (e.type == concurrency::ThreadPoolTraceEvent::WORK_ITEM) {
+              args.emplace("work_item", std::to_string(e.arg));
+            } else if (e.type != concurrency::ThreadPoolTraceEvent::WAIT) {
+              args.emplace("first_iteration", std::to_string(e.arg));
+            }
+            profiler.RecordEvent(profiling::THREAD_POOL_EVENT, e.thread_id,
+                                 concurrency::ThreadPoolTraceEvent::GetName(e.type), e.start, e.end, std::move(args));
+          });
       auto sync_time_begin = profiler.Start();
       profiler.EndTimeAndRecordEvent(profiling::NODE_EVENT,
                                      node_name_ + "_fence_after",
@@ -407,6 +529,14 @@ class KernelScope {
 
  private:
   TimePoint kernel_begin_time_;
+  // the hardware counters of the thread when the kernel began, if the profiler reads them
+  const profiling::HardwareCounters* hardware_counters_ = nullptr;
+  profiling::HardwareCounters::Sample hardware_counters_begin_;
+  std::chrono::steady_clock::time_point metrics_begin_time_;
+  std::optional<tracing::TraceSpan> span_;
+  std::optional<tracing::CurrentSpanScope> current_span_scope_;
+  std::optional<MemoryTimelineScope> memory_timeline_scope_;
+  std::optional<KernelDispatchScope> kernel_dispatch_scope_;
   SessionScope& session_scope_;
   const SessionState& session_state_;
   std::string node_name_;
@@ -514,11 +644,53 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
     LOGS(logger, ERROR) << msg_string;
     return Status(status.Category(), status.Code(), msg_string);
   }
+  if (const auto* graph_segments = ctx.GetSessionState().GetGraphSegmentCapture(); graph_segments != nullptr) {
+    graph_segments->OnKernelComputed(ctx, idx);
+  }
   ctx.RecycleNodeInputs(idx);
   LOGS(logger, VERBOSE) << "stream " << stream_idx << " launch kernel with idx " << idx;
   return Status::OK();
 }
 
+// Runs the kernels of a lean plan one after the other on the calling thread, see LeanExecutionPlan.
+static Status ExecuteTheLeanPlan(const LeanExecutionPlan& plan, StreamExecutionContext& ctx,
+                                 const bool& terminate_flag) {
+  const auto& session_state = ctx.GetSessionState();
+  const auto& logger = ctx.GetLogger();
+  auto& frame = ctx.GetExecutionFrame();
+  Stream* stream = ctx.GetDeviceStream(plan.StreamIndex());
+  const auto released_values = plan.ReleasedValues();
+
+  for (const auto& record : plan.Kernels()) {
+    if (terminate_flag) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+    }
+
+    OpKernelContextInternal kernel_ctx(session_state, frame, *record.kernel, logger, terminate_flag, stream);
+    Status status;
+    ORT_TRY {
+      status = record.kernel->Compute(&kernel_ctx);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+    if (!status.IsOK()) {
+      const auto& node = record.kernel->Node();
+      const auto msg_string = MakeString("Non-zero status code returned while running ", node.OpType(),
+                                         " node. Name:'", node.Name(), "' Status Message: ", status.ErrorMessage());
+      LOGS(logger, ERROR) << msg_string;
+      return Status(status.Category(), status.Code(), msg_string);
+    }
+
+    for (size_t i = record.release_begin; i < record.release_end; ++i) {
+      ORT_RETURN_IF_ERROR(frame.ReleaseMLValue(released_values[i]));
+    }
+  }
+  return Status::OK();
+}
+
 onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<const int> feed_mlvalue_idxs,
                                    gsl::span<const OrtValue> feeds, gsl::span<const int> fetch_mlvalue_idxs,
                                    std::vector<OrtValue>& fetches,
@@ -574,23 +746,28 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
 
   SessionScope session_scope(session_state, ctx.GetExecutionFrame());
 
-  auto* tp = single_thread_mode ? nullptr : session_state.GetInterOpThreadPool();
-
-  for (size_t i = 0; i < execution_plan->execution_plan.size(); ++i) {
-    if (execution_plan->execution_plan[i]->steps_.empty()) {
-      // execution context is initialized with number of valid streams
-      // for invalid stream (0 steps), it doesn't count in number of tasks
-      // so don't need to invoke CompleteTask here
-      // ctx.CompleteTask();
-    } else {
-      concurrency::ThreadPool::Schedule(tp, [i, &ctx, &terminate_flag, &session_scope]() {
-        RunSince(i, ctx, session_scope, terminate_flag, 0);
-      });
+  if (const auto* lean_plan = session_state.GetLeanExecutionPlan();
+      lean_plan != nullptr && !only_execute_path_to_fetches && !session_scope.IsInstrumented()) {
+    ORT_RETURN_IF_ERROR(ExecuteTheLeanPlan(*lean_plan, ctx, terminate_flag));
+  } else {
+    auto* tp = single_thread_mode ? nullptr : session_state.GetInterOpThreadPool();
+
+    for (size_t i = 0; i < execution_plan->execution_plan.size(); ++i) {
+      if (execution_plan->execution_plan[i]->steps_.empty()) {
+        // execution context is initialized with number of valid streams
+        // for invalid stream (0 steps), it doesn't count in number of tasks
+        // so don't need to invoke CompleteTask here
+        // ctx.CompleteTask();
+      } else {
+        concurrency::ThreadPool::Schedule(tp, [i, &ctx, &terminate_flag, &session_scope]() {
+          RunSince(i, ctx, session_scope, terminate_flag, 0);
+        });
+      }
     }
-  }
 
-  ctx.WaitAll();
-  ORT_RETURN_IF_ERROR(ctx.TaskStatus());
+    ctx.WaitAll();
+    ORT_RETURN_IF_ERROR(ctx.TaskStatus());
+  }
   ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GetOutputs(fetches));
   if (ctx.GetExecutionFrame().HasMemoryPatternPlanner()) {
     bool all_tensors = true;
@@ -604,7 +781,8 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
     if (all_tensors) {
       MemoryPatternGroup mem_patterns;
       ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GeneratePatterns(mem_patterns));
-      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(feeds, std::move(mem_patterns)));
+      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(feeds, feed_mlvalue_idxs,
+                                                                      std::move(mem_patterns)));
     }
   }
 
@@ -0,0 +1,250 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/session_metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "core/framework/allocator_stats.h"
+#include "core/graph/graph_viewer.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Returns floor(log2(n)) for n > 0
+int Log2Floor(uint64_t n) {
+#if defined(__GNUC__)
+  return 63 ^ __builtin_clzll(n);
+#elif defined(_MSC_VER) && defined(_WIN64)
+  unsigned long index;
+  _BitScanReverse64(&index, n);
+  return static_cast<int>(index);
+#else
+  int r = -1;
+  while (n > 0) {
+    r++;
+    n >>= 1;
+  }
+  return r;
+#endif
+}
+
+constexpr std::array<double, 3> kQuantiles = {0.5, 0.9, 0.99};
+
+std::string EscapeLabelValue(const std::string& value) {
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (char c : value) {
+    if (c == '\\' || c == '"') {
+      escaped += '\\';
+      escaped += c;
+    } else if (c == '\n') {
+      escaped += "\\n";
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+void WriteSummary(std::ostream& os, const std::string& name, const std::string& labels,
+                  const LatencyHistogram& histogram) {
+  for (double q : kQuantiles) {
+    os << name << "{" << labels << ",quantile=\"" << q << "\"} " << histogram.QuantileNs(q) * 1e-9 << "\n";
+  }
+  os << name << "_sum{" << labels << "} " << histogram.SumNs() * 1e-9 << "\n";
+  os << name << "_count{" << labels << "} " << histogram.Count() << "\n";
+}
+
+}  // namespace
+
+size_t LatencyHistogram::BucketIndex(uint64_t ns) {
+  if (ns < kSubBuckets) {
+    return static_cast<size_t>(ns);
+  }
+
+  const int exponent = Log2Floor(ns);
+  if (exponent > kMaxExponent) {
+    return kNumBuckets - 1;
+  }
+
+  // the kSubBucketBits bits below the leading one select the bucket within the power of two
+  const uint64_t sub_bucket = (ns >> (exponent - kSubBucketBits)) - kSubBuckets;
+  return static_cast<size_t>((exponent - kSubBucketBits + 1) * kSubBuckets + sub_bucket);
+}
+
+uint64_t LatencyHistogram::BucketUpperBoundNs(size_t index) {
+  if (index < kSubBuckets) {
+    return index;
+  }
+
+  const int shift = static_cast<int>(index / kSubBuckets) - 1;
+  const uint64_t sub_bucket = index % kSubBuckets;
+  return ((kSubBuckets + sub_bucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(uint64_t ns) {
+  buckets_[BucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_ns_.fetch_add(ns, std::memory_order_relaxed);
+
+  uint64_t max_ns = max_ns_.load(std::memory_order_relaxed);
+  while (ns > max_ns && !max_ns_.compare_exchange_weak(max_ns, ns, std::memory_order_relaxed)) {
+  }
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    buckets_[i].fetch_add(other.buckets_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  count_.fetch_add(other.Count(), std::memory_order_relaxed);
+  sum_ns_.fetch_add(other.SumNs(), std::memory_order_relaxed);
+
+  const uint64_t other_max_ns = other.max_ns_.load(std::memory_order_relaxed);
+  uint64_t max_ns = max_ns_.load(std::memory_order_relaxed);
+  while (other_max_ns > max_ns &&
+         !max_ns_.compare_exchange_weak(max_ns, other_max_ns, std::memory_order_relaxed)) {
+  }
+}
+
+uint64_t LatencyHistogram::QuantileNs(double q) const {
+  // the buckets may be updated while they are read, so the rank is computed from the counts that were read
+  std::array<uint64_t, kNumBuckets> counts;
+  uint64_t total = 0;
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+  if (total == 0) {
+    return 0;
+  }
+
+  const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * total)));
+  uint64_t cumulative = 0;
+  size_t index = 0;
+  for (; index < kNumBuckets - 1; ++index) {
+    cumulative += counts[index];
+    if (cumulative >= rank) {
+      break;
+    }
+  }
+
+  return std::min(BucketUpperBoundNs(index), max_ns_.load(std::memory_order_relaxed));
+}
+
+SessionMetrics::SessionMetrics(const GraphViewer& graph_viewer, double sampling_rate)
+    : sampling_interval_(sampling_rate > 0.0 ? std::max<uint64_t>(1, std::llround(1.0 / sampling_rate)) : 0),
+      nodes_(graph_viewer.MaxNodeIndex()) {
+  for (const auto& node : graph_viewer.Nodes()) {
+    auto node_metrics = std::make_unique<NodeMetrics>();
+    node_metrics->name = node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name();
+    node_metrics->op_type = node.OpType();
+    nodes_[node.Index()] = std::move(node_metrics);
+  }
+}
+
+bool SessionMetrics::SampleRun() {
+  return sampling_interval_ != 0 &&
+         num_runs_started_.fetch_add(1, std::memory_order_relaxed) % sampling_interval_ == 0;
+}
+
+void SessionMetrics::RecordNode(NodeIndex node_index, uint64_t ns) {
+  if (node_index < nodes_.size() && nodes_[node_index] != nullptr) {
+    nodes_[node_index]->latency.Record(ns);
+  }
+}
+
+std::string SessionMetrics::ToPrometheusText(const std::string& session_name, const AllocatorMap& allocators,
+                                             const concurrency::ThreadPool* intra_op_thread_pool,
+                                             const concurrency::ThreadPool* inter_op_thread_pool) const {
+  std::ostringstream os;
+  os << std::setprecision(9);
+  const std::string session_label = "session=\"" + EscapeLabelValue(session_name) + "\"";
+
+  os << "# HELP ort_session_run_latency_seconds Latency of the Runs of the session.\n"
+     << "# TYPE ort_session_run_latency_seconds summary\n";
+  WriteSummary(os, "ort_session_run_latency_seconds", session_label, run_latency_);
+
+  os << "# HELP ort_node_latency_seconds Latency of the kernels of the nodes in the sampled Runs.\n"
+     << "# TYPE ort_node_latency_seconds summary\n";
+  std::map<std::string, std::unique_ptr<LatencyHistogram>> op_latencies;
+  for (const auto& node : nodes_) {
+    if (node == nullptr || node->latency.Count() == 0) {
+      continue;
+    }
+    WriteSummary(os, "ort_node_latency_seconds",
+                 session_label + ",node=\"" + EscapeLabelValue(node->name) + "\",op_type=\"" +
+                     EscapeLabelValue(node->op_type) + "\"",
+                 node->latency);
+    auto& op_latency = op_latencies[node->op_type];
+    if (op_latency == nullptr) {
+      op_latency = std::make_unique<LatencyHistogram>();
+    }
+    op_latency->Merge(node->latency);
+  }
+
+  os << "# HELP ort_op_latency_seconds Latency of the kernels of the nodes of each op type in the sampled Runs.\n"
+     << "# TYPE ort_op_latency_seconds summary\n";
+  for (const auto& [op_type, latency] : op_latencies) {
+    WriteSummary(os, "ort_op_latency_seconds", session_label + ",op_type=\"" + EscapeLabelValue(op_type) + "\"",
+                 *latency);
+  }
+
+  std::ostringstream bytes_in_use, max_bytes_in_use, reserved_bytes, num_allocs;
+  for (const auto& [device, allocator] : allocators) {
+    AllocatorStats stats;
+    allocator->GetStats(&stats);
+    const std::string labels = session_label + ",allocator=\"" + EscapeLabelValue(allocator->Info().name) +
+                               "\",device_id=\"" + std::to_string(device.Id()) + "\"";
+    bytes_in_use << "ort_allocator_bytes_in_use{" << labels << "} " << stats.bytes_in_use << "\n";
+    max_bytes_in_use << "ort_allocator_max_bytes_in_use{" << labels << "} " << stats.max_bytes_in_use << "\n";
+    reserved_bytes << "ort_allocator_reserved_bytes{" << labels << "} " << stats.total_allocated_bytes << "\n";
+    num_allocs << "ort_allocator_allocations_total{" << labels << "} " << stats.num_allocs << "\n";
+  }
+  os << "# HELP ort_allocator_bytes_in_use Bytes allocated by the session allocators and not freed.\n"
+     << "# TYPE ort_allocator_bytes_in_use gauge\n"
+     << bytes_in_use.str()
+     << "# HELP ort_allocator_max_bytes_in_use Peak of ort_allocator_bytes_in_use.\n"
+     << "# TYPE ort_allocator_max_bytes_in_use gauge\n"
+     << max_bytes_in_use.str()
+     << "# HELP ort_allocator_reserved_bytes Bytes reserved from the device by arena based allocators.\n"
+     << "# TYPE ort_allocator_reserved_bytes gauge\n"
+     << reserved_bytes.str()
+     << "# HELP ort_allocator_allocations_total Allocations made by the session allocators.\n"
+     << "# TYPE ort_allocator_allocations_total counter\n"
+     << num_allocs.str();
+
+  // the utilization of a pool over an interval is the increase of the busy time divided by the interval and the
+  // number of threads
+  os << "# HELP ort_thread_pool_busy_seconds_total Time the threads of the pool spent running tasks.\n"
+     << "# TYPE ort_thread_pool_busy_seconds_total counter\n";
+  std::ostringstream num_threads;
+  for (const auto& [pool_name, pool] : {std::make_pair("intra_op", intra_op_thread_pool),
+                                        std::make_pair("inter_op", inter_op_thread_pool)}) {
+    if (pool == nullptr) {
+      continue;
+    }
+    const std::string labels = session_label + ",pool=\"" + pool_name + "\"";
+    os << "ort_thread_pool_busy_seconds_total{" << labels << "} "
+       << concurrency::ThreadPool::GetBusyTimeNs(pool) * 1e-9 << "\n";
+    num_threads << "ort_thread_pool_threads{" << labels << "} "
+                << concurrency::ThreadPool::GetNumThreads(pool) << "\n";
+  }
+  os << "# HELP ort_thread_pool_threads Number of threads in the pool.\n"
+     << "# TYPE ort_thread_pool_threads gauge\n"
+     << num_threads.str();
+
+  return os.str();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/graph/basic_types.h"
+
+namespace onnxruntime {
+
+class GraphViewer;
+
+namespace concurrency {
+class ThreadPool;
+}
+
+// Histogram of latencies in buckets of logarithmically increasing width, in the manner of HdrHistogram. The range of
+// nanoseconds between two consecutive powers of two is split into kSubBuckets buckets of equal width, so quantiles are
+// reported with a relative error of at most 1 / kSubBuckets. Recording is a few relaxed atomic operations, so
+// concurrent Runs record into the same histogram without locking.
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBucketBits = 3;
+  static constexpr uint64_t kSubBuckets = uint64_t{1} << kSubBucketBits;
+  // latencies of 2^(kMaxExponent + 1) ns (about 37 minutes) or more are counted in the last bucket
+  static constexpr int kMaxExponent = 40;
+  static constexpr size_t kNumBuckets = (kMaxExponent - kSubBucketBits + 2) * kSubBuckets;
+
+  void Record(uint64_t ns);
+
+  // Adds the latencies recorded by other, which may still be recording
+  void Merge(const LatencyHistogram& other);
+
+  uint64_t Count() const { return count_.load(std::memory_order_relaxed); }
+  uint64_t SumNs() const { return sum_ns_.load(std::memory_order_relaxed); }
+
+  // Upper bound of the bucket holding the q-quantile of the recorded latencies, capped by the largest latency
+  // recorded. 0 if nothing was recorded.
+  uint64_t QuantileNs(double q) const;
+
+  static size_t BucketIndex(uint64_t ns);
+  static uint64_t BucketUpperBoundNs(size_t index);
+
+ private:
+  std::array<std::atomic<uint64_t>, kNumBuckets> buckets_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_ns_{0};
+  std::atomic<uint64_t> max_ns_{0};
+};
+
+// Metrics of a session collected continuously while it runs, rather than only while profiling: latency histograms
+// of the Runs and of the nodes of the main graph, plus the arena and thread pool counters read when a snapshot is
+// taken. The kernel latencies are only measured in a sample of the Runs to bound the overhead.
+class SessionMetrics {
+ public:
+  // sampling_rate is the fraction of the Runs the kernel latencies are measured in, between 0 and 1
+  SessionMetrics(const GraphViewer& graph_viewer, double sampling_rate);
+
+  // Whether the kernel latencies of the Run starting now are measured
+  bool SampleRun();
+
+  void RecordRun(uint64_t ns) { run_latency_.Record(ns); }
+  void RecordNode(NodeIndex node_index, uint64_t ns);
+
+  // Renders the metrics in the Prometheus text exposition format. Each sample is labelled with the session name.
+  // Node latencies are summarized per node and per op type.
+  std::string ToPrometheusText(const std::string& session_name, const AllocatorMap& allocators,
+                               const concurrency::ThreadPool* intra_op_thread_pool,
+                               const concurrency::ThreadPool* inter_op_thread_pool) const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionMetrics);
+
+ private:
+  struct NodeMetrics {
+    std::string name;
+    std::string op_type;
+    LatencyHistogram latency;
+  };
+
+  // a Run in every sampling_interval_ is sampled, none if it is 0
+  uint64_t sampling_interval_;
+  std::atomic<uint64_t> num_runs_started_{0};
+
+  LatencyHistogram run_latency_;
+  // indexed by NodeIndex, null for the indices of removed nodes
+  std::vector<std::unique_ptr<NodeMetrics>> nodes_;
+};
+
+}  // namespace onnxruntime
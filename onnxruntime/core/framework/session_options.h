@@ -22,8 +22,9 @@
 namespace onnxruntime {
 
 enum class ExecutionOrder {
-  DEFAULT = 0,        // default topological sort
-  PRIORITY_BASED = 1  // priority-based topological sort
+  DEFAULT = 0,          // default topological sort
+  PRIORITY_BASED = 1,   // priority-based topological sort
+  MEMORY_EFFICIENT = 2  // topological sort that greedily minimizes the estimated peak size of live tensors
 };
 
 inline std::ostream& operator<<(std::ostream& os, const ExecutionOrder& order) {
@@ -34,6 +35,9 @@ inline std::ostream& operator<<(std::ostream& os, const ExecutionOrder& order) {
     case ExecutionOrder::PRIORITY_BASED:
       os << "PRIORITY_BASED";
       break;
+    case ExecutionOrder::MEMORY_EFFICIENT:
+      os << "MEMORY_EFFICIENT";
+      break;
     default:
       os << "UNKNOWN";
       break;
@@ -170,6 +174,10 @@ struct SessionOptions {
   // User specified logging func and param
   OrtLoggingFunction user_logging_function = nullptr;
   void* user_logging_param = nullptr;
+
+  // User specified function receiving the tracing spans of the Runs and its param
+  OrtTraceSpanFunction trace_span_function = nullptr;
+  void* trace_span_param = nullptr;
 };
 
 inline std::ostream& operator<<(std::ostream& os, const SessionOptions& session_options) {
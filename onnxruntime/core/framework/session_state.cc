@@ -3,11 +3,18 @@
 
 #include "core/framework/session_state.h"
 
+#include <algorithm>
+#include <limits>
 #include <sstream>
 
 #include "core/platform/ort_mutex.h"
 #include "core/common/logging/logging.h"
+#include "core/common/hash_combine.h"
+#include "core/common/parse_string.h"
 #include "core/common/safeint.h"
+#include "core/common/startup_timings.h"
+#include "core/common/string_utils.h"
+#include "core/flatbuffers/flatbuffers_utils.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/allocator.h"
 #include "core/framework/node_index_info.h"
@@ -120,6 +127,18 @@ void SessionState::UpdateAllocatorsWithEnvAllocators(const std::vector<Allocator
   }
 }
 
+void SessionState::SetActivationPools(const std::vector<AllocatorPtr>& activation_pools) {
+  for (const auto& pool : activation_pools) {
+    activation_pools_[pool->Info().device] = pool;
+  }
+}
+
+AllocatorPtr SessionState::GetActivationPool(const OrtDevice& device) const noexcept {
+  auto it = activation_pools_.find(device);
+  if (it != activation_pools_.end()) return it->second;
+  return nullptr;
+}
+
 void SessionState::CreateGraphInfo() {
   graph_viewer_.emplace(graph_);
   // use graph_viewer_ to initialize ort_value_name_idx_map_
@@ -222,7 +241,8 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
     }
     session_kernels_.clear();
     session_kernels_.resize(max_nodeid + 1);
-    for (const auto& node : nodes) {
+
+    const auto create_kernel = [this, &kernel_registry_manager](const Node& node) -> Status {
       // construct and save the kernels
       const KernelCreateInfo& kci = GetNodeKernelCreateInfo(node.Index());
 
@@ -231,7 +251,37 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
       const IExecutionProvider& exec_provider = *execution_providers_.Get(exec_provider_name);
 
       // assumes vector is already resize()'ed to the number of nodes in the graph
-      ORT_RETURN_IF_ERROR(kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]));
+      return kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]);
+    };
+
+    // CPU kernels only read the node and the session state in their constructor so they can be created
+    // concurrently. kernels of other execution providers may share state such as handles, so they are
+    // created on this thread.
+    const bool parallel_initialization =
+        sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsParallelInitialization, "0") == "1";
+    InlinedVector<const Node*> cpu_nodes;
+    for (const auto& node : nodes) {
+      if (parallel_initialization && node.GetExecutionProviderType() == kCpuExecutionProvider) {
+        cpu_nodes.push_back(&node);
+      } else {
+        ORT_RETURN_IF_ERROR(create_kernel(node));
+      }
+    }
+
+    std::vector<Status> statuses(cpu_nodes.size());
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        thread_pool_, static_cast<std::ptrdiff_t>(cpu_nodes.size()), [&](std::ptrdiff_t i) {
+          ORT_TRY {
+            statuses[i] = create_kernel(*cpu_nodes[i]);
+          }
+          ORT_CATCH(const std::exception& ex) {
+            ORT_HANDLE_EXCEPTION([&]() {
+              statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+            });
+          }
+        });
+    for (const auto& status : statuses) {
+      ORT_RETURN_IF_ERROR(status);
     }
   }
   node_index_info_.emplace(*graph_viewer_, ort_value_name_idx_map_);
@@ -396,116 +446,214 @@ static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
 
 Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
                                                        const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
-  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map](
-                                        bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
-    for (auto& node : GetGraphViewer().Nodes()) {
-      auto kernel = GetMutableKernel(node.Index());
-      int input_idx = 0;
-      for (auto& input_def : node.InputDefs()) {
-        if (input_def->Exists()) {
-          const std::string& input_name = input_def->Name();
-          SessionState* st = this;
-          // subgraph can use the value from outer scope,
-          // so it needs to check if current node uses constant initialized tensor from current and outer graphs
-          do {
-            int ort_value_idx;
-            if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
-              std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
-
-              if (constant_initialized_tensors.count(ort_value_idx)) {
-                bool is_packed = false;
-                const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
-
-                auto iter = initializers_to_share_map.find(input_name);
-                bool is_shared_initializer = (iter != initializers_to_share_map.end());
-
-                // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
-                if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
-                    node.GetExecutionProviderType() == kCpuExecutionProvider) {  // caching of pre-packed weights' turned ON
-
-                  AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
-                  ORT_ENFORCE(allocator_for_caching.get() != nullptr);
+  // the file is owned by the root session state
+  SessionState* root = this;
+  while (root->Parent() != nullptr) {
+    root = root->Parent();
+  }
+  PrepackedWeightsFile* prepacked_weights_file = root->prepacked_weights_file_.get();
 
-                  PrePackedWeights weights_to_be_filled_in;
-                  // The reason we invoke PrePack() before looking into the container for any pre-packed weight
-                  // cached by another instance of the same op_type (for the same constant initializer) is because
-                  // to truly know if we can use a cached pre-packed weight, we would have to compare the cached pre-packed
-                  // weight with the pre-packed weight generated by this instance of the same op_type because other static
-                  // properties of the node like node attributes could play a role in the pre-packed weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
+  // a constant initializer that was pre-packed, and may be released if all its consumers pre-packed it
+  struct PackedInitializer {
+    SessionState* st;
+    int ort_value_idx;
+    const std::string* input_name;
+  };
 
-                  if (is_packed) {
-                    // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight to be cached if the weight was pre-packed
-                    ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0, "The kernel corresponding to the node ", node.Name(),
-                                " doesn't have an implementation that can cache computed pre-packed weights");
+  // applies the pre-packing of the inputs of a node. this is not thread safe as it may release initializers.
+  const auto release_packed_initializers = [this, &constant_initializers_use_count](
+                                               gsl::span<const PackedInitializer> packed_initializers) {
+    for (const auto& packed : packed_initializers) {
+      ++number_of_prepacks_counter_;
+
+      const std::string& input_name = *packed.input_name;
+      if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
+        // release the constant initialized tensor
+        packed.st->initialized_tensors_.erase(packed.ort_value_idx);
+        packed.st->constant_initialized_tensors_.erase(packed.ort_value_idx);
+      }
+    }
+  };
 
-                    const auto& op_type = node.OpType();
+  // pre-packs the inputs of a node and adds the initializers that were pre-packed to packed_initializers
+  const auto prepack_node = [this, &initializers_to_share_map, prepacked_weights_file](
+                                const Node& node, bool should_cache_prepacked_weights_for_shared_initializers,
+                                InlinedVector<PackedInitializer>& packed_initializers) -> Status {
+    auto kernel = GetMutableKernel(node.Index());
+    int input_idx = 0;
+    for (auto& input_def : node.InputDefs()) {
+      if (input_def->Exists()) {
+        const std::string& input_name = input_def->Name();
+        SessionState* st = this;
+        // subgraph can use the value from outer scope,
+        // so it needs to check if current node uses constant initialized tensor from current and outer graphs
+        do {
+          int ort_value_idx;
+          if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
+            const std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
+
+            auto constant_initialized_tensor = constant_initialized_tensors.find(ort_value_idx);
+            if (constant_initialized_tensor != constant_initialized_tensors.end()) {
+              bool is_packed = false;
+              const Tensor& const_initialized_tensor = constant_initialized_tensor->second.Get<Tensor>();
+
+              auto iter = initializers_to_share_map.find(input_name);
+              bool is_shared_initializer = (iter != initializers_to_share_map.end());
+
+              // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
+              if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
+                  node.GetExecutionProviderType() == kCpuExecutionProvider) {  // caching of pre-packed weights' turned ON
+
+                AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
+                ORT_ENFORCE(allocator_for_caching.get() != nullptr);
+
+                PrePackedWeights weights_to_be_filled_in;
+                // The reason we invoke PrePack() before looking into the container for any pre-packed weight
+                // cached by another instance of the same op_type (for the same constant initializer) is because
+                // to truly know if we can use a cached pre-packed weight, we would have to compare the cached pre-packed
+                // weight with the pre-packed weight generated by this instance of the same op_type because other static
+                // properties of the node like node attributes could play a role in the pre-packed weights' contents.
+                ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
+                                                    is_packed,
+                                                    &weights_to_be_filled_in));
+
+                if (is_packed) {
+                  // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight to be cached if the weight was pre-packed
+                  ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0, "The kernel corresponding to the node ", node.Name(),
+                              " doesn't have an implementation that can cache computed pre-packed weights");
 
-                    // Sanity check
-                    // TODO: Check if some version of the ONNX IR allows op_type to be empty
-                    ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
+                  const auto& op_type = node.OpType();
 
-                    // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
-                    // that we just got by invoking PrePack() on this kernel.
+                  // Sanity check
+                  // TODO: Check if some version of the ONNX IR allows op_type to be empty
+                  ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
 
-                    const std::string& prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(op_type,
-                                                                                                           weights_to_be_filled_in);
+                  // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
+                  // that we just got by invoking PrePack() on this kernel.
 
-                    bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(prepacked_weights_container_key);
+                  const std::string& prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(op_type,
+                                                                                                         weights_to_be_filled_in);
 
-                    if (container_contains_packed_weight) {
-                      LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: " << input_name
-                                          << " used in the node: " << node.Name() << " which is of op type: " << node.OpType();
+                  bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(prepacked_weights_container_key);
 
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
-                                                                          node.Name()));
+                  if (container_contains_packed_weight) {
+                    LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: " << input_name
+                                        << " used in the node: " << node.Name() << " which is of op type: " << node.OpType();
 
-                      ++used_shared_pre_packed_weights_counter_;
-                    } else {  // container doesn't contain the pre-packed weight - so write into it for sharing across kernel instances
+                    ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                                        prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
+                                                                        node.Name()));
 
-                      if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key, std::move(weights_to_be_filled_in))) {
-                        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Unable to write the provided PrePackedWeights instance into the container");
-                      }
+                    ++used_shared_pre_packed_weights_counter_;
+                  } else {  // container doesn't contain the pre-packed weight - so write into it for sharing across kernel instances
 
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
-                                                                          node.Name()));
+                    if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key, std::move(weights_to_be_filled_in))) {
+                      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Unable to write the provided PrePackedWeights instance into the container");
                     }
+
+                    ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                                        prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
+                                                                        node.Name()));
+                  }
+                }
+
+              } else if (prepacked_weights_file != nullptr &&
+                         node.GetExecutionProviderType() == kCpuExecutionProvider &&
+                         !const_initialized_tensor.IsDataTypeString()) {  // pre-packed weights' file turned ON
+                const std::string key = PrepackedWeightsFile::GenerateKey(node, input_idx, const_initialized_tensor);
+
+                std::vector<BufferUniquePtr> persisted_buffers;
+                if (prepacked_weights_file->GetWeight(key, persisted_buffers)) {
+                  ORT_RETURN_IF_ERROR(kernel->UsePersistedPrePackedBuffers(const_initialized_tensor,
+                                                                           persisted_buffers, input_idx,
+                                                                           is_packed));
+                  if (is_packed) {
+                    ++used_persisted_pre_packed_weights_counter_;
                   }
+                }
 
-                } else {  // caching of pre-packed weights' turned OFF
+                if (!is_packed) {
                   AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+                  PrePackedWeights weights_to_be_filled_in;
                   ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx,
                                                       session_cpu_alloc,  // use allocator tied to this session
                                                       is_packed,
-                                                      nullptr  // no caching required
-                                                      ));
-                }
-                if (is_packed) {
-                  ++number_of_prepacks_counter_;
+                                                      &weights_to_be_filled_in));
 
-                  if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
-                    // release the constant initialized tensor
-                    st->initialized_tensors_.erase(ort_value_idx);
-                    constant_initialized_tensors.erase(ort_value_idx);
+                  // kernels that can't return their pre-packed weights keep them, and they are not persisted
+                  if (is_packed && !weights_to_be_filled_in.buffers_.empty()) {
+                    ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(
+                        *kernel, input_idx,
+                        prepacked_weights_file->AddWeight(key, std::move(weights_to_be_filled_in)),
+                        node.Name()));
                   }
                 }
+              } else {  // caching of pre-packed weights' turned OFF
+                AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+                ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx,
+                                                    session_cpu_alloc,  // use allocator tied to this session
+                                                    is_packed,
+                                                    nullptr  // no caching required
+                                                    ));
               }
-              // stop searching in 2 cases:
-              // 1. value is not from OuterScope
-              // 2. value is from OuterScope and the current OuterScope has the value
-              if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
-                break;
+              if (is_packed) {
+                packed_initializers.push_back({st, ort_value_idx, &input_name});
               }
             }
-            st = st->Parent();
-          } while (st);
-        }
-        input_idx++;
+            // stop searching in 2 cases:
+            // 1. value is not from OuterScope
+            // 2. value is from OuterScope and the current OuterScope has the value
+            if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
+              break;
+            }
+          }
+          st = st->Parent();
+        } while (st);
       }
+      input_idx++;
+    }
+
+    return Status::OK();
+  };
+
+  auto prepacked_constant_weights = [this, &prepack_node, &release_packed_initializers](
+                                        bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
+    InlinedVector<PackedInitializer> packed_initializers;
+    for (auto& node : GetGraphViewer().Nodes()) {
+      packed_initializers.clear();
+      ORT_RETURN_IF_ERROR(prepack_node(node, should_cache_prepacked_weights_for_shared_initializers,
+                                       packed_initializers));
+      release_packed_initializers(packed_initializers);
+    }
+
+    return Status::OK();
+  };
+
+  // pre-packs the nodes concurrently. an initializer is only released once all nodes were pre-packed, as other
+  // nodes may still be reading it.
+  auto prepacked_constant_weights_in_parallel = [this, &prepack_node, &release_packed_initializers]() -> Status {
+    InlinedVector<const Node*> nodes;
+    for (auto& node : GetGraphViewer().Nodes()) {
+      nodes.push_back(&node);
+    }
+
+    std::vector<InlinedVector<PackedInitializer>> packed_initializers(nodes.size());
+    std::vector<Status> statuses(nodes.size());
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        thread_pool_, static_cast<std::ptrdiff_t>(nodes.size()), [&](std::ptrdiff_t i) {
+          ORT_TRY {
+            statuses[i] = prepack_node(*nodes[i], false, packed_initializers[i]);
+          }
+          ORT_CATCH(const std::exception& ex) {
+            ORT_HANDLE_EXCEPTION([&]() {
+              statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+            });
+          }
+        });
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      ORT_RETURN_IF_ERROR(statuses[i]);
+      release_packed_initializers(packed_initializers[i]);
     }
 
     return Status::OK();
@@ -518,17 +666,82 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
     // and writes pre-packed weights to the container
     std::lock_guard<onnxruntime::OrtMutex> l(prepacked_weights_container_->mutex_);
     return prepacked_constant_weights(true);
+  } else if (prepacked_weights_file == nullptr &&
+             sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsParallelInitialization, "0") == "1") {
+    // the kernels are distinct and PrePack() only reads the initializer, so nodes can be pre-packed concurrently
+    // unless pre-packed weights are shared through the container or the file
+    return prepacked_constant_weights_in_parallel();
   } else {
     return prepacked_constant_weights(false);
   }
 }
 
-static int64_t CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs) {
-  int64_t key = 0;
-  for (const auto& input : tensor_inputs) {
-    for (auto dim : input.Get<Tensor>().Shape().GetDims()) key ^= dim;
+namespace {
+// Rounds dim up to the next power of two. Dims that are not positive are left as is.
+int64_t BucketDim(int64_t dim) {
+  if (dim <= 1) {
+    return dim;
+  }
+  int64_t bucket = 1;
+  while (bucket < dim && bucket <= std::numeric_limits<int64_t>::max() / 2) {
+    bucket <<= 1;
+  }
+  return bucket < dim ? dim : bucket;
+}
+}  // namespace
+
+int64_t SessionState::CalculateMemoryPatternsKey(gsl::span<const OrtValue> tensor_inputs,
+                                                 gsl::span<const int> feed_mlvalue_idxs,
+                                                 TensorShapeVector* dims) const {
+  size_t key = 0;
+  for (size_t i = 0, end = tensor_inputs.size(); i < end; ++i) {
+    const auto input_dims = tensor_inputs[i].Get<Tensor>().Shape().GetDims();
+    const InlinedVector<bool>* bucketed = nullptr;
+    if (mem_pattern_bucketing_ && i < feed_mlvalue_idxs.size()) {
+      auto it = mem_pattern_bucketed_dims_.find(feed_mlvalue_idxs[i]);
+      if (it != mem_pattern_bucketed_dims_.end() && it->second.size() == input_dims.size()) {
+        bucketed = &it->second;
+      }
+    }
+
+    // include the rank so inputs of different ranks don't produce the same sequence of dims
+    HashCombine(input_dims.size(), key);
+    for (size_t d = 0; d < input_dims.size(); ++d) {
+      const int64_t dim = input_dims[d];
+      HashCombine(bucketed && (*bucketed)[d] ? BucketDim(dim) : dim, key);
+      if (dims) {
+        dims->push_back(dim);
+      }
+    }
+  }
+  return static_cast<int64_t>(key);
+}
+
+std::shared_ptr<const MemoryPatternCacheEntry> SessionState::FindMemoryPatternLocked(int64_t key) const {
+  auto it = mem_patterns_.find(key);
+  if (it == mem_patterns_.end()) {
+    return nullptr;
+  }
+  mem_patterns_lru_.splice(mem_patterns_lru_.begin(), mem_patterns_lru_, it->second.lru_it);
+  return it->second.entry;
+}
+
+void SessionState::InsertMemoryPatternLocked(int64_t key, std::shared_ptr<const MemoryPatternCacheEntry> entry) const {
+  auto it = mem_patterns_.find(key);
+  if (it != mem_patterns_.end()) {
+    it->second.entry = std::move(entry);
+    mem_patterns_lru_.splice(mem_patterns_lru_.begin(), mem_patterns_lru_, it->second.lru_it);
+    return;
+  }
+
+  mem_patterns_lru_.push_front(key);
+  mem_patterns_.emplace(key, MemoryPatternCacheSlot{std::move(entry), mem_patterns_lru_.begin()});
+
+  // frames still using an evicted entry keep it alive through their shared_ptr
+  while (mem_pattern_cache_capacity_ > 0 && mem_patterns_.size() > mem_pattern_cache_capacity_) {
+    mem_patterns_.erase(mem_patterns_lru_.back());
+    mem_patterns_lru_.pop_back();
   }
-  return key;
 }
 
 #ifdef ENABLE_TRAINING
@@ -699,6 +912,7 @@ Status SessionState::GeneratePatternGroupCache(gsl::span<const OrtValue> tensor_
   }
   // TODO: add check for single stream
   // Allocate all other activations.
+  InlinedHashSet<int> traced_values;
   for (auto& step_index : execution_order) {
     int node_index = node_index_info.GetNodeOffset(step_index);
     auto* node = graph_viewer_->GetNode(step_index);
@@ -706,11 +920,19 @@ Status SessionState::GeneratePatternGroupCache(gsl::span<const OrtValue> tensor_
                        static_cast<int>(node->ImplicitInputDefs().size());
     // allocate output
     for (int i = 0, end = static_cast<int>(node->OutputDefs().size()); i < end; ++i) {
-      const auto ml_value_idx = node_index_info.GetMLValueIndex(output_start + i);
+      auto ml_value_idx = node_index_info.GetMLValueIndex(output_start + i);
+      // a value placed in a sub-buffer, like an input of Concat written in place in the Concat output, allocates the
+      // buffer it is placed in if that buffer doesn't exist yet.
+      if (ml_value_idx != NodeIndexInfo::kInvalidEntry &&
+          exe_plan->allocation_plan[ml_value_idx].alloc_kind == AllocKind::kReuse &&
+          exe_plan->allocation_plan[ml_value_idx].is_sub_buffer) {
+        ml_value_idx = exe_plan->allocation_plan[ml_value_idx].reused_buffer;
+      }
       if (ml_value_idx == NodeIndexInfo::kInvalidEntry ||
           (std::find(exe_plan->activation_allocation_order.begin(),
                      exe_plan->activation_allocation_order.end(), ml_value_idx) !=
-           exe_plan->activation_allocation_order.end()))
+           exe_plan->activation_allocation_order.end()) ||
+          !traced_values.insert(ml_value_idx).second)
         continue;
       const auto* ml_type = exe_plan->allocation_plan[ml_value_idx].value_type;
       if (!ml_type->IsTensorType())
@@ -765,38 +987,48 @@ Status SessionState::GeneratePatternGroupCache(gsl::span<const OrtValue> tensor_
 
 #endif
 
-// MemoryPatternGroup pointer is cached. It only inserted upon creation
-// and is not updated if already present.
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
+// Without bucketing an entry is only inserted upon creation and is not updated if already present.
+// With bucketing an entry is replaced when a Run in its bucket needed more memory than it was recorded for.
+std::shared_ptr<const MemoryPatternCacheEntry> SessionState::GetMemoryPatternGroup(
     gsl::span<const OrtValue> tensor_inputs,
-    gsl::span<const int> feed_mlvalue_idxs,
-    const InlinedHashMap<int, TensorShape>*& out_inferred_shapes) const {
-  out_inferred_shapes = nullptr;
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
+    gsl::span<const int> feed_mlvalue_idxs) const {
+  if (static_memory_plan_ && MatchesStaticMemoryPlan(tensor_inputs, feed_mlvalue_idxs)) {
+    return static_memory_plan_;
+  }
+
+  TensorShapeVector dims;
+  int64_t key = CalculateMemoryPatternsKey(tensor_inputs, feed_mlvalue_idxs,
+                                           mem_pattern_bucketing_ ? &dims : nullptr);
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
+  auto entry = FindMemoryPatternLocked(key);
+  if (!entry) {
 #ifdef ENABLE_TRAINING
-    MemoryPatternGroup mem_patterns;
-    InlinedHashMap<int, TensorShape> inferred_shapes;
-    if (GeneratePatternGroupCache(tensor_inputs, feed_mlvalue_idxs, mem_patterns, inferred_shapes).IsOK()) {
-      auto patt_insert = mem_patterns_.insert_or_assign(key, std::move(mem_patterns));
-      auto ptr = &patt_insert.first->second;
-      auto shape_insert = shape_patterns_.insert_or_assign(key, std::move(inferred_shapes));
-      out_inferred_shapes = &shape_insert.first->second;
-      return ptr;
+    auto new_entry = std::make_shared<MemoryPatternCacheEntry>();
+    if (GeneratePatternGroupCache(tensor_inputs, feed_mlvalue_idxs, new_entry->patterns,
+                                  new_entry->inferred_shapes)
+            .IsOK()) {
+      new_entry->has_inferred_shapes = true;
+      new_entry->recorded_dims = std::move(dims);
+      InsertMemoryPatternLocked(key, new_entry);
+      return new_entry;
     }
-#else
-    ORT_UNUSED_PARAMETER(feed_mlvalue_idxs);
 #endif
     return nullptr;
   }
 
-  auto patt_hit = shape_patterns_.find(key);
-  if (patt_hit != shape_patterns_.cend()) {
-    out_inferred_shapes = &patt_hit->second;
+  if (mem_pattern_bucketing_) {
+    // the patterns only fit if no input dim exceeds the dims they were recorded for
+    if (entry->recorded_dims.size() != dims.size()) {
+      return nullptr;
+    }
+    for (size_t i = 0; i < dims.size(); ++i) {
+      if (dims[i] > entry->recorded_dims[i]) {
+        return nullptr;
+      }
+    }
   }
-  return &it->second;
+
+  return entry;
 }
 
 void SessionState::ResolveMemoryPatternFlag() {
@@ -843,15 +1075,316 @@ void SessionState::ResolveMemoryPatternFlag() {
       }
     }
   }
+
+  if (enable_mem_pattern_) {
+    ResolveMemoryPatternBucketing();
+  }
+}
+
+void SessionState::ResolveMemoryPatternBucketing() {
+  const auto& config_options = sess_options_.config_options;
+  const auto cache_size = config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryPatternCacheSize, "0");
+  if (!TryParseStringWithClassicLocale(cache_size, mem_pattern_cache_capacity_)) {
+    LOGS(logger_, WARNING) << "Invalid value for " << kOrtSessionOptionsMemoryPatternCacheSize << ": " << cache_size
+                           << ". The memory pattern cache will be unbounded.";
+    mem_pattern_cache_capacity_ = 0;
+  }
+
+  mem_pattern_bucketing_ =
+      config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryPatternBucketing, "0") == "1";
+  if (!mem_pattern_bucketing_) {
+    return;
+  }
+
+  // bucket the listed symbolic dims, or all dims that are not fixed if none are listed
+  InlinedHashSet<std::string> dim_params;
+  const auto dim_params_str = config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryPatternBucketDims, "");
+  for (const auto& dim_param : utils::SplitString(dim_params_str, ",")) {
+    dim_params.insert(std::string(dim_param));
+  }
+
+  for (const auto* input : graph_viewer_->GetInputs()) {
+    const auto* shape = input->Shape();
+    int idx = 0;
+    if (!shape || !ort_value_name_idx_map_.GetIdx(input->Name(), idx).IsOK()) {
+      continue;
+    }
+
+    InlinedVector<bool> bucketed(static_cast<size_t>(shape->dim_size()), false);
+    bool any_bucketed = false;
+    for (int k = 0, end = shape->dim_size(); k < end; ++k) {
+      const auto& dim = shape->dim(k);
+      bucketed[k] = dim_params.empty() ? !dim.has_dim_value()
+                                       : (dim.has_dim_param() && dim_params.count(dim.dim_param()) > 0);
+      any_bucketed = any_bucketed || bucketed[k];
+    }
+
+    if (any_bucketed) {
+      mem_pattern_bucketed_dims_.insert_or_assign(idx, std::move(bucketed));
+    }
+  }
+
+  LOGS(logger_, INFO) << "Memory pattern shape bucketing enabled for " << mem_pattern_bucketed_dims_.size()
+                      << " graph inputs.";
 }
 
 Status SessionState::UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
+                                                   gsl::span<const int> feed_mlvalue_idxs,
                                                    MemoryPatternGroup mem_patterns) const {
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
+  auto entry = std::make_shared<MemoryPatternCacheEntry>();
+  entry->patterns = std::move(mem_patterns);
+  int64_t key = CalculateMemoryPatternsKey(tensor_inputs, feed_mlvalue_idxs,
+                                           mem_pattern_bucketing_ ? &entry->recorded_dims : nullptr);
 
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  // Do not update if present, as the pointer to the existing one is cached
-  mem_patterns_.emplace(key, std::move(mem_patterns));
+  auto existing = FindMemoryPatternLocked(key);
+  if (existing) {
+    if (!mem_pattern_bucketing_) {
+      // Do not update if present
+      return Status::OK();
+    }
+
+    // Keep the element-wise max of the recorded dims. The new patterns were traced from a Run that did not fit
+    // the existing entry, so they are at least as large for every dim that grew.
+    if (existing->recorded_dims.size() == entry->recorded_dims.size()) {
+      for (size_t i = 0; i < entry->recorded_dims.size(); ++i) {
+        if (existing->recorded_dims[i] > entry->recorded_dims[i]) {
+          // neither entry dominates the other. keep the existing one to avoid thrashing.
+          return Status::OK();
+        }
+      }
+    }
+  }
+
+  InsertMemoryPatternLocked(key, std::move(entry));
+  return Status::OK();
+}
+
+bool SessionState::MatchesStaticMemoryPlan(gsl::span<const OrtValue> tensor_inputs,
+                                           gsl::span<const int> feed_mlvalue_idxs) const {
+  size_t num_matched = 0;
+  for (size_t i = 0, end = std::min(tensor_inputs.size(), feed_mlvalue_idxs.size()); i < end; ++i) {
+    auto it = static_memory_plan_input_dims_.find(feed_mlvalue_idxs[i]);
+    if (it == static_memory_plan_input_dims_.end()) {
+      continue;
+    }
+
+    const auto input_dims = tensor_inputs[i].Get<Tensor>().Shape().GetDims();
+    if (!std::equal(input_dims.begin(), input_dims.end(), it->second.begin(), it->second.end())) {
+      return false;
+    }
+    ++num_matched;
+  }
+
+  return num_matched == static_memory_plan_input_dims_.size();
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+namespace {
+// Returns the size of the buffer ExecutionFrame allocates for a value with a fixed shape, or 0 if the shape
+// isn't fully known.
+size_t GetStaticTensorBufferSize(const NodeArg& arg, MLDataType element_type) {
+  const auto* shape = arg.Shape();
+  if (!shape) {
+    return 0;
+  }
+
+  SafeInt<size_t> num_elements = 1;
+  for (const auto& dim : shape->dim()) {
+    if (!dim.has_dim_value() || dim.dim_value() < 0) {
+      return 0;
+    }
+    num_elements *= dim.dim_value();
+  }
+
+  size_t size = 0;
+  if (!IAllocator::CalcMemSizeForArrayWithAlignment<kAllocAlignment>(static_cast<size_t>(num_elements),
+                                                                     element_type->Size(), &size)) {
+    return 0;
+  }
+  return size;
+}
+}  // namespace
+
+Status SessionState::SaveStaticMemoryPlanToOrtFormat(
+    flatbuffers::FlatBufferBuilder& builder,
+    flatbuffers::Offset<fbs::StaticMemoryPlan>& fbs_static_memory_plan) const {
+  fbs_static_memory_plan = 0;
+
+  const auto* exe_plan = GetExecutionPlan();
+  // the order allocations and frees happen in is only fixed with a single stream
+  if (!enable_mem_pattern_ || exe_plan == nullptr || exe_plan->execution_plan.size() != 1) {
+    LOGS(logger_, INFO) << "Static memory plan requires memory patterns and a single stream execution plan.";
+    return Status::OK();
+  }
+
+  const auto& graph_inputs = graph_viewer_->GetInputs();
+  std::vector<flatbuffers::Offset<fbs::StaticMemoryPlanInput>> fbs_inputs;
+  fbs_inputs.reserve(graph_inputs.size());
+  for (const auto* input : graph_inputs) {
+    const auto* shape = input->Shape();
+    if (!shape) {
+      LOGS(logger_, INFO) << "Static memory plan not saved as graph input " << input->Name() << " has no shape.";
+      return Status::OK();
+    }
+
+    std::vector<int64_t> dims;
+    dims.reserve(shape->dim_size());
+    for (const auto& dim : shape->dim()) {
+      if (!dim.has_dim_value()) {
+        LOGS(logger_, INFO) << "Static memory plan not saved as graph input " << input->Name()
+                            << " has a dynamic shape.";
+        return Status::OK();
+      }
+      dims.push_back(dim.dim_value());
+    }
+
+    fbs_inputs.push_back(fbs::CreateStaticMemoryPlanInput(builder, builder.CreateSharedString(input->Name()),
+                                                          builder.CreateVector(dims)));
+  }
+
+  // Replay the allocations and frees ExecutionFrame traces during a Run, using the inferred output shapes.
+  // Values whose shapes aren't known are left out of the plan and allocated at runtime.
+  OrtValuePatternPlanner mem_planner(*exe_plan);
+  InlinedVector<size_t> release_counts;
+  release_counts.reserve(exe_plan->release_actions.size());
+  for (const auto& action : exe_plan->release_actions) {
+    release_counts.push_back(action.ref_count);
+  }
+
+  // a single stream only contains kernel launch steps
+  for (const auto& step : exe_plan->execution_plan[0]->steps_) {
+    const auto node_index = step->GetNodeIndex();
+    const auto* node = graph_viewer_->GetNode(node_index);
+    ORT_RETURN_IF(node == nullptr, "Node ", node_index, " in the execution plan was not found.");
+
+    for (const auto* output : node->OutputDefs()) {
+      if (!output->Exists()) {
+        continue;
+      }
+
+      int ort_value_idx;
+      ORT_RETURN_IF_ERROR(ort_value_name_idx_map_.GetIdx(output->Name(), ort_value_idx));
+      const auto& alloc_plan = exe_plan->allocation_plan[ort_value_idx];
+      if (alloc_plan.alloc_kind != AllocKind::kAllocate || !alloc_plan.value_type->IsTensorType()) {
+        continue;
+      }
+
+      const auto* element_type = static_cast<const TensorTypeBase*>(alloc_plan.value_type)->GetElementType();
+      if (element_type == DataTypeImpl::GetType<std::string>()) {
+        continue;
+      }
+
+      const size_t size = GetStaticTensorBufferSize(*output, element_type);
+      if (size != 0) {
+        ORT_RETURN_IF_ERROR(mem_planner.TraceAllocation(ort_value_idx, size));
+      }
+    }
+
+    for (auto action_idx : exe_plan->node_release_list[node_index]) {
+      if (--release_counts[action_idx] == 0) {
+        ORT_RETURN_IF_ERROR(mem_planner.TraceFree(static_cast<int>(exe_plan->release_actions[action_idx].value_index)));
+      }
+    }
+  }
+
+  MemoryPatternGroup patterns;
+  ORT_RETURN_IF_ERROR(mem_planner.GeneratePatterns(patterns));
+
+  std::vector<flatbuffers::Offset<fbs::StaticMemoryPlanBuffer>> fbs_buffers;
+  fbs_buffers.reserve(patterns.locations.size());
+  for (size_t i = 0; i < patterns.locations.size(); ++i) {
+    const auto& location = patterns.locations[i];
+    const auto& pattern = patterns.patterns[i];
+    if (pattern.GetPatternsMap().empty()) {
+      continue;
+    }
+
+    // sort by offset so the saved model is deterministic
+    std::vector<std::pair<int, MemoryBlock>> blocks(pattern.GetPatternsMap().begin(), pattern.GetPatternsMap().end());
+    std::sort(blocks.begin(), blocks.end(), [](const auto& a, const auto& b) {
+      return a.second.offset_ != b.second.offset_ ? a.second.offset_ < b.second.offset_ : a.first < b.first;
+    });
+
+    std::vector<flatbuffers::Offset<fbs::StaticMemoryPlanBlock>> fbs_blocks;
+    fbs_blocks.reserve(blocks.size());
+    for (const auto& [ort_value_idx, block] : blocks) {
+      std::string name;
+      ORT_RETURN_IF_ERROR(ort_value_name_idx_map_.GetName(ort_value_idx, name));
+      fbs_blocks.push_back(fbs::CreateStaticMemoryPlanBlock(builder, builder.CreateSharedString(name),
+                                                            block.offset_, block.size_));
+    }
+
+    fbs_buffers.push_back(fbs::CreateStaticMemoryPlanBuffer(builder, location.Type(), location.MemType(),
+                                                            location.Id(), pattern.PeakSize(),
+                                                            builder.CreateVector(fbs_blocks)));
+  }
+
+  fbs_static_memory_plan = fbs::CreateStaticMemoryPlan(builder, builder.CreateVector(fbs_inputs),
+                                                       builder.CreateVector(fbs_buffers));
+  return Status::OK();
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+Status SessionState::LoadStaticMemoryPlanFromOrtFormat(const fbs::StaticMemoryPlan& fbs_static_memory_plan) {
+  if (!enable_mem_pattern_) {
+    LOGS(logger_, INFO) << "Static memory plan ignored as memory patterns are disabled.";
+    return Status::OK();
+  }
+
+  const auto* fbs_inputs = fbs_static_memory_plan.inputs();
+  const auto* fbs_buffers = fbs_static_memory_plan.buffers();
+  ORT_RETURN_IF(fbs_inputs == nullptr || fbs_buffers == nullptr,
+                "StaticMemoryPlan is missing inputs or buffers. ", fbs::utils::kInvalidOrtFormatModelMessage);
+
+  InlinedHashMap<int, TensorShapeVector> input_dims;
+  input_dims.reserve(fbs_inputs->size());
+  for (const auto* fbs_input : *fbs_inputs) {
+    ORT_RETURN_IF(fbs_input == nullptr || fbs_input->name() == nullptr || fbs_input->dims() == nullptr,
+                  "StaticMemoryPlanInput is invalid. ", fbs::utils::kInvalidOrtFormatModelMessage);
+    int ort_value_idx;
+    ORT_RETURN_IF_ERROR(ort_value_name_idx_map_.GetIdx(fbs_input->name()->string_view(), ort_value_idx));
+    input_dims.insert_or_assign(ort_value_idx,
+                                TensorShapeVector(fbs_input->dims()->begin(), fbs_input->dims()->end()));
+  }
+
+  const auto& allocation_plan = GetExecutionPlan()->allocation_plan;
+  auto entry = std::make_shared<MemoryPatternCacheEntry>();
+  for (const auto* fbs_buffer : *fbs_buffers) {
+    ORT_RETURN_IF(fbs_buffer == nullptr || fbs_buffer->blocks() == nullptr,
+                  "StaticMemoryPlanBuffer is invalid. ", fbs::utils::kInvalidOrtFormatModelMessage);
+    const OrtDevice location(fbs_buffer->device_type(), fbs_buffer->device_mem_type(), fbs_buffer->device_id());
+    const size_t peak_size = gsl::narrow<size_t>(fbs_buffer->size());
+
+    InlinedHashMap<int, MemoryBlock> blocks;
+    blocks.reserve(fbs_buffer->blocks()->size());
+    for (const auto* fbs_block : *fbs_buffer->blocks()) {
+      ORT_RETURN_IF(fbs_block == nullptr || fbs_block->value_name() == nullptr ||
+                        fbs_block->offset() > peak_size || fbs_block->size() > peak_size - fbs_block->offset(),
+                    "StaticMemoryPlanBlock is invalid. ", fbs::utils::kInvalidOrtFormatModelMessage);
+      int ort_value_idx;
+      ORT_RETURN_IF_ERROR(ort_value_name_idx_map_.GetIdx(fbs_block->value_name()->string_view(), ort_value_idx));
+
+      // the plan was computed for the execution providers the model was saved with. don't use it if the
+      // values are placed differently in this session.
+      const auto& alloc_plan = allocation_plan[ort_value_idx];
+      if (alloc_plan.alloc_kind != AllocKind::kAllocate || !(alloc_plan.location == location)) {
+        LOGS(logger_, WARNING) << "Static memory plan ignored as it doesn't match the allocation plan for "
+                               << fbs_block->value_name()->string_view();
+        return Status::OK();
+      }
+
+      blocks.insert_or_assign(ort_value_idx, MemoryBlock(gsl::narrow<size_t>(fbs_block->offset()),
+                                                         gsl::narrow<size_t>(fbs_block->size())));
+    }
+
+    entry->patterns.locations.push_back(location);
+    entry->patterns.patterns.emplace_back(std::move(blocks), peak_size);
+  }
+
+  static_memory_plan_ = std::move(entry);
+  static_memory_plan_input_dims_ = std::move(input_dims);
+  LOGS(logger_, INFO) << "Loaded static memory plan with " << fbs_buffers->size() << " buffers.";
   return Status::OK();
 }
 
@@ -1184,10 +1717,27 @@ Status SessionState::FinalizeSessionState(const std::basic_string<PATH_CHAR_TYPE
   ORT_RETURN_IF_ERROR(VerifyEachNodeIsAssignedToAnEp(graph_, logger_, execution_providers_));
   ORT_RETURN_IF_ERROR(PopulateKernelCreateInfo(kernel_registry_manager, saving_ort_format));
 
+  const std::string prepacked_weights_file_path =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigPrepackedWeightsFile, "");
+  if (!prepacked_weights_file_path.empty()) {
+    ORT_RETURN_IF_ERROR(PrepackedWeightsFile::Open(ToPathString(prepacked_weights_file_path), logger_,
+                                                   prepacked_weights_file_));
+  }
+
   InlinedHashMap<std::string, size_t> constant_initializers_use_count;
   ComputeConstantInitializerUseCount(graph_, constant_initializers_use_count);
-  return FinalizeSessionStateImpl(graph_location, kernel_registry_manager, nullptr, sess_options_,
-                                  remove_initializers, constant_initializers_use_count);
+  ORT_RETURN_IF_ERROR(FinalizeSessionStateImpl(graph_location, kernel_registry_manager, nullptr, sess_options_,
+                                               remove_initializers, constant_initializers_use_count));
+
+  if (prepacked_weights_file_) {
+    // the session works without the file, so failing to write it is not an error
+    auto status = prepacked_weights_file_->Save();
+    if (!status.IsOK()) {
+      LOGS(logger_, WARNING) << "Failed to write the pre-packed weights file " << prepacked_weights_file_path << ": "
+                             << status.ErrorMessage();
+    }
+  }
+  return Status::OK();
 }
 
 static Status Index(const OrtValueNameIdxMap& ort_value_name_idx_map,
@@ -1394,17 +1944,21 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
 
 #endif
 
-  auto status = SequentialPlanner::CreatePlan(parent_node, *graph_viewer_, valid_outer_scope_node_args,
-                                              execution_providers_, kernel_create_info_map_,
-                                              subgraphs_kernel_create_info_maps,
-                                              outer_scope_node_arg_to_location_map,
-                                              ort_value_name_idx_map_, context,
+  Status status;
+  {
+    StartupPhase phase("execution_plan");
+    status = SequentialPlanner::CreatePlan(parent_node, *graph_viewer_, valid_outer_scope_node_args,
+                                            execution_providers_, kernel_create_info_map_,
+                                            subgraphs_kernel_create_info_maps,
+                                            outer_scope_node_arg_to_location_map,
+                                            ort_value_name_idx_map_, context,
 #ifdef ORT_ENABLE_STREAM
-                                              GetStreamHandleRegistryInstance(),
+                                            GetStreamHandleRegistryInstance(),
 #endif
-                                              partition_config_file,
-                                              Logger(),
-                                              p_seq_exec_plan_);
+                                            partition_config_file,
+                                            Logger(),
+                                            p_seq_exec_plan_);
+  }
   ORT_RETURN_IF_ERROR(status);
 
   // Record the allocation plan
@@ -1416,6 +1970,14 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   GetMemoryProfiler()->Init(GetExecutionPlan(), GetOrtValueNameIdxMap());
 #endif
 
+#ifdef ORT_ENABLE_STREAM
+  // the streamed initializers are saved in host memory
+  if (weight_streaming_ep_ != nullptr) {
+    weight_streamer_ = std::make_unique<WeightStreamer>(*this, *weight_streaming_ep_);
+    ORT_RETURN_IF_ERROR(weight_streamer_->SelectInitializers(weight_streaming_budget_, *p_seq_exec_plan_));
+  }
+#endif
+
   // Note: For Training Prepacking should be always disabled.
   // For inference it is enabled by default, but users can choose to disable it via session options.
   const bool disable_prepacking =
@@ -1473,20 +2035,36 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   }
 #endif
 
-  ORT_RETURN_IF_ERROR(
-      session_state_utils::SaveInitializedTensors(
-          Env::Default(), graph_location, *graph_viewer_,
-          GetAllocator(OrtDevice()),
-          ort_value_name_idx_map_, initializer_allocation_order, *tensor_allocator,
-          [this, remove_initializers](const std::string& name, int idx, const OrtValue& value, const OrtCallback& d,
-                                      bool constant, bool sparse) -> Status {
-            ORT_RETURN_IF_ERROR(AddInitializedTensor(idx, value, &d, constant, sparse));
-            if (remove_initializers) {
-              graph_.RemoveInitializedTensor(name);
-            }
-            return Status::OK();
-          },
-          logger_, data_transfer_mgr_, *p_seq_exec_plan_, session_options, memory_profile_func));
+  // external initializers copied to a device in chunks are staged in pinned memory if an EP provides it
+  session_state_utils::ExternalDataStaging external_data_staging;
+  for (const auto& [device, alloc] : *allocators_) {
+    if (device.Type() == OrtDevice::CPU && device.MemType() != OrtDevice::MemType::DEFAULT) {
+      external_data_staging.pinned_alloc = alloc;
+      break;
+    }
+  }
+#ifdef ORT_ENABLE_STREAM
+  external_data_staging.stream_handle_registry = &GetStreamHandleRegistryInstance();
+#endif
+
+  {
+    StartupPhase phase("initializer_load");
+    ORT_RETURN_IF_ERROR(
+        session_state_utils::SaveInitializedTensors(
+            Env::Default(), graph_location, *graph_viewer_,
+            GetAllocator(OrtDevice()),
+            ort_value_name_idx_map_, initializer_allocation_order, *tensor_allocator,
+            [this, remove_initializers](const std::string& name, int idx, const OrtValue& value, const OrtCallback& d,
+                                        bool constant, bool sparse) -> Status {
+              ORT_RETURN_IF_ERROR(AddInitializedTensor(idx, value, &d, constant, sparse));
+              if (remove_initializers) {
+                graph_.RemoveInitializedTensor(name);
+              }
+              return Status::OK();
+            },
+            logger_, data_transfer_mgr_, *p_seq_exec_plan_, session_options, memory_profile_func,
+            thread_pool_, external_data_staging));
+  }
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Record Weight allocation info on device
@@ -1500,9 +2078,13 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
     CleanInitializedTensorsFromGraph();
   }
 
-  ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
+  {
+    StartupPhase phase("kernel_creation");
+    ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
+  }
 
   if (!disable_prepacking) {
+    StartupPhase phase("prepacking");
     ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
                                                           session_options.initializers_to_share_map));
   }
@@ -1510,6 +2092,25 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   ORT_RETURN_IF_ERROR(
       session_state_utils::SaveInputOutputNamesToNodeMapping(*graph_viewer_, *this, valid_outer_scope_node_args));
 
+  if (graph_segment_capture_ep_ != nullptr) {
+    graph_segment_capture_ = std::make_unique<GraphSegmentCapture>(*this, *graph_segment_capture_ep_);
+  }
+
+#ifdef ORT_ENABLE_STREAM
+  if (weight_streamer_ != nullptr) {
+    ORT_RETURN_IF_ERROR(weight_streamer_->Initialize());
+  }
+#endif
+
+  if (session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsLeanExecutor, "0") == "1") {
+    lean_execution_plan_ = LeanExecutionPlan::Create(*this);
+    LOGS(logger_, INFO) << (lean_execution_plan_ != nullptr ? "The execution plan runs lean"
+                                                            : "The execution plan can't run lean");
+  }
+
+  coalesce_feed_copies_ =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsCoalesceFeedCopies, "0") == "1";
+
   // Need to recurse into subgraph session state instances to finalize them and add the execution info
 
   // Currently all subgraphs need to be executed using the sequential EP due to potential deadlock with the current
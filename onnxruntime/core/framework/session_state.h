@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <list>
 #include <memory>
 #include <map>
 #include <unordered_map>
@@ -24,8 +25,12 @@
 #include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/prepacked_weights_file.h"
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/kernel_registry_manager.h"
+#include "core/framework/lean_execution_plan.h"
+#include "core/framework/graph_segment_capture.h"
+#include "core/framework/weight_streamer.h"
 #include "core/framework/mem_pattern.h"
 #include "core/framework/ort_value.h"
 #include "core/framework/node_index_info.h"
@@ -49,6 +54,7 @@ namespace onnxruntime {
 
 namespace fbs {
 struct SessionState;
+struct StaticMemoryPlan;
 }  // namespace fbs
 
 class ExecutionProviders;
@@ -58,10 +64,23 @@ class NodeIndexInfo;
 struct SequentialExecutionPlan;
 struct MemoryPatternGroup;
 class DeviceStreamCollection;
+class SessionMetrics;
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 class MemoryInfo;
 #endif
 
+// A memory pattern cached by SessionState, together with the data it was generated from.
+// Held by shared_ptr so an ExecutionFrame can keep using an entry that was evicted or replaced while it runs.
+struct MemoryPatternCacheEntry {
+  MemoryPatternGroup patterns;
+  // Shapes inferred together with the patterns. Only populated in training builds.
+  InlinedHashMap<int, TensorShape> inferred_shapes;
+  bool has_inferred_shapes = false;
+  // Input dims of the Run the patterns were recorded from. Only used with shape bucketing, where
+  // the entry serves every Run whose input dims are element-wise no larger than these.
+  TensorShapeVector recorded_dims;
+};
+
 /**
  * SessionState should be modified by the inference session class only.
  * It is supposed to be passed by const-ref only to all the executors.
@@ -135,6 +154,13 @@ class SessionState {
 
   void UpdateAllocatorsWithEnvAllocators(const std::vector<AllocatorPtr>&);
 
+  /** Make Runs of this graph take their memory pattern buffers from the given environment activation pools.
+      Subgraph session states do not inherit them, as a nested Run waiting on the pool could deadlock its parent. */
+  void SetActivationPools(const std::vector<AllocatorPtr>& activation_pools);
+
+  /** Get the activation pool for a given OrtDevice, or nullptr if there is none. */
+  AllocatorPtr GetActivationPool(const OrtDevice& device) const noexcept;
+
   const OrtValueNameIdxMap& GetOrtValueNameIdxMap() const noexcept { return ort_value_name_idx_map_; }
 
   /**
@@ -211,19 +237,58 @@ class SessionState {
   }
 #endif
 
+  /**
+  Get the metrics the executor records the kernel latencies of the sampled Runs in, or nullptr if the session doesn't
+  collect metrics. Only set in the session state of the main graph.
+  */
+  SessionMetrics* GetMetrics() const noexcept { return metrics_; }
+
+  void SetMetrics(SessionMetrics* metrics) noexcept { metrics_ = metrics; }
+
+  /**
+  Capture the kernels of the given execution provider in graph segments, see GraphSegmentCapture.
+  The segments keep the tensors they write alive, so the tensors can't be placed in the buffer of a memory pattern.
+  Must be called before FinalizeSessionState.
+  */
+  void EnableGraphSegmentCapture(IExecutionProvider& ep) {
+    graph_segment_capture_ep_ = &ep;
+    enable_mem_pattern_ = false;
+  }
+
+  // nullptr unless EnableGraphSegmentCapture was called
+  const GraphSegmentCapture* GetGraphSegmentCapture() const noexcept { return graph_segment_capture_.get(); }
+
+  /**
+  Keep the initializers of the given execution provider beyond budget bytes of device memory in host memory, and copy
+  them to the device ahead of the nodes that read them in each run, see WeightStreamer.
+  Must be called before FinalizeSessionState.
+  */
+  void EnableWeightStreaming(IExecutionProvider& ep, size_t budget) {
+    weight_streaming_ep_ = &ep;
+    weight_streaming_budget_ = budget;
+  }
+
+  // nullptr unless EnableWeightStreaming was called
+  const WeightStreamer* GetWeightStreamer() const noexcept { return weight_streamer_.get(); }
+
+  // nullptr unless kOrtSessionOptionsLeanExecutor is enabled and the execution plan can run lean
+  const LeanExecutionPlan* GetLeanExecutionPlan() const noexcept { return lean_execution_plan_.get(); }
+
+  // whether kOrtSessionOptionsCoalesceFeedCopies is enabled
+  bool CoalesceFeedCopies() const noexcept { return coalesce_feed_copies_; }
+
   /**
   Get cached memory pattern based on input shapes
   Must be called only when all values contain tensors
-  In training scenarios, the cache may be updated so
-  the callers would receive a copy of inferred shapes
-  made under mutex being held. In inference scenarios,
-  it is not mutable, we do not obtain a lock and simply get a pointer
-  w/o copying a hashtable
+  In training scenarios, the cache may be updated so the pattern and
+  the inferred shapes are generated under the mutex.
+  Returns nullptr if no pattern can serve the input shapes.
+  With shape bucketing enabled the returned patterns may have been recorded
+  for larger input shapes in the same bucket.
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
+  std::shared_ptr<const MemoryPatternCacheEntry> GetMemoryPatternGroup(
       gsl::span<const OrtValue> tensor_inputs,
-      gsl::span<const int> feed_mlvalue_idxs,
-      const InlinedHashMap<int, TensorShape>*& inferred_shapes) const;
+      gsl::span<const int> feed_mlvalue_idxs) const;
 
   /**
   Set generated memory pattern with a given input shapes.
@@ -231,8 +296,32 @@ class SessionState {
   All inputs must represent Tensors
   */
   Status UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
+                                       gsl::span<const int> feed_mlvalue_idxs,
                                        MemoryPatternGroup mem_patterns) const;
 
+#if !defined(ORT_MINIMAL_BUILD)
+  /**
+  Compute a static memory plan from the shapes inferred for the graph and save it in ORT format.
+  The plan is only computed for a single stream execution plan where every graph input has a fixed shape.
+  If it can't be computed 'fbs_static_memory_plan' is left null.
+  */
+  Status SaveStaticMemoryPlanToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
+                                         flatbuffers::Offset<fbs::StaticMemoryPlan>& fbs_static_memory_plan) const;
+#endif
+
+  /**
+  Load a static memory plan saved in an ORT format model. It is used as the memory pattern of every Run
+  whose input shapes match the shapes the plan was computed for.
+  Must be called after ResolveMemoryPatternFlag. The plan is ignored if memory patterns are disabled.
+  */
+  Status LoadStaticMemoryPlanFromOrtFormat(const fbs::StaticMemoryPlan& fbs_static_memory_plan);
+
+  /**
+  Whether memory pattern keys round dynamic input dims up to buckets.
+  If so a block of a cached pattern may be used for a smaller tensor.
+  */
+  bool GetEnableMemoryPatternBucketing() const { return mem_pattern_bucketing_; }
+
   bool GetUseDeterministicCompute() const { return sess_options_.use_deterministic_compute; }
 
   /**
@@ -323,6 +412,10 @@ class SessionState {
     return used_shared_pre_packed_weights_counter_;
   }
 
+  size_t GetUsedPersistedPrePackedWeightCounter() const {
+    return used_persisted_pre_packed_weights_counter_;
+  }
+
   const KernelCreateInfoMap& GetKernelCreateInfoMap() const {
     return kernel_create_info_map_;
   }
@@ -407,6 +500,10 @@ class SessionState {
   // fused_funcs_mgr_ must live longer than the session_kernels_, becaues a kernel could be created from this manager
   FuncManager fused_funcs_mgr_;
 
+  // File of pre-packed weights used by the kernels of this session state and of its subgraphs, so it must live
+  // longer than the session_kernels_. Only set in the root session state, if a file is configured.
+  std::unique_ptr<PrepackedWeightsFile> prepacked_weights_file_;
+
   // cache of the constructed kernels to avoid spending construction time per executor
   std::vector<std::unique_ptr<OpKernel>> session_kernels_;
   Graph& graph_;
@@ -452,6 +549,9 @@ class SessionState {
   std::unique_ptr<AllocatorMap> allocators_unique_ptr_;
   AllocatorMap* allocators_;
 
+  // environment activation pools the memory pattern buffers of this graph come from. empty for subgraphs.
+  AllocatorMap activation_pools_;
+
   OrtValueNameIdxMap ort_value_name_idx_map_;
 
   // initialized tensors
@@ -480,21 +580,55 @@ class SessionState {
   MemoryProfiler* memory_profiler_;
 #endif
 
+  // not owned, see GetMetrics()
+  SessionMetrics* metrics_ = nullptr;
+
   // switch for enable memory pattern optimization or not.
   bool enable_mem_pattern_;
 
+  // Reads the memory pattern bucketing and cache size session options and resolves which
+  // input dims are bucketed. Called by ResolveMemoryPatternFlag.
+  void ResolveMemoryPatternBucketing();
+
+  // Computes the memory pattern cache key for the input shapes. With bucketing the bucketed dims are rounded up
+  // to the next power of two first. If 'dims' is not null it receives the concatenated input dims.
+  int64_t CalculateMemoryPatternsKey(gsl::span<const OrtValue> tensor_inputs,
+                                     gsl::span<const int> feed_mlvalue_idxs,
+                                     TensorShapeVector* dims) const;
+
+  // Whether the input shapes are the ones the static memory plan was computed for.
+  bool MatchesStaticMemoryPlan(gsl::span<const OrtValue> tensor_inputs,
+                               gsl::span<const int> feed_mlvalue_idxs) const;
+
+  // Looks up 'key' and marks it as most recently used. Requires mem_patterns_lock_ to be held.
+  std::shared_ptr<const MemoryPatternCacheEntry> FindMemoryPatternLocked(int64_t key) const;
+
+  // Inserts or replaces the entry for 'key' and evicts the least recently used entries beyond
+  // mem_pattern_cache_capacity_. Requires mem_patterns_lock_ to be held.
+  void InsertMemoryPatternLocked(int64_t key, std::shared_ptr<const MemoryPatternCacheEntry> entry) const;
+
   // lock for the mem_patterns_
   mutable OrtMutex mem_patterns_lock_;
+  struct MemoryPatternCacheSlot {
+    std::shared_ptr<const MemoryPatternCacheEntry> entry;
+    std::list<int64_t>::iterator lru_it;
+  };
   // cache for the generated mem_patterns. key is calculated based on input shapes.
-  // must be a node based container as a pointer is cached.
-  mutable NodeHashMap<int64_t, MemoryPatternGroup> mem_patterns_;
-  // This is mutable under mutex in training scenarios so execution frame would make a copy
-  // of the value when created.
-#ifdef ENABLE_TRAINING
-  mutable NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
-#else
-  NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
-#endif
+  mutable InlinedHashMap<int64_t, MemoryPatternCacheSlot> mem_patterns_;
+  // keys of mem_patterns_ from most to least recently used
+  mutable std::list<int64_t> mem_patterns_lru_;
+  // maximum number of cached patterns. 0 means unbounded.
+  size_t mem_pattern_cache_capacity_ = 0;
+
+  // round dynamic input dims up to a power of two when computing memory pattern keys
+  bool mem_pattern_bucketing_ = false;
+  // per feed OrtValue index, which dims of the input are bucketed. inputs not in the map are not bucketed.
+  InlinedHashMap<int, InlinedVector<bool>> mem_pattern_bucketed_dims_;
+
+  // memory patterns loaded from the static memory plan of an ORT format model, and the dims of each graph input
+  // (keyed by OrtValue index) they were computed for. const after LoadStaticMemoryPlanFromOrtFormat.
+  std::shared_ptr<const MemoryPatternCacheEntry> static_memory_plan_;
+  InlinedHashMap<int, TensorShapeVector> static_memory_plan_input_dims_;
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -509,6 +643,17 @@ class SessionState {
 
   const SessionOptions& sess_options_;
 
+  IExecutionProvider* graph_segment_capture_ep_ = nullptr;
+  std::unique_ptr<GraphSegmentCapture> graph_segment_capture_;
+
+  IExecutionProvider* weight_streaming_ep_ = nullptr;
+  size_t weight_streaming_budget_ = 0;
+  std::unique_ptr<WeightStreamer> weight_streamer_;
+
+  std::unique_ptr<LeanExecutionPlan> lean_execution_plan_;
+
+  bool coalesce_feed_copies_ = false;
+
   std::optional<NodeIndexInfo> node_index_info_;
 
   // Container to store pre-packed weights to share between sessions.
@@ -547,6 +692,10 @@ class SessionState {
   // a constant initialized weight was used by the session state
   size_t used_shared_pre_packed_weights_counter_ = 0;
 
+  // Counter for number of times a pre-packed weight from the pre-packed weights file was used instead of
+  // calling PrePack
+  size_t used_persisted_pre_packed_weights_counter_ = 0;
+
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
   // Counter for number of times the session graph has been executed
   size_t graph_executions_counter_ = 0;
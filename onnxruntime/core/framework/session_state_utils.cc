@@ -1,9 +1,16 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <functional>
+#include <iomanip>
 #include <limits>
+#include <optional>
+#include <sstream>
 #include <utility>
+#include <vector>
 
 #include <core/common/status.h>
 
@@ -11,6 +18,7 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/framework/session_state_utils.h"
 #include "core/common/common.h"
+#include "core/common/parse_string.h"
 #include "core/common/logging/logging.h"
 #include "core/graph/graph_viewer.h"
 #include "core/framework/data_transfer_manager.h"
@@ -19,13 +27,16 @@
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/ort_value_name_idx_map.h"
 #include "core/framework/sequential_execution_plan.h"
+#include "core/framework/stream_handles.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
 #include "core/framework/bfc_arena.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/framework/mem_buffer.h"
+#include "core/framework/murmurhash3.h"
 #include "core/framework/tensor_allocator.h"
+#include "core/platform/threadpool.h"
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 #include "core/framework/memory_info.h"
 #endif
@@ -93,11 +104,207 @@ static inline common::Status ExtDataTensorProtoToTensor(const Env& env,
   return common::Status::OK();
 }
 
+#ifdef ORT_ENABLE_STREAM
+// reads the chunks into a ring of pinned staging buffers and copies them to dst asynchronously on stream, so
+// reading a chunk from the file overlaps the copies of the previous ones
+static common::Status StreamExternalDataInChunks(const Env& env, const std::basic_string<ORTCHAR_T>& file_path,
+                                                 FileOffsetType offset, size_t length, size_t chunk_size,
+                                                 const DataTransferManager& data_transfer_mgr,
+                                                 const AllocatorPtr& pinned_alloc, Stream& stream,
+                                                 const WaitNotificationFn& wait_fn, Tensor& dst) {
+  constexpr size_t kNumStagingBuffers = 2;
+  struct StagingBuffer {
+    IAllocatorUniquePtr<char> data;
+    // set while a copy from the buffer may be in flight
+    std::unique_ptr<synchronize::Notification> copied;
+  };
+  std::array<StagingBuffer, kNumStagingBuffers> ring;
+  for (auto& buffer : ring) {
+    buffer.data = IAllocator::MakeUniquePtr<char>(pinned_alloc, chunk_size);
+  }
+  const auto wait = [&stream, &wait_fn](StagingBuffer& buffer) {
+    if (buffer.copied) {
+      wait_fn(stream, *buffer.copied);
+      buffer.copied.reset();
+    }
+  };
+
+  const auto* const byte_type = DataTypeImpl::GetType<uint8_t>();
+  Status status;
+  for (size_t chunk = 0, done = 0; done < length; ++chunk) {
+    auto& buffer = ring[chunk % kNumStagingBuffers];
+    wait(buffer);
+
+    const size_t len = std::min(chunk_size, length - done);
+    status = env.ReadFileIntoBuffer(file_path.c_str(), offset + static_cast<FileOffsetType>(done), len,
+                                    gsl::make_span(buffer.data.get(), len));
+    if (!status.IsOK()) {
+      break;
+    }
+
+    const TensorShape chunk_shape({static_cast<int64_t>(len)});
+    const Tensor src_chunk(byte_type, chunk_shape, buffer.data.get(), pinned_alloc->Info());
+    Tensor dst_chunk(byte_type, chunk_shape, static_cast<char*>(dst.MutableDataRaw()) + done, dst.Location());
+    status = data_transfer_mgr.CopyTensorAsync(src_chunk, dst_chunk, stream);
+    if (!status.IsOK()) {
+      break;
+    }
+    buffer.copied = stream.CreateNotification(1);
+    if (!buffer.copied) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The stream of ", dst.Location().ToString(),
+                               " does not support notifications");
+      break;
+    }
+    buffer.copied->ActivateAndUpdate();
+    done += len;
+  }
+
+  // the staging buffers must outlive the copies in flight, also when a read or a copy failed
+  stream.Flush();
+  for (auto& buffer : ring) {
+    wait(buffer);
+  }
+  return status;
+}
+#endif
+
+// copies length bytes at offset in the file to the start of the device tensor dst, reading at most chunk_size bytes
+// of the file into host memory at a time.
+// if the device has streams and a pinned memory allocator the chunks are streamed through pinned staging buffers,
+// otherwise each chunk is read into pageable memory and copied synchronously.
+static common::Status CopyExternalDataInChunks(const Env& env, const std::basic_string<ORTCHAR_T>& file_path,
+                                               FileOffsetType offset, size_t length, size_t chunk_size,
+                                               const DataTransferManager& data_transfer_mgr,
+                                               const ExternalDataStaging& staging, Tensor& dst) {
+  ORT_RETURN_IF_NOT(length <= dst.SizeInBytes(), "External data of ", length, " bytes does not fit in a tensor of ",
+                    dst.SizeInBytes(), " bytes");
+  chunk_size = std::min(chunk_size, length);
+  if (chunk_size == 0) {
+    return Status::OK();
+  }
+
+#ifdef ORT_ENABLE_STREAM
+  if (staging.pinned_alloc != nullptr && staging.stream_handle_registry != nullptr) {
+    const OrtDevice& device = dst.Location().device;
+    auto create_stream_fn = staging.stream_handle_registry->GetCreateStreamFn(device.Type());
+    auto wait_fn = staging.stream_handle_registry->GetWaitHandle(device.Type(), OrtDevice::CPU);
+    if (create_stream_fn && wait_fn) {
+      std::unique_ptr<Stream> stream = create_stream_fn(device);
+      if (stream) {
+        return StreamExternalDataInChunks(env, file_path, offset, length, chunk_size, data_transfer_mgr,
+                                          staging.pinned_alloc, *stream, wait_fn, dst);
+      }
+    }
+  }
+#else
+  ORT_UNUSED_PARAMETER(staging);
+#endif
+
+  // the staging buffer is not taken from the CPU allocator so a large chunk doesn't grow the arena for good
+  auto staging_buffer = std::make_unique<char[]>(chunk_size);
+  const OrtMemoryInfo cpu_location(CPU, OrtAllocatorType::OrtDeviceAllocator);
+  const auto* const byte_type = DataTypeImpl::GetType<uint8_t>();
+
+  for (size_t done = 0; done < length;) {
+    const size_t len = std::min(chunk_size, length - done);
+    ORT_RETURN_IF_ERROR(env.ReadFileIntoBuffer(file_path.c_str(), offset + static_cast<FileOffsetType>(done), len,
+                                               gsl::make_span(staging_buffer.get(), len)));
+
+    const TensorShape chunk_shape({static_cast<int64_t>(len)});
+    const Tensor src_chunk(byte_type, chunk_shape, staging_buffer.get(), cpu_location);
+    Tensor dst_chunk(byte_type, chunk_shape, static_cast<char*>(dst.MutableDataRaw()) + done, dst.Location());
+    Status copy_status = data_transfer_mgr.CopyTensor(src_chunk, dst_chunk);
+    if (!copy_status.IsOK()) {
+      if (copy_status.ErrorMessage().empty()) {
+        return Status(copy_status.Category(), copy_status.Code(),
+                      "Failed to copy tensor to " + dst.Location().ToString());
+      }
+      return copy_status;
+    }
+    done += len;
+  }
+
+  return Status::OK();
+}
+
+// smallest initializer that is worth a shared memory segment, as each segment takes at least a page
+static constexpr size_t kMinSizeOfInitializerSharedAcrossProcesses = 4096;
+
+// whether the CPU initializer stored in the model is unpacked into shared memory, see
+// kOrtSessionOptionsShareInitializersAcrossProcesses
+static bool IsInitializerSharedAcrossProcesses(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                               const OrtDevice& location, const AllocatorPtr& default_cpu_alloc) {
+  if (utils::HasExternalData(tensor_proto) ||
+      tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING ||
+      location != default_cpu_alloc->Info().device) {
+    return false;
+  }
+  size_t size = 0;
+  return utils::GetSizeInBytesFromTensorProto<0>(tensor_proto, &size).IsOK() &&
+         size >= kMinSizeOfInitializerSharedAcrossProcesses;
+}
+
+// unpacks the initializer into a named shared memory segment, or maps the segment another process already filled
+static common::Status ShareInitializerAcrossProcesses(const Env& env,
+                                                      const std::basic_string<PATH_CHAR_TYPE>& proto_path,
+                                                      const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                                      OrtValue& ort_value) {
+  TensorShape tensor_shape = utils::GetTensorShapeFromTensorProto(tensor_proto);
+  const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+
+  // the segment is named after the unpacked data, so the data is unpacked even if the segment exists.
+  // a non-arena allocator returns the memory of the temporary tensor right away.
+  Tensor unpacked(type, tensor_shape, std::make_shared<CPUAllocator>());
+  ORT_RETURN_IF_ERROR(utils::TensorProtoToTensor(env, proto_path.c_str(), tensor_proto, unpacked));
+
+  uint32_t hash[4] = {0, 0, 0, 0};
+  const auto hash_bytes = [&hash](const void* data, size_t size) {
+    // MurmurHash3 takes an int length
+    constexpr size_t kChunk = size_t{1} << 30;
+    const char* p = static_cast<const char*>(data);
+    do {
+      const size_t len = std::min(size, kChunk);
+      MurmurHash3::x86_128(p, static_cast<int>(len), hash[0], &hash);
+      p += len;
+      size -= len;
+    } while (size > 0);
+  };
+  const int32_t data_type = tensor_proto.data_type();
+  hash_bytes(&data_type, sizeof(data_type));
+  const auto dims = tensor_shape.GetDims();
+  hash_bytes(dims.data(), dims.size_bytes());
+  hash_bytes(unpacked.DataRaw(), unpacked.SizeInBytes());
+
+  std::ostringstream name;
+  name << "ort_" << std::hex << std::setfill('0');
+  for (uint32_t h : hash) {
+    name << std::setw(8) << h;
+  }
+  name << "_" << std::dec << unpacked.SizeInBytes();
+
+  Env::MappedMemoryPtr mapping;
+  ORT_RETURN_IF_ERROR(env.MapSharedMemory(name.str(), unpacked.SizeInBytes(),
+                                          [&unpacked](gsl::span<char> data) {
+                                            std::memcpy(data.data(), unpacked.DataRaw(), data.size());
+                                          },
+                                          mapping));
+
+  // the OrtValue owns the mapping through the deleter, like a tensor with memory mapped external data
+  auto mapping_deleter = mapping.get_deleter();
+  auto p_tensor = std::make_unique<Tensor>(type, tensor_shape, mapping.release(),
+                                           OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator));
+  ExtDataValueDeleter deleter{mapping_deleter.callback, p_tensor.get()};
+  ort_value.Init(p_tensor.release(), DataTypeImpl::GetType<Tensor>(), deleter);
+  return common::Status::OK();
+}
+
 static common::Status DeserializeTensorProto(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& proto_path,
                                              const ONNX_NAMESPACE::TensorProto& tensor_proto, const MemBuffer* m,
                                              const AllocatorPtr& alloc, const AllocatorPtr& default_cpu_alloc,
                                              OrtValue& ort_value, const DataTransferManager& data_transfer_mgr,
-                                             bool use_device_allocator_for_initializers = false) {
+                                             bool use_device_allocator_for_initializers = false,
+                                             size_t external_data_copy_chunk_size = 0,
+                                             const ExternalDataStaging& external_data_staging = {}) {
   if (bool(alloc) == (m != nullptr)) {
     return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
                   "DeserializeTensorProto() takes either pre-allocated buffer or an allocator!");
@@ -147,6 +354,22 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "string tensor is not supported for copying between allocators");
     }
 
+    if (external_data_copy_chunk_size > 0 && utils::HasExternalData(tensor_proto)) {
+      std::basic_string<ORTCHAR_T> external_file_path;
+      FileOffsetType file_offset;
+      SafeInt<size_t> ext_data_len = 0;
+      ORT_RETURN_IF_ERROR(utils::GetExternalDataLocation(env, proto_path.c_str(), tensor_proto, external_file_path,
+                                                         file_offset, ext_data_len));
+      if (external_file_path != utils::kTensorProtoMemoryAddressTag) {
+        ORT_RETURN_IF_ERROR(CopyExternalDataInChunks(env, external_file_path, file_offset, ext_data_len,
+                                                     external_data_copy_chunk_size, data_transfer_mgr,
+                                                     external_data_staging, *p_tensor));
+        auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+        ort_value.Init(p_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+        return common::Status::OK();
+      }
+    }
+
     // deserialize to CPU first for non-CPU allocator, then copy
     std::unique_ptr<Tensor> p_deserialize_tensor;
     if (use_device_allocator_for_initializers) {
@@ -197,7 +420,9 @@ common::Status SaveInitializedTensors(
     const logging::Logger& logger, const DataTransferManager& data_transfer_mgr,
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
-    const MemoryProfileFunction& memory_profile_func) {
+    const MemoryProfileFunction& memory_profile_func,
+    concurrency::ThreadPool* thread_pool,
+    const ExternalDataStaging& external_data_staging) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -230,6 +455,14 @@ common::Status SaveInitializedTensors(
     return retval;
   };
 
+  // initializers unpacked into shared memory get no planned buffer
+  const bool share_initializers_across_processes =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsShareInitializersAcrossProcesses, "0") == "1";
+  const auto is_shared_across_processes = [&](int ort_value_index, const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+    return share_initializers_across_processes &&
+           IsInitializerSharedAcrossProcesses(tensor_proto, exec_plan.GetLocation(ort_value_index), default_cpu_alloc);
+  };
+
   // 1. first plan the memory
   const InitializedTensorSet& initialized_tensor_set = graph.GetAllInitializedTensors();
   InlinedHashMap<int, const ONNX_NAMESPACE::TensorProto*> id_to_initialized_tensor;
@@ -256,7 +489,8 @@ common::Status SaveInitializedTensors(
     const auto entry = initialized_tensors_to_allocate.find(ort_value_index);
     ORT_ENFORCE(entry != initialized_tensors_to_allocate.end(),
                 "OrtValue index: ", ort_value_index, " from initializer_allocation_order not found among initialized tensors");
-    if (!(utils::HasExternalData(*entry->second) && exec_plan.GetLocation(ort_value_index).Type() == OrtDevice::CPU)) {
+    if (!(utils::HasExternalData(*entry->second) && exec_plan.GetLocation(ort_value_index).Type() == OrtDevice::CPU) &&
+        !is_shared_across_processes(ort_value_index, *entry->second)) {
       // can not trace string tensor
       ORT_ENFORCE(entry->second->data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING, "Can not trace string tensor");
       ORT_RETURN_IF_ERROR(planner.Trace(entry->first, entry->second));
@@ -273,6 +507,9 @@ common::Status SaveInitializedTensors(
       // do not trace string tensor
       continue;
     }
+    if (is_shared_across_processes(entry.first, *entry.second)) {
+      continue;
+    }
     ORT_RETURN_IF_ERROR(planner.Trace(entry.first, entry.second));
   }
   // 2. allocate weight buffer on different locations
@@ -292,7 +529,26 @@ common::Status SaveInitializedTensors(
 
   OrtCallback deleter{nullptr, nullptr};
 
+  const auto chunk_size_config =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsExternalInitializerCopyChunkSize, "0");
+  size_t external_data_copy_chunk_size = 0;
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(chunk_size_config, external_data_copy_chunk_size),
+                    "Invalid value for ", kOrtSessionOptionsExternalInitializerCopyChunkSize, ": ", chunk_size_config);
+  const bool parallel_initialization =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsParallelInitialization, "0") == "1";
+
   // 3. create weight tensors based on weights buffer
+  struct InitializerToSave {
+    int ort_value_index;
+    const ONNX_NAMESPACE::TensorProto* tensor_proto;
+    std::optional<MemBuffer> m;
+    AllocatorPtr alloc;
+    OrtValue ort_value;
+    bool deserialize;
+    bool shared_across_processes;
+  };
+  std::vector<InitializerToSave> initializers;
+  initializers.reserve(id_to_initialized_tensor.size());
   for (const auto& entry : id_to_initialized_tensor) {
     int ort_value_index = entry.first;
     const std::string& name = entry.second->name();
@@ -302,30 +558,89 @@ common::Status SaveInitializedTensors(
       continue;
     }
 
-    OrtValue ort_value;
-
+    auto& initializer = initializers.emplace_back(InitializerToSave{ort_value_index, entry.second, {}, {}, {}, false, false});
     if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
-      ort_value = *(session_options.initializers_to_share_map.at(name));
+      initializer.ort_value = *(session_options.initializers_to_share_map.at(name));
       LOGS(logger, INFO) << "Using user supplied initializer with name (" << name << ").";
+    } else if (is_shared_across_processes(ort_value_index, *entry.second)) {
+      initializer.alloc = default_cpu_alloc;
+      initializer.deserialize = true;
+      initializer.shared_across_processes = true;
     } else {
-      const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
-
-      std::optional<MemBuffer> m;
-      AllocatorPtr alloc;
       // TODO: if the tensor need be copied, does it have enough room?
-      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, m, alloc));
-      bool use_device_allocator_for_initializers =
-          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
-
-      Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, (m.has_value()) ? &*m : nullptr, alloc,
-                                         default_cpu_alloc, ort_value, data_transfer_mgr,
-                                         use_device_allocator_for_initializers);
-      if (!st.IsOK()) {
-        std::ostringstream oss;
-        oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
-        return Status(st.Category(), st.Code(), oss.str());
+      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, initializer.m, initializer.alloc));
+      initializer.deserialize = true;
+    }
+  }
+
+  const bool use_device_allocator_for_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
+  const auto deserialize = [&](InitializerToSave& initializer) -> Status {
+    Status st;
+    if (initializer.shared_across_processes) {
+      ORT_TRY {
+        st = ShareInitializerAcrossProcesses(env, graph_loc, *initializer.tensor_proto, initializer.ort_value);
+      }
+      ORT_CATCH(const std::exception& ex) {
+        ORT_HANDLE_EXCEPTION([&]() {
+          st = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+        });
+      }
+      if (st.IsOK()) {
+        return Status::OK();
       }
+      // the session still works with a private copy
+      LOGS(logger, WARNING) << "Failed to share initializer " << initializer.tensor_proto->name()
+                            << " across processes: " << st.ErrorMessage();
+      st = Status::OK();
+    }
+    ORT_TRY {
+      st = DeserializeTensorProto(env, graph_loc, *initializer.tensor_proto,
+                                  (initializer.m.has_value()) ? &*initializer.m : nullptr, initializer.alloc,
+                                  default_cpu_alloc, initializer.ort_value, data_transfer_mgr,
+                                  use_device_allocator_for_initializers, external_data_copy_chunk_size,
+                                  external_data_staging);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        st = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
     }
+    if (!st.IsOK()) {
+      std::ostringstream oss;
+      oss << "Deserialize tensor " << initializer.tensor_proto->name() << " failed." << st.ErrorMessage();
+      return Status(st.Category(), st.Code(), oss.str());
+    }
+    return Status::OK();
+  };
+
+  // unpacking into CPU memory is independent for each initializer. copies to other devices stay on this thread
+  // as not every data transfer supports concurrent copies.
+  std::vector<Status> statuses(initializers.size());
+  InlinedVector<size_t> cpu_initializers;
+  for (size_t i = 0; i < initializers.size(); ++i) {
+    auto& initializer = initializers[i];
+    if (!initializer.deserialize) {
+      continue;
+    }
+    const OrtDevice& device = initializer.m.has_value() ? initializer.m->GetAllocInfo().device
+                                                        : initializer.alloc->Info().device;
+    if (parallel_initialization && device.Type() == OrtDevice::CPU) {
+      cpu_initializers.push_back(i);
+    } else {
+      statuses[i] = deserialize(initializer);
+    }
+  }
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(cpu_initializers.size()), [&](std::ptrdiff_t i) {
+        const size_t idx = cpu_initializers[static_cast<size_t>(i)];
+        statuses[idx] = deserialize(initializers[idx]);
+      });
+
+  for (size_t i = 0; i < initializers.size(); ++i) {
+    ORT_RETURN_IF_ERROR(statuses[i]);
+    const int ort_value_index = initializers[i].ort_value_index;
+    const std::string& name = initializers[i].tensor_proto->name();
 
     // 'name' is a reference to a string within the TensorProto that save_tensor_func may free
     // so we need to output this message prior to calling save_tensor_func
@@ -336,9 +651,9 @@ common::Status SaveInitializedTensors(
     const bool constant = graph.IsConstantInitializer(name, /* check_outer_scope */ false);
 #if !defined(DISABLE_SPARSE_TENSORS)
     const bool sparse = graph.GetGraph().IsSparseInitializer(name);
-    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, ort_value, deleter, constant, sparse));
+    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, initializers[i].ort_value, deleter, constant, sparse));
 #else
-    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, ort_value, deleter, constant, false));
+    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, initializers[i].ort_value, deleter, constant, false));
 #endif
   }
 
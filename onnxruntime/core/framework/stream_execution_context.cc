@@ -62,6 +62,12 @@ StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
   for (size_t i = 0; i < release_actions.size(); ++i) {
     release_plan_[i] = static_cast<int>(release_actions[i].ref_count);
   }
+  if (const auto* graph_segments = sess_state.GetGraphSegmentCapture(); graph_segments != nullptr) {
+    graph_segment_modes_.resize(graph_segments->NumSegments(), GraphSegmentCapture::Mode::kRegular);
+  }
+  if (const auto* weight_streamer = sess_state.GetWeightStreamer(); weight_streamer != nullptr) {
+    weight_streaming_state_ = std::make_unique<WeightStreamer::RunState>(*weight_streamer);
+  }
 }
 
 synchronize::Notification* StreamExecutionContext ::GetNotification(size_t idx) { return notifications_[idx].get(); }
@@ -114,6 +120,9 @@ StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
   for (size_t i = 0; i < release_actions.size(); ++i) {
     release_plan_[i] = static_cast<int>(release_actions[i].ref_count);
   }
+  if (const auto* graph_segments = sess_state.GetGraphSegmentCapture(); graph_segments != nullptr) {
+    graph_segment_modes_.resize(graph_segments->NumSegments(), GraphSegmentCapture::Mode::kRegular);
+  }
 }
 
 synchronize::Notification* StreamExecutionContext ::GetNotification(size_t /*idx*/) {
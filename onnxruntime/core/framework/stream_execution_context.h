@@ -4,6 +4,8 @@
 #include "core/common/logging/logging.h"
 #include "core/framework/device_stream_collection.h"
 #include "core/framework/execution_frame.h"
+#include "core/framework/graph_segment_capture.h"
+#include "core/framework/weight_streamer.h"
 #include "core/framework/ort_value.h"
 #include "core/framework/iexecutor.h"
 #include "core/framework/stream_handles.h"
@@ -116,6 +118,15 @@ class StreamExecutionContext {
   // Release the OrtValues after a step, based on the execution plan.
   void RecycleNodeInputs(onnxruntime::NodeIndex node_index);
 
+  // How this run executes each of the graph segments of the session, if it captures the kernels of an execution
+  // provider in segments.
+  std::vector<GraphSegmentCapture::Mode>& GetGraphSegmentModes() { return graph_segment_modes_; }
+
+#ifdef ORT_ENABLE_STREAM
+  // The device copies of the streamed initializers of this run, if the session streams them.
+  WeightStreamer::RunState* GetWeightStreamingState() { return weight_streaming_state_.get(); }
+#endif
+
 #ifdef ENABLE_TRAINING
   void SetOrtValueCache(OrtValueCachePtr cache) {
     cache_ = std::move(cache);
@@ -171,12 +182,17 @@ class StreamExecutionContext {
 #endif
   const bool single_thread_mode_;
 
+  std::vector<GraphSegmentCapture::Mode> graph_segment_modes_;
+
 #ifdef ORT_ENABLE_STREAM
   InlinedVector<std::unique_ptr<synchronize::Notification>> notifications_;
   // if it is nullptr, means current session doesn't have any EP using stream feature
   const DeviceStreamCollection* device_stream_map_;
 
   std::vector<CountDownBarrier> count_down_barriers_;
+
+  // released first, once the device completed the run
+  std::unique_ptr<WeightStreamer::RunState> weight_streaming_state_;
 #endif
 };
 
@@ -3,6 +3,7 @@
 
 #include "core/framework/tensor.h"
 
+#include <cstdlib>
 #include <utility>
 #include "core/common/safeint.h"
 #include "core/framework/data_types.h"
@@ -20,7 +21,8 @@ int64_t GetSizeFromStrides(const TensorShape& shape, gsl::span<const int64_t> st
       size = 0;
       break;
     }
-    size += strides[dim] * (shape[dim] - 1);
+    // a view that reverses a dimension (e.g. Slice with a negative step) has a negative stride.
+    size += std::abs(strides[dim]) * (shape[dim] - 1);
   }
   return size;
 }
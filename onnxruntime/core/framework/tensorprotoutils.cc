@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <algorithm>
+#include <cstring>
 #include <limits>
 
 #include "core/common/gsl.h"
@@ -177,6 +178,11 @@ Status ReadExternalDataForTensor(const ONNX_NAMESPACE::TensorProto& tensor_proto
       tensor_byte_size));
 
   unpacked_tensor.resize(tensor_byte_size);
+  if (external_file_path == onnxruntime::utils::kTensorProtoMemoryAddressTag) {
+    // the value in offset is the memory address of the data
+    std::memcpy(unpacked_tensor.data(), reinterpret_cast<const void*>(file_offset), tensor_byte_size);
+    return Status::OK();
+  }
   ORT_RETURN_IF_ERROR(onnxruntime::Env::Default().ReadFileIntoBuffer(
       external_file_path.c_str(),
       file_offset,
@@ -798,41 +804,74 @@ static Status GetFileContent(
   return Status::OK();
 }
 
-Status GetExtDataFromTensorProto(const Env& env, const ORTCHAR_T* model_path,
-                                 const ONNX_NAMESPACE::TensorProto& tensor_proto,
-                                 void*& ext_data_buf, SafeInt<size_t>& ext_data_len, OrtCallback& ext_data_deleter) {
+void SetExternalDataInMemory(ONNX_NAMESPACE::TensorProto& tensor_proto, const void* data, size_t length) {
+  static_assert(sizeof(void*) <= sizeof(ExternalDataInfo::OFFSET_TYPE));
+  // we reinterpret_cast this back to void* in GetExtDataFromTensorProto.
+  // use intptr_t as OFFSET_TYPE is signed. in theory you could get a weird looking value if the address uses the
+  // high bit, but that should be unlikely in a scenario where we care about memory usage enough to use this path.
+  const auto offset = narrow<ExternalDataInfo::OFFSET_TYPE>(reinterpret_cast<intptr_t>(data));
+
+  tensor_proto.clear_raw_data();
+  tensor_proto.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL);
+  ONNX_NAMESPACE::StringStringEntryProto* entry = tensor_proto.mutable_external_data()->Add();
+  entry->set_key("location");
+  entry->set_value(ToUTF8String(kTensorProtoMemoryAddressTag));
+  entry = tensor_proto.mutable_external_data()->Add();
+  entry->set_key("offset");
+  entry->set_value(std::to_string(offset));
+  entry = tensor_proto.mutable_external_data()->Add();
+  entry->set_key("length");
+  entry->set_value(std::to_string(length));
+}
+
+Status GetExternalDataLocation(const Env& env, const ORTCHAR_T* model_path,
+                               const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                               std::basic_string<ORTCHAR_T>& external_file_path, FileOffsetType& file_offset,
+                               SafeInt<size_t>& ext_data_len) {
   ORT_ENFORCE(utils::HasExternalData(tensor_proto));
   std::basic_string<ORTCHAR_T> tensor_proto_dir;
   if (model_path != nullptr) {
     ORT_RETURN_IF_ERROR(GetDirNameFromFilePath(model_path, tensor_proto_dir));
   }
   const ORTCHAR_T* t_prot_dir_s = tensor_proto_dir.size() == 0 ? nullptr : tensor_proto_dir.c_str();
-  std::basic_string<ORTCHAR_T> external_data_file_path;
-  FileOffsetType file_offset;
-  SafeInt<size_t> raw_data_safe_len = 0;
-  ORT_RETURN_IF_ERROR(GetExternalDataInfo(tensor_proto, t_prot_dir_s, external_data_file_path, file_offset,
-                                          raw_data_safe_len));
+  ORT_RETURN_IF_ERROR(GetExternalDataInfo(tensor_proto, t_prot_dir_s, external_file_path, file_offset,
+                                          ext_data_len));
 
-  if (external_data_file_path == onnxruntime::utils::kTensorProtoMemoryAddressTag) {
-    // the value in location is the memory address of the data
-    ext_data_buf = reinterpret_cast<void*>(file_offset);
-    ext_data_len = raw_data_safe_len;
-    ext_data_deleter = OrtCallback{nullptr, nullptr};
-  } else {
+  if (external_file_path != onnxruntime::utils::kTensorProtoMemoryAddressTag) {
     size_t file_length;
     // error reporting is inconsistent across platforms. Make sure the full path we attempted to open is included.
-    auto status = env.GetFileLength(external_data_file_path.c_str(), file_length);
+    auto status = env.GetFileLength(external_file_path.c_str(), file_length);
     if (!status.IsOK()) {
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "GetFileLength for ", ToUTF8String(external_data_file_path),
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "GetFileLength for ", ToUTF8String(external_file_path),
                              " failed:", status.ErrorMessage());
     }
 
     SafeInt<FileOffsetType> end_of_read(file_offset);
-    end_of_read += raw_data_safe_len;
+    end_of_read += ext_data_len;
     ORT_RETURN_IF(file_offset < 0 || end_of_read > narrow<FileOffsetType>(file_length),
                   "External initializer: ", tensor_proto.name(),
-                  " offset: ", file_offset, " size to read: ", static_cast<size_t>(raw_data_safe_len),
+                  " offset: ", file_offset, " size to read: ", static_cast<size_t>(ext_data_len),
                   " given file_length: ", file_length, " are out of bounds or can not be read in full.");
+  }
+
+  return Status::OK();
+}
+
+Status GetExtDataFromTensorProto(const Env& env, const ORTCHAR_T* model_path,
+                                 const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                 void*& ext_data_buf, SafeInt<size_t>& ext_data_len, OrtCallback& ext_data_deleter) {
+  std::basic_string<ORTCHAR_T> external_data_file_path;
+  FileOffsetType file_offset;
+  SafeInt<size_t> raw_data_safe_len = 0;
+  ORT_RETURN_IF_ERROR(GetExternalDataLocation(env, model_path, tensor_proto, external_data_file_path, file_offset,
+                                              raw_data_safe_len));
+
+  if (external_data_file_path == onnxruntime::utils::kTensorProtoMemoryAddressTag) {
+    // the value in location is the memory address of the data
+    ext_data_buf = reinterpret_cast<void*>(file_offset);
+    ext_data_len = raw_data_safe_len;
+    ext_data_deleter = OrtCallback{nullptr, nullptr};
+  } else {
     ORT_RETURN_IF_ERROR(GetFileContent(env, external_data_file_path.c_str(), file_offset, raw_data_safe_len,
                                        ext_data_buf, ext_data_deleter));
     ext_data_len = raw_data_safe_len;
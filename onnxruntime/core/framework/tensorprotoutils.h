@@ -98,6 +98,18 @@ address of the memory containing the data.
 */
 constexpr const ORTCHAR_T* kTensorProtoMemoryAddressTag = ORT_TSTR("*/_ORT_MEM_ADDR_/*");
 
+// Sets the external data of tensor_proto to the length bytes at data, which must remain valid while tensor_proto
+// or any tensor created from it is used.
+void SetExternalDataInMemory(ONNX_NAMESPACE::TensorProto& tensor_proto, const void* data, size_t length);
+
+// Given a tensor proto with external data obtain the path of the file with the data, and the offset and length
+// of the data in the file. The range is checked to be within the file.
+// If the data is in memory external_file_path is kTensorProtoMemoryAddressTag and file_offset is its address.
+common::Status GetExternalDataLocation(const Env& env, const ORTCHAR_T* model_path,
+                                       const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                       std::basic_string<ORTCHAR_T>& external_file_path, FileOffsetType& file_offset,
+                                       SafeInt<size_t>& ext_data_len);
+
 // Given a tensor proto with external data obtain a pointer to the data and its length.
 // The ext_data_deleter argument is updated with a callback that owns/releases the data.
 common::Status GetExtDataFromTensorProto(const Env& env, const ORTCHAR_T* model_path,
@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/trace_span.h"
+
+#include <atomic>
+#include <random>
+
+namespace onnxruntime {
+namespace tracing {
+
+namespace {
+
+thread_local const TraceSpan* current_span = nullptr;
+
+// Span ids are unique within the process. 0 is reserved for the parent of the root spans.
+uint64_t NewSpanId() {
+  static std::atomic<uint64_t> next_id{(static_cast<uint64_t>(std::random_device{}()) << 32) | 1};
+  uint64_t id;
+  do {
+    id = next_id.fetch_add(1, std::memory_order_relaxed);
+  } while (id == 0);
+  return id;
+}
+
+int64_t ToUnixTimeNs(std::chrono::system_clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+}  // namespace
+
+TraceSpan::TraceSpan(OrtTraceSpanFunction sink, void* sink_param, std::string trace_context, std::string name,
+                     const char* kind)
+    : root_trace_{sink, sink_param, std::move(trace_context)},
+      trace_(&root_trace_),
+      id_(NewSpanId()),
+      parent_id_(0),
+      name_(std::move(name)),
+      kind_(kind),
+      provider_(nullptr),
+      start_(std::chrono::system_clock::now()) {}
+
+TraceSpan::TraceSpan(const TraceSpan& parent, std::string name, const char* kind, const char* provider)
+    : root_trace_{nullptr, nullptr, {}},
+      trace_(parent.trace_),
+      id_(NewSpanId()),
+      parent_id_(parent.id_),
+      name_(std::move(name)),
+      kind_(kind),
+      provider_(provider),
+      start_(std::chrono::system_clock::now()) {}
+
+TraceSpan::~TraceSpan() {
+  const auto end = std::chrono::system_clock::now();
+  trace_->sink(trace_->sink_param, trace_->context.c_str(), id_, parent_id_, name_.c_str(), kind_,
+               provider_ != nullptr ? provider_ : "", ToUnixTimeNs(start_), ToUnixTimeNs(end));
+}
+
+const TraceSpan* TraceSpan::Current() {
+  return current_span;
+}
+
+CurrentSpanScope::CurrentSpanScope(const TraceSpan* span) : previous_(current_span) {
+  current_span = span;
+}
+
+CurrentSpanScope::~CurrentSpanScope() {
+  current_span = previous_;
+}
+
+}  // namespace tracing
+}  // namespace onnxruntime
@@ -0,0 +1,71 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "core/common/common.h"
+#include "core/session/onnxruntime_c_api.h"
+
+namespace onnxruntime {
+namespace tracing {
+
+// A span of a traced Run, reported to the OrtTraceSpanFunction of the session when it ends.
+//
+// The Run span is the root, it carries the trace context the caller set in the RunOptions so the sink can attach the
+// spans to the distributed trace of the request. The spans of the subgraphs, compiled partitions and copies are its
+// descendants. The span being executed is tracked per thread, so the executors of subgraphs find their parent
+// without the span being passed through the kernels.
+class TraceSpan {
+ public:
+  // Starts the root span of a Run
+  TraceSpan(OrtTraceSpanFunction sink, void* sink_param, std::string trace_context, std::string name,
+            const char* kind);
+
+  // Starts a child of parent. parent must outlive the span.
+  TraceSpan(const TraceSpan& parent, std::string name, const char* kind, const char* provider = nullptr);
+
+  ~TraceSpan();
+
+  uint64_t Id() const { return id_; }
+
+  // The span executed on the calling thread, nullptr if the thread isn't executing a traced Run
+  static const TraceSpan* Current();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(TraceSpan);
+
+ private:
+  // Where the spans of a Run go, owned by its root span
+  struct Trace {
+    OrtTraceSpanFunction sink;
+    void* sink_param;
+    std::string context;
+  };
+
+  Trace root_trace_;
+  const Trace* trace_;
+  uint64_t id_;
+  uint64_t parent_id_;
+  std::string name_;
+  const char* kind_;
+  const char* provider_;
+  std::chrono::system_clock::time_point start_;
+};
+
+// Makes span the current span of the calling thread for the lifetime of the scope. span may be nullptr.
+class CurrentSpanScope {
+ public:
+  explicit CurrentSpanScope(const TraceSpan* span);
+  ~CurrentSpanScope();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CurrentSpanScope);
+
+ private:
+  const TraceSpan* previous_;
+};
+
+}  // namespace tracing
+}  // namespace onnxruntime
@@ -22,6 +22,7 @@
 #include "core/common/common.h"
 #ifndef SHARED_PROVIDER
 #include "core/common/logging/logging.h"
+#include "core/framework/kernel_dispatch.h"
 #endif
 #include "core/framework/execution_provider.h"
 #include "core/framework/stream_handles.h"
@@ -164,6 +165,11 @@ class TunableOp {
         mgr.Add(op_sig, params_sig, id);
       }
     }
+    if (IsRecordingKernelDispatch()) {
+      // the sub-ops have no name, the id is their index in the tuning results
+      const std::string choice = id < 0 ? MakeString("default:", default_id_) : std::to_string(id);
+      RecordKernelDispatch(Signature().c_str(), choice.c_str());
+    }
     ORT_RETURN_IF_ERROR(ops_[id < 0 ? default_id_ : id](params));
     return Status::OK();
   }
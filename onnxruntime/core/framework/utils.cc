@@ -3,6 +3,7 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/framework/utils.h"
 
+#include <cstring>
 #include <iomanip>
 
 #include "core/graph/graph_viewer.h"
@@ -104,6 +105,13 @@ static common::Status AllocateHelper(const AllocatorPtr& allocator,
                              p_data,
                              allocator, target_mlvalue);
       }
+    } else if (target_stream && allocator->IsStreamOrdered()) {
+      size_t len = Tensor::CalculateTensorStorageSize(source_tensor.DataType(), source_tensor.Shape());
+      void* p_data = allocator->StreamOrderedAlloc(len, target_stream);
+      Tensor::InitOrtValue(source_tensor.DataType(),
+                           source_tensor.Shape(),
+                           p_data,
+                           allocator, target_mlvalue);
     } else {
       Tensor::InitOrtValue(source_tensor.DataType(),
                            source_tensor.Shape(),
@@ -438,6 +446,126 @@ static void FinalizeFeedFetchCopyInfo(FeedsFetchesManager& feeds_fetches_manager
   FinalizeFeedFetchCopyInfo(feeds_fetches_manager, feed_locations, fetch_alloc_info);
 }
 
+// feeds of at most this size are coalesced, see kOrtSessionOptionsCoalesceFeedCopies
+static constexpr size_t kMaxSizeOfCoalescedFeed = 64 * 1024;
+
+namespace {
+// The allocator of the coalesced feeds, which are views of one device buffer. Each feed frees the start of the buffer
+// through it when released, and the buffer is freed once the last of them released the allocator.
+class CoalescedFeedsAllocator final : public IAllocator {
+ public:
+  CoalescedFeedsAllocator(AllocatorPtr allocator, void* buffer)
+      : IAllocator(allocator->Info()), allocator_(std::move(allocator)), buffer_(buffer) {}
+
+  ~CoalescedFeedsAllocator() override { allocator_->Free(buffer_); }
+
+  void* Alloc(size_t) override { ORT_THROW("The coalesced feeds are not allocated"); }
+
+  void Free(void*) override {}
+
+ private:
+  AllocatorPtr allocator_;
+  void* buffer_;
+};
+}  // namespace
+
+// Copies the CPU tensors of orig_feeds at indices to new_feeds through one staging buffer, which is added to
+// staging_buffers as it must outlive the copy, and a single transfer to one buffer the new feeds are views of.
+static common::Status CopyCoalescedFeeds(const SessionState& session_state,
+                                         gsl::span<const OrtValue> orig_feeds,
+                                         std::vector<OrtValue>& new_feeds,
+                                         gsl::span<const size_t> indices,
+                                         const AllocatorPtr& allocator,
+                                         Stream* stream,
+                                         std::vector<std::unique_ptr<uint8_t[]>>& staging_buffers) {
+  InlinedVector<size_t> offsets;
+  offsets.reserve(indices.size());
+  size_t total = 0;
+  for (const auto idx : indices) {
+    offsets.push_back(total);
+    total += (orig_feeds[idx].Get<Tensor>().SizeInBytes() + kAllocAlignment - 1) / kAllocAlignment * kAllocAlignment;
+  }
+
+  void* buffer = allocator->Alloc(total);
+  ORT_RETURN_IF(buffer == nullptr, "Failed to allocate ", total, " bytes for the coalesced feeds");
+  auto feeds_allocator = std::make_shared<CoalescedFeedsAllocator>(allocator, buffer);
+
+  auto staging = std::make_unique<uint8_t[]>(total);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    const auto& source_tensor = orig_feeds[indices[i]].Get<Tensor>();
+    std::memcpy(staging.get() + offsets[i], source_tensor.DataRaw(), source_tensor.SizeInBytes());
+    Tensor::InitOrtValue(source_tensor.DataType(), source_tensor.Shape(), buffer, feeds_allocator,
+                         new_feeds[indices[i]], static_cast<ptrdiff_t>(offsets[i]));
+  }
+
+  const auto* const byte_type = DataTypeImpl::GetType<uint8_t>();
+  const TensorShape buffer_shape({static_cast<int64_t>(total)});
+  const Tensor source_buffer(byte_type, buffer_shape, staging.get(),
+                             OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator));
+  Tensor target_buffer(byte_type, buffer_shape, buffer, allocator->Info());
+  staging_buffers.push_back(std::move(staging));
+
+  const auto& data_transfer_mgr = session_state.GetDataTransferMgr();
+  return stream ? data_transfer_mgr.CopyTensorAsync(source_buffer, target_buffer, *stream)
+                : data_transfer_mgr.CopyTensor(source_buffer, target_buffer);
+}
+
+// Copies the small CPU tensor feeds that go to the same device on the same stream with CopyCoalescedFeeds when there
+// are several of them, and sets coalesced for them.
+static common::Status CoalesceFeedCopies(const SessionState& session_state,
+                                         gsl::span<const OrtValue> orig_feeds,
+                                         std::vector<OrtValue>& new_feeds,
+                                         gsl::span<const MLValueCopyInfo> copy_info,
+                                         gsl::span<Stream* const> feed_streams,
+                                         InlinedVector<bool>& coalesced,
+                                         std::vector<std::unique_ptr<uint8_t[]>>& staging_buffers) {
+  struct FeedGroup {
+    OrtDevice target_device;
+    Stream* stream;
+    InlinedVector<size_t> indices;
+  };
+  InlinedVector<FeedGroup, 1> groups;
+
+  for (size_t idx = 0; idx < orig_feeds.size(); ++idx) {
+    const auto& info = copy_info[idx];
+    if (info.source_device.Type() != OrtDevice::CPU || info.source_device == info.target_device ||
+        !orig_feeds[idx].IsTensor()) {
+      continue;
+    }
+    const auto& tensor = orig_feeds[idx].Get<Tensor>();
+    if (tensor.IsDataTypeString() || tensor.SizeInBytes() == 0 || tensor.SizeInBytes() > kMaxSizeOfCoalescedFeed) {
+      continue;
+    }
+
+    auto group = std::find_if(groups.begin(), groups.end(), [&](const FeedGroup& g) {
+      return g.target_device == info.target_device && g.stream == feed_streams[idx];
+    });
+    if (group == groups.end()) {
+      groups.push_back(FeedGroup{info.target_device, feed_streams[idx], {}});
+      group = groups.end() - 1;
+    }
+    group->indices.push_back(idx);
+  }
+
+  for (const auto& group : groups) {
+    if (group.indices.size() < 2) {
+      continue;
+    }
+    auto allocator = session_state.GetAllocator(group.target_device);
+    if (allocator == nullptr || allocator->IsStreamOrdered()) {
+      continue;
+    }
+
+    ORT_RETURN_IF_ERROR(CopyCoalescedFeeds(session_state, orig_feeds, new_feeds, group.indices, allocator,
+                                           group.stream, staging_buffers));
+    for (const auto idx : group.indices) {
+      coalesced[idx] = true;
+    }
+  }
+
+  return Status::OK();
+}
+
 static common::Status CopyInputsAcrossDevices(const SessionState& session_state,
                                               gsl::span<const OrtValue> orig_feeds,
                                               std::vector<OrtValue>& new_feeds,
@@ -453,7 +581,18 @@ static common::Status CopyInputsAcrossDevices(const SessionState& session_state,
   std::vector<IDataTransfer::SparseSrcDstPair> batched_sparse_data_transfers;
 #endif
 
+  InlinedVector<bool> coalesced(num_feeds, false);
+  // read by the copies until the streams are flushed below
+  std::vector<std::unique_ptr<uint8_t[]>> staging_buffers;
+  if (session_state.CoalesceFeedCopies()) {
+    ORT_RETURN_IF_ERROR(CoalesceFeedCopies(session_state, orig_feeds, new_feeds, copy_info, feed_streams, coalesced,
+                                           staging_buffers));
+  }
+
   for (size_t idx = 0; idx < num_feeds; ++idx) {
+    if (coalesced[idx]) {
+      continue;
+    }
 #if !defined(DISABLE_SPARSE_TENSORS)
     ORT_RETURN_IF_ERROR(BatchOrCopyMLValue(session_state, copy_info[idx], orig_feeds[idx], new_feeds[idx],
                                            feed_streams[idx],
@@ -737,21 +876,25 @@ common::Status ExecuteGraph(const SessionState& session_state,
                             DeviceStreamCollectionHolder& device_stream_collection_holder,
 #endif
                             bool only_execute_path_to_fetches,
-                            Stream* parent_stream) {
+                            Stream* parent_stream,
+                            const std::unordered_map<size_t, IExecutor::CustomAllocator>* fetch_allocators) {
   ORT_RETURN_IF_ERROR(utils::InitializeFeedFetchCopyInfo(session_state, feeds_fetches_manager));
 
   // finalize the copy info using the provided feeds and fetches. will update device_copy_checks in the background
   FinalizeFeedFetchCopyInfo(feeds_fetches_manager, feeds, fetches);
+
+  static const std::unordered_map<size_t, IExecutor::CustomAllocator> no_fetch_allocators;
+  const auto& fetch_allocators_to_use = fetch_allocators ? *fetch_allocators : no_fetch_allocators;
 #ifdef ORT_ENABLE_STREAM
   DeviceStreamCollection* device_stream_collection = device_stream_collection_holder.p_.get();
-  auto retval = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, {},
+  auto retval = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators_to_use,
                                  execution_mode, terminate_flag, logger,
                                  device_stream_collection,
                                  only_execute_path_to_fetches,
                                  parent_stream);
   return retval;
 #else
-  return ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, {},
+  return ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators_to_use,
                           execution_mode, terminate_flag, logger,
                           only_execute_path_to_fetches,
                           parent_stream);
@@ -765,7 +908,8 @@ common::Status ExecuteGraph(const SessionState& session_state,
 #ifdef ORT_ENABLE_STREAM
                             DeviceStreamCollectionHolder& device_stream_collection_holder,
 #endif
-                            const logging::Logger& logger) {
+                            const logging::Logger& logger,
+                            const std::unordered_map<size_t, IExecutor::CustomAllocator>* fetch_allocators) {
   return ExecuteGraph(session_state,
                       feeds_fetches_manager,
                       feeds, fetches,
@@ -775,7 +919,9 @@ common::Status ExecuteGraph(const SessionState& session_state,
 #ifdef ORT_ENABLE_STREAM
                       device_stream_collection_holder,
 #endif
-                      run_options.only_execute_path_to_fetches);
+                      run_options.only_execute_path_to_fetches,
+                      nullptr,
+                      fetch_allocators);
 }
 
 #ifdef ENABLE_TRAINING
@@ -919,15 +1065,45 @@ common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFet
                                ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger,
                                Stream* parent_stream,
                                bool sync_subgraph_fetches) {
+  SubgraphExecutionState state(session_state);
+  return ExecuteSubgraph(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators, execution_mode,
+                         terminate_flag, logger, parent_stream, state, sync_subgraph_fetches);
+}
+
+SubgraphExecutionState::SubgraphExecutionState(const SessionState& session_state)
 #ifdef ORT_ENABLE_STREAM
-  DeviceStreamCollectionHolder device_stream_collection_holder(&session_state);
-  DeviceStreamCollection* device_stream_collection = device_stream_collection_holder.p_.get();
+    : device_stream_collection_holder_(&session_state)
+#endif
+{
+#ifndef ORT_ENABLE_STREAM
+  ORT_UNUSED_PARAMETER(session_state);
+#endif
+}
 
+SubgraphExecutionState::~SubgraphExecutionState() {
+#ifdef ORT_ENABLE_STREAM
+  if (auto* device_stream_collection = GetDeviceStreamCollection()) {
+    // releases the buffers the streams hold on to, which they kept for reuse by the next execution
+    Status status = device_stream_collection->CleanUp(false);
+    if (!status.IsOK()) {
+      LOGS_DEFAULT(WARNING) << "Failed to clean up the device streams of a subgraph: " << status.ErrorMessage();
+    }
+  }
+#endif
+}
+
+common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFetchesManager& feeds_fetches_manager,
+                               gsl::span<const OrtValue> feeds, std::vector<OrtValue>& fetches,
+                               const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
+                               ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger,
+                               Stream* parent_stream, SubgraphExecutionState& state,
+                               bool sync_subgraph_fetches) {
+#ifdef ORT_ENABLE_STREAM
   auto retval = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
-                                 execution_mode, terminate_flag, logger, device_stream_collection, false, parent_stream);
-  if (device_stream_collection)
-    ORT_CHECK_AND_SET_RETVAL(device_stream_collection->CleanUp(false));
+                                 execution_mode, terminate_flag, logger, state.GetDeviceStreamCollection(), false,
+                                 parent_stream);
 #else
+  ORT_UNUSED_PARAMETER(state);
   auto retval = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
                                  execution_mode, terminate_flag, logger, false, parent_stream);
 #endif
@@ -88,7 +88,8 @@ common::Status ExecuteGraph(const SessionState& session_state, FeedsFetchesManag
                             DeviceStreamCollectionHolder& device_stream_collection_holder,
 #endif
                             bool only_execute_path_to_fetches = false,
-                            Stream* parent_stream = nullptr);
+                            Stream* parent_stream = nullptr,
+                            const std::unordered_map<size_t, IExecutor::CustomAllocator>* fetch_allocators = nullptr);
 
 common::Status ExecuteGraph(const SessionState& session_state, FeedsFetchesManager& feeds_fetches_manager,
                             gsl::span<const OrtValue> feeds, std::vector<OrtValue>& fetches,
@@ -96,7 +97,8 @@ common::Status ExecuteGraph(const SessionState& session_state, FeedsFetchesManag
 #ifdef ORT_ENABLE_STREAM
                             DeviceStreamCollectionHolder& device_stream_collection_holder,
 #endif
-                            const logging::Logger& logger);
+                            const logging::Logger& logger,
+                            const std::unordered_map<size_t, IExecutor::CustomAllocator>* fetch_allocators = nullptr);
 
 #ifdef ENABLE_TRAINING
 common::Status ExecutePartialGraph(const SessionState& session_state, FeedsFetchesManager& feeds_fetches_manager,
@@ -120,6 +122,34 @@ common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFet
                                subgraph fetches, i.e. the loop condition*/
                                bool sync_subgraph_fetches = false);
 
+// State kept across the executions of a subgraph by one invocation of a control flow kernel, e.g. the iterations
+// of Loop and Scan. The device streams of the subgraph are acquired from its session state once, on construction,
+// instead of for every iteration, and are cleaned up and returned when the state is destroyed.
+class SubgraphExecutionState {
+ public:
+  explicit SubgraphExecutionState(const SessionState& session_state);
+  ~SubgraphExecutionState();
+
+#ifdef ORT_ENABLE_STREAM
+  DeviceStreamCollection* GetDeviceStreamCollection() const { return device_stream_collection_holder_.p_.get(); }
+#endif
+
+ private:
+#ifdef ORT_ENABLE_STREAM
+  DeviceStreamCollectionHolder device_stream_collection_holder_;
+#endif
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SubgraphExecutionState);
+};
+
+// Execute a subgraph as above, reusing `state` from the previous executions of the same subgraph.
+common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFetchesManager& feeds_fetches_manager,
+                               gsl::span<const OrtValue> feeds, std::vector<OrtValue>& fetches,
+                               const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
+                               ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger,
+                               Stream* parent_stream, SubgraphExecutionState& state,
+                               bool sync_subgraph_fetches = false);
+
 bool IsInputOnCpu(const Node& node, const KernelCreateInfo* p_kci, size_t index);
 bool IsOutputOnCpu(const Node& node, const KernelCreateInfo* p_kci, size_t index);
 
@@ -0,0 +1,290 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/weight_streamer.h"
+
+#include <algorithm>
+#include <string_view>
+
+#include "core/framework/execution_frame.h"
+#include "core/framework/execution_provider.h"
+#include "core/framework/sequential_execution_plan.h"
+#include "core/framework/session_state.h"
+#include "core/framework/stream_execution_context.h"
+#include "core/framework/tensorprotoutils.h"
+
+namespace onnxruntime {
+
+#ifdef ORT_ENABLE_STREAM
+
+namespace {
+
+// Kernels may read small initializers, such as shapes or axes, on the host when they are created, and copying them
+// isn't worth a copy each run.
+constexpr size_t kMinStreamedInitializerBytes = 1 << 20;
+
+size_t AlignedSize(size_t size) {
+  return (size + kAllocAlignment - 1) / kAllocAlignment * kAllocAlignment;
+}
+
+}  // namespace
+
+WeightStreamer::RunState::RunState(const WeightStreamer& streamer)
+    : streamer_(streamer), lanes_(streamer.logic_streams_.size()) {}
+
+WeightStreamer::RunState::~RunState() {
+  for (auto& lane : lanes_) {
+    if (lane.copy_stream == nullptr) {
+      continue;
+    }
+
+    // the kernels of the run may still read the slots
+    ORT_TRY {
+      lane.copy_stream->Flush();
+      lane.compute_stream->Flush();
+      ORT_IGNORE_RETURN_VALUE(lane.copy_stream->CleanUpOnRunEnd());
+    }
+    ORT_CATCH(const std::exception&) {
+      // the device is in an error state, which the run reports already
+    }
+    lane.loaded[0].reset();
+    lane.loaded[1].reset();
+    lane.released.reset();
+    lane.slots[0].reset();
+    lane.slots[1].reset();
+    streamer_.ReleaseCopyStream(std::move(lane.copy_stream));
+  }
+}
+
+WeightStreamer::WeightStreamer(const SessionState& session_state, IExecutionProvider& ep)
+    : session_state_(session_state), ep_(ep), device_(ep.GetOrtDeviceByMemType(OrtMemTypeDefault)) {}
+
+WeightStreamer::~WeightStreamer() = default;
+
+Status WeightStreamer::SelectInitializers(size_t budget, SequentialExecutionPlan& plan) {
+  const auto& graph_viewer = session_state_.GetGraphViewer();
+  const auto& name_idx_map = session_state_.GetOrtValueNameIdxMap();
+
+  // pinned memory, which the device copies from asynchronously, if the execution provider has an allocator for it
+  OrtDevice host_device = ep_.GetOrtDeviceByMemType(OrtMemTypeCPUOutput);
+  if (host_device.Type() != OrtDevice::CPU || session_state_.GetAllocator(host_device) == nullptr) {
+    host_device = OrtDevice();
+  }
+
+  // the nodes that read each initializer. an implicit input is read by a subgraph, which doesn't stream it.
+  InlinedHashMap<std::string_view, size_t> num_readers;
+  for (const auto& node : graph_viewer.Nodes()) {
+    for (const auto* arg : node.InputDefs()) {
+      if (arg->Exists()) {
+        ++num_readers[arg->Name()];
+      }
+    }
+    for (const auto* arg : node.ImplicitInputDefs()) {
+      num_readers[arg->Name()] += 2;
+    }
+  }
+
+  // the initializers that stay on the device count towards the budget first, then those that can be streamed in the
+  // order the plan reads them
+  size_t resident_bytes = 0;
+  std::vector<std::pair<int, size_t>> candidates;
+  InlinedHashSet<int> planned_values;
+  for (const auto& logic_stream : plan.execution_plan) {
+    for (const auto& step : logic_stream->steps_) {
+      if (!step->IsKernelLaunch()) {
+        continue;
+      }
+
+      const Node& node = *graph_viewer.GetNode(step->GetNodeIndex());
+      for (const auto* arg : node.InputDefs()) {
+        const ONNX_NAMESPACE::TensorProto* tensor_proto =
+            arg->Exists() ? graph_viewer.GetConstantInitializer(arg->Name(), false) : nullptr;
+        int idx = -1;
+        if (tensor_proto == nullptr || !name_idx_map.GetIdx(arg->Name(), idx).IsOK() ||
+            !planned_values.insert(idx).second || plan.GetLocation(idx) != device_) {
+          continue;
+        }
+
+        size_t size = 0;
+        ORT_RETURN_IF_ERROR(utils::GetSizeInBytesFromTensorProto<kAllocAlignment>(*tensor_proto, &size));
+        if (node.GetExecutionProviderType() == ep_.Type() && num_readers[arg->Name()] == 1 &&
+            size >= kMinStreamedInitializerBytes &&
+            tensor_proto->data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+          candidates.emplace_back(idx, size);
+        } else {
+          resident_bytes += size;
+        }
+      }
+    }
+  }
+
+  size_t streamed_bytes = 0;
+  for (const auto& [idx, size] : candidates) {
+    if (resident_bytes + size <= budget) {
+      resident_bytes += size;
+      continue;
+    }
+    plan.allocation_plan[idx].location = host_device;
+    streamed_values_.insert(idx);
+    streamed_bytes += size;
+  }
+
+  LOGS(session_state_.Logger(), INFO) << "Weight streaming keeps " << resident_bytes << " bytes of initializers on "
+                                      << device_.ToString() << " and streams " << streamed_values_.size()
+                                      << " initializers of " << streamed_bytes << " bytes from "
+                                      << host_device.ToString();
+  return Status::OK();
+}
+
+Status WeightStreamer::Initialize() {
+  const auto& graph_viewer = session_state_.GetGraphViewer();
+  const auto& plan = *session_state_.GetExecutionPlan();
+  const auto& name_idx_map = session_state_.GetOrtValueNameIdxMap();
+  const auto& initializers = session_state_.GetConstantInitializedTensors();
+
+  logic_streams_.resize(plan.execution_plan.size());
+  node_positions_.assign(graph_viewer.MaxNodeIndex(), {-1, 0});
+  for (size_t i = 0; i < plan.execution_plan.size(); ++i) {
+    auto& logic_stream = logic_streams_[i];
+    for (const auto& step : plan.execution_plan[i]->steps_) {
+      if (!step->IsKernelLaunch()) {
+        continue;
+      }
+
+      const NodeIndex node_index = step->GetNodeIndex();
+      const auto& input_defs = graph_viewer.GetNode(node_index)->InputDefs();
+      StreamedNode streamed_node{node_index, {}};
+      size_t slot_size = 0;
+      for (size_t input_index = 0; input_index < input_defs.size(); ++input_index) {
+        int idx = -1;
+        if (!input_defs[input_index]->Exists() || !name_idx_map.GetIdx(input_defs[input_index]->Name(), idx).IsOK() ||
+            streamed_values_.count(idx) == 0) {
+          continue;
+        }
+
+        // a kernel that pre-packed the initializer and released it doesn't read it
+        auto initializer = initializers.find(idx);
+        if (initializer == initializers.end()) {
+          continue;
+        }
+
+        const Tensor& tensor = initializer->second.Get<Tensor>();
+        streamed_node.inputs.push_back({static_cast<int>(input_index), initializer->second, slot_size});
+        slot_size += AlignedSize(tensor.SizeInBytes());
+      }
+
+      if (!streamed_node.inputs.empty()) {
+        node_positions_[node_index] = {static_cast<int>(i), logic_stream.nodes.size()};
+        logic_stream.nodes.push_back(std::move(streamed_node));
+        logic_stream.slot_size = std::max(logic_stream.slot_size, slot_size);
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+std::unique_ptr<Stream> WeightStreamer::AcquireCopyStream() const {
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    if (!copy_streams_.empty()) {
+      auto stream = std::move(copy_streams_.back());
+      copy_streams_.pop_back();
+      return stream;
+    }
+  }
+
+  auto create_stream_fn = session_state_.GetStreamHandleRegistryInstance().GetCreateStreamFn(device_.Type());
+  return create_stream_fn ? create_stream_fn(device_) : nullptr;
+}
+
+void WeightStreamer::ReleaseCopyStream(std::unique_ptr<Stream> stream) const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  copy_streams_.push_back(std::move(stream));
+}
+
+Status WeightStreamer::InitializeLane(StreamExecutionContext& ctx, const LogicStream& logic_stream,
+                                      size_t stream_idx, RunState::Lane& lane) const {
+  lane.compute_stream = ctx.GetDeviceStream(stream_idx);
+  ORT_RETURN_IF(lane.compute_stream == nullptr, "Weight streaming needs a device stream for the nodes of ",
+                ep_.Type());
+  lane.copy_stream = AcquireCopyStream();
+  ORT_RETURN_IF(lane.copy_stream == nullptr, "Failed to create a copy stream on ", device_.ToString());
+
+  // the slots are freed on the compute stream at the end of the run
+  auto allocator = session_state_.GetAllocator(device_);
+  ORT_RETURN_IF(allocator == nullptr, "Failed to find an allocator for ", device_.ToString());
+  const auto wait_fn = session_state_.GetStreamHandleRegistryInstance().GetWaitHandle(device_.Type(),
+                                                                                       device_.Type());
+  for (auto& slot : lane.slots) {
+    slot = IAllocator::MakeUniquePtr<void>(allocator, logic_stream.slot_size, false, lane.compute_stream, wait_fn);
+  }
+
+  return Status::OK();
+}
+
+Status WeightStreamer::Load(RunState::Lane& lane, const LogicStream& logic_stream, size_t position) const {
+  // the copy overwrites what the kernels launched so far read from the slot, or from the memory the slot reuses
+  lane.released = lane.compute_stream->CreateNotification(1);
+  lane.released->ActivateAndUpdate();
+  session_state_.GetStreamHandleRegistryInstance().GetWaitHandle(device_.Type(), device_.Type())(*lane.copy_stream,
+                                                                                                  *lane.released);
+
+  const size_t slot = position % 2;
+  auto* slot_data = static_cast<uint8_t*>(lane.slots[slot].get());
+  const auto& device_info = session_state_.GetAllocator(device_)->Info();
+  for (const auto& input : logic_stream.nodes[position].inputs) {
+    const Tensor& src = input.value.Get<Tensor>();
+    Tensor dst(src.DataType(), src.Shape(), slot_data + input.offset, device_info);
+    ORT_RETURN_IF_ERROR(session_state_.GetDataTransferMgr().CopyTensorAsync(src, dst, *lane.copy_stream));
+  }
+
+  lane.loaded[slot] = lane.copy_stream->CreateNotification(1);
+  lane.loaded[slot]->ActivateAndUpdate();
+  lane.slot_positions[slot] = position;
+  return Status::OK();
+}
+
+Status WeightStreamer::PrefetchForKernel(StreamExecutionContext& ctx, NodeIndex node_index,
+                                         size_t stream_idx) const {
+  if (node_index >= node_positions_.size() || node_positions_[node_index].first < 0) {
+    return Status::OK();
+  }
+
+  const auto [logic_stream_idx, position] = node_positions_[node_index];
+  const LogicStream& logic_stream = logic_streams_[logic_stream_idx];
+  auto& lane = ctx.GetWeightStreamingState()->lanes_[logic_stream_idx];
+  if (lane.copy_stream == nullptr) {
+    ORT_RETURN_IF_ERROR(InitializeLane(ctx, logic_stream, stream_idx, lane));
+  }
+
+  // the first node of the stream, or a node whose prefetch didn't happen, loads its own initializers
+  const size_t slot = position % 2;
+  if (lane.slot_positions[slot] != position) {
+    ORT_RETURN_IF_ERROR(Load(lane, logic_stream, position));
+  }
+  session_state_.GetStreamHandleRegistryInstance().GetWaitHandle(device_.Type(), device_.Type())(
+      *lane.compute_stream, *lane.loaded[slot]);
+
+  // the kernel reads the device copies
+  auto& frame = ctx.GetExecutionFrame();
+  const int node_offset = session_state_.GetNodeIndexInfo().GetNodeOffset(node_index);
+  auto* slot_data = static_cast<uint8_t*>(lane.slots[slot].get());
+  const auto& device_info = session_state_.GetAllocator(device_)->Info();
+  for (const auto& input : logic_stream.nodes[position].inputs) {
+    const Tensor& src = input.value.Get<Tensor>();
+    OrtValue* value = frame.GetMutableNodeInputOrOutputMLValue(node_offset + input.input_index);
+    Tensor::InitOrtValue(src.DataType(), src.Shape(), slot_data + input.offset, device_info, *value);
+  }
+
+  // the initializers of the next node go to the other slot once the node before this one, which read it, completed
+  if (position + 1 < logic_stream.nodes.size()) {
+    ORT_RETURN_IF_ERROR(Load(lane, logic_stream, position + 1));
+  }
+
+  return Status::OK();
+}
+
+#endif  // ORT_ENABLE_STREAM
+
+}  // namespace onnxruntime
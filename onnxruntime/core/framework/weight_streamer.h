@@ -0,0 +1,122 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/stream_handles.h"
+#include "core/graph/basic_types.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class IExecutionProvider;
+class SessionState;
+class StreamExecutionContext;
+struct SequentialExecutionPlan;
+
+/**
+ * Streams the initializers of an execution provider that don't fit in device memory, e.g. the weights of a large model
+ * on a small GPU.
+ *
+ * The initializers read first in the order of the execution plan stay on the device up to the budget of the execution
+ * provider. The others that a single node of the execution provider reads stay in pinned host memory, and each run
+ * copies them to the device ahead of that node, on a copy stream of its own. The device copies go to two slots per
+ * logic stream: the copy of the initializers of a node into one slot overlaps the kernel of the node before it, which
+ * reads the other slot, so a run is bounded by the host to device bandwidth rather than by the device memory.
+ *
+ * Small initializers, which kernels may read on the host when they are created, and initializers that several nodes
+ * or subgraphs read always stay on the device.
+ */
+class WeightStreamer {
+ public:
+  // The device copies of a run, owned by its StreamExecutionContext. It waits for the device to complete the run
+  // before it releases them.
+  class RunState {
+   public:
+    explicit RunState(const WeightStreamer& streamer);
+    ~RunState();
+
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunState);
+
+   private:
+    friend class WeightStreamer;
+
+    struct Lane {
+      Stream* compute_stream = nullptr;
+      std::unique_ptr<Stream> copy_stream;
+      IAllocatorUniquePtr<void> slots[2];
+      // the position in the logic stream of the node whose initializers each slot holds
+      size_t slot_positions[2] = {SIZE_MAX, SIZE_MAX};
+      std::unique_ptr<synchronize::Notification> loaded[2];
+      std::unique_ptr<synchronize::Notification> released;
+    };
+
+    const WeightStreamer& streamer_;
+    std::vector<Lane> lanes_;  // one per logic stream of the plan
+  };
+
+  WeightStreamer(const SessionState& session_state, IExecutionProvider& ep);
+  ~WeightStreamer();
+
+  // Picks the initializers to stream and moves them to host memory in the plan. Called before the initializers are
+  // saved.
+  Status SelectInitializers(size_t budget, SequentialExecutionPlan& plan);
+
+  // Looks up the nodes that read the streamed initializers, once the kernels and the initializers exist.
+  Status Initialize();
+
+  size_t NumStreamedInitializers() const { return streamed_values_.size(); }
+
+  // Called before the kernel of a node runs. Makes the device copies of the streamed initializers of the node the
+  // inputs of the kernel, and starts copying the initializers of the next node of the logic stream that has some.
+  Status PrefetchForKernel(StreamExecutionContext& ctx, NodeIndex node_index, size_t stream_idx) const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(WeightStreamer);
+
+ private:
+  struct StreamedInput {
+    int input_index;
+    // the initializer in host memory
+    OrtValue value;
+    // of its device copy in the slot
+    size_t offset;
+  };
+
+  struct StreamedNode {
+    NodeIndex node_index;
+    InlinedVector<StreamedInput> inputs;
+  };
+
+  struct LogicStream {
+    std::vector<StreamedNode> nodes;
+    size_t slot_size = 0;
+  };
+
+  Status InitializeLane(StreamExecutionContext& ctx, const LogicStream& logic_stream, size_t stream_idx,
+                        RunState::Lane& lane) const;
+  Status Load(RunState::Lane& lane, const LogicStream& logic_stream, size_t position) const;
+  std::unique_ptr<Stream> AcquireCopyStream() const;
+  void ReleaseCopyStream(std::unique_ptr<Stream> stream) const;
+
+  const SessionState& session_state_;
+  IExecutionProvider& ep_;
+  OrtDevice device_;
+  InlinedHashSet<int> streamed_values_;
+  std::vector<LogicStream> logic_streams_;
+  // the logic stream and position in it of each node that reads streamed initializers, or -1
+  std::vector<std::pair<int, size_t>> node_positions_;
+
+  mutable OrtMutex mutex_;
+  mutable std::vector<std::unique_ptr<Stream>> copy_streams_;  // GUARDED_BY(mutex_)
+};
+
+}  // namespace onnxruntime
@@ -275,6 +275,15 @@ void GroupQueryAttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceContext&
       ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, static_cast<size_t>(past_key_index) + 1, 2);
       ONNX_NAMESPACE::propagateShapeFromInputToOutput(ctx, past_key_index, 1);
       ONNX_NAMESPACE::propagateShapeFromInputToOutput(ctx, static_cast<size_t>(past_key_index) + 1, 2);
+    } else if (ctx.getInputType(past_key_index) == nullptr) {
+      // Without a past state, the present state has the type of the query unless it is quantized to bytes.
+      if (getAttribute(ctx, "kv_cache_bit_width", 0) != 0) {
+        updateOutputElemType(ctx, 1, ONNX_NAMESPACE::TensorProto::UINT8);
+        updateOutputElemType(ctx, 2, ONNX_NAMESPACE::TensorProto::UINT8);
+      } else {
+        ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 1);
+        ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 2);
+      }
     }
   }
 }
@@ -424,7 +433,8 @@ Input tensors contains the hidden embedding of real tokens.
 Token_offset records the offset of token in the unpacked input.
 cumulated_token_count records cumulated length of each sequnces length.
 
-The operator only supports BERT like model with padding on right now.
+The padding must be on the right. When unidirectional is 1, each token only attends to the previous tokens of its
+sequence, like in the self attention of a decoder.
 
 )DOC";
 
@@ -483,6 +493,10 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
     OpSchema()
         .SetDoc(PackingAttention_ver1_doc)
         .Attr("num_heads", "Number of attention heads", AttributeProto::INT)
+        .Attr("unidirectional",
+              "Whether every token can only attend to previous tokens of its sequence. Default value is 0.",
+              AttributeProto::INT,
+              static_cast<int64_t>(0))
         .Attr("qkv_hidden_sizes",
               "Hidden dimension of Q, K, V: hidden_size, hidden_size and v_hidden_size",
               AttributeProto::INTS,
@@ -553,7 +567,8 @@ The query, key and value tensors contain result of hidden embedding of real toke
 Token_offset records the offset of token in the unpacked input.
 cumulative_sequence_length records cumulated length of each sequnces length.
 
-The operator only supports BERT like model with padding on right now.
+The padding must be on the right. When unidirectional is 1, each token only attends to the previous tokens of its
+sequence, like in the self attention of a decoder.
 )DOC";
 
 // Shape inference for PackedMultiHeadAttention. Here are the shapes of inputs and output:
@@ -612,6 +627,10 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
     OpSchema()
         .SetDoc(PackedMultiHeadAttention_ver1_doc)
         .Attr("num_heads", "Number of attention heads", AttributeProto::INT)
+        .Attr("unidirectional",
+              "Whether every token can only attend to previous tokens of its sequence. Default value is 0.",
+              AttributeProto::INT,
+              static_cast<int64_t>(0))
         .Attr("mask_filter_value", "The value to be filled in the attention mask. Default value is -10000.0f",
               AttributeProto::FLOAT, OPTIONAL_VALUE)
         .Attr("scale",
@@ -995,6 +1014,20 @@ constexpr const char* GroupQueryAttention_ver1_doc = R"DOC(
 Group Query Self/Cross Attention.
 
 Supports different number of heads for q and kv. Only supports causal or local attention.
+
+When kv_cache_bit_width is 8 or 4, the CPU kernel keeps the kv cache quantized. Each row of head_size elements of
+past_key, past_value, present_key and present_value is then stored as uint8 bytes: one float scale per block of 32
+elements followed by the symmetric signed values, one per byte for 8 bits or two per byte, low nibble first, for 4 bits.
+The last dimension of the cache is the size of such a row rounded up to a multiple of 4 bytes.
+
+When do_rotary is 1, the rotary embedding of the RotaryEmbedding op is applied to query and key before attention, at
+the positions that follow the past sequence length of each batch. The rotated key is what is stored in present_key.
+
+When block_tables is given, the CPU kernel uses a paged kv cache. past_key and past_value are then pools of cache blocks
+with shape (num_blocks, kv_num_heads, block_size, head_size), shared by all the sequences of the batch, and
+present_key and present_value are the same pools with the new rows written in place. Row t of batch b is in block
+block_tables[b, t / block_size], at row t % block_size, so a sequence only holds the blocks it has filled. The blocks
+that receive the new rows must not be shared with another sequence of the batch.
 )DOC";
 
 ONNX_MS_OPERATOR_SET_SCHEMA(
@@ -1011,6 +1044,18 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
               "left_window_size for local attention (like Mistral). Default value is -1 meaning unused.",
               AttributeProto::INT,
               static_cast<int64_t>(-1))
+        .Attr("kv_cache_bit_width",
+              "Bits per element of a quantized kv cache, 8 or 4. Default value is 0 meaning the kv cache has type T.",
+              AttributeProto::INT,
+              static_cast<int64_t>(0))
+        .Attr("do_rotary",
+              "Whether to apply rotary position embedding to query and key. Default value is 0.",
+              AttributeProto::INT,
+              static_cast<int64_t>(0))
+        .Attr("rotary_interleaved",
+              "Rotate using the interleaved pattern instead of the halves of each head. Default value is 0.",
+              AttributeProto::INT,
+              static_cast<int64_t>(0))
         .Input(0,
                "query",
                "Query with shape (batch_size, sequence_length, hidden_size)",
@@ -1027,13 +1072,13 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                "past_key",
                "past state key with support for format BNSH. When past_key uses same tensor as present_key"
                "(k-v cache), it is of length max_sequence_length... otherwise of length past_sequence_length.",
-               "T",
+               "T_CACHE",
                OpSchema::Optional)
         .Input(4,
                "past_value",
                "past state value with support for format BNSH. When past_value uses same tensor as present_value"
                "(k-v cache), it is of length max_sequence_length... otherwise of length past_sequence_length.",
-               "T",
+               "T_CACHE",
                OpSchema::Optional)
         .Input(5,
                "seqlens_k",
@@ -1043,6 +1088,22 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                "total_sequence_length",
                "Scalar tensor of total sequence length (past + new).",
                "M")
+        .Input(7,
+               "cos_cache",
+               "2D tensor with shape (max_sequence_length, head_size / 2). Required when do_rotary is 1.",
+               "T",
+               OpSchema::Optional)
+        .Input(8,
+               "sin_cache",
+               "2D tensor with shape (max_sequence_length, head_size / 2). Required when do_rotary is 1.",
+               "T",
+               OpSchema::Optional)
+        .Input(9,
+               "block_tables",
+               "2D tensor with shape (batch_size, max_blocks_per_sequence) holding the kv cache block of every "
+               "block_size rows of each sequence. When given, past_key and past_value are pools of cache blocks.",
+               "M",
+               OpSchema::Optional)
         .Output(0,
                 "output",
                 "3D output tensor with shape (batch_size, sequence_length, hidden_size)",
@@ -1052,14 +1113,16 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                 "present state key with support for format BNSH. When past_key uses same tensor as present_key"
                 "(k-v buffer), it is of length max_sequence_length... otherwise of length past_sequence_length +"
                 "kv_sequence_length.",
-                "T")
+                "T_CACHE")
         .Output(2,
                 "present_value",
                 "present state value with support for format BNSH. When past_value uses same tensor as present_value"
                 "(k-v buffer), it is of length max_sequence_length... otherwise of length past_sequence_length +"
                 "kv_sequence_length.",
-                "T")
-        .TypeConstraint("T", {"tensor(float16)"}, "Constrain input and output to float tensors.")
+                "T_CACHE")
+        .TypeConstraint("T", {"tensor(float16)", "tensor(float)"}, "Constrain input and output to float tensors.")
+        .TypeConstraint("T_CACHE", {"tensor(float16)", "tensor(float)", "tensor(uint8)"},
+                        "Constrain the kv cache to T, or to uint8 when it is quantized.")
         .TypeConstraint("M", {"tensor(int32)"}, "Constrain mask to int tensor.")
         .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
           GroupQueryAttentionTypeAndShapeInference(ctx, 3);
@@ -158,6 +158,12 @@ void RegisterCollectiveOps() {
       .Attr("output_shard_specs",
             "Similar to input_shard_specs but for outputs.",
             AttributeProto::STRINGS)
+      .Attr("overlap_chunks",
+            "The maximum number of chunks of rows of Y computed one after the other when Y is all-reduced. "
+            "The all-reduce of a chunk runs on a separate stream while the next chunk is computed. "
+            "1 computes Y at once, then all-reduces it.",
+            AttributeProto::INT,
+            static_cast<int64_t>(4))
       .Input(0, "A", "N-dimensional matrix A", "T", OpSchema::Single, true, 1, OpSchema::Differentiable)
       .Input(1, "B", "N-dimensional matrix B", "T", OpSchema::Single, true, 1, OpSchema::Differentiable)
       .Output(0, "Y", "Matrix multiply results from A * B", "T", OpSchema::Single, true, 1, OpSchema::Differentiable)
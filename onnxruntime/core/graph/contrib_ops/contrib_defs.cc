@@ -598,6 +598,28 @@ ONNX_MS_OPERATOR_SET_SCHEMA(BiasGelu, 1,
                                     "Constrain input and output types to float tensors.")
                                 .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
 
+constexpr const char* FusedElementwise_ver1_doc = R"DOC(
+Runs a chain of element-wise ops in a single pass over the output.
+The i-th op in 'ops' takes the values at 'operands[2 * i]' and 'operands[2 * i + 1]', where the values are the
+inputs followed by the results of the previous ops. The second operand of a unary op is -1. The output is the
+result of the last op.
+The first input has the shape of the output. Each of the other inputs has either the shape of the output, a single
+element, or the size of the last dimension of the output, in which case it is broadcast along the other dimensions.
+It is created by the ElementwiseChainFusion optimizer.)DOC";
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    FusedElementwise, 1,
+    OpSchema()
+        .SetDoc(FusedElementwise_ver1_doc)
+        .Attr("ops",
+              "Op types of the chain, from Add, Sub, Mul, Div, Max, Min, Neg, Abs, Relu, Sigmoid, Tanh, Exp, Sqrt, "
+              "Reciprocal and Erf.",
+              AttributeProto::STRINGS)
+        .Attr("operands", "Two operand indices per op.", AttributeProto::INTS)
+        .Input(0, "inputs", "The inputs of the chain.", "T", OpSchema::Variadic)
+        .Output(0, "Y", "The result of the last op.", "T")
+        .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+        .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
 constexpr const char* QuickGelu_ver1_doc = R"DOC(Compute x * Sigmoid(alpha * x).)DOC";
 ONNX_MS_OPERATOR_SET_SCHEMA(
     QuickGelu, 1,
@@ -1152,6 +1174,11 @@ ONNX_MS_OPERATOR_SET_SCHEMA(BeamSearch, 1,
                                       "Size of the vocabulary. "
                                       "If not provided, it will be inferred from the decoder subgraph's output shape",
                                       AttributeProto::INT, static_cast<int64_t>(-1))
+                                .Attr("broadcast_encoder_outputs",
+                                      "If nonzero, the encoder attention mask and the cross attention past key and value are fed "
+                                      "to the decoder subgraph with shape of batch_size instead of batch_size * num_beams, and "
+                                      "cross attention of the decoder broadcasts them over beams. Default 0.",
+                                      AttributeProto::INT, static_cast<int64_t>(0))
                                 .Input(0, "input_ids", "The sequence used as a prompt for the generation in the encoder subgraph. Shape is (batch_size, sequence_length)", "F")
                                 .Input(1, "max_length", "The maximum length of the sequence to be generated. Shape is (1)", "I")
                                 .Input(2, "min_length", "The minimum length below which the score of eos_token_id is set to -Inf. Shape is (1)", "I", OpSchema::Optional)
@@ -1206,6 +1233,11 @@ ONNX_MS_OPERATOR_SET_SCHEMA(WhisperBeamSearch, 1,
                                 .Attr("no_speech_token",
                                       "The token in whisper model that marks all sequence empty. With this model, whisper could output no_speech_prob after. Default -1.",
                                       AttributeProto::INT, OPTIONAL_VALUE)
+                                .Attr("broadcast_encoder_outputs",
+                                      "If nonzero, the encoder attention mask and the cross attention past key and value are fed "
+                                      "to the decoder subgraph with shape of batch_size instead of batch_size * num_beams, and "
+                                      "cross attention of the decoder broadcasts them over beams. Default 0.",
+                                      AttributeProto::INT, static_cast<int64_t>(0))
                                 .Input(0, "input_ids", "The sequence used as a prompt for the generation in the encoder subgraph. Shape is (batch_size, sequence_length)", "F")
                                 .Input(1, "max_length", "The maximum length of the sequence to be generated. Shape is (1)", "I")
                                 .Input(2, "min_length", "The minimum length below which the score of eos_token_id is set to -Inf. Shape is (1)", "I", OpSchema::Optional)
@@ -1317,6 +1349,16 @@ ONNX_MS_OPERATOR_SET_SCHEMA(GreedySearch, 1,
                                       "Size of the vocabulary. "
                                       "If not provided, it will be inferred from the decoder subgraph's output shape",
                                       AttributeProto::INT, static_cast<int64_t>(-1))
+                                .Attr("speculative_tokens",
+                                      "Maximum number of draft tokens looked up from the earlier text of the sequence and verified in one `decoder` run. "
+                                      "The generated sequences are the same as without drafts. 0 disables it. "
+                                      "It is used on CPU for GPT models with batch size 1 that do not share the past and present buffers",
+                                      AttributeProto::INT, static_cast<int64_t>(0))
+                                .Attr("prefix_cache_size",
+                                      "Number of prompts whose past state is kept by the node, so that later prompts starting with the same tokens "
+                                      "run the `decoder` subgraph only on the rest of the prompt. Prefixes are reused in blocks of 16 tokens. 0 disables it. "
+                                      "It is used on CPU for GPT models with batch size 1 that do not share the past and present buffers",
+                                      AttributeProto::INT, static_cast<int64_t>(0))
                                 .Input(0, "input_ids", "The sequence used as a prompt for the generation. Shape is (batch_size, sequence_length)", "I")
                                 .Input(1, "max_length", "The maximum length of the sequence to be generated. Shape is (1)", "I")
                                 .Input(2, "min_length", "The minimum length below which the score of eos_token_id is set to -Inf. Shape is (1)", "I", OpSchema::Optional)
@@ -1358,6 +1400,16 @@ ONNX_MS_OPERATOR_SET_SCHEMA(Sampling, 1,
                                       "Size of the vocabulary. "
                                       "If not provided, it will be inferred from the decoder subgraph's output shape",
                                       AttributeProto::INT, static_cast<int64_t>(-1))
+                                .Attr("speculative_tokens",
+                                      "Maximum number of draft tokens looked up from the earlier text of the sequence and verified in one `decoder` run. "
+                                      "The generated sequences are the same as without drafts. 0 disables it. "
+                                      "It is used on CPU for GPT models with batch size 1 that do not share the past and present buffers",
+                                      AttributeProto::INT, static_cast<int64_t>(0))
+                                .Attr("prefix_cache_size",
+                                      "Number of prompts whose past state is kept by the node, so that later prompts starting with the same tokens "
+                                      "run the `decoder` subgraph only on the rest of the prompt. Prefixes are reused in blocks of 16 tokens. 0 disables it. "
+                                      "It is used on CPU for GPT models with batch size 1 that do not share the past and present buffers",
+                                      AttributeProto::INT, static_cast<int64_t>(0))
                                 .Input(0, "input_ids", "The sequence used as a prompt for the generation. Shape is (batch_size, sequence_length)", "I")
                                 .Input(1, "max_length", "The maximum length of the sequence to be generated. Shape is (1)", "I")
                                 .Input(2, "min_length", "The minimum length below which the score of eos_token_id is set to -Inf. Shape is (1)", "I", OpSchema::Optional)
@@ -1714,6 +1766,24 @@ activation and leaky_relu_alpha.)DOC")
                                   }
                                 }));
 
+ONNX_MS_OPERATOR_SET_SCHEMA(FusedScaler, 1,
+                            OpSchema()
+                                .SetDoc(R"DOC(
+The fusion of the ai.onnx.ml ops Imputer and Scaler for float inputs, Y = (Imputer(X) - offset) * scale.
+Inputs that equal replaced_value_float, or any NaN when replaced_value_float is NaN, are replaced with
+imputed_value_floats before they are scaled. offset and scale have either one value or one value per feature, the
+only dimension of a 1D input or the second dimension of an input of rank 2 or more. The first imputed value is used
+for every feature unless there is one per feature.)DOC")
+                                .Input(0, "X", "Data to be imputed and scaled.", "T")
+                                .Output(0, "Y", "Imputed and scaled output data, with the shape of X.", "T")
+                                .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+                                .Attr("imputed_value_floats", "Values to change to.", AttributeProto::FLOATS)
+                                .Attr("replaced_value_float", "Value that needs replacing.", AttributeProto::FLOAT, 0.f)
+                                .Attr("offset", "First, offset by this.", AttributeProto::FLOATS)
+                                .Attr("scale", "Second, multiply by this. Must be the same length as offset.",
+                                      AttributeProto::FLOATS)
+                                .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(ExpandDims, 1,
                             OpSchema()
                                 .Input(0, "X", "input", "T")
@@ -2279,6 +2349,57 @@ Example 4:
   output  = [[[2,3]],[[4,5]]]
 )DOC"));
 
+ONNX_MS_OPERATOR_SET_SCHEMA(EmbeddingBag, 1,
+                            OpSchema()
+                                .Attr("mode",
+                                      "How the rows of a bag are reduced: `sum` (default) or `mean`.",
+                                      AttributeProto::STRING,
+                                      std::string("sum"))
+                                .Input(0, "table", "The embedding table, a 2D tensor of shape (num_rows, embedding_dim).",
+                                       "T")
+                                .Input(1, "indices",
+                                       "Tensor of rank q >= 1. Each row of the last dimension is a bag of rows of the "
+                                       "table. Negative indices count from the end of the table.",
+                                       "Tind")
+                                .Output(0, "output",
+                                        "The reduced bags, a tensor of shape indices.shape[:-1] + (embedding_dim).", "T")
+                                .TypeConstraint("T", {"tensor(float)"}, "Constrain the table and output to float tensors.")
+                                .TypeConstraint("Tind", {"tensor(int32)", "tensor(int64)"},
+                                                "Constrain indices to integer types.")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  propagateElemTypeFromInputToOutput(ctx, 0, 0);
+                                  const auto mode = getAttribute(ctx, "mode", std::string("sum"));
+                                  if (mode != "sum" && mode != "mean") {
+                                    fail_shape_inference("mode must be sum or mean, got ", mode);
+                                  }
+                                  if (!hasNInputShapes(ctx, 2)) {
+                                    return;
+                                  }
+                                  auto& table_shape = ctx.getInputType(0)->tensor_type().shape();
+                                  auto& indices_shape = ctx.getInputType(1)->tensor_type().shape();
+                                  if (table_shape.dim_size() != 2) {
+                                    fail_shape_inference("table must be a 2D tensor.");
+                                  }
+                                  if (indices_shape.dim_size() < 1) {
+                                    fail_shape_inference("indices must have rank larger than zero.");
+                                  }
+                                  auto* output_shape = ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape();
+                                  for (int i = 0; i < indices_shape.dim_size() - 1; ++i) {
+                                    *output_shape->add_dim() = indices_shape.dim(i);
+                                  }
+                                  *output_shape->add_dim() = table_shape.dim(1);
+                                })
+                                .SetDoc(R"DOC(
+Gathers the rows of a 2D embedding table selected by each bag of indices and reduces them, the fusion of
+Gather(table, indices, axis=0) with ReduceSum or ReduceMean over the last axis of the indices and keepdims=0.
+An empty bag produces zeros.
+Example:
+  table   = [[0,1],[2,3],[4,5]]
+  indices = [[0,2],[1,1]]
+  mode    = "sum"
+  output  = [[4,6],[4,6]]
+)DOC"));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(WordConvEmbedding, 1,
                             OpSchema()
                                 .Attr(
@@ -2640,7 +2761,8 @@ ONNX_MS_OPERATOR_SET_SCHEMA(GemmFloat8, 1,
                                     "A",
                                     "Input tensor A. "
                                     "The shape of A should be (M, K) if transA is 0, "
-                                    "or (K, M) if transA is non-zero.",
+                                    "or (K, M) if transA is non-zero. "
+                                    "If transA is 0, A may have more dimensions, which are flattened into M.",
                                     "TA")
                                 .Input(
                                     1,
@@ -2673,7 +2795,15 @@ ONNX_MS_OPERATOR_SET_SCHEMA(GemmFloat8, 1,
                                     "Scale of the output tensor if A or B is float 8.",
                                     "TS",
                                     OpSchema::Optional)
-                                .Output(0, "Y", "Output tensor of shape (M, N).", "TR")
+                                .Output(0, "Y",
+                                        "Output tensor of shape (M, N), "
+                                        "or the leading dimensions of A followed by N if A has more than 2 dimensions.",
+                                        "TR")
+                                .Output(1, "amaxY",
+                                        "Maximum absolute value of the output before it is scaled by scaleY, "
+                                        "a scalar, only computed if A and B are float 8.",
+                                        "TS",
+                                        OpSchema::Optional)
                                 .TypeConstraint(
                                     "TA",
                                     GEMM_FLOAT8_TYPES,
@@ -2694,6 +2824,10 @@ ONNX_MS_OPERATOR_SET_SCHEMA(GemmFloat8, 1,
                                                 "Constrain type for all input scales (scaleA, scaleB, scaleY).")
                                 .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
                                   propagateElemTypeFromAttributeToOutput(ctx, "dtype", 0, TensorProto::FLOAT);
+                                  if (ctx.getNumOutputs() > 1) {
+                                    updateOutputElemType(ctx, 1, TensorProto::FLOAT);
+                                    updateOutputShape(ctx, 1, ONNX_NAMESPACE::TensorShapeProto());
+                                  }
                                   if (!hasNInputShapes(ctx, 2)) {
                                     return;
                                   }
@@ -2703,12 +2837,18 @@ ONNX_MS_OPERATOR_SET_SCHEMA(GemmFloat8, 1,
                                   bool transB = transBAttr ? static_cast<int>(transBAttr->i()) != 0 : false;
                                   auto& first_input_shape = getInputShape(ctx, 0);
                                   auto& second_input_shape = getInputShape(ctx, 1);
-                                  if (first_input_shape.dim_size() != 2) {
+                                  if (first_input_shape.dim_size() < 2 || (transA && first_input_shape.dim_size() != 2)) {
                                     fail_shape_inference("First input does not have rank 2");
                                   }
                                   if (second_input_shape.dim_size() != 2) {
                                     fail_shape_inference("Second input does not have rank 2");
                                   }
+                                  if (first_input_shape.dim_size() > 2) {
+                                    ONNX_NAMESPACE::TensorShapeProto output_shape = first_input_shape;
+                                    *output_shape.mutable_dim(output_shape.dim_size() - 1) = second_input_shape.dim(transB ? 0 : 1);
+                                    updateOutputShape(ctx, 0, output_shape);
+                                    return;
+                                  }
                                   updateOutputShape(ctx, 0, {first_input_shape.dim(transA ? 1 : 0), second_input_shape.dim(transB ? 0 : 1)});
                                 }));
 
@@ -275,6 +275,61 @@ ONNX_MS_OPERATOR_SET_SCHEMA(QLinearConv, 1,
                                     onnxruntime::contrib::convPoolShapeInferenceNhwc(ctx, true, false, 0, 3);
                                   }
                                 }));
+
+ONNX_MS_OPERATOR_SET_SCHEMA(QLinearConvDepthwisePointwise, 1,
+                            OpSchema()
+                                .SetDoc(R"DOC(
+A depthwise QLinearConv followed by a 1x1 pointwise QLinearConv. The attributes
+describe the depthwise convolution; the pointwise convolution has unit strides
+and no padding. The intermediate activation is quantized with mid_scale and
+mid_zero_point and is not materialized in memory.
+)DOC")
+                                .Input(0, "x", "", "T1")
+                                .Input(1, "x_scale", "", "tensor(float)")
+                                .Input(2, "x_zero_point", "", "T1")
+                                .Input(3, "dw_w", "", "T2")
+                                .Input(4, "dw_w_scale", "", "tensor(float)")
+                                .Input(5, "dw_w_zero_point", "", "T2")
+                                .Input(6, "mid_scale", "", "tensor(float)")
+                                .Input(7, "mid_zero_point", "", "T1")
+                                .Input(8, "pw_w", "", "T2")
+                                .Input(9, "pw_w_scale", "", "tensor(float)")
+                                .Input(10, "pw_w_zero_point", "", "T2")
+                                .Input(11, "y_scale", "", "tensor(float)")
+                                .Input(12, "y_zero_point", "", "T1")
+                                .Input(13, "dw_B", "", "T3", OpSchema::Optional)
+                                .Input(14, "pw_B", "", "T3", OpSchema::Optional)
+                                .Output(0, "y", "", "T1")
+                                .TypeConstraint("T1", {"tensor(int8)", "tensor(uint8)"}, "")
+                                .TypeConstraint("T2", {"tensor(int8)"}, "")
+                                .TypeConstraint("T3", {"tensor(int32)"}, "")
+                                .Attr("auto_pad", "", AttributeProto::STRING, std::string("NOTSET"))
+                                .Attr("kernel_shape", "", AttributeProto::INTS, OPTIONAL_VALUE)
+                                .Attr("dilations", "", AttributeProto::INTS, OPTIONAL_VALUE)
+                                .Attr("strides", "", AttributeProto::INTS, OPTIONAL_VALUE)
+                                .Attr("pads", "", AttributeProto::INTS, OPTIONAL_VALUE)
+                                .Attr("group", "", AttributeProto::INT, static_cast<int64_t>(1))
+                                .Attr("channels_last", "", AttributeProto::INT, static_cast<int64_t>(0))
+                                .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
+                                  propagateElemTypeFromInputToOutput(ctx, 0, 0);
+
+                                  const bool channels_last = getAttribute(ctx, "channels_last", 0) != 0;
+                                  if (!channels_last) {
+                                    convPoolShapeInference(ctx, true, false, 0, 3);
+                                  } else {
+                                    onnxruntime::contrib::convPoolShapeInferenceNhwc(ctx, true, false, 0, 3);
+                                  }
+
+                                  // The output channels are those of the pointwise filter.
+                                  if (hasInputShape(ctx, 8) && hasShape(*ctx.getOutputType(0))) {
+                                    const auto& pw_w_shape = getInputShape(ctx, 8);
+                                    auto* output_shape = ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape();
+                                    if (pw_w_shape.dim_size() > 0 && output_shape->dim_size() > 1) {
+                                      const int channel_dim = channels_last ? output_shape->dim_size() - 1 : 1;
+                                      *output_shape->mutable_dim(channel_dim) = pw_w_shape.dim(0);
+                                    }
+                                  }
+                                }));
 std::function<void(OpSchema&)> ConvOpSchemaGenerator() {
   return [=](OpSchema& schema) {
     schema.Input(
@@ -388,7 +443,7 @@ ONNX_MS_OPERATOR_SET_SCHEMA(NhwcFusedConv, 1,
                             OpSchema()
                                 .SetDoc(R"DOC(
 NhwcFusedConv is a Conv operator with optional activation and add operators fused in.
-Only has fp16 implementation as of 2023/04/15.
+Implemented for fp16 and fp32 tensors.
 )DOC")
                                 .Attr("auto_pad", "", AttributeProto::STRING, std::string("NOTSET"))
                                 .Attr("kernel_shape", "", AttributeProto::INTS, OPTIONAL_VALUE)
@@ -403,7 +458,7 @@ Only has fp16 implementation as of 2023/04/15.
                                 .Input(2, "B", "", "T", OpSchema::Optional)
                                 .Input(3, "Z", "Tensor to be added to the output, must be the same shape and format as the output tensor.", "T", OpSchema::Optional)
                                 .Output(0, "Y", "", "T")
-                                .TypeConstraint("T", {"tensor(float16)"}, "Constrain input and output types to float tensors")
+                                .TypeConstraint("T", {"tensor(float16)", "tensor(float)"}, "Constrain input and output types to float tensors")
                                 .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
                                   ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 0);
                                   convPoolShapeInferenceNhwc(ctx, true, false, 0, 1);
@@ -381,6 +381,10 @@ C (int32) = (A - A_zero_point) * (B - B_zero_point)
 ONNX_MS_OPERATOR_SET_SCHEMA(
     DynamicQuantizeMatMul, 1,
     OpSchema()
+        .Attr("per_row_quantization",
+              "Quantize each row of input 'A' with its own scale instead of a single scale for the whole tensor. "
+              "The rows are quantized symmetrically to uint8 with a zero point of 128. Default value is 0.",
+              AttributeProto::INT, static_cast<int64_t>(0))
         .Input(0, "A", "N-dimensional matrix A", "T1")
         .Input(1, "B", "N-dimensional matrix B", "T2")
         .Input(2, "b_scale",
@@ -962,6 +966,10 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
               "Custom scale will be used if specified. Default value is 1/sqrt(head_size)",
               AttributeProto::FLOAT,
               OPTIONAL_VALUE)
+        .Attr("quantized_attention",
+              "Whether to quantize Q, K, V and the attention probabilities to 8 bits when there is no mask_index and "
+              "no past state. Default value is 0.",
+              AttributeProto::INT, static_cast<int64_t>(0))
         .Input(0, "input", "3D input tensor with shape (batch_size, sequence_length, input_hidden_size)", "T1")
         .Input(1, "weight",
                "2D input tensor with shape (input_hidden_size, 3 * hidden_size), hidden_size = num_heads * head_size",
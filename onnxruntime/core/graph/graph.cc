@@ -3,6 +3,7 @@
 
 #include "core/graph/graph.h"
 
+#include <atomic>
 #include <cassert>
 #include <fstream>
 #include <iostream>
@@ -15,6 +16,7 @@
 #include "core/common/inlined_containers.h"
 #include "core/common/logging/logging.h"
 #include "core/common/narrow.h"
+#include "core/common/startup_timings.h"
 #include "core/flatbuffers/flatbuffers_utils.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/tensor_shape.h"
@@ -178,8 +180,16 @@ static std::string GenerateSchemaKey(const IndexedSubGraph& subgraph_ptr) {
 }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+// starts at 1 as Graph::VerifyNodeAndOpMatch separates the input and output versions of a node with 0
+static std::atomic<uint64_t> node_arg_version_counter{1};
+
+void NodeArg::UpdateVersion() noexcept {
+  version_ = node_arg_version_counter.fetch_add(1, std::memory_order_relaxed);
+}
+
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD) || defined(ORT_MINIMAL_BUILD_CUSTOM_OPS)
 NodeArg::NodeArg(const std::string& name, const TypeProto* p_node_arg_type) {
+  UpdateVersion();
   node_arg_info_.set_name(name);
   // If the name is empty, it means the arg does not exist.
   exists_ = !(name.empty());
@@ -198,6 +208,7 @@ NodeArg::NodeArg(const std::string& name, const TypeProto* p_node_arg_type) {
 #endif  // #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD) || defined(ORT_MINIMAL_BUILD_CUSTOM_OPS)
 
 NodeArg::NodeArg(NodeArgInfo&& node_arg_info) {
+  UpdateVersion();
   node_arg_info_ = std::move(node_arg_info);
 
   exists_ = !node_arg_info_.name().empty();
@@ -288,6 +299,7 @@ bool NodeArg::HasTensorOrScalarShape() const {
 
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 void NodeArg::SetShape(const TensorShapeProto& shape) {
+  UpdateVersion();
   const auto type_case = node_arg_info_.type().value_case();
   switch (type_case) {
     case TypeProto::kTensorType:
@@ -319,6 +331,7 @@ void NodeArg::SetShape(const TensorShapeProto& shape) {
 }
 
 void NodeArg::ClearShape() {
+  UpdateVersion();
   const auto type_case = node_arg_info_.type().value_case();
   switch (type_case) {
     case TypeProto::kTensorType:
@@ -382,6 +395,7 @@ common::Status NodeArg::OverrideTypesHelper(const ONNX_NAMESPACE::TypeProto& inp
 
 common::Status NodeArg::UpdateTypeAndShape(const ONNX_NAMESPACE::TypeProto& input_type, bool strict,
                                            bool override_types, const logging::Logger& logger) {
+  UpdateVersion();
   if (!utils::HasType(node_arg_info_)) {
     SetType(input_type);
     return Status::OK();
@@ -499,6 +513,7 @@ void NodeArg::SetType(DataType p_type) {
     return;
   }
 
+  UpdateVersion();
   type_ = p_type;
   *(node_arg_info_.mutable_type()) = DataTypeUtils::ToTypeProto(p_type);
 }
@@ -508,6 +523,7 @@ void NodeArg::SetType(DataType p_type) {
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
 void NodeArg::SetType(const TypeProto& type_proto) {
+  UpdateVersion();
   type_ = DataTypeUtils::ToType(type_proto);
   *(node_arg_info_.mutable_type()) = type_proto;
 }
@@ -943,6 +959,9 @@ void Node::CreateSubgraph(const std::string& attr_name) {
 
 void Node::AddAttributeProto(AttributeProto value) {
   utils::SetNodeAttribute(std::move(value), attributes_);
+#if !defined(ORT_MINIMAL_BUILD)
+  inferred_def_versions_.clear();
+#endif
   if (graph_) {
     graph_->SetGraphResolveNeeded();
     graph_->SetGraphProtoSyncNeeded();
@@ -993,6 +1012,9 @@ void Node::AddAttribute(std::string attr_name, GraphProto value) {
 bool Node::ClearAttribute(const std::string& attr_name) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+#if !defined(ORT_MINIMAL_BUILD)
+  inferred_def_versions_.clear();
+#endif
   return attributes_.erase(attr_name) > 0;
 }
 
@@ -1001,6 +1023,9 @@ bool Node::ClearAttribute(const std::string& attr_name) {
 int Node::PruneRemovableAttributes(gsl::span<const std::string> removable_attributes) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+#if !defined(ORT_MINIMAL_BUILD)
+  inferred_def_versions_.clear();
+#endif
   int n_removed = 0;
   for (const auto& name : removable_attributes) {
     n_removed += static_cast<int>(attributes_.erase(name));
@@ -2338,6 +2363,10 @@ Status Graph::InferAndVerifyTypeMatch(Node& node, const OpSchema& op, const Reso
     ++i;
     if (!output_def->Exists()) continue;
 
+    // an output the inferencing leaves as it was keeps its version, so that its consumers aren't inferred again
+    const uint64_t output_version = output_def->version_;
+    const std::string output_type = output_def->ToProto().type().SerializeAsString();
+
     // if the number of actual parameters exceeds the number of formal parameters,
     // then the op has variadic outputs and the trailing extra actual parameters
     // correspond to the last formal parameter. (The ONNX schema verification check
@@ -2437,6 +2466,10 @@ Status Graph::InferAndVerifyTypeMatch(Node& node, const OpSchema& op, const Reso
           output_def->ClearShape();
       }
     }
+
+    if (output_def->ToProto().type().SerializeAsString() == output_type) {
+      output_def->version_ = output_version;
+    }
   }
 
   return Status::OK();
@@ -2546,15 +2579,35 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
     lsc.output_names.insert(std::string(input));
   }
 
+  // The schema of a node, the versions of its input defs, 0 and the versions of its output defs. A node of the main
+  // graph without subgraphs that has the attributes and the versions it was last inferred with would be inferred the
+  // same, so it is skipped, and a Resolve after a graph transformation infers the nodes downstream of the change only.
+  InlinedVector<uint64_t> def_versions;
+  auto get_def_versions = [&def_versions](const Node& node) {
+    def_versions.clear();
+    def_versions.push_back(reinterpret_cast<uintptr_t>(node.Op()));
+    for (const auto* def : node.InputDefs()) {
+      def_versions.push_back(def->version_);
+    }
+    def_versions.push_back(0);
+    for (const auto* def : node.OutputDefs()) {
+      def_versions.push_back(def->version_);
+    }
+    return gsl::make_span(def_versions);
+  };
+  const bool can_skip_inferencing = parent_node_ == nullptr && !options.override_types;
+
   for (auto node_index : nodes_in_topological_order_) {
     // Node verification.
     auto& node = *GetNode(node_index);
 
-    NodeProto node_proto;
-    node.ToProto(node_proto);
     const auto& node_name = node.Name();
 
     if (!node.Op()) {
+      node.inferred_def_versions_.clear();
+
+      NodeProto node_proto;
+      node.ToProto(node_proto);
       {
         auto status = Status::OK();
         ORT_TRY {
@@ -2597,6 +2650,16 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
 
     ORT_RETURN_IF_ERROR(node.UpdateInputArgCount());
 
+    const bool skip_inferencing = can_skip_inferencing && !node.ContainsSubgraph() &&
+                                  !node.inferred_def_versions_.empty() &&
+                                  SpanEq(get_def_versions(node), gsl::make_span(node.inferred_def_versions_));
+    if (skip_inferencing) {
+      for (const auto* output_def : node.OutputDefs()) {
+        lsc.output_names.insert(output_def->Name());
+      }
+      continue;
+    }
+
     // currently an Op is required by ValidateVersion, so we use gsl::not_null to validate that.
     // This may change in the future to allow a null Op
     const gsl::not_null<const OpSchema*> p_op{node.Op()};
@@ -2629,9 +2692,14 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
 
     NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
 
+    if (can_skip_inferencing && !node.ContainsSubgraph()) {
+      const auto versions = get_def_versions(node);
+      node.inferred_def_versions_.assign(versions.begin(), versions.end());
+    }
+
     // Accumulate output names of the iterated Node
-    for (auto& output_name : node_proto.output()) {
-      lsc.output_names.insert(output_name);
+    for (const auto* output_def : node.OutputDefs()) {
+      lsc.output_names.insert(output_def->Name());
     }
   }
 
@@ -2756,6 +2824,8 @@ Status Graph::Resolve(const ResolveOptions& options) {
     return Status::OK();
   }
 
+  StartupPhase phase("graph_resolve");
+
   // init all graph/subgraphs. non-recursive so call via ForThisAndAllSubgraphs.
   auto init_func = [](Graph& graph) { return graph.InitInputsInitializersOutputs(); };
   ORT_RETURN_IF_ERROR(ForThisAndAllSubgraphs(all_subgraphs, init_func));
@@ -2838,6 +2908,11 @@ void Graph::AddInitializedTensor(const TensorProto& tensor) {
   *(tensor_added) = tensor;
   name_to_initial_tensor_[tensor.name()] = tensor_added;
   SetGraphResolveNeeded();
+  // the consumers of the initializer are inferred again, as some read its value, e.g. the shape input of Reshape
+  auto* node_arg = GetNodeArg(tensor.name());
+  if (node_arg != nullptr) {
+    node_arg->UpdateVersion();
+  }
   if (!is_loaded_from_model_file_ && GetNodeArg(tensor.name()) == nullptr) {
     // make sure there is a NodeArg for the initializer as SetGraphInputsOutputs may add it to the graph inputs.
     // the shape will be set to the correct value in TypeCheckInputsAndInitializers as we don't yet know whether there
@@ -2896,6 +2971,10 @@ void Graph::RemoveInitializedTensor(const std::string& tensor_name) {
     sparse_tensor_names_.erase(tensor_name);
 #endif
     SetGraphResolveNeeded();
+    auto* node_arg = GetNodeArg(tensor_name);
+    if (node_arg != nullptr) {
+      node_arg->UpdateVersion();
+    }
   } else {
 #if !defined(DISABLE_SPARSE_TENSORS)
     ORT_ENFORCE(sparse_tensor_names_.count(tensor_name) == 0, "sparse_tensor_names_ not in sync with name_to_initial_tensor_");
@@ -2949,6 +3028,11 @@ Status Graph::ReplaceInitializedTensorImpl(ONNX_NAMESPACE::TensorProto new_initi
   ORT_ENFORCE(existing_entry != mutable_initializers.pointer_end(),
               "graph_proto_ is not in sync with name_to_initial_tensor_");
 
+  auto* node_arg = GetNodeArg(initializer_name);
+  if (node_arg != nullptr) {
+    node_arg->UpdateVersion();
+  }
+
   **existing_entry = std::move(new_initializer);
 
   return Status::OK();
@@ -5,11 +5,9 @@
 
 #include "flatbuffers/flatbuffers.h"
 
-#include "core/common/narrow.h"
 #include "core/flatbuffers/flatbuffers_utils.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/tensorprotoutils.h"
-#include "core/framework/tensor_external_data_info.h"
 #include "core/graph/graph.h"
 
 using namespace ONNX_NAMESPACE;
@@ -202,24 +200,7 @@ Status LoadInitializerOrtFormat(const fbs::Tensor& fbs_tensor, TensorProto& init
     ORT_RETURN_IF(nullptr == fbs_raw_data, "Missing raw data for initializer. Invalid ORT format model.");
 
     if (load_options.can_use_flatbuffer_for_initializers && fbs_raw_data->size() > 127) {
-      initializer.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL);
-
-      static_assert(sizeof(void*) <= sizeof(ExternalDataInfo::OFFSET_TYPE));
-      const void* data_offset = fbs_raw_data->Data();
-      // we reinterpret_cast this back to void* in tensorprotoutils.cc:GetExtDataFromTensorProto.
-      // use intptr_t as OFFSET_TYPE is signed. in theory you could get a weird looking value if the address uses the
-      // high bit, but that should be unlikely in a scenario where we care about memory usage enough to use this path.
-      auto offset = narrow<ExternalDataInfo::OFFSET_TYPE>(reinterpret_cast<intptr_t>(data_offset));
-
-      ONNX_NAMESPACE::StringStringEntryProto* entry = initializer.mutable_external_data()->Add();
-      entry->set_key("location");
-      entry->set_value(ToUTF8String(onnxruntime::utils::kTensorProtoMemoryAddressTag));
-      entry = initializer.mutable_external_data()->Add();
-      entry->set_key("offset");
-      entry->set_value(std::to_string(offset));
-      entry = initializer.mutable_external_data()->Add();
-      entry->set_key("length");
-      entry->set_value(std::to_string(fbs_raw_data->size()));
+      onnxruntime::utils::SetExternalDataInMemory(initializer, fbs_raw_data->Data(), fbs_raw_data->size());
     } else {
       // fbs_raw_data is uint8_t vector, so the size is byte size
       initializer.set_raw_data(fbs_raw_data->Data(), fbs_raw_data->size());
@@ -350,6 +331,8 @@ Status SaveOrtTensorOrtFormat(
 
   const auto fbs_tensor_name = builder.CreateString(tensor_name);
   const auto fbs_tensor_dims = SaveDims(builder, ort_tensor.Shape().GetDims());
+  // aligned so that a checkpoint mapped into memory can be used in place
+  builder.ForceVectorAlignment(ort_tensor.SizeInBytes(), sizeof(uint8_t), kOrtTensorDataAlignment);
   flatbuffers::Offset<flatbuffers::Vector<uint8_t>> raw_data = builder.CreateVector(
       static_cast<const uint8_t*>(ort_tensor.DataRaw()),
       ort_tensor.SizeInBytes());
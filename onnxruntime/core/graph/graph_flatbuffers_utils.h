@@ -88,6 +88,9 @@ Status LoadAttributeOrtFormat(const fbs::Attribute& fbs_attr,
 
 #ifdef ENABLE_TRAINING_APIS
 
+// Alignment of the data of the tensors saved by SaveOrtTensorOrtFormat, relative to the start of the buffer.
+constexpr size_t kOrtTensorDataAlignment = 64;
+
 /// @brief Save an ORT Tensor to a flatbuffer tensor
 /// @param[in] tensor_name Name of the tensor
 /// @param[in] ort_tensor ORT tensor to serialize to a flatbuffer tensor
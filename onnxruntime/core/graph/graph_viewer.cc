@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/graph/graph_viewer.h"
+
+#include <algorithm>
+#include <limits>
+
 #include "core/graph/indexed_sub_graph.h"
 
 namespace onnxruntime {
@@ -52,6 +56,230 @@ struct PriorityNodeCompare {
 };
 #endif
 
+#if !defined(ORT_MINIMAL_BUILD)
+namespace {
+size_t ElementSizeInBytes(int32_t elem_type) {
+  switch (elem_type) {
+    case ONNX_NAMESPACE::TensorProto_DataType_BOOL:
+    case ONNX_NAMESPACE::TensorProto_DataType_INT8:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT8:
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E4M3FN:
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E4M3FNUZ:
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E5M2:
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E5M2FNUZ:
+      return 1;
+    case ONNX_NAMESPACE::TensorProto_DataType_INT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16:
+      return 2;
+    case ONNX_NAMESPACE::TensorProto_DataType_INT64:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT64:
+    case ONNX_NAMESPACE::TensorProto_DataType_DOUBLE:
+    case ONNX_NAMESPACE::TensorProto_DataType_COMPLEX64:
+      return 8;
+    case ONNX_NAMESPACE::TensorProto_DataType_COMPLEX128:
+      return 16;
+    default:
+      return 4;
+  }
+}
+
+// Estimated size of a tensor value in bytes. Dims without a fixed value count as 1.
+size_t EstimateTensorSizeInBytes(const NodeArg& node_arg) {
+  const auto* type = node_arg.TypeAsProto();
+  const auto* shape = node_arg.Shape();
+  if (type == nullptr || !type->has_tensor_type() || shape == nullptr) {
+    return 0;
+  }
+
+  size_t size = ElementSizeInBytes(type->tensor_type().elem_type());
+  for (const auto& dim : shape->dim()) {
+    if (!dim.has_dim_value()) {
+      continue;
+    }
+
+    const auto dim_value = dim.dim_value();
+    if (dim_value <= 0) {
+      return 0;
+    }
+
+    // saturate rather than overflow for bogus shapes
+    size = static_cast<uint64_t>(dim_value) > std::numeric_limits<size_t>::max() / size
+               ? std::numeric_limits<size_t>::max()
+               : size * static_cast<size_t>(dim_value);
+  }
+
+  return size;
+}
+
+// Tracks the estimated bytes held by node outputs as the nodes of a GraphViewer are run one at a time.
+// An output is released once all of its consumers in the viewer have run, unless it is a graph output.
+class LiveTensorTracker {
+ public:
+  explicit LiveTensorTracker(const GraphViewer& graph_viewer) {
+    for (const auto& node : graph_viewer.Nodes()) {
+      node.ForEachDef([this](const NodeArg& arg, bool is_input) {
+        if (is_input) {
+          ++remaining_uses_[&arg];
+        }
+      });
+    }
+
+    for (const auto* output : graph_viewer.GetOutputs()) {
+      graph_outputs_.insert(output);
+    }
+  }
+
+  // Bytes allocated for the outputs of 'node'.
+  size_t OutputBytes(const Node& node) const {
+    size_t bytes = 0;
+    for (const auto* output : node.OutputDefs()) {
+      if (output->Exists()) {
+        bytes += EstimateTensorSizeInBytes(*output);
+      }
+    }
+    return bytes;
+  }
+
+  // Bytes released after 'node' runs. These are its inputs with no other remaining consumers,
+  // and its outputs that nothing consumes.
+  size_t ReleasedBytes(const Node& node) const {
+    size_t bytes = 0;
+    InlinedHashMap<const NodeArg*, size_t> uses;
+    node.ForEachDef([&uses](const NodeArg& arg, bool is_input) {
+      if (is_input) {
+        ++uses[&arg];
+      }
+    });
+
+    for (const auto& [arg, num_uses] : uses) {
+      auto it = live_sizes_.find(arg);
+      if (it != live_sizes_.end() && remaining_uses_.at(arg) == num_uses && graph_outputs_.count(arg) == 0) {
+        bytes += it->second;
+      }
+    }
+
+    for (const auto* output : node.OutputDefs()) {
+      if (output->Exists() && remaining_uses_.count(output) == 0 && graph_outputs_.count(output) == 0) {
+        bytes += EstimateTensorSizeInBytes(*output);
+      }
+    }
+
+    return bytes;
+  }
+
+  void Run(const Node& node) {
+    for (const auto* output : node.OutputDefs()) {
+      if (output->Exists()) {
+        const auto size = EstimateTensorSizeInBytes(*output);
+        live_sizes_[output] = size;
+        live_bytes_ += size;
+      }
+    }
+    peak_bytes_ = std::max(peak_bytes_, live_bytes_);
+
+    node.ForEachDef([this](const NodeArg& arg, bool is_input) {
+      if (is_input && --remaining_uses_[&arg] == 0) {
+        Release(arg);
+      }
+    });
+
+    for (const auto* output : node.OutputDefs()) {
+      if (output->Exists() && remaining_uses_.count(output) == 0) {
+        Release(*output);
+      }
+    }
+  }
+
+  size_t PeakBytes() const { return peak_bytes_; }
+
+ private:
+  void Release(const NodeArg& arg) {
+    auto it = live_sizes_.find(&arg);
+    if (it != live_sizes_.end() && graph_outputs_.count(&arg) == 0) {
+      live_bytes_ -= it->second;
+      live_sizes_.erase(it);
+    }
+  }
+
+  InlinedHashMap<const NodeArg*, size_t> remaining_uses_;
+  InlinedHashSet<const NodeArg*> graph_outputs_;
+  // outputs of the nodes that have run and not been released yet
+  InlinedHashMap<const NodeArg*, size_t> live_sizes_;
+  size_t live_bytes_ = 0;
+  size_t peak_bytes_ = 0;
+};
+
+// Kahn's algorithm picking the ready node that grows the live tensor bytes the least, or shrinks them the most.
+// Ties are broken by the position in 'default_order' so the result stays close to it.
+std::vector<NodeIndex> MemoryEfficientTopologicalSort(const GraphViewer& graph_viewer,
+                                                      const std::vector<NodeIndex>& default_order) {
+  LiveTensorTracker tracker(graph_viewer);
+
+  InlinedHashMap<NodeIndex, size_t> default_position;
+  InlinedHashMap<NodeIndex, size_t> in_degree;
+  default_position.reserve(default_order.size());
+  in_degree.reserve(default_order.size());
+  std::vector<const Node*> ready;
+  for (size_t i = 0; i < default_order.size(); ++i) {
+    const auto* node = graph_viewer.GetNode(default_order[i]);
+    default_position[node->Index()] = i;
+
+    size_t num_input_edges = 0;
+    for (auto it = node->InputEdgesBegin(), end = node->InputEdgesEnd(); it != end; ++it) {
+      if (graph_viewer.GetNode(it->GetNode().Index()) != nullptr) {
+        ++num_input_edges;
+      }
+    }
+
+    in_degree[node->Index()] = num_input_edges;
+    if (num_input_edges == 0) {
+      ready.push_back(node);
+    }
+  }
+
+  std::vector<NodeIndex> order;
+  order.reserve(default_order.size());
+  while (!ready.empty()) {
+    size_t best = 0;
+    size_t best_output_bytes = tracker.OutputBytes(*ready[0]);
+    size_t best_released_bytes = tracker.ReleasedBytes(*ready[0]);
+    for (size_t i = 1; i < ready.size(); ++i) {
+      const size_t output_bytes = tracker.OutputBytes(*ready[i]);
+      const size_t released_bytes = tracker.ReleasedBytes(*ready[i]);
+      // compare output - released without going negative
+      const size_t lhs = output_bytes + best_released_bytes;
+      const size_t rhs = best_output_bytes + released_bytes;
+      if (lhs < rhs ||
+          (lhs == rhs && default_position[ready[i]->Index()] < default_position[ready[best]->Index()])) {
+        best = i;
+        best_output_bytes = output_bytes;
+        best_released_bytes = released_bytes;
+      }
+    }
+
+    const Node* node = ready[best];
+    ready[best] = ready.back();
+    ready.pop_back();
+
+    tracker.Run(*node);
+    order.push_back(node->Index());
+
+    for (auto it = node->OutputEdgesBegin(), end = node->OutputEdgesEnd(); it != end; ++it) {
+      auto degree = in_degree.find(it->GetNode().Index());
+      if (degree != in_degree.end() && --degree->second == 0) {
+        ready.push_back(&it->GetNode());
+      }
+    }
+  }
+
+  ORT_ENFORCE(order.size() == default_order.size(), "Memory efficient topological sort did not visit every node.");
+  return order;
+}
+}  // namespace
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 GraphViewer::GraphViewer(const Graph& graph)
     : GraphViewer(graph, nullptr) {
 }
@@ -286,12 +514,30 @@ const std::vector<NodeIndex>& GraphViewer::GetNodesInTopologicalOrder(ExecutionO
 #if !defined(ORT_MINIMAL_BUILD)
     case ExecutionOrder::PRIORITY_BASED:
       return nodes_in_topological_order_with_priority_;
+    case ExecutionOrder::MEMORY_EFFICIENT:
+      std::call_once(memory_efficient_topological_order_flag_, [this]() {
+        nodes_in_memory_efficient_topological_order_ =
+            MemoryEfficientTopologicalSort(*this, nodes_in_topological_order_);
+      });
+      return nodes_in_memory_efficient_topological_order_;
 #endif
     default:
       ORT_THROW("Invalid ExecutionOrder");
   }
 }
 
+#if !defined(ORT_MINIMAL_BUILD)
+size_t GraphViewer::EstimatePeakMemoryUsage(gsl::span<const NodeIndex> order) const {
+  LiveTensorTracker tracker(*this);
+  for (const auto node_index : order) {
+    const auto* node = GetNode(node_index);
+    ORT_ENFORCE(node != nullptr, "Node ", node_index, " is not in the graph.");
+    tracker.Run(*node);
+  }
+  return tracker.PeakBytes();
+}
+#endif
+
 const std::vector<NodeIndex>& GraphViewer::GetRootNodes() const {
   // TODO: See if we need to calculate the root_nodes_ of the filtered graph.
   // GetRootNodes is only used by parallel executor currently, and isn't relevant to the usage of a filtered graph.
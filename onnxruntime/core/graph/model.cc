@@ -1,8 +1,14 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <limits>
 #include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
 #include "core/common/logging/logging.h"
+#include "core/common/startup_timings.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/flatbuffers/flatbuffers_utils.h"
 #include "core/framework/tensorprotoutils.h"
@@ -15,6 +21,7 @@
 #pragma warning(disable : 4800)
 #endif
 #include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
@@ -160,6 +167,7 @@ Model::Model(ModelProto&& model_proto, const PathString& model_path,
              const IOnnxRuntimeOpSchemaRegistryList* local_registries,
              const logging::Logger& logger, const ModelOptions& options)
     : model_path_(Path::Parse(model_path)) {
+  StartupPhase phase("graph_build");
   if (!utils::HasGraph(model_proto)) {
     ORT_THROW("ModelProto does not have a graph.");
   }
@@ -398,6 +406,7 @@ Status Model::Load(std::istream& model_istream, ModelProto* p_model_proto) {
   }
 
   google::protobuf::io::IstreamInputStream zero_copy_input(&model_istream);
+  StartupPhase phase("model_parse");
   const bool result = p_model_proto->ParseFromZeroCopyStream(&zero_copy_input) && model_istream.eof();
   if (!result) {
     return Status(ONNXRUNTIME, INVALID_PROTOBUF, "Failed to load model because protobuf parsing failed.");
@@ -649,6 +658,7 @@ Status Model::SaveWithExternalInitializers(Model& model, const PathString& file_
 }
 
 Status Model::LoadFromBytes(int count, void* p_bytes, /*out*/ ONNX_NAMESPACE::ModelProto& model_proto) {
+  StartupPhase phase("model_parse");
   const bool result = model_proto.ParseFromArray(p_bytes, count);
   if (!result) {
     return Status(ONNXRUNTIME, INVALID_PROTOBUF, "Protobuf parsing failed.");
@@ -685,12 +695,117 @@ Status Model::LoadFromBytes(int count, void* p_bytes, const PathString& model_pa
 using ::google::protobuf::io::CodedInputStream;
 using ::google::protobuf::io::FileInputStream;
 using ::google::protobuf::io::ZeroCopyInputStream;
+using ::google::protobuf::internal::WireFormatLite;
+
+namespace {
+// field numbers of the messages LoadReferencingInitializerData looks into
+constexpr int kModelProtoGraphField = 7;
+constexpr int kGraphProtoInitializerField = 5;
+constexpr int kTensorProtoRawDataField = 9;
+
+// Calls field_fn(field_number, field, payload) for each field of the serialized message, with the bytes of the
+// whole field and the bytes of the payload of a length delimited field.
+template <typename FieldFn>
+Status ForEachField(gsl::span<const uint8_t> message, FieldFn field_fn) {
+  ORT_RETURN_IF(message.size() > static_cast<size_t>(std::numeric_limits<int>::max()), "The message is too large");
+  CodedInputStream input(message.data(), static_cast<int>(message.size()));
+  for (;;) {
+    const int start = input.CurrentPosition();
+    const uint32_t tag = input.ReadTag();
+    if (tag == 0) {
+      ORT_RETURN_IF(static_cast<size_t>(start) != message.size(), "Protobuf parsing failed.");
+      return Status::OK();
+    }
+
+    gsl::span<const uint8_t> payload;
+    if (WireFormatLite::GetTagWireType(tag) == WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+      uint32_t length = 0;
+      ORT_RETURN_IF_NOT(input.ReadVarint32(&length), "Protobuf parsing failed.");
+      const int payload_start = input.CurrentPosition();
+      ORT_RETURN_IF_NOT(input.Skip(static_cast<int>(length)), "Protobuf parsing failed.");
+      payload = message.subspan(static_cast<size_t>(payload_start), length);
+    } else {
+      ORT_RETURN_IF_NOT(WireFormatLite::SkipField(&input, tag), "Protobuf parsing failed.");
+    }
+
+    const auto field = message.subspan(static_cast<size_t>(start), static_cast<size_t>(input.CurrentPosition() - start));
+    ORT_RETURN_IF_ERROR(field_fn(WireFormatLite::GetTagFieldNumber(tag), field, payload));
+  }
+}
+
+// Parses the serialized message with all fields except the ones handled by special_field_fn, which is called for
+// the length delimited fields with the field number.
+template <typename Message, typename SpecialFieldFn>
+Status ParseWithoutField(gsl::span<const uint8_t> message, int field_number, Message& parsed,
+                         SpecialFieldFn special_field_fn) {
+  std::string other_fields;
+  ORT_RETURN_IF_ERROR(ForEachField(message, [&](int number, gsl::span<const uint8_t> field,
+                                                gsl::span<const uint8_t> payload) -> Status {
+    if (number == field_number && payload.data() != nullptr) {
+      return special_field_fn(payload);
+    }
+    other_fields.append(reinterpret_cast<const char*>(field.data()), field.size());
+    return Status::OK();
+  }));
+  ORT_RETURN_IF_NOT(parsed.ParseFromString(other_fields), "Protobuf parsing failed.");
+  return Status::OK();
+}
+}  // namespace
+
+Status Model::LoadReferencingInitializerData(gsl::span<const uint8_t> bytes, ModelProto& model_proto) {
+  StartupPhase phase("model_parse");
+  // the structure of the model is parsed as usual. the initializers of the main graph are parsed one by one, with
+  // their raw data referenced in place rather than copied into the TensorProto.
+  std::vector<gsl::span<const uint8_t>> graphs;
+  ORT_RETURN_IF_ERROR(ParseWithoutField(bytes, kModelProtoGraphField, model_proto,
+                                        [&graphs](gsl::span<const uint8_t> graph) {
+                                          graphs.push_back(graph);
+                                          return Status::OK();
+                                        }));
+  // protobuf merges repeated occurrences of a message field, which no exporter writes for the graph
+  ORT_RETURN_IF(graphs.size() > 1, "The model has more than one graph");
+  if (graphs.empty()) {
+    return Status::OK();
+  }
+
+  GraphProto& graph_proto = *model_proto.mutable_graph();
+  std::vector<gsl::span<const uint8_t>> initializers;
+  ORT_RETURN_IF_ERROR(ParseWithoutField(graphs[0], kGraphProtoInitializerField, graph_proto,
+                                        [&initializers](gsl::span<const uint8_t> initializer) {
+                                          initializers.push_back(initializer);
+                                          return Status::OK();
+                                        }));
+
+  graph_proto.mutable_initializer()->Reserve(static_cast<int>(initializers.size()));
+  for (const auto& initializer : initializers) {
+    TensorProto& tensor_proto = *graph_proto.add_initializer();
+    std::optional<gsl::span<const uint8_t>> raw_data;
+    ORT_RETURN_IF_ERROR(ParseWithoutField(initializer, kTensorProtoRawDataField, tensor_proto,
+                                          [&raw_data](gsl::span<const uint8_t> data) {
+                                            raw_data = data;
+                                            return Status::OK();
+                                          }));
+    if (!raw_data.has_value()) {
+      continue;
+    }
+    if (raw_data->size() >= kMinSizeOfInitializerDataToReference &&
+        tensor_proto.data_location() != TensorProto_DataLocation_EXTERNAL) {
+      utils::SetExternalDataInMemory(tensor_proto, raw_data->data(), raw_data->size());
+    } else {
+      tensor_proto.set_raw_data(raw_data->data(), raw_data->size());
+    }
+  }
+
+  return Status::OK();
+}
 
 Status Model::Load(int fd, ONNX_NAMESPACE::ModelProto& model_proto) {
   if (fd < 0) {
     return Status(ONNXRUNTIME, INVALID_ARGUMENT, "<p_fd> less than 0.");
   }
 
+  StartupPhase phase("model_parse");
+
 #if GOOGLE_PROTOBUF_VERSION >= 3002000
   size_t file_size = 0;
   int block_size = -1;
@@ -848,6 +963,7 @@ common::Status Model::LoadFromOrtFormat(const fbs::Model& fbs_model,
                                         const OrtFormatLoadOptions& load_options,
                                         const logging::Logger& logger,
                                         std::unique_ptr<Model>& model) {
+  StartupPhase phase("graph_build");
   model = std::make_unique<Model>();
 
   // Load the model metadata
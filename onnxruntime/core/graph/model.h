@@ -263,6 +263,15 @@ class Model {
                                       const logging::Logger& logger,
                                       const ModelOptions& options = {});
 
+  // Parses the model in bytes without copying the raw data of the initializers of the main graph. Initializers
+  // with at least kMinSizeOfInitializerDataToReference bytes of raw data refer to it in bytes as external data at a
+  // memory address, so bytes must remain valid while the model or any tensor created from those initializers is used.
+  // This is meant for a memory mapped model file.
+  static common::Status LoadReferencingInitializerData(gsl::span<const uint8_t> bytes,
+                                                       /*out*/ ONNX_NAMESPACE::ModelProto& model_proto);
+
+  static constexpr size_t kMinSizeOfInitializerDataToReference = 128;
+
   static common::Status Load(const ONNX_NAMESPACE::ModelProto& model_proto, /*out*/ std::shared_ptr<Model>& p_model,
                              const IOnnxRuntimeOpSchemaRegistryList* local_registries,
                              const logging::Logger& logger,
@@ -20,6 +20,9 @@ Abstract:
 #include <cstddef>
 #include <cstdlib>
 #include <cstdint>
+#include <memory>
+
+#include "mlas_gemm_postprocessor.h"
 
 //
 // Define the calling convention for Windows targets.
@@ -64,6 +67,9 @@ Abstract:
 #define MLAS_TARGET_WASM
 #if defined(__wasm_simd128__)
 #define MLAS_TARGET_WASM_SIMD
+#if defined(__wasm_relaxed_simd__)
+#define MLAS_TARGET_WASM_RELAXED_SIMD
+#endif
 #else
 #define MLAS_TARGET_WASM_SCALAR
 #endif
@@ -94,6 +100,15 @@ Abstract:
 #endif // ARM64
 #endif // Visual Studio 16 or earlier does not support fp16 intrinsic
 
+//
+// Half precision GEMM and convolution have vectorized kernels on x64, using
+// F16C or AVX512-FP16, even though the other fp16 routines do not.
+//
+
+#if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) || defined(MLAS_TARGET_AMD64)
+#define MLAS_F16GEMM_INTRINSICS_SUPPORTED
+#endif
+
 //
 // Basic Linear Algebra Subprograms (BLAS) types.
 //
@@ -133,6 +148,17 @@ MlasGetPreferredBufferAlignment(
     void
     );
 
+/**
+ * @brief Return the instruction set extensions the kernels were selected for
+ *        on the current processor, e.g. "sse2 avx avx2 f16c", so that a change
+ *        of the kernels dispatched can be detected
+ */
+const char*
+MLASCALL
+MlasGetKernelIsa(
+    void
+    );
+
 #ifdef MLAS_TARGET_AMD64_IX86
 
 /**
@@ -161,6 +187,9 @@ enum MLAS_ACTIVATION_KIND {
     MlasLogisticActivation,
     MlasClipActivation,
     MlasHardSigmoidActivation,
+    MlasGeluActivation,         // x * 0.5 * (1 + erf(x / sqrt(2)))
+    MlasFastGeluActivation,     // x * 0.5 * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3)))
+    MlasSiluActivation,         // x * sigmoid(x)
     MlasActivationKindCount,
 };
 
@@ -199,6 +228,50 @@ MlasActivation(
 // op(X) = X or op(X) = transpose(X) or op(X) = conjg(transpose(X))
 //
 
+/**
+ * @brief Epilogue of a single precision GEMM, applied to each block of the
+ * output as soon as the block is final, while it is still in the cache:
+ *
+ *   C = Activation(C + Bias) + Residual
+ *
+ * Bias is a vector of N elements broadcast over the rows of C. Residual is a
+ * matrix of the shape of C with ldr elements per row. Each term is optional.
+ */
+class MLAS_SGEMM_EPILOGUE_PROCESSOR : public MLAS_GEMM_POSTPROCESSOR<float>
+{
+public:
+    MLAS_SGEMM_EPILOGUE_PROCESSOR(
+        const MLAS_ACTIVATION* Activation,
+        const float* Bias,
+        const float* Residual = nullptr,
+        size_t ldr = 0
+        ) :
+            Activation_(Activation),
+            Bias_(Bias),
+            Residual_(Residual),
+            ldr_(ldr)
+    {
+    }
+
+    void
+    Process(
+        float* C,
+        size_t StartM,
+        size_t StartN,
+        size_t CountM,
+        size_t CountN,
+        size_t ldc
+        ) const override;
+
+private:
+    const MLAS_ACTIVATION* Activation_;
+    const float* Bias_;
+    const float* Residual_;
+    size_t ldr_;
+};
+
+struct MLAS_SGEMM_JIT_KERNEL;
+
 /**
  * @brief Supply matrices data information to single precision gemm functions
  */
@@ -212,6 +285,11 @@ struct MLAS_SGEMM_DATA_PARAMS {
     float alpha = 1.0f;       /**< Supplies the scalar alpha multiplier (see SGEMM definition) */
     float beta = 0.0f;        /**< Supplies the scalar beta multiplier (see SGEMM definition) */
     bool BIsPacked = false;   /**< Whether B is pre-packed */
+    const MLAS_GEMM_POSTPROCESSOR<float>* OutputProcessor = nullptr; /**< Optional processor of the final output blocks */
+    const MLAS_SGEMM_JIT_KERNEL* JitKernel = nullptr; /**< Optional kernel generated for pre-packed B, used in place of OutputProcessor when it applies */
+    const float* JitBias = nullptr; /**< Supplies the bias row of a generated kernel built with a bias */
+    const float* const* BNodeReplicas = nullptr; /**< Optional copies of the pre-packed B by NUMA node, read in place of B by the threads of a node */
+    size_t BNodeReplicaCount = 0; /**< Supplies the number of entries of BNodeReplicas */
 };
 
 /**
@@ -241,6 +319,16 @@ MlasGemmBatch(
     MLAS_THREADPOOL* ThreadPool
     );
 
+/**
+ * @brief Return the name of the single precision GEMM kernel selected for the
+ *        current processor, e.g. "fma3" or "avx512f"
+ */
+const char*
+MLASCALL
+MlasSgemmGetKernelName(
+    void
+    );
+
 /**
  * @brief  Single precision matrix/matrix multiply operation (SGEMM)
  *
@@ -618,6 +706,17 @@ MlasGemmBatch(
     MLAS_THREADPOOL* ThreadPool
     );
 
+/**
+ * @brief Return the name of the quantized GEMM kernel selected for the signedness
+ *        of A and B on the current processor, e.g. "avx512vnni" or "amx"
+ */
+const char*
+MLASCALL
+MlasGemmQuantGetKernelName(
+    bool AIsSigned,
+    bool BIsSigned
+    );
+
 inline
 void
 MlasGemm(
@@ -696,6 +795,34 @@ MlasGemmPackB(
     void* PackedB
     );
 
+/**
+ * @brief Returns a single precision matrix/matrix multiply kernel generated
+ *        at run time for a matrix B packed by MlasGemmPackB.
+ *
+ *        The kernel is specialized for the exact N and K of the operation and
+ *        applies alpha, beta, the optional bias row and the activation to
+ *        each output tile. Kernels are cached and shared by all holders of
+ *        the same specialization, and released with the last reference.
+ *
+ * @param N           Supplies the number of columns of matrix B and matrix C.
+ * @param K           Supplies the number of columns of matrix A and the number
+ *                    of rows of matrix B.
+ * @param Activation  Optionally supplies the activation applied to the output,
+ *                    else nullptr for the identity.
+ * @param HasBias     Supplies true if MLAS_SGEMM_DATA_PARAMS::JitBias is added
+ *                    to each row of the output.
+ * @return The kernel to assign to MLAS_SGEMM_DATA_PARAMS::JitKernel, else
+ *         nullptr if the platform or the specialization is not supported.
+ */
+std::shared_ptr<const MLAS_SGEMM_JIT_KERNEL>
+MLASCALL
+MlasSgemmJitKernelGet(
+    size_t N,
+    size_t K,
+    const MLAS_ACTIVATION* Activation,
+    bool HasBias
+    );
+
 size_t
 MLASCALL
 MlasGemmPackBSize(
@@ -746,6 +873,174 @@ MlasSymmQgemmPackB(
     void* PackedB
     );
 
+//
+// Single precision matrix/matrix multiply with bfloat16 compute.
+// C := A * B
+//
+
+/**
+ * @brief Supply matrices data information to single precision gemm functions
+ *        that compute in bfloat16
+ */
+struct MLAS_SBGEMM_DATA_PARAMS {
+    const float* A = nullptr; /**< Supplies the address of matrix A, converted to bfloat16 on the fly */
+    size_t lda = 0;           /**< Supplies the first dimension of matrix A. */
+    const void* B = nullptr;  /**< Supplies the address of matrix B, packed by MlasSBGemmConvertPackB */
+    float* C = nullptr;       /**< Supplies the address of matrix C */
+    size_t ldc = 0;           /**< Supplies the first dimension of matrix C. */
+};
+
+/**
+ * @brief Returns the size of the buffer needed to pack matrix B for
+ *        MlasSBGemmBatch
+ * @param N  Number of columns
+ * @param K  Number of rows
+ * @return  size of the packing buffer,
+ *          0 if the processor has no AMX-BF16 or AVX512-BF16 support
+ */
+size_t
+MLASCALL
+MlasSBGemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+/**
+ * @brief Converts single precision matrix B to bfloat16 and packs it
+ *
+ * @param TransB      Supplies the transpose operation for matrix B.
+ * @param N           Number of columns
+ * @param K           Number of rows
+ * @param B           Supplies the address of matrix B
+ * @param ldb         Supplies the first dimension of matrix B.
+ * @param PackedB     Supplies the buffer of MlasSBGemmPackBSize bytes
+ * @param ThreadPool  Supplies the thread pool object to use
+ */
+void
+MLASCALL
+MlasSBGemmConvertPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief Batched single precision matrix/matrix multiply operation that
+ *        converts the inputs to bfloat16 and accumulates in single precision,
+ *        on AMX-BF16 tiles or with AVX512-BF16 dot products. The results
+ *        have the precision of bfloat16 products.
+ *
+ * @param M           Supplies the number of rows of matrix A and matrix C.
+ * @param N           Supplies the number of columns of matrix B and matrix C.
+ * @param K           Supplies the number of columns of matrix A and the number
+                      of rows of matrix B.
+ * @param Data        A array of matrices data parameters
+ * @param BatchSize   Supplies number of multiplications in this batch
+ * @param ThreadPool  Supplies the thread pool object to use, else nullptr if the
+                      base library threading support should be used.
+ */
+void
+MLASCALL
+MlasSBGemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SBGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Single precision matrix/matrix multiply with a block sparse matrix B.
+// C := alpha * A * B + beta * C
+//
+
+/**
+ * @brief Supply matrices data information to single precision gemm functions
+ *        with a block sparse matrix B
+ */
+struct MLAS_SPARSE_SGEMM_DATA_PARAMS {
+    const float* A = nullptr;       /**< Supplies the address of matrix A */
+    size_t lda = 0;                 /**< Supplies the first dimension of matrix A. */
+    const void* PackedB = nullptr;  /**< Supplies the address of matrix B, packed by MlasSparseGemmPackB */
+    float* C = nullptr;             /**< Supplies the address of matrix C */
+    size_t ldc = 0;                 /**< Supplies the first dimension of matrix C. */
+    float alpha = 1.0f;             /**< Supplies the scalar alpha multiplier (see SGEMM definition) */
+    float beta = 0.0f;              /**< Supplies the scalar beta multiplier (see SGEMM definition) */
+    const MLAS_GEMM_POSTPROCESSOR<float>* OutputProcessor = nullptr; /**< Optional processor of the output blocks */
+};
+
+/**
+ * @brief Returns the size of the buffer needed to pack the nonzero blocks of
+ *        matrix B for MlasSparseGemmBatch. The zero blocks of B are measured
+ *        to choose between blocks of 4x4 and 1x4 elements.
+ * @param TransB  Supplies the transpose operation for matrix B.
+ * @param N       Number of columns
+ * @param K       Number of rows
+ * @param B       Supplies the address of matrix B
+ * @param ldb     Supplies the first dimension of matrix B.
+ * @return  size of the packing buffer,
+ *          0 if matrix B is not sparse enough to be faster than MlasGemm
+ */
+size_t
+MLASCALL
+MlasSparseGemmPackBSize(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb
+    );
+
+/**
+ * @brief Packs the nonzero blocks of matrix B
+ *
+ * @param TransB      Supplies the transpose operation for matrix B.
+ * @param N           Number of columns
+ * @param K           Number of rows
+ * @param B           Supplies the address of matrix B
+ * @param ldb         Supplies the first dimension of matrix B.
+ * @param PackedB     Supplies the buffer of MlasSparseGemmPackBSize bytes
+ */
+void
+MLASCALL
+MlasSparseGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+/**
+ * @brief Batched single precision matrix/matrix multiply operation with a
+ *        block sparse matrix B, skipping the blocks of zeros.
+ *
+ * @param M           Supplies the number of rows of matrix A and matrix C.
+ * @param N           Supplies the number of columns of matrix B and matrix C.
+ * @param K           Supplies the number of columns of matrix A and the number
+                      of rows of matrix B.
+ * @param Data        A array of matrices data parameters
+ * @param BatchSize   Supplies number of multiplications in this batch
+ * @param ThreadPool  Supplies the thread pool object to use, else nullptr if the
+                      base library threading support should be used.
+ */
+void
+MLASCALL
+MlasSparseGemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SPARSE_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Convolution routines.
 //
@@ -754,6 +1049,7 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmWinograd,
 #if defined(MLAS_TARGET_WASM_SCALAR)
     MlasConvAlgorithmDepthwise,
 #endif
@@ -786,6 +1082,10 @@ struct MLAS_CONV_PARAMETERS {
         struct {
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            const float* PackedFilter;
+            size_t TileRowsPerBlock;
+        } Winograd;
     } u;
 };
 
@@ -805,7 +1105,8 @@ MlasConvPrepare(MLAS_CONV_PARAMETERS* Parameters,
                 const MLAS_ACTIVATION* Activation,
                 size_t* WorkingBufferSize,
                 float Beta,
-                MLAS_THREADPOOL* ThreadPool);
+                MLAS_THREADPOOL* ThreadPool,
+                const float* WinogradPackedFilter = nullptr);
 
 void
 MLASCALL
@@ -819,6 +1120,64 @@ MlasConv(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Winograd F(4x4, 3x3) convolution filter packing. MlasConvPrepare only selects
+// MlasConvAlgorithmWinograd when it is given a filter packed by these routines,
+// as the results differ by rounding from the other algorithms.
+//
+
+bool
+MLASCALL
+MlasConvWinogradIsSupported(
+    size_t Dimensions,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* StrideShape
+    );
+
+size_t
+MLASCALL
+MlasConvWinogradPackedFilterSize(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels
+    );
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    float* PackedFilter
+    );
+
+//
+// Transposed convolution routine.
+//
+
+void
+MLASCALL
+MlasConvTranspose2D(
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    size_t OutputChannels,
+    const int64_t* OutputShape,
+    const float* Input,
+    const float* Filter,
+    bool FilterIsTransposed,
+    const float* Bias,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasConvDepthwise(
@@ -940,6 +1299,42 @@ MlasConvSymDepthwise(
     const MLAS_CONV_SYM_PARAMS& Params
     );
 
+//
+// Fused depthwise and pointwise symmetric quantized convolution. The depthwise
+// filter is packed by MlasConvSymPackW with GroupCount set to the channel
+// count and the pointwise filter is packed by MlasConvSymPackW with GroupCount
+// and KernelSize set to one; MlasConvSymPointwisePackWSize returns zero if the
+// pointwise filter cannot be used by the fused routine. A tile of depthwise
+// output is kept in a thread local buffer and consumed by the pointwise kernel
+// while it is still in cache, so the intermediate activation never reaches
+// memory.
+//
+// DepthwiseParams supplies the input indirection buffer, the output pixel
+// count and the requantization of the intermediate activation; its Output is
+// ignored. PointwiseParams supplies the output buffer and the requantization
+// of the output; its InputDirect, InputIndirection, InputChannels, OutputCount
+// and KernelSize are ignored. The pointwise Bias must account for the zero
+// point of the intermediate activation (see MlasConvSymFixupInputZeroPoint).
+//
+
+size_t
+MlasConvSymPointwisePackWSize(
+    size_t InputChannels,
+    size_t OutputChannels,
+    bool InputIsSigned
+    );
+
+void
+MlasConvSymDepthwisePointwise(
+    const MLAS_CONV_SYM_PARAMS& DepthwiseParams,
+    const MLAS_CONV_SYM_PARAMS& PointwiseParams
+    );
+
+int32_t
+MlasConvSymDepthwisePointwiseGetKernelOutputCnt(
+    bool InputIsSigned
+    );
+
 //
 // Pooling routines.
 //
@@ -977,6 +1372,45 @@ MlasMaximumPool(
     size_t KernelSize
     );
 
+/**
+ * @brief Max Pooling for fp32 NHWC
+ * @param Input         Indirect buffer to activations, nullptr for padding
+ * @param Output        Address of the result tensor
+ * @param Channels      C in NHWC
+ * @param OutputCount   Number of output pixels
+ * @param KernelSize    Size of the kernel
+ * @return
+*/
+void
+MLASCALL
+MlasNhwcMaxPool(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
+/**
+ * @brief Avg Pooling for fp32 NHWC, averaging over the entries of the
+ *        indirect buffer that are not nullptr
+ * @param Input         Indirect buffer to activations
+ * @param Output        Address of the output data
+ * @param Channels      C in NHWC
+ * @param OutputCount   Number of output pixels
+ * @param KernelSize    size of the kernel
+ * @return
+*/
+void
+MLASCALL
+MlasNhwcAvgPool(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
 //
 // Miscellaneous compute routines.
 //
@@ -1024,6 +1458,294 @@ MlasComputeTanh(
     size_t N
     );
 
+/**
+ * @brief Single pass activation functions of a buffer. The gate of each block
+ *        of the input is computed by the vectorized transcendental routines
+ *        and combined with the block while it is still in the cache.
+ *
+ *    Gelu:     Output = 0.5 * x * (1 + erf(x / sqrt(2)))
+ *    FastGelu: Output = 0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3)))
+ *    Swish:    Output = x * sigmoid(Alpha * x), SiLU when Alpha is 1
+ *    Softplus: Output = log(1 + exp(x))
+ *
+ * The routines support in place updates of the output buffer.
+ */
+void
+MLASCALL
+MlasComputeGelu(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasComputeFastGelu(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasComputeSwish(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Alpha
+    );
+
+void
+MLASCALL
+MlasComputeSoftplus(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+/**
+ * @brief Reductions of a row major matrix.
+ *
+ *    MlasReduceLastAxis:  Output[r] = reduce(Input[r, 0 .. Columns - 1])
+ *    MlasReduceFirstAxis: Output[c] = reduce(Input[0 .. Rows - 1, c])
+ *
+ * The rows are combined with multiple vector accumulators. MlasReduceFirstAxis
+ * does not support MlasReduceLogSumExp. The results are accumulated in single
+ * precision.
+ */
+enum MLAS_REDUCE_KIND {
+    MlasReduceSum,
+    MlasReduceSumSquare,
+    MlasReduceMaximum,
+    MlasReduceMinimum,
+    MlasReduceLogSumExp,
+};
+
+void
+MLASCALL
+MlasReduceLastAxis(
+    MLAS_REDUCE_KIND ReduceKind,
+    const float* Input,
+    float* Output,
+    size_t Rows,
+    size_t Columns
+    );
+
+void
+MLASCALL
+MlasReduceFirstAxis(
+    MLAS_REDUCE_KIND ReduceKind,
+    const float* Input,
+    float* Output,
+    size_t Rows,
+    size_t Columns,
+    size_t ldInput
+    );
+
+/**
+ * @brief Sums the rows of an embedding table selected by one bag of indices,
+ *        the reduction of EmbeddingBag.
+ *
+ *    Output = Scale * sum(Table[Indices[i], 0 .. Dim - 1] for i in 0 .. IndexCount - 1)
+ *
+ * The rows of the following indices are prefetched while a row is summed.
+ *
+ * @param Table         the embedding table, RowCount rows of Dim elements
+ * @param RowCount      the number of rows of the table. Negative indices
+ *                      count from the end. The caller validates the indices.
+ * @param Dim           the number of elements of a row
+ * @param Indices       the indices of the rows to sum
+ * @param IndexCount    the number of indices, the output is zero if none
+ * @param Scale         1 for a sum, 1 / IndexCount for a mean
+ * @param Output        the output row of Dim elements
+ */
+void
+MLASCALL
+MlasEmbeddingBag(
+    const float* Table,
+    size_t RowCount,
+    size_t Dim,
+    const int32_t* Indices,
+    size_t IndexCount,
+    float Scale,
+    float* Output
+    );
+
+void
+MLASCALL
+MlasEmbeddingBag(
+    const float* Table,
+    size_t RowCount,
+    size_t Dim,
+    const int64_t* Indices,
+    size_t IndexCount,
+    float Scale,
+    float* Output
+    );
+
+/**
+ * @brief Layer normalization of one row, fused with the residual add of skip
+ *        layer normalization.
+ *
+ *    X = Input + Skip + Bias
+ *    Output = (X - mean(X)) / sqrt(var(X) + Epsilon) * Scale + Shift
+ *
+ * or, when Simplified (RMS normalization),
+ *
+ *    Output = X / sqrt(mean(X * X) + Epsilon) * Scale
+ *
+ * @param Input         the input row
+ * @param Skip          optional row added to the input
+ * @param Bias          optional row added to the input
+ * @param Scale         the scale (gamma) row
+ * @param Shift         optional shift (beta) row, ignored when Simplified
+ * @param Output        the output row, may be the same as Input
+ * @param SkipOutput    optional output of X
+ * @param N             row size
+ * @param Epsilon       value added to the variance
+ * @param Simplified    compute the RMS normalization
+ * @param Mean          optional output of the mean of X, zero when Simplified
+ * @param InvStdDev     optional output of the inverse standard deviation
+ */
+void
+MLASCALL
+MlasLayerNormalization(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    );
+
+/**
+ * @brief Parameters of a fused scaled dot product attention.
+ *
+ * Every (batch, head) pair computes softmax(Scale * Q * K^T) * V without
+ * materializing the SequenceLength x KvSequenceLength probabilities. Rows of
+ * a head are ld* elements apart, heads are *HeadStride elements apart and
+ * batches are *BatchStride elements apart, so both BSNH and BNSH layouts can
+ * be addressed directly. Query head n reads key/value head
+ * n / (NumHeads / KvNumHeads).
+ *
+ * When KvBitWidth is nonzero, the keys and values are read from QuantizedK
+ * and QuantizedV, whose rows were written by MlasQuantizeKvCacheRows, and
+ * their ld*, *HeadStride and *BatchStride are counted in bytes.
+ *
+ * When BlockTables is set, the keys and values are a paged cache: a pool of
+ * blocks of KvBlockSize rows per head, *BatchStride apart. Key row t of batch
+ * b lives in block BlockTables[b * BlockTableStride + t / KvBlockSize], at
+ * row t % KvBlockSize of that block.
+ */
+struct MLAS_FLASH_ATTENTION_PARAMS {
+    size_t BatchSize;
+    size_t NumHeads;
+    size_t KvNumHeads;                  ///< must divide NumHeads
+    size_t SequenceLength;              ///< query rows per head
+    size_t KvSequenceLength;            ///< key/value rows per head
+    size_t HeadSize;                    ///< query/key head size
+    size_t VHeadSize;                   ///< value/output head size
+    float Scale;
+    bool Causal = false;                ///< query row s sees key rows t <= s + KvLength - SequenceLength
+    ptrdiff_t LocalWindowSize = -1;     ///< when >= 0, query row s also needs t >= s + KvLength - SequenceLength - LocalWindowSize
+    const int32_t* KvSequenceLengths = nullptr;  ///< optional valid key rows per batch, else KvSequenceLength
+
+    const float* Q;
+    size_t ldq;
+    size_t QHeadStride;
+    size_t QBatchStride;
+    const float* K;
+    size_t ldk;
+    size_t KHeadStride;
+    size_t KBatchStride;
+    const float* V;
+    size_t ldv;
+    size_t VHeadStride;
+    size_t VBatchStride;
+    float* Output;
+    size_t ldo;
+    size_t OutputHeadStride;
+    size_t OutputBatchStride;
+
+    size_t KvBitWidth = 0;              ///< 0 for float keys and values, else 8 or 4
+    const uint8_t* QuantizedK = nullptr;
+    const uint8_t* QuantizedV = nullptr;
+
+    const int32_t* BlockTables = nullptr;  ///< optional cache block of each KvBlockSize key rows per batch
+    size_t BlockTableStride = 0;        ///< entries between the block tables of consecutive batches
+    size_t KvBlockSize = 0;             ///< key/value rows per cache block
+};
+
+/**
+ * @brief Fused attention, processing the keys and values in cache sized
+ *        blocks with an online softmax. Query rows with no visible key are
+ *        set to zero.
+ *
+ * @param Params        attention shapes and buffers
+ * @param ThreadPool    optional thread pool
+ */
+void
+MLASCALL
+MlasFlashAttention(
+    const MLAS_FLASH_ATTENTION_PARAMS* Params,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief Number of elements of a key/value cache row that share one scale.
+ */
+constexpr size_t MLAS_KV_CACHE_QUANT_BLOCK_SIZE = 32;
+
+/**
+ * @brief Returns the bytes of a key/value cache row of HeadSize elements
+ *        quantized to BitWidth bits, or 0 when BitWidth is not 8 or 4.
+ *
+ * A row holds a float scale per block of MLAS_KV_CACHE_QUANT_BLOCK_SIZE
+ * elements followed by the symmetric signed values, one per byte for 8 bits
+ * or two per byte, low nibble first, for 4 bits. The size is a multiple of
+ * sizeof(float) so that consecutive rows keep their scales aligned.
+ *
+ * @param HeadSize      elements per row
+ * @param BitWidth      8 or 4
+ */
+size_t
+MLASCALL
+MlasKvCacheQuantRowSize(
+    size_t HeadSize,
+    size_t BitWidth
+    );
+
+/**
+ * @brief Quantizes rows of keys or values into the key/value cache row
+ *        format of MlasKvCacheQuantRowSize, as consumed by
+ *        MlasFlashAttention when KvBitWidth is nonzero.
+ *
+ * @param Input         first input row
+ * @param ldi           elements between input rows
+ * @param Output        first output row
+ * @param ldo           bytes between output rows, at least the row size
+ * @param RowCount      number of rows
+ * @param HeadSize      elements per row
+ * @param BitWidth      8 or 4
+ */
+void
+MLASCALL
+MlasQuantizeKvCacheRows(
+    const float* Input,
+    size_t ldi,
+    uint8_t* Output,
+    size_t ldo,
+    size_t RowCount,
+    size_t HeadSize,
+    size_t BitWidth
+    );
+
 //
 // Half-precision floating-point routines.
 //
@@ -1652,6 +2374,90 @@ MlasTranspose(
         M, N);
 }
 
+/**
+ * @brief Layer normalization of one fp16 row, see the float overload. The row
+ *        is normalized in single precision.
+ */
+void
+MLASCALL
+MlasLayerNormalization(
+    const MLAS_FP16* Input,
+    const MLAS_FP16* Skip,
+    const MLAS_FP16* Bias,
+    const MLAS_FP16* Scale,
+    const MLAS_FP16* Shift,
+    MLAS_FP16* Output,
+    MLAS_FP16* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    );
+
+/**
+ * @brief Single pass activation functions of an fp16 buffer, see the float
+ *        overloads. The activation is computed in single precision a block at
+ *        a time.
+ */
+void
+MLASCALL
+MlasComputeGelu(
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasComputeFastGelu(
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasComputeSwish(
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t N,
+    float Alpha
+    );
+
+void
+MLASCALL
+MlasComputeSoftplus(
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t N
+    );
+
+/**
+ * @brief Reductions of an fp16 matrix, see the float overloads. The input is
+ *        widened to single precision a block at a time.
+ */
+void
+MLASCALL
+MlasReduceLastAxis(
+    MLAS_REDUCE_KIND ReduceKind,
+    const MLAS_FP16* Input,
+    float* Output,
+    size_t Rows,
+    size_t Columns
+    );
+
+void
+MLASCALL
+MlasReduceFirstAxis(
+    MLAS_REDUCE_KIND ReduceKind,
+    const MLAS_FP16* Input,
+    float* Output,
+    size_t Rows,
+    size_t Columns,
+    size_t ldInput
+    );
+
 #ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
 /**
  * @brief Max Pooling for fp16 NHWC
@@ -1691,4 +2497,37 @@ MlasNhwcAvgPool(
     size_t KernelSize
     );
 
+/**
+ * @brief Element wise addition of fp16 buffers
+ * @param Left          Supplies the left operand, N elements
+ * @param Right         Supplies the right operand, N elements or a single
+ *                      element when RightIsScalar is set
+ * @param Output        Supplies the output buffer, may alias an operand
+ * @param N             Number of elements to process
+ * @param RightIsScalar Broadcast the single right operand
+ * @return
+*/
+void
+MLASCALL
+MlasEltwiseAdd(
+    const MLAS_FP16* Left,
+    const MLAS_FP16* Right,
+    MLAS_FP16* Output,
+    size_t N,
+    bool RightIsScalar
+    );
+
+/**
+ * @brief Element wise multiplication of fp16 buffers, see MlasEltwiseAdd
+*/
+void
+MLASCALL
+MlasEltwiseMul(
+    const MLAS_FP16* Left,
+    const MLAS_FP16* Right,
+    MLAS_FP16* Output,
+    size_t N,
+    bool RightIsScalar
+    );
+
 #endif
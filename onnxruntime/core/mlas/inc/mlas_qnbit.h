@@ -23,6 +23,17 @@ Abstract:
 #include "mlas.h"
 #include "mlas_gemm_postprocessor.h"
 
+/**
+ * @brief Define compute types of block quantization
+ */
+typedef enum {
+    CompUndef = 0, /*!< undef */
+    CompFp32 = 1,  /*!< input fp32, accumulator fp32 */
+    CompFp16 = 2,  /*!< input fp16, accumulator fp16 */
+    CompBf16 = 3,  /*!< input bf16, accumulator fp32 */
+    CompInt8 = 4   /*!< input int8, accumulator int32 */
+} MLAS_SQNBIT_COMPUTE_TYPE;
+
 /**
  * @brief Data parameters for float/n-bit quantized int GEMM routine.
  */
@@ -52,6 +63,8 @@ struct MLAS_SQNBIT_GEMM_DATA_PARAMS {
  * @param[in]       BatchN          number of batches
  * @param[in]       BlkBitWidth     quantized value bit width (e.g., 4 means 4 bit ints)
  * @param[in]       BlkLen          number of quantized values per block
+ * @param[in]       ComputeType     CompInt8 quantizes the rows of A to int8 blocks of BlkLen values and accumulates
+ *                                  their products with B in int32, any other type computes in fp32
  * @param[inout]    DataParams      An array (size BatchN) of parameter blocks
  * @param[in]       ThreadPool      optional thread pool to use
  */
@@ -63,6 +76,7 @@ MlasSQNBitGemmBatch(
     size_t BatchN,
     size_t BlkBitWidth,
     size_t BlkLen,
+    MLAS_SQNBIT_COMPUTE_TYPE ComputeType,
     const MLAS_SQNBIT_GEMM_DATA_PARAMS* DataParams,
     MLAS_THREADPOOL* ThreadPool = nullptr
 );
@@ -71,24 +85,15 @@ MlasSQNBitGemmBatch(
  * @brief Determines whether a float32/quantized n-bit int GEMM implementation is available on the current platform.
  * @param[in]   BlkBitWidth     quantized value bit width (e.g., 4 means 4 bit ints)
  * @param[in]   BlkLen          number of quantized values per block
+ * @param[in]   ComputeType     compute type, see MlasSQNBitGemmBatch
  */
 bool MLASCALL
 MlasIsSQNBitGemmAvailable(
     size_t BlkBitWidth,
-    size_t BlkLen
+    size_t BlkLen,
+    MLAS_SQNBIT_COMPUTE_TYPE ComputeType
 );
 
-/**
- * @brief Define compute types of block quantization
- */
-typedef enum {
-    CompUndef = 0, /*!< undef */
-    CompFp32 = 1,  /*!< input fp32, accumulator fp32 */
-    CompFp16 = 2,  /*!< input fp16, accumulator fp16 */
-    CompBf16 = 3,  /*!< input bf16, accumulator fp32 */
-    CompInt8 = 4   /*!< input int8, accumulator int32 */
-} MLAS_SQNBIT_COMPUTE_TYPE;
-
 /**
  * @brief Data parameters for NBits GEMM routine
  *        C = A * B
@@ -10,7 +10,8 @@ Module Name:
 
 Abstract:
 
-    This module implements the fused activation and bias addition routines.
+    This module implements the fused activation and bias addition routines,
+    and the epilogue processor of the single precision GEMM.
 
 --*/
 
@@ -512,6 +513,33 @@ Return Value:
             break;
         }
 
+        case MlasGeluActivation:
+        case MlasFastGeluActivation:
+        case MlasSiluActivation:
+        {
+            if (Bias != nullptr) {
+                MlasActivationKernel<MlasIdentityActivation, true>(Activation, Buffer, Bias, M, N, ldc);
+            }
+
+            if (N == ldc) {
+                N *= M;
+                ldc = N;
+                M = 1;
+            }
+
+            for (; M > 0; M--, Buffer += ldc) {
+                if (Activation->ActivationKind == MlasGeluActivation) {
+                    MlasComputeGelu(Buffer, Buffer, N);
+                } else if (Activation->ActivationKind == MlasFastGeluActivation) {
+                    MlasComputeFastGelu(Buffer, Buffer, N);
+                } else {
+                    MlasComputeSwish(Buffer, Buffer, N, 1.0f);
+                }
+            }
+
+            break;
+        }
+
         case MlasActivationKindCount:
         {
             MLAS_THROW_EX(std::runtime_error, "bad mlas activation kind");
@@ -519,3 +547,134 @@ Return Value:
         }
     }
 }
+
+MLAS_FORCEINLINE
+void
+MlasEpilogueAddRow(
+    float* Row,
+    const float* Addend0,
+    const float* Addend1,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine adds one or two rows to a row of the output matrix.
+
+Arguments:
+
+    Row - Supplies the row of the output matrix.
+
+    Addend0 - Supplies the first row to add.
+
+    Addend1 - Optionally supplies the second row to add.
+
+    N - Supplies the number of elements of the rows.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t n = 0;
+
+    if (Addend1 != nullptr) {
+
+        for (; n + 4 <= N; n += 4) {
+            MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Row + n);
+            Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Addend0 + n));
+            Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Addend1 + n));
+            MlasStoreFloat32x4(Row + n, Vector);
+        }
+
+        for (; n < N; n++) {
+            Row[n] += Addend0[n] + Addend1[n];
+        }
+
+    } else {
+
+        for (; n + 4 <= N; n += 4) {
+            MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Row + n);
+            MlasStoreFloat32x4(Row + n, MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Addend0 + n)));
+        }
+
+        for (; n < N; n++) {
+            Row[n] += Addend0[n];
+        }
+    }
+}
+
+void
+MLAS_SGEMM_EPILOGUE_PROCESSOR::Process(
+    float* C,
+    size_t StartM,
+    size_t StartN,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc
+    ) const
+/*++
+
+Routine Description:
+
+    This routine applies the bias addition, the activation and the residual
+    addition to a block of the output matrix.
+
+Arguments:
+
+    C - Supplies the address of the output matrix.
+
+    StartM - Supplies the first row of the block.
+
+    StartN - Supplies the first column of the block.
+
+    CountM - Supplies the number of rows of the block.
+
+    CountN - Supplies the number of columns of the block.
+
+    ldc - Supplies the number of elements per row of the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const bool HasActivation = (Activation_ != nullptr && Activation_->ActivationKind != MlasIdentityActivation);
+
+    float* Row = C + StartM * ldc + StartN;
+    const float* Bias = (Bias_ != nullptr) ? Bias_ + StartN : nullptr;
+    const float* Residual = (Residual_ != nullptr) ? Residual_ + StartM * ldr_ + StartN : nullptr;
+
+    for (size_t m = 0; m < CountM; m++) {
+
+        if (HasActivation) {
+
+            if (Bias != nullptr) {
+                MlasEpilogueAddRow(Row, Bias, nullptr, CountN);
+            }
+
+            MlasActivation(Activation_, Row, nullptr, 1, CountN, CountN);
+
+            if (Residual != nullptr) {
+                MlasEpilogueAddRow(Row, Residual, nullptr, CountN);
+            }
+
+        } else if (Bias != nullptr) {
+
+            MlasEpilogueAddRow(Row, Bias, Residual, CountN);
+
+        } else if (Residual != nullptr) {
+
+            MlasEpilogueAddRow(Row, Residual, nullptr, CountN);
+        }
+
+        Row += ldc;
+
+        if (Residual != nullptr) {
+            Residual += ldr_;
+        }
+    }
+}
@@ -868,6 +868,9 @@ MLAS_HALF_GEMM_ACTIVATION_PROCESSOR::Process(
     Output += StartM * ldc + StartN;
 
     while (CountM-- > 0) {
+        for (size_t n = 0; n < CountN; n++) {
+            CRow[n] = MLAS_Half2Float(Output[n]);
+        }
         if (CAdd) {
             for (size_t n = 0; n < CountN; n++) {
                 CRow[n] += MLAS_Half2Float(CAdd[n]);
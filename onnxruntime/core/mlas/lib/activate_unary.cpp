@@ -0,0 +1,416 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    activate_unary.cpp
+
+Abstract:
+
+    This module implements routines to compute the GELU, fast GELU, Swish
+    (SiLU) and Softplus activation functions of a buffer.
+
+    Each activation is computed in a single pass over memory: the gate of a
+    block of the input is computed into a local buffer by one of the
+    vectorized transcendental routines, then the block is combined with the
+    gate while it is still in the cache.
+
+    The half precision routines widen a block of the input to single
+    precision, compute the activation of the block in single precision and
+    narrow the result.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Kinds of the single pass activation functions.
+//
+
+enum MLAS_UNARY_ACTIVATION_KIND {
+    MlasUnaryGelu,
+    MlasUnaryFastGelu,
+    MlasUnarySwish,
+    MlasUnarySoftplus,
+};
+
+constexpr size_t MLAS_UNARY_ACTIVATION_BLOCK_SIZE = 256;
+
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasComputeLog1pSmallVector(
+    MLAS_FLOAT32X4 Vector
+    )
+/*++
+
+Routine Description:
+
+    This routine computes log(1 + x) for the supplied vector of values in the
+    range [0, 1].
+
+    The value is computed as 2 * atanh(s) with s = x / (2 + x), which is at
+    most 1/3 in this range, so the odd series of atanh converges to single
+    precision accuracy in seven terms.
+
+Arguments:
+
+    Vector - Supplies the values to operate on.
+
+Return Value:
+
+    Returns log(1 + x) of the input.
+
+--*/
+{
+    const MLAS_FLOAT32X4 s = MlasDivideFloat32x4(Vector, MlasAddFloat32x4(Vector, MlasBroadcastFloat32x4(2.0f)));
+    const MLAS_FLOAT32X4 z = MlasMultiplyFloat32x4(s, s);
+
+    MLAS_FLOAT32X4 p = MlasBroadcastFloat32x4(1.0f / 13.0f);
+    p = MlasMultiplyAddFloat32x4(p, z, MlasBroadcastFloat32x4(1.0f / 11.0f));
+    p = MlasMultiplyAddFloat32x4(p, z, MlasBroadcastFloat32x4(1.0f / 9.0f));
+    p = MlasMultiplyAddFloat32x4(p, z, MlasBroadcastFloat32x4(1.0f / 7.0f));
+    p = MlasMultiplyAddFloat32x4(p, z, MlasBroadcastFloat32x4(1.0f / 5.0f));
+    p = MlasMultiplyAddFloat32x4(p, z, MlasBroadcastFloat32x4(1.0f / 3.0f));
+    p = MlasMultiplyAddFloat32x4(p, z, MlasBroadcastFloat32x4(1.0f));
+
+    return MlasMultiplyFloat32x4(MlasAddFloat32x4(s, s), p);
+}
+
+template<MLAS_UNARY_ACTIVATION_KIND ActivationKind>
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasUnaryActivationGateInput(
+    MLAS_FLOAT32X4 Vector,
+    MLAS_FLOAT32X4 AlphaBroadcast
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the argument of the transcendental gate function for
+    the supplied vector.
+
+Arguments:
+
+    Vector - Supplies the input values.
+
+    AlphaBroadcast - Supplies the broadcast scale of the Swish activation.
+
+Return Value:
+
+    Returns the argument of the gate function.
+
+--*/
+{
+    if (ActivationKind == MlasUnaryGelu) {
+
+        return MlasMultiplyFloat32x4(Vector, MlasBroadcastFloat32x4(0.7071067811865476f));
+
+    } else if (ActivationKind == MlasUnaryFastGelu) {
+
+        const MLAS_FLOAT32X4 B = MlasBroadcastFloat32x4(0.7978845608028654f);     // sqrt(2 / pi)
+        const MLAS_FLOAT32X4 C = MlasBroadcastFloat32x4(0.035677408136300125f);   // 0.044715 * sqrt(2 / pi)
+
+        return MlasMultiplyFloat32x4(Vector, MlasMultiplyAddFloat32x4(MlasMultiplyFloat32x4(Vector, Vector), C, B));
+
+    } else if (ActivationKind == MlasUnarySwish) {
+
+        return MlasMultiplyFloat32x4(Vector, AlphaBroadcast);
+
+    } else {
+
+        //
+        // exp(-|x|) is in the range (0, 1], so the gate never overflows.
+        //
+
+        return MlasSubtractFloat32x4(MlasZeroFloat32x4(), MlasAndNotFloat32x4(MlasBroadcastFloat32x4(-0.0f), Vector));
+    }
+}
+
+template<MLAS_UNARY_ACTIVATION_KIND ActivationKind>
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasUnaryActivationCombine(
+    MLAS_FLOAT32X4 Vector,
+    MLAS_FLOAT32X4 Gate
+    )
+/*++
+
+Routine Description:
+
+    This routine combines the supplied vector with its gate.
+
+Arguments:
+
+    Vector - Supplies the input values.
+
+    Gate - Supplies the gate of the input values.
+
+Return Value:
+
+    Returns the activation of the input.
+
+--*/
+{
+    if (ActivationKind == MlasUnaryGelu || ActivationKind == MlasUnaryFastGelu) {
+
+        //
+        // The erf and tanh gates are mapped from [-1, 1] to [0, 1].
+        //
+
+        const MLAS_FLOAT32X4 HalfBroadcast = MlasBroadcastFloat32x4(0.5f);
+
+        return MlasMultiplyFloat32x4(Vector, MlasMultiplyAddFloat32x4(Gate, HalfBroadcast, HalfBroadcast));
+
+    } else if (ActivationKind == MlasUnarySwish) {
+
+        return MlasMultiplyFloat32x4(Vector, Gate);
+
+    } else {
+
+        //
+        // softplus(x) = max(x, 0) + log(1 + exp(-|x|)).
+        //
+
+        return MlasAddFloat32x4(MlasMaximumFloat32x4(Vector, MlasZeroFloat32x4()), MlasComputeLog1pSmallVector(Gate));
+    }
+}
+
+template<MLAS_UNARY_ACTIVATION_KIND ActivationKind>
+void
+MlasUnaryActivationKernel(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Alpha
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a single pass activation function of a buffer.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    Alpha - Supplies the scale of the Swish activation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float Gate[MLAS_UNARY_ACTIVATION_BLOCK_SIZE], 64);
+
+    const MLAS_FLOAT32X4 AlphaBroadcast = MlasBroadcastFloat32x4(Alpha);
+
+    for (size_t n = 0; n < N; n += MLAS_UNARY_ACTIVATION_BLOCK_SIZE) {
+
+        const float* input = Input + n;
+        float* output = Output + n;
+        const size_t CountN = std::min(N - n, MLAS_UNARY_ACTIVATION_BLOCK_SIZE);
+
+        //
+        // Compute the gate of the block. The remainder of the block is
+        // computed a vector at a time so that the tail uses the same
+        // approximations as the body.
+        //
+
+        for (size_t i = 0; i < CountN; i += 4) {
+
+            MLAS_FLOAT32X4 Vector;
+
+            if (i + 4 <= CountN) {
+                Vector = MlasLoadFloat32x4(input + i);
+            } else {
+                float Tail[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+                std::copy_n(input + i, CountN - i, Tail);
+                Vector = MlasLoadFloat32x4(Tail);
+            }
+
+            MlasStoreAlignedFloat32x4(Gate + i, MlasUnaryActivationGateInput<ActivationKind>(Vector, AlphaBroadcast));
+        }
+
+        const size_t GateCount = (CountN + 3) & ~size_t(3);
+
+        if (ActivationKind == MlasUnaryGelu) {
+            MlasComputeErf(Gate, Gate, GateCount);
+        } else if (ActivationKind == MlasUnaryFastGelu) {
+            MlasComputeTanh(Gate, Gate, GateCount);
+        } else if (ActivationKind == MlasUnarySwish) {
+            MlasComputeLogistic(Gate, Gate, GateCount);
+        } else {
+            MlasComputeExp(Gate, Gate, GateCount);
+        }
+
+        //
+        // Combine the block with the gate.
+        //
+
+        size_t i = 0;
+
+        for (; i + 4 <= CountN; i += 4) {
+            MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(input + i);
+            MLAS_FLOAT32X4 GateVector = MlasLoadFloat32x4(Gate + i);
+            MlasStoreFloat32x4(output + i, MlasUnaryActivationCombine<ActivationKind>(Vector, GateVector));
+        }
+
+        if (i < CountN) {
+            float Tail[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            std::copy_n(input + i, CountN - i, Tail);
+            MLAS_FLOAT32X4 GateVector = MlasLoadFloat32x4(Gate + i);
+            MlasStoreFloat32x4(Tail, MlasUnaryActivationCombine<ActivationKind>(MlasLoadFloat32x4(Tail), GateVector));
+            std::copy_n(Tail, CountN - i, output + i);
+        }
+    }
+}
+
+template<MLAS_UNARY_ACTIVATION_KIND ActivationKind>
+void
+MlasUnaryActivationKernel(
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t N,
+    float Alpha
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a single pass activation function of a half
+    precision buffer in single precision.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    Alpha - Supplies the scale of the Swish activation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float Buffer[MLAS_UNARY_ACTIVATION_BLOCK_SIZE], 64);
+
+    for (size_t n = 0; n < N; n += MLAS_UNARY_ACTIVATION_BLOCK_SIZE) {
+
+        const size_t CountN = std::min(N - n, MLAS_UNARY_ACTIVATION_BLOCK_SIZE);
+
+        MlasConvertHalfToFloatBuffer(reinterpret_cast<const unsigned short*>(Input + n), Buffer, CountN);
+
+        MlasUnaryActivationKernel<ActivationKind>(Buffer, Buffer, CountN, Alpha);
+
+        for (size_t i = 0; i < CountN; i++) {
+            Output[n + i] = MLAS_FP16(Buffer[i]);
+        }
+    }
+}
+
+void
+MLASCALL
+MlasComputeGelu(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    MlasUnaryActivationKernel<MlasUnaryGelu>(Input, Output, N, 1.0f);
+}
+
+void
+MLASCALL
+MlasComputeGelu(
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t N
+    )
+{
+    MlasUnaryActivationKernel<MlasUnaryGelu>(Input, Output, N, 1.0f);
+}
+
+void
+MLASCALL
+MlasComputeFastGelu(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    MlasUnaryActivationKernel<MlasUnaryFastGelu>(Input, Output, N, 1.0f);
+}
+
+void
+MLASCALL
+MlasComputeFastGelu(
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t N
+    )
+{
+    MlasUnaryActivationKernel<MlasUnaryFastGelu>(Input, Output, N, 1.0f);
+}
+
+void
+MLASCALL
+MlasComputeSwish(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Alpha
+    )
+{
+    MlasUnaryActivationKernel<MlasUnarySwish>(Input, Output, N, Alpha);
+}
+
+void
+MLASCALL
+MlasComputeSwish(
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t N,
+    float Alpha
+    )
+{
+    MlasUnaryActivationKernel<MlasUnarySwish>(Input, Output, N, Alpha);
+}
+
+void
+MLASCALL
+MlasComputeSoftplus(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    MlasUnaryActivationKernel<MlasUnarySoftplus>(Input, Output, N, 1.0f);
+}
+
+void
+MLASCALL
+MlasComputeSoftplus(
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t N
+    )
+{
+    MlasUnaryActivationKernel<MlasUnarySoftplus>(Input, Output, N, 1.0f);
+}
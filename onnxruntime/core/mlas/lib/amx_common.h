@@ -55,7 +55,7 @@ tile_dpbusd_internal(dst,src1,src2)
   __asm__ volatile (".set ModRMByte, 0x04\n\t" 		\
 	".set ModRMByte, ModRMByte + ("#dst" << 3)\n\t"     \
 	".byte 0xC4, 0xE2, 0x7B, 0x4B, ModRMByte, 0x18\n\t" \
-   :: "a" ((const void*) (base)), "b" ((long) (stride)))
+   :: "a" ((const void*) (base)), "b" ((long) (stride)) : "memory")
 
 #define tile_loadd(dst,base,stride)					\
   tile_loadd_internal1(dst, base, stride)
@@ -65,16 +65,53 @@ tile_dpbusd_internal(dst,src1,src2)
   __asm__ volatile (".set ModRMByte, 0x04\n\t" 		\
 	".set ModRMByte, ModRMByte + ("#dst" << 3)\n\t"     \
 	".byte 0xC4, 0xE2, 0x7A, 0x4B, ModRMByte, 0x18\n\t" \
-   :: "a" ((const void*) (base)), "b" ((long) (stride)))
+   :: "a" ((const void*) (base)), "b" ((long) (stride)) : "memory")
 
 #define tile_stored(dst,base,stride)					\
 tile_stored_internal1(dst, base, stride)
 
 
 #define tile_loadconfig(config)						\
-__asm__ volatile (".byte 0xC4, 0xE2, 0x78, 0x49, 0x00" :: "a" (((const void *)config)))  \
+__asm__ volatile (".byte 0xC4, 0xE2, 0x78, 0x49, 0x00" :: "a" (((const void *)config)) : "memory")  \
 
 #define tile_storeconfig(config)					\
-__asm__ volatile (".byte 0xC4, 0xE2, 0x79, 0x49, 0x00" :: "a" (((const void *)config)))  \
+__asm__ volatile (".byte 0xC4, 0xE2, 0x79, 0x49, 0x00" :: "a" (((const void *)config)) : "memory")  \
 
 #endif
+
+// Tile configure structure
+struct tileconfig_t {
+    uint8_t palette_id = 0;
+    uint8_t start_row = 0;
+    uint8_t reserved1[14] = {0};
+    uint16_t colb[8] = {0};
+    uint8_t reserved2[16] = {0};
+    uint8_t rows[8] = {0};
+    uint8_t reserved3[8] = {0};
+};
+
+/**
+ * @brief Configure all eight tiles of the calling thread as 16 rows of 64
+ *        bytes, unless they are already configured so.
+ *
+ */
+MLAS_FORCEINLINE
+void
+MlasAmxLoadTileConfig()
+{
+    static thread_local struct tileconfig_t tc = {0};
+    struct tileconfig_t current_tc = {0};
+    tile_storeconfig(&current_tc);
+
+    if (tc.palette_id == 0 || (std::memcmp(&current_tc.colb, &tc.colb, sizeof(uint16_t) * 8) != 0 &&
+                               std::memcmp(&current_tc.rows, &tc.rows, sizeof(uint8_t) * 8) != 0)) {
+        // Filling tile configure structure.
+        tc.palette_id = 1;
+        for (int t = 0; t < 8; t++) {
+            tc.rows[t] = 16;
+            tc.colb[t] = 64;
+        }
+
+        tile_loadconfig(&tc);
+    }
+}
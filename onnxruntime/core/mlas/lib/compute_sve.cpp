@@ -0,0 +1,604 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    compute_sve.cpp
+
+Abstract:
+
+    This module implements the SVE kernels for the exponential, logistic and
+    hyperbolic tangent functions and for the reductions of the softmax
+    operation.
+
+    The kernels use the same algorithms and constants as the generic kernels in
+    compute.cpp, logistic.cpp and tanh.cpp. They are vector length agnostic:
+    each iteration processes svcntw() elements and the tail of the buffer is
+    processed by the same loop under a partial predicate, so a processor with
+    256-bit vectors processes twice as many elements per instruction as the
+    NEON kernels.
+
+    N.B. This module must be compiled with SVE enabled (-march=armv8.2-a+sve)
+    and is only called when the processor supports SVE.
+
+--*/
+
+#include "mlasi.h"
+
+#include <arm_sve.h>
+
+//
+// The constants of the generic kernels are bundled in structures of unnamed
+// type for use by kernels written in assembly, so they are repeated here.
+//
+
+namespace {
+
+const struct {
+    float LowerRange;
+    float UpperRange;
+    float LowerRangeSumExp;
+    float UpperRangeSumExp;
+    float RoundingBias;
+    float Log2Reciprocal;
+    float Log2High;
+    float Log2Low;
+    float poly_0;
+    float poly_1;
+    float poly_2;
+    float poly_3;
+    float poly_4;
+    float poly_56;
+    int32_t MinimumExponent;
+    int32_t MaximumExponent;
+} ExpConstants = {
+    -103.9720840454f,
+    88.7762626647950f,
+    -88.3762626647949f,
+    88.3762626647949f,
+    MLAS_ROUNDING_BIAS_MAGIC,
+    1.44269504088896341f,
+    -6.93145752e-1f,
+    -1.42860677e-6f,
+    0x1.694000p-10,
+    0x1.125edcp-7,
+    0x1.555b5ap-5,
+    0x1.555450p-3,
+    0x1.fffff6p-2,
+    0x1.000000p+0,
+    int32_t(0xC1000000),
+    int32_t(0x3F800000),
+};
+
+const struct {
+    float LowerRange;
+    float UpperRange;
+    float alpha_9;
+    float alpha_7;
+    float alpha_5;
+    float alpha_3;
+    float alpha_1;
+    float beta_10;
+    float beta_8;
+    float beta_6;
+    float beta_4;
+    float beta_2;
+    float beta_0;
+    float one_half;
+} LogisticConstants = {
+    -18.0f,
+    18.0f,
+    4.37031012579801e-11f,
+    1.15627324459942e-07f,
+    6.08574864600143e-05f,
+    8.51377133304701e-03f,
+    2.48287947061529e-01f,
+    6.10247389755681e-13f,
+    5.76102136993427e-09f,
+    6.29106785017040e-06f,
+    1.70198817374094e-03f,
+    1.16817656904453e-01f,
+    9.93151921023180e-01f,
+    0.5f,
+};
+
+const struct {
+    float LowerRange;
+    float UpperRange;
+    float alpha_13;
+    float alpha_11;
+    float alpha_9;
+    float alpha_7;
+    float alpha_5;
+    float alpha_3;
+    float alpha_1;
+    float beta_6;
+    float beta_4;
+    float beta_2;
+    float beta_0;
+} TanhConstants = {
+    -9.0f,
+    9.0f,
+    -2.76076847742355e-16f,
+    2.00018790482477e-13f,
+    -8.60467152213735e-11f,
+    5.12229709037114e-08f,
+    1.48572235717979e-05f,
+    6.37261928875436e-04f,
+    4.89352455891786e-03f,
+    1.19825839466702e-06f,
+    1.18534705686654e-04f,
+    2.26843463243900e-03f,
+    4.89352518554385e-03f,
+};
+
+MLAS_FORCEINLINE
+svfloat32_t
+MlasComputeExpVectorSve(
+    svbool_t Predicate,
+    svfloat32_t Vector
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function for the supplied vector,
+    see MlasComputeExpVector.
+
+Arguments:
+
+    Predicate - Supplies the active elements of the vector.
+
+    Vector - Supplies the values to operate on.
+
+Return Value:
+
+    Returns the exponential function of the input.
+
+--*/
+{
+    Vector = svmax_n_f32_x(Predicate, Vector, ExpConstants.LowerRange);
+    Vector = svmin_n_f32_x(Predicate, Vector, ExpConstants.UpperRange);
+
+    //
+    // Range reduction of the input by computing "(2 ^ m) * exp(reduced)".
+    //
+
+    const svfloat32_t RoundingBias = svdup_n_f32(ExpConstants.RoundingBias);
+
+    svfloat32_t biased = svmla_n_f32_x(Predicate, RoundingBias, Vector, ExpConstants.Log2Reciprocal);
+    svfloat32_t m = svsub_f32_x(Predicate, biased, RoundingBias);
+
+    Vector = svmla_n_f32_x(Predicate, Vector, m, ExpConstants.Log2High);
+    Vector = svmla_n_f32_x(Predicate, Vector, m, ExpConstants.Log2Low);
+
+    //
+    // Compute the scaling factors used to reconstruct the "(2 ^ m)" value
+    // from above. To cover the entire single precision floating point range,
+    // two scaling factors are needed to handle exponents [-150, 128].
+    //
+
+    svint32_t overflow = svlsl_n_s32_x(Predicate, svreinterpret_s32_f32(biased), 23);
+    svint32_t normal = svmin_n_s32_x(Predicate, overflow, ExpConstants.MaximumExponent);
+    normal = svmax_n_s32_x(Predicate, normal, ExpConstants.MinimumExponent);
+    overflow = svsub_s32_x(Predicate, overflow, normal);
+    overflow = svadd_n_s32_x(Predicate, overflow, ExpConstants.MaximumExponent);
+    normal = svadd_n_s32_x(Predicate, normal, ExpConstants.MaximumExponent);
+
+    //
+    // Compute the polynomial approximation of exp(reduced) and reconstruct
+    // the final result using the above scaling factors. The final term of
+    // the polynomial (poly_6=1.0f) is merged as the multiply/add of the
+    // overflow exponent (reference XNNPACK).
+    //
+
+    svfloat32_t p = svdup_n_f32(ExpConstants.poly_0);
+    p = svmad_n_f32_x(Predicate, p, Vector, ExpConstants.poly_1);
+    p = svmad_n_f32_x(Predicate, p, Vector, ExpConstants.poly_2);
+    p = svmad_n_f32_x(Predicate, p, Vector, ExpConstants.poly_3);
+    p = svmad_n_f32_x(Predicate, p, Vector, ExpConstants.poly_4);
+    p = svmad_n_f32_x(Predicate, p, Vector, ExpConstants.poly_56);
+
+    Vector = svmul_f32_x(Predicate, Vector, svreinterpret_f32_s32(overflow));
+    p = svmad_f32_x(Predicate, p, Vector, svreinterpret_f32_s32(overflow));
+    p = svmul_f32_x(Predicate, p, svreinterpret_f32_s32(normal));
+
+    return p;
+}
+
+MLAS_FORCEINLINE
+svfloat32_t
+MlasComputeSumExpVectorSve(
+    svbool_t Predicate,
+    svfloat32_t Vector,
+    float NegativeMaximum
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function for the supplied vector
+    once reduced by the maximum value, see MlasComputeSumExpVector.
+
+Arguments:
+
+    Predicate - Supplies the active elements of the vector.
+
+    Vector - Supplies the values to operate on.
+
+    NegativeMaximum - Supplies the negative maximum value that is added to
+        each element before computing the exponential function.
+
+Return Value:
+
+    Returns the exponential function of the input.
+
+--*/
+{
+    Vector = svadd_n_f32_x(Predicate, Vector, NegativeMaximum);
+    Vector = svmax_n_f32_x(Predicate, Vector, ExpConstants.LowerRangeSumExp);
+
+    const svfloat32_t RoundingBias = svdup_n_f32(ExpConstants.RoundingBias);
+
+    svfloat32_t biased = svmla_n_f32_x(Predicate, RoundingBias, Vector, ExpConstants.Log2Reciprocal);
+    svfloat32_t m = svsub_f32_x(Predicate, biased, RoundingBias);
+
+    Vector = svmla_n_f32_x(Predicate, Vector, m, ExpConstants.Log2High);
+    Vector = svmla_n_f32_x(Predicate, Vector, m, ExpConstants.Log2Low);
+
+    svint32_t normal = svlsl_n_s32_x(Predicate, svreinterpret_s32_f32(biased), 23);
+    normal = svadd_n_s32_x(Predicate, normal, ExpConstants.MaximumExponent);
+
+    svfloat32_t p = svdup_n_f32(ExpConstants.poly_0);
+    p = svmad_n_f32_x(Predicate, p, Vector, ExpConstants.poly_1);
+    p = svmad_n_f32_x(Predicate, p, Vector, ExpConstants.poly_2);
+    p = svmad_n_f32_x(Predicate, p, Vector, ExpConstants.poly_3);
+    p = svmad_n_f32_x(Predicate, p, Vector, ExpConstants.poly_4);
+    p = svmad_n_f32_x(Predicate, p, Vector, ExpConstants.poly_56);
+    p = svmad_n_f32_x(Predicate, p, Vector, ExpConstants.poly_56);
+
+    p = svmul_f32_x(Predicate, p, svreinterpret_f32_s32(normal));
+
+    return p;
+}
+
+}  // namespace
+
+void
+MLASCALL
+MlasComputeExpF32KernelSve(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the SVE kernel for the exponential function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t n = 0; n < N; n += svcntw()) {
+
+        const svbool_t Predicate = svwhilelt_b32_u64(n, N);
+
+        svfloat32_t Vector = svld1_f32(Predicate, Input + n);
+        svst1_f32(Predicate, Output + n, MlasComputeExpVectorSve(Predicate, Vector));
+    }
+}
+
+void
+MLASCALL
+MlasComputeLogisticF32KernelSve(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the SVE kernel for the logistic function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t n = 0; n < N; n += svcntw()) {
+
+        const svbool_t Predicate = svwhilelt_b32_u64(n, N);
+
+        svfloat32_t Value = svld1_f32(Predicate, Input + n);
+
+        // N.B. FMAX and FMIN return a NaN input unmodified.
+        Value = svmax_n_f32_x(Predicate, Value, LogisticConstants.LowerRange);
+        Value = svmin_n_f32_x(Predicate, Value, LogisticConstants.UpperRange);
+
+        svfloat32_t ValueSquared = svmul_f32_x(Predicate, Value, Value);
+
+        svfloat32_t p;
+        p = svmad_n_f32_x(Predicate, ValueSquared, svdup_n_f32(LogisticConstants.alpha_9), LogisticConstants.alpha_7);
+        p = svmad_n_f32_x(Predicate, p, ValueSquared, LogisticConstants.alpha_5);
+        p = svmad_n_f32_x(Predicate, p, ValueSquared, LogisticConstants.alpha_3);
+        p = svmad_n_f32_x(Predicate, p, ValueSquared, LogisticConstants.alpha_1);
+        p = svmul_f32_x(Predicate, p, Value);
+
+        svfloat32_t q;
+        q = svmad_n_f32_x(Predicate, ValueSquared, svdup_n_f32(LogisticConstants.beta_10), LogisticConstants.beta_8);
+        q = svmad_n_f32_x(Predicate, q, ValueSquared, LogisticConstants.beta_6);
+        q = svmad_n_f32_x(Predicate, q, ValueSquared, LogisticConstants.beta_4);
+        q = svmad_n_f32_x(Predicate, q, ValueSquared, LogisticConstants.beta_2);
+        q = svmad_n_f32_x(Predicate, q, ValueSquared, LogisticConstants.beta_0);
+
+        svfloat32_t Result = svadd_n_f32_x(Predicate, svdiv_f32_x(Predicate, p, q), LogisticConstants.one_half);
+
+        svst1_f32(Predicate, Output + n, Result);
+    }
+}
+
+void
+MLASCALL
+MlasComputeTanhF32KernelSve(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the SVE kernel for the hyperbolic tangent function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t n = 0; n < N; n += svcntw()) {
+
+        const svbool_t Predicate = svwhilelt_b32_u64(n, N);
+
+        svfloat32_t Value = svld1_f32(Predicate, Input + n);
+
+        // N.B. FMAX and FMIN return a NaN input unmodified.
+        Value = svmax_n_f32_x(Predicate, Value, TanhConstants.LowerRange);
+        Value = svmin_n_f32_x(Predicate, Value, TanhConstants.UpperRange);
+
+        svfloat32_t ValueSquared = svmul_f32_x(Predicate, Value, Value);
+
+        svfloat32_t p;
+        p = svmad_n_f32_x(Predicate, ValueSquared, svdup_n_f32(TanhConstants.alpha_13), TanhConstants.alpha_11);
+        p = svmad_n_f32_x(Predicate, p, ValueSquared, TanhConstants.alpha_9);
+        p = svmad_n_f32_x(Predicate, p, ValueSquared, TanhConstants.alpha_7);
+        p = svmad_n_f32_x(Predicate, p, ValueSquared, TanhConstants.alpha_5);
+        p = svmad_n_f32_x(Predicate, p, ValueSquared, TanhConstants.alpha_3);
+        p = svmad_n_f32_x(Predicate, p, ValueSquared, TanhConstants.alpha_1);
+        p = svmul_f32_x(Predicate, p, Value);
+
+        svfloat32_t q;
+        q = svmad_n_f32_x(Predicate, ValueSquared, svdup_n_f32(TanhConstants.beta_6), TanhConstants.beta_4);
+        q = svmad_n_f32_x(Predicate, q, ValueSquared, TanhConstants.beta_2);
+        q = svmad_n_f32_x(Predicate, q, ValueSquared, TanhConstants.beta_0);
+
+        svst1_f32(Predicate, Output + n, svdiv_f32_x(Predicate, p, q));
+    }
+}
+
+float
+MLASCALL
+MlasComputeSumExpF32KernelSve(
+    const float* Input,
+    float* Output,
+    size_t N,
+    const float* NegativeMaximum
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the SVE kernel for the sum of exponential
+    functions.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Optionally supplies the output buffer. When used for Softmax,
+        the output buffer is used to store the intermediate exp() results. When
+        used for LogSoftmax, the intermediate exp() results are not required.
+
+    N - Supplies the number of elements to process.
+
+    NegativeMaximum - Supplies the address of the negative maximum
+        value that is added to each element before computing the exponential
+        function.
+
+Return Value:
+
+    Returns the sum of the exponential functions.
+
+--*/
+{
+    const float NegativeMaximumValue = *NegativeMaximum;
+
+    svfloat32_t AccumulatorVector = svdup_n_f32(0.0f);
+
+    for (size_t n = 0; n < N; n += svcntw()) {
+
+        const svbool_t Predicate = svwhilelt_b32_u64(n, N);
+
+        svfloat32_t Vector = svld1_f32(Predicate, Input + n);
+
+        Vector = MlasComputeSumExpVectorSve(Predicate, Vector, NegativeMaximumValue);
+
+        //
+        // Merge the active elements only, the inactive elements of the tail
+        // are undefined.
+        //
+
+        AccumulatorVector = svadd_f32_m(Predicate, AccumulatorVector, Vector);
+
+        if (Output != nullptr) {
+            svst1_f32(Predicate, Output + n, Vector);
+        }
+    }
+
+    return svaddv_f32(svptrue_b32(), AccumulatorVector);
+}
+
+void
+MLASCALL
+MlasComputeSoftmaxOutputF32KernelSve(
+    float* Output,
+    size_t N,
+    const float* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the SVE kernel to produce the final output for
+    the softmax operation.
+
+Arguments:
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    Parameters - Supplies an array containing the scale value.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float Scale = Parameters[0];
+
+    for (size_t n = 0; n < N; n += svcntw()) {
+
+        const svbool_t Predicate = svwhilelt_b32_u64(n, N);
+
+        svfloat32_t Vector = svld1_f32(Predicate, Output + n);
+        svst1_f32(Predicate, Output + n, svmul_n_f32_x(Predicate, Vector, Scale));
+    }
+}
+
+void
+MLASCALL
+MlasComputeLogSoftmaxOutputF32KernelSve(
+    const float* Input,
+    float* Output,
+    size_t N,
+    const float* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the SVE kernel to produce the final output for
+    the log softmax operation.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    Parameters - Supplies an array containing the negative maximum and
+        logarithm values.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float NegativeMaximum = Parameters[0];
+    const float Logarithm = Parameters[1];
+
+    for (size_t n = 0; n < N; n += svcntw()) {
+
+        const svbool_t Predicate = svwhilelt_b32_u64(n, N);
+
+        svfloat32_t Vector = svld1_f32(Predicate, Input + n);
+        Vector = svadd_n_f32_x(Predicate, Vector, NegativeMaximum);
+        Vector = svsub_n_f32_x(Predicate, Vector, Logarithm);
+        svst1_f32(Predicate, Output + n, Vector);
+    }
+}
+
+float
+MLASCALL
+MlasReduceMaximumF32KernelSve(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the SVE kernel to find the maximum value of the
+    supplied buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    Returns the maximum value of the supplied buffer.
+
+--*/
+{
+    svfloat32_t MaximumVector = svdup_n_f32(std::numeric_limits<float>::lowest());
+
+    for (size_t n = 0; n < N; n += svcntw()) {
+
+        const svbool_t Predicate = svwhilelt_b32_u64(n, N);
+
+        MaximumVector = svmax_f32_m(Predicate, MaximumVector, svld1_f32(Predicate, Input + n));
+    }
+
+    return svmaxv_f32(svptrue_b32(), MaximumVector);
+}
@@ -592,7 +592,7 @@ Return Value:
 
             MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, CountN,
                 CountK, 1.0f, Filter + k, K, ColumnBuffer, CountN, beta,
-                SegmentOutput, OutputSize);
+                SegmentOutput, OutputSize, nullptr);
 
             beta = 1.0f;
         }
@@ -712,7 +712,7 @@ Return Value:
 
         MlasSgemmOperation(CblasNoTrans, Parameters->u.GemmDirect.TransB, FilterCount, OutputSize,
                            K, 1.0f, filter, K, input, Parameters->u.GemmDirect.ldb, Beta, output,
-                           OutputSize);
+                           OutputSize, nullptr);
 
         //
         // Apply the activation with optional bias.
@@ -903,6 +903,11 @@ Return Value:
         return;
     }
 
+    if (Algorithm == MlasConvAlgorithmWinograd) {
+        MlasConvWinograd(Parameters, Input, Bias, WorkingBuffer, Output, ThreadPool);
+        return;
+    }
+
 #if defined(MLAS_TARGET_WASM_SCALAR)
 
     if (Algorithm == MlasConvAlgorithmDepthwise) {
@@ -1002,6 +1007,15 @@ Return Value:
 
                     break;
                 }
+
+                case MlasConvAlgorithmWinograd:
+                {
+                    //
+                    // Handled above for all the batches and groups.
+                    //
+
+                    break;
+                }
             }
 
             //
@@ -1041,7 +1055,8 @@ MlasConvPrepare(
     const MLAS_ACTIVATION* Activation,
     size_t* WorkingBufferSize,
     float Beta,
-    MLAS_THREADPOOL* ThreadPool
+    MLAS_THREADPOOL* ThreadPool,
+    const float* WinogradPackedFilter
     )
 /*++
 
@@ -1088,6 +1103,10 @@ Arguments:
     ThreadPool - Supplies the thread pool object to use, else nullptr if the
         base library threading support should be used.
 
+    WinogradPackedFilter - Optionally supplies the filter packed by
+        MlasConvWinogradPackFilter. The Winograd algorithm is only considered
+        if it is supplied, and then MlasConv uses it instead of the filter.
+
 Return Value:
 
     None.
@@ -1168,6 +1187,10 @@ Return Value:
 
     *WorkingBufferSize = 0;
 
+    if (MlasConvWinogradPrepare(Parameters, WinogradPackedFilter, WorkingBufferSize, ThreadPool)) {
+        return;
+    }
+
     if (AllStridesAreOne && AllPaddingIsZero) {
 
         //
@@ -0,0 +1,450 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convolve_transpose.cpp
+
+Abstract:
+
+    This module implements the two dimensional transposed convolution.
+
+    The product of the filter and a block of input image rows is computed by a
+    GEMM into a buffer that holds the columns of the block and is then
+    scattered into the output image, so the column buffer of the whole image is
+    never materialized. The threads are given disjoint ranges of output
+    channels, so the scattered sums of different threads never overlap.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the approximate number of elements of the column buffer of a thread,
+// used to choose the number of input rows in a block.
+//
+
+constexpr size_t MLAS_CONV_TRANSPOSE_BLOCK_ELEMENTS = 64 * 1024;
+
+struct MLAS_CONV_TRANSPOSE_WORK_BLOCK {
+    size_t BatchGroupCount;
+    size_t GroupCount;
+    size_t InputChannels;
+    size_t InputHeight;
+    size_t InputWidth;
+    size_t OutputChannels;
+    size_t OutputHeight;
+    size_t OutputWidth;
+    size_t KernelHeight;
+    size_t KernelWidth;
+    size_t DilationHeight;
+    size_t DilationWidth;
+    size_t PaddingTop;
+    size_t PaddingLeft;
+    size_t StrideHeight;
+    size_t StrideWidth;
+    const float* Input;
+    const float* Filter;
+    bool FilterIsTransposed;
+    const float* Bias;
+    float* Output;
+    size_t ChannelsPerBlock;
+    size_t BlocksPerGroup;
+    size_t RowsPerBlock;
+    ptrdiff_t TargetThreadCount;
+};
+
+MLAS_FORCEINLINE
+void
+MlasConvTransposeValidRange(
+    size_t InputCount,
+    size_t OutputCount,
+    size_t Stride,
+    ptrdiff_t Offset,
+    size_t* Begin,
+    size_t* End
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the range of input positions i for which the output
+    position i * Stride + Offset lies inside the output image.
+
+Arguments:
+
+    InputCount - Supplies the number of input positions.
+
+    OutputCount - Supplies the number of output positions.
+
+    Stride - Supplies the stride between the outputs of adjacent inputs.
+
+    Offset - Supplies the output position of the first input, which is the
+        kernel offset minus the padding.
+
+    Begin - Receives the first valid input position.
+
+    End - Receives the end of the valid input positions.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const ptrdiff_t stride = ptrdiff_t(Stride);
+
+    ptrdiff_t begin = 0;
+
+    if (Offset < 0) {
+        begin = (-Offset + stride - 1) / stride;
+    }
+
+    ptrdiff_t end = 0;
+
+    if (ptrdiff_t(OutputCount) > Offset) {
+        end = (ptrdiff_t(OutputCount) - Offset + stride - 1) / stride;
+    }
+
+    end = std::min(end, ptrdiff_t(InputCount));
+
+    *Begin = size_t(begin);
+    *End = size_t(std::max(begin, end));
+}
+
+void
+MlasConvTransposeScatter(
+    const MLAS_CONV_TRANSPOSE_WORK_BLOCK* WorkBlock,
+    const float* ColumnBuffer,
+    size_t ChannelCount,
+    size_t RowStart,
+    size_t RowCount,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine adds the columns computed for a block of input rows to the
+    output image.
+
+Arguments:
+
+    WorkBlock - Supplies the structure that contains the transposed
+        convolution parameters.
+
+    ColumnBuffer - Supplies the columns of the block, one row for each output
+        channel and kernel element and one column for each input position.
+
+    ChannelCount - Supplies the number of output channels of the block.
+
+    RowStart - Supplies the first input row of the block.
+
+    RowCount - Supplies the number of input rows of the block.
+
+    Output - Supplies the output image of the first channel of the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputWidth = WorkBlock->InputWidth;
+    const size_t OutputHeight = WorkBlock->OutputHeight;
+    const size_t OutputWidth = WorkBlock->OutputWidth;
+    const size_t OutputSize = OutputHeight * OutputWidth;
+    const size_t StrideHeight = WorkBlock->StrideHeight;
+    const size_t StrideWidth = WorkBlock->StrideWidth;
+    const size_t ColumnCount = RowCount * InputWidth;
+
+    for (size_t c = 0; c < ChannelCount; c++) {
+
+        float* output = Output + c * OutputSize;
+
+        for (size_t kh = 0; kh < WorkBlock->KernelHeight; kh++) {
+
+            const ptrdiff_t OffsetHeight =
+                ptrdiff_t(kh * WorkBlock->DilationHeight) - ptrdiff_t(WorkBlock->PaddingTop);
+
+            size_t ihBegin;
+            size_t ihEnd;
+
+            MlasConvTransposeValidRange(RowStart + RowCount, OutputHeight, StrideHeight,
+                                        OffsetHeight, &ihBegin, &ihEnd);
+
+            ihBegin = std::max(ihBegin, RowStart);
+
+            for (size_t kw = 0; kw < WorkBlock->KernelWidth; kw++) {
+
+                const ptrdiff_t OffsetWidth =
+                    ptrdiff_t(kw * WorkBlock->DilationWidth) - ptrdiff_t(WorkBlock->PaddingLeft);
+
+                size_t iwBegin;
+                size_t iwEnd;
+
+                MlasConvTransposeValidRange(InputWidth, OutputWidth, StrideWidth,
+                                            OffsetWidth, &iwBegin, &iwEnd);
+
+                const float* column = ColumnBuffer +
+                    ((c * WorkBlock->KernelHeight + kh) * WorkBlock->KernelWidth + kw) * ColumnCount;
+
+                for (size_t ih = ihBegin; ih < ihEnd; ih++) {
+
+                    const float* src = column + (ih - RowStart) * InputWidth;
+                    float* dst = output + size_t(ptrdiff_t(ih * StrideHeight) + OffsetHeight) * OutputWidth;
+
+                    if (StrideWidth == 1) {
+                        dst += ptrdiff_t(iwBegin) + OffsetWidth;
+                        for (size_t iw = iwBegin; iw < iwEnd; iw++) {
+                            *dst++ += src[iw];
+                        }
+                    } else {
+                        for (size_t iw = iwBegin; iw < iwEnd; iw++) {
+                            dst[ptrdiff_t(iw * StrideWidth) + OffsetWidth] += src[iw];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void
+MlasConvTransposeThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    transposed convolution operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = static_cast<const MLAS_CONV_TRANSPOSE_WORK_BLOCK*>(Context);
+
+    const size_t InputChannels = WorkBlock->InputChannels;
+    const size_t InputSize = WorkBlock->InputHeight * WorkBlock->InputWidth;
+    const size_t OutputChannels = WorkBlock->OutputChannels;
+    const size_t OutputSize = WorkBlock->OutputHeight * WorkBlock->OutputWidth;
+    const size_t KernelSize = WorkBlock->KernelHeight * WorkBlock->KernelWidth;
+    const size_t KernelDim = OutputChannels * KernelSize;
+    const size_t ChannelsPerBlock = WorkBlock->ChannelsPerBlock;
+    const size_t RowsPerBlock = WorkBlock->RowsPerBlock;
+
+    MlasThreadedBufAlloc(ChannelsPerBlock * KernelSize * RowsPerBlock * WorkBlock->InputWidth * sizeof(float));
+
+    float* ColumnBuffer = reinterpret_cast<float*>(ThreadedBufHolder.get());
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->TargetThreadCount,
+                      WorkBlock->BatchGroupCount * WorkBlock->BlocksPerGroup,
+                      &WorkIndex, &WorkRemaining);
+
+    for (size_t WorkEnd = WorkIndex + WorkRemaining; WorkIndex < WorkEnd; WorkIndex++) {
+
+        const size_t bg = WorkIndex / WorkBlock->BlocksPerGroup;
+        const size_t group = bg % WorkBlock->GroupCount;
+        const size_t ChannelStart = (WorkIndex % WorkBlock->BlocksPerGroup) * ChannelsPerBlock;
+        const size_t ChannelCount = std::min(ChannelsPerBlock, OutputChannels - ChannelStart);
+
+        const float* input = WorkBlock->Input + bg * InputChannels * InputSize;
+        const float* filter = WorkBlock->Filter + group * InputChannels * KernelDim;
+        float* output = WorkBlock->Output + (bg * OutputChannels + ChannelStart) * OutputSize;
+
+        //
+        // Initialize the output channels with the bias, the columns of the
+        // blocks are accumulated into them.
+        //
+
+        for (size_t c = 0; c < ChannelCount; c++) {
+            const float value = (WorkBlock->Bias != nullptr) ?
+                WorkBlock->Bias[group * OutputChannels + ChannelStart + c] : 0.0f;
+            std::fill_n(output + c * OutputSize, OutputSize, value);
+        }
+
+        for (size_t RowStart = 0; RowStart < WorkBlock->InputHeight; RowStart += RowsPerBlock) {
+
+            const size_t RowCount = std::min(RowsPerBlock, WorkBlock->InputHeight - RowStart);
+            const size_t ColumnCount = RowCount * WorkBlock->InputWidth;
+
+            //
+            // The transposed filter of a group is stored as a matrix of output
+            // channels and kernel elements by input channels, else the filter
+            // is stored as its transpose.
+            //
+
+            if (WorkBlock->FilterIsTransposed) {
+                MlasSgemmOperation(CblasNoTrans, CblasNoTrans, ChannelCount * KernelSize, ColumnCount,
+                                   InputChannels, 1.0f, filter + ChannelStart * KernelSize * InputChannels,
+                                   InputChannels, input + RowStart * WorkBlock->InputWidth, InputSize, 0.0f,
+                                   ColumnBuffer, ColumnCount, nullptr);
+            } else {
+                MlasSgemmOperation(CblasTrans, CblasNoTrans, ChannelCount * KernelSize, ColumnCount,
+                                   InputChannels, 1.0f, filter + ChannelStart * KernelSize, KernelDim,
+                                   input + RowStart * WorkBlock->InputWidth, InputSize, 0.0f,
+                                   ColumnBuffer, ColumnCount, nullptr);
+            }
+
+            MlasConvTransposeScatter(WorkBlock, ColumnBuffer, ChannelCount, RowStart, RowCount, output);
+        }
+    }
+}
+
+void
+MLASCALL
+MlasConvTranspose2D(
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    size_t OutputChannels,
+    const int64_t* OutputShape,
+    const float* Input,
+    const float* Filter,
+    bool FilterIsTransposed,
+    const float* Bias,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the two dimensional transposed convolution of
+    images in NCHW format.
+
+Arguments:
+
+    BatchCount - Supplies the number of images.
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    InputShape - Supplies the height and width of the input image.
+
+    KernelShape - Supplies the height and width of the kernel.
+
+    DilationShape - Supplies the dilation of the kernel.
+
+    Padding - Supplies the top and left padding of the output image.
+
+    StrideShape - Supplies the stride of the input positions in the output
+        image.
+
+    OutputChannels - Supplies the number of output channels per group.
+
+    OutputShape - Supplies the height and width of the output image.
+
+    Input - Supplies the input tensor.
+
+    Filter - Supplies the filter tensor. The filter of a group is a matrix of
+        input channels by output channels and kernel elements, or its transpose
+        if FilterIsTransposed is true.
+
+    FilterIsTransposed - Supplies true if the filter of each group has been
+        transposed by the caller.
+
+    Bias - Optionally supplies the bias vector.
+
+    Output - Supplies the output tensor.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_TRANSPOSE_WORK_BLOCK WorkBlock;
+
+    WorkBlock.BatchGroupCount = BatchCount * GroupCount;
+    WorkBlock.GroupCount = GroupCount;
+    WorkBlock.InputChannels = InputChannels;
+    WorkBlock.InputHeight = size_t(InputShape[0]);
+    WorkBlock.InputWidth = size_t(InputShape[1]);
+    WorkBlock.OutputChannels = OutputChannels;
+    WorkBlock.OutputHeight = size_t(OutputShape[0]);
+    WorkBlock.OutputWidth = size_t(OutputShape[1]);
+    WorkBlock.KernelHeight = size_t(KernelShape[0]);
+    WorkBlock.KernelWidth = size_t(KernelShape[1]);
+    WorkBlock.DilationHeight = size_t(DilationShape[0]);
+    WorkBlock.DilationWidth = size_t(DilationShape[1]);
+    WorkBlock.PaddingTop = size_t(Padding[0]);
+    WorkBlock.PaddingLeft = size_t(Padding[1]);
+    WorkBlock.StrideHeight = size_t(StrideShape[0]);
+    WorkBlock.StrideWidth = size_t(StrideShape[1]);
+    WorkBlock.Input = Input;
+    WorkBlock.Filter = Filter;
+    WorkBlock.FilterIsTransposed = FilterIsTransposed;
+    WorkBlock.Bias = Bias;
+    WorkBlock.Output = Output;
+
+    const size_t InputSize = WorkBlock.InputHeight * WorkBlock.InputWidth;
+    const size_t KernelSize = WorkBlock.KernelHeight * WorkBlock.KernelWidth;
+
+    //
+    // Compute the number of threads from the complexity of the GEMMs, and
+    // split the output channels of each image and group into enough blocks
+    // to keep the threads busy.
+    //
+
+    const double Complexity = double(WorkBlock.BatchGroupCount) * double(OutputChannels) *
+                              double(KernelSize) * double(InputChannels) * double(InputSize);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    TargetThreadCount = std::min(TargetThreadCount, MlasGetMaximumThreadCount(ThreadPool));
+
+    size_t BlocksPerGroup = (size_t(TargetThreadCount) + WorkBlock.BatchGroupCount - 1) / WorkBlock.BatchGroupCount;
+    BlocksPerGroup = std::min(BlocksPerGroup, OutputChannels);
+
+    WorkBlock.ChannelsPerBlock = (OutputChannels + BlocksPerGroup - 1) / BlocksPerGroup;
+    WorkBlock.BlocksPerGroup = (OutputChannels + WorkBlock.ChannelsPerBlock - 1) / WorkBlock.ChannelsPerBlock;
+
+    const size_t BlockRowElements = WorkBlock.ChannelsPerBlock * KernelSize * WorkBlock.InputWidth;
+
+    WorkBlock.RowsPerBlock = std::max(size_t(1), MLAS_CONV_TRANSPOSE_BLOCK_ELEMENTS / BlockRowElements);
+    WorkBlock.RowsPerBlock = std::min(WorkBlock.RowsPerBlock, WorkBlock.InputHeight);
+
+    const size_t WorkCount = WorkBlock.BatchGroupCount * WorkBlock.BlocksPerGroup;
+
+    if (size_t(TargetThreadCount) > WorkCount) {
+        TargetThreadCount = ptrdiff_t(WorkCount);
+    }
+
+    WorkBlock.TargetThreadCount = TargetThreadCount;
+
+    MlasExecuteThreaded(MlasConvTransposeThreaded, &WorkBlock, TargetThreadCount, ThreadPool);
+}
@@ -0,0 +1,716 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convolve_winograd.cpp
+
+Abstract:
+
+    This module implements the Winograd F(4x4, 3x3) convolution.
+
+    Each 4x4 tile of the output image is computed from the 6x6 tile of the
+    input image that covers it. The input tiles and the filters are
+    transformed to 36 elements each, the transformed input tiles of a block of
+    output tiles are multiplied with the transformed filters by 36 GEMMs, one
+    for each element, and the products are transformed back to output tiles.
+    This uses 36 multiplications per 16 outputs instead of 144.
+
+    The filter transform is done once by MlasConvWinogradPackFilter, the input
+    and output transforms are done by the threads for their blocks of output
+    tile rows, so the working buffer only holds the transformed tiles of one
+    block per thread.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the sizes of the output and input tiles.
+//
+
+constexpr size_t MLAS_WINOGRAD_OUTPUT_TILE = 4;
+constexpr size_t MLAS_WINOGRAD_INPUT_TILE = 6;
+constexpr size_t MLAS_WINOGRAD_TILE_ELEMENTS = MLAS_WINOGRAD_INPUT_TILE * MLAS_WINOGRAD_INPUT_TILE;
+
+//
+// Define the approximate number of elements of the working buffer of a
+// thread, used to choose the number of tile rows in a block.
+//
+
+constexpr size_t MLAS_WINOGRAD_BLOCK_ELEMENTS = 256 * 1024;
+
+struct MLAS_CONV_WINOGRAD_WORK_BLOCK {
+    const MLAS_CONV_PARAMETERS* Parameters;
+    const float* Input;
+    const float* Bias;
+    float* WorkingBuffer;
+    float* Output;
+    size_t TilesHeight;
+    size_t TilesWidth;
+    size_t BlocksPerImage;
+    size_t WorkingBufferSizePerThread;
+};
+
+MLAS_FORCEINLINE
+void
+MlasWinogradInputTransform(
+    const float* d,
+    size_t Stride,
+    float* v,
+    size_t OutputStride
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies a vector of 6 elements by B^T.
+
+--*/
+{
+    const float d0 = d[0];
+    const float d1 = d[Stride];
+    const float d2 = d[2 * Stride];
+    const float d3 = d[3 * Stride];
+    const float d4 = d[4 * Stride];
+    const float d5 = d[5 * Stride];
+
+    v[0] = 4.0f * d0 - 5.0f * d2 + d4;
+    v[OutputStride] = -4.0f * (d1 + d2) + d3 + d4;
+    v[2 * OutputStride] = 4.0f * (d1 - d2) - d3 + d4;
+    v[3 * OutputStride] = 2.0f * (d3 - d1) - d2 + d4;
+    v[4 * OutputStride] = 2.0f * (d1 - d3) - d2 + d4;
+    v[5 * OutputStride] = 4.0f * d1 - 5.0f * d3 + d5;
+}
+
+MLAS_FORCEINLINE
+void
+MlasWinogradOutputTransform(
+    const float* m,
+    size_t Stride,
+    float* y,
+    size_t OutputStride
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies a vector of 6 elements by A^T.
+
+--*/
+{
+    const float m1_plus_m2 = m[Stride] + m[2 * Stride];
+    const float m1_minus_m2 = m[Stride] - m[2 * Stride];
+    const float m3_plus_m4 = m[3 * Stride] + m[4 * Stride];
+    const float m3_minus_m4 = m[3 * Stride] - m[4 * Stride];
+
+    y[0] = m[0] + m1_plus_m2 + m3_plus_m4;
+    y[OutputStride] = m1_minus_m2 + 2.0f * m3_minus_m4;
+    y[2 * OutputStride] = m1_plus_m2 + 4.0f * m3_plus_m4;
+    y[3 * OutputStride] = m1_minus_m2 + 8.0f * m3_minus_m4 + m[5 * Stride];
+}
+
+bool
+MLASCALL
+MlasConvWinogradIsSupported(
+    size_t Dimensions,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* StrideShape
+    )
+/*++
+
+Routine Description:
+
+    This routine returns whether a convolution can be computed with the
+    Winograd F(4x4, 3x3) algorithm, and so whether its filter should be packed
+    with MlasConvWinogradPackFilter.
+
+Arguments:
+
+    Dimensions - Supplies the number of dimensions.
+
+    KernelShape - Supplies the shape of the kernel transform.
+
+    DilationShape - Supplies the shape of the dilation.
+
+    StrideShape - Supplies the shape of the stride.
+
+Return Value:
+
+    Returns true if the convolution is a 2D 3x3 convolution with unit strides
+    and dilations.
+
+--*/
+{
+    if (Dimensions != 2) {
+        return false;
+    }
+
+    for (size_t dim = 0; dim < Dimensions; dim++) {
+        if (KernelShape[dim] != 3 || DilationShape[dim] != 1 || StrideShape[dim] != 1) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t
+MLASCALL
+MlasConvWinogradPackedFilterSize(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of elements of a filter packed by
+    MlasConvWinogradPackFilter.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    FilterCount - Supplies the number of filters per group.
+
+    InputChannels - Supplies the number of input channels per group.
+
+Return Value:
+
+    Returns the number of elements of the packed filter.
+
+--*/
+{
+    return GroupCount * MLAS_WINOGRAD_TILE_ELEMENTS * FilterCount * InputChannels;
+}
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    float* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a 3x3 filter for the Winograd F(4x4, 3x3)
+    convolution. The transformed filter of a group is stored as 36 matrices of
+    FilterCount rows and InputChannels columns, one for each element of the
+    transformed tiles.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    FilterCount - Supplies the number of filters per group.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    Filter - Supplies the filter tensor, of shape
+        [GroupCount * FilterCount, InputChannels, 3, 3].
+
+    PackedFilter - Supplies the buffer to receive the packed filter, of
+        MlasConvWinogradPackedFilterSize elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    static const float G[MLAS_WINOGRAD_INPUT_TILE][3] = {
+        {1.0f / 4.0f, 0.0f, 0.0f},
+        {-1.0f / 6.0f, -1.0f / 6.0f, -1.0f / 6.0f},
+        {-1.0f / 6.0f, 1.0f / 6.0f, -1.0f / 6.0f},
+        {1.0f / 24.0f, 1.0f / 12.0f, 1.0f / 6.0f},
+        {1.0f / 24.0f, -1.0f / 12.0f, 1.0f / 6.0f},
+        {0.0f, 0.0f, 1.0f},
+    };
+
+    const size_t MatrixSize = FilterCount * InputChannels;
+
+    for (size_t g = 0; g < GroupCount; g++) {
+
+        float* packed = PackedFilter + g * MLAS_WINOGRAD_TILE_ELEMENTS * MatrixSize;
+
+        for (size_t f = 0; f < FilterCount; f++) {
+
+            for (size_t c = 0; c < InputChannels; c++) {
+
+                const float* filter = Filter + ((g * FilterCount + f) * InputChannels + c) * 9;
+
+                //
+                // Compute U = G * g * G^T.
+                //
+
+                float Gg[MLAS_WINOGRAD_INPUT_TILE][3];
+
+                for (size_t i = 0; i < MLAS_WINOGRAD_INPUT_TILE; i++) {
+                    for (size_t j = 0; j < 3; j++) {
+                        Gg[i][j] = G[i][0] * filter[j] + G[i][1] * filter[3 + j] + G[i][2] * filter[6 + j];
+                    }
+                }
+
+                for (size_t i = 0; i < MLAS_WINOGRAD_INPUT_TILE; i++) {
+                    for (size_t j = 0; j < MLAS_WINOGRAD_INPUT_TILE; j++) {
+                        const float u = Gg[i][0] * G[j][0] + Gg[i][1] * G[j][1] + Gg[i][2] * G[j][2];
+                        packed[(i * MLAS_WINOGRAD_INPUT_TILE + j) * MatrixSize + f * InputChannels + c] = u;
+                    }
+                }
+            }
+        }
+    }
+}
+
+bool
+MlasConvWinogradPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    const float* PackedFilter,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine selects the Winograd algorithm if the convolution supports
+    it and is large enough to benefit from it.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+    PackedFilter - Supplies the filter packed by MlasConvWinogradPackFilter,
+        else nullptr.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    Returns true if the Winograd algorithm was selected.
+
+--*/
+{
+    if (PackedFilter == nullptr || Parameters->Dimensions != 2) {
+        return false;
+    }
+
+    for (size_t dim = 0; dim < 2; dim++) {
+        if (Parameters->KernelShape[dim] != 3 || Parameters->DilationShape[dim] != 1 ||
+            Parameters->StrideShape[dim] != 1) {
+            return false;
+        }
+    }
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+
+    //
+    // The transforms cost about as much as the GEMMs of a few channels, and
+    // partial output tiles waste the multiplications of their missing rows
+    // and columns.
+    //
+
+    if (InputChannels < 8 || FilterCount < 8) {
+        return false;
+    }
+
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t TilesHeight = (OutputHeight + MLAS_WINOGRAD_OUTPUT_TILE - 1) / MLAS_WINOGRAD_OUTPUT_TILE;
+    const size_t TilesWidth = (OutputWidth + MLAS_WINOGRAD_OUTPUT_TILE - 1) / MLAS_WINOGRAD_OUTPUT_TILE;
+
+    if (2 * OutputHeight * OutputWidth <
+        TilesHeight * TilesWidth * MLAS_WINOGRAD_OUTPUT_TILE * MLAS_WINOGRAD_OUTPUT_TILE) {
+        return false;
+    }
+
+    //
+    // Choose the number of tile rows in a block so that the transformed input
+    // and output tiles of a block fit in the working buffer of a thread, and
+    // so that there are blocks for all the threads.
+    //
+
+    const size_t ElementsPerTile = MLAS_WINOGRAD_TILE_ELEMENTS * (InputChannels + FilterCount);
+    const size_t ElementsPerTileRow = ElementsPerTile * TilesWidth;
+
+    size_t TileRowsPerBlock = MLAS_WINOGRAD_BLOCK_ELEMENTS / ElementsPerTileRow;
+
+    if (TileRowsPerBlock == 0) {
+        TileRowsPerBlock = 1;
+    } else if (TileRowsPerBlock > TilesHeight) {
+        TileRowsPerBlock = TilesHeight;
+    }
+
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+    const size_t ImageCount = Parameters->BatchCount * Parameters->GroupCount;
+
+    while (TileRowsPerBlock > 1 &&
+           ImageCount * ((TilesHeight + TileRowsPerBlock - 1) / TileRowsPerBlock) < size_t(ThreadCount)) {
+        TileRowsPerBlock--;
+    }
+
+    const size_t BlockCount = ImageCount * ((TilesHeight + TileRowsPerBlock - 1) / TileRowsPerBlock);
+
+    if (size_t(ThreadCount) > BlockCount) {
+        ThreadCount = ptrdiff_t(BlockCount);
+    }
+
+    Parameters->Algorithm = MlasConvAlgorithmWinograd;
+    Parameters->ThreadCount = ThreadCount;
+    Parameters->u.Winograd.PackedFilter = PackedFilter;
+    Parameters->u.Winograd.TileRowsPerBlock = TileRowsPerBlock;
+
+    *WorkingBufferSize = size_t(ThreadCount) * ElementsPerTileRow * TileRowsPerBlock;
+
+    return true;
+}
+
+void
+MlasConvWinogradBlock(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    size_t TilesWidth,
+    size_t TileRowStart,
+    size_t TileRowCount
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the output tiles of a block of tile rows of an
+    image of a group.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input image of the group.
+
+    PackedFilter - Supplies the packed filter of the group.
+
+    Bias - Optionally supplies the bias vector of the group.
+
+    WorkingBuffer - Supplies the working buffer of the thread.
+
+    Output - Supplies the output image of the group.
+
+    TilesWidth - Supplies the number of tiles in an output row.
+
+    TileRowStart - Supplies the first tile row of the block.
+
+    TileRowCount - Supplies the number of tile rows of the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputSize = Parameters->OutputSize;
+    const float Beta = Parameters->Beta;
+
+    const size_t TileCount = TileRowCount * TilesWidth;
+
+    //
+    // The transformed input tiles are stored as 36 matrices of InputChannels
+    // rows and TileCount columns, followed by the 36 products of
+    // FilterCount rows and TileCount columns.
+    //
+
+    float* TransformedInput = WorkingBuffer;
+    float* TransformedOutput = WorkingBuffer + MLAS_WINOGRAD_TILE_ELEMENTS * InputChannels * TileCount;
+
+    const size_t InputMatrixSize = InputChannels * TileCount;
+    const size_t OutputMatrixSize = FilterCount * TileCount;
+
+    //
+    // Transform the input tiles.
+    //
+
+    for (size_t c = 0; c < InputChannels; c++) {
+
+        const float* input = Input + c * InputSize;
+
+        for (size_t t = 0; t < TileCount; t++) {
+
+            const size_t th = TileRowStart + t / TilesWidth;
+            const size_t tw = t % TilesWidth;
+
+            //
+            // Load the input tile, with zeros for the padding. The subtraction
+            // of the padding wraps around for the elements before the image,
+            // which then fail the comparison with the image size.
+            //
+
+            const size_t ih0 = th * MLAS_WINOGRAD_OUTPUT_TILE - PaddingTop;
+            const size_t iw0 = tw * MLAS_WINOGRAD_OUTPUT_TILE - PaddingLeft;
+
+            float d[MLAS_WINOGRAD_TILE_ELEMENTS];
+
+            for (size_t i = 0; i < MLAS_WINOGRAD_INPUT_TILE; i++) {
+
+                const size_t ih = ih0 + i;
+
+                for (size_t j = 0; j < MLAS_WINOGRAD_INPUT_TILE; j++) {
+
+                    const size_t iw = iw0 + j;
+
+                    d[i * MLAS_WINOGRAD_INPUT_TILE + j] =
+                        (ih < InputHeight && iw < InputWidth) ? input[ih * InputWidth + iw] : 0.0f;
+                }
+            }
+
+            //
+            // Compute V = B^T * d * B.
+            //
+
+            float BTd[MLAS_WINOGRAD_TILE_ELEMENTS];
+
+            for (size_t j = 0; j < MLAS_WINOGRAD_INPUT_TILE; j++) {
+                MlasWinogradInputTransform(&d[j], MLAS_WINOGRAD_INPUT_TILE, &BTd[j], MLAS_WINOGRAD_INPUT_TILE);
+            }
+
+            float* v = TransformedInput + c * TileCount + t;
+
+            for (size_t i = 0; i < MLAS_WINOGRAD_INPUT_TILE; i++) {
+                MlasWinogradInputTransform(&BTd[i * MLAS_WINOGRAD_INPUT_TILE], 1,
+                                           v + i * MLAS_WINOGRAD_INPUT_TILE * InputMatrixSize, InputMatrixSize);
+            }
+        }
+    }
+
+    //
+    // Multiply the transformed filters with the transformed input tiles.
+    //
+
+    for (size_t xi = 0; xi < MLAS_WINOGRAD_TILE_ELEMENTS; xi++) {
+        MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, TileCount, InputChannels, 1.0f,
+                           PackedFilter + xi * FilterCount * InputChannels, InputChannels,
+                           TransformedInput + xi * InputMatrixSize, TileCount, 0.0f,
+                           TransformedOutput + xi * OutputMatrixSize, TileCount, nullptr);
+    }
+
+    //
+    // Transform the products to the output tiles.
+    //
+
+    for (size_t f = 0; f < FilterCount; f++) {
+
+        float* output = Output + f * OutputSize;
+
+        for (size_t t = 0; t < TileCount; t++) {
+
+            const float* m = TransformedOutput + f * TileCount + t;
+
+            //
+            // Compute Y = A^T * m * A.
+            //
+
+            float ATm[MLAS_WINOGRAD_OUTPUT_TILE * MLAS_WINOGRAD_INPUT_TILE];
+
+            for (size_t j = 0; j < MLAS_WINOGRAD_INPUT_TILE; j++) {
+                MlasWinogradOutputTransform(m + j * OutputMatrixSize, MLAS_WINOGRAD_INPUT_TILE * OutputMatrixSize,
+                                            &ATm[j], MLAS_WINOGRAD_INPUT_TILE);
+            }
+
+            float y[MLAS_WINOGRAD_OUTPUT_TILE * MLAS_WINOGRAD_OUTPUT_TILE];
+
+            for (size_t i = 0; i < MLAS_WINOGRAD_OUTPUT_TILE; i++) {
+                MlasWinogradOutputTransform(&ATm[i * MLAS_WINOGRAD_INPUT_TILE], 1,
+                                            &y[i * MLAS_WINOGRAD_OUTPUT_TILE], 1);
+            }
+
+            //
+            // Store the part of the tile inside the output image.
+            //
+
+            const size_t oh0 = (TileRowStart + t / TilesWidth) * MLAS_WINOGRAD_OUTPUT_TILE;
+            const size_t ow0 = (t % TilesWidth) * MLAS_WINOGRAD_OUTPUT_TILE;
+
+            const size_t RowCount = std::min(MLAS_WINOGRAD_OUTPUT_TILE, OutputHeight - oh0);
+            const size_t ColumnCount = std::min(MLAS_WINOGRAD_OUTPUT_TILE, OutputWidth - ow0);
+
+            for (size_t i = 0; i < RowCount; i++) {
+
+                float* row = output + (oh0 + i) * OutputWidth + ow0;
+
+                if (Beta == 0.0f) {
+                    for (size_t j = 0; j < ColumnCount; j++) {
+                        row[j] = y[i * MLAS_WINOGRAD_OUTPUT_TILE + j];
+                    }
+                } else {
+                    for (size_t j = 0; j < ColumnCount; j++) {
+                        row[j] = y[i * MLAS_WINOGRAD_OUTPUT_TILE + j] + Beta * row[j];
+                    }
+                }
+            }
+        }
+    }
+
+    //
+    // Apply the activation with optional bias to the output rows of the
+    // block.
+    //
+
+    const size_t RowStart = TileRowStart * MLAS_WINOGRAD_OUTPUT_TILE;
+    const size_t RowEnd = std::min((TileRowStart + TileRowCount) * MLAS_WINOGRAD_OUTPUT_TILE, OutputHeight);
+
+    MlasActivation(Parameters->Activation, Output + RowStart * OutputWidth, Bias, FilterCount,
+                   (RowEnd - RowStart) * OutputWidth, OutputSize);
+}
+
+void
+MlasConvWinogradThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    Winograd convolution operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = static_cast<const MLAS_CONV_WINOGRAD_WORK_BLOCK*>(Context);
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputGroupSize = Parameters->InputChannels * Parameters->InputSize;
+    const size_t OutputGroupSize = FilterCount * Parameters->OutputSize;
+    const size_t FilterGroupSize = MLAS_WINOGRAD_TILE_ELEMENTS * FilterCount * Parameters->InputChannels;
+    const size_t TileRowsPerBlock = Parameters->u.Winograd.TileRowsPerBlock;
+
+    float* WorkingBuffer = WorkBlock->WorkingBuffer + Index * WorkBlock->WorkingBufferSizePerThread;
+
+    size_t BlockIndex;
+    size_t BlockRemaining;
+
+    MlasPartitionWork(Index, Parameters->ThreadCount,
+                      Parameters->BatchCount * GroupCount * WorkBlock->BlocksPerImage,
+                      &BlockIndex, &BlockRemaining);
+
+    for (size_t BlockEnd = BlockIndex + BlockRemaining; BlockIndex < BlockEnd; BlockIndex++) {
+
+        const size_t bg = BlockIndex / WorkBlock->BlocksPerImage;
+        const size_t group = bg % GroupCount;
+
+        const size_t TileRowStart = (BlockIndex % WorkBlock->BlocksPerImage) * TileRowsPerBlock;
+        const size_t TileRowCount = std::min(TileRowsPerBlock, WorkBlock->TilesHeight - TileRowStart);
+
+        const float* bias = WorkBlock->Bias;
+
+        if (bias != nullptr) {
+            bias += group * FilterCount;
+        }
+
+        MlasConvWinogradBlock(Parameters,
+                              WorkBlock->Input + bg * InputGroupSize,
+                              Parameters->u.Winograd.PackedFilter + group * FilterGroupSize,
+                              bias,
+                              WorkingBuffer,
+                              WorkBlock->Output + bg * OutputGroupSize,
+                              WorkBlock->TilesWidth,
+                              TileRowStart,
+                              TileRowCount);
+    }
+}
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the convolution operation with the Winograd
+    F(4x4, 3x3) algorithm selected by MlasConvWinogradPrepare.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvPrepare.
+
+    Output - Supplies the output tensor.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WINOGRAD_WORK_BLOCK WorkBlock;
+
+    const size_t TileRowsPerBlock = Parameters->u.Winograd.TileRowsPerBlock;
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Input = Input;
+    WorkBlock.Bias = Bias;
+    WorkBlock.WorkingBuffer = WorkingBuffer;
+    WorkBlock.Output = Output;
+    WorkBlock.TilesHeight = (Parameters->OutputShape[0] + MLAS_WINOGRAD_OUTPUT_TILE - 1) / MLAS_WINOGRAD_OUTPUT_TILE;
+    WorkBlock.TilesWidth = (Parameters->OutputShape[1] + MLAS_WINOGRAD_OUTPUT_TILE - 1) / MLAS_WINOGRAD_OUTPUT_TILE;
+    WorkBlock.BlocksPerImage = (WorkBlock.TilesHeight + TileRowsPerBlock - 1) / TileRowsPerBlock;
+    WorkBlock.WorkingBufferSizePerThread = MLAS_WINOGRAD_TILE_ELEMENTS *
+        (Parameters->InputChannels + Parameters->FilterCount) * WorkBlock.TilesWidth * TileRowsPerBlock;
+
+    MlasExecuteThreaded(MlasConvWinogradThreaded, &WorkBlock, Parameters->ThreadCount, ThreadPool);
+}
@@ -142,6 +142,10 @@ MlasConvSymDepthwiseKernelSize25ArmU8S8(
 #endif
 }
 
+#if defined(MLAS_TARGET_AMD64) && !defined(ORT_MINIMAL_BUILD)
+MLAS_CONV_SYM_KERNEL MlasConvSymKernelAmx;
+#endif
+
 struct MLAS_CONV_SYM_DISPATCH {
     MLAS_CONV_SYM_KERNEL* Kernel;
 #if defined(MLAS_TARGET_ARM64)
@@ -229,6 +233,27 @@ const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvx512Vnni = {
     false,                                  // FixupInputZeroPoint
 };
 
+//
+// The depthwise convolution has no reduction over input channels to map to
+// the tiles, so it keeps the AVX512VNNI kernel.
+//
+
+const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAmx = {
+    MlasConvSymKernelAmx,
+    MlasConvSymDepthwiseKernelAvx512Vnni,
+    nullptr,
+    nullptr,
+    4,                                      // FilterInputChannelPackCount
+    16,                                     // FilterOutputChannelPackCount
+    64,                                     // KernelChannelCount
+    16,                                     // KernelOutputCount
+    4,                                      // KernelInputChannelAlignment
+    4,                                      // KernelOutputChannelAlignment
+    64,                                     // KernelDepthwiseChannelCount
+    6,                                      // KernelDepthwiseOutputCount
+    false,                                  // FixupInputZeroPoint
+};
+
 #endif // ORT_MINIMAL_BUILD
 
 #elif defined(MLAS_TARGET_ARM64)
@@ -325,6 +350,29 @@ GetConvSymDispatch(bool InputIsSigned){
     return InputIsSigned ? GetMlasPlatform().ConvSymS8S8Dispatch : GetMlasPlatform().ConvSymU8S8Dispatch;
 }
 
+MLAS_FORCEINLINE
+size_t
+MlasConvSymPackWSizeInternal(
+    const MLAS_CONV_SYM_DISPATCH* ConvSymDispatch,
+    size_t InputChannels,
+    size_t OutputChannels,
+    size_t KernelSize
+    )
+{
+    size_t OutputChannelPackCount = ConvSymDispatch->FilterOutputChannelPackCount;
+
+    if (ConvSymDispatch->Kernel == nullptr ||
+        OutputChannels < OutputChannelPackCount ||
+        (InputChannels % ConvSymDispatch->KernelInputChannelAlignment) != 0 ||
+        (OutputChannels % ConvSymDispatch->KernelOutputChannelAlignment) != 0
+        ) {
+        return 0;
+    }
+
+    size_t AlignedOutputChannels = (OutputChannels + OutputChannelPackCount - 1) / OutputChannelPackCount * OutputChannelPackCount;
+    return AlignedOutputChannels * InputChannels * KernelSize;
+}
+
 size_t
 MlasConvSymPackWSize(
     size_t GroupCount,
@@ -377,19 +425,30 @@ MlasConvSymPackWSize(
         }
 #endif
 
-        size_t OutputChannelPackCount = ConvSymDispatch->FilterOutputChannelPackCount;
+        return MlasConvSymPackWSizeInternal(ConvSymDispatch, InputChannels, OutputChannels, KernelSize);
+    }
+}
 
-        if (ConvSymDispatch->Kernel == nullptr ||
-            OutputChannels < OutputChannelPackCount ||
-            (InputChannels % ConvSymDispatch->KernelInputChannelAlignment) != 0 ||
-            (OutputChannels % ConvSymDispatch->KernelOutputChannelAlignment) != 0
-            ) {
-            return 0;
-        }
+size_t
+MlasConvSymPointwisePackWSize(
+    size_t InputChannels,
+    size_t OutputChannels,
+    bool InputIsSigned
+    )
+{
+    const MLAS_CONV_SYM_DISPATCH* ConvSymDispatch = GetConvSymDispatch(InputIsSigned);
 
-        size_t AlignedOutputChannels = (OutputChannels + OutputChannelPackCount - 1) / OutputChannelPackCount * OutputChannelPackCount;
-        return AlignedOutputChannels * InputChannels * KernelSize;
+    if (ConvSymDispatch == nullptr) {
+        return 0;
     }
+
+    //
+    // The pointwise half of the fused routine reads the intermediate tile
+    // through the indirect conv kernel, so this does not apply the ARM64
+    // preference for the QGEMM path on standalone pointwise convolutions.
+    //
+
+    return MlasConvSymPackWSizeInternal(ConvSymDispatch, InputChannels, OutputChannels, 1);
 }
 
 void
@@ -650,3 +709,95 @@ MlasConvSymDepthwise(
         OutputCountRemaining -= OutputCount;
     }
 }
+
+int32_t
+MlasConvSymDepthwisePointwiseGetKernelOutputCnt(
+    bool InputIsSigned
+    )
+{
+    const MLAS_CONV_SYM_DISPATCH* ConvSymDispatch = GetConvSymDispatch(InputIsSigned);
+    return std::max(ConvSymDispatch->KernelOutputCount, ConvSymDispatch->KernelDepthwiseOutputCount);
+}
+
+void
+MlasConvSymDepthwisePointwise(
+    const MLAS_CONV_SYM_PARAMS& DepthwiseParams,
+    const MLAS_CONV_SYM_PARAMS& PointwiseParams
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a depthwise convolution followed by a pointwise
+    convolution. The output pixels are processed in tiles: the depthwise
+    convolution of a tile is requantized into a thread local buffer sized to
+    stay resident in the L1 cache and the pointwise convolution of the tile
+    reads the buffer back before the next tile is computed.
+
+Arguments:
+
+    DepthwiseParams - Supplies the parameters of the depthwise convolution.
+        The Output field is ignored.
+
+    PointwiseParams - Supplies the parameters of the pointwise convolution.
+        The InputDirect, InputIndirection, InputChannels, OutputCount and
+        KernelSize fields are ignored.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_CONV_SYM_DISPATCH* ConvSymDispatch = GetConvSymDispatch(DepthwiseParams.InputIsSigned);
+
+    const size_t Channels = DepthwiseParams.OutputChannels;
+    const size_t KernelSize = DepthwiseParams.KernelSize;
+    const size_t OutputChannels = PointwiseParams.OutputChannels;
+
+    //
+    // Size the tile to a multiple of the pointwise kernel output count that
+    // keeps the intermediate activation within 16KB.
+    //
+
+    constexpr size_t TileBufferSize = 16 * 1024;
+    const size_t KernelOutputCount = ConvSymDispatch->KernelOutputCount;
+    const size_t TileCount =
+        std::max<size_t>(TileBufferSize / (Channels * KernelOutputCount), 1) * KernelOutputCount;
+
+    const size_t TileInputSize = UpAlignSize(TileCount * Channels);
+    MlasThreadedBufAlloc(TileInputSize + TileCount * sizeof(void*));
+
+    int8_t* TileInput = reinterpret_cast<int8_t*>(ThreadedBufHolder.get());
+    const void** TileIndirection = reinterpret_cast<const void**>(TileInput + TileInputSize);
+
+    for (size_t n = 0; n < TileCount; n++) {
+        TileIndirection[n] = TileInput + n * Channels;
+    }
+
+    MLAS_CONV_SYM_PARAMS TileDepthwiseParams = DepthwiseParams;
+    TileDepthwiseParams.Output = TileInput;
+
+    MLAS_CONV_SYM_PARAMS TilePointwiseParams = PointwiseParams;
+    TilePointwiseParams.InputDirect = nullptr;
+    TilePointwiseParams.InputIndirection = TileIndirection;
+    TilePointwiseParams.InputChannels = Channels;
+    TilePointwiseParams.KernelSize = 1;
+
+    for (size_t OutputIndex = 0; OutputIndex < DepthwiseParams.OutputCount;) {
+
+        const size_t OutputCount = std::min(DepthwiseParams.OutputCount - OutputIndex, TileCount);
+
+        TileDepthwiseParams.InputIndirection = DepthwiseParams.InputIndirection + OutputIndex * KernelSize;
+        TileDepthwiseParams.OutputCount = OutputCount;
+
+        MlasConvSymDepthwise(TileDepthwiseParams);
+
+        TilePointwiseParams.Output = static_cast<int8_t*>(PointwiseParams.Output) + OutputIndex * OutputChannels;
+        TilePointwiseParams.OutputCount = OutputCount;
+
+        MlasConvSym(TilePointwiseParams);
+
+        OutputIndex += OutputCount;
+    }
+}
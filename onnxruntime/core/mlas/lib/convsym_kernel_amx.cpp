@@ -0,0 +1,245 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convsym_kernel_amx.cpp
+
+Abstract:
+
+    This module implements the symmetric quantized integer convolution
+    kernel for amx.
+
+--*/
+
+#include "mlasi.h"
+#include "amx_common.h"
+
+#define TMM0 0
+#define TMM1 1
+#define TMM2 2
+#define TMM3 3
+#define TMM4 4
+#define TMM5 5
+#define TMM6 6
+
+#define TILE_M 16
+#define TILE_N 16
+#define TILE_K 64
+
+//
+// The kernel computes up to 16 output pixels by up to 64 output channels.
+// Tiles 0 - 3 accumulate the four 16x16 blocks of the output, tile 4 holds
+// the 16x64 block of input channels gathered through the indirection buffer
+// and tiles 5, 6 alternately hold the 64x16 blocks of the filter:
+//
+//           B T5  B T6  B T5  B T6
+//    A T4    T0    T1    T2    T3
+//
+// With four input and sixteen output channels per pack, the filter packed by
+// MlasConvSymPackW is already in the tile layout: each tile row is a group of
+// four input channels of sixteen output channels.
+//
+
+static inline
+uint16_t
+ChannelMask(
+    unsigned ChannelCount,
+    unsigned n
+    )
+{
+    const unsigned Count = ChannelCount - n * TILE_N;
+    return (Count >= TILE_N) ? uint16_t(0xFFFF) : uint16_t((1u << Count) - 1);
+}
+
+/**
+ * @brief Fill the accumulator tile buffer with the bias of its channels.
+ *
+ */
+static inline
+void
+InitAccumulatorTile(
+    int32_t* Tile,
+    const int32_t* Bias,
+    uint16_t MaskN
+    )
+{
+    const __m512i bias = _mm512_maskz_loadu_epi32(MaskN, Bias);
+
+    for (size_t m = 0; m < TILE_M; m++) {
+        _mm512_store_si512(Tile + m * TILE_N, bias);
+    }
+}
+
+/**
+ * @brief Requantize the accumulator tile buffer to the output.
+ *
+ */
+static inline
+void
+StoreOutputTile(
+    const int32_t* Tile,
+    uint8_t* Output,
+    size_t OutputChannels,
+    unsigned OutputCount,
+    uint16_t MaskN,
+    const float* Scale,
+    bool PerChannelScale,
+    const MLAS_CONV_SYM_POST_PROCESS_PARAMS* PostProcessParams
+    )
+{
+    const __m512 scale = PerChannelScale ? _mm512_maskz_loadu_ps(MaskN, Scale) : _mm512_set1_ps(Scale[0]);
+    const __m512 minimum = _mm512_set1_ps(PostProcessParams->MinimumValue);
+    const __m512 maximum = _mm512_set1_ps(PostProcessParams->MaximumValue);
+    const __m512i zeropoint = _mm512_set1_epi32(PostProcessParams->OutputZeroPoint);
+
+    for (unsigned m = 0; m < OutputCount; m++) {
+        __m512 value = _mm512_cvtepi32_ps(_mm512_load_si512(Tile + m * TILE_N));
+        value = _mm512_mul_ps(value, scale);
+        value = _mm512_min_ps(_mm512_max_ps(value, minimum), maximum);
+        const __m512i output = _mm512_add_epi32(_mm512_cvtps_epi32(value), zeropoint);
+        _mm512_mask_cvtepi32_storeu_epi8(Output + m * OutputChannels, MaskN, output);
+    }
+}
+
+void
+MLASCALL
+MlasConvSymKernelAmx(
+    const void* Input,
+    const void* Filter,
+    void* Output,
+    size_t KernelSize,
+    size_t InputChannels,
+    size_t OutputChannels,
+    unsigned ChannelCount,
+    unsigned OutputCount,
+    const MLAS_CONV_SYM_POST_PROCESS_PARAMS* PostProcessParams,
+    unsigned KernelFlags
+    )
+{
+    MLAS_DECLSPEC_ALIGN(uint8_t InputTile[TILE_M * TILE_K], 64);
+    MLAS_DECLSPEC_ALIGN(int8_t FilterTile[TILE_K * TILE_N], 64);
+    MLAS_DECLSPEC_ALIGN(int32_t AccumulatorTile[TILE_M * TILE_N], 64);
+
+    MlasAmxLoadTileConfig();
+
+    const bool InputDirect = (KernelFlags & MLAS_CONV_SYM_FLAG_INPUT_DIRECT) != 0;
+    const bool PerChannelScale = (KernelFlags & MLAS_CONV_SYM_FLAG_PER_CHANNEL_SCALE) != 0;
+    const unsigned TileCountN = (ChannelCount + TILE_N - 1) / TILE_N;
+
+    //
+    // The filter of each block of sixteen output channels is stored together.
+    //
+
+    const int8_t* filter = static_cast<const int8_t*>(Filter);
+    const size_t FilterStrideN = TILE_N * InputChannels * KernelSize;
+    const int32_t* Bias = PostProcessParams->Bias;
+
+    InitAccumulatorTile(AccumulatorTile, Bias, ChannelMask(ChannelCount, 0));
+    tile_loadd(TMM0, AccumulatorTile, TILE_N * sizeof(int32_t));
+    if (TileCountN > 1) {
+        InitAccumulatorTile(AccumulatorTile, Bias + TILE_N, ChannelMask(ChannelCount, 1));
+        tile_loadd(TMM1, AccumulatorTile, TILE_N * sizeof(int32_t));
+    }
+    if (TileCountN > 2) {
+        InitAccumulatorTile(AccumulatorTile, Bias + 2 * TILE_N, ChannelMask(ChannelCount, 2));
+        tile_loadd(TMM2, AccumulatorTile, TILE_N * sizeof(int32_t));
+    }
+    if (TileCountN > 3) {
+        InitAccumulatorTile(AccumulatorTile, Bias + 3 * TILE_N, ChannelMask(ChannelCount, 3));
+        tile_loadd(TMM3, AccumulatorTile, TILE_N * sizeof(int32_t));
+    }
+
+    //
+    // The rows past the output count and the columns past the input channels
+    // stay zero, so the filter rows they meet do not contribute.
+    //
+
+    std::memset(InputTile, 0, sizeof(InputTile));
+    std::memset(FilterTile, 0, sizeof(FilterTile));
+
+    for (size_t k = 0; k < KernelSize; k++) {
+
+        const uint8_t* InputRows[TILE_M];
+
+        for (unsigned m = 0; m < OutputCount; m++) {
+            InputRows[m] = InputDirect
+                ? static_cast<const uint8_t*>(Input) + m * InputChannels
+                : static_cast<const uint8_t* const*>(Input)[m * KernelSize + k];
+        }
+
+        for (size_t ic = 0; ic < InputChannels; ic += TILE_K) {
+
+            const size_t CountK = std::min<size_t>(InputChannels - ic, TILE_K);
+            const __mmask64 MaskK = (CountK == TILE_K) ? ~__mmask64(0) : (__mmask64(1) << CountK) - 1;
+
+            for (unsigned m = 0; m < OutputCount; m++) {
+                _mm512_store_si512(InputTile + m * TILE_K, _mm512_maskz_loadu_epi8(MaskK, InputRows[m] + ic));
+            }
+            tile_loadd(TMM4, InputTile, TILE_K);
+
+            const int8_t* filter_blk = filter + (k * InputChannels + ic) * TILE_N;
+
+            //
+            // A partial block of input channels is copied so that the tile load
+            // stays within the packed filter.
+            //
+
+            for (unsigned n = 0; n < TileCountN; n++) {
+
+                const int8_t* b_blk = filter_blk + n * FilterStrideN;
+
+                if (CountK < TILE_K) {
+                    std::memcpy(FilterTile, b_blk, CountK * TILE_N);
+                    b_blk = FilterTile;
+                }
+
+                switch (n) {
+                    case 0:
+                        tile_loadd(TMM5, b_blk, TILE_K);
+                        tile_dpbusd(TMM0, TMM4, TMM5);
+                        break;
+                    case 1:
+                        tile_loadd(TMM6, b_blk, TILE_K);
+                        tile_dpbusd(TMM1, TMM4, TMM6);
+                        break;
+                    case 2:
+                        tile_loadd(TMM5, b_blk, TILE_K);
+                        tile_dpbusd(TMM2, TMM4, TMM5);
+                        break;
+                    default:
+                        tile_loadd(TMM6, b_blk, TILE_K);
+                        tile_dpbusd(TMM3, TMM4, TMM6);
+                        break;
+                }
+            }
+        }
+    }
+
+    uint8_t* output = static_cast<uint8_t*>(Output);
+    const float* Scale = PostProcessParams->Scale;
+
+    tile_stored(TMM0, AccumulatorTile, TILE_N * sizeof(int32_t));
+    StoreOutputTile(AccumulatorTile, output, OutputChannels, OutputCount, ChannelMask(ChannelCount, 0),
+                    Scale, PerChannelScale, PostProcessParams);
+    if (TileCountN > 1) {
+        tile_stored(TMM1, AccumulatorTile, TILE_N * sizeof(int32_t));
+        StoreOutputTile(AccumulatorTile, output + TILE_N, OutputChannels, OutputCount, ChannelMask(ChannelCount, 1),
+                        Scale + (PerChannelScale ? TILE_N : 0), PerChannelScale, PostProcessParams);
+    }
+    if (TileCountN > 2) {
+        tile_stored(TMM2, AccumulatorTile, TILE_N * sizeof(int32_t));
+        StoreOutputTile(AccumulatorTile, output + 2 * TILE_N, OutputChannels, OutputCount,
+                        ChannelMask(ChannelCount, 2), Scale + (PerChannelScale ? 2 * TILE_N : 0), PerChannelScale,
+                        PostProcessParams);
+    }
+    if (TileCountN > 3) {
+        tile_stored(TMM3, AccumulatorTile, TILE_N * sizeof(int32_t));
+        StoreOutputTile(AccumulatorTile, output + 3 * TILE_N, OutputChannels, OutputCount,
+                        ChannelMask(ChannelCount, 3), Scale + (PerChannelScale ? 3 * TILE_N : 0), PerChannelScale,
+                        PostProcessParams);
+    }
+}
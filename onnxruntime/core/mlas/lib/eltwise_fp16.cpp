@@ -0,0 +1,108 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+    eltwise_fp16.cpp
+
+Abstract:
+    This module implements the element wise binary operations for fp16
+    tensors.
+--*/
+
+#include "mlasi.h"
+
+#include "fp16_common.h"
+
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+
+struct EltwiseAddOp {
+    static MLAS_FLOAT16X8 Apply(MLAS_FLOAT16X8 a, MLAS_FLOAT16X8 b) { return MlasAddFloat16x8(a, b); }
+    static MLAS_FLOAT16X4 Apply(MLAS_FLOAT16X4 a, MLAS_FLOAT16X4 b) { return MlasAddFloat16x4(a, b); }
+};
+
+struct EltwiseMulOp {
+    static MLAS_FLOAT16X8 Apply(MLAS_FLOAT16X8 a, MLAS_FLOAT16X8 b) { return MlasMultiplyFloat16x8(a, b); }
+    static MLAS_FLOAT16X4 Apply(MLAS_FLOAT16X4 a, MLAS_FLOAT16X4 b) { return MlasMultiplyFloat16x4(a, b); }
+};
+
+template <typename OpType>
+void
+MlasEltwiseFp16(
+    const _mlas_fp16_* Left,
+    const _mlas_fp16_* Right,
+    _mlas_fp16_* Output,
+    size_t N,
+    bool RightIsScalar
+    )
+{
+    const MLAS_FLOAT16X8 RightBroadcast = RightIsScalar ? MlasBroadcastFloat16x8(Right) : MlasZeroFloat16x8();
+
+    while (N >= 8) {
+        MLAS_FLOAT16X8 RightVec = RightIsScalar ? RightBroadcast : MlasLoadFloat16x8(Right);
+        MlasStoreFloat16x8(Output, OpType::Apply(MlasLoadFloat16x8(Left), RightVec));
+
+        Left += 8;
+        Right += RightIsScalar ? 0 : 8;
+        Output += 8;
+        N -= 8;
+    }
+
+    if (N >= 4) {
+        MLAS_FLOAT16X4 RightVec = RightIsScalar ? MlasToLowHalfFloat16x4(RightBroadcast) : MlasLoadFloat16x4(Right);
+        MlasStoreFloat16x4(Output, OpType::Apply(MlasLoadFloat16x4(Left), RightVec));
+
+        Left += 4;
+        Right += RightIsScalar ? 0 : 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    if (N > 0) {
+        //
+        // Copy the tail so that the loads stay within the buffers.
+        //
+
+        _mlas_fp16_ LeftTail[4] = {0, 0, 0, 0};
+        _mlas_fp16_ RightTail[4] = {0, 0, 0, 0};
+        std::copy_n(Left, N, LeftTail);
+        std::copy_n(Right, RightIsScalar ? 1 : N, RightTail);
+
+        MLAS_FLOAT16X4 RightVec = RightIsScalar ? MlasToLowHalfFloat16x4(RightBroadcast) : MlasLoadFloat16x4(RightTail);
+        MlasStorePartialFloat16x4(Output, OpType::Apply(MlasLoadFloat16x4(LeftTail), RightVec), N);
+    }
+}
+
+void
+MLASCALL
+MlasEltwiseAdd(
+    const MLAS_FP16* Left,
+    const MLAS_FP16* Right,
+    MLAS_FP16* Output,
+    size_t N,
+    bool RightIsScalar
+    )
+{
+    MlasEltwiseFp16<EltwiseAddOp>(reinterpret_cast<const _mlas_fp16_*>(Left),
+                                  reinterpret_cast<const _mlas_fp16_*>(Right),
+                                  reinterpret_cast<_mlas_fp16_*>(Output), N, RightIsScalar);
+}
+
+void
+MLASCALL
+MlasEltwiseMul(
+    const MLAS_FP16* Left,
+    const MLAS_FP16* Right,
+    MLAS_FP16* Output,
+    size_t N,
+    bool RightIsScalar
+    )
+{
+    MlasEltwiseFp16<EltwiseMulOp>(reinterpret_cast<const _mlas_fp16_*>(Left),
+                                  reinterpret_cast<const _mlas_fp16_*>(Right),
+                                  reinterpret_cast<_mlas_fp16_*>(Output), N, RightIsScalar);
+}
+
+#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
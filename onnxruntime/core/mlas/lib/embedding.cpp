@@ -0,0 +1,214 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    embedding.cpp
+
+Abstract:
+
+    This module implements the reduction of a bag of embedding table rows.
+
+    The indices of a bag are resolved to row addresses a block at a time. The
+    kernel sums a block of columns of every row of the block with vector
+    accumulators and prefetches the same columns of the rows that follow, so
+    the scattered row reads of a large table overlap the accumulation.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of rows resolved and summed by one call of the kernel.
+//
+
+constexpr size_t MLAS_EMBEDDING_BAG_ROW_BLOCK = 64;
+
+//
+// Number of rows ahead of the summed row that are prefetched.
+//
+
+constexpr size_t MLAS_EMBEDDING_BAG_PREFETCH_DISTANCE = 8;
+
+MLAS_FORCEINLINE
+void
+MlasEmbeddingBagPrefetch(
+    const float* Address
+    )
+{
+#if defined(MLAS_TARGET_AMD64_IX86)
+    _mm_prefetch(reinterpret_cast<const char*>(Address), _MM_HINT_T0);
+#elif defined(__GNUC__)
+    __builtin_prefetch(Address);
+#else
+    MLAS_UNREFERENCED_PARAMETER(Address);
+#endif
+}
+
+void
+MLASCALL
+MlasEmbeddingBagF32Kernel(
+    const float* const* Rows,
+    size_t RowCount,
+    size_t Dim,
+    float* Output,
+    bool Accumulate
+    )
+/*++
+
+Routine Description:
+
+    This routine sums rows of an embedding table into an output row.
+
+Arguments:
+
+    Rows - Supplies the addresses of the rows to sum.
+
+    RowCount - Supplies the number of rows.
+
+    Dim - Supplies the number of elements of a row.
+
+    Output - Supplies the output row.
+
+    Accumulate - Supplies true if the sum is added to the output row, false
+        if the sum replaces it.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t d = 0;
+
+    for (; d + 16 <= Dim; d += 16) {
+
+        MLAS_FLOAT32X4 Accumulator0 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator1 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator2 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator3 = MlasZeroFloat32x4();
+
+        if (Accumulate) {
+            Accumulator0 = MlasLoadFloat32x4(Output + d);
+            Accumulator1 = MlasLoadFloat32x4(Output + d + 4);
+            Accumulator2 = MlasLoadFloat32x4(Output + d + 8);
+            Accumulator3 = MlasLoadFloat32x4(Output + d + 12);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            if (r + MLAS_EMBEDDING_BAG_PREFETCH_DISTANCE < RowCount) {
+                MlasEmbeddingBagPrefetch(Rows[r + MLAS_EMBEDDING_BAG_PREFETCH_DISTANCE] + d);
+            }
+            const float* Row = Rows[r] + d;
+            Accumulator0 = MlasAddFloat32x4(Accumulator0, MlasLoadFloat32x4(Row));
+            Accumulator1 = MlasAddFloat32x4(Accumulator1, MlasLoadFloat32x4(Row + 4));
+            Accumulator2 = MlasAddFloat32x4(Accumulator2, MlasLoadFloat32x4(Row + 8));
+            Accumulator3 = MlasAddFloat32x4(Accumulator3, MlasLoadFloat32x4(Row + 12));
+        }
+
+        MlasStoreFloat32x4(Output + d, Accumulator0);
+        MlasStoreFloat32x4(Output + d + 4, Accumulator1);
+        MlasStoreFloat32x4(Output + d + 8, Accumulator2);
+        MlasStoreFloat32x4(Output + d + 12, Accumulator3);
+    }
+
+    for (; d + 4 <= Dim; d += 4) {
+
+        MLAS_FLOAT32X4 Accumulator = Accumulate ? MlasLoadFloat32x4(Output + d) : MlasZeroFloat32x4();
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulator = MlasAddFloat32x4(Accumulator, MlasLoadFloat32x4(Rows[r] + d));
+        }
+
+        MlasStoreFloat32x4(Output + d, Accumulator);
+    }
+
+    for (; d < Dim; d++) {
+
+        float Accumulator = Accumulate ? Output[d] : 0.0f;
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulator += Rows[r][d];
+        }
+
+        Output[d] = Accumulator;
+    }
+}
+
+template<typename IndexType>
+void
+MlasEmbeddingBagImpl(
+    const float* Table,
+    size_t RowCount,
+    size_t Dim,
+    const IndexType* Indices,
+    size_t IndexCount,
+    float Scale,
+    float* Output
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_EMBEDDING_BAG_FLOAT_KERNEL* EmbeddingBagF32Kernel = GetMlasPlatform().EmbeddingBagF32Kernel;
+#else
+    MLAS_EMBEDDING_BAG_FLOAT_KERNEL* EmbeddingBagF32Kernel = MlasEmbeddingBagF32Kernel;
+#endif
+
+    if (IndexCount == 0) {
+        std::fill_n(Output, Dim, 0.0f);
+        return;
+    }
+
+    const float* Rows[MLAS_EMBEDDING_BAG_ROW_BLOCK];
+
+    for (size_t i = 0; i < IndexCount; i += MLAS_EMBEDDING_BAG_ROW_BLOCK) {
+
+        const size_t Count = std::min(IndexCount - i, MLAS_EMBEDDING_BAG_ROW_BLOCK);
+
+        for (size_t r = 0; r < Count; r++) {
+            const int64_t Index = int64_t(Indices[i + r]);
+            const size_t Row = size_t(Index < 0 ? Index + int64_t(RowCount) : Index);
+            Rows[r] = Table + Row * Dim;
+        }
+
+        EmbeddingBagF32Kernel(Rows, Count, Dim, Output, i != 0);
+    }
+
+    if (Scale != 1.0f) {
+        for (size_t d = 0; d < Dim; d++) {
+            Output[d] *= Scale;
+        }
+    }
+}
+
+void
+MLASCALL
+MlasEmbeddingBag(
+    const float* Table,
+    size_t RowCount,
+    size_t Dim,
+    const int32_t* Indices,
+    size_t IndexCount,
+    float Scale,
+    float* Output
+    )
+{
+    MlasEmbeddingBagImpl(Table, RowCount, Dim, Indices, IndexCount, Scale, Output);
+}
+
+void
+MLASCALL
+MlasEmbeddingBag(
+    const float* Table,
+    size_t RowCount,
+    size_t Dim,
+    const int64_t* Indices,
+    size_t IndexCount,
+    float Scale,
+    float* Output
+    )
+{
+    MlasEmbeddingBagImpl(Table, RowCount, Dim, Indices, IndexCount, Scale, Output);
+}
@@ -0,0 +1,522 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    flashattn.cpp
+
+Abstract:
+
+    This module implements a fused scaled dot product attention,
+    MlasFlashAttention.
+
+    Each work item owns a block of query rows of one head and walks the keys
+    and values in blocks that stay resident in the L2 cache. The scores of a
+    block are exponentiated against a running row maximum, and the partial
+    output is rescaled whenever that maximum grows, so the full attention
+    probabilities are never written to memory.
+
+    The keys and values may also come from a quantized key/value cache, in
+    which case each block is expanded into a thread local buffer as it is
+    visited, so the cache is only streamed from memory at its quantized size.
+
+    A paged key/value cache is walked through its block table, splitting
+    the key/value blocks at the cache block boundaries.
+
+--*/
+
+#include "mlasi.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+
+//
+// Query rows and key/value rows processed per block. A key/value block of
+// 128 rows with a head size of 128 is 128KB, which leaves room in a typical
+// L2 cache for the query rows, the scores and the output block.
+//
+
+constexpr size_t FlashAttentionBlockM = 64;
+constexpr size_t FlashAttentionBlockN = 128;
+
+MLAS_FORCEINLINE
+size_t
+KvCacheQuantBlockCount(
+    size_t HeadSize
+    )
+{
+    return MlasDivRoundup(HeadSize, MLAS_KV_CACHE_QUANT_BLOCK_SIZE);
+}
+
+void
+KvCacheDequantizeRows(
+    const uint8_t* Input,
+    size_t ldi,
+    float* Output,
+    size_t RowCount,
+    size_t HeadSize,
+    size_t BitWidth
+    )
+/*++
+
+Routine Description:
+
+    This routine expands rows of a quantized key/value cache to float.
+
+Arguments:
+
+    Input - Supplies the first quantized row.
+
+    ldi - Supplies the bytes between quantized rows.
+
+    Output - Supplies the output rows, HeadSize elements apart.
+
+    RowCount - Supplies the number of rows.
+
+    HeadSize - Supplies the number of elements per row.
+
+    BitWidth - Supplies the quantized bit width, 8 or 4.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockCount = KvCacheQuantBlockCount(HeadSize);
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        const float* Scales = reinterpret_cast<const float*>(Input);
+        const uint8_t* Data = Input + BlockCount * sizeof(float);
+
+        for (size_t b = 0; b < BlockCount; b++) {
+
+            const size_t Begin = b * MLAS_KV_CACHE_QUANT_BLOCK_SIZE;
+            const size_t End = std::min(Begin + MLAS_KV_CACHE_QUANT_BLOCK_SIZE, HeadSize);
+            const float Scale = Scales[b];
+
+            if (BitWidth == 8) {
+                const int8_t* Values = reinterpret_cast<const int8_t*>(Data);
+                for (size_t k = Begin; k < End; k++) {
+                    Output[k] = Scale * float(Values[k]);
+                }
+            } else {
+                //
+                // The blocks start at an even element, so each byte holds a
+                // pair of elements of the same block.
+                //
+
+                size_t k = Begin;
+                for (; k + 2 <= End; k += 2) {
+                    const uint8_t Packed = Data[k / 2];
+                    Output[k] = Scale * float(int8_t(uint8_t(Packed << 4)) >> 4);
+                    Output[k + 1] = Scale * float(int8_t(Packed) >> 4);
+                }
+                if (k < End) {
+                    Output[k] = Scale * float(int8_t(uint8_t(Data[k / 2] << 4)) >> 4);
+                }
+            }
+        }
+
+        Input += ldi;
+        Output += HeadSize;
+    }
+}
+
+MLAS_FORCEINLINE
+float
+FlashAttentionReduceMaximum(
+    const float* Input,
+    size_t N
+    )
+{
+#if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
+    return GetMlasPlatform().ReduceMaximumF32Kernel(Input, N);
+#else
+    return MlasReduceMaximumF32Kernel(Input, N);
+#endif
+}
+
+MLAS_FORCEINLINE
+float
+FlashAttentionComputeSumExp(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float NegativeMaximum
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().ComputeSumExpF32Kernel(Input, Output, N, &NegativeMaximum);
+#else
+    return MlasComputeSumExpF32Kernel(Input, Output, N, &NegativeMaximum);
+#endif
+}
+
+void
+FlashAttentionBlock(
+    const MLAS_FLASH_ATTENTION_PARAMS& Params,
+    size_t Batch,
+    size_t Head,
+    size_t StartM,
+    size_t CountM
+    )
+/*++
+
+Routine Description:
+
+    This routine computes CountM query rows, starting at StartM, of one
+    attention head.
+
+Arguments:
+
+    Params - Supplies the attention parameters.
+
+    Batch - Supplies the batch index.
+
+    Head - Supplies the query head index.
+
+    StartM - Supplies the first query row.
+
+    CountM - Supplies the number of query rows, at most FlashAttentionBlockM.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float Scores[FlashAttentionBlockM * FlashAttentionBlockN], 16 * sizeof(float));
+    float RowMaximum[FlashAttentionBlockM];
+    float RowSum[FlashAttentionBlockM];
+
+    const size_t KvHead = Head / (Params.NumHeads / Params.KvNumHeads);
+
+    const float* Q = Params.Q + Batch * Params.QBatchStride + Head * Params.QHeadStride + StartM * Params.ldq;
+    float* Output = Params.Output + Batch * Params.OutputBatchStride + Head * Params.OutputHeadStride +
+                    StartM * Params.ldo;
+
+    const size_t HeadSize = Params.HeadSize;
+    const size_t VHeadSize = Params.VHeadSize;
+
+    //
+    // A quantized key/value block is expanded into a thread local buffer
+    // before it is multiplied.
+    //
+
+    const size_t KvBitWidth = Params.KvBitWidth;
+    const float* K = nullptr;
+    const float* V = nullptr;
+    const uint8_t* QuantizedK = nullptr;
+    const uint8_t* QuantizedV = nullptr;
+    float* KBlock = nullptr;
+    float* VBlock = nullptr;
+
+    if (KvBitWidth == 0) {
+        K = Params.K + KvHead * Params.KHeadStride;
+        V = Params.V + KvHead * Params.VHeadStride;
+    } else {
+        QuantizedK = Params.QuantizedK + KvHead * Params.KHeadStride;
+        QuantizedV = Params.QuantizedV + KvHead * Params.VHeadStride;
+        MlasThreadedBufAlloc(FlashAttentionBlockN * (HeadSize + VHeadSize) * sizeof(float));
+        KBlock = reinterpret_cast<float*>(ThreadedBufHolder.get());
+        VBlock = KBlock + FlashAttentionBlockN * HeadSize;
+    }
+
+    //
+    // Returns the offset of key/value row n of this batch, which is in a
+    // block of the batch's block table for a paged cache.
+    //
+
+    const int32_t* BlockTable = (Params.BlockTables != nullptr)
+                                    ? Params.BlockTables + Batch * Params.BlockTableStride
+                                    : nullptr;
+
+    auto KvRowOffset = [&](ptrdiff_t n, size_t BatchStride, size_t ld) -> size_t {
+        if (BlockTable == nullptr) {
+            return Batch * BatchStride + size_t(n) * ld;
+        }
+        const size_t Block = size_t(BlockTable[size_t(n) / Params.KvBlockSize]);
+        return Block * BatchStride + (size_t(n) % Params.KvBlockSize) * ld;
+    };
+
+    const ptrdiff_t KvLength = (Params.KvSequenceLengths != nullptr)
+                                   ? ptrdiff_t(Params.KvSequenceLengths[Batch])
+                                   : ptrdiff_t(Params.KvSequenceLength);
+
+    //
+    // Query row s is aligned with key row s + PastLength, which is the last
+    // key the row may see when the attention is causal.
+    //
+
+    const ptrdiff_t PastLength = KvLength - ptrdiff_t(Params.SequenceLength);
+
+    auto VisibleBegin = [&](size_t m) -> ptrdiff_t {
+        if (Params.LocalWindowSize < 0) {
+            return 0;
+        }
+        return std::max<ptrdiff_t>(0, ptrdiff_t(StartM + m) + PastLength - Params.LocalWindowSize);
+    };
+
+    auto VisibleEnd = [&](size_t m) -> ptrdiff_t {
+        if (!Params.Causal) {
+            return KvLength;
+        }
+        return std::clamp<ptrdiff_t>(ptrdiff_t(StartM + m) + PastLength + 1, 0, KvLength);
+    };
+
+    for (size_t m = 0; m < CountM; m++) {
+        std::fill_n(Output + m * Params.ldo, VHeadSize, 0.0f);
+        RowMaximum[m] = std::numeric_limits<float>::lowest();
+        RowSum[m] = 0.0f;
+    }
+
+    //
+    // Only the key blocks visible to some row of this query block are
+    // visited, which skips the upper triangle for causal attention and the
+    // keys behind a local window.
+    //
+
+    const ptrdiff_t BlockBegin = VisibleBegin(0);
+    const ptrdiff_t BlockEnd = VisibleEnd(CountM - 1);
+
+    size_t CountN = 0;
+
+    for (ptrdiff_t n = BlockBegin; n < BlockEnd; n += ptrdiff_t(CountN)) {
+
+        CountN = std::min<size_t>(FlashAttentionBlockN, size_t(BlockEnd - n));
+
+        if (BlockTable != nullptr) {
+            CountN = std::min(CountN, Params.KvBlockSize - size_t(n) % Params.KvBlockSize);
+        }
+
+        const size_t KOffset = KvRowOffset(n, Params.KBatchStride, Params.ldk);
+        const size_t VOffset = KvRowOffset(n, Params.VBatchStride, Params.ldv);
+
+        const float* KRows;
+        size_t ldk;
+
+        if (KvBitWidth == 0) {
+            KRows = K + KOffset;
+            ldk = Params.ldk;
+        } else {
+            KvCacheDequantizeRows(QuantizedK + KOffset, Params.ldk, KBlock, CountN, HeadSize, KvBitWidth);
+            KRows = KBlock;
+            ldk = HeadSize;
+        }
+
+        MlasGemm(CblasNoTrans, CblasTrans, CountM, CountN, HeadSize, Params.Scale,
+                 Q, Params.ldq, KRows, ldk,
+                 0.0f, Scores, FlashAttentionBlockN, nullptr);
+
+        for (size_t m = 0; m < CountM; m++) {
+
+            float* Row = Scores + m * FlashAttentionBlockN;
+
+            const size_t Begin = size_t(std::clamp<ptrdiff_t>(VisibleBegin(m) - n, 0, ptrdiff_t(CountN)));
+            const size_t End = size_t(std::clamp<ptrdiff_t>(VisibleEnd(m) - n, 0, ptrdiff_t(CountN)));
+
+            std::fill(Row, Row + Begin, 0.0f);
+            std::fill(Row + std::max(Begin, End), Row + CountN, 0.0f);
+
+            if (Begin >= End) {
+                continue;
+            }
+
+            const float Maximum = std::max(RowMaximum[m], FlashAttentionReduceMaximum(Row + Begin, End - Begin));
+            const float Sum = FlashAttentionComputeSumExp(Row + Begin, Row + Begin, End - Begin, -Maximum);
+
+            //
+            // Rescale the partial output to the new row maximum.
+            //
+
+            if (RowSum[m] != 0.0f && Maximum != RowMaximum[m]) {
+                const float Factor = std::exp(RowMaximum[m] - Maximum);
+                float* OutputRow = Output + m * Params.ldo;
+                for (size_t i = 0; i < VHeadSize; i++) {
+                    OutputRow[i] *= Factor;
+                }
+                RowSum[m] *= Factor;
+            }
+
+            RowMaximum[m] = Maximum;
+            RowSum[m] += Sum;
+        }
+
+        const float* VRows;
+        size_t ldv;
+
+        if (KvBitWidth == 0) {
+            VRows = V + VOffset;
+            ldv = Params.ldv;
+        } else {
+            KvCacheDequantizeRows(QuantizedV + VOffset, Params.ldv, VBlock, CountN, VHeadSize, KvBitWidth);
+            VRows = VBlock;
+            ldv = VHeadSize;
+        }
+
+        MlasGemm(CblasNoTrans, CblasNoTrans, CountM, VHeadSize, CountN, 1.0f,
+                 Scores, FlashAttentionBlockN, VRows, ldv,
+                 1.0f, Output, Params.ldo, nullptr);
+    }
+
+    for (size_t m = 0; m < CountM; m++) {
+        if (RowSum[m] != 0.0f) {
+            const float Scale = 1.0f / RowSum[m];
+            float* OutputRow = Output + m * Params.ldo;
+            for (size_t i = 0; i < VHeadSize; i++) {
+                OutputRow[i] *= Scale;
+            }
+        }
+    }
+}
+
+}  // namespace
+
+void
+MLASCALL
+MlasFlashAttention(
+    const MLAS_FLASH_ATTENTION_PARAMS* Params,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    if (Params->KvNumHeads == 0 || Params->NumHeads % Params->KvNumHeads != 0) {
+        MLAS_THROW_EX(std::invalid_argument, "NumHeads must be a multiple of KvNumHeads");
+    }
+
+    if (Params->KvBitWidth != 0 && Params->KvBitWidth != 8 && Params->KvBitWidth != 4) {
+        MLAS_THROW_EX(std::invalid_argument, "KvBitWidth must be 0, 8 or 4");
+    }
+
+    if (Params->BlockTables != nullptr && Params->KvBlockSize == 0) {
+        MLAS_THROW_EX(std::invalid_argument, "KvBlockSize must be nonzero for a paged key/value cache");
+    }
+
+    const size_t BlockCountM = MlasDivRoundup(Params->SequenceLength, FlashAttentionBlockM);
+    const size_t HeadCount = Params->BatchSize * Params->NumHeads;
+
+    MlasTrySimpleParallel(ThreadPool, ptrdiff_t(HeadCount * BlockCountM), [&](ptrdiff_t tid) {
+        const size_t BatchHead = size_t(tid) / BlockCountM;
+        const size_t StartM = (size_t(tid) % BlockCountM) * FlashAttentionBlockM;
+        const size_t CountM = std::min(FlashAttentionBlockM, Params->SequenceLength - StartM);
+
+        FlashAttentionBlock(*Params, BatchHead / Params->NumHeads, BatchHead % Params->NumHeads, StartM, CountM);
+    });
+}
+
+size_t
+MLASCALL
+MlasKvCacheQuantRowSize(
+    size_t HeadSize,
+    size_t BitWidth
+    )
+{
+    size_t DataSize;
+
+    if (BitWidth == 8) {
+        DataSize = HeadSize;
+    } else if (BitWidth == 4) {
+        DataSize = MlasDivRoundup(HeadSize, 2);
+    } else {
+        return 0;
+    }
+
+    const size_t RowSize = KvCacheQuantBlockCount(HeadSize) * sizeof(float) + DataSize;
+
+    return MlasDivRoundup(RowSize, sizeof(float)) * sizeof(float);
+}
+
+void
+MLASCALL
+MlasQuantizeKvCacheRows(
+    const float* Input,
+    size_t ldi,
+    uint8_t* Output,
+    size_t ldo,
+    size_t RowCount,
+    size_t HeadSize,
+    size_t BitWidth
+    )
+/*++
+
+Routine Description:
+
+    This routine quantizes rows of keys or values into the key/value cache
+    row format, using a symmetric scale per block of
+    MLAS_KV_CACHE_QUANT_BLOCK_SIZE elements.
+
+Arguments:
+
+    Input - Supplies the first input row.
+
+    ldi - Supplies the elements between input rows.
+
+    Output - Supplies the first quantized row.
+
+    ldo - Supplies the bytes between quantized rows.
+
+    RowCount - Supplies the number of rows.
+
+    HeadSize - Supplies the number of elements per row.
+
+    BitWidth - Supplies the quantized bit width, 8 or 4.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t RowSize = MlasKvCacheQuantRowSize(HeadSize, BitWidth);
+
+    if (RowSize == 0) {
+        MLAS_THROW_EX(std::invalid_argument, "BitWidth must be 8 or 4");
+    }
+
+    const size_t BlockCount = KvCacheQuantBlockCount(HeadSize);
+    const float MaximumValue = (BitWidth == 8) ? 127.0f : 7.0f;
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        float* Scales = reinterpret_cast<float*>(Output);
+        uint8_t* Data = Output + BlockCount * sizeof(float);
+
+        std::fill(Data, Output + RowSize, uint8_t(0));
+
+        for (size_t b = 0; b < BlockCount; b++) {
+
+            const size_t Begin = b * MLAS_KV_CACHE_QUANT_BLOCK_SIZE;
+            const size_t End = std::min(Begin + MLAS_KV_CACHE_QUANT_BLOCK_SIZE, HeadSize);
+
+            float AbsoluteMaximum = 0.0f;
+            for (size_t k = Begin; k < End; k++) {
+                AbsoluteMaximum = std::max(AbsoluteMaximum, std::fabs(Input[k]));
+            }
+
+            const float Scale = AbsoluteMaximum / MaximumValue;
+            const float InverseScale = (Scale != 0.0f) ? 1.0f / Scale : 0.0f;
+            Scales[b] = Scale;
+
+            for (size_t k = Begin; k < End; k++) {
+                const float Value = std::clamp(std::nearbyint(Input[k] * InverseScale), -MaximumValue, MaximumValue);
+                const int8_t Quantized = int8_t(Value);
+                if (BitWidth == 8) {
+                    Data[k] = uint8_t(Quantized);
+                } else {
+                    Data[k / 2] |= uint8_t((uint8_t(Quantized) & 0x0F) << ((k & 1) * 4));
+                }
+            }
+        }
+
+        Input += ldi;
+        Output += ldo;
+    }
+}
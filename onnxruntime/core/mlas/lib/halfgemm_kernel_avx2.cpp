@@ -0,0 +1,292 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the half precision GEMM kernel for x64 AVX2.
+
+    The processor has no half precision arithmetic, so the kernel widens the
+    fp16 operands with F16C and accumulates in single precision. The result
+    is rounded to fp16 once, when it is stored.
+
+--*/
+
+#include "mlasi.h"
+#include "halfgemm.h"
+
+#include <immintrin.h>
+
+#include <cstring>
+#include <utility>
+
+struct MLAS_HALF_GEMM_KERNEL_AVX2 {
+    static constexpr bool PackNeeded = false;
+    static constexpr size_t KernelMaxM = 6;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 1;
+
+    static constexpr MLAS_HALF_GEMM_STRIDES Strides{24, 128, 512};
+};
+
+namespace
+{
+
+template <typename IterationFn, size_t... Indices>
+MLAS_FORCEINLINE void
+UnrolledLoopIterations(IterationFn&& f, std::index_sequence<Indices...> /* indices */)
+{
+    (f(Indices), ...);
+}
+
+template <size_t N, typename IterationFn>
+MLAS_FORCEINLINE void
+UnrolledLoop(IterationFn&& f)
+{
+    UnrolledLoopIterations(std::forward<IterationFn>(f), std::make_index_sequence<N>());
+}
+
+MLAS_FORCEINLINE __m256
+LoadFloat16x8(const _mlas_fp16_* Buffer, size_t Count)
+{
+    if (Count == 8) {
+        return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Buffer)));
+    }
+    __m128i Halves = _mm_setzero_si128();
+    std::memcpy(&Halves, Buffer, Count * FP16_SIZE);
+    return _mm256_cvtph_ps(Halves);
+}
+
+MLAS_FORCEINLINE void
+StoreFloat16x8(_mlas_fp16_* Buffer, __m256 Vector, size_t Count)
+{
+    const __m128i Halves = _mm256_cvtps_ph(Vector, _MM_FROUND_TO_NEAREST_INT);
+    if (Count == 8) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Buffer), Halves);
+    } else {
+        std::memcpy(Buffer, &Halves, Count * FP16_SIZE);
+    }
+}
+
+/**
+ * @brief Compute a block of RowCount rows by up to 8 * ColumnVectors columns.
+ *        LastCount is the number of columns in the last vector, 8 for a full
+ *        block.
+ */
+template <size_t RowCount, size_t ColumnVectors>
+MLAS_FORCEINLINE void
+HalfGemmBlockAvx2(
+    size_t LastCount,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    auto ColumnCount = [LastCount](size_t v) -> size_t {
+        return (v + 1 == ColumnVectors) ? LastCount : 8;
+    };
+
+    __m256 Accumulators[RowCount][ColumnVectors];
+
+    UnrolledLoop<ColumnVectors>([&](size_t v) {
+        const __m256 Initial = (Bias != nullptr) ? LoadFloat16x8(Bias + 8 * v, ColumnCount(v))
+                                                 : _mm256_setzero_ps();
+        UnrolledLoop<RowCount>([&](size_t r) {
+            Accumulators[r][v] = Initial;
+            if (!ZeroMode) {
+                Accumulators[r][v] = _mm256_add_ps(
+                    Accumulators[r][v], LoadFloat16x8(C + r * ldc + 8 * v, ColumnCount(v)));
+            }
+        });
+    });
+
+    for (size_t k = 0; k < CountK; k++) {
+        __m256 BVectors[ColumnVectors];
+        UnrolledLoop<ColumnVectors>([&](size_t v) {
+            BVectors[v] = LoadFloat16x8(B + 8 * v, ColumnCount(v));
+        });
+
+        UnrolledLoop<RowCount>([&](size_t r) {
+            const __m256 AVector = _mm256_cvtph_ps(_mm_set1_epi16(static_cast<short>(A[r * lda + k])));
+            UnrolledLoop<ColumnVectors>([&](size_t v) {
+                Accumulators[r][v] = _mm256_fmadd_ps(AVector, BVectors[v], Accumulators[r][v]);
+            });
+        });
+
+        B += ldb;
+    }
+
+    UnrolledLoop<RowCount>([&](size_t r) {
+        UnrolledLoop<ColumnVectors>([&](size_t v) {
+            StoreFloat16x8(C + r * ldc + 8 * v, Accumulators[r][v], ColumnCount(v));
+        });
+    });
+}
+
+template <size_t RowCount>
+void
+HalfGemmRowsAvx2(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    while (CountN >= 16) {
+        HalfGemmBlockAvx2<RowCount, 2>(8, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+        C += 16;
+        B += 16;
+        if (Bias != nullptr) {
+            Bias += 16;
+        }
+        CountN -= 16;
+    }
+
+    if (CountN > 8) {
+        HalfGemmBlockAvx2<RowCount, 2>(CountN - 8, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+    } else if (CountN > 0) {
+        HalfGemmBlockAvx2<RowCount, 1>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+    }
+}
+
+MLAS_FORCEINLINE
+void
+CvtFloat2Half(
+    _mlas_fp16_* dest,
+    const float* src,
+    size_t len
+    )
+{
+    while (len >= 8) {
+        const __m128i Halves = _mm256_cvtps_ph(_mm256_loadu_ps(src), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), Halves);
+        src += 8;
+        dest += 8;
+        len -= 8;
+    }
+
+    while (len > 0) {
+        *dest++ = MLAS_Float2Half(*src++);
+        len--;
+    }
+}
+
+/**
+ * @brief Convert a 2D matrix from float to fp16
+*/
+MLAS_FORCEINLINE
+void
+CvtFloat2Half2D(
+    _mlas_fp16_* dest,
+    const float* src,
+    size_t stride,
+    size_t CntRow,
+    size_t CntCol
+    )
+{
+    if (stride == CntCol) {
+        CvtFloat2Half(dest, src, CntRow * CntCol);
+        return;
+    }
+    while (CntRow > 0) {
+        CvtFloat2Half(dest, src, CntCol);
+        src += stride;
+        dest += CntCol;
+        CntRow--;
+    }
+}
+
+}  // namespace
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackA<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    _mlas_fp16_* D,
+    const float* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+)
+{
+    CvtFloat2Half2D(D, A, lda, CountM, CountK);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    _mlas_fp16_* D,
+    const float* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+)
+{
+    CvtFloat2Half2D(D, B, ldb, CountK, CountN);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernel<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    const bool ZeroMode)
+{
+    switch (std::min(CountM, MLAS_HALF_GEMM_KERNEL_AVX2::KernelMaxM)) {
+        case 1:
+            HalfGemmRowsAvx2<1>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 2:
+            HalfGemmRowsAvx2<2>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 3:
+            HalfGemmRowsAvx2<3>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 4:
+            HalfGemmRowsAvx2<4>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 5:
+            HalfGemmRowsAvx2<5>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        default:
+            HalfGemmRowsAvx2<6>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+    }
+}
+
+
+const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx2 = {
+    MlasHalfGemmOperation<MLAS_HALF_GEMM_KERNEL_AVX2>,
+    nullptr,
+    MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX2>,
+    MLAS_HALF_GEMM_KERNEL_AVX2::PackedK,
+    MLAS_HALF_GEMM_KERNEL_AVX2::KernelMaxM,
+    0
+};
@@ -0,0 +1,282 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_avx512fp16.cpp
+
+Abstract:
+
+    This module implements the half precision GEMM kernel for x64 AVX512-FP16.
+
+    The kernel multiplies and accumulates in half precision, like the NEON
+    kernel does.
+
+--*/
+
+#include "mlasi.h"
+#include "halfgemm.h"
+
+#include <immintrin.h>
+
+#include <utility>
+
+struct MLAS_HALF_GEMM_KERNEL_AVX512FP16 {
+    static constexpr bool PackNeeded = false;
+    static constexpr size_t KernelMaxM = 6;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 1;
+
+    static constexpr MLAS_HALF_GEMM_STRIDES Strides{24, 256, 512};
+};
+
+namespace
+{
+
+template <typename IterationFn, size_t... Indices>
+MLAS_FORCEINLINE void
+UnrolledLoopIterations(IterationFn&& f, std::index_sequence<Indices...> /* indices */)
+{
+    (f(Indices), ...);
+}
+
+template <size_t N, typename IterationFn>
+MLAS_FORCEINLINE void
+UnrolledLoop(IterationFn&& f)
+{
+    UnrolledLoopIterations(std::forward<IterationFn>(f), std::make_index_sequence<N>());
+}
+
+MLAS_FORCEINLINE __m512h
+LoadFloat16x32(const _mlas_fp16_* Buffer, __mmask32 Mask)
+{
+    return _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask, Buffer));
+}
+
+MLAS_FORCEINLINE void
+StoreFloat16x32(_mlas_fp16_* Buffer, __m512h Vector, __mmask32 Mask)
+{
+    _mm512_mask_storeu_epi16(Buffer, Mask, _mm512_castph_si512(Vector));
+}
+
+/**
+ * @brief Compute a block of RowCount rows by up to 32 * ColumnVectors columns.
+ *        LastMask selects the columns of the last vector.
+ */
+template <size_t RowCount, size_t ColumnVectors>
+MLAS_FORCEINLINE void
+HalfGemmBlockAvx512Fp16(
+    __mmask32 LastMask,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    auto ColumnMask = [LastMask](size_t v) -> __mmask32 {
+        return (v + 1 == ColumnVectors) ? LastMask : __mmask32(~0u);
+    };
+
+    __m512h Accumulators[RowCount][ColumnVectors];
+
+    UnrolledLoop<ColumnVectors>([&](size_t v) {
+        const __m512h Initial = (Bias != nullptr) ? LoadFloat16x32(Bias + 32 * v, ColumnMask(v))
+                                                  : _mm512_setzero_ph();
+        UnrolledLoop<RowCount>([&](size_t r) {
+            Accumulators[r][v] = Initial;
+            if (!ZeroMode) {
+                Accumulators[r][v] = _mm512_add_ph(
+                    Accumulators[r][v], LoadFloat16x32(C + r * ldc + 32 * v, ColumnMask(v)));
+            }
+        });
+    });
+
+    for (size_t k = 0; k < CountK; k++) {
+        __m512h BVectors[ColumnVectors];
+        UnrolledLoop<ColumnVectors>([&](size_t v) {
+            BVectors[v] = LoadFloat16x32(B + 32 * v, ColumnMask(v));
+        });
+
+        UnrolledLoop<RowCount>([&](size_t r) {
+            const __m512h AVector = _mm512_castsi512_ph(_mm512_set1_epi16(static_cast<short>(A[r * lda + k])));
+            UnrolledLoop<ColumnVectors>([&](size_t v) {
+                Accumulators[r][v] = _mm512_fmadd_ph(AVector, BVectors[v], Accumulators[r][v]);
+            });
+        });
+
+        B += ldb;
+    }
+
+    UnrolledLoop<RowCount>([&](size_t r) {
+        UnrolledLoop<ColumnVectors>([&](size_t v) {
+            StoreFloat16x32(C + r * ldc + 32 * v, Accumulators[r][v], ColumnMask(v));
+        });
+    });
+}
+
+template <size_t RowCount>
+void
+HalfGemmRowsAvx512Fp16(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    while (CountN >= 64) {
+        HalfGemmBlockAvx512Fp16<RowCount, 2>(__mmask32(~0u), CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+        C += 64;
+        B += 64;
+        if (Bias != nullptr) {
+            Bias += 64;
+        }
+        CountN -= 64;
+    }
+
+    if (CountN > 32) {
+        const __mmask32 LastMask = __mmask32((uint64_t(1) << (CountN - 32)) - 1);
+        HalfGemmBlockAvx512Fp16<RowCount, 2>(LastMask, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+    } else if (CountN > 0) {
+        const __mmask32 LastMask = __mmask32((uint64_t(1) << CountN) - 1);
+        HalfGemmBlockAvx512Fp16<RowCount, 1>(LastMask, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+    }
+}
+
+MLAS_FORCEINLINE
+void
+CvtFloat2Half(
+    _mlas_fp16_* dest,
+    const float* src,
+    size_t len
+    )
+{
+    while (len >= 16) {
+        const __m256i Halves = _mm512_cvtps_ph(_mm512_loadu_ps(src), _MM_FROUND_TO_NEAREST_INT);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest), Halves);
+        src += 16;
+        dest += 16;
+        len -= 16;
+    }
+
+    if (len > 0) {
+        const __mmask16 Mask = __mmask16((1u << len) - 1);
+        const __m256i Halves = _mm512_cvtps_ph(_mm512_maskz_loadu_ps(Mask, src), _MM_FROUND_TO_NEAREST_INT);
+        _mm256_mask_storeu_epi16(dest, Mask, Halves);
+    }
+}
+
+/**
+ * @brief Convert a 2D matrix from float to fp16
+*/
+MLAS_FORCEINLINE
+void
+CvtFloat2Half2D(
+    _mlas_fp16_* dest,
+    const float* src,
+    size_t stride,
+    size_t CntRow,
+    size_t CntCol
+    )
+{
+    if (stride == CntCol) {
+        CvtFloat2Half(dest, src, CntRow * CntCol);
+        return;
+    }
+    while (CntRow > 0) {
+        CvtFloat2Half(dest, src, CntCol);
+        src += stride;
+        dest += CntCol;
+        CntRow--;
+    }
+}
+
+}  // namespace
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackA<MLAS_HALF_GEMM_KERNEL_AVX512FP16>(
+    _mlas_fp16_* D,
+    const float* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+)
+{
+    CvtFloat2Half2D(D, A, lda, CountM, CountK);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX512FP16>(
+    _mlas_fp16_* D,
+    const float* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+)
+{
+    CvtFloat2Half2D(D, B, ldb, CountK, CountN);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernel<MLAS_HALF_GEMM_KERNEL_AVX512FP16>(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    const bool ZeroMode)
+{
+    switch (std::min(CountM, MLAS_HALF_GEMM_KERNEL_AVX512FP16::KernelMaxM)) {
+        case 1:
+            HalfGemmRowsAvx512Fp16<1>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 2:
+            HalfGemmRowsAvx512Fp16<2>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 3:
+            HalfGemmRowsAvx512Fp16<3>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 4:
+            HalfGemmRowsAvx512Fp16<4>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 5:
+            HalfGemmRowsAvx512Fp16<5>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        default:
+            HalfGemmRowsAvx512Fp16<6>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+    }
+}
+
+
+const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx512Fp16 = {
+    MlasHalfGemmOperation<MLAS_HALF_GEMM_KERNEL_AVX512FP16>,
+    nullptr,
+    MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX512FP16>,
+    MLAS_HALF_GEMM_KERNEL_AVX512FP16::PackedK,
+    MLAS_HALF_GEMM_KERNEL_AVX512FP16::KernelMaxM,
+    0
+};
@@ -0,0 +1,155 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_avx2.cpp
+
+Abstract:
+
+    This module implements the layer normalization kernel with AVX2 and FMA3
+    instructions. See layernorm.cpp for the algorithm.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasLayerNormF32KernelAvx2(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+{
+    const bool HasAddend = (Skip != nullptr || Bias != nullptr);
+
+    auto LoadInput = [&](size_t n) -> float {
+        float Value = Input[n];
+        if (Skip != nullptr) {
+            Value += Skip[n];
+        }
+        if (Bias != nullptr) {
+            Value += Bias[n];
+        }
+        return Value;
+    };
+
+    auto LoadInputVector = [&](size_t n) -> __m256 {
+        __m256 Vector = _mm256_loadu_ps(Input + n);
+        if (Skip != nullptr) {
+            Vector = _mm256_add_ps(Vector, _mm256_loadu_ps(Skip + n));
+        }
+        if (Bias != nullptr) {
+            Vector = _mm256_add_ps(Vector, _mm256_loadu_ps(Bias + n));
+        }
+        if (HasAddend) {
+            _mm256_storeu_ps(Output + n, Vector);
+            if (SkipOutput != nullptr) {
+                _mm256_storeu_ps(SkipOutput + n, Vector);
+            }
+        }
+        return Vector;
+    };
+
+    const float Origin = Simplified ? 0.0f : LoadInput(0);
+    const __m256 OriginVector = _mm256_set1_ps(Origin);
+
+    __m256 Sum0 = _mm256_setzero_ps();
+    __m256 Sum1 = _mm256_setzero_ps();
+    __m256 SumSquares0 = _mm256_setzero_ps();
+    __m256 SumSquares1 = _mm256_setzero_ps();
+
+    size_t n = 0;
+
+    for (; n + 16 <= N; n += 16) {
+        const __m256 Delta0 = _mm256_sub_ps(LoadInputVector(n), OriginVector);
+        const __m256 Delta1 = _mm256_sub_ps(LoadInputVector(n + 8), OriginVector);
+        Sum0 = _mm256_add_ps(Sum0, Delta0);
+        Sum1 = _mm256_add_ps(Sum1, Delta1);
+        SumSquares0 = _mm256_fmadd_ps(Delta0, Delta0, SumSquares0);
+        SumSquares1 = _mm256_fmadd_ps(Delta1, Delta1, SumSquares1);
+    }
+
+    if (n + 8 <= N) {
+        const __m256 Delta0 = _mm256_sub_ps(LoadInputVector(n), OriginVector);
+        Sum0 = _mm256_add_ps(Sum0, Delta0);
+        SumSquares0 = _mm256_fmadd_ps(Delta0, Delta0, SumSquares0);
+        n += 8;
+    }
+
+    auto ReduceAdd = [](__m256 Vector) -> float {
+        __m128 Sum = _mm_add_ps(_mm256_castps256_ps128(Vector), _mm256_extractf128_ps(Vector, 1));
+        Sum = _mm_add_ps(Sum, _mm_movehl_ps(Sum, Sum));
+        Sum = _mm_add_ss(Sum, _mm_movehdup_ps(Sum));
+        return _mm_cvtss_f32(Sum);
+    };
+
+    float Sum = ReduceAdd(_mm256_add_ps(Sum0, Sum1));
+    float SumSquares = ReduceAdd(_mm256_add_ps(SumSquares0, SumSquares1));
+
+    for (; n < N; n++) {
+        const float Value = LoadInput(n);
+        if (HasAddend) {
+            Output[n] = Value;
+            if (SkipOutput != nullptr) {
+                SkipOutput[n] = Value;
+            }
+        }
+        const float Delta = Value - Origin;
+        Sum += Delta;
+        SumSquares += Delta * Delta;
+    }
+
+    const float* X = HasAddend ? Output : Input;
+
+    float RowMean;
+    float RowInvStdDev;
+    MlasLayerNormComputeStatistics(Sum, SumSquares, Origin, N, Epsilon, Simplified, &RowMean, &RowInvStdDev);
+
+    if (Simplified) {
+        Shift = nullptr;
+    }
+
+    const __m256 MeanVector = _mm256_set1_ps(RowMean);
+    const __m256 InvStdDevVector = _mm256_set1_ps(RowInvStdDev);
+
+    n = 0;
+
+    for (; n + 8 <= N; n += 8) {
+        const __m256 Vector = _mm256_sub_ps(_mm256_loadu_ps(X + n), MeanVector);
+        const __m256 Multiplier = _mm256_mul_ps(_mm256_loadu_ps(Scale + n), InvStdDevVector);
+        if (Shift != nullptr) {
+            _mm256_storeu_ps(Output + n, _mm256_fmadd_ps(Vector, Multiplier, _mm256_loadu_ps(Shift + n)));
+        } else {
+            _mm256_storeu_ps(Output + n, _mm256_mul_ps(Vector, Multiplier));
+        }
+    }
+
+    for (; n < N; n++) {
+        float Value = (X[n] - RowMean) * RowInvStdDev * Scale[n];
+        if (Shift != nullptr) {
+            Value += Shift[n];
+        }
+        Output[n] = Value;
+    }
+
+    if (Mean != nullptr) {
+        *Mean = RowMean;
+    }
+    if (InvStdDev != nullptr) {
+        *InvStdDev = RowInvStdDev;
+    }
+}
@@ -0,0 +1,124 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    embedding_avx512f.cpp
+
+Abstract:
+
+    This module implements the embedding bag kernel with AVX512F
+    instructions. See embedding.cpp for the algorithm.
+
+    Rows narrower than a vector are summed with gathers of one column of
+    eight rows at a time instead of a masked load per row.
+
+--*/
+
+#include "mlasi.h"
+
+constexpr size_t MLAS_EMBEDDING_BAG_PREFETCH_DISTANCE = 8;
+
+void
+MLASCALL
+MlasEmbeddingBagF32KernelAvx512F(
+    const float* const* Rows,
+    size_t RowCount,
+    size_t Dim,
+    float* Output,
+    bool Accumulate
+    )
+{
+    if (Dim < 4) {
+
+        for (size_t d = 0; d < Dim; d++) {
+
+            __m256 Accumulator = _mm256_setzero_ps();
+            size_t r = 0;
+
+            //
+            // The row addresses plus the column offset are the gather indices
+            // of a null base address.
+            //
+
+            const __m512i ColumnOffset = _mm512_set1_epi64(int64_t(d * sizeof(float)));
+
+            for (; r + 8 <= RowCount; r += 8) {
+                const __m512i Addresses = _mm512_add_epi64(_mm512_loadu_si512(Rows + r), ColumnOffset);
+                Accumulator = _mm256_add_ps(Accumulator, _mm512_i64gather_ps(Addresses, nullptr, 1));
+            }
+
+            float Sum = Accumulate ? Output[d] : 0.0f;
+
+            for (; r < RowCount; r++) {
+                Sum += Rows[r][d];
+            }
+
+            __m128 Reduced = _mm_add_ps(_mm256_castps256_ps128(Accumulator), _mm256_extractf128_ps(Accumulator, 1));
+            Reduced = _mm_add_ps(Reduced, _mm_movehl_ps(Reduced, Reduced));
+            Reduced = _mm_add_ss(Reduced, _mm_shuffle_ps(Reduced, Reduced, 1));
+
+            Output[d] = Sum + _mm_cvtss_f32(Reduced);
+        }
+
+        return;
+    }
+
+    size_t d = 0;
+
+    for (; d + 64 <= Dim; d += 64) {
+
+        __m512 Accumulator0 = _mm512_setzero_ps();
+        __m512 Accumulator1 = _mm512_setzero_ps();
+        __m512 Accumulator2 = _mm512_setzero_ps();
+        __m512 Accumulator3 = _mm512_setzero_ps();
+
+        if (Accumulate) {
+            Accumulator0 = _mm512_loadu_ps(Output + d);
+            Accumulator1 = _mm512_loadu_ps(Output + d + 16);
+            Accumulator2 = _mm512_loadu_ps(Output + d + 32);
+            Accumulator3 = _mm512_loadu_ps(Output + d + 48);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            if (r + MLAS_EMBEDDING_BAG_PREFETCH_DISTANCE < RowCount) {
+                const char* Prefetch = reinterpret_cast<const char*>(Rows[r + MLAS_EMBEDDING_BAG_PREFETCH_DISTANCE] + d);
+                _mm_prefetch(Prefetch, _MM_HINT_T0);
+                _mm_prefetch(Prefetch + 64, _MM_HINT_T0);
+                _mm_prefetch(Prefetch + 128, _MM_HINT_T0);
+                _mm_prefetch(Prefetch + 192, _MM_HINT_T0);
+            }
+            const float* Row = Rows[r] + d;
+            Accumulator0 = _mm512_add_ps(Accumulator0, _mm512_loadu_ps(Row));
+            Accumulator1 = _mm512_add_ps(Accumulator1, _mm512_loadu_ps(Row + 16));
+            Accumulator2 = _mm512_add_ps(Accumulator2, _mm512_loadu_ps(Row + 32));
+            Accumulator3 = _mm512_add_ps(Accumulator3, _mm512_loadu_ps(Row + 48));
+        }
+
+        _mm512_storeu_ps(Output + d, Accumulator0);
+        _mm512_storeu_ps(Output + d + 16, Accumulator1);
+        _mm512_storeu_ps(Output + d + 32, Accumulator2);
+        _mm512_storeu_ps(Output + d + 48, Accumulator3);
+    }
+
+    for (; d < Dim; d += 16) {
+
+        const size_t Count = std::min<size_t>(Dim - d, 16);
+        const __mmask16 Mask = __mmask16((1u << Count) - 1);
+
+        __m512 Accumulator = Accumulate ? _mm512_maskz_loadu_ps(Mask, Output + d) : _mm512_setzero_ps();
+
+        for (size_t r = 0; r < RowCount; r++) {
+            if (r + MLAS_EMBEDDING_BAG_PREFETCH_DISTANCE < RowCount) {
+                _mm_prefetch(reinterpret_cast<const char*>(Rows[r + MLAS_EMBEDDING_BAG_PREFETCH_DISTANCE] + d),
+                             _MM_HINT_T0);
+            }
+            Accumulator = _mm512_add_ps(Accumulator, _mm512_maskz_loadu_ps(Mask, Rows[r] + d));
+        }
+
+        _mm512_mask_storeu_ps(Output + d, Mask, Accumulator);
+    }
+}
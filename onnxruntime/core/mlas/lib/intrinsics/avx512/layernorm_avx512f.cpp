@@ -0,0 +1,123 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_avx512f.cpp
+
+Abstract:
+
+    This module implements the layer normalization kernel with AVX512F
+    instructions. See layernorm.cpp for the algorithm.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasLayerNormF32KernelAvx512F(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+{
+    const bool HasAddend = (Skip != nullptr || Bias != nullptr);
+
+    auto TailMask = [](size_t Count) -> __mmask16 {
+        return __mmask16((1u << Count) - 1);
+    };
+
+    auto LoadInputVector = [&](size_t n, __mmask16 Mask) -> __m512 {
+        __m512 Vector = _mm512_maskz_loadu_ps(Mask, Input + n);
+        if (Skip != nullptr) {
+            Vector = _mm512_add_ps(Vector, _mm512_maskz_loadu_ps(Mask, Skip + n));
+        }
+        if (Bias != nullptr) {
+            Vector = _mm512_add_ps(Vector, _mm512_maskz_loadu_ps(Mask, Bias + n));
+        }
+        if (HasAddend) {
+            _mm512_mask_storeu_ps(Output + n, Mask, Vector);
+            if (SkipOutput != nullptr) {
+                _mm512_mask_storeu_ps(SkipOutput + n, Mask, Vector);
+            }
+        }
+        return Vector;
+    };
+
+    float Origin = 0.0f;
+    if (!Simplified) {
+        Origin = Input[0] + ((Skip != nullptr) ? Skip[0] : 0.0f) + ((Bias != nullptr) ? Bias[0] : 0.0f);
+    }
+    const __m512 OriginVector = _mm512_set1_ps(Origin);
+
+    __m512 Sum0 = _mm512_setzero_ps();
+    __m512 Sum1 = _mm512_setzero_ps();
+    __m512 SumSquares0 = _mm512_setzero_ps();
+    __m512 SumSquares1 = _mm512_setzero_ps();
+
+    size_t n = 0;
+
+    for (; n + 32 <= N; n += 32) {
+        const __m512 Delta0 = _mm512_sub_ps(LoadInputVector(n, 0xFFFF), OriginVector);
+        const __m512 Delta1 = _mm512_sub_ps(LoadInputVector(n + 16, 0xFFFF), OriginVector);
+        Sum0 = _mm512_add_ps(Sum0, Delta0);
+        Sum1 = _mm512_add_ps(Sum1, Delta1);
+        SumSquares0 = _mm512_fmadd_ps(Delta0, Delta0, SumSquares0);
+        SumSquares1 = _mm512_fmadd_ps(Delta1, Delta1, SumSquares1);
+    }
+
+    for (; n < N; n += 16) {
+        const __mmask16 Mask = TailMask(std::min<size_t>(N - n, 16));
+        const __m512 Delta0 = _mm512_maskz_sub_ps(Mask, LoadInputVector(n, Mask), OriginVector);
+        Sum0 = _mm512_add_ps(Sum0, Delta0);
+        SumSquares0 = _mm512_fmadd_ps(Delta0, Delta0, SumSquares0);
+    }
+
+    const float Sum = _mm512_reduce_add_ps(_mm512_add_ps(Sum0, Sum1));
+    const float SumSquares = _mm512_reduce_add_ps(_mm512_add_ps(SumSquares0, SumSquares1));
+
+    const float* X = HasAddend ? Output : Input;
+
+    float RowMean;
+    float RowInvStdDev;
+    MlasLayerNormComputeStatistics(Sum, SumSquares, Origin, N, Epsilon, Simplified, &RowMean, &RowInvStdDev);
+
+    if (Simplified) {
+        Shift = nullptr;
+    }
+
+    const __m512 MeanVector = _mm512_set1_ps(RowMean);
+    const __m512 InvStdDevVector = _mm512_set1_ps(RowInvStdDev);
+
+    for (n = 0; n < N; n += 16) {
+        const __mmask16 Mask = TailMask(std::min<size_t>(N - n, 16));
+        const __m512 Vector = _mm512_sub_ps(_mm512_maskz_loadu_ps(Mask, X + n), MeanVector);
+        const __m512 Multiplier = _mm512_mul_ps(_mm512_maskz_loadu_ps(Mask, Scale + n), InvStdDevVector);
+        if (Shift != nullptr) {
+            _mm512_mask_storeu_ps(Output + n, Mask,
+                                  _mm512_fmadd_ps(Vector, Multiplier, _mm512_maskz_loadu_ps(Mask, Shift + n)));
+        } else {
+            _mm512_mask_storeu_ps(Output + n, Mask, _mm512_mul_ps(Vector, Multiplier));
+        }
+    }
+
+    if (Mean != nullptr) {
+        *Mean = RowMean;
+    }
+    if (InvStdDev != nullptr) {
+        *InvStdDev = RowInvStdDev;
+    }
+}
@@ -51,8 +51,24 @@ using tLauncher_Int8_S4_F32F32 = jblas::wrapper::gemm::LauncherKBlock<
     jblas::epilogue::gemm::CompInt8BlockEpilogue,
     jblas::epilogue::gemm::AccumulatorWriteBackFp32>;
 
+/*
+Name conversion explaination:
+Bf16:   comp type, determined by GemmCore, can be any jblas::gemm::HCorexxx(bf16 GemmCore)
+F32F32: input/output dtype, A is converted from fp32 by jblas::prologue_a::gemm::ActivationConverterFp32 and C is
+written by jblas::epilogue::gemm::AccumulatorWriteBackFp32. B is packed to bf16 ahead of time by
+jblas::prologue_b::gemm::WeightPack.
+*/
+template <class GemmCore_T>
+using tLauncher_Bf16_F32F32 = jblas::wrapper::gemm::LauncherBase<
+    GemmCore_T::ISA,
+    GemmCore_T,
+    jblas::prologue_a::gemm::ActivationConverterFp32,
+    jblas::prologue_b::gemm::WeightPack,
+    jblas::epilogue::gemm::AccumulatorWriteBackFp32>;
+
 using tAVX512F = jblas::gemm::SCoreRowNAvx512f<48, 8>;
 using tAMX_BF16 = jblas::gemm::HCoreRowNAmxbf16<64, 16>;
+using tAVX512_BF16 = jblas::gemm::HCoreRowNAvx512bf16<48, 8>;
 using tAVX512_FP16 = jblas::gemm::HCoreRowNAvx512fp16<96, 8>;
 using tAVX_VNNI = jblas::gemm::ICoreRowNAvxvnni<48, 2>;  // TODO(Yu) use 24x4 for higher efficiency
 using tAVX512_VNNI = jblas::gemm::ICoreRowNAvx512vnni<48, 8>;
@@ -10,7 +10,7 @@ Module Name:
 
 Abstract:
 
-    Currently only support Q4 gemm.
+    Currently only support Q4 gemm and fp32 gemm with bf16 compute.
 --*/
 
 #include "jblas_gemm.h"
@@ -532,3 +532,140 @@ JblasQ4GemmUnPackB(float* FpData, const void* PackedBuf, size_t N, size_t K, siz
     }
     return false;
 }
+
+static bool
+JblasAmxBf16Available()
+{
+    GetCPUDevice();
+    // the tile data state must be enabled for the process before AMX instructions can be used
+    static const bool available = _cd->AMX_BF16() && MlasInitAMX();
+    return available;
+}
+
+template <class GemmCore_T>
+static size_t
+JblasSBGemmPackBSizeImpl(size_t N, size_t K)
+{
+    static tLauncher_Bf16_F32F32<GemmCore_T> kernel;
+    auto stor = kernel.mProB.createStorage(static_cast<int>(N), static_cast<int>(K));
+    return stor.mSize;
+}
+
+size_t
+JblasSBGemmPackBSize(size_t N, size_t K)
+{
+    GetCPUDevice();
+    if (JblasAmxBf16Available()) {
+        return JblasSBGemmPackBSizeImpl<tAMX_BF16>(N, K);
+    }
+    if (_cd->AVX512_BF16()) {
+        return JblasSBGemmPackBSizeImpl<tAVX512_BF16>(N, K);
+    }
+    return 0;
+}
+
+template <class GemmCore_T>
+static void
+JblasSBGemmPackBImpl(
+    void* PackedBuf, const float* B, size_t N, size_t K, size_t ldb, bool TransB, MLAS_THREADPOOL* ThreadPool
+)
+{
+    static tLauncher_Bf16_F32F32<GemmCore_T> kernel;
+    auto N_ = static_cast<int>(N);
+    auto K_ = static_cast<int>(K);
+    auto stor = kernel.mProB.createStorage(N_, K_);
+    stor.assign(reinterpret_cast<int8_t*>(PackedBuf));
+
+    // convert B to a dense bf16 matrix, then interleave it in the layout of the GemmCore
+    const int Rows = TransB ? N_ : K_;
+    const int Cols = TransB ? K_ : N_;
+    auto Bf16B = utils::amalloc<utils::bf16>(N * K);
+    kernel::wrapper::Memcpy2DFp32CvtBf16::forward<GemmCore_T::ISA>(
+        B, Bf16B, Rows, Cols, static_cast<int>(ldb * sizeof(float)), Cols * static_cast<int>(sizeof(utils::bf16)),
+        false
+    );
+    ORTThreading orth(ThreadPool);
+    if (TransB) {
+        kernel.mProB.packWeightTranspose(N_, K_, {Bf16B, K_, &stor}, &orth);
+    } else {
+        kernel.mProB.packWeight(N_, K_, {Bf16B, N_, &stor}, &orth);
+    }
+    utils::afree(Bf16B);
+}
+
+bool
+JblasSBGemmPackB(
+    void* PackedBuf, const float* B, size_t N, size_t K, size_t ldb, bool TransB, MLAS_THREADPOOL* ThreadPool
+)
+{
+    GetCPUDevice();
+    if (JblasAmxBf16Available()) {
+        JblasSBGemmPackBImpl<tAMX_BF16>(PackedBuf, B, N, K, ldb, TransB, ThreadPool);
+        return true;
+    }
+    if (_cd->AVX512_BF16()) {
+        JblasSBGemmPackBImpl<tAVX512_BF16>(PackedBuf, B, N, K, ldb, TransB, ThreadPool);
+        return true;
+    }
+    return false;
+}
+
+template <class GemmCore_T>
+static void
+JblasSBGemmCompBf16(
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const float* A,
+    const size_t lda,
+    jblas::storage::gemm::StoragePackedWeight* B,
+    float* C,
+    const size_t ldc,
+    jblas::parallel::IThreading* th
+)
+{
+    using Parallel = jblas::parallel::gemm::SchedulerBase<GemmCore_T>;
+    using Launcher = tLauncher_Bf16_F32F32<GemmCore_T>;
+    static Launcher kernel;
+    auto M_ = static_cast<int>(M);
+    auto N_ = static_cast<int>(N);
+    auto K_ = static_cast<int>(K);
+    auto lda_ = static_cast<int>(lda);
+    auto ldc_ = static_cast<int>(ldc);
+    typename Launcher::Param args{M_, N_, K_, {A, lda_}, {nullptr, 0, B}, {C, ldc_}};
+    jblas::parallel::GemmBaseRun<Parallel>(kernel, args, th);
+}
+
+bool
+JblasSBGemmBatchDriver(
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const size_t BatchN,
+    const MLAS_SBGEMM_DATA_PARAMS* DataParams,
+    MLAS_THREADPOOL* ThreadPool
+)
+{
+    GetCPUDevice();
+    ORTThreading orth(ThreadPool);
+    for (size_t i = 0; i < BatchN; i++) {
+        auto ptr = jblas::storage::gemm::PackedWeightParser::deserialBuffer(DataParams[i].B);
+        auto uptr = std::unique_ptr<jblas::storage::gemm::WeightBase>(ptr);
+        if (ptr == nullptr || ptr->mPrologueID != JBLAS_PROLOGUEB_IDS::WeightPack) {
+            return false;
+        }
+        auto wptr = reinterpret_cast<jblas::storage::gemm::StoragePackedWeight*>(ptr);
+        if (ptr->mCoreId == tAMX_BF16::ID && JblasAmxBf16Available()) {
+            JblasSBGemmCompBf16<tAMX_BF16>(
+                M, N, K, DataParams[i].A, DataParams[i].lda, wptr, DataParams[i].C, DataParams[i].ldc, &orth
+            );
+        } else if (ptr->mCoreId == tAVX512_BF16::ID && _cd->AVX512_BF16()) {
+            JblasSBGemmCompBf16<tAVX512_BF16>(
+                M, N, K, DataParams[i].A, DataParams[i].lda, wptr, DataParams[i].C, DataParams[i].ldc, &orth
+            );
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
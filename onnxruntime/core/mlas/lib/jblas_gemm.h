@@ -10,7 +10,7 @@ Module Name:
 
 Abstract:
 
-    Currently only support Q4 gemm.
+    Currently only support Q4 gemm and fp32 gemm with bf16 compute.
 --*/
 
 #pragma once
@@ -59,3 +59,27 @@ JblasSQ4GemmBatchWorkspaceSize(
     const size_t BatchN,
     const MLAS_SQNBITS_GEMM_DATA_PACKED_PARAMS* DataParams
 );
+
+size_t
+JblasSBGemmPackBSize(size_t N, size_t K);
+
+bool
+JblasSBGemmPackB(
+    void* PackedBuf,
+    const float* B,
+    size_t N,
+    size_t K,
+    size_t ldb,
+    bool TransB,
+    MLAS_THREADPOOL* ThreadPool
+);
+
+bool
+JblasSBGemmBatchDriver(
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const size_t BatchN,
+    const MLAS_SBGEMM_DATA_PARAMS* DataParams,
+    MLAS_THREADPOOL* ThreadPool
+);
@@ -0,0 +1,295 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.cpp
+
+Abstract:
+
+    This module implements routines to compute layer normalization, optionally
+    fused with the residual add of skip layer normalization, and the simplified
+    (RMS) variant of layer normalization.
+
+    The row is read once from memory: the first pass forms Input + Skip + Bias
+    and accumulates the sums needed for the mean and variance, the second pass
+    normalizes the row while it is still in the cache. The variance is
+    accumulated relative to the first element of the row, which avoids the
+    cancellation of the textbook sum of squares formula when the mean is large
+    compared to the standard deviation.
+
+--*/
+
+#include "mlasi.h"
+
+#include <cmath>
+
+void
+MLASCALL
+MlasLayerNormF32Kernel(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for layer normalization.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Skip - Optionally supplies the skip row added to the input.
+
+    Bias - Optionally supplies the bias row added to the input.
+
+    Scale - Supplies the scale (gamma) row.
+
+    Shift - Optionally supplies the shift (beta) row. Ignored if Simplified.
+
+    Output - Supplies the output row.
+
+    SkipOutput - Optionally receives Input + Skip + Bias.
+
+    N - Supplies the number of elements of the row.
+
+    Epsilon - Supplies the value added to the variance.
+
+    Simplified - Supplies true to compute the root mean square normalization.
+
+    Mean - Optionally receives the mean of the row.
+
+    InvStdDev - Optionally receives the inverse standard deviation of the row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const bool HasAddend = (Skip != nullptr || Bias != nullptr);
+
+    auto LoadInput = [&](size_t n) -> float {
+        float Value = Input[n];
+        if (Skip != nullptr) {
+            Value += Skip[n];
+        }
+        if (Bias != nullptr) {
+            Value += Bias[n];
+        }
+        return Value;
+    };
+
+    const float Origin = Simplified ? 0.0f : LoadInput(0);
+    MLAS_FLOAT32X4 OriginVector = MlasBroadcastFloat32x4(Origin);
+
+    MLAS_FLOAT32X4 Sum0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 Sum1 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumSquares0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumSquares1 = MlasZeroFloat32x4();
+
+    auto LoadInputVector = [&](size_t n) -> MLAS_FLOAT32X4 {
+        MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Input + n);
+        if (Skip != nullptr) {
+            Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Skip + n));
+        }
+        if (Bias != nullptr) {
+            Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Bias + n));
+        }
+        if (HasAddend) {
+            MlasStoreFloat32x4(Output + n, Vector);
+            if (SkipOutput != nullptr) {
+                MlasStoreFloat32x4(SkipOutput + n, Vector);
+            }
+        }
+        return MlasSubtractFloat32x4(Vector, OriginVector);
+    };
+
+    size_t n = 0;
+
+    for (; n + 8 <= N; n += 8) {
+        MLAS_FLOAT32X4 Delta0 = LoadInputVector(n);
+        MLAS_FLOAT32X4 Delta1 = LoadInputVector(n + 4);
+        Sum0 = MlasAddFloat32x4(Sum0, Delta0);
+        Sum1 = MlasAddFloat32x4(Sum1, Delta1);
+        SumSquares0 = MlasMultiplyAddFloat32x4(Delta0, Delta0, SumSquares0);
+        SumSquares1 = MlasMultiplyAddFloat32x4(Delta1, Delta1, SumSquares1);
+    }
+
+    for (; n + 4 <= N; n += 4) {
+        MLAS_FLOAT32X4 Delta0 = LoadInputVector(n);
+        Sum0 = MlasAddFloat32x4(Sum0, Delta0);
+        SumSquares0 = MlasMultiplyAddFloat32x4(Delta0, Delta0, SumSquares0);
+    }
+
+    float Sum = MlasReduceAddFloat32x4(MlasAddFloat32x4(Sum0, Sum1));
+    float SumSquares = MlasReduceAddFloat32x4(MlasAddFloat32x4(SumSquares0, SumSquares1));
+
+    for (; n < N; n++) {
+        const float Value = LoadInput(n);
+        if (HasAddend) {
+            Output[n] = Value;
+            if (SkipOutput != nullptr) {
+                SkipOutput[n] = Value;
+            }
+        }
+        const float Delta = Value - Origin;
+        Sum += Delta;
+        SumSquares += Delta * Delta;
+    }
+
+    //
+    // Normalize the row. The combined row was stored to the output buffer when
+    // it differs from the input row.
+    //
+
+    const float* X = HasAddend ? Output : Input;
+
+    float RowMean;
+    float RowInvStdDev;
+    MlasLayerNormComputeStatistics(Sum, SumSquares, Origin, N, Epsilon, Simplified, &RowMean, &RowInvStdDev);
+
+    if (Simplified) {
+        Shift = nullptr;
+    }
+
+    MLAS_FLOAT32X4 MeanVector = MlasBroadcastFloat32x4(RowMean);
+    MLAS_FLOAT32X4 InvStdDevVector = MlasBroadcastFloat32x4(RowInvStdDev);
+
+    n = 0;
+
+    for (; n + 4 <= N; n += 4) {
+        MLAS_FLOAT32X4 Vector = MlasSubtractFloat32x4(MlasLoadFloat32x4(X + n), MeanVector);
+        MLAS_FLOAT32X4 Multiplier = MlasMultiplyFloat32x4(MlasLoadFloat32x4(Scale + n), InvStdDevVector);
+        if (Shift != nullptr) {
+            Vector = MlasMultiplyAddFloat32x4(Vector, Multiplier, MlasLoadFloat32x4(Shift + n));
+        } else {
+            Vector = MlasMultiplyFloat32x4(Vector, Multiplier);
+        }
+        MlasStoreFloat32x4(Output + n, Vector);
+    }
+
+    for (; n < N; n++) {
+        float Value = (X[n] - RowMean) * RowInvStdDev * Scale[n];
+        if (Shift != nullptr) {
+            Value += Shift[n];
+        }
+        Output[n] = Value;
+    }
+
+    if (Mean != nullptr) {
+        *Mean = RowMean;
+    }
+    if (InvStdDev != nullptr) {
+        *InvStdDev = RowInvStdDev;
+    }
+}
+
+void
+MLASCALL
+MlasLayerNormalization(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+{
+    if (N == 0) {
+        return;
+    }
+
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_LAYER_NORM_FLOAT_KERNEL* LayerNormF32Kernel = GetMlasPlatform().LayerNormF32Kernel;
+#else
+    MLAS_LAYER_NORM_FLOAT_KERNEL* LayerNormF32Kernel = MlasLayerNormF32Kernel;
+#endif
+
+    LayerNormF32Kernel(Input, Skip, Bias, Scale, Shift, Output, SkipOutput, N, Epsilon, Simplified, Mean, InvStdDev);
+}
+
+void
+MLASCALL
+MlasLayerNormalization(
+    const MLAS_FP16* Input,
+    const MLAS_FP16* Skip,
+    const MLAS_FP16* Bias,
+    const MLAS_FP16* Scale,
+    const MLAS_FP16* Shift,
+    MLAS_FP16* Output,
+    MLAS_FP16* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+{
+    if (N == 0) {
+        return;
+    }
+
+    //
+    // Widen the operands to single precision in a per thread buffer and
+    // normalize in single precision. The output row overwrites the widened
+    // input row.
+    //
+
+    const size_t BufferCount = 2 + (Skip != nullptr) + (Bias != nullptr) + (Shift != nullptr) +
+                               (SkipOutput != nullptr);
+    const size_t AlignedN = UpAlignSize(N * sizeof(float)) / sizeof(float);
+    MlasThreadedBufAlloc(BufferCount * AlignedN * sizeof(float));
+
+    float* Buffer = reinterpret_cast<float*>(ThreadedBufHolder.get());
+
+    auto Widen = [&](const MLAS_FP16* Source) -> float* {
+        if (Source == nullptr) {
+            return nullptr;
+        }
+        float* Destination = Buffer;
+        Buffer += AlignedN;
+        MlasConvertHalfToFloatBuffer(reinterpret_cast<const unsigned short*>(Source), Destination, N);
+        return Destination;
+    };
+
+    float* InputFloat = Widen(Input);
+    float* SkipFloat = Widen(Skip);
+    float* BiasFloat = Widen(Bias);
+    float* ScaleFloat = Widen(Scale);
+    float* ShiftFloat = Widen(Shift);
+    float* SkipOutputFloat = (SkipOutput != nullptr) ? Buffer : nullptr;
+
+    MlasLayerNormalization(InputFloat, SkipFloat, BiasFloat, ScaleFloat, ShiftFloat, InputFloat,
+                           SkipOutputFloat, N, Epsilon, Simplified, Mean, InvStdDev);
+
+    for (size_t n = 0; n < N; n++) {
+        Output[n] = MLAS_FP16(InputFloat[n]);
+    }
+
+    if (SkipOutput != nullptr) {
+        for (size_t n = 0; n < N; n++) {
+            SkipOutput[n] = MLAS_FP16(SkipOutputFloat[n]);
+        }
+    }
+}
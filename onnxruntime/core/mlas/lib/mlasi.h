@@ -191,6 +191,8 @@ class MLASCPUIDInfo
 
     bool HasArmNeon_I8MM() const { return has_arm_neon_i8mm_; }
 
+    bool HasArmSVE() const { return has_arm_sve_; }
+
     bool HasArmSVE_I8MM() const { return has_arm_sve_i8mm_; }
 
    private:
@@ -199,6 +201,7 @@ class MLASCPUIDInfo
     bool has_arm_neon_dot_{false};
     bool has_fp16_{false};
     bool has_arm_neon_i8mm_{false};
+    bool has_arm_sve_{false};
     bool has_arm_sve_i8mm_{false};
 };
 using MLAS_CPUIDINFO = MLASCPUIDInfo;
@@ -593,6 +596,33 @@ void
     size_t N
     );
 
+typedef
+void
+(MLASCALL MLAS_LAYER_NORM_FLOAT_KERNEL)(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    );
+
+typedef
+void
+(MLASCALL MLAS_EMBEDDING_BAG_FLOAT_KERNEL)(
+    const float* const* Rows,
+    size_t RowCount,
+    size_t Dim,
+    float* Output,
+    bool Accumulate
+    );
+
 typedef
 void
 (MLASCALL MLAS_QLINEAR_BINARY_OP_S8_KERNEL)(
@@ -820,6 +850,15 @@ extern "C" {
     MLAS_QUANTIZE_LINEAR_S8_KERNEL MlasQuantizeLinearS8KernelAvx512F;
     MLAS_QUANTIZE_LINEAR_U8_KERNEL MlasQuantizeLinearU8KernelAvx512F;
 #endif
+#if defined(MLAS_TARGET_ARM64) && defined(MLAS_USE_SVE)
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasComputeExpF32KernelSve;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasComputeLogisticF32KernelSve;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasComputeTanhF32KernelSve;
+    MLAS_COMPUTE_SUMEXP_FLOAT_KERNEL MlasComputeSumExpF32KernelSve;
+    MLAS_COMPUTE_SOFTMAX_OUTPUT_FLOAT_KERNEL MlasComputeSoftmaxOutputF32KernelSve;
+    MLAS_COMPUTE_LOGSOFTMAX_OUTPUT_FLOAT_KERNEL MlasComputeLogSoftmaxOutputF32KernelSve;
+    MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL MlasReduceMaximumF32KernelSve;
+#endif
 
     MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL MlasReduceMaximumF32Kernel;
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL MlasReduceMinimumMaximumF32Kernel;
@@ -828,6 +867,17 @@ extern "C" {
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL MlasReduceMinimumMaximumF32KernelAvx;
 #endif
 
+    MLAS_LAYER_NORM_FLOAT_KERNEL MlasLayerNormF32Kernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_LAYER_NORM_FLOAT_KERNEL MlasLayerNormF32KernelAvx2;
+    MLAS_LAYER_NORM_FLOAT_KERNEL MlasLayerNormF32KernelAvx512F;
+#endif
+
+    MLAS_EMBEDDING_BAG_FLOAT_KERNEL MlasEmbeddingBagF32Kernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_EMBEDDING_BAG_FLOAT_KERNEL MlasEmbeddingBagF32KernelAvx512F;
+#endif
+
 }
 
 //
@@ -856,6 +906,54 @@ extern "C" {
 #define MLAS_DGEMM_THREAD_COMPLEXITY                (size_t(64) * size_t(1024))
 #define MLAS_QGEMM_THREAD_COMPLEXITY                65536
 
+//
+// Supplies the output processor of a single precision matrix/matrix multiply
+// operation and the position of the output of the operation within the
+// matrix passed to the processor.
+//
+
+struct MLAS_SGEMM_POSTPROCESS {
+    const MLAS_GEMM_POSTPROCESSOR<float>* OutputProcessor;
+    float* C;
+    size_t StartM;
+    size_t StartN;
+};
+
+//
+// Define the parameters and routines of the single precision matrix/matrix
+// multiply kernels generated at run time by MlasSgemmJitKernelGet. A routine
+// computes all N columns of a tile of rows of matrix C from a matrix B packed
+// by MlasGemmPackB. The leading dimensions are in elements.
+//
+
+struct MLAS_SGEMM_JIT_PARAMS {
+    const float* A;
+    const float* B;
+    float* C;
+    size_t lda;
+    size_t ldc;
+    const float* Bias;
+    float alpha;
+    float beta;
+};
+
+typedef
+void
+(MLAS_SGEMM_JIT_ROUTINE)(
+    const MLAS_SGEMM_JIT_PARAMS* Params
+    );
+
+constexpr size_t MLAS_SGEMM_JIT_ROWS = 6;
+
+struct MLAS_SGEMM_JIT_KERNEL {
+    size_t N;
+    size_t K;
+    bool HasBias;
+    MLAS_SGEMM_JIT_ROUTINE* Routines[MLAS_SGEMM_JIT_ROWS];
+
+    virtual ~MLAS_SGEMM_JIT_KERNEL() = default;
+};
+
 //
 // Single-threaded single precision matrix/matrix multiply operation.
 //
@@ -874,7 +972,8 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_POSTPROCESS* PostProcess
     );
 
 //
@@ -916,6 +1015,7 @@ extern const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvx2;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvxVnni;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvx512Core;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvx512Vnni;
+extern const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAmx;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymU8DispatchNeon;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymS8DispatchNeon;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymU8DispatchDot;
@@ -945,6 +1045,20 @@ struct MLAS_SQNBIT_GEMM_DISPATCH;
 
 extern const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchNeon;
 
+extern const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvx2;
+
+extern const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvx512;
+
+//
+// Half precision matrix/matrix multiply dispatch structure.
+//
+
+struct MLAS_HALFGEMM_DISPATCH;
+
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx2;
+
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx512Fp16;
+
 //
 // Quantized depthwise convolution kernels.
 //
@@ -1076,6 +1190,8 @@ struct MLAS_PLATFORM {
     MLAS_COMPUTE_LOGSOFTMAX_OUTPUT_FLOAT_KERNEL* ComputeLogSoftmaxOutputF32Kernel;
     MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL* ReduceMaximumF32Kernel;
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL* ReduceMinimumMaximumF32Kernel;
+    MLAS_LAYER_NORM_FLOAT_KERNEL* LayerNormF32Kernel;
+    MLAS_EMBEDDING_BAG_FLOAT_KERNEL* EmbeddingBagF32Kernel;
     MLAS_QUANTIZE_LINEAR_S8_KERNEL* QuantizeLinearS8Kernel;
     MLAS_QUANTIZE_LINEAR_U8_KERNEL* QuantizeLinearU8Kernel;
     MLAS_QUANTIZE_LINEAR_S16_KERNEL* QuantizeLinearS16Kernel;
@@ -1084,6 +1200,13 @@ struct MLAS_PLATFORM {
     uint32_t PreferredBufferAlignment;
     int32_t MaximumThreadCount;
 #elif defined(MLAS_TARGET_ARM64)
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL* ComputeExpF32Kernel;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL* LogisticKernelRoutine;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL* TanhKernelRoutine;
+    MLAS_COMPUTE_SUMEXP_FLOAT_KERNEL* ComputeSumExpF32Kernel;
+    MLAS_COMPUTE_SOFTMAX_OUTPUT_FLOAT_KERNEL* ComputeSoftmaxOutputF32Kernel;
+    MLAS_COMPUTE_LOGSOFTMAX_OUTPUT_FLOAT_KERNEL* ComputeLogSoftmaxOutputF32Kernel;
+    MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL* ReduceMaximumF32Kernel;
     static constexpr int32_t MaximumThreadCount = MLAS_MAXIMUM_THREAD_COUNT * 4;
 #else
     static constexpr int32_t MaximumThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
@@ -1093,6 +1216,14 @@ struct MLAS_PLATFORM {
     const MLAS_Q8Q4GEMM_DISPATCH* Q8Q4GemmDispatch{nullptr};
 
     const MLAS_SQNBIT_GEMM_DISPATCH* SQNBitGemmDispatch{nullptr};
+
+    // The instruction set extensions the kernels above were selected for, in the
+    // order they were detected, e.g. "sse2 avx avx2".
+    std::string KernelIsa{"scalar"};
+
+#if defined(MLAS_TARGET_AMD64)
+    const MLAS_HALFGEMM_DISPATCH* HalfGemmDispatch{nullptr};
+#endif
 };
 
 inline
@@ -1101,6 +1232,20 @@ MLAS_PLATFORM& GetMlasPlatform(){
     return MlasPlatform;
 }
 
+#if defined(MLAS_TARGET_AMD64_IX86)
+
+//
+// Requests the permission to use the AMX tile data state for the process.
+// Returns true if AMX instructions can be used.
+//
+
+bool
+MlasInitAMX(
+    void
+    );
+
+#endif
+
 //
 // Threading support.
 //
@@ -1172,6 +1317,15 @@ MlasGetMaximumThreadCount(
 #endif
 }
 
+/**
+ * @brief Returns the NUMA node of the processor that runs the calling thread,
+ *        or 0 if it is not known.
+ */
+size_t
+MlasGetCurrentNumaNode(
+    void
+    );
+
 inline
 void
 MlasPartitionWork(
@@ -1194,6 +1348,38 @@ MlasPartitionWork(
     }
 }
 
+/**
+ * @brief Compute the mean and inverse standard deviation of a layer
+ *        normalization row from the sums of the row elements minus Origin.
+ */
+MLAS_FORCEINLINE
+void
+MlasLayerNormComputeStatistics(
+    float Sum,
+    float SumSquares,
+    float Origin,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+{
+    const float Count = float(N);
+
+    if (Simplified) {
+        *Mean = 0.0f;
+        *InvStdDev = 1.0f / std::sqrt(SumSquares / Count + Epsilon);
+        return;
+    }
+
+    const float MeanDelta = Sum / Count;
+    const float Variance = std::max(SumSquares / Count - MeanDelta * MeanDelta, 0.0f);
+
+    *Mean = Origin + MeanDelta;
+    *InvStdDev = 1.0f / std::sqrt(Variance + Epsilon);
+}
+
 //
 // Define the minimum floating point value (and its bit value equivalent) that
 // has no fractional bits. This number can be used for fast rounding of floating
@@ -1243,6 +1429,28 @@ MlasFp32FromBits(
 #pragma warning(pop)
 #endif
 
+//
+// Winograd F(4x4, 3x3) convolution, see convolve_winograd.cpp.
+//
+
+bool
+MlasConvWinogradPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    const float* PackedFilter,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 #if defined(MLAS_TARGET_WASM_SCALAR)
 
 void
@@ -1970,7 +2178,13 @@ MlasMultiplyAddFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2, MLAS_FL
 #elif defined(MLAS_VSX_INTRINSICS)
     return vec_madd(Vector1, Vector2, Vector3);
 #elif defined(MLAS_WASM_SIMD_INTRINSICS)
+#if defined(MLAS_TARGET_WASM_RELAXED_SIMD)
+    // N.B. The relaxed multiply/add is fused or not depending on the host, the
+    // kernels built on it don't depend on either rounding.
+    return wasm_f32x4_relaxed_madd(Vector1, Vector2, Vector3);
+#else
     return wasm_f32x4_add(wasm_f32x4_mul(Vector1, Vector2), Vector3);
+#endif
 #elif defined(MLAS_LSX_INTRINSICS)
     return __lsx_vfmadd_s(Vector1, Vector2, Vector3);
 #else
@@ -52,6 +52,10 @@ MLASCPUIDInfo::MLASCPUIDInfo()
 #define HWCAP_ASIMDDP (1 << 20)
 #endif
 
+#ifndef HWCAP_SVE
+#define HWCAP_SVE (1 << 22)
+#endif
+
 #ifndef HWCAP2_I8MM
 #define HWCAP2_I8MM (1 << 13)
 #endif
@@ -69,6 +73,7 @@ MLASCPUIDInfo::MLASCPUIDInfo()
     has_fp16_ = has_arm_neon_dot_;
 
     has_arm_neon_i8mm_ = ((getauxval(AT_HWCAP2) & HWCAP2_I8MM) != 0);
+    has_arm_sve_ = ((getauxval(AT_HWCAP) & HWCAP_SVE) != 0);
     has_arm_sve_i8mm_ = ((getauxval(AT_HWCAP2) & HWCAP2_SVEI8MM) != 0);
 }
 #endif
@@ -241,6 +246,7 @@ Return Value:
     this->GemmFloatKernel = MlasGemmFloatKernelSse;
     this->GemmU8S8Dispatch = &MlasGemmU8X8DispatchSse;
     this->GemmU8U8Dispatch = &MlasGemmU8X8DispatchSse;
+    this->KernelIsa = "sse2";
 
 #if defined(MLAS_TARGET_AMD64)
 
@@ -262,6 +268,8 @@ Return Value:
     this->ComputeLogSoftmaxOutputF32Kernel = MlasComputeLogSoftmaxOutputF32Kernel;
     this->ReduceMaximumF32Kernel = MlasReduceMaximumF32Kernel;
     this->ReduceMinimumMaximumF32Kernel = MlasReduceMinimumMaximumF32Kernel;
+    this->LayerNormF32Kernel = MlasLayerNormF32Kernel;
+    this->EmbeddingBagF32Kernel = MlasEmbeddingBagF32Kernel;
     this->QLinearAddS8Kernel = MlasQLinearAddS8Kernel;
     this->QLinearAddU8Kernel = MlasQLinearAddU8Kernel;
     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8Kernel;
@@ -291,6 +299,7 @@ Return Value:
 
     if ((Cpuid1[2] & 0x80000) != 0) {
         this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchSse41;
+        this->KernelIsa += " sse4.1";
     }
 
 #endif
@@ -310,6 +319,7 @@ Return Value:
         if ((xcr0 & 0x6) == 0x6) {
 
             this->GemmFloatKernel = MlasGemmFloatKernelAvx;
+            this->KernelIsa += " avx";
 
 #if defined(MLAS_TARGET_AMD64)
 
@@ -343,6 +353,7 @@ Return Value:
 
             if (((Cpuid1[2] & 0x1000) != 0) && ((Cpuid7[1] & 0x20) != 0)) {
 
+                this->KernelIsa += " avx2";
                 this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchAvx2;
                 this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx2;
                 this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx2;
@@ -367,6 +378,18 @@ Return Value:
                 this->ConvDepthwiseS8S8Kernel = MlasConvDepthwiseKernelAvx2<int8_t, int8_t>;
                 this->ConvDepthwiseS8U8Kernel = MlasConvDepthwiseKernelAvx2<int8_t, uint8_t>;
                 this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelFma3;
+                this->LayerNormF32Kernel = MlasLayerNormF32KernelAvx2;
+                this->SQNBitGemmDispatch = &MlasSQNBitGemmDispatchAvx2;
+
+                //
+                // Check if the processor supports F16C for the half precision
+                // GEMM kernel.
+                //
+
+                if ((Cpuid1[2] & 0x20000000) != 0) {
+                    this->HalfGemmDispatch = &MlasHalfGemmDispatchAvx2;
+                    this->KernelIsa += " f16c";
+                }
 
                 //
                 // Check if the processor supports Hybrid core architecture.
@@ -393,6 +416,7 @@ Return Value:
                     this->GemmU8S8Kernel = MlasGemmU8S8KernelAvxVnni;
                     this->GemvU8S8Kernel = MlasGemvU8S8KernelAvxVnni;
                     this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvxVnni;
+                    this->KernelIsa += " avxvnni";
                 }
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -404,6 +428,7 @@ Return Value:
 
                 if (((Cpuid7[1] & 0x10000) != 0) && ((xcr0 & 0xE0) == 0xE0)) {
 
+                    this->KernelIsa += " avx512f";
                     this->GemmFloatKernel = MlasGemmFloatKernelAvx512F;
                     this->GemmDoubleKernel = MlasGemmDoubleKernelAvx512F;
                     this->ConvNchwFloatKernel = MlasConvNchwFloatKernelAvx512F;
@@ -415,8 +440,11 @@ Return Value:
                     this->PoolFloatKernel[MlasAveragePoolingIncludePad] = MlasPoolAverageIncludePadFloatKernelAvx512F;
                     this->ComputeExpF32Kernel = MlasComputeExpF32KernelAvx512F;
                     this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelAvx512F;
+                    this->LayerNormF32Kernel = MlasLayerNormF32KernelAvx512F;
+                    this->EmbeddingBagF32Kernel = MlasEmbeddingBagF32KernelAvx512F;
                     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8KernelAvx512F;
                     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8KernelAvx512F;
+                    this->SQNBitGemmDispatch = &MlasSQNBitGemmDispatchAvx512;
                     this->NchwcBlockSize = 16;
                     this->PreferredBufferAlignment = 64;
 
@@ -427,6 +455,7 @@ Return Value:
 
                     if ((Cpuid7[1] & 0xC0020000) == 0xC0020000) {
 
+                        this->KernelIsa += " avx512core";
                         this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx512Core;
                         this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512Core;
                         this->GemmU8U8Kernel = MlasGemmU8U8KernelAvx512Core;
@@ -444,6 +473,17 @@ Return Value:
                             this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512Vnni;
                             this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvx512Vnni;
                             this->Q8Q4GemmDispatch = &MlasQ8Q4GemmDispatchAvx512vnni;
+                            this->KernelIsa += " avx512vnni";
+                        }
+
+                        //
+                        // Check if the processor supports AVX512-FP16.
+                        //
+
+                        if ((Cpuid7[3] & 0x800000) != 0) {
+
+                            this->HalfGemmDispatch = &MlasHalfGemmDispatchAvx512Fp16;
+                            this->KernelIsa += " avx512fp16";
                         }
                     }
                 }
@@ -459,6 +499,10 @@ Return Value:
                     if (MlasInitAMX()) {
                         this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAmx;
                         this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchAmx;
+                        if (this->ConvSymU8S8Dispatch == &MlasConvSymDispatchAvx512Vnni) {
+                            this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAmx;
+                        }
+                        this->KernelIsa += " amx";
                     }
                 }
 #endif // __APPLE__
@@ -483,6 +527,14 @@ Return Value:
     this->ConvSymU8S8Dispatch = &MlasConvSymU8DispatchNeon;
     this->ConvSymS8S8Dispatch = &MlasConvSymS8DispatchNeon;
     this->SQNBitGemmDispatch = &MlasSQNBitGemmDispatchNeon;
+    this->ComputeExpF32Kernel = MlasComputeExpF32Kernel;
+    this->LogisticKernelRoutine = MlasLogisticKernel;
+    this->TanhKernelRoutine = MlasTanhKernel;
+    this->ComputeSumExpF32Kernel = MlasComputeSumExpF32Kernel;
+    this->ComputeSoftmaxOutputF32Kernel = MlasComputeSoftmaxOutputF32Kernel;
+    this->ComputeLogSoftmaxOutputF32Kernel = MlasComputeLogSoftmaxOutputF32Kernel;
+    this->ReduceMaximumF32Kernel = MlasReduceMaximumF32Kernel;
+    this->KernelIsa = "neon";
 
     //
     // Check if the processor supports ASIMD dot product instructions.
@@ -512,6 +564,7 @@ Return Value:
         this->SymmQgemmDispatch = &MlasSymmQgemmS8DispatchSdot;
         this->ConvSymU8S8Dispatch = &MlasConvSymU8DispatchDot;
         this->ConvSymS8S8Dispatch = &MlasConvSymS8DispatchDot;
+        this->KernelIsa += " dot";
     }
 
 #if defined(__linux__)
@@ -522,13 +575,32 @@ Return Value:
         this->GemmU8U8Dispatch = &MlasGemmU8X8DispatchUmmla;
         this->GemmU8S8Dispatch = &MlasGemmU8X8DispatchUmmla;
         this->GemmS8S8Dispatch = &MlasGemmS8S8DispatchSmmla;
+        this->KernelIsa += " i8mm";
     }
+
+#if defined(MLAS_USE_SVE)
+    //
+    // Check if the processor supports SVE instructions. The SVE kernels are
+    // vector length agnostic, so they use the full width of the processor.
+    //
+    if (MLAS_CPUIDINFO::GetCPUIDInfo().HasArmSVE()) {
+        this->ComputeExpF32Kernel = MlasComputeExpF32KernelSve;
+        this->LogisticKernelRoutine = MlasComputeLogisticF32KernelSve;
+        this->TanhKernelRoutine = MlasComputeTanhF32KernelSve;
+        this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelSve;
+        this->ComputeSoftmaxOutputF32Kernel = MlasComputeSoftmaxOutputF32KernelSve;
+        this->ComputeLogSoftmaxOutputF32Kernel = MlasComputeLogSoftmaxOutputF32KernelSve;
+        this->ReduceMaximumF32Kernel = MlasReduceMaximumF32KernelSve;
+        this->KernelIsa += " sve";
+    }
+#endif
 #endif
 
 #endif // MLAS_TARGET_ARM64
 #if defined(MLAS_TARGET_POWER)
     this->GemmFloatKernel = MlasSgemmKernel;
     this->GemmDoubleKernel = MlasDgemmKernel;
+    this->KernelIsa = "power";
     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8Kernel;
     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8Kernel;
     this->QuantizeLinearS16Kernel = MlasQuantizeLinearS16Kernel;
@@ -541,6 +613,7 @@ Return Value:
     if (HasP9Instructions) {
         this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8KernelVSX;
         this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8KernelVSX;
+        this->KernelIsa += " power9";
     }
 
 #if defined(POWER10)
@@ -551,6 +624,7 @@ Return Value:
         this->GemmFloatKernel = MlasSgemmKernelPOWER10;
         this->GemmDoubleKernel = MlasDgemmKernelPOWER10;
         this->GemmU8X8Dispatch = &MlasGemm8X8DispatchPOWER10;
+        this->KernelIsa += " power10";
     }
 #endif
 #endif
@@ -569,6 +643,7 @@ Return Value:
     bool cap_lsx = hwcap & HWCAP_LOONGARCH_LSX;
 
     if( cap_lasx ){
+        this->KernelIsa = "lasx";
         this->GemmFloatKernel = MlasGemmFloatKernelLasx;
         this->GemmDoubleKernel = MlasGemmDoubleKernelLasx;
         this->ConvNchwFloatKernel = MlasConvNchwFloatKernelLasx;
@@ -586,6 +661,7 @@ Return Value:
         this->GemmU8S8Dispatch = &MlasGemmU8X8DispatchLSX;
         this->GemmU8U8Dispatch = &MlasGemmU8X8DispatchLSX;
     }else if( cap_lsx ){
+        this->KernelIsa = "lsx";
         this->GemmFloatKernel = MlasGemmFloatKernelLSX;
         this->GemmU8S8Dispatch = &MlasGemmU8X8DispatchLSX;
         this->GemmU8U8Dispatch = &MlasGemmU8X8DispatchLSX;
@@ -647,6 +723,31 @@ Return Value:
 #endif
 }
 
+const char*
+MLASCALL
+MlasGetKernelIsa(
+    void
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the instruction set extensions the kernels of this
+    library were selected for on the current processor.
+
+Arguments:
+
+    None.
+
+Return Value:
+
+    Returns the extensions separated by spaces, e.g. "sse2 avx avx2 f16c".
+
+--*/
+{
+    return GetMlasPlatform().KernelIsa.c_str();
+}
+
 #ifdef MLAS_TARGET_AMD64_IX86
 
 bool
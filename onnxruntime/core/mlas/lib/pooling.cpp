@@ -1701,3 +1701,142 @@ MlasMaximumPool<uint8_t>(
     size_t OutputCount,
     size_t KernelSize
     );
+
+template<bool IsMaxPool>
+void
+MlasNhwcPoolFloat(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the max or average pooling operation for NHWC
+    fp32 tensors. Entries of the indirection buffer that are nullptr refer to
+    padding and are skipped.
+
+Arguments:
+
+    Input - Supplies the indirection buffer of KernelSize pointers per output
+        pixel.
+
+    Output - Supplies the output tensor.
+
+    Channels - Supplies the number of channels.
+
+    OutputCount - Supplies the number of output pixels.
+
+    KernelSize - Supplies the number of pointers per output pixel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float InitialValue = IsMaxPool ? std::numeric_limits<float>::lowest() : 0.0f;
+
+    while (OutputCount > 0) {
+
+        size_t ValidCount = 0;
+
+        for (size_t k = 0; k < KernelSize; k++) {
+            ValidCount += (Input[k] != nullptr) ? 1 : 0;
+        }
+
+        const float Scale = (ValidCount > 0) ? 1.0f / float(ValidCount) : 0.0f;
+
+        size_t ChannelOffset = 0;
+        size_t c = Channels;
+
+        while (c >= 4) {
+
+            MLAS_FLOAT32X4 Reduction = MlasBroadcastFloat32x4(InitialValue);
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                if (Input[k] == nullptr) {
+                    continue;
+                }
+
+                MLAS_FLOAT32X4 InputVector = MlasLoadFloat32x4(&Input[k][ChannelOffset]);
+
+                if constexpr (IsMaxPool) {
+                    Reduction = MlasMaximumFloat32x4(Reduction, InputVector);
+                } else {
+                    Reduction = MlasAddFloat32x4(Reduction, InputVector);
+                }
+            }
+
+            if constexpr (!IsMaxPool) {
+                Reduction = MlasMultiplyFloat32x4(Reduction, MlasBroadcastFloat32x4(Scale));
+            }
+
+            MlasStoreFloat32x4(Output, Reduction);
+            Output += 4;
+
+            ChannelOffset += 4;
+            c -= 4;
+        }
+
+        while (c > 0) {
+
+            float Reduction = InitialValue;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                if (Input[k] == nullptr) {
+                    continue;
+                }
+
+                if constexpr (IsMaxPool) {
+                    Reduction = std::max(Reduction, Input[k][ChannelOffset]);
+                } else {
+                    Reduction += Input[k][ChannelOffset];
+                }
+            }
+
+            if constexpr (!IsMaxPool) {
+                Reduction *= Scale;
+            }
+
+            *Output++ = Reduction;
+
+            ChannelOffset += 1;
+            c -= 1;
+        }
+
+        Input += KernelSize;
+        OutputCount -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasNhwcMaxPool(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+{
+    MlasNhwcPoolFloat<true>(Input, Output, Channels, OutputCount, KernelSize);
+}
+
+void
+MLASCALL
+MlasNhwcAvgPool(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+{
+    MlasNhwcPoolFloat<false>(Input, Output, Channels, OutputCount, KernelSize);
+}
@@ -119,6 +119,87 @@ MlasQgemmGetKernelOutputCnt(
     return int32_t(dispatch->StrideM);
 }
 
+const char*
+MLASCALL
+MlasGemmQuantGetKernelName(
+    bool AIsSigned,
+    bool BIsSigned
+    )
+{
+    const auto* Dispatch = MlasGemmQuantGetDispatch(AIsSigned, BIsSigned);
+
+#if defined(MLAS_TARGET_AMD64)
+    if (Dispatch == &MlasGemmU8S8DispatchAmx) {
+        return "amx";
+    }
+    //
+    // The AVX2 dispatches call the kernel of the widest extension the
+    // processor supports.
+    //
+    if (Dispatch == &MlasGemmU8S8DispatchAvx2) {
+        auto* Kernel = GetMlasPlatform().GemmU8S8Kernel;
+        if (Kernel == MlasGemmU8S8KernelAvx512Vnni) {
+            return "avx512vnni";
+        }
+        if (Kernel == MlasGemmU8S8KernelAvx512Core) {
+            return "avx512core";
+        }
+        if (Kernel == MlasGemmU8S8KernelAvxVnni) {
+            return "avxvnni";
+        }
+        return "avx2";
+    }
+    if (Dispatch == &MlasGemmU8U8DispatchAvx2) {
+        return GetMlasPlatform().GemmU8U8Kernel == MlasGemmU8U8KernelAvx512Core ? "avx512core" : "avx2";
+    }
+#endif
+#if defined(MLAS_TARGET_AMD64_IX86)
+    if (Dispatch == &MlasGemmU8S8DispatchSse41) {
+        return "sse4.1";
+    }
+    if (Dispatch == &MlasGemmU8X8DispatchSse) {
+        return "sse2";
+    }
+#endif
+#if defined(MLAS_TARGET_ARM64)
+    if (Dispatch == &MlasGemmU8X8DispatchUmmla || Dispatch == &MlasGemmS8S8DispatchSmmla) {
+        return "i8mm";
+    }
+    if (Dispatch == &MlasGemmU8X8DispatchUdot || Dispatch == &MlasGemmS8S8DispatchSdot) {
+        return "dot";
+    }
+#endif
+#if defined(MLAS_TARGET_ARM64) || defined(MLAS_TARGET_ARM64EC) || (defined(MLAS_TARGET_ARM) && !defined(_MSC_VER))
+    if (Dispatch == &MlasGemmU8X8DispatchNeon) {
+        return "neon";
+    }
+#endif
+#if defined(MLAS_TARGET_ARM64)
+    if (Dispatch == &MlasGemmX8S8DispatchNeon) {
+        return "neon";
+    }
+#endif
+#if defined(MLAS_TARGET_WASM_SIMD)
+    if (Dispatch == &MlasGemmU8X8DispatchWasmSimd) {
+        return "wasm_simd";
+    }
+#endif
+#if defined(MLAS_TARGET_LARCH64)
+    if (Dispatch == &MlasGemmU8X8DispatchLSX) {
+        return "lsx";
+    }
+#endif
+#if defined(MLAS_TARGET_POWER) && defined(__linux__)  && defined(POWER10) && \
+    ((defined(__GNUC__) && ((__GNUC__ > 10) || (__GNUC__== 10 && __GNUC_MINOR__ >= 2))) || \
+    (defined(__clang__) && (__clang_major__ >= 12)))
+    if (Dispatch == &MlasGemm8X8DispatchPOWER10) {
+        return "power10";
+    }
+#endif
+
+    return Dispatch == &MlasGemmQuantDispatchDefault ? "default" : "unknown";
+}
+
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(push)
 // VC++ suggests we can attempt to make 'MlasBitsOfFp32' constexpr, but it is not valid.
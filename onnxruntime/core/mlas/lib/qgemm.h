@@ -592,6 +592,14 @@ Return Value:
     PackedB = (const uint8_t*)(PackedColumnSumBuffer + AlignedN);
     PackedColumnSumBuffer += RangeStartN;
 
+    //
+    // When the rows fit in a single panel, as for the GEMV case of a single
+    // row, matrix A is packed once per slice along the K dimension instead of
+    // once per slice along the N dimension.
+    //
+
+    const bool SinglePanelA = (RangeCountM <= Strides.M);
+
     //
     // Step through each slice of matrix B along the K dimension.
     //
@@ -649,40 +657,43 @@ Return Value:
 
                 CountM = std::min(RangeCountM - m, Strides.M);
 
-                //
-                // Copy a panel of matrix A to a local packed buffer.
-                //
-
-                MlasGemmQuantCopyPackA<KernelType>(
-                    PanelA,
-                    A + m * lda,
-                    lda,
-                    CountM,
-                    CountK,
-                    RowSumBuffer,
-                    Shape->AIsSigned);
-
-                //
-                // Apply the global depth value constant without the ZeroPointB scaling from:
-                //
-                //     (A[i] - ZeroPointA) * (B[i] - ZeroPointB)
-                //              ==>
-                //     A[i] * B[i] - A[i] * ZeroPointB - B[i] * ZeroPointA + ZeroPointA * ZeroPointB
-                //
-                // The ZeroPointB term is factored out and either applied below for per-matrix
-                // quantization or inside the kernel for per-column quantization.
-                //
-
-                for (size_t mm = 0; mm < CountM; mm++) {
-                    RowSumBuffer[mm] -= int32_t(CountK) * ZeroPointA;
-                }
+                if (!SinglePanelA || n == 0) {
+
+                    //
+                    // Copy a panel of matrix A to a local packed buffer.
+                    //
+
+                    MlasGemmQuantCopyPackA<KernelType>(
+                        PanelA,
+                        A + m * lda,
+                        lda,
+                        CountM,
+                        CountK,
+                        RowSumBuffer,
+                        Shape->AIsSigned);
+
+                    //
+                    // Apply the global depth value constant without the ZeroPointB scaling from:
+                    //
+                    //     (A[i] - ZeroPointA) * (B[i] - ZeroPointB)
+                    //              ==>
+                    //     A[i] * B[i] - A[i] * ZeroPointB - B[i] * ZeroPointA + ZeroPointA * ZeroPointB
+                    //
+                    // The ZeroPointB term is factored out and either applied below for per-matrix
+                    // quantization or inside the kernel for per-column quantization.
+                    //
+
+                    for (size_t mm = 0; mm < CountM; mm++) {
+                        RowSumBuffer[mm] -= int32_t(CountK) * ZeroPointA;
+                    }
 
-                //
-                // Scale the row sums by the per-matrix zero point offset of matrix B.
-                //
+                    //
+                    // Scale the row sums by the per-matrix zero point offset of matrix B.
+                    //
 
-                if (PackedZeroPointB == nullptr) {
-                    MlasGemmQuantScaleSumBuffer(RowSumBuffer, CountM, -ZeroPointB);
+                    if (PackedZeroPointB == nullptr) {
+                        MlasGemmQuantScaleSumBuffer(RowSumBuffer, CountM, -ZeroPointB);
+                    }
                 }
 
                 //
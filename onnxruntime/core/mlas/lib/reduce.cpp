@@ -0,0 +1,586 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce.cpp
+
+Abstract:
+
+    This module implements routines to reduce a matrix along its rows or
+    along its columns: sum, sum of squares, maximum, minimum and the log of
+    the sum of the exponentials.
+
+    The reductions along a row keep four vector accumulators in flight to
+    hide the latency of the vector operations. The reductions along the
+    columns combine four rows at a time into a block of the output that stays
+    in the cache.
+
+    The half precision routines widen a block of the input to single
+    precision and accumulate in single precision.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of elements widened from half precision at a time and number of
+// output columns combined at a time by the reductions along the columns.
+//
+
+constexpr size_t MLAS_REDUCE_BLOCK_SIZE = 256;
+
+//
+// Traits of the reduction kinds that combine elements with one vector
+// operation.
+//
+
+template<MLAS_REDUCE_KIND ReduceKind>
+struct MLAS_REDUCE_TRAITS;
+
+template<>
+struct MLAS_REDUCE_TRAITS<MlasReduceSum>
+{
+    static float Initial() { return 0.0f; }
+
+    static MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 Accumulator, MLAS_FLOAT32X4 Vector)
+    {
+        return MlasAddFloat32x4(Accumulator, Vector);
+    }
+
+    static MLAS_FLOAT32X4 Merge(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+    {
+        return MlasAddFloat32x4(Vector1, Vector2);
+    }
+
+    static float Combine(float Accumulator, float Value) { return Accumulator + Value; }
+
+    static float Merge(float Value1, float Value2) { return Value1 + Value2; }
+
+    static float Reduce(MLAS_FLOAT32X4 Vector) { return MlasReduceAddFloat32x4(Vector); }
+};
+
+template<>
+struct MLAS_REDUCE_TRAITS<MlasReduceSumSquare>
+{
+    static float Initial() { return 0.0f; }
+
+    static MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 Accumulator, MLAS_FLOAT32X4 Vector)
+    {
+        return MlasMultiplyAddFloat32x4(Vector, Vector, Accumulator);
+    }
+
+    static MLAS_FLOAT32X4 Merge(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+    {
+        return MlasAddFloat32x4(Vector1, Vector2);
+    }
+
+    static float Combine(float Accumulator, float Value) { return Accumulator + Value * Value; }
+
+    static float Merge(float Value1, float Value2) { return Value1 + Value2; }
+
+    static float Reduce(MLAS_FLOAT32X4 Vector) { return MlasReduceAddFloat32x4(Vector); }
+};
+
+template<>
+struct MLAS_REDUCE_TRAITS<MlasReduceMaximum>
+{
+    static float Initial() { return -std::numeric_limits<float>::infinity(); }
+
+    static MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 Accumulator, MLAS_FLOAT32X4 Vector)
+    {
+        return MlasMaximumFloat32x4(Accumulator, Vector);
+    }
+
+    static MLAS_FLOAT32X4 Merge(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+    {
+        return MlasMaximumFloat32x4(Vector1, Vector2);
+    }
+
+    static float Combine(float Accumulator, float Value) { return std::max(Accumulator, Value); }
+
+    static float Merge(float Value1, float Value2) { return std::max(Value1, Value2); }
+
+    static float Reduce(MLAS_FLOAT32X4 Vector) { return MlasReduceMaximumFloat32x4(Vector); }
+};
+
+template<>
+struct MLAS_REDUCE_TRAITS<MlasReduceMinimum>
+{
+    static float Initial() { return std::numeric_limits<float>::infinity(); }
+
+    static MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 Accumulator, MLAS_FLOAT32X4 Vector)
+    {
+        return MlasMinimumFloat32x4(Accumulator, Vector);
+    }
+
+    static MLAS_FLOAT32X4 Merge(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+    {
+        return MlasMinimumFloat32x4(Vector1, Vector2);
+    }
+
+    static float Combine(float Accumulator, float Value) { return std::min(Accumulator, Value); }
+
+    static float Merge(float Value1, float Value2) { return std::min(Value1, Value2); }
+
+    static float Reduce(MLAS_FLOAT32X4 Vector) { return MlasReduceMinimumFloat32x4(Vector); }
+};
+
+template<MLAS_REDUCE_KIND ReduceKind>
+float
+MlasReduceVectorKernel(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces a vector with four vector accumulators.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    Returns the reduction of the supplied buffer.
+
+--*/
+{
+    using Traits = MLAS_REDUCE_TRAITS<ReduceKind>;
+
+    float Accumulator = Traits::Initial();
+
+    if (N >= 4) {
+
+        MLAS_FLOAT32X4 AccumulatorVector0 = MlasBroadcastFloat32x4(Accumulator);
+
+        if (N >= 16) {
+
+            MLAS_FLOAT32X4 AccumulatorVector1 = AccumulatorVector0;
+            MLAS_FLOAT32X4 AccumulatorVector2 = AccumulatorVector0;
+            MLAS_FLOAT32X4 AccumulatorVector3 = AccumulatorVector0;
+
+            while (N >= 16) {
+
+                AccumulatorVector0 = Traits::Combine(AccumulatorVector0, MlasLoadFloat32x4(Input));
+                AccumulatorVector1 = Traits::Combine(AccumulatorVector1, MlasLoadFloat32x4(Input + 4));
+                AccumulatorVector2 = Traits::Combine(AccumulatorVector2, MlasLoadFloat32x4(Input + 8));
+                AccumulatorVector3 = Traits::Combine(AccumulatorVector3, MlasLoadFloat32x4(Input + 12));
+
+                Input += 16;
+                N -= 16;
+            }
+
+            AccumulatorVector0 = Traits::Merge(AccumulatorVector0, AccumulatorVector1);
+            AccumulatorVector2 = Traits::Merge(AccumulatorVector2, AccumulatorVector3);
+            AccumulatorVector0 = Traits::Merge(AccumulatorVector0, AccumulatorVector2);
+        }
+
+        while (N >= 4) {
+
+            AccumulatorVector0 = Traits::Combine(AccumulatorVector0, MlasLoadFloat32x4(Input));
+
+            Input += 4;
+            N -= 4;
+        }
+
+        Accumulator = Traits::Reduce(AccumulatorVector0);
+    }
+
+    while (N > 0) {
+
+        Accumulator = Traits::Combine(Accumulator, *Input);
+
+        Input += 1;
+        N -= 1;
+    }
+
+    return Accumulator;
+}
+
+float
+MlasReduceVectorMaximum(
+    const float* Input,
+    size_t N
+    )
+{
+    //
+    // The platform kernel starts from the lowest finite value, which is only
+    // used as the offset of the exponentials.
+    //
+
+#if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
+    return GetMlasPlatform().ReduceMaximumF32Kernel(Input, N);
+#else
+    return MlasReduceMaximumF32Kernel(Input, N);
+#endif
+}
+
+float
+MlasReduceVectorSumExp(
+    const float* Input,
+    size_t N,
+    float Maximum
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the sum of the exponentials of a vector offset by
+    the supplied maximum of the vector.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+    Maximum - Supplies the maximum value of the buffer.
+
+Return Value:
+
+    Returns the sum of exp(Input[i] - Maximum).
+
+--*/
+{
+    if (Maximum == -std::numeric_limits<float>::infinity()) {
+        return 0.0f;
+    }
+
+    if (!std::isfinite(Maximum)) {
+
+        //
+        // The vectorized exponential clamps its argument, so compute the
+        // infinities and NaNs of the sum exactly.
+        //
+
+        float Accumulation = 0.0f;
+
+        for (size_t n = 0; n < N; n++) {
+            Accumulation += std::exp(Input[n] - Maximum);
+        }
+
+        return Accumulation;
+    }
+
+    float NegativeMaximum = -Maximum;
+
+#if defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().ComputeSumExpF32Kernel(Input, nullptr, N, &NegativeMaximum);
+#else
+    return MlasComputeSumExpF32Kernel(Input, nullptr, N, &NegativeMaximum);
+#endif
+}
+
+float
+MlasReduceVector(
+    MLAS_REDUCE_KIND ReduceKind,
+    const float* Input,
+    size_t N
+    )
+{
+    switch (ReduceKind) {
+        case MlasReduceSum:
+            return MlasReduceVectorKernel<MlasReduceSum>(Input, N);
+        case MlasReduceSumSquare:
+            return MlasReduceVectorKernel<MlasReduceSumSquare>(Input, N);
+        case MlasReduceMaximum:
+            return MlasReduceVectorKernel<MlasReduceMaximum>(Input, N);
+        case MlasReduceMinimum:
+            return MlasReduceVectorKernel<MlasReduceMinimum>(Input, N);
+        case MlasReduceLogSumExp: {
+            const float Maximum = MlasReduceVectorMaximum(Input, N);
+            return std::log(MlasReduceVectorSumExp(Input, N, Maximum)) + Maximum;
+        }
+    }
+
+    MLAS_THROW_EX(std::invalid_argument, "unsupported reduction kind");
+}
+
+float
+MlasReduceMerge(
+    MLAS_REDUCE_KIND ReduceKind,
+    float Value1,
+    float Value2
+    )
+{
+    switch (ReduceKind) {
+        case MlasReduceMaximum:
+            return MLAS_REDUCE_TRAITS<MlasReduceMaximum>::Merge(Value1, Value2);
+        case MlasReduceMinimum:
+            return MLAS_REDUCE_TRAITS<MlasReduceMinimum>::Merge(Value1, Value2);
+        default:
+            return Value1 + Value2;
+    }
+}
+
+float
+MlasReduceInitial(
+    MLAS_REDUCE_KIND ReduceKind
+    )
+{
+    switch (ReduceKind) {
+        case MlasReduceMaximum:
+            return MLAS_REDUCE_TRAITS<MlasReduceMaximum>::Initial();
+        case MlasReduceMinimum:
+            return MLAS_REDUCE_TRAITS<MlasReduceMinimum>::Initial();
+        default:
+            return 0.0f;
+    }
+}
+
+template<MLAS_REDUCE_KIND ReduceKind>
+void
+MlasReduceColumnsKernel(
+    const float* Input,
+    float* Output,
+    size_t Rows,
+    size_t Columns,
+    size_t ldInput
+    )
+/*++
+
+Routine Description:
+
+    This routine combines the rows of a matrix into the output vector, four
+    rows at a time.
+
+Arguments:
+
+    Input - Supplies the input matrix.
+
+    Output - Supplies the output vector, which holds the partial reductions
+        of the columns on entry.
+
+    Rows - Supplies the number of rows of the input matrix.
+
+    Columns - Supplies the number of columns of the input matrix.
+
+    ldInput - Supplies the leading dimension of the input matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    using Traits = MLAS_REDUCE_TRAITS<ReduceKind>;
+
+    while (Rows > 0) {
+
+        const size_t RowCount = std::min(Rows, size_t{4});
+
+        const float* Input0 = Input;
+        const float* Input1 = (RowCount > 1) ? Input + ldInput : Input0;
+        const float* Input2 = (RowCount > 2) ? Input + 2 * ldInput : Input0;
+        const float* Input3 = (RowCount > 3) ? Input + 3 * ldInput : Input0;
+
+        size_t c = 0;
+
+        if (RowCount == 4) {
+
+            const MLAS_FLOAT32X4 InitialVector = MlasBroadcastFloat32x4(Traits::Initial());
+
+            for (; c + 4 <= Columns; c += 4) {
+
+                MLAS_FLOAT32X4 Accumulator0 = Traits::Combine(MlasLoadFloat32x4(Output + c), MlasLoadFloat32x4(Input0 + c));
+                MLAS_FLOAT32X4 Accumulator1 = Traits::Combine(InitialVector, MlasLoadFloat32x4(Input1 + c));
+                Accumulator0 = Traits::Combine(Accumulator0, MlasLoadFloat32x4(Input2 + c));
+                Accumulator1 = Traits::Combine(Accumulator1, MlasLoadFloat32x4(Input3 + c));
+
+                MlasStoreFloat32x4(Output + c, Traits::Merge(Accumulator0, Accumulator1));
+            }
+
+        } else {
+
+            for (; c + 4 <= Columns; c += 4) {
+
+                MLAS_FLOAT32X4 Accumulator = MlasLoadFloat32x4(Output + c);
+
+                for (size_t r = 0; r < RowCount; r++) {
+                    Accumulator = Traits::Combine(Accumulator, MlasLoadFloat32x4(Input + r * ldInput + c));
+                }
+
+                MlasStoreFloat32x4(Output + c, Accumulator);
+            }
+        }
+
+        for (; c < Columns; c++) {
+
+            float Accumulator = Output[c];
+
+            for (size_t r = 0; r < RowCount; r++) {
+                Accumulator = Traits::Combine(Accumulator, Input[r * ldInput + c]);
+            }
+
+            Output[c] = Accumulator;
+        }
+
+        Input += RowCount * ldInput;
+        Rows -= RowCount;
+    }
+}
+
+void
+MlasReduceColumns(
+    MLAS_REDUCE_KIND ReduceKind,
+    const float* Input,
+    float* Output,
+    size_t Rows,
+    size_t Columns,
+    size_t ldInput
+    )
+{
+    switch (ReduceKind) {
+        case MlasReduceSum:
+            MlasReduceColumnsKernel<MlasReduceSum>(Input, Output, Rows, Columns, ldInput);
+            break;
+        case MlasReduceSumSquare:
+            MlasReduceColumnsKernel<MlasReduceSumSquare>(Input, Output, Rows, Columns, ldInput);
+            break;
+        case MlasReduceMaximum:
+            MlasReduceColumnsKernel<MlasReduceMaximum>(Input, Output, Rows, Columns, ldInput);
+            break;
+        case MlasReduceMinimum:
+            MlasReduceColumnsKernel<MlasReduceMinimum>(Input, Output, Rows, Columns, ldInput);
+            break;
+        default:
+            MLAS_THROW_EX(std::invalid_argument, "unsupported reduction kind");
+    }
+}
+
+void
+MLASCALL
+MlasReduceLastAxis(
+    MLAS_REDUCE_KIND ReduceKind,
+    const float* Input,
+    float* Output,
+    size_t Rows,
+    size_t Columns
+    )
+{
+    for (size_t r = 0; r < Rows; r++) {
+        Output[r] = MlasReduceVector(ReduceKind, Input + r * Columns, Columns);
+    }
+}
+
+void
+MLASCALL
+MlasReduceLastAxis(
+    MLAS_REDUCE_KIND ReduceKind,
+    const MLAS_FP16* Input,
+    float* Output,
+    size_t Rows,
+    size_t Columns
+    )
+{
+    MLAS_DECLSPEC_ALIGN(float Buffer[MLAS_REDUCE_BLOCK_SIZE], 64);
+
+    for (size_t r = 0; r < Rows; r++) {
+
+        const MLAS_FP16* Row = Input + r * Columns;
+
+        //
+        // The log of the sum of the exponentials is offset by the maximum of
+        // the row, so find the maximum with a first pass over the row.
+        //
+
+        const MLAS_REDUCE_KIND BlockKind = (ReduceKind == MlasReduceLogSumExp) ? MlasReduceMaximum : ReduceKind;
+
+        float Accumulator = MlasReduceInitial(BlockKind);
+
+        for (size_t n = 0; n < Columns; n += MLAS_REDUCE_BLOCK_SIZE) {
+
+            const size_t CountN = std::min(Columns - n, MLAS_REDUCE_BLOCK_SIZE);
+
+            MlasConvertHalfToFloatBuffer(reinterpret_cast<const unsigned short*>(Row + n), Buffer, CountN);
+
+            Accumulator = MlasReduceMerge(BlockKind, Accumulator, MlasReduceVector(BlockKind, Buffer, CountN));
+        }
+
+        if (ReduceKind == MlasReduceLogSumExp) {
+
+            const float Maximum = Accumulator;
+
+            Accumulator = 0.0f;
+
+            for (size_t n = 0; n < Columns; n += MLAS_REDUCE_BLOCK_SIZE) {
+
+                const size_t CountN = std::min(Columns - n, MLAS_REDUCE_BLOCK_SIZE);
+
+                MlasConvertHalfToFloatBuffer(reinterpret_cast<const unsigned short*>(Row + n), Buffer, CountN);
+
+                Accumulator += MlasReduceVectorSumExp(Buffer, CountN, Maximum);
+            }
+
+            Accumulator = std::log(Accumulator) + Maximum;
+        }
+
+        Output[r] = Accumulator;
+    }
+}
+
+void
+MLASCALL
+MlasReduceFirstAxis(
+    MLAS_REDUCE_KIND ReduceKind,
+    const float* Input,
+    float* Output,
+    size_t Rows,
+    size_t Columns,
+    size_t ldInput
+    )
+{
+    const float Initial = MlasReduceInitial(ReduceKind);
+
+    for (size_t c = 0; c < Columns; c += MLAS_REDUCE_BLOCK_SIZE) {
+
+        const size_t CountC = std::min(Columns - c, MLAS_REDUCE_BLOCK_SIZE);
+
+        std::fill_n(Output + c, CountC, Initial);
+
+        MlasReduceColumns(ReduceKind, Input + c, Output + c, Rows, CountC, ldInput);
+    }
+}
+
+void
+MLASCALL
+MlasReduceFirstAxis(
+    MLAS_REDUCE_KIND ReduceKind,
+    const MLAS_FP16* Input,
+    float* Output,
+    size_t Rows,
+    size_t Columns,
+    size_t ldInput
+    )
+{
+    MLAS_DECLSPEC_ALIGN(float Buffer[4 * MLAS_REDUCE_BLOCK_SIZE], 64);
+
+    const float Initial = MlasReduceInitial(ReduceKind);
+
+    for (size_t c = 0; c < Columns; c += MLAS_REDUCE_BLOCK_SIZE) {
+
+        const size_t CountC = std::min(Columns - c, MLAS_REDUCE_BLOCK_SIZE);
+
+        std::fill_n(Output + c, CountC, Initial);
+
+        for (size_t r = 0; r < Rows; r += 4) {
+
+            const size_t RowCount = std::min(Rows - r, size_t{4});
+
+            for (size_t i = 0; i < RowCount; i++) {
+                MlasConvertHalfToFloatBuffer(reinterpret_cast<const unsigned short*>(Input + (r + i) * ldInput + c),
+                                             Buffer + i * MLAS_REDUCE_BLOCK_SIZE, CountC);
+            }
+
+            MlasReduceColumns(ReduceKind, Buffer, Output + c, RowCount, CountC, MLAS_REDUCE_BLOCK_SIZE);
+        }
+    }
+}
@@ -0,0 +1,89 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation with bfloat16 compute, MlasSBGemmBatch.
+
+--*/
+
+#include "mlasi.h"
+#ifdef MLAS_JBLAS
+#include "jblas_gemm.h"
+#endif
+
+size_t
+MLASCALL
+MlasSBGemmPackBSize(
+    size_t N,
+    size_t K
+    )
+{
+#ifdef MLAS_JBLAS
+    return JblasSBGemmPackBSize(N, K);
+#else
+    MLAS_UNREFERENCED_PARAMETER(N);
+    MLAS_UNREFERENCED_PARAMETER(K);
+    return 0;
+#endif
+}
+
+void
+MLASCALL
+MlasSBGemmConvertPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+#ifdef MLAS_JBLAS
+    if (JblasSBGemmPackB(PackedB, B, N, K, ldb, TransB == CblasTrans, ThreadPool)) {
+        return;
+    }
+#endif
+    MLAS_UNREFERENCED_PARAMETER(TransB);
+    MLAS_UNREFERENCED_PARAMETER(N);
+    MLAS_UNREFERENCED_PARAMETER(K);
+    MLAS_UNREFERENCED_PARAMETER(B);
+    MLAS_UNREFERENCED_PARAMETER(ldb);
+    MLAS_UNREFERENCED_PARAMETER(PackedB);
+    MLAS_UNREFERENCED_PARAMETER(ThreadPool);
+    MLAS_THROW_EX(std::runtime_error, "bfloat16 GEMM is not supported on this platform");
+}
+
+void
+MLASCALL
+MlasSBGemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SBGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+#ifdef MLAS_JBLAS
+    if (JblasSBGemmBatchDriver(M, N, K, BatchSize, Data, ThreadPool)) {
+        return;
+    }
+#endif
+    MLAS_UNREFERENCED_PARAMETER(M);
+    MLAS_UNREFERENCED_PARAMETER(N);
+    MLAS_UNREFERENCED_PARAMETER(K);
+    MLAS_UNREFERENCED_PARAMETER(Data);
+    MLAS_UNREFERENCED_PARAMETER(BatchSize);
+    MLAS_UNREFERENCED_PARAMETER(ThreadPool);
+    MLAS_THROW_EX(std::runtime_error, "matrix B was not packed by MlasSBGemmConvertPackB on this platform");
+}
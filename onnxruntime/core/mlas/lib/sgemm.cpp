@@ -1003,6 +1003,52 @@ Return Value:
 
 #endif
 
+MLAS_FORCEINLINE
+void
+MlasSgemmPostProcess(
+    const MLAS_SGEMM_POSTPROCESS* PostProcess,
+    size_t StartM,
+    size_t StartN,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine invokes the optional output processor on a block of the
+    output matrix that has been fully accumulated.
+
+Arguments:
+
+    PostProcess - Optionally supplies the output processor and the position
+        of the output of the operation within the processed matrix.
+
+    StartM - Supplies the first row of the block relative to the output of the
+        operation.
+
+    StartN - Supplies the first column of the block relative to the output of
+        the operation.
+
+    CountM - Supplies the number of rows of the block.
+
+    CountN - Supplies the number of columns of the block.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (PostProcess != nullptr) {
+        PostProcess->OutputProcessor->Process(PostProcess->C, PostProcess->StartM + StartM,
+            PostProcess->StartN + StartN, CountM, CountN, ldc);
+    }
+}
+
 MLAS_FORCEINLINE
 float*
 MlasSgemmKernelLoop(
@@ -1015,7 +1061,10 @@ MlasSgemmKernelLoop(
     size_t lda,
     size_t ldc,
     float alpha,
-    bool ZeroMode
+    bool ZeroMode,
+    const MLAS_SGEMM_POSTPROCESS* PostProcess,
+    size_t StartM,
+    size_t StartN
     )
 /*++
 
@@ -1051,6 +1100,16 @@ Arguments:
     ZeroMode - Supplies true if the output matrix must be zero initialized,
         else false if the output matrix is accumulated into.
 
+    PostProcess - Optionally supplies the output processor to invoke on the
+        rows as they are produced. Supplied only for the final slice along
+        the K dimension, so that the rows are processed while still cached.
+
+    StartM - Supplies the first row of matrix C relative to the output of the
+        operation.
+
+    StartN - Supplies the first column of matrix C relative to the output of
+        the operation.
+
 Return Value:
 
     Returns the next address of matrix C.
@@ -1071,9 +1130,12 @@ Return Value:
         }
 #endif
 
+        MlasSgemmPostProcess(PostProcess, StartM, StartN, RowsHandled, CountN, ldc);
+
         C += ldc * RowsHandled;
         A += lda * RowsHandled;
         CountM -= RowsHandled;
+        StartM += RowsHandled;
     }
 
     return C;
@@ -1093,7 +1155,8 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_POSTPROCESS* PostProcess
     )
 /*++
 
@@ -1131,6 +1194,9 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    PostProcess - Optionally supplies the output processor to invoke on the
+        output blocks once they are final.
+
 Return Value:
 
     None.
@@ -1147,6 +1213,7 @@ Return Value:
 
     if (K == 0) {
         MlasSgemmMultiplyBeta(C, M, N, ldc, beta);
+        MlasSgemmPostProcess(PostProcess, 0, 0, M, N, ldc);
         return;
     }
 
@@ -1170,6 +1237,7 @@ Return Value:
 
         if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(A, B, C, K, N, ldb, beta);
+            MlasSgemmPostProcess(PostProcess, 0, 0, M, N, ldc);
             return;
         }
 
@@ -1177,6 +1245,7 @@ Return Value:
 
         if (TransB == CblasNoTrans) {
             MlasGemvFloatKernel(A, B, C, K, N, ldb, (beta == 0.0f));
+            MlasSgemmPostProcess(PostProcess, 0, 0, M, N, ldc);
             return;
         }
 
@@ -1205,6 +1274,7 @@ Return Value:
 
         if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(B, A, C, K, M, lda, beta);
+            MlasSgemmPostProcess(PostProcess, 0, 0, M, N, ldc);
             return;
         }
 
@@ -1278,14 +1348,18 @@ Return Value:
             }
 
             //
-            // Step through each slice of matrix A along the M dimension.
+            // Step through each slice of matrix A along the M dimension. The
+            // output rows are final after the last slice along the K
+            // dimension.
             //
 
             float* c = C + n;
+            const MLAS_SGEMM_POSTPROCESS* SlicePostProcess = (k + CountK == K) ? PostProcess : nullptr;
 
             if (TransA == CblasNoTrans) {
 
-                MlasSgemmKernelLoop(A + k, PanelB, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode);
+                MlasSgemmKernelLoop(A + k, PanelB, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode,
+                    SlicePostProcess, 0, n);
 
             } else {
 
@@ -1309,7 +1383,8 @@ Return Value:
                     // Step through the rows of the local buffer.
                     //
 
-                    c = MlasSgemmKernelLoop(PanelA, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
+                    c = MlasSgemmKernelLoop(PanelA, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode,
+                        SlicePostProcess, M - RowsRemaining - RowsTransposed, n);
                 }
             }
 
@@ -1332,7 +1407,8 @@ MlasSgemmPackedOperation(
     size_t AlignedN,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_POSTPROCESS* PostProcess
     )
 /*++
 
@@ -1372,6 +1448,9 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    PostProcess - Optionally supplies the output processor to invoke on the
+        output blocks once they are final.
+
 Return Value:
 
     None.
@@ -1380,6 +1459,40 @@ Return Value:
 {
     float PanelA[MLAS_SGEMM_TRANSA_ROWS * MLAS_SGEMM_PACKED_STRIDEK];
 
+    //
+    // Handle the special case of a single row of matrix A (GEMV). There is no
+    // reuse of matrix B, so the operation is bound by the bandwidth to read
+    // the packed matrix. Step through each slice of matrix B along the K
+    // dimension for the whole column range instead of slicing along the N
+    // dimension first: the packed data for the column range is contiguous
+    // within a K slice and is streamed from memory once, while the single
+    // output row stays cached.
+    //
+
+    if (M == 1 && TransA == CblasNoTrans) {
+
+        if (beta != 0.0f && beta != 1.0f) {
+            MlasSgemmMultiplyBeta(C, 1, RangeCountN, ldc, beta);
+        }
+
+        size_t CountK;
+        bool ZeroMode = (beta == 0.0f);
+
+        for (size_t k = 0; k < K; k += CountK) {
+
+            CountK = std::min(K - k, size_t(MLAS_SGEMM_PACKED_STRIDEK));
+
+            const float* pb = (const float*)PackedB + AlignedN * k + CountK * RangeStartN;
+
+            MlasSgemmKernelLoop(A + k, pb, C, CountK, 1, RangeCountN, lda, ldc, alpha, ZeroMode,
+                (k + CountK == K) ? PostProcess : nullptr, 0, 0);
+
+            ZeroMode = false;
+        }
+
+        return;
+    }
+
     //
     // Step through each slice of matrix B along the N dimension.
     //
@@ -1417,10 +1530,12 @@ Return Value:
 
             const float* pb = (const float*)PackedB + AlignedN * k + CountK * SliceStartN;
             float* c = C + n;
+            const MLAS_SGEMM_POSTPROCESS* SlicePostProcess = (k + CountK == K) ? PostProcess : nullptr;
 
             if (TransA == CblasNoTrans) {
 
-                MlasSgemmKernelLoop(A + k, pb, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode);
+                MlasSgemmKernelLoop(A + k, pb, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode,
+                    SlicePostProcess, 0, n);
 
             } else {
 
@@ -1444,7 +1559,8 @@ Return Value:
                     // Step through the rows of the local buffer.
                     //
 
-                    c = MlasSgemmKernelLoop(PanelA, pb, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
+                    c = MlasSgemmKernelLoop(PanelA, pb, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode,
+                        SlicePostProcess, M - RowsRemaining - RowsTransposed, n);
                 }
             }
 
@@ -1453,6 +1569,91 @@ Return Value:
     }
 }
 
+void
+MlasSgemmJitOperation(
+    size_t M,
+    const MLAS_SGEMM_DATA_PARAMS* DataParams,
+    size_t StartM
+    )
+/*++
+
+Routine Description:
+
+    This routine executes a range of rows of a single precision matrix/matrix
+    multiply operation with a kernel generated by MlasSgemmJitKernelGet.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C to compute.
+
+    DataParams - Supplies the data position and layout of the matrices.
+
+    StartM - Supplies the first row of matrix A and matrix C to compute.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_SGEMM_JIT_KERNEL* Kernel = DataParams->JitKernel;
+
+    MLAS_SGEMM_JIT_PARAMS Params;
+    Params.A = DataParams->A + StartM * DataParams->lda;
+    Params.B = DataParams->B;
+    Params.C = DataParams->C + StartM * DataParams->ldc;
+    Params.lda = DataParams->lda;
+    Params.ldc = DataParams->ldc;
+    Params.Bias = DataParams->JitBias;
+    Params.alpha = DataParams->alpha;
+    Params.beta = DataParams->beta;
+
+    while (M > 0) {
+
+        const size_t RowsThisPass = std::min(M, MLAS_SGEMM_JIT_ROWS);
+
+        Kernel->Routines[RowsThisPass - 1](&Params);
+
+        Params.A += RowsThisPass * Params.lda;
+        Params.C += RowsThisPass * Params.ldc;
+        M -= RowsThisPass;
+    }
+}
+
+bool
+MlasSgemmJitUsable(
+    CBLAS_TRANSPOSE TransA,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* DataParams
+    )
+/*++
+
+Routine Description:
+
+    This routine determines whether the generated kernel supplied with the
+    data parameters matches the operation.
+
+Arguments:
+
+    TransA - Supplies the transpose operation on A matrix
+
+    N, K - Supplies the shape of the multiplication
+
+    DataParams - Supplies the data position and layout of the matrices
+
+Return Value:
+
+    Returns true if the generated kernel can compute the operation.
+
+--*/
+{
+    const MLAS_SGEMM_JIT_KERNEL* Kernel = DataParams->JitKernel;
+
+    return Kernel != nullptr && DataParams->BIsPacked && TransA == CblasNoTrans &&
+        Kernel->N == N && Kernel->K == K && Kernel->HasBias == (DataParams->JitBias != nullptr);
+}
+
 void
 MlasSgemmThreaded(
     const ptrdiff_t ThreadCountM,
@@ -1496,6 +1697,24 @@ Return Value:
 --*/
 {
 
+    //
+    // Read the copy of a pre-packed B that is local to the NUMA node running
+    // this thread.
+    //
+
+    MLAS_SGEMM_DATA_PARAMS NodeDataParams;
+
+    if (DataParams->BIsPacked && DataParams->BNodeReplicaCount != 0) {
+
+        const size_t Node = MlasGetCurrentNumaNode();
+
+        if (Node < DataParams->BNodeReplicaCount && DataParams->BNodeReplicas[Node] != nullptr) {
+            NodeDataParams = *DataParams;
+            NodeDataParams.B = DataParams->BNodeReplicas[Node];
+            DataParams = &NodeDataParams;
+        }
+    }
+
     const ptrdiff_t ThreadIdM = ThreadId / ThreadCountN;
     const ptrdiff_t ThreadIdN = ThreadId % ThreadCountN;
 
@@ -1508,6 +1727,16 @@ Return Value:
 
     MlasPartitionWork(ThreadIdM, ThreadCountM, M, &RangeStartM, &RangeCountM);
 
+    //
+    // A generated kernel computes all the columns of its rows, so it is used
+    // only when the operation is partitioned along the M dimension.
+    //
+
+    if (ThreadCountN == 1 && MlasSgemmJitUsable(TransA, N, K, DataParams)) {
+        MlasSgemmJitOperation(RangeCountM, DataParams, RangeStartM);
+        return;
+    }
+
     //
     // Partition the operation along the N dimension.
     //
@@ -1536,11 +1765,21 @@ Return Value:
     const float* A = DataParams->A + RangeStartM * ((TransA == CblasNoTrans) ? lda : 1);
     float* C = DataParams->C + RangeStartM * ldc + RangeStartN;
 
+    MLAS_SGEMM_POSTPROCESS PostProcess;
+    PostProcess.OutputProcessor = DataParams->OutputProcessor;
+    PostProcess.C = DataParams->C;
+    PostProcess.StartM = RangeStartM;
+    PostProcess.StartN = RangeStartN;
+
+    const MLAS_SGEMM_POSTPROCESS* ThreadPostProcess =
+        (DataParams->OutputProcessor != nullptr) ? &PostProcess : nullptr;
+
     if (DataParams->BIsPacked) {
 
         MlasSgemmPackedOperation(TransA, RangeCountM, RangeStartN, RangeCountN,
             K, DataParams->alpha, A, lda, DataParams->B,
-            BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, DataParams->beta, C, ldc);
+            BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, DataParams->beta, C, ldc,
+            ThreadPostProcess);
 
     } else {
 
@@ -1549,7 +1788,8 @@ Return Value:
         const float* B = (const float*)DataParams->B + RangeStartN * ((TransB == CblasNoTrans) ? 1 : ldb);
 
         MlasSgemmOperation(TransA, TransB, RangeCountM, RangeCountN, K,
-            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc);
+            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc,
+            ThreadPostProcess);
     }
 }
 #if defined(_MSC_VER) && !defined(__clang__)
@@ -1639,6 +1879,59 @@ MlasGemmBatch(
 #pragma warning(pop)
 #endif
 
+const char*
+MLASCALL
+MlasSgemmGetKernelName(
+    void
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the name of the single precision GEMM kernel selected
+    for the current processor.
+
+Arguments:
+
+    None.
+
+Return Value:
+
+    Returns the name of the kernel, e.g. "avx512f".
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64_IX86) || defined(MLAS_TARGET_POWER) || defined(MLAS_TARGET_LARCH64)
+    auto* GemmFloatKernel = GetMlasPlatform().GemmFloatKernel;
+#endif
+
+#if defined(MLAS_TARGET_AMD64)
+    if (GemmFloatKernel == MlasGemmFloatKernelAvx512F) {
+        return "avx512f";
+    }
+    if (GemmFloatKernel == MlasGemmFloatKernelFma3) {
+        return "fma3";
+    }
+#endif
+#if defined(MLAS_TARGET_AMD64_IX86)
+    if (GemmFloatKernel == MlasGemmFloatKernelAvx) {
+        return "avx";
+    }
+    return "sse2";
+#elif defined(MLAS_TARGET_POWER)
+    return GemmFloatKernel == MlasSgemmKernelPOWER10 ? "power10" : "power";
+#elif defined(MLAS_TARGET_LARCH64)
+    if (GemmFloatKernel == MlasGemmFloatKernelLasx) {
+        return "lasx";
+    }
+    return GemmFloatKernel == MlasGemmFloatKernelLSX ? "lsx" : "default";
+#elif defined(MLAS_TARGET_ARM64) || defined(MLAS_TARGET_ARM)
+    return "neon";
+#else
+    return "default";
+#endif
+}
+
 size_t
 MLASCALL
 MlasGemmPackBSize(
@@ -0,0 +1,626 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sgemm_jit.cpp
+
+Abstract:
+
+    This module implements the generation at run time of single precision
+    matrix/matrix multiply micro-kernels for a matrix B packed by
+    MlasGemmPackB.
+
+    A kernel is specialized for the exact number of columns N and depth K of
+    the operation and for its epilogue. The loops along N and K are unrolled
+    at generation time, so the remainder columns of the last packed panel are
+    handled with a constant mask instead of a generic edge path, and the
+    accumulators of a tile stay in registers across the slices of the packed
+    matrix along K. The bias row and the piecewise linear activations are
+    applied to the accumulators before the tile is stored.
+
+    One routine is generated for each count of rows of a tile, up to
+    MLAS_SGEMM_JIT_ROWS rows. The kernels use AVX2 and FMA3 instructions and
+    are generated with the Xbyak assembler bundled with jblas.
+
+--*/
+
+#include "mlasi.h"
+
+#if defined(MLAS_JBLAS) && defined(MLAS_TARGET_AMD64)
+
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+#include "jblas/xbyak/xbyak.h"
+#include "jblas/xbyak/xbyak_util.h"
+
+//
+// Define the limit on the number of packed panels along N and slices along K
+// of a generated kernel, which bounds the size of the unrolled code.
+//
+
+constexpr size_t MLAS_SGEMM_JIT_MAXIMUM_BLOCKS = 64;
+
+class MLAS_SGEMM_JIT_GENERATOR : public MLAS_SGEMM_JIT_KERNEL, private Xbyak::CodeGenerator
+{
+public:
+    MLAS_SGEMM_JIT_GENERATOR(
+        size_t N,
+        size_t K,
+        const MLAS_ACTIVATION& Activation,
+        bool HasBias
+        ) :
+            Xbyak::CodeGenerator(EstimateCodeSize(N, K)),
+            Activation_(Activation)
+    {
+        this->N = N;
+        this->K = K;
+        this->HasBias = HasBias;
+
+        size_t Offsets[MLAS_SGEMM_JIT_ROWS];
+
+        for (size_t Rows = 1; Rows <= MLAS_SGEMM_JIT_ROWS; Rows++) {
+            align(16);
+            Offsets[Rows - 1] = getSize();
+            GenerateRoutine(Rows);
+        }
+
+        GenerateConstants();
+
+        ready();
+
+        for (size_t Rows = 1; Rows <= MLAS_SGEMM_JIT_ROWS; Rows++) {
+            Routines[Rows - 1] = reinterpret_cast<MLAS_SGEMM_JIT_ROUTINE*>(
+                const_cast<uint8_t*>(getCode()) + Offsets[Rows - 1]);
+        }
+    }
+
+    static
+    size_t
+    PanelCount(
+        size_t N
+        )
+    {
+        return (N + 15) / 16;
+    }
+
+    static
+    size_t
+    SliceCount(
+        size_t K
+        )
+    {
+        return (K + MLAS_SGEMM_PACKED_STRIDEK - 1) / MLAS_SGEMM_PACKED_STRIDEK;
+    }
+
+private:
+    const MLAS_ACTIVATION Activation_;
+    Xbyak::Label MaskLabel_;
+    Xbyak::Label ConstantsLabel_;
+
+    Xbyak::Reg64 Params_;
+    Xbyak::Reg64 RowA_[MLAS_SGEMM_JIT_ROWS];
+    Xbyak::Reg64 PanelB_;
+    Xbyak::Reg64 OffsetK_;
+    Xbyak::Reg64 C_;
+    Xbyak::Reg64 C3_;
+    Xbyak::Reg64 ldc_;
+
+    static
+    size_t
+    EstimateCodeSize(
+        size_t N,
+        size_t K
+        )
+    {
+        //
+        // Bound the size of the code of the largest tile generously: each
+        // slice has at most seven unrolled steps and each panel has one
+        // epilogue.
+        //
+
+        const size_t SliceBytes = 7 * 160 + 64;
+        const size_t PanelBytes = 1024 + SliceCount(K) * SliceBytes;
+
+        return MLAS_SGEMM_JIT_ROWS * (512 + PanelCount(N) * PanelBytes) + 4096;
+    }
+
+    Xbyak::Ymm
+    Accumulator(
+        size_t Row,
+        size_t Vector
+        ) const
+    {
+        return Xbyak::Ymm(int(Row * 2 + Vector));
+    }
+
+    Xbyak::Address
+    AddressC(
+        size_t Row,
+        size_t Offset
+        ) const
+    {
+        const Xbyak::Reg64& Base = (Row < 3) ? C_ : C3_;
+        const int Disp = int(Offset);
+
+        switch (Row % 3) {
+            case 0:
+                return ptr[Base + Disp];
+            case 1:
+                return ptr[Base + ldc_ + Disp];
+            default:
+                return ptr[Base + ldc_ * 2 + Disp];
+        }
+    }
+
+    void
+    GenerateStep(
+        size_t Rows,
+        size_t VectorCount,
+        size_t OffsetA,
+        size_t OffsetB
+        )
+    {
+        vmovups(ymm12, ptr[PanelB_ + int(OffsetB)]);
+        if (VectorCount > 1) {
+            vmovups(ymm13, ptr[PanelB_ + int(OffsetB + 32)]);
+        }
+
+        for (size_t Row = 0; Row < Rows; Row++) {
+            vbroadcastss(ymm14, ptr[RowA_[Row] + OffsetK_ + int(OffsetA)]);
+            vfmadd231ps(Accumulator(Row, 0), ymm12, ymm14);
+            if (VectorCount > 1) {
+                vfmadd231ps(Accumulator(Row, 1), ymm13, ymm14);
+            }
+        }
+    }
+
+    void
+    GenerateSlice(
+        size_t Rows,
+        size_t VectorCount,
+        size_t StartN,
+        size_t StartK,
+        size_t CountK
+        )
+    {
+        //
+        // Compute the address of the panel within the slice. The slices are
+        // packed one after another, each with the panels for all columns.
+        //
+
+        const size_t AlignedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+        const size_t OffsetB = (AlignedN * StartK + CountK * StartN) * sizeof(float);
+
+        mov(PanelB_, ptr[Params_ + offsetof(MLAS_SGEMM_JIT_PARAMS, B)]);
+        if (OffsetB != 0) {
+            add(PanelB_, uint32_t(OffsetB));
+        }
+        xor_(OffsetK_, OffsetK_);
+
+        //
+        // Step through the slice four rows of matrix B at a time.
+        //
+
+        const size_t LoopCount = CountK / 4;
+
+        if (LoopCount > 0) {
+
+            Xbyak::Label LoopLabel;
+            L(LoopLabel);
+
+            for (size_t u = 0; u < 4; u++) {
+                GenerateStep(Rows, VectorCount, (StartK + u) * sizeof(float), u * 16 * sizeof(float));
+            }
+
+            add(PanelB_, 4 * 16 * sizeof(float));
+            add(OffsetK_, 4 * sizeof(float));
+            cmp(OffsetK_, uint32_t(LoopCount * 4 * sizeof(float)));
+            jb(LoopLabel, T_NEAR);
+        }
+
+        for (size_t u = 0; u < CountK % 4; u++) {
+            GenerateStep(Rows, VectorCount, (StartK + u) * sizeof(float), u * 16 * sizeof(float));
+        }
+    }
+
+    void
+    GenerateLoadVector(
+        const Xbyak::Ymm& Vector,
+        const Xbyak::Address& Address,
+        bool Masked
+        )
+    {
+        if (Masked) {
+            vmaskmovps(Vector, ymm15, Address);
+        } else {
+            vmovups(Vector, Address);
+        }
+    }
+
+    void
+    GenerateEpilogue(
+        size_t Rows,
+        size_t VectorCount,
+        size_t StartN,
+        bool MaskLast
+        )
+    {
+        if (MaskLast) {
+            vmovups(ymm15, ptr[rip + MaskLabel_]);
+        }
+
+        //
+        // Scale the accumulators by alpha.
+        //
+
+        vbroadcastss(ymm13, ptr[Params_ + offsetof(MLAS_SGEMM_JIT_PARAMS, alpha)]);
+
+        for (size_t Row = 0; Row < Rows; Row++) {
+            for (size_t v = 0; v < VectorCount; v++) {
+                vmulps(Accumulator(Row, v), Accumulator(Row, v), ymm13);
+            }
+        }
+
+        //
+        // Accumulate beta times the output matrix unless beta is zero.
+        //
+
+        Xbyak::Label SkipBetaLabel;
+
+        vbroadcastss(ymm13, ptr[Params_ + offsetof(MLAS_SGEMM_JIT_PARAMS, beta)]);
+        vxorps(ymm14, ymm14, ymm14);
+        vucomiss(xmm13, xmm14);
+        je(SkipBetaLabel, T_NEAR);
+
+        for (size_t Row = 0; Row < Rows; Row++) {
+            for (size_t v = 0; v < VectorCount; v++) {
+                GenerateLoadVector(ymm12, AddressC(Row, (StartN + v * 8) * sizeof(float)),
+                    MaskLast && v + 1 == VectorCount);
+                vfmadd231ps(Accumulator(Row, v), ymm12, ymm13);
+            }
+        }
+
+        L(SkipBetaLabel);
+
+        //
+        // Add the bias row.
+        //
+
+        if (HasBias) {
+
+            mov(PanelB_, ptr[Params_ + offsetof(MLAS_SGEMM_JIT_PARAMS, Bias)]);
+
+            for (size_t v = 0; v < VectorCount; v++) {
+                GenerateLoadVector(ymm12, ptr[PanelB_ + int((StartN + v * 8) * sizeof(float))],
+                    MaskLast && v + 1 == VectorCount);
+                for (size_t Row = 0; Row < Rows; Row++) {
+                    vaddps(Accumulator(Row, v), Accumulator(Row, v), ymm12);
+                }
+            }
+        }
+
+        //
+        // Apply the activation.
+        //
+
+        switch (Activation_.ActivationKind) {
+
+            case MlasReluActivation:
+            {
+                vxorps(ymm14, ymm14, ymm14);
+                for (size_t Row = 0; Row < Rows; Row++) {
+                    for (size_t v = 0; v < VectorCount; v++) {
+                        vmaxps(Accumulator(Row, v), Accumulator(Row, v), ymm14);
+                    }
+                }
+                break;
+            }
+
+            case MlasLeakyReluActivation:
+            {
+                //
+                // Select the scaled value for the negative inputs by their
+                // sign bit.
+                //
+
+                vbroadcastss(ymm13, ptr[rip + ConstantsLabel_]);
+                for (size_t Row = 0; Row < Rows; Row++) {
+                    for (size_t v = 0; v < VectorCount; v++) {
+                        vmulps(ymm12, Accumulator(Row, v), ymm13);
+                        vblendvps(Accumulator(Row, v), Accumulator(Row, v), ymm12, Accumulator(Row, v));
+                    }
+                }
+                break;
+            }
+
+            case MlasClipActivation:
+            {
+                vbroadcastss(ymm13, ptr[rip + ConstantsLabel_]);
+                vbroadcastss(ymm14, ptr[rip + ConstantsLabel_ + 4]);
+                for (size_t Row = 0; Row < Rows; Row++) {
+                    for (size_t v = 0; v < VectorCount; v++) {
+                        vmaxps(Accumulator(Row, v), Accumulator(Row, v), ymm13);
+                        vminps(Accumulator(Row, v), Accumulator(Row, v), ymm14);
+                    }
+                }
+                break;
+            }
+
+            case MlasHardSigmoidActivation:
+            {
+                vbroadcastss(ymm13, ptr[rip + ConstantsLabel_]);
+                vbroadcastss(ymm14, ptr[rip + ConstantsLabel_ + 4]);
+                vxorps(ymm12, ymm12, ymm12);
+                for (size_t Row = 0; Row < Rows; Row++) {
+                    for (size_t v = 0; v < VectorCount; v++) {
+                        vfmadd213ps(Accumulator(Row, v), ymm13, ymm14);
+                        vmaxps(Accumulator(Row, v), Accumulator(Row, v), ymm12);
+                    }
+                }
+                vbroadcastss(ymm12, ptr[rip + ConstantsLabel_ + 8]);
+                for (size_t Row = 0; Row < Rows; Row++) {
+                    for (size_t v = 0; v < VectorCount; v++) {
+                        vminps(Accumulator(Row, v), Accumulator(Row, v), ymm12);
+                    }
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+
+        //
+        // Store the tile.
+        //
+
+        for (size_t Row = 0; Row < Rows; Row++) {
+            for (size_t v = 0; v < VectorCount; v++) {
+                const Xbyak::Address Address = AddressC(Row, (StartN + v * 8) * sizeof(float));
+                if (MaskLast && v + 1 == VectorCount) {
+                    vmaskmovps(Address, ymm15, Accumulator(Row, v));
+                } else {
+                    vmovups(Address, Accumulator(Row, v));
+                }
+            }
+        }
+    }
+
+    void
+    GenerateRoutine(
+        size_t Rows
+        )
+    {
+        Xbyak::util::StackFrame Frame(this, 1, 11, 10 * 16, false);
+
+        Params_ = Frame.p[0];
+        for (size_t Row = 0; Row < MLAS_SGEMM_JIT_ROWS; Row++) {
+            RowA_[Row] = Frame.t[int(Row)];
+        }
+        PanelB_ = Frame.t[6];
+        OffsetK_ = Frame.t[7];
+        C_ = Frame.t[8];
+        C3_ = Frame.t[9];
+        ldc_ = Frame.t[10];
+
+#if defined(_WIN32)
+        for (int i = 0; i < 10; i++) {
+            vmovups(xword[rsp + i * 16], Xbyak::Xmm(6 + i));
+        }
+#endif
+
+        //
+        // Compute the addresses of the rows of matrix A and of matrix C.
+        //
+
+        mov(RowA_[0], ptr[Params_ + offsetof(MLAS_SGEMM_JIT_PARAMS, A)]);
+        mov(OffsetK_, ptr[Params_ + offsetof(MLAS_SGEMM_JIT_PARAMS, lda)]);
+        shl(OffsetK_, 2);
+        for (size_t Row = 1; Row < Rows; Row++) {
+            lea(RowA_[Row], ptr[RowA_[Row - 1] + OffsetK_]);
+        }
+
+        mov(C_, ptr[Params_ + offsetof(MLAS_SGEMM_JIT_PARAMS, C)]);
+        mov(ldc_, ptr[Params_ + offsetof(MLAS_SGEMM_JIT_PARAMS, ldc)]);
+        shl(ldc_, 2);
+        if (Rows > 3) {
+            lea(C3_, ptr[C_ + ldc_ * 2]);
+            add(C3_, ldc_);
+        }
+
+        //
+        // Step through the packed panels of 16 columns, accumulating each
+        // panel over all slices of matrix B along K in registers.
+        //
+
+        for (size_t n = 0; n < N; n += 16) {
+
+            const size_t CountN = std::min(N - n, size_t(16));
+            const size_t VectorCount = (CountN + 7) / 8;
+
+            for (size_t Row = 0; Row < Rows; Row++) {
+                for (size_t v = 0; v < VectorCount; v++) {
+                    vxorps(Accumulator(Row, v), Accumulator(Row, v), Accumulator(Row, v));
+                }
+            }
+
+            for (size_t k = 0; k < K; k += MLAS_SGEMM_PACKED_STRIDEK) {
+                GenerateSlice(Rows, VectorCount, n, k, std::min(K - k, size_t(MLAS_SGEMM_PACKED_STRIDEK)));
+            }
+
+            GenerateEpilogue(Rows, VectorCount, n, (CountN % 8) != 0);
+        }
+
+        vzeroupper();
+
+#if defined(_WIN32)
+        for (int i = 0; i < 10; i++) {
+            vmovups(Xbyak::Xmm(6 + i), xword[rsp + i * 16]);
+        }
+#endif
+
+        Frame.close();
+    }
+
+    void
+    GenerateConstants(
+        void
+        )
+    {
+        align(32);
+
+        L(MaskLabel_);
+        for (size_t i = 0; i < 8; i++) {
+            dd(i < N % 8 ? 0xFFFFFFFF : 0);
+        }
+
+        L(ConstantsLabel_);
+        for (float Value : {Activation_.Parameters.Values[0], Activation_.Parameters.Values[1], 1.0f}) {
+            uint32_t Bits;
+            std::memcpy(&Bits, &Value, sizeof(Bits));
+            dd(Bits);
+        }
+    }
+};
+
+static
+bool
+MlasSgemmJitSupported(
+    void
+    )
+{
+    static const bool Supported = []() {
+        Xbyak::util::Cpu Cpu;
+        return Cpu.has(Xbyak::util::Cpu::tAVX2) && Cpu.has(Xbyak::util::Cpu::tFMA);
+    }();
+
+    return Supported;
+}
+
+std::shared_ptr<const MLAS_SGEMM_JIT_KERNEL>
+MLASCALL
+MlasSgemmJitKernelGet(
+    size_t N,
+    size_t K,
+    const MLAS_ACTIVATION* Activation,
+    bool HasBias
+    )
+/*++
+
+Routine Description:
+
+    This routine returns a kernel generated for the supplied shape and
+    epilogue. The kernels are cached by their specialization and shared by
+    all the callers that hold a reference to them.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    Activation - Optionally supplies the activation to apply to the output.
+
+    HasBias - Supplies true if a bias row is added to the output.
+
+Return Value:
+
+    Returns the kernel, or nullptr if no kernel can be generated.
+
+--*/
+{
+    MLAS_ACTIVATION KernelActivation;
+    KernelActivation.ActivationKind = MlasIdentityActivation;
+    KernelActivation.Parameters.Values[0] = 0.0f;
+    KernelActivation.Parameters.Values[1] = 0.0f;
+
+    //
+    // Copy only the parameters used by the activation, so that the unused
+    // ones do not take part in the key of the cache.
+    //
+
+    if (Activation != nullptr) {
+        switch (Activation->ActivationKind) {
+            case MlasIdentityActivation:
+            case MlasReluActivation:
+                break;
+            case MlasClipActivation:
+            case MlasHardSigmoidActivation:
+                KernelActivation.Parameters.Values[1] = Activation->Parameters.Values[1];
+                [[fallthrough]];
+            case MlasLeakyReluActivation:
+                KernelActivation.Parameters.Values[0] = Activation->Parameters.Values[0];
+                break;
+            default:
+                return nullptr;
+        }
+        KernelActivation.ActivationKind = Activation->ActivationKind;
+    }
+
+    if (N == 0 || K == 0 || !MlasSgemmJitSupported() ||
+        MLAS_SGEMM_JIT_GENERATOR::PanelCount(N) * MLAS_SGEMM_JIT_GENERATOR::SliceCount(K) > MLAS_SGEMM_JIT_MAXIMUM_BLOCKS) {
+        return nullptr;
+    }
+
+    using KEY = std::tuple<size_t, size_t, int, float, float, bool>;
+
+    static std::mutex CacheMutex;
+    static std::map<KEY, std::weak_ptr<const MLAS_SGEMM_JIT_KERNEL>> Cache;
+
+    const KEY Key(N, K, int(KernelActivation.ActivationKind), KernelActivation.Parameters.Values[0],
+        KernelActivation.Parameters.Values[1], HasBias);
+
+    std::lock_guard<std::mutex> Lock(CacheMutex);
+
+    auto& Entry = Cache[Key];
+    std::shared_ptr<const MLAS_SGEMM_JIT_KERNEL> Kernel = Entry.lock();
+
+    if (!Kernel) {
+
+        //
+        // Drop the entries of the kernels that have been released.
+        //
+
+        for (auto it = Cache.begin(); it != Cache.end();) {
+            if (it->second.expired() && it->first != Key) {
+                it = Cache.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        Kernel = std::make_shared<MLAS_SGEMM_JIT_GENERATOR>(N, K, KernelActivation, HasBias);
+        Entry = Kernel;
+    }
+
+    return Kernel;
+}
+
+#else
+
+std::shared_ptr<const MLAS_SGEMM_JIT_KERNEL>
+MLASCALL
+MlasSgemmJitKernelGet(
+    size_t N,
+    size_t K,
+    const MLAS_ACTIVATION* Activation,
+    bool HasBias
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(N);
+    MLAS_UNREFERENCED_PARAMETER(K);
+    MLAS_UNREFERENCED_PARAMETER(Activation);
+    MLAS_UNREFERENCED_PARAMETER(HasBias);
+
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,588 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparsegemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation with a block sparse matrix B, MlasSparseGemmBatch.
+
+    Matrix B is packed as blocks of BlockK rows by four columns. Only the
+    blocks that hold a nonzero value are stored: for each band of four columns,
+    the blocks are stored in the order of K together with the index of their
+    first row. The kernel skips the blocks of zeros and vectorizes across the
+    four columns of a block.
+
+    Pruned weights only benefit from the sparse layout when most of the blocks
+    are zero, so the packing routines decline matrices below a sparsity
+    threshold and the dense SGEMM is used for them instead.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of columns of a sparse block.
+//
+
+constexpr size_t MLAS_SPARSE_GEMM_BLOCK_N = 4;
+
+//
+// Minimum fraction of zero blocks for the sparse layout to be faster than the
+// dense SGEMM, for the 4x4 and 1x4 blocks. 1x4 blocks do a quarter of the
+// multiplies of 4x4 blocks per block index and need a higher sparsity.
+//
+
+constexpr float MLAS_SPARSE_GEMM_MIN_SPARSITY_4x4 = 0.6f;
+constexpr float MLAS_SPARSE_GEMM_MIN_SPARSITY_1x4 = 0.75f;
+
+//
+// Header of a packed sparse matrix B. The header is followed by the start of
+// each band in the block arrays (BandCount + 1 entries), the first row of each
+// block (BlockCount entries) and, at the next aligned offset, the values of
+// each block (BlockK rows of four columns, zero padded).
+//
+
+struct MLAS_SPARSE_GEMM_PACKED_B {
+    size_t N;
+    size_t K;
+    uint32_t BlockK;
+    uint32_t BlockCount;
+};
+
+struct MLAS_SPARSE_GEMM_PACKED_B_LAYOUT {
+    size_t BandStartOffset;
+    size_t BlockRowOffset;
+    size_t ValuesOffset;
+    size_t Size;
+};
+
+MLAS_FORCEINLINE
+MLAS_SPARSE_GEMM_PACKED_B_LAYOUT
+MlasSparseGemmPackedBLayout(
+    size_t N,
+    size_t BlockK,
+    size_t BlockCount
+    )
+{
+    const size_t BandCount = (N + MLAS_SPARSE_GEMM_BLOCK_N - 1) / MLAS_SPARSE_GEMM_BLOCK_N;
+
+    MLAS_SPARSE_GEMM_PACKED_B_LAYOUT Layout;
+    Layout.BandStartOffset = sizeof(MLAS_SPARSE_GEMM_PACKED_B);
+    Layout.BlockRowOffset = Layout.BandStartOffset + (BandCount + 1) * sizeof(uint32_t);
+    Layout.ValuesOffset = UpAlignSize(Layout.BlockRowOffset + BlockCount * sizeof(uint32_t));
+    Layout.Size = Layout.ValuesOffset + BlockCount * BlockK * MLAS_SPARSE_GEMM_BLOCK_N * sizeof(float);
+    return Layout;
+}
+
+template<typename Callback>
+void
+MlasSparseGemmForEachBlock(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    size_t BlockK,
+    const float* B,
+    size_t ldb,
+    Callback OnBlock
+    )
+/*++
+
+Routine Description:
+
+    This routine enumerates the blocks of matrix B in band order and invokes
+    the callback with the band, the first row and whether the block holds a
+    nonzero value.
+
+--*/
+{
+    auto Element = [=](size_t k, size_t n) {
+        return (TransB == CblasNoTrans) ? B[k * ldb + n] : B[n * ldb + k];
+    };
+
+    for (size_t n0 = 0; n0 < N; n0 += MLAS_SPARSE_GEMM_BLOCK_N) {
+
+        const size_t CountN = std::min(N - n0, MLAS_SPARSE_GEMM_BLOCK_N);
+
+        for (size_t k0 = 0; k0 < K; k0 += BlockK) {
+
+            const size_t CountK = std::min(K - k0, BlockK);
+            bool IsNonZero = false;
+
+            for (size_t k = k0; k < k0 + CountK && !IsNonZero; k++) {
+                for (size_t n = n0; n < n0 + CountN; n++) {
+                    if (Element(k, n) != 0.0f) {
+                        IsNonZero = true;
+                        break;
+                    }
+                }
+            }
+
+            OnBlock(n0 / MLAS_SPARSE_GEMM_BLOCK_N, k0, IsNonZero);
+        }
+    }
+}
+
+size_t
+MlasSparseGemmSelectBlockK(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    size_t* BlockCount
+    )
+/*++
+
+Routine Description:
+
+    This routine selects the block shape for matrix B from the fraction of
+    its blocks that are zero.
+
+Return Value:
+
+    Returns the number of rows of a block, else zero if matrix B is not sparse
+    enough for the sparse layout.
+
+--*/
+{
+    if (N == 0 || K == 0) {
+        return 0;
+    }
+
+    const size_t BandCount = (N + MLAS_SPARSE_GEMM_BLOCK_N - 1) / MLAS_SPARSE_GEMM_BLOCK_N;
+
+    for (size_t BlockK : {size_t(4), size_t(1)}) {
+
+        const float MinimumSparsity = (BlockK == 4) ? MLAS_SPARSE_GEMM_MIN_SPARSITY_4x4 :
+                                                      MLAS_SPARSE_GEMM_MIN_SPARSITY_1x4;
+        const size_t TotalCount = BandCount * ((K + BlockK - 1) / BlockK);
+
+        size_t NonZeroCount = 0;
+
+        MlasSparseGemmForEachBlock(TransB, N, K, BlockK, B, ldb,
+            [&](size_t, size_t, bool IsNonZero) { NonZeroCount += IsNonZero; });
+
+        if (NonZeroCount <= std::numeric_limits<uint32_t>::max() &&
+            double(NonZeroCount) <= double(TotalCount) * (1.0 - MinimumSparsity)) {
+            *BlockCount = NonZeroCount;
+            return BlockK;
+        }
+    }
+
+    return 0;
+}
+
+size_t
+MLASCALL
+MlasSparseGemmPackBSize(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes for the packed sparse matrix B
+    buffer.
+
+Arguments:
+
+    TransB - Supplies the transpose operation on B matrix
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+Return Value:
+
+    Returns the size in bytes for the packed matrix B buffer, else zero if
+    matrix B is not sparse enough to benefit from the sparse layout.
+
+--*/
+{
+    size_t BlockCount;
+    const size_t BlockK = MlasSparseGemmSelectBlockK(TransB, N, K, B, ldb, &BlockCount);
+
+    if (BlockK == 0) {
+        return 0;
+    }
+
+    return MlasSparseGemmPackedBLayout(N, BlockK, BlockCount).Size;
+}
+
+void
+MLASCALL
+MlasSparseGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the nonzero blocks of matrix B.
+
+Arguments:
+
+    TransB - Supplies the transpose operation on B matrix
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of the buffer of MlasSparseGemmPackBSize
+        bytes.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t BlockCount;
+    const size_t BlockK = MlasSparseGemmSelectBlockK(TransB, N, K, B, ldb, &BlockCount);
+
+    if (BlockK == 0) {
+        MLAS_THROW_EX(std::invalid_argument, "matrix B is not sparse enough to pack");
+    }
+
+    const MLAS_SPARSE_GEMM_PACKED_B_LAYOUT Layout = MlasSparseGemmPackedBLayout(N, BlockK, BlockCount);
+    uint8_t* Buffer = reinterpret_cast<uint8_t*>(PackedB);
+
+    auto* Packed = reinterpret_cast<MLAS_SPARSE_GEMM_PACKED_B*>(Buffer);
+    Packed->N = N;
+    Packed->K = K;
+    Packed->BlockK = uint32_t(BlockK);
+    Packed->BlockCount = uint32_t(BlockCount);
+
+    uint32_t* BandStart = reinterpret_cast<uint32_t*>(Buffer + Layout.BandStartOffset);
+    uint32_t* BlockRow = reinterpret_cast<uint32_t*>(Buffer + Layout.BlockRowOffset);
+    float* Values = reinterpret_cast<float*>(Buffer + Layout.ValuesOffset);
+
+    auto Element = [=](size_t k, size_t n) {
+        return (TransB == CblasNoTrans) ? B[k * ldb + n] : B[n * ldb + k];
+    };
+
+    uint32_t Block = 0;
+    size_t LastBand = 0;
+    BandStart[0] = 0;
+
+    MlasSparseGemmForEachBlock(TransB, N, K, BlockK, B, ldb,
+        [&](size_t Band, size_t k0, bool IsNonZero) {
+
+        while (LastBand < Band) {
+            BandStart[++LastBand] = Block;
+        }
+
+        if (!IsNonZero) {
+            return;
+        }
+
+        const size_t n0 = Band * MLAS_SPARSE_GEMM_BLOCK_N;
+        float* BlockValues = Values + size_t(Block) * BlockK * MLAS_SPARSE_GEMM_BLOCK_N;
+
+        for (size_t k = 0; k < BlockK; k++) {
+            for (size_t n = 0; n < MLAS_SPARSE_GEMM_BLOCK_N; n++) {
+                const bool InRange = (k0 + k < K) && (n0 + n < N);
+                BlockValues[k * MLAS_SPARSE_GEMM_BLOCK_N + n] = InRange ? Element(k0 + k, n0 + n) : 0.0f;
+            }
+        }
+
+        BlockRow[Block++] = uint32_t(k0);
+    });
+
+    const size_t BandCount = (N + MLAS_SPARSE_GEMM_BLOCK_N - 1) / MLAS_SPARSE_GEMM_BLOCK_N;
+
+    while (LastBand < BandCount) {
+        BandStart[++LastBand] = Block;
+    }
+}
+
+template<size_t BlockK, size_t RowCount>
+void
+MlasSparseGemmKernel(
+    const MLAS_SPARSE_GEMM_PACKED_B* Packed,
+    const float* A,
+    size_t lda,
+    float* C,
+    size_t ldc,
+    size_t StartBand,
+    size_t CountBand,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of RowCount rows of matrix C for a range of
+    bands of the sparse matrix B.
+
+Arguments:
+
+    Packed - Supplies the packed sparse matrix B.
+
+    A - Supplies the address of the first row of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    C - Supplies the address of the first row of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    StartBand - Supplies the first band of four columns to compute.
+
+    CountBand - Supplies the number of bands to compute.
+
+    alpha - Supplies the scalar multiplier (see SGEMM definition).
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const uint8_t* Buffer = reinterpret_cast<const uint8_t*>(Packed);
+    const MLAS_SPARSE_GEMM_PACKED_B_LAYOUT Layout =
+        MlasSparseGemmPackedBLayout(Packed->N, BlockK, Packed->BlockCount);
+
+    const uint32_t* BandStart = reinterpret_cast<const uint32_t*>(Buffer + Layout.BandStartOffset);
+    const uint32_t* BlockRow = reinterpret_cast<const uint32_t*>(Buffer + Layout.BlockRowOffset);
+    const float* Values = reinterpret_cast<const float*>(Buffer + Layout.ValuesOffset);
+
+    const size_t N = Packed->N;
+    const size_t K = Packed->K;
+
+    const MLAS_FLOAT32X4 AlphaBroadcast = MlasBroadcastFloat32x4(alpha);
+    const MLAS_FLOAT32X4 BetaBroadcast = MlasBroadcastFloat32x4(beta);
+
+    for (size_t Band = StartBand; Band < StartBand + CountBand; Band++) {
+
+        MLAS_FLOAT32X4 Accumulators[RowCount];
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r] = MlasZeroFloat32x4();
+        }
+
+        for (size_t Block = BandStart[Band]; Block < BandStart[Band + 1]; Block++) {
+
+            const size_t k0 = BlockRow[Block];
+            const float* BlockValues = Values + Block * BlockK * MLAS_SPARSE_GEMM_BLOCK_N;
+
+            //
+            // The rows of the last block beyond K are zero padded in matrix B
+            // but must not be read from matrix A.
+            //
+
+            const size_t CountK = (BlockK == 1 || k0 + BlockK <= K) ? BlockK : K - k0;
+
+            for (size_t k = 0; k < CountK; k++) {
+
+                const MLAS_FLOAT32X4 BElements = MlasLoadFloat32x4(BlockValues + k * MLAS_SPARSE_GEMM_BLOCK_N);
+
+                for (size_t r = 0; r < RowCount; r++) {
+                    const MLAS_FLOAT32X4 ABroadcast = MlasBroadcastFloat32x4(A[r * lda + k0 + k]);
+                    Accumulators[r] = MlasMultiplyAddFloat32x4(ABroadcast, BElements, Accumulators[r]);
+                }
+            }
+        }
+
+        const size_t n0 = Band * MLAS_SPARSE_GEMM_BLOCK_N;
+        const size_t CountN = std::min(N - n0, MLAS_SPARSE_GEMM_BLOCK_N);
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            float* c = C + r * ldc + n0;
+            MLAS_FLOAT32X4 Accumulator = MlasMultiplyFloat32x4(Accumulators[r], AlphaBroadcast);
+
+            if (CountN == MLAS_SPARSE_GEMM_BLOCK_N) {
+
+                if (beta != 0.0f) {
+                    Accumulator = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(c), BetaBroadcast, Accumulator);
+                }
+
+                MlasStoreFloat32x4(c, Accumulator);
+
+            } else {
+
+                float Result[MLAS_SPARSE_GEMM_BLOCK_N];
+                MlasStoreFloat32x4(Result, Accumulator);
+
+                for (size_t n = 0; n < CountN; n++) {
+                    c[n] = (beta != 0.0f) ? Result[n] + beta * c[n] : Result[n];
+                }
+            }
+        }
+    }
+}
+
+template<size_t BlockK>
+void
+MlasSparseGemmOperation(
+    const MLAS_SPARSE_SGEMM_DATA_PARAMS& Params,
+    size_t StartM,
+    size_t CountM,
+    size_t StartBand,
+    size_t CountBand
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a range of rows of matrix C for a range of bands of
+    the sparse matrix B, then invokes the output processor on each block of
+    rows.
+
+--*/
+{
+    const auto* Packed = reinterpret_cast<const MLAS_SPARSE_GEMM_PACKED_B*>(Params.PackedB);
+    const size_t lda = Params.lda;
+    const size_t ldc = Params.ldc;
+
+    const size_t StartN = StartBand * MLAS_SPARSE_GEMM_BLOCK_N;
+    const size_t CountN = std::min(Packed->N, (StartBand + CountBand) * MLAS_SPARSE_GEMM_BLOCK_N) - StartN;
+
+    while (CountM > 0) {
+
+        const float* A = Params.A + StartM * lda;
+        float* C = Params.C + StartM * ldc;
+        const size_t RowCount = std::min(CountM, size_t(4));
+
+        switch (RowCount) {
+            case 4:
+                MlasSparseGemmKernel<BlockK, 4>(Packed, A, lda, C, ldc, StartBand, CountBand, Params.alpha, Params.beta);
+                break;
+            case 3:
+                MlasSparseGemmKernel<BlockK, 3>(Packed, A, lda, C, ldc, StartBand, CountBand, Params.alpha, Params.beta);
+                break;
+            case 2:
+                MlasSparseGemmKernel<BlockK, 2>(Packed, A, lda, C, ldc, StartBand, CountBand, Params.alpha, Params.beta);
+                break;
+            default:
+                MlasSparseGemmKernel<BlockK, 1>(Packed, A, lda, C, ldc, StartBand, CountBand, Params.alpha, Params.beta);
+                break;
+        }
+
+        if (Params.OutputProcessor != nullptr) {
+            Params.OutputProcessor->Process(Params.C, StartM, StartN, RowCount, CountN, ldc);
+        }
+
+        StartM += RowCount;
+        CountM -= RowCount;
+    }
+}
+
+void
+MLASCALL
+MlasSparseGemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SPARSE_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    if (M == 0 || N == 0 || BatchSize == 0) {
+        return;
+    }
+
+    const auto* Packed = reinterpret_cast<const MLAS_SPARSE_GEMM_PACKED_B*>(Data[0].PackedB);
+
+    if (Packed->N != N || Packed->K != K) {
+        MLAS_THROW_EX(std::invalid_argument, "packed sparse matrix B does not match the dimensions");
+    }
+
+    const size_t BandCount = (N + MLAS_SPARSE_GEMM_BLOCK_N - 1) / MLAS_SPARSE_GEMM_BLOCK_N;
+
+    //
+    // Compute the number of target threads given the number of multiplies of
+    // the nonzero blocks.
+    //
+
+    const double Complexity = double(M) * double(Packed->BlockCount) * double(Packed->BlockK) *
+                              double(MLAS_SPARSE_GEMM_BLOCK_N) * double(BatchSize);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * GetMlasPlatform().MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = GetMlasPlatform().MaximumThreadCount;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Segment each multiply across the rows of matrix A, else across the bands
+    // of matrix B for skinny matrices.
+    //
+
+    ptrdiff_t ThreadsPerGemm = (TargetThreadCount + BatchSize - 1) / BatchSize;
+    const bool PartitionN = BandCount > M;
+    const size_t WorkCount = PartitionN ? BandCount : M;
+
+    if (size_t(ThreadsPerGemm) > WorkCount) {
+        ThreadsPerGemm = ptrdiff_t(WorkCount);
+    }
+
+    MlasTrySimpleParallel(ThreadPool,
+        ThreadsPerGemm * static_cast<ptrdiff_t>(BatchSize),
+        [=](ptrdiff_t tid)
+    {
+        const ptrdiff_t GemmIdx = tid / ThreadsPerGemm;
+        const ptrdiff_t ThreadIdx = tid % ThreadsPerGemm;
+        const MLAS_SPARSE_SGEMM_DATA_PARAMS& Params = Data[GemmIdx];
+
+        size_t WorkIndex;
+        size_t WorkRemaining;
+        MlasPartitionWork(ThreadIdx, ThreadsPerGemm, WorkCount, &WorkIndex, &WorkRemaining);
+
+        size_t StartM = 0;
+        size_t CountM = M;
+        size_t StartBand = 0;
+        size_t CountBand = BandCount;
+
+        if (PartitionN) {
+            StartBand = WorkIndex;
+            CountBand = WorkRemaining;
+        } else {
+            StartM = WorkIndex;
+            CountM = WorkRemaining;
+        }
+
+        if (reinterpret_cast<const MLAS_SPARSE_GEMM_PACKED_B*>(Params.PackedB)->BlockK == 4) {
+            MlasSparseGemmOperation<4>(Params, StartM, CountM, StartBand, CountBand);
+        } else {
+            MlasSparseGemmOperation<1>(Params, StartM, CountM, StartBand, CountBand);
+        }
+    });
+}
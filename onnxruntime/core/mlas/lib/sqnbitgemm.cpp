@@ -43,6 +43,19 @@ GetDispatchQuantVariant(size_t BlkBitWidth, size_t BlkLen)
     return type;
 }
 
+// Get the operation for `ComputeType`, nullptr if there is none.
+MLAS_SQNBIT_GEMM_OPERATION*
+GetOperation(int32_t QuantVariant, MLAS_SQNBIT_COMPUTE_TYPE ComputeType)
+{
+    const MLAS_SQNBIT_GEMM_DISPATCH* Dispatch = GetMlasPlatform().SQNBitGemmDispatch;
+    if (QuantVariant == -1 || Dispatch == nullptr) {
+        return nullptr;
+    }
+
+    // the compute types other than int8 don't allow less accuracy than fp32
+    return (ComputeType == CompInt8) ? Dispatch->OperationsCompInt8[QuantVariant] : Dispatch->Operations[QuantVariant];
+}
+
 }  // namespace
 
 void MLASCALL
@@ -53,12 +66,13 @@ MlasSQNBitGemmBatch(
     const size_t BatchN,
     const size_t BlkBitWidth,
     const size_t BlkLen,
+    MLAS_SQNBIT_COMPUTE_TYPE ComputeType,
     const MLAS_SQNBIT_GEMM_DATA_PARAMS* DataParams,
     MLAS_THREADPOOL* ThreadPool
 )
 {
     const int32_t QuantVariant = GetDispatchQuantVariant(BlkBitWidth, BlkLen);
-    MLAS_SQNBIT_GEMM_OPERATION* const Operation = GetMlasPlatform().SQNBitGemmDispatch->Operations[QuantVariant];
+    MLAS_SQNBIT_GEMM_OPERATION* const Operation = GetOperation(QuantVariant, ComputeType);
 
     if (ThreadPool == nullptr) {
         for (size_t gemm_i = 0; gemm_i < BatchN; gemm_i++) {
@@ -130,20 +144,12 @@ MlasSQNBitGemmBatch(
 bool MLASCALL
 MlasIsSQNBitGemmAvailable(
     size_t BlkBitWidth,
-    size_t BlkLen
+    size_t BlkLen,
+    MLAS_SQNBIT_COMPUTE_TYPE ComputeType
 )
 {
     const int32_t QuantVariant = GetDispatchQuantVariant(BlkBitWidth, BlkLen);
-    if (QuantVariant == -1) {
-        return false;
-    }
-
-    if (GetMlasPlatform().SQNBitGemmDispatch == nullptr ||
-        GetMlasPlatform().SQNBitGemmDispatch->Operations[QuantVariant] == nullptr) {
-        return false;
-    }
-
-    return true;
+    return GetOperation(QuantVariant, ComputeType) != nullptr;
 }
 
 size_t MLASCALL
@@ -16,7 +16,8 @@ Abstract:
     for a matrix/matrix multiplication, A*B, where A is a float matrix and B is
     a n-bit quantized integer matrix (QNBitGemm).
 
-    - A shared kernel driver function template, MlasSQNBitGemmOperation.
+    - A shared kernel driver function template, MlasSQNBitGemmOperation, and
+    its variant for the int8 compute type, MlasSQNBitGemmOperationCompInt8.
 
     - Kernel dispatch structure.
 
@@ -98,6 +99,59 @@ MlasQNBitBlkDequantBForSgemm(
     size_t BlockStrideQuantB
 );
 
+/**
+ * @brief Quantize a row of float matrix A to int8 blocks for the int8 compute type. See MlasQ8BlkSize for the layout.
+ *
+ * @tparam BlkLen       Number of values in a block.
+ * @tparam KernelType   Hardware-specific kernel type.
+ *
+ * @param       A           Supplies the A matrix row.
+ * @param       CountK      Number of columns of A.
+ * @param[out]  QuantA      Supplies the output buffer of MlasDivRoundup(CountK, BlkLen) quantized blocks. The values of
+ *                          the last block past CountK are set to 0.
+ */
+template <size_t BlkLen, typename KernelType>
+MLAS_FORCEINLINE void
+MlasQNBitQuantizeARowCompInt8(
+    const float* A,
+    size_t CountK,
+    uint8_t* QuantA
+);
+
+/**
+ * @brief Multiply a row of A quantized to int8 blocks with quantized n-bit integer matrix B, accumulating the
+ *        products of each block in int32.
+ *        B is block quantized and column major.
+ *        This kernel handles the special case where M, the number of rows of A and C, is 1.
+ *
+ * @tparam BlkBitWidth  Bit width of each value in a block.
+ * @tparam BlkLen       Number of values in a block.
+ * @tparam KernelType   Hardware-specific kernel type.
+ *
+ * @param       QuantA              Supplies the A matrix row quantized by MlasQNBitQuantizeARowCompInt8.
+ * @param       QuantBData          Supplies the quantized B matrix block data.
+ * @param       QuantBScale         Supplies the quantized B matrix block scale values.
+ * @param       QuantBZeroPoint     Supplies the quantized B matrix block zero point values. Optional.
+ * @param[out]  C                   Supplies the output C matrix.
+ * @param       CountN              Number of columns of B and C.
+ * @param       CountK              Number of columns of A and rows of B.
+ * @param       BlockStrideQuantB   Number of blocks between adjacent columns of the quantized B matrix.
+ * @param       Bias                Bias vector of length N.
+ */
+template <size_t BlkBitWidth, size_t BlkLen, typename KernelType>
+MLAS_FORCEINLINE void
+MlasSQNBitGemmM1KernelCompInt8(
+    const uint8_t* QuantA,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockStrideQuantB,
+    const float* Bias
+);
+
 //
 // MlasQNBitGemmOperation and helpers
 //
@@ -119,6 +173,41 @@ MlasQNBitZeroPointsForBlksSizeInBytes(size_t BlkCount)
     }
 }
 
+//
+// A row of A quantized for the int8 compute type is a sequence of blocks of BlkLen values, each stored as its float
+// scale followed by its int8 values.
+//
+
+constexpr MLAS_FORCEINLINE size_t
+MlasQ8BlkSize(size_t BlkLen)
+{
+    return sizeof(float) + BlkLen * sizeof(int8_t);
+}
+
+MLAS_FORCEINLINE float&
+MlasQ8BlkScale(uint8_t* BlkPtr)
+{
+    return *reinterpret_cast<float*>(BlkPtr);
+}
+
+MLAS_FORCEINLINE float
+MlasQ8BlkScale(const uint8_t* BlkPtr)
+{
+    return *reinterpret_cast<const float*>(BlkPtr);
+}
+
+MLAS_FORCEINLINE int8_t*
+MlasQ8BlkData(uint8_t* BlkPtr)
+{
+    return reinterpret_cast<int8_t*>(BlkPtr + sizeof(float));
+}
+
+MLAS_FORCEINLINE const int8_t*
+MlasQ8BlkData(const uint8_t* BlkPtr)
+{
+    return reinterpret_cast<const int8_t*>(BlkPtr + sizeof(float));
+}
+
 MLAS_FORCEINLINE void
 MlasAddBiasForGemm(const float* Bias, float* C, size_t CountM, size_t CountN, size_t ldc)
 {
@@ -257,6 +346,71 @@ MlasSQNBitGemmOperation(
     }
 }
 
+template <size_t BlkBitWidth, size_t BlkLen, typename KernelType>
+MLAS_FORCEINLINE void MLASCALL
+MlasSQNBitGemmOperationCompInt8(
+    const size_t K,
+    const MLAS_SQNBIT_GEMM_DATA_PARAMS* const DataParams,
+    const size_t RangeStartM,
+    const size_t RangeCountM,
+    const size_t RangeStartN,
+    const size_t RangeCountN
+)
+{
+    if (RangeCountM != 1) {
+        // the int8 kernel reads B for each row of C, the float kernels dequantize it once for all the rows
+        MlasSQNBitGemmOperation<BlkBitWidth, BlkLen, KernelType>(
+            K, DataParams, RangeStartM, RangeCountM, RangeStartN, RangeCountN
+        );
+        return;
+    }
+
+    const size_t k_blks = MlasDivRoundup(K, BlkLen);
+    const size_t ldb = k_blks * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t k_blks_zp_bytes = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(k_blks);
+
+    const float* A = DataParams->A + RangeStartM * DataParams->lda;
+
+    const uint8_t* QuantBData = static_cast<const uint8_t*>(DataParams->QuantBData) + RangeStartN * ldb;
+    const float* QuantBScale = DataParams->QuantBScale + RangeStartN * k_blks;
+    const uint8_t* QuantBZeroPoint =
+        (DataParams->QuantBZeroPoint == nullptr)
+            ? nullptr
+            : static_cast<const uint8_t*>(DataParams->QuantBZeroPoint) + RangeStartN * k_blks_zp_bytes;
+
+    float* C = DataParams->C + RangeStartM * DataParams->ldc + RangeStartN;
+
+    const float* Bias = (DataParams->Bias == nullptr) ? nullptr : DataParams->Bias + RangeStartN;
+
+    // each range of columns quantizes the row of A, which costs K against the CountN * K of its products
+    MlasThreadedBufAlloc(k_blks * MlasQ8BlkSize(BlkLen));
+    auto* quant_a = reinterpret_cast<uint8_t*>(ThreadedBufHolder.get());
+    MlasQNBitQuantizeARowCompInt8<BlkLen, KernelType>(A, K, quant_a);
+
+    size_t CountN;
+    for (size_t n = 0; n < RangeCountN; n += CountN) {
+        CountN = std::min(RangeCountN - n, size_t{128});
+
+        const uint8_t* b_col = QuantBData + n * ldb;
+        const float* b_col_scale = QuantBScale + n * k_blks;
+        const uint8_t* b_col_zp =
+            (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + n * k_blks_zp_bytes;
+        float* c_blk = C + n;
+        const float* bias = (Bias == nullptr) ? nullptr : Bias + n;
+
+        MlasSQNBitGemmM1KernelCompInt8<BlkBitWidth, BlkLen, KernelType>(
+            quant_a, b_col, b_col_scale, b_col_zp, c_blk, CountN, K, k_blks, bias
+        );
+
+        if (DataParams->PostProcessor != nullptr) {
+            DataParams->PostProcessor->Process(
+                DataParams->C, RangeStartM, RangeStartN + n,
+                RangeCountM, CountN, DataParams->ldc
+            );
+        }
+    }
+}
+
 //
 // Kernel dispatch structure.
 //
@@ -284,4 +438,9 @@ struct MLAS_SQNBIT_GEMM_DISPATCH {
     MLAS_SQNBIT_GEMM_OPERATION* Operations[QuantVariantCount] = {
         // Initialized to nullptrs. Overwrite in hardware-specific kernel implementation.
     };
+
+    // the operations of the int8 compute type
+    MLAS_SQNBIT_GEMM_OPERATION* OperationsCompInt8[QuantVariantCount] = {
+        // Initialized to nullptrs. Overwrite in hardware-specific kernel implementation.
+    };
 };
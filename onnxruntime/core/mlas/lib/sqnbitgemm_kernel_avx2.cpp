@@ -0,0 +1,420 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sqnbitgemm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the float/quantized n-bit integer matrix
+    multiplication kernels for x64 AVX2.
+
+--*/
+
+#include "sqnbitgemm.h"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+//
+// Hardware-specific kernel type.
+//
+struct MLAS_SQNBIT_GEMM_KERNEL_AVX2 {
+};
+
+namespace
+{
+
+template <typename IterationFn, size_t... Indices>
+MLAS_FORCEINLINE void
+UnrolledLoopIterations(IterationFn&& f, std::index_sequence<Indices...> /* indices */)
+{
+    (f(Indices), ...);
+}
+
+template <size_t N, typename IterationFn>
+MLAS_FORCEINLINE void
+UnrolledLoop(IterationFn&& f)
+{
+    UnrolledLoopIterations(std::forward<IterationFn>(f), std::make_index_sequence<N>());
+}
+
+/**
+ * @brief Horizontally sum 4 vectors and return the sums in order.
+ */
+MLAS_FORCEINLINE __m128
+FoldAccumulators(__m256 a0, __m256 a1, __m256 a2, __m256 a3)
+{
+    // per 128-bit lane: a0 a0 a1 a1 | a2 a2 a3 a3 -> a0 a1 a2 a3
+    const __m256 h01 = _mm256_hadd_ps(a0, a1);
+    const __m256 h23 = _mm256_hadd_ps(a2, a3);
+    const __m256 h = _mm256_hadd_ps(h01, h23);
+    return _mm_add_ps(_mm256_castps256_ps128(h), _mm256_extractf128_ps(h, 1));
+}
+
+MLAS_FORCEINLINE float
+HorizontalSum(__m256 a)
+{
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_movehdup_ps(s));
+    return _mm_cvtss_f32(s);
+}
+
+/**
+ * @brief Loads 8 floats, or the first `count` of them followed by zeros.
+ */
+MLAS_FORCEINLINE __m256
+LoadFloat8(const float* src, size_t count)
+{
+    if (count >= 8) {
+        return _mm256_loadu_ps(src);
+    }
+
+    const __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(count)), index);
+    return _mm256_maskload_ps(src, mask);
+}
+
+/**
+ * @brief Converts the 16 4-bit values of 8 bytes, low nibble first, to two vectors of 8 floats.
+ */
+MLAS_FORCEINLINE void
+UnpackFloat16(const uint8_t* src, __m256& lo, __m256& hi)
+{
+    const __m128i low_mask = _mm_set1_epi8(0x0F);
+    const __m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+    const __m128i even = _mm_and_si128(packed, low_mask);
+    const __m128i odd = _mm_and_si128(_mm_srli_epi16(packed, 4), low_mask);
+    const __m128i values = _mm_unpacklo_epi8(even, odd);
+    lo = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(values));
+    hi = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(values, 8)));
+}
+
+template <size_t BlkBitWidth>
+MLAS_FORCEINLINE float
+ZeroPointOfBlk(const uint8_t* QuantBZeroPointColPtr, size_t BlkIdx)
+{
+    static_assert(BlkBitWidth == 4);
+    if (QuantBZeroPointColPtr == nullptr) {
+        return 8.0f;
+    }
+    const uint8_t zp_packed = QuantBZeroPointColPtr[BlkIdx / 2];
+    return static_cast<float>(((BlkIdx & 1) == 1) ? (zp_packed >> 4) : (zp_packed & 0x0F));
+}
+
+template <size_t BlkBitWidth, size_t BlkLen, size_t NCols>
+MLAS_FORCEINLINE void
+ComputeDotProducts(
+    const float* ARowPtr,
+    const uint8_t* QuantBDataColPtr,
+    const float* QuantBScaleColPtr,
+    const uint8_t* QuantBZeroPointColPtr,
+    float* SumPtr,
+    size_t CountK,
+    size_t StrideQuantBData,
+    size_t StrideQuantBScale,
+    size_t StrideQuantBZeroPoint,
+    const float* BiasPtr
+)
+{
+    static_assert(NCols == 1 || NCols == 4, "NCols must be 1 or 4");
+    static_assert(BlkBitWidth == 4);
+
+    constexpr size_t SubBlkLen = 16;  // number of block elements to process in one iteration
+    static_assert(BlkLen % SubBlkLen == 0);
+
+    __m256 acc[NCols];
+    UnrolledLoop<NCols>([&](size_t i) { acc[i] = _mm256_setzero_ps(); });
+
+    const uint8_t* QuantBData = QuantBDataColPtr;
+
+    for (size_t k = 0, blk = 0; k < CountK; k += BlkLen, blk += 1) {
+        const size_t k_blk_len = std::min(CountK - k, BlkLen);
+
+        __m256 zp[NCols];
+        UnrolledLoop<NCols>([&](size_t i) {
+            const uint8_t* zp_col = (QuantBZeroPointColPtr == nullptr)
+                                        ? nullptr
+                                        : QuantBZeroPointColPtr + i * StrideQuantBZeroPoint;
+            zp[i] = _mm256_set1_ps(ZeroPointOfBlk<BlkBitWidth>(zp_col, blk));
+        });
+
+        // sum of a * (b - zp) over the block, the scale is applied once per block
+        __m256 blk_acc[NCols];
+        UnrolledLoop<NCols>([&](size_t i) { blk_acc[i] = _mm256_setzero_ps(); });
+
+        for (size_t k_idx_in_blk = 0; k_idx_in_blk < k_blk_len; k_idx_in_blk += SubBlkLen) {
+            // load `SubBlkLen` elements from A, padded with 0's if there aren't enough
+            const size_t k_subblk_len = std::min(k_blk_len - k_idx_in_blk, SubBlkLen);
+            const float* a = ARowPtr + k + k_idx_in_blk;
+            const __m256 av0 = LoadFloat8(a, k_subblk_len);
+            const __m256 av1 = (k_subblk_len > 8) ? LoadFloat8(a + 8, k_subblk_len - 8) : _mm256_setzero_ps();
+
+            UnrolledLoop<NCols>([&](size_t i) {
+                const size_t b_data_block_offset = k_idx_in_blk * BlkBitWidth / 8;
+                __m256 bv0, bv1;
+                UnpackFloat16(QuantBData + i * StrideQuantBData + b_data_block_offset, bv0, bv1);
+                bv0 = _mm256_sub_ps(bv0, zp[i]);
+                bv1 = _mm256_sub_ps(bv1, zp[i]);
+                blk_acc[i] = _mm256_fmadd_ps(av0, bv0, blk_acc[i]);
+                blk_acc[i] = _mm256_fmadd_ps(av1, bv1, blk_acc[i]);
+            });
+        }
+
+        UnrolledLoop<NCols>([&](size_t i) {
+            const __m256 scale = _mm256_broadcast_ss(QuantBScaleColPtr + i * StrideQuantBScale + blk);
+            acc[i] = _mm256_fmadd_ps(blk_acc[i], scale, acc[i]);
+        });
+
+        // increment pointer to next block
+        QuantBData += MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    }
+
+    if constexpr (NCols == 4) {
+        __m128 sum = FoldAccumulators(acc[0], acc[1], acc[2], acc[3]);
+
+        if (BiasPtr != nullptr) {
+            sum = _mm_add_ps(sum, _mm_loadu_ps(BiasPtr));
+        }
+
+        _mm_storeu_ps(SumPtr, sum);
+    } else {
+        for (size_t i = 0; i < NCols; ++i) {
+            SumPtr[i] = HorizontalSum(acc[i]);
+            if (BiasPtr != nullptr) {
+                SumPtr[i] += BiasPtr[i];
+            }
+        }
+    }
+}
+
+}  // namespace
+
+//
+// MlasSQNBitGemmKernel and helpers.
+//
+
+template <size_t BlkBitWidth, size_t BlkLen>
+MLAS_FORCEINLINE void
+MlasSQNBitGemmM1KernelAvx2(
+    const float* A,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockStrideQuantB,
+    const float* Bias
+)
+{
+    constexpr size_t NCols = 4;
+
+    const size_t BlockCountK = BlockStrideQuantB;
+
+    const size_t StrideQuantBData = BlockCountK * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t StrideQuantBScale = BlockCountK;
+    const size_t StrideQuantBZeroPoint = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockCountK);
+
+    const float* BiasPtr = Bias;
+
+    const uint8_t* QuantBDataColPtr = QuantBData;
+    const float* QuantBScaleColPtr = QuantBScale;
+    const uint8_t* QuantBZeroPointColPtr = QuantBZeroPoint;
+
+    float* SumPtr = C;
+
+    int64_t nblk = static_cast<int64_t>(CountN) - NCols;
+
+    while (nblk >= 0) {
+        ComputeDotProducts<BlkBitWidth, BlkLen, NCols>(
+            A, QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, SumPtr, CountK,
+            StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+            BiasPtr
+        );
+
+        // move to next `NCols` columns
+
+        QuantBDataColPtr += NCols * StrideQuantBData;
+        QuantBScaleColPtr += NCols * StrideQuantBScale;
+        if (QuantBZeroPointColPtr != nullptr) {
+            QuantBZeroPointColPtr += NCols * StrideQuantBZeroPoint;
+        }
+
+        BiasPtr += BiasPtr != nullptr ? NCols : 0;
+        SumPtr += NCols;
+
+        nblk -= NCols;
+    }
+
+    // left over columns less than `NCols`?
+    nblk += NCols;
+    for (int64_t n = 0; n < nblk; ++n) {
+        ComputeDotProducts<BlkBitWidth, BlkLen, 1>(
+            A, QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, SumPtr, CountK,
+            StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+            BiasPtr
+        );
+
+        // move to next column
+
+        QuantBDataColPtr += StrideQuantBData;
+        QuantBScaleColPtr += StrideQuantBScale;
+        if (QuantBZeroPointColPtr != nullptr) {
+            QuantBZeroPointColPtr += StrideQuantBZeroPoint;
+        }
+
+        BiasPtr += BiasPtr != nullptr ? 1 : 0;
+        SumPtr += 1;
+    }
+}
+
+#define SPECIALIZE_SQNBIT_GEMM_M1_KERNEL(BlkBitWidth, BlkLen)                  \
+    template <>                                                                \
+    MLAS_FORCEINLINE void                                                      \
+    MlasSQNBitGemmM1Kernel<BlkBitWidth, BlkLen, MLAS_SQNBIT_GEMM_KERNEL_AVX2>( \
+        const float* A,                                                        \
+        const uint8_t* QuantBData,                                             \
+        const float* QuantBScale,                                              \
+        const uint8_t* QuantBZeroPoint,                                        \
+        float* C,                                                              \
+        size_t CountN,                                                         \
+        size_t CountK,                                                         \
+        size_t BlockStrideQuantB,                                              \
+        const float* Bias                                                      \
+    )                                                                          \
+    {                                                                          \
+        return MlasSQNBitGemmM1KernelAvx2<BlkBitWidth, BlkLen>(                \
+            A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK,    \
+            BlockStrideQuantB, Bias                                            \
+        );                                                                     \
+    }
+
+SPECIALIZE_SQNBIT_GEMM_M1_KERNEL(4, 16)
+SPECIALIZE_SQNBIT_GEMM_M1_KERNEL(4, 32)
+SPECIALIZE_SQNBIT_GEMM_M1_KERNEL(4, 64)
+SPECIALIZE_SQNBIT_GEMM_M1_KERNEL(4, 128)
+SPECIALIZE_SQNBIT_GEMM_M1_KERNEL(4, 256)
+
+#undef SPECIALIZE_SQNBIT_GEMM_M1_KERNEL
+
+//
+// MlasQNBitBlkDequantBForSgemm and helpers.
+//
+
+template <size_t BlkBitWidth, size_t BlkLen>
+MLAS_FORCEINLINE void
+MlasQNBitBlkDequantBForSgemmAvx2(
+    float* FpData,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockStrideQuantB
+)
+{
+    static_assert(BlkBitWidth == 4);
+
+    // the Sgemm kernel reads B in panels of 16 columns, each row of a panel is contiguous
+    constexpr size_t PanelWidth = 16;
+
+    float* Dst = FpData;
+
+    const uint8_t* QuantBDataCol = QuantBData;
+    const float* QuantBScaleCol = QuantBScale;
+    const uint8_t* QuantBZeroPointCol = QuantBZeroPoint;
+
+    for (size_t n = 0; n < CountN; n += PanelWidth) {
+        const size_t nnlen = std::min(CountN - n, PanelWidth);
+
+        for (size_t nn = 0; nn < nnlen; ++nn) {
+            for (size_t k = 0, k_blk_idx = 0; k < CountK; k += BlkLen, k_blk_idx += 1) {
+                const size_t kklen = std::min(CountK - k, BlkLen);
+
+                const uint8_t* b_data = QuantBDataCol + k_blk_idx * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+                const __m256 scale = _mm256_set1_ps(QuantBScaleCol[k_blk_idx]);
+                const __m256 zp = _mm256_set1_ps(ZeroPointOfBlk<BlkBitWidth>(QuantBZeroPointCol, k_blk_idx));
+
+                for (size_t kk = 0; kk < kklen; kk += 16) {
+                    // dequantize 16 values of the column, then scatter them to the rows of the panel
+                    alignas(32) float values[16];
+                    __m256 v0, v1;
+                    UnpackFloat16(b_data + kk / 2, v0, v1);
+                    _mm256_store_ps(values, _mm256_mul_ps(_mm256_sub_ps(v0, zp), scale));
+                    _mm256_store_ps(values + 8, _mm256_mul_ps(_mm256_sub_ps(v1, zp), scale));
+
+                    const size_t len = std::min(kklen - kk, size_t{16});
+                    float* dst = Dst + (k + kk) * PanelWidth + nn;
+                    for (size_t i = 0; i < len; ++i) {
+                        dst[i * PanelWidth] = values[i];
+                    }
+                }
+            }
+
+            QuantBDataCol += BlockStrideQuantB * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+            QuantBScaleCol += BlockStrideQuantB;
+            if (QuantBZeroPointCol != nullptr) {
+                QuantBZeroPointCol += MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockStrideQuantB);
+            }
+        }
+
+        // zero out any remaining columns
+
+        if (nnlen < PanelWidth) {
+            for (size_t k = 0; k < CountK; ++k) {
+                std::fill_n(Dst + (k * PanelWidth) + nnlen, PanelWidth - nnlen, 0.0f);
+            }
+        }
+
+        Dst += CountK * PanelWidth;
+    }
+}
+
+#define SPECIALIZE_QNBIT_BLK_DEQUANT_B_FOR_SGEMM(BlkBitWidth, BlkLen)                           \
+    template <>                                                                                 \
+    MLAS_FORCEINLINE void                                                                       \
+    MlasQNBitBlkDequantBForSgemm<BlkBitWidth, BlkLen, MLAS_SQNBIT_GEMM_KERNEL_AVX2>(            \
+        float* FpData,                                                                          \
+        const uint8_t* QuantBData,                                                              \
+        const float* QuantBScale,                                                               \
+        const uint8_t* QuantBZeroPoint,                                                         \
+        size_t CountN,                                                                          \
+        size_t CountK,                                                                          \
+        size_t BlockStrideQuantB                                                                \
+    )                                                                                           \
+    {                                                                                           \
+        MlasQNBitBlkDequantBForSgemmAvx2<BlkBitWidth, BlkLen>(                                  \
+            FpData, QuantBData, QuantBScale, QuantBZeroPoint, CountN, CountK, BlockStrideQuantB \
+        );                                                                                      \
+    }
+
+SPECIALIZE_QNBIT_BLK_DEQUANT_B_FOR_SGEMM(4, 16)
+SPECIALIZE_QNBIT_BLK_DEQUANT_B_FOR_SGEMM(4, 32)
+SPECIALIZE_QNBIT_BLK_DEQUANT_B_FOR_SGEMM(4, 64)
+SPECIALIZE_QNBIT_BLK_DEQUANT_B_FOR_SGEMM(4, 128)
+SPECIALIZE_QNBIT_BLK_DEQUANT_B_FOR_SGEMM(4, 256)
+
+#undef SPECIALIZE_QNBIT_BLK_DEQUANT_B_FOR_SGEMM
+
+//
+// Kernel dispatch structure definition.
+//
+
+const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvx2 = []() {
+    MLAS_SQNBIT_GEMM_DISPATCH d;
+    d.Operations[QuantVariant_BitWidth4_BlockSize16] = MlasSQNBitGemmOperation<4, 16, MLAS_SQNBIT_GEMM_KERNEL_AVX2>;
+    d.Operations[QuantVariant_BitWidth4_BlockSize32] = MlasSQNBitGemmOperation<4, 32, MLAS_SQNBIT_GEMM_KERNEL_AVX2>;
+    d.Operations[QuantVariant_BitWidth4_BlockSize64] = MlasSQNBitGemmOperation<4, 64, MLAS_SQNBIT_GEMM_KERNEL_AVX2>;
+    d.Operations[QuantVariant_BitWidth4_BlockSize128] = MlasSQNBitGemmOperation<4, 128, MLAS_SQNBIT_GEMM_KERNEL_AVX2>;
+    d.Operations[QuantVariant_BitWidth4_BlockSize256] = MlasSQNBitGemmOperation<4, 256, MLAS_SQNBIT_GEMM_KERNEL_AVX2>;
+    return d;
+}();
@@ -0,0 +1,372 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sqnbitgemm_kernel_avx512.cpp
+
+Abstract:
+
+    This module implements the float/quantized n-bit integer matrix
+    multiplication kernels for x64 AVX512F.
+
+--*/
+
+#include "sqnbitgemm.h"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+//
+// Hardware-specific kernel type.
+//
+struct MLAS_SQNBIT_GEMM_KERNEL_AVX512 {
+};
+
+namespace
+{
+
+template <typename IterationFn, size_t... Indices>
+MLAS_FORCEINLINE void
+UnrolledLoopIterations(IterationFn&& f, std::index_sequence<Indices...> /* indices */)
+{
+    (f(Indices), ...);
+}
+
+template <size_t N, typename IterationFn>
+MLAS_FORCEINLINE void
+UnrolledLoop(IterationFn&& f)
+{
+    UnrolledLoopIterations(std::forward<IterationFn>(f), std::make_index_sequence<N>());
+}
+
+/**
+ * @brief Loads 16 floats, or the first `count` of them followed by zeros.
+ */
+MLAS_FORCEINLINE __m512
+LoadFloat16(const float* src, size_t count)
+{
+    const __mmask16 mask = (count >= 16) ? __mmask16(0xFFFF) : __mmask16((1u << count) - 1);
+    return _mm512_maskz_loadu_ps(mask, src);
+}
+
+/**
+ * @brief Converts the 16 4-bit values of 8 bytes, low nibble first, to a vector of 16 floats.
+ */
+MLAS_FORCEINLINE __m512
+UnpackFloat16(const uint8_t* src)
+{
+    const __m128i low_mask = _mm_set1_epi8(0x0F);
+    const __m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+    const __m128i even = _mm_and_si128(packed, low_mask);
+    const __m128i odd = _mm_and_si128(_mm_srli_epi16(packed, 4), low_mask);
+    return _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_unpacklo_epi8(even, odd)));
+}
+
+template <size_t BlkBitWidth>
+MLAS_FORCEINLINE float
+ZeroPointOfBlk(const uint8_t* QuantBZeroPointColPtr, size_t BlkIdx)
+{
+    static_assert(BlkBitWidth == 4);
+    if (QuantBZeroPointColPtr == nullptr) {
+        return 8.0f;
+    }
+    const uint8_t zp_packed = QuantBZeroPointColPtr[BlkIdx / 2];
+    return static_cast<float>(((BlkIdx & 1) == 1) ? (zp_packed >> 4) : (zp_packed & 0x0F));
+}
+
+template <size_t BlkBitWidth, size_t BlkLen, size_t NCols>
+MLAS_FORCEINLINE void
+ComputeDotProducts(
+    const float* ARowPtr,
+    const uint8_t* QuantBDataColPtr,
+    const float* QuantBScaleColPtr,
+    const uint8_t* QuantBZeroPointColPtr,
+    float* SumPtr,
+    size_t CountK,
+    size_t StrideQuantBData,
+    size_t StrideQuantBScale,
+    size_t StrideQuantBZeroPoint,
+    const float* BiasPtr
+)
+{
+    static_assert(NCols == 1 || NCols == 4, "NCols must be 1 or 4");
+    static_assert(BlkBitWidth == 4);
+
+    constexpr size_t SubBlkLen = 16;  // number of block elements to process in one iteration
+    static_assert(BlkLen % SubBlkLen == 0);
+
+    __m512 acc[NCols];
+    UnrolledLoop<NCols>([&](size_t i) { acc[i] = _mm512_setzero_ps(); });
+
+    const uint8_t* QuantBData = QuantBDataColPtr;
+
+    for (size_t k = 0, blk = 0; k < CountK; k += BlkLen, blk += 1) {
+        const size_t k_blk_len = std::min(CountK - k, BlkLen);
+
+        __m512 zp[NCols];
+        UnrolledLoop<NCols>([&](size_t i) {
+            const uint8_t* zp_col = (QuantBZeroPointColPtr == nullptr)
+                                        ? nullptr
+                                        : QuantBZeroPointColPtr + i * StrideQuantBZeroPoint;
+            zp[i] = _mm512_set1_ps(ZeroPointOfBlk<BlkBitWidth>(zp_col, blk));
+        });
+
+        // sum of a * (b - zp) over the block, the scale is applied once per block
+        __m512 blk_acc[NCols];
+        UnrolledLoop<NCols>([&](size_t i) { blk_acc[i] = _mm512_setzero_ps(); });
+
+        for (size_t k_idx_in_blk = 0; k_idx_in_blk < k_blk_len; k_idx_in_blk += SubBlkLen) {
+            // load `SubBlkLen` elements from A, padded with 0's if there aren't enough
+            const size_t k_subblk_len = std::min(k_blk_len - k_idx_in_blk, SubBlkLen);
+            const __m512 av = LoadFloat16(ARowPtr + k + k_idx_in_blk, k_subblk_len);
+
+            UnrolledLoop<NCols>([&](size_t i) {
+                const size_t b_data_block_offset = k_idx_in_blk * BlkBitWidth / 8;
+                const __m512 bv = _mm512_sub_ps(UnpackFloat16(QuantBData + i * StrideQuantBData + b_data_block_offset), zp[i]);
+                blk_acc[i] = _mm512_fmadd_ps(av, bv, blk_acc[i]);
+            });
+        }
+
+        UnrolledLoop<NCols>([&](size_t i) {
+            const __m512 scale = _mm512_set1_ps(QuantBScaleColPtr[i * StrideQuantBScale + blk]);
+            acc[i] = _mm512_fmadd_ps(blk_acc[i], scale, acc[i]);
+        });
+
+        // increment pointer to next block
+        QuantBData += MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    }
+
+    for (size_t i = 0; i < NCols; ++i) {
+        SumPtr[i] = _mm512_reduce_add_ps(acc[i]);
+        if (BiasPtr != nullptr) {
+            SumPtr[i] += BiasPtr[i];
+        }
+    }
+}
+
+}  // namespace
+
+//
+// MlasSQNBitGemmKernel and helpers.
+//
+
+template <size_t BlkBitWidth, size_t BlkLen>
+MLAS_FORCEINLINE void
+MlasSQNBitGemmM1KernelAvx512(
+    const float* A,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockStrideQuantB,
+    const float* Bias
+)
+{
+    constexpr size_t NCols = 4;
+
+    const size_t BlockCountK = BlockStrideQuantB;
+
+    const size_t StrideQuantBData = BlockCountK * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t StrideQuantBScale = BlockCountK;
+    const size_t StrideQuantBZeroPoint = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockCountK);
+
+    const float* BiasPtr = Bias;
+
+    const uint8_t* QuantBDataColPtr = QuantBData;
+    const float* QuantBScaleColPtr = QuantBScale;
+    const uint8_t* QuantBZeroPointColPtr = QuantBZeroPoint;
+
+    float* SumPtr = C;
+
+    int64_t nblk = static_cast<int64_t>(CountN) - NCols;
+
+    while (nblk >= 0) {
+        ComputeDotProducts<BlkBitWidth, BlkLen, NCols>(
+            A, QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, SumPtr, CountK,
+            StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+            BiasPtr
+        );
+
+        // move to next `NCols` columns
+
+        QuantBDataColPtr += NCols * StrideQuantBData;
+        QuantBScaleColPtr += NCols * StrideQuantBScale;
+        if (QuantBZeroPointColPtr != nullptr) {
+            QuantBZeroPointColPtr += NCols * StrideQuantBZeroPoint;
+        }
+
+        BiasPtr += BiasPtr != nullptr ? NCols : 0;
+        SumPtr += NCols;
+
+        nblk -= NCols;
+    }
+
+    // left over columns less than `NCols`?
+    nblk += NCols;
+    for (int64_t n = 0; n < nblk; ++n) {
+        ComputeDotProducts<BlkBitWidth, BlkLen, 1>(
+            A, QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, SumPtr, CountK,
+            StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+            BiasPtr
+        );
+
+        // move to next column
+
+        QuantBDataColPtr += StrideQuantBData;
+        QuantBScaleColPtr += StrideQuantBScale;
+        if (QuantBZeroPointColPtr != nullptr) {
+            QuantBZeroPointColPtr += StrideQuantBZeroPoint;
+        }
+
+        BiasPtr += BiasPtr != nullptr ? 1 : 0;
+        SumPtr += 1;
+    }
+}
+
+#define SPECIALIZE_SQNBIT_GEMM_M1_KERNEL(BlkBitWidth, BlkLen)                  \
+    template <>                                                                \
+    MLAS_FORCEINLINE void                                                      \
+    MlasSQNBitGemmM1Kernel<BlkBitWidth, BlkLen, MLAS_SQNBIT_GEMM_KERNEL_AVX512>( \
+        const float* A,                                                        \
+        const uint8_t* QuantBData,                                             \
+        const float* QuantBScale,                                              \
+        const uint8_t* QuantBZeroPoint,                                        \
+        float* C,                                                              \
+        size_t CountN,                                                         \
+        size_t CountK,                                                         \
+        size_t BlockStrideQuantB,                                              \
+        const float* Bias                                                      \
+    )                                                                          \
+    {                                                                          \
+        return MlasSQNBitGemmM1KernelAvx512<BlkBitWidth, BlkLen>(                \
+            A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK,    \
+            BlockStrideQuantB, Bias                                            \
+        );                                                                     \
+    }
+
+SPECIALIZE_SQNBIT_GEMM_M1_KERNEL(4, 16)
+SPECIALIZE_SQNBIT_GEMM_M1_KERNEL(4, 32)
+SPECIALIZE_SQNBIT_GEMM_M1_KERNEL(4, 64)
+SPECIALIZE_SQNBIT_GEMM_M1_KERNEL(4, 128)
+SPECIALIZE_SQNBIT_GEMM_M1_KERNEL(4, 256)
+
+#undef SPECIALIZE_SQNBIT_GEMM_M1_KERNEL
+
+//
+// MlasQNBitBlkDequantBForSgemm and helpers.
+//
+
+template <size_t BlkBitWidth, size_t BlkLen>
+MLAS_FORCEINLINE void
+MlasQNBitBlkDequantBForSgemmAvx512(
+    float* FpData,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockStrideQuantB
+)
+{
+    static_assert(BlkBitWidth == 4);
+
+    // the Sgemm kernel reads B in panels of 16 columns, each row of a panel is contiguous
+    constexpr size_t PanelWidth = 16;
+
+    float* Dst = FpData;
+
+    const uint8_t* QuantBDataCol = QuantBData;
+    const float* QuantBScaleCol = QuantBScale;
+    const uint8_t* QuantBZeroPointCol = QuantBZeroPoint;
+
+    for (size_t n = 0; n < CountN; n += PanelWidth) {
+        const size_t nnlen = std::min(CountN - n, PanelWidth);
+
+        for (size_t nn = 0; nn < nnlen; ++nn) {
+            for (size_t k = 0, k_blk_idx = 0; k < CountK; k += BlkLen, k_blk_idx += 1) {
+                const size_t kklen = std::min(CountK - k, BlkLen);
+
+                const uint8_t* b_data = QuantBDataCol + k_blk_idx * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+                const __m512 scale = _mm512_set1_ps(QuantBScaleCol[k_blk_idx]);
+                const __m512 zp = _mm512_set1_ps(ZeroPointOfBlk<BlkBitWidth>(QuantBZeroPointCol, k_blk_idx));
+
+                for (size_t kk = 0; kk < kklen; kk += 16) {
+                    // dequantize 16 values of the column, then scatter them to the rows of the panel
+                    alignas(64) float values[16];
+                    _mm512_store_ps(values, _mm512_mul_ps(_mm512_sub_ps(UnpackFloat16(b_data + kk / 2), zp), scale));
+
+                    const size_t len = std::min(kklen - kk, size_t{16});
+                    float* dst = Dst + (k + kk) * PanelWidth + nn;
+                    for (size_t i = 0; i < len; ++i) {
+                        dst[i * PanelWidth] = values[i];
+                    }
+                }
+            }
+
+            QuantBDataCol += BlockStrideQuantB * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+            QuantBScaleCol += BlockStrideQuantB;
+            if (QuantBZeroPointCol != nullptr) {
+                QuantBZeroPointCol += MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockStrideQuantB);
+            }
+        }
+
+        // zero out any remaining columns
+
+        if (nnlen < PanelWidth) {
+            for (size_t k = 0; k < CountK; ++k) {
+                std::fill_n(Dst + (k * PanelWidth) + nnlen, PanelWidth - nnlen, 0.0f);
+            }
+        }
+
+        Dst += CountK * PanelWidth;
+    }
+}
+
+#define SPECIALIZE_QNBIT_BLK_DEQUANT_B_FOR_SGEMM(BlkBitWidth, BlkLen)                           \
+    template <>                                                                                 \
+    MLAS_FORCEINLINE void                                                                       \
+    MlasQNBitBlkDequantBForSgemm<BlkBitWidth, BlkLen, MLAS_SQNBIT_GEMM_KERNEL_AVX512>(            \
+        float* FpData,                                                                          \
+        const uint8_t* QuantBData,                                                              \
+        const float* QuantBScale,                                                               \
+        const uint8_t* QuantBZeroPoint,                                                         \
+        size_t CountN,                                                                          \
+        size_t CountK,                                                                          \
+        size_t BlockStrideQuantB                                                                \
+    )                                                                                           \
+    {                                                                                           \
+        MlasQNBitBlkDequantBForSgemmAvx512<BlkBitWidth, BlkLen>(                                  \
+            FpData, QuantBData, QuantBScale, QuantBZeroPoint, CountN, CountK, BlockStrideQuantB \
+        );                                                                                      \
+    }
+
+SPECIALIZE_QNBIT_BLK_DEQUANT_B_FOR_SGEMM(4, 16)
+SPECIALIZE_QNBIT_BLK_DEQUANT_B_FOR_SGEMM(4, 32)
+SPECIALIZE_QNBIT_BLK_DEQUANT_B_FOR_SGEMM(4, 64)
+SPECIALIZE_QNBIT_BLK_DEQUANT_B_FOR_SGEMM(4, 128)
+SPECIALIZE_QNBIT_BLK_DEQUANT_B_FOR_SGEMM(4, 256)
+
+#undef SPECIALIZE_QNBIT_BLK_DEQUANT_B_FOR_SGEMM
+
+//
+// Kernel dispatch structure definition.
+//
+
+const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvx512 = []() {
+    MLAS_SQNBIT_GEMM_DISPATCH d;
+    d.Operations[QuantVariant_BitWidth4_BlockSize16] = MlasSQNBitGemmOperation<4, 16, MLAS_SQNBIT_GEMM_KERNEL_AVX512>;
+    d.Operations[QuantVariant_BitWidth4_BlockSize32] = MlasSQNBitGemmOperation<4, 32, MLAS_SQNBIT_GEMM_KERNEL_AVX512>;
+    d.Operations[QuantVariant_BitWidth4_BlockSize64] = MlasSQNBitGemmOperation<4, 64, MLAS_SQNBIT_GEMM_KERNEL_AVX512>;
+    d.Operations[QuantVariant_BitWidth4_BlockSize128] = MlasSQNBitGemmOperation<4, 128, MLAS_SQNBIT_GEMM_KERNEL_AVX512>;
+    d.Operations[QuantVariant_BitWidth4_BlockSize256] = MlasSQNBitGemmOperation<4, 256, MLAS_SQNBIT_GEMM_KERNEL_AVX512>;
+    return d;
+}();
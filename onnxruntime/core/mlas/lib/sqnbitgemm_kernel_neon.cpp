@@ -474,6 +474,301 @@ SPECIALIZE_QNBIT_BLK_DEQUANT_B_FOR_SGEMM(4, 256)
 
 #undef SPECIALIZE_QNBIT_BLK_DEQUANT_B_FOR_SGEMM
 
+//
+// MlasQNBitQuantizeARowCompInt8 and helpers.
+//
+
+template <size_t BlkLen>
+MLAS_FORCEINLINE void
+MlasQNBitQuantizeARowCompInt8Neon(
+    const float* A,
+    size_t CountK,
+    uint8_t* QuantA
+)
+{
+    static_assert(BlkLen % 16 == 0, "BlkLen must be divisible by 16.");
+
+    uint8_t* QuantABlkPtr = QuantA;
+
+    for (size_t k = 0; k < CountK; k += BlkLen) {
+        const size_t k_blk_len = std::min(CountK - k, BlkLen);
+
+        // the values past CountK are loaded as 0's
+        float32x4_t av[BlkLen / 4]{};
+        LoadData<BlkLen>(A + k, k_blk_len, av);
+
+        // the scale maps the largest magnitude in the block to 127
+        float32x4_t amax_v = vabsq_f32(av[0]);
+        for (size_t i = 1; i < BlkLen / 4; ++i) {
+            amax_v = vmaxq_f32(amax_v, vabsq_f32(av[i]));
+        }
+        const float amax = vmaxvq_f32(amax_v);
+        const float scale_reciprocal = (amax != 0.0f) ? 127.0f / amax : 0.0f;
+
+        MlasQ8BlkScale(QuantABlkPtr) = amax / 127.0f;
+        int8_t* QuantABlkData = MlasQ8BlkData(QuantABlkPtr);
+
+        for (size_t i = 0; i < BlkLen / 4; i += 4) {
+            int32x4_t qv[4];
+            UnrolledLoop<4>([&](size_t j) { qv[j] = vcvtnq_s32_f32(vmulq_n_f32(av[i + j], scale_reciprocal)); });
+
+            const int16x8_t qv_s16_0 = vcombine_s16(vqmovn_s32(qv[0]), vqmovn_s32(qv[1]));
+            const int16x8_t qv_s16_1 = vcombine_s16(vqmovn_s32(qv[2]), vqmovn_s32(qv[3]));
+            vst1q_s8(QuantABlkData + i * 4, vcombine_s8(vqmovn_s16(qv_s16_0), vqmovn_s16(qv_s16_1)));
+        }
+
+        QuantABlkPtr += MlasQ8BlkSize(BlkLen);
+    }
+}
+
+#define SPECIALIZE_QNBIT_QUANTIZE_A_ROW_COMP_INT8(BlkLen)                         \
+    template <>                                                                   \
+    MLAS_FORCEINLINE void                                                         \
+    MlasQNBitQuantizeARowCompInt8<BlkLen, MLAS_SQNBIT_GEMM_KERNEL_NEON>(          \
+        const float* A,                                                           \
+        size_t CountK,                                                            \
+        uint8_t* QuantA                                                           \
+    )                                                                             \
+    {                                                                             \
+        MlasQNBitQuantizeARowCompInt8Neon<BlkLen>(A, CountK, QuantA);             \
+    }
+
+SPECIALIZE_QNBIT_QUANTIZE_A_ROW_COMP_INT8(16)
+SPECIALIZE_QNBIT_QUANTIZE_A_ROW_COMP_INT8(32)
+SPECIALIZE_QNBIT_QUANTIZE_A_ROW_COMP_INT8(64)
+SPECIALIZE_QNBIT_QUANTIZE_A_ROW_COMP_INT8(128)
+SPECIALIZE_QNBIT_QUANTIZE_A_ROW_COMP_INT8(256)
+
+#undef SPECIALIZE_QNBIT_QUANTIZE_A_ROW_COMP_INT8
+
+//
+// MlasSQNBitGemmM1KernelCompInt8 and helpers.
+//
+
+namespace
+{
+
+MLAS_FORCEINLINE int32x4_t
+DotProductS8(int32x4_t acc, int8x16_t a, int8x16_t b)
+{
+#if defined(__ARM_FEATURE_DOTPROD)
+    return vdotq_s32(acc, a, b);
+#else
+    // The products of the int8 values of A with the 4-bit values of B fit in 16 bits. Only the sum of the lanes of
+    // the accumulator is used, so which products each lane adds up doesn't matter.
+    const int16x8_t p0 = vmull_s8(vget_low_s8(a), vget_low_s8(b));
+    const int16x8_t p1 = vmull_high_s8(a, b);
+    return vpadalq_s16(vpadalq_s16(acc, p0), p1);
+#endif
+}
+
+template <size_t BlkBitWidth, size_t BlkLen, size_t NCols>
+MLAS_FORCEINLINE void
+ComputeDotProductsCompInt8(
+    const uint8_t* QuantARowPtr,
+    const uint8_t* QuantBDataColPtr,
+    const float* QuantBScaleColPtr,
+    const uint8_t* QuantBZeroPointColPtr,
+    float* SumPtr,
+    size_t CountK,
+    size_t StrideQuantBData,
+    size_t StrideQuantBScale,
+    size_t StrideQuantBZeroPoint,
+    const float* BiasPtr
+)
+{
+    static_assert(NCols == 1 || NCols == 4, "NCols must be 1 or 4");
+    static_assert(BlkBitWidth == 4, "Only 4-bit B values are supported.");
+
+    const uint8x8_t LowMask = vdup_n_u8(0x0F);
+
+    float32x4_t acc[NCols]{};
+
+    const uint8_t* QuantABlkPtr = QuantARowPtr;
+    const uint8_t* QuantBData = QuantBDataColPtr;
+    const float* QuantBScale = QuantBScaleColPtr;
+    size_t QuantBZeroPointIdx = 0;  // track half byte increments with this index instead of a pointer
+
+    for (size_t k = 0; k < CountK; k += BlkLen) {
+        // the values of A past CountK are 0's, so the whole block is multiplied
+        const int8_t* QuantABlkData = MlasQ8BlkData(QuantABlkPtr);
+
+        float scale[NCols];
+        UnrolledLoop<NCols>([&](size_t i) {
+            scale[i] = MlasQ8BlkScale(QuantABlkPtr) * QuantBScale[i * StrideQuantBScale];
+        });
+
+        int8x16_t zp_v[NCols];
+        if (QuantBZeroPointColPtr != nullptr) {
+            UnrolledLoop<NCols>([&](size_t i) {
+                const uint8_t zp_packed =
+                    QuantBZeroPointColPtr[i * StrideQuantBZeroPoint + QuantBZeroPointIdx / 2];
+                const uint8_t zp = ((QuantBZeroPointIdx & 1) == 1) ? (zp_packed >> 4) : (zp_packed & 0x0F);
+                zp_v[i] = vdupq_n_s8(static_cast<int8_t>(zp));
+            });
+        } else {
+            UnrolledLoop<NCols>([&](size_t i) { zp_v[i] = vdupq_n_s8(8); });
+        }
+
+        int32x4_t iacc[NCols]{};
+
+        constexpr size_t SubBlkLen = 16;  // number of block elements to process in one iteration
+
+        for (size_t k_idx_in_blk = 0; k_idx_in_blk < BlkLen; k_idx_in_blk += SubBlkLen) {
+            const int8x16_t av = vld1q_s8(QuantABlkData + k_idx_in_blk);
+
+            // load B column vectors
+            uint8x8_t bv_packed[NCols];
+            UnrolledLoop<NCols>([&](size_t i) {
+                const size_t b_data_block_offset = k_idx_in_blk * BlkBitWidth / 8;
+                bv_packed[i] = vld1_u8(QuantBData + i * StrideQuantBData + b_data_block_offset);
+            });
+
+            // unpack the 4-bit values to int8 and subtract the zero point
+            int8x16_t bv[NCols];
+            UnrolledLoop<NCols>([&](size_t i) {
+                const uint8x8_t bv_lo = vand_u8(bv_packed[i], LowMask);
+                const uint8x8_t bv_hi = vshr_n_u8(bv_packed[i], 4);
+                const uint8x16_t bv_u8 = vcombine_u8(vzip1_u8(bv_lo, bv_hi), vzip2_u8(bv_lo, bv_hi));
+                bv[i] = vsubq_s8(vreinterpretq_s8_u8(bv_u8), zp_v[i]);
+            });
+
+            UnrolledLoop<NCols>([&](size_t i) { iacc[i] = DotProductS8(iacc[i], av, bv[i]); });
+        }
+
+        UnrolledLoop<NCols>([&](size_t i) { acc[i] = vfmaq_n_f32(acc[i], vcvtq_f32_s32(iacc[i]), scale[i]); });
+
+        // increment pointers to next block
+        QuantABlkPtr += MlasQ8BlkSize(BlkLen);
+        QuantBData += MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+        QuantBScale += 1;
+        QuantBZeroPointIdx += 1;
+    }
+
+    if constexpr (NCols == 4) {
+        float32x4_t sum = FoldAccumulators(acc[0], acc[1], acc[2], acc[3]);
+
+        if (BiasPtr != nullptr) {
+            sum = vaddq_f32(sum, vld1q_f32(BiasPtr));
+        }
+
+        vst1q_f32(SumPtr, sum);
+    } else {
+        for (size_t i = 0; i < NCols; ++i) {
+            SumPtr[i] = vaddvq_f32(acc[i]);
+            if (BiasPtr != nullptr) {
+                SumPtr[i] += BiasPtr[i];
+            }
+        }
+    }
+}
+
+}  // namespace
+
+template <size_t BlkBitWidth, size_t BlkLen>
+MLAS_FORCEINLINE void
+MlasSQNBitGemmM1KernelCompInt8Neon(
+    const uint8_t* QuantA,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockStrideQuantB,
+    const float* Bias
+)
+{
+    constexpr size_t NCols = 4;
+
+    const size_t BlockCountK = BlockStrideQuantB;
+
+    const size_t StrideQuantBData = BlockCountK * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t StrideQuantBScale = BlockCountK;
+    const size_t StrideQuantBZeroPoint = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockCountK);
+
+    const float* BiasPtr = Bias;
+
+    const uint8_t* QuantBDataColPtr = QuantBData;
+    const float* QuantBScaleColPtr = QuantBScale;
+    const uint8_t* QuantBZeroPointColPtr = QuantBZeroPoint;
+
+    float* SumPtr = C;
+
+    int64_t nblk = static_cast<int64_t>(CountN) - NCols;
+
+    while (nblk >= 0) {
+        ComputeDotProductsCompInt8<BlkBitWidth, BlkLen, NCols>(
+            QuantA, QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, SumPtr, CountK,
+            StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+            BiasPtr
+        );
+
+        // move to next `NCols` columns
+
+        QuantBDataColPtr += NCols * StrideQuantBData;
+        QuantBScaleColPtr += NCols * StrideQuantBScale;
+        if (QuantBZeroPointColPtr != nullptr) {
+            QuantBZeroPointColPtr += NCols * StrideQuantBZeroPoint;
+        }
+
+        BiasPtr += BiasPtr != nullptr ? NCols : 0;
+        SumPtr += NCols;
+
+        nblk -= NCols;
+    }
+
+    // left over columns less than `NCols`?
+    nblk += NCols;
+    for (int64_t n = 0; n < nblk; ++n) {
+        ComputeDotProductsCompInt8<BlkBitWidth, BlkLen, 1>(
+            QuantA, QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, SumPtr, CountK,
+            StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+            BiasPtr
+        );
+
+        // move to next column
+
+        QuantBDataColPtr += StrideQuantBData;
+        QuantBScaleColPtr += StrideQuantBScale;
+        if (QuantBZeroPointColPtr != nullptr) {
+            QuantBZeroPointColPtr += StrideQuantBZeroPoint;
+        }
+
+        BiasPtr += BiasPtr != nullptr ? 1 : 0;
+        SumPtr += 1;
+    }
+}
+
+#define SPECIALIZE_SQNBIT_GEMM_M1_KERNEL_COMP_INT8(BlkBitWidth, BlkLen)                \
+    template <>                                                                        \
+    MLAS_FORCEINLINE void                                                              \
+    MlasSQNBitGemmM1KernelCompInt8<BlkBitWidth, BlkLen, MLAS_SQNBIT_GEMM_KERNEL_NEON>( \
+        const uint8_t* QuantA,                                                         \
+        const uint8_t* QuantBData,                                                     \
+        const float* QuantBScale,                                                      \
+        const uint8_t* QuantBZeroPoint,                                                \
+        float* C,                                                                      \
+        size_t CountN,                                                                 \
+        size_t CountK,                                                                 \
+        size_t BlockStrideQuantB,                                                      \
+        const float* Bias                                                              \
+    )                                                                                  \
+    {                                                                                  \
+        return MlasSQNBitGemmM1KernelCompInt8Neon<BlkBitWidth, BlkLen>(                \
+            QuantA, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK,       \
+            BlockStrideQuantB, Bias                                                    \
+        );                                                                             \
+    }
+
+SPECIALIZE_SQNBIT_GEMM_M1_KERNEL_COMP_INT8(4, 16)
+SPECIALIZE_SQNBIT_GEMM_M1_KERNEL_COMP_INT8(4, 32)
+SPECIALIZE_SQNBIT_GEMM_M1_KERNEL_COMP_INT8(4, 64)
+SPECIALIZE_SQNBIT_GEMM_M1_KERNEL_COMP_INT8(4, 128)
+SPECIALIZE_SQNBIT_GEMM_M1_KERNEL_COMP_INT8(4, 256)
+
+#undef SPECIALIZE_SQNBIT_GEMM_M1_KERNEL_COMP_INT8
+
 //
 // Kernel dispatch structure definition.
 //
@@ -485,5 +780,16 @@ const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchNeon = []() {
     d.Operations[QuantVariant_BitWidth4_BlockSize64] = MlasSQNBitGemmOperation<4, 64, MLAS_SQNBIT_GEMM_KERNEL_NEON>;
     d.Operations[QuantVariant_BitWidth4_BlockSize128] = MlasSQNBitGemmOperation<4, 128, MLAS_SQNBIT_GEMM_KERNEL_NEON>;
     d.Operations[QuantVariant_BitWidth4_BlockSize256] = MlasSQNBitGemmOperation<4, 256, MLAS_SQNBIT_GEMM_KERNEL_NEON>;
+
+    d.OperationsCompInt8[QuantVariant_BitWidth4_BlockSize16] =
+        MlasSQNBitGemmOperationCompInt8<4, 16, MLAS_SQNBIT_GEMM_KERNEL_NEON>;
+    d.OperationsCompInt8[QuantVariant_BitWidth4_BlockSize32] =
+        MlasSQNBitGemmOperationCompInt8<4, 32, MLAS_SQNBIT_GEMM_KERNEL_NEON>;
+    d.OperationsCompInt8[QuantVariant_BitWidth4_BlockSize64] =
+        MlasSQNBitGemmOperationCompInt8<4, 64, MLAS_SQNBIT_GEMM_KERNEL_NEON>;
+    d.OperationsCompInt8[QuantVariant_BitWidth4_BlockSize128] =
+        MlasSQNBitGemmOperationCompInt8<4, 128, MLAS_SQNBIT_GEMM_KERNEL_NEON>;
+    d.OperationsCompInt8[QuantVariant_BitWidth4_BlockSize256] =
+        MlasSQNBitGemmOperationCompInt8<4, 256, MLAS_SQNBIT_GEMM_KERNEL_NEON>;
     return d;
 }();
@@ -16,6 +16,11 @@ Abstract:
 
 #include "mlasi.h"
 
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 void
 MlasExecuteThreaded(
     MLAS_THREADED_ROUTINE* ThreadedRoutine,
@@ -130,4 +135,25 @@ MlasTryBatchParallel(
     MLAS_THREADPOOL::TryBatchParallelFor(ThreadPool, Iterations, Work, 0);
 #endif
 
-}
\ No newline at end of file
+}
+size_t
+MlasGetCurrentNumaNode(
+    void
+    )
+{
+#if defined(_WIN32)
+    PROCESSOR_NUMBER ProcessorNumber;
+    USHORT NodeNumber;
+    GetCurrentProcessorNumberEx(&ProcessorNumber);
+    if (GetNumaProcessorNodeEx(&ProcessorNumber, &NodeNumber) && NodeNumber != MAXUSHORT) {
+        return NodeNumber;
+    }
+#elif defined(__linux__) && defined(SYS_getcpu)
+    unsigned Cpu;
+    unsigned Node;
+    if (syscall(SYS_getcpu, &Cpu, &Node, nullptr) == 0) {
+        return Node;
+    }
+#endif
+    return 0;
+}
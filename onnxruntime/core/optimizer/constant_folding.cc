@@ -26,6 +26,57 @@ ConstantFolding::ConstantFolding(const IExecutionProvider& execution_provider,
       execution_provider_(execution_provider) {
 }
 
+// Folding a node whose outputs are much larger than its inputs, e.g. an Expand or a Tile of a small initializer,
+// trades a cheap kernel at run time for a large initializer that is held in memory while the session is loaded,
+// so such a node is left as is once its outputs exceed both kMinOutputSizeToLimit bytes and kMaxOutputSizeRatio
+// times the size of its inputs.
+static constexpr size_t kMinOutputSizeToLimit = 1024 * 1024;
+static constexpr size_t kMaxOutputSizeRatio = 16;
+
+static bool IsOutputTooLarge(size_t inputs_size, size_t outputs_size) {
+  return outputs_size > kMinOutputSizeToLimit && outputs_size / kMaxOutputSizeRatio > inputs_size;
+}
+
+static size_t GetSizeInBytes(const InitializedTensorSet& constant_inputs) {
+  size_t inputs_size = 0;
+  for (const auto& constant_input : constant_inputs) {
+    size_t size = 0;
+    if (utils::GetSizeInBytesFromTensorProto<0>(*constant_input.second, &size).IsOK()) {
+      inputs_size += size;
+    }
+  }
+  return inputs_size;
+}
+
+// Computes the size of the outputs of the node from their inferred shapes.
+// Returns false if the shape or the element type of an output is unknown.
+static bool GetInferredOutputsSizeInBytes(const Node& node, size_t& outputs_size) {
+  outputs_size = 0;
+  for (const auto* output_def : node.OutputDefs()) {
+    const auto* type = output_def->TypeAsProto();
+    const auto* shape = output_def->Shape();
+    if (type == nullptr || !utils::HasTensorType(*type) || shape == nullptr) {
+      return false;
+    }
+
+    ONNX_NAMESPACE::TensorProto output_proto;
+    output_proto.set_data_type(type->tensor_type().elem_type());
+    for (const auto& dim : shape->dim()) {
+      if (!utils::HasDimValue(dim)) {
+        return false;
+      }
+      output_proto.add_dims(dim.dim_value());
+    }
+
+    size_t size = 0;
+    if (!utils::GetSizeInBytesFromTensorProto<0>(output_proto, &size).IsOK()) {
+      return false;
+    }
+    outputs_size += size;
+  }
+  return true;
+}
+
 // We need to handle a Shape node separately as the input doesn't need to be a constant initializer for
 // Shape to be able to be constant folded.
 static bool ConstantFoldShapeNode(Graph& graph, Node& node) {
@@ -135,6 +186,10 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
   GraphViewer graph_viewer(graph);
   auto& order = graph_viewer.GetNodesInTopologicalOrder();
 
+  // the number of nodes yet to be folded or run that read each value folded by this pass. the value is removed from
+  // the initializers once they are all folded, instead of being held until the graph is resolved.
+  InlinedHashMap<std::string, size_t> folded_value_ref_counts;
+
 #if !defined(DISABLE_SPARSE_TENSORS)
   std::function<bool(const std::string&)> is_sparse_initializer_check = [&graph](const std::string& name) -> bool {
     return graph.IsSparseInitializer(name);
@@ -223,6 +278,16 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
         }
       }
 
+      const size_t inputs_size = GetSizeInBytes(constant_inputs);
+      size_t inferred_outputs_size = 0;
+      if (GetInferredOutputsSizeInBytes(*node, inferred_outputs_size) &&
+          IsOutputTooLarge(inputs_size, inferred_outputs_size)) {
+        LOGS(logger, INFO) << "Skipping constant folding of " << node->OpType() << " node '" << node->Name()
+                           << "' as its outputs of " << inferred_outputs_size
+                           << " bytes are much larger than its inputs";
+        continue;
+      }
+
 #if !defined(DISABLE_SPARSE_TENSORS)
       // Create execution frame for executing constant nodes.
       OptimizerExecutionFrame::Info info({node}, constant_inputs, graph.ModelPath(), execution_provider_,
@@ -289,6 +354,7 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
       // added to the graph as initializers.
       ORT_ENFORCE(fetches.size() == node->OutputDefs().size());
       converted_to_constant = true;
+      size_t outputs_size = 0;
       for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
         const auto& constant_arg_out = *node->OutputDefs()[fetch_idx];
         // XXX: Add support for SparseTensors outputs when we have sparse outputs
@@ -298,6 +364,13 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
           converted_to_constant = false;
           break;
         }
+        outputs_size += fetches[fetch_idx].Get<Tensor>().SizeInBytes();
+      }
+
+      if (converted_to_constant && IsOutputTooLarge(inputs_size, outputs_size)) {
+        LOGS(logger, INFO) << "Skipping constant folding of " << node->OpType() << " node '" << node->Name()
+                           << "' as its outputs of " << outputs_size << " bytes are much larger than its inputs";
+        converted_to_constant = false;
       }
 
       if (converted_to_constant) {
@@ -320,6 +393,22 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
     }
 
     if (converted_to_constant) {
+      for (const auto* input_def : node->InputDefs()) {
+        auto ref_count = folded_value_ref_counts.find(input_def->Name());
+        if (ref_count != folded_value_ref_counts.end() && --ref_count->second == 0) {
+          graph.RemoveInitializedTensor(ref_count->first);
+          folded_value_ref_counts.erase(ref_count);
+        }
+      }
+
+      const auto& output_defs = node->OutputDefs();
+      for (auto it = node->OutputEdgesBegin(), end = node->OutputEdgesEnd(); it != end; ++it) {
+        const auto* output_def = output_defs[it->GetSrcArgIndex()];
+        if (!graph.IsOutput(output_def)) {
+          ++folded_value_ref_counts[output_def->Name()];
+        }
+      }
+
       // Remove single-output node chain for inputs of the node
       auto p_ip_node = node->InputNodesBegin();
       const auto p_ip_node_end = node->InputNodesEnd();
@@ -45,13 +45,14 @@ bool HasElementDataType(const NodeArg& node_arg, int32_t data_type) {
 }
 
 bool ConvFusionDataTypeCheck(const Node& conv_node) {
-  // TODO(hasesh): The CPU and CUDA EP only support float type for the Conv+Activation
-  // and the Conv+Add+Relu fusions.
+  // TODO(hasesh): The CPU EP only supports float type for the Conv+Activation fusion, and the CUDA EP float and
+  // float16 for the Conv+Activation and the Conv+Add+Activation fusions.
   // Assess the support level for the other compatible EPs and if they also
   // only support float, remove the EP check altogether.
   const std::string_view node_ep = conv_node.GetExecutionProviderType();
   if (node_ep == kCudaExecutionProvider) {
-    if (!HasElementDataType(*conv_node.InputDefs()[0], ONNX_NAMESPACE::TensorProto_DataType_FLOAT)) {
+    if (!HasElementDataType(*conv_node.InputDefs()[0], ONNX_NAMESPACE::TensorProto_DataType_FLOAT) &&
+        !HasElementDataType(*conv_node.InputDefs()[0], ONNX_NAMESPACE::TensorProto_DataType_FLOAT16)) {
       return false;
     }
   }
@@ -71,6 +72,49 @@ bool ConvFusionDataTypeCheck(const Node& conv_node) {
   return true;
 }
 
+// The activations that FusedConv supports on all of the EPs but ROCm.
+bool IsSupportedActivation(const GraphViewer& graph_viewer, const Node& activation_node) {
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "Relu", {6, 13, 14}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "Sigmoid", {6, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "Tanh", {6, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "LeakyRelu", {6, 16})) {
+    return true;
+  }
+
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "Clip", {6, 11, 12, 13})) {
+    float min, max;
+    if (!optimizer_utils::GetClipConstantMinMax(graph_viewer.GetGraph(), activation_node, min, max)) {
+      return false;
+    }
+    return true;
+  }
+
+  return false;
+}
+
+// Whether both values have the same known shape, so the one is a Z of FusedConv for the other.
+bool HasSameShape(const NodeArg& a, const NodeArg& b) {
+  const auto* a_shape = a.Shape();
+  const auto* b_shape = b.Shape();
+  if (a_shape == nullptr || b_shape == nullptr || a_shape->dim_size() != b_shape->dim_size()) {
+    return false;
+  }
+
+  for (int i = 0; i < a_shape->dim_size(); ++i) {
+    const auto& a_dim = a_shape->dim(i);
+    const auto& b_dim = b_shape->dim(i);
+    if (utils::HasDimValue(a_dim) && utils::HasDimValue(b_dim)) {
+      if (a_dim.dim_value() != b_dim.dim_value()) {
+        return false;
+      }
+    } else if (!utils::HasDimParam(a_dim) || !utils::HasDimParam(b_dim) || a_dim.dim_param() != b_dim.dim_param()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 class ConvActivationSelector : public NodeSelector {
  public:
   ConvActivationSelector() = default;
@@ -83,41 +127,22 @@ class ConvActivationSelector : public NodeSelector {
       return std::nullopt;
     }
 
-    auto is_supported_non_cuda_rocm_ep_activation = [&graph_viewer](const Node& activation_node) {
-      if (graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "Relu", {6, 13, 14}) ||
-          graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "Sigmoid", {6, 13}) ||
-          graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "Tanh", {6, 13}) ||
-          graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "LeakyRelu", {6, 16})) {
-        return true;
-      }
-
-      if (graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "Clip", {6, 11, 12, 13})) {
-        float min, max;
-        if (!optimizer_utils::GetClipConstantMinMax(graph_viewer.GetGraph(), activation_node, min, max)) {
-          return false;
-        }
-        return true;
-      }
-
-      return false;
-    };
-
     if (!ConvFusionDataTypeCheck(node)) {
       return std::nullopt;
     }
 
     // check EP type and activation
-    if (node_ep == kCudaExecutionProvider || node_ep == kRocmExecutionProvider) {
+    if (node_ep == kRocmExecutionProvider) {
       if (!graph_utils::IsSupportedOptypeVersionAndDomain(*next_node, "Relu", {6, 13, 14})) {
         return std::nullopt;
       }
     } else if (node_ep.empty() || node_ep == kCpuExecutionProvider) {
-      if (!is_supported_non_cuda_rocm_ep_activation(*next_node) &&
+      if (!IsSupportedActivation(graph_viewer, *next_node) &&
           !graph_utils::IsSupportedOptypeVersionAndDomain(*next_node, "HardSigmoid", {6})) {
         return std::nullopt;
       }
     } else {
-      if (!is_supported_non_cuda_rocm_ep_activation(*next_node)) {
+      if (!IsSupportedActivation(graph_viewer, *next_node)) {
         return std::nullopt;
       }
     }
@@ -129,9 +154,10 @@ class ConvActivationSelector : public NodeSelector {
   }
 };
 
-class ConvAddRelu : public NodeSelector {
+// Conv->Add->Activation, or Conv->Add for a residual add, where the Add gives Z of FusedConv.
+class ConvAddActivation : public NodeSelector {
  public:
-  ConvAddRelu() = default;
+  ConvAddActivation() = default;
 
   std::optional<NodesToOptimizeIndices> Select(const GraphViewer& graph_viewer, const Node& node) const override {
     const std::string_view node_ep = node.GetExecutionProviderType();
@@ -144,6 +170,12 @@ class ConvAddRelu : public NodeSelector {
       return std::nullopt;
     }
 
+    // Z is appended after the bias.
+    const auto& conv_inputs = node.InputDefs();
+    if (conv_inputs.size() != 3 || !conv_inputs[2]->Exists()) {
+      return std::nullopt;
+    }
+
     const auto* add_node = GetLoneConsumerNode(graph_viewer, node);
     if (!add_node ||
         !graph_utils::IsSupportedOptypeVersionAndDomain(*add_node, "Add", {6, 7, 13, 14}) ||
@@ -151,17 +183,22 @@ class ConvAddRelu : public NodeSelector {
       return std::nullopt;
     }
 
-    const auto* relu_node = GetLoneConsumerNode(graph_viewer, *add_node);
-    if (!relu_node ||
-        !graph_utils::IsSupportedOptypeVersionAndDomain(*relu_node, "Relu", {6, 13, 14}) ||
-        relu_node->GetExecutionProviderType() != node_ep) {
+    const auto& add_inputs = add_node->InputDefs();
+    if (!HasSameShape(*add_inputs[0], *add_inputs[1])) {
       return std::nullopt;
     }
 
     NodesToOptimizeIndicesBuilder builder{};
     builder.target_node = node.Index();
-    builder.output_nodes = {add_node->Index(),
-                            relu_node->Index()};
+    builder.output_nodes = {add_node->Index()};
+
+    const auto* activation_node = GetLoneConsumerNode(graph_viewer, *add_node);
+    if (activation_node &&
+        activation_node->GetExecutionProviderType() == node_ep &&
+        IsSupportedActivation(graph_viewer, *activation_node)) {
+      builder.output_nodes.push_back(activation_node->Index());
+    }
+
     return builder.Build();
   }
 };
@@ -172,6 +209,38 @@ class ConvAddRelu : public NodeSelector {
 namespace actions {
 using NTO = NodesToOptimize;
 
+NodeAttributes ActivationAttributes(const Graph& graph, const Node& activation) {
+  NodeAttributes extra_fused_conv_attributes;
+
+  const auto& activation_op_type = activation.OpType();
+  utils::SetNodeAttribute(utils::MakeAttribute("activation", activation_op_type), extra_fused_conv_attributes);
+
+  InlinedVector<float> activation_params;
+  if (activation_op_type == "LeakyRelu") {
+    activation_params.push_back(graph_utils::GetNodeAttribute(activation, "alpha")->f());
+  } else if (activation_op_type == "Clip") {
+    float min, max;
+    ORT_ENFORCE(optimizer_utils::GetClipConstantMinMax(graph, activation, min, max),
+                "Failed to get Clip min/max constants.");
+    activation_params.push_back(min);
+    activation_params.push_back(max);
+  } else if (activation_op_type == "HardSigmoid") {
+    auto* alpha_attr = graph_utils::GetNodeAttribute(activation, "alpha");
+    auto* beta_attr = graph_utils::GetNodeAttribute(activation, "beta");
+    float alpha = (alpha_attr == nullptr ? 0.2f : alpha_attr->f());
+    float beta = (beta_attr == nullptr ? 0.5f : beta_attr->f());
+    activation_params.push_back(alpha);
+    activation_params.push_back(beta);
+  }
+
+  if (!activation_params.empty()) {
+    utils::SetNodeAttribute(utils::MakeAttribute("activation_params", activation_params),
+                            extra_fused_conv_attributes);
+  }
+
+  return extra_fused_conv_attributes;
+}
+
 class FuseConvActivationAction : public ReplaceWithNew {
  private:
   std::string OpType(const RuntimeState& runtime_state) const override {
@@ -199,38 +268,9 @@ class FuseConvActivationAction : public ReplaceWithNew {
   }
 
   NodeAttributes ExtraAttributes(const RuntimeState& state) const override {
-    NodeAttributes extra_fused_conv_attributes;
-
     const auto* activation = state.selected_nodes.Output(0);
     ORT_ENFORCE(activation != nullptr, "Expected activation node.");
-
-    const auto& activation_op_type = activation->OpType();
-    utils::SetNodeAttribute(utils::MakeAttribute("activation", activation_op_type), extra_fused_conv_attributes);
-
-    InlinedVector<float> activation_params;
-    if (activation_op_type == "LeakyRelu") {
-      activation_params.push_back(graph_utils::GetNodeAttribute(*activation, "alpha")->f());
-    } else if (activation_op_type == "Clip") {
-      float min, max;
-      ORT_ENFORCE(optimizer_utils::GetClipConstantMinMax(state.graph, *activation, min, max),
-                  "Failed to get Clip min/max constants.");
-      activation_params.push_back(min);
-      activation_params.push_back(max);
-    } else if (activation_op_type == "HardSigmoid") {
-      auto* alpha_attr = graph_utils::GetNodeAttribute(*activation, "alpha");
-      auto* beta_attr = graph_utils::GetNodeAttribute(*activation, "beta");
-      float alpha = (alpha_attr == nullptr ? 0.2f : alpha_attr->f());
-      float beta = (beta_attr == nullptr ? 0.5f : beta_attr->f());
-      activation_params.push_back(alpha);
-      activation_params.push_back(beta);
-    }
-
-    if (!activation_params.empty()) {
-      utils::SetNodeAttribute(utils::MakeAttribute("activation_params", activation_params),
-                              extra_fused_conv_attributes);
-    }
-
-    return extra_fused_conv_attributes;
+    return ActivationAttributes(state.graph, *activation);
   }
 
   std::vector<NodeAndMoveInfo> ValueMoves(const RuntimeState&) const override {
@@ -244,16 +284,23 @@ class FuseConvActivationAction : public ReplaceWithNew {
   }
 };
 
-class FuseConvAddRelu : public ReplaceWithNew {
+class FuseConvAddActivation : public ReplaceWithNew {
  private:
-  std::string OpType(const RuntimeState&) const override { return "FusedConv"; }
+  std::string OpType(const RuntimeState& runtime_state) const override {
+    return runtime_state.selected_nodes.Target().OpType() == "NhwcConv" ? "NhwcFusedConv" : "FusedConv";
+  }
 
   std::string Domain(const RuntimeState&) const override { return kMSDomain; }
 
-  NodeAttributes ExtraAttributes(const RuntimeState&) const override {
-    NodeAttributes extra_fused_conv_attributes;
-    utils::SetNodeAttribute(utils::MakeAttribute("activation", "Relu"), extra_fused_conv_attributes);
-    return extra_fused_conv_attributes;
+  NodeAttributes ExtraAttributes(const RuntimeState& state) const override {
+    // Conv->Add has no activation.
+    if (state.selected_nodes.num_outputs == 1) {
+      return {};
+    }
+
+    const auto* activation = state.selected_nodes.Output(1);
+    ORT_ENFORCE(activation != nullptr, "Expected activation node.");
+    return ActivationAttributes(state.graph, *activation);
   }
 
   std::vector<NodeAndMoveInfo> ValueMoves(const RuntimeState& state) const override {
@@ -265,12 +312,12 @@ class FuseConvAddRelu : public ReplaceWithNew {
 
     const auto conv_location = NTO::NodeLocation{NTO::NodeType::kTarget, 0};
     const auto add_location = NTO::NodeLocation{NTO::NodeType::kOutput, 0};
-    const auto relu_location = NTO::NodeLocation{NTO::NodeType::kOutput, 1};
+    const auto last_location = NTO::NodeLocation{NTO::NodeType::kOutput, state.selected_nodes.num_outputs - 1};
 
     return {
         MoveAll(conv_location, ArgType::kInput),                                       // move all inputs from conv
         MoveAndAppend(add_location, ArgType::kInput, add_input_idx, ArgType::kInput),  // append add input
-        MoveAll(relu_location, ArgType::kOutput),                                      // move all outputs from relu
+        MoveAll(last_location, ArgType::kOutput),  // move all outputs from the activation, or the add
     };
   }
 };
@@ -291,12 +338,14 @@ void RegisterConvActivationFusionRules(SelectorActionRegistry& registry) {
 #endif
 }
 
-void RegisterConvAddReluFusionRules(SelectorActionRegistry& registry) {
+void RegisterConvAddActivationFusionRules(SelectorActionRegistry& registry) {
+  // keeps the name of the Conv+Add+Relu fusion it extends, which saved runtime optimizations refer to
   const auto name = "ConvAddRelu";
-  auto action = std::make_unique<actions::FuseConvAddRelu>();
+  auto action = std::make_unique<actions::FuseConvAddActivation>();
 #if !defined(ORT_MINIMAL_BUILD)
-  auto selector = std::make_unique<selectors::ConvAddRelu>();
-  registry.RegisterSelectorAndAction(name, {{"Conv", {1, 11}}},
+  const std::string msDomainConv = SelectorActionRegistry::OpVersionsMapKey("NhwcConv", kMSDomain);
+  auto selector = std::make_unique<selectors::ConvAddActivation>();
+  registry.RegisterSelectorAndAction(name, {{"Conv", {1, 11}}, {msDomainConv, {1}}},
                                      std::move(selector), std::move(action));
 #else
   registry.RegisterAction(name, std::move(action));
@@ -306,7 +355,7 @@ void RegisterConvAddReluFusionRules(SelectorActionRegistry& registry) {
 SelectorActionRegistry CreateSelectorActionRegistry() {
   SelectorActionRegistry registry{};
   RegisterConvActivationFusionRules(registry);
-  RegisterConvAddReluFusionRules(registry);
+  RegisterConvAddActivationFusionRules(registry);
   return registry;
 }
 
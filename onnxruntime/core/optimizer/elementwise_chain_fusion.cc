@@ -0,0 +1,278 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_chain_fusion.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Upper bound of the nodes in a chain, which keeps the per-thread scratch buffer of FusedElementwise small.
+constexpr size_t kMaxChainLength = 32;
+
+// Returns true if FusedElementwise can run the op of node.
+bool IsElementwiseOp(const Node& node) {
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13, 14}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14})) {
+    return true;
+  }
+
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Max", {8, 12, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Min", {8, 12, 13})) {
+    return node.InputDefs().size() == 2;
+  }
+
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Neg", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Abs", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Exp", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sqrt", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Reciprocal", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Erf", {9, 13});
+}
+
+bool IsFloatTensor(const NodeArg& arg) {
+  const TypeProto* type = arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == TensorProto_DataType_FLOAT;
+}
+
+bool HasShape(const TensorShapeProto& shape, const TensorShapeProto& expected) {
+  if (shape.dim_size() != expected.dim_size()) {
+    return false;
+  }
+
+  for (int i = 0; i < shape.dim_size(); i++) {
+    if (shape.dim(i) != expected.dim(i)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Returns true if FusedElementwise broadcasts an input of this shape to output_shape, which it does for a single
+// element or for the size of the last dimension.
+bool IsBroadcastShape(const TensorShapeProto& shape, const TensorShapeProto& output_shape) {
+  const int rank = shape.dim_size();
+  if (rank > output_shape.dim_size()) {
+    return false;
+  }
+
+  for (int i = 0; i + 1 < rank; i++) {
+    if (!utils::HasDimValue(shape.dim(i)) || shape.dim(i).dim_value() != 1) {
+      return false;
+    }
+  }
+
+  if (rank == 0) {
+    return true;
+  }
+
+  const auto& last_dim = shape.dim(rank - 1);
+  return utils::HasDimValue(last_dim) &&
+         (last_dim.dim_value() == 1 || last_dim == output_shape.dim(output_shape.dim_size() - 1));
+}
+
+// Returns true if each input of node is either a value of the chain or can be an input of FusedElementwise.
+bool CanTakeInputs(const Node& node, const InlinedHashSet<const NodeArg*>& chain_values,
+                   const TensorShapeProto& output_shape) {
+  for (const NodeArg* input : node.InputDefs()) {
+    if (chain_values.count(input) > 0) {
+      continue;
+    }
+
+    if (!input->Exists() || !IsFloatTensor(*input)) {
+      return false;
+    }
+
+    const TensorShapeProto* shape = input->Shape();
+    if (shape == nullptr || !(HasShape(*shape, output_shape) || IsBroadcastShape(*shape, output_shape))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Returns true if the output of each node but the last is used, and only by nodes of the chain. Then every node is
+// an ancestor of the last one, so no input of the chain can depend on its values.
+bool IsClosed(const Graph& graph, gsl::span<Node* const> nodes, const InlinedHashSet<NodeIndex>& node_indices) {
+  for (size_t i = 0; i + 1 < nodes.size(); i++) {
+    const Node& node = *nodes[i];
+    if (graph.NodeProducesGraphOutput(node) || node.GetOutputEdgesCount() == 0) {
+      return false;
+    }
+
+    for (auto it = node.OutputEdgesBegin(); it != node.OutputEdgesEnd(); ++it) {
+      if (node_indices.count(it->GetNode().Index()) == 0) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+Status ElementwiseChainFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                         const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!IsElementwiseOp(node) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        !IsFloatTensor(*node.OutputDefs()[0])) {
+      continue;
+    }
+
+    const TensorShapeProto* output_shape = node.OutputDefs()[0]->Shape();
+    InlinedHashSet<const NodeArg*> chain_values;
+    if (output_shape == nullptr || !CanTakeInputs(node, chain_values, *output_shape)) {
+      continue;
+    }
+
+    InlinedVector<Node*> nodes{&node};
+    InlinedHashSet<NodeIndex> node_indices{node.Index()};
+    chain_values.insert(node.OutputDefs()[0]);
+
+    // Grow the chain with consumers of its values that have the same output shape and whose other inputs can be
+    // taken by FusedElementwise as well. The nodes are added after all of their inputs, so they are in the order of
+    // the steps of FusedElementwise.
+    bool grown = true;
+    while (grown && nodes.size() < kMaxChainLength) {
+      grown = false;
+      for (size_t i = 0; i < nodes.size() && !grown; i++) {
+        for (auto it = nodes[i]->OutputNodesBegin(); it != nodes[i]->OutputNodesEnd(); ++it) {
+          Node* next = graph.GetNode(it->Index());
+          if (node_indices.count(next->Index()) > 0 ||
+              !IsElementwiseOp(*next) ||
+              next->GetExecutionProviderType() != node.GetExecutionProviderType() ||
+              !IsFloatTensor(*next->OutputDefs()[0]) ||
+              next->OutputDefs()[0]->Shape() == nullptr ||
+              !HasShape(*next->OutputDefs()[0]->Shape(), *output_shape) ||
+              !CanTakeInputs(*next, chain_values, *output_shape)) {
+            continue;
+          }
+
+          nodes.push_back(next);
+          node_indices.insert(next->Index());
+          chain_values.insert(next->OutputDefs()[0]);
+          grown = true;
+          break;
+        }
+      }
+    }
+
+    // Drop nodes from the end until only the last node has outputs used outside of the chain.
+    while (nodes.size() > 1 && !IsClosed(graph, nodes, node_indices)) {
+      node_indices.erase(nodes.back()->Index());
+      chain_values.erase(nodes.back()->OutputDefs()[0]);
+      nodes.pop_back();
+    }
+
+    if (nodes.size() < 2) {
+      continue;
+    }
+
+    // Collect the inputs of the chain. The first one must have the output shape.
+    InlinedVector<NodeArg*> inputs;
+    for (Node* chain_node : nodes) {
+      for (NodeArg* input : chain_node->MutableInputDefs()) {
+        if (chain_values.count(input) == 0 && std::find(inputs.begin(), inputs.end(), input) == inputs.end()) {
+          inputs.push_back(input);
+        }
+      }
+    }
+
+    auto full_input = std::find_if(inputs.begin(), inputs.end(), [output_shape](const NodeArg* input) {
+      return HasShape(*input->Shape(), *output_shape);
+    });
+    if (full_input == inputs.end()) {
+      continue;
+    }
+    std::rotate(inputs.begin(), full_input, full_input + 1);
+
+    InlinedHashMap<const NodeArg*, int64_t> value_indices;
+    for (size_t i = 0; i < inputs.size(); i++) {
+      value_indices[inputs[i]] = static_cast<int64_t>(i);
+    }
+
+    std::vector<std::string> ops;
+    std::vector<int64_t> operands;
+    for (size_t i = 0; i < nodes.size(); i++) {
+      const Node& chain_node = *nodes[i];
+      const auto& input_defs = chain_node.InputDefs();
+      ops.push_back(chain_node.OpType());
+      operands.push_back(value_indices[input_defs[0]]);
+      operands.push_back(input_defs.size() > 1 ? value_indices[input_defs[1]] : -1);
+      value_indices[chain_node.OutputDefs()[0]] = static_cast<int64_t>(inputs.size() + i);
+    }
+
+    Node& last_node = *nodes.back();
+    std::vector<NodeArg*> outputs = last_node.MutableOutputDefs();
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("FusedElementwise"),
+                                     "FusedElementwise",
+                                     "fused element-wise chain",
+                                     inputs,
+                                     outputs,
+                                     nullptr,
+                                     kMSDomain);
+    fused_node.AddAttribute("ops", ops);
+    fused_node.AddAttribute("operands", operands);
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    fused_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    // Move the edges from the producers of the inputs and to the consumers of the output to the fused node.
+    for (Node* chain_node : nodes) {
+      for (auto it = chain_node->InputEdgesBegin(); it != chain_node->InputEdgesEnd(); ++it) {
+        const NodeIndex src_index = it->GetNode().Index();
+        if (node_indices.count(src_index) == 0) {
+          const NodeArg* input = chain_node->InputDefs()[it->GetDstArgIndex()];
+          graph.AddEdge(src_index, fused_node.Index(), it->GetSrcArgIndex(),
+                        static_cast<int>(value_indices[input]));
+        }
+      }
+    }
+
+    for (const auto& output_edge : graph_utils::GraphEdge::GetNodeOutputEdges(last_node)) {
+      graph.AddEdge(fused_node.Index(), output_edge.dst_node, output_edge.src_arg_index, output_edge.dst_arg_index);
+    }
+
+    for (Node* chain_node : nodes) {
+      graph_utils::RemoveNodeOutputEdges(graph, *chain_node);
+      graph.RemoveNode(chain_node->Index());
+    }
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ElementwiseChainFusion
+Fuse connected element-wise nodes, such as Add, Mul, Sigmoid and Tanh, into one FusedElementwise node.
+
+The nodes must have float outputs of the same shape. The inputs from outside the fused nodes must either have that
+shape, a single element, or the size of the last dimension in which case they are broadcast along the other
+dimensions. The outputs of all fused nodes but the last one must only be used by the fused nodes.
+It runs after the fusions that target specific patterns, such as BiasGelu, so that those still apply.
+*/
+class ElementwiseChainFusion : public GraphTransformer {
+ public:
+  ElementwiseChainFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ElementwiseChainFusion", compatible_execution_providers) {
+  }
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
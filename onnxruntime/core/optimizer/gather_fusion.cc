@@ -335,4 +335,85 @@ Status GatherToSliceFusion::ApplyImpl(Graph& graph, bool& modified, int graph_le
   return Status::OK();
 }
 
+Status EmbeddingBagFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                     const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (p_node == nullptr) continue;  // we removed the node as part of an earlier fusion
+    Node& gather_node = *p_node;
+
+    ORT_RETURN_IF_ERROR(Recurse(gather_node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(gather_node, "Gather", {1, 11, 13}) ||
+        !graph_utils::IsSupportedProvider(gather_node, GetCompatibleExecutionProviders()) ||
+        gather_node.GetOutputEdgesCount() != 1 || graph.NodeProducesGraphOutput(gather_node)) {
+      continue;
+    }
+
+    // The kernel gathers float rows of a 2D table.
+    const NodeArg& table_arg = *gather_node.InputDefs()[0];
+    const NodeArg& indices_arg = *gather_node.InputDefs()[1];
+    const auto* table_shape = table_arg.Shape();
+    const auto* indices_shape = indices_arg.Shape();
+    if (table_arg.TypeAsProto() == nullptr ||
+        table_arg.TypeAsProto()->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT ||
+        table_shape == nullptr || table_shape->dim_size() != 2 || indices_shape == nullptr ||
+        indices_shape->dim_size() < 1) {
+      continue;
+    }
+
+    const auto& gather_attrs = gather_node.GetAttributes();
+    const auto axis_it = gather_attrs.find("axis");
+    if (axis_it != gather_attrs.end() && axis_it->second.i() != 0 && axis_it->second.i() != -2) {
+      continue;
+    }
+
+    Node& reduce_node = *graph.GetNode(gather_node.OutputNodesBegin()->Index());
+    const bool is_sum = graph_utils::IsSupportedOptypeVersionAndDomain(reduce_node, "ReduceSum", {1, 11, 13});
+    const bool is_mean = graph_utils::IsSupportedOptypeVersionAndDomain(reduce_node, "ReduceMean", {1, 11, 13, 18});
+    if ((!is_sum && !is_mean) || reduce_node.GetExecutionProviderType() != gather_node.GetExecutionProviderType() ||
+        reduce_node.InputDefs()[0] != gather_node.OutputDefs()[0]) {
+      continue;
+    }
+
+    if (!optimizer_utils::IsAttributeWithExpectedValue(reduce_node, "keepdims", static_cast<int64_t>(0))) {
+      continue;
+    }
+
+    // The reduced axis must be the last axis of the indices, the one before the embedding dim of the gathered rows.
+    InlinedVector<int64_t> axes;
+    const bool axes_is_input = (is_sum && graph_utils::MatchesOpSinceVersion(reduce_node, {13})) ||
+                               (is_mean && graph_utils::MatchesOpSinceVersion(reduce_node, {18}));
+    if (axes_is_input) {
+      if (reduce_node.InputDefs().size() < 2 || !reduce_node.InputDefs()[1]->Exists() ||
+          !optimizer_utils::AppendTensorFromInitializer(graph, *reduce_node.InputDefs()[1], axes, true)) {
+        continue;
+      }
+    } else if (!graph_utils::GetRepeatedNodeAttributeValues(reduce_node, "axes", axes)) {
+      continue;
+    }
+
+    const int64_t gathered_rank = indices_shape->dim_size() + 1;
+    if (axes.size() != 1 || (axes[0] < 0 ? axes[0] + gathered_rank : axes[0]) != gathered_rank - 2) {
+      continue;
+    }
+
+    InlinedVector<NodeArg*> embedding_bag_inputs{gather_node.MutableInputDefs()[0],
+                                                 gather_node.MutableInputDefs()[1]};
+    Node& embedding_bag_node = graph.AddNode(graph.GenerateNodeName("EmbeddingBag"), "EmbeddingBag",
+                                             "fused Gather and " + reduce_node.OpType(), embedding_bag_inputs, {},
+                                             nullptr, kMSDomain);
+    embedding_bag_node.AddAttribute("mode", std::string(is_sum ? "sum" : "mean"));
+    embedding_bag_node.SetExecutionProviderType(gather_node.GetExecutionProviderType());
+
+    graph_utils::FinalizeNodeFusion(graph, {gather_node, reduce_node}, embedding_bag_node);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
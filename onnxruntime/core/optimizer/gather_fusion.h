@@ -36,4 +36,18 @@ class GatherToSliceFusion : public GraphTransformer {
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
+/**
+@Class EmbeddingBagFusion
+
+Fuse Gather(table, indices, axis=0) -> ReduceSum/ReduceMean(axes=[last axis of indices], keepdims=0) to a
+com.microsoft.EmbeddingBag node, which sums the gathered rows without writing them out.
+*/
+class EmbeddingBagFusion : public GraphTransformer {
+ public:
+  EmbeddingBagFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("EmbeddingBagFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
 }  // namespace onnxruntime
@@ -33,6 +33,12 @@ bool IsFusableActivation(const Node& node) {
 #ifndef DISABLE_CONTRIB_OPS
          IsSupportedOptypeVersionAndDomain(node, "ScaledTanh", {1}, kOnnxDomain) ||
          IsSupportedOptypeVersionAndDomain(node, "ParametricSoftplus", {1}, kOnnxDomain) ||
+         // The GELU family is fused into the MLAS output blocks by the float FusedGemm kernel.
+         IsSupportedOptypeVersionAndDomain(node, "Gelu", {1}, kMSDomain) ||
+         (IsSupportedOptypeVersionAndDomain(node, "FastGelu", {1}, kMSDomain) && node.InputDefs().size() == 1) ||
+         (IsSupportedOptypeVersionAndDomain(node, "QuickGelu", {1}, kMSDomain) &&
+          graph_utils::GetNodeAttribute(node, "alpha") != nullptr &&
+          graph_utils::GetNodeAttribute(node, "alpha")->f() == 1.0f) ||
 #endif
          IsSupportedOptypeVersionAndDomain(node, "ThresholdedRelu", {1, 10}, kOnnxDomain);
 }
@@ -0,0 +1,247 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/gemm_float8_fusion.h"
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/qdq_transformer/qdq_util.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+static int32_t GetElemType(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr ? type->tensor_type().elem_type() : TensorProto_DataType_UNDEFINED;
+}
+
+static bool IsFloat8Type(int32_t elem_type) {
+  return elem_type == TensorProto_DataType_FLOAT8E4M3FN || elem_type == TensorProto_DataType_FLOAT8E5M2;
+}
+
+// Returns the scale of a QuantizeLinear or DequantizeLinear node if it is a constant float or float16 scalar and the
+// zero point is missing or a constant zero.
+static std::optional<float> GetPerTensorScale(const Graph& graph, const Node& q_or_dq_node) {
+  const auto& input_defs = q_or_dq_node.InputDefs();
+  const TensorProto* scale_proto = graph_utils::GetConstantInitializer(graph, input_defs[QDQ::SCALE_ID]->Name());
+  if (scale_proto == nullptr) {
+    return std::nullopt;
+  }
+
+  Initializer scale(*scale_proto, graph.ModelPath());
+  if (scale.size() != 1) {
+    return std::nullopt;
+  }
+
+  float scale_value;
+  if (scale.data_type() == TensorProto_DataType_FLOAT) {
+    scale_value = *scale.data<float>();
+  } else if (scale.data_type() == TensorProto_DataType_FLOAT16) {
+    scale_value = scale.data<MLFloat16>()->ToFloat();
+  } else {
+    return std::nullopt;
+  }
+
+  if (input_defs.size() > QDQ::ZERO_POINT_ID && input_defs[QDQ::ZERO_POINT_ID]->Exists()) {
+    const TensorProto* zero_point_proto =
+        graph_utils::GetConstantInitializer(graph, input_defs[QDQ::ZERO_POINT_ID]->Name());
+    if (zero_point_proto == nullptr) {
+      return std::nullopt;
+    }
+
+    Initializer zero_point(*zero_point_proto, graph.ModelPath());
+    const auto zero_point_bytes = zero_point.DataAsByteSpan();
+    if (zero_point.size() != 1 ||
+        std::any_of(zero_point_bytes.begin(), zero_point_bytes.end(), [](uint8_t b) { return b != 0; })) {
+      return std::nullopt;
+    }
+  }
+
+  return scale_value;
+}
+
+// Returns the DequantizeLinear node of a float 8 tensor producing an input of the MatMul, if it only feeds the MatMul.
+static const Node* GetFloat8DQNode(const Graph& graph, const Node& matmul_node, int input_index) {
+  const Node* dq_node = graph_utils::GetInputNode(matmul_node, input_index);
+  if (dq_node == nullptr ||
+      !QDQ::MatchDQNode(*dq_node) ||
+      dq_node->GetExecutionProviderType() != matmul_node.GetExecutionProviderType() ||
+      !optimizer_utils::CheckOutputEdges(graph, *dq_node, 1) ||
+      !IsFloat8Type(GetElemType(*dq_node->InputDefs()[QDQ::INPUT_ID]))) {
+    return nullptr;
+  }
+
+  return dq_node;
+}
+
+static NodeArg& AddScalarInitializer(Graph& graph, const std::string& name, float value) {
+  TensorProto tensor_proto;
+  tensor_proto.set_name(graph.GenerateNodeArgName(name));
+  tensor_proto.set_data_type(TensorProto_DataType_FLOAT);
+  tensor_proto.add_float_data(value);
+  return graph_utils::AddInitializer(graph, tensor_proto);
+}
+
+/**
+GemmFloat8Fusion will fuse subgraph like below into GemmFloat8:
+
+ A (float 8)  A_Scale   B (float 8, constant) B_Scale
+      \         /              \                /
+   DequantizeLinear         DequantizeLinear
+            \                    /
+             \                  /
+                    MatMul                                       (A, B^T, , A_Scale, B_Scale, 1 / Y_Scale)
+                      |                         ---->                              |
+                      v                                                            v
+               QuantizeLinear (optional)  Y_Scale                             GemmFloat8
+                      |                                                            |
+                      v                                                            v
+                  (output)                                                      (output)
+
+The zero points must be missing or zero, which cuBLASLt does not support otherwise. The output is float 8 if the
+MatMul is followed by a float 8 QuantizeLinear node, otherwise it is the output type of the MatMul. GemmFloat8
+multiplies the result by its output scale while QuantizeLinear divides it by its own.
+*/
+Status GemmFloat8Fusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  InlinedVector<std::reference_wrapper<Node>> nodes_to_remove;
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& matmul_node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(matmul_node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(matmul_node, "MatMul", {1, 9, 13}) ||
+        !graph_utils::IsSupportedProvider(matmul_node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    const Node* p_dq_node_a = GetFloat8DQNode(graph, matmul_node, 0);
+    const Node* p_dq_node_b = GetFloat8DQNode(graph, matmul_node, 1);
+    if (p_dq_node_a == nullptr || p_dq_node_b == nullptr) {
+      continue;
+    }
+
+    // cuBLASLt does not multiply two float8e5m2 matrices.
+    const NodeArg& input_a = *p_dq_node_a->InputDefs()[QDQ::INPUT_ID];
+    const NodeArg& input_b = *p_dq_node_b->InputDefs()[QDQ::INPUT_ID];
+    if (GetElemType(input_a) == TensorProto_DataType_FLOAT8E5M2 &&
+        GetElemType(input_b) == TensorProto_DataType_FLOAT8E5M2) {
+      continue;
+    }
+
+    // A must have at least 2 dimensions, its leading dimensions being flattened into M.
+    const TensorShapeProto* shape_a = input_a.Shape();
+    if (shape_a == nullptr || shape_a->dim_size() < 2) {
+      continue;
+    }
+
+    const TensorProto* b_proto = graph_utils::GetConstantInitializer(graph, input_b.Name());
+    if (b_proto == nullptr || b_proto->dims_size() != 2) {
+      continue;
+    }
+
+    const auto scale_a = GetPerTensorScale(graph, *p_dq_node_a);
+    const auto scale_b = GetPerTensorScale(graph, *p_dq_node_b);
+    if (!scale_a.has_value() || !scale_b.has_value()) {
+      continue;
+    }
+
+    int32_t output_type = GetElemType(*matmul_node.OutputDefs()[0]);
+    if (output_type != TensorProto_DataType_FLOAT && output_type != TensorProto_DataType_FLOAT16 &&
+        output_type != TensorProto_DataType_BFLOAT16) {
+      continue;
+    }
+
+    // Find the float 8 QuantizeLinear node of the output, which saturates like cuBLASLt.
+    Node* p_q_node = nullptr;
+    std::optional<float> scale_y;
+    if (optimizer_utils::CheckOutputEdges(graph, matmul_node, 1)) {
+      const Node& child_node = *matmul_node.OutputNodesBegin();
+      const auto* saturate_attr = graph_utils::GetNodeAttribute(child_node, "saturate");
+      if (QDQ::MatchQNode(child_node) &&
+          child_node.GetExecutionProviderType() == matmul_node.GetExecutionProviderType() &&
+          IsFloat8Type(GetElemType(*child_node.OutputDefs()[0])) &&
+          (saturate_attr == nullptr || saturate_attr->i() != 0)) {
+        scale_y = GetPerTensorScale(graph, child_node);
+        if (scale_y.has_value() && *scale_y != 0.0f) {
+          p_q_node = graph.GetNode(child_node.Index());
+          output_type = GetElemType(*child_node.OutputDefs()[0]);
+        }
+      }
+    }
+
+    // Transpose B, which is (K, N), into (N, K).
+    Initializer b_initializer(*b_proto, graph.ModelPath());
+    const auto b_bytes = b_initializer.DataAsByteSpan();
+    const int64_t K = b_proto->dims(0);
+    const int64_t N = b_proto->dims(1);
+    std::vector<uint8_t> transposed_b(b_bytes.size());
+    for (int64_t k = 0; k < K; ++k) {
+      for (int64_t n = 0; n < N; ++n) {
+        transposed_b[n * K + k] = b_bytes[k * N + n];
+      }
+    }
+
+    TensorProto transposed_b_proto;
+    transposed_b_proto.set_name(graph.GenerateNodeArgName(input_b.Name() + "_transposed"));
+    transposed_b_proto.set_data_type(b_proto->data_type());
+    transposed_b_proto.add_dims(N);
+    transposed_b_proto.add_dims(K);
+    transposed_b_proto.set_raw_data(transposed_b.data(), transposed_b.size());
+
+    Node& dq_node_a = *graph.GetNode(p_dq_node_a->Index());
+    Node& dq_node_b = *graph.GetNode(p_dq_node_b->Index());
+
+    InlinedVector<NodeArg*> input_defs{
+        dq_node_a.MutableInputDefs()[QDQ::INPUT_ID],
+        &graph_utils::AddInitializer(graph, transposed_b_proto),
+        &graph.GetOrCreateNodeArg("", nullptr),
+        &AddScalarInitializer(graph, dq_node_a.Name() + "_scale", *scale_a),
+        &AddScalarInitializer(graph, dq_node_b.Name() + "_scale", *scale_b)};
+    if (p_q_node != nullptr) {
+      input_defs.push_back(&AddScalarInitializer(graph, p_q_node->Name() + "_inverse_scale", 1.0f / *scale_y));
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName(matmul_node.Name() + "_GemmFloat8"),
+                                     "GemmFloat8",
+                                     "Fused DequantizeLinear, MatMul and QuantizeLinear",
+                                     input_defs,
+                                     p_q_node != nullptr ? p_q_node->MutableOutputDefs() : matmul_node.MutableOutputDefs(),
+                                     nullptr,
+                                     kMSDomain);
+    fused_node.AddAttribute("transA", static_cast<int64_t>(0));
+    fused_node.AddAttribute("transB", static_cast<int64_t>(1));
+    fused_node.AddAttribute("dtype", static_cast<int64_t>(output_type));
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    fused_node.SetExecutionProviderType(matmul_node.GetExecutionProviderType());
+
+    nodes_to_remove.push_back(dq_node_a);
+    nodes_to_remove.push_back(dq_node_b);
+    nodes_to_remove.push_back(matmul_node);
+    if (p_q_node != nullptr) {
+      nodes_to_remove.push_back(*p_q_node);
+    }
+  }
+
+  modified = modified || !nodes_to_remove.empty();
+
+  for (const auto& node : nodes_to_remove) {
+    graph_utils::RemoveNodeOutputEdges(graph, node);
+    graph.RemoveNode(node.get().Index());
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class GemmFloat8Fusion
+Fuse DequantizeLinear nodes of float 8 tensors, the MatMul consuming them and the float 8 QuantizeLinear node
+consuming its result, if any, into GemmFloat8 with per-tensor scales. B must be a constant initializer, which is
+transposed as cuBLASLt only multiplies float 8 matrices with transB=1.
+*/
+class GemmFloat8Fusion : public GraphTransformer {
+ public:
+  GemmFloat8Fusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("GemmFloat8Fusion", compatible_execution_providers) {
+  }
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/optimizer/graph_transformer_mgr.h"
+#include "core/common/startup_timings.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 
 using namespace onnxruntime;
@@ -33,6 +34,7 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
         continue;
 
       bool modified = false;
+      StartupPhase phase("graph_transformer", transformer->Name());
       ORT_RETURN_IF_ERROR(transformer->Apply(graph, modified, logger));
       graph_changed = graph_changed || modified;
     }
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <variant>
 
+#include "core/common/string_utils.h"
 #include "core/optimizer/conv_activation_fusion.h"
 #include "core/optimizer/nhwc_transformer.h"
 #include "core/optimizer/qdq_transformer/qdq_final_cleanup.h"
@@ -32,6 +33,7 @@
 #include "core/optimizer/double_qdq_pairs_remover.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_chain_fusion.h"
 #include "core/optimizer/embed_layer_norm_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
@@ -40,6 +42,7 @@
 #include "core/optimizer/gelu_approximation.h"
 #include "core/optimizer/gelu_fusion.h"
 #include "core/optimizer/gemm_activation_fusion.h"
+#include "core/optimizer/gemm_float8_fusion.h"
 #include "core/optimizer/gemm_sum_fusion.h"
 #include "core/optimizer/gemm_transpose_fusion.h"
 #include "core/optimizer/identical_children_consolidation.h"
@@ -51,10 +54,12 @@
 #include "core/optimizer/matmul_scale_fusion.h"
 #include "core/optimizer/matmul_transpose_fusion.h"
 #include "core/optimizer/matmul_bn_fusion.h"
+#include "core/optimizer/mixed_precision_conversion.h"
 #include "core/optimizer/pad_fusion.h"
 #include "core/optimizer/nchwc_transformer.h"
 #include "core/optimizer/noop_elimination.h"
 #include "core/optimizer/not_where_fusion.h"
+#include "core/optimizer/packing_mode_conversion.h"
 #include "core/optimizer/pre_shape_node_elimination.h"
 #ifdef MLAS_TARGET_AMD64_IX86
 #include "core/optimizer/qdq_transformer/avx2_weight_s8_to_u8.h"
@@ -69,6 +74,7 @@
 #include "core/optimizer/reshape_fusion.h"
 #include "core/optimizer/rocm_blas_alt_impl.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
+#include "core/optimizer/scaler_fusion.h"
 #include "core/optimizer/skip_layer_norm_fusion.h"
 #include "core/optimizer/slice_elimination.h"
 #include "core/optimizer/transpose_optimizer.h"
@@ -261,6 +267,10 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
                                                             QDQIsInt8Allowed() ? "1" : "0") == "1";
       const bool enable_gelu_approximation =
           session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableGeluApproximation, "0") == "1";
+      const bool enable_elementwise_chain_fusion =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableElementwiseChainFusion, "0") == "1";
+      const bool enable_packing_mode =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnablePackingMode, "0") == "1";
 
       const InlinedHashSet<std::string_view> cuda_rocm_eps = {onnxruntime::kCudaExecutionProvider,
                                                               onnxruntime::kRocmExecutionProvider};
@@ -271,6 +281,15 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
                                                                       onnxruntime::kCudaExecutionProvider,
                                                                       onnxruntime::kRocmExecutionProvider,
                                                                       onnxruntime::kDmlExecutionProvider};
+      const InlinedHashSet<std::string_view> cpu_cuda_rocm_js_eps = {onnxruntime::kCpuExecutionProvider,
+                                                                     onnxruntime::kCudaExecutionProvider,
+                                                                     onnxruntime::kRocmExecutionProvider,
+                                                                     onnxruntime::kJsExecutionProvider};
+      const InlinedHashSet<std::string_view> cpu_cuda_dml_rocm_js_eps = {onnxruntime::kCpuExecutionProvider,
+                                                                         onnxruntime::kCudaExecutionProvider,
+                                                                         onnxruntime::kRocmExecutionProvider,
+                                                                         onnxruntime::kDmlExecutionProvider,
+                                                                         onnxruntime::kJsExecutionProvider};
       const InlinedHashSet<std::string_view> cpu_cuda_rocm_acl_armnn_js_eps = {onnxruntime::kCpuExecutionProvider,
                                                                                onnxruntime::kCudaExecutionProvider,
                                                                                onnxruntime::kRocmExecutionProvider,
@@ -294,26 +313,37 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
         transformers.emplace_back(std::make_unique<QDQSelectorActionTransformer>(qdq_is_int8_allowed));
       }
 
+#if !defined(DISABLE_FLOAT8_TYPES)
+      const bool enable_gemm_float8_fusion =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableGemmFloat8Fusion, "0") == "1";
+      if (enable_gemm_float8_fusion) {
+        transformers.emplace_back(
+            std::make_unique<GemmFloat8Fusion>(InlinedHashSet<std::string_view>{onnxruntime::kCudaExecutionProvider}));
+      }
+#endif
+
       transformers.emplace_back(std::make_unique<GemmActivationFusion>(cpu_ep));
       transformers.emplace_back(std::make_unique<MatMulIntegerToFloatFusion>(cpu_ep));
       transformers.emplace_back(std::make_unique<DynamicQuantizeMatMulFusion>(cpu_ep));
 
       transformers.emplace_back(std::make_unique<ConvActivationFusion>(cpu_cuda_rocm_acl_armnn_js_eps));
 
-      transformers.emplace_back(std::make_unique<GeluFusion>(cpu_cuda_dml_rocm_eps));
+      transformers.emplace_back(std::make_unique<GeluFusion>(cpu_cuda_dml_rocm_js_eps));
       transformers.emplace_back(std::make_unique<LayerNormFusion>(cpu_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<SimplifiedLayerNormFusion>(cpu_cuda_rocm_eps));
-      transformers.emplace_back(std::make_unique<AttentionFusion>(cpu_cuda_dml_rocm_eps));
+      transformers.emplace_back(std::make_unique<AttentionFusion>(cpu_cuda_dml_rocm_js_eps));
       transformers.emplace_back(std::make_unique<EmbedLayerNormFusion>(cpu_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<GatherToSplitFusion>(cpu_cuda_rocm_eps));
       transformers.emplace_back(std::make_unique<GatherToSliceFusion>(cpu_cuda_rocm_eps));
+      transformers.emplace_back(std::make_unique<EmbeddingBagFusion>(cpu_ep));
+      transformers.emplace_back(std::make_unique<ImputerScalerFusion>(cpu_ep));
 
       transformers.emplace_back(std::make_unique<MatmulTransposeFusion>(cpu_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<BiasGeluFusion>(cpu_cuda_dml_rocm_eps));
 
-      transformers.emplace_back(std::make_unique<SkipLayerNormFusion>(cpu_cuda_dml_rocm_eps));
+      transformers.emplace_back(std::make_unique<SkipLayerNormFusion>(cpu_cuda_dml_rocm_js_eps));
 
-      transformers.emplace_back(std::make_unique<FastGeluFusion>(cpu_cuda_rocm_eps));
+      transformers.emplace_back(std::make_unique<FastGeluFusion>(cpu_cuda_rocm_js_eps));
       transformers.emplace_back(std::make_unique<QuickGeluFusion>(cpu_cuda_dml_rocm_eps));
 
       // GeluApproximation has side effects which may change results. It needs to be manually enabled,
@@ -342,6 +372,18 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       transformers.emplace_back(std::make_unique<MatMulScaleFusion>(cpu_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<MatMulActivationFusion>(dml_ep));
 
+      // PackingModeConversion runs after the attention and normalization fusions, whose nodes it converts.
+      if (enable_packing_mode) {
+        transformers.emplace_back(
+            std::make_unique<PackingModeConversion>(InlinedHashSet<std::string_view>{onnxruntime::kCudaExecutionProvider}));
+      }
+
+      // ElementwiseChainFusion runs after the fusions of specific element-wise patterns, so that it only takes the
+      // nodes they leave.
+      if (enable_elementwise_chain_fusion) {
+        transformers.emplace_back(std::make_unique<ElementwiseChainFusion>(cpu_ep));
+      }
+
 #ifdef MLAS_TARGET_AMD64_IX86
       if (avx2_precision_mode) {
         transformers.emplace_back(std::make_unique<Avx2WeightS8ToU8Transformer>(cpu_ep));
@@ -349,6 +391,28 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 #endif
 
 #endif  // !defined(DISABLE_CONTRIB_OPS)
+
+      // MixedPrecisionConversion runs after the fusions, which mostly match float nodes.
+      const std::string mixed_precision_type =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsMixedPrecisionType, "");
+      if (!mixed_precision_type.empty()) {
+        ORT_ENFORCE(mixed_precision_type == "fp16" || mixed_precision_type == "bf16",
+                    "Unsupported mixed precision type: ", mixed_precision_type);
+        const auto target_type = mixed_precision_type == "fp16" ? ONNX_NAMESPACE::TensorProto_DataType_FLOAT16
+                                                                : ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16;
+        InlinedHashSet<std::string> fp32_op_types;
+        const std::string fp32_ops =
+            session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsMixedPrecisionFp32Ops, "");
+        for (const auto& op_type : utils::SplitString(fp32_ops, ",")) {
+          fp32_op_types.emplace(op_type);
+        }
+
+        const InlinedHashSet<std::string_view> gpu_eps = {onnxruntime::kCudaExecutionProvider,
+                                                          onnxruntime::kRocmExecutionProvider,
+                                                          onnxruntime::kDmlExecutionProvider};
+        transformers.emplace_back(std::make_unique<MixedPrecisionConversion>(target_type, fp32_op_types, gpu_eps));
+      }
+
       // The QDQFinalCleanupTransformer must run AFTER other transformers that fuse Q/DQ nodes. Otherwise, their
       // fusions might be prevented if this one removes a Q/DQ node too early.
       transformers.emplace_back(std::make_unique<QDQFinalCleanupTransformer>(enable_quant_qdq_cleanup));
@@ -357,13 +421,18 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 
     case TransformerLevel::Level3: {
 #ifndef DISABLE_CONTRIB_OPS
-      // Register the NCHWc layout transformer if supported by the platform.
-      if (MlasNchwcGetBlockSize() > 1) {
+      const bool enable_nhwc_fp32 =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableNhwcFp32, "0") == "1";
+
+      // Register the NCHWc layout transformer if supported by the platform, unless the fp32 layout
+      // sensitive nodes are transformed to NHWC instead.
+      if (MlasNchwcGetBlockSize() > 1 && !enable_nhwc_fp32) {
         transformers.emplace_back(std::make_unique<NchwcTransformer>());
       }
 
       auto cpu_registry = cpu_execution_provider.GetKernelRegistry();
-      auto nhwc_transformer = std::make_unique<NhwcTransformer>(std::move(cpu_allocator), std::move(cpu_registry));
+      auto nhwc_transformer = std::make_unique<NhwcTransformer>(std::move(cpu_allocator), std::move(cpu_registry),
+                                                                enable_nhwc_fp32);
       if (nhwc_transformer->IsActive()) {
         transformers.emplace_back(std::move(nhwc_transformer));
       }
@@ -439,7 +508,10 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformersForMinimalB
 #ifndef DISABLE_CONTRIB_OPS
         AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
         auto cpu_registry = cpu_execution_provider.GetKernelRegistry();
-        auto nhwc_transformer = std::make_unique<NhwcTransformer>(std::move(cpu_allocator), std::move(cpu_registry));
+        const bool enable_nhwc_fp32 =
+            session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableNhwcFp32, "0") == "1";
+        auto nhwc_transformer = std::make_unique<NhwcTransformer>(std::move(cpu_allocator), std::move(cpu_registry),
+                                                                  enable_nhwc_fp32);
         if (nhwc_transformer->IsActive()) {
           transformers.emplace_back(std::move(nhwc_transformer));
         }
@@ -0,0 +1,280 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/mixed_precision_conversion.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <string>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// The ops that are converted. Their float inputs and outputs all have the same type, and their results do not lose
+// much accuracy in reduced precision. Reductions, Softmax, normalizations and ops like Exp, Log or Pow are left out.
+const InlinedHashMap<std::string_view, std::string_view>& ConvertibleOps() {
+  static const InlinedHashMap<std::string_view, std::string_view> ops{
+      {"Add", kOnnxDomain},
+      {"AveragePool", kOnnxDomain},
+      {"Clip", kOnnxDomain},
+      {"Concat", kOnnxDomain},
+      {"Conv", kOnnxDomain},
+      {"ConvTranspose", kOnnxDomain},
+      {"Div", kOnnxDomain},
+      {"Expand", kOnnxDomain},
+      {"Flatten", kOnnxDomain},
+      {"Gather", kOnnxDomain},
+      {"Gemm", kOnnxDomain},
+      {"Identity", kOnnxDomain},
+      {"LeakyRelu", kOnnxDomain},
+      {"MatMul", kOnnxDomain},
+      {"MaxPool", kOnnxDomain},
+      {"Mul", kOnnxDomain},
+      {"Relu", kOnnxDomain},
+      {"Reshape", kOnnxDomain},
+      {"Sigmoid", kOnnxDomain},
+      {"Slice", kOnnxDomain},
+      {"Split", kOnnxDomain},
+      {"Squeeze", kOnnxDomain},
+      {"Sub", kOnnxDomain},
+      {"Tanh", kOnnxDomain},
+      {"Tile", kOnnxDomain},
+      {"Transpose", kOnnxDomain},
+      {"Unsqueeze", kOnnxDomain},
+      {"Where", kOnnxDomain},
+      {"BiasGelu", kMSDomain},
+      {"FastGelu", kMSDomain},
+      {"FusedMatMul", kMSDomain},
+      {"Gelu", kMSDomain},
+      {"QuickGelu", kMSDomain},
+  };
+  return ops;
+}
+
+// The converted ops that only move data. Converting them saves nothing by itself, so they are only converted to keep
+// the values produced by other converted nodes in reduced precision.
+bool IsDataMovementOp(const Node& node) {
+  static const InlinedHashSet<std::string_view> ops{
+      "Concat", "Expand", "Flatten", "Gather", "Identity", "Reshape", "Slice", "Split", "Squeeze", "Tile",
+      "Transpose", "Unsqueeze"};
+  return node.Domain() == kOnnxDomain && ops.count(node.OpType()) > 0;
+}
+
+bool IsFloatTensor(const NodeArg& arg) {
+  const TypeProto* type = arg.TypeAsProto();
+  return arg.Exists() && type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == TensorProto_DataType_FLOAT;
+}
+
+// Returns true if all values of the float initializer can be represented by target_type without overflow.
+bool FitsTargetType(const Initializer& initializer, TensorProto_DataType target_type) {
+  if (target_type == TensorProto_DataType_BFLOAT16) {
+    return true;  // bfloat16 has the exponent range of float
+  }
+
+  constexpr float kMaxFloat16 = 65504.0f;
+  const auto values = initializer.DataAsSpan<float>();
+  return std::all_of(values.begin(), values.end(), [](float value) {
+    return std::isnan(value) || std::abs(value) <= kMaxFloat16;
+  });
+}
+
+// Adds a Cast of input to output, which is created with output_type if it is nullptr.
+NodeArg* AddCastNode(Graph& graph, NodeArg& input, NodeArg* output, const TypeProto& output_type,
+                     TensorProto_DataType to, const ProviderType& provider_type) {
+  if (output == nullptr) {
+    output = &graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(input.Name() + "_reduced"), &output_type);
+  }
+
+  Node& cast_node = graph.AddNode(graph.GenerateNodeName(input.Name() + "_MixedPrecisionCast"),
+                                  "Cast",
+                                  "Cast for mixed precision",
+                                  std::array{&input},
+                                  std::array{output},
+                                  nullptr,
+                                  kOnnxDomain);
+  cast_node.AddAttribute("to", static_cast<int64_t>(to));
+  cast_node.SetExecutionProviderType(provider_type);
+  return output;
+}
+
+}  // namespace
+
+bool MixedPrecisionConversion::IsConvertible(const Node& node) const {
+  const auto& ops = ConvertibleOps();
+  const auto op = ops.find(node.OpType());
+  if (op == ops.end() || op->second != node.Domain() ||
+      fp32_op_types_.count(node.OpType()) > 0 ||
+      !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+      node.ContainsSubgraph()) {
+    return false;
+  }
+
+  // The schema must allow the target type wherever it allows float.
+  const auto* schema = node.Op();
+  if (schema == nullptr) {
+    return false;
+  }
+
+  const std::string target_type_str = target_type_ == TensorProto_DataType_FLOAT16 ? "tensor(float16)"
+                                                                                   : "tensor(bfloat16)";
+  for (const auto& constraint : schema->typeConstraintParams()) {
+    const auto& allowed_types = constraint.allowed_type_strs;
+    if (std::find(allowed_types.begin(), allowed_types.end(), "tensor(float)") != allowed_types.end() &&
+        std::find(allowed_types.begin(), allowed_types.end(), target_type_str) == allowed_types.end()) {
+      return false;
+    }
+  }
+
+  // All of the float inputs and outputs are converted, so there must be at least one, and none of unknown type.
+  bool has_float_input = false;
+  for (const NodeArg* input : node.InputDefs()) {
+    if (input->Exists() && input->TypeAsProto() == nullptr) {
+      return false;
+    }
+    has_float_input = has_float_input || IsFloatTensor(*input);
+  }
+
+  for (const NodeArg* output : node.OutputDefs()) {
+    if (output->Exists() && output->TypeAsProto() == nullptr) {
+      return false;
+    }
+  }
+
+  if (!has_float_input) {
+    return false;
+  }
+
+  // Softmax computes in the type of its input, so its inputs are produced in float to avoid overflow of the logits.
+  for (auto it = node.OutputNodesBegin(); it != node.OutputNodesEnd(); ++it) {
+    if (it->OpType() == "Softmax" || it->OpType() == "LogSoftmax") {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+Status MixedPrecisionConversion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                           const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  // Decide which nodes to convert before changing the graph, so that it is known for each value whether all of its
+  // consumers are converted.
+  InlinedHashSet<NodeIndex> converted_nodes;
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    ORT_RETURN_IF_ERROR(Recurse(*node_ptr, modified, graph_level, logger));
+
+    if (!IsConvertible(*node_ptr)) {
+      continue;
+    }
+
+    if (IsDataMovementOp(*node_ptr)) {
+      const auto& input_defs = node_ptr->InputDefs();
+      const bool has_converted_input =
+          std::any_of(node_ptr->InputEdgesBegin(), node_ptr->InputEdgesEnd(), [&](const Node::EdgeEnd& edge) {
+            return IsFloatTensor(*input_defs[edge.GetDstArgIndex()]) &&
+                   converted_nodes.count(edge.GetNode().Index()) > 0;
+          });
+      if (!has_converted_input) {
+        continue;
+      }
+    }
+
+    converted_nodes.insert(node_index);
+  }
+
+  if (converted_nodes.empty()) {
+    return Status::OK();
+  }
+
+  // The reduced precision value for each float value used by a converted node.
+  InlinedHashMap<const NodeArg*, NodeArg*> reduced_args;
+
+  for (auto node_index : node_topology_list) {
+    if (converted_nodes.count(node_index) == 0) {
+      continue;
+    }
+
+    Node& node = *graph.GetNode(node_index);
+    const ProviderType& provider_type = node.GetExecutionProviderType();
+    std::map<const NodeArg*, NodeArg*> replacement_defs;
+
+    for (NodeArg* input : node.MutableInputDefs()) {
+      if (!IsFloatTensor(*input) || replacement_defs.count(input) > 0) {
+        continue;
+      }
+
+      auto reduced = reduced_args.find(input);
+      if (reduced == reduced_args.end()) {
+        TypeProto reduced_type(*input->TypeAsProto());
+        reduced_type.mutable_tensor_type()->set_elem_type(target_type_);
+
+        NodeArg* reduced_arg = nullptr;
+        const TensorProto* tensor_proto = graph_utils::GetConstantInitializer(graph, input->Name());
+        if (tensor_proto != nullptr) {
+          Initializer initializer{*tensor_proto, graph.ModelPath()};
+          if (FitsTargetType(initializer, target_type_)) {
+            const std::string name = graph.GenerateNodeArgName(input->Name() + "_reduced");
+            reduced_arg = &graph_utils::AddInitializer(graph, target_type_ == TensorProto_DataType_FLOAT16
+                                                                  ? initializer.ToFP16(name)
+                                                                  : initializer.ToBFloat16(name));
+          }
+        }
+
+        if (reduced_arg == nullptr) {
+          reduced_arg = AddCastNode(graph, *input, nullptr, reduced_type, target_type_, provider_type);
+        }
+
+        reduced = reduced_args.emplace(input, reduced_arg).first;
+      }
+
+      replacement_defs[input] = reduced->second;
+    }
+
+    for (NodeArg* output : node.MutableOutputDefs()) {
+      if (!IsFloatTensor(*output)) {
+        continue;
+      }
+
+      TypeProto reduced_type(*output->TypeAsProto());
+      reduced_type.mutable_tensor_type()->set_elem_type(target_type_);
+      NodeArg* reduced_arg =
+          &graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(output->Name() + "_reduced"), &reduced_type);
+      reduced_args[output] = reduced_arg;
+      replacement_defs[output] = reduced_arg;
+
+      // Cast back to float if the value is a graph output or is used by a node that is not converted.
+      const auto consumers = graph.GetConsumerNodes(output->Name());
+      const bool needs_float = graph.IsOutput(output) ||
+                               std::any_of(consumers.begin(), consumers.end(), [&converted_nodes](const Node* consumer) {
+                                 return converted_nodes.count(consumer->Index()) == 0;
+                               });
+      if (needs_float) {
+        AddCastNode(graph, *reduced_arg, output, *output->TypeAsProto(), TensorProto_DataType_FLOAT, provider_type);
+      }
+    }
+
+    node.ReplaceDefs(replacement_defs);
+  }
+
+  // The edges are rebuilt from the new node args when the graph is resolved after this transformer.
+  modified = true;
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/graph/onnx_protobuf.h"
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class MixedPrecisionConversion
+
+Convert float nodes whose ops are safe to run in reduced precision, such as MatMul, Conv, Add and Relu, to float16 or
+bfloat16. Ops that are numerically sensitive, such as reductions, Softmax and the normalizations, are not in the list
+of converted ops and stay in float. The producers of Softmax inputs stay in float as well.
+
+Casts are inserted where a converted node consumes a float value, or where a float value is needed from a converted
+node, so the inputs and outputs of the graph do not change. Constant initializers are converted instead of cast,
+unless they have values that do not fit the reduced precision type.
+*/
+class MixedPrecisionConversion : public GraphTransformer {
+ public:
+  MixedPrecisionConversion(ONNX_NAMESPACE::TensorProto_DataType target_type,
+                           const InlinedHashSet<std::string>& fp32_op_types = {},
+                           const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("MixedPrecisionConversion", compatible_execution_providers),
+        target_type_(target_type),
+        fp32_op_types_(fp32_op_types) {
+  }
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+ private:
+  bool IsConvertible(const Node& node) const;
+
+  // TensorProto_DataType_FLOAT16 or TensorProto_DataType_BFLOAT16.
+  const ONNX_NAMESPACE::TensorProto_DataType target_type_;
+
+  // Op types supplied by the user that must stay in float in addition to the ones that are not converted by default.
+  const InlinedHashSet<std::string> fp32_op_types_;
+};
+
+}  // namespace onnxruntime
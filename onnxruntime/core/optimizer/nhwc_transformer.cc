@@ -43,7 +43,8 @@ NhwcConvLookup(
   return &(iter->second);
 }
 
-NhwcTransformer::NhwcTransformer(AllocatorPtr cpu_allocator, std::shared_ptr<KernelRegistry> cpu_kernel_registry) noexcept
+NhwcTransformer::NhwcTransformer(AllocatorPtr cpu_allocator, std::shared_ptr<KernelRegistry> cpu_kernel_registry,
+                                 bool enable_fp32) noexcept
     : GraphTransformer("NhwcTransformer"), cpu_allocator_(std::move(cpu_allocator)) {
   if (!cpu_kernel_registry) {
     // This is a CPU op nodes optimizer, not useful if cpu EP is not available.
@@ -94,6 +95,26 @@ NhwcTransformer::NhwcTransformer(AllocatorPtr cpu_allocator, std::shared_ptr<Ker
     }
   }
 
+  {
+    // fused depthwise and pointwise qconv -> nhwc fused qconv
+    const std::pair<MLDataType, api::DataType> qconv_dw_pw_types[] = {
+        {DataTypeImpl::GetTensorType<int8_t>(), api::DataType::INT8},
+        {DataTypeImpl::GetTensorType<uint8_t>(), api::DataType::UINT8}};
+    for (const auto& [kernel_type, data_type] : qconv_dw_pw_types) {
+      OpKernelRegistryId qconv_dw_pw{
+          "QLinearConvDepthwisePointwise", kMSDomain, 1, {{"T1", {kernel_type}}}};
+      const KernelCreateInfo* kernel_create_info{};
+      const auto status = cpu_kernel_registry->TryFindKernel(
+          kCpuExecutionProvider, qconv_dw_pw.op_type_, qconv_dw_pw.domain_,
+          qconv_dw_pw.version_, qconv_dw_pw.type_constraints_, &kernel_create_info);
+      if (status.IsOK() && kernel_create_info != nullptr) {
+        conv_table_.emplace(
+            OpIdInfo("QLinearConvDepthwisePointwise", kMSDomain, data_type),
+            OpTransformInfo{qconv_dw_pw.op_type_, qconv_dw_pw.domain_, qconv_dw_pw.version_, true});
+      }
+    }
+  }
+
   {
     // fp16 conv -> fp16 nhwc conv
     OpKernelRegistryId nhwc_conv_fp16{
@@ -164,6 +185,35 @@ NhwcTransformer::NhwcTransformer(AllocatorPtr cpu_allocator, std::shared_ptr<Ker
           OpTransformInfo{nhwc_gavgpool_fp16.op_type_, nhwc_gavgpool_fp16.domain_, nhwc_gavgpool_fp16.version_, false});
     }
   }
+
+  if (enable_fp32) {
+    // fp32 conv and pooling -> fp32 nhwc conv and pooling
+    struct Fp32Mapping {
+      const char* source_op;
+      const char* source_domain;
+      OpKernelRegistryId target;
+    };
+    const Fp32Mapping fp32_mappings[] = {
+        {"Conv", kOnnxDomain, {"NhwcFusedConv", kMSDomain, 1, {{"T", {DataTypeImpl::GetTensorType<float>()}}}}},
+        {"FusedConv", kMSDomain, {"NhwcFusedConv", kMSDomain, 1, {{"T", {DataTypeImpl::GetTensorType<float>()}}}}},
+        {"MaxPool", kOnnxDomain, {"MaxPool", kMSInternalNHWCDomain, 12, {{"T", {DataTypeImpl::GetTensorType<float>()}}}}},
+        {"AveragePool", kOnnxDomain,
+         {"AveragePool", kMSInternalNHWCDomain, 11, {{"T", {DataTypeImpl::GetTensorType<float>()}}}}},
+        {"GlobalAveragePool", kOnnxDomain,
+         {"GlobalAveragePool", kMSInternalNHWCDomain, 1, {{"T", {DataTypeImpl::GetTensorType<float>()}}}}}};
+    for (const auto& mapping : fp32_mappings) {
+      const auto& target = mapping.target;
+      const KernelCreateInfo* kernel_create_info{};
+      const auto status = cpu_kernel_registry->TryFindKernel(
+          kCpuExecutionProvider, target.op_type_, target.domain_,
+          target.version_, target.type_constraints_, &kernel_create_info);
+      if (status.IsOK() && kernel_create_info != nullptr) {
+        conv_table_.emplace(
+            OpIdInfo(mapping.source_op, mapping.source_domain, api::DataType::FLOAT),
+            OpTransformInfo{target.op_type_, target.domain_, target.version_, false});
+      }
+    }
+  }
 };
 
 Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
@@ -200,6 +250,13 @@ Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
       continue;
     }
 
+    // Skip if an output other than the first one is used, e.g. the Indices of MaxPool.
+    // Only the first output is transposed back and the NHWC kernels do not produce the others.
+    const auto outputs = node->Outputs();
+    if (std::any_of(outputs.begin() + 1, outputs.end(), [](std::string_view output) { return !output.empty(); })) {
+      continue;
+    }
+
     // Skip if unknown rank
     auto shape = NodeFromApiNode(*node).InputDefs()[0]->Shape();
     if (shape == nullptr) {
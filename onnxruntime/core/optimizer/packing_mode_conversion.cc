@@ -0,0 +1,494 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/packing_mode_conversion.h"
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+struct TokenWiseOp {
+  std::string_view domain;
+  // The number of leading inputs that may be padded values, or -1 if any input may be.
+  int num_padded_inputs;
+  // The maximum rank of the other inputs, e.g. weights of MatMul or a bias that is broadcast to every token.
+  int max_other_rank;
+};
+
+// The ops that compute each token on its own, so they give the same results for the real tokens with packed values.
+const InlinedHashMap<std::string_view, TokenWiseOp>& TokenWiseOps() {
+  static const InlinedHashMap<std::string_view, TokenWiseOp> ops{
+      {"Add", {kOnnxDomain, -1, 1}},
+      {"Cast", {kOnnxDomain, -1, 1}},
+      {"Div", {kOnnxDomain, -1, 1}},
+      {"Erf", {kOnnxDomain, -1, 1}},
+      {"LayerNormalization", {kOnnxDomain, 1, 1}},
+      {"MatMul", {kOnnxDomain, 1, 2}},
+      {"Mul", {kOnnxDomain, -1, 1}},
+      {"Relu", {kOnnxDomain, -1, 1}},
+      {"Sigmoid", {kOnnxDomain, -1, 1}},
+      {"SimplifiedLayerNormalization", {kOnnxDomain, 1, 1}},
+      {"Sub", {kOnnxDomain, -1, 1}},
+      {"Tanh", {kOnnxDomain, -1, 1}},
+      {"BiasGelu", {kMSDomain, 1, 1}},
+      {"FastGelu", {kMSDomain, 1, 1}},
+      {"Gelu", {kMSDomain, 1, 1}},
+      {"MatMulNBits", {kMSDomain, 1, 3}},
+      {"QuickGelu", {kMSDomain, 1, 1}},
+      {"SkipLayerNormalization", {kMSDomain, 2, 1}},
+      {"SkipSimplifiedLayerNormalization", {kMSDomain, 2, 1}},
+  };
+  return ops;
+}
+
+bool IsSameDim(const TensorShapeProto_Dimension& a, const TensorShapeProto_Dimension& b) {
+  if (a.has_dim_value() && b.has_dim_value()) {
+    return a.dim_value() == b.dim_value();
+  }
+
+  return a.has_dim_param() && b.has_dim_param() && !a.dim_param().empty() && a.dim_param() == b.dim_param();
+}
+
+// Returns true if arg is a float value with shape (batch_size, sequence_length, hidden_size), whose batch_size and
+// sequence_length are the ones of padded_shape, so it can be packed.
+bool IsPaddedValue(const Graph& graph, const NodeArg& arg, const TensorShapeProto& padded_shape) {
+  if (!arg.Exists() || graph.IsInitializedTensor(arg.Name())) {
+    return false;
+  }
+
+  const TypeProto* type = arg.TypeAsProto();
+  if (type == nullptr || !type->has_tensor_type() ||
+      (type->tensor_type().elem_type() != TensorProto_DataType_FLOAT &&
+       type->tensor_type().elem_type() != TensorProto_DataType_FLOAT16)) {
+    return false;
+  }
+
+  const TensorShapeProto* shape = arg.Shape();
+  return shape != nullptr && shape->dim_size() == 3 &&
+         IsSameDim(shape->dim(0), padded_shape.dim(0)) && IsSameDim(shape->dim(1), padded_shape.dim(1));
+}
+
+bool HasRankAtMost(const NodeArg& arg, int rank) {
+  const TensorShapeProto* shape = arg.Shape();
+  return shape != nullptr && shape->dim_size() <= rank;
+}
+
+bool IsUsed(const Graph& graph, const NodeArg& arg) {
+  return arg.Exists() && (graph.IsOutput(&arg) || !graph.GetConsumerNodes(arg.Name()).empty());
+}
+
+bool IsTokenWise(const Graph& graph, const Node& node, const TensorShapeProto& padded_shape,
+                 const InlinedHashSet<std::string_view>& compatible_providers) {
+  const auto& ops = TokenWiseOps();
+  const auto op = ops.find(node.OpType());
+  if (op == ops.end() || op->second.domain != node.Domain() ||
+      !graph_utils::IsSupportedProvider(node, compatible_providers) ||
+      node.ContainsSubgraph()) {
+    return false;
+  }
+
+  // The normalizations must normalize the hidden dimension only.
+  if (node.OpType() == "LayerNormalization" || node.OpType() == "SimplifiedLayerNormalization") {
+    const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+    if (axis_attr != nullptr && axis_attr->i() != -1 && axis_attr->i() != 2) {
+      return false;
+    }
+  }
+
+  bool has_padded_input = false;
+  const auto& input_defs = node.InputDefs();
+  for (size_t i = 0; i < input_defs.size(); ++i) {
+    if (!input_defs[i]->Exists()) {
+      continue;
+    }
+
+    if (IsPaddedValue(graph, *input_defs[i], padded_shape)) {
+      if (op->second.num_padded_inputs >= 0 && i >= static_cast<size_t>(op->second.num_padded_inputs)) {
+        return false;
+      }
+      has_padded_input = true;
+    } else if (!HasRankAtMost(*input_defs[i], op->second.max_other_rank)) {
+      return false;
+    }
+  }
+
+  if (!has_padded_input || !IsPaddedValue(graph, *node.OutputDefs()[0], padded_shape)) {
+    return false;
+  }
+
+  // Optional outputs like the mean of LayerNormalization are packed as well, so they must have the padded shape.
+  for (const NodeArg* output : node.OutputDefs()) {
+    if (IsUsed(graph, *output) && !IsPaddedValue(graph, *output, padded_shape)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// The indices of the padded inputs and of the mask of the attention ops that are converted.
+struct AttentionOp {
+  std::string_view packed_op_type;
+  InlinedVector<int> padded_inputs;
+  int mask_input;
+  // the inputs and outputs whose states the packed op does not have
+  InlinedVector<int> unsupported_inputs;
+  InlinedVector<int> unsupported_outputs;
+  // the attributes that are kept
+  InlinedVector<std::string_view> attributes;
+};
+
+const AttentionOp* GetAttentionOp(const Node& node) {
+  // Attention: input, weights, bias, mask_index, past, relative_position_bias, past_sequence_length
+  static const AttentionOp attention{
+      "PackedAttention", {0}, 3, {4, 6}, {1}, {"num_heads", "qkv_hidden_sizes", "scale", "unidirectional"}};
+  // MultiHeadAttention: query, key, value, bias, key_padding_mask, relative_position_bias, past_key, past_value
+  static const AttentionOp multi_head_attention{
+      "PackedMultiHeadAttention", {0, 1, 2}, 4, {6, 7}, {1, 2}, {"num_heads", "mask_filter_value", "scale"}};
+
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Attention", {1}, kMSDomain)) {
+    return &attention;
+  }
+
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "MultiHeadAttention", {1}, kMSDomain)) {
+    return &multi_head_attention;
+  }
+
+  return nullptr;
+}
+
+// Returns the mask of an attention node that can be converted to packing mode, which must have the sequence lengths
+// with shape (batch_size), or nullptr.
+const NodeArg* GetSequenceLengths(const Graph& graph, const Node& node, const AttentionOp& op) {
+  const auto& input_defs = node.InputDefs();
+  if (input_defs.size() <= static_cast<size_t>(op.mask_input) || !input_defs[op.mask_input]->Exists()) {
+    return nullptr;
+  }
+
+  for (int i : op.unsupported_inputs) {
+    if (input_defs.size() > static_cast<size_t>(i) && input_defs[i]->Exists()) {
+      return nullptr;
+    }
+  }
+
+  for (int i : op.unsupported_outputs) {
+    if (node.OutputDefs().size() > static_cast<size_t>(i) && IsUsed(graph, *node.OutputDefs()[i])) {
+      return nullptr;
+    }
+  }
+
+  // PackedAttention needs the bias, and has no rotary embedding or shared buffer for the past state.
+  if (node.OpType() == "Attention") {
+    const auto* do_rotary_attr = graph_utils::GetNodeAttribute(node, "do_rotary");
+    const auto* share_buffer_attr = graph_utils::GetNodeAttribute(node, "past_present_share_buffer");
+    if (input_defs.size() <= 2 || !input_defs[2]->Exists() ||
+        (do_rotary_attr != nullptr && do_rotary_attr->i() != 0) ||
+        (share_buffer_attr != nullptr && share_buffer_attr->i() != 0)) {
+      return nullptr;
+    }
+  }
+
+  // Masks with shape (2 * batch_size) also have 1 dimension, so the dimension must be the batch_size of the query.
+  const NodeArg& mask = *input_defs[op.mask_input];
+  const TensorShapeProto* mask_shape = mask.Shape();
+  const TensorShapeProto* query_shape = input_defs[0]->Shape();
+  if (mask.TypeAsProto() == nullptr ||
+      mask.TypeAsProto()->tensor_type().elem_type() != TensorProto_DataType_INT32 ||
+      mask_shape == nullptr || mask_shape->dim_size() != 1 ||
+      query_shape == nullptr || query_shape->dim_size() != 3 ||
+      !IsSameDim(mask_shape->dim(0), query_shape->dim(0))) {
+    return nullptr;
+  }
+
+  return &mask;
+}
+
+TypeProto PackedType(const NodeArg& arg) {
+  // The shape is left to shape inference.
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(arg.TypeAsProto()->tensor_type().elem_type());
+  return type;
+}
+
+// An attention node that is converted, with what is needed after it was removed.
+struct RemovedAttentionNode {
+  const AttentionOp* op;
+  std::string name;
+  ProviderType provider_type;
+  std::vector<NodeArg*> input_defs;
+  NodeArg* output;
+  NodeAttributes attributes;
+};
+
+}  // namespace
+
+Status PackingModeConversion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                        const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  // Find the attention nodes to convert. They must share the sequence lengths and the padded shape of the first one.
+  const NodeArg* sequence_lengths = nullptr;
+  const TensorShapeProto* padded_shape = nullptr;
+  InlinedVector<NodeIndex> attention_nodes;
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    ORT_RETURN_IF_ERROR(Recurse(*node_ptr, modified, graph_level, logger));
+
+    const AttentionOp* op = GetAttentionOp(*node_ptr);
+    if (op == nullptr || !graph_utils::IsSupportedProvider(*node_ptr, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    const NodeArg* mask = GetSequenceLengths(graph, *node_ptr, *op);
+    if (mask == nullptr || (sequence_lengths != nullptr && mask != sequence_lengths)) {
+      continue;
+    }
+
+    const TensorShapeProto& shape = padded_shape != nullptr ? *padded_shape : *node_ptr->InputDefs()[0]->Shape();
+    const auto& input_defs = node_ptr->InputDefs();
+    const bool is_self_attention = std::all_of(op->padded_inputs.begin(), op->padded_inputs.end(), [&](int i) {
+      return IsPaddedValue(graph, *input_defs[i], shape);
+    });
+    if (!is_self_attention || !IsPaddedValue(graph, *node_ptr->OutputDefs()[0], shape)) {
+      continue;
+    }
+
+    sequence_lengths = mask;
+    padded_shape = &shape;
+    attention_nodes.push_back(node_index);
+  }
+
+  if (attention_nodes.empty()) {
+    return Status::OK();
+  }
+
+  // Grow the packed region from the attention nodes through the token-wise nodes that produce or consume their
+  // padded values.
+  InlinedHashSet<NodeIndex> packed_nodes(attention_nodes.begin(), attention_nodes.end());
+  InlinedVector<const Node*> nodes_to_visit;
+  for (auto node_index : attention_nodes) {
+    nodes_to_visit.push_back(graph.GetNode(node_index));
+  }
+
+  while (!nodes_to_visit.empty()) {
+    const Node& node = *nodes_to_visit.back();
+    nodes_to_visit.pop_back();
+
+    for (const NodeArg* input : node.InputDefs()) {
+      if (!IsPaddedValue(graph, *input, *padded_shape)) {
+        continue;
+      }
+
+      const Node* producer = graph.GetProducerNode(input->Name());
+      if (producer != nullptr && packed_nodes.count(producer->Index()) == 0 &&
+          IsTokenWise(graph, *producer, *padded_shape, GetCompatibleExecutionProviders())) {
+        packed_nodes.insert(producer->Index());
+        nodes_to_visit.push_back(producer);
+      }
+    }
+
+    for (const NodeArg* output : node.OutputDefs()) {
+      if (!IsPaddedValue(graph, *output, *padded_shape)) {
+        continue;
+      }
+
+      for (const Node* consumer : graph.GetConsumerNodes(output->Name())) {
+        if (packed_nodes.count(consumer->Index()) == 0 &&
+            IsTokenWise(graph, *consumer, *padded_shape, GetCompatibleExecutionProviders())) {
+          packed_nodes.insert(consumer->Index());
+          nodes_to_visit.push_back(consumer);
+        }
+      }
+    }
+  }
+
+  // Decide which values are padded again before changing the graph: the graph outputs, and the values that nodes
+  // outside of the region use.
+  InlinedHashSet<const NodeArg*> restored_args;
+  for (auto node_index : node_topology_list) {
+    if (packed_nodes.count(node_index) == 0) {
+      continue;
+    }
+
+    for (const NodeArg* output : graph.GetNode(node_index)->OutputDefs()) {
+      if (!IsPaddedValue(graph, *output, *padded_shape)) {
+        continue;
+      }
+
+      const auto consumers = graph.GetConsumerNodes(output->Name());
+      if (graph.IsOutput(output) ||
+          std::any_of(consumers.begin(), consumers.end(), [&packed_nodes](const Node* consumer) {
+            return packed_nodes.count(consumer->Index()) == 0;
+          })) {
+        restored_args.insert(output);
+      }
+    }
+  }
+
+  // Remove the attention nodes while the edges still match the node args.
+  InlinedHashMap<NodeIndex, RemovedAttentionNode> removed_attention_nodes;
+  for (auto node_index : attention_nodes) {
+    Node& node = *graph.GetNode(node_index);
+    const AttentionOp* op = GetAttentionOp(node);
+
+    RemovedAttentionNode removed{op, node.Name(), node.GetExecutionProviderType(),
+                                 std::vector<NodeArg*>(node.MutableInputDefs().begin(), node.MutableInputDefs().end()),
+                                 node.MutableOutputDefs()[0], {}};
+    for (const auto& name : op->attributes) {
+      const auto* attr = graph_utils::GetNodeAttribute(node, std::string(name));
+      if (attr != nullptr) {
+        removed.attributes[attr->name()] = *attr;
+      }
+    }
+
+    removed_attention_nodes.emplace(node_index, std::move(removed));
+    graph_utils::RemoveNodeOutputEdges(graph, node);
+    graph.RemoveNode(node_index);
+  }
+
+  NodeArg* sequence_lengths_arg = graph.GetNodeArg(sequence_lengths->Name());
+  TypeProto int32_type;
+  int32_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT32);
+  NodeArg& token_offset = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName("token_offset"), &int32_type);
+  NodeArg& cumulative_sequence_length =
+      graph.GetOrCreateNodeArg(graph.GenerateNodeArgName("cumulative_sequence_length"), &int32_type);
+  bool has_remove_padding_node = false;
+
+  // The packed value for each padded value used by a packed node.
+  InlinedHashMap<const NodeArg*, NodeArg*> packed_args;
+  auto get_packed_arg = [&](NodeArg& input, const ProviderType& provider_type) -> NodeArg* {
+    auto packed = packed_args.find(&input);
+    if (packed != packed_args.end()) {
+      return packed->second;
+    }
+
+    // The value comes from outside of the region, so pack it. The first RemovePadding node gives the token offsets
+    // and cumulative sequence lengths that all of the packed nodes use.
+    TypeProto packed_type = PackedType(input);
+    NodeArg* packed_arg = &graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(input.Name() + "_packed"), &packed_type);
+    std::array<NodeArg*, 4> outputs{
+        packed_arg,
+        has_remove_padding_node ? &graph.GetOrCreateNodeArg(graph.GenerateNodeArgName("token_offset"), &int32_type)
+                                : &token_offset,
+        has_remove_padding_node
+            ? &graph.GetOrCreateNodeArg(graph.GenerateNodeArgName("cumulative_sequence_length"), &int32_type)
+            : &cumulative_sequence_length,
+        &graph.GetOrCreateNodeArg(graph.GenerateNodeArgName("max_sequence_length"), &int32_type)};
+    has_remove_padding_node = true;
+
+    Node& remove_padding_node = graph.AddNode(graph.GenerateNodeName(input.Name() + "_RemovePadding"),
+                                              "RemovePadding",
+                                              "Pack the tokens for packing mode",
+                                              std::array{&input, sequence_lengths_arg},
+                                              outputs,
+                                              nullptr,
+                                              kMSDomain);
+    remove_padding_node.SetExecutionProviderType(provider_type);
+    packed_args.emplace(&input, packed_arg);
+    return packed_arg;
+  };
+
+  // Creates the packed value of a padded output, and pads it again into the output if needed.
+  auto add_packed_output = [&](NodeArg& output, const ProviderType& provider_type) -> NodeArg* {
+    TypeProto packed_type = PackedType(output);
+    NodeArg* packed_arg = &graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(output.Name() + "_packed"),
+                                                    &packed_type);
+    packed_args.emplace(&output, packed_arg);
+
+    if (restored_args.count(&output) > 0) {
+      Node& restore_padding_node = graph.AddNode(graph.GenerateNodeName(output.Name() + "_RestorePadding"),
+                                                 "RestorePadding",
+                                                 "Restore the padding of a value leaving packing mode",
+                                                 std::array{packed_arg, &token_offset},
+                                                 std::array{&output},
+                                                 nullptr,
+                                                 kMSDomain);
+      restore_padding_node.SetExecutionProviderType(provider_type);
+    }
+
+    return packed_arg;
+  };
+
+  for (auto node_index : node_topology_list) {
+    if (packed_nodes.count(node_index) == 0) {
+      continue;
+    }
+
+    auto removed = removed_attention_nodes.find(node_index);
+    if (removed != removed_attention_nodes.end()) {
+      const RemovedAttentionNode& attention = removed->second;
+      const auto& input_defs = attention.input_defs;
+      NodeArg& empty_arg = graph.GetOrCreateNodeArg("", nullptr);
+      auto get_input = [&](size_t i) -> NodeArg* {
+        return i < input_defs.size() ? input_defs[i] : &empty_arg;
+      };
+
+      // PackedAttention: input, weights, bias, token_offset, cumulative_sequence_length, relative_position_bias
+      // PackedMultiHeadAttention: query, key, value, bias, token_offset, cumulative_sequence_length,
+      //                           relative_position_bias
+      InlinedVector<NodeArg*> packed_inputs;
+      for (int i = 0; i < attention.op->mask_input; ++i) {
+        NodeArg* input = get_input(i);
+        const bool is_padded = std::find(attention.op->padded_inputs.begin(), attention.op->padded_inputs.end(), i) !=
+                               attention.op->padded_inputs.end();
+        packed_inputs.push_back(is_padded ? get_packed_arg(*input, attention.provider_type) : input);
+      }
+      packed_inputs.push_back(&token_offset);
+      packed_inputs.push_back(&cumulative_sequence_length);
+      NodeArg* relative_position_bias = get_input(attention.op->mask_input + 1);
+      if (relative_position_bias->Exists()) {
+        packed_inputs.push_back(relative_position_bias);
+      }
+
+      NodeArg* packed_output = add_packed_output(*attention.output, attention.provider_type);
+      Node& packed_node = graph.AddNode(graph.GenerateNodeName(attention.name + "_packed"),
+                                        std::string(attention.op->packed_op_type),
+                                        "Attention in packing mode",
+                                        packed_inputs,
+                                        std::array{packed_output},
+                                        &attention.attributes,
+                                        kMSDomain);
+      packed_node.SetExecutionProviderType(attention.provider_type);
+      continue;
+    }
+
+    Node& node = *graph.GetNode(node_index);
+    const ProviderType& provider_type = node.GetExecutionProviderType();
+    std::map<const NodeArg*, NodeArg*> replacement_defs;
+
+    for (NodeArg* input : node.MutableInputDefs()) {
+      if (IsPaddedValue(graph, *input, *padded_shape) && replacement_defs.count(input) == 0) {
+        replacement_defs[input] = get_packed_arg(*input, provider_type);
+      }
+    }
+
+    for (NodeArg* output : node.MutableOutputDefs()) {
+      if (IsPaddedValue(graph, *output, *padded_shape)) {
+        replacement_defs[output] = add_packed_output(*output, provider_type);
+      }
+    }
+
+    node.ReplaceDefs(replacement_defs);
+  }
+
+  // The edges are rebuilt from the new node args when the graph is resolved after this transformer.
+  modified = true;
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,35 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class PackingModeConversion
+
+Convert the transformer layers of a model to packing mode, in which the activations only hold the real tokens of the
+sequences of a batch that is padded on the right, so no compute is spent on the padding.
+
+Attention nodes whose mask index has the sequence lengths with shape (batch_size) are converted to PackedAttention,
+and MultiHeadAttention nodes whose key padding mask has them to PackedMultiHeadAttention. The unidirectional attribute
+is kept, so the causal self attention of decoders is converted as well. The nodes around them that compute each token
+on its own, such as MatMul, the normalizations, the activations and the element-wise ops with a bias, take the packed
+values with shape (token_count, hidden_size) too.
+
+RemovePadding packs the values with shape (batch_size, sequence_length, hidden_size) where they enter these nodes, and
+RestorePadding pads them again where they leave, so the inputs and outputs of the graph keep their shapes. The padding
+positions of the outputs are zeros.
+*/
+class PackingModeConversion : public GraphTransformer {
+ public:
+  PackingModeConversion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("PackingModeConversion", compatible_execution_providers) {
+  }
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
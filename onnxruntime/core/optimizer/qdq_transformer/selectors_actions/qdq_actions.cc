@@ -248,6 +248,38 @@ ConvReplaceWithQLinear::ConvReplaceWithQLinear()
 WhereReplaceWithQLinear::WhereReplaceWithQLinear()
     : ReplaceWithQLinear(kMSDomain, WhereMoves()) {
 }
+ConvDepthwisePointwiseReplaceWithFused::ConvDepthwisePointwiseReplaceWithFused()
+    : ReplaceWithNewFixed(kMSDomain, "QLinearConvDepthwisePointwise", {}) {
+}
+
+std::vector<NodeAndMoveInfo> ConvDepthwisePointwiseReplaceWithFused::ValueMoves(const RuntimeState& state) const {
+  NTO::NodeLocation dw{NTO::NodeType::kTarget, 0};
+  NTO::NodeLocation pw{NTO::NodeType::kOutput, 0};
+
+  std::vector<NodeAndMoveInfo> moves;
+  for (int i = 0; i < 8; i++) {
+    moves.push_back(MoveAndAppend(dw, ArgType::kInput, i, ArgType::kInput));  // x, dw_w and the mid quant params
+  }
+  for (int i = 3; i < 8; i++) {
+    moves.push_back(MoveAndAppend(pw, ArgType::kInput, i, ArgType::kInput));  // pw_w and the y quant params
+  }
+
+  // the selector ensures the depthwise bias exists if the pointwise bias does
+  auto has_bias = [](const Node& node) {
+    const auto& input_defs = node.InputDefs();
+    return input_defs.size() > 8 && input_defs[8]->Exists();
+  };
+  if (has_bias(state.selected_nodes.Target())) {
+    moves.push_back(MoveAndAppend(dw, ArgType::kInput, 8, ArgType::kInput));
+  }
+  if (has_bias(*state.selected_nodes.Output(0))) {
+    moves.push_back(MoveAndAppend(pw, ArgType::kInput, 8, ArgType::kInput));
+  }
+
+  moves.push_back(MoveAll(pw, ArgType::kOutput));
+  return moves;
+}
+
 MatMulReplaceWithQLinear::MatMulReplaceWithQLinear()
     : matmul_int_to_float_replacer_{MatMulIntToFloatReplacer()},
       qlinear_matmul_replacer_{kOnnxDomain} {
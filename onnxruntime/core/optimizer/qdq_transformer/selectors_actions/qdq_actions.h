@@ -62,6 +62,15 @@ struct ConvReplaceWithQLinear : ReplaceWithQLinear {
 struct WhereReplaceWithQLinear : ReplaceWithQLinear {
   WhereReplaceWithQLinear();
 };
+
+// replace a depthwise QLinearConv and the 1x1 QLinearConv consuming it with QLinearConvDepthwisePointwise
+struct ConvDepthwisePointwiseReplaceWithFused : public ReplaceWithNewFixed {
+  ConvDepthwisePointwiseReplaceWithFused();
+
+ private:
+  std::vector<NodeAndMoveInfo> ValueMoves(const RuntimeState& state) const override;
+};
+
 struct SplitReplaceWithQuant : public Action {
   Status Run(Graph&, const NodesToOptimize& selected_nodes) const override;
 };
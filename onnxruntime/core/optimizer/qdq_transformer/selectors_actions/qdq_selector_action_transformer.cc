@@ -183,6 +183,28 @@ void ConvQDQRules(SelectorActionRegistry& qdq_selector_action_registry, bool is_
 #endif
 }
 
+void ConvDepthwisePointwiseRules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 2 Nodes. 0=depthwise QLinearConv, 1=1x1 pointwise QLinearConv consuming its output
+  // Replace with QLinearConvDepthwisePointwise, which keeps the intermediate activation in cache
+  // Delete all original nodes
+  const std::string action_name{"ConvDepthwisePointwise"};
+  std::unique_ptr<Action> action = std::make_unique<QDQ::ConvDepthwisePointwiseReplaceWithFused>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::ConvDepthwisePointwiseSelector>();
+
+  qdq_selector_action_registry.RegisterSelectorAndAction(
+      action_name,
+      {{"QLinearConv", {}},
+       {SelectorActionRegistry::OpVersionsMapKey("QLinearConv", kMSDomain), {}}},
+      std::move(selector),
+      std::move(action));
+
+#else
+  qdq_selector_action_registry.RegisterAction(action_name, std::move(action));
+#endif
+}
+
 void MatMulQDQRules(SelectorActionRegistry& qdq_selector_action_registry, bool is_int8_allowed = false) {
   // 3 or 4 nodes. 2 x DQ for inputs, target, optional Q
   // Replace with QLinearMatMul if Q found, or MatMulIntegerToFloat if not.
@@ -256,6 +278,7 @@ SelectorActionRegistry CreateSelectorActionRegistry(bool is_int8_allowed) {
   BinaryOpQDQRules(qdq_selector_action_registry);
   VariadicOpQDQRules(qdq_selector_action_registry);
   ConvQDQRules(qdq_selector_action_registry, is_int8_allowed);
+  ConvDepthwisePointwiseRules(qdq_selector_action_registry);
   MatMulQDQRules(qdq_selector_action_registry, is_int8_allowed);
   GemmQDQRules(qdq_selector_action_registry);
   WhereQDQRules(qdq_selector_action_registry);
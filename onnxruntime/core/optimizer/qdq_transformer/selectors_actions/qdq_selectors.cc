@@ -6,6 +6,7 @@
 #include "core/optimizer/qdq_transformer/selectors_actions/qdq_selectors.h"
 
 #include "core/graph/graph.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/optimizer/initializer.h"
 #include "core/optimizer/qdq_transformer/qdq_util.h"
 #include "core/optimizer/qdq_transformer/selectors_actions/shared/utils.h"
@@ -563,6 +564,112 @@ bool TopKNodeGroupSelector::Check(const GraphViewer& graph_viewer,
   return IsQDQPairSupported(q_node, dq_node, get_const_initializer, graph_viewer.ModelPath());
 }
 
+namespace {
+
+int64_t GetIntAttribute(const Node& node, const std::string& name, int64_t default_value) {
+  const auto& attributes = node.GetAttributes();
+  const auto it = attributes.find(name);
+  return it != attributes.end() ? it->second.i() : default_value;
+}
+
+bool AllIntsAttributeEqual(const Node& node, const std::string& name, int64_t value) {
+  const auto& attributes = node.GetAttributes();
+  const auto it = attributes.find(name);
+  return it == attributes.end() ||
+         std::all_of(it->second.ints().begin(), it->second.ints().end(), [value](int64_t v) { return v == value; });
+}
+
+bool HasConvBias(const Node& node) {
+  const auto& input_defs = node.InputDefs();
+  return input_defs.size() > 8 && input_defs[8]->Exists();
+}
+
+// Returns the constant 4D int8 filter of a QLinearConv node if all of its zero points are zero.
+const ONNX_NAMESPACE::TensorProto* GetSymmetricConvFilter(const GraphViewer& graph_viewer, const Node& node) {
+  const auto& input_defs = node.InputDefs();
+  const auto* W = graph_viewer.GetConstantInitializer(input_defs[3]->Name(), true);
+  const auto* W_zero_point = graph_viewer.GetConstantInitializer(input_defs[5]->Name(), true);
+  if (W == nullptr || W_zero_point == nullptr || W->dims_size() != 4 ||
+      W->data_type() != ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_INT8) {
+    return nullptr;
+  }
+
+  Initializer zero_point(*W_zero_point, graph_viewer.ModelPath());
+  const auto zero_point_values = zero_point.DataAsSpan<int8_t>();
+  if (!std::all_of(zero_point_values.begin(), zero_point_values.end(), [](int8_t v) { return v == 0; })) {
+    return nullptr;
+  }
+
+  return W;
+}
+
+}  // namespace
+
+std::optional<NodesToOptimizeIndices> ConvDepthwisePointwiseSelector::Select(const GraphViewer& graph_viewer,
+                                                                             const Node& node) const {
+  // The depthwise output must be consumed only by the pointwise convolution.
+  if (node.GetOutputEdgesCount() != 1 || graph_viewer.NodeProducesGraphOutput(node)) {
+    return std::nullopt;
+  }
+
+  const auto edge = node.OutputEdgesBegin();
+  const Node& next_node = edge->GetNode();
+  if (edge->GetDstArgIndex() != 0 || graph_viewer.GetNode(next_node.Index()) == nullptr ||
+      next_node.OpType() != node.OpType() || next_node.Domain() != node.Domain() ||
+      next_node.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+    return std::nullopt;
+  }
+
+  const auto* dw_W = GetSymmetricConvFilter(graph_viewer, node);
+  const auto* pw_W = GetSymmetricConvFilter(graph_viewer, next_node);
+  if (dw_W == nullptr || pw_W == nullptr) {
+    return std::nullopt;
+  }
+
+  // Depthwise convolution with a channel multiplier of one.
+  const int64_t channels = dw_W->dims(0);
+  if (dw_W->dims(1) != 1 || GetIntAttribute(node, "group", 1) != channels) {
+    return std::nullopt;
+  }
+
+  // 1x1 pointwise convolution with unit strides and no padding.
+  if (pw_W->dims(1) != channels || pw_W->dims(2) != 1 || pw_W->dims(3) != 1 ||
+      GetIntAttribute(next_node, "group", 1) != 1 ||
+      !AllIntsAttributeEqual(next_node, "strides", 1) || !AllIntsAttributeEqual(next_node, "pads", 0)) {
+    return std::nullopt;
+  }
+
+  if (GetIntAttribute(node, "channels_last", 0) != GetIntAttribute(next_node, "channels_last", 0)) {
+    return std::nullopt;
+  }
+
+  // The fused node has a single activation type.
+  const int32_t dt_input = node.InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  if (node.OutputDefs()[0]->TypeAsProto()->tensor_type().elem_type() != dt_input ||
+      next_node.OutputDefs()[0]->TypeAsProto()->tensor_type().elem_type() != dt_input) {
+    return std::nullopt;
+  }
+
+  // The fused node can't express a pointwise bias without a depthwise bias.
+  if (!HasConvBias(node) && HasConvBias(next_node)) {
+    return std::nullopt;
+  }
+
+  // The filters must be supported by the fused MLAS kernel on this platform.
+  const bool is_signed = dt_input == ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_INT8;
+  const size_t kernel_size = static_cast<size_t>(dw_W->dims(2) * dw_W->dims(3));
+  if (MlasConvSymPackWSize(static_cast<size_t>(channels), 1, 1, kernel_size, is_signed) == 0 ||
+      MlasConvSymPointwisePackWSize(static_cast<size_t>(channels), static_cast<size_t>(pw_W->dims(0)),
+                                    is_signed) == 0) {
+    return std::nullopt;
+  }
+
+  NodesToOptimizeIndicesBuilder builder;
+  builder.target_node = node.Index();
+  builder.output_nodes.push_back(next_node.Index());
+  return builder.Build();
+}
+
 }  // namespace QDQ
 }  // namespace onnxruntime
 
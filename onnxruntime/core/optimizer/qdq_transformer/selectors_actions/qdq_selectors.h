@@ -348,6 +348,15 @@ class GemmSelector : public BaseSelector {
   void UpdateBuilder(NodesToOptimizeIndicesBuilder&) const override;
 };
 
+// Depthwise QLinearConv -> 1x1 pointwise QLinearConv with symmetric int8 filters.
+// The depthwise node is the target and the pointwise node is the single output node.
+class ConvDepthwisePointwiseSelector : public NodeSelector {
+ public:
+  ConvDepthwisePointwiseSelector() = default;
+
+  std::optional<NodesToOptimizeIndices> Select(const GraphViewer& graph_viewer, const Node& node) const override;
+};
+
 }  // namespace QDQ
 }  // namespace onnxruntime
 
@@ -0,0 +1,68 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/scaler_fusion.h"
+
+#include "core/graph/graph_utils.h"
+
+namespace onnxruntime {
+
+Status ImputerScalerFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                      const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (p_node == nullptr) continue;  // we removed the node as part of an earlier fusion
+    Node& imputer_node = *p_node;
+
+    ORT_RETURN_IF_ERROR(Recurse(imputer_node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(imputer_node, "Imputer", {1}, kMLDomain) ||
+        !graph_utils::IsSupportedProvider(imputer_node, GetCompatibleExecutionProviders()) ||
+        imputer_node.GetOutputEdgesCount() != 1 || graph.NodeProducesGraphOutput(imputer_node)) {
+      continue;
+    }
+
+    // The fused kernel handles float features, the ones imputed with imputed_value_floats.
+    const NodeArg& input_arg = *imputer_node.InputDefs()[0];
+    const auto* imputed_values = graph_utils::GetNodeAttribute(imputer_node, "imputed_value_floats");
+    if (input_arg.TypeAsProto() == nullptr ||
+        input_arg.TypeAsProto()->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT ||
+        imputed_values == nullptr || imputed_values->floats_size() == 0) {
+      continue;
+    }
+
+    Node& scaler_node = *graph.GetNode(imputer_node.OutputNodesBegin()->Index());
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(scaler_node, "Scaler", {1}, kMLDomain) ||
+        scaler_node.GetExecutionProviderType() != imputer_node.GetExecutionProviderType()) {
+      continue;
+    }
+
+    const auto* offset = graph_utils::GetNodeAttribute(scaler_node, "offset");
+    const auto* scale = graph_utils::GetNodeAttribute(scaler_node, "scale");
+    if (offset == nullptr || scale == nullptr) {
+      continue;
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("FusedScaler"), "FusedScaler",
+                                     "fused Imputer and Scaler", {imputer_node.MutableInputDefs()[0]}, {},
+                                     nullptr, kMSDomain);
+    fused_node.AddAttributeProto(*imputed_values);
+    const auto* replaced_value = graph_utils::GetNodeAttribute(imputer_node, "replaced_value_float");
+    if (replaced_value != nullptr) {
+      fused_node.AddAttributeProto(*replaced_value);
+    }
+    fused_node.AddAttributeProto(*offset);
+    fused_node.AddAttributeProto(*scale);
+    fused_node.SetExecutionProviderType(imputer_node.GetExecutionProviderType());
+
+    graph_utils::FinalizeNodeFusion(graph, {imputer_node, scaler_node}, fused_node);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
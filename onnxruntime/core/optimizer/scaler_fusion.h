@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ImputerScalerFusion
+
+Fuse ai.onnx.ml Imputer -> Scaler on float features, the numeric preprocessing of converted scikit-learn pipelines,
+to a com.microsoft.FusedScaler node, which imputes and scales each row in one pass.
+*/
+class ImputerScalerFusion : public GraphTransformer {
+ public:
+  ImputerScalerFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ImputerScalerFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -121,6 +121,32 @@ static NodeArg* CastToFloat(Graph& graph, NodeArg* input, int32_t output_data_ty
   return &cast_float;
 }
 
+// Returns true if node is a SimplifiedLayerNormalization that SkipSimplifiedLayerNormalization can replace, which
+// normalizes the last axis of a float or float16 input and has no inv_std_var output.
+static bool IsSimplifiedLayerNorm(const Node& node) {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "SimplifiedLayerNormalization", {1}, kOnnxDomain)) {
+    return false;
+  }
+
+  for (const auto& input_arg : node.InputDefs()) {
+    if (*(input_arg->Type()) == "tensor(bfloat16)") {
+      return false;
+    }
+  }
+
+  if (node.OutputDefs().size() > 1 && node.OutputDefs()[1]->Exists()) {
+    return false;
+  }
+
+  const auto* axis = graph_utils::GetNodeAttribute(node, "axis");
+  if (axis == nullptr) {
+    return true;
+  }
+
+  // The input of the first Add is checked to be 3D, so the last axis is 2.
+  return axis->i() == -1 || axis->i() == 2;
+}
+
 /**
 Skip Layer Normalization will fuse Add + LayerNormalization into one node, and another Add if applicable
 
@@ -158,6 +184,9 @@ After fusion:
           \    /
     SkipLayerNormalization
 
+SimplifiedLayerNormalization, which is produced by SimplifiedLayerNormFusion from the RMSNorm subgraphs of models
+such as LLaMA, is fused the same way into SkipSimplifiedLayerNormalization.
+
 Note: This fusion doesn't consider the following case:
       [Sub1]   [Sub2]
          \       /
@@ -180,7 +209,8 @@ Status SkipLayerNormFusion::ApplyImpl(Graph& graph, bool& modified, int graph_le
     Node& ln_node = *p_layernorm;
     ORT_RETURN_IF_ERROR(Recurse(ln_node, modified, graph_level, logger));
 
-    if (!graph_utils::IsSupportedOptypeVersionAndDomain(ln_node, "LayerNormalization", {1, 17}) ||
+    const bool is_simplified = IsSimplifiedLayerNorm(ln_node);
+    if ((!graph_utils::IsSupportedOptypeVersionAndDomain(ln_node, "LayerNormalization", {1, 17}) && !is_simplified) ||
         !graph_utils::IsSupportedProvider(ln_node, GetCompatibleExecutionProviders()) ||
         !IsSupportedDataType(ln_node)) {
       continue;
@@ -255,11 +285,14 @@ Status SkipLayerNormFusion::ApplyImpl(Graph& graph, bool& modified, int graph_le
 
     NodeArg beta_place_holder("", nullptr);
 
-    // Get the inputs for the new SkipLayerNormalization node.
+    // Get the inputs for the new SkipLayerNormalization node. SkipSimplifiedLayerNormalization has no beta input.
     InlinedVector<NodeArg*> skip_layer_norm_input_defs{p_add1->MutableInputDefs()[0],
                                                        p_add1->MutableInputDefs()[1],
-                                                       ln_node.MutableInputDefs()[1],
-                                                       ln_node.MutableInputDefs().size() == 2 ? &beta_place_holder : ln_node.MutableInputDefs()[2]};
+                                                       ln_node.MutableInputDefs()[1]};
+    if (!is_simplified) {
+      skip_layer_norm_input_defs.push_back(ln_node.MutableInputDefs().size() == 2 ? &beta_place_holder
+                                                                                  : ln_node.MutableInputDefs()[2]);
+    }
 
     if (matched_format == Format::Format1) {
       skip_layer_norm_input_defs[0] = p_add2->MutableInputDefs()[0];
@@ -282,12 +315,13 @@ Status SkipLayerNormFusion::ApplyImpl(Graph& graph, bool& modified, int graph_le
                               ln_node.GetExecutionProviderType());
     }
 
-    Node& skip_layer_norm_node = graph.AddNode(graph.GenerateNodeName("SkipLayerNormalization"),
-                                               "SkipLayerNormalization",
+    const std::string op_type = is_simplified ? "SkipSimplifiedLayerNormalization" : "SkipLayerNormalization";
+    Node& skip_layer_norm_node = graph.AddNode(graph.GenerateNodeName(op_type),
+                                               op_type,
                                                "fused SkipLayerNorm subgraphs ",
                                                skip_layer_norm_input_defs,
                                                ln_node.MutableOutputDefs(), {}, kMSDomain);
-    // Get attribute "epsilon" from "LayerNormalization" node if available. Else, default value
+    // Get attribute "epsilon" from the normalization node if available. Else, default value
     // will be used.
     NodeAttributes ln_attrs = ln_node.GetAttributes();
     NodeAttributes::const_iterator epsilon = ln_attrs.find("epsilon");
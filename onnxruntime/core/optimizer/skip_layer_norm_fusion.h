@@ -11,6 +11,7 @@ namespace onnxruntime {
 @Class SkipLayerNormFusion
 
 Rewrite graph fusing Add + Layer Normalization subgraph to a single SkipLayerNormalization node.
+Add + SimplifiedLayerNormalization is fused to SkipSimplifiedLayerNormalization the same way.
 
 */
 class SkipLayerNormFusion : public GraphTransformer {
@@ -91,6 +91,12 @@ struct ThreadOptions {
   void* custom_thread_creation_options = nullptr;
   OrtCustomJoinThreadFn custom_join_thread_fn = nullptr;
   int dynamic_block_base_ = 0;
+
+  // Schedule ThreadPool::TryParallelFor loops by work stealing, see ThreadPool::TryWorkStealingParallelFor.
+  bool work_stealing_loops_ = false;
+
+  // With spinning allowed, spin only for as long as the next task is predicted to arrive, then block.
+  bool adaptive_spinning_ = false;
 };
 
 std::ostream& operator<<(std::ostream& os, const LogicalProcessors&);
@@ -141,6 +147,25 @@ class Env {
 
   virtual std::vector<LogicalProcessors> GetDefaultThreadAffinities() const = 0;
 
+  /// <summary>
+  /// Classifies the cores of hybrid CPUs, e.g. performance and efficiency cores.
+  /// </summary>
+  /// <returns>The efficiency class of each core returned by GetDefaultThreadAffinities(), in the same order.
+  /// Faster cores have higher classes. Empty if all cores are of the same class or the topology is unknown.</returns>
+  virtual std::vector<uint8_t> GetCoreEfficiencyClasses() const {
+    return {};
+  }
+
+  /// <summary>
+  /// Groups the cores by the last level cache they share, e.g. the CCXs of AMD EPYC CPUs.
+  /// </summary>
+  /// <returns>The cache domain of each core returned by GetDefaultThreadAffinities(), in the same order.
+  /// Domains are numbered from 0 in the order of their first core. Empty if all cores share one cache or the
+  /// topology is unknown.</returns>
+  virtual std::vector<int> GetCoreCacheDomains() const {
+    return {};
+  }
+
   /// \brief Returns the number of micro-seconds since the Unix epoch.
   virtual uint64_t NowMicros() const {
     return env_time_->NowMicros();
@@ -186,6 +211,23 @@ class Env {
   virtual common::Status MapFileIntoMemory(_In_z_ const ORTCHAR_T* file_path, FileOffsetType offset, size_t length,
                                            MappedMemoryPtr& mapped_memory) const = 0;
 
+  /**
+   * Maps a named shared memory segment, so processes that map a segment of the same name share its physical pages.
+   * If no segment of the name exists, it is created and initialize_fn is called to fill it. A process that finds
+   * the segment waits until it was filled.
+   * This is a copy-on-write mapping, so any changes are not visible to other processes.
+   * On Windows the segment exists while a process maps it. On other platforms it exists until the system restarts
+   * or until it is removed with shm_unlink().
+   * @param name The name of the segment. It must not contain path separators.
+   * @param length The length in bytes of the data of the segment.
+   * @param initialize_fn Fills the data of a new segment.
+   * @param[out] mapped_memory A smart pointer to the mapped data which
+   *             unmaps the memory (unless release()'d) when destroyed.
+   */
+  virtual common::Status MapSharedMemory(const std::string& name, size_t length,
+                                         const std::function<void(gsl::span<char>)>& initialize_fn,
+                                         MappedMemoryPtr& mapped_memory) const = 0;
+
 #ifdef _WIN32
   /// \brief Returns true if the directory exists.
   virtual bool FolderExists(const std::wstring& path) const = 0;
@@ -19,6 +19,7 @@ limitations under the License.
 #include <assert.h>
 #include <dlfcn.h>
 #include <fcntl.h>
+#include <signal.h>
 #include <ftw.h>
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -29,8 +30,11 @@ limitations under the License.
 #include <sys/syscall.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <optional>
+#include <sstream>
 #include <thread>
 #include <utility>  // for std::forward
 #include <vector>
@@ -48,6 +52,7 @@ limitations under the License.
 #include "core/common/logging/logging.h"
 #include "core/common/narrow.h"
 #include "core/platform/scoped_resource.h"
+#include "core/platform/shared_memory_header.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
 
 namespace onnxruntime {
@@ -56,6 +61,41 @@ namespace {
 
 constexpr int OneMillion = 1000000;
 
+#if defined(ORT_USE_CPUINFO) && defined(__linux__)
+// Returns the capacity the kernel assigns to a logical processor on asymmetric systems such as ARM big.LITTLE,
+// 1024 for the fastest ones, or -1 if it is not available.
+int ReadCpuCapacity(uint32_t linux_id) {
+  std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(linux_id) + "/cpu_capacity");
+  int capacity = -1;
+  if (!(file >> capacity)) {
+    return -1;
+  }
+  return capacity;
+}
+
+// Returns whether linux_id is in a sysfs cpu list such as "0-7,16,18-19".
+bool IsInCpuList(const std::string& cpu_list, uint32_t linux_id) {
+  std::istringstream stream(cpu_list);
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    unsigned long first = 0;
+    unsigned long last = 0;
+    const auto dash = range.find('-');
+    ORT_TRY {
+      first = std::stoul(range.substr(0, dash));
+      last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+    }
+    ORT_CATCH(const std::exception&) {
+      return false;
+    }
+    if (linux_id >= first && linux_id <= last) {
+      return true;
+    }
+  }
+  return false;
+}
+#endif
+
 class UnmapFileParam {
  public:
   void* addr;
@@ -328,6 +368,74 @@ class PosixEnv : public Env {
     return ret;
   }
 
+  std::vector<uint8_t> GetCoreEfficiencyClasses() const override {
+    std::vector<uint8_t> ret;
+#if defined(ORT_USE_CPUINFO) && defined(__linux__)
+    if (cpuinfo_available_) {
+      // Intel hybrid CPUs list their efficiency cores separately, ARM ones report a capacity per core
+      std::string atom_cpus;
+      std::ifstream atom_cpus_file("/sys/devices/cpu_atom/cpus");
+      std::getline(atom_cpus_file, atom_cpus);
+
+      const auto num_phys_cores = cpuinfo_get_cores_count();
+      std::vector<int> capacities;
+      capacities.reserve(num_phys_cores);
+      for (uint32_t i = 0; i < num_phys_cores; ++i) {
+        const auto linux_id = cpuinfo_get_processor(cpuinfo_get_core(i)->processor_start)->linux_id;
+        int capacity = ReadCpuCapacity(linux_id);
+        if (capacity < 0 && !atom_cpus.empty()) {
+          capacity = IsInCpuList(atom_cpus, linux_id) ? 0 : 1;
+        }
+        if (capacity < 0) {
+          return ret;
+        }
+        capacities.push_back(capacity);
+      }
+
+      // number the distinct capacities from the slowest to the fastest
+      std::vector<int> classes = capacities;
+      std::sort(classes.begin(), classes.end());
+      classes.erase(std::unique(classes.begin(), classes.end()), classes.end());
+      if (classes.size() > 1) {
+        ret.reserve(capacities.size());
+        for (int capacity : capacities) {
+          const auto efficiency_class = std::lower_bound(classes.begin(), classes.end(), capacity) - classes.begin();
+          ret.push_back(static_cast<uint8_t>(std::min<ptrdiff_t>(efficiency_class, UINT8_MAX)));
+        }
+      }
+    }
+#endif
+    return ret;
+  }
+
+  std::vector<int> GetCoreCacheDomains() const override {
+    std::vector<int> ret;
+#if defined(ORT_USE_CPUINFO) && defined(__linux__)
+    if (cpuinfo_available_) {
+      // cores that share the last level cache point to the same cpuinfo_cache
+      const auto num_phys_cores = cpuinfo_get_cores_count();
+      std::vector<const cpuinfo_cache*> domains;
+      ret.reserve(num_phys_cores);
+      for (uint32_t i = 0; i < num_phys_cores; ++i) {
+        const auto& cache = cpuinfo_get_processor(cpuinfo_get_core(i)->processor_start)->cache;
+        const cpuinfo_cache* last_level_cache = cache.l3 != nullptr ? cache.l3 : cache.l2;
+        if (last_level_cache == nullptr) {
+          return {};
+        }
+        auto domain = std::find(domains.begin(), domains.end(), last_level_cache);
+        if (domain == domains.end()) {
+          domain = domains.insert(domains.end(), last_level_cache);
+        }
+        ret.push_back(static_cast<int>(domain - domains.begin()));
+      }
+      if (domains.size() <= 1) {
+        ret.clear();
+      }
+    }
+#endif
+    return ret;
+  }
+
   void SleepForMicroseconds(int64_t micros) const override {
     while (micros > 0) {
       timespec sleep_time;
@@ -460,6 +568,101 @@ class PosixEnv : public Env {
     return Status::OK();
   }
 
+  Status MapSharedMemory(const std::string& name, size_t length,
+                         const std::function<void(gsl::span<char>)>& initialize_fn,
+                         MappedMemoryPtr& mapped_memory) const override {
+#if defined(__ANDROID__)
+    ORT_UNUSED_PARAMETER(name);
+    ORT_UNUSED_PARAMETER(length);
+    ORT_UNUSED_PARAMETER(initialize_fn);
+    ORT_UNUSED_PARAMETER(mapped_memory);
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "POSIX shared memory is not available on Android");
+#else
+    ORT_RETURN_IF(name.empty() || name.find('/') != std::string::npos, "Invalid shared memory name: ", name);
+    const std::string shm_name = "/" + name;
+    const size_t mapped_length = kSharedMemoryDataOffset + length;
+
+    // the first process to create the segment fills it through a shared mapping
+    ScopedFileDescriptor created{shm_open(shm_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644)};
+    if (created.IsValid()) {
+      if (ftruncate(created.Get(), static_cast<off_t>(mapped_length)) != 0) {
+        auto status = ReportSystemError("ftruncate", shm_name);
+        shm_unlink(shm_name.c_str());
+        return status;
+      }
+      void* const base = mmap(nullptr, mapped_length, PROT_READ | PROT_WRITE, MAP_SHARED, created.Get(), 0);
+      if (base == MAP_FAILED) {
+        auto status = ReportSystemError("mmap", shm_name);
+        shm_unlink(shm_name.c_str());
+        return status;
+      }
+      auto* header = static_cast<SharedMemoryHeader*>(base);
+      header->length = length;
+      header->creator_pid = getpid();
+      initialize_fn(gsl::make_span(static_cast<char*>(base) + kSharedMemoryDataOffset, length));
+      header->state.store(SharedMemoryHeader::kReady, std::memory_order_release);
+      munmap(base, mapped_length);
+    } else if (errno != EEXIST) {
+      return ReportSystemError("shm_open", shm_name);
+    }
+
+    ScopedFileDescriptor file_descriptor{created.IsValid() ? created.Release()
+                                                           : shm_open(shm_name.c_str(), O_RDONLY, 0)};
+    if (!file_descriptor.IsValid()) {
+      return ReportSystemError("shm_open", shm_name);
+    }
+
+    // wait for the creator to size and fill the segment
+    const auto deadline = std::chrono::steady_clock::now() + kSharedMemoryFillTimeout;
+    for (;;) {
+      struct stat sb;
+      if (fstat(file_descriptor.Get(), &sb) != 0) {
+        return ReportSystemError("fstat", shm_name);
+      }
+      if (static_cast<size_t>(sb.st_size) >= kSharedMemoryDataOffset) {
+        void* const base = mmap(nullptr, kSharedMemoryDataOffset, PROT_READ, MAP_SHARED, file_descriptor.Get(), 0);
+        if (base == MAP_FAILED) {
+          return ReportSystemError("mmap", shm_name);
+        }
+        const auto* header = static_cast<const SharedMemoryHeader*>(base);
+        const bool ready = header->state.load(std::memory_order_acquire) == SharedMemoryHeader::kReady;
+        const uint64_t segment_length = header->length;
+        const auto creator_pid = static_cast<pid_t>(header->creator_pid);
+        munmap(base, kSharedMemoryDataOffset);
+
+        if (ready) {
+          ORT_RETURN_IF(segment_length != length, "Shared memory segment ", shm_name, " has ", segment_length,
+                        " bytes, expected ", length);
+          break;
+        }
+        if (creator_pid != 0 && kill(creator_pid, 0) != 0 && errno == ESRCH) {
+          // remove the segment so the next process recreates it
+          shm_unlink(shm_name.c_str());
+          return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The process that created shared memory segment ", shm_name,
+                                 " exited before filling it");
+        }
+      }
+      if (std::chrono::steady_clock::now() > deadline) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Timed out waiting for shared memory segment ", shm_name,
+                               " to be filled");
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    void* const mapped_base =
+        mmap(nullptr, mapped_length, PROT_READ | PROT_WRITE, MAP_PRIVATE, file_descriptor.Get(), 0);
+    if (mapped_base == MAP_FAILED) {
+      return ReportSystemError("mmap", shm_name);
+    }
+
+    mapped_memory =
+        MappedMemoryPtr{reinterpret_cast<char*>(mapped_base) + kSharedMemoryDataOffset,
+                        OrtCallbackInvoker{OrtCallback{UnmapFile, new UnmapFileParam{mapped_base, mapped_length}}}};
+
+    return Status::OK();
+#endif
+  }
+
   static common::Status ReportSystemError(const char* operation_name, const std::string& path) {
     auto [err_no, err_msg] = GetSystemError();
     std::ostringstream oss;
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace onnxruntime {
+
+// Header at the start of a shared memory segment mapped by Env::MapSharedMemory().
+// The process that creates the segment sets state to kReady once the data was written.
+struct SharedMemoryHeader {
+  static constexpr uint64_t kFilling = 0;
+  static constexpr uint64_t kReady = 1;
+
+  std::atomic<uint64_t> state;
+  uint64_t length;
+  // lets a waiting process detect a segment whose creator exited before filling it
+  int64_t creator_pid;
+};
+
+// offset of the data in the segment, which keeps it aligned for vector loads
+constexpr size_t kSharedMemoryDataOffset = 64;
+static_assert(sizeof(SharedMemoryHeader) <= kSharedMemoryDataOffset);
+
+// how long a process waits for another process to fill a segment
+constexpr std::chrono::seconds kSharedMemoryFillTimeout{60};
+
+}  // namespace onnxruntime
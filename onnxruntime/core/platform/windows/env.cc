@@ -32,6 +32,7 @@ limitations under the License.
 #include "core/common/span_utils.h"
 #include "core/platform/env.h"
 #include "core/platform/scoped_resource.h"
+#include "core/platform/shared_memory_header.h"
 #include <unsupported/Eigen/CXX11/ThreadPool>
 #include <wil/Resource.h>
 
@@ -260,6 +261,10 @@ std::vector<LogicalProcessors> WindowsEnv::GetDefaultThreadAffinities() const {
   return cores_.empty() ? std::vector<LogicalProcessors>(DefaultNumCores(), LogicalProcessors{}) : cores_;
 }
 
+std::vector<uint8_t> WindowsEnv::GetCoreEfficiencyClasses() const {
+  return core_efficiency_classes_;
+}
+
 WindowsEnv& WindowsEnv::Instance() {
   static WindowsEnv default_env;
   return default_env;
@@ -439,6 +444,88 @@ Status WindowsEnv::MapFileIntoMemory(_In_z_ const ORTCHAR_T* file_path,
   return Status::OK();
 }
 
+Status WindowsEnv::MapSharedMemory(const std::string& name, size_t length,
+                                   const std::function<void(gsl::span<char>)>& initialize_fn,
+                                   MappedMemoryPtr& mapped_memory) const {
+  ORT_RETURN_IF(name.empty() || name.find('\\') != std::string::npos, "Invalid shared memory name: ", name);
+  const std::wstring mapping_name = ToWideString("Local\\" + name);
+  const uint64_t mapped_length = kSharedMemoryDataOffset + static_cast<uint64_t>(length);
+
+  // the section is backed by the paging file and lives as long as any process has a handle or view of it
+  wil::unique_handle file_mapping_handle{
+      CreateFileMappingW(INVALID_HANDLE_VALUE,
+                         nullptr,
+                         PAGE_READWRITE,
+                         static_cast<DWORD>(mapped_length >> 32),
+                         static_cast<DWORD>(mapped_length & 0xFFFFFFFF),
+                         mapping_name.c_str())};
+  const auto create_error = GetLastError();
+  if (!file_mapping_handle) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                           "create file mapping ", name,
+                           " fail, errcode = ", create_error,
+                           " - ", std::system_category().message(create_error));
+  }
+
+  if (create_error != ERROR_ALREADY_EXISTS) {
+    void* const base = MapViewOfFile(file_mapping_handle.get(), FILE_MAP_WRITE, 0, 0, 0);
+    if (base == nullptr) {
+      const auto error_code = GetLastError();
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                             "map view of file mapping ", name,
+                             " fail, errcode = ", error_code,
+                             " - ", std::system_category().message(error_code));
+    }
+    auto* header = static_cast<SharedMemoryHeader*>(base);
+    header->length = length;
+    header->creator_pid = static_cast<int64_t>(GetCurrentProcessId());
+    initialize_fn(gsl::make_span(static_cast<char*>(base) + kSharedMemoryDataOffset, length));
+    header->state.store(SharedMemoryHeader::kReady, std::memory_order_release);
+    UnmapViewOfFile(base);
+  } else {
+    // wait for the creator to fill the section
+    void* const base = MapViewOfFile(file_mapping_handle.get(), FILE_MAP_READ, 0, 0, kSharedMemoryDataOffset);
+    if (base == nullptr) {
+      const auto error_code = GetLastError();
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                             "map view of file mapping ", name,
+                             " fail, errcode = ", error_code,
+                             " - ", std::system_category().message(error_code));
+    }
+    const auto* header = static_cast<const SharedMemoryHeader*>(base);
+    const auto deadline = std::chrono::steady_clock::now() + kSharedMemoryFillTimeout;
+    while (header->state.load(std::memory_order_acquire) != SharedMemoryHeader::kReady &&
+           std::chrono::steady_clock::now() < deadline) {
+      Sleep(1);
+    }
+    const bool ready = header->state.load(std::memory_order_acquire) == SharedMemoryHeader::kReady;
+    const uint64_t segment_length = header->length;
+    UnmapViewOfFile(base);
+
+    ORT_RETURN_IF_NOT(ready, "Timed out waiting for shared memory segment ", name, " to be filled");
+    ORT_RETURN_IF(segment_length != length, "Shared memory segment ", name, " has ", segment_length,
+                  " bytes, expected ", length);
+  }
+
+  // a copy-on-write view, so writes to the tensor stay private to this process
+  void* const mapped_base = MapViewOfFile(file_mapping_handle.get(), FILE_MAP_COPY, 0, 0, 0);
+  if (mapped_base == nullptr) {
+    const auto error_code = GetLastError();
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                           "map view of file mapping ", name,
+                           " fail, errcode = ", error_code,
+                           " - ", std::system_category().message(error_code));
+  }
+
+  GSL_SUPPRESS(r.11)
+  mapped_memory =
+      MappedMemoryPtr{reinterpret_cast<char*>(mapped_base) + kSharedMemoryDataOffset,
+                      OrtCallbackInvoker{OrtCallback{UnmapFile, new UnmapFileParam{mapped_base,
+                                                                                   static_cast<size_t>(mapped_length)}}}};
+
+  return Status::OK();
+}
+
 bool WindowsEnv::FolderExists(const std::wstring& path) const {
   DWORD attributes = GetFileAttributesW(path.c_str());
   return (attributes != INVALID_FILE_ATTRIBUTES) && (attributes & FILE_ATTRIBUTE_DIRECTORY);
@@ -890,10 +977,17 @@ void WindowsEnv::InitializeCpuInfo() {
         }
       }
       cores_.push_back(std::move(core_global_proc_ids));
+      // higher classes are more performant. all cores have class 0 on CPUs that are not hybrid.
+      core_efficiency_classes_.push_back(processor_info->Processor.EfficiencyClass);
       core_id++;
     }
     iter += size;
   }
+
+  if (std::all_of(core_efficiency_classes_.begin(), core_efficiency_classes_.end(),
+                  [this](uint8_t c) { return c == core_efficiency_classes_.front(); })) {
+    core_efficiency_classes_.clear();
+  }
   if (logging::LoggingManager::HasDefaultLogger()) {
     LOGS_DEFAULT(VERBOSE) << "Found total " << cores_.size() << " core(s) from windows system:";
     LOGS_DEFAULT(VERBOSE) << log_stream.str();
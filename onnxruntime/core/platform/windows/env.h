@@ -55,6 +55,7 @@ class WindowsEnv : public Env {
   static int DefaultNumCores();
   int GetNumPhysicalCpuCores() const override;
   std::vector<LogicalProcessors> GetDefaultThreadAffinities() const override;
+  std::vector<uint8_t> GetCoreEfficiencyClasses() const override;
   static WindowsEnv& Instance();
   PIDType GetSelfPid() const override;
   Status GetFileLength(_In_z_ const ORTCHAR_T* file_path, size_t& length) const override;
@@ -65,6 +66,9 @@ class WindowsEnv : public Env {
                            FileOffsetType offset,
                            size_t length,
                            MappedMemoryPtr& mapped_memory) const override;
+  Status MapSharedMemory(const std::string& name, size_t length,
+                         const std::function<void(gsl::span<char>)>& initialize_fn,
+                         MappedMemoryPtr& mapped_memory) const override;
   bool FolderExists(const std::wstring& path) const override;
   bool FolderExists(const std::string& path) const override;
   common::Status CreateFolder(const std::wstring& path) const override;
@@ -113,6 +117,8 @@ class WindowsEnv : public Env {
    * }
    */
   std::vector<LogicalProcessors> cores_;
+  // efficiency class of each core in cores_, empty if all cores have the same class
+  std::vector<uint8_t> core_efficiency_classes_;
   /*
    * "global_processor_info_map_" is a map of:
    * global_processor_id <--> (group_id, local_processor_id)
@@ -9,6 +9,7 @@
 #error "This file should only be included when building on Apple platforms."
 #endif
 
+#include "coreml/MIL.pb.h"
 #include "coreml/Model.pb.h"
 
 namespace COREML_SPEC = CoreML::Specification;
@@ -77,6 +77,11 @@ BaseOpBuilder::CreateNNLayer(const std::string& layer_name) {
 
 bool BaseOpBuilder::IsOpSupported(const Node& node, const OpBuilderInputParams& input_params,
                                   const logging::Logger& logger) const {
+  if (input_params.create_mlprogram && !SupportsMLProgram()) {
+    LOGS(logger, VERBOSE) << "Operator [" << node.OpType() << "] is not supported in an MLProgram";
+    return false;
+  }
+
   if (!HasSupportedInputs(node, input_params, logger))
     return false;
 
@@ -42,6 +42,9 @@ class BaseOpBuilder : public IOpBuilder {
   bool IsOpSupported(const Node& node, const OpBuilderInputParams& input_params,
                      const logging::Logger& logger) const override final;
 
+  // Op builders which can add their operator to an MLProgram override this
+  bool SupportsMLProgram() const override { return false; }
+
  protected:
   virtual bool IsOpSupportedImpl(const Node& /* node */, const OpBuilderInputParams& /* input_params */,
                                  const logging::Logger& /* logger */) const {
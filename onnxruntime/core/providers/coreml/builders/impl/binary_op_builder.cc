@@ -7,6 +7,7 @@
 #include "core/providers/shared/utils/utils.h"
 #ifdef __APPLE__
 #include "core/framework/tensorprotoutils.h"
+#include "core/providers/coreml/builders/impl/builder_utils.h"
 #include "core/providers/coreml/builders/model_builder.h"
 #endif
 
@@ -26,6 +27,8 @@ class BinaryOpBuilder : public BaseOpBuilder {
   int GetMinSupportedOpSet(const Node& node) const override;
 
   bool HasSupportedInputsImpl(const Node& node, const logging::Logger& logger) const override;
+
+  bool SupportsMLProgram() const override { return true; }
 };
 
 #ifdef __APPLE__
@@ -65,6 +68,34 @@ Status BinaryOpBuilder::AddToModelBuilderImpl(ModelBuilder& model_builder, const
   const auto& op_type(node.OpType());
   const auto& input_defs(node.InputDefs());
 
+  if (model_builder.CreateMLProgram()) {
+    std::string_view coreml_op_type;
+    if (op_type == "Add") {
+      coreml_op_type = "add";
+    } else if (op_type == "Mul") {
+      coreml_op_type = "mul";
+    } else if (op_type == "Sub") {
+      coreml_op_type = "sub";
+    } else if (op_type == "Div") {
+      // real_div is the floating point division, div rounds toward negative infinity for integers
+      coreml_op_type = "real_div";
+    } else if (op_type == "Pow") {
+      coreml_op_type = "pow";
+    } else {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "BinaryOpBuilder::AddToModelBuilderImpl, unknown op: ", op_type);
+    }
+
+    // the elementwise binary operations broadcast their inputs
+    std::unique_ptr<COREML_SPEC::MILSpec::Operation> op = model_builder.CreateOperation(node, coreml_op_type);
+    AddOperationInput(*op, "x", input_defs[0]->Name());
+    AddOperationInput(*op, "y", input_defs[1]->Name());
+    AddOperationOutput(*op, *node.OutputDefs()[0]);
+
+    model_builder.AddOperation(std::move(op));
+    return Status::OK();
+  }
+
   std::unique_ptr<COREML_SPEC::NeuralNetworkLayer> layer = CreateNNLayer(model_builder, node);
 
   if (op_type == "Add") {
@@ -5,8 +5,13 @@
 
 #include "core/providers/coreml/builders/impl/builder_utils.h"
 
+#include <algorithm>
+#include <type_traits>
+
 #include "core/common/narrow.h"
+#include "core/common/span_utils.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/graph/node_arg.h"
 #include "core/providers/coreml/builders/helper.h"
 #include "core/providers/shared/utils/utils.h"
 #include "core/optimizer/initializer.h"
@@ -133,6 +138,182 @@ void CreateCoreMLWeight(CoreML::Specification::WeightParams& weight, gsl::span<c
   CreateCoreMLWeightConvertingDataToFloats(weight, data);
 }
 
+//
+// MLProgram utils
+//
+
+COREML_SPEC::MILSpec::DataType OnnxDataTypeToMILSpec(int onnx_type) {
+  switch (static_cast<ONNX_NAMESPACE::TensorProto_DataType>(onnx_type)) {
+    case ONNX_NAMESPACE::TensorProto_DataType_BOOL:
+      return COREML_SPEC::MILSpec::DataType::BOOL;
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT:
+      return COREML_SPEC::MILSpec::DataType::FLOAT32;
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT16:
+      return COREML_SPEC::MILSpec::DataType::FLOAT16;
+    case ONNX_NAMESPACE::TensorProto_DataType_INT32:
+    case ONNX_NAMESPACE::TensorProto_DataType_INT64:
+      return COREML_SPEC::MILSpec::DataType::INT32;
+    case ONNX_NAMESPACE::TensorProto_DataType_STRING:
+      return COREML_SPEC::MILSpec::DataType::STRING;
+    default:
+      ORT_THROW("Unsupported data type: ", onnx_type);
+  }
+}
+
+void SetTensorTypeInfo(COREML_SPEC::MILSpec::TensorType& tensor_type, COREML_SPEC::MILSpec::DataType data_type,
+                       std::optional<gsl::span<const int64_t>> shape) {
+  tensor_type.set_datatype(data_type);
+  if (shape) {
+    tensor_type.set_rank(shape->size());
+    for (const auto dim : *shape) {
+      if (dim >= 0) {
+        tensor_type.add_dimensions()->mutable_constant()->set_size(narrow<uint64_t>(dim));
+      } else {
+        tensor_type.add_dimensions()->mutable_unknown()->set_variadic(false);
+      }
+    }
+  }
+}
+
+namespace {
+template <typename T>
+COREML_SPEC::MILSpec::DataType DataTypeToMILSpec() {
+  if constexpr (std::is_same_v<T, float>) {
+    return COREML_SPEC::MILSpec::DataType::FLOAT32;
+  } else if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>) {
+    return COREML_SPEC::MILSpec::DataType::INT32;
+  } else if constexpr (std::is_same_v<T, bool>) {
+    return COREML_SPEC::MILSpec::DataType::BOOL;
+  } else {
+    static_assert(std::is_same_v<T, std::string>, "Unsupported data type");
+    return COREML_SPEC::MILSpec::DataType::STRING;
+  }
+}
+
+void CopyDataToTensorValue(COREML_SPEC::MILSpec::TensorValue& tensor_value, gsl::span<const float> data) {
+  tensor_value.mutable_floats()->mutable_values()->Assign(data.begin(), data.end());
+}
+
+void CopyDataToTensorValue(COREML_SPEC::MILSpec::TensorValue& tensor_value, gsl::span<const int32_t> data) {
+  tensor_value.mutable_ints()->mutable_values()->Assign(data.begin(), data.end());
+}
+
+void CopyDataToTensorValue(COREML_SPEC::MILSpec::TensorValue& tensor_value, gsl::span<const int64_t> data) {
+  auto& values = *tensor_value.mutable_ints()->mutable_values();
+  values.Reserve(narrow<int>(data.size()));
+  std::transform(data.begin(), data.end(), google::protobuf::RepeatedFieldBackInserter(&values),
+                 [](int64_t v) { return narrow<int32_t>(v); });
+}
+
+void CopyDataToTensorValue(COREML_SPEC::MILSpec::TensorValue& tensor_value, gsl::span<const bool> data) {
+  tensor_value.mutable_bools()->mutable_values()->Assign(data.begin(), data.end());
+}
+
+void CopyDataToTensorValue(COREML_SPEC::MILSpec::TensorValue& tensor_value, gsl::span<const std::string> data) {
+  auto& values = *tensor_value.mutable_strings()->mutable_values();
+  for (const auto& v : data) {
+    *values.Add() = v;
+  }
+}
+}  // namespace
+
+template <typename T>
+COREML_SPEC::MILSpec::Value CreateTensorValue(gsl::span<const T> data,
+                                              std::optional<gsl::span<const int64_t>> shape) {
+  COREML_SPEC::MILSpec::Value value;
+  auto& tensor_type = *value.mutable_type()->mutable_tensortype();
+
+  if (shape) {
+    SetTensorTypeInfo(tensor_type, DataTypeToMILSpec<T>(), shape);
+  } else {
+    // infer as 1D shape
+    const int64_t num_elements = narrow<int64_t>(data.size());
+    SetTensorTypeInfo(tensor_type, DataTypeToMILSpec<T>(), AsSpan({num_elements}));
+  }
+
+  CopyDataToTensorValue(*value.mutable_immediatevalue()->mutable_tensor(), data);
+  return value;
+}
+
+template <typename T>
+COREML_SPEC::MILSpec::Value CreateScalarTensorValue(const T& data) {
+  gsl::span<const T> data_span{&data, 1};
+  gsl::span<const int64_t> shape{};  // empty for a scalar
+  return CreateTensorValue(data_span, shape);
+}
+
+// explicit instantiations for the types the op builders use
+template COREML_SPEC::MILSpec::Value CreateTensorValue(gsl::span<const float> data,
+                                                       std::optional<gsl::span<const int64_t>> shape);
+template COREML_SPEC::MILSpec::Value CreateTensorValue(gsl::span<const int32_t> data,
+                                                       std::optional<gsl::span<const int64_t>> shape);
+template COREML_SPEC::MILSpec::Value CreateTensorValue(gsl::span<const int64_t> data,
+                                                       std::optional<gsl::span<const int64_t>> shape);
+template COREML_SPEC::MILSpec::Value CreateTensorValue(gsl::span<const bool> data,
+                                                       std::optional<gsl::span<const int64_t>> shape);
+
+template COREML_SPEC::MILSpec::Value CreateScalarTensorValue(const float& data);
+template COREML_SPEC::MILSpec::Value CreateScalarTensorValue(const int32_t& data);
+template COREML_SPEC::MILSpec::Value CreateScalarTensorValue(const bool& data);
+template COREML_SPEC::MILSpec::Value CreateScalarTensorValue(const std::string& data);
+
+Status CreateTensorValue(const ONNX_NAMESPACE::TensorProto& tensor, COREML_SPEC::MILSpec::Value& value) {
+  const auto& dims = tensor.dims();
+  const std::vector<int64_t> shape(dims.begin(), dims.end());
+  Initializer unpacked_tensor(tensor);
+
+  switch (tensor.data_type()) {
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT:
+      value = CreateTensorValue(unpacked_tensor.DataAsSpan<float>(), AsSpan(shape));
+      break;
+    case ONNX_NAMESPACE::TensorProto_DataType_INT32:
+      value = CreateTensorValue(unpacked_tensor.DataAsSpan<int32_t>(), AsSpan(shape));
+      break;
+    case ONNX_NAMESPACE::TensorProto_DataType_INT64:
+      value = CreateTensorValue(unpacked_tensor.DataAsSpan<int64_t>(), AsSpan(shape));
+      break;
+    case ONNX_NAMESPACE::TensorProto_DataType_BOOL:
+      value = CreateTensorValue(unpacked_tensor.DataAsSpan<bool>(), AsSpan(shape));
+      break;
+    default:
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "The initializer of graph has unsupported type, name: ",
+                             tensor.name(), " type: ", tensor.data_type());
+  }
+
+  return Status::OK();
+}
+
+void AddOperationInput(COREML_SPEC::MILSpec::Operation& op, std::string_view input_name, std::string_view value_name) {
+  COREML_SPEC::MILSpec::Argument arg;
+  arg.mutable_arguments()->Add()->set_name(std::string(value_name));
+
+  (*op.mutable_inputs())[std::string(input_name)] = std::move(arg);
+}
+
+void AddOperationOutput(COREML_SPEC::MILSpec::Operation& op, const NodeArg& output) {
+  std::optional<std::vector<int64_t>> shape;
+  if (const auto* shape_proto = output.Shape()) {
+    shape.emplace();
+    shape->reserve(shape_proto->dim_size());
+    for (const auto& dim : shape_proto->dim()) {
+      shape->push_back(utils::HasDimValue(dim) ? dim.dim_value() : -1);
+    }
+  }
+
+  AddIntermediateOperationOutput(op, output.Name(), output.TypeAsProto()->tensor_type().elem_type(),
+                                 shape ? std::optional<gsl::span<const int64_t>>(AsSpan(*shape)) : std::nullopt);
+}
+
+void AddIntermediateOperationOutput(COREML_SPEC::MILSpec::Operation& op, std::string_view output_name,
+                                    int32_t element_type, std::optional<gsl::span<const int64_t>> shape) {
+  auto& outputs = *op.mutable_outputs();
+  auto& output_arg = *outputs.Add();
+  output_arg.set_name(std::string(output_name));
+
+  SetTensorTypeInfo(*output_arg.mutable_type()->mutable_tensortype(), OnnxDataTypeToMILSpec(element_type), shape);
+}
+
 }  // namespace coreml
 }  // namespace onnxruntime
 
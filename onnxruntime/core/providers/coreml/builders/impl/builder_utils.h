@@ -7,16 +7,19 @@
 
 #ifdef __APPLE__
 
+#include <optional>
+#include <string>
+#include <string_view>
+
 #include "core/common/gsl.h"
 #include "core/common/status.h"
 #include "core/graph/basic_types.h"
 #include "core/providers/common.h"
+#include "core/providers/coreml/builders/coreml_spec.h"
 
-namespace CoreML {
-namespace Specification {
-class WeightParams;
-}
-}  // namespace CoreML
+namespace onnxruntime {
+class NodeArg;
+}  // namespace onnxruntime
 
 namespace onnxruntime {
 namespace coreml {
@@ -44,6 +47,42 @@ void CreateCoreMLWeight(CoreML::Specification::WeightParams& weight, gsl::span<c
 // Copy the int64_t array to a coreml weight
 void CreateCoreMLWeight(CoreML::Specification::WeightParams& weight, gsl::span<const int64_t> data);
 
+//
+// MLProgram utils
+//
+
+// Get the MILSpec data type for an ONNX data type. int64 is mapped to int32, which is what the CoreML operations use.
+COREML_SPEC::MILSpec::DataType OnnxDataTypeToMILSpec(int onnx_type);
+
+// Set the data type and the shape of a tensor type. Dynamic dimensions (-1) are unknown dimensions.
+// Without a shape the rank of the tensor is unknown.
+void SetTensorTypeInfo(COREML_SPEC::MILSpec::TensorType& tensor_type, COREML_SPEC::MILSpec::DataType data_type,
+                       std::optional<gsl::span<const int64_t>> shape);
+
+// Create a tensor value with the data. The shape defaults to a 1D tensor of the size of the data.
+// int64_t data is stored as int32.
+template <typename T>
+COREML_SPEC::MILSpec::Value CreateTensorValue(gsl::span<const T> data,
+                                              std::optional<gsl::span<const int64_t>> shape = std::nullopt);
+
+// Create a scalar tensor value (rank 0)
+template <typename T>
+COREML_SPEC::MILSpec::Value CreateScalarTensorValue(const T& data);
+
+// Create a tensor value with the data of an ONNX initializer
+Status CreateTensorValue(const ONNX_NAMESPACE::TensorProto& tensor, COREML_SPEC::MILSpec::Value& value);
+
+// Add an input to the operation, which is bound to the value with the name value_name
+void AddOperationInput(COREML_SPEC::MILSpec::Operation& op, std::string_view input_name, std::string_view value_name);
+
+// Add an output of the operation for the ONNX node arg
+void AddOperationOutput(COREML_SPEC::MILSpec::Operation& op, const NodeArg& output);
+
+// Add an output of the operation for a value between the operations that an ONNX node is decomposed into.
+// element_type uses TensorProto::DataType.
+void AddIntermediateOperationOutput(COREML_SPEC::MILSpec::Operation& op, std::string_view output_name,
+                                    int32_t element_type, std::optional<gsl::span<const int64_t>> shape);
+
 }  // namespace coreml
 }  // namespace onnxruntime
 
@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/common.h"
+#include "core/providers/coreml/builders/helper.h"
+#include "core/providers/coreml/builders/impl/base_op_builder.h"
+#include "core/providers/coreml/builders/op_builder_factory.h"
+#include "core/providers/shared/utils/utils.h"
+
+#ifdef __APPLE__
+#include "core/providers/coreml/builders/impl/builder_utils.h"
+#include "core/providers/coreml/builders/model_builder.h"
+#endif
+
+namespace onnxruntime {
+namespace coreml {
+
+// Handles the ONNX Gelu (opset 20) and the com.microsoft Gelu, which is the ONNX Gelu without approximation
+class GeluOpBuilder : public BaseOpBuilder {
+  // Add operator related
+#ifdef __APPLE__
+ private:
+  Status AddToModelBuilderImpl(ModelBuilder& model_builder, const Node& node,
+                               const logging::Logger& logger) const override;
+#endif
+
+  // Operator support related
+ private:
+  bool IsOpSupportedImpl(const Node& node, const OpBuilderInputParams& input_params,
+                         const logging::Logger& logger) const override;
+
+  bool SupportsMLProgram() const override { return true; }
+};
+
+// Add operator related
+
+#ifdef __APPLE__
+Status GeluOpBuilder::AddToModelBuilderImpl(ModelBuilder& model_builder, const Node& node,
+                                            const logging::Logger& /* logger */) const {
+  NodeAttrHelper helper(node);
+  const auto approximate = helper.Get("approximate", std::string("none"));
+  const std::string mode = approximate == "tanh" ? "TANH_APPROXIMATION" : "EXACT";
+
+  std::unique_ptr<COREML_SPEC::MILSpec::Operation> op = model_builder.CreateOperation(node, "gelu");
+  AddOperationInput(*op, "x", node.InputDefs()[0]->Name());
+  AddOperationInput(*op, "mode", model_builder.AddScalarConstant(op->type(), "mode", mode));
+  AddOperationOutput(*op, *node.OutputDefs()[0]);
+
+  model_builder.AddOperation(std::move(op));
+  return Status::OK();
+}
+#endif
+
+// Operator support related
+
+bool GeluOpBuilder::IsOpSupportedImpl(const Node& /* node */, const OpBuilderInputParams& input_params,
+                                      const logging::Logger& logger) const {
+  if (!input_params.create_mlprogram) {
+    LOGS(logger, VERBOSE) << "Gelu is only supported in an MLProgram";
+    return false;
+  }
+
+  return true;
+}
+
+void CreateGeluOpBuilder(const std::string& op_type, OpBuilderRegistrations& op_registrations) {
+  op_registrations.builders.push_back(std::make_unique<GeluOpBuilder>());
+  op_registrations.op_builder_map.emplace(op_type, op_registrations.builders.back().get());
+}
+
+}  // namespace coreml
+}  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/common/safeint.h"
+#include "core/common/span_utils.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/optimizer/initializer.h"
 #include "core/providers/common.h"
@@ -34,6 +35,8 @@ class GemmOpBuilder : public BaseOpBuilder {
  private:
   bool IsOpSupportedImpl(const Node& /* node */, const OpBuilderInputParams& /* input_params */,
                          const logging::Logger& /* logger */) const override;
+
+  bool SupportsMLProgram() const override { return true; }
 };
 
 // Add operator related
@@ -42,6 +45,11 @@ class GemmOpBuilder : public BaseOpBuilder {
 void GemmOpBuilder::AddInitializersToSkip(ModelBuilder& model_builder, const Node& node) const {
   const auto& op = node.OpType();
   const auto& input_defs(node.InputDefs());
+  if (model_builder.CreateMLProgram() && op == "MatMul") {
+    // the inputs of matmul are regular values
+    return;
+  }
+
   // We have already embedded the weights (matrix B and C(if any)) into the coreml layer
   // No need to copy them later to reduce memory consumption
   model_builder.AddInitializerToSkip(input_defs[1]->Name());
@@ -71,10 +79,56 @@ static Status GetTensorFloatDataTransposed(const ONNX_NAMESPACE::TensorProto& te
 
 Status GemmOpBuilder::AddToModelBuilderImpl(ModelBuilder& model_builder, const Node& node,
                                             const logging::Logger& /* logger */) const {
-  std::unique_ptr<COREML_SPEC::NeuralNetworkLayer> layer = CreateNNLayer(model_builder, node);
-
   const auto& op_type = node.OpType();
   const auto& input_defs = node.InputDefs();
+
+  if (model_builder.CreateMLProgram()) {
+    std::unique_ptr<COREML_SPEC::MILSpec::Operation> op;
+    if (op_type == "MatMul") {
+      // matmul broadcasts the batch dimensions of its inputs like ONNX MatMul
+      op = model_builder.CreateOperation(node, "matmul");
+      AddOperationInput(*op, "x", input_defs[0]->Name());
+      AddOperationInput(*op, "y", input_defs[1]->Name());
+    } else {  // Gemm
+      // linear computes x * weight' + bias, where weight has the shape {N, K}
+      const auto& b_tensor = *model_builder.GetInitializerTensors().at(input_defs[1]->Name());
+      const auto& b_shape = b_tensor.dims();
+
+      NodeAttrHelper helper(node);
+      const auto transB = helper.Get("transB", 0);
+      std::vector<float> weight;
+      std::vector<int64_t> weight_shape;
+      if (transB == 0) {
+        ORT_RETURN_IF_ERROR(GetTensorFloatDataTransposed(b_tensor, weight));
+        weight_shape = {b_shape[1], b_shape[0]};
+      } else {
+        Initializer unpacked_tensor(b_tensor);
+        const auto b_data = unpacked_tensor.DataAsSpan<float>();
+        weight.assign(b_data.begin(), b_data.end());
+        weight_shape = {b_shape[0], b_shape[1]};
+      }
+
+      op = model_builder.CreateOperation(node, "linear");
+      AddOperationInput(*op, "x", input_defs[0]->Name());
+      AddOperationInput(*op, "weight",
+                        model_builder.AddConstant(op->type(), "weight", weight, AsSpan(weight_shape)));
+
+      if (input_defs.size() > 2) {
+        // C has the shape {N} or {1, N}, which was checked in IsOpSupportedImpl
+        const auto& bias_tensor = *model_builder.GetInitializerTensors().at(input_defs[2]->Name());
+        Initializer unpacked_bias(bias_tensor);
+        AddOperationInput(*op, "bias",
+                          model_builder.AddConstant(op->type(), "bias", unpacked_bias.DataAsSpan<float>()));
+      }
+    }
+
+    AddOperationOutput(*op, *node.OutputDefs()[0]);
+    model_builder.AddOperation(std::move(op));
+    return Status::OK();
+  }
+
+  std::unique_ptr<COREML_SPEC::NeuralNetworkLayer> layer = CreateNNLayer(model_builder, node);
+
   const auto& b_tensor = *model_builder.GetInitializerTensors().at(input_defs[1]->Name());
   const auto& b_shape = b_tensor.dims();
 
@@ -130,6 +184,20 @@ bool GemmOpBuilder::IsOpSupportedImpl(const Node& node, const OpBuilderInputPara
   const auto& input_defs(node.InputDefs());
   size_t a_idx = 0, b_idx = 1, c_idx = 2;  // A*B+C
 
+  if (op_type == "MatMul" && input_params.create_mlprogram) {
+    // matmul takes non-constant inputs of any rank
+    std::vector<int64_t> a_shape, b_shape;
+    if (!GetShape(*input_defs[a_idx], a_shape, logger) || !GetShape(*input_defs[b_idx], b_shape, logger))
+      return false;
+
+    if (a_shape.empty() || b_shape.empty()) {
+      LOGS(logger, VERBOSE) << "A and B of MatMul must not be scalars";
+      return false;
+    }
+
+    return true;
+  }
+
   const auto& initializers = input_params.graph_viewer.GetAllInitializedTensors();
   if (!Contains(initializers, input_defs[b_idx]->Name())) {
     LOGS(logger, VERBOSE) << "B of Gemm/Matmul must be an initializer tensor";
@@ -0,0 +1,138 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+
+#include "core/providers/common.h"
+#include "core/providers/coreml/builders/helper.h"
+#include "core/providers/coreml/builders/impl/base_op_builder.h"
+#include "core/providers/coreml/builders/op_builder_factory.h"
+#include "core/providers/coreml/shape_utils.h"
+#include "core/providers/shared/utils/utils.h"
+
+#ifdef __APPLE__
+#include "core/providers/coreml/builders/impl/builder_utils.h"
+#include "core/providers/coreml/builders/model_builder.h"
+#endif
+
+namespace onnxruntime {
+namespace coreml {
+
+class LayerNormOpBuilder : public BaseOpBuilder {
+  // Add operator related
+#ifdef __APPLE__
+ private:
+  Status AddToModelBuilderImpl(ModelBuilder& model_builder, const Node& node,
+                               const logging::Logger& logger) const override;
+#endif
+
+  // Operator support related
+ private:
+  bool IsOpSupportedImpl(const Node& node, const OpBuilderInputParams& input_params,
+                         const logging::Logger& logger) const override;
+
+  bool SupportsMLProgram() const override { return true; }
+};
+
+// Add operator related
+
+#ifdef __APPLE__
+Status LayerNormOpBuilder::AddToModelBuilderImpl(ModelBuilder& model_builder, const Node& node,
+                                                 const logging::Logger& logger) const {
+  const auto& input_defs = node.InputDefs();
+
+  std::vector<int64_t> input_shape;
+  ORT_RETURN_IF_NOT(GetShape(*input_defs[0], input_shape, logger), "Cannot get shape");
+
+  NodeAttrHelper helper(node);
+  const auto axis = HandleNegativeAxis(helper.Get("axis", -1), input_shape.size());
+  const auto epsilon = helper.Get("epsilon", 1e-5f);
+
+  // ONNX normalizes over the dimensions from axis to the last one
+  std::vector<int64_t> axes;
+  for (auto i = axis; i < static_cast<int64_t>(input_shape.size()); ++i) {
+    axes.push_back(i);
+  }
+
+  std::unique_ptr<COREML_SPEC::MILSpec::Operation> op = model_builder.CreateOperation(node, "layer_norm");
+  AddOperationInput(*op, "x", input_defs[0]->Name());
+  AddOperationInput(*op, "axes", model_builder.AddConstant(op->type(), "axes", axes));
+  AddOperationInput(*op, "gamma", input_defs[1]->Name());
+  if (input_defs.size() > 2 && input_defs[2]->Exists()) {
+    AddOperationInput(*op, "beta", input_defs[2]->Name());
+  }
+  AddOperationInput(*op, "epsilon", model_builder.AddScalarConstant(op->type(), "epsilon", epsilon));
+  AddOperationOutput(*op, *node.OutputDefs()[0]);
+
+  model_builder.AddOperation(std::move(op));
+  return Status::OK();
+}
+#endif
+
+// Operator support related
+
+bool LayerNormOpBuilder::IsOpSupportedImpl(const Node& node, const OpBuilderInputParams& input_params,
+                                           const logging::Logger& logger) const {
+  if (!input_params.create_mlprogram) {
+    LOGS(logger, VERBOSE) << "LayerNormalization is only supported in an MLProgram";
+    return false;
+  }
+
+  const auto& output_defs = node.OutputDefs();
+  if (std::any_of(output_defs.begin() + 1, output_defs.end(),
+                  [](const NodeArg* output) { return output->Exists(); })) {
+    LOGS(logger, VERBOSE) << "LayerNormalization with the Mean or InvStdDev outputs is not supported";
+    return false;
+  }
+
+  const auto& input_defs = node.InputDefs();
+  std::vector<int64_t> input_shape;
+  if (!GetShape(*input_defs[0], input_shape, logger))
+    return false;
+
+  if (input_shape.empty()) {
+    LOGS(logger, VERBOSE) << "LayerNormalization does not support a scalar input";
+    return false;
+  }
+
+  NodeAttrHelper helper(node);
+  const auto axis = HandleNegativeAxis(helper.Get("axis", -1), input_shape.size());
+  const std::vector<int64_t> normalized_shape(input_shape.begin() + axis, input_shape.end());
+  if (!IsStaticShape(normalized_shape)) {
+    LOGS(logger, VERBOSE) << "LayerNormalization requires static normalized dimensions. Input shape: "
+                          << Shape2String(input_shape) << ", axis: " << axis;
+    return false;
+  }
+
+  // gamma and beta of layer_norm must be constants with the normalized shape
+  for (size_t i = 1; i < input_defs.size(); ++i) {
+    if (!input_defs[i]->Exists()) {
+      continue;
+    }
+
+    const auto* param_name = i == 1 ? "scale" : "bias";
+    if (!CheckIsConstantInitializer(*input_defs[i], input_params.graph_viewer, logger, param_name)) {
+      return false;
+    }
+
+    std::vector<int64_t> param_shape;
+    if (!GetShape(*input_defs[i], param_shape, logger))
+      return false;
+
+    if (param_shape != normalized_shape) {
+      LOGS(logger, VERBOSE) << "LayerNormalization " << param_name << " must have the normalized shape "
+                            << Shape2String(normalized_shape) << ", actual shape: " << Shape2String(param_shape);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void CreateLayerNormOpBuilder(const std::string& op_type, OpBuilderRegistrations& op_registrations) {
+  op_registrations.builders.push_back(std::make_unique<LayerNormOpBuilder>());
+  op_registrations.op_builder_map.emplace(op_type, op_registrations.builders.back().get());
+}
+
+}  // namespace coreml
+}  // namespace onnxruntime
@@ -12,6 +12,7 @@
 #include "core/providers/shared/utils/utils.h"
 
 #ifdef __APPLE__
+#include "core/providers/coreml/builders/impl/builder_utils.h"
 #include "core/providers/coreml/builders/model_builder.h"
 #endif
 
@@ -36,6 +37,8 @@ class ReshapeOpBuilder : public BaseOpBuilder {
 
   // Reshape opset 4- uses attributes for new shape which we do not support for now
   int GetMinSupportedOpSet(const Node& /* node */) const override { return 5; }
+
+  bool SupportsMLProgram() const override { return true; }
 };
 
 // Add operator related
@@ -48,8 +51,6 @@ void ReshapeOpBuilder::AddInitializersToSkip(ModelBuilder& model_builder, const
 Status ReshapeOpBuilder::AddToModelBuilderImpl(ModelBuilder& model_builder,
                                                const Node& node,
                                                const logging::Logger& logger) const {
-  std::unique_ptr<COREML_SPEC::NeuralNetworkLayer> layer = CreateNNLayer(model_builder, node);
-
   const auto& input_defs = node.InputDefs();
   const auto& initializers(model_builder.GetInitializerTensors());
   const auto& target_shape_tensor = *initializers.at(input_defs[1]->Name());
@@ -62,6 +63,19 @@ Status ReshapeOpBuilder::AddToModelBuilderImpl(ModelBuilder& model_builder,
   std::vector<int64_t> input_shape;
   ORT_RETURN_IF_NOT(GetStaticShape(*input_defs[0], input_shape, logger), "Cannot get shape");
   ReshapeHelper helper(TensorShape(input_shape), target_shape);
+
+  if (model_builder.CreateMLProgram()) {
+    // the 0 and -1 dimensions of the target shape were resolved by ReshapeHelper
+    std::unique_ptr<COREML_SPEC::MILSpec::Operation> op = model_builder.CreateOperation(node, "reshape");
+    AddOperationInput(*op, "x", input_defs[0]->Name());
+    AddOperationInput(*op, "shape",
+                      model_builder.AddConstant(op->type(), "shape", gsl::span<const int64_t>(target_shape)));
+    AddOperationOutput(*op, *node.OutputDefs()[0]);
+    model_builder.AddOperation(std::move(op));
+    return Status::OK();
+  }
+
+  std::unique_ptr<COREML_SPEC::NeuralNetworkLayer> layer = CreateNNLayer(model_builder, node);
   *layer->mutable_reshapestatic()->mutable_targetshape() = {target_shape.cbegin(), target_shape.cend()};
   *layer->mutable_input()->Add() = input_defs[0]->Name();
   *layer->mutable_output()->Add() = node.OutputDefs()[0]->Name();
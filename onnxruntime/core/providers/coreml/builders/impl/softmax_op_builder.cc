@@ -9,6 +9,7 @@
 #include "core/providers/shared/utils/utils.h"
 
 #ifdef __APPLE__
+#include "core/providers/coreml/builders/impl/builder_utils.h"
 #include "core/providers/coreml/builders/model_builder.h"
 #endif
 #include "core/providers/coreml/builders/op_builder_factory.h"
@@ -28,6 +29,8 @@ class SoftmaxOpBuilder : public BaseOpBuilder {
  private:
   bool IsOpSupportedImpl(const Node& node, const OpBuilderInputParams& input_params,
                          const logging::Logger& logger) const override;
+
+  bool SupportsMLProgram() const override { return true; }
 };
 
 // Add operator related
@@ -49,6 +52,16 @@ Status SoftmaxOpBuilder::AddToModelBuilderImpl(ModelBuilder& model_builder,
   const auto axis = helper.Get("axis", axis_default_value);
   const auto axis_nonnegative = HandleNegativeAxis(axis, data_shape.size());
 
+  if (model_builder.CreateMLProgram()) {
+    // the opset 13- inputs which would be coerced to 2D were rejected in IsOpSupportedImpl
+    std::unique_ptr<COREML_SPEC::MILSpec::Operation> op = model_builder.CreateOperation(node, "softmax");
+    AddOperationInput(*op, "x", input_name);
+    AddOperationInput(*op, "axis", model_builder.AddScalarConstant(op->type(), "axis", axis));
+    AddOperationOutput(*op, *node.OutputDefs()[0]);
+    model_builder.AddOperation(std::move(op));
+    return Status::OK();
+  }
+
   if (node.SinceVersion() >= 13 || (data_shape.size() == 2)) {
     auto* coreml_softmaxnd = layer->mutable_softmaxnd();
     coreml_softmaxnd->set_axis(axis);
@@ -103,7 +116,7 @@ Status SoftmaxOpBuilder::AddToModelBuilderImpl(ModelBuilder& model_builder,
 
 // Operator support related
 
-bool SoftmaxOpBuilder::IsOpSupportedImpl(const Node& node, const OpBuilderInputParams& /* input_params */,
+bool SoftmaxOpBuilder::IsOpSupportedImpl(const Node& node, const OpBuilderInputParams& input_params,
                                          const logging::Logger& logger) const {
   const auto& input_defs = node.InputDefs();
   std::vector<int64_t> input_shape;
@@ -116,6 +129,11 @@ bool SoftmaxOpBuilder::IsOpSupportedImpl(const Node& node, const OpBuilderInputP
     return false;
   }
 
+  if (input_params.create_mlprogram && node.SinceVersion() < 13 && input_shape.size() != 2) {
+    LOGS(logger, VERBOSE) << "Softmax opset 13- with an input which is not 2D is not supported in an MLProgram";
+    return false;
+  }
+
   return true;
 }
 
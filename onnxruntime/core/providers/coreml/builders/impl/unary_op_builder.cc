@@ -4,6 +4,7 @@
 #include "core/providers/common.h"
 
 #ifdef __APPLE__
+#include "core/providers/coreml/builders/impl/builder_utils.h"
 #include "core/providers/coreml/builders/model_builder.h"
 #endif
 #include "core/providers/coreml/builders/helper.h"
@@ -20,6 +21,11 @@ class UnaryOpBuilder : public BaseOpBuilder {
   Status AddToModelBuilderImpl(ModelBuilder& model_builder, const Node& node,
                                const logging::Logger& logger) const override;
 #endif
+
+  bool IsOpSupportedImpl(const Node& node, const OpBuilderInputParams& input_params,
+                         const logging::Logger& logger) const override;
+
+  bool SupportsMLProgram() const override { return true; }
 };
 
 #ifdef __APPLE__
@@ -28,6 +34,29 @@ Status UnaryOpBuilder::AddToModelBuilderImpl(ModelBuilder& model_builder, const
   const auto& op_type(node.OpType());
   const auto& input_defs(node.InputDefs());
 
+  if (model_builder.CreateMLProgram()) {
+    std::unique_ptr<COREML_SPEC::MILSpec::Operation> op;
+    if (op_type == "Sqrt") {
+      op = model_builder.CreateOperation(node, "sqrt");
+      AddOperationInput(*op, "x", input_defs[0]->Name());
+    } else if (op_type == "Reciprocal") {
+      // the inverse operation adds an epsilon to x, use a division to match the ONNX results exactly
+      op = model_builder.CreateOperation(node, "real_div");
+      AddOperationInput(*op, "x", model_builder.AddScalarConstant("real_div", "x", 1.0f));
+      AddOperationInput(*op, "y", input_defs[0]->Name());
+    } else if (op_type == "Erf") {
+      op = model_builder.CreateOperation(node, "erf");
+      AddOperationInput(*op, "x", input_defs[0]->Name());
+    } else {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "UnaryOpBuilder::AddToModelBuilderImpl, unknown op: ", op_type);
+    }
+
+    AddOperationOutput(*op, *node.OutputDefs()[0]);
+    model_builder.AddOperation(std::move(op));
+    return Status::OK();
+  }
+
   std::unique_ptr<COREML_SPEC::NeuralNetworkLayer> layer = CreateNNLayer(model_builder, node);
 
   if (op_type == "Sqrt") {
@@ -49,6 +78,16 @@ Status UnaryOpBuilder::AddToModelBuilderImpl(ModelBuilder& model_builder, const
 
 // Operator support related
 
+bool UnaryOpBuilder::IsOpSupportedImpl(const Node& node, const OpBuilderInputParams& input_params,
+                                       const logging::Logger& logger) const {
+  if (node.OpType() == "Erf" && !input_params.create_mlprogram) {
+    LOGS(logger, VERBOSE) << "Erf is only supported in an MLProgram";
+    return false;
+  }
+
+  return true;
+}
+
 void CreateUnaryOpBuilder(const std::string& op_type, OpBuilderRegistrations& op_registrations) {
   op_registrations.builders.push_back(std::make_unique<UnaryOpBuilder>());
   op_registrations.op_builder_map.emplace(op_type, op_registrations.builders.back().get());
@@ -1,15 +1,26 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <fstream>
+#include <iomanip>
+#include <sstream>
 #include <core/common/safeint.h>
 
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
 #include "model_builder.h"
 #include "helper.h"
 #include "op_builder_factory.h"
 
+#include "core/common/narrow.h"
+#include "core/common/span_utils.h"
+#include "core/framework/float16.h"
+#include "core/framework/murmurhash3.h"
 #include "core/providers/common.h"
 #include "core/providers/coreml/builders/impl/builder_utils.h"
+#include "core/providers/coreml/coreml_provider_factory.h"
 #include "core/providers/coreml/model/host_utils.h"
 #include "core/providers/coreml/model/model.h"
 #include "core/providers/coreml/shape_utils.h"
@@ -17,15 +28,105 @@
 namespace onnxruntime {
 namespace coreml {
 
+namespace {
+// The opset of the MLProgram operations, which CoreML Specification Version 6 (Core ML 5) supports
+constexpr const char* kMLProgramOpset = "CoreML5";
+
+// Replace the references to the value old_name in the operations of the block, including the output that defines it
+void RenameMLProgramValue(COREML_SPEC::MILSpec::Block& block, const std::string& old_name,
+                          const std::string& new_name) {
+  for (auto& op : *block.mutable_operations()) {
+    for (auto& [input_name, argument] : *op.mutable_inputs()) {
+      for (auto& binding : *argument.mutable_arguments()) {
+        if (binding.binding_case() == COREML_SPEC::MILSpec::Argument_Binding::kName && binding.name() == old_name) {
+          binding.set_name(new_name);
+        }
+      }
+    }
+
+    for (auto& output : *op.mutable_outputs()) {
+      if (output.name() == old_name) {
+        output.set_name(new_name);
+      }
+    }
+  }
+}
+
+void ConvertTypeToFp16(COREML_SPEC::MILSpec::ValueType& type) {
+  if (type.has_tensortype() && type.tensortype().datatype() == COREML_SPEC::MILSpec::DataType::FLOAT32) {
+    type.mutable_tensortype()->set_datatype(COREML_SPEC::MILSpec::DataType::FLOAT16);
+  }
+}
+
+void ConvertValueToFp16(COREML_SPEC::MILSpec::Value& value) {
+  if (!value.type().has_tensortype() ||
+      value.type().tensortype().datatype() != COREML_SPEC::MILSpec::DataType::FLOAT32) {
+    return;
+  }
+
+  ConvertTypeToFp16(*value.mutable_type());
+
+  // fp16 immediate values are stored as bytes
+  if (value.has_immediatevalue() && value.immediatevalue().tensor().has_floats()) {
+    auto& tensor = *value.mutable_immediatevalue()->mutable_tensor();
+    const auto& floats = tensor.floats().values();
+    std::string bytes(floats.size() * sizeof(MLFloat16), '\0');
+    std::transform(floats.begin(), floats.end(), reinterpret_cast<MLFloat16*>(bytes.data()),
+                   [](float v) { return MLFloat16(v); });
+    tensor.mutable_bytes()->set_values(std::move(bytes));
+  }
+}
+
+// Create a cast operation from the value input_name to the value output_name of the type output_type
+std::unique_ptr<COREML_SPEC::MILSpec::Operation> CreateCastOperation(const std::string& input_name,
+                                                                     COREML_SPEC::MILSpec::NamedValueType output,
+                                                                     const char* dtype) {
+  auto op = std::make_unique<COREML_SPEC::MILSpec::Operation>();
+  op->set_type("cast");
+  (*op->mutable_attributes())["name"] = CreateScalarTensorValue(MakeString("cast_", output.name()));
+  AddOperationInput(*op, "x", input_name);
+  // immediate value, so the operation doesn't depend on a const operation that would need to be placed before it
+  *(*op->mutable_inputs())["dtype"].mutable_arguments()->Add()->mutable_value() =
+      CreateScalarTensorValue(std::string(dtype));
+  *op->mutable_outputs()->Add() = std::move(output);
+  return op;
+}
+
+// Hash of the serialized CoreML model and the OS version, as the compiled model depends on the CoreML compiler
+std::string HashModel(const std::string& serialized_model) {
+  std::string data = serialized_model + util::GetOSVersionString();
+  uint32_t hash[4] = {0, 0, 0, 0};
+  MurmurHash3::x86_128(data.data(), narrow<int>(data.size()), 0, hash);
+
+  std::ostringstream os;
+  os << std::hex << std::setfill('0');
+  for (const auto h : hash) {
+    os << std::setw(8) << h;
+  }
+  return os.str();
+}
+}  // namespace
+
 ModelBuilder::ModelBuilder(const GraphViewer& graph_viewer, const logging::Logger& logger, uint32_t coreml_flags)
     : graph_viewer_(graph_viewer),
       logger_(logger),
-      coreml_flags_(coreml_flags) {
+      coreml_flags_(coreml_flags),
+      create_ml_program_((coreml_flags & COREML_FLAG_CREATE_MLPROGRAM) != 0),
+      // COREML_FLAG_USE_CPU_ONLY asks for reference outputs without precision loss
+      fp16_compute_precision_(create_ml_program_ && (coreml_flags & COREML_FLAG_USE_CPU_ONLY) == 0) {
 }
 
 Status ModelBuilder::Initialize() {
   coreml_model_ = std::make_unique<CoreML::Specification::Model>();
-  {  // initialize CoreML model
+  if (create_ml_program_) {
+    // An MLProgram requires CoreML Specification Version 6 (Core ML 5)
+    coreml_model_->set_specificationversion(6);
+    auto& program = *coreml_model_->mutable_mlprogram();
+    program.set_version(1);
+    mlprogram_main_fn_ = &(*program.mutable_functions())["main"];
+    mlprogram_main_fn_->set_opset(kMLProgramOpset);
+    mlprogram_main_block_ = &(*mlprogram_main_fn_->mutable_block_specializations())[kMLProgramOpset];
+  } else {  // initialize CoreML model
     // We support CorelML Specification Version 4 (Core ML 3)
     coreml_model_->set_specificationversion(4);
     auto* neural_network = coreml_model_->mutable_neuralnetwork();
@@ -38,6 +139,10 @@ Status ModelBuilder::Initialize() {
   ORT_RETURN_IF_ERROR(AddOperations());
   ORT_RETURN_IF_ERROR(RegisterModelOutputs());
 
+  if (fp16_compute_precision_) {
+    ConvertMLProgramToFp16();
+  }
+
   return Status::OK();
 }
 
@@ -80,6 +185,22 @@ Status ModelBuilder::RegisterInitializers() {
     if (usage_count == 0)
       continue;
 
+    if (create_ml_program_) {
+      // the initializer is the output of a const operation with the same name
+      COREML_SPEC::MILSpec::Value value;
+      ORT_RETURN_IF_ERROR(CreateTensorValue(tensor, value));
+
+      auto op = std::make_unique<COREML_SPEC::MILSpec::Operation>();
+      op->set_type("const");
+      (*op->mutable_attributes())["name"] = CreateScalarTensorValue(name);
+      auto& output = *op->mutable_outputs()->Add();
+      output.set_name(name);
+      *output.mutable_type() = value.type();
+      (*op->mutable_attributes())["val"] = std::move(value);
+      AddOperation(std::move(op));
+      continue;
+    }
+
     std::unique_ptr<COREML_SPEC::NeuralNetworkLayer> layer = std::make_unique<COREML_SPEC::NeuralNetworkLayer>();
     layer->set_name(GetUniqueName("initializer_" + name));
 
@@ -202,6 +323,19 @@ Status ModelBuilder::RegisterModelInputOutput(const NodeArg& node_arg, bool is_i
     }
   }
 
+  if (create_ml_program_) {
+    if (is_input) {
+      // the inputs of the model are the inputs of the main function
+      auto& function_input = *mlprogram_main_fn_->mutable_inputs()->Add();
+      function_input.set_name(name);
+      SetTensorTypeInfo(*function_input.mutable_type()->mutable_tensortype(), OnnxDataTypeToMILSpec(data_type),
+                        AsSpan(shape));
+    } else {
+      // the outputs of the model are the outputs of the block of the main function
+      mlprogram_main_block_->add_outputs(name);
+    }
+  }
+
   input_output_info_.emplace(name, OnnxTensorInfo{data_type, shape});
 
   return Status::OK();
@@ -241,7 +375,7 @@ Status ModelBuilder::RegisterModelOutputs() {
 
 Status ModelBuilder::Compile(std::unique_ptr<Model>& model, const std::string& path) {
   ORT_RETURN_IF_ERROR(SaveCoreMLModel(path));
-  model.reset(new Model(path, logger_, coreml_flags_));
+  model.reset(new Model(path, model_hash_, logger_, coreml_flags_));
   model->SetScalarOutputs(std::move(scalar_outputs_));
   model->SetInt64Outputs(std::move(int64_outputs_));
   model->SetInputOutputInfo(std::move(input_output_info_));
@@ -250,8 +384,24 @@ Status ModelBuilder::Compile(std::unique_ptr<Model>& model, const std::string& p
 
 Status ModelBuilder::SaveCoreMLModel(const std::string& path) {
   ORT_RETURN_IF_ERROR(Initialize());
+
+  // the map fields of the MLProgram are serialized in a deterministic order, so the same model always has the same
+  // bytes, and the hash of the bytes can key the cache of the compiled model
+  std::string serialized_model;
+  {
+    google::protobuf::io::StringOutputStream string_stream(&serialized_model);
+    google::protobuf::io::CodedOutputStream coded_stream(&string_stream);
+    coded_stream.SetSerializationDeterministic(true);
+    ORT_RETURN_IF_NOT(coreml_model_->SerializeToCodedStream(&coded_stream), "Serialize the CoreML model failed");
+  }
+
   std::ofstream stream(path, std::ofstream::out | std::ofstream::binary);
-  ORT_RETURN_IF_NOT(coreml_model_->SerializeToOstream(&stream), "Save the CoreML model failed");
+  stream.write(serialized_model.data(), serialized_model.size());
+  ORT_RETURN_IF_NOT(stream.good(), "Save the CoreML model failed");
+
+  if (coreml_flags_ & COREML_FLAG_CACHE_COMPILED_MODEL) {
+    model_hash_ = HashModel(serialized_model);
+  }
 
   // TODO, Delete, debug only
   if (const char* path = std::getenv("ORT_COREML_EP_CONVERTED_MODEL_PATH")) {
@@ -275,6 +425,106 @@ void ModelBuilder::AddLayer(std::unique_ptr<COREML_SPEC::NeuralNetworkLayer> lay
   neural_network->mutable_layers()->AddAllocated(layer.release());
 }
 
+std::unique_ptr<COREML_SPEC::MILSpec::Operation> ModelBuilder::CreateOperation(const Node& node,
+                                                                             std::string_view op_type,
+                                                                             std::string_view suffix) {
+  // the node name is optional in ONNX, and a node may be decomposed into multiple operations
+  const auto op_name = GetUniqueName(MakeString(node.Name(), "_", node.Index(), "_", op_type, suffix));
+
+  auto op = std::make_unique<COREML_SPEC::MILSpec::Operation>();
+  op->set_type(std::string(op_type));
+  (*op->mutable_attributes())["name"] = CreateScalarTensorValue(op_name);
+  return op;
+}
+
+void ModelBuilder::AddOperation(std::unique_ptr<COREML_SPEC::MILSpec::Operation> operation) {
+  mlprogram_main_block_->mutable_operations()->AddAllocated(operation.release());
+}
+
+std::string ModelBuilder::AddConstantImpl(std::string_view op_type, std::string_view value_type,
+                                          COREML_SPEC::MILSpec::Value&& value) {
+  const auto name = GetUniqueName(MakeString(op_type, "_", value_type));
+
+  auto op = std::make_unique<COREML_SPEC::MILSpec::Operation>();
+  op->set_type("const");
+  (*op->mutable_attributes())["name"] = CreateScalarTensorValue(name);
+  auto& output = *op->mutable_outputs()->Add();
+  output.set_name(name);
+  *output.mutable_type() = value.type();
+  (*op->mutable_attributes())["val"] = std::move(value);
+
+  AddOperation(std::move(op));
+  return name;
+}
+
+void ModelBuilder::ConvertMLProgramToFp16() {
+  auto& operations = *mlprogram_main_block_->mutable_operations();
+  for (auto& op : operations) {
+    for (auto& output : *op.mutable_outputs()) {
+      ConvertTypeToFp16(*output.mutable_type());
+    }
+
+    // the values of const operations, and the immediate values of operation parameters such as epsilon
+    for (auto& [attribute_name, attribute] : *op.mutable_attributes()) {
+      ConvertValueToFp16(attribute);
+    }
+
+    for (auto& [input_name, argument] : *op.mutable_inputs()) {
+      for (auto& binding : *argument.mutable_arguments()) {
+        if (binding.has_value()) {
+          ConvertValueToFp16(*binding.mutable_value());
+        }
+      }
+    }
+  }
+
+  // cast the fp32 inputs to fp16 at the start of the block
+  int num_input_casts = 0;
+  for (const auto& input : mlprogram_main_fn_->inputs()) {
+    if (input.type().tensortype().datatype() != COREML_SPEC::MILSpec::DataType::FLOAT32) {
+      continue;
+    }
+
+    const auto fp16_name = GetUniqueName(input.name() + "_fp16");
+    RenameMLProgramValue(*mlprogram_main_block_, input.name(), fp16_name);
+
+    COREML_SPEC::MILSpec::NamedValueType fp16_value = input;
+    fp16_value.set_name(fp16_name);
+    ConvertTypeToFp16(*fp16_value.mutable_type());
+    operations.AddAllocated(CreateCastOperation(input.name(), std::move(fp16_value), "fp16").release());
+
+    // move the cast before the other operations
+    for (int i = operations.size() - 1; i > num_input_casts; --i) {
+      operations.SwapElements(i, i - 1);
+    }
+    ++num_input_casts;
+  }
+
+  // cast the fp16 outputs to fp32 at the end of the block
+  for (const auto& output_name : mlprogram_main_block_->outputs()) {
+    const COREML_SPEC::MILSpec::NamedValueType* output_value = nullptr;
+    for (const auto& op : operations) {
+      for (const auto& output : op.outputs()) {
+        if (output.name() == output_name) {
+          output_value = &output;
+        }
+      }
+    }
+
+    if (output_value == nullptr ||
+        output_value->type().tensortype().datatype() != COREML_SPEC::MILSpec::DataType::FLOAT16) {
+      continue;
+    }
+
+    COREML_SPEC::MILSpec::NamedValueType fp32_value = *output_value;
+    fp32_value.mutable_type()->mutable_tensortype()->set_datatype(COREML_SPEC::MILSpec::DataType::FLOAT32);
+
+    const auto fp16_name = GetUniqueName(output_name + "_fp16");
+    RenameMLProgramValue(*mlprogram_main_block_, output_name, fp16_name);
+    operations.AddAllocated(CreateCastOperation(fp16_name, std::move(fp32_value), "fp32").release());
+  }
+}
+
 void ModelBuilder::AddInitializerToSkip(const std::string& tensor_name) {
   // decrement usage count if this is a known initializer.
   // For simplicity the OpBuilder::AddInitializersToSkip implementations may call this for arbitrary input names
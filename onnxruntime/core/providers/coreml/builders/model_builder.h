@@ -3,8 +3,13 @@
 
 #pragma once
 
+#include <optional>
+#include <string_view>
+
+#include "core/common/gsl.h"
 #include "core/graph/graph_viewer.h"
 #include "core/providers/coreml/builders/coreml_spec.h"
+#include "core/providers/coreml/builders/impl/builder_utils.h"
 
 namespace onnxruntime {
 namespace coreml {
@@ -25,8 +30,46 @@ class ModelBuilder {
   const GraphViewer& GetGraphViewer() const { return graph_viewer_; }
   const InitializedTensorSet& GetInitializerTensors() const { return graph_viewer_.GetAllInitializedTensors(); }
 
+  // Whether the model is an MLProgram, or a NeuralNetwork
+  bool CreateMLProgram() const { return create_ml_program_; }
+
+  /*
+   * NeuralNetwork helpers
+   */
+
   void AddLayer(std::unique_ptr<COREML_SPEC::NeuralNetworkLayer> layer);
 
+  /*
+   * MLProgram helpers
+   */
+
+  // Create an operation of the MIL type op_type for the node. suffix distinguishes the operations that a node is
+  // decomposed into.
+  std::unique_ptr<COREML_SPEC::MILSpec::Operation> CreateOperation(const Node& node, std::string_view op_type,
+                                                                   std::string_view suffix = "");
+
+  // Add the operation to the main function of the MLProgram. The operations must be added in topological order.
+  void AddOperation(std::unique_ptr<COREML_SPEC::MILSpec::Operation> operation);
+
+  // Add a const operation with the value for the input value_type of an operation of the type op_type, and return
+  // the unique name of the value. The shape defaults to a 1D tensor of the size of the data.
+  template <typename T>
+  std::string AddConstant(std::string_view op_type, std::string_view value_type, gsl::span<const T> value,
+                          std::optional<gsl::span<const int64_t>> shape = std::nullopt) {
+    return AddConstantImpl(op_type, value_type, CreateTensorValue(value, shape));
+  }
+
+  template <typename T>
+  std::string AddConstant(std::string_view op_type, std::string_view value_type, const std::vector<T>& value,
+                          std::optional<gsl::span<const int64_t>> shape = std::nullopt) {
+    return AddConstant(op_type, value_type, gsl::span<const T>(value), shape);
+  }
+
+  template <typename T>
+  std::string AddScalarConstant(std::string_view op_type, std::string_view value_type, const T& value) {
+    return AddConstantImpl(op_type, value_type, CreateScalarTensorValue(value));
+  }
+
   // The initializer will be processed separately, skip it as an initializer
   void AddInitializerToSkip(const std::string& tensor_name);
 
@@ -40,8 +83,17 @@ class ModelBuilder {
   const GraphViewer& graph_viewer_;
   const logging::Logger& logger_;
   uint32_t coreml_flags_;
+  const bool create_ml_program_;       // MLProgram (Core ML 5, iOS 15+, macOS 12+) or NeuralNetwork
+  const bool fp16_compute_precision_;  // whether the operations of the MLProgram run in fp16
 
   std::unique_ptr<CoreML::Specification::Model> coreml_model_;
+
+  // the main function of the MLProgram and its block, which has the operations
+  COREML_SPEC::MILSpec::Function* mlprogram_main_fn_{nullptr};
+  COREML_SPEC::MILSpec::Block* mlprogram_main_block_{nullptr};
+
+  // hash of the serialized CoreML model and the OS version, which keys the cache of the compiled model
+  std::string model_hash_;
   std::unordered_set<std::string> scalar_outputs_;
   std::unordered_set<std::string> int64_outputs_;
   std::unordered_map<std::string, OnnxTensorInfo> input_output_info_;
@@ -72,6 +124,13 @@ class ModelBuilder {
   // Record the onnx int64 type output names
   void AddInt64Output(const std::string& output_name);
 
+  std::string AddConstantImpl(std::string_view op_type, std::string_view value_type,
+                              COREML_SPEC::MILSpec::Value&& value);
+
+  // Convert the operations of the MLProgram to fp16, and cast the float inputs and outputs of the main function
+  // to and from fp16, so the model still takes and returns fp32 values
+  void ConvertMLProgramToFp16();
+
   static const IOpBuilder* GetOpBuilder(const Node& node);
 };
 
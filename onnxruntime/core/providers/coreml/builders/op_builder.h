@@ -11,12 +11,14 @@ namespace coreml {
 class ModelBuilder;
 
 struct OpBuilderInputParams {
-  OpBuilderInputParams(const GraphViewer& graph_viewer, bool only_allow_static_input_shapes)
+  OpBuilderInputParams(const GraphViewer& graph_viewer, bool only_allow_static_input_shapes, bool create_mlprogram)
       : graph_viewer(graph_viewer),
-        only_allow_static_input_shapes(only_allow_static_input_shapes) {}
+        only_allow_static_input_shapes(only_allow_static_input_shapes),
+        create_mlprogram(create_mlprogram) {}
 
   const GraphViewer& graph_viewer;
   const bool only_allow_static_input_shapes;
+  const bool create_mlprogram;  // whether the operators are added to an MLProgram instead of a NeuralNetwork
 };
 
 class IOpBuilder {
@@ -41,6 +43,9 @@ class IOpBuilder {
   // Check if an operator is supported
   virtual bool IsOpSupported(const Node& node, const OpBuilderInputParams& input_params,
                              const logging::Logger& logger) const = 0;
+
+  // Check if the op builder can add the operator to an MLProgram
+  virtual bool SupportsMLProgram() const = 0;
 };
 
 }  // namespace coreml
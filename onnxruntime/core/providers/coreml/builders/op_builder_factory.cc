@@ -102,6 +102,7 @@ static OpBuilderRegistrations CreateOpBuilderRegistrations() {
   {  // Unary
     CreateUnaryOpBuilder("Sqrt", op_registrations);
     CreateUnaryOpBuilder("Reciprocal", op_registrations);
+    CreateUnaryOpBuilder("Erf", op_registrations);
   }
 
   {  // Reduction
@@ -130,6 +131,14 @@ static OpBuilderRegistrations CreateOpBuilderRegistrations() {
     CreateSplitOpBuilder("Split", op_registrations);
   }
 
+  {  // LayerNormalization
+    CreateLayerNormOpBuilder("LayerNormalization", op_registrations);
+  }
+
+  {  // Gelu
+    CreateGeluOpBuilder("Gelu", op_registrations);
+  }
+
   return op_registrations;
 }
 
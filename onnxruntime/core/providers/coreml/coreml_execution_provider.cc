@@ -23,9 +23,21 @@ namespace onnxruntime {
 
 constexpr const char* COREML = "CoreML";
 
+namespace {
+uint32_t ValidateCoreMLFlags(uint32_t coreml_flags) {
+#ifdef __APPLE__
+  if ((coreml_flags & COREML_FLAG_CREATE_MLPROGRAM) && !coreml::util::HasMLProgram()) {
+    LOGS_DEFAULT(WARNING) << "MLProgram requires macOS 12 or iOS 15 and later. Creating a NeuralNetwork instead.";
+    coreml_flags &= ~COREML_FLAG_CREATE_MLPROGRAM;
+  }
+#endif
+  return coreml_flags;
+}
+}  // namespace
+
 CoreMLExecutionProvider::CoreMLExecutionProvider(uint32_t coreml_flags)
     : IExecutionProvider{onnxruntime::kCoreMLExecutionProvider, true},
-      coreml_flags_(coreml_flags) {
+      coreml_flags_(ValidateCoreMLFlags(coreml_flags)) {
 }
 
 CoreMLExecutionProvider::~CoreMLExecutionProvider() {}
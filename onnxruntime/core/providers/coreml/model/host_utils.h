@@ -13,6 +13,9 @@
 // Base requireed OS to run CoreML Specification Version 4 (Core ML 3)
 #define HAS_VALID_BASE_OS_VERSION @available(macOS 10.15, iOS 13, *)
 
+// Required OS to run CoreML Specification Version 6 (Core ML 5), the first version with MLProgram
+#define HAS_COREML5_OR_LATER @available(macOS 12, iOS 15, *)
+
 namespace onnxruntime {
 namespace coreml {
 namespace util {
@@ -21,6 +24,13 @@ namespace util {
 // This corresponds to [CoreML Specification Version 4 (Core ML 3)]
 bool HasRequiredBaseOS();
 
+// Return if we are running on an OS which can run an MLProgram
+// This corresponds to [CoreML Specification Version 6 (Core ML 5)]
+bool HasMLProgram();
+
+// Get the version of the OS, including the build number, e.g. "Version 17.0 (Build 21A329)"
+std::string GetOSVersionString();
+
 // Get a temporary macOS/iOS temp file path
 std::string GetTemporaryFilePath();
 
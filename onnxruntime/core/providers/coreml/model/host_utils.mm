@@ -18,6 +18,17 @@ bool HasRequiredBaseOS() {
     return false;
 }
 
+bool HasMLProgram() {
+  if (HAS_COREML5_OR_LATER)
+    return true;
+  else
+    return false;
+}
+
+std::string GetOSVersionString() {
+  return std::string([[[NSProcessInfo processInfo] operatingSystemVersionString] UTF8String]);
+}
+
 std::string GetTemporaryFilePath() {
   // Get temporary directory.
   NSURL* temporary_directory_url = [NSURL fileURLWithPath:NSTemporaryDirectory() isDirectory:YES];
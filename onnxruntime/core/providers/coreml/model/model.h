@@ -72,7 +72,8 @@ class Model {
 
   OrtMutex mutex_;
 
-  Model(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags);
+  // cache_key keys the compiled model in the cache when COREML_FLAG_CACHE_COMPILED_MODEL is set
+  Model(const std::string& path, const std::string& cache_key, const logging::Logger& logger, uint32_t coreml_flags);
   Status LoadModel();
 
   void SetInputOutputInfo(std::unordered_map<std::string, OnnxTensorInfo>&& input_output_info) {
@@ -237,17 +237,19 @@ Status CopyMLMultiArrayBuffer(const void* mlmultiarray_buffer, void* tensor_buff
 NS_ASSUME_NONNULL_BEGIN
 
 // Execution for a CoreML model, it performs
-// 1. Compile the model by given path for execution
+// 1. Compile the model by given path for execution, or load the compiled model from the cache
 // 2. Predict using given OnnxTensorFeatureProvider input and copy the output data back ORT
-// 3. The compiled model will be removed in dealloc or removed using cleanup function
+// 3. The compiled model will be removed in dealloc or removed using cleanup function, unless it is kept in the cache
 @interface CoreMLExecution : NSObject {
   NSString* coreml_model_path_;
   NSString* compiled_model_path_;
+  NSString* _Nullable cache_key_;
   const logging::Logger* logger_;
   uint32_t coreml_flags_;
 }
 
 - (instancetype)initWithPath:(const std::string&)path
+                    cacheKey:(const std::string&)cache_key
                       logger:(const logging::Logger&)logger
                 coreml_flags:(uint32_t)coreml_flags;
 - (void)cleanup;
@@ -266,10 +268,12 @@ NS_ASSUME_NONNULL_BEGIN
 @implementation CoreMLExecution
 
 - (instancetype)initWithPath:(const std::string&)path
+                    cacheKey:(const std::string&)cache_key
                       logger:(const logging::Logger&)logger
                 coreml_flags:(uint32_t)coreml_flags {
   if (self = [super init]) {
     coreml_model_path_ = [NSString stringWithUTF8String:path.c_str()];
+    cache_key_ = cache_key.empty() ? nil : [NSString stringWithUTF8String:cache_key.c_str()];
     logger_ = &logger;
     coreml_flags_ = coreml_flags;
   }
@@ -302,13 +306,57 @@ NS_ASSUME_NONNULL_BEGIN
   [self cleanup];
 }
 
+// Get the URL of the compiled model in the cache, creating the cache directory if needed. Returns nil if there is no
+// cache directory.
+- (NSURL* _Nullable)cachedCompiledModelURL {
+  NSFileManager* file_manager = [NSFileManager defaultManager];
+  NSURL* caches_url = [[file_manager URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask] firstObject];
+  if (caches_url == nil) {
+    LOGS(*logger_, WARNING) << "Failed to get the caches directory, the compiled CoreML model will not be cached";
+    return nil;
+  }
+
+  NSURL* cache_url = [[caches_url URLByAppendingPathComponent:@"onnxruntime" isDirectory:YES]
+      URLByAppendingPathComponent:@"coreml"
+                      isDirectory:YES];
+  NSError* error = nil;
+  if (![file_manager createDirectoryAtURL:cache_url withIntermediateDirectories:YES attributes:nil error:&error]) {
+    LOGS(*logger_, WARNING) << "Failed to create the CoreML model cache directory: " << [[cache_url path] UTF8String]
+                            << ", error message: " << [[error localizedDescription] UTF8String];
+    return nil;
+  }
+
+  return [cache_url URLByAppendingPathComponent:[cache_key_ stringByAppendingString:@".mlmodelc"] isDirectory:YES];
+}
+
 - (Status)loadModel {
+  MLModelConfiguration* config = [MLModelConfiguration alloc];
+  config.computeUnits = (coreml_flags_ & COREML_FLAG_USE_CPU_ONLY)
+                            ? MLComputeUnitsCPUOnly
+                            : MLComputeUnitsAll;
+
+  NSError* error = nil;
+  NSURL* cached_url = cache_key_ != nil ? [self cachedCompiledModelURL] : nil;
+  if (cached_url != nil && [[NSFileManager defaultManager] fileExistsAtPath:[cached_url path]]) {
+    _model = [MLModel modelWithContentsOfURL:cached_url configuration:config error:&error];
+    if (_model != nil) {
+      LOGS(*logger_, VERBOSE) << "Loaded the compiled CoreML model from the cache: " << [[cached_url path] UTF8String];
+      return Status::OK();
+    }
+
+    // the cached model may be incomplete, e.g. if the app was killed while caching it, compile the model again
+    LOGS(*logger_, WARNING) << "Failed to load the cached compiled CoreML model: " << [[cached_url path] UTF8String]
+                            << ((error != nil) ? MakeString(", error: ", [[error localizedDescription] UTF8String])
+                                               : "");
+    [[NSFileManager defaultManager] removeItemAtURL:cached_url error:nil];
+    error = nil;
+  }
+
   NSURL* modelUrl = [NSURL URLWithString:coreml_model_path_];
   if (modelUrl == nil) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to create model URL from path");
   }
 
-  NSError* error = nil;
   NSURL* compileUrl = [MLModel compileModelAtURL:modelUrl error:&error];
 
   if (error != nil) {
@@ -318,10 +366,19 @@ NS_ASSUME_NONNULL_BEGIN
 
   compiled_model_path_ = [compileUrl path];
 
-  MLModelConfiguration* config = [MLModelConfiguration alloc];
-  config.computeUnits = (coreml_flags_ & COREML_FLAG_USE_CPU_ONLY)
-                            ? MLComputeUnitsCPUOnly
-                            : MLComputeUnitsAll;
+  if (cached_url != nil) {
+    // Move the compiled model to the cache, which owns it from then on. If another session cached the same model
+    // first, the moving fails and this session uses its own compiled model, which is cleaned up as usual.
+    NSError* cache_error = nil;
+    if ([[NSFileManager defaultManager] moveItemAtURL:compileUrl toURL:cached_url error:&cache_error]) {
+      compileUrl = cached_url;
+      compiled_model_path_ = nil;
+    } else {
+      LOGS(*logger_, VERBOSE) << "Failed to cache the compiled CoreML model: " << [[cached_url path] UTF8String]
+                              << ", error message: " << [[cache_error localizedDescription] UTF8String];
+    }
+  }
+
   _model = [MLModel modelWithContentsOfURL:compileUrl configuration:config error:&error];
 
   if (error != nil || _model == nil) {
@@ -428,7 +485,8 @@ namespace coreml {
 // This class will bridge Model (c++) with CoreMLExecution (objective c++)
 class Execution {
  public:
-  Execution(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags);
+  Execution(const std::string& path, const std::string& cache_key, const logging::Logger& logger,
+            uint32_t coreml_flags);
   ~Execution(){};
 
   Status LoadModel();
@@ -441,9 +499,11 @@ class Execution {
   CoreMLExecution* execution_;
 };
 
-Execution::Execution(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags) {
+Execution::Execution(const std::string& path, const std::string& cache_key, const logging::Logger& logger,
+                     uint32_t coreml_flags) {
   @autoreleasepool {
     execution_ = [[CoreMLExecution alloc] initWithPath:path
+                                              cacheKey:cache_key
                                                 logger:logger
                                           coreml_flags:coreml_flags];
   }
@@ -482,8 +542,9 @@ Status Execution::Predict(const std::unordered_map<std::string, OnnxTensorData>&
   return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Execution::Predict requires macos 10.15+ or ios 13+");
 }
 
-Model::Model(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags)
-    : execution_(std::make_unique<Execution>(path, logger, coreml_flags)) {
+Model::Model(const std::string& path, const std::string& cache_key, const logging::Logger& logger,
+             uint32_t coreml_flags)
+    : execution_(std::make_unique<Execution>(path, cache_key, logger, coreml_flags)) {
 }
 
 Model::~Model() {}
@@ -50,6 +50,7 @@ REGISTER_VERSIONED_UNARY_ELEMENTWISE_TYPED_KERNEL(Relu, 13, 13, MLFloat16);
 REGISTER_UNARY_ELEMENTWISE_TYPED_KERNEL(Relu, 14, MLFloat16);
 REGISTER_VERSIONED_UNARY_ELEMENTWISE_TYPED_KERNEL(LeakyRelu, 6, 15, MLFloat16);
 REGISTER_UNARY_ELEMENTWISE_TYPED_KERNEL(LeakyRelu, 16, MLFloat16);
+REGISTER_UNARY_ELEMENTWISE_TYPED_KERNEL(Softplus, 1, MLFloat16);
 #endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
 
 REGISTER_UNARY_ELEMENTWISE_KERNEL(Selu, 6);
@@ -107,6 +108,13 @@ template Status ElementWiseRangedTransform<float>::Create(const std::string& typ
 }  // namespace functors
 
 namespace functors {
+template <>
+void Softplus<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
+  ptrdiff_t len = last - first;
+  float* output_ptr = output + first;
+  MlasComputeSoftplus(input + first, output_ptr, static_cast<size_t>(len));
+}
+
 template <>
 void Sigmoid<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
   ptrdiff_t len = last - first;
@@ -102,6 +102,9 @@ struct Softplus : public ElementWiseRangedTransform<T> {
   }
 };
 
+template <>
+void Softplus<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const;
+
 template <typename T>
 struct Relu : public ElementWiseRangedTransform<T> {
   Status Init(const onnxruntime::NodeAttributes&) {
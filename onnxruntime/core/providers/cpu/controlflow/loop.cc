@@ -24,6 +24,7 @@
 #include "core/providers/utils.h"
 
 #include "core/common/gsl.h"
+#include "core/common/safeint.h"
 
 #ifdef _MSC_VER
 #pragma warning(pop)
@@ -181,6 +182,18 @@ Loop::Info::Info(const onnxruntime::Node& node, const GraphViewer& subgraph_in)
     auto& output = subgraph_outputs[i];
     subgraph_output_names.push_back(output->Name());
   }
+
+  // e.g. a 'for' loop exported with a constant true condition. the 'cond' output may be the input itself or an
+  // Identity of it.
+  const auto& cond_input_name = subgraph_inputs[1]->Name();
+  const auto& cond_output_name = subgraph_outputs[0]->Name();
+  condition_passthrough = cond_input_name == cond_output_name;
+  if (!condition_passthrough) {
+    const auto* producer = subgraph.GetProducerNode(cond_output_name);
+    condition_passthrough = producer != nullptr && producer->OpType() == "Identity" &&
+                            producer->Domain() == kOnnxDomain &&
+                            producer->InputDefs()[0]->Name() == cond_input_name;
+  }
 }
 
 class LoopImpl {
@@ -204,6 +217,18 @@ class LoopImpl {
   // create the single Loop output from a collection of per-iteration outputs
   Status ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index);
 
+  // allocate the Loop output for scan output scan_output_index once the per-iteration shape is known
+  Status AllocateScanOutput(size_t scan_output_index, const TensorShape& per_iteration_shape);
+
+  // OrtValue for the slice of the Loop output written by the given iteration
+  OrtValue ScanOutputSlice(size_t scan_output_index, int64_t iteration) const;
+
+  // set the fetches of the scan outputs to the slices of the next iteration, and clear the others
+  void SetScanOutputFetches(std::vector<OrtValue>& fetches, int64_t iteration) const;
+
+  // make sure the scan outputs of the iteration are in their slice of the Loop outputs
+  Status SaveScanOutputs(const std::vector<OrtValue>& fetches, int64_t iteration);
+
   OpKernelContextInternal& context_;
   const SessionState& session_state_;
   const Loop::Info& info_;
@@ -220,6 +245,17 @@ class LoopImpl {
   // the order from the subgraph matches the order from the loop output
   std::vector<std::vector<OrtValue>> loop_output_tensors_;
 
+  // if the number of iterations is known before the first one, the subgraph writes the scan outputs directly into
+  // slices of the Loop outputs instead of them being saved in loop_output_tensors_ and concatenated at the end.
+  struct ScanOutput {
+    Tensor* output = nullptr;
+    TensorShape per_iteration_shape;
+    size_t bytes_per_iteration = 0;
+  };
+
+  bool scan_outputs_in_place_ = false;
+  std::vector<ScanOutput> scan_outputs_;
+
   const Loop::ConcatOutput& concat_output_func_;
 };
 
@@ -420,7 +456,14 @@ Status LoopImpl::Initialize() {
   iter_num_mlvalue_ = MakeScalarMLValue<int64_t>(cpu_allocator, 0, iter_num_rank != 0);
   condition_mlvalue_ = MakeScalarMLValue<bool>(cpu_allocator, condition_, condition_rank != 0);
 
-  loop_output_tensors_.resize(static_cast<size_t>(info_.num_outputs) - info_.num_loop_carried_vars);
+  const auto num_scan_outputs = static_cast<size_t>(info_.num_outputs) - info_.num_loop_carried_vars;
+  scan_outputs_in_place_ = info_.condition_passthrough && max_trip_count_tensor && max_trip_count_ > 0 &&
+                           condition_ && num_scan_outputs > 0;
+  if (scan_outputs_in_place_) {
+    scan_outputs_.resize(num_scan_outputs);
+  } else {
+    loop_output_tensors_.resize(num_scan_outputs);
+  }
 
   return status;
 }
@@ -453,6 +496,10 @@ void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outpu
     next_inputs[i] = last_outputs[i - 1];
   }
 
+  if (scan_outputs_in_place_) {
+    return;
+  }
+
   // save loop outputs as we have to concatenate at the end
   for (ptrdiff_t j = info_.num_loop_carried_vars; j < info_.num_outputs; ++j) {
     ORT_ENFORCE(last_outputs[j + 1].IsTensor(), "All scan outputs MUST be tensors");
@@ -480,6 +527,85 @@ Status LoopImpl::ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_outp
   return Status::OK();
 }
 
+Status LoopImpl::AllocateScanOutput(size_t scan_output_index, const TensorShape& per_iteration_shape) {
+  TensorShapeVector dims;
+  dims.reserve(per_iteration_shape.NumDimensions() + 1);
+
+  // first dimension is number of iterations
+  dims.push_back(max_trip_count_);
+  const auto& per_iteration_dims = per_iteration_shape.GetDims();
+  dims.insert(dims.end(), per_iteration_dims.begin(), per_iteration_dims.end());
+
+  const int output_index = info_.num_loop_carried_vars + static_cast<int>(scan_output_index);
+  Tensor* output = context_.Output(output_index, TensorShape(dims));
+  if (!output) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to create output tensor for output #", output_index);
+  }
+
+  auto& scan_output = scan_outputs_[scan_output_index];
+  scan_output.output = output;
+  scan_output.per_iteration_shape = per_iteration_shape;
+  scan_output.bytes_per_iteration = SafeInt<size_t>(per_iteration_shape.Size()) * output->DataType()->Size();
+
+  return Status::OK();
+}
+
+OrtValue LoopImpl::ScanOutputSlice(size_t scan_output_index, int64_t iteration) const {
+  const auto& scan_output = scan_outputs_[scan_output_index];
+  auto* data = static_cast<gsl::byte*>(scan_output.output->MutableDataRaw()) +
+               SafeInt<size_t>(iteration) * scan_output.bytes_per_iteration;
+
+  OrtValue slice;
+  Tensor::InitOrtValue(scan_output.output->DataType(), scan_output.per_iteration_shape, data,
+                       scan_output.output->Location(), slice);
+  return slice;
+}
+
+void LoopImpl::SetScanOutputFetches(std::vector<OrtValue>& fetches, int64_t iteration) const {
+  // cond and the loop carried vars are allocated by the subgraph as their shapes can change
+  for (ptrdiff_t i = 0; i <= info_.num_loop_carried_vars; ++i) {
+    fetches[i] = OrtValue();
+  }
+
+  for (size_t j = 0; j < scan_outputs_.size(); ++j) {
+    fetches[static_cast<size_t>(info_.num_loop_carried_vars) + j + 1] = ScanOutputSlice(j, iteration);  // skip cond
+  }
+}
+
+Status LoopImpl::SaveScanOutputs(const std::vector<OrtValue>& fetches, int64_t iteration) {
+  for (size_t j = 0; j < scan_outputs_.size(); ++j) {
+    const auto& fetch = fetches[static_cast<size_t>(info_.num_loop_carried_vars) + j + 1];  // skip cond
+    ORT_RETURN_IF_NOT(fetch.IsTensor(), "All scan outputs MUST be tensors");
+    const auto& iteration_data = fetch.Get<Tensor>();
+
+    auto& scan_output = scan_outputs_[j];
+    if (!scan_output.output) {
+      // the fetch allocator is not used if no node produces the subgraph output, e.g. it's an initializer
+      ORT_RETURN_IF_ERROR(AllocateScanOutput(j, iteration_data.Shape()));
+    }
+
+    OrtValue slice = ScanOutputSlice(j, iteration);
+    Tensor& slice_tensor = *slice.GetMutable<Tensor>();
+    if (iteration_data.DataRaw() == slice_tensor.DataRaw()) {
+      continue;
+    }
+
+    if (iteration_data.Shape() != scan_output.per_iteration_shape) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Inconsistent shape in loop output for output. ",
+                             " Expected:", scan_output.per_iteration_shape, " Got:", iteration_data.Shape());
+    }
+
+    auto* data_transfer = session_state_.GetDataTransferMgr().GetDataTransfer(iteration_data.Location().device,
+                                                                              slice_tensor.Location().device);
+    if (context_.GetComputeStream())
+      ORT_RETURN_IF_ERROR(data_transfer->CopyTensorAsync(iteration_data, slice_tensor, *context_.GetComputeStream()));
+    else
+      ORT_RETURN_IF_ERROR(data_transfer->CopyTensor(iteration_data, slice_tensor));
+  }
+
+  return Status::OK();
+}
+
 Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
   auto status = Status::OK();
 
@@ -488,27 +614,70 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
 
   CreateInitialFeeds(feeds);
 
+  // the device streams are acquired once for all iterations
+  utils::SubgraphExecutionState subgraph_state(session_state_);
+
   auto& iter_num_value = *iter_num_mlvalue_.GetMutable<Tensor>()->MutableData<int64_t>();
 
+  std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
+  if (scan_outputs_in_place_) {
+    fetches.resize(info_.num_subgraph_outputs);
+
+    // the first iteration allocates the Loop outputs when the subgraph requests the allocation of its outputs.
+    // the following iterations are given the slices to write to as fetches.
+    for (size_t j = 0; j < scan_outputs_.size(); ++j) {
+      const size_t fetch_index = static_cast<size_t>(info_.num_loop_carried_vars) + j + 1;  // skip cond
+      fetch_allocators[fetch_index] = [this, j, fetch_index, &fetches](const TensorShape& shape,
+                                                                       const OrtDevice& location,
+                                                                       OrtValue& ort_value, bool& allocated) {
+        ORT_RETURN_IF_ERROR(AllocateScanOutput(j, shape));
+        OrtValue slice = ScanOutputSlice(j, 0);
+
+        // same as Scan, if the Loop output is not on the device the subgraph output is produced on, the fetches
+        // copy logic in utils::ExecuteSubgraph moves it into the slice
+        if (slice.Get<Tensor>().Location().device == location) {
+          ort_value = slice;
+          allocated = true;
+        } else {
+          fetches[fetch_index] = slice;
+        }
+
+        return Status::OK();
+      };
+    }
+  }
+
   while (iter_num_value < max_trip_count_ && *condition_mlvalue_.GetMutable<Tensor>()->MutableData<bool>()) {
     if (iter_num_value != 0) {
       SaveOutputsAndUpdateFeeds(fetches, feeds);
-      fetches.clear();
+      if (scan_outputs_in_place_) {
+        fetch_allocators.clear();
+        SetScanOutputFetches(fetches, iter_num_value);
+      } else {
+        fetches.clear();
+      }
     }
 
-    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, {},
+    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, fetch_allocators,
                                     ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger(),
-                                    context_.GetComputeStream(),
+                                    context_.GetComputeStream(), subgraph_state,
                                     // because the fetch[0] is the loop condition which we need to access on CPU,
                                     // have to perofrm a stream sync to make sure the data arrived.
                                     true);
     ORT_RETURN_IF_ERROR(status);
 
+    if (scan_outputs_in_place_) {
+      ORT_RETURN_IF_ERROR(SaveScanOutputs(fetches, iter_num_value));
+    }
+
     condition_mlvalue_ = fetches[0];
 
     ++iter_num_value;
   }
 
+  ORT_RETURN_IF(scan_outputs_in_place_ && iter_num_value != max_trip_count_,
+                "Loop condition changed although the subgraph returns its condition input.");
+
   // As the loop carried variables may change shape across iterations there's no way to avoid a copy
   // as we need the final shape.
   auto copy_mlvalue_to_output = [this](OrtValue& input, int output_idx,
@@ -581,7 +750,7 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
       ORT_RETURN_IF_ERROR(copy_mlvalue_to_output(fetches[static_cast<ptrdiff_t>(i) + 1], i, iter_num_value, *info_.loop_carried_vars_types[static_cast<ptrdiff_t>(i)]));  // skip cond
     }
 
-    for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
+    for (int i = info_.num_loop_carried_vars; i < info_.num_outputs && !scan_outputs_in_place_; ++i) {
       // add last output
       auto& per_iteration_outputs = loop_output_tensors_[static_cast<ptrdiff_t>(i) - info_.num_loop_carried_vars];
       per_iteration_outputs.push_back(fetches[static_cast<ptrdiff_t>(i) + 1]);  // skip cond
@@ -38,6 +38,9 @@ class Loop : public controlflow::IControlFlowKernel {
     std::vector<std::string> subgraph_output_names;
 
     std::vector<const ONNX_NAMESPACE::TypeProto*> loop_carried_vars_types;
+
+    // true if the subgraph returns its 'cond' input unchanged, so only 'M' can end the Loop
+    bool condition_passthrough;
   };
 
   // function to concatenate the OrtValue instances from each Loop iteration into a single output buffer.
@@ -89,7 +89,8 @@ class ElementWiseKernel final : public OpKernel {
   Status Compute(OpKernelContext* context) const override {
     using T = typename F::DataType;
     const Tensor* X = context->Input<Tensor>(0);
-    Tensor* Y = context->Output(0, X->Shape());
+    // the functors compute each output element from the input element at the same position only
+    Tensor* Y = context->OutputMayReuseInput(0, 0, X->Shape());
     concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
     const int64_t input_size = X->Shape().Size();
     if (input_size == 0)
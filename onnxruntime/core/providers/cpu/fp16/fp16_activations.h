@@ -71,6 +71,26 @@ struct LeakyRelu<MLFloat16> : public ElementWiseRangedTransform<MLFloat16> {
   }
 };
 
+template <>
+struct Softplus<MLFloat16> : public ElementWiseRangedTransform<MLFloat16> {
+  Status Init(const onnxruntime::NodeAttributes&) {
+    return Status::OK();
+  }
+  GSL_SUPPRESS(r.11)
+  ElementWiseRangedTransform<MLFloat16>* Copy() const final {
+    using T1 = typename std::remove_pointer<decltype(this)>::type;
+    using T2 = typename std::remove_const<T1>::type;
+    return new T2(*this);
+  }
+  float Cost() const final {
+    return 15.0f;
+  }
+  void operator()(std::ptrdiff_t first, std::ptrdiff_t last) const final {
+    ptrdiff_t len = last - first;
+    MlasComputeSoftplus(this->input + first, this->output + first, static_cast<size_t>(len));
+  }
+};
+
 // TODO Add the following activations:
 //    MlasTanhActivation,
 //    MlasLogisticActivation,
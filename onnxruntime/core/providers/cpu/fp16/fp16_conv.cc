@@ -7,7 +7,7 @@
 
 #include "core/mlas/inc/mlas.h"
 
-#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+#ifdef MLAS_F16GEMM_INTRINSICS_SUPPORTED
 
 #include "core/common/safeint.h"
 #include "core/framework/float16.h"
@@ -630,4 +630,4 @@ ONNX_OPERATOR_TYPED_KERNEL_EX(
 
 }  // namespace onnxruntime
 
-#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
+#endif  // MLAS_F16GEMM_INTRINSICS_SUPPORTED
@@ -29,6 +29,9 @@ class Einsum : public OpKernel {
 
   std::string equation_;
   std::unique_ptr<EinsumEquationPreprocessor> einsum_equation_preprocessor_;
+
+  // Contraction order of the inputs for the last seen input shapes
+  mutable EinsumOp::ContractionOrderCache contraction_order_cache_;
 };
 
 }  // namespace onnxruntime
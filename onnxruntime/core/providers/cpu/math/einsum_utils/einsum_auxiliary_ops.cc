@@ -2,6 +2,11 @@
 // Licensed under the MIT License.
 
 #include "einsum_auxiliary_ops.h"
+#include "core/mlas/inc/mlas.h"
+
+#include <functional>
+#include <limits>
+#include <numeric>
 
 using namespace onnxruntime::common;
 
@@ -47,6 +52,30 @@ Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
   return Status::OK();
 }
 
+// All the batches go to a single MLAS call so that the thread pool is partitioned over the batches as well as over
+// each product instead of running one parallel GEMM after another.
+template <>
+Status MatMul<float>(const float* input_1_data, const float* input_2_data, float* output_data,
+                     size_t left_stride, size_t right_stride, size_t output_stride,
+                     size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+                     void* /*einsum_cuda_assets*/) {
+  std::vector<MLAS_SGEMM_DATA_PARAMS> data(num_batches);
+  for (size_t i = 0; i < num_batches; ++i) {
+    data[i].A = input_1_data + i * left_stride;
+    data[i].lda = K;
+    data[i].B = input_2_data + i * right_stride;
+    data[i].ldb = N;
+    data[i].C = output_data + i * output_stride;
+    data[i].ldc = N;
+    data[i].alpha = 1.0f;
+    data[i].beta = 0.0f;
+  }
+
+  MlasGemmBatch(CblasNoTrans, CblasNoTrans, M, N, K, data.data(), num_batches, tp);
+
+  return Status::OK();
+}
+
 // CPU specific ReduceSum helper
 template <typename T>
 std::unique_ptr<Tensor> ReduceSum(const Tensor& input, gsl::span<const int64_t> reduce_axes,
@@ -353,6 +382,198 @@ std::unique_ptr<Tensor> ReduceSum(const Tensor& input, const TensorShape& input_
   return device_reduce_sum_func(input, reduce_axes, true, allocator, &input_shape_override, tp, einsum_cuda_assets);
 }
 
+namespace {
+
+// Up to this many inputs the contraction order is searched exhaustively over all the ways of splitting the inputs
+// in two, which takes 3^n steps. Larger equations contract the cheapest pair first.
+constexpr size_t kMaxOptimalContractionInputs = 10;
+
+// The subscript labels an operand has, as a bit per label. Labels of size 1 are left out as they don't change the
+// cost and are summed out for free.
+using LabelMask = uint64_t;
+
+// Index of the input of a subset of inputs with a single one.
+size_t InputOfSubset(size_t subset) {
+  size_t input = 0;
+  while ((subset >>= 1) != 0) {
+    ++input;
+  }
+  return input;
+}
+
+struct ContractionCostModel {
+  std::vector<double> label_dims;
+  LabelMask output_labels = 0;
+
+  double Size(LabelMask labels) const {
+    double size = 1.0;
+    for (size_t label = 0; labels != 0; ++label, labels >>= 1) {
+      if (labels & 1) {
+        size *= label_dims[label];
+      }
+    }
+    return size;
+  }
+
+  // Multiply-adds of contracting two operands into one with the `kept` labels. The labels only one of the operands
+  // has and that are not kept are summed out before the product, see PairwiseOperandProcess().
+  double Cost(LabelMask left, LabelMask right, LabelMask kept) const {
+    const LabelMask summed_out_alone = (left ^ right) & ~kept;
+    return Size((left | right) & ~summed_out_alone);
+  }
+};
+
+double LeftToRightCost(const ContractionCostModel& model, gsl::span<const LabelMask> input_labels) {
+  std::vector<LabelMask> labels_after(input_labels.size() + 1, 0);
+  for (size_t i = input_labels.size(); i > 0; --i) {
+    labels_after[i - 1] = labels_after[i] | input_labels[i - 1];
+  }
+
+  double cost = 0.0;
+  LabelMask current = input_labels[0];
+  for (size_t i = 1; i < input_labels.size(); ++i) {
+    const LabelMask kept = (current | input_labels[i]) & (model.output_labels | labels_after[i + 1]);
+    cost += model.Cost(current, input_labels[i], kept);
+    current = kept;
+  }
+  return cost;
+}
+
+double OptimalContractionOrder(const ContractionCostModel& model, gsl::span<const LabelMask> input_labels,
+                               std::vector<ContractionStep>& contraction_order) {
+  const size_t num_inputs = input_labels.size();
+  const size_t num_subsets = size_t{1} << num_inputs;
+  const size_t all_inputs = num_subsets - 1;
+
+  // labels of the union of the inputs of each subset, of the result of contracting them, the cost of the cheapest
+  // contraction and the first half of the split it contracts last
+  std::vector<LabelMask> subset_labels(num_subsets, 0);
+  for (size_t subset = 1; subset < num_subsets; ++subset) {
+    const size_t lowest = subset & (~subset + 1);
+    subset_labels[subset] = subset_labels[subset ^ lowest] | input_labels[InputOfSubset(lowest)];
+  }
+  std::vector<LabelMask> kept_labels(num_subsets, 0);
+  std::vector<double> cost(num_subsets, 0.0);
+  std::vector<size_t> split(num_subsets, 0);
+
+  for (size_t subset = 1; subset < num_subsets; ++subset) {
+    kept_labels[subset] = subset_labels[subset] & (model.output_labels | subset_labels[all_inputs ^ subset]);
+    const size_t lowest = subset & (~subset + 1);
+    if (subset == lowest) {
+      continue;
+    }
+
+    // the first half holds the lowest input so that each split is seen once and keeps the inputs in order
+    cost[subset] = std::numeric_limits<double>::infinity();
+    for (size_t first = (subset - 1) & subset; first != 0; first = (first - 1) & subset) {
+      if ((first & lowest) == 0) {
+        continue;
+      }
+      const size_t second = subset ^ first;
+      const double split_cost = cost[first] + cost[second] +
+                                model.Cost(kept_labels[first], kept_labels[second], kept_labels[subset]);
+      if (split_cost < cost[subset]) {
+        cost[subset] = split_cost;
+        split[subset] = first;
+      }
+    }
+  }
+
+  // emit the contractions of each half before the one that combines them
+  std::function<size_t(size_t)> emit = [&](size_t subset) -> size_t {
+    if ((subset & (subset - 1)) == 0) {
+      return InputOfSubset(subset);
+    }
+    const size_t left = emit(split[subset]);
+    const size_t right = emit(subset ^ split[subset]);
+    contraction_order.push_back({left, right});
+    return num_inputs + contraction_order.size() - 1;
+  };
+  emit(all_inputs);
+
+  return cost[all_inputs];
+}
+
+double GreedyContractionOrder(const ContractionCostModel& model, gsl::span<const LabelMask> input_labels,
+                              std::vector<ContractionStep>& contraction_order) {
+  std::vector<size_t> operands(input_labels.size());
+  std::iota(operands.begin(), operands.end(), size_t{0});
+  std::vector<LabelMask> operand_labels(input_labels.begin(), input_labels.end());
+
+  double total_cost = 0.0;
+  while (operands.size() > 1) {
+    size_t best_i = 0, best_j = 1;
+    double best_cost = std::numeric_limits<double>::infinity();
+    LabelMask best_kept = 0;
+    for (size_t i = 0; i < operands.size(); ++i) {
+      for (size_t j = i + 1; j < operands.size(); ++j) {
+        LabelMask others = model.output_labels;
+        for (size_t k = 0; k < operands.size(); ++k) {
+          if (k != i && k != j) {
+            others |= operand_labels[operands[k]];
+          }
+        }
+        const LabelMask left = operand_labels[operands[i]];
+        const LabelMask right = operand_labels[operands[j]];
+        const LabelMask kept = (left | right) & others;
+        const double cost = model.Cost(left, right, kept);
+        if (cost < best_cost) {
+          best_cost = cost;
+          best_i = i;
+          best_j = j;
+          best_kept = kept;
+        }
+      }
+    }
+
+    contraction_order.push_back({operands[best_i], operands[best_j]});
+    operand_labels.push_back(best_kept);
+    total_cost += best_cost;
+    operands.erase(operands.begin() + best_j);
+    operands[best_i] = operand_labels.size() - 1;
+  }
+
+  return total_cost;
+}
+
+}  // namespace
+
+std::vector<ContractionStep> ComputeContractionOrder(gsl::span<const TensorShape> homogenized_input_dims,
+                                                     gsl::span<const int64_t> subscript_indices_to_output_indices) {
+  std::vector<ContractionStep> contraction_order;
+  const size_t num_inputs = homogenized_input_dims.size();
+  const size_t num_labels = subscript_indices_to_output_indices.size();
+  if (num_inputs <= 2 || num_labels > sizeof(LabelMask) * 8) {
+    return contraction_order;
+  }
+
+  ContractionCostModel model;
+  model.label_dims.assign(num_labels, 1.0);
+  std::vector<LabelMask> input_labels(num_inputs, 0);
+  for (size_t input = 0; input < num_inputs; ++input) {
+    const auto dims = homogenized_input_dims[input].GetDims();
+    for (size_t label = 0; label < num_labels; ++label) {
+      if (dims[label] > 1) {
+        input_labels[input] |= LabelMask{1} << label;
+        model.label_dims[label] = static_cast<double>(dims[label]);
+      }
+    }
+  }
+  for (size_t label = 0; label < num_labels; ++label) {
+    if (subscript_indices_to_output_indices[label] != -1) {
+      model.output_labels |= LabelMask{1} << label;
+    }
+  }
+
+  const double cost = num_inputs <= kMaxOptimalContractionInputs
+                          ? OptimalContractionOrder(model, input_labels, contraction_order)
+                          : GreedyContractionOrder(model, input_labels, contraction_order);
+  if (!(cost < LeftToRightCost(model, input_labels))) {
+    contraction_order.clear();
+  }
+  return contraction_order;
+}
+
 // Explicit template instantiations of functions
 
 // float
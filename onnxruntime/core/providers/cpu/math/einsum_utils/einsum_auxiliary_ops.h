@@ -12,8 +12,11 @@
 #include "core/providers/cpu/reduction/reduction_ops.h"
 #endif
 
+#include <algorithm>
 #include <vector>
 
+#include "core/platform/ort_mutex.h"
+
 namespace onnxruntime {
 
 namespace EinsumOp {
@@ -108,6 +111,47 @@ std::unique_ptr<Tensor> ReduceSum(const Tensor& input, const TensorShape& input_
                                   concurrency::ThreadPool* tp, void* cuda_ep,
                                   const DeviceHelpers::ReduceSum<T>& device_reduce_sum_func);
 
+// One pair-wise contraction of an Einsum evaluation order. The operands index the inputs followed by the results of
+// the preceding steps, so the result of step i is operand i + number of inputs.
+struct ContractionStep {
+  size_t left;
+  size_t right;
+};
+
+// Searches the order of pair-wise contractions of the inputs that needs the fewest multiply-adds, exhaustively for a
+// few inputs and greedily for more, in the spirit of numpy.einsum_path / opt_einsum.
+// The inputs are described by their homogenized dims, and subscript_indices_to_output_indices is -1 for the subscript
+// labels that are summed out. Returns an empty order when contracting the inputs from left to right is as cheap.
+std::vector<ContractionStep> ComputeContractionOrder(gsl::span<const TensorShape> homogenized_input_dims,
+                                                     gsl::span<const int64_t> subscript_indices_to_output_indices);
+
+// Holds the contraction order computed for the input shapes an Einsum node saw last, so that the following runs
+// with the same shapes skip the search.
+class ContractionOrderCache {
+ public:
+  bool TryGet(gsl::span<const int64_t> shapes_key, std::vector<ContractionStep>& contraction_order) const {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    if (!has_value_ || !std::equal(shapes_key.begin(), shapes_key.end(), shapes_key_.begin(), shapes_key_.end())) {
+      return false;
+    }
+    contraction_order = contraction_order_;
+    return true;
+  }
+
+  void Set(gsl::span<const int64_t> shapes_key, const std::vector<ContractionStep>& contraction_order) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    shapes_key_.assign(shapes_key.begin(), shapes_key.end());
+    contraction_order_ = contraction_order;
+    has_value_ = true;
+  }
+
+ private:
+  mutable OrtMutex mutex_;
+  bool has_value_ = false;
+  std::vector<int64_t> shapes_key_;
+  std::vector<ContractionStep> contraction_order_;
+};
+
 }  // namespace EinsumOp
 
 }  // namespace onnxruntime
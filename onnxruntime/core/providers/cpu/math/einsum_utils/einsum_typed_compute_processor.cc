@@ -343,6 +343,72 @@ void EinsumTypedComputeProcessor<T>::SetDeviceHelpers(const EinsumOp::DeviceHelp
   device_data_copy_func_ = device_data_copy_func;
 }
 
+template <typename T>
+void EinsumTypedComputeProcessor<T>::SetContractionOrderCache(EinsumOp::ContractionOrderCache* contraction_order_cache) {
+  contraction_order_cache_ = contraction_order_cache;
+}
+
+template <typename T>
+Status EinsumTypedComputeProcessor<T>::RunContractionOrder(gsl::span<const EinsumOp::ContractionStep> contraction_order) {
+  auto& preprocessed_inputs = einsum_compute_preprocessor_.GetPreprocessedInputTensors();
+  const auto& raw_inputs = einsum_compute_preprocessor_.GetRawInputTensors();
+  const auto& homogenized_input_dims = einsum_compute_preprocessor_.GetHomogenizedInputDims();
+  const auto& subscript_indices_to_output_indices =
+      einsum_compute_preprocessor_.GetMappedSubscriptIndicesToOutputindices();
+  const size_t num_subscript_labels = onnxruntime::narrow<size_t>(einsum_compute_preprocessor_.GetNumSubscriptIndices());
+  const size_t num_inputs = raw_inputs.size();
+
+  // The operands are the inputs followed by the results of the steps. Each operand is released once it's contracted.
+  std::vector<std::unique_ptr<Tensor>> results(contraction_order.size());
+  std::vector<bool> contracted(num_inputs + contraction_order.size(), false);
+
+  const auto operand = [&](size_t index) -> const Tensor& {
+    if (index >= num_inputs) {
+      return *results[index - num_inputs];
+    }
+    return preprocessed_inputs[index] ? *preprocessed_inputs[index] : *raw_inputs[index];
+  };
+  const auto operand_shape = [&](size_t index) -> const TensorShape& {
+    return index >= num_inputs ? results[index - num_inputs]->Shape() : homogenized_input_dims[index];
+  };
+
+  for (size_t step = 0; step < contraction_order.size(); ++step) {
+    const size_t left = contraction_order[step].left;
+    const size_t right = contraction_order[step].right;
+    contracted[left] = true;
+    contracted[right] = true;
+
+    // Sum out the labels that are not in the output and that no operand still to be contracted has
+    TensorShapeVector reduced_dims;
+    reduced_dims.reserve(num_subscript_labels);
+    for (size_t dim = 0; dim < num_subscript_labels; ++dim) {
+      if (subscript_indices_to_output_indices[dim] != -1) {
+        continue;
+      }
+      bool needed_later = false;
+      for (size_t other = 0; other < num_inputs + step && !needed_later; ++other) {
+        needed_later = !contracted[other] && operand_shape(other)[dim] > 1;
+      }
+      if (!needed_later) {
+        reduced_dims.push_back(static_cast<int64_t>(dim));
+      }
+    }
+
+    results[step] = PairwiseOperandProcess(operand(left), operand_shape(left), operand(right), operand_shape(right),
+                                           reduced_dims, step == contraction_order.size() - 1);
+
+    for (size_t index : {left, right}) {
+      if (index >= num_inputs) {
+        results[index - num_inputs].reset();
+      } else {
+        preprocessed_inputs[index].reset();
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
 template <typename T>
 Status EinsumTypedComputeProcessor<T>::Run() {
   const auto& mapped_indices_to_last_input_index = einsum_compute_preprocessor_.GetMappedSubscriptIndicesToLastInputIndex();
@@ -357,6 +423,31 @@ Status EinsumTypedComputeProcessor<T>::Run() {
 
   auto num_inputs = context_->InputCount();
 
+  // With more than two inputs, contract them in the order with the fewest multiply-adds when that is cheaper than
+  // from left to right
+  if (num_inputs > 2) {
+    std::vector<EinsumOp::ContractionStep> contraction_order;
+    TensorShapeVector shapes_key;
+    bool cached = false;
+    if (contraction_order_cache_) {
+      shapes_key.push_back(num_subscript_labels);
+      for (const auto& dims : homogenized_input_dims) {
+        shapes_key.insert(shapes_key.end(), dims.GetDims().begin(), dims.GetDims().end());
+      }
+      cached = contraction_order_cache_->TryGet(shapes_key, contraction_order);
+    }
+    if (!cached) {
+      contraction_order = EinsumOp::ComputeContractionOrder(
+          homogenized_input_dims, einsum_compute_preprocessor_.GetMappedSubscriptIndicesToOutputindices());
+      if (contraction_order_cache_) {
+        contraction_order_cache_->Set(shapes_key, contraction_order);
+      }
+    }
+    if (!contraction_order.empty()) {
+      return RunContractionOrder(contraction_order);
+    }
+  }
+
   // Pre-process the first input so as to reduce any dims that only it has
   std::unique_ptr<const Tensor> result;
 
@@ -33,11 +33,17 @@ class EinsumTypedComputeProcessor {
                         const EinsumOp::DeviceHelpers::ReduceSum<T>& device_reduce_sum_func,
                         const EinsumOp::DeviceHelpers::DataCopy& device_data_copy_func);
 
+  // Optional cache of the contraction order, owned by the kernel and kept across runs
+  void SetContractionOrderCache(EinsumOp::ContractionOrderCache* contraction_order_cache);
+
   Status Run();
 
  private:
   // Private methods -
 
+  // Contracts the operands pair-wise in the given order instead of from left to right
+  Status RunContractionOrder(gsl::span<const EinsumOp::ContractionStep> contraction_order);
+
   // Processes Einsum operands in a pair-wise fashion
   // Employs Transpose, ReduceSum, and MatMul under the hood
   // to achieve MatMul(a, b) and reduces (by summing) along specified axes
@@ -67,6 +73,8 @@ class EinsumTypedComputeProcessor {
 
   // Holds EP-specific assets required for (auxiliary) ops that need to be executed on non-CPU EPs
   void* einsum_ep_assets_;
+
+  EinsumOp::ContractionOrderCache* contraction_order_cache_ = nullptr;
 };
 
 }  // namespace onnxruntime
@@ -478,7 +478,7 @@ Status Add<T>::Compute(OpKernelContext* context) const {
         per_iter_bh.OutputEigen<T>() = per_iter_bh.EigenInput0<T>() + per_iter_bh.EigenInput1<T>();
       }};
 
-  UntypedBroadcastTwo(*context, funcs, 1.0f);
+  UntypedBroadcastTwoMayReuseInput(*context, funcs, 1.0f);
   return Status::OK();
 }
 
@@ -495,7 +495,7 @@ Status Sub<T>::Compute(OpKernelContext* context) const {
         per_iter_bh.OutputEigen<T>() = per_iter_bh.EigenInput0<T>() - per_iter_bh.EigenInput1<T>();
       }};
 
-  UntypedBroadcastTwo(*context, funcs, 1.0);
+  UntypedBroadcastTwoMayReuseInput(*context, funcs, 1.0);
   return Status::OK();
 }
 
@@ -512,10 +512,54 @@ Status Mul<T>::Compute(OpKernelContext* context) const {
         per_iter_bh.OutputEigen<T>() = per_iter_bh.EigenInput0<T>().cwiseProduct(per_iter_bh.EigenInput1<T>());
       }};
 
-  UntypedBroadcastTwo(*context, funcs, 1.0);
+  UntypedBroadcastTwoMayReuseInput(*context, funcs, 1.0);
+  return Status::OK();
+}
+
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+// Add and Mul are commutative so the scalar operand is always passed on the right.
+template <void (*EltwiseFn)(const MLFloat16*, const MLFloat16*, MLFloat16*, size_t, bool)>
+static Status EltwiseMLFloat16(OpKernelContext* context) {
+  ProcessBroadcastSpanFuncs funcs{
+      [](BroadcastHelper& per_iter_bh) {
+        auto input_1 = per_iter_bh.SpanInput1<MLFloat16>();
+        const MLFloat16 input_0 = per_iter_bh.ScalarInput0<MLFloat16>();
+        EltwiseFn(input_1.data(), &input_0, per_iter_bh.OutputSpan<MLFloat16>().data(), input_1.size(), true);
+      },
+      [](BroadcastHelper& per_iter_bh) {
+        auto input_0 = per_iter_bh.SpanInput0<MLFloat16>();
+        const MLFloat16 input_1 = per_iter_bh.ScalarInput1<MLFloat16>();
+        EltwiseFn(input_0.data(), &input_1, per_iter_bh.OutputSpan<MLFloat16>().data(), input_0.size(), true);
+      },
+      [](BroadcastHelper& per_iter_bh) {
+        auto input_0 = per_iter_bh.SpanInput0<MLFloat16>();
+        auto input_1 = per_iter_bh.SpanInput1<MLFloat16>();
+        EltwiseFn(input_0.data(), input_1.data(), per_iter_bh.OutputSpan<MLFloat16>().data(), input_0.size(), false);
+      }};
+
+  UntypedBroadcastTwoMayReuseInput(*context, funcs, 1.0);
   return Status::OK();
 }
 
+template <>
+Status Add<MLFloat16>::Compute(OpKernelContext* context) const {
+  return EltwiseMLFloat16<MlasEltwiseAdd>(context);
+}
+
+template <>
+Status Mul<MLFloat16>::Compute(OpKernelContext* context) const {
+  return EltwiseMLFloat16<MlasEltwiseMul>(context);
+}
+
+// registered after the specializations they instantiate
+REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, MLFloat16, Add);
+REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, MLFloat16, Add);
+REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, MLFloat16, Add);
+REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, MLFloat16, Mul);
+REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, MLFloat16, Mul);
+REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, MLFloat16, Mul);
+#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
+
 template <typename T>
 Status Div<T>::Compute(OpKernelContext* context) const {
   ProcessBroadcastSpanFuncs funcs{
@@ -529,7 +573,7 @@ Status Div<T>::Compute(OpKernelContext* context) const {
         per_iter_bh.OutputEigen<T>() = per_iter_bh.EigenInput0<T>().cwiseQuotient(per_iter_bh.EigenInput1<T>());
       }};
 
-  UntypedBroadcastTwo(*context, funcs, 1.0);
+  UntypedBroadcastTwoMayReuseInput(*context, funcs, 1.0);
   return Status::OK();
 }
 
@@ -1943,16 +1987,26 @@ void UntypedBroadcastTwo(OpKernelContext& context, const ProcessBroadcastSpanFun
   BroadcastLooper(broadcast_helper, funcs);
 }
 
-// Variant of UntypedBroadcastTwo that will parallelize.
-// Operator usage is the same as the parallelization is opaque to the operator.
-// unit_cost must be a valid cost value.
-void UntypedBroadcastTwo(OpKernelContext& context, const ProcessBroadcastSpanFuncs& funcs, double unit_cost,
-                         void* user_data) {
+// Parallelized broadcast of two inputs. If may_reuse_input is set the output is written into the buffer of an
+// input with the output shape when nothing reads that input after the kernel.
+static void UntypedBroadcastTwoImpl(OpKernelContext& context, const ProcessBroadcastSpanFuncs& funcs,
+                                    double unit_cost, void* user_data, bool may_reuse_input) {
   const Tensor& input0_tensor = *context.Input<Tensor>(0);
   const Tensor& input1_tensor = *context.Input<Tensor>(1);
   InputBroadcaster input_broadcaster(input0_tensor, input1_tensor);
 
-  Tensor& output_tensor = *context.Output(0, input_broadcaster.GetOutputShape());
+  const TensorShape output_shape = input_broadcaster.GetOutputShape();
+  int reuse_input = -1;
+  if (may_reuse_input) {
+    if (input0_tensor.Shape() == output_shape && context.IsInputDeadAfterKernel(0)) {
+      reuse_input = 0;
+    } else if (input1_tensor.Shape() == output_shape && context.IsInputDeadAfterKernel(1)) {
+      reuse_input = 1;
+    }
+  }
+
+  Tensor& output_tensor = reuse_input >= 0 ? *context.OutputMayReuseInput(0, reuse_input, output_shape)
+                                           : *context.Output(0, output_shape);
 
   size_t span_size = input_broadcaster.GetSpanSize();
   size_t output_size = static_cast<ptrdiff_t>(output_tensor.Shape().Size());
@@ -1995,6 +2049,19 @@ void UntypedBroadcastTwo(OpKernelContext& context, const ProcessBroadcastSpanFun
   }
 }
 
+// Variant of UntypedBroadcastTwo that will parallelize.
+// Operator usage is the same as the parallelization is opaque to the operator.
+// unit_cost must be a valid cost value.
+void UntypedBroadcastTwo(OpKernelContext& context, const ProcessBroadcastSpanFuncs& funcs, double unit_cost,
+                         void* user_data) {
+  UntypedBroadcastTwoImpl(context, funcs, unit_cost, user_data, /*may_reuse_input*/ false);
+}
+
+void UntypedBroadcastTwoMayReuseInput(OpKernelContext& context, const ProcessBroadcastSpanFuncs& funcs,
+                                      double unit_cost) {
+  UntypedBroadcastTwoImpl(context, funcs, unit_cost, /*user_data*/ nullptr, /*may_reuse_input*/ true);
+}
+
 // allocate_tensor should allocate a tensor of the output type with the given shape
 static void UntypedBroadcastVariadic(int input_count, OpKernelContext& context,
                                      AllocateTensorFunc allocate_tensor,
@@ -994,6 +994,12 @@ void UntypedBroadcastTwo(OpKernelContext& context, const ProcessBroadcastSpanFun
 void UntypedBroadcastTwo(OpKernelContext& context, const ProcessBroadcastSpanFuncs& funcs, double unit_cost,
                          void* user_data = nullptr);
 
+// Broadcast two inputs with parallelization, where each output element only depends on the input elements at the
+// same position. The output is written into the buffer of an input with the output shape if nothing reads that
+// input after the kernel runs.
+void UntypedBroadcastTwoMayReuseInput(OpKernelContext& context, const ProcessBroadcastSpanFuncs& funcs,
+                                      double unit_cost);
+
 // Helper to provide the looping logic with optimization for parallelizing within a single span if the
 // TBroadcastHelper instance was setup to enable that.
 template <typename TBroadcastHelper>
@@ -5,6 +5,7 @@
 #include "core/providers/cpu/math/gemm.h"
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
+#include "core/framework/kernel_dispatch.h"
 #include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/util/math_cpuonly.h"
 #include "gemm_helper.h"
@@ -138,6 +139,43 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
   return true;
 }
 
+size_t GemmPackBSparseFp32Size(const Tensor& tensor_b, bool trans_b) {
+  const auto& b_shape = tensor_b.Shape();
+  if (b_shape.NumDimensions() != 2) {
+    return 0;
+  }
+
+  const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+
+  // measures the zero blocks of B
+  return MlasSparseGemmPackBSize(trans_b ? CblasTrans : CblasNoTrans, N, K, tensor_b.Data<float>(),
+                                 trans_b ? K : N);
+}
+
+bool GemmPackBSparseFp32(AllocatorPtr& alloc,
+                         const Tensor& tensor_b,
+                         bool trans_b,
+                         IAllocatorUniquePtr<void>& packed_b,
+                         size_t& packed_b_size,
+                         TensorShape& b_shape) {
+  packed_b_size = GemmPackBSparseFp32Size(tensor_b, trans_b);
+  if (packed_b_size == 0) {
+    return false;
+  }
+  b_shape = tensor_b.Shape();
+
+  const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+
+  packed_b = IAllocator::MakeUniquePtr<void>(alloc, packed_b_size, true);
+  // zero the padding so the hash of the buffer used for sharing is deterministic
+  memset(packed_b.get(), 0, packed_b_size);
+  MlasSparseGemmPackB(trans_b ? CblasTrans : CblasNoTrans, N, K, tensor_b.Data<float>(), trans_b ? K : N,
+                      packed_b.get());
+  return true;
+}
+
 template <typename T>
 void Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           ptrdiff_t M, ptrdiff_t N, ptrdiff_t K,
@@ -189,7 +227,7 @@ void Gemm<MLFloat16>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans
 #if defined(__GNUC__) && defined(HAS_CLASS_MEMACCESS)
 #pragma GCC diagnostic pop
 #endif
-#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+#ifdef MLAS_F16GEMM_INTRINSICS_SUPPORTED
   bool support_mlas = false;
   if (c_shape == nullptr) {
     support_mlas = true;
@@ -236,6 +274,21 @@ template void Gemm<float>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE
                                        float* y_data,
                                        concurrency::ThreadPool* thread_pool);
 
+template <>
+void Gemm<float>::CreateJitKernels() {
+  // the generated kernels read the packed B built by GemmPackBFp32 and don't transpose A
+  if (packed_b_is_sparse_ || trans_A_ != CblasNoTrans) {
+    return;
+  }
+
+  const size_t N = static_cast<size_t>(trans_B_ != CblasNoTrans ? b_shape_[0] : b_shape_[1]);
+  const size_t K = static_cast<size_t>(trans_B_ != CblasNoTrans ? b_shape_[1] : b_shape_[0]);
+  const MLAS_ACTIVATION* activation = mlas_activation_.has_value() ? &*mlas_activation_ : nullptr;
+
+  jit_kernel_ = MlasSgemmJitKernelGet(N, K, activation, false);
+  jit_bias_kernel_ = MlasSgemmJitKernelGet(N, K, activation, true);
+}
+
 template <typename T>
 Status Gemm<T>::PrePack(const Tensor& /* tensor */, int /* input_idx */, AllocatorPtr /*alloc_for_caching*/,
                         /*out*/ bool& is_packed,
@@ -253,9 +306,23 @@ Status Gemm<float>::PrePack(const Tensor& tensor, int input_idx,
   // only pack Matrix B
   if (input_idx == 1) {
     size_t packed_b_size;
-    is_packed = GemmPackBFp32(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_);
+    // MlasSparseGemmBatch doesn't transpose A
+    packed_b_is_sparse_ = trans_A_ == CblasNoTrans &&
+                          GemmPackBSparseFp32(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size,
+                                              b_shape_);
+    is_packed = packed_b_is_sparse_ ||
+                GemmPackBFp32(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_);
+    if (is_packed) {
+      CreateJitKernels();
+    }
     bool share_prepacked_weights = (prepacked_weights != nullptr);
     if (is_packed && share_prepacked_weights) {
+      // the sparse buffer goes after an empty placeholder, so the layout can be told apart when it is shared
+      // or persisted
+      if (packed_b_is_sparse_) {
+        prepacked_weights->buffers_.push_back(nullptr);
+        prepacked_weights->buffer_sizes_.push_back(0);
+      }
       prepacked_weights->buffers_.push_back(std::move(packed_b_));
       prepacked_weights->buffer_sizes_.push_back(packed_b_size);
     }
@@ -279,7 +346,37 @@ Status Gemm<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prep
 
   if (input_idx == 1) {
     used_shared_buffers = true;
-    packed_b_ = std::move(prepacked_buffers[0]);
+    packed_b_ = std::move(prepacked_buffers.back());
+  }
+  return Status::OK();
+}
+
+template <typename T>
+Status Gemm<T>::UsePersistedPrePackedBuffers(const Tensor& /*tensor*/,
+                                             std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                             int /*input_idx*/,
+                                             /*out*/ bool& used_persisted_buffers) {
+  used_persisted_buffers = false;
+  return Status::OK();
+}
+
+template <>
+Status Gemm<float>::UsePersistedPrePackedBuffers(const Tensor& tensor,
+                                                 std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                 int input_idx,
+                                                 /*out*/ bool& used_persisted_buffers) {
+  used_persisted_buffers = false;
+
+  // the state GemmPackBFp32 or GemmPackBSparseFp32 sets up in PrePack
+  const bool buffers_are_sparse = prepacked_buffers.size() == 2;
+  if (input_idx == 1 && tensor.Shape().NumDimensions() == 2 &&
+      buffers_are_sparse == (trans_A_ == CblasNoTrans &&
+                             GemmPackBSparseFp32Size(tensor, trans_B_ != CblasNoTrans) != 0)) {
+    used_persisted_buffers = true;
+    b_shape_ = tensor.Shape();
+    packed_b_ = std::move(prepacked_buffers.back());
+    packed_b_is_sparse_ = buffers_are_sparse;
+    CreateJitKernels();
   }
   return Status::OK();
 }
@@ -408,24 +505,64 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
   const float* c_data = C != nullptr ? C->Data<float>() : nullptr;
   const TensorShape* c_shape = C != nullptr ? &C->Shape() : nullptr;
 
-  if (B) {
+  // A bias row broadcast over the rows of Y and an activation supported by MLAS are
+  // applied to each output block by the GEMM itself instead of in separate passes.
+  const bool is_bias_row = c_data != nullptr && beta_ == 1.0f &&
+                           c_shape->Size() == N &&
+                           (c_shape->NumDimensions() == 1 ||
+                            (c_shape->NumDimensions() == 2 && (*c_shape)[0] == 1));
+
+  if (B && !is_bias_row && !mlas_activation_.has_value()) {
     ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, A->Data<float>(), B->Data<float>(), beta_,
                 c_data, c_shape, y_data, thread_pool);
   } else {
-    GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
-    MlasGemm(
-        trans_A_,
-        static_cast<size_t>(M),
-        static_cast<size_t>(N),
-        static_cast<size_t>(K),
-        alpha_,
-        A->Data<float>(),
-        static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K),
-        packed_b_.get(),
-        c_data != nullptr ? beta_ : 0.0f,
-        y_data,
-        static_cast<size_t>(N),
-        thread_pool);
+    if (!is_bias_row) {
+      GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
+    }
+
+    MLAS_SGEMM_EPILOGUE_PROCESSOR epilogue(mlas_activation_.has_value() ? &*mlas_activation_ : nullptr,
+                                           is_bias_row ? c_data : nullptr);
+
+    const float beta = (c_data != nullptr && !is_bias_row) ? beta_ : 0.0f;
+
+    if (packed_b_is_sparse_) {
+      MLAS_SPARSE_SGEMM_DATA_PARAMS data;
+      data.A = A->Data<float>();
+      data.lda = static_cast<size_t>(K);
+      data.PackedB = packed_b_.get();
+      data.C = y_data;
+      data.ldc = static_cast<size_t>(N);
+      data.alpha = alpha_;
+      data.beta = beta;
+      data.OutputProcessor = &epilogue;
+
+      MlasSparseGemmBatch(static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+                          &data, 1, thread_pool);
+    } else {
+      MLAS_SGEMM_DATA_PARAMS data;
+      data.A = A->Data<float>();
+      data.lda = static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K);
+      if (B) {
+        data.B = B->Data<float>();
+        data.ldb = static_cast<size_t>(trans_B_ != CblasNoTrans ? K : N);
+      } else {
+        data.B = static_cast<const float*>(packed_b_.get());
+        data.BIsPacked = true;
+        // MLAS runs the generated kernel in place of the epilogue when it partitions the rows
+        data.JitKernel = is_bias_row ? jit_bias_kernel_.get() : jit_kernel_.get();
+        data.JitBias = is_bias_row ? c_data : nullptr;
+      }
+      data.C = y_data;
+      data.ldc = static_cast<size_t>(N);
+      data.alpha = alpha_;
+      data.beta = beta;
+      data.OutputProcessor = &epilogue;
+
+      RecordKernelDispatch("mlas_sgemm", data.JitKernel != nullptr ? "jit" : MlasSgemmGetKernelName());
+      MlasGemm(trans_A_, B ? trans_B_ : CblasNoTrans,
+               static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+               data, thread_pool);
+    }
   }
 
   ComputeActivation(y_data, SafeInt<size_t>(M) * N, thread_pool);
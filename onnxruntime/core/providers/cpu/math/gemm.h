@@ -3,11 +3,14 @@
 
 #pragma once
 
+#include <optional>
+
 #include "gemm_base.h"
 
 #include "core/framework/op_kernel.h"
 #include "core/common/common.h"
 #include "core/util/math.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/cpu/activation/activations.h"
 
 namespace onnxruntime {
@@ -28,6 +31,11 @@ class Gemm : protected GemmBase, public OpKernel {
                                    int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  Status UsePersistedPrePackedBuffers(const Tensor& tensor,
+                                      std::vector<BufferUniquePtr>& prepacked_buffers,
+                                      int input_idx,
+                                      /*out*/ bool& used_persisted_buffers) override;
+
   static void ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           ptrdiff_t M, ptrdiff_t N, ptrdiff_t K,
                           T alpha,
@@ -40,10 +48,23 @@ class Gemm : protected GemmBase, public OpKernel {
  protected:
   TensorShape b_shape_;
   IAllocatorUniquePtr<void> packed_b_;
+  // packed_b_ holds the nonzero blocks of B for MlasSparseGemmBatch
+  bool packed_b_is_sparse_{false};
 
   // For fused gemm + activation
   std::unique_ptr<functors::ElementWiseRangedTransform<T>> activation_;
 
+  // For fused gemm + activation applied by MLAS to the output blocks while they are
+  // still in the cache. Takes the place of activation_ when set.
+  std::optional<MLAS_ACTIVATION> mlas_activation_;
+
+  // SGEMM kernels generated by MLAS for the shape of the packed B and the epilogue, without and
+  // with a bias row. Null when the platform or the shape is not supported.
+  std::shared_ptr<const MLAS_SGEMM_JIT_KERNEL> jit_kernel_;
+  std::shared_ptr<const MLAS_SGEMM_JIT_KERNEL> jit_bias_kernel_;
+
+  void CreateJitKernels();
+
   void ComputeActivation(_Inout_updates_(y_size) T* y_data, ptrdiff_t y_size, _Inout_opt_ concurrency::ThreadPool* thread_pool) const;
 };
 
@@ -14,4 +14,17 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
                    size_t& packed_b_size,
                    TensorShape& b_shape);
 
+// Size of the nonzero blocks of B packed for MlasSparseGemmBatch, or 0 if B is not
+// a 2D matrix that is sparse enough to be faster than the dense layout of GemmPackBFp32.
+size_t GemmPackBSparseFp32Size(const Tensor& tensor_b, bool trans_b);
+
+// Packs the nonzero blocks of B for MlasSparseGemmBatch. Returns false if
+// GemmPackBSparseFp32Size is 0.
+bool GemmPackBSparseFp32(AllocatorPtr& alloc,
+                         const Tensor& tensor_b,
+                         bool trans_b,
+                         IAllocatorUniquePtr<void>& packed_b,
+                         size_t& packed_b_size,
+                         TensorShape& b_shape);
+
 };  // namespace onnxruntime
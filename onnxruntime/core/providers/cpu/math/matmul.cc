@@ -2,19 +2,34 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/math/matmul.h"
+
+#include <optional>
+
+#include "core/common/narrow.h"
+#include "core/common/type_list.h"
+#include "core/framework/huge_page_allocator.h"
+#include "core/framework/kernel_dispatch.h"
 #include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/providers/cpu/math/matmul_helper.h"
+#include "core/providers/cpu/tensor/strided_view.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
+// the float kernel reads the matrices of strided inputs through the leading dimensions of the gemm.
+#ifdef ENABLE_STRIDED_TENSORS
+#define CREATE_MATMUL_FLOAT_KERNEL_DEF KernelDefBuilder().MayStridedInput(0).MayStridedInput(1)
+#else
+#define CREATE_MATMUL_FLOAT_KERNEL_DEF KernelDefBuilder()
+#endif
+
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     MatMul,
     1, 8,
     float,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    CREATE_MATMUL_FLOAT_KERNEL_DEF.TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     MatMul<float>);
 
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
@@ -30,7 +45,7 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     9,
     12,
     float,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    CREATE_MATMUL_FLOAT_KERNEL_DEF.TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     MatMul<float>);
 
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
@@ -63,7 +78,7 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     MatMul,
     13,
     float,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    CREATE_MATMUL_FLOAT_KERNEL_DEF.TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     MatMul<float>);
 
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
@@ -89,6 +104,31 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
         .TypeConstraint("T", BuildKernelDefConstraints<int64_t, uint64_t>()),
     MatMul<int64_t>);
 
+#ifdef MLAS_F16GEMM_INTRINSICS_SUPPORTED
+// Registered by RegisterFp16Kernels when MlasFp16AccelerationSupported()
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    1, 8,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    9,
+    12,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    MatMul,
+    13,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+#endif
+
 template <typename T>
 Status MatMul<T>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
@@ -126,6 +166,104 @@ Status MatMul<T>::Compute(OpKernelContext* ctx) const {
   return Status::OK();
 }
 
+#ifdef MLAS_F16GEMM_INTRINSICS_SUPPORTED
+template <>
+Status MatMul<MLFloat16>::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const auto* a = ctx->Input<Tensor>(0);
+  const auto* b = ctx->Input<Tensor>(1);
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  const auto* a_data = a->Data<MLFloat16>();
+  const auto* b_data = b->Data<MLFloat16>();
+  auto* y_data = y->MutableData<MLFloat16>();
+
+  const size_t max_len = helper.OutputOffsets().size();
+  std::vector<MLAS_HALF_GEMM_DATA_PARAMS> data(max_len);
+  for (size_t i = 0; i < max_len; i++) {
+    data[i].A = a_data + helper.LeftOffsets()[i];
+    data[i].lda = K;
+    data[i].B = b_data + helper.RightOffsets()[i];
+    data[i].ldb = N;
+    data[i].C = y_data + helper.OutputOffsets()[i];
+    data[i].ldc = N;
+  }
+  MlasHalfGemmBatch(M, N, K, max_len, data.data(), thread_pool);
+
+  return Status::OK();
+}
+#endif
+
+size_t MatMul<float>::Bf16PackBSize(const TensorShape& b_shape) const {
+  // MlasSBGemmBatch doesn't transpose A or scale the product
+  if (!allow_bf16_ || trans_a_attr_ != 0 || alpha_attr_ != 1.0f || b_shape.NumDimensions() != 2) {
+    return 0;
+  }
+  const bool trans_b = trans_b_attr_ != 0;
+  const size_t K = static_cast<size_t>(trans_b ? b_shape[1] : b_shape[0]);
+  const size_t N = static_cast<size_t>(trans_b ? b_shape[0] : b_shape[1]);
+  return MlasSBGemmPackBSize(N, K);
+}
+
+MatMul<float>::PackedBLayout MatMul<float>::SelectPackedBLayout(const Tensor& tensor) const {
+  if (Bf16PackBSize(tensor.Shape()) != 0) {
+    return PackedBLayout::Bf16;
+  }
+  // MlasSparseGemmBatch doesn't transpose A
+  if (trans_a_attr_ == 0 && GemmPackBSparseFp32Size(tensor, trans_b_attr_ != 0) != 0) {
+    return PackedBLayout::Sparse;
+  }
+  return PackedBLayout::Fp32;
+}
+
+void MatMul<float>::CreateJitKernel() {
+  // the generated kernels don't transpose A
+  if (packed_b_layout_ != PackedBLayout::Fp32 || trans_a_attr_ != 0) {
+    return;
+  }
+  const bool trans_b = trans_b_attr_ != 0;
+  const size_t K = static_cast<size_t>(trans_b ? b_shape_[1] : b_shape_[0]);
+  const size_t N = static_cast<size_t>(trans_b ? b_shape_[0] : b_shape_[1]);
+  jit_kernel_ = MlasSgemmJitKernelGet(N, K, nullptr, false);
+}
+
+void MatMul<float>::ReplicatePackedB() {
+  packed_b_replica_data_.clear();
+  packed_b_replicas_.clear();
+  if (!use_numa_replicas_ || !packed_b_ || packed_b_layout_ != PackedBLayout::Fp32) {
+    return;
+  }
+
+  // small weights stay in the caches, and each copy takes at least a huge page
+  const int node_count = HugePageCPUAllocator::GetNumaNodeCount();
+  const bool trans_b = trans_b_attr_ != 0;
+  const size_t K = static_cast<size_t>(trans_b ? b_shape_[1] : b_shape_[0]);
+  const size_t N = static_cast<size_t>(trans_b ? b_shape_[0] : b_shape_[1]);
+  const size_t packed_b_size = MlasGemmPackBSize(N, K);
+  if (node_count < 2 || packed_b_size < HugePageCPUAllocator::kHugePage2MB) {
+    return;
+  }
+
+  for (int node = 0; node < node_count; node++) {
+    auto node_alloc = std::make_shared<HugePageCPUAllocator>(HugePageCPUAllocator::kHugePage2MB, node);
+    packed_b_replicas_.push_back(IAllocator::MakeUniquePtr<void>(std::move(node_alloc), packed_b_size));
+    memcpy(packed_b_replicas_.back().get(), packed_b_.get(), packed_b_size);
+    packed_b_replica_data_.push_back(static_cast<const float*>(packed_b_replicas_.back().get()));
+  }
+}
+
 Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ AllocatorPtr alloc,
                               /*out*/ bool& is_packed,
                               /*out*/ PrePackedWeights* prepacked_weights) {
@@ -133,13 +271,39 @@ Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ Alloc
 
   // only pack Matrix B
   if (input_idx == 1) {
-    size_t packed_b_size;
-    is_packed = GemmPackBFp32(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
+    const bool trans_b = trans_b_attr_ != 0;
+    size_t packed_b_size = 0;
+    packed_b_layout_ = SelectPackedBLayout(tensor);
+    if (packed_b_layout_ == PackedBLayout::Bf16) {
+      packed_b_size = Bf16PackBSize(tensor.Shape());
+      b_shape_ = tensor.Shape();
+      const size_t K = static_cast<size_t>(trans_b ? b_shape_[1] : b_shape_[0]);
+      const size_t N = static_cast<size_t>(trans_b ? b_shape_[0] : b_shape_[1]);
+      packed_b_ = IAllocator::MakeUniquePtr<void>(alloc, packed_b_size, true);
+      // zero the padding so the hash of the buffer used for sharing is deterministic
+      memset(packed_b_.get(), 0, packed_b_size);
+      MlasSBGemmConvertPackB(trans_b ? CblasTrans : CblasNoTrans, N, K, tensor.Data<float>(), trans_b ? K : N,
+                             packed_b_.get(), nullptr);
+      is_packed = true;
+    } else if (packed_b_layout_ == PackedBLayout::Sparse) {
+      is_packed = GemmPackBSparseFp32(alloc, tensor, trans_b, packed_b_, packed_b_size, b_shape_);
+    } else {
+      is_packed = GemmPackBFp32(alloc, tensor, trans_b, packed_b_, packed_b_size, b_shape_);
+      if (is_packed) {
+        CreateJitKernel();
+      }
+    }
     bool share_prepacked_weights = (prepacked_weights != nullptr);
     if (is_packed && share_prepacked_weights) {
+      for (int i = 0; i < static_cast<int>(packed_b_layout_); i++) {
+        prepacked_weights->buffers_.push_back(nullptr);
+        prepacked_weights->buffer_sizes_.push_back(0);
+      }
       prepacked_weights->buffers_.push_back(std::move(packed_b_));
       prepacked_weights->buffer_sizes_.push_back(packed_b_size);
     }
+    // the copies of shared buffers are made in UseSharedPrePackedBuffers
+    ReplicatePackedB();
   }
   return Status::OK();
 }
@@ -151,12 +315,100 @@ Status MatMul<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& pr
 
   if (input_idx == 1) {
     used_shared_buffers = true;
-    packed_b_ = std::move(prepacked_buffers[0]);
+    packed_b_ = std::move(prepacked_buffers.back());
+    ReplicatePackedB();
+  }
+
+  return Status::OK();
+}
+
+Status MatMul<float>::UsePersistedPrePackedBuffers(const Tensor& tensor,
+                                                   std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                   int input_idx,
+                                                   /*out*/ bool& used_persisted_buffers) {
+  used_persisted_buffers = false;
+
+  // the state PrePack sets up. the buffers may have been packed by a session with another precision
+  // setting, in which case they are packed again
+  const auto buffers_layout = static_cast<PackedBLayout>(prepacked_buffers.size() - 1);
+  if (input_idx == 1 && !prepacked_buffers.empty() && tensor.Shape().NumDimensions() == 2 &&
+      buffers_layout == SelectPackedBLayout(tensor)) {
+    used_persisted_buffers = true;
+    b_shape_ = tensor.Shape();
+    packed_b_ = std::move(prepacked_buffers.back());
+    packed_b_layout_ = buffers_layout;
+    CreateJitKernel();
+    ReplicatePackedB();
   }
 
   return Status::OK();
 }
 
+#ifdef ENABLE_STRIDED_TENSORS
+namespace {
+
+// The layout of the matrices of a strided input that the gemm can read directly.
+struct StridedMatrixLayout {
+  bool trans = false;
+  size_t ld = 0;
+  // the element strides of the batch dimensions.
+  TensorShapeVector batch_strides;
+  TensorShapeVector batch_dims;
+};
+
+// Returns whether the matrices of a strided tensor have a unit stride in one of the last two dimensions, in which
+// case the gemm reads them with the other stride as the leading dimension. e.g. the transpose of the key of an
+// attention head is read as a transposed matrix.
+bool GetStridedMatrixLayout(const Tensor& tensor, StridedMatrixLayout& layout) {
+  const auto& shape = tensor.Shape();
+  const size_t rank = shape.NumDimensions();
+  if (rank < 2) {
+    return false;
+  }
+
+  const auto strides = tensor.Strides();
+  const int64_t rows = shape[rank - 2];
+  const int64_t cols = shape[rank - 1];
+
+  // the stride of a dimension of size 1 is never used.
+  const int64_t row_stride = rows == 1 ? cols : strides[rank - 2];
+  const int64_t col_stride = cols == 1 ? 1 : strides[rank - 1];
+
+  if (col_stride == 1 && row_stride >= cols) {
+    layout.trans = false;
+    layout.ld = static_cast<size_t>(row_stride);
+  } else if (row_stride == 1 && col_stride >= rows) {
+    layout.trans = true;
+    layout.ld = static_cast<size_t>(col_stride);
+  } else {
+    return false;
+  }
+
+  layout.batch_strides.assign(strides.begin(), strides.end() - 2);
+  layout.batch_dims.assign(shape.GetDims().begin(), shape.GetDims().end() - 2);
+  return true;
+}
+
+// Returns the element offset of the matrix of a strided tensor at the offset 'contiguous_offset' of the contiguous
+// tensor, as given by MatMulComputeHelper.
+std::ptrdiff_t StridedMatrixOffset(const StridedMatrixLayout& layout, size_t matrix_size, size_t contiguous_offset) {
+  if (matrix_size == 0) {
+    return 0;
+  }
+
+  size_t batch = contiguous_offset / matrix_size;
+  int64_t offset = 0;
+  for (size_t i = layout.batch_dims.size(); i-- > 0;) {
+    const auto dim = static_cast<size_t>(layout.batch_dims[i]);
+    offset += static_cast<int64_t>(batch % dim) * layout.batch_strides[i];
+    batch /= dim;
+  }
+  return narrow<std::ptrdiff_t>(offset);
+}
+
+}  // namespace
+#endif
+
 Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
 
@@ -176,6 +428,19 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   if (y->Shape().Size() == 0)
     return Status::OK();
 
+#ifdef ENABLE_STRIDED_TENSORS
+  // B packed for the bfloat16 and sparse gemms is read with contiguous matrices of A.
+  std::optional<Tensor> a_contiguous;
+  if (!a->IsContiguous() && packed_b_ && packed_b_layout_ != PackedBLayout::Fp32) {
+    AllocatorPtr alloc;
+    ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+    a_contiguous.emplace(a->DataType(), a->Shape(), alloc);
+    ORT_RETURN_IF_ERROR(ComputeStridedView<TypeList<float>>(thread_pool, *a, *a_contiguous,
+                                                            ToShapeVector(a->Strides()), 0));
+    a = &*a_contiguous;
+  }
+#endif
+
   const auto* a_data = a->Data<float>();
   const auto* b_data = b ? b->Data<float>() : nullptr;
   auto* y_data = y->MutableData<float>();
@@ -187,6 +452,41 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const size_t lda = helper.Lda(trans_a);
   const size_t ldb = helper.Ldb(trans_b);
 
+  if (packed_b_ && packed_b_layout_ == PackedBLayout::Bf16) {
+    std::vector<MLAS_SBGEMM_DATA_PARAMS> data(max_len);
+    for (size_t i = 0; i < max_len; i++) {
+      data[i].A = a_data + helper.LeftOffsets()[i];
+      data[i].lda = lda;
+      data[i].B = packed_b_.get();
+      data[i].C = y_data + helper.OutputOffsets()[i];
+      data[i].ldc = N;
+    }
+    RecordKernelDispatch("mlas_sgemm", "sbgemm");
+    MlasSBGemmBatch(M, N, K, data.data(), max_len, thread_pool);
+    return Status::OK();
+  }
+
+  if (packed_b_ && packed_b_layout_ == PackedBLayout::Sparse) {
+    std::vector<MLAS_SPARSE_SGEMM_DATA_PARAMS> data(max_len);
+    for (size_t i = 0; i < max_len; i++) {
+      data[i].A = a_data + helper.LeftOffsets()[i];
+      data[i].lda = lda;
+      data[i].PackedB = packed_b_.get();
+      data[i].C = y_data + helper.OutputOffsets()[i];
+      data[i].ldc = N;
+      data[i].alpha = alpha_attr_;
+    }
+    RecordKernelDispatch("mlas_sgemm", "sparse");
+    MlasSparseGemmBatch(M, N, K, data.data(), max_len, thread_pool);
+    return Status::OK();
+  }
+
+#ifdef ENABLE_STRIDED_TENSORS
+  if (!a->IsContiguous() || (b != nullptr && !b->IsContiguous())) {
+    return ComputeStrided(ctx, *a, b, helper, *y);
+  }
+#endif
+
   std::vector<MLAS_SGEMM_DATA_PARAMS> data(max_len);
   for (size_t i = 0; i < max_len; i++) {
     data[i].BIsPacked = bool(packed_b_);
@@ -198,11 +498,95 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
     data[i].ldc = N;
     data[i].alpha = alpha_attr_;
     data[i].beta = 0.0f;
+    data[i].JitKernel = jit_kernel_.get();
+    data[i].BNodeReplicas = packed_b_replica_data_.data();
+    data[i].BNodeReplicaCount = packed_b_replica_data_.size();
   }
+  RecordKernelDispatch("mlas_sgemm", jit_kernel_ ? "jit" : MlasSgemmGetKernelName());
   MlasGemmBatch(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
                 M, N, K, data.data(), max_len, thread_pool);
 
   return Status::OK();
 }
 
+#ifdef ENABLE_STRIDED_TENSORS
+Status MatMul<float>::ComputeStrided(OpKernelContext* ctx, const Tensor& a, const Tensor* b,
+                                     const MatMulComputeHelper& helper, Tensor& y) const {
+  // FusedMatMul doesn't take strided inputs.
+  ORT_RETURN_IF(trans_a_attr_ || trans_b_attr_ || trans_batch_a_ || trans_batch_b_,
+                "Strided inputs are only supported without transposed inputs.");
+
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+
+  // a strided input whose matrices the gemm can't read directly is copied to a contiguous tensor.
+  auto get_layout = [&](const Tensor*& input, std::optional<Tensor>& contiguous,
+                        StridedMatrixLayout& layout) -> Status {
+    if (!GetStridedMatrixLayout(*input, layout)) {
+      if (!input->IsContiguous()) {
+        contiguous.emplace(input->DataType(), input->Shape(), alloc);
+        ORT_RETURN_IF_ERROR(ComputeStridedView<TypeList<float>>(thread_pool, *input, *contiguous,
+                                                                ToShapeVector(input->Strides()), 0));
+        input = &*contiguous;
+      }
+      // a vector has no layout and is read as a single row or column.
+      GetStridedMatrixLayout(*input, layout);
+    }
+    return Status::OK();
+  };
+
+  const Tensor* a_input = &a;
+  std::optional<Tensor> a_contiguous;
+  StridedMatrixLayout a_layout;
+  ORT_RETURN_IF_ERROR(get_layout(a_input, a_contiguous, a_layout));
+  const float* a_data = a_input->Data<float>();
+  if (a_input->Shape().NumDimensions() < 2) {
+    a_layout.ld = K;
+  }
+
+  const float* b_data = nullptr;
+  StridedMatrixLayout b_layout;
+  std::optional<Tensor> b_contiguous;
+  if (b != nullptr) {
+    const Tensor* b_input = b;
+    ORT_RETURN_IF_ERROR(get_layout(b_input, b_contiguous, b_layout));
+    b_data = b_input->Data<float>();
+    if (b_input->Shape().NumDimensions() < 2) {
+      b_layout.ld = N;
+    }
+  } else {
+    b_layout.ld = static_cast<size_t>(helper.Ldb(false));
+  }
+
+  auto* y_data = y.MutableData<float>();
+  const size_t max_len = helper.OutputOffsets().size();
+  std::vector<MLAS_SGEMM_DATA_PARAMS> data(max_len);
+  for (size_t i = 0; i < max_len; i++) {
+    data[i].BIsPacked = bool(packed_b_);
+    data[i].A = a_data + StridedMatrixOffset(a_layout, M * K, helper.LeftOffsets()[i]);
+    data[i].lda = a_layout.ld;
+    data[i].B = data[i].BIsPacked ? (float*)packed_b_.get()
+                                  : b_data + StridedMatrixOffset(b_layout, K * N, helper.RightOffsets()[i]);
+    data[i].ldb = b_layout.ld;
+    data[i].C = y_data + helper.OutputOffsets()[i];
+    data[i].ldc = N;
+    data[i].alpha = alpha_attr_;
+    data[i].beta = 0.0f;
+    data[i].JitKernel = jit_kernel_.get();
+    data[i].BNodeReplicas = packed_b_replica_data_.data();
+    data[i].BNodeReplicaCount = packed_b_replica_data_.size();
+  }
+  RecordKernelDispatch("mlas_sgemm", jit_kernel_ ? "jit" : MlasSgemmGetKernelName());
+  MlasGemmBatch(a_layout.trans ? CblasTrans : CblasNoTrans, b_layout.trans ? CblasTrans : CblasNoTrans,
+                M, N, K, data.data(), max_len, thread_pool);
+
+  return Status::OK();
+}
+#endif
+
 }  // namespace onnxruntime
@@ -4,9 +4,13 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 
+class MatMulComputeHelper;
+
 template <typename T>
 class MatMul final : public OpKernel {
  public:
@@ -15,6 +19,11 @@ class MatMul final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 };
 
+#ifdef MLAS_F16GEMM_INTRINSICS_SUPPORTED
+template <>
+Status MatMul<MLFloat16>::Compute(OpKernelContext* context) const;
+#endif
+
 template <>
 class MatMul<float> final : public OpKernel {
  public:
@@ -27,6 +36,8 @@ class MatMul<float> final : public OpKernel {
     info.GetAttrOrDefault<int64_t>("transBatchB", &trans_batch_b_attr, 0);
     trans_batch_a_ = trans_batch_a_attr != 0;
     trans_batch_b_ = trans_batch_b_attr != 0;
+    allow_bf16_ = info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsMlasGemmFastMathBf16, "0") == "1";
+    use_numa_replicas_ = info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsMlasGemmNumaReplicas, "0") == "1";
   }
 
   Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
@@ -36,11 +47,48 @@ class MatMul<float> final : public OpKernel {
   Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  Status UsePersistedPrePackedBuffers(const Tensor& tensor, std::vector<BufferUniquePtr>& prepacked_buffers,
+                                      int input_idx, /*out*/ bool& used_persisted_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
  private:
+  // Layout of packed_b_. The buffers shared or persisted for a layout are preceded by as many
+  // empty placeholders as the value of the layout, so the layouts can be told apart.
+  enum class PackedBLayout {
+    Fp32 = 0,    // packed by GemmPackBFp32 for MlasGemmBatch
+    Bf16 = 1,    // converted to bfloat16 for MlasSBGemmBatch
+    Sparse = 2,  // the nonzero blocks packed by GemmPackBSparseFp32 for MlasSparseGemmBatch
+  };
+
+  // Size of B packed for MlasSBGemmBatch, or 0 if B is packed for MlasGemmBatch
+  size_t Bf16PackBSize(const TensorShape& b_shape) const;
+
+  // The layout PrePack chooses for B
+  PackedBLayout SelectPackedBLayout(const Tensor& tensor) const;
+
+  // Sets jit_kernel_ for B packed in the Fp32 layout
+  void CreateJitKernel();
+
+  // Sets packed_b_replicas_ for B packed in the Fp32 layout, if use_numa_replicas_ is set
+  void ReplicatePackedB();
+
+#ifdef ENABLE_STRIDED_TENSORS
+  // Computes the output of MatMul for strided inputs
+  Status ComputeStrided(OpKernelContext* ctx, const Tensor& a, const Tensor* b, const MatMulComputeHelper& helper,
+                        Tensor& y) const;
+#endif
+
   TensorShape b_shape_;
   IAllocatorUniquePtr<void> packed_b_;
+  PackedBLayout packed_b_layout_{PackedBLayout::Fp32};
+  // SGEMM kernel generated by MLAS for the shape of the packed B, or null if not supported
+  std::shared_ptr<const MLAS_SGEMM_JIT_KERNEL> jit_kernel_;
+  bool allow_bf16_{false};
+  // copies of packed_b_ bound to the memory of each NUMA node, see kOrtSessionOptionsMlasGemmNumaReplicas
+  bool use_numa_replicas_{false};
+  std::vector<IAllocatorUniquePtr<void>> packed_b_replicas_;
+  std::vector<const float*> packed_b_replica_data_;
 
   // For FusedMatMul contrib ops
   float alpha_attr_;
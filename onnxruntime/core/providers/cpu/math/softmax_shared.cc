@@ -26,7 +26,9 @@
 
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
+#include "core/framework/float16.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 template <typename T>
@@ -103,4 +105,33 @@ common::Status SoftmaxCPU<float>(size_t N,
   return Status::OK();
 }
 
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+template <>
+common::Status SoftmaxCPU<MLFloat16>(size_t N,
+                                     size_t D,
+                                     const MLFloat16* Xdata,
+                                     MLFloat16* Ydata,
+                                     bool logarithmic,
+                                     onnxruntime::concurrency::ThreadPool* thread_pool) {
+  // each row is widened to single precision and normalized with the float kernel
+  std::vector<float> buffer(N * D);
+
+  concurrency::ThreadPool::TryBatchParallelFor(
+      thread_pool, static_cast<int32_t>(N),
+      [&](ptrdiff_t n) {
+        float* row = buffer.data() + n * D;
+        MlasConvertHalfToFloatBuffer(reinterpret_cast<const unsigned short*>(Xdata + n * D), row, D);
+        MlasComputeSoftmax(row, row, 1, D, logarithmic, nullptr);
+
+        MLFloat16* output = Ydata + n * D;
+        for (size_t d = 0; d < D; ++d) {
+          output[d] = MLFloat16(row[d]);
+        }
+      },
+      0);
+
+  return Status::OK();
+}
+#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
+
 }  // namespace onnxruntime
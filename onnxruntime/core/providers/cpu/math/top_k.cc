@@ -25,6 +25,7 @@
 #include <queue>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <core/common/safeint.h>
 
 namespace onnxruntime {
@@ -140,6 +141,18 @@ static void SelectTopK(const Comparator& comparer,
   // the data_holder now contains the indices of the top k elements in the first k elements
 }
 
+// Returns the number of threads to split the rows of a TopK over.
+static int64_t TopKThreadCount(const TensorShape& input_shape, int64_t rows, const unsigned k,
+                               concurrency::ThreadPool* threadpool) {
+  int64_t tp_threads = concurrency::ThreadPool::DegreeOfParallelism(threadpool);
+  int64_t num_threads = std::min(tp_threads, rows);  // split on rows so can't have more threads than rows
+
+  // rough attempt to make sure there's enough work for each thread. if there's insufficient work the usage of
+  // too many threads degrades performance.
+  int64_t threads_needed = static_cast<int64_t>(std::floor(input_shape.Size() * k / (128 * 1024)));
+  return std::max(std::min(threads_needed, num_threads), static_cast<int64_t>(1));
+}
+
 // Given an input tensor 'input' and metadata values - 'k' and 'axis_parsed',
 // this method will extract the sorted top k largest/smallest elements and place them in the output tensor 'values'
 // along with the metadata output 'indices'
@@ -164,14 +177,8 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
   const int64_t num_blocks = input_shape[axis_parsed];
   const int64_t block_slice = reduced_cols / k;
 
-  int64_t tp_threads = concurrency::ThreadPool::DegreeOfParallelism(threadpool);
-  int64_t num_threads = std::min(tp_threads, rows);  // split on rows so can't have more threads than rows
-
-  // rough attempt to make sure there's enough work for each thread. if there's insufficient work the usage of
-  // too many threads degrades performance.
   // TODO: May want a different calculation for each branch below instead.
-  int64_t threads_needed = static_cast<int64_t>(std::floor(input_shape.Size() * k / (128 * 1024)));
-  num_threads = std::max(std::min(threads_needed, num_threads), static_cast<int64_t>(1));
+  const int64_t num_threads = TopKThreadCount(input_shape, rows, k, threadpool);
 
   // from testing various batch sizes relative to k, the following appears to work well as a selector.
   // tested with following combinations
@@ -326,6 +333,291 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
   }
 }
 
+/*
+Threshold filter and radix select.
+
+The values are mapped to unsigned keys that sort in the same order as the values. A row is scanned once and only
+the keys greater than a threshold are copied to a buffer. When the buffer fills up it's reduced to the top k keys
+with a radix select and the threshold is raised to the smallest of them, so for the long rows of a vocabulary
+almost all the values are rejected by a single compare.
+
+The radix select finds the top k keys of the buffer a digit at a time, starting from the most significant digit:
+  - a histogram of the digit finds the bucket holding the k-th key.
+  - the keys of the higher buckets are selected and the keys of that bucket are kept as the candidates for the
+    next digit.
+Once all the digits are consumed the remaining candidates have equal values, and the ones with the lowest indices
+are taken like the comparators above do.
+*/
+template <typename T>
+struct RadixSelectTraits;
+
+// Number of values checked at a time by the threshold filter.
+constexpr int64_t kRadixSelectFilterBlock = 16;
+
+template <>
+struct RadixSelectTraits<float> {
+  using KeyType = uint32_t;
+  static constexpr int kDigitBits = 11;
+
+  static KeyType ToKey(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    // -0 and 0 compare equal
+    bits = (bits == 0x80000000u) ? 0 : bits;
+    return bits ^ (static_cast<uint32_t>(static_cast<int32_t>(bits) >> 31) | 0x80000000u);
+  }
+
+  // Returns true if a value of the block may beat the threshold value. NaN values always may.
+  template <int64_t kBlock>
+  static bool AnyBeats(const float* values, float threshold, KeyType /*threshold_key*/, bool largest) {
+    int any = 0;
+    if (largest) {
+      for (int64_t b = 0; b < kBlock; ++b) {
+        any |= static_cast<int>(!(values[b] <= threshold));
+      }
+    } else {
+      for (int64_t b = 0; b < kBlock; ++b) {
+        any |= static_cast<int>(!(values[b] >= threshold));
+      }
+    }
+    return any != 0;
+  }
+};
+
+template <>
+struct RadixSelectTraits<MLFloat16> {
+  using KeyType = uint16_t;
+  static constexpr int kDigitBits = 8;
+
+  static KeyType ToKey(MLFloat16 value) {
+    uint16_t bits = value.val;
+    bits = (bits == 0x8000u) ? 0 : bits;
+    return static_cast<uint16_t>(bits ^ (static_cast<uint16_t>(static_cast<int16_t>(bits) >> 15) | 0x8000u));
+  }
+
+  template <int64_t kBlock>
+  static bool AnyBeats(const MLFloat16* values, MLFloat16 /*threshold*/, KeyType threshold_key, bool largest) {
+    const KeyType invert = largest ? KeyType{0} : static_cast<KeyType>(~KeyType{0});
+    int any = 0;
+    for (int64_t b = 0; b < kBlock; ++b) {
+      any |= static_cast<int>(static_cast<KeyType>(ToKey(values[b]) ^ invert) > threshold_key);
+    }
+    return any != 0;
+  }
+};
+
+// Minimum size of a contiguous float row for the threshold filter to be used instead of a heap or nth_element.
+constexpr int64_t kRadixSelectMinBlocks = 4096;
+
+// Minimum number of keys buffered by the threshold filter before they're reduced to the top k.
+constexpr size_t kRadixSelectMinBufferSize = 1024;
+
+// Returns the bucket of the histogram that holds the 'need'-th largest key and sets 'need' to the number of keys
+// needed from that bucket.
+static size_t FindRadixSelectBucket(const std::vector<size_t>& histogram, size_t num_buckets, size_t& need) {
+  size_t bucket = num_buckets - 1;
+  while (histogram[bucket] < need) {
+    need -= histogram[bucket];
+    --bucket;
+  }
+  return bucket;
+}
+
+// Reduces 'items' to the k pairs with the largest keys, preferring the lowest indices for equal keys.
+// The order of the result is unspecified. 'histogram', 'candidates' and 'next_candidates' are scratch buffers.
+template <typename KeyType, int kDigitBits>
+static void RadixSelect(std::vector<std::pair<KeyType, int64_t>>& items, const size_t k,
+                        std::vector<size_t>& histogram,
+                        std::vector<std::pair<KeyType, int64_t>>& candidates,
+                        std::vector<std::pair<KeyType, int64_t>>& next_candidates) {
+  constexpr int kKeyBits = static_cast<int>(sizeof(KeyType) * 8);
+
+  if (items.size() <= k) {
+    return;
+  }
+
+  candidates.swap(items);
+  items.clear();
+
+  size_t need = k;
+  int shift = kKeyBits;
+  while (candidates.size() > need && shift > 0) {
+    const int bits = std::min(kDigitBits, shift);
+    shift -= bits;
+    const size_t num_buckets = size_t{1} << bits;
+    const size_t mask = num_buckets - 1;
+
+    std::fill_n(histogram.begin(), num_buckets, size_t{0});
+    for (const auto& candidate : candidates) {
+      ++histogram[(candidate.first >> shift) & mask];
+    }
+
+    const size_t bucket = FindRadixSelectBucket(histogram, num_buckets, need);
+
+    next_candidates.clear();
+    for (const auto& candidate : candidates) {
+      const size_t digit = (candidate.first >> shift) & mask;
+      if (digit > bucket) {
+        items.push_back(candidate);
+      } else if (digit == bucket) {
+        next_candidates.push_back(candidate);
+      }
+    }
+    candidates.swap(next_candidates);
+  }
+
+  if (candidates.size() > need) {
+    // the candidates have equal keys
+    std::nth_element(candidates.begin(), candidates.begin() + need, candidates.end(),
+                     [](const std::pair<KeyType, int64_t>& lhs, const std::pair<KeyType, int64_t>& rhs) {
+                       return lhs.second < rhs.second;
+                     });
+  }
+
+  items.insert(items.end(), candidates.begin(), candidates.begin() + need);
+}
+
+template <typename T>
+static void FindTopKElementsRadixSelect(const Tensor* input, const TensorShape& input_shape, Tensor* values,
+                                        Tensor* indices, const TensorShape& output_shape, const unsigned k,
+                                        bool largest, bool sorted, const unsigned axis_parsed,
+                                        concurrency::ThreadPool* threadpool) {
+  using Traits = RadixSelectTraits<T>;
+  using KeyType = typename Traits::KeyType;
+  using KeyIndex = std::pair<KeyType, int64_t>;
+
+  const int64_t rows = input_shape.SizeToDimension(static_cast<size_t>(axis_parsed));
+  const int64_t cols = input->Shape().Size() / rows;
+  const T* input_data = input->Data<T>();
+
+  const int64_t reduced_cols = output_shape.SizeFromDimension(static_cast<size_t>(axis_parsed));
+  T* values_data = values->MutableData<T>();
+  int64_t* indices_data = indices->MutableData<int64_t>();
+
+  const int64_t num_blocks = input_shape[axis_parsed];
+  const int64_t block_slice = reduced_cols / k;
+  const int64_t num_threads = TopKThreadCount(input_shape, rows, k, threadpool);
+
+  // select the largest keys of the inverted keys to find the smallest values
+  const KeyType invert = largest ? KeyType{0} : static_cast<KeyType>(~KeyType{0});
+  const size_t buffer_size = std::max(size_t{4} * k, kRadixSelectMinBufferSize);
+
+  auto find_top_k = [num_threads, rows, cols, num_blocks, block_slice, reduced_cols, k, largest, sorted, invert,
+                     buffer_size, input_data, values_data, indices_data](std::ptrdiff_t batch) {
+    auto work = concurrency::ThreadPool::PartitionWork(batch, onnxruntime::narrow<size_t>(num_threads),
+                                                       onnxruntime::narrow<size_t>(rows));
+
+    // re-use the buffers for all the rows processed by this thread
+    std::vector<size_t> histogram(size_t{1} << Traits::kDigitBits);
+    std::vector<KeyIndex> items;
+    std::vector<KeyIndex> candidates;
+    std::vector<KeyIndex> next_candidates;
+    items.reserve(buffer_size);
+
+    // reduces the buffer to the top k keys and returns the smallest of them
+    auto reduce = [&]() {
+      RadixSelect<KeyType, Traits::kDigitBits>(items, k, histogram, candidates, next_candidates);
+      auto smallest = std::min_element(items.begin(), items.end(), [](const KeyIndex& lhs, const KeyIndex& rhs) {
+        return lhs.first < rhs.first;
+      });
+      return *smallest;
+    };
+
+    for (auto i = work.start; i < work.end; ++i) {
+      for (int64_t j = 0; j < block_slice; ++j) {
+        const T* row = input_data + i * cols + j;
+        items.clear();
+
+        // fill the buffer, then only keep the keys that beat the k-th key found so far. a later key equal to the
+        // threshold has a higher index than the keys it ties with so it's never selected.
+        const int64_t prefix = std::min(num_blocks, static_cast<int64_t>(buffer_size));
+        for (int64_t l = 0; l < prefix; ++l) {
+          items.emplace_back(static_cast<KeyType>(Traits::ToKey(row[l * block_slice]) ^ invert), l);
+        }
+
+        if (prefix < num_blocks) {
+          KeyIndex threshold = reduce();
+          T threshold_value = row[threshold.second * block_slice];
+          int64_t l = prefix;
+          while (l < num_blocks) {
+            // skip the blocks without any value beating the threshold. the check vectorizes for contiguous rows.
+            if (block_slice == 1) {
+              while (l + kRadixSelectFilterBlock <= num_blocks &&
+                     !Traits::template AnyBeats<kRadixSelectFilterBlock>(row + l, threshold_value, threshold.first,
+                                                                         largest)) {
+                l += kRadixSelectFilterBlock;
+              }
+            }
+
+            const int64_t end = std::min(l + kRadixSelectFilterBlock, num_blocks);
+            for (; l < end; ++l) {
+              const KeyType key = static_cast<KeyType>(Traits::ToKey(row[l * block_slice]) ^ invert);
+              if (key > threshold.first) {
+                items.emplace_back(key, l);
+                if (items.size() == buffer_size) {
+                  threshold = reduce();
+                  threshold_value = row[threshold.second * block_slice];
+                }
+              }
+            }
+          }
+        }
+
+        RadixSelect<KeyType, Traits::kDigitBits>(items, k, histogram, candidates, next_candidates);
+
+        if (sorted) {
+          std::sort(items.begin(), items.end(), [](const KeyIndex& lhs, const KeyIndex& rhs) {
+            return lhs.first > rhs.first || (lhs.first == rhs.first && lhs.second < rhs.second);
+          });
+        }
+
+        T* row_values = values_data + i * reduced_cols + j;
+        int64_t* row_indices = indices_data + i * reduced_cols + j;
+        for (size_t l = 0; l < k; ++l) {
+          const int64_t idx = items[l].second;
+          row_values[l * block_slice] = row[idx * block_slice];
+          row_indices[l * block_slice] = idx;
+        }
+      }
+    }
+  };
+
+  if (num_threads <= 1) {
+    find_top_k(0);
+  } else {
+    concurrency::ThreadPool::TrySimpleParallelFor(threadpool, onnxruntime::narrow<ptrdiff_t>(num_threads), find_top_k);
+  }
+}
+
+// Selects the top k elements with the threshold filter for the long float rows and for fp16, which has no other
+// implementation, or with the comparator based implementations otherwise.
+template <typename T>
+static void FindTopK(const Tensor* input, const TensorShape& input_shape, Tensor* values, Tensor* indices,
+                     const TensorShape& output_shape, const unsigned k, bool largest, bool sorted,
+                     const unsigned axis_parsed, concurrency::ThreadPool* threadpool) {
+  if constexpr (std::is_same<T, MLFloat16>::value) {
+    FindTopKElementsRadixSelect<T>(input, input_shape, values, indices, output_shape, k, largest, sorted,
+                                   axis_parsed, threadpool);
+  } else {
+    if constexpr (std::is_same<T, float>::value) {
+      const bool contiguous = input_shape.SizeFromDimension(static_cast<size_t>(axis_parsed) + 1) == 1;
+      if (k > 1 && contiguous && input_shape[axis_parsed] >= kRadixSelectMinBlocks) {
+        FindTopKElementsRadixSelect<T>(input, input_shape, values, indices, output_shape, k, largest, sorted,
+                                       axis_parsed, threadpool);
+        return;
+      }
+    }
+
+    if (largest) {
+      FindTopKElements<GreaterValueCmp<T>>(input, input_shape, values, indices, output_shape, k, sorted,
+                                           axis_parsed, threadpool);
+    } else {
+      FindTopKElements<LesserValueCmp<T>>(input, input_shape, values, indices, output_shape, k, sorted,
+                                          axis_parsed, threadpool);
+    }
+  }
+}
+
 // Wrapper over core TopK implementation
 template <typename T>
 static Status TopKImpl(OpKernelContext* p_op_kernel_context, const Tensor* input, const int axis, const unsigned k,
@@ -359,13 +651,8 @@ static Status TopKImpl(OpKernelContext* p_op_kernel_context, const Tensor* input
 
   auto* threadpool = p_op_kernel_context->GetOperatorThreadPool();
 
-  if (largest) {
-    FindTopKElements<GreaterValueCmp<T>>(input, input_shape, values, indices, output_shape, k, sorted,
-                                         gsl::narrow_cast<unsigned>(axis_parsed), threadpool);
-  } else {
-    FindTopKElements<LesserValueCmp<T>>(input, input_shape, values, indices, output_shape, k, sorted,
-                                        gsl::narrow_cast<unsigned>(axis_parsed), threadpool);
-  }
+  FindTopK<T>(input, input_shape, values, indices, output_shape, k, largest, sorted,
+              gsl::narrow_cast<unsigned>(axis_parsed), threadpool);
 
   return Status::OK();
 }
@@ -402,13 +689,8 @@ Status GetTopK(const Tensor* input, const int axis, const unsigned k, bool large
     return Status::OK();
   }
 
-  if (largest) {
-    FindTopKElements<GreaterValueCmp<T>>(input, input_shape, &output_values, &output_indices, output_shape, k, sorted,
-                                         gsl::narrow_cast<unsigned>(axis_parsed), threadpool);
-  } else {
-    FindTopKElements<LesserValueCmp<T>>(input, input_shape, &output_values, &output_indices, output_shape, k, sorted,
-                                        gsl::narrow_cast<unsigned>(axis_parsed), threadpool);
-  }
+  FindTopK<T>(input, input_shape, &output_values, &output_indices, output_shape, k, largest, sorted,
+              gsl::narrow_cast<unsigned>(axis_parsed), threadpool);
 
   return Status::OK();
 }
@@ -420,6 +702,12 @@ template Status GetTopK<float>(const Tensor* input, const int axis, const unsign
                                Tensor& output_values,
                                Tensor& output_indices);
 
+template Status GetTopK<MLFloat16>(const Tensor* input, const int axis, const unsigned k, bool largest, bool sorted,
+                                   AllocatorPtr allocator,
+                                   onnxruntime::concurrency::ThreadPool* threadpool,
+                                   Tensor& output_values,
+                                   Tensor& output_indices);
+
 // Opset ver - 1 to 9
 
 static void TopkOpset9ConstructorCommon(const OpKernelInfo& op_kernel_info, int& axis, unsigned int& k) {
@@ -551,6 +839,11 @@ TopK<11, int64_t>::TopK(const OpKernelInfo& op_kernel_info) : OpKernel(op_kernel
   TopkOpset11ConstructorCommon(op_kernel_info, axis_, largest_, sorted_);
 }
 
+template <>
+TopK<11, MLFloat16>::TopK(const OpKernelInfo& op_kernel_info) : OpKernel(op_kernel_info) {
+  TopkOpset11ConstructorCommon(op_kernel_info, axis_, largest_, sorted_);
+}
+
 // Opset ver - 11
 template <>
 Status TopK<11, float>::Compute(OpKernelContext* p_op_kernel_context) const {
@@ -572,6 +865,11 @@ Status TopK<11, int64_t>::Compute(OpKernelContext* p_op_kernel_context) const {
   return ComputeImplOpset1011<int64_t>(p_op_kernel_context, axis_, largest_, sorted_);
 }
 
+template <>
+Status TopK<11, MLFloat16>::Compute(OpKernelContext* p_op_kernel_context) const {
+  return ComputeImplOpset1011<MLFloat16>(p_op_kernel_context, axis_, largest_, sorted_);
+}
+
 // Register necessary kernels
 // spec https://github.com/onnx/onnx/blob/main/docs/Operators.md#TopK
 
@@ -600,5 +898,6 @@ REGISTER_TOPK_TYPED_KERNEL(11, float);
 REGISTER_TOPK_TYPED_KERNEL(11, double);
 REGISTER_TOPK_TYPED_KERNEL(11, int64_t);
 REGISTER_TOPK_TYPED_KERNEL(11, int32_t);
+REGISTER_TOPK_TYPED_KERNEL(11, MLFloat16);
 
 }  // namespace onnxruntime
@@ -50,7 +50,8 @@ ONNX_CPU_OPERATOR_ML_KERNEL(
     Imputer,
     1,
     KernelDefBuilder().TypeConstraint("T", {DataTypeImpl::GetTensorType<float>(),
-                                            DataTypeImpl::GetTensorType<int64_t>()}),
+                                            DataTypeImpl::GetTensorType<int64_t>()})
+        .MayInplace(0, 0),
     ImputerOp);
 
 ImputerOp::ImputerOp(const OpKernelInfo& info) : OpKernel(info),
@@ -83,28 +84,26 @@ common::Status ComputeByType(OpKernelContext* context,
 
   const T* x_data = X.Data<T>();
   size_t x_size = onnxruntime::narrow<size_t>(x_shape.Size());
-  int64_t stride = dims.size() == 1 ? dims[0] : dims[1];
+  size_t stride = onnxruntime::narrow<size_t>(dims.size() == 1 ? dims[0] : dims[1]);
 
   Tensor* Y = context->Output(0, x_shape);
   T* y_data = Y->MutableData<T>();
-  if (imputed_values.size() == static_cast<size_t>(stride)) {
-    for (size_t i = 0; i < x_size; i++) {
-      if (std::isnan(static_cast<float>(x_data[i])) && std::isnan(static_cast<float>(replaced_value))) {
-        y_data[i] = imputed_values[i % stride];
-      } else if (x_data[i] == replaced_value) {
-        y_data[i] = imputed_values[i % stride];
-      } else {
-        y_data[i] = x_data[i];
-      }
-    }
-  } else {
-    for (size_t i = 0; i < x_size; i++) {
-      if (std::isnan(static_cast<float>(x_data[i])) && std::isnan(static_cast<float>(replaced_value))) {
-        y_data[i] = imputed_values[0];
-      } else if (x_data[i] == replaced_value) {
-        y_data[i] = imputed_values[0];
+  if (x_size == 0) {
+    return Status::OK();
+  }
+
+  // Y may share the buffer of X, every value is read before it is written.
+  const size_t step = imputed_values.size() == stride ? 1 : 0;
+  const bool replace_nan = std::isnan(static_cast<float>(replaced_value));
+  for (size_t row = 0; row < x_size; row += stride) {
+    const T* x = x_data + row;
+    T* y = y_data + row;
+    for (size_t c = 0; c < stride; ++c) {
+      const T value = x[c];
+      if ((replace_nan && std::isnan(static_cast<float>(value))) || value == replaced_value) {
+        y[c] = imputed_values[c * step];
       } else {
-        y_data[i] = x_data[i];
+        y[c] = value;
       }
     }
   }
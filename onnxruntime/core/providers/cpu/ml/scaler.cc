@@ -60,8 +60,6 @@ ONNX_CPU_OPERATOR_TYPED_ML_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<int32_t>()).MayInplace(0, 0),
     ScalerOp<int32_t>);
 
-static constexpr int kParallelizationThreshold = 10 * 1000;
-
 template <typename T>
 ScalerOp<T>::ScalerOp(const OpKernelInfo& info) : OpKernel(info),
                                                   scale_(info.GetAttrsOrDefault<float>("scale")),
@@ -83,35 +81,38 @@ common::Status ScalerOp<T>::Compute(OpKernelContext* context) const {
     return Status(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid argument: input has empty dimensions.");
   }
 
-  size_t x_size = onnxruntime::narrow<size_t>(x_shape.Size());
-  int64_t stride = x_dims.size() == 1 ? x_dims[0] : x_dims[1];
-  auto* ttp = context->GetOperatorThreadPool();
-  auto conditional_batch_call = [ttp, x_size](std::function<void(ptrdiff_t)> f) {
-    if (x_size < kParallelizationThreshold) {  // TODO: tune this, arbitrary threshold
-      for (size_t i = 0; i < x_size; ++i) {
-        f(i);
-      }
-    } else {
-      concurrency::ThreadPool::TryBatchParallelFor(ttp, x_size, f, 0);
-    }
-  };
+  const size_t x_size = onnxruntime::narrow<size_t>(x_shape.Size());
+  const size_t stride = onnxruntime::narrow<size_t>(x_dims.size() == 1 ? x_dims[0] : x_dims[1]);
+  if (x_size == 0) {
+    return Status::OK();
+  }
 
-  if (static_cast<int64_t>(offset_.size()) == stride &&
-      static_cast<int64_t>(scale_.size()) == stride) {
-    auto fn = [this, y_data, x_data, stride](ptrdiff_t i) {
-      y_data[i] = static_cast<float>((x_data[i] - offset_[i % stride]) * scale_[i % stride]);
-    };
-    conditional_batch_call(fn);
+  // Scale and offset of feature size are indexed by the column, a single value is read with a step of 0.
+  size_t step;
+  if (offset_.size() == stride && scale_.size() == stride) {
+    step = 1;
   } else if (offset_.size() == 1 && scale_.size() == 1) {
-    auto fn = [this, y_data, x_data](ptrdiff_t i) {
-      y_data[i] = static_cast<float>((x_data[i] - offset_[0]) * scale_[0]);
-    };
-    conditional_batch_call(fn);
+    step = 0;
   } else {
     std::ostringstream err_msg;
     err_msg << "Either both scale and offset can be of feature size (" << stride << ") or 1";
     return Status(ONNXRUNTIME, INVALID_ARGUMENT, err_msg.str());
   }
+
+  const auto row_count = static_cast<std::ptrdiff_t>(x_size / stride);
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), row_count,
+      TensorOpCost{static_cast<double>(stride * sizeof(T)), static_cast<double>(stride * sizeof(float)),
+                   static_cast<double>(stride) * 2.0},
+      [this, x_data, y_data, stride, step](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const T* x = x_data + row * stride;
+          float* y = y_data + row * stride;
+          for (size_t c = 0; c < stride; ++c) {
+            y[c] = static_cast<float>((x[c] - offset_[c * step]) * scale_[c * step]);
+          }
+        }
+      });
   return Status::OK();
 }
 }  // namespace ml
@@ -7,6 +7,7 @@
 #include "core/platform/ort_mutex.h"
 #include "core/platform/threadpool.h"
 #include "tree_ensemble_helper.h"
+#include "tree_ensemble_quickscorer.h"
 
 namespace onnxruntime {
 namespace ml {
@@ -47,6 +48,11 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   // `ThresholdType` is used as well for output type (double as well for lightgbm) and not `OutputType`.
   std::vector<SparseValue<ThresholdType>> weights_;
   std::vector<TreeNodeElement<ThresholdType>*> roots_;
+  // Evaluates all trees at once when every tree is small enough, chosen in Init.
+  TreeEnsembleQuickScorer<InputType, ThresholdType> quick_scorer_;
+
+  // Number of rows evaluated together by ProcessTreeNodeLeaves.
+  static constexpr int64_t kTraversalRows = 8;
 
  public:
   TreeEnsembleCommon() {}
@@ -83,9 +89,18 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   TreeNodeElement<ThresholdType>* ProcessTreeNodeLeave(TreeNodeElement<ThresholdType>* root,
                                                        const InputType* x_data) const;
 
+  // Stores in leaves[r] the leaf of the tree reached by row r of x_data for the n_rows (at most kTraversalRows) rows.
+  // The rows go down the tree together, the node loads of the different rows don't depend on each other.
+  void ProcessTreeNodeLeaves(TreeNodeElement<ThresholdType>* root, const InputType* x_data, int64_t stride,
+                             size_t n_rows, const TreeNodeElement<ThresholdType>** leaves) const;
+
   template <typename AGG>
   void ComputeAgg(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Y, Tensor* label, const AGG& agg) const;
 
+  template <typename AGG>
+  void ComputeAggQuickScorer(concurrency::ThreadPool* ttp, const InputType* x_data, OutputType* z_data,
+                             int64_t* label_data, int64_t N, int64_t stride, const AGG& agg) const;
+
  private:
   size_t AddNodes(const size_t i, const InlinedVector<NODE_MODE>& cmodes, const InlinedVector<size_t>& truenode_ids,
                   const InlinedVector<size_t>& falsenode_ids, const std::vector<int64_t>& nodes_featureids,
@@ -338,6 +353,9 @@ Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::Init(
     }
   }
 
+  // Ensembles of small trees are evaluated with QuickScorer, the others node by node.
+  quick_scorer_.Init(nodes_, roots_, has_missing_tracks_);
+
   return Status::OK();
 }
 
@@ -455,6 +473,11 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
   int64_t* label_data = label == nullptr ? nullptr : label->MutableData<int64_t>();
   auto max_num_threads = concurrency::ThreadPool::DegreeOfParallelism(ttp);
 
+  if (!quick_scorer_.empty() && (N > 1 || n_trees_ <= parallel_tree_ || max_num_threads == 1)) {
+    ComputeAggQuickScorer(ttp, x_data, z_data, label_data, N, stride, agg);
+    return;
+  }
+
   if (n_targets_or_classes_ == 1) {
     if (N == 1) {
       ScoreValue<ThresholdType> score = {0, 0};
@@ -489,7 +512,8 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
       // split into batch so that every batch holds on caches, then loop on trees and finally loop
       // on the batch rows.
       std::vector<ScoreValue<ThresholdType>> scores(parallel_tree_N_);
-      size_t j;
+      const TreeNodeElement<ThresholdType>* leaves[kTraversalRows];
+      size_t j, r, n_rows;
       int64_t i, batch, batch_end;
 
       for (batch = 0; batch < N; batch += parallel_tree_N_) {
@@ -498,8 +522,12 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           scores[SafeInt<ptrdiff_t>(i - batch)] = {0, 0};
         }
         for (j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-          for (i = batch; i < batch_end; ++i) {
-            agg.ProcessTreeNodePrediction1(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+          for (i = batch; i < batch_end; i += kTraversalRows) {
+            n_rows = static_cast<size_t>(std::min(kTraversalRows, batch_end - i));
+            ProcessTreeNodeLeaves(roots_[j], x_data + i * stride, stride, n_rows, leaves);
+            for (r = 0; r < n_rows; ++r) {
+              agg.ProcessTreeNodePrediction1(scores[SafeInt<ptrdiff_t>(i - batch + static_cast<int64_t>(r))], *leaves[r]);
+            }
           }
         }
         for (i = batch; i < batch_end; ++i) {
@@ -518,13 +546,17 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             num_threads,
             [this, &agg, &scores, num_threads, x_data, N, begin_n, end_n, stride](ptrdiff_t batch_num) {
               auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, onnxruntime::narrow<size_t>(this->n_trees_));
+              const TreeNodeElement<ThresholdType>* leaves[kTraversalRows];
               for (int64_t i = begin_n; i < end_n; ++i) {
                 scores[batch_num * SafeInt<ptrdiff_t>(N) + i] = {0, 0};
               }
               for (auto j = work.start; j < work.end; ++j) {
-                for (int64_t i = begin_n; i < end_n; ++i) {
-                  agg.ProcessTreeNodePrediction1(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
-                                                 *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+                for (int64_t i = begin_n; i < end_n; i += kTraversalRows) {
+                  auto n_rows = static_cast<size_t>(std::min(kTraversalRows, end_n - i));
+                  ProcessTreeNodeLeaves(roots_[j], x_data + i * stride, stride, n_rows, leaves);
+                  for (size_t r = 0; r < n_rows; ++r) {
+                    agg.ProcessTreeNodePrediction1(scores[batch_num * SafeInt<ptrdiff_t>(N) + i + static_cast<int64_t>(r)], *leaves[r]);
+                  }
                 }
               }
             });
@@ -586,7 +618,8 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
       }
     } else if (N <= parallel_N_ || max_num_threads == 1) { /* section C2: 2+ outputs, 2+ rows, not enough rows to parallelize */
       std::vector<InlinedVector<ScoreValue<ThresholdType>>> scores(parallel_tree_N_);
-      size_t j, limit;
+      const TreeNodeElement<ThresholdType>* leaves[kTraversalRows];
+      size_t j, limit, r, n_rows;
       int64_t i, batch, batch_end;
       batch_end = std::min(N, static_cast<int64_t>(parallel_tree_N_));
       for (i = 0; i < batch_end; ++i) {
@@ -598,8 +631,12 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           std::fill(scores[SafeInt<ptrdiff_t>(i - batch)].begin(), scores[SafeInt<ptrdiff_t>(i - batch)].end(), ScoreValue<ThresholdType>({0, 0}));
         }
         for (j = 0, limit = roots_.size(); j < limit; ++j) {
-          for (i = batch; i < batch_end; ++i) {
-            agg.ProcessTreeNodePrediction(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
+          for (i = batch; i < batch_end; i += kTraversalRows) {
+            n_rows = static_cast<size_t>(std::min(kTraversalRows, batch_end - i));
+            ProcessTreeNodeLeaves(roots_[j], x_data + i * stride, stride, n_rows, leaves);
+            for (r = 0; r < n_rows; ++r) {
+              agg.ProcessTreeNodePrediction(scores[SafeInt<ptrdiff_t>(i - batch + static_cast<int64_t>(r))], *leaves[r], weights_);
+            }
           }
         }
         for (i = batch; i < batch_end; ++i) {
@@ -619,13 +656,18 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             num_threads,
             [this, &agg, &scores, num_threads, x_data, N, stride, begin_n, end_n](ptrdiff_t batch_num) {
               auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, onnxruntime::narrow<size_t>(this->n_trees_));
+              const TreeNodeElement<ThresholdType>* leaves[kTraversalRows];
               for (int64_t i = begin_n; i < end_n; ++i) {
                 scores[batch_num * SafeInt<ptrdiff_t>(N) + i].resize(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
               }
               for (auto j = work.start; j < work.end; ++j) {
-                for (int64_t i = begin_n; i < end_n; ++i) {
-                  agg.ProcessTreeNodePrediction(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
-                                                *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
+                for (int64_t i = begin_n; i < end_n; i += kTraversalRows) {
+                  auto n_rows = static_cast<size_t>(std::min(kTraversalRows, end_n - i));
+                  ProcessTreeNodeLeaves(roots_[j], x_data + i * stride, stride, n_rows, leaves);
+                  for (size_t r = 0; r < n_rows; ++r) {
+                    agg.ProcessTreeNodePrediction(scores[batch_num * SafeInt<ptrdiff_t>(N) + i + static_cast<int64_t>(r)], *leaves[r],
+                                                  weights_);
+                  }
                 }
               }
             });
@@ -669,6 +711,106 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
   }
 }  // namespace detail
 
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename AGG>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAggQuickScorer(
+    concurrency::ThreadPool* ttp, const InputType* x_data, OutputType* z_data, int64_t* label_data, int64_t N,
+    int64_t stride, const AGG& agg) const {
+  // QuickScorer evaluates all trees of one row at once, the computation is parallelized by rows.
+  auto num_threads = N <= parallel_N_ ? 1 : std::min<int32_t>(concurrency::ThreadPool::DegreeOfParallelism(ttp),
+                                                               SafeInt<int32_t>(N));
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      ttp,
+      num_threads,
+      [this, &agg, num_threads, x_data, z_data, label_data, N, stride](ptrdiff_t batch_num) {
+        auto work = concurrency::ThreadPool::PartitionWork(batch_num, onnxruntime::narrow<ptrdiff_t>(num_threads),
+                                                           onnxruntime::narrow<ptrdiff_t>(N));
+        std::vector<uint64_t> bitvectors(onnxruntime::narrow<size_t>(n_trees_));
+        std::vector<const TreeNodeElement<ThresholdType>*> leaves(onnxruntime::narrow<size_t>(n_trees_));
+        InlinedVector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_targets_or_classes_));
+
+        for (auto i = work.start; i < work.end; ++i) {
+          quick_scorer_.ComputeLeaves(x_data + i * stride, bitvectors.data(), leaves.data());
+          if (n_targets_or_classes_ == 1) {
+            ScoreValue<ThresholdType> score = {0, 0};
+            for (const auto* leaf : leaves) {
+              agg.ProcessTreeNodePrediction1(score, *leaf);
+            }
+            agg.FinalizeScores1(z_data + i, score, label_data == nullptr ? nullptr : (label_data + i));
+          } else {
+            std::fill(scores.begin(), scores.end(), ScoreValue<ThresholdType>({0, 0}));
+            for (const auto* leaf : leaves) {
+              agg.ProcessTreeNodePrediction(scores, *leaf, weights_);
+            }
+            agg.FinalizeScores(scores, z_data + i * n_targets_or_classes_, -1,
+                               label_data == nullptr ? nullptr : (label_data + i));
+          }
+        }
+      });
+}
+
+template <typename InputType, typename ThresholdType, typename Compare>
+void ProcessTreeNodeLeavesSameMode(const TreeNodeElement<ThresholdType>* root, const InputType* x_data,
+                                   int64_t stride, size_t n_rows, bool has_missing_tracks,
+                                   const TreeNodeElement<ThresholdType>** leaves, Compare compare) {
+  for (size_t r = 0; r < n_rows; ++r) {
+    leaves[r] = root;
+  }
+  for (bool moved = root->is_not_leaf(); moved;) {
+    moved = false;
+    for (size_t r = 0; r < n_rows; ++r) {
+      const TreeNodeElement<ThresholdType>* node = leaves[r];
+      if (node->is_not_leaf()) {
+        const InputType val = x_data[static_cast<int64_t>(r) * stride + node->feature_id];
+        leaves[r] = (compare(val, node->value_or_unique_weight) ||
+                     (has_missing_tracks && node->is_missing_track_true() && _isnan_(val)))
+                        ? node->truenode_or_weight.ptr
+                        : node + 1;
+        moved = true;
+      }
+    }
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeaves(
+    TreeNodeElement<ThresholdType>* root, const InputType* x_data, int64_t stride, size_t n_rows,
+    const TreeNodeElement<ThresholdType>** leaves) const {
+  if (!same_mode_) {
+    for (size_t r = 0; r < n_rows; ++r) {
+      leaves[r] = ProcessTreeNodeLeave(root, x_data + static_cast<int64_t>(r) * stride);
+    }
+    return;
+  }
+  switch (root->mode()) {
+    case NODE_MODE::BRANCH_LEQ:
+      ProcessTreeNodeLeavesSameMode(root, x_data, stride, n_rows, has_missing_tracks_, leaves, std::less_equal<>());
+      break;
+    case NODE_MODE::BRANCH_LT:
+      ProcessTreeNodeLeavesSameMode(root, x_data, stride, n_rows, has_missing_tracks_, leaves, std::less<>());
+      break;
+    case NODE_MODE::BRANCH_GTE:
+      ProcessTreeNodeLeavesSameMode(root, x_data, stride, n_rows, has_missing_tracks_, leaves,
+                                    std::greater_equal<>());
+      break;
+    case NODE_MODE::BRANCH_GT:
+      ProcessTreeNodeLeavesSameMode(root, x_data, stride, n_rows, has_missing_tracks_, leaves, std::greater<>());
+      break;
+    case NODE_MODE::BRANCH_EQ:
+      ProcessTreeNodeLeavesSameMode(root, x_data, stride, n_rows, has_missing_tracks_, leaves, std::equal_to<>());
+      break;
+    case NODE_MODE::BRANCH_NEQ:
+      ProcessTreeNodeLeavesSameMode(root, x_data, stride, n_rows, has_missing_tracks_, leaves,
+                                    std::not_equal_to<>());
+      break;
+    case NODE_MODE::LEAF:
+      for (size_t r = 0; r < n_rows; ++r) {
+        leaves[r] = root;
+      }
+      break;
+  }
+}
+
 #define TREE_FIND_VALUE(CMP)                                                                           \
   if (has_missing_tracks_) {                                                                           \
     while (root->is_not_leaf()) {                                                                      \
@@ -684,11 +826,6 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
     }                                                                                                  \
   }
 
-inline bool _isnan_(float x) { return std::isnan(x); }
-inline bool _isnan_(double x) { return std::isnan(x); }
-inline bool _isnan_(int64_t) { return false; }
-inline bool _isnan_(int32_t) { return false; }
-
 template <typename InputType, typename ThresholdType, typename OutputType>
 TreeNodeElement<ThresholdType>*
 TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeave(
@@ -0,0 +1,255 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include "tree_ensemble_aggregator.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+#include <intrin.h>
+#endif
+
+namespace onnxruntime {
+namespace ml {
+namespace detail {
+
+inline uint32_t LowestSetBit(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<uint32_t>(__builtin_ctzll(bits));
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+  unsigned long index;
+  _BitScanForward64(&index, bits);
+  return static_cast<uint32_t>(index);
+#else
+  uint32_t index = 0;
+  while ((bits & 1) == 0) {
+    bits >>= 1;
+    ++index;
+  }
+  return index;
+#endif
+}
+
+// Evaluates every tree of an ensemble at once with the QuickScorer algorithm
+// (Lucchese et al., "QuickScorer: a Fast Algorithm to Rank Documents with Additive Ensembles of Regression Trees").
+// The leaves of a tree are numbered so that the leaves of the true branch of a node come before the leaves of its
+// false branch, and a tree is represented by a 64-bit vector with one bit per leaf. Evaluating a node to false
+// clears the bits of the leaves of its true branch. Whatever the order the nodes are evaluated in, the leaf reached
+// by a row is then the lowest bit left in the vector of its tree.
+// The nodes are stored as a structure of arrays grouped by feature and sorted by threshold, so that the nodes
+// evaluated to false for a feature value are a prefix of the feature group and the scan stops at the first true node.
+// Only ensembles where every tree has at most 64 leaves and every node uses the same inequality can be evaluated
+// this way. Init returns false for the other ones.
+template <typename InputType, typename ThresholdType>
+class TreeEnsembleQuickScorer {
+ public:
+  static constexpr size_t kMaxLeaves = 64;
+
+  bool Init(const std::vector<TreeNodeElement<ThresholdType>>& nodes,
+            const std::vector<TreeNodeElement<ThresholdType>*>& roots,
+            bool has_missing_tracks);
+
+  bool empty() const { return leaf_offsets_.empty(); }
+
+  // Stores in leaves[j] the leaf of tree j reached by the row x_data.
+  // bitvectors is a buffer of one element per tree.
+  void ComputeLeaves(const InputType* x_data, uint64_t* bitvectors,
+                     const TreeNodeElement<ThresholdType>** leaves) const;
+
+ private:
+  struct NodeEntry {
+    int feature_id;
+    ThresholdType threshold;
+    uint32_t tree_id;
+    uint64_t mask;
+    bool missing_track_true;
+  };
+
+  bool AddTree(const TreeNodeElement<ThresholdType>* node, const TreeNodeElement<ThresholdType>* first_node,
+               uint32_t tree_id, std::vector<bool>& visited, std::vector<NodeEntry>& entries);
+
+  template <typename Compare>
+  void ApplyMasks(const InputType* x_data, uint64_t* bitvectors, Compare compare) const;
+
+  NODE_MODE mode_ = NODE_MODE::LEAF;
+  bool has_missing_tracks_ = false;
+
+  // Nodes of feature features_[f] are in [feature_offsets_[f], feature_offsets_[f + 1]).
+  std::vector<int> features_;
+  std::vector<size_t> feature_offsets_;
+  std::vector<ThresholdType> thresholds_;
+  std::vector<uint32_t> tree_ids_;
+  std::vector<uint64_t> masks_;
+  std::vector<uint8_t> missing_tracks_true_;
+
+  // Leaves of tree j, in bit order, are in [leaf_offsets_[j], leaf_offsets_[j + 1]).
+  std::vector<size_t> leaf_offsets_;
+  std::vector<const TreeNodeElement<ThresholdType>*> leaves_;
+};
+
+template <typename InputType, typename ThresholdType>
+bool TreeEnsembleQuickScorer<InputType, ThresholdType>::AddTree(const TreeNodeElement<ThresholdType>* node,
+                                                                const TreeNodeElement<ThresholdType>* first_node,
+                                                                uint32_t tree_id, std::vector<bool>& visited,
+                                                                std::vector<NodeEntry>& entries) {
+  // A node reachable from two parents (see AddNodes) would need two different bits.
+  const size_t position = static_cast<size_t>(node - first_node);
+  if (visited[position]) {
+    return false;
+  }
+  visited[position] = true;
+
+  if (!node->is_not_leaf()) {
+    if (leaves_.size() - leaf_offsets_.back() >= kMaxLeaves) {
+      return false;
+    }
+    leaves_.push_back(node);
+    return true;
+  }
+
+  if (node->mode() != mode_ || std::isnan(static_cast<double>(node->value_or_unique_weight))) {
+    return false;
+  }
+
+  const size_t first_true_leaf = leaves_.size() - leaf_offsets_.back();
+  if (!AddTree(node->truenode_or_weight.ptr, first_node, tree_id, visited, entries)) {
+    return false;
+  }
+  const size_t end_true_leaf = leaves_.size() - leaf_offsets_.back();
+
+  const uint64_t true_leaves = (end_true_leaf == kMaxLeaves ? ~uint64_t{0} : ((uint64_t{1} << end_true_leaf) - 1)) &
+                               ~((uint64_t{1} << first_true_leaf) - 1);
+  entries.push_back({node->feature_id, node->value_or_unique_weight, tree_id, ~true_leaves,
+                     node->is_missing_track_true()});
+
+  return AddTree(node + 1, first_node, tree_id, visited, entries);
+}
+
+template <typename InputType, typename ThresholdType>
+bool TreeEnsembleQuickScorer<InputType, ThresholdType>::Init(const std::vector<TreeNodeElement<ThresholdType>>& nodes,
+                                                             const std::vector<TreeNodeElement<ThresholdType>*>& roots,
+                                                             bool has_missing_tracks) {
+  *this = TreeEnsembleQuickScorer();
+  if (roots.empty() || roots.size() >= std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+
+  mode_ = NODE_MODE::LEAF;
+  for (const auto& node : nodes) {
+    if (node.is_not_leaf()) {
+      mode_ = node.mode();
+      break;
+    }
+  }
+  switch (mode_) {
+    case NODE_MODE::BRANCH_LEQ:
+    case NODE_MODE::BRANCH_LT:
+    case NODE_MODE::BRANCH_GTE:
+    case NODE_MODE::BRANCH_GT:
+      break;
+    default:
+      // Equality tests don't split the feature values into two intervals.
+      return false;
+  }
+  has_missing_tracks_ = has_missing_tracks;
+
+  std::vector<NodeEntry> entries;
+  std::vector<bool> visited(nodes.size(), false);
+  leaf_offsets_.reserve(roots.size() + 1);
+  leaf_offsets_.push_back(0);
+  for (size_t j = 0; j < roots.size(); ++j) {
+    if (!AddTree(roots[j], nodes.data(), static_cast<uint32_t>(j), visited, entries)) {
+      *this = TreeEnsembleQuickScorer();
+      return false;
+    }
+    leaf_offsets_.push_back(leaves_.size());
+  }
+
+  // The scan of a feature group stops at the first node evaluated to true, so the nodes are sorted by increasing
+  // threshold for BRANCH_LEQ and BRANCH_LT and by decreasing threshold for BRANCH_GTE and BRANCH_GT.
+  const bool descending = mode_ == NODE_MODE::BRANCH_GTE || mode_ == NODE_MODE::BRANCH_GT;
+  std::stable_sort(entries.begin(), entries.end(), [descending](const NodeEntry& a, const NodeEntry& b) {
+    if (a.feature_id != b.feature_id) {
+      return a.feature_id < b.feature_id;
+    }
+    return descending ? b.threshold < a.threshold : a.threshold < b.threshold;
+  });
+
+  thresholds_.reserve(entries.size());
+  tree_ids_.reserve(entries.size());
+  masks_.reserve(entries.size());
+  if (has_missing_tracks_) {
+    missing_tracks_true_.reserve(entries.size());
+  }
+  for (size_t k = 0; k < entries.size(); ++k) {
+    if (k == 0 || entries[k].feature_id != entries[k - 1].feature_id) {
+      features_.push_back(entries[k].feature_id);
+      feature_offsets_.push_back(k);
+    }
+    thresholds_.push_back(entries[k].threshold);
+    tree_ids_.push_back(entries[k].tree_id);
+    masks_.push_back(entries[k].mask);
+    if (has_missing_tracks_) {
+      missing_tracks_true_.push_back(entries[k].missing_track_true ? 1 : 0);
+    }
+  }
+  feature_offsets_.push_back(entries.size());
+  return true;
+}
+
+template <typename InputType, typename ThresholdType>
+template <typename Compare>
+void TreeEnsembleQuickScorer<InputType, ThresholdType>::ApplyMasks(const InputType* x_data, uint64_t* bitvectors,
+                                                                   Compare compare) const {
+  for (size_t f = 0, n_features = features_.size(); f < n_features; ++f) {
+    const InputType val = x_data[features_[f]];
+    size_t k = feature_offsets_[f];
+    const size_t end = feature_offsets_[f + 1];
+    if (has_missing_tracks_ && _isnan_(val)) {
+      // A missing value makes every node of the feature false except the ones tracking missing values as true.
+      for (; k < end; ++k) {
+        if (!missing_tracks_true_[k]) {
+          bitvectors[tree_ids_[k]] &= masks_[k];
+        }
+      }
+      continue;
+    }
+    for (; k < end && !compare(val, thresholds_[k]); ++k) {
+      bitvectors[tree_ids_[k]] &= masks_[k];
+    }
+  }
+}
+
+template <typename InputType, typename ThresholdType>
+void TreeEnsembleQuickScorer<InputType, ThresholdType>::ComputeLeaves(
+    const InputType* x_data, uint64_t* bitvectors, const TreeNodeElement<ThresholdType>** leaves) const {
+  const size_t n_trees = leaf_offsets_.size() - 1;
+  std::fill(bitvectors, bitvectors + n_trees, ~uint64_t{0});
+  switch (mode_) {
+    case NODE_MODE::BRANCH_LEQ:
+      ApplyMasks(x_data, bitvectors, std::less_equal<>());
+      break;
+    case NODE_MODE::BRANCH_LT:
+      ApplyMasks(x_data, bitvectors, std::less<>());
+      break;
+    case NODE_MODE::BRANCH_GTE:
+      ApplyMasks(x_data, bitvectors, std::greater_equal<>());
+      break;
+    case NODE_MODE::BRANCH_GT:
+      ApplyMasks(x_data, bitvectors, std::greater<>());
+      break;
+    default:
+      ORT_THROW("Unexpected mode ", static_cast<int>(mode_), " in TreeEnsembleQuickScorer.");
+  }
+  for (size_t j = 0; j < n_trees; ++j) {
+    leaves[j] = leaves_[leaf_offsets_[j] + LowestSetBit(bitvectors[j])];
+  }
+}
+
+}  // namespace detail
+}  // namespace ml
+}  // namespace onnxruntime
@@ -153,6 +153,65 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+Status Conv<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  if (input_idx != 1 || tensor.Shape().NumDimensions() != 4 || conv_attrs_.group <= 0 ||
+      tensor.Shape()[0] % conv_attrs_.group != 0) {
+    return Status::OK();
+  }
+
+  TensorShapeVector kernel_shape;
+  if (!conv_attrs_.ComputeKernelShape(tensor.Shape(), kernel_shape).IsOK()) {
+    return Status::OK();
+  }
+
+  TensorShapeVector dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(kernel_shape.size(), 1);
+  }
+  TensorShapeVector strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(kernel_shape.size(), 1);
+  }
+  if (dilations.size() != kernel_shape.size() || strides.size() != kernel_shape.size() ||
+      !MlasConvWinogradIsSupported(kernel_shape.size(), kernel_shape.data(), dilations.data(), strides.data())) {
+    return Status::OK();
+  }
+
+  const size_t group_count = narrow<size_t>(conv_attrs_.group);
+  const size_t filter_count = narrow<size_t>(tensor.Shape()[0]) / group_count;
+  const size_t input_channels = narrow<size_t>(tensor.Shape()[1]);
+  const size_t packed_W_size =
+      SafeInt<size_t>(MlasConvWinogradPackedFilterSize(group_count, filter_count, input_channels)) * sizeof(float);
+
+  winograd_packed_W_ = IAllocator::MakeUniquePtr<void>(alloc, packed_W_size, true);
+  MlasConvWinogradPackFilter(group_count, filter_count, input_channels, tensor.Data<float>(),
+                             static_cast<float*>(winograd_packed_W_.get()));
+
+  if (prepacked_weights != nullptr) {
+    prepacked_weights->buffers_.push_back(std::move(winograd_packed_W_));
+    prepacked_weights->buffer_sizes_.push_back(packed_W_size);
+  }
+
+  return Status::OK();
+}
+
+Status Conv<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                              int input_idx,
+                                              /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    winograd_packed_W_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
 Status Conv<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const Tensor* X = context->Input<Tensor>(0);
@@ -231,7 +290,8 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
                     &activation_,
                     &WorkingBufferSize,
                     Beta,
-                    thread_pool);
+                    thread_pool,
+                    static_cast<const float*>(winograd_packed_W_.get()));
 
     auto* working_data = WorkingBufferSize > 0 ? alloc->Alloc(sizeof(float) * SafeInt<size_t>(WorkingBufferSize))
                                                : nullptr;
@@ -30,10 +30,23 @@ class Conv<float> : public OpKernel {
 
   Status Compute(OpKernelContext* context) const override;
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
  protected:
   MLAS_ACTIVATION activation_;
 
   ConvAttributes conv_attrs_;
+
+ private:
+  // W transformed for the Winograd algorithm of MlasConv if it is a 3x3 filter with unit strides and dilations.
+  // W itself is kept as MlasConvPrepare only chooses that algorithm for large enough inputs.
+  IAllocatorUniquePtr<void> winograd_packed_W_;
 };
 
 }  // namespace onnxruntime
@@ -17,6 +17,8 @@
 
 #include "core/providers/cpu/nn/conv_transpose.h"
 
+#include <algorithm>
+
 #include "core/mlas/inc/mlas.h"
 #include "core/common/safeint.h"
 #include "core/util/math.h"
@@ -241,6 +243,38 @@ Status ConvTranspose<float>::DoConvTranspose(OpKernelContext* context, bool dyna
   const int64_t kernel_dim = p.num_output_channels / conv_transpose_attrs_.group * kernel_size;
   const int64_t output_size = (p.Y->Shape().Slice(2)).Size();
 
+  // 1D and 2D transposed convolutions scatter the columns of blocks of input rows straight into the output instead
+  // of computing the column buffer of the whole image.
+  const size_t spatial_dims = p.kernel_shape.size();
+  if ((spatial_dims == 1 || spatial_dims == 2) && input_image_size > 0 && kernel_size > 0 &&
+      std::all_of(p.pads.begin(), p.pads.end(), [](int64_t pad) { return pad >= 0; })) {
+    const size_t w = spatial_dims - 1;
+    const int64_t input_shape[2] = {spatial_dims == 2 ? p.input_shape[0] : 1, p.input_shape[w]};
+    const int64_t kernel_shape[2] = {spatial_dims == 2 ? p.kernel_shape[0] : 1, p.kernel_shape[w]};
+    const int64_t dilations[2] = {spatial_dims == 2 ? p.dilations[0] : 1, p.dilations[w]};
+    const int64_t pads[2] = {spatial_dims == 2 ? p.pads[0] : 0, p.pads[w]};
+    const int64_t strides[2] = {spatial_dims == 2 ? p.strides[0] : 1, p.strides[w]};
+    const int64_t Y_shape[2] = {spatial_dims == 2 ? p.Y->Shape()[2] : 1, p.Y->Shape()[2 + w]};
+
+    MlasConvTranspose2D(onnxruntime::narrow<size_t>(p.N),
+                        onnxruntime::narrow<size_t>(conv_transpose_attrs_.group),
+                        onnxruntime::narrow<size_t>(p.num_input_channels / conv_transpose_attrs_.group),
+                        input_shape,
+                        kernel_shape,
+                        dilations,
+                        pads,
+                        strides,
+                        onnxruntime::narrow<size_t>(p.num_output_channels / conv_transpose_attrs_.group),
+                        Y_shape,
+                        p.X->Data<float>(),
+                        p.F ? p.F->Data<float>() : static_cast<const float*>(transposed_filter_.get()),
+                        p.F == nullptr,
+                        p.B ? p.B->Data<float>() : nullptr,
+                        p.Y->MutableData<float>(),
+                        thread_pool);
+    return Status::OK();
+  }
+
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
 
@@ -6,9 +6,8 @@
 #include "core/common/narrow.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/random_generator.h"
-#include <chrono>
-#include <random>
-#include "core/util/math_cpuonly.h"
+#include "core/platform/threadpool.h"
+#include <algorithm>
 
 namespace onnxruntime {
 
@@ -18,14 +17,14 @@ class Dropout final : public OpKernel {
   Dropout(const OpKernelInfo& info) : OpKernel{info} {
     int64_t seed = 0;
     if (info.GetAttr<int64_t>("seed", &seed).IsOK()) {
-      generator_ = std::make_unique<RandomGenerator>(seed);
+      generator_ = std::make_unique<PhiloxGenerator>(static_cast<uint64_t>(seed));
     }
   }
 
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  mutable std::unique_ptr<RandomGenerator> generator_;
+  mutable std::unique_ptr<PhiloxGenerator> generator_;
 };
 
 namespace {
@@ -78,21 +77,39 @@ Status Dropout<T1, T2>::Compute(OpKernelContext* context) const {
 
   } else {
     // drop some
-    ConstEigenVectorArrayMap<T1> X_arr(X_span.data(), X_span.size());
-    EigenVectorArrayMap<T1> Y_arr(Y_span.data(), Y_span.size());
-    EigenVectorArrayMap<bool> mask_arr(mask_span.data(), mask_span.size());
-
-    // generate mask
-    {
-      RandomGenerator& generator = generator_ != nullptr ? *generator_.get() : RandomGenerator::Default();
-      std::default_random_engine rng(gsl::narrow_cast<std::default_random_engine::result_type>(generator.NextSeed()));
-      std::uniform_real_distribution<float> dist{0.0f, 1.0f};
-      mask_arr = Eigen::ArrayX<bool>::NullaryExpr(
-          mask_arr.size(),
-          [ratio_value, &dist, &rng]() { return dist(rng) >= ratio_value; });
-    }
-
-    Y_arr = mask_arr.cast<T1>() * X_arr / (1.0f - ratio_value);
+    // each Philox counter yields the random numbers of PhiloxEngine::kNumOutputs consecutive elements, so the
+    // ranges of counters are generated in parallel and the mask only depends on the seed and offset.
+    constexpr size_t kNumOutputs = PhiloxEngine::kNumOutputs;
+    constexpr size_t kCountersPerBlock = 256;
+    const size_t num_counters = (X_span.size() + kNumOutputs - 1) / kNumOutputs;
+    PhiloxGenerator& generator = generator_ != nullptr ? *generator_.get() : PhiloxGenerator::Default();
+    // the offset counts random numbers, as the curand offset does
+    const auto seeds = generator.NextPhiloxSeeds(static_cast<uint64_t>(num_counters * kNumOutputs));
+    const uint64_t first_counter = (seeds.second + kNumOutputs - 1) / kNumOutputs;
+    const float keep_probability = 1.0f - ratio_value;
+    const T1 scale = static_cast<T1>(1.0f / keep_probability);
+
+    const auto generate_mask = [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      uint32_t random_values[kCountersPerBlock * kNumOutputs];
+      for (std::ptrdiff_t block = first; block < last; ++block) {
+        const size_t begin = static_cast<size_t>(block) * kCountersPerBlock * kNumOutputs;
+        const size_t end = std::min(begin + kCountersPerBlock * kNumOutputs, X_span.size());
+        PhiloxEngine::Generate(seeds.first, 0, first_counter + begin / kNumOutputs,
+                               (end - begin + kNumOutputs - 1) / kNumOutputs, random_values);
+        for (size_t i = begin; i < end; ++i) {
+          const bool keep = PhiloxEngine::ToUniformFloat(random_values[i - begin]) < keep_probability;
+          mask_span[i] = keep;
+          Y_span[i] = keep ? X_span[i] * scale : T1{0};
+        }
+      }
+    };
+
+    const std::ptrdiff_t num_blocks = static_cast<std::ptrdiff_t>((num_counters + kCountersPerBlock - 1) /
+                                                                  kCountersPerBlock);
+    const TensorOpCost cost{static_cast<double>(kCountersPerBlock * kNumOutputs * sizeof(T1)),
+                            static_cast<double>(kCountersPerBlock * kNumOutputs * (sizeof(T1) + sizeof(bool))),
+                            static_cast<double>(kCountersPerBlock * kNumOutputs * 20)};
+    concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), num_blocks, cost, generate_mask);
   }
 
   return Status::OK();
@@ -3,6 +3,7 @@
 
 #include "layer_norm.h"
 
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/common.h"
 
 namespace onnxruntime {
@@ -15,5 +16,8 @@ namespace onnxruntime {
 
 REGISTER_ONNX_KERNEL_TYPED(float)
 REGISTER_ONNX_KERNEL_TYPED(double)
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+REGISTER_ONNX_KERNEL_TYPED(MLFloat16)
+#endif
 
 }  // namespace onnxruntime
@@ -3,8 +3,11 @@
 
 #include "layer_norm_impl.h"
 
+#include <type_traits>
+
 #include "core/common/safeint.h"
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/util/math_cpuonly.h"
@@ -80,38 +83,50 @@ Status ComputeImpl(OpKernelContext* p_ctx, int64_t orig_axis, float epsilon, boo
         const T* p_input = X_data + task_idx * norm_size;
         T* p_output = Y_data + task_idx * norm_size;
 
-        T mean = 0;
-        T mean_square = 0;
-
-        for (int64_t h = 0; h < norm_size; h++) {
-          mean += p_input[h];
-          mean_square += p_input[h] * p_input[h];
-        }
-
-        mean = mean / norm_size;
-        if (simplified) {
-          mean_square = sqrt(mean_square / norm_size + epsilon);
+        if constexpr (std::is_same_v<T, float> && std::is_same_v<U, float>) {
+          MlasLayerNormalization(p_input, nullptr, nullptr, scale_data, bias_data, p_output, nullptr,
+                                 static_cast<size_t>(norm_size), epsilon, simplified,
+                                 mean_data != nullptr ? &mean_data[task_idx] : nullptr,
+                                 inv_std_dev_data != nullptr ? &inv_std_dev_data[task_idx] : nullptr);
+        } else if constexpr (std::is_same_v<T, MLFloat16>) {
+          MlasLayerNormalization(p_input, nullptr, nullptr, scale_data, bias_data, p_output, nullptr,
+                                 static_cast<size_t>(norm_size), epsilon, simplified,
+                                 mean_data != nullptr ? &mean_data[task_idx] : nullptr,
+                                 inv_std_dev_data != nullptr ? &inv_std_dev_data[task_idx] : nullptr);
         } else {
-          mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon);
-        }
+          T mean = 0;
+          T mean_square = 0;
 
-        for (int64_t h = 0; h < norm_size; h++) {
+          for (int64_t h = 0; h < norm_size; h++) {
+            mean += p_input[h];
+            mean_square += p_input[h] * p_input[h];
+          }
+
+          mean = mean / norm_size;
           if (simplified) {
-            p_output[h] = p_input[h] / mean_square * scale_data[h];
-          } else if (nullptr == bias) {
-            p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h];
+            mean_square = sqrt(mean_square / norm_size + epsilon);
           } else {
-            p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h] + bias_data[h];
+            mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon);
           }
-        }
 
-        if (mean_data != nullptr) {
-          // ONNX spec doesn't support 'double' for 'U' so when 'T' == double, 'U' == float and we need to narrow
-          mean_data[task_idx] = gsl::narrow_cast<U>(mean);
-        }
+          for (int64_t h = 0; h < norm_size; h++) {
+            if (simplified) {
+              p_output[h] = p_input[h] / mean_square * scale_data[h];
+            } else if (nullptr == bias) {
+              p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h];
+            } else {
+              p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h] + bias_data[h];
+            }
+          }
 
-        if (inv_std_dev_data != nullptr) {
-          inv_std_dev_data[task_idx] = gsl::narrow_cast<U>(1 / mean_square);
+          if (mean_data != nullptr) {
+            // ONNX spec doesn't support 'double' for 'U' so when 'T' == double, 'U' == float and we need to narrow
+            mean_data[task_idx] = gsl::narrow_cast<U>(mean);
+          }
+
+          if (inv_std_dev_data != nullptr) {
+            inv_std_dev_data[task_idx] = gsl::narrow_cast<U>(1 / mean_square);
+          }
         }
       },
       0);
@@ -124,16 +139,16 @@ struct SrcDispatcher {
   Status operator()(OpKernelContext* p_ctx, int64_t orig_axis, float epsilon, bool simplified, bool contrib_op) const {
     // the contrib op kernel was always registered with the same type for all constraints.
     // our implementation of the onnx op only supports 'float' as the U constraint.
+    // there is no fp16 contrib op kernel.
 #if !defined(DISABLE_CONTRIB_OPS)
-    if (contrib_op) {
-      return ComputeImpl<T, T>(p_ctx, orig_axis, epsilon, simplified);
-    } else
-#else
-    ORT_UNUSED_PARAMETER(contrib_op);
-#endif
-    {
-      return ComputeImpl<T, float>(p_ctx, orig_axis, epsilon, simplified);
+    if constexpr (!std::is_same_v<T, MLFloat16>) {
+      if (contrib_op) {
+        return ComputeImpl<T, T>(p_ctx, orig_axis, epsilon, simplified);
+      }
     }
+#endif
+    ORT_UNUSED_PARAMETER(contrib_op);
+    return ComputeImpl<T, float>(p_ctx, orig_axis, epsilon, simplified);
   }
 };
 }  // namespace
@@ -141,7 +156,11 @@ struct SrcDispatcher {
 Status LayerNormImpl::Compute(OpKernelContext* p_ctx) const {
   const auto elem_type = p_ctx->Input<Tensor>(0)->GetElementType();
 
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+  using SupportedTypeList = boost::mp11::mp_list<float, double, MLFloat16>;
+#else
   using SupportedTypeList = boost::mp11::mp_list<float, double>;
+#endif
 
   utils::MLTypeCallDispatcherFromTypeList<SupportedTypeList> t_disp(elem_type);
   return t_disp.InvokeRet<Status, SrcDispatcher>(p_ctx, axis_, epsilon_, simplified_, contrib_op_);
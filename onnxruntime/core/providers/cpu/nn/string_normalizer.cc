@@ -17,6 +17,7 @@
 
 #endif  // _MSC_VER
 
+#include <array>
 #include <locale>
 #include <functional>
 #include <unordered_set>
@@ -214,10 +215,58 @@ const std::string default_locale("en_US.UTF-8");  // All non-MS and not Apple
 
 #endif  // _MSC_VER
 
+using AsciiCaseTable = std::array<int8_t, 128>;
+
+AsciiCaseTable MakeAsciiCaseTable(const Locale& loc, StringNormalizer::CaseAction caseaction) {
+  AsciiCaseTable table;
+  for (size_t ch = 0; ch < table.size(); ++ch) {
+    if (caseaction == StringNormalizer::NONE) {
+      table[ch] = static_cast<int8_t>(ch);
+      continue;
+    }
+    std::wstring wstr(1, static_cast<wchar_t>(ch));
+    loc.ChangeCase(caseaction, wstr);
+    // e.g. the capital I of Turkish locales becomes a dotless i
+    table[ch] = static_cast<uint32_t>(wstr[0]) < 128 ? static_cast<int8_t>(wstr[0]) : int8_t{-1};
+  }
+  return table;
+}
+
+// Changes the case of s into cased, with the ASCII table when it covers every character of s, otherwise through
+// a wide string.
+Status ChangeCase(const Locale& loc, Utf8Converter& converter, const AsciiCaseTable& table,
+                  StringNormalizer::CaseAction caseaction, const std::string& s, std::string& cased) {
+  cased.resize(s.size());
+  size_t i = 0;
+  for (; i < s.size(); ++i) {
+    const auto ch = static_cast<unsigned char>(s[i]);
+    if (ch >= table.size() || table[ch] < 0) {
+      break;
+    }
+    cased[i] = static_cast<char>(table[ch]);
+  }
+  if (i == s.size()) {
+    return Status::OK();
+  }
+
+  std::wstring wstr = converter.from_bytes(s);
+  if (wstr == wconv_error) {
+    // Please do not include the input text in the error message as it could
+    // be deemed as a compliance violation by teams using this operator
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                  "Input contains invalid utf8 chars");
+  }
+  // In place transform
+  loc.ChangeCase(caseaction, wstr);
+  cased = converter.to_bytes(wstr);
+  return Status::OK();
+}
+
 template <class ForwardIter>
 Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
                       const Locale& loc,
                       Utf8Converter& converter,
+                      const AsciiCaseTable& table,
                       size_t N, size_t C,
                       StringNormalizer::CaseAction caseaction) {
   std::vector<int64_t> output_dims;
@@ -244,16 +293,7 @@ Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
   while (first != end) {
     auto& s = *first;
     if (caseaction == StringNormalizer::LOWER || caseaction == StringNormalizer::UPPER) {
-      std::wstring wstr = converter.from_bytes(s);
-      if (wstr == wconv_error) {
-        // Please do not include the input text in the error message as it could
-        // be deemed as a compliance violation by teams using this operator
-        return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                      "Input contains invalid utf8 chars");
-      }
-      // In place transform
-      loc.ChangeCase(caseaction, wstr);
-      *(output_data + output_idx) = converter.to_bytes(wstr);
+      ORT_RETURN_IF_ERROR(ChangeCase(loc, converter, table, caseaction, s, *(output_data + output_idx)));
     } else {
       assert(caseaction == StringNormalizer::NONE);
       // Simple copy or move if the iterator points to a non-const string
@@ -296,9 +336,12 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
   }
 
   locale_name_ = info.GetAttrOrDefault("locale", default_locale);
-  Locale locale(locale_name_);
+  locale_ = std::make_unique<Locale>(locale_name_);
   Utf8Converter converter(conv_error, wconv_error);
 
+  ascii_case_change_ = MakeAsciiCaseTable(*locale_, case_change_action_);
+  ascii_compare_case_ = MakeAsciiCaseTable(*locale_, compare_caseaction_);
+
   std::vector<std::string> swords = info.GetAttrsOrDefault<std::string>("stopwords");
   for (auto& sw : swords) {
     ORT_ENFORCE(!sw.empty(), "Empty stopwords not allowed");
@@ -306,15 +349,17 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
       auto p = stopwords_.insert(std::move(sw));
       ORT_ENFORCE(p.second, "Duplicate stopwords not allowed");
     } else {
-      std::wstring wstr = converter.from_bytes(sw);
-      ORT_ENFORCE(wstr != wconv_error, "Stopword contains invalid utf8 chars");
-      locale.ChangeCase(compare_caseaction_, wstr);
-      auto p = wstopwords_.insert(std::move(wstr));
+      std::string cased;
+      ORT_ENFORCE(ChangeCase(*locale_, converter, ascii_compare_case_, compare_caseaction_, sw, cased).IsOK(),
+                  "Stopword contains invalid utf8 chars");
+      auto p = cased_stopwords_.insert(std::move(cased));
       ORT_ENFORCE(p.second, "Duplicate stopwords not allowed");
     }
   }
 }
 
+StringNormalizer::~StringNormalizer() = default;
+
 Status StringNormalizer::Compute(OpKernelContext* ctx) const {
   using namespace string_normalizer;
 
@@ -343,7 +388,7 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
   }
 
   Status status;
-  Locale locale(locale_name_);
+  const Locale& locale = *locale_;
   Utf8Converter converter(conv_error, wconv_error);
   auto* const input_data = X->Data<std::string>();
   using StrRef = std::reference_wrapper<const std::string>;
@@ -361,13 +406,14 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
         ++first;
       }
       status = CopyCaseAction(filtered_strings.cbegin(), filtered_strings.cend(), ctx, locale, converter,
-                              N, filtered_strings.size(), case_change_action_);
+                              ascii_case_change_, N, filtered_strings.size(), case_change_action_);
     } else {
       // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, case_change_action_);
+      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, ascii_case_change_, N, C,
+                              case_change_action_);
     }
   } else {
-    if (!wstopwords_.empty()) {
+    if (!cased_stopwords_.empty()) {
       // Filter input. When no case action is required
       // we simply store original string references.
       // Otherwise, we store converted strings.
@@ -375,37 +421,33 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
       InlinedVector<std::string> filtered_cased_strings;
       filtered_orignal_strings.reserve(C);
       filtered_cased_strings.reserve(C);
+      std::string cased;
       auto first = input_data;
       auto const last = input_data + C;
       while (first != last) {
         const std::string& s = *first;
-        std::wstring wstr = converter.from_bytes(s);
-        if (wstr == wconv_error) {
-          // Please do not include the input text in the error message as it could
-          // be deemed as a compliance violation by teams using this operator
-          return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                        "Input contains invalid utf8 chars");
-        }
-        locale.ChangeCase(compare_caseaction_, wstr);
-        if (0 == wstopwords_.count(wstr)) {
+        ORT_RETURN_IF_ERROR(ChangeCase(locale, converter, ascii_compare_case_, compare_caseaction_, s, cased));
+        if (0 == cased_stopwords_.count(cased)) {
           if (case_change_action_ == NONE) {
             filtered_orignal_strings.push_back(std::cref(s));
           } else {
-            filtered_cased_strings.push_back(converter.to_bytes(wstr));
+            // compare_caseaction_ is case_change_action_ in this case
+            filtered_cased_strings.push_back(cased);
           }
         }
         ++first;
       }
       if (case_change_action_ == NONE) {
-        status = CopyCaseAction(filtered_orignal_strings.cbegin(), filtered_orignal_strings.cend(), ctx, locale, converter,
-                                N, filtered_orignal_strings.size(), NONE);
+        status = CopyCaseAction(filtered_orignal_strings.cbegin(), filtered_orignal_strings.cend(), ctx, locale,
+                                converter, ascii_case_change_, N, filtered_orignal_strings.size(), NONE);
       } else {
         status = CopyCaseAction(filtered_cased_strings.begin(), filtered_cased_strings.end(), ctx, locale, converter,
-                                N, filtered_cased_strings.size(), NONE);
+                                ascii_case_change_, N, filtered_cased_strings.size(), NONE);
       }
     } else {
       // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, case_change_action_);
+      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, ascii_case_change_, N, C,
+                              case_change_action_);
     }
   }
   return status;
@@ -6,11 +6,17 @@
 #include "core/common/inlined_containers.h"
 #include "core/framework/op_kernel.h"
 
+#include <array>
 #include <locale>
+#include <memory>
 #include <string>
 
 namespace onnxruntime {
 
+namespace string_normalizer {
+class Locale;
+}  // namespace string_normalizer
+
 class StringNormalizer : public OpKernel {
  public:
   enum CaseAction {
@@ -20,7 +26,7 @@ class StringNormalizer : public OpKernel {
   };
 
   explicit StringNormalizer(const OpKernelInfo& info);
-  ~StringNormalizer() override = default;
+  ~StringNormalizer() override;
 
   Status Compute(OpKernelContext* ctx) const override;
 
@@ -29,9 +35,15 @@ class StringNormalizer : public OpKernel {
   CaseAction case_change_action_;
   CaseAction compare_caseaction_;  // used for case-insensitive compare
   std::string locale_name_;
-  // Either if these are populated but not both
+  std::unique_ptr<string_normalizer::Locale> locale_;
+  // Either if these are populated but not both.
+  // cased_stopwords_ holds the UTF-8 stopwords after compare_caseaction_.
   InlinedHashSet<std::string> stopwords_;
-  InlinedHashSet<std::wstring> wstopwords_;
+  InlinedHashSet<std::string> cased_stopwords_;
+  // Result of case_change_action_ and compare_caseaction_ in the locale for each ASCII character, or -1 when it is
+  // not an ASCII character. Strings made of such characters are cased without converting them to wide strings.
+  std::array<int8_t, 128> ascii_case_change_;
+  std::array<int8_t, 128> ascii_compare_case_;
 };
 
 }  // namespace onnxruntime
@@ -7,7 +7,8 @@
 #include "core/platform/threadpool.h"
 
 #include <functional>
-#include <unordered_map>
+#include <string_view>
+#include <core/common/inlined_containers.h>
 #include <core/common/safeint.h>
 
 namespace onnxruntime {
@@ -40,11 +41,11 @@ struct NgramPart<std::string>;
 using NgramPartInt = NgramPart<int64_t>;
 using NgramPartString = NgramPart<std::string>;
 
-// Avoid recursive class definitions using unique_ptr + forward declaration
-using IntMap = std::unordered_map<int64_t, std::unique_ptr<NgramPartInt>>;
+// Avoid recursive class definitions using unique_ptr + forward declaration.
+// The string keys are views of the pool_strings attribute, which outlives the kernel.
+using IntMap = InlinedHashMap<int64_t, std::unique_ptr<NgramPartInt>>;
 
-using StrMap = std::unordered_map<std::reference_wrapper<const std::string>, std::unique_ptr<NgramPartString>,
-                                  std::hash<std::string>, std::equal_to<std::string>>;
+using StrMap = InlinedHashMap<std::string_view, std::unique_ptr<NgramPartString>>;
 
 template <>
 struct NgramPart<int64_t> {
@@ -215,6 +216,12 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
     ORT_ENFORCE(status.IsOK() && !pool_int64s.empty(), "non-empty pool_int64s is required if pool_strings not provided");
   }
 
+  std::vector<std::string_view> pool_string_views;
+  pool_string_views.reserve(pool_strings.size());
+  for (const std::string& str : pool_strings) {
+    pool_string_views.emplace_back(str);
+  }
+
   // Iterator via the pool. Insert 1 item for 1-grams, 2 items for 2-grams, etc.
   const auto total_items = (pool_strings.empty()) ? pool_int64s.size() : pool_strings.size();
   size_t ngram_id = 1;  // start with 1, 0 - means no n-gram
@@ -237,7 +244,8 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
         if (pool_strings.empty()) {
           ngram_id = PopulateGrams<int64_t>(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_map_);
         } else {
-          ngram_id = PopulateGrams<std::string>(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->str_map_);
+          ngram_id = PopulateGrams<std::string>(pool_string_views.begin() + start_idx, ngrams, ngram_size, ngram_id,
+                                                impl_->str_map_);
         }
       } else {
         ngram_id += ngrams;
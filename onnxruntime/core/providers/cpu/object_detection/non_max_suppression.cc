@@ -13,10 +13,12 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 
-#include <queue>
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
 #include "non_max_suppression_helper.h"
 
 // TODO:fix the warnings
@@ -118,6 +120,118 @@ Status NonMaxSuppressionBase::GetThresholdsFromInputs(const PrepareContext& pc,
   return Status::OK();
 }
 
+namespace {
+
+struct BoxInfoPtr {
+  float score_{};
+  int64_t index_{};
+
+  BoxInfoPtr() = default;
+  explicit BoxInfoPtr(float score, int64_t idx) : score_(score), index_(idx) {}
+  inline bool operator<(const BoxInfoPtr& rhs) const {
+    return score_ < rhs.score_ || (score_ == rhs.score_ && index_ > rhs.index_);
+  }
+};
+
+struct BoxCorners {
+  float x_min;
+  float y_min;
+  float x_max;
+  float y_max;
+  float area;
+};
+
+// Same corners and area as SuppressByIOU, computed once per box instead of once per pair of boxes.
+inline BoxCorners GetBoxCorners(const float* box, int64_t center_point_box) {
+  BoxCorners corners;
+  if (0 == center_point_box) {
+    // boxes data format [y1, x1, y2, x2]
+    MaxMin(box[1], box[3], corners.x_min, corners.x_max);
+    MaxMin(box[0], box[2], corners.y_min, corners.y_max);
+  } else {
+    // boxes data format [x_center, y_center, width, height]
+    const float width_half = box[2] / 2;
+    const float height_half = box[3] / 2;
+    corners.x_min = box[0] - width_half;
+    corners.x_max = box[0] + width_half;
+    corners.y_min = box[1] - height_half;
+    corners.y_max = box[1] + height_half;
+  }
+  corners.area = (corners.x_max - corners.x_min) * (corners.y_max - corners.y_min);
+  return corners;
+}
+
+// The boxes selected for a class, as a structure of arrays so that the IOU of a candidate with all of them is a
+// loop the compiler can vectorize.
+class SelectedBoxes {
+ public:
+  void Reserve(size_t capacity) {
+    x_min_.reserve(capacity);
+    y_min_.reserve(capacity);
+    x_max_.reserve(capacity);
+    y_max_.reserve(capacity);
+    area_.reserve(capacity);
+  }
+
+  void Clear() {
+    x_min_.clear();
+    y_min_.clear();
+    x_max_.clear();
+    y_max_.clear();
+    area_.clear();
+  }
+
+  size_t Size() const { return area_.size(); }
+
+  void Add(const BoxCorners& box) {
+    x_min_.push_back(box.x_min);
+    y_min_.push_back(box.y_min);
+    x_max_.push_back(box.x_max);
+    y_max_.push_back(box.y_max);
+    area_.push_back(box.area);
+  }
+
+  // Whether SuppressByIOU suppresses the candidate with one of the selected boxes. The boxes are tested by blocks,
+  // without branches inside a block, and the test stops at the first block that suppresses the candidate.
+  bool Suppress(const BoxCorners& candidate, float iou_threshold) const {
+    if (!(candidate.area > .0f)) {
+      return false;
+    }
+
+    constexpr size_t kBlockSize = 16;
+    const size_t num_selected = Size();
+    for (size_t begin = 0; begin < num_selected; begin += kBlockSize) {
+      const size_t end = std::min(num_selected, begin + kBlockSize);
+      int suppressed = 0;
+      for (size_t i = begin; i < end; ++i) {
+        const float intersection_x_min = std::max(candidate.x_min, x_min_[i]);
+        const float intersection_x_max = std::min(candidate.x_max, x_max_[i]);
+        const float intersection_y_min = std::max(candidate.y_min, y_min_[i]);
+        const float intersection_y_max = std::min(candidate.y_max, y_max_[i]);
+        const float intersection_area = (intersection_x_max - intersection_x_min) *
+                                        (intersection_y_max - intersection_y_min);
+        const float union_area = candidate.area + area_[i] - intersection_area;
+        suppressed |= (intersection_x_max > intersection_x_min) & (intersection_y_max > intersection_y_min) &
+                      (intersection_area > .0f) & (area_[i] > .0f) & (union_area > .0f) &
+                      (intersection_area / union_area > iou_threshold);
+      }
+      if (suppressed != 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  std::vector<float> x_min_;
+  std::vector<float> y_min_;
+  std::vector<float> x_max_;
+  std::vector<float> y_max_;
+  std::vector<float> area_;
+};
+
+}  // namespace
+
 Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   PrepareContext pc;
   ORT_RETURN_IF_ERROR(PrepareCompute(ctx, pc));
@@ -136,74 +250,80 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   const auto* const boxes_data = pc.boxes_data_;
   const auto* const scores_data = pc.scores_data_;
 
-  struct BoxInfoPtr {
-    float score_{};
-    int64_t index_{};
-
-    BoxInfoPtr() = default;
-    explicit BoxInfoPtr(float score, int64_t idx) : score_(score), index_(idx) {}
-    inline bool operator<(const BoxInfoPtr& rhs) const {
-      return score_ < rhs.score_ || (score_ == rhs.score_ && index_ > rhs.index_);
-    }
-  };
-
   const auto center_point_box = GetCenterPointBox();
-
-  std::vector<SelectedIndex> selected_indices;
-  std::vector<BoxInfoPtr> selected_boxes_inside_class;
-  selected_boxes_inside_class.reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_));
-
-  for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
-      std::vector<BoxInfoPtr> candidate_boxes;
-      candidate_boxes.reserve(pc.num_boxes_);
-
-      // Filter by score_threshold_
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            candidate_boxes.emplace_back(*class_scores, box_index);
+  const size_t max_selected_per_class =
+      std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), static_cast<size_t>(pc.num_boxes_));
+
+  // Each (batch, class) pair is independent, their selected indices are concatenated in order at the end.
+  const std::ptrdiff_t num_tasks = narrow<std::ptrdiff_t>(pc.num_batches_ * pc.num_classes_);
+  std::vector<std::vector<SelectedIndex>> selected_indices_per_task(num_tasks);
+
+  const double cost = static_cast<double>(pc.num_boxes_) * 16.0;
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), num_tasks, cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<BoxInfoPtr> candidate_boxes;
+        candidate_boxes.reserve(pc.num_boxes_);
+        SelectedBoxes selected_boxes;
+        selected_boxes.Reserve(max_selected_per_class);
+
+        for (std::ptrdiff_t task = first; task < last; ++task) {
+          const int64_t batch_index = task / pc.num_classes_;
+          const int64_t class_index = task % pc.num_classes_;
+          const int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
+          const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
+
+          // Filter by score_threshold_
+          candidate_boxes.clear();
+          const auto* class_scores = scores_data + box_score_offset;
+          if (pc.score_threshold_ != nullptr) {
+            for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
+              if (*class_scores > score_threshold) {
+                candidate_boxes.emplace_back(*class_scores, box_index);
+              }
+            }
+          } else {
+            for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
+              candidate_boxes.emplace_back(*class_scores, box_index);
+            }
           }
-        }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          candidate_boxes.emplace_back(*class_scores, box_index);
-        }
-      }
-      std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
-
-      selected_boxes_inside_class.clear();
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
-        const BoxInfoPtr& next_top_score = sorted_boxes.top();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (const auto& selected_index : selected_boxes_inside_class) {
-          if (SuppressByIOU(batch_boxes, next_top_score.index_, selected_index.index_, center_point_box, iou_threshold)) {
-            selected = false;
-            break;
+
+          // The candidates are popped from a heap in decreasing score order, so only the ones visited before
+          // max_output_boxes_per_class boxes are selected get sorted.
+          std::make_heap(candidate_boxes.begin(), candidate_boxes.end());
+          auto heap_end = candidate_boxes.end();
+
+          std::vector<SelectedIndex>& selected_indices = selected_indices_per_task[task];
+          selected_boxes.Clear();
+          // Get the next box with top score, filter by iou_threshold
+          while (heap_end != candidate_boxes.begin() && selected_boxes.Size() < max_selected_per_class) {
+            std::pop_heap(candidate_boxes.begin(), heap_end);
+            --heap_end;
+            const BoxInfoPtr& next_top_score = *heap_end;
+
+            // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
+            const BoxCorners corners = GetBoxCorners(batch_boxes + 4 * next_top_score.index_, center_point_box);
+            if (!selected_boxes.Suppress(corners, iou_threshold)) {
+              selected_boxes.Add(corners);
+              selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
+            }
           }
         }
+      });
 
-        if (selected) {
-          selected_boxes_inside_class.push_back(next_top_score);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
-        }
-        sorted_boxes.pop();
-      }  // while
-    }    // for class_index
-  }      // for batch_index
+  size_t num_selected = 0;
+  for (const auto& selected_indices : selected_indices_per_task) {
+    num_selected += selected_indices.size();
+  }
 
   constexpr auto last_dim = 3;
-  const auto num_selected = selected_indices.size();
   Tensor* output = ctx->Output(0, {static_cast<int64_t>(num_selected), last_dim});
   ORT_ENFORCE(output != nullptr);
   static_assert(last_dim * sizeof(int64_t) == sizeof(SelectedIndex), "Possible modification of SelectedIndex");
-  memcpy(output->MutableData<int64_t>(), selected_indices.data(), num_selected * sizeof(SelectedIndex));
+  auto* output_data = reinterpret_cast<SelectedIndex*>(output->MutableData<int64_t>());
+  for (const auto& selected_indices : selected_indices_per_task) {
+    output_data = std::copy(selected_indices.begin(), selected_indices.end(), output_data);
+  }
 
   return Status::OK();
 }
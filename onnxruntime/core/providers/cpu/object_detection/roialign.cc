@@ -17,7 +17,9 @@
 
 #include "roialign.h"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 #include <core/common/safeint.h>
 #include "core/util/math_cpuonly.h"
 #include "core/common/common.h"
@@ -163,11 +165,28 @@ void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, floa
   int64_t pooled_height = output_shape[2];
   int64_t pooled_width = output_shape[3];
 
-  // 100 is a random chosed value, need be tuned
-  double cost = static_cast<double>(channels * pooled_width * pooled_height * 100);
+  if (n_rois == 0 || channels == 0) {
+    return;
+  }
+
+  // The channels of each ROI are split as well when there are fewer ROIs than threads. A thread computes the sampling
+  // positions and weights of a ROI once for its consecutive channel blocks of the ROI.
+  const int64_t dop = ThreadPool::DegreeOfParallelism(ttp);
+  int64_t channel_blocks = n_rois >= dop ? 1 : std::min(channels, (dop + n_rois - 1) / n_rois);
+  const int64_t channels_per_block = (channels + channel_blocks - 1) / channel_blocks;
+  channel_blocks = (channels + channels_per_block - 1) / channels_per_block;
 
-  ThreadPool::TryParallelFor(ttp, static_cast<ptrdiff_t>(n_rois), cost, [&](ptrdiff_t n, ptrdiff_t end) {
-    for (; n != end; ++n) {
+  // 100 is a random chosed value, need be tuned
+  double cost = static_cast<double>(channels_per_block * pooled_width * pooled_height * 100);
+
+  const auto unit_count = static_cast<ptrdiff_t>(n_rois * channel_blocks);
+  ThreadPool::TryParallelFor(ttp, unit_count, cost, [&](ptrdiff_t unit, ptrdiff_t end) {
+    std::vector<PreCalc<T>> pre_calc;
+    int64_t pre_calc_roi = -1;
+    for (; unit != end; ++unit) {
+      const int64_t n = unit / channel_blocks;
+      const int64_t channel_begin = (unit % channel_blocks) * channels_per_block;
+      const int64_t channel_end = std::min(channel_begin + channels_per_block, channels);
       int64_t index_n = n * channels * pooled_width * pooled_height;
 
       const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
@@ -201,12 +220,15 @@ void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, floa
 
       // we want to precalculate indices and weights shared by all channels,
       // this is the key point of optimization
-      std::vector<PreCalc<T>> pre_calc(roi_bin_grid_h * roi_bin_grid_w * pooled_width * SafeInt<size_t>(pooled_height));
-      PreCalcForBilinearInterpolate(height, width, pooled_height, pooled_width, roi_bin_grid_h, roi_bin_grid_w,
-                                    roi_start_h, roi_start_w, bin_size_h, bin_size_w, roi_bin_grid_h,
-                                    roi_bin_grid_w, pre_calc);
+      if (n != pre_calc_roi) {
+        pre_calc.resize(roi_bin_grid_h * roi_bin_grid_w * pooled_width * SafeInt<size_t>(pooled_height));
+        PreCalcForBilinearInterpolate(height, width, pooled_height, pooled_width, roi_bin_grid_h, roi_bin_grid_w,
+                                      roi_start_h, roi_start_w, bin_size_h, bin_size_w, roi_bin_grid_h,
+                                      roi_bin_grid_w, pre_calc);
+        pre_calc_roi = n;
+      }
 
-      for (int64_t c = 0; c < channels; c++) {
+      for (int64_t c = channel_begin; c < channel_end; c++) {
         int64_t index_n_c = index_n + c * pooled_width * pooled_height;
         const T* offset_bottom_data =
             bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
@@ -253,7 +275,7 @@ void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, floa
           }  // for pw
         }    // for ph
       }      // for c
-    }        // for n
+    }        // for n and the channel block
   });
 }
 }  // namespace
@@ -3,6 +3,7 @@
 
 #include "matmul_integer_base.h"
 
+#include "core/framework/kernel_dispatch.h"
 #include "core/providers/cpu/math/matmul_helper.h"
 #include "core/util/math_cpuonly.h"
 #include "core/util/qmath.h"
@@ -120,6 +121,7 @@ Status MatMulInteger::Compute(OpKernelContext* ctx) const {
     gemm_params.B = b_data + helper.RightOffsets()[batch];
     gemm_params.C = y_data + helper.OutputOffsets()[batch];
   }
+  RecordKernelDispatch("mlas_qgemm", MlasGemmQuantGetKernelName(gemm_shape.AIsSigned, gemm_shape.BIsSigned));
   MlasGemmBatch(gemm_shape, gemm_data_vec.data(), batch_size, ctx->GetOperatorThreadPool());
 
   return Status::OK();
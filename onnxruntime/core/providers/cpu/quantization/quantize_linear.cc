@@ -173,36 +173,73 @@ ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
 }  // namespace contrib
 #endif  // !defined(DISABLE_CONTRIB_OPS)
 
+// Runs fn(offset, count, broadcast index) over the elements of the block_count * broadcast_dim blocks of block_size
+// elements. The blocks are divided between the threads, or the elements of each block when there are fewer blocks
+// than threads, as with per-tensor scales.
+template <typename Fn>
+void ParallelForQDQBlocks(concurrency::ThreadPool* thread_pool, int64_t block_count, int64_t broadcast_dim,
+                          int64_t block_size, const TensorOpCost& element_cost, const Fn& fn) {
+  const std::ptrdiff_t num_blocks = narrow<std::ptrdiff_t>(block_count * broadcast_dim);
+  const std::ptrdiff_t size = narrow<std::ptrdiff_t>(block_size);
+  const std::ptrdiff_t bd = narrow<std::ptrdiff_t>(broadcast_dim);
+
+  if (num_blocks >= concurrency::ThreadPool::DegreeOfParallelism(thread_pool)) {
+    const TensorOpCost block_cost{element_cost.bytes_loaded * size, element_cost.bytes_stored * size,
+                                  element_cost.compute_cycles * size};
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool, num_blocks, block_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t block = begin; block < end; ++block) {
+            fn(block * size, size, block % bd);
+          }
+        });
+  } else {
+    for (std::ptrdiff_t block = 0; block < num_blocks; ++block) {
+      concurrency::ThreadPool::TryParallelFor(
+          thread_pool, size, element_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+            fn(block * size + begin, end - begin, block % bd);
+          });
+    }
+  }
+}
+
 template <typename T, typename OutT>
 struct DequantizeLinearApply {
-  void op(int64_t N, int64_t broadcast_dim, int64_t block_size, const T* input, const OutT* scale, OutT* output, const T* zero_point) {
-    for (size_t n = 0; n < static_cast<size_t>(N); n++) {
-      for (size_t bd = 0; bd < static_cast<size_t>(broadcast_dim); bd++) {
-        auto zp = zero_point ? static_cast<int32_t>(zero_point[bd]) : 0;
-        auto sc = static_cast<float>(scale[bd]);
-        for (size_t bs = 0; bs < static_cast<size_t>(block_size); bs++) {
-          *output++ = static_cast<OutT>(static_cast<float>(static_cast<int32_t>(*input++) - zp) * sc);
-        }
-      }
-    }
+  void op(concurrency::ThreadPool* thread_pool, int64_t N, int64_t broadcast_dim, int64_t block_size, const T* input,
+          const OutT* scale, OutT* output, const T* zero_point) {
+    const TensorOpCost unit_cost{static_cast<double>(sizeof(T)), static_cast<double>(sizeof(OutT)), 2.0};
+    ParallelForQDQBlocks(thread_pool, N, broadcast_dim, block_size, unit_cost,
+                         [&](std::ptrdiff_t offset, std::ptrdiff_t count, std::ptrdiff_t bd) {
+                           const auto zp = zero_point ? static_cast<int32_t>(zero_point[bd]) : 0;
+                           const auto sc = static_cast<float>(scale[bd]);
+                           const T* x = input + offset;
+                           OutT* y = output + offset;
+                           for (std::ptrdiff_t i = 0; i < count; i++) {
+                             y[i] = static_cast<OutT>(static_cast<float>(static_cast<int32_t>(x[i]) - zp) * sc);
+                           }
+                         });
   }
 };
 
 #if !defined(DISABLE_FLOAT8_TYPES)
 
-#define DEQUANTIZE_LINEAR_APPLY_FLOAT8(T)                                                                                      \
-  template <typename OutT>                                                                                                     \
-  struct DequantizeLinearApply<T, OutT> {                                                                                      \
-    void op(int64_t N, int64_t broadcast_dim, int64_t block_size, const T* input, const OutT* scale, OutT* output, const T*) { \
-      for (size_t n = 0; n < static_cast<size_t>(N); n++) {                                                                    \
-        for (size_t bd = 0; bd < static_cast<size_t>(broadcast_dim); bd++) {                                                   \
-          auto sc = scale[bd];                                                                                                 \
-          for (size_t bs = 0; bs < static_cast<size_t>(block_size); bs++, input++) {                                           \
-            *output++ = static_cast<OutT>(input->ToFloat() * sc);                                                              \
-          }                                                                                                                    \
-        }                                                                                                                      \
-      }                                                                                                                        \
-    }                                                                                                                          \
+// float 8 values are looked up in a table of the 256 bit patterns
+#define DEQUANTIZE_LINEAR_APPLY_FLOAT8(T)                                                                         \
+  template <typename OutT>                                                                                        \
+  struct DequantizeLinearApply<T, OutT> {                                                                         \
+    void op(concurrency::ThreadPool* thread_pool, int64_t N, int64_t broadcast_dim, int64_t block_size,           \
+            const T* input, const OutT* scale, OutT* output, const T*) {                                          \
+      const float* table = Float8ToFloatTable<T>();                                                               \
+      const TensorOpCost unit_cost{static_cast<double>(sizeof(T)), static_cast<double>(sizeof(OutT)), 2.0};      \
+      ParallelForQDQBlocks(thread_pool, N, broadcast_dim, block_size, unit_cost,                                  \
+                           [&](std::ptrdiff_t offset, std::ptrdiff_t count, std::ptrdiff_t bd) {                 \
+                             auto sc = scale[bd];                                                                 \
+                             const T* x = input + offset;                                                         \
+                             OutT* y = output + offset;                                                           \
+                             for (std::ptrdiff_t i = 0; i < count; i++) {                                         \
+                               y[i] = static_cast<OutT>(table[x[i].val] * sc);                                    \
+                             }                                                                                    \
+                           });                                                                                    \
+    }                                                                                                             \
   };
 
 DEQUANTIZE_LINEAR_APPLY_FLOAT8(Float8E4M3FN)
@@ -248,11 +285,11 @@ Status DequantizeLinear<T>::Compute(OpKernelContext* ctx) const {
   if (to == ONNX_NAMESPACE::TensorProto::FLOAT) {
     const float* scale = x_scale.Data<float>();
     float* output = y.MutableData<float>();
-    DequantizeLinearApply<T, float>().op(N, broadcast_dim, block_size, input, scale, output, zero_point);
+    DequantizeLinearApply<T, float>().op(ctx->GetOperatorThreadPool(), N, broadcast_dim, block_size, input, scale, output, zero_point);
   } else if (to == ONNX_NAMESPACE::TensorProto::FLOAT16) {
     const MLFloat16* scale = x_scale.Data<MLFloat16>();
     MLFloat16* output = y.MutableData<MLFloat16>();
-    DequantizeLinearApply<T, MLFloat16>().op(N, broadcast_dim, block_size, input, scale, output, zero_point);
+    DequantizeLinearApply<T, MLFloat16>().op(ctx->GetOperatorThreadPool(), N, broadcast_dim, block_size, input, scale, output, zero_point);
   } else if (to == ONNX_NAMESPACE::TensorProto::BFLOAT16) {
     ORT_THROW("DequantizeLinear into BFLOAT16 is not implemented yet.");
   } else {
@@ -373,13 +410,13 @@ void ParQuantizeLinear(const InputType* Input,
 
 template <typename T, typename InT>
 void ComputeLoop(OpKernelContext* ctx, const InT* input, const InT* scale, const T* zero_point, T* output, int64_t N, int64_t broadcast_dim, int64_t block_size, bool saturate) {
-  for (size_t n = 0; n < static_cast<size_t>(N); n++) {
-    for (size_t bd = 0; bd < static_cast<size_t>(broadcast_dim); bd++) {
-      ParQuantizeLinear(input, output, static_cast<size_t>(block_size), scale[bd], bd, zero_point, saturate, ctx->GetOperatorThreadPool());
-      input += block_size;
-      output += block_size;
-    }
-  }
+  // the blocks, or the parts of a block, are quantized by each thread without nesting another parallel loop
+  const TensorOpCost unit_cost{static_cast<double>(sizeof(InT)), static_cast<double>(sizeof(T)), 2.0};
+  ParallelForQDQBlocks(ctx->GetOperatorThreadPool(), N, broadcast_dim, block_size, unit_cost,
+                       [&](std::ptrdiff_t offset, std::ptrdiff_t count, std::ptrdiff_t bd) {
+                         ParQuantizeLinear(input + offset, output + offset, static_cast<size_t>(count), scale[bd],
+                                           static_cast<size_t>(bd), zero_point, saturate, nullptr);
+                       });
 }
 
 // formula is Y = X / Scale + ZeroPoint
@@ -5,6 +5,7 @@
 
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
+#include "core/framework/kernel_dispatch.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/math/matmul_helper.h"
 #include "core/providers/common.h"
@@ -144,6 +145,7 @@ Status QLinearMatMul::Compute(OpKernelContext* ctx) const {
     gemm_params[i].OutputProcessor = &(requant_procs[i]);
   }
 
+  RecordKernelDispatch("mlas_qgemm", MlasGemmQuantGetKernelName(gemm_shape.AIsSigned, gemm_shape.BIsSigned));
   MlasGemmBatch(gemm_shape, gemm_params.data(), num_gemms, ctx->GetOperatorThreadPool());
 
   return Status::OK();
@@ -207,6 +207,12 @@ void DumpMatrixImpl(const std::string& name, const float* src, int row, int col,
 }
 #endif
 
+bool ComputeDirectionsConcurrently(concurrency::ThreadPool* thread_pool, int batch_size, int hidden_size) {
+  // batch_size * hidden_size is the size of the hidden state updated by each step
+  constexpr int kMaxStepSize = 2048;
+  return concurrency::ThreadPool::DegreeOfParallelism(thread_pool) >= 2 && batch_size * hidden_size <= kMaxStepSize;
+}
+
 void ComputeGemm(const int M,
                  const int N,
                  const int K,
@@ -554,6 +560,44 @@ void merge_lstm_gates_to_memory(const float* pprev, const float* restrict pi, co
   }
 }
 
+void lstm_cell_sigmoid_tanh(float* piofc, const float* pb, const float b, const bool input_forget, float* pcurr,
+                            float* ph, int c) {
+  const int c_x4 = 4 * c;
+  if (pb != nullptr) {
+    for (int i = 0; i < c_x4; i++) {
+      piofc[i] = std::max(-b, std::min(b, piofc[i] + pb[i]));
+    }
+  } else {
+    for (int i = 0; i < c_x4; i++) {
+      piofc[i] = std::max(-b, std::min(b, piofc[i]));
+    }
+  }
+
+  float* pi = piofc;
+  float* po = pi + c;
+  float* pf = po + c;
+  float* pg = pf + c;
+
+  // the i, o and f gates are contiguous and share the sigmoid
+  MlasComputeLogistic(pi, pi, input_forget ? 2 * c : 3 * c);
+  MlasComputeTanh(pg, pg, c);
+  if (input_forget) {
+    for (int i = 0; i < c; i++) {
+      pcurr[i] = pcurr[i] * (1.0f - pi[i]) + pi[i] * pg[i];
+    }
+  } else {
+    for (int i = 0; i < c; i++) {
+      pcurr[i] = pcurr[i] * pf[i] + pi[i] * pg[i];
+    }
+  }
+
+  // the g gate is no longer needed and holds tanh(Ct)
+  MlasComputeTanh(pcurr, pg, c);
+  for (int i = 0; i < c; i++) {
+    ph[i] = po[i] * pg[i];
+  }
+}
+
 void gru_reset_gate_tanh(const float* ps1, float* ps2, float* pd, int c, float alpha, float beta) {
   ORT_UNUSED_PARAMETER(alpha);
   ORT_UNUSED_PARAMETER(beta);
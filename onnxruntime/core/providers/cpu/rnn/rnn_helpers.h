@@ -325,6 +325,10 @@ T* SafeRawPointer(typename gsl::span<T> span, size_t offset, size_t size) {
 void DumpMatrixImpl(const std::string& name, const float* src, int row, int col,
                     int offset = 0, int col_width = -1);
 
+// Whether the two directions of a bidirectional layer should be computed concurrently, each on a single thread.
+// This is preferable to splitting the steps of each direction between the threads when they are too small for it.
+bool ComputeDirectionsConcurrently(concurrency::ThreadPool* thread_pool, int batch_size, int hidden_size);
+
 // Helper class to wrap the processing of the activation funcs and any alpha/beta values.
 // The alpha/beta values are consumed in the order of the activation funcs. once they run out
 // defaults will be used as needed.
@@ -383,6 +387,10 @@ void sigmoid_exact(float* pd, int c, float alpha, float beta);
 void tanh_exact(float* pd, int c, float alpha, float beta);
 void merge_lstm_gates_to_memory(const float* pprev, const float* pi, const float* pf, const float* pg, float* pcurr,
                                 int c);
+// One step of an LSTM cell with the default activations (f = sigmoid, g = tanh, h = tanh) and no peepholes.
+// piofc holds the c values of each of the i, o, f and c gates of a row, pb the bias in the same order or nullptr.
+// Ct is computed in place of Ct-1 in pcurr, and Ht is written to ph. piofc is used as scratch.
+void lstm_cell_sigmoid_tanh(float* piofc, const float* pb, float b, bool input_forget, float* pcurr, float* ph, int c);
 void gru_reset_gate_tanh(const float* ps1, float* ps2, float* pd, int c, float alpha, float beta);
 void gru_reset_gate_sigmoid(const float* ps1, float* ps2, float* pd, int c, float alpha, float beta);
 void gru_reset_gate_relu(const float* ps1, const float* ps2, float* pd, int c, float alpha, float beta);
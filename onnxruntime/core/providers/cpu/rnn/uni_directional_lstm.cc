@@ -75,6 +75,10 @@ UniDirectionalLstm<T>::UniDirectionalLstm(
 
   clip_with_bias_ptr_ = use_bias_ ? deepcpu::clip_add_bias : deepcpu::clip_ignore_bias;
 
+  // training needs the value of every gate in output_iofc, which the fused computations use as scratch
+  fused_gates_ = !use_peepholes_ && !training_mode_ && activation_f_.func == deepcpu::sigmoid &&
+                 activation_g_.func == deepcpu::tanh && activation_h_.func == deepcpu::tanh_m;
+
   SetNumThreads();
   AllocateBuffers();
   InitializeBuffers(initial_hidden_state, initial_cell_state);
@@ -103,10 +107,12 @@ void UniDirectionalLstm<T>::AllocateBuffers() {
   }
 
   if (use_bias_) {
-    bias_WRi_ = Allocate(allocator_, hidden_size_, bias_WRi_ptr_);
-    bias_WRf_ = Allocate(allocator_, hidden_size_, bias_WRf_ptr_);
-    bias_WRo_ = Allocate(allocator_, hidden_size_, bias_WRo_ptr_);
-    bias_WRc_ = Allocate(allocator_, hidden_size_, bias_WRc_ptr_);
+    // one buffer in the iofc order of the gates, so the fused gate computations can add the bias of a row at once
+    bias_WR_ = Allocate(allocator_, 4 * hidden_size_, bias_WR_ptr_);
+    bias_WRi_ = bias_WR_.subspan(0, hidden_size_);
+    bias_WRo_ = bias_WR_.subspan(hidden_size_, hidden_size_);
+    bias_WRf_ = bias_WR_.subspan(2 * hidden_size_, hidden_size_);
+    bias_WRc_ = bias_WR_.subspan(3 * hidden_size_, hidden_size_);
   }
 
   if (direction_ == kReverse) {
@@ -497,6 +503,14 @@ void UniDirectionalLstm<T>::GateComputations(
 
     // DumpMatrix("C_prev" + row_str, pCprev_hidden_size, 1, hidden_size_);
 
+    if (fused_gates_) {
+      const float* pB = use_bias_ ? SafeRawConstPointer<T>(bias_WR_, 0, hidden_size_x4) : nullptr;
+      float* pH =
+          SafeRawPointer<T>(batched_output + row * hidden_size_ + b * hidden_size_, batched_output_end, hidden_size_);
+      deepcpu::lstm_cell_sigmoid_tanh(pi, pB, clip_, input_forget_, pCprev_hidden_size, pH, hidden_size_);
+      continue;
+    }
+
     // Input Gate
     if (use_peepholes_) {
       deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_i_, 0, hidden_size_), pi,
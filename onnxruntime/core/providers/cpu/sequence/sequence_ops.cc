@@ -192,6 +192,7 @@ ONNX_CPU_OPERATOR_KERNEL(
     SequenceInsert,
     11,
     KernelDefBuilder()
+        .MayInplace(0, 0)
         .TypeConstraint("S", DataTypeImpl::AllSequenceTensorTypes())
         .TypeConstraint("I", std::vector<MLDataType>{
                                  DataTypeImpl::GetTensorType<int32_t>(),
@@ -234,6 +235,13 @@ Status SequenceInsert::Compute(OpKernelContext* context) const {
   }
 
   auto* Y = context->Output<TensorSeq>(0);
+  if (Y == S) {
+    // the sequence is updated in place as this is its last use, so a loop building it doesn't copy it at each step
+    // Using DataTransferManager here allows other non-CPU EPs to use this implementation of the sequence ops
+    Y->InsertAt(static_cast<size_t>(input_seq_idx), CloneTensor(*X, context, Info().GetDataTransferManager()));
+    return Status::OK();
+  }
+
   Y->SetType(S->DataType());
   Y->Reserve(SafeInt<size_t>(num_tensors_input_seq) + 1);
 
@@ -259,6 +267,7 @@ ONNX_CPU_OPERATOR_KERNEL(
     SequenceErase,
     11,
     KernelDefBuilder()
+        .MayInplace(0, 0)
         .TypeConstraint("S", DataTypeImpl::AllSequenceTensorTypes())
         .TypeConstraint("I", std::vector<MLDataType>{
                                  DataTypeImpl::GetTensorType<int32_t>(),
@@ -284,6 +293,12 @@ Status SequenceErase::Compute(OpKernelContext* context) const {
   }
 
   auto* Y = context->Output<TensorSeq>(0);
+  if (Y == S) {
+    // the sequence is updated in place as this is its last use
+    Y->EraseAt(static_cast<size_t>(input_seq_idx));
+    return Status::OK();
+  }
+
   Y->SetType(S->DataType());
   Y->Reserve(SafeInt<size_t>(num_tensors_input_seq) - 1);
 
@@ -0,0 +1,365 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/signal/fft.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+namespace signal {
+
+namespace {
+
+// std::complex multiplication checks for infinities and NaNs, which prevents the butterflies from being vectorized.
+template <typename T>
+inline std::complex<T> Multiply(const std::complex<T>& a, const std::complex<T>& b) {
+  return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+}
+
+constexpr double kPi = 3.14159265358979323846;
+
+// exp(i * pi * numerator / denominator), computed in double precision.
+template <typename T>
+std::complex<T> UnitRoot(double numerator, double denominator) {
+  const double angle = kPi * numerator / denominator;
+  return {static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle))};
+}
+
+}  // namespace
+
+template <typename T>
+FFTPlan<T>::FFTPlan(size_t length, bool inverse) : length_(length), inverse_(inverse) {
+  ORT_ENFORCE(length > 0, "The FFT length must be greater than zero.");
+  const double sign = inverse ? 1.0 : -1.0;
+
+  size_t remaining = length;
+  while (remaining % 4 == 0) {
+    radices_.push_back(4);
+    remaining /= 4;
+  }
+  while (remaining % 2 == 0) {
+    radices_.push_back(2);
+    remaining /= 2;
+  }
+  for (size_t p = 3; p <= kMaxGenericRadix && remaining > 1; p += 2) {
+    while (remaining % p == 0) {
+      radices_.push_back(p);
+      remaining /= p;
+    }
+  }
+
+  if (remaining > 1) {
+    radices_.clear();
+
+    size_t convolution_length = 1;
+    while (convolution_length < 2 * length - 1) {
+      convolution_length <<= 1;
+    }
+    convolution_plan_ = std::make_unique<FFTPlan<T>>(convolution_length, false);
+    scratch_size_ = 2 * convolution_length;
+
+    // n^2 is reduced modulo 2 * length to keep the angle accurate.
+    chirp_.resize(length);
+    for (size_t n = 0; n < length; ++n) {
+      chirp_[n] = UnitRoot<T>(sign * static_cast<double>((n * n) % (2 * length)), static_cast<double>(length));
+    }
+
+    std::vector<std::complex<T>> filter(convolution_length, std::complex<T>(0, 0));
+    filter[0] = std::conj(chirp_[0]);
+    for (size_t n = 1; n < length; ++n) {
+      filter[n] = std::conj(chirp_[n]);
+      filter[convolution_length - n] = std::conj(chirp_[n]);
+    }
+    chirp_filter_.resize(convolution_length);
+    convolution_plan_->Transform(filter.data(), chirp_filter_.data(), nullptr);
+    const T scale = static_cast<T>(1) / static_cast<T>(convolution_length);
+    for (auto& value : chirp_filter_) {
+      value *= scale;
+    }
+    return;
+  }
+
+  sub_lengths_.resize(radices_.size());
+  size_t sub_length = length;
+  for (size_t stage = 0; stage < radices_.size(); ++stage) {
+    sub_length /= radices_[stage];
+    sub_lengths_[stage] = sub_length;
+  }
+
+  twiddles_.resize(length);
+  for (size_t k = 0; k < length; ++k) {
+    twiddles_[k] = UnitRoot<T>(sign * 2.0 * static_cast<double>(k), static_cast<double>(length));
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::Transform(const std::complex<T>* input, std::complex<T>* output, std::complex<T>* scratch) const {
+  if (convolution_plan_) {
+    const size_t convolution_length = convolution_plan_->Length();
+    std::complex<T>* a = scratch;
+    std::complex<T>* c = scratch + convolution_length;
+    for (size_t n = 0; n < length_; ++n) {
+      a[n] = Multiply(input[n], chirp_[n]);
+    }
+    std::fill(a + length_, a + convolution_length, std::complex<T>(0, 0));
+    convolution_plan_->Transform(a, c, nullptr);
+
+    // The inverse FFT of the product is the conjugate of the forward FFT of its conjugate.
+    for (size_t k = 0; k < convolution_length; ++k) {
+      a[k] = std::conj(Multiply(c[k], chirp_filter_[k]));
+    }
+    convolution_plan_->Transform(a, c, nullptr);
+    for (size_t k = 0; k < length_; ++k) {
+      output[k] = Multiply(std::conj(c[k]), chirp_[k]);
+    }
+    return;
+  }
+
+  if (radices_.empty()) {
+    output[0] = input[0];
+    return;
+  }
+  Work(output, input, 1, 0);
+}
+
+// Decimation in time: the sub-transforms of the radix interleaved subsequences of the input are computed into
+// consecutive blocks of the output, then combined by the butterflies of the stage.
+template <typename T>
+void FFTPlan<T>::Work(std::complex<T>* output, const std::complex<T>* input, size_t stride, size_t stage) const {
+  const size_t radix = radices_[stage];
+  const size_t m = sub_lengths_[stage];
+  if (m == 1) {
+    for (size_t q = 0; q < radix; ++q) {
+      output[q] = input[q * stride];
+    }
+  } else {
+    for (size_t q = 0; q < radix; ++q) {
+      Work(output + q * m, input + q * stride, stride * radix, stage + 1);
+    }
+  }
+
+  switch (radix) {
+    case 2:
+      Butterfly2(output, stride, m);
+      break;
+    case 3:
+      Butterfly3(output, stride, m);
+      break;
+    case 4:
+      Butterfly4(output, stride, m);
+      break;
+    case 5:
+      Butterfly5(output, stride, m);
+      break;
+    default:
+      ButterflyGeneric(output, stride, m, radix);
+      break;
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::Butterfly2(std::complex<T>* output, size_t stride, size_t m) const {
+  std::complex<T>* output1 = output + m;
+  for (size_t k = 0; k < m; ++k) {
+    const std::complex<T> t = Multiply(output1[k], twiddles_[k * stride]);
+    output1[k] = output[k] - t;
+    output[k] += t;
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::Butterfly3(std::complex<T>* output, size_t stride, size_t m) const {
+  const T epi3 = twiddles_[stride * m].imag();
+  std::complex<T>* output1 = output + m;
+  std::complex<T>* output2 = output + 2 * m;
+  for (size_t k = 0; k < m; ++k) {
+    const std::complex<T> s1 = Multiply(output1[k], twiddles_[k * stride]);
+    const std::complex<T> s2 = Multiply(output2[k], twiddles_[2 * k * stride]);
+    const std::complex<T> s3 = s1 + s2;
+    const std::complex<T> s0 = (s1 - s2) * epi3;
+    const std::complex<T> half = output[k] - s3 * static_cast<T>(0.5);
+    output[k] += s3;
+    output2[k] = {half.real() + s0.imag(), half.imag() - s0.real()};
+    output1[k] = {half.real() - s0.imag(), half.imag() + s0.real()};
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::Butterfly4(std::complex<T>* output, size_t stride, size_t m) const {
+  std::complex<T>* output1 = output + m;
+  std::complex<T>* output2 = output + 2 * m;
+  std::complex<T>* output3 = output + 3 * m;
+  for (size_t k = 0; k < m; ++k) {
+    const std::complex<T> s0 = Multiply(output1[k], twiddles_[k * stride]);
+    const std::complex<T> s1 = Multiply(output2[k], twiddles_[2 * k * stride]);
+    const std::complex<T> s2 = Multiply(output3[k], twiddles_[3 * k * stride]);
+    const std::complex<T> s5 = output[k] - s1;
+    const std::complex<T> s3 = s0 + s2;
+    const std::complex<T> s4 = s0 - s2;
+    const std::complex<T> s6 = output[k] + s1;
+    output2[k] = s6 - s3;
+    output[k] = s6 + s3;
+    if (inverse_) {
+      output1[k] = {s5.real() - s4.imag(), s5.imag() + s4.real()};
+      output3[k] = {s5.real() + s4.imag(), s5.imag() - s4.real()};
+    } else {
+      output1[k] = {s5.real() + s4.imag(), s5.imag() - s4.real()};
+      output3[k] = {s5.real() - s4.imag(), s5.imag() + s4.real()};
+    }
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::Butterfly5(std::complex<T>* output, size_t stride, size_t m) const {
+  const std::complex<T> ya = twiddles_[stride * m];
+  const std::complex<T> yb = twiddles_[2 * stride * m];
+  std::complex<T>* output1 = output + m;
+  std::complex<T>* output2 = output + 2 * m;
+  std::complex<T>* output3 = output + 3 * m;
+  std::complex<T>* output4 = output + 4 * m;
+  for (size_t k = 0; k < m; ++k) {
+    const std::complex<T> s0 = output[k];
+    const std::complex<T> s1 = Multiply(output1[k], twiddles_[k * stride]);
+    const std::complex<T> s2 = Multiply(output2[k], twiddles_[2 * k * stride]);
+    const std::complex<T> s3 = Multiply(output3[k], twiddles_[3 * k * stride]);
+    const std::complex<T> s4 = Multiply(output4[k], twiddles_[4 * k * stride]);
+
+    const std::complex<T> s7 = s1 + s4;
+    const std::complex<T> s10 = s1 - s4;
+    const std::complex<T> s8 = s2 + s3;
+    const std::complex<T> s9 = s2 - s3;
+
+    output[k] = s0 + s7 + s8;
+
+    const std::complex<T> s5 = {s0.real() + s7.real() * ya.real() + s8.real() * yb.real(),
+                                s0.imag() + s7.imag() * ya.real() + s8.imag() * yb.real()};
+    const std::complex<T> s6 = {s10.imag() * ya.imag() + s9.imag() * yb.imag(),
+                                -s10.real() * ya.imag() - s9.real() * yb.imag()};
+    output1[k] = s5 - s6;
+    output4[k] = s5 + s6;
+
+    const std::complex<T> s11 = {s0.real() + s7.real() * yb.real() + s8.real() * ya.real(),
+                                 s0.imag() + s7.imag() * yb.real() + s8.imag() * ya.real()};
+    const std::complex<T> s12 = {-s10.imag() * yb.imag() + s9.imag() * ya.imag(),
+                                 s10.real() * yb.imag() - s9.real() * ya.imag()};
+    output2[k] = s11 + s12;
+    output3[k] = s11 - s12;
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::ButterflyGeneric(std::complex<T>* output, size_t stride, size_t m, size_t radix) const {
+  std::complex<T> values[kMaxGenericRadix];
+  for (size_t u = 0; u < m; ++u) {
+    for (size_t q = 0; q < radix; ++q) {
+      values[q] = output[u + q * m];
+    }
+    for (size_t q1 = 0; q1 < radix; ++q1) {
+      const size_t k = u + q1 * m;
+      size_t twiddle_index = 0;
+      std::complex<T> sum = values[0];
+      for (size_t q = 1; q < radix; ++q) {
+        twiddle_index += stride * k;
+        if (twiddle_index >= length_) {
+          twiddle_index -= length_;
+        }
+        sum += Multiply(values[q], twiddles_[twiddle_index]);
+      }
+      output[k] = sum;
+    }
+  }
+}
+
+template <typename T>
+RealFFTPlan<T>::RealFFTPlan(size_t length)
+    : length_(length),
+      plan_(length % 2 == 0 ? length / 2 : length, false) {
+  // An even length uses the half length plan on the samples packed as complex numbers and an odd one the full length
+  // plan on the samples converted to complex numbers.
+  scratch_size_ = 2 * plan_.Length() + plan_.ScratchSize();
+  if (length % 2 == 0) {
+    const size_t half_length = length / 2;
+    twiddles_.resize(half_length + 1);
+    for (size_t k = 0; k <= half_length; ++k) {
+      twiddles_[k] = UnitRoot<T>(-2.0 * static_cast<double>(k), static_cast<double>(length));
+    }
+  }
+}
+
+template <typename T>
+void RealFFTPlan<T>::Transform(const T* input, std::complex<T>* output, std::complex<T>* scratch) const {
+  const size_t n = plan_.Length();
+  std::complex<T>* packed = scratch;
+  std::complex<T>* transformed = scratch + n;
+  std::complex<T>* plan_scratch = scratch + 2 * n;
+
+  if (length_ % 2 != 0) {
+    for (size_t i = 0; i < n; ++i) {
+      packed[i] = {input[i], 0};
+    }
+    plan_.Transform(packed, transformed, plan_scratch);
+    std::copy(transformed, transformed + n / 2 + 1, output);
+    return;
+  }
+
+  // z[i] = x[2i] + i x[2i+1]. The transforms of the even and odd samples are extracted from Z[k] and conj(Z[n - k]),
+  // and X[k] = E[k] + w^k O[k].
+  for (size_t i = 0; i < n; ++i) {
+    packed[i] = {input[2 * i], input[2 * i + 1]};
+  }
+  plan_.Transform(packed, transformed, plan_scratch);
+  const T half = static_cast<T>(0.5);
+  for (size_t k = 0; k <= n; ++k) {
+    const std::complex<T> z = transformed[k == n ? 0 : k];
+    const std::complex<T> z_conj = std::conj(transformed[k == 0 ? 0 : n - k]);
+    const std::complex<T> even = (z + z_conj) * half;
+    const std::complex<T> difference = (z - z_conj) * half;
+    // odd = -i * difference
+    const std::complex<T> odd = {difference.imag(), -difference.real()};
+    output[k] = even + Multiply(twiddles_[k], odd);
+  }
+}
+
+template <typename T>
+std::shared_ptr<const FFTPlan<T>> FFTPlanCache<T>::GetPlan(size_t length, bool inverse) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = plans_.find({length, inverse});
+  if (it != plans_.end()) {
+    return it->second;
+  }
+  if (plans_.size() >= kMaxCachedPlans) {
+    plans_.clear();
+  }
+  auto plan = std::make_shared<const FFTPlan<T>>(length, inverse);
+  plans_.emplace(std::make_pair(length, inverse), plan);
+  return plan;
+}
+
+template <typename T>
+std::shared_ptr<const RealFFTPlan<T>> FFTPlanCache<T>::GetRealPlan(size_t length) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = real_plans_.find(length);
+  if (it != real_plans_.end()) {
+    return it->second;
+  }
+  if (real_plans_.size() >= kMaxCachedPlans) {
+    real_plans_.clear();
+  }
+  auto plan = std::make_shared<const RealFFTPlan<T>>(length);
+  real_plans_.emplace(length, plan);
+  return plan;
+}
+
+template class FFTPlan<float>;
+template class FFTPlan<double>;
+template class RealFFTPlan<float>;
+template class RealFFTPlan<double>;
+template class FFTPlanCache<float>;
+template class FFTPlanCache<double>;
+
+}  // namespace signal
+}  // namespace onnxruntime
@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <complex>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+namespace signal {
+
+// Complex FFT of a given length and direction, computed without scaling:
+//   output[k] = sum_n input[n] * exp(-+2 * pi * i * n * k / length)
+// The length is factored into radix 4, 2, 3 and 5 butterflies, and a generic butterfly for the other primes up to
+// kMaxGenericRadix. A length with a larger prime factor is computed with Bluestein's algorithm, as a convolution
+// done through a power of 2 FFT.
+template <typename T>
+class FFTPlan {
+ public:
+  static constexpr size_t kMaxGenericRadix = 31;
+
+  FFTPlan(size_t length, bool inverse);
+
+  size_t Length() const { return length_; }
+
+  // Number of elements of the scratch buffer needed by Transform.
+  size_t ScratchSize() const { return scratch_size_; }
+
+  // input and output must not overlap, scratch has ScratchSize() elements.
+  void Transform(const std::complex<T>* input, std::complex<T>* output, std::complex<T>* scratch) const;
+
+ private:
+  void Work(std::complex<T>* output, const std::complex<T>* input, size_t stride, size_t stage) const;
+  void Butterfly2(std::complex<T>* output, size_t stride, size_t m) const;
+  void Butterfly3(std::complex<T>* output, size_t stride, size_t m) const;
+  void Butterfly4(std::complex<T>* output, size_t stride, size_t m) const;
+  void Butterfly5(std::complex<T>* output, size_t stride, size_t m) const;
+  void ButterflyGeneric(std::complex<T>* output, size_t stride, size_t m, size_t radix) const;
+
+  size_t length_;
+  bool inverse_;
+  size_t scratch_size_ = 0;
+
+  // Radix of each stage and length of the sub-transforms it combines.
+  std::vector<size_t> radices_;
+  std::vector<size_t> sub_lengths_;
+  // twiddles_[k] = exp(-+2 * pi * i * k / length)
+  std::vector<std::complex<T>> twiddles_;
+
+  // Bluestein's algorithm: chirp_[n] = exp(-+pi * i * n^2 / length) and the FFT of the conjugate chirp, divided by
+  // the length of convolution_plan_.
+  std::unique_ptr<FFTPlan<T>> convolution_plan_;
+  std::vector<std::complex<T>> chirp_;
+  std::vector<std::complex<T>> chirp_filter_;
+};
+
+// Forward FFT of a real signal, output[k] for k <= length / 2 (the other bins are the conjugates).
+// An even length is computed with a complex FFT of half the length.
+template <typename T>
+class RealFFTPlan {
+ public:
+  explicit RealFFTPlan(size_t length);
+
+  size_t Length() const { return length_; }
+
+  // Number of elements of the scratch buffer needed by Transform.
+  size_t ScratchSize() const { return scratch_size_; }
+
+  // output has length / 2 + 1 elements, scratch has ScratchSize() elements.
+  void Transform(const T* input, std::complex<T>* output, std::complex<T>* scratch) const;
+
+ private:
+  size_t length_;
+  size_t scratch_size_;
+  FFTPlan<T> plan_;
+  // twiddles_[k] = exp(-2 * pi * i * k / length) for k <= length / 2 when the length is even.
+  std::vector<std::complex<T>> twiddles_;
+};
+
+// Plans created by a DFT or STFT kernel, for each length and direction, and reused by the following runs.
+template <typename T>
+class FFTPlanCache {
+ public:
+  std::shared_ptr<const FFTPlan<T>> GetPlan(size_t length, bool inverse);
+  std::shared_ptr<const RealFFTPlan<T>> GetRealPlan(size_t length);
+
+ private:
+  // The lengths come from the inputs, the cache is emptied instead of growing without limit.
+  static constexpr size_t kMaxCachedPlans = 16;
+
+  OrtMutex mutex_;
+  std::map<std::pair<size_t, bool>, std::shared_ptr<const FFTPlan<T>>> plans_;
+  std::map<size_t, std::shared_ptr<const RealFFTPlan<T>>> real_plans_;
+};
+
+}  // namespace signal
+}  // namespace onnxruntime
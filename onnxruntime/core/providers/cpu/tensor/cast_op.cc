@@ -15,9 +15,13 @@
 #include "core/framework/data_types.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/util/math_cpuonly.h"
+#if !defined(DISABLE_FLOAT8_TYPES)
+#include "core/util/qmath.h"
+#endif
 
 #include "Eigen/src/Core/arch/Default/BFloat16.h"
 #include "Eigen/src/Core/arch/Default/Half.h"
@@ -178,75 +182,117 @@ template <>
 struct EigenCastType<BFloat16> {
   using type = Eigen::bfloat16;
 };
+// the elements of large tensors are cast by the threads of the operator thread pool, fn casts [begin, end)
+template <typename SrcType, typename DstType, typename Fn>
+void ParallelCast(const OpKernelContext& context, std::ptrdiff_t shape_size, double cycles_per_element, const Fn& fn) {
+  const TensorOpCost unit_cost{static_cast<double>(sizeof(SrcType)), static_cast<double>(sizeof(DstType)),
+                               cycles_per_element};
+  concurrency::ThreadPool::TryParallelFor(context.GetOperatorThreadPool(), shape_size, unit_cost, fn);
+}
+
+// converting a string costs much more than converting a number
+constexpr double kStringCastCycles = 256.0;
+
 // generic tensor X -> Y
 template <typename SrcType, typename DstType, typename Enable = void>
 struct TensorCaster {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
     using SrcEigenCastType = typename EigenCastType<SrcType>::type;
     using DstEigenCastType = typename EigenCastType<DstType>::type;
 
     const std::ptrdiff_t shape_size = narrow<std::ptrdiff_t>(shape.Size());
-    const auto in_vector =
-        ConstEigenVectorMap<SrcEigenCastType>(reinterpret_cast<const SrcEigenCastType*>(in.Data<SrcType>()), shape_size);
-    auto out_vector =
-        EigenVectorMap<DstEigenCastType>(reinterpret_cast<DstEigenCastType*>(out.MutableData<DstType>()), shape_size);
-    out_vector = in_vector.template cast<DstEigenCastType>();
+    const auto* in_data = reinterpret_cast<const SrcEigenCastType*>(in.Data<SrcType>());
+    auto* out_data = reinterpret_cast<DstEigenCastType*>(out.MutableData<DstType>());
+    ParallelCast<SrcType, DstType>(context, shape_size, 1.0, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      const auto in_vector = ConstEigenVectorMap<SrcEigenCastType>(in_data + begin, end - begin);
+      auto out_vector = EigenVectorMap<DstEigenCastType>(out_data + begin, end - begin);
+      out_vector = in_vector.template cast<DstEigenCastType>();
+    });
   }
 };
 
 // tensor X -> string
 template <typename SrcType>
 struct TensorCaster<SrcType, std::string> {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
     const std::ptrdiff_t shape_size = narrow<std::ptrdiff_t>(shape.Size());
     const auto* in_data = in.Data<SrcType>();
     auto* out_data = out.MutableData<std::string>();
-    for (std::ptrdiff_t i = 0; i < shape_size; ++i) {
-      CastToString(in_data[i], out_data[i]);
-    }
+    ParallelCast<SrcType, std::string>(context, shape_size, kStringCastCycles,
+                                       [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                                         for (std::ptrdiff_t i = begin; i < end; ++i) {
+                                           CastToString(in_data[i], out_data[i]);
+                                         }
+                                       });
   }
 };
 
 // tensor string -> X
 template <typename DstType>
 struct TensorCaster<std::string, DstType> {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
     const std::ptrdiff_t shape_size = narrow<std::ptrdiff_t>(shape.Size());
     const auto* in_data = in.Data<std::string>();
     auto* out_data = out.MutableData<DstType>();
-    for (std::ptrdiff_t i = 0; i < shape_size; ++i) {
-      CastFromString(in_data[i], out_data[i]);
-    }
+    ParallelCast<std::string, DstType>(context, shape_size, kStringCastCycles,
+                                       [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                                         for (std::ptrdiff_t i = begin; i < end; ++i) {
+                                           CastFromString(in_data[i], out_data[i]);
+                                         }
+                                       });
   }
 };
 
 #if !defined(DISABLE_FLOAT8_TYPES)
 
+// tensor float 8 -> X, the float values of the 256 bit patterns are looked up in a table
+template <typename SrcType, typename DstType>
+struct TensorCaster<SrcType, DstType,
+                    typename std::enable_if<IsOrtFloat8Type<SrcType>::value &&
+                                            !std::is_same<DstType, std::string>::value>::type> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    const std::ptrdiff_t shape_size = narrow<std::ptrdiff_t>(shape.Size());
+    const auto* in_data = in.Data<SrcType>();
+    auto* out_data = out.MutableData<DstType>();
+    const float* table = Float8ToFloatTable<SrcType>();
+    ParallelCast<SrcType, DstType>(context, shape_size, 1.0, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      for (std::ptrdiff_t i = begin; i < end; ++i) {
+        out_data[i] = static_cast<DstType>(table[in_data[i].val]);
+      }
+    });
+  }
+};
+
 // tensor X -> float 8
 template <typename SrcType, typename DstType, typename Enable = void>
 struct TensorCasterNoSat {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
     const std::ptrdiff_t shape_size = narrow<std::ptrdiff_t>(shape.Size());
     const auto* in_data = in.Data<SrcType>();
     auto* out_data = out.MutableData<DstType>();
-    for (std::ptrdiff_t i = 0; i < shape_size; ++i) {
-      out_data[i] = DstType(static_cast<float>(in_data[i]), false);
-    }
+    ParallelCast<SrcType, DstType>(context, shape_size, 8.0, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      for (std::ptrdiff_t i = begin; i < end; ++i) {
+        out_data[i] = DstType(static_cast<float>(in_data[i]), false);
+      }
+    });
   }
 };
 
 // tensor string -> float 8
 template <typename DstType>
 struct TensorCasterNoSat<std::string, DstType> {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
     const std::ptrdiff_t shape_size = narrow<std::ptrdiff_t>(shape.Size());
     const auto* in_data = in.Data<std::string>();
     auto* out_data = out.MutableData<DstType>();
-    float float_value;
-    for (std::ptrdiff_t i = 0; i < shape_size; ++i) {
-      CastFromString(in_data[i], float_value);
-      out_data[i] = DstType(float_value, false);
-    }
+    ParallelCast<std::string, DstType>(context, shape_size, kStringCastCycles,
+                                       [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                                         float float_value;
+                                         for (std::ptrdiff_t i = begin; i < end; ++i) {
+                                           CastFromString(in_data[i], float_value);
+                                           out_data[i] = DstType(float_value, false);
+                                         }
+                                       });
   }
 };
 
@@ -259,11 +305,13 @@ struct TensorCasterNoSat<std::string, DstType> {
 // tensor MLFloat16 -> float
 template <>
 struct TensorCaster<MLFloat16, float> {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
     auto out_data = out.MutableData<float>();
     auto in_data = in.Data<MLFloat16>();
-    const size_t shape_size = narrow<size_t>(shape.Size());
-    MlasConvertHalfToFloatBuffer(&in_data[0].val, out_data, shape_size);
+    const std::ptrdiff_t shape_size = narrow<std::ptrdiff_t>(shape.Size());
+    ParallelCast<MLFloat16, float>(context, shape_size, 1.0, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      MlasConvertHalfToFloatBuffer(&in_data[begin].val, out_data + begin, static_cast<size_t>(end - begin));
+    });
   }
 };
 
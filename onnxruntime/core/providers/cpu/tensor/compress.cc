@@ -2,6 +2,11 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/compress.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 using namespace ::onnxruntime::common;
 
@@ -38,17 +43,29 @@ Status Compress::Compute(OpKernelContext* ctx) const {
   auto condition_length = condition->Shape().Size();
   auto condition_data = condition->Data<bool>();
 
-  int64_t positive_condition_count = 0;
   // if has axis, we need to compress on dimension[axis], otherwise compress on the flattened input data
   int64_t compress_input_length = has_axis_ ? input_dimensions[onnxruntime::narrow<size_t>(axis)] : input_tensor->Shape().Size();
   int64_t valid_condition_length = compress_input_length < condition_length ? compress_input_length : condition_length;
 
-  // Figure out output shape
-  for (int i = 0; i < valid_condition_length; ++i) {
-    if (condition_data[i]) {
-      ++positive_condition_count;
-    }
-  }
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  // The condition is split into blocks. The true conditions of each block are counted and their exclusive prefix sum
+  // is the index of the first output row of each block, so the blocks of every outer index are copied in parallel.
+  constexpr int64_t kBlockSize = 16 * 1024;
+  const std::ptrdiff_t num_blocks = onnxruntime::narrow<std::ptrdiff_t>((valid_condition_length + kBlockSize - 1) / kBlockSize);
+  std::vector<int64_t> block_offsets(static_cast<size_t>(num_blocks) + 1, 0);
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, num_blocks, TensorOpCost{static_cast<double>(kBlockSize), 0.0, static_cast<double>(kBlockSize)},
+      [&](std::ptrdiff_t first_block, std::ptrdiff_t last_block) {
+        for (std::ptrdiff_t block = first_block; block < last_block; ++block) {
+          const bool* begin = condition_data + block * kBlockSize;
+          const bool* end = condition_data + std::min(valid_condition_length, (block + 1) * kBlockSize);
+          block_offsets[block + 1] = std::count(begin, end, true);
+        }
+      });
+  std::partial_sum(block_offsets.begin(), block_offsets.end(), block_offsets.begin());
+
+  const int64_t positive_condition_count = block_offsets.back();
 
   std::vector<int64_t> output_dims(input_dimensions.begin(), input_dimensions.end());
   if (has_axis_) {
@@ -68,11 +85,11 @@ Status Compress::Compute(OpKernelContext* ctx) const {
   auto* output_data = static_cast<uint8_t*>(output_tensor->MutableDataRaw());
   auto element_bytes = input_tensor->DataType()->Size();
   bool is_string_type = input_tensor->IsDataTypeString();
-  int64_t output_index = 0;
 
+  // without an axis the flattened input is compressed as a single row of elements
+  int64_t axes_left_stride = 1;
+  int64_t axes_right_stride = 1;
   if (has_axis_) {
-    int64_t axes_left_stride = 1;
-    int64_t axes_right_stride = 1;
     for (int i = 0; i < axis; ++i) {
       axes_left_stride *= input_dimensions[i];
     }
@@ -80,44 +97,52 @@ Status Compress::Compute(OpKernelContext* ctx) const {
     for (auto i = static_cast<size_t>(axis + 1); i < rank; ++i) {
       axes_right_stride *= input_dimensions[i];
     }
-    int64_t axes_included_right_stride = axes_right_stride * input_dimensions[onnxruntime::narrow<size_t>(axis)];
-    int64_t axes_included_right_stride_bytes = axes_included_right_stride * element_bytes;
-    ORT_ENFORCE(axes_right_stride >= 0 &&
-                static_cast<uint64_t>(axes_right_stride) < std::numeric_limits<size_t>::max());
-    size_t axes_right_stride_bytes = 0;
-    if (!IAllocator::CalcMemSizeForArray(static_cast<size_t>(axes_right_stride), element_bytes,
-                                         &axes_right_stride_bytes))
-      return Status(ONNXRUNTIME, FAIL, "size overflow");
-    for (int i = 0; i < axes_left_stride; ++i) {
-      for (int j = 0; j < valid_condition_length; ++j) {
-        if (!condition_data[j]) {
-          continue;
-        }
-        if (is_string_type) {
-          for (int idxItem = 0; idxItem < axes_right_stride; ++idxItem) {
-            reinterpret_cast<std::string*>(output_data)[output_index + idxItem] =
-                reinterpret_cast<const std::string*>(input_data)[i * axes_included_right_stride + j * axes_right_stride + idxItem];
-          }
-          output_index += axes_right_stride;
-        } else {
-          memcpy(output_data + output_index, input_data + i * axes_included_right_stride_bytes + j * axes_right_stride_bytes, axes_right_stride_bytes);
-          output_index += axes_right_stride_bytes;
-        }
-      }
-    }
-  } else {
-    for (int i = 0; i < valid_condition_length; ++i) {
-      if (!condition_data[i]) {
+  }
+  int64_t axes_included_right_stride = axes_right_stride * compress_input_length;
+  ORT_ENFORCE(axes_right_stride >= 0 &&
+              static_cast<uint64_t>(axes_right_stride) < std::numeric_limits<size_t>::max());
+  size_t axes_right_stride_bytes = 0;
+  if (!IAllocator::CalcMemSizeForArray(static_cast<size_t>(axes_right_stride), element_bytes,
+                                       &axes_right_stride_bytes))
+    return Status(ONNXRUNTIME, FAIL, "size overflow");
+
+  // copies the slices of the true conditions of a block, a run of consecutive true conditions is copied at once
+  auto copy_block = [&](int64_t outer_index, std::ptrdiff_t block) {
+    int64_t output_index = outer_index * positive_condition_count + block_offsets[block];
+    const int64_t end = std::min(valid_condition_length, (block + 1) * kBlockSize);
+    for (int64_t j = block * kBlockSize; j < end;) {
+      if (!condition_data[j]) {
+        ++j;
         continue;
       }
+      const int64_t run_begin = j;
+      while (j < end && condition_data[j]) {
+        ++j;
+      }
+      const int64_t input_offset = outer_index * axes_included_right_stride + run_begin * axes_right_stride;
+      const int64_t count = (j - run_begin) * axes_right_stride;
       if (is_string_type) {
-        reinterpret_cast<std::string*>(output_data)[output_index] = reinterpret_cast<const std::string*>(input_data)[i];
+        const auto* src = reinterpret_cast<const std::string*>(input_data) + input_offset;
+        std::copy(src, src + count, reinterpret_cast<std::string*>(output_data) + output_index * axes_right_stride);
       } else {
-        memcpy(output_data + output_index * element_bytes, input_data + i * element_bytes, element_bytes);
+        memcpy(output_data + output_index * axes_right_stride_bytes,
+               input_data + input_offset * element_bytes,
+               (j - run_begin) * axes_right_stride_bytes);
       }
-      ++output_index;
+      output_index += j - run_begin;
     }
-  }
+  };
+
+  const double block_bytes = static_cast<double>(std::min(kBlockSize, valid_condition_length)) *
+                             static_cast<double>(axes_right_stride_bytes);
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, onnxruntime::narrow<std::ptrdiff_t>(axes_left_stride) * num_blocks,
+      TensorOpCost{block_bytes, block_bytes, block_bytes},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t index = first; index < last; ++index) {
+          copy_block(index / num_blocks, index % num_blocks);
+        }
+      });
 
   return Status::OK();
 }
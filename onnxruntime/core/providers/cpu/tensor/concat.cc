@@ -256,6 +256,13 @@ Status ConcatBase::ComputeImpl(Prepare& p, OpKernelContext* ctx) const {
   // Note that output_strides_full is only used later when is_stack_ is true, so it's safe to move
   auto output_strides_for_copy = is_stack_ ? StridesForStack(output_strides_full, p.axis) : std::move(output_strides_full);
 
+  // the slice of the output for each input is contiguous if the dims before the axis are 1. the allocation planner
+  // may have placed an input there already, in which case it does not need to be copied.
+  const bool contiguous_slices = !is_stack_ &&
+                                 p.output_tensor->Shape().SizeToDimension(onnxruntime::narrow<size_t>(p.axis)) == 1;
+  const auto* output_data = static_cast<const uint8_t*>(p.output_tensor->DataRaw());
+  const size_t element_size = p.output_tensor->DataType()->Size();
+
   for (int input_index = 0; input_index < input_count; input_index++) {
     const auto& prep = p.inputs[input_index];
 
@@ -263,16 +270,22 @@ Status ConcatBase::ComputeImpl(Prepare& p, OpKernelContext* ctx) const {
     if (prep.num_elements == 0)
       continue;
 
-    // parallel copy the data across
-    auto status = DispatchStridedCopy<EnabledDataTypes>(ctx->GetOperatorThreadPool(),
-                                                        *p.output_tensor,
-                                                        onnxruntime::narrow<ptrdiff_t>(initial_output_offset),
-                                                        output_strides_for_copy,
-                                                        prep.tensor->Shape(),
-                                                        *prep.tensor,
-                                                        0,  // src_offset
-                                                        StridesForTensor(*prep.tensor));
-    ORT_RETURN_IF_ERROR(status);
+    const bool in_place = contiguous_slices &&
+                          prep.tensor->DataRaw() ==
+                              output_data + onnxruntime::narrow<size_t>(initial_output_offset) * element_size;
+
+    if (!in_place) {
+      // parallel copy the data across
+      auto status = DispatchStridedCopy<EnabledDataTypes>(ctx->GetOperatorThreadPool(),
+                                                          *p.output_tensor,
+                                                          onnxruntime::narrow<ptrdiff_t>(initial_output_offset),
+                                                          output_strides_for_copy,
+                                                          prep.tensor->Shape(),
+                                                          *prep.tensor,
+                                                          0,  // src_offset
+                                                          StridesForTensor(*prep.tensor));
+      ORT_RETURN_IF_ERROR(status);
+    }
 
     // advance along the axis that we are concatenating on (by the size of the axis of the tensor that we just copied)
     if (is_stack_) {
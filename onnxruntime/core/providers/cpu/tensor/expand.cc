@@ -4,22 +4,30 @@
 #include "expand.h"
 #include <cmath>
 #include <core/common/safeint.h>
+#include "core/common/type_list.h"
+#include "core/providers/cpu/tensor/strided_view.h"
 
 namespace onnxruntime {
 
-#define REG_EXPAND_KERNEL(TYPE)                                                    \
-  ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                        \
-      Expand,                                                                      \
-      8,                                                                           \
-      12,                                                                          \
-      TYPE,                                                                        \
-      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
-      Expand<TYPE>);                                                               \
-  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                  \
-      Expand,                                                                      \
-      13,                                                                          \
-      TYPE,                                                                        \
-      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
+#ifdef ENABLE_STRIDED_TENSORS
+#define CREATE_EXPAND_KERNEL_DEF KernelDefBuilder().MayStridedInput(0).MayStridedOutput(0, 0)
+#else
+#define CREATE_EXPAND_KERNEL_DEF KernelDefBuilder()
+#endif
+
+#define REG_EXPAND_KERNEL(TYPE)                                                          \
+  ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                              \
+      Expand,                                                                            \
+      8,                                                                                 \
+      12,                                                                                \
+      TYPE,                                                                              \
+      CREATE_EXPAND_KERNEL_DEF.TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
+      Expand<TYPE>);                                                                     \
+  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                        \
+      Expand,                                                                            \
+      13,                                                                                \
+      TYPE,                                                                              \
+      CREATE_EXPAND_KERNEL_DEF.TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
       Expand<TYPE>);
 
 REG_EXPAND_KERNEL(float)
@@ -69,6 +77,23 @@ Status Expand<T>::Compute(OpKernelContext* context) const {
 
   TensorShape output_tensor_shape(output_shape);
   auto* output_tensor = context->Output(0, output_tensor_shape);
+
+#ifdef ENABLE_STRIDED_TENSORS
+  if (IsStridedViewCompute(*input_tensor, *output_tensor)) {
+    // the expanded dimensions of the output have a stride of 0.
+    const auto input_strides = input_tensor->Strides();
+    const size_t rank_offset = output_shape.size() - input_shape.size();
+    TensorShapeVector output_strides(output_shape.size(), 0);
+    for (size_t i = 0; i < input_shape.size(); ++i) {
+      if (input_shape[i] == output_shape[rank_offset + i]) {
+        output_strides[rank_offset + i] = input_strides[i];
+      }
+    }
+
+    return ComputeStridedView<TypeList<T>>(context->GetOperatorThreadPool(), *input_tensor, *output_tensor,
+                                           output_strides, 0);
+  }
+#endif
   auto* output_data = output_tensor->MutableData<T>();
   auto* output_dims = output_shape.data();
   auto output_dims_size = static_cast<int64_t>(output_shape.size());
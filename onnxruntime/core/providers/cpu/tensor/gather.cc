@@ -3,6 +3,7 @@
 
 // https://github.com/onnx/onnx/blob/main/docs/Operators.md#Gather
 #include "core/providers/cpu/tensor/gather.h"
+#include "core/providers/cpu/tensor/gather_rows.h"
 #include "core/common/common.h"
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
@@ -102,29 +103,43 @@ Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uin
     }
   }
 
-  auto lambda = [&](int64_t index) {
-    int64_t batch = index / N;
-    int64_t i = index % N;
+  if (is_string_type) {
+    auto lambda = [&](int64_t index) {
+      int64_t batch = index / N;
+      int64_t i = index % N;
 
-    const int64_t src_offset_batch = batch * data_batch_bytes;
-    const int64_t dst_offset_batch = batch * gathered_batch_bytes;
-    Tin idx = indices_data[i];
-    idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
-    const int64_t src_offset = src_offset_batch + idx * block_size;
-    const int64_t dst_offset = dst_offset_batch + i * block_size;
+      const int64_t src_offset_batch = batch * data_batch_bytes;
+      const int64_t dst_offset_batch = batch * gathered_batch_bytes;
+      Tin idx = indices_data[i];
+      idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
+      const int64_t src_offset = src_offset_batch + idx * block_size;
+      const int64_t dst_offset = dst_offset_batch + i * block_size;
 
-    if (is_string_type) {
       reinterpret_cast<std::string*>(dst_base)[dst_offset / element_bytes] =
           reinterpret_cast<const std::string*>(src_base)[src_offset / element_bytes];
-    } else {
-      memcpy(dst_base + dst_offset, src_base + src_offset, narrow<size_t>(block_size));
-    }
+    };
+    concurrency::ThreadPool::TryParallelFor(tp, SafeInt<ptrdiff_t>(M) * N, static_cast<double>(block_size),
+                                            [&lambda](ptrdiff_t first, ptrdiff_t last) {
+                                              for (int index = static_cast<int>(first), end = static_cast<int>(last); index < end; ++index) {
+                                                lambda(index);
+                                              }
+                                            });
+    return Status::OK();
+  }
+
+  // The gathered rows of a batch are consecutive in the output, so output row `index` is row index % N of batch
+  // index / N. A single batch (gathering along the outermost axis, e.g. an embedding lookup) skips the division.
+  auto source_offset = [&](ptrdiff_t index) -> int64_t {
+    const int64_t batch = M == 1 ? 0 : index / N;
+    const int64_t i = M == 1 ? index : index % N;
+    Tin idx = indices_data[i];
+    idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
+    return batch * data_batch_bytes + idx * block_size;
   };
   concurrency::ThreadPool::TryParallelFor(tp, SafeInt<ptrdiff_t>(M) * N, static_cast<double>(block_size),
-                                          [&lambda](ptrdiff_t first, ptrdiff_t last) {
-                                            for (int index = static_cast<int>(first), end = static_cast<int>(last); index < end; ++index) {
-                                              lambda(index);
-                                            }
+                                          [&](ptrdiff_t first, ptrdiff_t last) {
+                                            gather_rows::CopyRows(src_base, dst_base, narrow<size_t>(block_size),
+                                                                  first, last, source_offset);
                                           });
 
   return Status::OK();
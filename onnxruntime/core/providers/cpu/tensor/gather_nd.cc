@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 #include <core/common/safeint.h>
 #include "gather_nd.h"
+#include "core/providers/cpu/tensor/gather_rows.h"
 #include "core/platform/threadpool.h"
 
 namespace onnxruntime {
@@ -177,16 +178,14 @@ Status GatherND::Compute(OpKernelContext* context) const {
 }
 
 Status GatherND::GatherNumber(const Prepare& p, concurrency::ThreadPool* tp) const {
-  auto lambda = [&](int64_t slice_idx) {
-    memcpy(p.output_base + slice_idx * p.bytes_per_slice, p.input_base + p.slice_offsets[onnxruntime::narrow<size_t>(slice_idx)] * p.element_bytes,
-           onnxruntime::narrow<size_t>(p.bytes_per_slice));
+  auto source_offset = [&](ptrdiff_t slice_idx) {
+    return p.slice_offsets[onnxruntime::narrow<size_t>(slice_idx)] * p.element_bytes;
   };
   concurrency::ThreadPool::TryParallelFor(
       tp, p.slice_offsets.size(), static_cast<double>(p.bytes_per_slice),
-      [&lambda](ptrdiff_t first, ptrdiff_t last) {
-        for (int slice_idx = static_cast<int>(first), end = static_cast<int>(last); slice_idx < end; ++slice_idx) {
-          lambda(slice_idx);
-        }
+      [&](ptrdiff_t first, ptrdiff_t last) {
+        gather_rows::CopyRows(p.input_base, p.output_base, onnxruntime::narrow<size_t>(p.bytes_per_slice),
+                              first, last, source_offset);
       });
   return Status::OK();
 }
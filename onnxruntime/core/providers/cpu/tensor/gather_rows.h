@@ -0,0 +1,73 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace onnxruntime {
+namespace gather_rows {
+
+// Number of rows ahead of the copied row whose source is prefetched. The sources of gathered rows are scattered
+// over the input, typically a large embedding table, so the hardware prefetchers can't predict them.
+constexpr std::ptrdiff_t kPrefetchDistance = 8;
+
+inline void Prefetch(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+  (void)address;
+#endif
+}
+
+template <size_t RowBytes, typename SourceOffset>
+void CopyFixedSizeRows(const uint8_t* src_base, uint8_t* dst_base, std::ptrdiff_t first, std::ptrdiff_t last,
+                       const SourceOffset& source_offset) {
+  for (std::ptrdiff_t row = first; row < last; ++row) {
+    if (row + kPrefetchDistance < last) {
+      Prefetch(src_base + source_offset(row + kPrefetchDistance));
+    }
+    // a constant size lets the compiler replace the call with a load and a store
+    memcpy(dst_base + static_cast<size_t>(row) * RowBytes, src_base + source_offset(row), RowBytes);
+  }
+}
+
+// Copies rows [first, last) of row_bytes bytes to consecutive rows of dst_base. source_offset(row) returns the byte
+// offset of the source of a row from src_base. The sources of the following rows are prefetched, and rows of 1, 2,
+// 4, 8 or 16 bytes are copied without a call to memcpy.
+template <typename SourceOffset>
+void CopyRows(const uint8_t* src_base, uint8_t* dst_base, size_t row_bytes, std::ptrdiff_t first, std::ptrdiff_t last,
+              const SourceOffset& source_offset) {
+  switch (row_bytes) {
+    case 1:
+      return CopyFixedSizeRows<1>(src_base, dst_base, first, last, source_offset);
+    case 2:
+      return CopyFixedSizeRows<2>(src_base, dst_base, first, last, source_offset);
+    case 4:
+      return CopyFixedSizeRows<4>(src_base, dst_base, first, last, source_offset);
+    case 8:
+      return CopyFixedSizeRows<8>(src_base, dst_base, first, last, source_offset);
+    case 16:
+      return CopyFixedSizeRows<16>(src_base, dst_base, first, last, source_offset);
+    default:
+      break;
+  }
+
+  for (std::ptrdiff_t row = first; row < last; ++row) {
+    if (row + kPrefetchDistance < last) {
+      Prefetch(src_base + source_offset(row + kPrefetchDistance));
+    }
+    memcpy(dst_base + static_cast<size_t>(row) * row_bytes, src_base + source_offset(row), row_bytes);
+  }
+}
+
+}  // namespace gather_rows
+}  // namespace onnxruntime
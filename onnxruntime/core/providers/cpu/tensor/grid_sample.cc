@@ -3,11 +3,15 @@
 
 #include "core/providers/cpu/tensor/grid_sample.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "core/framework/element_type_lists.h"
 #include "core/framework/TensorSeq.h"
 #include "core/providers/common.h"
 #include "core/framework/copy.h"
 #include "core/providers/op_kernel_type_control.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 
@@ -90,56 +94,87 @@ void GsGetCubicCoeffs(T x, T coeffs[4]) {
   coeffs[3] = ((cubic_alpha * (2 - x) - 5 * cubic_alpha) * (2 - x) + 8 * cubic_alpha) * (2 - x) - 4 * cubic_alpha;
 }
 
+// Sampled rows, as offsets of the row start in the image, sampled columns and interpolation weights of one output
+// location. They only depend on the grid, so they are computed once for a block of output locations and used for
+// every channel. A row or column outside of the image with zeros padding is -1 and samples a zero.
+// Nearest mode uses the first entry, linear mode the first two and cubic mode all four.
 template <typename T>
-T GsBicubicInterpolate(T p[4][4], T x, T y) {
-  T v[4] = {};
-  T coeffs[4] = {};
-  GsGetCubicCoeffs(x, coeffs);
-  for (int64_t i = 0; i < 4; i++) {
-    v[i] = coeffs[0] * p[i][0] + coeffs[1] * p[i][1] + coeffs[2] * p[i][2] + coeffs[3] * p[i][3];
-  }
-  GsGetCubicCoeffs(y, coeffs);
-  return static_cast<T>(coeffs[0] * v[0] + coeffs[1] * v[1] + coeffs[2] * v[2] + coeffs[3] * v[3]);
+struct GsSamplePoint2D {
+  int64_t rows[4];
+  int64_t cols[4];
+  T wx[4];
+  T wy[4];
+};
+
+template <typename T>
+struct GsSamplePoint3D {
+  int64_t depths[2];
+  int64_t rows[2];
+  int64_t cols[2];
+  T wx[2];
+  T wy[2];
+  T wz[2];
+};
+
+template <typename T>
+inline T GsPixel(const T* image, int64_t offset, int64_t col) {
+  return (offset < 0 || col < 0) ? T{} : image[offset + col];
 }
 
 template <typename T>
-T GridSample<T>::PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, T border[/* 4 */]) const {
-  T pixel = {};  // default 0
-  if (padding_mode_ == Zeros) {
-    if (c >= 0 && c < W && r >= 0 && r < H) {
-      pixel = image[r * W + c];
-    }
-  } else if (padding_mode_ == Border) {
-    c = std::clamp<int64_t>(c, 0, W - 1);
-    r = std::clamp<int64_t>(r, 0, H - 1);
-    pixel = image[r * W + c];
-  } else {  // (padding_mode_ == Reflection)
-    c = static_cast<int64_t>(GsReflect(static_cast<T>(c), border[0], border[2]));
-    r = static_cast<int64_t>(GsReflect(static_cast<T>(r), border[1], border[3]));
-    pixel = image[r * W + c];
-  }
-  return pixel;
+inline T GsPixel(const T* image, int64_t depth, int64_t row, int64_t col) {
+  return (depth < 0 || row < 0 || col < 0) ? T{} : image[depth + row + col];
 }
 
+constexpr int64_t kGsBlockSize = 256;
+
+// Runs compute_points(n, location_begin, location_end, points) for each block of output locations of every image and
+// interpolate(n, location_begin, location_end, channel_begin, channel_end, points) for the channels of the block. The
+// channels are split as well when there are fewer blocks than threads; a thread reuses the sample points of a block
+// for its following channel ranges.
+template <typename Point, typename ComputePoints, typename Interpolate>
+void GsParallelFor(concurrency::ThreadPool* tp, int64_t N, int64_t C, int64_t locations, double cost_per_sample,
+                   const ComputePoints& compute_points, const Interpolate& interpolate) {
+  const int64_t block_size = std::min(locations, kGsBlockSize);
+  const int64_t location_blocks = (locations + block_size - 1) / block_size;
+  const int64_t spatial_units = N * location_blocks;
+  const int64_t dop = concurrency::ThreadPool::DegreeOfParallelism(tp);
+  int64_t channel_blocks = spatial_units >= dop ? 1 : std::min(C, (dop + spatial_units - 1) / spatial_units);
+  const int64_t channels_per_block = (C + channel_blocks - 1) / channel_blocks;
+  channel_blocks = (C + channels_per_block - 1) / channels_per_block;
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, onnxruntime::narrow<std::ptrdiff_t>(spatial_units * channel_blocks),
+      cost_per_sample * static_cast<double>(block_size * channels_per_block),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<Point> points(onnxruntime::narrow<size_t>(block_size));
+        int64_t computed_unit = -1;
+        for (std::ptrdiff_t unit = first; unit < last; ++unit) {
+          const int64_t spatial_unit = unit / channel_blocks;
+          const int64_t n = spatial_unit / location_blocks;
+          const int64_t location_begin = (spatial_unit % location_blocks) * block_size;
+          const int64_t location_end = std::min(location_begin + block_size, locations);
+          if (spatial_unit != computed_unit) {
+            compute_points(n, location_begin, location_end, points.data());
+            computed_unit = spatial_unit;
+          }
+          const int64_t channel_begin = (unit % channel_blocks) * channels_per_block;
+          const int64_t channel_end = std::min(channel_begin + channels_per_block, C);
+          interpolate(n, location_begin, location_end, channel_begin, channel_end, points.data());
+        }
+      });
+}
+
+// Index of row or column i of an image axis of the given length after padding, -1 for zeros padding outside of it.
 template <typename T>
-T GridSample<T>::PixelAtGrid3D(const T* image, int64_t d, int64_t h, int64_t w, int64_t D, int64_t H, int64_t W, T border[/* 6 */]) const {
-  T pixel = {};  // default 0
+int64_t GridSample<T>::PaddedIndex(int64_t i, int64_t length, T border_min, T border_max) const {
   if (padding_mode_ == Zeros) {
-    if (w >= 0 && w < W && h >= 0 && h < H && d >= 0 && d < D) {
-      pixel = image[d * H * W + h * W + w];
-    }
-  } else if (padding_mode_ == Border) {
-    w = std::clamp<int64_t>(w, 0, W - 1);
-    h = std::clamp<int64_t>(h, 0, H - 1);
-    d = std::clamp<int64_t>(d, 0, D - 1);
-    pixel = image[d * H * W + h * W + w];
-  } else {  // (padding_mode_ == Reflection)
-    w = static_cast<int64_t>(GsReflect(static_cast<T>(w), border[0], border[3]));
-    h = static_cast<int64_t>(GsReflect(static_cast<T>(h), border[1], border[4]));
-    d = static_cast<int64_t>(GsReflect(static_cast<T>(d), border[2], border[5]));
-    pixel = image[d * H * W + h * W + w];
+    return (i >= 0 && i < length) ? i : -1;
   }
-  return pixel;
+  if (padding_mode_ == Border) {
+    return std::clamp<int64_t>(i, 0, length - 1);
+  }
+  return static_cast<int64_t>(GsReflect(static_cast<T>(i), border_min, border_max));
 }
 
 // When grid sampling, padding is applied before interpolation.
@@ -201,65 +236,96 @@ Status GridSample<T>::Compute(OpKernelContext* context) const {
       y_min = 0.f;
       y_max = H_in - 1.f;
     }
-    T border[] = {x_min, y_min, x_max, y_max};  // l-t-r-b
-
-    concurrency::ThreadPool* tp = H_out * W_out > 64 ? context->GetOperatorThreadPool() : nullptr;
-    for (int64_t n = 0; n < N; n++) {
-      const T* grid_data = grid->Data<T>() + n * (H_out * W_out) * 2;
-      concurrency::ThreadPool::TrySimpleParallelFor(
-          tp, onnxruntime::narrow<std::ptrdiff_t>(C),
-          [&](std::ptrdiff_t c) {
-            const T* X_data = input->Data<T>() + (n * C + c) * (H_in * W_in);
-            T* Y_data = Y.MutableData<T>() + (n * C + c) * (H_out * W_out);
-
-            for (int64_t oy = 0; oy < H_out; oy++) {
-              for (int64_t ox = 0; ox < W_out; ox++) {
-                const T* gridpoint = grid_data + (oy * W_out + ox) * 2;
-                T* Y_gridpoint = Y_data + oy * W_out + ox;
-                auto nx = gridpoint[0];  // normalized location
-                auto ny = gridpoint[1];
-                auto x = GsDenormalize<T>(nx, W_in, align_corners_);  // actual location
-                auto y = GsDenormalize<T>(ny, H_in, align_corners_);
-
-                if (mode_ == Nearest) {
-                  x = static_cast<T>(std::nearbyint(static_cast<T>(x)));
-                  y = static_cast<T>(std::nearbyint(static_cast<T>(y)));
-                  // x, y are integers in all padding modes
-                  *Y_gridpoint = PixelAtGrid(X_data, static_cast<int64_t>(y), static_cast<int64_t>(x), H_in, W_in, border);
-                } else if (mode_ == Linear) {
-                  int64_t x1 = static_cast<int64_t>(std::floor(x));
-                  int64_t y1 = static_cast<int64_t>(std::floor(y));
-                  int64_t x2 = x1 + 1;
-                  int64_t y2 = y1 + 1;
-
-                  T p11 = PixelAtGrid(X_data, y1, x1, H_in, W_in, border);
-                  T p12 = PixelAtGrid(X_data, y1, x2, H_in, W_in, border);
-                  T p21 = PixelAtGrid(X_data, y2, x1, H_in, W_in, border);
-                  T p22 = PixelAtGrid(X_data, y2, x2, H_in, W_in, border);
-
-                  T dx2 = static_cast<T>(x2) - x;
-                  T dx1 = x - static_cast<T>(x1);
-                  T dy2 = static_cast<T>(y2) - y;
-                  T dy1 = y - static_cast<T>(y1);
-                  *Y_gridpoint = dy2 * (dx2 * p11 + dx1 * p12) + dy1 * (dx2 * p21 + dx1 * p22);
-                } else if (mode_ == Cubic) {
-                  int64_t x0 = static_cast<int64_t>(std::floor(x)) - 1;  // top-left corner of the bbox
-                  int64_t y0 = static_cast<int64_t>(std::floor(y)) - 1;
-
-                  T p[4][4] = {};  // [H][W]
-                  for (int64_t h = 0; h < 4; h++) {
-                    for (int64_t w = 0; w < 4; w++) {
-                      p[h][w] = PixelAtGrid(X_data, h + y0, w + x0, H_in, W_in, border);
-                    }
-                  }
-                  T dx = static_cast<T>(x - x0 - 1);
-                  T dy = static_cast<T>(y - y0 - 1);
-                  *Y_gridpoint = GsBicubicInterpolate(p, dx, dy);
-                }
-              }
+
+    const T* input_data = input->Data<T>();
+    const T* grid_data = grid->Data<T>();
+    T* output_data = Y.MutableData<T>();
+    const int64_t locations = H_out * W_out;
+
+    auto compute_points = [&](int64_t n, int64_t location_begin, int64_t location_end,
+                              GsSamplePoint2D<T>* points) {
+      auto row_offset = [&](int64_t r) {
+        const int64_t row = PaddedIndex(r, H_in, y_min, y_max);
+        return row < 0 ? row : row * W_in;
+      };
+      for (int64_t l = location_begin; l < location_end; l++) {
+        const T* gridpoint = grid_data + (n * locations + l) * 2;
+        auto& point = points[l - location_begin];
+        auto x = GsDenormalize<T>(gridpoint[0], W_in, align_corners_);  // actual location
+        auto y = GsDenormalize<T>(gridpoint[1], H_in, align_corners_);
+
+        if (mode_ == Nearest) {
+          // x, y are integers in all padding modes
+          x = static_cast<T>(std::nearbyint(static_cast<T>(x)));
+          y = static_cast<T>(std::nearbyint(static_cast<T>(y)));
+          point.rows[0] = row_offset(static_cast<int64_t>(y));
+          point.cols[0] = PaddedIndex(static_cast<int64_t>(x), W_in, x_min, x_max);
+        } else if (mode_ == Linear) {
+          int64_t x1 = static_cast<int64_t>(std::floor(x));
+          int64_t y1 = static_cast<int64_t>(std::floor(y));
+          int64_t x2 = x1 + 1;
+          int64_t y2 = y1 + 1;
+          point.rows[0] = row_offset(y1);
+          point.rows[1] = row_offset(y2);
+          point.cols[0] = PaddedIndex(x1, W_in, x_min, x_max);
+          point.cols[1] = PaddedIndex(x2, W_in, x_min, x_max);
+          point.wx[0] = static_cast<T>(x2) - x;
+          point.wx[1] = x - static_cast<T>(x1);
+          point.wy[0] = static_cast<T>(y2) - y;
+          point.wy[1] = y - static_cast<T>(y1);
+        } else if (mode_ == Cubic) {
+          int64_t x0 = static_cast<int64_t>(std::floor(x)) - 1;  // top-left corner of the bbox
+          int64_t y0 = static_cast<int64_t>(std::floor(y)) - 1;
+          for (int64_t i = 0; i < 4; i++) {
+            point.rows[i] = row_offset(y0 + i);
+            point.cols[i] = PaddedIndex(x0 + i, W_in, x_min, x_max);
+          }
+          GsGetCubicCoeffs(static_cast<T>(x - x0 - 1), point.wx);
+          GsGetCubicCoeffs(static_cast<T>(y - y0 - 1), point.wy);
+        }
+      }
+    };
+
+    auto interpolate = [&](int64_t n, int64_t location_begin, int64_t location_end, int64_t channel_begin,
+                           int64_t channel_end, const GsSamplePoint2D<T>* points) {
+      for (int64_t c = channel_begin; c < channel_end; c++) {
+        const T* X_data = input_data + (n * C + c) * (H_in * W_in);
+        T* Y_data = output_data + (n * C + c) * locations;
+        const GsSamplePoint2D<T>* point = points;
+
+        if (mode_ == Nearest) {
+          for (int64_t l = location_begin; l < location_end; l++, point++) {
+            Y_data[l] = GsPixel(X_data, point->rows[0], point->cols[0]);
+          }
+        } else if (mode_ == Linear) {
+          for (int64_t l = location_begin; l < location_end; l++, point++) {
+            T p11 = GsPixel(X_data, point->rows[0], point->cols[0]);
+            T p12 = GsPixel(X_data, point->rows[0], point->cols[1]);
+            T p21 = GsPixel(X_data, point->rows[1], point->cols[0]);
+            T p22 = GsPixel(X_data, point->rows[1], point->cols[1]);
+            const T* wx = point->wx;
+            const T* wy = point->wy;
+            Y_data[l] = wy[0] * (wx[0] * p11 + wx[1] * p12) + wy[1] * (wx[0] * p21 + wx[1] * p22);
+          }
+        } else if (mode_ == Cubic) {
+          for (int64_t l = location_begin; l < location_end; l++, point++) {
+            const T* wx = point->wx;
+            const T* wy = point->wy;
+            T v[4] = {};
+            for (int64_t h = 0; h < 4; h++) {
+              const int64_t row = point->rows[h];
+              v[h] = wx[0] * GsPixel(X_data, row, point->cols[0]) + wx[1] * GsPixel(X_data, row, point->cols[1]) +
+                     wx[2] * GsPixel(X_data, row, point->cols[2]) + wx[3] * GsPixel(X_data, row, point->cols[3]);
             }
-          });
-    }
+            Y_data[l] = static_cast<T>(wy[0] * v[0] + wy[1] * v[1] + wy[2] * v[2] + wy[3] * v[3]);
+          }
+        }
+      }
+    };
+
+    const double cost_per_sample = mode_ == Nearest ? 2.0 : (mode_ == Linear ? 8.0 : 32.0);
+    GsParallelFor<GsSamplePoint2D<T>>(context->GetOperatorThreadPool(), N, C, locations, cost_per_sample,
+                                      compute_points, interpolate);
   } else if (data_dims == 3) {
     // sample 3d;
     auto D_in = input_dims[2];
@@ -290,70 +356,99 @@ Status GridSample<T>::Compute(OpKernelContext* context) const {
       z_min = 0.f;
       z_max = D_in - 1.f;
     }
-    T border[] = {x_min, y_min, z_min, x_max, y_max, z_max};
-
-    concurrency::ThreadPool* tp = D_out * H_out * W_out > 64 ? context->GetOperatorThreadPool() : nullptr;
-    for (int64_t n = 0; n < N; n++) {
-      const T* grid_data = grid->Data<T>() + n * (D_out * H_out * W_out) * 3;
-      concurrency::ThreadPool::TrySimpleParallelFor(
-          tp, onnxruntime::narrow<std::ptrdiff_t>(C),
-          [&](std::ptrdiff_t c) {
-            const T* X_data = input->Data<T>() + (n * C + c) * (D_in * H_in * W_in);
-            T* Y_data = Y.MutableData<T>() + (n * C + c) * (D_out * H_out * W_out);
-
-            for (int64_t oz = 0; oz < D_out; oz++) {
-              for (int64_t oy = 0; oy < H_out; oy++) {
-                for (int64_t ox = 0; ox < W_out; ox++) {
-                  const T* gridpoint = grid_data + (oz * H_out * W_out + oy * W_out + ox) * 3;
-                  T* Y_gridpoint = Y_data + oz * H_out * W_out + oy * W_out + ox;
-                  auto nx = gridpoint[0];  // normalized location
-                  auto ny = gridpoint[1];
-                  auto nz = gridpoint[2];
-                  auto x = GsDenormalize<T>(nx, W_in, align_corners_);  // actual location
-                  auto y = GsDenormalize<T>(ny, H_in, align_corners_);
-                  auto z = GsDenormalize<T>(nz, D_in, align_corners_);
-
-                  if (mode_ == Nearest) {
-                    x = static_cast<T>(std::nearbyint(static_cast<T>(x)));
-                    y = static_cast<T>(std::nearbyint(static_cast<T>(y)));
-                    z = static_cast<T>(std::nearbyint(static_cast<T>(z)));
-
-                    // x, y are integers in all padding modes
-                    *Y_gridpoint = PixelAtGrid3D(X_data, static_cast<int64_t>(z), static_cast<int64_t>(y), static_cast<int64_t>(x),
-                                                 D_in, H_in, W_in, border);
-                  } else if (mode_ == Linear) {
-                    int64_t x1 = static_cast<int64_t>(std::floor(x));
-                    int64_t y1 = static_cast<int64_t>(std::floor(y));
-                    int64_t z1 = static_cast<int64_t>(std::floor(z));
-                    int64_t x2 = x1 + 1;
-                    int64_t y2 = y1 + 1;
-                    int64_t z2 = z1 + 1;
-
-                    T dx2 = static_cast<T>(x2) - x;
-                    T dx1 = x - static_cast<T>(x1);
-                    T dy2 = static_cast<T>(y2) - y;
-                    T dy1 = y - static_cast<T>(y1);
-                    T dz2 = static_cast<T>(z2) - z;
-                    T dz1 = z - static_cast<T>(z1);
-
-                    T p111 = PixelAtGrid3D(X_data, z1, y1, x1, D_in, H_in, W_in, border);
-                    T p112 = PixelAtGrid3D(X_data, z1, y1, x2, D_in, H_in, W_in, border);
-                    T p121 = PixelAtGrid3D(X_data, z1, y2, x1, D_in, H_in, W_in, border);
-                    T p122 = PixelAtGrid3D(X_data, z1, y2, x2, D_in, H_in, W_in, border);
-                    T Y_gridpoint_z1 = dy2 * (dx2 * p111 + dx1 * p112) + dy1 * (dx2 * p121 + dx1 * p122);
-
-                    T p211 = PixelAtGrid3D(X_data, z2, y1, x1, D_in, H_in, W_in, border);
-                    T p212 = PixelAtGrid3D(X_data, z2, y1, x2, D_in, H_in, W_in, border);
-                    T p221 = PixelAtGrid3D(X_data, z2, y2, x1, D_in, H_in, W_in, border);
-                    T p222 = PixelAtGrid3D(X_data, z2, y2, x2, D_in, H_in, W_in, border);
-                    T Y_gridpoint_z2 = dy2 * (dx2 * p211 + dx1 * p212) + dy1 * (dx2 * p221 + dx1 * p222);
-                    *Y_gridpoint = dz2 * Y_gridpoint_z1 + dz1 * Y_gridpoint_z2;
-                  }
-                }
-              }
-            }
-          });
-    }
+
+    const T* input_data = input->Data<T>();
+    const T* grid_data = grid->Data<T>();
+    T* output_data = Y.MutableData<T>();
+    const int64_t locations = D_out * H_out * W_out;
+
+    auto compute_points = [&](int64_t n, int64_t location_begin, int64_t location_end,
+                              GsSamplePoint3D<T>* points) {
+      auto depth_offset = [&](int64_t d) {
+        const int64_t depth = PaddedIndex(d, D_in, z_min, z_max);
+        return depth < 0 ? depth : depth * H_in * W_in;
+      };
+      auto row_offset = [&](int64_t r) {
+        const int64_t row = PaddedIndex(r, H_in, y_min, y_max);
+        return row < 0 ? row : row * W_in;
+      };
+      for (int64_t l = location_begin; l < location_end; l++) {
+        const T* gridpoint = grid_data + (n * locations + l) * 3;
+        auto& point = points[l - location_begin];
+        auto x = GsDenormalize<T>(gridpoint[0], W_in, align_corners_);  // actual location
+        auto y = GsDenormalize<T>(gridpoint[1], H_in, align_corners_);
+        auto z = GsDenormalize<T>(gridpoint[2], D_in, align_corners_);
+
+        if (mode_ == Nearest) {
+          // x, y, z are integers in all padding modes
+          x = static_cast<T>(std::nearbyint(static_cast<T>(x)));
+          y = static_cast<T>(std::nearbyint(static_cast<T>(y)));
+          z = static_cast<T>(std::nearbyint(static_cast<T>(z)));
+          point.depths[0] = depth_offset(static_cast<int64_t>(z));
+          point.rows[0] = row_offset(static_cast<int64_t>(y));
+          point.cols[0] = PaddedIndex(static_cast<int64_t>(x), W_in, x_min, x_max);
+        } else if (mode_ == Linear) {
+          int64_t x1 = static_cast<int64_t>(std::floor(x));
+          int64_t y1 = static_cast<int64_t>(std::floor(y));
+          int64_t z1 = static_cast<int64_t>(std::floor(z));
+          int64_t x2 = x1 + 1;
+          int64_t y2 = y1 + 1;
+          int64_t z2 = z1 + 1;
+          point.depths[0] = depth_offset(z1);
+          point.depths[1] = depth_offset(z2);
+          point.rows[0] = row_offset(y1);
+          point.rows[1] = row_offset(y2);
+          point.cols[0] = PaddedIndex(x1, W_in, x_min, x_max);
+          point.cols[1] = PaddedIndex(x2, W_in, x_min, x_max);
+          point.wx[0] = static_cast<T>(x2) - x;
+          point.wx[1] = x - static_cast<T>(x1);
+          point.wy[0] = static_cast<T>(y2) - y;
+          point.wy[1] = y - static_cast<T>(y1);
+          point.wz[0] = static_cast<T>(z2) - z;
+          point.wz[1] = z - static_cast<T>(z1);
+        }
+      }
+    };
+
+    auto interpolate = [&](int64_t n, int64_t location_begin, int64_t location_end, int64_t channel_begin,
+                           int64_t channel_end, const GsSamplePoint3D<T>* points) {
+      for (int64_t c = channel_begin; c < channel_end; c++) {
+        const T* X_data = input_data + (n * C + c) * (D_in * H_in * W_in);
+        T* Y_data = output_data + (n * C + c) * locations;
+        const GsSamplePoint3D<T>* point = points;
+
+        if (mode_ == Nearest) {
+          for (int64_t l = location_begin; l < location_end; l++, point++) {
+            Y_data[l] = GsPixel(X_data, point->depths[0], point->rows[0], point->cols[0]);
+          }
+        } else if (mode_ == Linear) {
+          for (int64_t l = location_begin; l < location_end; l++, point++) {
+            const int64_t* d = point->depths;
+            const int64_t* r = point->rows;
+            const int64_t* w = point->cols;
+            const T* wx = point->wx;
+            const T* wy = point->wy;
+
+            T p111 = GsPixel(X_data, d[0], r[0], w[0]);
+            T p112 = GsPixel(X_data, d[0], r[0], w[1]);
+            T p121 = GsPixel(X_data, d[0], r[1], w[0]);
+            T p122 = GsPixel(X_data, d[0], r[1], w[1]);
+            T Y_gridpoint_z1 = wy[0] * (wx[0] * p111 + wx[1] * p112) + wy[1] * (wx[0] * p121 + wx[1] * p122);
+
+            T p211 = GsPixel(X_data, d[1], r[0], w[0]);
+            T p212 = GsPixel(X_data, d[1], r[0], w[1]);
+            T p221 = GsPixel(X_data, d[1], r[1], w[0]);
+            T p222 = GsPixel(X_data, d[1], r[1], w[1]);
+            T Y_gridpoint_z2 = wy[0] * (wx[0] * p211 + wx[1] * p212) + wy[1] * (wx[0] * p221 + wx[1] * p222);
+            Y_data[l] = point->wz[0] * Y_gridpoint_z1 + point->wz[1] * Y_gridpoint_z2;
+          }
+        }
+      }
+    };
+
+    const double cost_per_sample = mode_ == Nearest ? 2.0 : 16.0;
+    GsParallelFor<GsSamplePoint3D<T>>(context->GetOperatorThreadPool(), N, C, locations, cost_per_sample,
+                                      compute_points, interpolate);
   } else {
     // shall not reach here due to above checks
     return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Only support GirdSample in 4-D or 5-D cases.");
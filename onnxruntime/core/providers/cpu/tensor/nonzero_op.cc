@@ -3,10 +3,13 @@
 
 #include "core/providers/cpu/tensor/nonzero_op.h"
 
+#include <algorithm>
 #include <cassert>
+#include <numeric>
 #include <vector>
-#include <core/common/safeint.h>
-#include "core/util/math_cpuonly.h"
+
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/tensor/utils.h"
 
 namespace onnxruntime {
 // kernel builder functions
@@ -59,59 +62,91 @@ Status NonZero<T>::Compute(OpKernelContext* context) const {
   const auto& X_shape = X->Shape();
   assert(X_shape.Size() >= 0);
 
-  const Eigen::Index coordinate_size = X_shape.IsScalar() ? 1 : onnxruntime::narrow<Eigen::Index>(X_shape.NumDimensions());
-  std::vector<int64_t> non_zero_indices_buffer{};
-  // reserve enough space for indices for every element of X
-  non_zero_indices_buffer.reserve(SafeInt<size_t>(X_shape.Size()) * coordinate_size);
-
+  const std::ptrdiff_t coordinate_size = X_shape.IsScalar() ? 1 : onnxruntime::narrow<std::ptrdiff_t>(X_shape.NumDimensions());
+  const std::ptrdiff_t size = onnxruntime::narrow<std::ptrdiff_t>(X_shape.Size());
   const T* data = X->Data<T>();
-
-  if (X_shape.IsScalar()) {
-    const T& value = *data;
-    if (value != T{}) {
-      non_zero_indices_buffer.push_back(0);
-    }
-  } else {
-    std::vector<int64_t> coordinate(coordinate_size, 0);
-
-    // as we iterate the entries, increment the coordinate for the current entry
-    // e.g. if shape is {2,2}, we start with 0,0 increment to 0,1 increment to 1,0 and finally 1,1
-    auto increment_coordinate = [&coordinate, &coordinate_size, &X_shape]() {
-      for (Eigen::Index idx = coordinate_size - 1; idx >= 0; --idx) {
-        int64_t& cur_coord = coordinate[idx];
-        if (cur_coord != X_shape[idx] - 1) {
-          ++cur_coord;
-          break;
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  // The non-zero values of each block of elements are counted, the number of non-zero values before each block is
+  // the exclusive prefix sum of the counts, and each block then writes the coordinates of its non-zero values
+  // straight into the output.
+  constexpr std::ptrdiff_t kBlockSize = 16 * 1024;
+  const std::ptrdiff_t num_blocks = (size + kBlockSize - 1) / kBlockSize;
+  const TensorOpCost block_cost{static_cast<double>(kBlockSize * sizeof(T)), 0.0, static_cast<double>(kBlockSize)};
+
+  std::vector<int64_t> block_offsets(static_cast<size_t>(num_blocks) + 1, 0);
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, num_blocks, block_cost, [&](std::ptrdiff_t first_block, std::ptrdiff_t last_block) {
+        for (std::ptrdiff_t block = first_block; block < last_block; ++block) {
+          const T* begin = data + block * kBlockSize;
+          const T* end = data + std::min(size, (block + 1) * kBlockSize);
+          block_offsets[block + 1] = std::count_if(begin, end, [](const T& value) { return value != T{}; });
         }
-        cur_coord = 0;
-      }
-    };
-
-    for (size_t i = 0, end = onnxruntime::narrow<size_t>(X_shape.Size()); i < end; ++i) {
-      const T& value = *data++;
-      if (value != T{}) {
-        non_zero_indices_buffer.insert(non_zero_indices_buffer.end(),
-                                       coordinate.begin(), coordinate.end());
-      }
-
-      increment_coordinate();
-    }
-  }
-
-  const Eigen::Index num_non_zero_values = onnxruntime::narrow<Eigen::Index>(non_zero_indices_buffer.size()) / coordinate_size;
+      });
+  std::partial_sum(block_offsets.begin(), block_offsets.end(), block_offsets.begin());
 
-  // transpose result for output
-  ConstEigenMatrixMapRowMajor<int64_t> non_zero_indices_matrix{
-      non_zero_indices_buffer.data(),
-      num_non_zero_values, coordinate_size};
+  const int64_t num_non_zero_values = block_offsets.back();
 
   Tensor* const Y = context->Output(0, {coordinate_size, num_non_zero_values});
   ORT_ENFORCE(Y, "failed to get first output!");
 
-  EigenMatrixMapRowMajor<int64_t> y_matrix{
-      Y->MutableData<int64_t>(),
-      coordinate_size, num_non_zero_values};
-  y_matrix = non_zero_indices_matrix.transpose();
+  if (num_non_zero_values == 0) {
+    return Status::OK();
+  }
+
+  int64_t* y_data = Y->MutableData<int64_t>();
+
+  if (X_shape.IsScalar()) {
+    *y_data = 0;
+    return Status::OK();
+  }
+
+  const TensorPitches pitches(X_shape);
+
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, num_blocks, block_cost, [&](std::ptrdiff_t first_block, std::ptrdiff_t last_block) {
+        std::vector<int64_t> coordinate(coordinate_size);
+
+        // as we iterate the entries, increment the coordinate for the current entry
+        // e.g. if shape is {2,2}, we start with 0,0 increment to 0,1 increment to 1,0 and finally 1,1
+        auto increment_coordinate = [&coordinate, coordinate_size, &X_shape]() {
+          for (std::ptrdiff_t idx = coordinate_size - 1; idx >= 0; --idx) {
+            int64_t& cur_coord = coordinate[idx];
+            if (cur_coord != X_shape[idx] - 1) {
+              ++cur_coord;
+              break;
+            }
+            cur_coord = 0;
+          }
+        };
+
+        for (std::ptrdiff_t block = first_block; block < last_block; ++block) {
+          int64_t position = block_offsets[block];
+          if (position == block_offsets[block + 1]) {
+            continue;
+          }
+
+          const std::ptrdiff_t begin = block * kBlockSize;
+          const std::ptrdiff_t end = std::min(size, begin + kBlockSize);
+
+          int64_t remainder = begin;
+          for (std::ptrdiff_t idx = 0; idx < coordinate_size; ++idx) {
+            coordinate[idx] = remainder / pitches[idx];
+            remainder %= pitches[idx];
+          }
+
+          for (std::ptrdiff_t i = begin; i < end; ++i) {
+            if (data[i] != T{}) {
+              for (std::ptrdiff_t idx = 0; idx < coordinate_size; ++idx) {
+                y_data[idx * num_non_zero_values + position] = coordinate[idx];
+              }
+              ++position;
+            }
+
+            increment_coordinate();
+          }
+        }
+      });
 
   return Status::OK();
 }
@@ -3,6 +3,9 @@
 
 #include "core/providers/cpu/tensor/scatter_nd.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/platform/threadpool.h"
@@ -396,11 +399,45 @@ struct ScatterNDDispatchTarget {
         } break;
       }
     };
+
+    const auto& element_offsets = prepare.element_offsets;
+    if (reduction == ScatterND::Reduction::None || element_offsets.size() < 2) {
+      concurrency::ThreadPool::TryParallelFor(
+          tp, element_offsets.size(), static_cast<double>(prepare.element_to_copy),
+          [&lambda](ptrdiff_t first, ptrdiff_t last) {
+            for (int i = static_cast<int>(first), end = static_cast<int>(last); i < end; ++i) {
+              lambda(i);
+            }
+          });
+      return Status::OK();
+    }
+
+    // Updates of the same slice are reduced by one thread in the order of the indices, as parallel updates of a
+    // duplicated index would race. Visiting the updates in the order of their destination also keeps the writes of
+    // large scattered outputs (e.g. embedding gradients) local.
+    std::vector<size_t> order(element_offsets.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&element_offsets](size_t lhs, size_t rhs) {
+      return element_offsets[lhs] < element_offsets[rhs];
+    });
+
+    std::vector<size_t> run_starts;
+    for (size_t i = 0; i < order.size(); ++i) {
+      if (i == 0 || element_offsets[order[i]] != element_offsets[order[i - 1]]) {
+        run_starts.push_back(i);
+      }
+    }
+    run_starts.push_back(order.size());
+
+    const auto run_count = static_cast<std::ptrdiff_t>(run_starts.size() - 1);
+    const double cost = static_cast<double>(prepare.element_to_copy) * static_cast<double>(order.size()) /
+                        static_cast<double>(run_count);
     concurrency::ThreadPool::TryParallelFor(
-        tp, prepare.element_offsets.size(), static_cast<double>(prepare.element_to_copy),
-        [&lambda](ptrdiff_t first, ptrdiff_t last) {
-          for (int i = static_cast<int>(first), end = static_cast<int>(last); i < end; ++i) {
-            lambda(i);
+        tp, run_count, cost,
+        [&](ptrdiff_t first, ptrdiff_t last) {
+          for (size_t k = run_starts[static_cast<size_t>(first)], end = run_starts[static_cast<size_t>(last)];
+               k < end; ++k) {
+            lambda(static_cast<int64_t>(order[k]));
           }
         });
     return Status::OK();
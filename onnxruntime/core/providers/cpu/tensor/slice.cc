@@ -11,6 +11,7 @@
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/tensor/slice_helper.h"
+#include "core/providers/cpu/tensor/strided_view.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/op_kernel_type_control.h"
 
@@ -39,16 +40,22 @@ using EnabledIndicesTypes = ORT_OP_KERNEL_ARG_ENABLED_TYPE_LIST_ALL_OPSETS(kCpuE
                                                                            Slice, Input, 1);
 }  // namespace
 
+#ifdef ENABLE_STRIDED_TENSORS
+#define CREATE_SLICE_KERNEL_DEF KernelDefBuilder().MayStridedInput(0).MayStridedOutput(0, 0)
+#else
+#define CREATE_SLICE_KERNEL_DEF KernelDefBuilder()
+#endif
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     1, 9,
-    KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
+    CREATE_SLICE_KERNEL_DEF.TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
     Slice1);
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     10, 10,
-    KernelDefBuilder()
+    CREATE_SLICE_KERNEL_DEF
         .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
         .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
     Slice10);
@@ -57,7 +64,7 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     11,
     12,
-    KernelDefBuilder()
+    CREATE_SLICE_KERNEL_DEF
         .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
         .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
     Slice10);
@@ -65,7 +72,7 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
 ONNX_CPU_OPERATOR_KERNEL(
     Slice,
     13,
-    KernelDefBuilder()
+    CREATE_SLICE_KERNEL_DEF
         .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
         .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
     Slice10);
@@ -277,7 +284,7 @@ static inline bool CallSliceImplIfEnabled(OpKernelContext* ctx,
   return enabled;
 }
 
-Status SliceBase::Compute(OpKernelContext* ctx) const {
+Status SliceBase::Compute(OpKernelContext* ctx, const ComputeCache& compute_cache) const {
   const auto* input_tensor_ptr = ctx->Input<Tensor>(0);
   const auto& input_tensor = *input_tensor_ptr;
   const auto input_dimensions = input_tensor.Shape().GetDims();
@@ -288,23 +295,88 @@ Status SliceBase::Compute(OpKernelContext* ctx) const {
 
   SliceOp::PrepareForComputeMetadata compute_metadata(input_dimensions);
 
+  TensorShapeVector input_starts;
+  TensorShapeVector input_ends;
+  TensorShapeVector input_axes;
+  TensorShapeVector input_steps;
+
+  // the attributes are the same in every Run, the inputs are part of the key
+  ComputeCache::Key key;
+  ComputeCache::AppendToKey(input_dimensions, key);
+
   // Slice V10 & DynamicSlice
   if (dynamic_) {
-    TensorShapeVector input_starts;
-    TensorShapeVector input_ends;
-    TensorShapeVector input_axes;
-    TensorShapeVector input_steps;
     ORT_RETURN_IF_ERROR(FillVectorsFromInput(*ctx->Input<Tensor>(1), *ctx->Input<Tensor>(2),
                                              ctx->Input<Tensor>(3), ctx->Input<Tensor>(4),
                                              input_starts, input_ends,
                                              input_axes, input_steps));
+    ComputeCache::AppendToKey(input_starts, key);
+    ComputeCache::AppendToKey(input_ends, key);
+    ComputeCache::AppendToKey(input_axes, key);
+    ComputeCache::AppendToKey(input_steps, key);
+  }
+
+  CachedComputeMetadata cached;
+  if (compute_cache.Find(key, cached)) {
+    compute_metadata.starts_ = std::move(cached.starts);
+    compute_metadata.ends_ = std::move(cached.ends);
+    compute_metadata.steps_ = std::move(cached.steps);
+    compute_metadata.output_dims_ = std::move(cached.output_dims);
+    if (cached.flattened) {
+      compute_metadata.flattened_input_dims_ = std::move(cached.flattened_input_dims);
+      compute_metadata.flattened_output_dims_ = std::move(cached.flattened_output_dims);
+    } else {
+      compute_metadata.p_flattened_input_dims_ = nullptr;
+      compute_metadata.p_flattened_output_dims_ = nullptr;
+    }
+  } else {
+    // Slice V10 & DynamicSlice
+    if (dynamic_) {
+      ORT_RETURN_IF_ERROR(PrepareForCompute(input_starts, input_ends, input_axes, input_steps, compute_metadata));
+    }
+    // Slice V1-9
+    else {
+      ORT_RETURN_IF_ERROR(PrepareForCompute(attr_starts_, attr_ends_, attr_axes_, compute_metadata));
+    }
 
-    ORT_RETURN_IF_ERROR(PrepareForCompute(input_starts, input_ends, input_axes, input_steps, compute_metadata));
+    cached.starts = compute_metadata.starts_;
+    cached.ends = compute_metadata.ends_;
+    cached.steps = compute_metadata.steps_;
+    cached.output_dims = compute_metadata.output_dims_;
+    cached.flattened = compute_metadata.p_flattened_input_dims_ != nullptr;
+    cached.flattened_input_dims = compute_metadata.flattened_input_dims_;
+    cached.flattened_output_dims = compute_metadata.flattened_output_dims_;
+    compute_cache.Insert(std::move(key), std::move(cached));
   }
-  // Slice V1-9
-  else {
-    ORT_RETURN_IF_ERROR(PrepareForCompute(attr_starts_, attr_ends_, attr_axes_, compute_metadata));
+
+#ifdef ENABLE_STRIDED_TENSORS
+  auto& output_tensor = *ctx->Output(0, TensorShape(compute_metadata.output_dims_));
+  if (IsStridedViewCompute(input_tensor, output_tensor)) {
+    // the starts and steps of the compute metadata are for the flattened dimensions of a contiguous input.
+    SliceOp::PrepareForComputeMetadata view_metadata(input_dimensions);
+    if (dynamic_) {
+      ORT_RETURN_IF_ERROR(SliceOp::PrepareForComputeHelper(input_starts, input_ends, input_axes, input_steps,
+                                                           view_metadata));
+    } else {
+      ORT_RETURN_IF_ERROR(SliceOp::PrepareForComputeHelper(attr_starts_, attr_ends_, attr_axes_, view_metadata));
+    }
+
+    // the output is the input starting at the first element of the slice, with the strides scaled by the steps.
+    // a negative step reverses the dimension.
+    const auto input_strides = input_tensor.Strides();
+    TensorShapeVector output_strides(input_dimensions.size());
+    std::ptrdiff_t offset = 0;
+    for (size_t i = 0; i < input_dimensions.size(); ++i) {
+      output_strides[i] = view_metadata.steps_[i] * input_strides[i];
+      if (output_tensor.Shape().Size() != 0) {
+        offset += narrow<std::ptrdiff_t>(view_metadata.starts_[i] * input_strides[i]);
+      }
+    }
+
+    return ComputeStridedView<EnabledDataTypes>(ctx->GetOperatorThreadPool(), input_tensor, output_tensor,
+                                                output_strides, offset);
   }
+#endif
 
   Status status = Status::OK();
 
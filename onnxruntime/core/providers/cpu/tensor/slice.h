@@ -4,6 +4,7 @@
 
 #ifndef SHARED_PROVIDER
 #include "core/common/common.h"
+#include "core/framework/kernel_shape_cache.h"
 #include "core/framework/op_kernel.h"
 #include "core/util/math_cpuonly.h"
 #endif
@@ -56,7 +57,21 @@ class SliceBase {
     }
   }
 
-  Status Compute(OpKernelContext* context) const;
+#ifndef SHARED_PROVIDER
+  // What PrepareForCompute derives from the input dims and the starts, ends, axes and steps, cached across Runs.
+  struct CachedComputeMetadata {
+    TensorShapeVector starts;
+    TensorShapeVector ends;
+    TensorShapeVector steps;
+    TensorShapeVector output_dims;
+    bool flattened = false;
+    TensorShapeVector flattened_input_dims;
+    TensorShapeVector flattened_output_dims;
+  };
+  using ComputeCache = KernelShapeCache<CachedComputeMetadata>;
+
+  Status Compute(OpKernelContext* context, const ComputeCache& compute_cache) const;
+#endif
 
  protected:
   gsl::span<const int64_t> StartsAttribute() const { return attr_starts_; }
@@ -68,14 +83,22 @@ class SliceBase {
   std::vector<int64_t> attr_starts_, attr_ends_, attr_axes_;
 };
 
+#ifndef SHARED_PROVIDER
 struct Slice1 final : public OpKernel, public SliceBase {
   Slice1(const OpKernelInfo& info) : OpKernel(info), SliceBase(info, false) {}
-  Status Compute(OpKernelContext* context) const override { return SliceBase::Compute(context); }
+  Status Compute(OpKernelContext* context) const override { return SliceBase::Compute(context, compute_cache_); }
+
+ private:
+  ComputeCache compute_cache_;
 };
 
 struct Slice10 final : public OpKernel, public SliceBase {
   Slice10(const OpKernelInfo& info) : OpKernel(info), SliceBase(info, true) {}
-  Status Compute(OpKernelContext* context) const override { return SliceBase::Compute(context); }
+  Status Compute(OpKernelContext* context) const override { return SliceBase::Compute(context, compute_cache_); }
+
+ private:
+  ComputeCache compute_cache_;
 };
+#endif
 
 }  // namespace onnxruntime
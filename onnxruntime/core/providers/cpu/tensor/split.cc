@@ -11,6 +11,7 @@
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/providers/common.h"
 #include "core/providers/op_kernel_type_control.h"
+#include "core/providers/cpu/tensor/strided_view.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
@@ -28,12 +29,18 @@ ORT_SPECIFY_OP_KERNEL_ARG_REQUIRED_TYPES_ALL_OPSETS(
 using EnabledSplitDataTypes = ORT_OP_KERNEL_ARG_ENABLED_TYPE_LIST_ALL_OPSETS(
     kCpuExecutionProvider, kOnnxDomain, Split, Input, 0);
 
+#ifdef ENABLE_STRIDED_TENSORS
+#define CREATE_SPLIT_KERNEL_DEF KernelDefBuilder().MayStridedInput(0).VariadicMayStridedOutput(0)
+#else
+#define CREATE_SPLIT_KERNEL_DEF KernelDefBuilder()
+#endif
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Split,
     2,
     10,
-    KernelDefBuilder().TypeConstraint("T",
-                                      BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
+    CREATE_SPLIT_KERNEL_DEF.TypeConstraint("T",
+                                           BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
     Split_1_13);
 
 // Opset 11 starts to support Neg Axis.
@@ -41,8 +48,8 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Split,
     11,
     12,
-    KernelDefBuilder().TypeConstraint("T",
-                                      BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
+    CREATE_SPLIT_KERNEL_DEF.TypeConstraint("T",
+                                           BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
     Split_1_13);
 
 // Opset 13 starts to supports 'split' as optional input.
@@ -50,16 +57,16 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Split,
     13,
     17,
-    KernelDefBuilder().TypeConstraint("T",
-                                      BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
+    CREATE_SPLIT_KERNEL_DEF.TypeConstraint("T",
+                                           BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
     Split_1_13);
 
 // TODO: support unequal split and num_outputs
 ONNX_CPU_OPERATOR_KERNEL(
     Split,
     18,
-    KernelDefBuilder().TypeConstraint("T",
-                                      BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
+    CREATE_SPLIT_KERNEL_DEF.TypeConstraint("T",
+                                           BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
     Split_18);
 
 Status SplitBase::PrepareForCompute(const TensorShape& input_shape, int num_outputs, int64_t& axis, int& before_dims,
@@ -146,7 +153,8 @@ Status SplitImpl::Compute(OpKernelContext* context) const {
                                         after_dims_excluding_split,
                                         split_sizes));
 
-  const auto input_strides = StridesForTensor(input);
+  // the outputs are views of the input when the allocation planner placed them on the buffer of the input.
+  const auto input_strides = ViewInputStrides(input);
 
   // copy dimensions so we can update the selected axis in place
   auto output_dimensions = input_shape.AsShapeVector();
@@ -159,14 +167,11 @@ Status SplitImpl::Compute(OpKernelContext* context) const {
     output_dimensions[narrow<size_t>(axis)] = split_size;
 
     Tensor* output = context->Output(i, TensorShape{output_dimensions});
-    const auto output_strides = StridesForTensor(*output);
 
-    ORT_RETURN_IF_ERROR(DispatchStridedCopy<EnabledSplitDataTypes>(context->GetOperatorThreadPool(),
-                                                                   *output, /* dst_offset */ 0, output_strides,
-                                                                   output->Shape(),
-                                                                   input, input_offset, input_strides));
+    ORT_RETURN_IF_ERROR(ComputeStridedView<EnabledSplitDataTypes>(context->GetOperatorThreadPool(),
+                                                                  input, *output, input_strides, input_offset));
 
-    input_offset += SafeInt<ptrdiff_t>(split_size) * after_dims_excluding_split;  // offset by the data we used in this iteration
+    input_offset += SafeInt<ptrdiff_t>(split_size) * input_strides[narrow<size_t>(axis)];  // offset by the data we used in this iteration
   }
 
   return Status::OK();
@@ -3,13 +3,22 @@
 
 #include "core/providers/cpu/tensor/squeeze.h"
 
+#include "core/framework/element_type_lists.h"
+#include "core/providers/cpu/tensor/strided_view.h"
+
 namespace onnxruntime {
 
+#ifdef ENABLE_STRIDED_TENSORS
+#define CREATE_SQUEEZE_KERNEL_DEF KernelDefBuilder().MayStridedInput(0).MayStridedOutput(0, 0)
+#else
+#define CREATE_SQUEEZE_KERNEL_DEF KernelDefBuilder()
+#endif
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Squeeze,
     1,
     10,
-    KernelDefBuilder()
+    CREATE_SQUEEZE_KERNEL_DEF
         .TypeConstraint("T", DataTypeImpl::AllTensorTypes())
         .Alias(0, 0),
     Squeeze);
@@ -19,7 +28,7 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Squeeze,
     11,
     12,
-    KernelDefBuilder()
+    CREATE_SQUEEZE_KERNEL_DEF
         .TypeConstraint("T", DataTypeImpl::AllTensorTypes())
         .Alias(0, 0),
     Squeeze);
@@ -28,8 +37,44 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
 ONNX_CPU_OPERATOR_KERNEL(
     Squeeze,
     13,
-    KernelDefBuilder()
+    CREATE_SQUEEZE_KERNEL_DEF
         .TypeConstraint("T", DataTypeImpl::AllTensorTypes())
         .Alias(0, 0),
     Squeeze);
+
+Status Squeeze::Compute(OpKernelContext* context) const {
+  const auto* X = context->Input<Tensor>(0);
+  const TensorShape& X_shape = X->Shape();
+
+  TensorShapeVector axes;
+  size_t num_inputs = context->InputCount();
+  if (num_inputs == 2) {  // axes is an input
+    const Tensor* axes_tensor = context->Input<Tensor>(1);
+    ORT_ENFORCE(axes_tensor != nullptr, "Axes input is null");
+    ORT_ENFORCE(axes_tensor->Shape().NumDimensions() == 1,
+                "An axes tensor must be a vector tensor.");
+    auto nDims = static_cast<size_t>(axes_tensor->Shape()[0]);
+    const auto* data = axes_tensor->Data<int64_t>();
+    axes.assign(data, data + nDims);
+  } else {
+    axes.assign(axes_.begin(), axes_.end());
+  }
+
+  TensorShapeVector output_shape = ComputeOutputShape(X_shape, axes);
+
+  Tensor* Y = context->Output(0, TensorShape(output_shape));
+
+#ifdef ENABLE_STRIDED_TENSORS
+  // a strided input gives a strided output, which is a copy if the allocation planner didn't place it on the input.
+  if (IsStridedViewCompute(*X, *Y)) {
+    return ComputeStridedView<element_type_lists::All>(
+        context->GetOperatorThreadPool(), *X, *Y, SqueezedViewStrides(X_shape, X->Strides(), Y->Shape()), 0);
+  }
+#endif
+
+  CopyCpuTensor(X, Y);
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
@@ -66,32 +66,7 @@ class Squeeze final : public OpKernel, public SqueezeBase {
  public:
   explicit Squeeze(const OpKernelInfo& info) : OpKernel(info), SqueezeBase(info) {}
 
-  Status Compute(OpKernelContext* context) const override {
-    const auto* X = context->Input<Tensor>(0);
-    const TensorShape& X_shape = X->Shape();
-
-    TensorShapeVector axes;
-    size_t num_inputs = context->InputCount();
-    if (num_inputs == 2) {  // axes is an input
-      const Tensor* axes_tensor = context->Input<Tensor>(1);
-      ORT_ENFORCE(axes_tensor != nullptr, "Axes input is null");
-      ORT_ENFORCE(axes_tensor->Shape().NumDimensions() == 1,
-                  "An axes tensor must be a vector tensor.");
-      auto nDims = static_cast<size_t>(axes_tensor->Shape()[0]);
-      const auto* data = axes_tensor->Data<int64_t>();
-      axes.assign(data, data + nDims);
-    } else {
-      axes.assign(axes_.begin(), axes_.end());
-    }
-
-    TensorShapeVector output_shape = ComputeOutputShape(X_shape, axes);
-
-    Tensor* Y = context->Output(0, TensorShape(output_shape));
-
-    CopyCpuTensor(X, Y);
-
-    return Status::OK();
-  }
+  Status Compute(OpKernelContext* context) const override;
 };
 
 }  // namespace onnxruntime
@@ -0,0 +1,106 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/framework/copy.h"
+
+namespace onnxruntime {
+
+#ifdef ENABLE_STRIDED_TENSORS
+// Returns whether a view operator has to compute its output from the strides of the view: either the allocation
+// planner placed the output on the buffer of the input so the output becomes the view, or the input is strided and
+// can't be read by the contiguous implementation of the operator.
+inline bool IsStridedViewCompute(const Tensor& input, const Tensor& output) {
+  return output.DataRaw() == input.DataRaw() || !input.IsContiguous();
+}
+#endif
+
+// Returns whether 'output' is placed at the element offset 'view_offset' into the buffer of 'input' and the view with
+// the element strides 'view_strides' is contiguous, so the output is the view. Strides of dimensions of size 1 are
+// never used to address an element, so they don't need to match.
+inline bool IsContiguousViewInPlace(const Tensor& input, const Tensor& output, const TensorShapeVector& view_strides,
+                                    std::ptrdiff_t view_offset) {
+  const auto* view_data = static_cast<const uint8_t*>(input.DataRaw()) +
+                          view_offset * static_cast<std::ptrdiff_t>(input.DataType()->Size());
+  if (output.DataRaw() != view_data || output.DataType() != input.DataType()) {
+    return false;
+  }
+
+  const TensorShape& output_shape = output.Shape();
+  int64_t contiguous_stride = 1;
+  for (size_t i = output_shape.NumDimensions(); i > 0; --i) {
+    if (output_shape[i - 1] != 1 && view_strides[i - 1] != contiguous_stride) {
+      return false;
+    }
+    contiguous_stride *= output_shape[i - 1];
+  }
+  return true;
+}
+
+// Writes the view of 'input' with the shape of 'output', the element strides 'view_strides' and the element offset
+// 'view_offset' to 'output'. The output is the view itself if it shares the buffer of the input, otherwise the
+// elements of the view are copied to the contiguous output.
+template <typename EnabledDataTypes>
+Status ComputeStridedView(concurrency::ThreadPool* thread_pool, const Tensor& input, Tensor& output,
+                          const TensorShapeVector& view_strides, std::ptrdiff_t view_offset) {
+  // the allocation planner may have placed a contiguous view, like an output of Split, at its offset into the buffer
+  // of the input, in which case the output already holds the elements of the view.
+  if (IsContiguousViewInPlace(input, output, view_strides, view_offset)) {
+    return Status::OK();
+  }
+
+#ifdef ENABLE_STRIDED_TENSORS
+  if (output.DataRaw() == input.DataRaw()) {
+    output.SetByteOffset(output.ByteOffset() + view_offset * static_cast<std::ptrdiff_t>(input.DataType()->Size()));
+    output.SetShapeAndStrides(output.Shape(), view_strides);
+    return Status::OK();
+  }
+#endif
+
+  const TensorShape& output_shape = output.Shape();
+  if (output_shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  // the strided copy needs at least one dimension.
+  if (output_shape.NumDimensions() == 0) {
+    return DispatchStridedCopy<EnabledDataTypes>(thread_pool, output, 0, {1}, TensorShape({1}), input, view_offset,
+                                                 {1});
+  }
+
+  return DispatchStridedCopy<EnabledDataTypes>(thread_pool, output, 0, StridesForTensor(output), output_shape,
+                                               input, view_offset, view_strides);
+}
+
+#ifdef ENABLE_STRIDED_TENSORS
+// Returns the element strides of a view that only adds or removes dimensions of size 1 of the input, like Squeeze
+// and Unsqueeze. The other dimensions keep their order so they keep their strides.
+inline TensorShapeVector SqueezedViewStrides(const TensorShape& input_shape, gsl::span<const int64_t> input_strides,
+                                             const TensorShape& output_shape) {
+  // the stride of a dimension of size 1 is never used to address an element.
+  TensorShapeVector output_strides(output_shape.NumDimensions(), 1);
+  size_t input_dim = 0;
+  for (size_t i = 0; i < output_shape.NumDimensions(); ++i) {
+    if (output_shape[i] == 1) {
+      continue;
+    }
+    while (input_shape[input_dim] == 1) {
+      ++input_dim;
+    }
+    output_strides[i] = input_strides[input_dim++];
+  }
+  return output_strides;
+}
+
+// Returns the element strides of the input of a view operator.
+inline TensorShapeVector ViewInputStrides(const Tensor& input) {
+  return ToShapeVector(input.Strides());
+}
+#else
+inline TensorShapeVector ViewInputStrides(const Tensor& input) {
+  return StridesForTensor(input);
+}
+#endif
+
+}  // namespace onnxruntime
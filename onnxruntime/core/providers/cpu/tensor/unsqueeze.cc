@@ -3,17 +3,25 @@
 
 #include "core/providers/cpu/tensor/unsqueeze.h"
 #include "utils.h"
+#include "core/framework/element_type_lists.h"
 #include "core/providers/common.h"
+#include "core/providers/cpu/tensor/strided_view.h"
 
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
 
+#ifdef ENABLE_STRIDED_TENSORS
+#define CREATE_UNSQUEEZE_KERNEL_DEF KernelDefBuilder().MayStridedInput(0).MayStridedOutput(0, 0)
+#else
+#define CREATE_UNSQUEEZE_KERNEL_DEF KernelDefBuilder()
+#endif
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Unsqueeze,
     1,
     10,
-    KernelDefBuilder()
+    CREATE_UNSQUEEZE_KERNEL_DEF
         .Alias(0, 0)
         .TypeConstraint("T", DataTypeImpl::AllTensorTypes()),
     Unsqueeze);
@@ -22,7 +30,7 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Unsqueeze,
     11,
     12,
-    KernelDefBuilder()
+    CREATE_UNSQUEEZE_KERNEL_DEF
         .Alias(0, 0)
         .TypeConstraint("T", DataTypeImpl::AllTensorTypes()),
     Unsqueeze);
@@ -31,7 +39,7 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
 ONNX_CPU_OPERATOR_KERNEL(
     Unsqueeze,
     13,
-    KernelDefBuilder()
+    CREATE_UNSQUEEZE_KERNEL_DEF
         .Alias(0, 0)
         .TypeConstraint("T", DataTypeImpl::AllTensorTypes()),
     Unsqueeze);
@@ -90,6 +98,14 @@ Status UnsqueezeBase::PrepareCompute(OpKernelContext* ctx, Prepare& p) const {
 Status Unsqueeze::Compute(OpKernelContext* ctx) const {
   Prepare p;
   ORT_RETURN_IF_ERROR(PrepareCompute(ctx, p));
+#ifdef ENABLE_STRIDED_TENSORS
+  // a strided input gives a strided output, which is a copy if the allocation planner didn't place it on the input.
+  if (IsStridedViewCompute(*p.input_tensor, *p.output_tensor)) {
+    return ComputeStridedView<element_type_lists::All>(
+        ctx->GetOperatorThreadPool(), *p.input_tensor, *p.output_tensor,
+        SqueezedViewStrides(p.input_tensor->Shape(), p.input_tensor->Strides(), p.output_tensor->Shape()), 0);
+  }
+#endif
   CopyCpuTensor(p.input_tensor, p.output_tensor);
   return Status::OK();
 }
@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <limits>
+
 #include "core/common/safeint.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/upsample.h"
@@ -873,197 +876,296 @@ std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff
   return coeffs;
 }
 
-// Get the tensor data at the requested coordinate
-template <typename T>
-T GetDataForCoordinate(const T* Xdata,
-                       int64_t x, int64_t y,
-                       int64_t input_height, int64_t input_width) {
-  x = std::max(static_cast<int64_t>(0), std::min(x, input_width - 1));
-  y = std::max(static_cast<int64_t>(0), std::min(y, input_height - 1));
-  return Xdata[y * input_width + x];
-}
+// Interpolation taps of one axis of the cubic resize, precomputed once per output index so that the two passes of
+// the separable filter are plain multiply-adds.
+struct CubicFilterTable {
+  // CubicModeGridLength input indices per output index, clamped to the input.
+  std::vector<int64_t> index;
+  // CubicModeGridLength weights per output index, renormalized when exclude_outside is set.
+  std::vector<float> weight;
+  // The weights in fixed point with kCubicWeightBits fractional bits. Only set for 8-bit data.
+  std::vector<int32_t> weight_int;
+  // Set for the output indices whose original coordinate is outside the input when extrapolation is used.
+  std::vector<uint8_t> extrapolate;
+  // The largest sum of the absolute weights of an output index, which bounds the growth of the values in a pass.
+  float max_weight_sum = 1.0f;
+};
 
-// Computes cubic convolution interpolation in 1D
-template <typename T>
-float CubicInterpolation1D(const T* Xdata,
-                           int64_t x,
-                           int64_t y,
-                           int64_t input_height,
-                           int64_t input_width,
-                           std::array<float, CubicModeGridLength>& coeff_array,
-                           float coeff_sum,
-                           std::unordered_map<int64_t, float>& cache) {
-  // When calculating cubic interpolation we move the 4*4 grid across the original data and therefore there is
-  // opportunity to cache the results for previously seen combinations.
-  // Check if the result is already available in the cache
-  auto grid_start_pos = (y)*input_width + (x - 1);
-  if (cache.find(grid_start_pos) != cache.end()) {
-    return cache[grid_start_pos];
+// 8-bit data is resized with fixed-point weights. The horizontal pass keeps kCubicIntermediateBits fractional bits
+// between the passes, so with weight sums up to kCubicMaxFixedPointWeightSum every product fits in an int32.
+constexpr int kCubicWeightBits = 14;
+constexpr int kCubicIntermediateBits = 6;
+constexpr float kCubicMaxFixedPointWeightSum = 2.0f;
+
+CubicFilterTable SetupCubicFilter(int64_t input_size, int64_t output_size, float scale, float roi_start,
+                                  float roi_end, float cubic_coeff_a, bool use_extrapolation, bool exclude_outside,
+                                  bool fixed_point, const GetOriginalCoordinateFunc& get_original_coordinate) {
+  CubicFilterTable table;
+  const size_t output_count = narrow<size_t>(output_size);
+  table.index.resize(output_count * CubicModeGridLength);
+  table.weight.resize(output_count * CubicModeGridLength);
+  table.extrapolate.resize(output_count);
+
+  for (int64_t o = 0; o < output_size; ++o) {
+    const float in = scale == 1 ? static_cast<float>(o)
+                                : get_original_coordinate(static_cast<float>(o), scale,
+                                                          static_cast<float>(output_size),
+                                                          static_cast<float>(input_size), roi_start, roi_end);
+
+    // when use_extrapolation is set and original index is out of the dim range
+    // then use extrapolation_value as the output value.
+    table.extrapolate[narrow<size_t>(o)] = use_extrapolation && (in < 0 || in > static_cast<float>(input_size - 1));
+
+    const auto in_int = static_cast<int64_t>(std::floor(in));
+    auto coeffs = GetCubicCoeffs(in - static_cast<float>(in_int), cubic_coeff_a);
+
+    if (exclude_outside) {
+      // When true, the weight of sampling locations outside the grid will be set to 0
+      // and the weight will be renormalized so that their sum is 1.0
+      float coeff_sum = 0;
+      for (size_t i = 0; i < CubicModeGridLength; ++i) {
+        const int64_t in_val = in_int - 1 + static_cast<int64_t>(i);
+        if (in_val < 0 || in_val >= input_size) {
+          coeffs[i] = 0.0f;
+        }
+        coeff_sum += coeffs[i];
+      }
+      for (auto& coeff : coeffs) {
+        coeff /= coeff_sum;
+      }
+    }
+
+    float weight_sum = 0;
+    for (size_t i = 0; i < CubicModeGridLength; ++i) {
+      const size_t offset = narrow<size_t>(o) * CubicModeGridLength + i;
+      table.index[offset] = std::clamp<int64_t>(in_int - 1 + static_cast<int64_t>(i), 0, input_size - 1);
+      table.weight[offset] = coeffs[i];
+      weight_sum += std::abs(coeffs[i]);
+    }
+    table.max_weight_sum = std::max(table.max_weight_sum, weight_sum);
   }
 
-  // get the neighbors in 1D and find interpolation for this dimension
-  // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of x
-  float result = 0;
-  for (int i = 0, j = -1; i < static_cast<int>(CubicModeGridLength); i++, j++) {
-    auto orig_data = GetDataForCoordinate(Xdata, x + j, y, input_height, input_width);
-    result += coeff_array[narrow<size_t>(i)] / coeff_sum * orig_data;
+  if (fixed_point && table.max_weight_sum <= kCubicMaxFixedPointWeightSum) {
+    table.weight_int.resize(table.weight.size());
+    for (size_t o = 0; o < output_count; ++o) {
+      // the weights of an output index sum to 1, so give the rounding residue to the largest of them to keep flat
+      // areas unchanged
+      const float* weight = table.weight.data() + o * CubicModeGridLength;
+      int32_t* weight_int = table.weight_int.data() + o * CubicModeGridLength;
+      int32_t weight_int_sum = 0;
+      size_t largest = 0;
+      for (size_t i = 0; i < CubicModeGridLength; ++i) {
+        weight_int[i] = static_cast<int32_t>(std::lround(weight[i] * (1 << kCubicWeightBits)));
+        weight_int_sum += weight_int[i];
+        if (weight[i] > weight[largest]) {
+          largest = i;
+        }
+      }
+      weight_int[largest] += (1 << kCubicWeightBits) - weight_int_sum;
+    }
   }
-  cache[grid_start_pos] = result;
 
-  return result;
+  return table;
 }
-#if defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 6001)
-#endif
-template <typename T>
-void ResizeBiCubic(int64_t batch_size,
-                   int64_t num_channels,
-                   int64_t input_height,
-                   int64_t input_width,
-                   int64_t output_height,
-                   int64_t output_width,
-                   float height_scale,
-                   float width_scale,
-                   float cubic_coeff_a,
-                   bool use_extrapolation,
-                   float extrapolation_value,
-                   bool exclude_outside,
-                   const std::vector<float>& roi,
-                   const T* Xdata,
-                   T* Ydata,
-                   const GetOriginalCoordinateFunc& get_original_coordinate) {
-  std::vector<float> y_original;
-  y_original.reserve(narrow<size_t>(output_height));
 
-  std::vector<float> x_original;
-  x_original.reserve(narrow<size_t>(output_width));
+// Interpolates one input row along the width. The rows are [width, num_channels].
+template <typename T, typename AccumulateType>
+void CubicHorizontalPass(const T* Xrow, AccumulateType* Hrow, const CubicFilterTable& table,
+                         int64_t output_width, int64_t num_channels) {
+  const int64_t* index = table.index.data();
+  const AccumulateType* weight;
+  if constexpr (std::is_same<AccumulateType, int32_t>::value) {
+    weight = table.weight_int.data();
+  } else {
+    weight = table.weight.data();
+  }
 
-  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
-  std::unordered_map<float, std::unordered_map<int64_t, float>> coeff_to_1Dinterpolation_map;
-  auto roi_y_start = roi.size() / 2 - 2;
-  auto roi_y_end = roi.size() - 2;
-  auto roi_x_start = roi.size() / 2 - 1;
-  auto roi_x_end = roi.size() - 1;
+  const auto convert = [](AccumulateType value) {
+    if constexpr (std::is_same<AccumulateType, int32_t>::value) {
+      return static_cast<int32_t>((value + (1 << (kCubicWeightBits - kCubicIntermediateBits - 1))) >>
+                                  (kCubicWeightBits - kCubicIntermediateBits));
+    } else {
+      return value;
+    }
+  };
 
-  // generate coefficients in y direction
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = height_scale == 1 ? static_cast<float>(y)
-                                   : get_original_coordinate(static_cast<float>(y), height_scale,
-                                                             static_cast<float>(output_height),
-                                                             static_cast<float>(input_height),
-                                                             roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    auto s = y_original[narrow<size_t>(y)] - std::floor(y_original[narrow<size_t>(y)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
+  if (num_channels == 1) {
+    for (int64_t x = 0; x < output_width; ++x, index += CubicModeGridLength, weight += CubicModeGridLength) {
+      const AccumulateType result = weight[0] * static_cast<AccumulateType>(Xrow[index[0]]) +
+                                    weight[1] * static_cast<AccumulateType>(Xrow[index[1]]) +
+                                    weight[2] * static_cast<AccumulateType>(Xrow[index[2]]) +
+                                    weight[3] * static_cast<AccumulateType>(Xrow[index[3]]);
+      Hrow[x] = convert(result);
     }
+    return;
   }
 
-  // generate coefficients in x direction
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = width_scale == 1 ? static_cast<float>(x)
-                                  : get_original_coordinate(static_cast<float>(x),
-                                                            width_scale,
-                                                            static_cast<float>(output_width),
-                                                            static_cast<float>(input_width),
-                                                            roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    auto s = x_original[narrow<size_t>(x)] - std::floor(x_original[narrow<size_t>(x)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
+  for (int64_t x = 0; x < output_width; ++x, index += CubicModeGridLength, weight += CubicModeGridLength) {
+    const T* X0 = Xrow + index[0] * num_channels;
+    const T* X1 = Xrow + index[1] * num_channels;
+    const T* X2 = Xrow + index[2] * num_channels;
+    const T* X3 = Xrow + index[3] * num_channels;
+    AccumulateType* H = Hrow + x * num_channels;
+    for (int64_t c = 0; c < num_channels; ++c) {
+      const AccumulateType result = weight[0] * static_cast<AccumulateType>(X0[c]) +
+                                    weight[1] * static_cast<AccumulateType>(X1[c]) +
+                                    weight[2] * static_cast<AccumulateType>(X2[c]) +
+                                    weight[3] * static_cast<AccumulateType>(X3[c]);
+      H[c] = convert(result);
     }
   }
+}
 
-  // setup up temp arrays to hold coefficients when exclude_outside is set to true
-  std::array<float, CubicModeGridLength> y_coeff_holder;
-  std::array<float, CubicModeGridLength> x_coeff_holder;
-  float y_coeff_sum = 1;
-  float x_coeff_sum = 1;
+// Interpolates one output row along the height from the horizontally interpolated rows. The rows are
+// [output_width, num_channels].
+template <typename T, typename AccumulateType>
+void CubicVerticalPass(const AccumulateType* Hdata, T* Yrow, const CubicFilterTable& table_y,
+                       const CubicFilterTable& table_x, int64_t y, int64_t output_width, int64_t num_channels,
+                       T extrapolation_value) {
+  const int64_t row_size = output_width * num_channels;
+  const int64_t* index = table_y.index.data() + y * CubicModeGridLength;
+  const AccumulateType* weight;
+  if constexpr (std::is_same<AccumulateType, int32_t>::value) {
+    weight = table_y.weight_int.data() + y * CubicModeGridLength;
+  } else {
+    weight = table_y.weight.data() + y * CubicModeGridLength;
+  }
 
-  for (int64_t n = 0; n < batch_size; n++) {
-    for (int64_t c = 0; c < num_channels; c++) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        auto in_y = y_original[narrow<size_t>(y)];
+  const AccumulateType* H0 = Hdata + index[0] * row_size;
+  const AccumulateType* H1 = Hdata + index[1] * row_size;
+  const AccumulateType* H2 = Hdata + index[2] * row_size;
+  const AccumulateType* H3 = Hdata + index[3] * row_size;
+  const AccumulateType w0 = weight[0], w1 = weight[1], w2 = weight[2], w3 = weight[3];
+
+  for (int64_t i = 0; i < row_size; ++i) {
+    const AccumulateType result = w0 * H0[i] + w1 * H1[i] + w2 * H2[i] + w3 * H3[i];
+    if constexpr (std::is_same<AccumulateType, int32_t>::value) {
+      const int32_t value = (result + (1 << (kCubicWeightBits + kCubicIntermediateBits - 1))) >>
+                            (kCubicWeightBits + kCubicIntermediateBits);
+      Yrow[i] = static_cast<T>(std::clamp<int32_t>(value, std::numeric_limits<T>::lowest(),
+                                                   std::numeric_limits<T>::max()));
+    } else if constexpr (std::is_integral<T>::value) {
+      Yrow[i] = static_cast<T>(std::clamp<float>(std::round(result),
+                                                 static_cast<float>(std::numeric_limits<T>::lowest()),
+                                                 static_cast<float>(std::numeric_limits<T>::max())));
+    } else {
+      Yrow[i] = static_cast<T>(result);
+    }
+  }
 
-        // when use_extrapolation is set and original index is out of the dim range
-        // then use extrapolation_value as the output value.
-        if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
-          for (int64_t x = 0; x < output_width; ++x) {
-            Ydata[y * output_width + x] = extrapolation_value;
-          }
-          continue;
-        }
+  for (int64_t x = 0; x < output_width; ++x) {
+    if (table_x.extrapolate[narrow<size_t>(x)]) {
+      std::fill_n(Yrow + x * num_channels, narrow<size_t>(num_channels), extrapolation_value);
+    }
+  }
+}
 
-        auto y_int = static_cast<int64_t>(std::floor(in_y));
-        auto& coeff_y = exclude_outside ? y_coeff_holder : cubic_coeffs[in_y - y_int];
-        y_coeff_sum = 1;
-
-        if (exclude_outside) {
-          // When true, the weight of sampling locations outside the grid will be set to 0
-          // and the weight will be renormalized so that their sum is 1.0
-          y_coeff_sum = 0;
-          auto& orig_y_coeffs = cubic_coeffs[in_y - y_int];
-          for (int64_t i = 0, y_val = y_int - 1; y_val <= y_int + 2; y_val++, i++) {
-            y_coeff_holder[narrow<size_t>(i)] = (y_val < 0 || y_val >= static_cast<float>(input_height)) ? 0.0f : orig_y_coeffs[narrow<size_t>(i)];
-            y_coeff_sum += y_coeff_holder[narrow<size_t>(i)];
-          }
+template <typename T, typename AccumulateType>
+void ResizeBiCubicSeparable(int64_t batch_size, int64_t num_channels, int64_t input_height, int64_t input_width,
+                            int64_t output_height, int64_t output_width, const CubicFilterTable& table_y,
+                            const CubicFilterTable& table_x, T extrapolation_value, const T* Xdata, T* Ydata,
+                            AllocatorPtr& alloc, concurrency::ThreadPool* tp) {
+  // only the input rows that are a tap of an interpolated output row go through the horizontal pass
+  std::vector<int64_t> rows;
+  {
+    std::vector<uint8_t> row_used(narrow<size_t>(input_height), 0);
+    for (int64_t y = 0; y < output_height; ++y) {
+      if (!table_y.extrapolate[narrow<size_t>(y)]) {
+        for (size_t i = 0; i < CubicModeGridLength; ++i) {
+          row_used[narrow<size_t>(table_y.index[narrow<size_t>(y) * CubicModeGridLength + i])] = 1;
         }
+      }
+    }
+    for (int64_t r = 0; r < input_height; ++r) {
+      if (row_used[narrow<size_t>(r)]) {
+        rows.push_back(r);
+      }
+    }
+  }
 
-        for (int64_t x = 0; x < output_width; ++x) {
-          auto in_x = x_original[narrow<size_t>(x)];
+  const int64_t input_row_size = input_width * num_channels;
+  const int64_t output_row_size = output_width * num_channels;
+  auto hdata_buffer = IAllocator::MakeUniquePtr<AccumulateType>(
+      alloc, SafeInt<size_t>(input_height) * narrow<size_t>(output_row_size));
+  AccumulateType* Hdata = hdata_buffer.get();
 
-          // when use_extrapolation is set and original index is out of the dim range
-          // then use extrapolation_value as the output value.
-          if (use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1))) {
-            Ydata[y * output_width + x] = extrapolation_value;
-            continue;
+  for (int64_t n = 0; n < batch_size; ++n) {
+    const T* X = Xdata + n * input_height * input_row_size;
+    T* Y = Ydata + n * output_height * output_row_size;
+
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(rows.size()),
+        static_cast<double>(output_row_size * CubicModeGridLength * 2),
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            const int64_t r = rows[narrow<size_t>(i)];
+            CubicHorizontalPass(X + r * input_row_size, Hdata + r * output_row_size, table_x, output_width,
+                                num_channels);
           }
+        });
 
-          auto x_int = static_cast<int64_t>(std::floor(in_x));
-          auto s_x = static_cast<float>(in_x - x_int);
-          auto& coeff_x = exclude_outside ? x_coeff_holder : cubic_coeffs[s_x];
-          x_coeff_sum = 1;
-
-          if (exclude_outside) {
-            // When true, the weight of sampling locations outside the grid will be set to 0
-            // and the weight will be renormalized so that their sum is 1.0
-            x_coeff_sum = 0;
-            auto& orig_x_coeff = cubic_coeffs[s_x];
-            for (int64_t i = 0, x_val = x_int - 1; x_val <= x_int + 2; x_val++, i++) {
-              x_coeff_holder[narrow<size_t>(i)] = (x_val < 0 || x_val >= static_cast<float>(input_width)) ? 0.0f : orig_x_coeff[narrow<size_t>(i)];
-              x_coeff_sum += x_coeff_holder[narrow<size_t>(i)];
+    concurrency::ThreadPool::TryParallelFor(
+        tp, narrow<std::ptrdiff_t>(output_height),
+        static_cast<double>(output_row_size * CubicModeGridLength * 2),
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t y = first; y < last; ++y) {
+            T* Yrow = Y + y * output_row_size;
+            if (table_y.extrapolate[narrow<size_t>(y)]) {
+              std::fill_n(Yrow, narrow<size_t>(output_row_size), extrapolation_value);
+            } else {
+              CubicVerticalPass(Hdata, Yrow, table_y, table_x, y, output_width, num_channels, extrapolation_value);
             }
           }
+        });
+  }
+}
 
-          // Compute cubic interpolation in x dimension using the x coefficients.
-          // From the result of cubic interpolation in x dim, compute cubic interpolation in y dimension
-          auto& interpolation_result_cache = coeff_to_1Dinterpolation_map[s_x];
-          float result = 0;
-          for (int64_t y_val = y_int - 1, i = 0; y_val <= y_int + 2; y_val++, i++) {
-            auto x_interpolation_result = CubicInterpolation1D(Xdata, x_int, y_val,
-                                                               input_height, input_width, coeff_x, x_coeff_sum,
-                                                               interpolation_result_cache);
-            result += x_interpolation_result * coeff_y[narrow<size_t>(i)] / y_coeff_sum;
-          }
-
-          Ydata[y * output_width + x] = static_cast<T>(result);
-        }
-      }
-
-      Xdata += input_height * input_width;
-      Ydata += output_height * output_width;
-
-      // clear the cache when moving to the next channel
-      coeff_to_1Dinterpolation_map.clear();
+// Bicubic resize as a separable filter: every input row is first interpolated along the width with precomputed taps
+// and weights, then the output rows are interpolated along the height from four of those rows. The data is
+// [batch_size, height, width, num_channels], so NCHW input is resized as N*C images of a single channel. 8-bit
+// data is computed in fixed point.
+template <typename T>
+void ResizeBiCubic(int64_t batch_size,
+                   int64_t num_channels,
+                   int64_t input_height,
+                   int64_t input_width,
+                   int64_t output_height,
+                   int64_t output_width,
+                   float height_scale,
+                   float width_scale,
+                   float cubic_coeff_a,
+                   bool use_extrapolation,
+                   float extrapolation_value,
+                   bool exclude_outside,
+                   float roi_y_start,
+                   float roi_y_end,
+                   float roi_x_start,
+                   float roi_x_end,
+                   const T* Xdata,
+                   T* Ydata,
+                   AllocatorPtr& alloc,
+                   const GetOriginalCoordinateFunc& get_original_coordinate,
+                   concurrency::ThreadPool* tp) {
+  const CubicFilterTable table_y = SetupCubicFilter(input_height, output_height, height_scale, roi_y_start,
+                                                    roi_y_end, cubic_coeff_a, use_extrapolation, exclude_outside,
+                                                    is_8bit_v<T>, get_original_coordinate);
+  const CubicFilterTable table_x = SetupCubicFilter(input_width, output_width, width_scale, roi_x_start,
+                                                    roi_x_end, cubic_coeff_a, use_extrapolation, exclude_outside,
+                                                    is_8bit_v<T>, get_original_coordinate);
+
+  if constexpr (is_8bit_v<T>) {
+    // the fixed-point weights are only set up when the weight sums are small enough not to overflow
+    if (!table_x.weight_int.empty() && !table_y.weight_int.empty()) {
+      ResizeBiCubicSeparable<T, int32_t>(batch_size, num_channels, input_height, input_width, output_height,
+                                         output_width, table_y, table_x, static_cast<T>(extrapolation_value),
+                                         Xdata, Ydata, alloc, tp);
+      return;
     }
   }
+
+  ResizeBiCubicSeparable<T, float>(batch_size, num_channels, input_height, input_width, output_height, output_width,
+                                   table_y, table_x, static_cast<T>(extrapolation_value), Xdata, Ydata, alloc, tp);
 }
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
 
 template <typename T>
 Status Upsample<T>::BaseCompute(OpKernelContext* context,
@@ -1304,10 +1406,20 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
                                  output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
         }
       } else {
-        ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width,
+        // roi is [start of each axis, end of each axis] and H and W are the last two axes or, for NHWC, the two
+        // before the last
+        const size_t roi_y_start = roi.size() / 2 - (is_nchw ? 2 : 3);
+        const size_t roi_x_start = roi_y_start + 1;
+        const size_t roi_y_end = roi.size() - (is_nchw ? 2 : 3);
+        const size_t roi_x_end = roi_y_end + 1;
+        // NCHW is resized as N*C images of a single channel
+        ResizeBiCubic(is_nchw ? batch_size * num_channels : batch_size, is_nchw ? 1 : num_channels,
+                      input_height, input_width, output_height, output_width,
                       height_scale, width_scale, cubic_coeff_a_, use_extrapolation_,
-                      extrapolation_value_, exclude_outside_, roi, X->Data<float>(),
-                      Y->MutableData<float>(), get_original_coordinate_);
+                      extrapolation_value_, exclude_outside_, roi[roi_y_start], roi[roi_y_end],
+                      roi[roi_x_start], roi[roi_x_end], X->Data<T>(), Y->MutableData<T>(), alloc,
+                      get_original_coordinate_,
+                      output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
       }
       return Status::OK();
     }
@@ -361,11 +361,11 @@ class UpsampleBase {
                         "in the ",
                         is_resize_ ? "Resize operator" : "Upsample operator");
     } else if (UpsampleMode::CUBIC == mode) {
-      // we support cubic in NHWC format once anti-alias is enabled
       ORT_RETURN_IF_NOT(scales.size() == 2 || (scales.size() == 4 && scales[0] == 1 && scales[1] == 1) ||
-                            (antialias_ && scales.size() == 4 && scales[0] == 1 && scales[3] == 1),
+                            (scales.size() == 4 && scales[0] == 1 && scales[3] == 1),
                         "'Cubic' mode only support 2-D inputs ('Bicubic') or 4-D inputs "
-                        "with the corresponding outermost 2 scale values being 1 in the ",
+                        "with the corresponding outermost 2 scale values or outermost and innermost scale values "
+                        "being 1 in the ",
                         is_resize_ ? "Resize operator" : "Upsample operator");
     }
     return Status::OK();
@@ -4,8 +4,10 @@
 #include "core/providers/cpu/tensor/where_op.h"
 
 #include <algorithm>
+#include <optional>
 #include <type_traits>
 
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/math/element_wise_ops.h"  // for broadcast utilities
 
 namespace onnxruntime {
@@ -234,6 +236,54 @@ static std::unique_ptr<Tensor> UntypedSelect(OpKernelContext& context, bool targ
   return selection_tensor;
 }
 
+// Returns the output shape if every input either has that shape or a single element, in which case the output is
+// computed in one parallel pass without the selection tensors.
+static std::optional<TensorShape> GetShapeWithoutBroadcast(const Tensor& condition, const Tensor& X, const Tensor& Y) {
+  const TensorShape* output_shape = &condition.Shape();
+  for (const Tensor* input : {&X, &Y}) {
+    const TensorShape& shape = input->Shape();
+    if (shape.Size() > output_shape->Size() ||
+        (shape.Size() == output_shape->Size() && shape.NumDimensions() > output_shape->NumDimensions())) {
+      output_shape = &shape;
+    }
+  }
+
+  for (const Tensor* input : {&condition, &X, &Y}) {
+    const TensorShape& shape = input->Shape();
+    if (shape != *output_shape &&
+        (shape.Size() != 1 || shape.NumDimensions() > output_shape->NumDimensions())) {
+      return std::nullopt;
+    }
+  }
+
+  return *output_shape;
+}
+
+template <typename T>
+void SelectWithoutBroadcast(OpKernelContext& context, const TensorShape& output_shape,
+                            const Tensor& condition_tensor, const Tensor& X_tensor, const Tensor& Y_tensor) {
+  Tensor& output = *context.Output(0, output_shape);
+  const std::ptrdiff_t size = onnxruntime::narrow<std::ptrdiff_t>(output_shape.Size());
+
+  const bool* condition = condition_tensor.Data<bool>();
+  const T* X = X_tensor.Data<T>();
+  const T* Y = Y_tensor.Data<T>();
+  T* Z = output.MutableData<T>();
+
+  // a single element input is read at index 0 for every output element
+  const std::ptrdiff_t condition_step = condition_tensor.Shape().Size() == size ? 1 : 0;
+  const std::ptrdiff_t X_step = X_tensor.Shape().Size() == size ? 1 : 0;
+  const std::ptrdiff_t Y_step = Y_tensor.Shape().Size() == size ? 1 : 0;
+
+  const TensorOpCost unit_cost{static_cast<double>(1 + 2 * sizeof(T)), static_cast<double>(sizeof(T)), 1.0};
+  concurrency::ThreadPool::TryParallelFor(
+      context.GetOperatorThreadPool(), size, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i < end; ++i) {
+          Z[i] = condition[i * condition_step] ? X[i * X_step] : Y[i * Y_step];
+        }
+      });
+}
+
 static void UntypedMerge(OpKernelContext& context,
                          const Tensor& X_selection_tensor, const Tensor& Y_selection_tensor,
                          const ProcessBroadcastSpanFuncs& functors) {
@@ -249,6 +299,14 @@ static void UntypedMerge(OpKernelContext& context,
 
 template <typename T>
 Status Where<T>::Compute(OpKernelContext* context) const {
+  const auto& condition = *context->Input<Tensor>(0);
+  const auto& X = *context->Input<Tensor>(1);
+  const auto& Y = *context->Input<Tensor>(2);
+  if (auto output_shape = GetShapeWithoutBroadcast(condition, X, Y)) {
+    SelectWithoutBroadcast<T>(*context, *output_shape, condition, X, Y);
+    return Status::OK();
+  }
+
   // we use a func pointer to save the overhead of std::function, so we can't capture tensor_allocator here
   const auto typed_tensor_allocation = [](const TensorAllocator& allocator,
                                           const TensorShape& shape) {
@@ -2,6 +2,11 @@
 // Licensed under the MIT License.
 
 #include "cuda_allocator.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "core/framework/stream_handles.h"
 #include "cuda_common.h"
 #include "gpu_data_transfer.h"
 
@@ -86,6 +91,106 @@ void* CUDAExternalAllocator::Reserve(size_t size) {
   return p;
 }
 
+CUDAMemPoolAllocator::CUDAMemPoolAllocator(OrtDevice::DeviceId device_id, const char* name,
+                                           size_t release_threshold, size_t mem_limit)
+    : IAllocator(
+          OrtMemoryInfo(name, OrtAllocatorType::OrtDeviceAllocator,
+                        OrtDevice(OrtDevice::GPU, OrtDevice::MemType::DEFAULT, device_id),
+                        device_id, OrtMemTypeDefault)),
+      mem_limit_(mem_limit) {
+  int pools_supported = 0;
+  CUDA_CALL_THROW(cudaDeviceGetAttribute(&pools_supported, cudaDevAttrMemoryPoolsSupported, device_id));
+  ORT_ENFORCE(pools_supported != 0, "CUDA device ", device_id, " does not support memory pools.");
+
+  cudaMemPoolProps props{};
+  props.allocType = cudaMemAllocationTypePinned;
+  props.handleTypes = cudaMemHandleTypeNone;
+  props.location.type = cudaMemLocationTypeDevice;
+  props.location.id = device_id;
+  CUDA_CALL_THROW(cudaMemPoolCreate(&pool_, &props));
+
+  uint64_t threshold = release_threshold;
+  CUDA_CALL_THROW(cudaMemPoolSetAttribute(pool_, cudaMemPoolAttrReleaseThreshold, &threshold));
+
+  stats_.bytes_limit = mem_limit == std::numeric_limits<size_t>::max() ? 0 : static_cast<int64_t>(mem_limit);
+}
+
+CUDAMemPoolAllocator::~CUDAMemPoolAllocator() {
+  // the allocator is shared by the tensors it allocated, so they are all freed by now
+  cudaMemPoolDestroy(pool_);  // do not throw error since it's OK to fail during shutdown
+}
+
+void* CUDAMemPoolAllocator::AllocOnCudaStream(size_t size, cudaStream_t stream) {
+  void* p = nullptr;
+  if (size == 0) {
+    return p;
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (size > mem_limit_ || static_cast<size_t>(stats_.bytes_in_use) > mem_limit_ - size) {
+    ORT_THROW("Available memory of ", mem_limit_ - static_cast<size_t>(stats_.bytes_in_use),
+              " is smaller than requested bytes of ", size);
+  }
+
+  CUDA_CALL_THROW(cudaMallocFromPoolAsync(&p, size, pool_, stream));
+  allocations_.emplace(p, Allocation{stream, size});
+
+  stats_.num_allocs++;
+  stats_.bytes_in_use += size;
+  stats_.total_allocated_bytes += size;
+  stats_.max_bytes_in_use = std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
+  stats_.max_alloc_size = std::max(stats_.max_alloc_size, static_cast<int64_t>(size));
+  return p;
+}
+
+void* CUDAMemPoolAllocator::Alloc(size_t size) {
+  // the memory is used without a stream, so it has to be allocated before the call returns
+  void* p = AllocOnCudaStream(size, cudaStreamPerThread);
+  if (p != nullptr) {
+    CUDA_CALL_THROW(cudaStreamSynchronize(cudaStreamPerThread));
+  }
+  return p;
+}
+
+void* CUDAMemPoolAllocator::StreamOrderedAlloc(size_t size, Stream* stream) {
+  if (stream == nullptr || stream->GetHandle() == nullptr) {
+    return Alloc(size);
+  }
+  return AllocOnCudaStream(size, static_cast<cudaStream_t>(stream->GetHandle()));
+}
+
+void CUDAMemPoolAllocator::DetachStream(Stream* stream) {
+  if (stream == nullptr || stream->GetHandle() == nullptr) {
+    return;
+  }
+
+  const auto cuda_stream = static_cast<cudaStream_t>(stream->GetHandle());
+  std::lock_guard<OrtMutex> lock(mutex_);
+  for (auto& allocation : allocations_) {
+    if (allocation.second.stream == cuda_stream) {
+      allocation.second.stream = cudaStreamPerThread;
+    }
+  }
+}
+
+void CUDAMemPoolAllocator::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = allocations_.find(p);
+  ORT_ENFORCE(it != allocations_.end(), "Freeing memory that was not allocated by ", Info().name);
+  cudaFreeAsync(p, it->second.stream);  // do not throw error since it's OK for cudaFreeAsync to fail during shutdown
+  stats_.bytes_in_use -= it->second.size;
+  allocations_.erase(it);
+}
+
+void CUDAMemPoolAllocator::GetStats(AllocatorStats* stats) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  *stats = stats_;
+}
+
 void* CUDAPinnedAllocator::Alloc(size_t size) {
   void* p = nullptr;
   if (size > 0) {
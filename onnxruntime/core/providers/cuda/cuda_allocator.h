@@ -6,6 +6,7 @@
 #include "core/common/inlined_containers.h"
 #include "core/framework/allocator.h"
 #include "core/platform/ort_mutex.h"
+#include "core/providers/cuda/cuda_pch.h"
 
 namespace onnxruntime {
 
@@ -49,6 +50,39 @@ class CUDAExternalAllocator : public CUDAAllocator {
   InlinedHashSet<void*> reserved_;
 };
 
+// Allocates device memory from a CUDA memory pool with cudaMallocFromPoolAsync instead of caching cudaMalloc
+// allocations in an arena. An allocation is ordered on the stream it is made for, and freed on that stream, so the
+// memory can be reused by the later work of the stream before the free completes on the device, and by the other
+// streams once it has completed. The pool returns the memory it holds above release_threshold to the device at
+// stream synchronizations, so other libraries in the process can use it.
+// Allocations made on a stream that is being captured in a CUDA graph become memory nodes of the graph.
+class CUDAMemPoolAllocator : public IAllocator {
+ public:
+  CUDAMemPoolAllocator(OrtDevice::DeviceId device_id, const char* name, size_t release_threshold, size_t mem_limit);
+  ~CUDAMemPoolAllocator() override;
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+  bool IsStreamOrdered() const override { return true; }
+  void* StreamOrderedAlloc(size_t size, Stream* stream) override;
+  void DetachStream(Stream* stream) override;
+  void GetStats(AllocatorStats* stats) override;
+
+ private:
+  void* AllocOnCudaStream(size_t size, cudaStream_t stream);
+
+  cudaMemPool_t pool_{};
+  const size_t mem_limit_;
+
+  OrtMutex mutex_;
+  struct Allocation {
+    cudaStream_t stream;
+    size_t size;
+  };
+  InlinedHashMap<void*, Allocation> allocations_;
+  AllocatorStats stats_;
+};
+
 // TODO: add a default constructor
 class CUDAPinnedAllocator : public IAllocator {
  public:
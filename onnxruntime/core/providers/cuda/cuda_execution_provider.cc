@@ -165,6 +165,13 @@ AllocatorPtr CUDAExecutionProvider::CreateCudaAllocator(OrtDevice::DeviceId devi
   }
 }
 
+AllocatorPtr CUDAExecutionProvider::CreateCudaMemPoolAllocator(OrtDevice::DeviceId device_id,
+                                                               size_t gpu_mem_limit,
+                                                               size_t release_threshold) {
+  // the pool caches the memory itself, so it is not wrapped in an arena
+  return std::make_shared<CUDAMemPoolAllocator>(device_id, CUDA, release_threshold, gpu_mem_limit);
+}
+
 CUDAExecutionProvider::PerThreadContext::PerThreadContext(OrtDevice::DeviceId device_id, cudaStream_t stream, size_t /*gpu_mem_limit*/,
                                                           ArenaExtendStrategy /*arena_extend_strategy*/, CUDAExecutionProviderExternalAllocatorInfo /*external_allocator_info*/,
                                                           OrtArenaCfg* /*default_memory_arena_cfg*/) {
@@ -176,8 +183,6 @@ CUDAExecutionProvider::PerThreadContext::PerThreadContext(OrtDevice::DeviceId de
 
   CUDNN_CALL_THROW(cudnnCreate(&cudnn_handle_));
   CUDNN_CALL_THROW(cudnnSetStream(cudnn_handle_, stream));
-
-  cuda_graph_.SetStream(stream);
 }
 
 CUDAExecutionProvider::PerThreadContext::~PerThreadContext() {
@@ -186,33 +191,6 @@ CUDAExecutionProvider::PerThreadContext::~PerThreadContext() {
   ORT_IGNORE_RETURN_VALUE(CUDNN_CALL(cudnnDestroy(cudnn_handle_)));
 }
 
-bool CUDAExecutionProvider::PerThreadContext::IsGraphCaptureAllowed() const {
-  return regular_run_count_before_graph_capture_ >= min_num_runs_before_cuda_graph_capture_;
-}
-
-void CUDAExecutionProvider::PerThreadContext::CaptureBegin() {
-  cuda_graph_.Reset();
-  cuda_graph_.CaptureBegin();
-}
-
-void CUDAExecutionProvider::PerThreadContext::CaptureEnd() {
-  cuda_graph_.CaptureEnd();
-  is_graph_captured_ = true;
-}
-
-bool CUDAExecutionProvider::PerThreadContext::IsGraphCaptured() const {
-  return is_graph_captured_;
-}
-
-Status CUDAExecutionProvider::PerThreadContext::ReplayGraph() {
-  ORT_ENFORCE(IsGraphCaptured());
-  return cuda_graph_.Replay();
-}
-
-void CUDAExecutionProvider::PerThreadContext::IncrementRegularRunCountBeforeGraphCapture() {
-  ++regular_run_count_before_graph_capture_;
-}
-
 void OverrideTunableOpInfoByEnv(CUDAExecutionProviderInfo& info) {
   if (auto env_tunable_op_enable = onnxruntime::ParseTestOnlyEnvironmentVariable<bool>(
           "ORT_CUDA_TUNABLE_OP_ENABLE", {"0", "1"}, "Use provider_options \"tunable_op_enable\" instead.");
@@ -269,12 +247,25 @@ CUDAExecutionProvider::CUDAExecutionProvider(const CUDAExecutionProviderInfo& in
     }
   }
 
+  if (info.enable_cuda_graph) {
+    cuda_graph_cache_ = std::make_unique<CUDAGraphCache>(stream_, static_cast<size_t>(info.cuda_graph_max_count),
+                                                         min_num_runs_before_cuda_graph_capture_);
+  }
+
   size_t free = 0;
   size_t total = 0;
   CUDA_CALL_THROW(cudaMemGetInfo(&free, &total));
 
   OverrideTunableOpInfoByEnv(info_);
 
+  if (!info_.cudnn_conv_algo_cache_path.empty()) {
+    int runtime_version = 0;
+    CUDA_CALL_THROW(cudaRuntimeGetVersion(&runtime_version));
+    auto fingerprint = MakeString("cudnn=", cudnnGetVersion(), ";cuda=", runtime_version,
+                                  ";device=", device_prop_.name, ";sm=", device_prop_.major, ".", device_prop_.minor);
+    conv_algo_cache_ = std::make_unique<cuda::CudnnConvAlgoCache>(info_.cudnn_conv_algo_cache_path, fingerprint);
+  }
+
 #ifdef USE_TRITON_KERNEL
   onnxruntime::cuda::LoadOrtTritonKernel();
 #endif
@@ -298,6 +289,13 @@ CUDAExecutionProvider::~CUDAExecutionProvider() {
   if (!external_stream_ && stream_) {
     ORT_IGNORE_RETURN_VALUE(CUDA_CALL(cudaStreamDestroy(stream_)));
   }
+
+  if (conv_algo_cache_) {
+    auto status = conv_algo_cache_->Save();
+    if (!status.IsOK()) {
+      LOGS_DEFAULT(WARNING) << "Failed to save the cuDNN conv algorithm cache: " << status.ErrorMessage();
+    }
+  }
 }
 
 ITuningContext* CUDAExecutionProvider::GetTuningContext() const {
@@ -385,23 +383,23 @@ Status CUDAExecutionProvider::Sync() const {
 Status CUDAExecutionProvider::OnRunStart() {
   // always set CUDA device when session::Run() in case it runs in a worker thread
   CUDA_RETURN_IF_ERROR(cudaSetDevice(GetDeviceId()));
-  if (IsGraphCaptureEnabled() && GetPerThreadContext().IsGraphCaptureAllowed() && !GetPerThreadContext().IsGraphCaptured()) {
-    LOGS(*GetLogger(), INFO) << "Capturing the cuda graph for this model";
-    GetPerThreadContext().CaptureBegin();
+  if (IsGraphCaptureEnabled()) {
+    auto& context = GetPerThreadContext();
+    const bool is_capturing = cuda_graph_cache_->BeginRun(context.GraphKey());
+    context.SetCapturingGraph(is_capturing);
+    if (is_capturing) {
+      LOGS(*GetLogger(), INFO) << "Capturing the cuda graph for this model with graph key " << context.GraphKey();
+    }
   }
   return Status::OK();
 }
 
 Status CUDAExecutionProvider::OnRunEnd(bool sync_stream) {
-  if (IsGraphCaptureEnabled() && !GetPerThreadContext().IsGraphCaptured()) {
-    if (GetPerThreadContext().IsGraphCaptureAllowed()) {
-      GetPerThreadContext().CaptureEnd();
-      // CUDA work issued to a capturing stream doesn’t actually run on the GPU,
-      // so run the captured graph here to actually execute the work.
-      ORT_RETURN_IF_ERROR(GetPerThreadContext().ReplayGraph());
-    } else {
-      GetPerThreadContext().IncrementRegularRunCountBeforeGraphCapture();
-    }
+  if (IsGraphCaptureEnabled()) {
+    auto& context = GetPerThreadContext();
+    const bool is_capturing = context.IsCapturingGraph();
+    context.SetCapturingGraph(false);
+    ORT_RETURN_IF_ERROR(cuda_graph_cache_->EndRun(context.GraphKey(), is_capturing));
   }
 
   if (sync_stream) {
@@ -429,12 +427,45 @@ bool CUDAExecutionProvider::IsGraphCaptureEnabled() const {
   return info_.enable_cuda_graph;
 }
 
+void CUDAExecutionProvider::SetGraphCaptureKey(int64_t graph_key) {
+  GetPerThreadContext().SetGraphKey(graph_key);
+}
+
 bool CUDAExecutionProvider::IsGraphCaptured() const {
-  return GetPerThreadContext().IsGraphCaptured();
+  return IsGraphCaptureEnabled() && cuda_graph_cache_->IsGraphCaptured(GetPerThreadContext().GraphKey());
 }
 
 Status CUDAExecutionProvider::ReplayGraph() {
-  return GetPerThreadContext().ReplayGraph();
+  ORT_RETURN_IF_NOT(IsGraphCaptureEnabled(), "CUDA graph is not enabled.");
+  return cuda_graph_cache_->Replay(GetPerThreadContext().GraphKey());
+}
+
+bool CUDAExecutionProvider::BeginGraphSegmentCapture(int64_t segment_key) {
+  if (!IsGraphCaptureEnabled() || !cuda_graph_cache_->BeginSegmentCapture(segment_key)) {
+    return false;
+  }
+  GetPerThreadContext().SetCapturingSegmentKey(segment_key);
+  return true;
+}
+
+Status CUDAExecutionProvider::EndGraphSegmentCapture(int64_t segment_key) {
+  ORT_RETURN_IF_NOT(IsGraphCaptureEnabled(), "CUDA graph is not enabled.");
+  GetPerThreadContext().SetCapturingSegmentKey(kCudaGraphKeySkip);
+  return cuda_graph_cache_->EndSegmentCapture(segment_key);
+}
+
+Status CUDAExecutionProvider::ReplayGraphSegment(int64_t segment_key) {
+  ORT_RETURN_IF_NOT(IsGraphCaptureEnabled(), "CUDA graph is not enabled.");
+  return cuda_graph_cache_->ReplaySegment(segment_key);
+}
+
+bool CUDAExecutionProvider::IsCapturingGraphSegment() const {
+  return IsGraphCaptureEnabled() && GetPerThreadContext().CapturingSegmentKey() != kCudaGraphKeySkip;
+}
+
+void CUDAExecutionProvider::RetainBufferForGraphSegment(IAllocatorUniquePtr<void>&& buffer) const {
+  ORT_ENFORCE(IsCapturingGraphSegment(), "No CUDA graph segment is being captured by this thread.");
+  cuda_graph_cache_->RetainSegmentBuffer(GetPerThreadContext().CapturingSegmentKey(), std::move(buffer));
 }
 
 namespace cuda {
@@ -2488,8 +2519,10 @@ std::vector<AllocatorPtr> CUDAExecutionProvider::CreatePreferredAllocators() {
       // at the risk the lifetime isn't managed correctly if one of those devices go away.
       0);
   return std::vector<AllocatorPtr>{
-      CreateCudaAllocator(info_.device_id, info_.gpu_mem_limit, info_.arena_extend_strategy,
-                          info_.external_allocator_info, info_.default_memory_arena_cfg),
+      info_.use_cuda_mempool && !info_.external_allocator_info.UseExternalAllocator()
+          ? CreateCudaMemPoolAllocator(info_.device_id, info_.gpu_mem_limit, info_.cuda_mempool_release_threshold)
+          : CreateCudaAllocator(info_.device_id, info_.gpu_mem_limit, info_.arena_extend_strategy,
+                                info_.external_allocator_info, info_.default_memory_arena_cfg),
       CreateAllocator(pinned_memory_info),
   };
 }
@@ -13,6 +13,7 @@
 #include "core/providers/cuda/cuda_execution_provider_info.h"
 #include "core/providers/cuda/cuda_graph.h"
 #include "core/providers/cuda/cuda_pch.h"
+#include "core/providers/cuda/cudnn_conv_algo_cache.h"
 #include "core/providers/cuda/shared_inc/cuda_utils.h"
 #include "core/providers/cuda/shared_inc/cuda_call.h"
 #include "core/providers/cuda/tunable/cuda_tuning_context.h"
@@ -78,6 +79,8 @@ class CUDAExecutionProvider : public IExecutionProvider {
   bool GetCudnnConv1dPadToNc1d() const { return info_.cudnn_conv1d_pad_to_nc1d; }
   bool IsSkipLayerNormInStrictMode() const { return info_.enable_skip_layer_norm_strict_mode; }
   bool IsNHWCPreferred() const { return info_.prefer_nhwc; }
+  // nullptr unless the cudnn_conv_algo_cache_path option is set
+  cuda::CudnnConvAlgoCache* GetCudnnConvAlgoCache() const { return conv_algo_cache_.get(); }
 
   ProviderOptions GetProviderOptions() const override {
     return CUDAExecutionProviderInfo::ToProviderOptions(info_);
@@ -85,14 +88,27 @@ class CUDAExecutionProvider : public IExecutionProvider {
 
   static AllocatorPtr CreateCudaAllocator(OrtDevice::DeviceId device_id, size_t cuda_mem_limit, ArenaExtendStrategy arena_extend_strategy,
                                           CUDAExecutionProviderExternalAllocatorInfo external_alloc_info, const OrtArenaCfg* arena_cfg);
+  static AllocatorPtr CreateCudaMemPoolAllocator(OrtDevice::DeviceId device_id, size_t cuda_mem_limit,
+                                                 size_t release_threshold);
 
   ITuningContext* GetTuningContext() const override;
 
   std::unique_ptr<profiling::EpProfiler> GetProfiler() override;
 
   bool IsGraphCaptureEnabled() const override;
+  void SetGraphCaptureKey(int64_t graph_key) override;
   bool IsGraphCaptured() const override;
   Status ReplayGraph() override;
+  bool BeginGraphSegmentCapture(int64_t segment_key) override;
+  Status EndGraphSegmentCapture(int64_t segment_key) override;
+  Status ReplayGraphSegment(int64_t segment_key) override;
+
+  size_t GetWeightStreamingBudget() const override { return info_.weight_streaming_budget; }
+
+  // Whether the current thread captures a graph segment, whose buffers must live as long as the segment.
+  bool IsCapturingGraphSegment() const;
+  // Keeps a buffer alive as long as the graph segment that the current thread captures.
+  void RetainBufferForGraphSegment(IAllocatorUniquePtr<void>&& buffer) const;
   void RegisterStreamHandlers(IStreamCommandHandleRegistry& stream_handle_registry, AllocatorMap& allocators) const override;
   OrtDevice GetOrtDeviceByMemType(OrtMemType mem_type) const override;
   std::vector<AllocatorPtr> CreatePreferredAllocators() override;
@@ -109,6 +125,17 @@ class CUDAExecutionProvider : public IExecutionProvider {
   // the tuning context might be altered when calling into a TunableOp
   mutable cuda::tunable::CudaTuningContext tuning_context_;
 
+  std::unique_ptr<cuda::CudnnConvAlgoCache> conv_algo_cache_;
+
+  // The captured graphs of all threads, which run on the EP level stream. Only set if cuda graph is enabled.
+  std::unique_ptr<CUDAGraphCache> cuda_graph_cache_;
+
+  // There is chance that the second regular run allocates GPU memory for causes like:
+  // (1) memory pattern is enabled. (2) arena allocation for stream.
+  // Since no GPU memory allocation is allowed during graph capturing, we need at least two regular runs
+  // to allocate enough memory in Arena before graph capturing.
+  static constexpr int min_num_runs_before_cuda_graph_capture_ = 2;  // required min regular runs of a graph key before its capture.
+
   class PerThreadContext final {
    public:
     PerThreadContext(OrtDevice::DeviceId device_id, cudaStream_t stream, size_t cuda_mem_limit, ArenaExtendStrategy arena_extend_strategy,
@@ -174,12 +201,14 @@ class CUDAExecutionProvider : public IExecutionProvider {
       }
     }
 
-    bool IsGraphCaptureAllowed() const;
-    void CaptureBegin();
-    void CaptureEnd();
-    bool IsGraphCaptured() const;
-    Status ReplayGraph();
-    void IncrementRegularRunCountBeforeGraphCapture();
+    CudaGraphKey_t GraphKey() const { return graph_key_; }
+    void SetGraphKey(CudaGraphKey_t graph_key) { graph_key_ = graph_key; }
+
+    bool IsCapturingGraph() const { return is_capturing_graph_; }
+    void SetCapturingGraph(bool is_capturing_graph) { is_capturing_graph_ = is_capturing_graph; }
+
+    CudaGraphKey_t CapturingSegmentKey() const { return capturing_segment_key_; }
+    void SetCapturingSegmentKey(CudaGraphKey_t segment_key) { capturing_segment_key_ = segment_key; }
 
    private:
     cublasHandle_t cublas_handle_ = nullptr;
@@ -195,17 +224,11 @@ class CUDAExecutionProvider : public IExecutionProvider {
     std::unique_ptr<cuda::IConstantBuffer<Float8E5M2>> constant_ones_float8e5m2_;
 #endif
 
-    // Cuda graph with multi threads will be supported in the future, so cuda_graph_
-    // is put under PerThreadContext.
-    CUDAGraph cuda_graph_;
-    bool is_graph_captured_ = false;
-    int regular_run_count_before_graph_capture_ = 0;
-
-    // There is chance that the second regular run allocates GPU memory for causes like:
-    // (1) memory pattern is enabled. (2) arena allocation for stream.
-    // Since no GPU memory allocation is allowed during graph capturing, we need at least two regular runs
-    // to allocate enough memory in Arena before graph capturing.
-    const int min_num_runs_before_cuda_graph_capture_ = 2;  // required min regular runs before graph capture for the necessary memory allocations.
+    // The graph that the runs of this thread capture and replay.
+    CudaGraphKey_t graph_key_ = 0;
+    bool is_capturing_graph_ = false;
+    // the graph segment of a run that this thread captures
+    CudaGraphKey_t capturing_segment_key_ = kCudaGraphKeySkip;
   };
 
   using PerThreadContextMap = std::unordered_map<const CUDAExecutionProvider*, std::weak_ptr<PerThreadContext>>;
@@ -25,7 +25,12 @@ constexpr const char* kGpuExternalFree = "gpu_external_free";
 constexpr const char* kGpuExternalEmptyCache = "gpu_external_empty_cache";
 constexpr const char* kCudnnConvUseMaxWorkspace = "cudnn_conv_use_max_workspace";
 constexpr const char* kEnableCudaGraph = "enable_cuda_graph";
+constexpr const char* kCudaGraphMaxCount = "cuda_graph_max_count";
+constexpr const char* kUseCudaMempool = "use_cuda_mempool";
+constexpr const char* kCudaMempoolReleaseThreshold = "cuda_mempool_release_threshold";
+constexpr const char* kWeightStreamingBudget = "weight_streaming_budget";
 constexpr const char* kCudnnConv1dPadToNc1d = "cudnn_conv1d_pad_to_nc1d";
+constexpr const char* kCudnnConvAlgoCachePath = "cudnn_conv_algo_cache_path";
 constexpr const char* kTunableOpEnable = "tunable_op_enable";
 constexpr const char* kTunableOpTuningEnable = "tunable_op_tuning_enable";
 constexpr const char* kTunableOpMaxTuningDurationMs = "tunable_op_max_tuning_duration_ms";
@@ -100,7 +105,19 @@ CUDAExecutionProviderInfo CUDAExecutionProviderInfo::FromProviderOptions(const P
           .AddAssignmentToReference(cuda::provider_option_names::kDoCopyInDefaultStream, info.do_copy_in_default_stream)
           .AddAssignmentToReference(cuda::provider_option_names::kCudnnConvUseMaxWorkspace, info.cudnn_conv_use_max_workspace)
           .AddAssignmentToReference(cuda::provider_option_names::kEnableCudaGraph, info.enable_cuda_graph)
+          .AddValueParser(
+              cuda::provider_option_names::kCudaGraphMaxCount,
+              [&info](const std::string& value_str) -> Status {
+                ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(value_str, info.cuda_graph_max_count));
+                ORT_RETURN_IF_NOT(info.cuda_graph_max_count > 0, "cuda_graph_max_count must be positive.");
+                return Status::OK();
+              })
+          .AddAssignmentToReference(cuda::provider_option_names::kUseCudaMempool, info.use_cuda_mempool)
+          .AddAssignmentToReference(cuda::provider_option_names::kCudaMempoolReleaseThreshold,
+                                    info.cuda_mempool_release_threshold)
+          .AddAssignmentToReference(cuda::provider_option_names::kWeightStreamingBudget, info.weight_streaming_budget)
           .AddAssignmentToReference(cuda::provider_option_names::kCudnnConv1dPadToNc1d, info.cudnn_conv1d_pad_to_nc1d)
+          .AddAssignmentToReference(cuda::provider_option_names::kCudnnConvAlgoCachePath, info.cudnn_conv_algo_cache_path)
           .AddAssignmentToReference(cuda::provider_option_names::kEnableSkipLayerNormStrictMode, info.enable_skip_layer_norm_strict_mode)
           .AddAssignmentToReference(cuda::provider_option_names::kPreferNCHWMode, info.prefer_nhwc)
           .AddAssignmentToReference(cuda::provider_option_names::KUseEPLevelUnifiedStream, info.use_ep_level_unified_stream)
@@ -144,7 +161,13 @@ ProviderOptions CUDAExecutionProviderInfo::ToProviderOptions(const CUDAExecution
       {cuda::provider_option_names::kDoCopyInDefaultStream, MakeStringWithClassicLocale(info.do_copy_in_default_stream)},
       {cuda::provider_option_names::kCudnnConvUseMaxWorkspace, MakeStringWithClassicLocale(info.cudnn_conv_use_max_workspace)},
       {cuda::provider_option_names::kEnableCudaGraph, MakeStringWithClassicLocale(info.enable_cuda_graph)},
+      {cuda::provider_option_names::kCudaGraphMaxCount, MakeStringWithClassicLocale(info.cuda_graph_max_count)},
+      {cuda::provider_option_names::kUseCudaMempool, MakeStringWithClassicLocale(info.use_cuda_mempool)},
+      {cuda::provider_option_names::kCudaMempoolReleaseThreshold,
+       MakeStringWithClassicLocale(info.cuda_mempool_release_threshold)},
+      {cuda::provider_option_names::kWeightStreamingBudget, MakeStringWithClassicLocale(info.weight_streaming_budget)},
       {cuda::provider_option_names::kCudnnConv1dPadToNc1d, MakeStringWithClassicLocale(info.cudnn_conv1d_pad_to_nc1d)},
+      {cuda::provider_option_names::kCudnnConvAlgoCachePath, info.cudnn_conv_algo_cache_path},
       {cuda::provider_option_names::kTunableOpEnable, MakeStringWithClassicLocale(info.tunable_op.enable)},
       {cuda::provider_option_names::kTunableOpTuningEnable, MakeStringWithClassicLocale(info.tunable_op.tuning_enable)},
       {cuda::provider_option_names::kTunableOpMaxTuningDurationMs, MakeStringWithClassicLocale(info.tunable_op.max_tuning_duration_ms)},
@@ -166,11 +189,18 @@ ProviderOptions CUDAExecutionProviderInfo::ToProviderOptions(const OrtCUDAProvid
       {cuda::provider_option_names::kDoCopyInDefaultStream, MakeStringWithClassicLocale(info.do_copy_in_default_stream)},
       {cuda::provider_option_names::kCudnnConvUseMaxWorkspace, MakeStringWithClassicLocale(info.cudnn_conv_use_max_workspace)},
       {cuda::provider_option_names::kCudnnConv1dPadToNc1d, MakeStringWithClassicLocale(info.cudnn_conv1d_pad_to_nc1d)},
+      {cuda::provider_option_names::kCudnnConvAlgoCachePath,
+       info.cudnn_conv_algo_cache_path != nullptr ? info.cudnn_conv_algo_cache_path : ""},
       {cuda::provider_option_names::kTunableOpEnable, MakeStringWithClassicLocale(info.tunable_op_enable)},
       {cuda::provider_option_names::kTunableOpTuningEnable, MakeStringWithClassicLocale(info.tunable_op_tuning_enable)},
       {cuda::provider_option_names::kTunableOpMaxTuningDurationMs, MakeStringWithClassicLocale(info.tunable_op_max_tuning_duration_ms)},
       {cuda::provider_option_names::kPreferNCHWMode, MakeStringWithClassicLocale(info.prefer_nhwc)},
       {cuda::provider_option_names::KUseEPLevelUnifiedStream, MakeStringWithClassicLocale(info.use_ep_level_unified_stream)},
+      {cuda::provider_option_names::kCudaGraphMaxCount, MakeStringWithClassicLocale(info.cuda_graph_max_count)},
+      {cuda::provider_option_names::kUseCudaMempool, MakeStringWithClassicLocale(info.use_cuda_mempool)},
+      {cuda::provider_option_names::kCudaMempoolReleaseThreshold,
+       MakeStringWithClassicLocale(info.cuda_mempool_release_threshold)},
+      {cuda::provider_option_names::kWeightStreamingBudget, MakeStringWithClassicLocale(info.weight_streaming_budget)},
   };
 
   return options;
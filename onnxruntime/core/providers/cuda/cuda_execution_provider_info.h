@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <limits>
+#include <string>
 
 #include "core/common/hash_combine.h"
 #include "core/framework/arena_extend_strategy.h"
@@ -65,10 +66,28 @@ struct CUDAExecutionProviderInfo {
   bool cudnn_conv_use_max_workspace{true};
 
   bool enable_cuda_graph{false};
+  // The max number of graphs captured for runs with different input shapes or graph ids when enable_cuda_graph is
+  // set. The least recently used graph is released when a new one is captured.
+  int cuda_graph_max_count{8};
+
+  // Allocate the device memory from a CUDA memory pool with cudaMallocAsync instead of the arena. The pool keeps up
+  // to cuda_mempool_release_threshold bytes it doesn't use, and returns the rest to the device at synchronizations.
+  // gpu_mem_limit applies to the pool, the arena settings in default_memory_arena_cfg don't.
+  bool use_cuda_mempool{false};
+  size_t cuda_mempool_release_threshold{std::numeric_limits<size_t>::max()};
+
+  // Keep the initializers beyond weight_streaming_budget bytes of device memory in pinned host memory, and copy each
+  // to the device on a side stream while the node before the one that reads it computes. 0 keeps all of them on the
+  // device.
+  size_t weight_streaming_budget{0};
 
   // By default, for Conv1D, will pad [N,C,D] to [N,C,D,1], if turn on, will pad to [N,C,1,D].
   bool cudnn_conv1d_pad_to_nc1d{false};
 
+  // File of the algorithms found by the exhaustive conv algo search. It is read when the provider is created and
+  // rewritten with the new algorithms when it is destroyed. Empty to search in every process.
+  std::string cudnn_conv_algo_cache_path{};
+
   cuda::TunableOpInfo tunable_op{};
 
   bool enable_skip_layer_norm_strict_mode{false};
@@ -22,11 +22,9 @@ void CUDAGraph::CaptureBegin() {
               "Create a new instance to capture a new graph.");
 
   CUDA_CALL_THROW(cudaStreamSynchronize(stream_));
-  // For now cuda graph can only work with a single thread. In the future, we
-  // will support multiple threads. For multiple threads with multiple graphs
-  // and streams, `cudaStreamCaptureModeGlobal` needs to be changed to
-  // `cudaStreamCaptureModeThreadLocal`
-  CUDA_CALL_THROW(cudaStreamBeginCapture(stream_, cudaStreamCaptureModeGlobal));
+  // Only the capturing thread is restricted in the CUDA calls it may make, so
+  // other threads, e.g. of other sessions, can keep allocating memory.
+  CUDA_CALL_THROW(cudaStreamBeginCapture(stream_, cudaStreamCaptureModeThreadLocal));
 }
 
 void CUDAGraph::CaptureEnd() {
@@ -36,21 +34,29 @@ void CUDAGraph::CaptureEnd() {
   }
 
   has_graph_ = true;
-  CUDA_CALL_THROW(cudaGraphInstantiate(&graph_exec_, graph_, NULL, NULL, 0));
+  // the allocations made on the stream during the capture with a stream ordered allocator are memory nodes of the
+  // graph, the ones that are not freed in the graph are freed when it is launched again
+  CUDA_CALL_THROW(cudaGraphInstantiateWithFlags(&graph_exec_, graph_, cudaGraphInstantiateFlagAutoFreeOnLaunch));
   has_graph_exec_ = true;
   CUDA_CALL_THROW(cudaGraphDestroy(graph_));
   has_graph_ = false;
 }
 
-Status CUDAGraph::Replay() {
+Status CUDAGraph::Replay(bool sync) {
   // Although this function is not thread safe, the lock is not needed here because
   // CUDA EP maintains a separate cuda graph per thread
   LOGS_DEFAULT(INFO) << "Replaying CUDA graph on stream " << stream_;
   CUDA_RETURN_IF_ERROR(cudaGraphLaunch(graph_exec_, stream_));
-  CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream_));
+  if (sync) {
+    CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream_));
+  }
   return Status::OK();
 }
 
+void CUDAGraph::RetainBuffer(IAllocatorUniquePtr<void>&& buffer) {
+  retained_buffers_.push_back(std::move(buffer));
+}
+
 void CUDAGraph::Reset() {
   if (has_graph_) {
     CUDA_CALL_THROW(cudaGraphDestroy(graph_));
@@ -64,6 +70,196 @@ void CUDAGraph::Reset() {
 
 CUDAGraph::~CUDAGraph() {
   Reset();
+  // the graph doesn't use the retained buffers any more
+  retained_buffers_.clear();
+}
+
+CUDAGraphCache::CUDAGraphCache(cudaStream_t stream, size_t max_graphs, int min_runs_before_capture)
+    : stream_(stream), max_graphs_(max_graphs), min_runs_before_capture_(min_runs_before_capture) {
+  ORT_ENFORCE(max_graphs_ > 0, "The CUDA graph cache must hold at least one graph.");
+}
+
+std::shared_ptr<CUDAGraph> CUDAGraphCache::FindGraph(CudaGraphKey_t key) const {
+  for (auto it = graphs_.begin(); it != graphs_.end(); ++it) {
+    if (it->first == key) {
+      // move to the front of the least recently used order
+      graphs_.splice(graphs_.begin(), graphs_, it);
+      return graphs_.front().second;
+    }
+  }
+  return nullptr;
+}
+
+bool CUDAGraphCache::BeginRun(CudaGraphKey_t key) {
+  std::unique_lock<OrtMutex> lock(mutex_);
+  stream_available_.wait(lock, [this]() { return !is_capturing_; });
+
+  if (key == kCudaGraphKeySkip || FindGraph(key) != nullptr) {
+    ++active_runs_;
+    return false;
+  }
+
+  auto count_it = regular_run_counts_.find(key);
+  if (count_it == regular_run_counts_.end() || count_it->second < min_runs_before_capture_) {
+    ++active_runs_;
+    return false;
+  }
+
+  // The capture needs the stream to itself.
+  is_capturing_ = true;
+  capturing_key_ = key;
+  stream_available_.wait(lock, [this]() { return active_runs_ == 0; });
+  regular_run_counts_.erase(count_it);
+
+  if (graphs_.size() >= max_graphs_) {
+    LOGS_DEFAULT(INFO) << "Releasing the least recently used CUDA graph to capture a new one";
+    graphs_.pop_back();
+  }
+
+  auto graph = std::make_shared<CUDAGraph>(stream_);
+  ORT_TRY {
+    graph->CaptureBegin();
+  }
+  ORT_CATCH(const std::exception&) {
+    is_capturing_ = false;
+    stream_available_.notify_all();
+    ORT_RETHROW;
+  }
+  graphs_.emplace_front(key, std::move(graph));
+  return true;
+}
+
+Status CUDAGraphCache::EndRun(CudaGraphKey_t key, bool is_capturing) {
+  std::shared_ptr<CUDAGraph> graph;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    if (!is_capturing) {
+      --active_runs_;
+      if (key != kCudaGraphKeySkip && FindGraph(key) == nullptr) {
+        // Bound the counts of keys that are seen once, e.g. of rarely recurring shapes.
+        if (regular_run_counts_.size() >= 16 * max_graphs_ && regular_run_counts_.count(key) == 0) {
+          regular_run_counts_.clear();
+        }
+        ++regular_run_counts_[key];
+      }
+      stream_available_.notify_all();
+      return Status::OK();
+    }
+    graph = FindGraph(key);
+  }
+
+  // CUDA work issued to a capturing stream doesn't actually run on the GPU,
+  // so run the captured graph here to actually execute the work.
+  Status status;
+  ORT_TRY {
+    graph->CaptureEnd();
+    status = graph->Replay();
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "CUDA graph capture failed: ", ex.what());
+    });
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (!status.IsOK()) {
+    graphs_.remove_if([&graph](const auto& entry) { return entry.second == graph; });
+  }
+  is_capturing_ = false;
+  stream_available_.notify_all();
+  return status;
+}
+
+bool CUDAGraphCache::IsGraphCaptured(CudaGraphKey_t key) const {
+  if (key == kCudaGraphKeySkip) {
+    return false;
+  }
+  std::lock_guard<OrtMutex> lock(mutex_);
+  // a graph being captured is not ready to replay
+  return !(is_capturing_ && capturing_key_ == key) && FindGraph(key) != nullptr;
+}
+
+Status CUDAGraphCache::Replay(CudaGraphKey_t key) {
+  std::shared_ptr<CUDAGraph> graph;
+  {
+    std::unique_lock<OrtMutex> lock(mutex_);
+    stream_available_.wait(lock, [this]() { return !is_capturing_; });
+    graph = FindGraph(key);
+    ORT_RETURN_IF(graph == nullptr, "No CUDA graph was captured for graph key ", key);
+    ++active_runs_;
+  }
+
+  // The graph is shared, so it stays valid if another thread releases it from the cache meanwhile.
+  Status status = graph->Replay();
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  --active_runs_;
+  stream_available_.notify_all();
+  return status;
+}
+
+bool CUDAGraphCache::BeginSegmentCapture(CudaGraphKey_t segment_key) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  // the caller's run is the only one using the stream
+  if (is_capturing_ || active_runs_ != 1 || segments_.count(segment_key) > 0) {
+    return false;
+  }
+
+  auto graph = std::make_shared<CUDAGraph>(stream_);
+  ORT_TRY {
+    graph->CaptureBegin();
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      LOGS_DEFAULT(WARNING) << "Failed to begin the capture of CUDA graph segment " << segment_key << ": " << ex.what();
+    });
+    return false;
+  }
+
+  is_capturing_ = true;
+  capturing_key_ = segment_key;
+  segments_.emplace(segment_key, std::move(graph));
+  return true;
+}
+
+Status CUDAGraphCache::EndSegmentCapture(CudaGraphKey_t segment_key) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  ORT_RETURN_IF_NOT(is_capturing_ && capturing_key_ == segment_key, "CUDA graph segment ", segment_key,
+                    " is not being captured.");
+
+  Status status;
+  ORT_TRY {
+    segments_.at(segment_key)->CaptureEnd();
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "CUDA graph segment capture failed: ", ex.what());
+    });
+  }
+
+  if (!status.IsOK()) {
+    segments_.erase(segment_key);
+  }
+  is_capturing_ = false;
+  capturing_key_ = kCudaGraphKeySkip;
+  stream_available_.notify_all();
+  return status;
+}
+
+void CUDAGraphCache::RetainSegmentBuffer(CudaGraphKey_t segment_key, IAllocatorUniquePtr<void>&& buffer) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  segments_.at(segment_key)->RetainBuffer(std::move(buffer));
+}
+
+Status CUDAGraphCache::ReplaySegment(CudaGraphKey_t segment_key) {
+  std::shared_ptr<CUDAGraph> graph;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = segments_.find(segment_key);
+    ORT_RETURN_IF(it == segments_.end(), "No CUDA graph segment was captured for segment key ", segment_key);
+    graph = it->second;
+  }
+  return graph->Replay(/*sync*/ false);
 }
 
 }  // namespace onnxruntime
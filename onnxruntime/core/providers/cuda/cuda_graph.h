@@ -3,7 +3,13 @@
 
 #pragma once
 
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 #include "core/common/common.h"
+#include "core/framework/allocator.h"
 #include "core/platform/ort_mutex.h"
 #include "core/providers/cuda/cuda_pch.h"
 
@@ -11,6 +17,11 @@ namespace onnxruntime {
 
 using CaptureId_t = unsigned long long;
 
+// Identifies one of the captured graphs of a model, either a user supplied graph id or a signature of the input shapes.
+using CudaGraphKey_t = int64_t;
+// Runs with this key are neither captured nor replayed.
+constexpr CudaGraphKey_t kCudaGraphKeySkip = -1;
+
 struct CUDAGraph {
   CUDAGraph(){};
   CUDAGraph(cudaStream_t stream);
@@ -19,9 +30,13 @@ struct CUDAGraph {
   void SetStream(cudaStream_t stream);
   void CaptureBegin();
   void CaptureEnd();
-  Status Replay();
+  // sync waits for the replayed work to complete
+  Status Replay(bool sync = true);
   void Reset();
 
+  // Keeps a buffer that the captured work uses, e.g. a scratch buffer of a kernel, as long as the graph.
+  void RetainBuffer(IAllocatorUniquePtr<void>&& buffer);
+
  private:
   cudaGraph_t graph_ = NULL;
   cudaGraphExec_t graph_exec_ = NULL;
@@ -30,6 +45,77 @@ struct CUDAGraph {
   bool has_graph_exec_ = false;
 
   cudaStream_t stream_ = nullptr;  // Does not own the stream
+
+  std::vector<IAllocatorUniquePtr<void>> retained_buffers_;
+};
+
+/**
+ * A bounded cache of captured graphs, one per key, for a model with dynamic input shapes.
+ *
+ * Runs of a key that has no graph yet run regularly until the key has been seen min_runs_before_capture times, so
+ * that the arena holds all the memory the run needs, and the next run of the key is captured. When the cache is full,
+ * the least recently used graph is released to make room for the new one.
+ *
+ * The cache is shared by all threads that run the model on the same stream. The graphs take their intermediate
+ * buffers from the same arena, so a capture has exclusive use of the stream: it waits for the runs and replays of the
+ * other threads to finish, and new ones wait for the capture. Replays are serialized by the stream, so no two graphs
+ * use the shared buffers at the same time.
+ */
+class CUDAGraphCache {
+ public:
+  CUDAGraphCache(cudaStream_t stream, size_t max_graphs, int min_runs_before_capture);
+
+  /**
+   * Starts a regular run of the model with the given key.
+   * @return true if the run is to be captured, which must be ended by EndRun before the next run of this thread.
+   */
+  bool BeginRun(CudaGraphKey_t key);
+
+  /**
+   * Ends a run started by BeginRun. A captured run is instantiated and replayed, as the captured work has not run yet.
+   */
+  Status EndRun(CudaGraphKey_t key, bool is_capturing);
+
+  bool IsGraphCaptured(CudaGraphKey_t key) const;
+
+  Status Replay(CudaGraphKey_t key);
+
+  /**
+   * Starts capturing a graph segment of a run, see GraphSegmentCapture. The run of the caller is active already, so
+   * rather than waiting for the other runs to finish, which might wait for this one, the capture is only started when
+   * there are none.
+   * @return false if the capture can't start now.
+   */
+  bool BeginSegmentCapture(CudaGraphKey_t segment_key);
+
+  // Ends the capture started by BeginSegmentCapture. The segment is discarded if the capture failed.
+  Status EndSegmentCapture(CudaGraphKey_t segment_key);
+
+  // Keeps a buffer that the graph segment being captured uses as long as the segment.
+  void RetainSegmentBuffer(CudaGraphKey_t segment_key, IAllocatorUniquePtr<void>&& buffer);
+
+  // Launches a captured graph segment without waiting for it to complete.
+  Status ReplaySegment(CudaGraphKey_t segment_key);
+
+ private:
+  std::shared_ptr<CUDAGraph> FindGraph(CudaGraphKey_t key) const;
+
+  cudaStream_t stream_;  // Does not own the stream
+  const size_t max_graphs_;
+  const int min_runs_before_capture_;
+
+  mutable OrtMutex mutex_;
+  OrtCondVar stream_available_;
+  bool is_capturing_ = false;
+  CudaGraphKey_t capturing_key_ = kCudaGraphKeySkip;
+  int active_runs_ = 0;  // regular runs and replays that issue work to the stream
+
+  // most recently used graph first
+  mutable std::list<std::pair<CudaGraphKey_t, std::shared_ptr<CUDAGraph>>> graphs_;
+  std::unordered_map<CudaGraphKey_t, int> regular_run_counts_;
+
+  // the segments are kept as long as the model, as their buffers are
+  std::unordered_map<CudaGraphKey_t, std::shared_ptr<CUDAGraph>> segments_;
 };
 
 }  // namespace onnxruntime
@@ -42,7 +42,16 @@ class CudaKernel : public OpKernel {
   template <typename T>
   inline IAllocatorUniquePtr<T> GetScratchBuffer(size_t count_or_bytes, onnxruntime::Stream* stream) const {
     if (count_or_bytes == 0) return nullptr;
-    return IAllocator::MakeUniquePtr<T>(Info().GetAllocator(OrtMemType::OrtMemTypeDefault), count_or_bytes, false, stream, WaitCudaNotificationOnDevice);
+    auto buffer = IAllocator::MakeUniquePtr<T>(Info().GetAllocator(OrtMemType::OrtMemTypeDefault), count_or_bytes, false, stream, WaitCudaNotificationOnDevice);
+    if (provider_->IsCapturingGraphSegment()) {
+      // the captured graph segment keeps using the buffer after the kernel, so the segment owns it
+      T* p = buffer.get();
+      auto deleter = buffer.get_deleter();
+      provider_->RetainBufferForGraphSegment(
+          IAllocatorUniquePtr<void>{buffer.release(), [deleter = std::move(deleter)](void* ptr) { deleter(static_cast<T*>(ptr)); }});
+      return IAllocatorUniquePtr<T>{p, [](T*) {}};
+    }
+    return buffer;
   }
 
   // Different from GetScratchBuffer which use IAllocator::Alloc() to allocate memory,
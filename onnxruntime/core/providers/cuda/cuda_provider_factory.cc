@@ -218,6 +218,10 @@ struct CUDA_Provider : Provider {
     info.default_memory_arena_cfg = params->default_memory_arena_cfg;
     info.cudnn_conv_use_max_workspace = params->cudnn_conv_use_max_workspace != 0;
     info.enable_cuda_graph = params->enable_cuda_graph != 0;
+    info.cuda_graph_max_count = params->cuda_graph_max_count;
+    info.use_cuda_mempool = params->use_cuda_mempool != 0;
+    info.cuda_mempool_release_threshold = params->cuda_mempool_release_threshold;
+    info.weight_streaming_budget = params->weight_streaming_budget;
     info.prefer_nhwc = params->prefer_nhwc;
     info.cudnn_conv1d_pad_to_nc1d = params->cudnn_conv1d_pad_to_nc1d != 0;
     info.tunable_op.enable = params->tunable_op_enable;
@@ -225,6 +229,7 @@ struct CUDA_Provider : Provider {
     info.tunable_op.max_tuning_duration_ms = params->tunable_op_max_tuning_duration_ms;
     info.enable_skip_layer_norm_strict_mode = params->enable_skip_layer_norm_strict_mode != 0;
     info.use_ep_level_unified_stream = params->use_ep_level_unified_stream != 0;
+    info.cudnn_conv_algo_cache_path = params->cudnn_conv_algo_cache_path != nullptr ? params->cudnn_conv_algo_cache_path : "";
 
     return std::make_shared<CUDAProviderFactory>(info);
   }
@@ -254,10 +259,24 @@ struct CUDA_Provider : Provider {
     cuda_options.default_memory_arena_cfg = internal_options.default_memory_arena_cfg;
     cuda_options.cudnn_conv_use_max_workspace = internal_options.cudnn_conv_use_max_workspace;
     cuda_options.enable_cuda_graph = internal_options.enable_cuda_graph;
+    cuda_options.cuda_graph_max_count = internal_options.cuda_graph_max_count;
+    cuda_options.use_cuda_mempool = internal_options.use_cuda_mempool;
+    cuda_options.cuda_mempool_release_threshold = internal_options.cuda_mempool_release_threshold;
+    cuda_options.weight_streaming_budget = internal_options.weight_streaming_budget;
     cuda_options.cudnn_conv1d_pad_to_nc1d = internal_options.cudnn_conv1d_pad_to_nc1d;
     cuda_options.enable_skip_layer_norm_strict_mode = internal_options.enable_skip_layer_norm_strict_mode;
     cuda_options.prefer_nhwc = internal_options.prefer_nhwc;
     cuda_options.use_ep_level_unified_stream = internal_options.use_ep_level_unified_stream;
+
+    // the string is released by ReleaseCUDAProviderOptions()
+    delete[] cuda_options.cudnn_conv_algo_cache_path;
+    cuda_options.cudnn_conv_algo_cache_path = nullptr;
+    const auto& cache_path = internal_options.cudnn_conv_algo_cache_path;
+    if (!cache_path.empty()) {
+      char* dest = new char[cache_path.size() + 1];
+      std::memcpy(dest, cache_path.c_str(), cache_path.size() + 1);
+      cuda_options.cudnn_conv_algo_cache_path = dest;
+    }
   }
 
   ProviderOptions GetProviderOptions(const void* provider_options) override {
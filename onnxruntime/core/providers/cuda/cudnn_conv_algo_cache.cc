@@ -0,0 +1,116 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/shared_library/provider_api.h"
+#include "core/providers/cuda/cudnn_conv_algo_cache.h"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+namespace onnxruntime {
+namespace cuda {
+
+/*
+File layout, one text line each:
+  "ORTCUDNNCONV1"
+  fingerprint
+  key algo memory math_type, for each entry
+*/
+namespace {
+constexpr const char* kMagic = "ORTCUDNNCONV1";
+}  // namespace
+
+CudnnConvAlgoCache::CudnnConvAlgoCache(std::string path, std::string fingerprint)
+    : path_(std::move(path)), fingerprint_(std::move(fingerprint)) {
+  std::ifstream in(path_);
+  if (!in) {
+    return;
+  }
+
+  std::string magic, fingerprint_in_file;
+  if (!std::getline(in, magic) || magic != kMagic || !std::getline(in, fingerprint_in_file)) {
+    LOGS_DEFAULT(WARNING) << "Ignoring cuDNN conv algorithm cache " << path_ << ": not a cache file";
+    return;
+  }
+  if (fingerprint_in_file != fingerprint_) {
+    LOGS_DEFAULT(WARNING) << "Ignoring cuDNN conv algorithm cache " << path_ << ": it was written for "
+                          << fingerprint_in_file << ", this process runs with " << fingerprint_;
+    return;
+  }
+
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream ss(line);
+    std::string key;
+    Entry entry{};
+    if (!(ss >> key >> entry.algo >> entry.memory >> entry.math_type)) {
+      LOGS_DEFAULT(WARNING) << "Ignoring cuDNN conv algorithm cache " << path_ << ": malformed entry " << line;
+      entries_.clear();
+      return;
+    }
+    entries_[key] = entry;
+  }
+}
+
+bool CudnnConvAlgoCache::Find(const std::string& key, Entry& entry) const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return false;
+  }
+  entry = it->second;
+  return true;
+}
+
+void CudnnConvAlgoCache::Insert(const std::string& key, const Entry& entry) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  entries_[key] = entry;
+  dirty_ = true;
+}
+
+Status CudnnConvAlgoCache::Save() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (!dirty_) {
+    return Status::OK();
+  }
+
+  // other processes may save the same file, each writes its own temporary file
+  const std::string tmp_path = path_ + ".tmp" + std::to_string(std::random_device{}());
+  {
+    std::ofstream out(tmp_path, std::ios::trunc);
+    ORT_RETURN_IF_NOT(out, "Failed to open ", tmp_path, " for writing");
+    out << kMagic << "\n"
+        << fingerprint_ << "\n";
+    for (const auto& [key, entry] : entries_) {
+      out << key << " " << entry.algo << " " << entry.memory << " " << entry.math_type << "\n";
+    }
+    out.close();
+    ORT_RETURN_IF_NOT(out, "Failed to write ", tmp_path);
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmp_path, path_, ec);
+  if (ec) {
+    std::filesystem::remove(tmp_path, ec);
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to replace ", path_, " with ", tmp_path);
+  }
+  return Status::OK();
+}
+
+std::string CudnnConvAlgoCache::MakeKey(const char* op, int data_type, bool channels_last, int64_t group,
+                                        bool max_workspace, std::initializer_list<gsl::span<const int64_t>> dims) {
+  std::ostringstream ss;
+  ss << op << "|" << data_type << "|" << channels_last << "|" << group << "|" << max_workspace;
+  for (const auto& d : dims) {
+    ss << "|";
+    for (size_t i = 0; i < d.size(); ++i) {
+      ss << (i > 0 ? "," : "") << d[i];
+    }
+  }
+  return ss.str();
+}
+
+}  // namespace cuda
+}  // namespace onnxruntime
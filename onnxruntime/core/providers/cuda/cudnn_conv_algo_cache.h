@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <initializer_list>
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+/**
+ * cuDNN convolution algorithms found by the exhaustive search, persisted in a file so that later processes use them
+ * without benchmarking again.
+ *
+ * Entries are keyed by the convolution parameters. A file is only used with the cuDNN and CUDA versions and the
+ * device model that wrote it, which is checked like the validators of TuningResults.
+ */
+class CudnnConvAlgoCache {
+ public:
+  struct Entry {
+    int algo;
+    size_t memory;
+    int math_type;
+  };
+
+  // Reads the file at path. A missing file, or one written for another device or library version, is treated as
+  // empty and is replaced by Save().
+  CudnnConvAlgoCache(std::string path, std::string fingerprint);
+
+  bool Find(const std::string& key, Entry& entry) const;
+
+  void Insert(const std::string& key, const Entry& entry);
+
+  // Writes the entries to the file if any were inserted. The new file replaces the old one atomically.
+  Status Save() const;
+
+  // Key of a convolution of the kind `op`, e.g. "fwd", whose cuDNN descriptors are made of the dims
+  static std::string MakeKey(const char* op, int data_type, bool channels_last, int64_t group, bool max_workspace,
+                             std::initializer_list<gsl::span<const int64_t>> dims);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CudnnConvAlgoCache);
+
+ private:
+  const std::string path_;
+  const std::string fingerprint_;
+  mutable OrtMutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  bool dirty_ = false;
+};
+
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -9,14 +9,31 @@ using namespace onnxruntime::common;
 namespace onnxruntime {
 namespace cuda {
 
+static Tensor* BinaryElementwiseOutput(OpKernelContext* context, const TensorShape& lhs_shape,
+                                       const TensorShape& rhs_shape, const TensorShape& output_shape,
+                                       bool may_reuse_input) {
+  if (may_reuse_input) {
+    if (lhs_shape == output_shape && context->IsInputDeadAfterKernel(0)) {
+      return context->OutputMayReuseInput(0, 0, output_shape);
+    }
+    if (rhs_shape == output_shape && context->IsInputDeadAfterKernel(1)) {
+      return context->OutputMayReuseInput(0, 1, output_shape);
+    }
+  }
+
+  return context->Output(0, output_shape);
+}
+
 template <>
-Status BinaryElementwise<ShouldNotBroadcast>::Prepare(OpKernelContext* context, BinaryElementwisePreparation* p) const {
+Status BinaryElementwise<ShouldNotBroadcast>::Prepare(OpKernelContext* context, BinaryElementwisePreparation* p,
+                                                      bool may_reuse_input) const {
   p->lhs_tensor = context->Input<Tensor>(0);
   p->rhs_tensor = context->Input<Tensor>(1);
   if (!(p->lhs_tensor->Shape() == p->rhs_tensor->Shape()))
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, Node().Name(), ": mismatching input shapes: ",
                            p->lhs_tensor->Shape().ToString(), " != ", p->rhs_tensor->Shape().ToString());
-  p->output_tensor = context->Output(0, p->lhs_tensor->Shape());
+  p->output_tensor = BinaryElementwiseOutput(context, p->lhs_tensor->Shape(), p->rhs_tensor->Shape(),
+                                             p->lhs_tensor->Shape(), may_reuse_input);
   p->output_rank_or_simple_broadcast = static_cast<int32_t>(SimpleBroadcast::NoBroadcast);
   return Status::OK();
 }
@@ -70,7 +87,8 @@ Status BinaryElementwiseBroadcastPrepare(
 }
 
 template <>
-Status BinaryElementwise<ShouldBroadcast>::Prepare(OpKernelContext* context, BinaryElementwisePreparation* p) const {
+Status BinaryElementwise<ShouldBroadcast>::Prepare(OpKernelContext* context, BinaryElementwisePreparation* p,
+                                                   bool may_reuse_input) const {
   auto lhs_tensor = context->Input<Tensor>(0);
   auto rhs_tensor = context->Input<Tensor>(1);
   const auto& lhs_shape = lhs_tensor->Shape();
@@ -78,7 +96,7 @@ Status BinaryElementwise<ShouldBroadcast>::Prepare(OpKernelContext* context, Bin
 
   TensorShape output_shape;
   ORT_RETURN_IF_ERROR(ComputeOutputShape(Node().Name(), lhs_shape, rhs_shape, output_shape));
-  auto output_tensor = context->Output(0, output_shape);
+  auto output_tensor = BinaryElementwiseOutput(context, lhs_shape, rhs_shape, output_shape, may_reuse_input);
 
   ORT_RETURN_IF_ERROR(BinaryElementwiseBroadcastPrepare(lhs_tensor, rhs_tensor, output_tensor, p));
 
@@ -154,7 +172,7 @@ Status BinaryElementwise<ShouldBroadcast>::Prepare(OpKernelContext* context, Bin
   template <>                                                                                           \
   Status x<T>::ComputeInternal(OpKernelContext* context) const {                                        \
     BinaryElementwisePreparation prepare;                                                               \
-    ORT_RETURN_IF_ERROR(Prepare(context, &prepare));                                                    \
+    ORT_RETURN_IF_ERROR(Prepare(context, &prepare, /*may_reuse_input*/ true));                          \
     Impl_##x<typename ToCudaType<T>::MappedType>(                                                       \
         Stream(context),                                                                                \
         prepare.output_rank_or_simple_broadcast,                                                        \
@@ -138,7 +138,10 @@ class BinaryElementwise : public CudaKernel {
   Status ComputeInternal(OpKernelContext*) const override {
     return Status(common::ONNXRUNTIME, common::FAIL);  // should not reach here
   }
-  Status Prepare(OpKernelContext* context, BinaryElementwisePreparation* p) const;
+  // if may_reuse_input is set the output is written into the buffer of an input with the output shape when
+  // nothing reads that input after the kernel. only for kernels computing each output element from the input
+  // elements at the matching position.
+  Status Prepare(OpKernelContext* context, BinaryElementwisePreparation* p, bool may_reuse_input = false) const;
 };
 
 template <typename T>
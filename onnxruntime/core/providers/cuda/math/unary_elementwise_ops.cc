@@ -9,7 +9,8 @@ namespace cuda {
 
 Status UnaryElementwise::Prepare(OpKernelContext* context, UnaryElementwisePreparation* p) const {
   p->input_tensor = context->Input<Tensor>(0);
-  p->output_tensor = context->Output(0, p->input_tensor->Shape());
+  // each thread writes the output elements it read the input elements for, so the output may share the input buffer
+  p->output_tensor = context->OutputMayReuseInput(0, 0, p->input_tensor->Shape());
   return Status::OK();
 }
 
@@ -360,6 +360,23 @@ Status Conv<T, NHWC>::UpdateState(OpKernelContext* context, bool bias_expected)
       ORT_ENFORCE(cudnn_conv_algo > -1 && cudnn_conv_algo < 3, "cudnn_conv_algo should be 0, 1 or 2, but got ", cudnn_conv_algo);
       switch (cudnn_conv_algo) {
         case 0: {
+          // the algorithms found by earlier processes
+          auto* algo_cache = cuda_ep->GetCudnnConvAlgoCache();
+          std::string algo_cache_key;
+          if (algo_cache) {
+            algo_cache_key = CudnnConvAlgoCache::MakeKey(
+                "fwd", CudnnTensor::GetDataType<CudaT>(), channels_last, conv_attrs_.group,
+                cuda_ep->GetCudnnConvUseMaxWorkspace(),
+                {x_dims_cudnn, w_dims, y_dims_cudnn, pads, strides, dilations});
+            CudnnConvAlgoCache::Entry entry;
+            if (algo_cache->Find(algo_cache_key, entry)) {
+              perf.algo = static_cast<cudnnConvolutionFwdAlgo_t>(entry.algo);
+              perf.memory = entry.memory;
+              perf.mathType = static_cast<cudnnMathType_t>(entry.math_type);
+              break;
+            }
+          }
+
           static constexpr int num_algos = CUDNN_CONVOLUTION_FWD_ALGO_COUNT;
           size_t max_ws_size = cuda_ep->GetCudnnConvUseMaxWorkspace() ? GetMaxWorkspaceSize(GetCudnnHandle(context), s_, kAllAlgos, num_algos)
                                                                       : AlgoSearchWorkspaceSize;
@@ -380,6 +397,9 @@ Status Conv<T, NHWC>::UpdateState(OpKernelContext* context, bool bias_expected)
               &perf,
               algo_search_workspace.get(),
               max_ws_size));
+          if (algo_cache) {
+            algo_cache->Insert(algo_cache_key, {perf.algo, perf.memory, perf.mathType});
+          }
           break;
         }
         case 1:
@@ -183,19 +183,38 @@ Status ConvTranspose<T, NHWC>::DoConvTranspose(OpKernelContext* context, bool dy
       y_data = reinterpret_cast<CudaT*>(p.Y->MutableData<T>());
 
       if (!s_.cached_benchmark_results.contains(x_dims)) {
-        IAllocatorUniquePtr<void> algo_search_workspace =
-            GetScratchBuffer<void>(AlgoSearchWorkspaceSize, context->GetComputeStream());
-
-        // set math type to tensor core before algorithm search
-        if constexpr (std::is_same<T, MLFloat16>::value)
-          CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, CUDNN_TENSOR_OP_MATH));
-
-        cudnnConvolutionBwdDataAlgoPerf_t perf;
-        int algo_count = 1;
-        CUDNN_RETURN_IF_ERROR(cudnnFindConvolutionBackwardDataAlgorithmEx(
-            GetCudnnHandle(context), s_.w_desc, w_data, s_.x_tensor, x_data, s_.conv_desc, s_.y_tensor, y_data, 1,
-            &algo_count, &perf, algo_search_workspace.get(), AlgoSearchWorkspaceSize));
-        s_.cached_benchmark_results.insert(x_dims, {perf.algo, perf.memory, perf.mathType});
+        // the algorithms found by earlier processes
+        const auto* cuda_ep = static_cast<const CUDAExecutionProvider*>(this->Info().GetExecutionProvider());
+        auto* algo_cache = cuda_ep->GetCudnnConvAlgoCache();
+        std::string algo_cache_key;
+        CudnnConvAlgoCache::Entry entry;
+        if (algo_cache) {
+          algo_cache_key = CudnnConvAlgoCache::MakeKey(
+              "bwd_data", CudnnTensor::GetDataType<CudaT>(), NHWC, conv_transpose_attrs_.group, false,
+              {x_dims, w_dims, y_dims, p.pads, p.strides, p.dilations});
+        }
+
+        if (algo_cache && algo_cache->Find(algo_cache_key, entry)) {
+          s_.cached_benchmark_results.insert(x_dims, {static_cast<cudnnConvolutionBwdDataAlgo_t>(entry.algo),
+                                                      entry.memory, static_cast<cudnnMathType_t>(entry.math_type)});
+        } else {
+          IAllocatorUniquePtr<void> algo_search_workspace =
+              GetScratchBuffer<void>(AlgoSearchWorkspaceSize, context->GetComputeStream());
+
+          // set math type to tensor core before algorithm search
+          if constexpr (std::is_same<T, MLFloat16>::value)
+            CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, CUDNN_TENSOR_OP_MATH));
+
+          cudnnConvolutionBwdDataAlgoPerf_t perf;
+          int algo_count = 1;
+          CUDNN_RETURN_IF_ERROR(cudnnFindConvolutionBackwardDataAlgorithmEx(
+              GetCudnnHandle(context), s_.w_desc, w_data, s_.x_tensor, x_data, s_.conv_desc, s_.y_tensor, y_data, 1,
+              &algo_count, &perf, algo_search_workspace.get(), AlgoSearchWorkspaceSize));
+          s_.cached_benchmark_results.insert(x_dims, {perf.algo, perf.memory, perf.mathType});
+          if (algo_cache) {
+            algo_cache->Insert(algo_cache_key, {perf.algo, perf.memory, perf.mathType});
+          }
+        }
       }
 
       const auto& perf = s_.cached_benchmark_results.at(x_dims);
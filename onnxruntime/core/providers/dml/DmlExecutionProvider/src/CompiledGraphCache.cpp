@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "precomp.h"
+#include "CompiledGraphCache.h"
+
+namespace Dml
+{
+    std::shared_ptr<CompiledGraphCache> CompiledGraphCache::GetForDevice(IDMLDevice* device)
+    {
+        // The entries of devices without execution providers left are expired, and are replaced when the address is
+        // reused by another device.
+        static std::mutex s_mutex;
+        static std::unordered_map<IDMLDevice*, std::weak_ptr<CompiledGraphCache>> s_caches;
+
+        std::lock_guard<std::mutex> lock(s_mutex);
+
+        for (auto it = s_caches.begin(); it != s_caches.end();)
+        {
+            it = it->second.expired() ? s_caches.erase(it) : std::next(it);
+        }
+
+        auto& weakCache = s_caches[device];
+        std::shared_ptr<CompiledGraphCache> cache = weakCache.lock();
+        if (!cache)
+        {
+            cache = std::make_shared<CompiledGraphCache>();
+            weakCache = cache;
+        }
+
+        return cache;
+    }
+
+    Microsoft::WRL::ComPtr<IDMLCompiledOperator> CompiledGraphCache::Find(const std::string& key) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_compiledGraphs.find(key);
+        return it != m_compiledGraphs.end() ? it->second : nullptr;
+    }
+
+    void CompiledGraphCache::Add(const std::string& key, Microsoft::WRL::ComPtr<IDMLCompiledOperator> compiledOperator)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_compiledGraphs.emplace(key, std::move(compiledOperator));
+    }
+}
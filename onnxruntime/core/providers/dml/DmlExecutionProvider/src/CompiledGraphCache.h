@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+
+namespace Dml
+{
+    // Compiled DML graphs of the fused partitions, shared by all the execution providers which use the same DML
+    // device. Sessions loading the same model, or models with identical partitions, on one device compile each
+    // partition once instead of once per session.
+    //
+    // IDMLCompiledOperator can't be serialized, so the cache lives in memory for as long as an execution provider
+    // using the device exists. It isn't attached to the device itself, as the compiled operators hold references to
+    // the device and would keep it alive.
+    class CompiledGraphCache
+    {
+    public:
+        // Returns the cache of the device, creating it if no execution provider holds it.
+        static std::shared_ptr<CompiledGraphCache> GetForDevice(IDMLDevice* device);
+
+        // Returns null if there is no compiled graph for the key.
+        Microsoft::WRL::ComPtr<IDMLCompiledOperator> Find(const std::string& key) const;
+
+        void Add(const std::string& key, Microsoft::WRL::ComPtr<IDMLCompiledOperator> compiledOperator);
+
+    private:
+        mutable std::mutex m_mutex;
+        std::unordered_map<std::string, Microsoft::WRL::ComPtr<IDMLCompiledOperator>> m_compiledGraphs;
+    };
+}
@@ -2,6 +2,8 @@
 
 #include "DmlGraphFusionHelper.h"
 #include "DmlRuntimeFusedGraphKernel.h"
+#include "core/common/path_string.h"
+#include "core/framework/murmurhash3.h"
 
 namespace Dml
 {
@@ -440,6 +442,101 @@ namespace DmlGraphFusionHelper
         return compiledExecutionPlanOperator;
     }
 
+    std::string GetCompiledPartitionKey(
+        const onnxruntime::Graph& graph,
+        const onnxruntime::IndexedSubGraph& indexedSubGraph,
+        const std::unordered_map<std::string, GraphNodeProperties>& partitionNodePropsMap,
+        const std::unordered_map<std::string, std::pair<const ONNX_NAMESPACE::TensorProto*, bool>>& isInitializerTransferable,
+        gsl::span<const uint8_t> isInputsUploadedByDmlEP,
+        const GraphDescBuilder::GraphDesc& graphDesc,
+        const ExecutionProviderImpl* providerImpl)
+    {
+        uint32_t hash[4] = {0, 0, 0, 0};
+        auto hashBytes = [&hash](const void* data, size_t size)
+        {
+            MurmurHash3::x86_128(data, gsl::narrow_cast<int32_t>(size), hash[0], &hash);
+        };
+        auto hashString = [&hashBytes](const std::string& str)
+        {
+            hashBytes(str.data(), str.size());
+        };
+
+        for (auto nodeIndex : indexedSubGraph.nodes)
+        {
+            const onnxruntime::Node* node = graph.GetNode(nodeIndex);
+
+            // The node proto holds the operator, its attributes and the names of its edges
+            ONNX_NAMESPACE::NodeProto nodeProto;
+            node->ToProto(nodeProto);
+            hashString(nodeProto.SerializeAsString());
+            hashString(std::to_string(node->SinceVersion()));
+
+            auto properties = partitionNodePropsMap.find(GraphDescBuilder::GetUniqueNodeName(*node));
+            if (properties != partitionNodePropsMap.end())
+            {
+                for (const auto* edgeShapes : {&properties->second.inputShapes, &properties->second.outputShapes})
+                {
+                    for (size_t i = 0; i < edgeShapes->EdgeCount(); ++i)
+                    {
+                        const std::vector<uint32_t>& shape = edgeShapes->GetShape(i);
+                        hashBytes(shape.data(), shape.size() * sizeof(uint32_t));
+                        hashString(",");
+                    }
+                }
+            }
+        }
+
+        for (const auto* names : {&indexedSubGraph.GetMetaDef()->inputs, &indexedSubGraph.GetMetaDef()->outputs})
+        {
+            for (const std::string& name : *names)
+            {
+                hashString(name);
+                const onnxruntime::NodeArg* arg = graph.GetNodeArg(name);
+                if (arg && arg->TypeAsProto())
+                {
+                    hashString(arg->TypeAsProto()->SerializeAsString());
+                }
+            }
+        }
+
+        // Initializers may be read on the CPU while the graph is built, so their contents are part of the key
+        for (const std::string& input : indexedSubGraph.GetMetaDef()->inputs)
+        {
+            auto iter = isInitializerTransferable.find(input);
+            if (iter == isInitializerTransferable.end())
+            {
+                continue;
+            }
+
+            const ONNX_NAMESPACE::TensorProto* tensor = iter->second.first;
+            hashString(iter->second.second ? "transferable" : "duplicated");
+            if (tensor->has_raw_data())
+            {
+                hashString(tensor->name());
+                hashString(std::to_string(tensor->data_type()));
+                hashBytes(tensor->dims().data(), tensor->dims().size() * sizeof(int64_t));
+                hashString(tensor->raw_data());
+            }
+            else
+            {
+                hashString(tensor->SerializeAsString());
+                if (tensor->data_location() == ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL)
+                {
+                    hashString(onnxruntime::ToUTF8String(graph.ModelPath().ToPathString()));
+                }
+            }
+        }
+
+        hashBytes(isInputsUploadedByDmlEP.data(), isInputsUploadedByDmlEP.size());
+
+        const uint8_t flags[] = {graphDesc.reuseCommandList, providerImpl->MetacommandsEnabled()};
+        hashBytes(flags, sizeof(flags));
+
+        char key[33];
+        snprintf(key, sizeof(key), "%08x%08x%08x%08x", hash[0], hash[1], hash[2], hash[3]);
+        return key;
+    }
+
     void FusePartitionAndRegisterKernel(
         onnxruntime::Graph& graph,
         onnxruntime::KernelRegistry* registryForPartitionKernels,
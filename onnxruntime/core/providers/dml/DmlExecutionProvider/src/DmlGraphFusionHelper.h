@@ -71,6 +71,18 @@ namespace DmlGraphFusionHelper
         const onnxruntime::IndexedSubGraph& indexedSubGraph,
         const ExecutionProviderImpl* providerImpl);
 
+    // Gets the key of a partition in the CompiledGraphCache. It covers everything the compiled graph depends on: the
+    // nodes and their attributes, the shapes of their edges, the contents of the initializers of the partition, which
+    // inputs are owned by DML and the execution flags.
+    std::string GetCompiledPartitionKey(
+        const onnxruntime::Graph& graph,
+        const onnxruntime::IndexedSubGraph& indexedSubGraph,
+        const std::unordered_map<std::string, GraphNodeProperties>& partitionNodePropsMap,
+        const std::unordered_map<std::string, std::pair<const ONNX_NAMESPACE::TensorProto*, bool>>& isInitializerTransferable,
+        gsl::span<const uint8_t> isInputsUploadedByDmlEP,
+        const GraphDescBuilder::GraphDesc& graphDesc,
+        const ExecutionProviderImpl* providerImpl);
+
     void FusePartitionAndRegisterKernel(
         onnxruntime::Graph& graph,
         onnxruntime::KernelRegistry* registryForPartitionKernels,
@@ -11,6 +11,7 @@
 #include "FusedGraphKernel.h"
 #include "MLOperatorAuthorImpl.h"
 #include "DmlGraphFusionHelper.h"
+#include "CompiledGraphCache.h"
 
 
 namespace Dml
@@ -239,12 +240,31 @@ namespace Dml
                         subgraphInputs,
                         subgraphOutputs);
 
-                    // Compile the operator
-                    auto compiledPartition = DmlGraphFusionHelper::TryCreateCompiledOperator(
-                        graphDesc,
+                    // Compile the operator, unless a session on the same device has already compiled the same partition
+                    std::string compiledPartitionKey = DmlGraphFusionHelper::GetCompiledPartitionKey(
+                        graph,
                         indexedSubGraph,
+                        partitionNodePropsMap,
+                        isInitializerTransferable,
+                        isInputsUploadedByDmlEP,
+                        graphDesc,
                         m_providerImpl);
 
+                    CompiledGraphCache* compiledGraphCache = m_providerImpl->GetCompiledGraphCache();
+                    auto compiledPartition = compiledGraphCache->Find(compiledPartitionKey);
+                    if (!compiledPartition)
+                    {
+                        compiledPartition = DmlGraphFusionHelper::TryCreateCompiledOperator(
+                            graphDesc,
+                            indexedSubGraph,
+                            m_providerImpl);
+
+                        if (compiledPartition)
+                        {
+                            compiledGraphCache->Add(compiledPartitionKey, compiledPartition);
+                        }
+                    }
+
                     if (!compiledPartition)
                     {
                         // Fail early if even a single operator is too big to compile. This is highly unlikely.
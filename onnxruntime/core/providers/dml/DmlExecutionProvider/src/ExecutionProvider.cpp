@@ -7,6 +7,7 @@
 #include "ExecutionProvider.h"
 #include "PooledUploadHeap.h"
 #include "ReadbackHeap.h"
+#include "CompiledGraphCache.h"
 #include "ExecutionContext.h"
 #include "BucketizedBufferAllocator.h"
 #include "MLOperatorAuthorImpl.h"
@@ -187,6 +188,7 @@ namespace Dml
 
         m_uploadHeap = std::make_unique<PooledUploadHeap>(m_d3d12Device.Get(), m_context);
         m_readbackHeap = std::make_unique<ReadbackHeap>(m_d3d12Device.Get(), m_context);
+        m_compiledGraphCache = CompiledGraphCache::GetForDevice(m_dmlDevice.Get());
 
         CreateDmlKernelRegistry(&m_kernelRegistry, &m_internalRegInfoMap);
 
@@ -25,6 +25,7 @@ namespace Dml
     class ExecutionContext;
     class BucketizedBufferAllocator;
     class CPUAllocator;
+    class CompiledGraphCache;
     class ExecutionProvider;
 
     class ExecutionProviderImpl : public WRL::Base<Dml::IExecutionProvider,
@@ -169,6 +170,11 @@ namespace Dml
             return m_partitionKernelPrefixVal;
         }
 
+        CompiledGraphCache* GetCompiledGraphCache() const
+        {
+            return m_compiledGraphCache.get();
+        }
+
         onnxruntime::common::Status OnSessionInitializationEnd();
         std::vector<onnxruntime::AllocatorPtr> CreatePreferredAllocators();
 
@@ -194,6 +200,7 @@ namespace Dml
         std::unique_ptr<ReadbackHeap> m_readbackHeap;
         std::shared_ptr<BucketizedBufferAllocator> m_allocator;
         std::shared_ptr<CPUAllocator> m_cpuInputAllocator;
+        std::shared_ptr<CompiledGraphCache> m_compiledGraphCache;
         std::shared_ptr<onnxruntime::KernelRegistry> m_kernelRegistry;
         std::shared_ptr<const Windows::AI::MachineLearning::Adapter::InternalRegistrationInfoMap> m_internalRegInfoMap;
         mutable uint64_t m_partitionKernelPrefixVal = 0;
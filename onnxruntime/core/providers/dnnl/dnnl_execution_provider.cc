@@ -76,6 +76,11 @@ DnnlExecutionProvider::DnnlExecutionProvider(const DnnlExecutionProviderInfo& in
 #endif  // !defined(DNNL_JAVA)
   // Log the number of threads used
   LOGS_DEFAULT(INFO) << "Allocated " << omp_get_max_threads() << " OpenMP threads for oneDNN ep\n";
+#elif defined(DNNL_THREADPOOL)
+  // oneDNN runs in the intra-op thread pool of each call, whose size is set in the SessionOptions
+  if (num_threads != nullptr && *num_threads > 0) {
+    LOGS_DEFAULT(WARNING) << "The oneDNN EP shares ORT's intra-op thread pool, so its number of threads is ignored.";
+  }
 #endif  // defined(DNNL_OPENMP)
 
 }  // namespace onnxruntime
@@ -85,7 +90,7 @@ DnnlExecutionProvider::~DnnlExecutionProvider() {
 
 std::vector<std::vector<NodeIndex>> DnnlExecutionProvider::GetSupportedNodes(const GraphViewer& graph_viewer) const {
   std::vector<std::vector<size_t>> supported_node_vecs;
-  std::vector<size_t> supported_node_vec;
+  std::unordered_set<NodeIndex> supported_nodes;
 
   std::unordered_map<std::string, int> all_nodes_count;
   std::unordered_map<std::string, int> supported_nodes_count;
@@ -113,17 +118,43 @@ std::vector<std::vector<NodeIndex>> DnnlExecutionProvider::GetSupportedNodes(con
     }
 
     if (supported) {
-      supported_node_vec.push_back(node_idx);
-    } else {
-      if (!supported_node_vec.empty()) {
-        supported_node_vecs.push_back(supported_node_vec);
-        supported_node_vec.clear();
-      }
+      supported_nodes.insert(node_idx);
     }
   }
 
-  if (!supported_node_vec.empty()) {
-    supported_node_vecs.push_back(supported_node_vec);
+  // Group the supported nodes into as few subgraphs as possible. A subgraph ends at a node that depends on it
+  // through a node it doesn't contain, as fusing that node would create a cycle, rather than at the next node in
+  // topological order that isn't supported. Each subgraph reorders its outputs from oneDNN's blocked memory formats
+  // to the plain ORT layout, so subgraphs only split where another EP consumes the tensors in the plain layout.
+  std::unordered_set<NodeIndex> grouped_nodes;
+  while (grouped_nodes.size() < supported_nodes.size()) {
+    std::vector<NodeIndex> group;
+    // nodes with an input produced by the group, and nodes with an input produced by nodes outside the group which
+    // depend on it
+    std::unordered_set<NodeIndex> consumers_of_group;
+    std::unordered_set<NodeIndex> consumers_of_dependents;
+    for (auto node_idx : node_indices) {
+      if (grouped_nodes.count(node_idx) != 0) {
+        continue;
+      }
+
+      const auto* node(graph_viewer.GetNode(node_idx));
+      const bool depends_on_group_outside = consumers_of_dependents.count(node_idx) != 0;
+      const bool joins_group = supported_nodes.count(node_idx) != 0 && !depends_on_group_outside;
+      if (joins_group) {
+        group.push_back(node_idx);
+      } else if (!depends_on_group_outside && consumers_of_group.count(node_idx) == 0) {
+        continue;
+      }
+
+      auto& consumers = joins_group ? consumers_of_group : consumers_of_dependents;
+      for (auto it = node->OutputEdgesBegin(), end = node->OutputEdgesEnd(); it != end; ++it) {
+        consumers.insert(it->GetNode().Index());
+      }
+    }
+
+    grouped_nodes.insert(group.begin(), group.end());
+    supported_node_vecs.push_back(std::move(group));
   }
 
   // collect statistics and report
@@ -358,6 +389,12 @@ Status DnnlExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fuse
       // lock each subgraph_primitive as multiple threads have shared memories
       {
         std::unique_lock<OrtMutex> lock(subgraph_primitive->GetMutex());
+#if defined(DNNL_THREADPOOL)
+        // the primitives run in the intra-op thread pool of the call rather than in threads of oneDNN's own
+        ort_dnnl::DnnlThreadPool threadpool(ctx);
+        subgraph_primitive->SetThreadPool(&threadpool);
+        auto reset_threadpool = gsl::finally([subgraph_primitive]() { subgraph_primitive->SetThreadPool(nullptr); });
+#endif  // defined(DNNL_THREADPOOL)
         subgraph_primitive->Compile(inputs);
         std::unordered_map<std::string, ort_dnnl::OnnxTensorData> outputs;
         outputs.reserve(subgraph_num_outputs);
@@ -7,6 +7,13 @@
 #include <Windows.h>
 #endif
 #include <thread>
+#if defined(DNNL_THREADPOOL)
+#include <functional>
+
+#include "dnnl_threadpool.hpp"
+#define ORT_API_MANUAL_INIT
+#include "core/session/onnxruntime_cxx_api.h"
+#endif  // defined(DNNL_THREADPOOL)
 
 inline int DnnlCalcNumThreads() {
   int num_threads = 0;
@@ -29,4 +36,51 @@ inline int DnnlCalcNumThreads() {
     num_threads = std::thread::hardware_concurrency();
 
   return num_threads;
-}
\ No newline at end of file
+}
+
+#if defined(DNNL_THREADPOOL)
+namespace onnxruntime {
+namespace ort_dnnl {
+
+// Runs the parallel loops of the oneDNN primitives of a call in the intra-op thread pool of the call, so a session
+// mixing the CPU EP with the DNNL EP has a single set of workers, which spin according to ORT's spinning setting,
+// instead of ORT's workers and OpenMP's competing for the cores.
+class DnnlThreadPool : public dnnl::threadpool_interop::threadpool_iface {
+ public:
+  explicit DnnlThreadPool(const Ort::KernelContext& context)
+      : context_{context}, num_threads_{context.GetDegreeOfParallelism()} {}
+
+  int get_num_threads() const override { return num_threads_; }
+
+  bool get_in_parallel() const override { return in_parallel_; }
+
+  // parallel_for returns once all the iterations have run
+  uint64_t get_flags() const override { return 0; }
+
+  void parallel_for(int n, const std::function<void(int, int)>& fn) override {
+    struct Loop {
+      const std::function<void(int, int)>& fn;
+      int n;
+    } loop{fn, n};
+
+    context_.ParallelFor(
+        [](void* data, size_t i) {
+          const auto& loop = *static_cast<const Loop*>(data);
+          in_parallel_ = true;
+          loop.fn(static_cast<int>(i), loop.n);
+          in_parallel_ = false;
+        },
+        static_cast<size_t>(n), 0, &loop);
+  }
+
+ private:
+  Ort::KernelContext context_;
+  int num_threads_;
+
+  // whether the thread runs an iteration of parallel_for
+  inline static thread_local bool in_parallel_ = false;
+};
+
+}  // namespace ort_dnnl
+}  // namespace onnxruntime
+#endif  // defined(DNNL_THREADPOOL)
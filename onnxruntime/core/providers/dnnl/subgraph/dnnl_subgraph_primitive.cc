@@ -240,15 +240,24 @@ void DnnlSubgraphPrimitive::AddKernels() {
   }
 }
 
+// The engines are shared by the subgraphs of all the sessions in the process. oneDNN's primitive cache is process
+// wide but keyed by the engine as well as the primitive descriptor, so subgraphs created with the same engine reuse
+// each other's primitives when they are recompiled, instead of creating them again or, on GPU, compiling the kernels
+// again for a new context. An empty engine is returned if there is no device of the kind.
+static dnnl::engine GetSharedEngine(dnnl::engine::kind kind) {
+  static const dnnl::engine cpu_engine = dnnl_engine_get_count(dnnl_engine_kind_t::dnnl_cpu)
+                                             ? dnnl::engine(dnnl::engine::kind::cpu, 0)
+                                             : dnnl::engine();
+  static const dnnl::engine gpu_engine = dnnl_engine_get_count(dnnl_engine_kind_t::dnnl_gpu)
+                                             ? dnnl::engine(dnnl::engine::kind::gpu, 0)
+                                             : dnnl::engine();
+  return kind == dnnl::engine::kind::gpu ? gpu_engine : cpu_engine;
+}
+
 DnnlSubgraphPrimitive::DnnlSubgraphPrimitive(ort_dnnl::DnnlSubgraph& dnnl_subgraph) {
   subgraph_ = &dnnl_subgraph;
-  if (dnnl_engine_get_count(dnnl_engine_kind_t::dnnl_cpu)) {
-    cpu_engine_ = dnnl::engine(dnnl::engine::kind::cpu, 0);
-  }
-
-  if (dnnl_engine_get_count(dnnl_engine_kind_t::dnnl_gpu)) {
-    gpu_engine_ = dnnl::engine(dnnl::engine::kind::gpu, 0);
-  }
+  cpu_engine_ = GetSharedEngine(dnnl::engine::kind::cpu);
+  gpu_engine_ = GetSharedEngine(dnnl::engine::kind::gpu);
 }
 
 bool DnnlSubgraphPrimitive::IsDynamic() {
@@ -392,6 +401,11 @@ dnnl::engine DnnlSubgraphPrimitive::GetEngine() {
 }
 
 dnnl::stream DnnlSubgraphPrimitive::GetStream() {
+#if defined(DNNL_THREADPOOL)
+  if (!gpu_engine_ && threadpool_) {
+    return dnnl::threadpool_interop::make_stream(cpu_engine_, threadpool_);
+  }
+#endif  // defined(DNNL_THREADPOOL)
   return dnnl::stream(GetEngine());
 }
 
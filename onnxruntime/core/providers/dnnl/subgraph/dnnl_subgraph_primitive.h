@@ -4,6 +4,9 @@
 #pragma once
 #include "dnnl_subgraph.h"
 #include "dnnl.hpp"
+#if defined(DNNL_THREADPOOL)
+#include "dnnl_threadpool.hpp"
+#endif  // defined(DNNL_THREADPOOL)
 #include "core/platform/ort_mutex.h"
 
 namespace onnxruntime {
@@ -70,6 +73,10 @@ class DnnlSubgraphPrimitive {
   // original input from ORT was a scalar.
   bool IsScalar(const DnnlTensor& tensor);
   OrtMutex& GetMutex() { return mutex_; }
+#if defined(DNNL_THREADPOOL)
+  // the thread pool the primitives of the current call run in, owned by the caller
+  void SetThreadPool(dnnl::threadpool_interop::threadpool_iface* threadpool) { threadpool_ = threadpool; }
+#endif  // defined(DNNL_THREADPOOL)
 
   // GetMemory in OrtFormat if the memory is not in the OrtFormat this will reorder the memory.
   // All memory will be moved to the dnnl_engine even if it is already in OrtFormat.
@@ -124,6 +131,9 @@ class DnnlSubgraphPrimitive {
 
   dnnl::engine cpu_engine_;
   dnnl::engine gpu_engine_;
+#if defined(DNNL_THREADPOOL)
+  dnnl::threadpool_interop::threadpool_iface* threadpool_ = nullptr;
+#endif  // defined(DNNL_THREADPOOL)
 
   OrtMutex mutex_;
 
@@ -3,6 +3,8 @@
 
 #include "js_execution_provider.h"
 
+#include <emscripten.h>
+
 #include <string_view>
 #include <unordered_map>
 #include <unordered_set>
@@ -220,6 +222,9 @@ class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kJsExecutionProvider, kOnnxDomai
 class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kJsExecutionProvider, kOnnxDomain, 13, 14, Shape);
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kJsExecutionProvider, kOnnxDomain, 15, Shape);
 
+class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kJsExecutionProvider, kOnnxDomain, 1, 12, Size);
+class ONNX_OPERATOR_KERNEL_CLASS_NAME(kJsExecutionProvider, kOnnxDomain, 13, Size);
+
 class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kJsExecutionProvider, kOnnxDomain, 5, 12, Reshape);
 class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kJsExecutionProvider, kOnnxDomain, 13, 13, Reshape);
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kJsExecutionProvider, kOnnxDomain, 14, Reshape);
@@ -464,6 +469,9 @@ std::unique_ptr<KernelRegistry> RegisterKernels() {
       BuildKernelCreateInfo<ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kJsExecutionProvider, kOnnxDomain, 13, 14, Shape)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_KERNEL_CLASS_NAME(kJsExecutionProvider, kOnnxDomain, 15, Shape)>,
 
+      BuildKernelCreateInfo<ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kJsExecutionProvider, kOnnxDomain, 1, 12, Size)>,
+      BuildKernelCreateInfo<ONNX_OPERATOR_KERNEL_CLASS_NAME(kJsExecutionProvider, kOnnxDomain, 13, Size)>,
+
       BuildKernelCreateInfo<ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kJsExecutionProvider, kOnnxDomain, 5, 12, Reshape)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kJsExecutionProvider, kOnnxDomain, 13, 13, Reshape)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_KERNEL_CLASS_NAME(kJsExecutionProvider, kOnnxDomain, 14, Reshape)>,
@@ -681,7 +689,8 @@ using namespace js;
 
 JsExecutionProvider::JsExecutionProvider(const JsExecutionProviderInfo& info)
     : IExecutionProvider{kJsExecutionProvider, OrtDevice(OrtDevice::GPU, OrtDevice::MemType::DEFAULT, 0), true},
-      preferred_data_layout_{info.data_layout} {
+      preferred_data_layout_{info.data_layout},
+      enable_graph_capture_{info.enable_graph_capture} {
 }
 
 std::vector<AllocatorPtr> JsExecutionProvider::CreatePreferredAllocators() {
@@ -749,4 +758,44 @@ std::unique_ptr<onnxruntime::IDataTransfer> JsExecutionProvider::GetDataTransfer
 JsExecutionProvider::~JsExecutionProvider() {
 }
 
+Status JsExecutionProvider::OnRunStart() {
+  if (IsGraphCaptureEnabled() && graph_key_ != -1 && !IsGraphCaptured() &&
+      regular_run_counts_[graph_key_] >= min_num_runs_before_graph_capture_) {
+    LOGS(*GetLogger(), INFO) << "Capturing the webgpu graph for this model with graph key " << graph_key_;
+    EM_ASM({ Module.jsepCaptureBegin($0); }, static_cast<double>(graph_key_));
+    capturing_graph_ = true;
+  }
+  return Status::OK();
+}
+
+Status JsExecutionProvider::OnRunEnd(bool /*sync_stream*/) {
+  if (capturing_graph_) {
+    EM_ASM({ Module.jsepCaptureEnd($0); }, static_cast<double>(graph_key_));
+    captured_graphs_.insert(graph_key_);
+    capturing_graph_ = false;
+  } else if (IsGraphCaptureEnabled() && graph_key_ != -1) {
+    // the regular runs before the capture allocate the buffers that the captured commands use
+    ++regular_run_counts_[graph_key_];
+  }
+  return Status::OK();
+}
+
+bool JsExecutionProvider::IsGraphCaptureEnabled() const {
+  return enable_graph_capture_;
+}
+
+void JsExecutionProvider::SetGraphCaptureKey(int64_t graph_key) {
+  graph_key_ = graph_key;
+}
+
+bool JsExecutionProvider::IsGraphCaptured() const {
+  return IsGraphCaptureEnabled() && captured_graphs_.count(graph_key_) > 0;
+}
+
+Status JsExecutionProvider::ReplayGraph() {
+  ORT_RETURN_IF_NOT(IsGraphCaptured(), "No webgpu graph is captured for graph key ", graph_key_);
+  EM_ASM({ Module.jsepReplay($0); }, static_cast<double>(graph_key_));
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <unordered_set>
+
 #include "core/framework/execution_provider.h"
 #include "core/graph/constants.h"
 #include "core/providers/providers.h"
@@ -30,10 +33,19 @@ struct JsExecutionProviderInfo {
         data_layout = DataLayout::NHWC;
       }
     }
+
+    it = po.find("enable_graph_capture");
+    if (it != po.end()) {
+      enable_graph_capture = it->second == "1";
+    }
   }
 
   // JSEP default preferred layout is NHWC
   DataLayout data_layout = DataLayout::NHWC;
+
+  // record the GPU commands of a run and replay them in the following runs, which needs all the compute nodes on the
+  // JS EP and the inputs and outputs bound to GPU buffers
+  bool enable_graph_capture = false;
 };
 
 class JsExecutionProvider : public IExecutionProvider {
@@ -57,7 +69,25 @@ class JsExecutionProvider : public IExecutionProvider {
   bool ConcurrentRunSupported() const override { return false; }
 
   std::vector<AllocatorPtr> CreatePreferredAllocators() override;
+
+  Status OnRunStart() override;
+  Status OnRunEnd(bool sync_stream) override;
+
+  bool IsGraphCaptureEnabled() const override;
+  void SetGraphCaptureKey(int64_t graph_key) override;
+  bool IsGraphCaptured() const override;
+  Status ReplayGraph() override;
+
   DataLayout preferred_data_layout_;
+
+ private:
+  static constexpr int min_num_runs_before_graph_capture_ = 1;  // required min regular runs of a graph key before its capture.
+
+  bool enable_graph_capture_ = false;
+  int64_t graph_key_ = 0;
+  bool capturing_graph_ = false;
+  std::unordered_map<int64_t, int> regular_run_counts_;
+  std::unordered_set<int64_t> captured_graphs_;
 };
 
 }  // namespace onnxruntime
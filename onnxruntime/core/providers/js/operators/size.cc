@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/js/js_kernel.h"
+#include "core/providers/js/js_data_types.h"
+#include "core/providers/cpu/tensor/size.h"
+
+namespace onnxruntime {
+namespace js {
+
+// Like Shape, Size only reads the shape of its input, so it runs on the CPU without downloading the tensor data and
+// its output stays on the CPU for the shape computations that consume it.
+
+ONNX_OPERATOR_VERSIONED_KERNEL_EX(
+    Size,
+    kOnnxDomain,
+    1, 12,
+    kJsExecutionProvider,
+    (*KernelDefBuilder::Create())
+        .OutputMemoryType(OrtMemTypeCPU, 0)
+        .TypeConstraint("T", JsepSupportedDataTypes())
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<int64_t>()),
+    Size);
+
+ONNX_OPERATOR_KERNEL_EX(
+    Size,
+    kOnnxDomain,
+    13,
+    kJsExecutionProvider,
+    (*KernelDefBuilder::Create())
+        .OutputMemoryType(OrtMemTypeCPU, 0)
+        .TypeConstraint("T", JsepSupportedDataTypes())
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<int64_t>()),
+    Size);
+
+}  // namespace js
+}  // namespace onnxruntime
@@ -1,6 +1,7 @@
 // Copyright (C) 2019-2022 Intel Corporation
 // Licensed under the MIT License
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <memory>
@@ -99,7 +100,12 @@ BasicBackend::BasicBackend(const ONNX_NAMESPACE::ModelProto& model_proto,
     throw(msg);
   }
 
-  inferRequestsQueue_ = std::unique_ptr<InferRequestsQueue>(new InferRequestsQueue(exe_network_, 1));
+  // Concurrent Runs each take an idle infer request, so the pool holds as many requests as the device runs
+  // in parallel on its throughput streams
+  size_t num_infer_req = std::max(static_cast<size_t>(exe_network_.GetOptimalNumberOfInferRequests()),
+                                  static_cast<size_t>(std::max(global_context_.num_streams, 1)));
+  LOGS_DEFAULT(INFO) << log_tag << "Number of infer requests: " << num_infer_req;
+  inferRequestsQueue_ = std::unique_ptr<InferRequestsQueue>(new InferRequestsQueue(exe_network_, num_infer_req));
 }
 
 bool BasicBackend::ValidateSubgraph(std::map<std::string, std::shared_ptr<ov::Node>>& const_outputs_map) {
@@ -240,6 +246,18 @@ void BasicBackend::StartAsyncInference(Ort::KernelContext& context, OVInferReque
         } catch (const char* msg) {
           throw(msg);
         }
+      } else if (input_info_iter->get_partial_shape().is_static()) {
+        // avoid input copies by wrapping the ORT input buffer in the tensor of the infer request
+        const auto tensor = context.GetInput(subgraph_context_.input_names.at(input_name));
+        OVTensorPtr tensor_ptr;
+        if (tensor.GetTensorMemoryInfo().GetAllocatorName() != OpenVINO_GPU) {
+          tensor_ptr = std::make_shared<ov::Tensor>(input_info_iter->get_element_type(), input_info_iter->get_shape(),
+                                                    const_cast<void*>(tensor.GetTensorRawData()));
+        } else {
+          tensor_ptr = std::make_shared<ov::Tensor>(input_info_iter->get_element_type(), input_info_iter->get_shape());
+          FillInputBlob(tensor_ptr, batch_slice_idx, input_name, context, subgraph_context_);
+        }
+        infer_request->SetTensor(input_name, tensor_ptr);
       } else {
         OVTensorPtr graph_input_blob;
         try {
@@ -251,6 +269,35 @@ void BasicBackend::StartAsyncInference(Ort::KernelContext& context, OVInferReque
       }
       input_idx++;
     }
+
+    // Let OpenVINO write the static outputs straight into the ORT output buffers. The outputs of dynamic shapes are
+    // never bound, as ORT can only allocate them once the shapes are known, and are copied when the request completes.
+    auto graph_output_info = exe_network_.Get().outputs();
+    for (auto output_info_iter = graph_output_info.begin();
+         output_info_iter != graph_output_info.end(); ++output_info_iter) {
+      if (!output_info_iter->get_partial_shape().is_static()) {
+        continue;
+      }
+      auto output_names = output_info_iter->get_names();
+      auto it = std::find_if(subgraph_context_.output_names.begin(), subgraph_context_.output_names.end(),
+                             [&output_names](const auto& name_index) {
+                               return output_names.find(name_index.first) != output_names.end();
+                             });
+      if (it == subgraph_context_.output_names.end()) {
+        // reported when the request completes
+        continue;
+      }
+      const auto& output_shape = output_info_iter->get_shape();
+      std::vector<int64_t> ort_shape(output_shape.begin(), output_shape.end());
+      auto output_tensor = context.GetOutput(it->second, ort_shape.data(), ort_shape.size());
+      if (output_tensor.GetTensorMemoryInfo().GetAllocatorName() == OpenVINO_GPU) {
+        continue;
+      }
+      OVTensorPtr tensor_ptr = std::make_shared<ov::Tensor>(output_info_iter->get_element_type(), output_shape,
+                                                            output_tensor.GetTensorMutableRawData());
+      infer_request->SetTensor(it->first, tensor_ptr);
+    }
+
     // Start Async inference
     infer_request->StartAsync();
   } catch (const char* msg) {
@@ -406,7 +453,8 @@ void BasicBackend::CompleteAsyncInference(Ort::KernelContext& context, OVInferRe
       auto mem_info = output_tensor.GetTensorMemoryInfo();
       if (mem_info.GetAllocatorName() == OpenVINO_GPU) {
         return;
-      } else {
+      } else if (graph_output_blob->data() != output_tensor.GetTensorMutableRawData()) {
+        // the output isn't bound to the ORT output buffer
         size_t batch_slice = 0;
         FillOutputBlob(graph_output_blob, output_tensor, batch_slice);
       }
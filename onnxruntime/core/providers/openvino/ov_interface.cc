@@ -143,6 +143,15 @@ OVInferRequest OVExeNetwork::CreateInferRequest() {
   }
 }
 
+uint32_t OVExeNetwork::GetOptimalNumberOfInferRequests() {
+  try {
+    return obj.get_property(ov::optimal_number_of_infer_requests);
+  } catch (...) {
+    LOGS_DEFAULT(WARNING) << log_tag << "Couldn't get the optimal number of infer requests, using 1";
+    return 1;
+  }
+}
+
 OVTensorPtr OVInferRequest::GetTensor(const std::string& input_name) {
   try {
     auto tobj = ovInfReq.get_tensor(input_name);
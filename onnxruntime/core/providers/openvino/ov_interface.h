@@ -74,6 +74,7 @@ class OVExeNetwork {
   OVExeNetwork() { obj = ov::CompiledModel(); }
   ov::CompiledModel& Get() { return obj; }
   OVInferRequest CreateInferRequest();
+  uint32_t GetOptimalNumberOfInferRequests();
 };
 
 class OVInferRequest {
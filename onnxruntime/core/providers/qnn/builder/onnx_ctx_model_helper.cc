@@ -8,6 +8,7 @@
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <future>
 
 namespace onnxruntime {
 namespace qnn {
@@ -60,32 +61,27 @@ Status CreateNodeArgs(const std::vector<std::string>& names,
   return Status::OK();
 }
 
-Status GetEpContextFromModel(const onnxruntime::PathString& ctx_onnx_model_path,
-                             QnnBackendManager* qnn_backend_manager,
-                             QnnModel& qnn_model,
-                             const logging::Logger& logger) {
-  using namespace onnxruntime;
-  std::shared_ptr<Model> model;
-  ORT_RETURN_IF_ERROR(Model::Load(ToPathString(ctx_onnx_model_path), model, {}, logger));
-  const auto& graph = model->MainGraph();
-  return GetEpContextFromGraph(GraphViewer(graph),
-                               ctx_onnx_model_path,
-                               qnn_backend_manager,
-                               qnn_model);
+const onnxruntime::Node& GetEpContextNode(const onnxruntime::GraphViewer& graph_viewer) {
+  return *graph_viewer.Nodes().begin();
 }
 
-Status GetEpContextFromGraph(const onnxruntime::GraphViewer& graph_viewer,
-                             const onnxruntime::PathString& ctx_onnx_model_path,
-                             QnnBackendManager* qnn_backend_manager,
-                             QnnModel& qnn_model) {
-  const auto& node = graph_viewer.Nodes().begin();
-  NodeAttrHelper node_helper(*node);
+bool IsMainContextNode(const onnxruntime::Node& ep_context_node) {
+  NodeAttrHelper node_helper(ep_context_node);
+  return node_helper.Get(MAIN_CONTEXT, static_cast<int64_t>(1)) == 1;
+}
+
+Status GetEpContextFromMainNode(const onnxruntime::Node& main_context_node,
+                                const onnxruntime::PathString& ctx_onnx_model_path,
+                                QnnBackendManager* qnn_backend_manager,
+                                QnnModelLookupTable& qnn_models) {
+  ORT_RETURN_IF_NOT(EPCONTEXT_OP == main_context_node.OpType(), "Should only filter in the EPContext node.");
+  NodeAttrHelper node_helper(main_context_node);
   bool is_embed_mode = node_helper.Get(EMBED_MODE, true);
   if (is_embed_mode) {
     const std::string& context_binary = node_helper.Get(EP_CACHE_CONTEXT, "");
     return qnn_backend_manager->LoadCachedQnnContextFromBuffer(const_cast<char*>(context_binary.c_str()),
                                                                static_cast<uint64_t>(context_binary.length()),
-                                                               qnn_model);
+                                                               qnn_models);
   }
 
   std::string external_qnn_context_binary_file_name = node_helper.Get(EP_CACHE_CONTEXT, "");
@@ -109,21 +105,43 @@ Status GetEpContextFromGraph(const onnxruntime::GraphViewer& graph_viewer,
   cache_file.close();
   return qnn_backend_manager->LoadCachedQnnContextFromBuffer(buffer.get(),
                                                              static_cast<uint64_t>(buffer_size),
-                                                             qnn_model);
+                                                             qnn_models);
 }
 
-Status LoadQnnCtxFromOnnxModel(const onnxruntime::GraphViewer& graph_viewer,
+Status LoadQnnCtxFromMainNodes(const std::vector<const onnxruntime::Node*>& main_context_nodes,
                                const onnxruntime::PathString& ctx_onnx_model_path,
-                               bool is_qnn_ctx_model,
-                               bool is_ctx_cache_file_exist,
                                QnnBackendManager* qnn_backend_manager,
-                               QnnModel& qnn_model,
-                               const logging::Logger& logger) {
+                               QnnModelLookupTable& qnn_models) {
   Status status;
-  if (is_qnn_ctx_model) {
-    status = GetEpContextFromGraph(graph_viewer, ctx_onnx_model_path, qnn_backend_manager, qnn_model);
-  } else if (is_ctx_cache_file_exist) {
-    status = GetEpContextFromModel(ctx_onnx_model_path, qnn_backend_manager, qnn_model, logger);
+  if (main_context_nodes.size() == 1) {
+    status = GetEpContextFromMainNode(*main_context_nodes[0], ctx_onnx_model_path, qnn_backend_manager, qnn_models);
+  } else if (main_context_nodes.size() > 1) {
+    // Overlap reading and loading the binaries, each one goes to a Qnn context of its own
+    std::vector<QnnModelLookupTable> qnn_models_per_node(main_context_nodes.size());
+    std::vector<std::future<Status>> load_results;
+    load_results.reserve(main_context_nodes.size());
+    for (size_t i = 0; i < main_context_nodes.size(); ++i) {
+      load_results.push_back(std::async(std::launch::async, [&, i]() {
+        return GetEpContextFromMainNode(*main_context_nodes[i], ctx_onnx_model_path, qnn_backend_manager,
+                                        qnn_models_per_node[i]);
+      }));
+    }
+
+    for (auto& load_result : load_results) {
+      auto load_status = load_result.get();
+      if (status.IsOK()) {
+        status = load_status;
+      }
+    }
+
+    for (auto& node_qnn_models : qnn_models_per_node) {
+      for (auto& qnn_model_kv : node_qnn_models) {
+        if (status.IsOK() && !qnn_models.emplace(qnn_model_kv.first, std::move(qnn_model_kv.second)).second) {
+          status = ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_GRAPH, "Graph ", qnn_model_kv.first,
+                                   " exists in more than one Qnn context binary.");
+        }
+      }
+    }
   }
 
   if (!status.IsOK()) {
@@ -133,6 +151,28 @@ Status LoadQnnCtxFromOnnxModel(const onnxruntime::GraphViewer& graph_viewer,
   return Status::OK();
 }
 
+Status GetEpContextFromModel(const onnxruntime::PathString& ctx_onnx_model_path,
+                             QnnBackendManager* qnn_backend_manager,
+                             QnnModelLookupTable& qnn_models,
+                             const logging::Logger& logger) {
+  using namespace onnxruntime;
+  std::shared_ptr<Model> model;
+  ORT_RETURN_IF_ERROR(Model::Load(ToPathString(ctx_onnx_model_path), model, {}, logger));
+  const auto& graph = GraphViewer(model->MainGraph());
+
+  std::vector<const Node*> main_context_nodes;
+  for (const auto& node : graph.Nodes()) {
+    if (EPCONTEXT_OP == node.OpType() && IsMainContextNode(node)) {
+      main_context_nodes.push_back(&node);
+    }
+  }
+  if (main_context_nodes.empty()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_GRAPH, "No Qnn context binary in the EpContextModel.");
+  }
+
+  return LoadQnnCtxFromMainNodes(main_context_nodes, ctx_onnx_model_path, qnn_backend_manager, qnn_models);
+}
+
 Status GetMetadataFromEpContextModel(const onnxruntime::PathString& ctx_onnx_model_path,
                                      std::string& model_name,
                                      std::string& model_description,
@@ -212,7 +252,7 @@ Status GenerateCtxCacheOnnxModel(const std::string model_name,
                                  uint64_t buffer_size,
                                  const std::string& sdk_build_version,
                                  const std::vector<IExecutionProvider::FusedNodeAndGraph>& fused_nodes_and_graphs,
-                                 const std::unordered_map<std::string, std::unique_ptr<QnnModel>>& qnn_models,
+                                 const QnnModelLookupTable& qnn_models,
                                  const onnxruntime::PathString& context_cache_path,
                                  bool qnn_context_embed_mode,
                                  const logging::Logger& logger) {
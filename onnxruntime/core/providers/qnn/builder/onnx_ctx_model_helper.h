@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "qnn_def.h"
@@ -19,6 +21,7 @@ namespace qnn {
 
 class QnnModel;
 class QnnBackendManager;
+using QnnModelLookupTable = std::unordered_map<std::string, std::unique_ptr<QnnModel>>;
 
 static const std::string EPCONTEXT_OP = "EPContext";
 static const std::string MAIN_CONTEXT = "main_context";
@@ -42,23 +45,28 @@ bool IsContextCacheFileExists(const std::string& customer_context_cache_path,
                               const onnxruntime::PathString& model_pathstring,
                               onnxruntime::PathString& context_cache_path);
 
-Status GetEpContextFromModel(const onnxruntime::PathString& ctx_onnx_model_path,
-                             QnnBackendManager* qnn_backend_manager,
-                             QnnModel& qnn_model,
-                             const logging::Logger& logger);
+// Get the EPContext node of a fused graph from an Onnx model with Qnn context cache binary
+const onnxruntime::Node& GetEpContextNode(const onnxruntime::GraphViewer& graph_viewer);
 
-Status GetEpContextFromGraph(const onnxruntime::GraphViewer& graph_viewer,
-                             const onnxruntime::PathString& ctx_onnx_model_path,
-                             QnnBackendManager* qnn_backend_manager,
-                             QnnModel& qnn_model);
+// Whether the EPContext node holds the Qnn context binary, rather than referring to a graph in the binary of another node
+bool IsMainContextNode(const onnxruntime::Node& ep_context_node);
+
+Status GetEpContextFromMainNode(const onnxruntime::Node& main_context_node,
+                                const onnxruntime::PathString& ctx_onnx_model_path,
+                                QnnBackendManager* qnn_backend_manager,
+                                QnnModelLookupTable& qnn_models);
 
-Status LoadQnnCtxFromOnnxModel(const onnxruntime::GraphViewer& graph_viewer,
+// Load the Qnn context binaries of the main context nodes, concurrently if there are several of them.
+// The QnnModels of all the graphs in the binaries are added to qnn_models.
+Status LoadQnnCtxFromMainNodes(const std::vector<const onnxruntime::Node*>& main_context_nodes,
                                const onnxruntime::PathString& ctx_onnx_model_path,
-                               bool is_qnn_ctx_model,
-                               bool is_ctx_cache_file_exist,
                                QnnBackendManager* qnn_backend_manager,
-                               QnnModel& qnn_model,
-                               const logging::Logger& logger);
+                               QnnModelLookupTable& qnn_models);
+
+Status GetEpContextFromModel(const onnxruntime::PathString& ctx_onnx_model_path,
+                             QnnBackendManager* qnn_backend_manager,
+                             QnnModelLookupTable& qnn_models,
+                             const logging::Logger& logger);
 
 Status ValidateWithContextFile(const onnxruntime::PathString& context_cache_path,
                                const std::string& model_name,
@@ -79,7 +87,7 @@ Status GenerateCtxCacheOnnxModel(const std::string model_name,
                                  uint64_t buffer_size,
                                  const std::string& sdk_build_version,
                                  const std::vector<IExecutionProvider::FusedNodeAndGraph>& fused_nodes_and_graphs,
-                                 const std::unordered_map<std::string, std::unique_ptr<QnnModel>>& qnn_models,
+                                 const QnnModelLookupTable& qnn_models,
                                  const onnxruntime::PathString& context_cache_path,
                                  bool qnn_context_embed_mode,
                                  const logging::Logger& logger);
@@ -433,6 +433,15 @@ Status QnnBackendManager::CreateContext() {
 }
 
 Status QnnBackendManager::ReleaseContext() {
+  {
+    std::lock_guard<std::mutex> lock(contexts_from_binary_mutex_);
+    for (auto context : contexts_from_binary_) {
+      auto result = qnn_interface_.contextFree(context, nullptr);
+      ORT_RETURN_IF(QNN_CONTEXT_NO_ERROR != result, "Failed to release context created from binary.");
+    }
+    contexts_from_binary_.clear();
+  }
+
   if (false == context_created_) {
     return Status::OK();
   }
@@ -483,15 +492,26 @@ std::unique_ptr<unsigned char[]> QnnBackendManager::GetContextBinaryBuffer(uint6
   return context_buffer;
 }
 
-Status QnnBackendManager::LoadCachedQnnContextFromBuffer(char* buffer, uint64_t buffer_length, QnnModel& qnn_model) {
+Status QnnBackendManager::LoadCachedQnnContextFromBuffer(char* buffer, uint64_t buffer_length,
+                                                         QnnModelLookupTable& qnn_models) {
   bool result = nullptr == qnn_sys_interface_.systemContextCreate ||
                 nullptr == qnn_sys_interface_.systemContextGetBinaryInfo ||
                 nullptr == qnn_sys_interface_.systemContextFree;
   ORT_RETURN_IF(result, "Failed to get valid function pointer.");
 
+  // The backend profile handle collects the events of one call at a time
+  const bool profiling_enabled = ProfilingLevel::OFF != profiling_level_ && ProfilingLevel::INVALID != profiling_level_;
+  std::unique_lock<std::mutex> profiling_lock(contexts_from_binary_mutex_, std::defer_lock);
+  if (profiling_enabled) {
+    profiling_lock.lock();
+  }
+
   QnnSystemContext_Handle_t sys_ctx_handle = nullptr;
   auto rt = qnn_sys_interface_.systemContextCreate(&sys_ctx_handle);
   ORT_RETURN_IF(QNN_SUCCESS != rt, "Failed to create system handle.");
+  auto free_sys_ctx = gsl::finally([this, &sys_ctx_handle]() {
+    qnn_sys_interface_.systemContextFree(sys_ctx_handle);
+  });
 
   const QnnSystemContext_BinaryInfo_t* binary_info = nullptr;
   Qnn_ContextBinarySize_t binary_info_size{0};
@@ -516,8 +536,7 @@ Status QnnBackendManager::LoadCachedQnnContextFromBuffer(char* buffer, uint64_t
     graphs_info = binary_info->contextBinaryInfoV2.graphs;
   }
 
-  ORT_RETURN_IF(graph_count > 1, "Load from Qnn cached context only support 1 sub-graph.");
-  ORT_RETURN_IF(graphs_info == nullptr, "Failed to get graph info from Qnn cached context.");
+  ORT_RETURN_IF(graphs_info == nullptr || graph_count == 0, "Failed to get graph info from Qnn cached context.");
 
   ORT_RETURN_IF(nullptr == qnn_interface_.contextCreateFromBinary,
                 "Invalid function pointer for contextCreateFromBinary.");
@@ -526,26 +545,38 @@ Status QnnBackendManager::LoadCachedQnnContextFromBuffer(char* buffer, uint64_t
   ORT_RETURN_IF_ERROR(SetQnnContextConfig(context_priority_, qnn_context_config));
   const QnnContext_Config_t* context_configs[] = {&qnn_context_config, nullptr};
 
+  Qnn_ContextHandle_t context = nullptr;
   rt = qnn_interface_.contextCreateFromBinary(backend_handle_,
                                               device_handle_,
                                               context_configs,
                                               static_cast<void*>(buffer),
                                               buffer_length,
-                                              &context_,
-                                              profile_backend_handle_);
+                                              &context,
+                                              profiling_enabled ? profile_backend_handle_ : nullptr);
   ORT_RETURN_IF(QNN_SUCCESS != rt, "Failed to create context from binary.");
 
-  // More work to support multiple partition, how to map the graph name in compile to qnn graph name
-  // Need the lower level framework to understand EPContext op and pass in the partition_name in fused_node during Compile
-  ORT_RETURN_IF_ERROR(qnn_model.DeserializeGraphInfoFromBinaryInfo(graphs_info[0]));
+  {
+    std::unique_lock<std::mutex> lock(contexts_from_binary_mutex_, std::defer_lock);
+    if (!profiling_enabled) {
+      lock.lock();
+    }
+    contexts_from_binary_.push_back(context);
+  }
 
-  qnn_sys_interface_.systemContextFree(sys_ctx_handle);
-  sys_ctx_handle = nullptr;
+  // The graphs in the binary share the weights of the context, each is retrieved by the name it was composed with
+  for (uint32_t i = 0; i < graph_count; ++i) {
+    auto qnn_model = std::make_unique<QnnModel>(*logger_, this);
+    ORT_RETURN_IF_ERROR(qnn_model->DeserializeGraphInfoFromBinaryInfo(graphs_info[i], context));
+    const std::string graph_name = qnn_model->Name();
+    ORT_RETURN_IF_NOT(qnn_models.emplace(graph_name, std::move(qnn_model)).second,
+                      "Duplicate graph name in Qnn cached context: ", graph_name);
+  }
 
-  ORT_RETURN_IF_ERROR(ExtractBackendProfilingInfo());
-  context_created_ = true;
+  if (profiling_enabled) {
+    ORT_RETURN_IF_ERROR(ExtractBackendProfilingInfo());
+  }
 
-  LOGS(*logger_, VERBOSE) << "Load from cached QNN Context completed.";
+  LOGS(*logger_, VERBOSE) << "Load from cached QNN Context completed, number of graphs: " << graph_count;
   return Status::OK();
 }
 
@@ -74,7 +74,8 @@ class QnnModel {
     return GetInputOutputIndex(name, outputs_info_);
   }
 
-  Status DeserializeGraphInfoFromBinaryInfo(const QnnSystemContext_GraphInfo_t& qnn_sys_ctx_graph_info);
+  Status DeserializeGraphInfoFromBinaryInfo(const QnnSystemContext_GraphInfo_t& qnn_sys_ctx_graph_info,
+                                            const Qnn_ContextHandle_t& context);
 
   const std::vector<std::string>& GetInputNames() const {
     return input_names_;
@@ -131,5 +132,8 @@ class QnnModel {
   QnnBackendType qnn_backend_type_ = QnnBackendType::CPU;
 };
 
+// <graph name, QnnModel>
+using QnnModelLookupTable = std::unordered_map<std::string, std::unique_ptr<QnnModel>>;
+
 }  // namespace qnn
 }  // namespace onnxruntime
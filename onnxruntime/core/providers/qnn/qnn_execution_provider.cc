@@ -131,6 +131,10 @@ QNNExecutionProvider::QNNExecutionProvider(const ProviderOptions& provider_optio
     LOGS_DEFAULT(VERBOSE) << "User specified context cache embed mode: " << qnn_context_embed_mode_;
 
     context_cache_path_cfg_ = session_options->config_options.GetConfigOrDefault(kOrtSessionOptionEpContextFilePath, "");
+
+    share_ep_contexts_ = session_options->config_options.GetConfigOrDefault(
+                             kOrtSessionOptionShareEpContexts, "0") == "1";
+    LOGS_DEFAULT(VERBOSE) << "Share EP contexts: " << share_ep_contexts_;
   }
 
   static const std::string BACKEND_PATH = "backend_path";
@@ -199,13 +203,22 @@ QNNExecutionProvider::QNNExecutionProvider(const ProviderOptions& provider_optio
     }
   }
 
-  qnn_backend_manager_ = std::make_unique<qnn::QnnBackendManager>(
-      std::move(backend_path),
-      profiling_level,
-      rpc_control_latency,
-      htp_performance_mode,
-      context_priority,
-      std::move(qnn_saver_path));
+  auto create_backend_manager = [&]() {
+    return std::make_shared<qnn::QnnBackendManager>(
+        std::move(backend_path),
+        profiling_level,
+        rpc_control_latency,
+        htp_performance_mode,
+        context_priority,
+        std::move(qnn_saver_path));
+  };
+
+  if (share_ep_contexts_) {
+    // The options of the session which creates the shared backend apply to all the sessions sharing it
+    qnn_backend_manager_ = SharedContext::GetInstance().GetOrCreateQnnBackendManager(create_backend_manager);
+  } else {
+    qnn_backend_manager_ = create_backend_manager();
+  }
 }
 
 bool QNNExecutionProvider::IsNodeSupported(qnn::QnnModelWrapper& qnn_model_wrapper, const NodeUnit& node_unit,
@@ -245,7 +258,7 @@ QNNExecutionProvider::GetSupportedNodes(const GraphViewer& graph_viewer,
                                         bool load_from_cached_context,
                                         const logging::Logger& logger) const {
   std::unordered_set<const Node*> supported_nodes{};
-  // Enable Qnn context cache requires the whole graph partitioned to Qnn EP
+  // Loading the QDQ model with an existing Qnn context cache file requires the whole graph partitioned to Qnn EP
   // Blindly filter in all nodes if context cache is enabled
   if (load_from_cached_context) {
     for (const auto& node : graph_viewer.Nodes()) {
@@ -404,7 +417,17 @@ QNNExecutionProvider::GetCapability(const onnxruntime::GraphViewer& graph_viewer
   size_t num_of_supported_nodes = 0;
 
   // Create partitions from supported nodes.
-  {
+  if (is_qnn_ctx_model) {
+    // Each EPContext node is a partition of its own, which refers to a graph in a Qnn context binary.
+    // The other nodes of the model are left to other EPs.
+    for (const auto& node : graph_viewer.Nodes()) {
+      if (qnn::EPCONTEXT_OP != node.OpType()) {
+        continue;
+      }
+      result.push_back(utils::MakeComputeCapability(graph_viewer, {&node}, gen_metadef_name, QNN));
+      ++num_of_supported_nodes;
+    }
+  } else {
     std::vector<std::unique_ptr<ComputeCapability>> partitions = utils::CreateSupportedPartitions(graph_viewer,
                                                                                                   supported_nodes, {},
                                                                                                   gen_metadef_name, QNN,
@@ -538,6 +561,74 @@ Status QNNExecutionProvider::CompileFromOrtGraph(const std::vector<FusedNodeAndG
   return Status::OK();
 }
 
+Status QNNExecutionProvider::CompileFromQnnCtx(const std::vector<FusedNodeAndGraph>& fused_nodes_and_graphs,
+                                               std::vector<NodeComputeInfo>& node_compute_funcs,
+                                               const onnxruntime::PathString& context_cache_path,
+                                               bool is_qnn_ctx_model,
+                                               const logging::Logger& logger) {
+  // Load and execute from cached context if exist
+  qnn::QnnModelLookupTable qnn_models;
+  if (is_qnn_ctx_model) {
+    // Load the binaries once for all the partitions, skipping the ones whose graphs another session has loaded
+    std::vector<const Node*> main_context_nodes;
+    for (const auto& fused_node_and_graph : fused_nodes_and_graphs) {
+      const Node& ep_context_node = qnn::GetEpContextNode(fused_node_and_graph.filtered_graph);
+      if (qnn::IsMainContextNode(ep_context_node) &&
+          !(share_ep_contexts_ && SharedContext::GetInstance().HasQnnModel(ep_context_node.Name()))) {
+        main_context_nodes.push_back(&ep_context_node);
+      }
+    }
+    ORT_RETURN_IF_ERROR(qnn::LoadQnnCtxFromMainNodes(main_context_nodes,
+                                                     context_cache_path,
+                                                     qnn_backend_manager_.get(),
+                                                     qnn_models));
+  } else {
+    ORT_RETURN_IF(fused_nodes_and_graphs.size() != 1, "Only support single partition for context cache feature.");
+    ORT_RETURN_IF_ERROR(qnn::GetEpContextFromModel(context_cache_path,
+                                                   qnn_backend_manager_.get(),
+                                                   qnn_models,
+                                                   logger));
+  }
+
+  for (const auto& fused_node_and_graph : fused_nodes_and_graphs) {
+    Node& fused_node = fused_node_and_graph.fused_node;
+    const onnxruntime::GraphViewer& graph_viewer(fused_node_and_graph.filtered_graph);
+
+    // The graphs are composed with the names of the fused nodes which generate the context binary,
+    // which are the names of the EPContext nodes in the Qnn context model.
+    const std::string& graph_name = is_qnn_ctx_model ? qnn::GetEpContextNode(graph_viewer).Name() : fused_node.Name();
+    std::unique_ptr<qnn::QnnModel> qnn_model;
+    auto qnn_model_kv = qnn_models.find(graph_name);
+    if (qnn_model_kv != qnn_models.end()) {
+      qnn_model = std::move(qnn_model_kv->second);
+      qnn_models.erase(qnn_model_kv);
+    } else if (fused_nodes_and_graphs.size() == 1 && qnn_models.size() == 1) {
+      // A binary with a single graph, e.g. generated by the Qnn toolchain with a graph name of its own
+      qnn_model = std::move(qnn_models.begin()->second);
+      qnn_models.clear();
+    } else if (share_ep_contexts_) {
+      qnn_model = SharedContext::GetInstance().GetSharedQnnModel(graph_name);
+    }
+    ORT_RETURN_IF(nullptr == qnn_model, "Graph ", graph_name, " is not found in the Qnn context binaries.");
+
+    ORT_RETURN_IF_ERROR(qnn_model->SetGraphInputOutputInfo(graph_viewer, fused_node));
+    ORT_RETURN_IF_ERROR(qnn_model->SetupQnnInputOutput());
+
+    // fused node name is QNNExecutionProvider_QNN_[hash_id]_[id]
+    // the name here should be same with context->node_name in compute_info
+    qnn_models_.emplace(fused_node.Name(), std::move(qnn_model));
+
+    ORT_RETURN_IF_ERROR(CreateComputeFunc(node_compute_funcs, logger));
+  }
+
+  // Keep the graphs this session doesn't run for the other sessions sharing the contexts
+  if (share_ep_contexts_ && !qnn_models.empty()) {
+    SharedContext::GetInstance().AddSharedQnnModels(std::move(qnn_models));
+  }
+
+  return Status::OK();
+}
+
 Status QNNExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fused_nodes_and_graphs,
                                      std::vector<NodeComputeInfo>& node_compute_funcs) {
   const auto& logger = *GetLogger();
@@ -563,25 +654,7 @@ Status QNNExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fused
   }
 
   if (is_qnn_ctx_model || (context_cache_enabled_ && is_ctx_file_exist)) {
-    ORT_RETURN_IF(fused_nodes_and_graphs.size() != 1, "Only support single partition for context cache feature.");
-    std::unique_ptr<qnn::QnnModel> qnn_model = std::make_unique<qnn::QnnModel>(logger, qnn_backend_manager_.get());
-    // Load and execute from cached context if exist
-    ORT_RETURN_IF_ERROR(qnn::LoadQnnCtxFromOnnxModel(graph_viewer,
-                                                     context_cache_path,
-                                                     is_qnn_ctx_model,
-                                                     is_ctx_file_exist,
-                                                     qnn_backend_manager_.get(),
-                                                     *(qnn_model.get()),
-                                                     logger));
-    ORT_RETURN_IF_ERROR(qnn_model->SetGraphInputOutputInfo(graph_viewer, fused_node));
-    ORT_RETURN_IF_ERROR(qnn_model->SetupQnnInputOutput());
-
-    // fused node name is QNNExecutionProvider_QNN_[hash_id]_[id]
-    // the name here should be same with context->node_name in compute_info
-    qnn_models_.emplace(graph_meta_id, std::move(qnn_model));
-
-    ORT_RETURN_IF_ERROR(CreateComputeFunc(node_compute_funcs, logger));
-    return Status::OK();
+    return CompileFromQnnCtx(fused_nodes_and_graphs, node_compute_funcs, context_cache_path, is_qnn_ctx_model, logger);
   }
 
   ORT_RETURN_IF_ERROR(CompileFromOrtGraph(fused_nodes_and_graphs, node_compute_funcs, logger));
@@ -5,6 +5,9 @@
 
 #include "core/framework/execution_provider.h"
 #include "core/framework/session_options.h"
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include "core/providers/qnn/builder/qnn_backend_manager.h"
 #include "core/providers/qnn/builder/qnn_model.h"
@@ -12,6 +15,64 @@
 
 namespace onnxruntime {
 
+// The Qnn backend and the graphs of the Qnn context binaries shared by the sessions which enable ep.share_ep_contexts.
+// A session takes the graphs it runs from the loaded binaries and leaves the others here, so a session of another
+// model in the same binary, e.g. the decode graph of a LLM loaded along with its prefill graph, uses the graph with the
+// weights already on the device. The backend manager lives as long as a session uses it.
+class SharedContext {
+ public:
+  static SharedContext& GetInstance() {
+    static SharedContext instance;
+    return instance;
+  }
+
+  std::shared_ptr<qnn::QnnBackendManager> GetOrCreateQnnBackendManager(
+      const std::function<std::shared_ptr<qnn::QnnBackendManager>()>& create_backend_manager) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto qnn_backend_manager = qnn_backend_manager_.lock();
+    if (qnn_backend_manager == nullptr) {
+      // the graphs left by the sessions of a released backend can't run anymore
+      shared_qnn_models_.clear();
+      qnn_backend_manager = create_backend_manager();
+      qnn_backend_manager_ = qnn_backend_manager;
+    }
+    return qnn_backend_manager;
+  }
+
+  bool HasQnnModel(const std::string& graph_name) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return shared_qnn_models_.find(graph_name) != shared_qnn_models_.end();
+  }
+
+  // Takes the graph out of the shared context, nullptr if there is no such graph
+  std::unique_ptr<qnn::QnnModel> GetSharedQnnModel(const std::string& graph_name) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = shared_qnn_models_.find(graph_name);
+    if (it == shared_qnn_models_.end()) {
+      return nullptr;
+    }
+    auto qnn_model = std::move(it->second);
+    shared_qnn_models_.erase(it);
+    return qnn_model;
+  }
+
+  void AddSharedQnnModels(qnn::QnnModelLookupTable&& qnn_models) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    for (auto& qnn_model_kv : qnn_models) {
+      shared_qnn_models_[qnn_model_kv.first] = std::move(qnn_model_kv.second);
+    }
+  }
+
+ private:
+  SharedContext() = default;
+  ~SharedContext() = default;
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SharedContext);
+
+  std::weak_ptr<qnn::QnnBackendManager> qnn_backend_manager_;
+  qnn::QnnModelLookupTable shared_qnn_models_;
+  std::mutex mtx_;
+};
+
 // Logical device representation.
 class QNNExecutionProvider : public IExecutionProvider {
  public:
@@ -49,6 +110,12 @@ class QNNExecutionProvider : public IExecutionProvider {
   Status CreateComputeFunc(std::vector<NodeComputeInfo>& node_compute_funcs,
                            const logging::Logger& logger);
 
+  Status CompileFromQnnCtx(const std::vector<FusedNodeAndGraph>& fused_nodes_and_graphs,
+                           std::vector<NodeComputeInfo>& node_compute_funcs,
+                           const onnxruntime::PathString& context_cache_path,
+                           bool is_qnn_ctx_model,
+                           const logging::Logger& logger);
+
   Status CompileFromOrtGraph(const std::vector<FusedNodeAndGraph>& fused_nodes_and_graphs,
                              std::vector<NodeComputeInfo>& node_compute_funcs,
                              const logging::Logger& logger);
@@ -59,12 +126,13 @@ class QNNExecutionProvider : public IExecutionProvider {
 
  private:
   qnn::HtpGraphFinalizationOptimizationMode htp_graph_finalization_opt_mode_ = qnn::HtpGraphFinalizationOptimizationMode::kDefault;
-  std::unique_ptr<qnn::QnnBackendManager> qnn_backend_manager_;
-  std::unordered_map<std::string, std::unique_ptr<qnn::QnnModel>> qnn_models_;
+  std::shared_ptr<qnn::QnnBackendManager> qnn_backend_manager_;
+  qnn::QnnModelLookupTable qnn_models_;
   bool context_cache_enabled_ = false;
   std::string context_cache_path_cfg_ = "";
   bool disable_cpu_ep_fallback_ = false;  // True if CPU EP fallback has been disabled for this session.
   bool qnn_context_embed_mode_ = true;
+  bool share_ep_contexts_ = false;
   int32_t vtcm_size_in_mb_ = 0;
 };
 
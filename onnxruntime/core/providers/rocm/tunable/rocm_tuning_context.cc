@@ -53,6 +53,19 @@ Status RocmTuningResultsValidator::ValidateDeviceModel(const std::string& value)
   return Status::OK();
 }
 
+// the kernels selected by tuning depend on the architecture and its features, e.g. gfx90a:sramecc+:xnack-, which
+// devices with the same model name don't necessarily share.
+std::string RocmTuningResultsValidator::GetGcnArch() const {
+  return ep_->GetDeviceProp().gcnArchName;
+}
+
+Status RocmTuningResultsValidator::ValidateGcnArch(const std::string& value) const {
+  auto current = GetGcnArch();
+  ORT_RETURN_IF(current != value, "GCN architecture mismatch: tuning results produced with ", value,
+                ", onnxruntime currently run with ", current);
+  return Status::OK();
+}
+
 RocmTuningResultsValidator::RocmTuningResultsValidator(ROCMExecutionProvider* ep) : ep_{ep} {
   RegisterValidator("HIP_VERSION", GetHipVersion, ValidateHipVersion);
   RegisterValidator("ROCBLAS_VERSION", GetRocBlasVersion, ValidateRocBlasVersion);
@@ -60,6 +73,10 @@ RocmTuningResultsValidator::RocmTuningResultsValidator(ROCMExecutionProvider* ep
       "DEVICE_MODEL",
       [this]() { return GetDeviceModel(); },
       [this](const std::string& value) { return ValidateDeviceModel(value); });
+  RegisterValidator(
+      "GCN_ARCH",
+      [this]() { return GetGcnArch(); },
+      [this](const std::string& value) { return ValidateGcnArch(value); });
 }
 
 std::string RocmTuningResultsValidator::GetOrtBuildConfig() const {
@@ -25,6 +25,9 @@ class RocmTuningResultsValidator : public TuningResultsValidator {
   std::string GetDeviceModel() const;
   Status ValidateDeviceModel(const std::string& value) const;
 
+  std::string GetGcnArch() const;
+  Status ValidateGcnArch(const std::string& value) const;
+
  private:
   ROCMExecutionProvider* ep_;  // non-owning handle
 };
@@ -274,6 +274,9 @@ std::unordered_set<NodeIndex> GetCpuPreferredNodes(const onnxruntime::GraphViewe
 
 std::string GetEnvironmentVar(const std::string& var_name);
 
+bool IsRecordingKernelDispatch() noexcept;
+void RecordKernelDispatch(const char* key, const char* value);
+
 namespace profiling {
 
 std::string demangle(const char* name);
@@ -365,6 +365,9 @@ std::string GetEnvironmentVar(const std::string& var_name) {
   return g_host->GetEnvironmentVar(var_name);
 }
 
+bool IsRecordingKernelDispatch() noexcept { return g_host->IsRecordingKernelDispatch(); }
+void RecordKernelDispatch(const char* key, const char* value) { g_host->RecordKernelDispatch(key, value); }
+
 std::unordered_set<NodeIndex> GetCpuPreferredNodes(const onnxruntime::GraphViewer& graph,
                                                    const IExecutionProvider::IKernelLookup& kernel_lookup,
                                                    gsl::span<const NodeIndex> tentative_nodes) {
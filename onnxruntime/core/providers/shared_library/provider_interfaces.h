@@ -135,6 +135,9 @@ struct ProviderHost {
 
   virtual std::string GetEnvironmentVar(const std::string& var_name) = 0;
 
+  virtual bool IsRecordingKernelDispatch() noexcept = 0;
+  virtual void RecordKernelDispatch(const char* key, const char* value) = 0;
+
   virtual void LogRuntimeError(uint32_t session_id, const common::Status& status,
                                const char* file, const char* function, uint32_t line) = 0;
 
@@ -782,6 +785,8 @@ struct ProviderHost {
   virtual bool OpKernelContext__GetUseDeterministicCompute(const OpKernelContext* p) = 0;
   virtual bool OpKernelContext__TryGetInferredOutputShape(const OpKernelContext* p, int index, TensorShape& shape) = 0;
   virtual bool OpKernelContext__TryGetInferredInputShape(const OpKernelContext* p, int index, TensorShape& shape) = 0;
+  virtual bool OpKernelContext__IsInputDeadAfterKernel(const OpKernelContext* p, int index) = 0;
+  virtual Tensor* OpKernelContext__OutputMayReuseInput(OpKernelContext* p, int output_index, int input_index, const TensorShape& shape) = 0;
   virtual Stream* OpKernelContext__GetComputeStream(const OpKernelContext* p) = 0;
 
   // OpKernelInfo
@@ -813,6 +813,8 @@ struct OpKernelContext final {
 
   bool TryGetInferredOutputShape(int index, TensorShape& shape) const { return g_host->OpKernelContext__TryGetInferredOutputShape(this, index, shape); }
   bool TryGetInferredInputShape(int index, TensorShape& shape) const { return g_host->OpKernelContext__TryGetInferredInputShape(this, index, shape); }
+  bool IsInputDeadAfterKernel(int index) const { return g_host->OpKernelContext__IsInputDeadAfterKernel(this, index); }
+  Tensor* OutputMayReuseInput(int output_index, int input_index, const TensorShape& shape) { return g_host->OpKernelContext__OutputMayReuseInput(this, output_index, input_index, shape); }
   Stream* GetComputeStream() const { return g_host->OpKernelContext__GetComputeStream(this); }
 
   PROVIDER_DISALLOW_ALL(OpKernelContext)
@@ -716,6 +716,49 @@ Status ApplyProfileShapesFromInputTensorValue(std::vector<nvinfer1::IOptimizatio
   return Status::OK();
 }
 
+/*
+ * Get the index of the first optimization profile of the engine whose min/max shapes cover the shapes of all the
+ * execution tensor inputs of the current run, or -1 if none of the profiles does.
+ *
+ * Shape tensor inputs aren't checked, as their values are on the device and are only read when the profile shapes
+ * are applied from input tensor values.
+ */
+int GetProfileIndexForInputShapes(Ort::KernelContext& ctx,
+                                  const nvinfer1::ICudaEngine* trt_engine,
+                                  const std::unordered_map<std::string, size_t>& input_indexes) {
+  for (int profile_index = 0, num_profiles = trt_engine->getNbOptimizationProfiles(); profile_index < num_profiles; ++profile_index) {
+    bool covered = true;
+    for (int i = 0, end = trt_engine->getNbIOTensors(); i < end && covered; ++i) {
+      auto const& name = trt_engine->getIOTensorName(i);
+      if (trt_engine->getTensorIOMode(name) != nvinfer1::TensorIOMode::kINPUT || trt_engine->isShapeInferenceIO(name)) {
+        continue;
+      }
+
+      const auto iter = input_indexes.find(name);
+      if (iter == input_indexes.end()) {
+        continue;
+      }
+      const auto tensor_shapes = ctx.GetInput(iter->second).GetTensorTypeAndShapeInfo().GetShape();
+      nvinfer1::Dims dims_min = trt_engine->getProfileShape(name, profile_index, nvinfer1::OptProfileSelector::kMIN);
+      nvinfer1::Dims dims_max = trt_engine->getProfileShape(name, profile_index, nvinfer1::OptProfileSelector::kMAX);
+      if (dims_min.nbDims != static_cast<int>(tensor_shapes.size())) {
+        covered = false;
+        break;
+      }
+      for (int j = 0, nb_dims = dims_min.nbDims; j < nb_dims; ++j) {
+        if (tensor_shapes[j] < dims_min.d[j] || tensor_shapes[j] > dims_max.d[j]) {
+          covered = false;
+          break;
+        }
+      }
+    }
+    if (covered) {
+      return profile_index;
+    }
+  }
+  return -1;
+}
+
 /*
  * Set TensorRT execution context input.
  *
@@ -1375,6 +1418,7 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     profile_max_shapes = info.profile_max_shapes;
     profile_opt_shapes = info.profile_opt_shapes;
     cuda_graph_enable_ = info.cuda_graph_enable;
+    background_engine_build_ = info.background_engine_build;
   } else {
     try {
       const std::string max_partition_iterations_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kMaxPartitionIterations);
@@ -1528,6 +1572,11 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
       if (!cuda_graph_enable_env.empty()) {
         cuda_graph_enable_ = (std::stoi(cuda_graph_enable_env) == 0 ? false : true);
       }
+
+      const std::string background_engine_build_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kBackgroundEngineBuild);
+      if (!background_engine_build_env.empty()) {
+        background_engine_build_ = (std::stoi(background_engine_build_env) == 0 ? false : true);
+      }
     } catch (const std::invalid_argument& ex) {
       LOGS_DEFAULT(WARNING) << "[TensorRT EP] Invalid Argument (from environment variables): " << ex.what();
     } catch (const std::out_of_range& ex) {
@@ -1666,7 +1715,8 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
                         << ", trt_profile_min_shapes: " << profile_min_shapes
                         << ", trt_profile_max_shapes: " << profile_max_shapes
                         << ", trt_profile_opt_shapes: " << profile_opt_shapes
-                        << ", trt_cuda_graph_enable: " << cuda_graph_enable_;
+                        << ", trt_cuda_graph_enable: " << cuda_graph_enable_
+                        << ", trt_background_engine_build: " << background_engine_build_;
 }
 
 TensorrtExecutionProvider::~TensorrtExecutionProvider() {
@@ -2718,6 +2768,11 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
       }
     }
 
+    // Index the engine and profile caches by the explicit profiles, so each set of shape buckets has its own engine
+    if (has_explicit_profile) {
+      trt_node_name_with_precision += "_profile" + GetProfileId(profile_min_shapes_, profile_max_shapes_, profile_opt_shapes_);
+    }
+
     // enable sparse weights
     if (sparsity_enable_) {
       trt_config->setFlag(nvinfer1::BuilderFlag::kSPARSE_WEIGHTS);
@@ -2992,7 +3047,8 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
             runtime_.get(), profiles_[context->node_name], context_memory_sharing_enable_, &max_ctx_mem_size_,
             dynamic_range_map, engine_decryption_enable_, engine_decryption_, engine_encryption_, timing_cache_enable_,
             global_cache_path_, force_timing_cache_match_, detailed_build_log_, build_heuristics_enable_, sparsity_enable_,
-            builder_optimization_level_, auxiliary_streams_, !tactic_sources_.empty(), tactics};
+            builder_optimization_level_, auxiliary_streams_, !tactic_sources_.empty(), tactics, cuda_graph_enable_,
+            background_engine_build_, &engine_build_cv_};
       *state = p.release();
       return 0;
     };
@@ -3011,8 +3067,24 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
       // The whole compute_function should be considered the critical section where multiple threads may update kernel function state, access one builder, create/serialize/save engine,
       // save profile and serialize/save timing cache. Therefore, those operations should be synchronized across different threads when ORT is using multithreading.
       // More details here, https://docs.nvidia.com/deeplearning/tensorrt/developer-guide/index.html#threading
-      std::lock_guard<OrtMutex> lock(*(trt_state->tensorrt_mu_ptr));
+      std::unique_lock<OrtMutex> lock(*(trt_state->tensorrt_mu_ptr));
       const std::unordered_map<std::string, size_t>& input_indexes = (trt_state->input_info)[0];
+
+      // While an engine for new shape ranges is being built in the background, the runs whose input shapes are covered
+      // by the current engine keep using it, and the others wait for the new engine.
+      bool use_current_engine = false;
+      while (trt_state->engine_build_pending) {
+        bool has_shape_tensor_input = false;
+        for (int i = 0, end = static_cast<int>(input_indexes.size()); i < end; ++i) {
+          has_shape_tensor_input |= trt_state->network->get()->getInput(i)->isShapeTensor();
+        }
+        if (!has_shape_tensor_input && GetProfileIndexForInputShapes(ctx, trt_state->engine->get(), input_indexes) >= 0) {
+          use_current_engine = true;
+          break;
+        }
+        trt_state->engine_build_cv_ptr->wait(lock);
+      }
+
       const std::unordered_map<std::string, size_t>& output_indexes = (trt_state->output_info)[0];
       const std::unordered_map<std::string, size_t>& output_types = (trt_state->output_info)[1];
       bool sync_stream_after_enqueue = trt_state->sync_stream_after_enqueue;
@@ -3122,7 +3194,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
 
         // If there is any input tensor in shape_ranges, it means this input tensor has dynamic shape and its profile shape values have not yet resolved.
         // TRT EP will help determine the min/max/opt profile values based on current input tensor value.
-        if (shape_ranges.find(input_name) != shape_ranges.end()) {
+        if (!use_current_engine && shape_ranges.find(input_name) != shape_ranges.end()) {
           auto status = ApplyProfileShapesFromInputTensorValue(trt_profiles, ctx, input, shape_ranges, input_indexes, tensor_shape_values, stream, &engine_update);
           if (status != Status::OK()) {
             return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to parse input tensor and generate optimization profiles.");
@@ -3132,9 +3204,14 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
 
       // Regenerate engine
       if (engine_update) {
-        // Destroy the IExecutionContext objects before destroying an engine object, otherwise it will lead to undefined behavior.
-        trt_state->context->reset();
-        trt_state->engine->reset();
+        // With background engine build, the current engine keeps serving the runs it covers until the new one is built.
+        // The first engine of a fused node is always built in the run that needs it.
+        const bool build_in_background = trt_state->background_engine_build && trt_engine != nullptr;
+        if (!build_in_background) {
+          // Destroy the IExecutionContext objects before destroying an engine object, otherwise it will lead to undefined behavior.
+          trt_state->context->reset();
+          trt_state->engine->reset();
+        }
         auto trt_config = std::unique_ptr<nvinfer1::IBuilderConfig>(trt_builder->createBuilderConfig());
         trt_config->setMemoryPoolLimit(nvinfer1::MemoryPoolType::kWORKSPACE, *(trt_state->max_workspace_size_ptr));
         for (auto trt_profile : trt_profiles) {
@@ -3222,8 +3299,24 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
 
         // Build engine
         std::unique_ptr<nvinfer1::IHostMemory> serialized_engine;
+        std::unique_ptr<nvinfer1::ICudaEngine> new_engine;
         {
-          auto lock = GetApiLock();
+          // The build doesn't touch the state of the current engine, so the kernel lock is released for the other runs
+          // of this fused node while it is in progress. The network and profiles aren't modified by those runs while
+          // the build is pending.
+          if (build_in_background) {
+            trt_state->engine_build_pending = true;
+            lock.unlock();
+          }
+          auto build_done = gsl::finally([&]() {
+            if (build_in_background) {
+              lock.lock();
+              trt_state->engine_build_pending = false;
+              trt_state->engine_build_cv_ptr->notify_all();
+            }
+          });
+
+          auto api_lock = GetApiLock();
           std::chrono::steady_clock::time_point engine_build_start;
           if (detailed_build_log_) {
             engine_build_start = std::chrono::steady_clock::now();
@@ -3233,9 +3326,9 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
           if (!serialized_engine) {
             return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to create engine from network.");
           }
-          *(trt_state->engine) = std::unique_ptr<nvinfer1::ICudaEngine>(
+          new_engine = std::unique_ptr<nvinfer1::ICudaEngine>(
               trt_state->runtime->deserializeCudaEngine(serialized_engine->data(), serialized_engine->size()));
-          if (!(*(trt_state->engine))) {
+          if (!new_engine) {
             return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to deserialize engine.");
           }
           if (detailed_build_log_) {
@@ -3243,9 +3336,9 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
             LOGS_DEFAULT(INFO) << "TensorRT engine build for " << trt_state->trt_node_name_with_precision << " took: " << std::chrono::duration_cast<std::chrono::milliseconds>(engine_build_stop - engine_build_start).count() << "ms" << std::endl;
           }
         }
-        if (!(*(trt_state->engine))) {
-          return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP Failed to Build Engine.");
-        }
+        // Destroy the IExecutionContext objects before destroying an engine object, otherwise it will lead to undefined behavior.
+        trt_state->context->reset();
+        *(trt_state->engine) = std::move(new_engine);
         trt_engine = trt_state->engine->get();
         if (trt_state->engine_cache_enable) {
           // Serialize engine profile
@@ -3301,6 +3394,20 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
         trt_context = trt_state->context->get();
       }
 
+      // Select the optimization profile that covers the input shapes when the engine is built with several of them
+      if (trt_engine->getNbOptimizationProfiles() > 1) {
+        int profile_index = GetProfileIndexForInputShapes(ctx, trt_engine, input_indexes);
+        if (profile_index < 0) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP input shapes of ", fused_node_name,
+                                 " are not covered by any of the optimization profiles of the engine.");
+        }
+        if (trt_context->getOptimizationProfile() != profile_index &&
+            !trt_context->setOptimizationProfileAsync(profile_index, stream)) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to set optimization profile ", profile_index,
+                                 " for ", fused_node_name);
+        }
+      }
+
       // Get input and output binding names
       int total_bindings = trt_engine->getNbIOTensors();
       std::vector<char const*> input_binding_names, output_binding_names;
@@ -46,6 +46,7 @@ static const std::string kProfilesMinShapes = "ORT_TENSORRT_PROFILE_MIN_SHAPES";
 static const std::string kProfilesMaxShapes = "ORT_TENSORRT_PROFILE_MAX_SHAPES";
 static const std::string kProfilesOptShapes = "ORT_TENSORRT_PROFILE_OPT_SHAPES";
 static const std::string kCudaGraphEnable = "ORT_TENSORRT_CUDA_GRAPH_ENABLE";
+static const std::string kBackgroundEngineBuild = "ORT_TENSORRT_BACKGROUND_ENGINE_BUILD_ENABLE";
 // Old env variable for backward compatibility
 static const std::string kEngineCachePath = "ORT_TENSORRT_ENGINE_CACHE_PATH";
 }  // namespace tensorrt_env_vars
@@ -175,6 +176,10 @@ struct TensorrtFuncState {
   bool filter_tactic_sources = false;
   nvinfer1::TacticSources tactic_sources;
   bool cuda_graph_enable = 0;
+  bool background_engine_build = false;
+  OrtCondVar* engine_build_cv_ptr = nullptr;
+  // Set while an engine for new shape ranges is built outside of tensorrt_mu_ptr, see trt_background_engine_build.
+  bool engine_build_pending = false;
 };
 
 // Holds important information for building valid ORT graph.
@@ -270,6 +275,9 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   bool force_timing_cache_match_ = false;
   bool detailed_build_log_ = false;
   bool cuda_graph_enable_ = false;
+  bool background_engine_build_ = false;
+  // Notified under tensorrt_mu_ when a background engine build of any fused node finishes.
+  OrtCondVar engine_build_cv_;
 
   // The OrtAllocator object will be get during ep compute time
   // and should be kept for the lifetime of TRT EP object.
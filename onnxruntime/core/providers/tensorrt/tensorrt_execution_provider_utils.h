@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <fstream>
 #include <unordered_map>
 #include <string>
@@ -574,6 +575,52 @@ HashValue TRTGenerateId(const GraphViewer& graph_viewer) {
   return model_hash;
 }
 
+/*
+ * Get an id of the explicit profiles provided by user.
+ *
+ * The id is added to the names of the engine and profile caches, so the engines built for different sets of
+ * profiles (shape buckets) are kept side by side in the cache directory instead of overwriting each other, and
+ * going back to a set of profiles that has been used before loads its engine without rebuilding it.
+ */
+std::string GetProfileId(std::unordered_map<std::string, std::vector<std::vector<int64_t>>>& profile_min_shapes,
+                         std::unordered_map<std::string, std::vector<std::vector<int64_t>>>& profile_max_shapes,
+                         std::unordered_map<std::string, std::vector<std::vector<int64_t>>>& profile_opt_shapes) {
+  uint32_t hash[4] = {0, 0, 0, 0};
+
+  auto hash_str = [&hash](const std::string& str) {
+    MurmurHash3::x86_128(str.data(), gsl::narrow_cast<int32_t>(str.size()), hash[0], &hash);
+  };
+
+  auto hash_shapes = [&hash_str](const std::vector<std::vector<int64_t>>& shapes) {
+    std::string shapes_string;
+    for (const auto& shape : shapes) {
+      for (auto v : shape) {
+        shapes_string += std::to_string(v);
+        shapes_string += "x";
+      }
+      shapes_string += ",";
+    }
+    hash_str(shapes_string);
+  };
+
+  // Hash the inputs in a fixed order as the iteration order of the maps is unspecified
+  std::vector<std::string> input_names;
+  for (const auto& it : profile_min_shapes) {
+    input_names.push_back(it.first);
+  }
+  std::sort(input_names.begin(), input_names.end());
+
+  for (const auto& input_name : input_names) {
+    hash_str(input_name);
+    hash_shapes(profile_min_shapes[input_name]);
+    hash_shapes(profile_max_shapes[input_name]);
+    hash_shapes(profile_opt_shapes[input_name]);
+  }
+
+  HashValue profile_hash = hash[0] | (uint64_t(hash[1]) << 32);
+  return std::to_string(profile_hash);
+}
+
 bool ValidateProfileShapes(std::unordered_map<std::string, std::vector<std::vector<int64_t>>>& profile_min_shapes,
                            std::unordered_map<std::string, std::vector<std::vector<int64_t>>>& profile_max_shapes,
                            std::unordered_map<std::string, std::vector<std::vector<int64_t>>>& profile_opt_shapes) {
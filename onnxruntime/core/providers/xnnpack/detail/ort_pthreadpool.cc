@@ -0,0 +1,336 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if defined(XNNPACK_USE_ORT_THREADPOOL)
+
+#include "core/providers/xnnpack/detail/ort_pthreadpool.h"
+
+#include <algorithm>
+#include <array>
+
+#include "core/platform/threadpool.h"
+
+namespace {
+
+using onnxruntime::concurrency::ThreadPool;
+
+template <size_t N>
+using Index = std::array<size_t, N>;
+
+size_t DivideRoundUp(size_t n, size_t q) {
+  return n / q + (n % q != 0 ? 1 : 0);
+}
+
+// Calls fn(thread, index) for each index in [0, range). The range is split into a batch per thread of the pool, and
+// thread is the index of the batch. The tasks of a thread index in [0, pthreadpool_get_threads_count()) never run
+// concurrently, which the _with_thread tasks of XNNPACK rely on to use a buffer per thread.
+template <typename Fn>
+void Parallelize(pthreadpool_t threadpool, size_t range, const Fn& fn) {
+  ThreadPool* tp = threadpool ? threadpool->thread_pool : nullptr;
+  const auto total = static_cast<std::ptrdiff_t>(range);
+  const std::ptrdiff_t num_batches = std::min<std::ptrdiff_t>(total, ThreadPool::DegreeOfParallelism(tp));
+  if (num_batches <= 1) {
+    for (size_t i = 0; i < range; ++i) {
+      fn(size_t{0}, i);
+    }
+    return;
+  }
+
+  ThreadPool::TrySimpleParallelFor(tp, num_batches, [&](std::ptrdiff_t batch) {
+    const auto work = ThreadPool::PartitionWork(batch, num_batches, total);
+    for (std::ptrdiff_t i = work.start; i < work.end; ++i) {
+      fn(static_cast<size_t>(batch), static_cast<size_t>(i));
+    }
+  });
+}
+
+// Calls fn(thread, start, size) for each tile of an N-d range, in row-major order. Untiled dimensions have tiles of 1.
+template <size_t N, typename Fn>
+void ParallelizeTiled(pthreadpool_t threadpool, const Index<N>& range, const Index<N>& tile, const Fn& fn) {
+  Index<N> tiles;
+  size_t num_tiles = 1;
+  for (size_t d = 0; d < N; ++d) {
+    tiles[d] = DivideRoundUp(range[d], tile[d]);
+    num_tiles *= tiles[d];
+  }
+
+  Parallelize(threadpool, num_tiles, [&](size_t thread, size_t index) {
+    Index<N> start;
+    Index<N> size;
+    for (size_t d = N; d-- > 0;) {
+      start[d] = (index % tiles[d]) * tile[d];
+      size[d] = std::min(tile[d], range[d] - start[d]);
+      index /= tiles[d];
+    }
+    fn(thread, start, size);
+  });
+}
+
+}  // namespace
+
+// A pool created by XNNPACK itself has no ORT thread pool and runs its loops sequentially. The EP doesn't create any,
+// it passes the intra-op thread pool of each call instead.
+pthreadpool_t pthreadpool_create(size_t /*threads_count*/) {
+  return new pthreadpool{};
+}
+
+void pthreadpool_destroy(pthreadpool_t threadpool) {
+  delete threadpool;
+}
+
+size_t pthreadpool_get_threads_count(pthreadpool_t threadpool) {
+  return static_cast<size_t>(ThreadPool::DegreeOfParallelism(threadpool ? threadpool->thread_pool : nullptr));
+}
+
+// ORT's threads keep their own floating point state, so PTHREADPOOL_FLAG_DISABLE_DENORMALS is ignored like the other
+// flags. The microarchitecture variants always use the default microarchitecture.
+
+void pthreadpool_parallelize_1d(pthreadpool_t threadpool, pthreadpool_task_1d_t task, void* context,
+                                size_t range, uint32_t /*flags*/) {
+  Parallelize(threadpool, range, [&](size_t, size_t i) { task(context, i); });
+}
+
+void pthreadpool_parallelize_1d_with_thread(pthreadpool_t threadpool, pthreadpool_task_1d_with_thread_t task,
+                                            void* context, size_t range, uint32_t /*flags*/) {
+  Parallelize(threadpool, range, [&](size_t thread, size_t i) { task(context, thread, i); });
+}
+
+void pthreadpool_parallelize_1d_with_uarch(pthreadpool_t threadpool, pthreadpool_task_1d_with_id_t task,
+                                           void* context, uint32_t default_uarch_index, uint32_t /*max_uarch_index*/,
+                                           size_t range, uint32_t /*flags*/) {
+  Parallelize(threadpool, range, [&](size_t, size_t i) { task(context, default_uarch_index, i); });
+}
+
+void pthreadpool_parallelize_1d_tile_1d(pthreadpool_t threadpool, pthreadpool_task_1d_tile_1d_t task, void* context,
+                                        size_t range, size_t tile, uint32_t /*flags*/) {
+  ParallelizeTiled<1>(threadpool, {range}, {tile}, [&](size_t, const Index<1>& s, const Index<1>& t) {
+    task(context, s[0], t[0]);
+  });
+}
+
+void pthreadpool_parallelize_2d(pthreadpool_t threadpool, pthreadpool_task_2d_t task, void* context,
+                                size_t range_i, size_t range_j, uint32_t /*flags*/) {
+  ParallelizeTiled<2>(threadpool, {range_i, range_j}, {1, 1}, [&](size_t, const Index<2>& s, const Index<2>&) {
+    task(context, s[0], s[1]);
+  });
+}
+
+void pthreadpool_parallelize_2d_with_thread(pthreadpool_t threadpool, pthreadpool_task_2d_with_thread_t task,
+                                            void* context, size_t range_i, size_t range_j, uint32_t /*flags*/) {
+  ParallelizeTiled<2>(threadpool, {range_i, range_j}, {1, 1},
+                      [&](size_t thread, const Index<2>& s, const Index<2>&) {
+                        task(context, thread, s[0], s[1]);
+                      });
+}
+
+void pthreadpool_parallelize_2d_tile_1d(pthreadpool_t threadpool, pthreadpool_task_2d_tile_1d_t task, void* context,
+                                        size_t range_i, size_t range_j, size_t tile_j, uint32_t /*flags*/) {
+  ParallelizeTiled<2>(threadpool, {range_i, range_j}, {1, tile_j},
+                      [&](size_t, const Index<2>& s, const Index<2>& t) {
+                        task(context, s[0], s[1], t[1]);
+                      });
+}
+
+void pthreadpool_parallelize_2d_tile_1d_with_uarch(pthreadpool_t threadpool,
+                                                   pthreadpool_task_2d_tile_1d_with_id_t task, void* context,
+                                                   uint32_t default_uarch_index, uint32_t /*max_uarch_index*/,
+                                                   size_t range_i, size_t range_j, size_t tile_j,
+                                                   uint32_t /*flags*/) {
+  ParallelizeTiled<2>(threadpool, {range_i, range_j}, {1, tile_j},
+                      [&](size_t, const Index<2>& s, const Index<2>& t) {
+                        task(context, default_uarch_index, s[0], s[1], t[1]);
+                      });
+}
+
+void pthreadpool_parallelize_2d_tile_1d_with_uarch_with_thread(
+    pthreadpool_t threadpool, pthreadpool_task_2d_tile_1d_with_id_with_thread_t task, void* context,
+    uint32_t default_uarch_index, uint32_t /*max_uarch_index*/, size_t range_i, size_t range_j, size_t tile_j,
+    uint32_t /*flags*/) {
+  ParallelizeTiled<2>(threadpool, {range_i, range_j}, {1, tile_j},
+                      [&](size_t thread, const Index<2>& s, const Index<2>& t) {
+                        task(context, default_uarch_index, thread, s[0], s[1], t[1]);
+                      });
+}
+
+void pthreadpool_parallelize_2d_tile_2d(pthreadpool_t threadpool, pthreadpool_task_2d_tile_2d_t task, void* context,
+                                        size_t range_i, size_t range_j, size_t tile_i, size_t tile_j,
+                                        uint32_t /*flags*/) {
+  ParallelizeTiled<2>(threadpool, {range_i, range_j}, {tile_i, tile_j},
+                      [&](size_t, const Index<2>& s, const Index<2>& t) {
+                        task(context, s[0], s[1], t[0], t[1]);
+                      });
+}
+
+void pthreadpool_parallelize_2d_tile_2d_with_uarch(pthreadpool_t threadpool,
+                                                   pthreadpool_task_2d_tile_2d_with_id_t task, void* context,
+                                                   uint32_t default_uarch_index, uint32_t /*max_uarch_index*/,
+                                                   size_t range_i, size_t range_j, size_t tile_i, size_t tile_j,
+                                                   uint32_t /*flags*/) {
+  ParallelizeTiled<2>(threadpool, {range_i, range_j}, {tile_i, tile_j},
+                      [&](size_t, const Index<2>& s, const Index<2>& t) {
+                        task(context, default_uarch_index, s[0], s[1], t[0], t[1]);
+                      });
+}
+
+void pthreadpool_parallelize_3d(pthreadpool_t threadpool, pthreadpool_task_3d_t task, void* context,
+                                size_t range_i, size_t range_j, size_t range_k, uint32_t /*flags*/) {
+  ParallelizeTiled<3>(threadpool, {range_i, range_j, range_k}, {1, 1, 1},
+                      [&](size_t, const Index<3>& s, const Index<3>&) {
+                        task(context, s[0], s[1], s[2]);
+                      });
+}
+
+void pthreadpool_parallelize_3d_tile_1d(pthreadpool_t threadpool, pthreadpool_task_3d_tile_1d_t task, void* context,
+                                        size_t range_i, size_t range_j, size_t range_k, size_t tile_k,
+                                        uint32_t /*flags*/) {
+  ParallelizeTiled<3>(threadpool, {range_i, range_j, range_k}, {1, 1, tile_k},
+                      [&](size_t, const Index<3>& s, const Index<3>& t) {
+                        task(context, s[0], s[1], s[2], t[2]);
+                      });
+}
+
+void pthreadpool_parallelize_3d_tile_1d_with_thread(pthreadpool_t threadpool,
+                                                    pthreadpool_task_3d_tile_1d_with_thread_t task, void* context,
+                                                    size_t range_i, size_t range_j, size_t range_k, size_t tile_k,
+                                                    uint32_t /*flags*/) {
+  ParallelizeTiled<3>(threadpool, {range_i, range_j, range_k}, {1, 1, tile_k},
+                      [&](size_t thread, const Index<3>& s, const Index<3>& t) {
+                        task(context, thread, s[0], s[1], s[2], t[2]);
+                      });
+}
+
+void pthreadpool_parallelize_3d_tile_1d_with_uarch(pthreadpool_t threadpool,
+                                                   pthreadpool_task_3d_tile_1d_with_id_t task, void* context,
+                                                   uint32_t default_uarch_index, uint32_t /*max_uarch_index*/,
+                                                   size_t range_i, size_t range_j, size_t range_k, size_t tile_k,
+                                                   uint32_t /*flags*/) {
+  ParallelizeTiled<3>(threadpool, {range_i, range_j, range_k}, {1, 1, tile_k},
+                      [&](size_t, const Index<3>& s, const Index<3>& t) {
+                        task(context, default_uarch_index, s[0], s[1], s[2], t[2]);
+                      });
+}
+
+void pthreadpool_parallelize_3d_tile_1d_with_uarch_with_thread(
+    pthreadpool_t threadpool, pthreadpool_task_3d_tile_1d_with_id_with_thread_t task, void* context,
+    uint32_t default_uarch_index, uint32_t /*max_uarch_index*/, size_t range_i, size_t range_j, size_t range_k,
+    size_t tile_k, uint32_t /*flags*/) {
+  ParallelizeTiled<3>(threadpool, {range_i, range_j, range_k}, {1, 1, tile_k},
+                      [&](size_t thread, const Index<3>& s, const Index<3>& t) {
+                        task(context, default_uarch_index, thread, s[0], s[1], s[2], t[2]);
+                      });
+}
+
+void pthreadpool_parallelize_3d_tile_2d(pthreadpool_t threadpool, pthreadpool_task_3d_tile_2d_t task, void* context,
+                                        size_t range_i, size_t range_j, size_t range_k, size_t tile_j, size_t tile_k,
+                                        uint32_t /*flags*/) {
+  ParallelizeTiled<3>(threadpool, {range_i, range_j, range_k}, {1, tile_j, tile_k},
+                      [&](size_t, const Index<3>& s, const Index<3>& t) {
+                        task(context, s[0], s[1], s[2], t[1], t[2]);
+                      });
+}
+
+void pthreadpool_parallelize_3d_tile_2d_with_uarch(pthreadpool_t threadpool,
+                                                   pthreadpool_task_3d_tile_2d_with_id_t task, void* context,
+                                                   uint32_t default_uarch_index, uint32_t /*max_uarch_index*/,
+                                                   size_t range_i, size_t range_j, size_t range_k, size_t tile_j,
+                                                   size_t tile_k, uint32_t /*flags*/) {
+  ParallelizeTiled<3>(threadpool, {range_i, range_j, range_k}, {1, tile_j, tile_k},
+                      [&](size_t, const Index<3>& s, const Index<3>& t) {
+                        task(context, default_uarch_index, s[0], s[1], s[2], t[1], t[2]);
+                      });
+}
+
+void pthreadpool_parallelize_4d(pthreadpool_t threadpool, pthreadpool_task_4d_t task, void* context,
+                                size_t range_i, size_t range_j, size_t range_k, size_t range_l, uint32_t /*flags*/) {
+  ParallelizeTiled<4>(threadpool, {range_i, range_j, range_k, range_l}, {1, 1, 1, 1},
+                      [&](size_t, const Index<4>& s, const Index<4>&) {
+                        task(context, s[0], s[1], s[2], s[3]);
+                      });
+}
+
+void pthreadpool_parallelize_4d_tile_1d(pthreadpool_t threadpool, pthreadpool_task_4d_tile_1d_t task, void* context,
+                                        size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t tile_l, uint32_t /*flags*/) {
+  ParallelizeTiled<4>(threadpool, {range_i, range_j, range_k, range_l}, {1, 1, 1, tile_l},
+                      [&](size_t, const Index<4>& s, const Index<4>& t) {
+                        task(context, s[0], s[1], s[2], s[3], t[3]);
+                      });
+}
+
+void pthreadpool_parallelize_4d_tile_2d(pthreadpool_t threadpool, pthreadpool_task_4d_tile_2d_t task, void* context,
+                                        size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t tile_k, size_t tile_l, uint32_t /*flags*/) {
+  ParallelizeTiled<4>(threadpool, {range_i, range_j, range_k, range_l}, {1, 1, tile_k, tile_l},
+                      [&](size_t, const Index<4>& s, const Index<4>& t) {
+                        task(context, s[0], s[1], s[2], s[3], t[2], t[3]);
+                      });
+}
+
+void pthreadpool_parallelize_4d_tile_2d_with_uarch(pthreadpool_t threadpool,
+                                                   pthreadpool_task_4d_tile_2d_with_id_t task, void* context,
+                                                   uint32_t default_uarch_index, uint32_t /*max_uarch_index*/,
+                                                   size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                                   size_t tile_k, size_t tile_l, uint32_t /*flags*/) {
+  ParallelizeTiled<4>(threadpool, {range_i, range_j, range_k, range_l}, {1, 1, tile_k, tile_l},
+                      [&](size_t, const Index<4>& s, const Index<4>& t) {
+                        task(context, default_uarch_index, s[0], s[1], s[2], s[3], t[2], t[3]);
+                      });
+}
+
+void pthreadpool_parallelize_5d(pthreadpool_t threadpool, pthreadpool_task_5d_t task, void* context,
+                                size_t range_i, size_t range_j, size_t range_k, size_t range_l, size_t range_m,
+                                uint32_t /*flags*/) {
+  ParallelizeTiled<5>(threadpool, {range_i, range_j, range_k, range_l, range_m}, {1, 1, 1, 1, 1},
+                      [&](size_t, const Index<5>& s, const Index<5>&) {
+                        task(context, s[0], s[1], s[2], s[3], s[4]);
+                      });
+}
+
+void pthreadpool_parallelize_5d_tile_1d(pthreadpool_t threadpool, pthreadpool_task_5d_tile_1d_t task, void* context,
+                                        size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t range_m, size_t tile_m, uint32_t /*flags*/) {
+  ParallelizeTiled<5>(threadpool, {range_i, range_j, range_k, range_l, range_m}, {1, 1, 1, 1, tile_m},
+                      [&](size_t, const Index<5>& s, const Index<5>& t) {
+                        task(context, s[0], s[1], s[2], s[3], s[4], t[4]);
+                      });
+}
+
+void pthreadpool_parallelize_5d_tile_2d(pthreadpool_t threadpool, pthreadpool_task_5d_tile_2d_t task, void* context,
+                                        size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t range_m, size_t tile_l, size_t tile_m, uint32_t /*flags*/) {
+  ParallelizeTiled<5>(threadpool, {range_i, range_j, range_k, range_l, range_m}, {1, 1, 1, tile_l, tile_m},
+                      [&](size_t, const Index<5>& s, const Index<5>& t) {
+                        task(context, s[0], s[1], s[2], s[3], s[4], t[3], t[4]);
+                      });
+}
+
+void pthreadpool_parallelize_6d(pthreadpool_t threadpool, pthreadpool_task_6d_t task, void* context,
+                                size_t range_i, size_t range_j, size_t range_k, size_t range_l, size_t range_m,
+                                size_t range_n, uint32_t /*flags*/) {
+  ParallelizeTiled<6>(threadpool, {range_i, range_j, range_k, range_l, range_m, range_n}, {1, 1, 1, 1, 1, 1},
+                      [&](size_t, const Index<6>& s, const Index<6>&) {
+                        task(context, s[0], s[1], s[2], s[3], s[4], s[5]);
+                      });
+}
+
+void pthreadpool_parallelize_6d_tile_1d(pthreadpool_t threadpool, pthreadpool_task_6d_tile_1d_t task, void* context,
+                                        size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t range_m, size_t range_n, size_t tile_n, uint32_t /*flags*/) {
+  ParallelizeTiled<6>(threadpool, {range_i, range_j, range_k, range_l, range_m, range_n}, {1, 1, 1, 1, 1, tile_n},
+                      [&](size_t, const Index<6>& s, const Index<6>& t) {
+                        task(context, s[0], s[1], s[2], s[3], s[4], s[5], t[5]);
+                      });
+}
+
+void pthreadpool_parallelize_6d_tile_2d(pthreadpool_t threadpool, pthreadpool_task_6d_tile_2d_t task, void* context,
+                                        size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t range_m, size_t range_n, size_t tile_m, size_t tile_n,
+                                        uint32_t /*flags*/) {
+  ParallelizeTiled<6>(threadpool, {range_i, range_j, range_k, range_l, range_m, range_n},
+                      {1, 1, 1, 1, tile_m, tile_n},
+                      [&](size_t, const Index<6>& s, const Index<6>& t) {
+                        task(context, s[0], s[1], s[2], s[3], s[4], s[5], t[4], t[5]);
+                      });
+}
+
+#endif  // defined(XNNPACK_USE_ORT_THREADPOOL)
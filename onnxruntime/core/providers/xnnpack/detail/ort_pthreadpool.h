@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if defined(XNNPACK_USE_ORT_THREADPOOL)
+
+#include <pthreadpool.h>
+
+namespace onnxruntime {
+namespace concurrency {
+class ThreadPool;
+}
+}  // namespace onnxruntime
+
+// The implementation of the pthreadpool API that XNNPACK is linked with when built with XNNPACK_USE_ORT_THREADPOOL.
+// The parallel loops of XNNPACK run in the parallel sections of the ORT intra-op thread pool that the pool points to,
+// so a session mixing the CPU EP with the XNNPACK EP has a single set of workers, which spin between the loops of both
+// EPs according to the spinning setting of ORT's pool. A pool without an ORT thread pool runs the loops sequentially.
+struct pthreadpool {
+  onnxruntime::concurrency::ThreadPool* thread_pool{nullptr};
+};
+
+#endif  // defined(XNNPACK_USE_ORT_THREADPOOL)
@@ -0,0 +1,589 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/xnnpack/detail/subgraph.h"
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "core/common/inlined_containers.h"
+#include "core/common/narrow.h"
+#include "core/common/span_utils.h"
+#include "core/framework/op_kernel.h"
+#include "core/framework/op_node_proto_helper.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/constants.h"
+#include "core/graph/graph_viewer.h"
+#include "core/optimizer/initializer.h"
+#include "core/providers/common.h"
+#include "core/providers/cpu/nn/pool_attributes.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/xnnpack/detail/utils.h"
+#include "core/session/onnxruntime_cxx_api.h"
+
+namespace onnxruntime {
+namespace xnnpack {
+
+namespace {
+
+bool GetStaticShape(const NodeArg& arg, TensorShapeVector& shape) {
+  const auto* shape_proto = arg.Shape();
+  if (shape_proto == nullptr) {
+    return false;
+  }
+
+  shape.clear();
+  for (const auto& dim : shape_proto->dim()) {
+    if (!dim.has_dim_value()) {
+      return false;
+    }
+    shape.push_back(dim.dim_value());
+  }
+
+  return true;
+}
+
+bool IsFloatWithStaticShape(const NodeArg& arg) {
+  int32_t type = 0;
+  TensorShapeVector shape;
+  return GetType(arg, type) && type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT &&
+         GetStaticShape(arg, shape) && shape.size() <= XNN_MAX_TENSOR_DIMS;
+}
+
+bool IsConstant(const GraphViewer& graph, const NodeArg* arg) {
+  return arg != nullptr && arg->Exists() && graph.IsConstantInitializer(arg->Name(), true);
+}
+
+bool HasOptionalInput(const Node& node, size_t index) {
+  const auto& inputs = node.InputDefs();
+  return inputs.size() > index && inputs[index]->Exists();
+}
+
+size_t Rank(const NodeArg& arg) {
+  return static_cast<size_t>(arg.Shape()->dim_size());
+}
+
+bool IsConvSupported(const Node& node, const GraphViewer& graph) {
+  const auto& inputs = node.InputDefs();
+  if (Rank(*inputs[0]) != 4 || !IsConstant(graph, inputs[1]) || Rank(*inputs[1]) != 4) {
+    return false;
+  }
+
+  if (HasOptionalInput(node, 2) && !IsConstant(graph, inputs[2])) {
+    return false;
+  }
+
+  ProtoHelperNodeContext nc(node);
+  OpNodeProtoHelper info(&nc);
+  const auto auto_pad = StringToAutoPadType(info.GetAttrOrDefault<std::string>("auto_pad", "NOTSET"));
+  return IsPaddingTypeSupported(auto_pad);
+}
+
+bool IsPoolSupported(const Node& node) {
+  const auto& outputs = node.OutputDefs();
+  if (Rank(*node.InputDefs()[0]) != 4 || (outputs.size() == 2 && outputs[1]->Exists())) {
+    return false;
+  }
+
+  ProtoHelperNodeContext nc(node);
+  OpNodeProtoHelper info(&nc);
+  PoolAttributes pool_attrs(info, node.OpType(), node.SinceVersion());
+
+  // xnnpack supports neither rounding the output size up nor 1x1 pooling
+  if (pool_attrs.ceil_mode != 0 || !IsPaddingTypeSupported(pool_attrs.auto_pad) ||
+      pool_attrs.kernel_shape.size() != 2 ||
+      (pool_attrs.kernel_shape[0] == 1 && pool_attrs.kernel_shape[1] == 1)) {
+    return false;
+  }
+
+  if (node.OpType() == "AveragePool") {
+    // the average of xnnpack excludes the padding
+    const bool has_pads = std::any_of(pool_attrs.pads.cbegin(), pool_attrs.pads.cend(),
+                                      [](int64_t pad) { return pad != 0; });
+    if (!pool_attrs.default_dilations || (pool_attrs.count_include_pad && has_pads)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool IsGemmSupported(const Node& node, const GraphViewer& graph) {
+  const auto& inputs = node.InputDefs();
+  ProtoHelperNodeContext nc(node);
+  OpNodeProtoHelper info(&nc);
+  if (info.GetAttrOrDefault<int64_t>("transA", 0) != 0 ||
+      info.GetAttrOrDefault<float>("alpha", 1.f) != 1.f ||
+      info.GetAttrOrDefault<float>("beta", 1.f) != 1.f) {
+    return false;
+  }
+
+  if (Rank(*inputs[0]) != 2 || !IsConstant(graph, inputs[1]) || Rank(*inputs[1]) != 2) {
+    return false;
+  }
+
+  if (HasOptionalInput(node, 2)) {
+    // C must be a constant bias of the output channels
+    TensorShapeVector c_shape, y_shape;
+    if (!IsConstant(graph, inputs[2]) || !GetStaticShape(*inputs[2], c_shape) ||
+        !GetStaticShape(*node.OutputDefs()[0], y_shape) ||
+        c_shape.empty() || c_shape.back() != y_shape[1] || TensorShape(c_shape).Size() != y_shape[1]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool IsMatMulSupported(const Node& node, const GraphViewer& graph) {
+  const auto& inputs = node.InputDefs();
+  return Rank(*inputs[0]) >= 2 && IsConstant(graph, inputs[1]) && Rank(*inputs[1]) == 2;
+}
+
+bool IsSoftmaxSupported(const Node& node) {
+  // xnnpack normalizes the last dimension, which is what Softmax before opset 13 does for the last axis as well
+  const auto rank = static_cast<int64_t>(Rank(*node.InputDefs()[0]));
+  ProtoHelperNodeContext nc(node);
+  OpNodeProtoHelper info(&nc);
+  const auto axis = info.GetAttrOrDefault<int64_t>("axis", node.SinceVersion() < 13 ? 1 : -1);
+  return rank > 0 && HandleNegativeAxis(axis, rank) == rank - 1;
+}
+
+bool IsClipSupported(const Node& node, const GraphViewer& graph) {
+  const auto& inputs = node.InputDefs();
+  for (size_t i = 1; i < inputs.size(); ++i) {
+    if (inputs[i]->Exists() && !IsConstant(graph, inputs[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+Status CheckStatus(xnn_status status, const char* function) {
+  ORT_RETURN_IF_NOT(status == xnn_status_success, function, " failed with status ", status);
+  return Status::OK();
+}
+
+std::vector<size_t> ToXnnDims(gsl::span<const int64_t> shape) {
+  std::vector<size_t> dims;
+  dims.reserve(shape.size());
+  std::transform(shape.begin(), shape.end(), std::back_inserter(dims),
+                 [](int64_t dim) { return narrow<size_t>(dim); });
+  return dims;
+}
+
+// Defines the nodes of a GraphViewer in an xnn_subgraph, one at a time in topological order.
+class SubgraphBuilder {
+ public:
+  SubgraphBuilder(const GraphViewer& graph, xnn_subgraph_t subgraph, std::vector<std::vector<float>>& static_data)
+      : graph_{graph}, subgraph_{subgraph}, static_data_{static_data} {
+  }
+
+  Status DefineExternalValue(const NodeArg& arg, uint32_t external_id, uint32_t flags) {
+    TensorShapeVector shape;
+    ORT_ENFORCE(GetStaticShape(arg, shape));
+    const auto dims = ToXnnDims(shape);
+    uint32_t id = XNN_INVALID_VALUE_ID;
+    ORT_RETURN_IF_ERROR(CheckStatus(xnn_define_tensor_value(subgraph_, xnn_datatype_fp32, dims.size(), dims.data(),
+                                                            nullptr, external_id, flags, &id),
+                                    "xnn_define_tensor_value"));
+    value_ids_[arg.Name()] = id;
+    return Status::OK();
+  }
+
+  Status AddNode(const Node& node) {
+    const auto& op_type = node.OpType();
+    if (op_type == "Conv") {
+      return AddConv(node);
+    } else if (op_type == "MaxPool" || op_type == "AveragePool") {
+      return AddPool(node);
+    } else if (op_type == "Gemm" || op_type == "MatMul") {
+      return AddFullyConnected(node);
+    } else if (op_type == "Softmax") {
+      return AddSoftmax(node);
+    } else if (op_type == "Relu" || op_type == "Clip") {
+      return AddClamp(node);
+    } else if (op_type == "Sigmoid" || op_type == "HardSwish") {
+      return AddUnary(node);
+    } else if (op_type == "Add" || op_type == "Sub" || op_type == "Mul" || op_type == "Div") {
+      return AddBinary(node);
+    }
+
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "No support for ", op_type, " in an xnnpack subgraph");
+  }
+
+ private:
+  // Gets the value of a node input, which an earlier node produced or is an input or a constant initializer.
+  Status GetInputId(const NodeArg& arg, uint32_t& id) {
+    if (auto it = value_ids_.find(arg.Name()); it != value_ids_.end()) {
+      id = it->second;
+      return Status::OK();
+    }
+
+    const auto* initializer = graph_.GetConstantInitializer(arg.Name(), true);
+    ORT_RETURN_IF(initializer == nullptr, "Value ", arg.Name(), " is not defined in the xnnpack subgraph");
+
+    Initializer data(*initializer, graph_.ModelPath());
+    const auto values = data.DataAsSpan<float>();
+    ORT_RETURN_IF_ERROR(DefineStaticValue(std::vector<float>(values.begin(), values.end()), ToXnnDims(data.dims()),
+                                          id));
+    value_ids_[arg.Name()] = id;
+    return Status::OK();
+  }
+
+  // Gets the value of a node output, which is an output of the subgraph or an internal value.
+  Status GetOutputId(const NodeArg& arg, uint32_t& id) {
+    if (auto it = value_ids_.find(arg.Name()); it != value_ids_.end()) {
+      id = it->second;
+      return Status::OK();
+    }
+
+    TensorShapeVector shape;
+    ORT_ENFORCE(GetStaticShape(arg, shape));
+    const auto dims = ToXnnDims(shape);
+    ORT_RETURN_IF_ERROR(CheckStatus(xnn_define_tensor_value(subgraph_, xnn_datatype_fp32, dims.size(), dims.data(),
+                                                            nullptr, XNN_INVALID_VALUE_ID, 0, &id),
+                                    "xnn_define_tensor_value"));
+    value_ids_[arg.Name()] = id;
+    return Status::OK();
+  }
+
+  Status DefineStaticValue(std::vector<float> data, const std::vector<size_t>& dims, uint32_t& id) {
+    // xnnpack may read XNN_EXTRA_BYTES past the end of the data
+    const size_t size = data.size();
+    data.resize(size + XNN_EXTRA_BYTES / sizeof(float) + 1);
+    static_data_.push_back(std::move(data));
+    return CheckStatus(xnn_define_tensor_value(subgraph_, xnn_datatype_fp32, dims.size(), dims.data(),
+                                               static_data_.back().data(), XNN_INVALID_VALUE_ID, 0, &id),
+                       "xnn_define_tensor_value");
+  }
+
+  Status AddConv(const Node& node) {
+    const auto& inputs = node.InputDefs();
+    ProtoHelperNodeContext nc(node);
+    OpNodeProtoHelper info(&nc);
+
+    // the layout transformation leaves the weight in OIHW, and xnnpack wants it in OHWI
+    Initializer weight(*graph_.GetConstantInitializer(inputs[1]->Name(), true), graph_.ModelPath());
+    const auto w_dims = weight.dims();
+    const size_t output_channels = narrow<size_t>(w_dims[0]);
+    const size_t group_input_channels = narrow<size_t>(w_dims[1]);
+    const size_t kernel_height = narrow<size_t>(w_dims[2]);
+    const size_t kernel_width = narrow<size_t>(w_dims[3]);
+    const auto w_data = weight.DataAsSpan<float>();
+    std::vector<float> w_ohwi(w_data.size());
+    for (size_t o = 0; o < output_channels; ++o) {
+      for (size_t i = 0; i < group_input_channels; ++i) {
+        for (size_t h = 0; h < kernel_height; ++h) {
+          for (size_t w = 0; w < kernel_width; ++w) {
+            w_ohwi[((o * kernel_height + h) * kernel_width + w) * group_input_channels + i] =
+                w_data[((o * group_input_channels + i) * kernel_height + h) * kernel_width + w];
+          }
+        }
+      }
+    }
+
+    uint32_t x_id, w_id, y_id;
+    uint32_t b_id = XNN_INVALID_VALUE_ID;
+    ORT_RETURN_IF_ERROR(GetInputId(*inputs[0], x_id));
+    ORT_RETURN_IF_ERROR(DefineStaticValue(std::move(w_ohwi),
+                                          {output_channels, kernel_height, kernel_width, group_input_channels},
+                                          w_id));
+    if (HasOptionalInput(node, 2)) {
+      ORT_RETURN_IF_ERROR(GetInputId(*inputs[2], b_id));
+    }
+    ORT_RETURN_IF_ERROR(GetOutputId(*node.OutputDefs()[0], y_id));
+
+    const auto group = narrow<uint32_t>(info.GetAttrOrDefault<int64_t>("group", 1));
+    auto strides = info.GetAttrsOrDefault<int64_t>("strides");
+    auto dilations = info.GetAttrsOrDefault<int64_t>("dilations");
+    auto pads = info.GetAttrsOrDefault<int64_t>("pads");
+    strides.resize(2, 1);
+    dilations.resize(2, 1);
+    pads.resize(4, 0);
+
+    uint32_t flags = 0;
+    const auto auto_pad = StringToAutoPadType(info.GetAttrOrDefault<std::string>("auto_pad", "NOTSET"));
+    if (auto_pad == AutoPadType::SAME_UPPER) {
+      flags |= XNN_FLAG_TENSORFLOW_SAME_PADDING;
+    }
+    if (auto_pad != AutoPadType::NOTSET) {
+      std::fill(pads.begin(), pads.end(), 0);
+    }
+
+    return CheckStatus(
+        xnn_define_convolution_2d(subgraph_,
+                                  narrow<uint32_t>(pads[0]), narrow<uint32_t>(pads[3]),
+                                  narrow<uint32_t>(pads[2]), narrow<uint32_t>(pads[1]),
+                                  narrow<uint32_t>(kernel_height), narrow<uint32_t>(kernel_width),
+                                  narrow<uint32_t>(strides[0]), narrow<uint32_t>(strides[1]),
+                                  narrow<uint32_t>(dilations[0]), narrow<uint32_t>(dilations[1]),
+                                  group, group_input_channels, output_channels / group,
+                                  -INFINITY, INFINITY, x_id, w_id, b_id, y_id, flags),
+        "xnn_define_convolution_2d");
+  }
+
+  Status AddPool(const Node& node) {
+    ProtoHelperNodeContext nc(node);
+    OpNodeProtoHelper info(&nc);
+    PoolAttributes pool_attrs(info, node.OpType(), node.SinceVersion());
+
+    uint32_t x_id, y_id;
+    ORT_RETURN_IF_ERROR(GetInputId(*node.InputDefs()[0], x_id));
+    ORT_RETURN_IF_ERROR(GetOutputId(*node.OutputDefs()[0], y_id));
+
+    uint32_t flags = 0;
+    if (pool_attrs.auto_pad == AutoPadType::SAME_UPPER) {
+      flags |= XNN_FLAG_TENSORFLOW_SAME_PADDING;
+    }
+    if (pool_attrs.auto_pad != AutoPadType::NOTSET) {
+      std::fill(pool_attrs.pads.begin(), pool_attrs.pads.end(), 0);
+    }
+
+    const auto& pads = pool_attrs.pads;
+    const auto& kernel_shape = pool_attrs.kernel_shape;
+    const auto& strides = pool_attrs.strides;
+    if (node.OpType() == "MaxPool") {
+      return CheckStatus(
+          xnn_define_max_pooling_2d(subgraph_,
+                                    narrow<uint32_t>(pads[0]), narrow<uint32_t>(pads[3]),
+                                    narrow<uint32_t>(pads[2]), narrow<uint32_t>(pads[1]),
+                                    narrow<uint32_t>(kernel_shape[0]), narrow<uint32_t>(kernel_shape[1]),
+                                    narrow<uint32_t>(strides[0]), narrow<uint32_t>(strides[1]),
+                                    narrow<uint32_t>(pool_attrs.dilations[0]),
+                                    narrow<uint32_t>(pool_attrs.dilations[1]),
+                                    -INFINITY, INFINITY, x_id, y_id, flags),
+          "xnn_define_max_pooling_2d");
+    }
+
+    return CheckStatus(
+        xnn_define_average_pooling_2d(subgraph_,
+                                      narrow<uint32_t>(pads[0]), narrow<uint32_t>(pads[3]),
+                                      narrow<uint32_t>(pads[2]), narrow<uint32_t>(pads[1]),
+                                      narrow<uint32_t>(kernel_shape[0]), narrow<uint32_t>(kernel_shape[1]),
+                                      narrow<uint32_t>(strides[0]), narrow<uint32_t>(strides[1]),
+                                      -INFINITY, INFINITY, x_id, y_id, flags),
+        "xnn_define_average_pooling_2d");
+  }
+
+  Status AddFullyConnected(const Node& node) {
+    const auto& inputs = node.InputDefs();
+    uint32_t a_id, b_id, y_id;
+    uint32_t c_id = XNN_INVALID_VALUE_ID;
+    ORT_RETURN_IF_ERROR(GetInputId(*inputs[0], a_id));
+    ORT_RETURN_IF_ERROR(GetInputId(*inputs[1], b_id));
+    ORT_RETURN_IF_ERROR(GetOutputId(*node.OutputDefs()[0], y_id));
+
+    // the filter of xnnpack is (N, K), so B with shape (K, N) needs to be transposed
+    uint32_t flags = XNN_FLAG_TRANSPOSE_WEIGHTS;
+    if (node.OpType() == "Gemm") {
+      ProtoHelperNodeContext nc(node);
+      OpNodeProtoHelper info(&nc);
+      if (info.GetAttrOrDefault<int64_t>("transB", 0) != 0) {
+        flags = 0;
+      }
+
+      if (HasOptionalInput(node, 2)) {
+        // the bias of xnnpack is 1D
+        Initializer c(*graph_.GetConstantInitializer(inputs[2]->Name(), true), graph_.ModelPath());
+        const auto c_data = c.DataAsSpan<float>();
+        ORT_RETURN_IF_ERROR(DefineStaticValue(std::vector<float>(c_data.begin(), c_data.end()), {c_data.size()},
+                                              c_id));
+      }
+    }
+
+    return CheckStatus(xnn_define_fully_connected(subgraph_, -INFINITY, INFINITY, a_id, b_id, c_id, y_id, flags),
+                       "xnn_define_fully_connected");
+  }
+
+  Status AddSoftmax(const Node& node) {
+    uint32_t x_id, y_id;
+    ORT_RETURN_IF_ERROR(GetInputId(*node.InputDefs()[0], x_id));
+    ORT_RETURN_IF_ERROR(GetOutputId(*node.OutputDefs()[0], y_id));
+    return CheckStatus(xnn_define_softmax(subgraph_, x_id, y_id, 0), "xnn_define_softmax");
+  }
+
+  Status AddClamp(const Node& node) {
+    uint32_t x_id, y_id;
+    ORT_RETURN_IF_ERROR(GetInputId(*node.InputDefs()[0], x_id));
+    ORT_RETURN_IF_ERROR(GetOutputId(*node.OutputDefs()[0], y_id));
+
+    float min = -INFINITY;
+    float max = INFINITY;
+    if (node.OpType() == "Relu") {
+      min = 0.f;
+    } else {
+      GetClipMinMax(node, graph_, min, max);
+    }
+
+    // xnnpack fuses the clamp into the node that produces x
+    return CheckStatus(xnn_define_clamp(subgraph_, min, max, x_id, y_id, 0), "xnn_define_clamp");
+  }
+
+  Status AddUnary(const Node& node) {
+    uint32_t x_id, y_id;
+    ORT_RETURN_IF_ERROR(GetInputId(*node.InputDefs()[0], x_id));
+    ORT_RETURN_IF_ERROR(GetOutputId(*node.OutputDefs()[0], y_id));
+
+    if (node.OpType() == "Sigmoid") {
+      return CheckStatus(xnn_define_sigmoid(subgraph_, x_id, y_id, 0), "xnn_define_sigmoid");
+    }
+
+    return CheckStatus(xnn_define_hardswish(subgraph_, x_id, y_id, 0), "xnn_define_hardswish");
+  }
+
+  Status AddBinary(const Node& node) {
+    const auto& inputs = node.InputDefs();
+    uint32_t a_id, b_id, y_id;
+    ORT_RETURN_IF_ERROR(GetInputId(*inputs[0], a_id));
+    ORT_RETURN_IF_ERROR(GetInputId(*inputs[1], b_id));
+    ORT_RETURN_IF_ERROR(GetOutputId(*node.OutputDefs()[0], y_id));
+
+    // the binary nodes of xnnpack broadcast like numpy
+    const auto& op_type = node.OpType();
+    if (op_type == "Add") {
+      return CheckStatus(xnn_define_add2(subgraph_, -INFINITY, INFINITY, a_id, b_id, y_id, 0), "xnn_define_add2");
+    } else if (op_type == "Sub") {
+      return CheckStatus(xnn_define_subtract(subgraph_, -INFINITY, INFINITY, a_id, b_id, y_id, 0),
+                         "xnn_define_subtract");
+    } else if (op_type == "Mul") {
+      return CheckStatus(xnn_define_multiply2(subgraph_, -INFINITY, INFINITY, a_id, b_id, y_id, 0),
+                         "xnn_define_multiply2");
+    }
+
+    return CheckStatus(xnn_define_divide(subgraph_, -INFINITY, INFINITY, a_id, b_id, y_id, 0),
+                       "xnn_define_divide");
+  }
+
+  const GraphViewer& graph_;
+  xnn_subgraph_t subgraph_;
+  std::vector<std::vector<float>>& static_data_;
+  std::unordered_map<std::string, uint32_t> value_ids_;
+};
+
+}  // namespace
+
+bool IsNodeSupportedInSubgraph(const Node& node, const GraphViewer& graph) {
+  const auto is_float_with_static_shape = [](const NodeArg* arg) {
+    return !arg->Exists() || IsFloatWithStaticShape(*arg);
+  };
+  const auto& inputs = node.InputDefs();
+  const auto& outputs = node.OutputDefs();
+  if (!std::all_of(inputs.begin(), inputs.end(), is_float_with_static_shape) ||
+      !std::all_of(outputs.begin(), outputs.end(), is_float_with_static_shape)) {
+    return false;
+  }
+
+  const auto& op_type = node.OpType();
+  if (node.Domain() == kMSInternalNHWCDomain) {
+    if (op_type == "Conv") {
+      return IsConvSupported(node, graph);
+    } else if (op_type == "MaxPool" || op_type == "AveragePool") {
+      return IsPoolSupported(node);
+    }
+  } else if (node.Domain() == kOnnxDomain) {
+    if (op_type == "Gemm") {
+      return IsGemmSupported(node, graph);
+    } else if (op_type == "MatMul") {
+      return IsMatMulSupported(node, graph);
+    } else if (op_type == "Softmax") {
+      return IsSoftmaxSupported(node);
+    } else if (op_type == "Clip") {
+      return IsClipSupported(node, graph);
+    } else {
+      static const InlinedHashSet<std::string_view> elementwise_ops = {"Relu", "Sigmoid", "HardSwish",
+                                                                       "Add", "Sub", "Mul", "Div"};
+      return elementwise_ops.count(op_type) > 0;
+    }
+  }
+
+  return false;
+}
+
+Status Subgraph::Create(const Node& fused_node, const GraphViewer& graph_viewer, pthreadpool* threadpool,
+                        std::unique_ptr<Subgraph>& subgraph) {
+  auto result = std::unique_ptr<Subgraph>(new Subgraph());
+
+  // constant initializers are static values of the subgraph, so they aren't external values
+  const auto& input_defs = fused_node.InputDefs();
+  const auto& output_defs = fused_node.OutputDefs();
+  for (size_t i = 0; i < input_defs.size(); ++i) {
+    if (input_defs[i]->Exists() && !graph_viewer.IsConstantInitializer(input_defs[i]->Name(), true)) {
+      result->inputs_.push_back({i, narrow<uint32_t>(result->inputs_.size()), {}});
+    }
+  }
+
+  for (size_t i = 0; i < output_defs.size(); ++i) {
+    result->outputs_.push_back({i, narrow<uint32_t>(result->inputs_.size() + i), {}});
+  }
+
+  xnn_subgraph_t xnn_subgraph = nullptr;
+  const auto num_external_values = narrow<uint32_t>(result->inputs_.size() + result->outputs_.size());
+  ORT_RETURN_IF_ERROR(CheckStatus(xnn_create_subgraph(num_external_values, 0, &xnn_subgraph), "xnn_create_subgraph"));
+  std::unique_ptr<xnn_subgraph, decltype(&xnn_delete_subgraph)> subgraph_holder(xnn_subgraph, xnn_delete_subgraph);
+
+  SubgraphBuilder builder(graph_viewer, xnn_subgraph, result->static_data_);
+  for (auto& input : result->inputs_) {
+    const auto& arg = *input_defs[input.index];
+    ORT_ENFORCE(GetStaticShape(arg, input.shape));
+    ORT_RETURN_IF_ERROR(builder.DefineExternalValue(arg, input.id, XNN_VALUE_FLAG_EXTERNAL_INPUT));
+  }
+
+  for (auto& output : result->outputs_) {
+    const auto& arg = *output_defs[output.index];
+    ORT_ENFORCE(GetStaticShape(arg, output.shape));
+    ORT_RETURN_IF_ERROR(builder.DefineExternalValue(arg, output.id, XNN_VALUE_FLAG_EXTERNAL_OUTPUT));
+  }
+
+  for (NodeIndex index : graph_viewer.GetNodesInTopologicalOrder()) {
+    ORT_RETURN_IF_ERROR(builder.AddNode(*graph_viewer.GetNode(index)));
+  }
+
+#if defined(XNNPACK_USE_ORT_THREADPOOL)
+  // the runtime keeps the pool, which points to the intra-op thread pool of the call being run
+  threadpool = &result->threadpool_;
+#endif
+
+  xnn_runtime_t runtime = nullptr;
+  ORT_RETURN_IF_ERROR(CheckStatus(xnn_create_runtime_v2(xnn_subgraph, threadpool, 0, &runtime),
+                                  "xnn_create_runtime_v2"));
+  result->runtime_.reset(runtime);
+
+  subgraph = std::move(result);
+  return Status::OK();
+}
+
+Status Subgraph::Compute(OrtKernelContext* context) {
+  Ort::KernelContext ctx(context);
+
+  std::vector<xnn_external_value> external_values;
+  external_values.reserve(inputs_.size() + outputs_.size());
+  for (const auto& input : inputs_) {
+    auto tensor = ctx.GetInput(input.index);
+    const auto shape = tensor.GetTensorTypeAndShapeInfo().GetShape();
+    ORT_RETURN_IF_NOT(SpanEq(AsSpan(shape), AsSpan(input.shape)),
+                      "The shape of input ", input.index, " differs from the one the xnnpack subgraph was built for");
+    external_values.push_back({input.id, const_cast<void*>(tensor.GetTensorRawData())});
+  }
+
+  for (const auto& output : outputs_) {
+    auto tensor = ctx.GetOutput(output.index, output.shape.data(), output.shape.size());
+    external_values.push_back({output.id, tensor.GetTensorMutableRawData()});
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+#if defined(XNNPACK_USE_ORT_THREADPOOL)
+  // the workers of ORT's pool stay in a single parallel section for the loops of all the nodes of the runtime
+  threadpool_.thread_pool = reinterpret_cast<OpKernelContext*>(context)->GetOperatorThreadPool();
+  concurrency::ThreadPool::ParallelSection parallel_section(threadpool_.thread_pool);
+#endif
+  ORT_RETURN_IF_ERROR(CheckStatus(xnn_setup_runtime(runtime_.get(), external_values.size(), external_values.data()),
+                                  "xnn_setup_runtime"));
+  return CheckStatus(xnn_invoke_runtime(runtime_.get()), "xnn_invoke_runtime");
+}
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
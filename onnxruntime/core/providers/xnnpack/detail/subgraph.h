@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/tensor_shape.h"
+#include "core/platform/ort_mutex.h"
+#include "core/providers/xnnpack/detail/ort_pthreadpool.h"
+#include "core/session/onnxruntime_c_api.h"
+
+#include "xnnpack.h"
+
+struct pthreadpool;
+
+namespace onnxruntime {
+class GraphViewer;
+class Node;
+
+namespace xnnpack {
+
+// Whether the node can be defined in an xnn_subgraph. All the values it consumes and produces must be float with
+// static shapes, as the subgraph defines the shape of each tensor up front, and its weights must be constant.
+bool IsNodeSupportedInSubgraph(const Node& node, const GraphViewer& graph);
+
+// A region of the graph lowered to a single XNNPACK runtime, so XNNPACK can fuse the nodes, plan the memory of the
+// values between them and run the whole region in its thread pool without returning to ORT after each node.
+class Subgraph {
+ public:
+  ~Subgraph() = default;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Subgraph);
+
+  // Defines the nodes of graph_viewer in an xnn_subgraph and creates the runtime for it. The non-constant inputs and
+  // the outputs of fused_node are the external values of the runtime. threadpool is ignored when the runtime uses the
+  // intra-op thread pool of each call, see XNNPACK_USE_ORT_THREADPOOL.
+  static Status Create(const Node& fused_node, const GraphViewer& graph_viewer, pthreadpool* threadpool,
+                       std::unique_ptr<Subgraph>& subgraph);
+
+  Status Compute(OrtKernelContext* context);
+
+ private:
+  Subgraph() = default;
+
+  struct ExternalValue {
+    size_t index;  // index of the input or output of the fused node
+    uint32_t id;   // id of the value in the xnn_subgraph
+    TensorShapeVector shape;
+  };
+
+  std::vector<ExternalValue> inputs_;
+  std::vector<ExternalValue> outputs_;
+
+  // data of the static values, which must outlive the runtime
+  std::vector<std::vector<float>> static_data_;
+
+  std::unique_ptr<xnn_runtime, decltype(&xnn_delete_runtime)> runtime_{nullptr, xnn_delete_runtime};
+
+#if defined(XNNPACK_USE_ORT_THREADPOOL)
+  // set to the intra-op thread pool of each call, as the runtime is created with the pool
+  pthreadpool threadpool_;
+#endif
+
+  // the runtime is set up with the buffers of a call at a time
+  OrtMutex mutex_;
+};
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
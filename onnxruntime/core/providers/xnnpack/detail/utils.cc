@@ -203,6 +203,39 @@ std::unique_ptr<IndexedSubGraph::MetaDef> FuseQDQGroup(const NodeUnit& node_unit
   return metadef;
 }
 
+void GetClipMinMax(const Node& clip, const GraphViewer& graph, float& min, float& max) {
+  bool min_max_are_attributes = clip.SinceVersion() == 1 || clip.SinceVersion() == 6;
+
+  if (min_max_are_attributes) {
+    ProtoHelperNodeContext nc(clip);
+    OpNodeProtoHelper info(&nc);
+    min = info.GetAttrOrDefault<float>("min", min);
+    max = info.GetAttrOrDefault<float>("max", max);
+  } else {
+    const auto& clip_inputs = clip.InputDefs();
+    const auto num_inputs = clip_inputs.size();
+
+    const auto update_value = [&](size_t idx, float& value_to_set) {
+      if (num_inputs > idx) {
+        const NodeArg& arg = *clip_inputs[idx];
+        if (arg.Exists()) {
+          const auto& value = *graph.GetConstantInitializer(arg.Name(), true);
+          // these should never be in external data as it makes no sense to put scalars there.
+          ORT_ENFORCE(utils::HasExternalData(value) == false,
+                      "External data is not supported for the scalar min/max Clip values");
+
+          value_to_set = utils::HasRawData(value)
+                             ? *reinterpret_cast<const float*>(value.raw_data().data())
+                             : value.float_data()[0];
+        }
+      }
+    };
+
+    update_value(1, min);
+    update_value(2, max);
+  }
+}
+
 // Fuse activation with node_unit.
 std::unique_ptr<IndexedSubGraph::MetaDef> FuseActivation(const NodeUnit& node_unit, const NodeUnit& activation_unit,
                                                          const GraphViewer& graph) {
@@ -239,36 +272,7 @@ std::unique_ptr<IndexedSubGraph::MetaDef> FuseActivation(const NodeUnit& node_un
   if (activation_type == "Clip") {
     min = std::numeric_limits<float>::min();
     max = std::numeric_limits<float>::max();
-    bool min_max_are_attributes = activation.SinceVersion() == 1 || activation.SinceVersion() == 6;
-
-    if (min_max_are_attributes) {
-      ProtoHelperNodeContext nc(activation);
-      OpNodeProtoHelper info(&nc);
-      min = info.GetAttrOrDefault<float>("min", min);
-      max = info.GetAttrOrDefault<float>("max", max);
-    } else {
-      const auto& clip_inputs = activation.InputDefs();
-      const auto num_inputs = clip_inputs.size();
-
-      const auto update_value = [&](size_t idx, float& value_to_set) {
-        if (num_inputs > idx) {
-          const NodeArg& arg = *clip_inputs[idx];
-          if (arg.Exists()) {
-            const auto& value = *graph.GetConstantInitializer(arg.Name(), true);
-            // these should never be in external data as it makes no sense to put scalars there.
-            ORT_ENFORCE(utils::HasExternalData(value) == false,
-                        "External data is not supported for the scalar min/max Clip values");
-
-            value_to_set = utils::HasRawData(value)
-                               ? *reinterpret_cast<const float*>(value.raw_data().data())
-                               : value.float_data()[0];
-          }
-        }
-      };
-
-      update_value(1, min);
-      update_value(2, max);
-    }
+    GetClipMinMax(activation, graph, min, max);
   } else if (activation_type == "Relu") {
     min = 0.f;
   } else {
@@ -19,6 +19,7 @@
 
 namespace onnxruntime {
 class GraphViewer;
+class Node;
 class NodeUnit;
 namespace xnnpack {
 constexpr const char* kDynamicDomainByCreate = "xnnpack";
@@ -79,6 +80,10 @@ bool IsPaddingTypeSupported(AutoPadType auto_pad);
 
 using XnnpackOperator = std::unique_ptr<struct xnn_operator, XnnpackOperatorDeleter>;
 
+// Reads the min and max of a Clip node, which are attributes before opset 11 and constant inputs from it.
+// min and max are left as they are if the node doesn't set them.
+void GetClipMinMax(const Node& clip, const GraphViewer& graph, float& min, float& max);
+
 std::unique_ptr<IndexedSubGraph::MetaDef> FuseActivation(const NodeUnit& conv_unit, const NodeUnit& activation,
                                                          const GraphViewer& graph);
 std::unique_ptr<IndexedSubGraph::MetaDef> FuseQDQGroup(const NodeUnit& unit_node);
@@ -198,7 +198,7 @@ Status Softmax::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
-  pthreadpool_t threadpool = GetThreadPool();
+  pthreadpool_t threadpool = GetThreadPool(*ctx);
   const size_t N = X_shape.SizeToDimension(axis_);
   // const size_t D = X_shape.SizeFromDimension(axis_); // the step D is 1
   xnn_status status = xnn_status_invalid_state;
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <iterator>
 #include <string_view>
 #include <unordered_map>
 #include <unordered_set>
@@ -10,9 +12,11 @@
 #include "xnnpack_execution_provider.h"
 #include "detail/utils.h"
 #include "detail/node_support_checker.h"
+#include "detail/subgraph.h"
 
 #include "core/framework/compute_capability.h"
 #include "core/framework/kernel_registry.h"
+#include "core/providers/partitioning_utils.h"
 #include "core/providers/shared/node_unit/node_unit.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 
@@ -155,8 +159,16 @@ std::unique_ptr<KernelRegistry> RegisterKernels() {
 using namespace xnnpack;
 
 XnnpackExecutionProvider::XnnpackExecutionProvider(const XnnpackExecutionProviderInfo& info)
-    : IExecutionProvider{kXnnpackExecutionProvider, true} {
+    : IExecutionProvider{kXnnpackExecutionProvider, true},
+      enable_subgraph_compile_{info.enable_subgraph_compile} {
   int xnn_thread_pool_size = info.xnn_thread_pool_size;
+#if defined(XNNPACK_USE_ORT_THREADPOOL)
+  // the kernels run XNNPACK in the parallel sections of ORT's intra-op thread pool, so there is no pool of its own
+  if (xnn_thread_pool_size != 0) {
+    LOGS_DEFAULT(WARNING) << "The XNNPACK EP shares ORT's intra-op thread pool, so intra_op_num_threads is ignored. "
+                             "Please set the intra-op thread pool size in the SessionOptions instead.";
+  }
+#else
   int ort_thread_pool_size = info.session_options ? info.session_options->intra_op_param.thread_pool_size : 1;
   bool allow_intra_op_spinning = (info.session_options == nullptr) ||
                                  (info.session_options &&
@@ -168,7 +180,8 @@ XnnpackExecutionProvider::XnnpackExecutionProvider(const XnnpackExecutionProvide
            "If ORT's thread pool size is > 1 and spinning is enabled, "
            "there will be contention between the two thread pools, and performance will suffer."
            "Please set either intra_op_param.allow_spinning to 0 in the SessionOption config params,"
-           "or the ORT intra-op threadpool size to 1.";
+           "or the ORT intra-op threadpool size to 1, "
+           "or build with onnxruntime_XNNPACK_USE_ORT_THREADPOOL to share ORT's thread pool.";
   }
 
   if (xnn_thread_pool_size == 0) {
@@ -179,6 +192,7 @@ XnnpackExecutionProvider::XnnpackExecutionProvider(const XnnpackExecutionProvide
     // pthreadpool is independent of ort-threadpoool, so we had better disable cpu spinning for ort-threadpool.
     xnnpack_thread_pool_ = pthreadpool_create(static_cast<size_t>(xnn_thread_pool_size));
   }
+#endif
 }
 
 std::vector<AllocatorPtr> XnnpackExecutionProvider::CreatePreferredAllocators() {
@@ -296,6 +310,11 @@ std::vector<std::unique_ptr<ComputeCapability>> XnnpackExecutionProvider::GetCap
         // see if it's an activation we can fuse with a node we support. note that we can only do this after
         // the layout transform as we need to fuse with the NWHC op that we have the real kernel for.
         const NodeUnit* fuse_with = checker.IsNodeSupportedWithFusion(node_unit);
+        // when compiling, the activation joins the region of the node it follows and XNNPACK fuses it in there.
+        if (fuse_with && enable_subgraph_compile_ && IsNodeSupportedInSubgraph(fuse_with->GetNode(), graph)) {
+          fuse_with = nullptr;
+        }
+
         if (fuse_with) {
           // add new MetaDef to existing ComputeCapability.
           // we know an entry must exist in node_to_compute_capability as we update supported_node_unit_map
@@ -342,12 +361,110 @@ std::vector<std::unique_ptr<ComputeCapability>> XnnpackExecutionProvider::GetCap
     }
   }
 
-  // FUTURE: finding nodes to compile can be inserted here and added to the ComputeCapability instances returned.
   // GraphPartitioner can handle a mix of static and compiled kernels.
+  if (enable_subgraph_compile_) {
+    CompileSupportedRegions(graph, capabilities);
+  }
 
   return capabilities;
 }
 
+void XnnpackExecutionProvider::CompileSupportedRegions(
+    const GraphViewer& graph,
+    std::vector<std::unique_ptr<ComputeCapability>>& capabilities) const {
+  // the NHWC nodes only exist in the second call, after the layout transformation of the nodes taken in the first.
+  const auto& nodes = graph.Nodes();
+  if (std::none_of(nodes.begin(), nodes.end(),
+                   [this](const Node& node) { return node.GetExecutionProviderType() == Type(); })) {
+    return;
+  }
+
+  // a region can have the nodes with a static kernel, other than those of QDQ node groups or with a fused activation,
+  // and the unassigned nodes the static kernels don't cover, e.g. Add, Mul or Sigmoid.
+  std::unordered_set<const Node*> supported_nodes;
+  std::unordered_set<NodeIndex> nodes_in_capabilities;
+  for (const auto& capability : capabilities) {
+    const auto& sub_graph = *capability->sub_graph;
+    nodes_in_capabilities.insert(sub_graph.nodes.cbegin(), sub_graph.nodes.cend());
+    if (sub_graph.GetMetaDef() == nullptr && sub_graph.nodes.size() == 1) {
+      const Node* node = graph.GetNode(sub_graph.nodes[0]);
+      if (IsNodeSupportedInSubgraph(*node, graph)) {
+        supported_nodes.insert(node);
+      }
+    }
+  }
+
+  for (const Node& node : nodes) {
+    if (node.GetExecutionProviderType().empty() && nodes_in_capabilities.count(node.Index()) == 0 &&
+        IsNodeSupportedInSubgraph(node, graph)) {
+      supported_nodes.insert(&node);
+    }
+  }
+
+  const auto gen_metadef_name = [&]() {
+    HashValue model_hash;
+    int metadef_id = GenerateMetaDefId(graph, model_hash);
+    return MakeString("XNNPACK_", model_hash, "_", metadef_id);
+  };
+
+  auto regions = utils::CreateSupportedPartitions(graph, supported_nodes, {}, gen_metadef_name, "XNNPACK", Type());
+
+  // a single node gains nothing from a subgraph, so it keeps its static kernel if it has one
+  regions.erase(std::remove_if(regions.begin(), regions.end(),
+                               [](const std::unique_ptr<ComputeCapability>& region) {
+                                 return region->sub_graph->nodes.size() < 2;
+                               }),
+                regions.end());
+
+  std::unordered_set<NodeIndex> nodes_in_regions;
+  for (const auto& region : regions) {
+    nodes_in_regions.insert(region->sub_graph->nodes.cbegin(), region->sub_graph->nodes.cend());
+  }
+
+  capabilities.erase(std::remove_if(capabilities.begin(), capabilities.end(),
+                                    [&nodes_in_regions](const std::unique_ptr<ComputeCapability>& capability) {
+                                      return nodes_in_regions.count(capability->sub_graph->nodes[0]) > 0;
+                                    }),
+                     capabilities.end());
+
+  LOGS_DEFAULT(VERBOSE) << "XNNPACK subgraphs: " << regions.size() << " with " << nodes_in_regions.size()
+                        << " nodes. Nodes with a static kernel: " << capabilities.size();
+
+  std::move(regions.begin(), regions.end(), std::back_inserter(capabilities));
+}
+
+#if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+common::Status XnnpackExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fused_nodes_and_graphs,
+                                                 std::vector<NodeComputeInfo>& node_compute_funcs) {
+  for (const auto& fused_node_and_graph : fused_nodes_and_graphs) {
+    const Node& fused_node = fused_node_and_graph.fused_node;
+    std::unique_ptr<Subgraph> subgraph;
+    ORT_RETURN_IF_ERROR(Subgraph::Create(fused_node, fused_node_and_graph.filtered_graph, xnnpack_thread_pool_,
+                                         subgraph));
+    subgraphs_[fused_node.Name()] = std::move(subgraph);
+
+    NodeComputeInfo compute_info;
+    compute_info.create_state_func = [&](ComputeContext* context, FunctionState* state) {
+      *state = subgraphs_[context->node_name].get();
+      return 0;
+    };
+
+    compute_info.release_state_func = [](FunctionState state) {
+      // the `state` is a Subgraph owned by subgraphs_
+      ORT_UNUSED_PARAMETER(state);
+    };
+
+    compute_info.compute_func = [](FunctionState state, const OrtApi* /* api */, OrtKernelContext* context) {
+      return reinterpret_cast<Subgraph*>(state)->Compute(context);
+    };
+
+    node_compute_funcs.push_back(std::move(compute_info));
+  }
+
+  return Status::OK();
+}
+#endif
+
 std::shared_ptr<KernelRegistry> XnnpackExecutionProvider::GetKernelRegistry() const {
   static std::shared_ptr<KernelRegistry> registry = xnnpack::RegisterKernels();
   return registry;
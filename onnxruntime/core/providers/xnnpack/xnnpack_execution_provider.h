@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+#include <unordered_map>
+
 #include "core/framework/execution_provider.h"
 #include "core/graph/constants.h"
 #include "core/providers/providers.h"
@@ -11,9 +15,14 @@
 
 struct pthreadpool;
 namespace onnxruntime {
-// placeholder for future use. no options currently
+namespace xnnpack {
+class Subgraph;
+}
+
 struct XnnpackExecutionProviderInfo {
   int xnn_thread_pool_size{0};
+  // compile the regions of supported nodes into XNNPACK subgraphs instead of running a kernel per node
+  bool enable_subgraph_compile{false};
   const SessionOptions* session_options{nullptr};
   XnnpackExecutionProviderInfo() = default;
 
@@ -22,6 +31,10 @@ struct XnnpackExecutionProviderInfo {
     if (auto it = po.find("intra_op_num_threads"); it != po.end()) {
       xnn_thread_pool_size = std::stoi(it->second);
     }
+
+    if (auto it = po.find("enable_subgraph_compile"); it != po.end()) {
+      enable_subgraph_compile = it->second == "1";
+    }
   }
 };
 
@@ -36,6 +49,11 @@ class XnnpackExecutionProvider : public IExecutionProvider {
 
   std::shared_ptr<KernelRegistry> GetKernelRegistry() const override;
 
+#if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+  common::Status Compile(const std::vector<FusedNodeAndGraph>& fused_nodes_and_graphs,
+                         std::vector<NodeComputeInfo>& node_compute_funcs) override;
+#endif
+
   DataLayout GetPreferredLayout() const override { return DataLayout::NHWC; }
 
   FusionStyle GetFusionStyle() const override { return FusionStyle::FilteredGraphViewer; }
@@ -50,7 +68,15 @@ class XnnpackExecutionProvider : public IExecutionProvider {
   std::vector<AllocatorPtr> CreatePreferredAllocators() override;
 
  private:
+  // replaces the capabilities of the nodes in regions that an XNNPACK subgraph supports with one for each region
+  void CompileSupportedRegions(const GraphViewer& graph,
+                               std::vector<std::unique_ptr<ComputeCapability>>& capabilities) const;
+
   pthreadpool* xnnpack_thread_pool_{nullptr};
+  const bool enable_subgraph_compile_;
+
+  // compiled subgraphs by fused node name
+  std::unordered_map<std::string, std::unique_ptr<xnnpack::Subgraph>> subgraphs_;
 };
 
 }  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #pragma once
 #include "core/framework/op_kernel.h"
 #include "core/providers/xnnpack/xnnpack_execution_provider.h"
+#include "core/providers/xnnpack/detail/ort_pthreadpool.h"
 #include "xnnpack.h"
 
 struct pthreadpool;
@@ -19,8 +20,17 @@ class XnnpackKernel : public OpKernel {
             static_cast<const XnnpackExecutionProvider*>(info.GetExecutionProvider())->GetPrivateThreadPool()},
         caches_{enable_caches} {
   }
-  [[nodiscard]] pthreadpool* GetThreadPool() const {
+  // The pool to run the XNNPACK operators of a call in. When built with XNNPACK_USE_ORT_THREADPOOL it schedules onto the
+  // intra-op thread pool of the call, otherwise it is the private pthreadpool of the EP.
+  [[nodiscard]] pthreadpool* GetThreadPool(OpKernelContext& context) const {
+#if defined(XNNPACK_USE_ORT_THREADPOOL)
+    // the EP doesn't support concurrent runs, so a call at a time uses the pool
+    ort_threadpool_.thread_pool = context.GetOperatorThreadPool();
+    return &ort_threadpool_;
+#else
+    ORT_UNUSED_PARAMETER(context);
     return xnnpack_threadpool_;
+#endif
   }
 
   // see comment below about enabling code cache
@@ -30,6 +40,9 @@ class XnnpackKernel : public OpKernel {
 
  private:
   pthreadpool* xnnpack_threadpool_;
+#if defined(XNNPACK_USE_ORT_THREADPOOL)
+  mutable pthreadpool ort_threadpool_;
+#endif
 
   // Helper class to wrap usage of the XNNPACK weights and code caches.
   // NOTE: Currently creating/freeing the code cache is not exposed via the public xnnpack.h header so usage is
@@ -2,7 +2,12 @@
 // Licensed under the MIT License.
 
 #include "core/session/IOBinding.h"
+
+#include <algorithm>
+
 #include "core/common/logging/logging.h"
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/utils.h"
@@ -97,17 +102,117 @@ common::Status IOBinding::BindOutputImpl(const std::string& name, const OrtValue
   } else {
     outputs_[index] = ml_value;
     outputs_device_info_[index] = device;
+    ring_buffers_.erase(index);
   }
   ORT_ENFORCE(mapped_output_names_.size() == output_names_.size(), "Size mismatch", mapped_output_names_.size(), "!=", output_names_.size());
 
   return Status::OK();
 }
 
+common::Status IOBinding::BindOutput(const std::string& name, OutputRingBuffer ring_buffer) {
+  if (ring_buffer.base == nullptr || ring_buffer.stride_bytes == 0 || !ring_buffer.get_position) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Ring buffer for output ", name, " needs a base pointer, a stride and a position callback.");
+  }
+
+  const auto& graph_outputs = session_state_.GetGraphViewer().GetOutputs();
+  auto output = std::find_if(graph_outputs.cbegin(), graph_outputs.cend(),
+                             [&name](const NodeArg* arg) { return arg->Name() == name; });
+  if (output == graph_outputs.cend()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid output name: ", name);
+  }
+
+  MLDataType type = (*output)->TypeAsProto() ? DataTypeImpl::TypeFromProto(*(*output)->TypeAsProto()) : nullptr;
+  if (type == nullptr || !type->IsTensorType()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Only tensor outputs can be bound to a ring buffer: ", name);
+  }
+
+  ORT_RETURN_IF_ERROR(BindOutputImpl(name, {}, ring_buffer.memory_info.device));
+
+  const size_t index = mapped_output_names_[name];
+  ring_buffers_[index] = {std::move(ring_buffer), type->AsTensorType()->GetElementType()};
+
+  return Status::OK();
+}
+
+Status IOBinding::CreateRingBufferTensor(size_t index, MLDataType element_type, const TensorShape& shape,
+                                         OrtValue& value) {
+  const auto& ring_buffer = ring_buffers_.at(index).buffer;
+
+  size_t num_bytes = 0;
+  if (!IAllocator::CalcMemSizeForArray(narrow<size_t>(shape.Size()), element_type->Size(), &num_bytes)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Size overflow for output ", output_names_[index], " of shape ", shape);
+  }
+
+  const size_t offset = SafeInt<size_t>(ring_buffer.get_position(num_bytes)) * ring_buffer.stride_bytes;
+  if (offset > ring_buffer.capacity_bytes || num_bytes > ring_buffer.capacity_bytes - offset) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Output ", output_names_[index], " of ", num_bytes,
+                           " bytes does not fit in its ring buffer at offset ", offset, ". Capacity is ",
+                           ring_buffer.capacity_bytes, " bytes.");
+  }
+
+  Tensor::InitOrtValue(element_type, shape, static_cast<char*>(ring_buffer.base) + offset, ring_buffer.memory_info,
+                       value);
+  return Status::OK();
+}
+
+std::unordered_map<size_t, IExecutor::CustomAllocator> IOBinding::PrepareRingBufferOutputs() {
+  std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
+  written_in_place_.assign(outputs_.size(), 0);
+
+  for (const auto& entry : ring_buffers_) {
+    const size_t index = entry.first;
+    // the value of the previous Run is a view of the ring buffer at an old position.
+    // leave the output unallocated so that the execution frame asks for the new position.
+    outputs_[index] = OrtValue();
+
+    fetch_allocators[index] = [this, index](const TensorShape& shape, const OrtDevice& location,
+                                            OrtValue& ort_value, bool& allocated) -> Status {
+      const auto& binding = ring_buffers_.at(index);
+      if (location != binding.buffer.memory_info.device) {
+        // produced on another device. FinalizeRingBufferOutputs() copies it into the ring buffer.
+        return Status::OK();
+      }
+
+      ORT_RETURN_IF_ERROR(CreateRingBufferTensor(index, binding.element_type, shape, ort_value));
+      written_in_place_[index] = 1;
+      allocated = true;
+      return Status::OK();
+    };
+  }
+
+  return fetch_allocators;
+}
+
+common::Status IOBinding::FinalizeRingBufferOutputs() {
+  for (const auto& entry : ring_buffers_) {
+    const size_t index = entry.first;
+    if (written_in_place_[index]) {
+      continue;
+    }
+
+    const OrtValue& produced = outputs_[index];
+    if (!produced.IsAllocated() || !produced.IsTensor()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Output ", output_names_[index], " was not produced as a tensor.");
+    }
+
+    const Tensor& src = produced.Get<Tensor>();
+    OrtValue dst;
+    ORT_RETURN_IF_ERROR(CreateRingBufferTensor(index, src.DataType(), src.Shape(), dst));
+    ORT_RETURN_IF_ERROR(session_state_.GetDataTransferMgr().CopyTensor(src, *dst.GetMutable<Tensor>()));
+    outputs_[index] = std::move(dst);
+  }
+
+  return Status::OK();
+}
+
 void IOBinding::ClearOutputs() {
   mapped_output_names_.clear();
   output_names_.clear();
   outputs_.clear();
   outputs_device_info_.clear();
+  ring_buffers_.clear();
+  written_in_place_.clear();
 }
 
 const std::vector<std::string>& IOBinding::GetOutputNames() const { return output_names_; }
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <functional>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -9,12 +10,28 @@
 #include "core/framework/execution_provider.h"
 #include "core/common/status.h"
 #include "core/graph/basic_types.h"
+#include "core/framework/iexecutor.h"
 #include "core/framework/ort_value.h"
 #include "core/session/inference_session.h"
 #include "core/common/logging/logging.h"
 
 namespace onnxruntime {
 class SessionState;
+
+/**
+ * Caller owned buffer, typically a ring buffer, that an output is written into directly.
+ * The write position may change on every Run, so it is queried when the size of the output is known.
+ */
+struct OutputRingBuffer {
+  void* base{nullptr};
+  size_t capacity_bytes{0};
+  // distance in bytes between two write positions
+  size_t stride_bytes{1};
+  OrtMemoryInfo memory_info{CPU, OrtAllocatorType::OrtDeviceAllocator};
+  // returns the write position for an output of the given size, in units of stride_bytes from base
+  std::function<size_t(size_t num_bytes)> get_position;
+};
+
 /**
  * Input/Output binding.
  * Usage is as follows:
@@ -71,6 +88,14 @@ class IOBinding {
    */
   common::Status BindOutput(const std::string& name, OrtDevice device = {});
 
+  /**
+   * Bind an output name to a caller owned buffer.
+   * On every Run the output is written at the position returned by ring_buffer.get_position, without a copy
+   * if the kernel producing it runs on the device of the buffer. GetOutputs() returns a tensor that views the
+   * buffer at that position.
+   */
+  common::Status BindOutput(const std::string& name, OutputRingBuffer ring_buffer);
+
   /**
    * This simply collects the outputs obtained after calling Run() inside the @param outputs.
    */
@@ -109,9 +134,29 @@ class IOBinding {
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IOBinding);
 
+  struct RingBufferBinding {
+    OutputRingBuffer buffer;
+    MLDataType element_type;
+  };
+  // outputs bound to a ring buffer, by index in output_names_
+  std::unordered_map<size_t, RingBufferBinding> ring_buffers_;
+  // per output, set if the current Run wrote it in place into its ring buffer.
+  // one element per output so a parallel executor can set different entries concurrently.
+  std::vector<char> written_in_place_;
+
   // device info for all outputs. only used by InferenceSession if the output is not pre-allocated.
   const std::vector<OrtDevice>& GetOutputsDeviceInfo() const;
 
+  // Used by InferenceSession::Run. Clears the ring buffer outputs of the previous Run and returns the fetch
+  // allocators that make the ExecutionFrame create those outputs in their ring buffers.
+  std::unordered_map<size_t, IExecutor::CustomAllocator> PrepareRingBufferOutputs();
+
+  // Used by InferenceSession::Run. Copies ring buffer outputs that could not be written in place into their buffer,
+  // e.g. outputs that alias a graph input or were produced on another device.
+  common::Status FinalizeRingBufferOutputs();
+
+  Status CreateRingBufferTensor(size_t index, MLDataType element_type, const TensorShape& shape, OrtValue& value);
+
   // The implementation for the BindOutput() overloads
   common::Status BindOutputImpl(const std::string& name, const OrtValue& ml_value, OrtDevice device);
 };
@@ -151,6 +151,13 @@ ORT_API_STATUS_IMPL(OrtApis::SetUserLoggingFunction, _In_ OrtSessionOptions* opt
   return nullptr;
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SetTraceSpanFunction, _Inout_ OrtSessionOptions* options,
+                    _In_opt_ OrtTraceSpanFunction trace_span_function, _In_opt_ void* trace_span_param) {
+  options->value.trace_span_function = trace_span_function;
+  options->value.trace_span_param = trace_span_param;
+  return nullptr;
+}
+
 ///< applies to session load, initialization, etc
 ORT_API_STATUS_IMPL(OrtApis::SetSessionLogVerbosityLevel, _In_ OrtSessionOptions* options, int session_log_verbosity_level) {
   options->value.session_log_verbosity_level = session_log_verbosity_level;
@@ -83,6 +83,25 @@ ORT_API_STATUS_IMPL(OrtApis::CreateAndRegisterAllocator, _Inout_ OrtEnv* env,
   return nullptr;
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreateAndRegisterActivationPool, _Inout_ OrtEnv* env,
+                    _In_ const OrtMemoryInfo* mem_info, size_t max_bytes, int64_t admission_timeout_ms) {
+  using namespace onnxruntime;
+  if (!env) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Env is null");
+  }
+
+  if (!mem_info) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "OrtMemoryInfo is null");
+  }
+
+  auto st = env->CreateAndRegisterActivationPool(*mem_info, max_bytes, admission_timeout_ms);
+
+  if (!st.IsOK()) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, st.ErrorMessage().c_str());
+  }
+  return nullptr;
+}
+
 ORT_API_STATUS_IMPL(OrtApis::RegisterAllocator, _Inout_ OrtEnv* env,
                     _In_ OrtAllocator* allocator) {
   using namespace onnxruntime;
@@ -13,9 +13,11 @@
 #include "core/framework/onnxruntime_typeinfo.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/op_kernel_info.h"
+#include "core/framework/prepacked_weights.h"
 #include "core/framework/tensor_type_and_shape.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/graph/onnx_protobuf.h"
+#include "core/platform/threadpool.h"
 #include "core/session/allocator_adapters.h"
 #include "core/session/api_utils.h"
 #include "core/session/custom_ops.h"
@@ -31,6 +33,7 @@ static constexpr uint32_t min_ort_version_with_custom_version = 17;
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_MINIMAL_BUILD_CUSTOM_OPS)
 static constexpr uint32_t min_ort_version_with_compute_v2_support = 16;
 static constexpr uint32_t min_ort_version_with_shape_inference = 17;
+static constexpr uint32_t min_ort_version_with_prepack_support = 17;
 #endif
 
 #if !defined(DISABLE_FLOAT8_TYPES)
@@ -377,6 +380,76 @@ ORT_API_STATUS_IMPL(OrtApis::KernelContext_GetResource, _In_ const OrtKernelCont
   API_IMPL_END
 };
 
+ORT_API_STATUS_IMPL(OrtApis::KernelContext_ParallelFor, _In_ const OrtKernelContext* context,
+                    _In_ void (*fn)(void*, size_t), _In_ size_t total, _In_ size_t num_batch,
+                    _In_opt_ void* usr_data) {
+  API_IMPL_BEGIN
+  if (!context) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Invalid context");
+  }
+  if (fn && total) {
+    const auto* ctx = reinterpret_cast<const onnxruntime::OpKernelContext*>(context);
+    auto* tp = ctx->GetOperatorThreadPool();
+    auto task = [fn, usr_data](std::ptrdiff_t ix) { fn(usr_data, static_cast<size_t>(ix)); };
+    if (num_batch) {
+      onnxruntime::concurrency::ThreadPool::TryBatchParallelFor(tp, static_cast<std::ptrdiff_t>(total), task,
+                                                                static_cast<std::ptrdiff_t>(num_batch));
+    } else {
+      onnxruntime::concurrency::ThreadPool::TrySimpleParallelFor(tp, static_cast<std::ptrdiff_t>(total), task);
+    }
+  }
+  return nullptr;
+  API_IMPL_END
+};
+
+ORT_API_STATUS_IMPL(OrtApis::KernelContext_GetDegreeOfParallelism, _In_ const OrtKernelContext* context,
+                    _Out_ int* out) {
+  API_IMPL_BEGIN
+  if (!context) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Invalid context");
+  }
+  const auto* ctx = reinterpret_cast<const onnxruntime::OpKernelContext*>(context);
+  *out = onnxruntime::concurrency::ThreadPool::DegreeOfParallelism(ctx->GetOperatorThreadPool());
+  return nullptr;
+  API_IMPL_END
+};
+
+ORT_API_STATUS_IMPL(OrtApis::KernelContext_GetScratchBuffer, _In_ const OrtKernelContext* context,
+                    _In_ const OrtMemoryInfo* mem_info, _In_ size_t size, _Outptr_result_maybenull_ void** out) {
+  API_IMPL_BEGIN
+  *out = nullptr;
+  if (size == 0) {
+    return nullptr;
+  }
+  const auto* ctx = reinterpret_cast<const onnxruntime::OpKernelContext*>(context);
+  onnxruntime::AllocatorPtr allocator = ctx->GetAllocator(mem_info->device);
+  if (!allocator) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "No requested allocator available");
+  }
+  *out = allocator->Alloc(size);
+  return nullptr;
+  API_IMPL_END
+};
+
+// the pre-packed weights a CustomOpKernel::PrePack fills in, with the allocator the buffers are allocated with
+struct OrtPrePackedWeights {
+  onnxruntime::PrePackedWeights& weights;
+  onnxruntime::AllocatorPtr allocator;
+};
+
+ORT_API_STATUS_IMPL(OrtApis::PrePackedWeights_AddBuffer, _Inout_ OrtPrePackedWeights* prepacked_weights,
+                    _In_ void* buffer, _In_ size_t size) {
+  API_IMPL_BEGIN
+  if (!prepacked_weights || !buffer) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Invalid pre-packed weights or buffer");
+  }
+  auto allocator = prepacked_weights->allocator;
+  prepacked_weights->weights.buffers_.emplace_back(buffer, [allocator](void* p) { allocator->Free(p); });
+  prepacked_weights->weights.buffer_sizes_.push_back(size);
+  return nullptr;
+  API_IMPL_END
+};
+
 #ifdef _WIN32
 #pragma warning(pop)
 #endif
@@ -685,6 +758,50 @@ struct CustomOpKernel : OpKernel {
     }
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) override {
+    is_packed = false;
+    if (op_.version < min_ort_version_with_prepack_support || !op_.KernelPrePack ||
+        (prepacked_weights != nullptr && !op_.KernelUseSharedPrePackedBuffers)) {
+      return Status::OK();
+    }
+
+    // the kernel reads the initializer through a value that doesn't own its buffer
+    OrtValue value;
+    Tensor::InitOrtValue(tensor.DataType(), tensor.Shape(), const_cast<void*>(tensor.DataRaw()), tensor.Location(),
+                         value);
+    OrtAllocatorImplWrappingIAllocator allocator(AllocatorPtr(alloc));
+
+    int packed = 0;
+    if (prepacked_weights != nullptr) {
+      OrtPrePackedWeights ort_prepacked_weights{*prepacked_weights, alloc};
+      ORT_RETURN_IF_ERROR(ToStatus(op_.KernelPrePack(op_kernel_, &value, input_idx, &allocator,
+                                                     &ort_prepacked_weights, &packed)));
+    } else {
+      ORT_RETURN_IF_ERROR(ToStatus(op_.KernelPrePack(op_kernel_, &value, input_idx, &allocator, nullptr, &packed)));
+    }
+    is_packed = packed != 0;
+    return Status::OK();
+  }
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override {
+    used_shared_buffers = false;
+    if (op_.version < min_ort_version_with_prepack_support || !op_.KernelUseSharedPrePackedBuffers) {
+      return Status::OK();
+    }
+
+    InlinedVector<void*> buffers;
+    buffers.reserve(prepacked_buffers.size());
+    for (const auto& prepacked_buffer : prepacked_buffers) {
+      buffers.push_back(prepacked_buffer.get());
+    }
+    ORT_RETURN_IF_ERROR(ToStatus(op_.KernelUseSharedPrePackedBuffers(op_kernel_, input_idx, buffers.data(),
+                                                                     buffers.size())));
+    used_shared_buffers = true;
+    return Status::OK();
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CustomOpKernel);
 
@@ -0,0 +1,161 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/device_pool_session.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "core/framework/execution_provider.h"
+#include "core/graph/model.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+DevicePoolSession::DevicePoolSession(DevicePoolSessionOptions options) : options_(std::move(options)) {}
+
+DevicePoolSession::~DevicePoolSession() = default;
+
+Status DevicePoolSession::Create(const SessionOptions& session_options, const Environment& env,
+                                 const PathString& model_uri,
+                                 std::vector<std::unique_ptr<IExecutionProvider>> replica_providers,
+                                 DevicePoolSessionOptions options,
+                                 std::unique_ptr<DevicePoolSession>& device_pool_session) {
+  const size_t num_replicas = replica_providers.size();
+  ORT_RETURN_IF(num_replicas == 0, "A device pool needs at least one replica");
+  ORT_RETURN_IF(std::any_of(replica_providers.begin(), replica_providers.end(), [](const auto& p) { return !p; }),
+                "The execution provider of a replica is null");
+
+  ONNX_NAMESPACE::ModelProto model_proto;
+  ORT_RETURN_IF_ERROR(Model::Load(model_uri, model_proto));
+
+  auto session = std::unique_ptr<DevicePoolSession>(new DevicePoolSession(std::move(options)));
+  session->replicas_.resize(num_replicas);
+
+  for (size_t r = 0; r < num_replicas; ++r) {
+    SessionOptions replica_session_options = session_options;
+    replica_session_options.session_logid += "_replica_" + std::to_string(r);
+    auto& replica_session = session->replicas_[r].session;
+    replica_session = std::make_unique<InferenceSession>(replica_session_options, env);
+    ORT_RETURN_IF_ERROR(replica_session->RegisterExecutionProvider(std::move(replica_providers[r])));
+    if (r + 1 < num_replicas) {
+      ORT_RETURN_IF_ERROR(replica_session->Load(model_proto, model_uri));
+    } else {
+      ORT_RETURN_IF_ERROR(replica_session->Load(std::move(model_proto), model_uri));
+    }
+
+    // the replicas are initialized in order, so the first one has written the optimization cache when the others
+    // look it up
+    ORT_RETURN_IF_ERROR(replica_session->Initialize());
+
+#if !defined(ORT_MINIMAL_BUILD)
+    if (r > 0) {
+      ORT_RETURN_IF_ERROR(replica_session->SetTuningResults(session->replicas_[0].session->GetTuningResults()));
+    }
+#endif
+  }
+
+  device_pool_session = std::move(session);
+  return Status::OK();
+}
+
+DevicePoolReplicaMetrics DevicePoolSession::GetReplicaMetrics(size_t replica) const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return replicas_[replica].metrics;
+}
+
+size_t DevicePoolSession::NumQueuedRuns() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return queued_runs_;
+}
+
+size_t DevicePoolSession::AcquireReplica() {
+  std::unique_lock<OrtMutex> lock(mutex_);
+
+  // the replica with the fewest runs in flight, starting the search after the replica picked last so that the idle
+  // replicas take turns
+  const auto find_replica = [this]() {
+    size_t best = replicas_.size();
+    for (size_t i = 0; i < replicas_.size(); ++i) {
+      const size_t r = (next_replica_ + i) % replicas_.size();
+      const size_t in_flight = replicas_[r].metrics.in_flight_runs;
+      if (options_.max_in_flight_per_replica != 0 && in_flight >= options_.max_in_flight_per_replica) {
+        continue;
+      }
+      if (best == replicas_.size() || in_flight < replicas_[best].metrics.in_flight_runs) {
+        best = r;
+      }
+    }
+    return best;
+  };
+
+  size_t replica = find_replica();
+  if (replica == replicas_.size()) {
+    ++queued_runs_;
+    replica_released_.wait(lock, [&]() {
+      replica = find_replica();
+      return replica != replicas_.size();
+    });
+    --queued_runs_;
+  }
+
+  ++replicas_[replica].metrics.in_flight_runs;
+  next_replica_ = (replica + 1) % replicas_.size();
+  return replica;
+}
+
+void DevicePoolSession::ReleaseReplica(size_t replica, bool failed, uint64_t run_time_us) {
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto& metrics = replicas_[replica].metrics;
+    --metrics.in_flight_runs;
+    ++(failed ? metrics.failed_runs : metrics.completed_runs);
+    metrics.total_run_time_us += run_time_us;
+  }
+  replica_released_.notify_one();
+}
+
+Status DevicePoolSession::Run(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                              gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+                              std::vector<OrtValue>& fetches) {
+  ORT_RETURN_IF_NOT(feed_names.size() == feeds.size(), "Expected as many feeds as feed names");
+  const std::vector<OrtDevice> output_devices(output_names.size(), OrtDevice());
+
+  const size_t replica = AcquireReplica();
+  const auto start = std::chrono::steady_clock::now();
+
+  Status status;
+  ORT_TRY {
+    fetches.clear();
+    status = replicas_[replica].session->Run(run_options, feed_names, feeds, output_names, &fetches,
+                                             &output_devices);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+    });
+  }
+
+  const auto run_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                              start);
+  ReleaseReplica(replica, !status.IsOK(), static_cast<uint64_t>(run_time.count()));
+  return status;
+}
+
+Status DevicePoolSession::ShareTuningResults() {
+#if !defined(ORT_MINIMAL_BUILD)
+  std::vector<TuningResults> tuning_results;
+  for (const auto& replica : replicas_) {
+    auto replica_results = replica.session->GetTuningResults();
+    tuning_results.insert(tuning_results.end(), replica_results.begin(), replica_results.end());
+  }
+
+  for (auto& replica : replicas_) {
+    ORT_RETURN_IF_ERROR(replica.session->SetTuningResults(tuning_results));
+  }
+#endif
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/common/path_string.h"
+#include "core/common/status.h"
+#include "core/framework/framework_common.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+class Environment;
+class IExecutionProvider;
+class InferenceSession;
+struct SessionOptions;
+
+struct DevicePoolSessionOptions {
+  // the most runs a replica runs at once. a run that finds every replica at the limit waits in the queue of the pool
+  // and starts on the first replica that completes a run. 0 doesn't limit the runs of a replica.
+  size_t max_in_flight_per_replica = 1;
+};
+
+struct DevicePoolReplicaMetrics {
+  size_t in_flight_runs = 0;
+  uint64_t completed_runs = 0;
+  uint64_t failed_runs = 0;
+  // the time the replica spent on the runs it completed, failed or not
+  uint64_t total_run_time_us = 0;
+};
+
+/**
+ * Data-parallel inference of a model on several devices.
+ *
+ * The pool holds a replica of the model per execution provider, e.g. the CUDA execution provider of each device, and
+ * routes each run to the replica with the fewest runs in flight, rotating among the idle ones. A run that finds every
+ * replica at max_in_flight_per_replica waits in the queue of the pool.
+ *
+ * The model is parsed once. The first replica is initialized before the others, so that they load the graph it
+ * optimized from the optimization cache when kOrtSessionOptionsOptimizationCacheDir is set, and start with the
+ * tuning results it holds. ShareTuningResults() shares the results the replicas tune while they run.
+ *
+ * The outputs are on CPU, whichever replica ran.
+ */
+class DevicePoolSession {
+ public:
+  static Status Create(const SessionOptions& session_options, const Environment& env, const PathString& model_uri,
+                       std::vector<std::unique_ptr<IExecutionProvider>> replica_providers,
+                       DevicePoolSessionOptions options, std::unique_ptr<DevicePoolSession>& device_pool_session);
+
+  ~DevicePoolSession();
+
+  size_t NumReplicas() const { return replicas_.size(); }
+  const InferenceSession& GetReplicaSession(size_t replica) const { return *replicas_[replica].session; }
+
+  DevicePoolReplicaMetrics GetReplicaMetrics(size_t replica) const;
+
+  // the runs waiting for a replica
+  size_t NumQueuedRuns() const;
+
+  Status Run(const RunOptions& run_options, gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+             gsl::span<const std::string> output_names, std::vector<OrtValue>& fetches);
+
+  // Sets the tuning results of every replica on all the others. The results a replica can't use, e.g. those of
+  // another device architecture, are skipped.
+  Status ShareTuningResults();
+
+ private:
+  struct Replica {
+    std::unique_ptr<InferenceSession> session;
+    DevicePoolReplicaMetrics metrics;  // GUARDED_BY(mutex_)
+  };
+
+  explicit DevicePoolSession(DevicePoolSessionOptions options);
+
+  // Waits for a replica below the in-flight limit and counts the run against it.
+  size_t AcquireReplica();
+  void ReleaseReplica(size_t replica, bool failed, uint64_t run_time_us);
+
+  const DevicePoolSessionOptions options_;
+  std::vector<Replica> replicas_;
+
+  mutable OrtMutex mutex_;
+  OrtCondVar replica_released_;
+  size_t queued_runs_ = 0;   // GUARDED_BY(mutex_)
+  size_t next_replica_ = 0;  // GUARDED_BY(mutex_)
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(DevicePoolSession);
+};
+
+}  // namespace onnxruntime
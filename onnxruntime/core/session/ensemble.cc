@@ -0,0 +1,222 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/session/ensemble.h"
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "core/common/path.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/model.h"
+
+namespace onnxruntime {
+
+namespace {
+using NameMap = std::unordered_map<std::string, std::string>;
+
+// Renames the values and nodes of a graph and of its subgraphs to prefix + name, or the values in renamed to their
+// entry. ONNX names are unique across the scopes of a model, so the subgraphs are renamed like their graph.
+void RenameGraph(ONNX_NAMESPACE::GraphProto& graph, const std::string& prefix, const NameMap& renamed) {
+  const auto rename = [&prefix, &renamed](std::string& name) {
+    // an empty name is a missing optional input or output
+    if (!name.empty()) {
+      const auto it = renamed.find(name);
+      name = it != renamed.end() ? it->second : prefix + name;
+    }
+  };
+
+  graph.set_name(prefix + graph.name());
+  for (auto& input : *graph.mutable_input()) {
+    rename(*input.mutable_name());
+  }
+  for (auto& output : *graph.mutable_output()) {
+    rename(*output.mutable_name());
+  }
+  for (auto& value_info : *graph.mutable_value_info()) {
+    rename(*value_info.mutable_name());
+  }
+  for (auto& initializer : *graph.mutable_initializer()) {
+    rename(*initializer.mutable_name());
+  }
+  for (auto& sparse_initializer : *graph.mutable_sparse_initializer()) {
+    rename(*sparse_initializer.mutable_values()->mutable_name());
+  }
+  for (auto& node : *graph.mutable_node()) {
+    if (!node.name().empty()) {
+      node.set_name(prefix + node.name());
+    }
+    for (auto& input : *node.mutable_input()) {
+      rename(input);
+    }
+    for (auto& output : *node.mutable_output()) {
+      rename(output);
+    }
+    for (auto& attribute : *node.mutable_attribute()) {
+      if (attribute.has_g()) {
+        RenameGraph(*attribute.mutable_g(), prefix, renamed);
+      }
+      for (auto& subgraph : *attribute.mutable_graphs()) {
+        RenameGraph(subgraph, prefix, renamed);
+      }
+    }
+  }
+}
+
+bool HasExternalData(const ONNX_NAMESPACE::GraphProto& graph) {
+  for (const auto& initializer : graph.initializer()) {
+    if (utils::HasExternalData(initializer)) {
+      return true;
+    }
+  }
+  for (const auto& node : graph.node()) {
+    for (const auto& attribute : node.attribute()) {
+      if ((attribute.has_g() && HasExternalData(attribute.g())) ||
+          std::any_of(attribute.graphs().begin(), attribute.graphs().end(),
+                      [](const auto& subgraph) { return HasExternalData(subgraph); })) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+const ONNX_NAMESPACE::ValueInfoProto* FindValueInfo(
+    const google::protobuf::RepeatedPtrField<ONNX_NAMESPACE::ValueInfoProto>& values, const std::string& name) {
+  const auto it = std::find_if(values.begin(), values.end(),
+                               [&name](const auto& value) { return value.name() == name; });
+  return it != values.end() ? &*it : nullptr;
+}
+}  // namespace
+
+Status ComposeEnsemble(gsl::span<const EnsembleMember> members, gsl::span<const EnsembleEdge> edges,
+                       ONNX_NAMESPACE::ModelProto& model_proto, PathString& model_uri) {
+  ORT_RETURN_IF(members.empty(), "An ensemble needs at least one member");
+
+  std::unordered_map<std::string, size_t> member_indices;
+  std::vector<ONNX_NAMESPACE::ModelProto> member_protos(members.size());
+  for (size_t i = 0; i < members.size(); ++i) {
+    ORT_RETURN_IF(members[i].name.empty(), "The name of an ensemble member is empty");
+    ORT_RETURN_IF_NOT(member_indices.emplace(members[i].name, i).second, "Two ensemble members are named ",
+                      members[i].name);
+    ORT_RETURN_IF_ERROR(Model::Load(members[i].model_path, member_protos[i]));
+  }
+
+  // the inputs of each member fed by an edge, renamed to the output feeding them
+  std::vector<NameMap> fed_inputs(members.size());
+  std::unordered_set<std::string> edge_outputs;
+  for (const auto& edge : edges) {
+    const auto producer = member_indices.find(edge.producer);
+    const auto consumer = member_indices.find(edge.consumer);
+    ORT_RETURN_IF(producer == member_indices.end(), "The edge to ", edge.consumer, "/", edge.input,
+                  " is from an unknown member ", edge.producer);
+    ORT_RETURN_IF(consumer == member_indices.end(), "The edge from ", edge.producer, "/", edge.output,
+                  " is to an unknown member ", edge.consumer);
+
+    const auto* output = FindValueInfo(member_protos[producer->second].graph().output(), edge.output);
+    const auto* input = FindValueInfo(member_protos[consumer->second].graph().input(), edge.input);
+    ORT_RETURN_IF(output == nullptr, edge.output, " is not an output of ensemble member ", edge.producer);
+    ORT_RETURN_IF(input == nullptr, edge.input, " is not an input of ensemble member ", edge.consumer);
+    ORT_RETURN_IF(output->type().has_tensor_type() && input->type().has_tensor_type() &&
+                      output->type().tensor_type().elem_type() != input->type().tensor_type().elem_type(),
+                  "The edge from ", edge.producer, "/", edge.output, " to ", edge.consumer, "/", edge.input,
+                  " connects tensors of different element types");
+
+    const std::string output_name = edge.producer + "/" + edge.output;
+    ORT_RETURN_IF_NOT(fed_inputs[consumer->second].emplace(edge.input, output_name).second, "Input ",
+                      edge.consumer, "/", edge.input, " is fed by two edges");
+    edge_outputs.insert(output_name);
+  }
+
+  model_uri = members.front().model_path;
+  const PathString model_dir = Path::Parse(model_uri).ParentPath().ToPathString();
+
+  ONNX_NAMESPACE::ModelProto composed;
+  composed.set_producer_name("onnxruntime");
+  auto& composed_graph = *composed.mutable_graph();
+  composed_graph.set_name("ensemble");
+  std::map<std::string, int64_t> opset_versions;
+  std::unordered_map<std::string, const ONNX_NAMESPACE::FunctionProto*> functions;
+
+  for (size_t i = 0; i < members.size(); ++i) {
+    const auto& member = members[i];
+    auto& member_proto = member_protos[i];
+    ORT_RETURN_IF(HasExternalData(member_proto.graph()) &&
+                      Path::Parse(member.model_path).ParentPath().ToPathString() != model_dir,
+                  "Ensemble member ", member.name, " has external data and must be in the directory of the first "
+                  "member");
+
+    composed.set_ir_version(std::max(composed.ir_version(), member_proto.ir_version()));
+    for (const auto& opset : member_proto.opset_import()) {
+      const auto [it, inserted] = opset_versions.emplace(opset.domain(), opset.version());
+      ORT_RETURN_IF(!inserted && it->second != opset.version(), "Ensemble member ", member.name,
+                    " imports version ", opset.version(), " of opset '", opset.domain(), "' but another member ",
+                    "imports version ", it->second);
+    }
+    for (const auto& function : member_proto.functions()) {
+      const auto [it, inserted] = functions.emplace(function.domain() + ":" + function.name(), &function);
+      ORT_RETURN_IF(!inserted && it->second->SerializeAsString() != function.SerializeAsString(),
+                    "Ensemble members define different functions ", function.domain(), ":", function.name());
+      if (inserted) {
+        *composed.add_functions() = function;
+      }
+    }
+
+    auto& graph = *member_proto.mutable_graph();
+    const NameMap& renamed = fed_inputs[i];
+    // an input fed by an edge may be an initializer providing its default value, which the edge replaces
+    auto& initializers = *graph.mutable_initializer();
+    initializers.erase(std::remove_if(initializers.begin(), initializers.end(),
+                                      [&renamed](const auto& initializer) {
+                                        return renamed.count(initializer.name()) > 0;
+                                      }),
+                       initializers.end());
+    std::vector<bool> is_fed;
+    for (const auto& input : graph.input()) {
+      is_fed.push_back(renamed.count(input.name()) > 0);
+    }
+
+    RenameGraph(graph, member.name + "/", renamed);
+
+    for (int j = 0; j < graph.input_size(); ++j) {
+      if (!is_fed[j]) {
+        *composed_graph.add_input() = std::move(*graph.mutable_input(j));
+      }
+    }
+    // the outputs feeding edges are values inside the ensemble, their types are kept as value infos
+    for (auto& output : *graph.mutable_output()) {
+      *(edge_outputs.count(output.name()) > 0 ? composed_graph.add_value_info() : composed_graph.add_output()) =
+          std::move(output);
+    }
+    for (auto& node : *graph.mutable_node()) {
+      *composed_graph.add_node() = std::move(node);
+    }
+    for (auto& initializer : *graph.mutable_initializer()) {
+      *composed_graph.add_initializer() = std::move(initializer);
+    }
+    for (auto& sparse_initializer : *graph.mutable_sparse_initializer()) {
+      *composed_graph.add_sparse_initializer() = std::move(sparse_initializer);
+    }
+    for (auto& value_info : *graph.mutable_value_info()) {
+      *composed_graph.add_value_info() = std::move(value_info);
+    }
+  }
+
+  for (const auto& [domain, version] : opset_versions) {
+    auto& opset = *composed.add_opset_import();
+    opset.set_domain(domain);
+    opset.set_version(version);
+  }
+
+  model_proto = std::move(composed);
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -0,0 +1,50 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <string>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/common/path_string.h"
+#include "core/common/status.h"
+#include "core/graph/onnx_protobuf.h"
+
+namespace onnxruntime {
+
+struct EnsembleMember {
+  // the values of the member are named "<name>/<value>" in the ensemble
+  std::string name;
+  PathString model_path;
+};
+
+// The output of producer feeds the input of consumer.
+struct EnsembleEdge {
+  std::string producer;
+  std::string output;
+  std::string consumer;
+  std::string input;
+};
+
+/**
+ * Composes the models of an ensemble, e.g. preprocessing, several models and postprocessing, into one model linked
+ * by the edges, which an InferenceSession loads like any other. The ensemble is then optimized, partitioned and
+ * planned as a whole: its members share the arena and memory plan of the session, the values passing along edges
+ * are neither copied nor leave the device, and independent members run concurrently with ExecutionMode::ORT_PARALLEL.
+ *
+ * The inputs of the ensemble are the inputs of the members without an edge, the outputs are the outputs of the
+ * members that feed no edge, all named "<member>/<name>". The members must import the same version of each opset
+ * they share.
+ *
+ * @param model_uri the path that the external data of the composed model is relative to, the path of the first
+ *        member. The members with external data must be in its directory.
+ */
+Status ComposeEnsemble(gsl::span<const EnsembleMember> members, gsl::span<const EnsembleEdge> edges,
+                       ONNX_NAMESPACE::ModelProto& model_proto, PathString& model_uri);
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
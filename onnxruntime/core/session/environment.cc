@@ -3,7 +3,9 @@
 
 #include "core/session/environment.h"
 #include "core/session/allocator_adapters.h"
+#include "core/framework/activation_pool.h"
 #include "core/framework/allocator_utils.h"
+#include "core/framework/huge_page_allocator.h"
 #include "core/graph/constants.h"
 #include "core/graph/op.h"
 
@@ -137,6 +139,11 @@ Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, co
     int max_dead_bytes_per_chunk = -1;
     int initial_growth_chunk_size_bytes = -1;
     int64_t max_power_of_two_extend_bytes = -1L;
+    int slab_max_alloc_bytes = -1;
+    int64_t slab_region_bytes = -1L;
+    int slab_thread_cache_blocks = -1;
+    int64_t huge_page_bytes = -1L;
+    int numa_node = -1;
 
     // override with values from the user supplied arena_cfg object
     if (arena_cfg) {
@@ -154,12 +161,40 @@ Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, co
       max_dead_bytes_per_chunk = arena_cfg->max_dead_bytes_per_chunk;
       initial_growth_chunk_size_bytes = arena_cfg->initial_growth_chunk_size_bytes;
       max_power_of_two_extend_bytes = arena_cfg->max_power_of_two_extend_bytes;
+      slab_max_alloc_bytes = arena_cfg->slab_max_alloc_bytes;
+      slab_region_bytes = arena_cfg->slab_region_bytes;
+      slab_thread_cache_blocks = arena_cfg->slab_thread_cache_blocks;
+
+      huge_page_bytes = arena_cfg->huge_page_bytes;
+      if (!(huge_page_bytes == -1 || huge_page_bytes == 0 ||
+            huge_page_bytes == static_cast<int64_t>(HugePageCPUAllocator::kHugePage2MB) ||
+            huge_page_bytes == static_cast<int64_t>(HugePageCPUAllocator::kHugePage1GB))) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "Received invalid value for huge page bytes."
+                               " Valid values can be either 2MB, 1GB, 0 or -1.");
+      }
+
+      numa_node = arena_cfg->numa_node;
+      if (numa_node < -1 || (numa_node != -1 && huge_page_bytes <= 0)) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "Received invalid value for NUMA node. It must be -1, or a node id if huge pages are used.");
+      }
     }
 
     OrtArenaCfg l_arena_cfg{max_mem, arena_extend_strategy, initial_chunk_size_bytes, max_dead_bytes_per_chunk,
                             initial_growth_chunk_size_bytes, max_power_of_two_extend_bytes};
+    l_arena_cfg.slab_max_alloc_bytes = slab_max_alloc_bytes;
+    l_arena_cfg.slab_region_bytes = slab_region_bytes;
+    l_arena_cfg.slab_thread_cache_blocks = slab_thread_cache_blocks;
+    l_arena_cfg.huge_page_bytes = huge_page_bytes;
+    l_arena_cfg.numa_node = numa_node;
     AllocatorCreationInfo alloc_creation_info{
-        [mem_info](int) { return std::make_unique<CPUAllocator>(mem_info); },
+        [mem_info, huge_page_bytes, numa_node](int) -> std::unique_ptr<IAllocator> {
+          if (huge_page_bytes > 0) {
+            return std::make_unique<HugePageCPUAllocator>(mem_info, static_cast<size_t>(huge_page_bytes), numa_node);
+          }
+          return std::make_unique<CPUAllocator>(mem_info);
+        },
         0,
         create_arena,
         l_arena_cfg};
@@ -192,6 +227,35 @@ Status Environment::UnregisterAllocator(const OrtMemoryInfo& mem_info) {
   return Status::OK();
 }
 
+Status Environment::CreateAndRegisterActivationPool(const OrtMemoryInfo& mem_info, size_t max_bytes,
+                                                    int64_t admission_timeout_ms) {
+  if (mem_info.device.Type() != OrtDevice::CPU) {
+    return Status(ONNXRUNTIME, INVALID_ARGUMENT, "Only CPU activation pools are supported.");
+  }
+
+  if (max_bytes == 0 || admission_timeout_ms < 0) {
+    return Status(ONNXRUNTIME, INVALID_ARGUMENT,
+                  "The activation pool size must be positive and the admission timeout must not be negative.");
+  }
+
+  auto ite = std::find_if(std::begin(activation_pools_),
+                          std::end(activation_pools_),
+                          [&mem_info](const AllocatorPtr& pool) {
+                            return AreOrtMemoryInfosEquivalent(pool->Info(), mem_info, false);
+                          });
+
+  if (ite != activation_pools_.end()) {
+    return Status(ONNXRUNTIME, INVALID_ARGUMENT, "An activation pool for this device has already been registered.");
+  }
+
+  // blocks are large and long lived, so they come straight from the device allocator rather than an arena
+  auto block_allocator = std::make_shared<CPUAllocator>(mem_info);
+  activation_pools_.push_back(std::make_shared<ActivationPool>(std::move(block_allocator), max_bytes,
+                                                               std::chrono::milliseconds(admission_timeout_ms)));
+
+  return Status::OK();
+}
+
 Status Environment::Initialize(std::unique_ptr<logging::LoggingManager> logging_manager,
                                const OrtThreadingOptions* tp_options,
                                bool create_global_thread_pools) {
@@ -4,7 +4,13 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <iomanip>
 #include <memory>
+#include <numeric>
+#include <optional>
 #include <sstream>
 #include <list>
 #include <string>
@@ -12,9 +18,12 @@
 #include <queue>
 
 #include "core/common/denormal.h"
+#include "core/common/hash_combine.h"
 #include "core/common/logging/logging.h"
 #include "core/common/parse_string.h"
 #include "core/common/path_string.h"
+#include "core/common/startup_timings.h"
+#include "core/common/string_utils.h"
 #include "core/flatbuffers/flatbuffers_utils.h"
 #include "core/flatbuffers/ort_format_version.h"
 #include "core/framework/bfc_arena.h"
@@ -27,15 +36,20 @@
 #include "core/framework/kernel_type_str_resolver.h"
 #include "core/framework/kernel_type_str_resolver_utils.h"
 #include "core/framework/mldata_type_utils.h"
+#include "core/framework/murmurhash3.h"
 #include "core/framework/TensorSeq.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/framework/roofline.h"
+#include "core/framework/memory_timeline.h"
 #include "core/framework/tensor_type_and_shape.h"
+#include "core/framework/trace_span.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/transform_layout_functions.h"
 #include "core/framework/utils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/optimizer/graph_transformer_utils.h"
 #include "core/optimizer/graph_transformer.h"
 #include "core/optimizer/layout_transformation/layout_transformation.h"
@@ -47,6 +61,7 @@
 #include "core/optimizer/transpose_optimization/ort_optimizer_utils.h"
 #include "core/platform/Barrier.h"
 #include "core/platform/ort_mutex.h"
+#include "core/platform/path_lib.h"
 #include "core/platform/threadpool.h"
 #ifdef _WIN32
 #include "core/platform/tracing.h"
@@ -64,6 +79,7 @@
 #include "core/session/user_logging_sink.h"
 #include "core/session/IOBinding.h"
 #include "core/session/inference_session_utils.h"
+#include "core/session/prepared_run.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
 #include "core/util/protobuf_parsing_utils.h"
@@ -77,6 +93,7 @@
 #ifdef ENABLE_TRAINING
 #include "core/framework/partial_graph_execution_state.h"
 #include "core/framework/stream_execution_context.h"
+#include "orttraining/core/optimizer/memory_optimizer/activation_offload.h"
 #include "orttraining/core/optimizer/memory_optimizer/memory_optimizer.h"
 #endif
 
@@ -140,28 +157,28 @@ static bool HasMemcpyNodes(const Graph& graph) {
   return false;
 }
 
-static bool AreAllComputeNodesAssignedToCudaEp(const Graph& graph) {
-  bool nodes_on_cpu_and_cuda_eps_only = true;
+static bool AreAllComputeNodesAssignedToEp(const Graph& graph, ProviderType provider) {
+  bool nodes_on_cpu_and_target_eps_only = true;
 
   for (const auto& node : graph.Nodes()) {
     const auto& node_provider = node.GetExecutionProviderType();
 
     // Empty node provider means CPU EP
     if (!node_provider.empty() &&
-        node_provider != kCudaExecutionProvider &&
+        node_provider != provider &&
         node_provider != kCpuExecutionProvider) {
-      nodes_on_cpu_and_cuda_eps_only = false;
+      nodes_on_cpu_and_target_eps_only = false;
       break;
     }
   }
 
-  // If we see nodes assigned to EPs other than CPU or CUDA
+  // If we see nodes assigned to EPs other than CPU or the target EP (e.g. CUDA)
   // (or) if there are Memcpy nodes, then all compute nodes have
-  // not been parititoned to the CUDA EP.
+  // not been parititoned to the target EP.
   // We allow CPU EPs to show up in the EP list as long as thre is no Memcpy
   // involved as shape subgraphs will be forced onto CPU and these will not have
   // Memcpy nodes involved.
-  return nodes_on_cpu_and_cuda_eps_only && !HasMemcpyNodes(graph);
+  return nodes_on_cpu_and_target_eps_only && !HasMemcpyNodes(graph);
 }
 
 static bool AreAllNodesInMainGraphAssignedToOneEp(const Graph& graph, ProviderType provider) {
@@ -229,8 +246,83 @@ Status GetMinimalBuildOptimizationHandling(
                          "Invalid value for ", kOrtSessionOptionsConfigMinimalBuildOptimizations, ": ", config_value);
 };
 
+// hex string of the MurmurHash3 of the bytes
+std::string HashBytes(gsl::span<const uint8_t> bytes) {
+  uint32_t hash[4] = {0, 0, 0, 0};
+  // MurmurHash3 takes an int length
+  constexpr size_t kChunk = size_t{1} << 30;
+  do {
+    const auto chunk = bytes.first(std::min(bytes.size(), kChunk));
+    MurmurHash3::x86_128(chunk.data(), static_cast<int>(chunk.size()), hash[0], &hash);
+    bytes = bytes.subspan(chunk.size());
+  } while (!bytes.empty());
+
+  std::ostringstream ss;
+  ss << std::hex << std::setfill('0');
+  for (uint32_t h : hash) {
+    ss << std::setw(8) << h;
+  }
+  return ss.str();
+}
+
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+// Reads the intra op priority and maximum degree of parallelism from config_options.
+// Settings that are not present keep the value passed in.
+Status ParseIntraOpSchedulingConfig(const ConfigOptions& config_options,
+                                    const char* priority_key, const char* max_degree_of_parallelism_key,
+                                    concurrency::ThreadPool::Priority& priority, int& max_degree_of_parallelism) {
+  const auto priority_str = config_options.GetConfigEntry(priority_key);
+  if (priority_str.has_value()) {
+    if (*priority_str == "normal") {
+      priority = concurrency::ThreadPool::Priority::kNormal;
+    } else if (*priority_str == "high") {
+      priority = concurrency::ThreadPool::Priority::kHigh;
+    } else {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ", priority_key, ": ",
+                             *priority_str, ". Expected 'normal' or 'high'.");
+    }
+  }
+
+  const auto max_dop_str = config_options.GetConfigEntry(max_degree_of_parallelism_key);
+  if (max_dop_str.has_value()) {
+    int value = 0;
+    if (!TryParseStringWithClassicLocale(*max_dop_str, value) || value < 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ", max_degree_of_parallelism_key,
+                             ": ", *max_dop_str, ". Expected a non-negative integer.");
+    }
+    max_degree_of_parallelism = value;
+  }
+
+  return Status::OK();
+}
+
+// Selects the captured graph of a run: the graph id in the run options if there is one, otherwise a signature of
+// the shapes of the feeds, so that runs with different input shapes capture and replay different graphs.
+Status GetGraphCaptureKey(const RunOptions& run_options, gsl::span<const OrtValue> feeds, int64_t& graph_key) {
+  const auto graph_id_str = run_options.config_options.GetConfigEntry(kOrtRunOptionsConfigCudaGraphId);
+  if (graph_id_str.has_value()) {
+    if (!TryParseStringWithClassicLocale(*graph_id_str, graph_key) || graph_key < -1) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ", kOrtRunOptionsConfigCudaGraphId,
+                             ": ", *graph_id_str, ". Expected -1 or a non-negative integer.");
+    }
+    return Status::OK();
+  }
+
+  size_t signature = feeds.size();
+  for (const auto& feed : feeds) {
+    if (feed.IsTensor()) {
+      const auto dims = feed.Get<Tensor>().Shape().GetDims();
+      HashCombine(dims.size(), signature);
+      for (const int64_t dim : dims) {
+        HashCombine(dim, signature);
+      }
+    }
+  }
+  graph_key = static_cast<int64_t>(signature & static_cast<size_t>(std::numeric_limits<int64_t>::max()));
+  return Status::OK();
+}
+
 }  // namespace
 
 std::atomic<uint32_t> InferenceSession::global_session_id_{1};
@@ -370,6 +462,10 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
 
   use_per_session_threads_ = session_options.use_per_session_threads;
   force_spinning_stop_between_runs_ = session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigForceSpinningStop, "0") == "1";
+  ORT_THROW_IF_ERROR(ParseIntraOpSchedulingConfig(session_options_.config_options,
+                                                  kOrtSessionOptionsConfigIntraOpPriority,
+                                                  kOrtSessionOptionsConfigIntraOpMaxDegreeOfParallelism,
+                                                  intra_op_priority_, intra_op_max_degree_of_parallelism_));
 
   if (use_per_session_threads_) {
     LOGS(*session_logger_, INFO) << "Creating and using per session threadpools since use_per_session_threads_ is true";
@@ -391,6 +487,18 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         to.allow_spinning = allow_intra_op_spinning;
         to.dynamic_block_base_ = std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBlockBase, "0"));
         LOGS(*session_logger_, INFO) << "Dynamic block base set to " << to.dynamic_block_base_;
+        to.work_stealing_loops_ =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigWorkStealingLoops, "0") == "1";
+        to.adaptive_spinning_ =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpAdaptiveSpinning,
+                                                               "0") == "1";
+        to.prefer_performance_cores =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpPreferPerformanceCores,
+                                                               "1") == "1";
+        const std::string cache_domain =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpCacheDomain, "-1");
+        // session ids are consecutive, so they spread the sessions over the domains
+        to.cache_domain = cache_domain == "auto" ? static_cast<int>(session_id_ % INT32_MAX) : std::stoi(cache_domain);
 
         // Set custom threading functions
         to.custom_create_thread_fn = session_options_.custom_create_thread_fn;
@@ -596,6 +704,10 @@ InferenceSession::~InferenceSession() {
     }
   }
 
+#if !defined(ORT_MINIMAL_BUILD)
+  SaveTuningResultsCache();
+#endif
+
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
   if (session_activity_started_)
     TraceLoggingWriteStop(session_activity, "OrtInferenceSessionActivity");
@@ -793,10 +905,26 @@ common::Status InferenceSession::SaveToOrtFormat(const PathString& filepath) con
   ORT_RETURN_IF_ERROR(
       kernel_type_str_resolver.SaveToOrtFormat(builder, fbs_kernel_type_str_resolver));
 
+  const bool save_snapshot =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsSaveSessionSnapshot, "0") == "1";
+
+  flatbuffers::Offset<fbs::StaticMemoryPlan> fbs_static_memory_plan;
+  if (save_snapshot ||
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsSaveStaticMemoryPlan, "0") == "1") {
+    ORT_RETURN_IF_ERROR(session_state_->SaveStaticMemoryPlanToOrtFormat(builder, fbs_static_memory_plan));
+  }
+
+  flatbuffers::Offset<flatbuffers::String> fbs_prepacked_weights_file;
+  if (save_snapshot) {
+    fbs_prepacked_weights_file = builder.CreateString(ToUTF8String(GetLastComponent(filepath)) + ".prepacked");
+  }
+
   fbs::InferenceSessionBuilder sb(builder);
   sb.add_ort_version(ort_model_version);
   sb.add_model(fbs_model);
   sb.add_kernel_type_str_resolver(fbs_kernel_type_str_resolver);
+  sb.add_static_memory_plan(fbs_static_memory_plan);
+  sb.add_prepacked_weights_file(fbs_prepacked_weights_file);
   auto session = sb.Finish();
   builder.Finish(session, fbs::InferenceSessionIdentifier());
 
@@ -811,6 +939,298 @@ common::Status InferenceSession::SaveToOrtFormat(const PathString& filepath) con
   return Status::OK();
 }
 
+Status InferenceSession::GetShapeSpecialization(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                                InferenceSession*& session) {
+  session = nullptr;
+  if (!shape_specializations_) {
+    return Status::OK();
+  }
+
+  // the key is the shapes of the feeds in the order of their names
+  InlinedVector<size_t> feed_order(feed_names.size());
+  std::iota(feed_order.begin(), feed_order.end(), size_t{0});
+  std::sort(feed_order.begin(), feed_order.end(), [&feed_names](size_t a, size_t b) {
+    return feed_names[a] < feed_names[b];
+  });
+
+  std::ostringstream key;
+  for (size_t i : feed_order) {
+    if (!feeds[i].IsTensor()) {
+      return Status::OK();
+    }
+    key << feed_names[i] << feeds[i].Get<Tensor>().Shape() << ";";
+  }
+
+  auto& specializations = *shape_specializations_;
+  std::lock_guard<OrtMutex> lock(specializations.mutex);
+  const auto specialization = specializations.sessions.find(key.str());
+  if (specialization != specializations.sessions.end()) {
+    session = specialization->second.get();
+    return Status::OK();
+  }
+
+  if (specializations.sessions.size() >= specializations.max_count) {
+    return Status::OK();
+  }
+
+  // limit the number of shapes that are counted if they keep changing
+  constexpr size_t kMaxCountedShapes = 64;
+  if (specializations.run_counts.size() >= kMaxCountedShapes && specializations.run_counts.count(key.str()) == 0) {
+    specializations.run_counts.clear();
+  }
+  if (++specializations.run_counts[key.str()] < specializations.min_runs) {
+    return Status::OK();
+  }
+  specializations.run_counts.erase(key.str());
+
+  // runs with these shapes wait for the specialization to be created and the other runs for the lookup above.
+  std::unique_ptr<InferenceSession> specialized_session;
+  const auto status = CreateShapeSpecialization(feed_names, feeds, specialized_session);
+  if (status.IsOK()) {
+    LOGS(*session_logger_, INFO) << "Created the version of the model specialized for the input shapes " << key.str();
+  } else {
+    // the shapes are not tried again
+    LOGS(*session_logger_, WARNING) << "Could not specialize the model for the input shapes " << key.str() << ": "
+                                    << status.ErrorMessage();
+    specialized_session.reset();
+  }
+
+  session = specialized_session.get();
+  specializations.sessions.emplace(key.str(), std::move(specialized_session));
+  return Status::OK();
+}
+
+Status InferenceSession::CreateShapeSpecialization(gsl::span<const std::string> feed_names,
+                                                   gsl::span<const OrtValue> feeds,
+                                                   std::unique_ptr<InferenceSession>& session) const {
+  ONNX_NAMESPACE::ModelProto model_proto = shape_specializations_->model_proto;
+  auto& graph_proto = *model_proto.mutable_graph();
+
+  // the shapes of the other values are inferred from the shapes of the inputs
+  graph_proto.clear_value_info();
+  for (auto& input : *graph_proto.mutable_input()) {
+    const auto feed = std::find(feed_names.begin(), feed_names.end(), input.name());
+    if (feed == feed_names.end() || !input.type().has_tensor_type()) {
+      continue;
+    }
+
+    const auto& shape = feeds[feed - feed_names.begin()].Get<Tensor>().Shape();
+    auto& shape_proto = *input.mutable_type()->mutable_tensor_type()->mutable_shape();
+    shape_proto.clear_dim();
+    for (const auto dim : shape.GetDims()) {
+      shape_proto.add_dim()->set_dim_value(dim);
+    }
+  }
+
+  SessionOptions session_options = session_options_;
+  session_options.optimized_model_filepath.clear();
+  session_options.enable_profiling = false;
+  session_options.config_options.configurations[kOrtSessionOptionsShapeSpecializationMaxCount] = "0";
+
+  // the specializations run on the thread pools of this session
+  session = std::make_unique<InferenceSession>(session_options, environment_, GetIntraOpThreadPoolToUse(),
+                                               GetInterOpThreadPoolToUse());
+  session->model_location_ = model_location_;
+  session->model_proto_ = std::move(model_proto);
+  session->is_model_proto_parsed_ = true;
+  ORT_RETURN_IF_ERROR(session->Load());
+  return session->Initialize();
+}
+
+PathString InferenceSession::GetOptimizationCacheFilePath() const {
+  const std::string cache_dir =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsOptimizationCacheDir, "");
+  // the model is saved explicitly, or the graph is changed by initializers provided at runtime
+  if (cache_dir.empty() || onnx_model_hash_.empty() || !session_options_.optimized_model_filepath.empty() ||
+      !session_options_.initializers_to_share_map.empty() || !session_options_.external_initializers.empty()) {
+    return {};
+  }
+
+  // saving an ORT format model only assigns the nodes EPs would compile, so the session would not compile them
+  static const std::array<std::string_view, 3> kEpsWithStaticKernels = {
+      kCpuExecutionProvider, kCudaExecutionProvider, kRocmExecutionProvider};
+  for (const auto& ep : execution_providers_) {
+    if (std::find(kEpsWithStaticKernels.begin(), kEpsWithStaticKernels.end(), ep->Type()) ==
+        kEpsWithStaticKernels.end()) {
+      LOGS(*session_logger_, INFO) << "Not using the optimization cache as " << ep->Type() << " compiles nodes";
+      return {};
+    }
+  }
+
+  // the data of external initializers is not part of the hash of the model
+  for (const auto& [name, tensor_proto] : model_->MainGraph().GetAllInitializedTensors()) {
+    if (utils::HasExternalData(*tensor_proto)) {
+      LOGS(*session_logger_, INFO) << "Not using the optimization cache as initializer " << name
+                                   << " has external data";
+      return {};
+    }
+  }
+
+  // the key covers everything the transformers and the partitioning depend on. the NCHWc block size is the
+  // hardware specific part of the level 3 optimizations.
+  std::ostringstream key;
+  key << onnx_model_hash_ << ";" << ORT_VERSION << ";" << static_cast<int>(session_options_.graph_optimization_level)
+      << ";" << MlasNchwcGetBlockSize() << ";";
+
+  std::vector<std::string> optimizers_to_disable(optimizers_to_disable_.begin(), optimizers_to_disable_.end());
+  std::sort(optimizers_to_disable.begin(), optimizers_to_disable.end());
+  for (const auto& optimizer : optimizers_to_disable) {
+    key << optimizer << ",";
+  }
+  key << ";";
+
+  for (const auto& free_dimension_override : session_options_.free_dimension_overrides) {
+    key << free_dimension_override.dim_identifier << ":"
+        << static_cast<int>(free_dimension_override.dim_identifer_type) << ":" << free_dimension_override.dim_value
+        << ",";
+  }
+  key << ";";
+
+  std::vector<std::pair<std::string, std::string>> config_entries(
+      session_options_.config_options.configurations.begin(), session_options_.config_options.configurations.end());
+  std::sort(config_entries.begin(), config_entries.end());
+  for (const auto& [config_key, config_value] : config_entries) {
+    if (config_key != kOrtSessionOptionsOptimizationCacheDir) {
+      key << config_key << "=" << config_value << ",";
+    }
+  }
+  key << ";";
+
+  for (const auto& ep : execution_providers_) {
+    const auto provider_options = ep->GetProviderOptions();
+    std::vector<std::pair<std::string, std::string>> options(provider_options.begin(), provider_options.end());
+    std::sort(options.begin(), options.end());
+    key << ep->Type() << "{";
+    for (const auto& [option_key, option_value] : options) {
+      // the optimized graph doesn't depend on which device of the EP the session runs on, so the sessions of the
+      // replicas of a model on several devices share the cached model
+      if (option_key != "device_id") {
+        key << option_key << "=" << option_value << ",";
+      }
+    }
+    key << "}";
+  }
+
+  const std::string key_str = key.str();
+  const auto file_name =
+      HashBytes(gsl::make_span(reinterpret_cast<const uint8_t*>(key_str.data()), key_str.size())) + ".ort";
+  return ConcatPathComponent(ToPathString(cache_dir), ToPathString(file_name));
+}
+
+void InferenceSession::SaveOptimizationCache(const PathString& cache_file) const {
+  if (session_state_->GetFuncMgr().NumFuncs() > 0) {
+    LOGS(*session_logger_, INFO) << "Not saving the model to the optimization cache as it contains compiled nodes";
+    return;
+  }
+
+  // the cache is an optimization, so failing to write it is not an error.
+  // the model is written to a temporary file first so other processes never load a partially written file.
+  const std::filesystem::path path(cache_file);
+  const std::filesystem::path tmp_path(cache_file + ToPathString(".tmp" + std::to_string(Env::Default().GetSelfPid())));
+  std::error_code ec;
+  std::filesystem::create_directories(path.parent_path(), ec);
+  auto status = SaveToOrtFormat(tmp_path.native());
+  if (status.IsOK()) {
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to replace the file: ", ec.message());
+    }
+  }
+  if (!status.IsOK()) {
+    std::filesystem::remove(tmp_path, ec);
+    LOGS(*session_logger_, WARNING) << "Failed to save the model to the optimization cache file "
+                                    << ToUTF8String(cache_file) << ": " << status.ErrorMessage();
+  }
+}
+
+void InferenceSession::LoadTuningResultsCache() {
+  const std::string cache_dir =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsTuningResultsCacheDir, "");
+  if (cache_dir.empty()) {
+    return;
+  }
+
+  for (const auto& ep : execution_providers_) {
+    const auto* tuning_ctx = ep->GetTuningContext();
+    if (tuning_ctx == nullptr) {
+      continue;
+    }
+
+    // the validators identify the ORT build, the libraries and the device the results are valid for, so processes
+    // on different devices or with different versions sharing the directory use separate files.
+    std::vector<std::pair<std::string, std::string>> validators;
+    ORT_TRY {
+      const auto all_validators = tuning_ctx->GetTuningResultsValidator().GetAllValidators();
+      validators.assign(all_validators.begin(), all_validators.end());
+    }
+    ORT_CATCH(const std::exception& e) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        LOGS(*session_logger_, WARNING) << "Not using the tuning results cache for " << ep->Type() << ": "
+                                        << e.what();
+      });
+      continue;
+    }
+    std::sort(validators.begin(), validators.end());
+
+    std::ostringstream key;
+    key << ep->Type() << ";";
+    for (const auto& [validator_key, validator_value] : validators) {
+      key << validator_key << "=" << validator_value << ";";
+    }
+
+    const std::string key_str = key.str();
+    const auto file_name =
+        ep->Type() + "_" +
+        HashBytes(gsl::make_span(reinterpret_cast<const uint8_t*>(key_str.data()), key_str.size())) + ".json";
+    auto cache_file = ConcatPathComponent(ToPathString(cache_dir), ToPathString(file_name));
+
+    if (std::error_code ec; std::filesystem::exists(std::filesystem::path(cache_file), ec)) {
+      TuningResults tuning_results;
+      auto status = inference_session_utils::LoadTuningResultsFromFile(cache_file, tuning_results);
+      if (status.IsOK()) {
+        status = SetTuningResults({tuning_results}, /*error_on_invalid*/ true, /*auto_enable*/ true);
+      }
+      if (status.IsOK()) {
+        LOGS(*session_logger_, INFO) << "Loaded the tuning results of " << ep->Type() << " from "
+                                     << ToUTF8String(cache_file);
+      } else {
+        LOGS(*session_logger_, WARNING) << "Ignoring tuning results cache file " << ToUTF8String(cache_file) << ": "
+                                        << status.ErrorMessage();
+      }
+    }
+
+    tuning_results_cache_files_.emplace_back(ep->Type(), std::move(cache_file));
+  }
+}
+
+void InferenceSession::SaveTuningResultsCache() const {
+  // only tuning adds results, so the files of sessions which didn't tune are already up to date.
+  for (const auto& [ep_type, cache_file] : tuning_results_cache_files_) {
+    const auto* ep = execution_providers_.Get(ep_type);
+    const auto* tuning_ctx = ep != nullptr ? ep->GetTuningContext() : nullptr;
+    if (tuning_ctx == nullptr || !tuning_ctx->IsTuningEnabled()) {
+      continue;
+    }
+
+    Status status;
+    ORT_TRY {
+      const auto tuning_results = tuning_ctx->GetTuningResults();
+      if (!tuning_results.results.empty()) {
+        status = inference_session_utils::SaveTuningResultsToFile(cache_file, tuning_results);
+      }
+    }
+    ORT_CATCH(const std::exception& e) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, e.what());
+      });
+    }
+    if (!status.IsOK()) {
+      LOGS(*session_logger_, WARNING) << "Failed to save the tuning results of " << ep_type << " to "
+                                      << ToUTF8String(cache_file) << ": " << status.ErrorMessage();
+    }
+  }
+}
+
 common::Status InferenceSession::LoadWithLoader(std::function<common::Status(std::shared_ptr<Model>&)> loader,
                                                 const std::string& event_name) {
   Status status = Status::OK();
@@ -818,6 +1238,8 @@ common::Status InferenceSession::LoadWithLoader(std::function<common::Status(std
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Start();
   }
+  StartupTimingsScope startup_timings_scope(&startup_timings_);
+  StartupPhase load_phase("load");
   ORT_TRY {
     std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
     if (is_model_loaded_) {  // already loaded
@@ -869,6 +1291,26 @@ common::Status InferenceSession::LoadOnnxModel(const PathString& model_uri) {
 #endif
     const bool strict_shape_type_inference = session_options_.config_options.GetConfigOrDefault(
                                                  kOrtSessionOptionsConfigStrictShapeTypeInference, "0") == "1";
+
+    // an optimized ONNX model would be saved with the addresses of the initializers in the mapping
+    const bool use_onnx_model_file_for_initializers =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseOnnxModelFileForInitializers,
+                                                           "0") == "1" &&
+        session_options_.optimized_model_filepath.empty();
+    if (use_onnx_model_file_for_initializers) {
+      size_t model_length = 0;
+      ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(model_location_.c_str(), model_length));
+      ORT_RETURN_IF_ERROR(Env::Default().MapFileIntoMemory(model_location_.c_str(), 0, model_length,
+                                                           onnx_model_file_mapping_));
+      ModelProto model_proto;
+      ORT_RETURN_IF_ERROR(onnxruntime::Model::LoadReferencingInitializerData(
+          gsl::make_span(reinterpret_cast<const uint8_t*>(onnx_model_file_mapping_.get()), model_length),
+          model_proto));
+      return onnxruntime::Model::Load(std::move(model_proto), model_location_, model,
+                                      HasLocalSchema() ? &custom_schema_registries_ : nullptr, *session_logger_,
+                                      ModelOptions(true, strict_shape_type_inference));
+    }
+
     return onnxruntime::Model::Load(model_location_, model, HasLocalSchema() ? &custom_schema_registries_ : nullptr,
                                     *session_logger_,
                                     ModelOptions(true, strict_shape_type_inference));
@@ -908,6 +1350,15 @@ common::Status InferenceSession::Load(const PathString& model_uri) {
                            "Invoke Load().");
   }
 
+  // a model that can't be read is reported by LoadOnnxModel
+  size_t model_length = 0;
+  Env::MappedMemoryPtr model_bytes;
+  if (!session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsOptimizationCacheDir, "").empty() &&
+      Env::Default().GetFileLength(model_uri.c_str(), model_length).IsOK() && model_length > 0 &&
+      Env::Default().MapFileIntoMemory(model_uri.c_str(), 0, model_length, model_bytes).IsOK()) {
+    onnx_model_hash_ = HashBytes(gsl::make_span(reinterpret_cast<const uint8_t*>(model_bytes.get()), model_length));
+  }
+
   return LoadOnnxModel(model_uri);
 #else
   return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "ONNX format model is not supported in this build.");
@@ -937,10 +1388,20 @@ common::Status InferenceSession::Load(const void* model_data, int model_data_len
                            "Invoke Load().");
   }
 
+  if (!session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsOptimizationCacheDir, "").empty() &&
+      model_data_len > 0) {
+    onnx_model_hash_ = HashBytes(gsl::make_span(static_cast<const uint8_t*>(model_data),
+                                                static_cast<size_t>(model_data_len)));
+  }
+
   auto loader = [this, model_data, model_data_len](std::shared_ptr<onnxruntime::Model>& model) {
     ModelProto model_proto;
 
-    const bool result = model_proto.ParseFromArray(model_data, model_data_len);
+    bool result;
+    {
+      StartupPhase phase("model_parse");
+      result = model_proto.ParseFromArray(model_data, model_data_len);
+    }
     if (!result) {
       return Status(common::ONNXRUNTIME, common::INVALID_PROTOBUF,
                     "Failed to load model because protobuf parsing failed.");
@@ -998,6 +1459,26 @@ common::Status InferenceSession::LoadOnnxModel(std::unique_ptr<ModelProto> p_mod
   return LoadOnnxModel(std::move(*p_model_proto));
 }
 
+common::Status InferenceSession::Load(ModelProto model_proto, const PathString& model_uri) {
+  if (is_model_proto_parsed_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                           "ModelProto corresponding to the model to be loaded has already been parsed. "
+                           "Invoke Load().");
+  }
+
+  model_location_ = model_uri;
+  auto loader = [this, &model_proto](std::shared_ptr<onnxruntime::Model>& model) {
+    const bool strict_shape_type_inference = session_options_.config_options.GetConfigOrDefault(
+                                                 kOrtSessionOptionsConfigStrictShapeTypeInference, "0") == "1";
+    // This call will move model_proto to the constructed model instance
+    return onnxruntime::Model::Load(std::move(model_proto), model_location_, model,
+                                    HasLocalSchema() ? &custom_schema_registries_ : nullptr, *session_logger_,
+                                    ModelOptions(true, strict_shape_type_inference));
+  };
+
+  return LoadWithLoader(loader, "model_loading_proto");
+}
+
 common::Status InferenceSession::Load(std::istream& model_istream, bool allow_released_opsets_only) {
   if (is_model_proto_parsed_) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
@@ -1072,7 +1553,9 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph, bool
   // 7. insert copy nodes (required transformer).
 
   // Run Ahead Of time function inlining
-  GraphPartitioner partitioner(kernel_registry_manager_, execution_providers_);
+  const bool cost_based_cpu_fallback =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsCostBasedCpuFallback, "0") == "1";
+  GraphPartitioner partitioner(kernel_registry_manager_, execution_providers_, cost_based_cpu_fallback);
   if (const bool disable_aot_function_inlining =
           session_options_.config_options.GetConfigOrDefault(
               kOrtSessionOptionsDisableAheadOfTimeFunctionInlining, "0") == "1";
@@ -1165,8 +1648,11 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph, bool
   }
 
   // Do partitioning based on execution providers' capabilities.
-  ORT_RETURN_IF_ERROR_SESSIONID_(partitioner.Partition(graph, session_state_->GetMutableFuncMgr(), transform_layout_fn,
-                                                       mode, debug_graph_fn));
+  {
+    StartupPhase phase("partitioning");
+    ORT_RETURN_IF_ERROR_SESSIONID_(partitioner.Partition(graph, session_state_->GetMutableFuncMgr(),
+                                                         transform_layout_fn, mode, debug_graph_fn));
+  }
 
   // apply Level2 and higher transformers.
   // we do not run Level 1 again as those transformers assume partitioning will run later to do node assignment.
@@ -1206,9 +1692,19 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph, bool
         session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryOptimizerEnabler, "");
     const std::string probe_config =
         session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryOptimizerProbeConfig, "0:0");
+    const std::string memory_budget_config =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryOptimizerBudget, "");
 
-    MemoryOptimizer mem_transformer{memory_optimizer_config, probe_config};
+    MemoryOptimizer mem_transformer{memory_optimizer_config, probe_config, memory_budget_config};
     ORT_RETURN_IF_ERROR_SESSIONID_(apply_transformer_once(mem_transformer, *session_logger_, graph));
+
+    // Offload the stashed activations that are not recomputed.
+    const std::string activation_offload_config =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsActivationOffloadConfig, "");
+    if (!activation_offload_config.empty()) {
+      ActivationOffload offload_transformer{activation_offload_config};
+      ORT_RETURN_IF_ERROR_SESSIONID_(apply_transformer_once(offload_transformer, *session_logger_, graph));
+    }
   }
 #endif
 
@@ -1272,6 +1768,9 @@ Status InferenceSession::LoadOrtModel(const void* model_data, int model_data_len
 Status InferenceSession::LoadOrtModelWithLoader(std::function<Status()> load_ort_format_model_bytes) {
   static_assert(FLATBUFFERS_LITTLEENDIAN, "ORT format only supports little-endian machines");
 
+  StartupTimingsScope startup_timings_scope(&startup_timings_);
+  StartupPhase load_phase("load");
+
   std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
 
   if (is_model_loaded_) {  // already loaded
@@ -1370,6 +1869,18 @@ Status InferenceSession::LoadOrtModelWithLoader(std::function<Status()> load_ort
   ORT_RETURN_IF_ERROR(SaveModelMetadata(*tmp_model));
   model_ = std::move(tmp_model);
 
+  // a session snapshot names the pre-packed weights file next to it. a file set in the session options takes precedence.
+  if (const auto* fbs_prepacked_weights_file = fbs_session->prepacked_weights_file();
+      fbs_prepacked_weights_file != nullptr && !model_location_.empty() &&
+      !config_options.GetConfigEntry(kOrtSessionOptionsConfigPrepackedWeightsFile).has_value()) {
+    std::basic_string<ORTCHAR_T> model_dir;
+    ORT_RETURN_IF_ERROR(GetDirNameFromFilePath(model_location_, model_dir));
+    const auto prepacked_weights_file_path =
+        ConcatPathComponent(model_dir, ToPathString(fbs_prepacked_weights_file->str()));
+    ORT_RETURN_IF_ERROR(session_options_.config_options.AddConfigEntry(
+        kOrtSessionOptionsConfigPrepackedWeightsFile, ToUTF8String(prepacked_weights_file_path).c_str()));
+  }
+
   KernelTypeStrResolver kernel_type_str_resolver{};
   if (const auto* fbs_kernel_type_str_resolver = fbs_session->kernel_type_str_resolver();
       fbs_kernel_type_str_resolver != nullptr) {
@@ -1529,6 +2040,9 @@ common::Status InferenceSession::Initialize() {
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Start();
   }
+  StartupTimingsScope startup_timings_scope(&startup_timings_);
+  std::optional<StartupPhase> initialize_phase;
+  initialize_phase.emplace("initialize");
 
   ORT_TRY {
     LOGS(*session_logger_, INFO) << "Initializing session.";
@@ -1553,6 +2067,40 @@ common::Status InferenceSession::Initialize() {
       have_cpu_ep = execution_providers_.Get(onnxruntime::kCpuExecutionProvider) != nullptr;
     }
 
+#if !defined(ORT_MINIMAL_BUILD)
+    // an ORT format model saved to the optimization cache by an earlier session replaces the ONNX model.
+    // it is already optimized and partitioned, so it is initialized like any other ORT format model.
+    PathString optimization_cache_file;
+    if (ort_format_model_bytes_.empty()) {
+      optimization_cache_file = GetOptimizationCacheFilePath();
+    }
+    if (std::error_code ec; !optimization_cache_file.empty() &&
+                            std::filesystem::exists(std::filesystem::path(optimization_cache_file), ec)) {
+      auto onnx_model = model_;
+      const auto onnx_model_location = model_location_;
+      is_model_loaded_ = false;
+      const auto load_status = LoadOrtModel(optimization_cache_file);
+      if (load_status.IsOK()) {
+        LOGS(*session_logger_, INFO) << "Loaded the optimized model from " << ToUTF8String(optimization_cache_file);
+        optimization_cache_file.clear();
+      } else {
+        // the file is replaced with the model optimized by this session
+        LOGS(*session_logger_, WARNING) << "Ignoring optimization cache file " << ToUTF8String(optimization_cache_file)
+                                        << ": " << load_status.ErrorMessage();
+        model_ = std::move(onnx_model);
+        model_location_ = onnx_model_location;
+        ort_format_model_bytes_ = gsl::span<const uint8_t>();
+        std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+        using_ort_model_bytes_for_initializers_ = false;
+        ORT_RETURN_IF_ERROR_SESSIONID_(SaveModelMetadata(*model_));
+        is_model_loaded_ = true;
+      }
+    }
+    const bool saving_optimization_cache = !optimization_cache_file.empty();
+#else
+    constexpr bool saving_optimization_cache = false;
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
     // Verify that there are no external initializers in the graph if external data is disabled.
     onnxruntime::Graph& graph = model_->MainGraph();
 #ifdef DISABLE_EXTERNAL_INITIALIZERS
@@ -1578,6 +2126,36 @@ common::Status InferenceSession::Initialize() {
     // re-acquire mutex
     std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
 
+#if !defined(ORT_MINIMAL_BUILD)
+    // keep the model before it is transformed to create the versions of it specialized for the input shapes from
+    const auto shape_specialization_max_count_str = session_options_.config_options.GetConfigOrDefault(
+        kOrtSessionOptionsShapeSpecializationMaxCount, "0");
+    const auto shape_specialization_min_runs_str = session_options_.config_options.GetConfigOrDefault(
+        kOrtSessionOptionsShapeSpecializationMinRuns, "3");
+    size_t shape_specialization_max_count = 0;
+    size_t shape_specialization_min_runs = 0;
+    if (!TryParseStringWithClassicLocale(shape_specialization_max_count_str, shape_specialization_max_count) ||
+        !TryParseStringWithClassicLocale(shape_specialization_min_runs_str, shape_specialization_min_runs)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ",
+                             kOrtSessionOptionsShapeSpecializationMaxCount, " or ",
+                             kOrtSessionOptionsShapeSpecializationMinRuns, ": ", shape_specialization_max_count_str,
+                             ", ", shape_specialization_min_runs_str, ". Expected non-negative integers.");
+    }
+    if (shape_specialization_max_count > 0) {
+      if (!ort_format_model_bytes_.empty() || HasLocalSchema() || execution_providers_.NumProviders() != 1 ||
+          !session_options_.external_initializers.empty()) {
+        LOGS(*session_logger_, WARNING) << "Not specializing the model for input shapes. It is only supported for "
+                                        << "ONNX format models without custom ops or external initializers provided "
+                                        << "by the session options, using the CPU execution provider only.";
+      } else {
+        shape_specializations_ = std::make_unique<ShapeSpecializations>();
+        shape_specializations_->max_count = shape_specialization_max_count;
+        shape_specializations_->min_runs = shape_specialization_min_runs;
+        shape_specializations_->model_proto = model_->ToProto();
+      }
+    }
+#endif
+
 #if !defined(DISABLE_EXTERNAL_INITIALIZERS) && !defined(ORT_MINIMAL_BUILD)
     if (!session_options_.external_initializers.empty()) {
       ORT_RETURN_IF_ERROR_SESSIONID_(graph.InjectExternalInitializedTensors(session_options_.external_initializers));
@@ -1609,6 +2187,13 @@ common::Status InferenceSession::Initialize() {
       session_state_->UpdateAllocatorsWithEnvAllocators(environment_.GetRegisteredSharedAllocators());
     }
 
+    bool use_env_activation_pool =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseEnvActivationPool, "0") == "1";
+    if (use_env_activation_pool) {
+      LOGS(*session_logger_, INFO) << "This session will use the activation pools registered with the environment.";
+      session_state_->SetActivationPools(environment_.GetRegisteredActivationPools());
+    }
+
     for (auto& ep : execution_providers_) {
       auto tuning_ctx = ep->GetTuningContext();
       if (nullptr != tuning_ctx) {
@@ -1634,6 +2219,9 @@ common::Status InferenceSession::Initialize() {
     const bool loading_ort_format = !ort_format_model_bytes_.empty();
     const bool saving_model = !session_options_.optimized_model_filepath.empty();
     const bool saving_ort_format = [&]() {
+      if (saving_optimization_cache) {
+        return true;
+      }
       if (saving_model) {
         const std::string model_type = session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSaveModelFormat, "");
         const bool has_explicit_type = !model_type.empty();
@@ -1724,12 +2312,32 @@ common::Status InferenceSession::Initialize() {
       // The TRT EP is configured to do a graph capture AND
       // All the graph nodes have been assigned to the TRT EP,
       // Then the TRT EP is cached for triggering a ReplayGraph() in Run().
-      std::vector<const char*> cuda_graph_support_ep_list = {onnxruntime::kTensorrtExecutionProvider, onnxruntime::kCudaExecutionProvider};
+      //
+      // Check for JS EP:
+      // Same as the CUDA EP, except that the JS EP doesn't capture graph segments. Its captured graph records the
+      // WebGPU commands of a run.
+      std::vector<const char*> cuda_graph_support_ep_list = {onnxruntime::kTensorrtExecutionProvider,
+                                                             onnxruntime::kCudaExecutionProvider,
+                                                             onnxruntime::kJsExecutionProvider};
 
       for (auto& it : cuda_graph_support_ep_list) {
         auto* target_ep = execution_providers_.Get(it);
 
         if (target_ep && target_ep->IsGraphCaptureEnabled()) {
+          // A model that the CUDA EP can't capture as a whole is captured in segments between the nodes that can't be
+          // captured, see GraphSegmentCapture.
+          if (strcmp(target_ep->Type().c_str(), onnxruntime::kCudaExecutionProvider) == 0 &&
+              (HasControlflowNodes(graph) || !AreAllComputeNodesAssignedToEp(graph, kCudaExecutionProvider))) {
+            LOGS(*session_logger_, WARNING) << "This model has control flow nodes or compute nodes that are not "
+                                            << "partitioned to the CUDA EP, which can't be captured by CUDA Graphs. "
+                                            << "This session will capture the CUDA EP nodes between them in segments.";
+            // the segments keep the tensors they write alive, which the buffers shared by the allocation plan aren't
+            session_options_.enable_mem_reuse = false;
+            session_state_->EnableGraphSegmentCapture(*target_ep);
+            graph_segment_capture_ep_ = target_ep;
+            break;
+          }
+
           // CUDA Graphs can't work with control flow nodes
           if (HasControlflowNodes(graph)) {
             LOGS(*session_logger_, ERROR) << "This session cannot use the CUDA Graph feature as requested by the user "
@@ -1741,19 +2349,22 @@ common::Status InferenceSession::Initialize() {
                                 "as the model has control flow nodes which can't be supported by CUDA Graphs."));
           }
 
-          if (strcmp(target_ep->Type().c_str(), onnxruntime::kCudaExecutionProvider) == 0) {
-            // Ensure that all nodes have been partitioned to CUDA or CPU EP && there are no memcpy nodes
+          if (strcmp(target_ep->Type().c_str(), onnxruntime::kCudaExecutionProvider) == 0 ||
+              strcmp(target_ep->Type().c_str(), onnxruntime::kJsExecutionProvider) == 0) {
+            // Ensure that all nodes have been partitioned to CUDA/JS or CPU EP && there are no memcpy nodes
             // The reasoning behind this logic is that certain shape nodes will be forced onto CPU
             // and as long as there are no memcpy nodes this is confirmation that no compute nodes have been placed on the CPU EP
             // which is all we care about.
-            if (!AreAllComputeNodesAssignedToCudaEp(graph)) {
-              LOGS(*session_logger_, ERROR) << "This session cannot use the CUDA Graph feature as requested by the user "
-                                            << " as all compute graph nodes have not been partitioned to the CUDA EP.";
+            if (!AreAllComputeNodesAssignedToEp(graph, target_ep->Type())) {
+              LOGS(*session_logger_, ERROR) << "This session cannot use the graph capture feature as requested by the user "
+                                            << " as all compute graph nodes have not been partitioned to the "
+                                            << target_ep->Type();
 
               ORT_RETURN_IF_ERROR_SESSIONID_(
                   ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
-                                  "This session cannot use the CUDA Graph feature as requested by the user "
-                                  " as all compute graph nodes have not been partitioned to the CUDA EP."));
+                                  "This session cannot use the graph capture feature as requested by the user "
+                                  " as all compute graph nodes have not been partitioned to the " +
+                                      target_ep->Type()));
             }
 
             // Log a warning for the user to know that there are shape subgraphs that will execute on CPU
@@ -1789,6 +2400,24 @@ common::Status InferenceSession::Initialize() {
         }
       }
 
+      // The initializers of an EP beyond its device memory budget are streamed from host memory, see WeightStreamer.
+      for (const auto& ep : execution_providers_) {
+        const size_t budget = ep->GetWeightStreamingBudget();
+        if (budget == 0) {
+          continue;
+        }
+        // a captured graph would read the device copies of a past run
+        if (ep->IsGraphCaptureEnabled()) {
+          LOGS(*session_logger_, WARNING) << "Weight streaming is disabled for " << ep->Type()
+                                          << " as it captures graphs.";
+          continue;
+        }
+        LOGS(*session_logger_, INFO) << "This session streams the initializers of " << ep->Type()
+                                     << " beyond " << budget << " bytes of device memory.";
+        session_state_->EnableWeightStreaming(*ep, budget);
+        break;  // one EP streams its initializers
+      }
+
       const bool disable_cpu_ep_fallback = session_options_.config_options.GetConfigOrDefault(
                                                kOrtSessionOptionsDisableCPUEPFallback, "0") == "1";
 
@@ -1843,11 +2472,14 @@ common::Status InferenceSession::Initialize() {
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
     }
 
-    ORT_RETURN_IF_ERROR_SESSIONID_(
-        session_state_->FinalizeSessionState(model_location_, kernel_registry_manager_,
-                                             // need to keep the initializers if saving the optimized model
-                                             !saving_model,
-                                             saving_ort_format));
+    {
+      StartupPhase phase("session_state_finalize");
+      ORT_RETURN_IF_ERROR_SESSIONID_(
+          session_state_->FinalizeSessionState(model_location_, kernel_registry_manager_,
+                                               // need to keep the initializers if saving the optimized model
+                                               !saving_model && !saving_optimization_cache,
+                                               saving_ort_format));
+    }
 
 #if !defined(ORT_MINIMAL_BUILD)
     if (saving_model) {
@@ -1887,6 +2519,10 @@ common::Status InferenceSession::Initialize() {
       }
     }
 
+    if (saving_optimization_cache) {
+      SaveOptimizationCache(optimization_cache_file);
+    }
+
     std::vector<TuningResults> tuning_results;
     bool found_tuning_results = false;
     ORT_RETURN_IF_ERROR_SESSIONID_(inference_session_utils::ParseTuningResultsFromModelMetadata(
@@ -1894,11 +2530,79 @@ common::Status InferenceSession::Initialize() {
     if (found_tuning_results) {
       ORT_RETURN_IF_ERROR_SESSIONID_(SetTuningResults(tuning_results, /*error_on_invalid*/ false, /*auto_enable*/ true));
     }
+
+    LoadTuningResultsCache();
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
     // Resolve memory pattern flags of the main graph and subgraph session states
     ResolveMemoryPatternFlags(*session_state_);
 
+    const std::string metrics_sampling_rate_str =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsMetricsSamplingRate, "");
+    if (!metrics_sampling_rate_str.empty()) {
+      double metrics_sampling_rate = 0.0;
+      if (!TryParseStringWithClassicLocale(metrics_sampling_rate_str, metrics_sampling_rate) ||
+          !(metrics_sampling_rate >= 0.0 && metrics_sampling_rate <= 1.0)) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ",
+                               kOrtSessionOptionsMetricsSamplingRate, ": ", metrics_sampling_rate_str,
+                               ". Expected a number between 0 and 1.");
+      }
+      metrics_ = std::make_unique<SessionMetrics>(session_state_->GetGraphViewer(), metrics_sampling_rate);
+      session_state_->SetMetrics(metrics_.get());
+      concurrency::ThreadPool::EnableBusyTimeTracking(GetIntraOpThreadPoolToUse());
+      concurrency::ThreadPool::EnableBusyTimeTracking(GetInterOpThreadPoolToUse());
+    }
+
+    memory_timeline_file_prefix_ =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryTimelineFilePrefix, "");
+    if (!memory_timeline_file_prefix_.empty()) {
+      const std::string max_runs_str =
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryTimelineMaxRuns, "1");
+      if (!TryParseStringWithClassicLocale(max_runs_str, memory_timeline_max_runs_) || memory_timeline_max_runs_ < 0) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ",
+                               kOrtSessionOptionsMemoryTimelineMaxRuns, ": ", max_runs_str,
+                               ". Expected a non-negative integer.");
+      }
+      for (const auto& [idx, value] : session_state_->GetInitializedTensors()) {
+        if (value.IsTensor()) {
+          const Tensor& tensor = value.Get<Tensor>();
+          memory_timeline_initializer_bytes_[tensor.Location().device.ToString()] += tensor.SizeInBytes();
+        }
+      }
+    }
+
+    ORT_RETURN_IF_ERROR_SESSIONID_(ParseStateVariables());
+
+    if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsRecordKernelDispatch, "0") == "1") {
+      kernel_dispatch_recorder_ = std::make_unique<KernelDispatchRecorder>();
+    }
+
+    if (const std::string hardware_counter_names =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsProfileHardwareCounters, "");
+        !hardware_counter_names.empty()) {
+      std::unique_ptr<profiling::HardwareCounters> hardware_counters;
+      std::string warnings;
+      const auto status = profiling::HardwareCounters::Create(hardware_counter_names, hardware_counters, warnings);
+      if (status.Code() == common::INVALID_ARGUMENT) {
+        return status;
+      }
+      if (!status.IsOK()) {
+        LOGS(*session_logger_, WARNING) << "The profile won't include hardware counters: " << status.ErrorMessage();
+      } else if (!warnings.empty()) {
+        LOGS(*session_logger_, WARNING) << warnings;
+      }
+      session_profiler_.SetHardwareCounters(std::move(hardware_counters));
+    }
+
+    // use the static memory plan saved in an ORT format model, if any
+    if (!ort_format_model_bytes_.empty()) {
+      const auto* fbs_session = fbs::GetInferenceSession(ort_format_model_bytes_.data());
+      if (const auto* fbs_static_memory_plan = fbs_session->static_memory_plan();
+          fbs_static_memory_plan != nullptr) {
+        ORT_RETURN_IF_ERROR_SESSIONID_(session_state_->LoadStaticMemoryPlanFromOrtFormat(*fbs_static_memory_plan));
+      }
+    }
+
     is_inited_ = true;
 
     if (!using_ort_model_bytes_for_initializers_) {
@@ -1935,7 +2639,15 @@ common::Status InferenceSession::Initialize() {
     LOGS(*session_logger_, ERROR) << status.ErrorMessage();
   }
 
+  initialize_phase.reset();
   if (session_profiler_.IsEnabled()) {
+    // the phases of Load and Initialize, nested in the order they began
+    for (const auto& phase : startup_timings_.GetPhases()) {
+      session_profiler_.RecordEvent(
+          profiling::SESSION_EVENT, logging::GetThreadId(),
+          phase.name.empty() ? phase.phase : phase.phase + "/" + phase.name, phase.start, phase.end,
+          {{"phase", phase.phase}, {"name", phase.name}, {"depth", std::to_string(phase.depth)}});
+    }
     session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "session_initialization", tp);
   }
 
@@ -2284,14 +2996,171 @@ struct ThreadPoolSpinningSwitch {
 };
 }  // namespace
 
+Status InferenceSession::ParseStateVariables() {
+  const std::string state_variables =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsStateVariables, "");
+  for (const auto pair : utils::SplitString(state_variables, ",")) {
+    const auto separator = pair.find(':');
+    if (separator == std::string_view::npos) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ", kOrtSessionOptionsStateVariables,
+                             ": ", state_variables, ". Expected a comma separated list of <input>:<output> pairs.");
+    }
+
+    StateVariable state_variable{std::string(pair.substr(0, separator)), std::string(pair.substr(separator + 1)),
+                                 OrtDevice()};
+    if (input_def_map_.find(state_variable.input_name) == input_def_map_.end() ||
+        output_def_map_.find(state_variable.output_name) == output_def_map_.end()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The state variable ", pair, " of ",
+                             kOrtSessionOptionsStateVariables, " doesn't pair an input of the model with an output.");
+    }
+
+    // an input no node consumes is kept on CPU
+    InlinedVector<SessionState::NodeInfo> node_info_vec;
+    if (session_state_->GetInputNodeInfo(state_variable.input_name, node_info_vec).IsOK() &&
+        !node_info_vec.empty() && node_info_vec.front().device != nullptr) {
+      state_variable.device = *node_info_vec.front().device;
+    }
+
+    state_variables_.push_back(std::move(state_variable));
+  }
+
+  return Status::OK();
+}
+
 Status InferenceSession::Run(const RunOptions& run_options,
                              gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
                              gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
-                             const std::vector<OrtDevice>* p_fetches_device_info) {
+                             const std::vector<OrtDevice>* p_fetches_device_info,
+                             const std::unordered_map<size_t, IExecutor::CustomAllocator>* p_fetch_allocators,
+                             const ResolvedFeedsFetches* resolved_feeds_fetches) {
+  if (!state_variables_.empty()) {
+    // the feeds and fetches resolved by the caller don't include the state
+    return RunWithStateVariables(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info,
+                                 p_fetch_allocators);
+  }
+
+  return RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info, p_fetch_allocators,
+                 resolved_feeds_fetches);
+}
+
+Status InferenceSession::RunWithStateVariables(
+    const RunOptions& run_options, gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+    gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
+    const std::vector<OrtDevice>* p_fetches_device_info,
+    const std::unordered_map<size_t, IExecutor::CustomAllocator>* p_fetch_allocators) {
+  // the caller's fetches are validated before the state outputs are added to them
+  ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+
+  const std::string context_name =
+      run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigStateContext, "");
+  std::shared_ptr<StateContext> context;
+  {
+    std::lock_guard<OrtMutex> lock(state_contexts_mutex_);
+    auto& entry = state_contexts_[context_name];
+    if (entry == nullptr) {
+      entry = std::make_shared<StateContext>();
+      entry->values.resize(state_variables_.size());
+    }
+    context = entry;
+  }
+
+  std::lock_guard<OrtMutex> context_lock(context->mutex);
+
+  std::vector<std::string> state_feed_names(feed_names.begin(), feed_names.end());
+  std::vector<OrtValue> state_feeds(feeds.begin(), feeds.end());
+  std::vector<std::string> state_output_names(output_names.begin(), output_names.end());
+  std::vector<OrtValue> state_fetches;
+  if (p_fetches != nullptr) {
+    state_fetches = *p_fetches;
+  }
+  state_fetches.resize(output_names.size());
+  std::vector<OrtDevice> state_fetches_device_info =
+      p_fetches_device_info != nullptr ? *p_fetches_device_info : std::vector<OrtDevice>(output_names.size());
+  InlinedVector<size_t> state_fetch_indices;
+  state_fetch_indices.reserve(state_variables_.size());
+
+  for (size_t i = 0, end = state_variables_.size(); i < end; ++i) {
+    const StateVariable& state_variable = state_variables_[i];
+
+    // the caller feeds the input to reset the state
+    if (context->values[i].IsAllocated() &&
+        std::find(feed_names.begin(), feed_names.end(), state_variable.input_name) == feed_names.end()) {
+      state_feed_names.push_back(state_variable.input_name);
+      state_feeds.push_back(context->values[i]);
+    }
+
+    const auto output = std::find(output_names.begin(), output_names.end(), state_variable.output_name);
+    if (output != output_names.end()) {
+      state_fetch_indices.push_back(static_cast<size_t>(output - output_names.begin()));
+    } else {
+      state_fetch_indices.push_back(state_output_names.size());
+      state_output_names.push_back(state_variable.output_name);
+      state_fetches.emplace_back();
+      state_fetches_device_info.push_back(state_variable.device);
+    }
+  }
+
+  ORT_RETURN_IF_ERROR(RunImpl(run_options, state_feed_names, state_feeds, state_output_names, &state_fetches,
+                              &state_fetches_device_info, p_fetch_allocators, nullptr));
+
+  if (run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigEndStateContext, "0") == "1") {
+    std::fill(context->values.begin(), context->values.end(), OrtValue());
+    std::lock_guard<OrtMutex> lock(state_contexts_mutex_);
+    auto entry = state_contexts_.find(context_name);
+    if (entry != state_contexts_.end() && entry->second == context) {
+      state_contexts_.erase(entry);
+    }
+  } else {
+    for (size_t i = 0, end = state_variables_.size(); i < end; ++i) {
+      context->values[i] = state_fetches[state_fetch_indices[i]];
+    }
+  }
+
+  if (p_fetches != nullptr) {
+    state_fetches.resize(output_names.size());
+    *p_fetches = std::move(state_fetches);
+  }
+  return Status::OK();
+}
+
+Status InferenceSession::RunImpl(const RunOptions& run_options,
+                                 gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                 gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
+                                 const std::vector<OrtDevice>* p_fetches_device_info,
+                                 const std::unordered_map<size_t, IExecutor::CustomAllocator>* p_fetch_allocators,
+                                 const ResolvedFeedsFetches* resolved_feeds_fetches) {
   TimePoint tp;
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Start();
   }
+  const auto run_start = std::chrono::steady_clock::now();
+
+  // the span of the Run is the parent of the spans the executors of the graph and its subgraphs report
+  std::optional<tracing::TraceSpan> run_span;
+  std::optional<tracing::CurrentSpanScope> run_span_scope;
+  if (session_options_.trace_span_function != nullptr) {
+    run_span.emplace(session_options_.trace_span_function, session_options_.trace_span_param,
+                     run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigTraceContext, ""),
+                     session_options_.session_logid, "run");
+    run_span_scope.emplace(&*run_span);
+  }
+
+  // the ExecutionFrames of the graph and its subgraphs record their allocations in the current timeline
+  std::optional<MemoryTimeline> memory_timeline;
+  std::optional<MemoryTimelineScope> memory_timeline_scope;
+  int64_t memory_timeline_run = 0;
+  if (!memory_timeline_file_prefix_.empty() &&
+      (memory_timeline_run = memory_timeline_runs_.fetch_add(1, std::memory_order_relaxed)) <
+          memory_timeline_max_runs_) {
+    memory_timeline.emplace(memory_timeline_run, memory_timeline_initializer_bytes_);
+    memory_timeline_scope.emplace(&*memory_timeline, nullptr);
+  }
+
+  // the kernels of the graph and its subgraphs record the variants they dispatch to in the current recorder
+  std::optional<KernelDispatchScope> kernel_dispatch_scope;
+  if (kernel_dispatch_recorder_ != nullptr) {
+    kernel_dispatch_scope.emplace(kernel_dispatch_recorder_.get(), nullptr);
+  }
 
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
   TraceLoggingActivity<telemetry_provider_handle> ortrun_activity;
@@ -2303,6 +3172,15 @@ Status InferenceSession::Run(const RunOptions& run_options,
 
   // Increment/decrement concurrent_num_runs_ and control
   // session threads spinning as configured. Do nothing for graph replay except the counter.
+  int64_t graph_capture_key = 0;
+  if (cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled()) {
+    ORT_RETURN_IF_ERROR_SESSIONID_(GetGraphCaptureKey(run_options, feeds, graph_capture_key));
+    cached_execution_provider_for_graph_replay_.SetGraphCaptureKey(graph_capture_key);
+  } else if (graph_segment_capture_ep_ != nullptr) {
+    // the executor captures the segments, not the execution provider the whole run
+    graph_segment_capture_ep_->SetGraphCaptureKey(-1);
+  }
+
   const bool control_spinning = use_per_session_threads_ &&
                                 force_spinning_stop_between_runs_ &&
                                 !cached_execution_provider_for_graph_replay_.IsGraphCaptured();
@@ -2310,6 +3188,16 @@ Status InferenceSession::Run(const RunOptions& run_options,
   auto* inter_tp = (control_spinning) ? inter_op_thread_pool_.get() : nullptr;
   ThreadPoolSpinningSwitch runs_refcounter_and_tp_spin_control(intra_tp, inter_tp, current_num_runs_);
 
+  // priority and quota of the parallel loops this Run submits to the intra op thread pool
+  auto intra_op_priority = intra_op_priority_;
+  int intra_op_max_degree_of_parallelism = intra_op_max_degree_of_parallelism_;
+  ORT_RETURN_IF_ERROR_SESSIONID_(ParseIntraOpSchedulingConfig(run_options.config_options,
+                                                              kOrtRunOptionsConfigIntraOpPriority,
+                                                              kOrtRunOptionsConfigIntraOpMaxDegreeOfParallelism,
+                                                              intra_op_priority, intra_op_max_degree_of_parallelism));
+  concurrency::ThreadPool::SchedulingScope intra_op_scheduling_scope(intra_op_priority,
+                                                                     intra_op_max_degree_of_parallelism);
+
   // Check if this Run() is simply going to be a CUDA Graph replay.
   if (cached_execution_provider_for_graph_replay_.IsGraphCaptured()) {
     LOGS(*session_logger_, INFO) << "Replaying the captured "
@@ -2331,9 +3219,23 @@ Status InferenceSession::Run(const RunOptions& run_options,
       // log evaluation start to trace logging provider
       env.GetTelemetryProvider().LogEvaluationStart();
 
-      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
+      const bool feeds_validated = resolved_feeds_fetches != nullptr && resolved_feeds_fetches->feeds_validated;
+      if (!feeds_validated) {
+        ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
+      }
       ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
 
+#if !defined(ORT_MINIMAL_BUILD)
+      if (!feeds_validated) {
+        InferenceSession* specialized_session = nullptr;
+        ORT_RETURN_IF_ERROR_SESSIONID_(GetShapeSpecialization(feed_names, feeds, specialized_session));
+        if (specialized_session != nullptr) {
+          return specialized_session->RunImpl(run_options, feed_names, feeds, output_names, p_fetches,
+                                              p_fetches_device_info, p_fetch_allocators, nullptr);
+        }
+      }
+#endif
+
       // shrink certain default memory arenas if the user has requested for it
       const std::string& shrink_memory_arenas =
           run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigEnableMemoryArenaShrinkage, "");
@@ -2342,8 +3244,10 @@ Status InferenceSession::Run(const RunOptions& run_options,
         ORT_RETURN_IF_ERROR_SESSIONID_(ValidateAndParseShrinkArenaString(shrink_memory_arenas, arenas_to_shrink));
       }
 
-      FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
-      FeedsFetchesManager feeds_fetches_manager{std::move(info)};
+      FeedsFetchesManager feeds_fetches_manager{
+          resolved_feeds_fetches != nullptr && resolved_feeds_fetches->info != nullptr
+              ? FeedsFetchesInfo(*resolved_feeds_fetches->info)
+              : FeedsFetchesInfo(feed_names, output_names, session_state_->GetOrtValueNameIdxMap())};
 
       if (p_fetches_device_info) {
         // populate the target device info. ignored if pre-allocated fetches are provided
@@ -2409,7 +3313,8 @@ Status InferenceSession::Run(const RunOptions& run_options,
 #ifdef ORT_ENABLE_STREAM
                                      device_stream_collection_holder,
 #endif
-                                     run_logger);
+                                     run_logger,
+                                     p_fetch_allocators);
       }
 
       // info all execution providers InferenceSession:Run ended
@@ -2444,6 +3349,21 @@ Status InferenceSession::Run(const RunOptions& run_options,
     }
   }
 
+  if (memory_timeline.has_value()) {
+    memory_timeline_scope.reset();
+    auto status = memory_timeline->Write(
+        MakeString(memory_timeline_file_prefix_, "_", session_id_, "_", memory_timeline_run));
+    if (!status.IsOK()) {
+      LOGS(*session_logger_, WARNING) << "Failed to write the memory timeline: " << status.ErrorMessage();
+    }
+  }
+
+  if (metrics_ != nullptr && retval.IsOK()) {
+    metrics_->RecordRun(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                  std::chrono::steady_clock::now() - run_start)
+                                                  .count()));
+  }
+
   // keep track of telemetry
   ++telemetry_.total_runs_since_last_;
   telemetry_.total_run_duration_since_last_ += TimeDiffMicroSeconds(tp);
@@ -2475,9 +3395,10 @@ Status InferenceSession::Run(const RunOptions& run_options,
   // so that users just need one session run to capture the graph.
   // N is defined in min_num_runs_before_cuda_graph_capture_ for CUDA EP, and the value could be different for other EP.
   if (retval.IsOK() && cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled() &&
-      !cached_execution_provider_for_graph_replay_.IsGraphCaptured()) {
+      graph_capture_key != -1 && !cached_execution_provider_for_graph_replay_.IsGraphCaptured()) {
     LOGS(*session_logger_, INFO) << "Start another run for necessary memory allocation or graph capture.";
-    ORT_RETURN_IF_ERROR(Run(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info));
+    ORT_RETURN_IF_ERROR(RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info,
+                                nullptr, nullptr));
   }
   return retval;
 }
@@ -2553,6 +3474,218 @@ Status InferenceSession::Run(const RunOptions& run_options,
   return Status::OK();
 }
 
+Status InferenceSession::RunBatch(const RunOptions& run_options,
+                                  gsl::span<const char* const> feed_names,
+                                  gsl::span<const OrtValue* const> feeds,
+                                  gsl::span<const char* const> fetch_names,
+                                  gsl::span<OrtValue*> fetches,
+                                  gsl::span<Status> statuses) {
+  const size_t num_feeds = feed_names.size();
+  const size_t num_fetches = fetch_names.size();
+  const size_t batch_size = statuses.size();
+  if (feeds.size() != batch_size * num_feeds || fetches.size() != batch_size * num_fetches) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "RunBatch expects ", num_feeds, " feeds and ",
+                           num_fetches, " fetches for each of the ", batch_size, " requests, got ", feeds.size(),
+                           " feeds and ", fetches.size(), " fetches.");
+  }
+  if (!is_inited_) {
+    LOGS(*session_logger_, ERROR) << "Session was not initialized";
+    return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+  }
+
+  // the names are converted and resolved once for all the requests
+  FeedsFetchesInfo info;
+  info.feed_names.reserve(num_feeds);
+  for (const char* feed_name : feed_names) {
+    if (feed_name == nullptr || feed_name[0] == '\0') {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "input name cannot be empty");
+    }
+    info.feed_names.emplace_back(feed_name);
+  }
+  info.output_names.reserve(num_fetches);
+  for (const char* fetch_name : fetch_names) {
+    if (fetch_name == nullptr || fetch_name[0] == '\0') {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "output name cannot be empty");
+    }
+    info.output_names.emplace_back(fetch_name);
+  }
+  ORT_RETURN_IF_ERROR_SESSIONID_(info.SetMLValueIdxs(session_state_->GetOrtValueNameIdxMap()));
+  const ResolvedFeedsFetches resolved{&info, false};
+
+  const auto run_request = [&](size_t r) {
+    Status status;
+    ORT_TRY {
+      InlinedVector<OrtValue> request_feeds;
+      request_feeds.reserve(num_feeds);
+      for (size_t i = 0; i < num_feeds && status.IsOK(); ++i) {
+        const OrtValue* feed = feeds[r * num_feeds + i];
+        if (feed == nullptr) {
+          status = ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "NULL input supplied for input ",
+                                   info.feed_names[i]);
+        } else {
+          request_feeds.push_back(*feed);
+        }
+      }
+
+      std::vector<OrtValue> request_fetches(num_fetches);
+      for (size_t i = 0; i < num_fetches; ++i) {
+        if (fetches[r * num_fetches + i] != nullptr) {
+          request_fetches[i] = *fetches[r * num_fetches + i];
+        }
+      }
+
+      if (status.IsOK()) {
+        status = Run(run_options, info.feed_names, request_feeds, info.output_names, &request_fetches, nullptr,
+                     nullptr, &resolved);
+      }
+      if (status.IsOK()) {
+        for (size_t i = 0; i < num_fetches; ++i) {
+          if (fetches[r * num_fetches + i] == nullptr) {
+            fetches[r * num_fetches + i] = new OrtValue(request_fetches[i]);
+          }
+        }
+      }
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+    ORT_CATCH(...) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, "unknown exception");
+    }
+    statuses[r] = status;
+  };
+
+  auto* tp = GetIntraOpThreadPoolToUse();
+  if (batch_size < 2 || !is_concurrent_run_supported_ || tp == nullptr ||
+      concurrency::ThreadPool::DegreeOfParallelism(tp) < 2) {
+    for (size_t r = 0; r < batch_size; ++r) {
+      run_request(r);
+    }
+    return Status::OK();
+  }
+
+  // the threads of the pool run the requests as in RunAsync, outside of a parallel section so that their kernels
+  // can still use the pool, and the calling thread runs the first one
+  OrtMutex mutex;
+  OrtCondVar cv;
+  size_t pending = batch_size - 1;  // GUARDED_BY(mutex)
+  for (size_t r = 1; r < batch_size; ++r) {
+    concurrency::ThreadPool::Schedule(tp, [&, r]() {
+      run_request(r);
+      std::lock_guard<OrtMutex> lock(mutex);
+      if (--pending == 0) {
+        cv.notify_all();
+      }
+    });
+  }
+  run_request(0);
+  std::unique_lock<OrtMutex> lock(mutex);
+  cv.wait(lock, [&]() { return pending == 0; });
+  return Status::OK();
+}
+
+Status InferenceSession::PrepareRun(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                    gsl::span<const std::string> output_names,
+                                    std::unique_ptr<PreparedRun>& prepared_run) {
+  if (!is_inited_) {
+    LOGS(*session_logger_, ERROR) << "Session was not initialized";
+    return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+  }
+  ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
+  ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, nullptr));
+
+  std::vector<PreparedRun::FeedInfo> feed_infos;
+  feed_infos.reserve(feeds.size());
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    if (!feeds[i].IsTensor()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Only runs with tensor feeds can be prepared but input '",
+                             feed_names[i], "' is not a tensor.");
+    }
+    const Tensor& tensor = feeds[i].Get<Tensor>();
+    feed_infos.push_back({tensor.DataType(), tensor.Shape(), tensor.Location().device});
+  }
+
+  // the run is on the specialization for the shapes of the feeds if there is one, as they don't change
+  InferenceSession* run_session = this;
+#if !defined(ORT_MINIMAL_BUILD)
+  InferenceSession* specialized_session = nullptr;
+  ORT_RETURN_IF_ERROR_SESSIONID_(GetShapeSpecialization(feed_names, feeds, specialized_session));
+  if (specialized_session != nullptr) {
+    run_session = specialized_session;
+  }
+#endif
+
+  FeedsFetchesInfo info;
+  info.feed_names.assign(feed_names.begin(), feed_names.end());
+  info.output_names.assign(output_names.begin(), output_names.end());
+  ORT_RETURN_IF_ERROR_SESSIONID_(info.SetMLValueIdxs(run_session->session_state_->GetOrtValueNameIdxMap()));
+
+  prepared_run = std::make_unique<PreparedRun>(*this, *run_session, std::move(info), std::move(feed_infos));
+  return Status::OK();
+}
+
+Status InferenceSession::Run(const RunOptions& run_options, const PreparedRun& prepared_run,
+                             gsl::span<const OrtValue> feeds, std::vector<OrtValue>* p_fetches) {
+  if (&prepared_run.GetSession() != this) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The run was prepared by another session.");
+  }
+  ORT_RETURN_IF_ERROR_SESSIONID_(prepared_run.ValidateFeeds(feeds));
+
+  const ResolvedFeedsFetches resolved{&prepared_run.GetFeedsFetchesInfo(), true};
+  return prepared_run.GetRunSession().Run(run_options, prepared_run.GetFeedNames(), feeds,
+                                          prepared_run.GetFetchNames(), p_fetches, nullptr, nullptr, &resolved);
+}
+
+Status InferenceSession::Clone(std::unique_ptr<InferenceSession>& clone) const {
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    if (!is_inited_) {
+      LOGS(*session_logger_, ERROR) << "Session was not initialized";
+      return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+    }
+  }
+
+  // the clones would run the execution providers at the same time, each under its own lock
+  if (!is_concurrent_run_supported_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                           "The session can't be cloned as one of its execution providers doesn't support "
+                           "concurrent runs.");
+  }
+  if (cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled() || graph_segment_capture_ep_ != nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                           "The session can't be cloned as one of its execution providers captures graphs.");
+  }
+
+  SessionOptions session_options = session_options_;
+  session_options.optimized_model_filepath.clear();
+  session_options.enable_profiling = false;
+  session_options.config_options.configurations[kOrtSessionOptionsShapeSpecializationMaxCount] = "0";
+
+  // the clone runs on the thread pools of this session, which its kernels use through the session state
+  auto cloned = std::make_unique<InferenceSession>(session_options, environment_, GetIntraOpThreadPoolToUse(),
+                                                   GetInterOpThreadPoolToUse());
+  for (const auto& execution_provider : execution_providers_) {
+    ORT_RETURN_IF_ERROR(cloned->execution_providers_.Add(execution_provider->Type(), execution_provider));
+  }
+  cloned->execution_providers_.SetCpuProviderWasImplicitlyAdded(
+      execution_providers_.GetCpuProviderWasImplicitlyAdded());
+
+  cloned->model_location_ = model_location_;
+  cloned->model_ = model_;
+  cloned->model_metadata_ = model_metadata_;
+  cloned->input_def_map_ = input_def_map_;
+  cloned->output_def_map_ = output_def_map_;
+  cloned->session_state_ = session_state_;
+  cloned->state_variables_ = state_variables_;
+  cloned->is_model_loaded_ = true;
+  cloned->is_inited_ = true;
+
+  clone = std::move(cloned);
+  return Status::OK();
+}
+
 common::Status InferenceSession::RunAsync(const RunOptions* run_options,
                                           gsl::span<const char* const> feed_names,
                                           gsl::span<const OrtValue* const> feeds,
@@ -2677,8 +3810,11 @@ common::Status InferenceSession::NewIOBinding(std::unique_ptr<IOBinding>* io_bin
 common::Status InferenceSession::Run(const RunOptions& run_options, IOBinding& io_binding) {
   // TODO should Run() call io_binding.SynchronizeInputs() or should it let the callers do it?
   // io_binding.SynchronizeInputs();
-  return Run(run_options, io_binding.GetInputNames(), io_binding.GetInputs(), io_binding.GetOutputNames(),
-             &io_binding.GetOutputs(), &io_binding.GetOutputsDeviceInfo());
+  const auto fetch_allocators = io_binding.PrepareRingBufferOutputs();
+  ORT_RETURN_IF_ERROR(Run(run_options, io_binding.GetInputNames(), io_binding.GetInputs(), io_binding.GetOutputNames(),
+                          &io_binding.GetOutputs(), &io_binding.GetOutputsDeviceInfo(),
+                          fetch_allocators.empty() ? nullptr : &fetch_allocators));
+  return io_binding.FinalizeRingBufferOutputs();
 }
 
 common::Status InferenceSession::Run(IOBinding& io_binding) {
@@ -2710,6 +3846,10 @@ void InferenceSession::StartProfiling(const logging::Logger* logger_ptr) {
 std::string InferenceSession::EndProfiling() {
   if (is_model_loaded_) {
     if (session_profiler_.IsEnabled()) {
+      // the peak of the CPU, to compare the FLOP/s of the kernels against
+      const auto now = session_profiler_.Start();
+      session_profiler_.RecordEvent(profiling::SESSION_EVENT, logging::GetThreadId(), "device_peak", now, now,
+                                    GetCpuPeakInfo());
       return session_profiler_.EndProfiling();
     } else {
       LOGS(*session_logger_, VERBOSE) << "Profiler is disabled.";
@@ -2777,10 +3917,60 @@ Status InferenceSession::SetTuningResults(
 }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+common::Status InferenceSession::GetMetricsSnapshot(std::string& snapshot) const {
+  if (metrics_ == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The session does not collect metrics. Set ",
+                           kOrtSessionOptionsMetricsSamplingRate, " to enable them.");
+  }
+
+  const std::string session_name =
+      session_options_.session_logid.empty() ? std::to_string(session_id_) : session_options_.session_logid;
+  snapshot = metrics_->ToPrometheusText(session_name, session_state_->GetAllocators(), GetIntraOpThreadPoolToUse(),
+                                        GetInterOpThreadPoolToUse());
+  return Status::OK();
+}
+
+std::string InferenceSession::GetStartupTimings() const {
+  return startup_timings_.ToJson();
+}
+
+common::Status InferenceSession::GetKernelDispatches(std::string& dispatches) const {
+  if (kernel_dispatch_recorder_ == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The session does not record the kernel dispatches. Set ",
+                           kOrtSessionOptionsRecordKernelDispatch, " to \"1\" to record them.");
+  }
+
+  dispatches = kernel_dispatch_recorder_->ToJson();
+  return Status::OK();
+}
+
 AllocatorPtr InferenceSession::GetAllocator(const OrtMemoryInfo& mem_info) const {
   return session_state_->GetAllocator(mem_info);
 }
 
+common::Status InferenceSession::CompactMemoryArena(const OrtMemoryInfo& mem_info) {
+  if (!is_inited_) {
+    LOGS(*session_logger_, ERROR) << "Session was not initialized";
+    return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+  }
+
+  if (GetCurrentNumRuns() > 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The memory arena can only be compacted while no Run is in progress.");
+  }
+
+  auto alloc = session_state_->GetAllocator(mem_info);
+  if (alloc == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "No allocator registered for: ", mem_info.ToString());
+  }
+
+  if (alloc->Info().alloc_type != OrtAllocatorType::OrtArenaAllocator) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The registered allocator is not an arena based allocator: ",
+                           alloc->Info().ToString());
+  }
+
+  return static_cast<BFCArena*>(alloc.get())->Compact();
+}
+
 common::Status InferenceSession::ValidateAndParseShrinkArenaString(const std::string& ort_device_list,
                                                                    /*out*/ InlinedVector<AllocatorPtr>& arenas_to_shrink) const {
   arenas_to_shrink.reserve(5);  // Allocate some memory for the container (we are unlikely to see more than 5 memory arena shrink requests)
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <map>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -12,12 +14,15 @@
 #include "core/common/logging/logging.h"
 #include "core/common/path_string.h"
 #include "core/common/profiler.h"
+#include "core/common/startup_timings.h"
 #include "core/common/status.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/iexecutor.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/kernel_dispatch.h"
+#include "core/framework/session_metrics.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tuning_results.h"
 #include "core/framework/framework_provider_common.h"
@@ -25,6 +30,8 @@
 #include "core/optimizer/graph_transformer_level.h"
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/insert_cast_transformer.h"
+#include "core/platform/env.h"
+#include "core/platform/threadpool.h"
 #include "core/framework/session_options.h"
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
 #include "core/language_interop_ops/language_interop_ops.h"
@@ -41,10 +48,12 @@ class ModelProto;
 namespace onnxruntime {  // forward declarations
 class CustomRegistry;
 class Environment;
+struct FeedsFetchesInfo;
 class GraphTransformer;
 class IExecutionProvider;
 class IOBinding;
 struct Notification;
+class PreparedRun;
 
 #ifdef ENABLE_TRAINING
 struct PartialGraphExecutionState;
@@ -300,6 +309,14 @@ class InferenceSession {
    */
   [[nodiscard]] common::Status Load(std::istream& model_istream, bool allow_released_opsets_only = true);
 
+  /**
+   * Load an ONNX model from a ModelProto, e.g. a part of a larger model.
+   * @param model_proto the model, which is moved into the session.
+   * @param model_uri path of the model file that the external data of the initializers is relative to.
+   * @return OK if success.
+   */
+  [[nodiscard]] common::Status Load(ONNX_NAMESPACE::ModelProto model_proto, const PathString& model_uri);
+
   /**
    * Load an ONNX model from the member model_proto_.
    * To be called only in conjunction with a ctor that takes in a model path/ model stream/ model array
@@ -317,10 +334,30 @@ class InferenceSession {
    */
   [[nodiscard]] common::Status Initialize();
 
+  /**
+   * What the caller of Run resolved for its feeds and fetches, to do it once for several runs.
+   */
+  struct ResolvedFeedsFetches {
+    // the indices of feed_names and output_names
+    const FeedsFetchesInfo* info = nullptr;
+    // the feeds were validated against the inputs of the model, and the run is on the shape specialization of the
+    // session for them if there is one, as for a PreparedRun
+    bool feeds_validated = false;
+  };
+
+  /**
+   * @param p_fetch_allocators optional allocators, by index in output_names, that create unallocated outputs
+   *        in caller provided memory once their shape is known.
+   * @param resolved_feeds_fetches optional feeds and fetches resolved by the caller, e.g. once for all the requests
+   *        of RunBatch.
+   */
   [[nodiscard]] common::Status Run(const RunOptions& run_options, gsl::span<const std::string> feed_names,
                                    gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
                                    std::vector<OrtValue>* p_fetches,
-                                   const std::vector<OrtDevice>* p_fetches_device_info = nullptr);
+                                   const std::vector<OrtDevice>* p_fetches_device_info = nullptr,
+                                   const std::unordered_map<size_t, IExecutor::CustomAllocator>* p_fetch_allocators =
+                                       nullptr,
+                                   const ResolvedFeedsFetches* resolved_feeds_fetches = nullptr);
 
   [[nodiscard]] common::Status Run(const RunOptions& run_options,
                                    gsl::span<const char* const> feed_names,
@@ -328,6 +365,51 @@ class InferenceSession {
                                    gsl::span<const char* const> fetch_names,
                                    gsl::span<OrtValue*> fetches);
 
+  /**
+   * Runs independent requests with the same feed and fetch names, resolving the names once for all of them. The
+   * requests run concurrently on the intra op thread pool if it has several threads and the session supports
+   * concurrent runs, sequentially otherwise.
+   * @param feeds the feeds of each request, feed_names.size() by request.
+   * @param fetches the fetches of each request, fetch_names.size() by request. A nullptr is set to an OrtValue
+   *        allocated with new if its request succeeds, as in Run.
+   * @param statuses the status of each request, their count is the number of requests.
+   * @return an error if the arguments are invalid for all the requests, OK otherwise.
+   */
+  [[nodiscard]] common::Status RunBatch(const RunOptions& run_options,
+                                        gsl::span<const char* const> feed_names,
+                                        gsl::span<const OrtValue* const> feeds,
+                                        gsl::span<const char* const> fetch_names,
+                                        gsl::span<OrtValue*> fetches,
+                                        gsl::span<common::Status> statuses);
+
+  /**
+   * Prepares runs with the feed and fetch names given, and feeds of the types, shapes and devices of feeds.
+   * The names are resolved and the feeds validated once here, see PreparedRun.
+   * @param prepared_run the prepared run, which must not outlive the session.
+   */
+  [[nodiscard]] common::Status PrepareRun(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                          gsl::span<const std::string> output_names,
+                                          std::unique_ptr<PreparedRun>& prepared_run);
+
+  /**
+   * Runs a run prepared by PrepareRun.
+   * @param feeds the feeds in the order of the feed names of prepared_run. They must be of the types, shapes and
+   *        devices it was prepared for.
+   * @param p_fetches the fetches in the order of the fetch names of prepared_run, as in Run.
+   */
+  [[nodiscard]] common::Status Run(const RunOptions& run_options, const PreparedRun& prepared_run,
+                                   gsl::span<const OrtValue> feeds, std::vector<OrtValue>* p_fetches);
+
+  /**
+   * Clones the initialized session for another worker thread. The clone shares the model, the session state with
+   * its kernels, execution plans, initializers and prepacked weights, the execution providers and their allocators,
+   * and the thread pools of this session; it has its own logger, metrics and run counters. Its kernels log and
+   * profile through this session, and it doesn't specialize the model for the shapes of its inputs.
+   * The session can't be cloned if one of its execution providers doesn't support concurrent runs or captures graphs.
+   * @param clone the clone, which must not outlive the session.
+   */
+  [[nodiscard]] common::Status Clone(std::unique_ptr<InferenceSession>& clone) const;
+
   [[nodiscard]] common::Status RunAsync(const RunOptions* run_options,
                                         gsl::span<const char* const> feed_names,
                                         gsl::span<const OrtValue* const> feeds,
@@ -474,6 +556,26 @@ class InferenceSession {
     */
   const profiling::Profiler& GetProfiling() const;
 
+  /**
+   * Get a snapshot of the metrics collected while the session runs, see kOrtSessionOptionsMetricsSamplingRate.
+   * @param snapshot The metrics in the Prometheus text exposition format.
+   * @return Status indicating if the session collects metrics.
+   */
+  [[nodiscard]] common::Status GetMetricsSnapshot(std::string& snapshot) const;
+
+  /**
+   * Get the kernel variants the nodes dispatched to in their last Run, see kOrtSessionOptionsRecordKernelDispatch.
+   * @param dispatches A JSON array with the dispatches of each node, see KernelDispatchRecorder::ToJson.
+   * @return Status indicating if the session records the dispatches.
+   */
+  [[nodiscard]] common::Status GetKernelDispatches(std::string& dispatches) const;
+
+  /**
+   * Get the time spent in each phase of Load and Initialize, e.g. in each graph transformer.
+   * @return A JSON object with the phases and their totals, see StartupTimings::ToJson.
+   */
+  std::string GetStartupTimings() const;
+
 #if !defined(ORT_MINIMAL_BUILD)
   /**
    * Get the TuningResults of TunableOp for every execution providers.
@@ -507,6 +609,14 @@ class InferenceSession {
    */
   AllocatorPtr GetAllocator(const OrtMemoryInfo& mem_info) const;
 
+  /**
+   * Coalesce the free memory of the arena based allocator matching mem_info and release its unused regions.
+   * Fails if a Run is in progress, as the arena must be idle while it is compacted.
+   * @param mem_info is a reference to OrtMemoryInfo that identifies the arena
+   * @return OK if the arena was compacted
+   */
+  common::Status CompactMemoryArena(const OrtMemoryInfo& mem_info);
+
   /**
    *Get InferenceSession logger.
    */
@@ -602,6 +712,25 @@ class InferenceSession {
 
   [[nodiscard]] common::Status SaveModelMetadata(const onnxruntime::Model& model);
 
+  // Runs with the feeds and fetches of the caller, see Run.
+  [[nodiscard]] common::Status RunImpl(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                                       gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+                                       std::vector<OrtValue>* p_fetches,
+                                       const std::vector<OrtDevice>* p_fetches_device_info,
+                                       const std::unordered_map<size_t, IExecutor::CustomAllocator>* p_fetch_allocators,
+                                       const ResolvedFeedsFetches* resolved_feeds_fetches);
+
+  // Runs with the state of the state context of run_options fed to the state inputs the caller doesn't feed, and the
+  // state outputs fetched for the next Run in addition to the caller's fetches.
+  [[nodiscard]] common::Status RunWithStateVariables(
+      const RunOptions& run_options, gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+      gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
+      const std::vector<OrtDevice>* p_fetches_device_info,
+      const std::unordered_map<size_t, IExecutor::CustomAllocator>* p_fetch_allocators);
+
+  // Parses kOrtSessionOptionsStateVariables into state_variables_.
+  [[nodiscard]] common::Status ParseStateVariables();
+
 #if !defined(ORT_MINIMAL_BUILD)
 
   [[nodiscard]] common::Status LoadOnnxModel(const PathString& model_uri);
@@ -611,6 +740,31 @@ class InferenceSession {
   }
 
   common::Status SaveToOrtFormat(const PathString& filepath) const;
+
+  // Path of the file in kOrtSessionOptionsOptimizationCacheDir for the model optimized with these session options
+  // and execution providers, or an empty path if the session can't use the optimization cache.
+  PathString GetOptimizationCacheFilePath() const;
+
+  // Saves the optimized model to cache_file, logging a warning if that fails.
+  void SaveOptimizationCache(const PathString& cache_file) const;
+
+  // Loads the tuning results of the execution providers which support TunableOp from
+  // kOrtSessionOptionsTuningResultsCacheDir, and records the files to save the results to in the destructor.
+  void LoadTuningResultsCache();
+
+  // Saves the tuning results of the execution providers with tuning enabled to the files found by
+  // LoadTuningResultsCache(), logging a warning if that fails.
+  void SaveTuningResultsCache() const;
+
+  // Sets session to the version of the model specialized for the shapes of the feeds if it exists or the shapes were
+  // seen often enough to create it, otherwise to nullptr. See kOrtSessionOptionsShapeSpecializationMaxCount.
+  [[nodiscard]] common::Status GetShapeSpecialization(gsl::span<const std::string> feed_names,
+                                                      gsl::span<const OrtValue> feeds, InferenceSession*& session);
+
+  // Creates a session for the model with the dims of the inputs fixed to the shapes of the feeds.
+  [[nodiscard]] common::Status CreateShapeSpecialization(gsl::span<const std::string> feed_names,
+                                                         gsl::span<const OrtValue> feeds,
+                                                         std::unique_ptr<InferenceSession>& session) const;
 #endif
 
   /**
@@ -691,6 +845,18 @@ class InferenceSession {
   onnxruntime::GraphTransformerManager graph_transformer_mgr_;
 
   InlinedHashSet<gsl::not_null<const ONNX_NAMESPACE::OpSchema*>> saved_runtime_optimization_produced_node_op_schemas_;
+
+  // hash of the ONNX model bytes, used as part of the key of the optimization cache. empty if the model was not
+  // loaded from a file or bytes or the cache is not enabled.
+  std::string onnx_model_hash_;
+
+  // The mapping of the ONNX model file if kOrtSessionOptionsConfigUseOnnxModelFileForInitializers is set.
+  // Initializers refer to their data in it, so it is kept for the lifetime of the session.
+  Env::MappedMemoryPtr onnx_model_file_mapping_;
+
+  // Execution provider types and the files in kOrtSessionOptionsTuningResultsCacheDir their tuning results are saved
+  // to when the session is destroyed.
+  std::vector<std::pair<std::string, PathString>> tuning_results_cache_files_;
 #endif
   // Any GraphTransformer/RewriteRule name in this set will not be enabled.
   InlinedHashSet<std::string> optimizers_to_disable_;
@@ -712,13 +878,49 @@ class InferenceSession {
   // Profiler for this session.
   profiling::Profiler session_profiler_;
 
+  // latency histograms and counters collected in every Run, if kOrtSessionOptionsMetricsSamplingRate is set
+  std::unique_ptr<SessionMetrics> metrics_;
+
+  // the allocations of the first memory_timeline_max_runs_ Runs are recorded to files named after
+  // memory_timeline_file_prefix_, if kOrtSessionOptionsMemoryTimelineFilePrefix is set
+  std::string memory_timeline_file_prefix_;
+  int64_t memory_timeline_max_runs_ = 0;
+  std::atomic<int64_t> memory_timeline_runs_{0};
+  // the bytes of the initializers by device, the baseline of the memory peaks
+  std::map<std::string, size_t> memory_timeline_initializer_bytes_;
+
+  // the kernel variants the nodes dispatched to, if kOrtSessionOptionsRecordKernelDispatch is set
+  std::unique_ptr<KernelDispatchRecorder> kernel_dispatch_recorder_;
+
+  // a graph input fed with the value the paired graph output had in the previous Run, see
+  // kOrtSessionOptionsStateVariables
+  struct StateVariable {
+    std::string input_name;
+    std::string output_name;
+    // the device the input is consumed on, which the state is kept on between the Runs
+    OrtDevice device;
+  };
+  std::vector<StateVariable> state_variables_;
+
+  // the state of the Runs with the same kOrtRunOptionsConfigStateContext, which run one after the other
+  struct StateContext {
+    OrtMutex mutex;
+    // by index in state_variables_, unallocated until a Run computed it
+    std::vector<OrtValue> values;
+  };
+  OrtMutex state_contexts_mutex_;
+  std::unordered_map<std::string, std::shared_ptr<StateContext>> state_contexts_;
+
+  // the time spent in each phase of Load and Initialize
+  StartupTimings startup_timings_;
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   MemoryProfiler memory_profiler_;
 #endif
 
   // Immutable state for each op in the model. Shared by all executors.
-  // It has a dependency on execution_providers_.
-  std::unique_ptr<SessionState> session_state_;
+  // It has a dependency on execution_providers_. Shared with the clones of the session.
+  std::shared_ptr<SessionState> session_state_;
 
   // Threadpools per session. These are initialized and used for the entire duration of the session
   // when use_per_session_threads is true.
@@ -731,6 +933,11 @@ class InferenceSession {
   // Spinning is restarted on the next Run()
   bool force_spinning_stop_between_runs_ = false;
 
+  // Scheduling priority and maximum degree of parallelism of the intra op parallel loops of a Run.
+  // Set from the session options and overridable per Run.
+  concurrency::ThreadPool::Priority intra_op_priority_ = concurrency::ThreadPool::Priority::kNormal;
+  int intra_op_max_degree_of_parallelism_ = 0;
+
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> thread_pool_;
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
 
@@ -805,6 +1012,22 @@ class InferenceSession {
 
   // Flag indicating if ModelProto has been parsed in an applicable ctor
   bool is_model_proto_parsed_ = false;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // The versions of the model specialized for the shapes of its inputs, if they are enabled.
+  struct ShapeSpecializations {
+    size_t max_count = 0;
+    size_t min_runs = 0;
+    // the model before it is transformed, which the specializations are created from
+    ONNX_NAMESPACE::ModelProto model_proto;
+    OrtMutex mutex;
+    // the number of runs for the input shapes that are not specialized yet, and the sessions for the ones that are.
+    // the session is nullptr if the specialization could not be created.
+    std::unordered_map<std::string, size_t> run_counts;
+    std::unordered_map<std::string, std::unique_ptr<InferenceSession>> sessions;
+  };
+  std::unique_ptr<ShapeSpecializations> shape_specializations_;
+#endif
   const Environment& environment_;
 
   // View of the bytes from an ORT format model.
@@ -857,6 +1080,12 @@ class InferenceSession {
       return cached_execution_provider_for_graph_replay_ != nullptr && cached_execution_provider_for_graph_replay_->IsGraphCaptureEnabled();
     }
 
+    void SetGraphCaptureKey(int64_t graph_key) {
+      if (cached_execution_provider_for_graph_replay_ != nullptr) {
+        cached_execution_provider_for_graph_replay_->SetGraphCaptureKey(graph_key);
+      }
+    }
+
     bool IsGraphCaptured() const {
       return cached_execution_provider_for_graph_replay_ != nullptr && cached_execution_provider_for_graph_replay_->IsGraphCaptured();
     }
@@ -877,6 +1106,9 @@ class InferenceSession {
   };
 
   CachedExecutionProviderForGraphReplay cached_execution_provider_for_graph_replay_;
+
+  // The execution provider whose nodes are captured in graph segments, for a model it can't capture as a whole.
+  IExecutionProvider* graph_segment_capture_ep_ = nullptr;
 };
 
 struct SessionIOBinding {
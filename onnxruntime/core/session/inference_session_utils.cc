@@ -5,6 +5,11 @@
 
 #include "core/session/inference_session_utils.h"
 
+#include <filesystem>
+#include <fstream>
+
+#include "core/platform/env.h"
+
 namespace onnxruntime {
 
 //---------------------
@@ -110,6 +115,11 @@ void from_json(const json& j, TuningResults& trs) {
   j.at("validators").get_to(trs.validators);
 }
 
+// This function is called by nlohmann/json
+void to_json(json& j, const TuningResults& trs) {
+  j = json{{"ep", trs.ep}, {"results", trs.results}, {"validators", trs.validators}};
+}
+
 //---------------------------------------------------
 //--- end of session options related helpers ---
 //---------------------------------------------------
@@ -264,6 +274,50 @@ Status ParseTuningResultsFromModelMetadata(const onnxruntime::ModelMetadata& met
   return Status::OK();
 }
 
+Status LoadTuningResultsFromFile(const PathString& file_path, TuningResults& results) {
+  std::ifstream file(std::filesystem::path(file_path), std::ios::binary);
+  ORT_RETURN_IF_NOT(file.good(), "Failed to open ", ToUTF8String(file_path));
+
+  Status status;
+  ORT_TRY {
+    results = json::parse(file).get<TuningResults>();
+  }
+  ORT_CATCH(const std::exception& e) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Tuning results in ", ToUTF8String(file_path),
+                               " cannot be parsed. Error message: ", e.what());
+    });
+  }
+
+  return status;
+}
+
+Status SaveTuningResultsToFile(const PathString& file_path, const TuningResults& results) {
+  const std::filesystem::path path(file_path);
+  const std::filesystem::path tmp_path(file_path + ToPathString(".tmp" + std::to_string(Env::Default().GetSelfPid())));
+  std::error_code ec;
+  std::filesystem::create_directories(path.parent_path(), ec);
+
+  {
+    std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+    ORT_RETURN_IF_NOT(file.good(), "Failed to open ", ToUTF8String(tmp_path.native()));
+    file << json(results).dump();
+    file.close();
+    if (!file.good()) {
+      std::filesystem::remove(tmp_path, ec);
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write ", ToUTF8String(tmp_path.native()));
+    }
+  }
+
+  std::filesystem::rename(tmp_path, path, ec);
+  if (ec) {
+    std::filesystem::remove(tmp_path, ec);
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to replace ", ToUTF8String(file_path), ": ", ec.message());
+  }
+
+  return Status::OK();
+}
+
 }  // namespace inference_session_utils
 }  // namespace onnxruntime
 
@@ -62,6 +62,13 @@ Status ParseTuningResultsFromModelMetadata(const onnxruntime::ModelMetadata& met
                                            /*out*/ std::vector<TuningResults>& results,
                                            /*out*/ bool& key_found);
 
+// Reads the tuning results of one execution provider from a json file written by SaveTuningResultsToFile.
+Status LoadTuningResultsFromFile(const PathString& file_path, /*out*/ TuningResults& results);
+
+// Writes the tuning results to a json file. The file is replaced atomically, so concurrent readers never see a
+// partially written file.
+Status SaveTuningResultsToFile(const PathString& file_path, const TuningResults& results);
+
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 }  // namespace inference_session_utils
@@ -3,14 +3,21 @@
 
 #include "core/session/onnxruntime_c_api.h"
 #include "core/session/allocator_adapters.h"
+#include "core/session/ensemble.h"
 #include "core/session/inference_session_utils.h"
 #include "core/session/IOBinding.h"
+#include "core/session/prepared_run.h"
+#include "core/session/request_batcher.h"
+#include "core/session/run_pipeline.h"
+#include "core/session/swappable_session.h"
 #include "core/framework/allocator.h"
 #include "core/framework/error_code_helper.h"
 #include "core/framework/execution_provider.h"
 #include "core/framework/tensor_type_and_shape.h"
 #include "core/framework/utils.h"
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstring>
 #include <functional>
 #include <sstream>
@@ -846,6 +853,30 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::RunBatch, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len* batch_size) const OrtValue* const* inputs, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len* batch_size) OrtValue** outputs, size_t batch_size,
+                    _Out_writes_all_(batch_size) OrtStatus** statuses) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+
+  std::vector<Status> request_statuses(batch_size);
+  const RunOptions default_run_options;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->RunBatch(run_options != nullptr ? *run_options : default_run_options,
+                                                    gsl::span(input_names, input_len),
+                                                    gsl::span(inputs, input_len * batch_size),
+                                                    gsl::span(output_names, output_names_len),
+                                                    gsl::span(outputs, output_names_len * batch_size),
+                                                    request_statuses));
+  for (size_t i = 0; i < batch_size; ++i) {
+    statuses[i] = ToOrtStatus(request_statuses[i]);
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::RunAsync, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
                     _In_reads_(input_len) const char* const* input_names,
                     _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
@@ -942,6 +973,397 @@ ORT_API_STATUS_IMPL(OrtApis::BindOutputToDevice, _Inout_ OrtIoBinding* binding_p
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::BindOutputToRingBuffer, _Inout_ OrtIoBinding* binding_ptr, _In_ const char* name,
+                    _In_ const OrtMemoryInfo* mem_info, _Inout_ void* base, size_t capacity_bytes, size_t stride_bytes,
+                    _In_ OrtRingBufferPositionFn position_fn, _In_opt_ void* user_data) {
+  API_IMPL_BEGIN
+  if (mem_info == nullptr || position_fn == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "OrtMemoryInfo and position callback must be provided");
+  }
+
+  onnxruntime::OutputRingBuffer ring_buffer;
+  ring_buffer.base = base;
+  ring_buffer.capacity_bytes = capacity_bytes;
+  ring_buffer.stride_bytes = stride_bytes;
+  ring_buffer.memory_info = *mem_info;
+  ring_buffer.get_position = [position_fn, user_data](size_t num_bytes) { return position_fn(user_data, num_bytes); };
+
+  auto st = binding_ptr->binding_->BindOutput(name, std::move(ring_buffer));
+  if (!st.IsOK()) {
+    return ToOrtStatus(st);
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
+struct OrtRunPipeline {
+  std::unique_ptr<::onnxruntime::RunPipeline> pipeline_;
+  explicit OrtRunPipeline(std::unique_ptr<::onnxruntime::RunPipeline>&& pipeline) : pipeline_(std::move(pipeline)) {}
+  OrtRunPipeline(const OrtRunPipeline&) = delete;
+  OrtRunPipeline& operator=(const OrtRunPipeline&) = delete;
+};
+
+ORT_API_STATUS_IMPL(OrtApis::CreateRunPipeline, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    size_t depth, _Outptr_ OrtRunPipeline** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  std::vector<std::string> input_names_vec(input_names, input_names + input_len);
+  std::vector<std::string> output_names_vec(output_names, output_names + output_names_len);
+  auto pipeline = std::make_unique<::onnxruntime::RunPipeline>(*session, run_options ? *run_options : OrtRunOptions(),
+                                                               std::move(input_names_vec),
+                                                               std::move(output_names_vec), depth);
+  ORT_API_RETURN_IF_STATUS_NOT_OK(pipeline->Initialize());
+  *out = std::make_unique<OrtRunPipeline>(std::move(pipeline)).release();
+  return nullptr;
+  API_IMPL_END
+}
+
+namespace {
+std::vector<OrtValue> CopyInputValues(const OrtValue* const* inputs, size_t input_len) {
+  std::vector<OrtValue> input_values;
+  input_values.reserve(input_len);
+  for (size_t i = 0; i < input_len; ++i) {
+    input_values.push_back(*inputs[i]);
+  }
+  return input_values;
+}
+
+// adapts a RunAsyncCallbackFn to the callbacks of RunPipeline and RequestBatcher. the outputs are handed over to
+// the caller, who releases them.
+std::function<void(Status, std::vector<OrtValue>&)> WrapRunAsyncCallback(RunAsyncCallbackFn callback,
+                                                                         void* user_data) {
+  return [callback, user_data](Status run_status, std::vector<OrtValue>& outputs) {
+    std::vector<OrtValue*> output_ptrs;
+    if (run_status.IsOK()) {
+      output_ptrs.reserve(outputs.size());
+      for (auto& output : outputs) {
+        output_ptrs.push_back(std::make_unique<OrtValue>(std::move(output)).release());
+      }
+    }
+    callback(user_data, output_ptrs.empty() ? nullptr : output_ptrs.data(), output_ptrs.size(),
+             ToOrtStatus(run_status));
+  };
+}
+}  // namespace
+
+ORT_API_STATUS_IMPL(OrtApis::RunPipelineSubmit, _Inout_ OrtRunPipeline* pipeline,
+                    _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                    _In_ RunAsyncCallbackFn callback, _In_opt_ void* user_data) {
+  API_IMPL_BEGIN
+  auto status = pipeline->pipeline_->Submit(CopyInputValues(inputs, input_len),
+                                            WrapRunAsyncCallback(callback, user_data));
+  return ToOrtStatus(status);
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunPipelineWait, _Inout_ OrtRunPipeline* pipeline) {
+  API_IMPL_BEGIN
+  pipeline->pipeline_->Wait();
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API(void, OrtApis::ReleaseRunPipeline, _Frees_ptr_opt_ OrtRunPipeline* pipeline) {
+  delete pipeline;
+}
+
+struct OrtRequestBatcher {
+  std::unique_ptr<::onnxruntime::RequestBatcher> batcher_;
+  explicit OrtRequestBatcher(std::unique_ptr<::onnxruntime::RequestBatcher>&& batcher)
+      : batcher_(std::move(batcher)) {}
+  OrtRequestBatcher(const OrtRequestBatcher&) = delete;
+  OrtRequestBatcher& operator=(const OrtRequestBatcher&) = delete;
+};
+
+ORT_API_STATUS_IMPL(OrtApis::CreateRequestBatcher, _Inout_ OrtSession* sess,
+                    _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    size_t batch_axis, size_t max_batch_size, int64_t max_delay_us,
+                    _In_reads_opt_(num_padding_buckets) const int64_t* padding_buckets, size_t num_padding_buckets,
+                    _Outptr_ OrtRequestBatcher** out) {
+  API_IMPL_BEGIN
+  if (max_batch_size == 0 || max_delay_us < 0) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "max_batch_size must be positive and max_delay_us not negative");
+  }
+  if (num_padding_buckets > 0 && padding_buckets == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "padding_buckets must be provided");
+  }
+
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  ::onnxruntime::RequestBatcherOptions options;
+  options.batch_axis = batch_axis;
+  options.max_batch_size = max_batch_size;
+  options.max_delay = std::chrono::microseconds(max_delay_us);
+  if (num_padding_buckets > 0) {
+    options.padding_buckets.assign(padding_buckets, padding_buckets + num_padding_buckets);
+  }
+  if (!std::is_sorted(options.padding_buckets.begin(), options.padding_buckets.end())) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "padding_buckets must be sorted");
+  }
+
+  *out = std::make_unique<OrtRequestBatcher>(std::make_unique<::onnxruntime::RequestBatcher>(
+                                                 *session, run_options ? *run_options : OrtRunOptions(),
+                                                 std::vector<std::string>(input_names, input_names + input_len),
+                                                 std::vector<std::string>(output_names, output_names + output_names_len),
+                                                 std::move(options)))
+             .release();
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RequestBatcherSubmit, _Inout_ OrtRequestBatcher* batcher,
+                    _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                    _In_ RunAsyncCallbackFn callback, _In_opt_ void* user_data) {
+  API_IMPL_BEGIN
+  auto status = batcher->batcher_->Submit(CopyInputValues(inputs, input_len),
+                                          WrapRunAsyncCallback(callback, user_data));
+  return ToOrtStatus(status);
+  API_IMPL_END
+}
+
+ORT_API(void, OrtApis::ReleaseRequestBatcher, _Frees_ptr_opt_ OrtRequestBatcher* batcher) {
+  delete batcher;
+}
+
+struct OrtPreparedRun {
+  std::unique_ptr<::onnxruntime::PreparedRun> prepared_run_;
+  explicit OrtPreparedRun(std::unique_ptr<::onnxruntime::PreparedRun>&& prepared_run)
+      : prepared_run_(std::move(prepared_run)) {}
+  OrtPreparedRun(const OrtPreparedRun&) = delete;
+  OrtPreparedRun& operator=(const OrtPreparedRun&) = delete;
+};
+
+ORT_API_STATUS_IMPL(OrtApis::CreatePreparedRun, _Inout_ OrtSession* sess,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Outptr_ OrtPreparedRun** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  std::vector<std::string> feed_names;
+  feed_names.reserve(input_len);
+  std::vector<OrtValue> feeds;
+  feeds.reserve(input_len);
+  for (size_t i = 0; i < input_len; ++i) {
+    if (input_names[i] == nullptr || input_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input name cannot be empty");
+    }
+    if (inputs[i] == nullptr) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input cannot be NULL");
+    }
+    feed_names.emplace_back(input_names[i]);
+    feeds.push_back(*inputs[i]);
+  }
+  std::vector<std::string> fetch_names;
+  fetch_names.reserve(output_names_len);
+  for (size_t i = 0; i < output_names_len; ++i) {
+    if (output_names[i] == nullptr || output_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
+    }
+    fetch_names.emplace_back(output_names[i]);
+  }
+
+  std::unique_ptr<::onnxruntime::PreparedRun> prepared_run;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->PrepareRun(feed_names, feeds, fetch_names, prepared_run));
+  *out = std::make_unique<OrtPreparedRun>(std::move(prepared_run)).release();
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunPrepared, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_ const OrtPreparedRun* prepared_run,
+                    _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                    _Inout_updates_all_(output_len) OrtValue** outputs, size_t output_len) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  InlinedVector<OrtValue> feeds;
+  feeds.reserve(input_len);
+  for (size_t i = 0; i < input_len; ++i) {
+    if (inputs[i] == nullptr) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input cannot be NULL");
+    }
+    feeds.push_back(*inputs[i]);
+  }
+  std::vector<OrtValue> fetches(output_len);
+  for (size_t i = 0; i < output_len; ++i) {
+    if (outputs[i] != nullptr) {
+      fetches[i] = *outputs[i];
+    }
+  }
+
+  const RunOptions default_run_options;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->Run(run_options != nullptr ? *run_options : default_run_options,
+                                               *prepared_run->prepared_run_, feeds, &fetches));
+  for (size_t i = 0; i < output_len; ++i) {
+    if (outputs[i] == nullptr) {
+      outputs[i] = std::make_unique<OrtValue>(std::move(fetches[i])).release();
+    }
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API(void, OrtApis::ReleasePreparedRun, _Frees_ptr_opt_ OrtPreparedRun* prepared_run) {
+  delete prepared_run;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::CloneSession, _In_ const OrtSession* sess, _Outptr_ OrtSession** out) {
+  API_IMPL_BEGIN
+  const auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  std::unique_ptr<::onnxruntime::InferenceSession> clone;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->Clone(clone));
+  *out = reinterpret_cast<OrtSession*>(clone.release());
+  return nullptr;
+  API_IMPL_END
+}
+
+struct OrtSwappableSession {
+  std::unique_ptr<::onnxruntime::SwappableSession> session_;
+  explicit OrtSwappableSession(std::unique_ptr<::onnxruntime::SwappableSession>&& session)
+      : session_(std::move(session)) {}
+  OrtSwappableSession(const OrtSwappableSession&) = delete;
+  OrtSwappableSession& operator=(const OrtSwappableSession&) = delete;
+};
+
+ORT_API_STATUS_IMPL(OrtApis::CreateSwappableSession, _In_ const OrtEnv* env, _In_ const ORTCHAR_T* model_path,
+                    _In_opt_ const OrtSessionOptions* options, size_t max_warmup_shapes,
+                    int warmup_max_degree_of_parallelism, _Outptr_ OrtSwappableSession** out) {
+  API_IMPL_BEGIN
+  if (warmup_max_degree_of_parallelism < 0) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "warmup_max_degree_of_parallelism must not be negative");
+  }
+
+  // the sessions of all the models are created with a copy of the options
+  auto create_session = [env, session_options = options != nullptr ? *options : OrtSessionOptions()](
+                            const PathString& path,
+                            const std::unordered_map<std::string, const OrtValue*>& initializers,
+                            std::unique_ptr<::onnxruntime::InferenceSession>& session) -> Status {
+    OrtSessionOptions model_options = session_options;
+    for (const auto& [name, value] : initializers) {
+      // initializers the options already share are kept
+      if (model_options.value.initializers_to_share_map.count(name) == 0) {
+        ORT_RETURN_IF_ERROR(model_options.value.AddInitializer(name.c_str(), value));
+      }
+    }
+
+    OrtStatus* status = CreateSessionAndLoadModel(&model_options, env, path.c_str(), nullptr, 0, session);
+    if (status == nullptr) {
+      status = InitializeSession(&model_options, session);
+    }
+    auto result = ToStatus(status);
+    OrtApis::ReleaseStatus(status);
+    return result;
+  };
+
+  ::onnxruntime::SwappableSessionOptions swappable_options;
+  swappable_options.max_warmup_shapes = max_warmup_shapes;
+  swappable_options.warmup_max_degree_of_parallelism = warmup_max_degree_of_parallelism;
+  auto session = std::make_unique<::onnxruntime::SwappableSession>(std::move(create_session),
+                                                                   std::move(swappable_options));
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->Load(model_path));
+  *out = std::make_unique<OrtSwappableSession>(std::move(session)).release();
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SwappableSessionRun, _Inout_ OrtSwappableSession* session,
+                    _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** outputs) {
+  API_IMPL_BEGIN
+  const RunOptions default_run_options;
+  auto status = session->session_->Run(run_options != nullptr ? *run_options : default_run_options,
+                                       gsl::span<const char* const>(input_names, input_len),
+                                       gsl::span<const OrtValue* const>(inputs, input_len),
+                                       gsl::span<const char* const>(output_names, output_names_len),
+                                       gsl::span<OrtValue*>(outputs, output_names_len));
+  return ToOrtStatus(status);
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SwappableSessionSwap, _Inout_ OrtSwappableSession* session,
+                    _In_ const ORTCHAR_T* model_path) {
+  API_IMPL_BEGIN
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->session_->Swap(model_path));
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SwappableSessionWaitForSwap, _Inout_ OrtSwappableSession* session) {
+  API_IMPL_BEGIN
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->session_->WaitForSwap());
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API(void, OrtApis::ReleaseSwappableSession, _Frees_ptr_opt_ OrtSwappableSession* session) {
+  delete session;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::CreateEnsembleSession, _In_ const OrtEnv* env,
+                    _In_reads_(num_members) const char* const* member_names,
+                    _In_reads_(num_members) const ORTCHAR_T* const* member_paths, size_t num_members,
+                    _In_reads_(num_edges) const char* const* edge_producers,
+                    _In_reads_(num_edges) const char* const* edge_outputs,
+                    _In_reads_(num_edges) const char* const* edge_consumers,
+                    _In_reads_(num_edges) const char* const* edge_inputs, size_t num_edges,
+                    _In_opt_ const OrtSessionOptions* options, _Outptr_ OrtSession** out) {
+  API_IMPL_BEGIN
+#if !defined(ORT_MINIMAL_BUILD)
+  std::vector<::onnxruntime::EnsembleMember> members;
+  members.reserve(num_members);
+  for (size_t i = 0; i < num_members; ++i) {
+    if (member_names[i] == nullptr || member_paths[i] == nullptr) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "member names and paths cannot be NULL");
+    }
+    members.push_back({member_names[i], member_paths[i]});
+  }
+  std::vector<::onnxruntime::EnsembleEdge> edges;
+  edges.reserve(num_edges);
+  for (size_t i = 0; i < num_edges; ++i) {
+    if (edge_producers[i] == nullptr || edge_outputs[i] == nullptr || edge_consumers[i] == nullptr ||
+        edge_inputs[i] == nullptr) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "edge names cannot be NULL");
+    }
+    edges.push_back({edge_producers[i], edge_outputs[i], edge_consumers[i], edge_inputs[i]});
+  }
+
+  ONNX_NAMESPACE::ModelProto model_proto;
+  PathString model_uri;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(::onnxruntime::ComposeEnsemble(members, edges, model_proto, model_uri));
+
+  auto sess = std::make_unique<::onnxruntime::InferenceSession>(
+      options == nullptr ? onnxruntime::SessionOptions() : options->value, env->GetEnvironment());
+  if (options && !options->custom_op_domains_.empty()) {
+    ORT_API_RETURN_IF_STATUS_NOT_OK(sess->AddCustomOpDomains(options->custom_op_domains_));
+  }
+  ORT_API_RETURN_IF_STATUS_NOT_OK(sess->Load(std::move(model_proto), model_uri));
+  ORT_API_RETURN_IF_ERROR(InitializeSession(options, sess));
+  *out = reinterpret_cast<OrtSession*>(sess.release());
+  return nullptr;
+#else
+  ORT_UNUSED_PARAMETER(env);
+  ORT_UNUSED_PARAMETER(member_names);
+  ORT_UNUSED_PARAMETER(member_paths);
+  ORT_UNUSED_PARAMETER(num_members);
+  ORT_UNUSED_PARAMETER(edge_producers);
+  ORT_UNUSED_PARAMETER(edge_outputs);
+  ORT_UNUSED_PARAMETER(edge_consumers);
+  ORT_UNUSED_PARAMETER(edge_inputs);
+  ORT_UNUSED_PARAMETER(num_edges);
+  ORT_UNUSED_PARAMETER(options);
+  ORT_UNUSED_PARAMETER(out);
+
+  return OrtApis::CreateStatus(ORT_FAIL, "Ensembles are not supported in this build.");
+#endif
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::GetBoundOutputNames, _In_ const OrtIoBinding* binding_ptr, _In_ OrtAllocator* allocator,
                     _Out_ char** buffer, _Outptr_result_maybenull_ size_t** lengths, _Out_ size_t* count) {
   API_IMPL_BEGIN
@@ -1364,6 +1786,37 @@ ORT_API_STATUS_IMPL(OrtApis::SessionEndProfiling, _In_ OrtSession* sess, _Inout_
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionGetMetricsSnapshot, _In_ const OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  std::string snapshot;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->GetMetricsSnapshot(snapshot));
+  *out = StrDup(snapshot, allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetKernelDispatches, _In_ const OrtSession* sess,
+                    _Inout_ OrtAllocator* allocator, _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  std::string dispatches;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->GetKernelDispatches(dispatches));
+  *out = StrDup(dispatches, allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetStartupTimings, _In_ const OrtSession* sess,
+                    _Inout_ OrtAllocator* allocator, _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  *out = StrDup(session->GetStartupTimings(), allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::SessionGetModelMetadata, _In_ const OrtSession* sess,
                     _Outptr_ OrtModelMetadata** out) {
   API_IMPL_BEGIN
@@ -2196,6 +2649,16 @@ ORT_API_STATUS_IMPL(OrtApis::SessionGetProfilingStartTimeNs, _In_ const OrtSessi
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CompactArena, _Inout_ OrtSession* sess, _In_ const OrtMemoryInfo* mem_info) {
+  API_IMPL_BEGIN
+  if (mem_info == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "OrtMemoryInfo is null");
+  }
+  auto* session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  return ToOrtStatus(session->CompactMemoryArena(*mem_info));
+  API_IMPL_END
+}
+
 // End support for non-tensor types
 
 ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfg, _In_ size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes,
@@ -2230,6 +2693,16 @@ ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfgV2, _In_reads_(num_keys) const char*
       cfg->initial_growth_chunk_size_bytes = static_cast<int>(arena_config_values[i]);
     } else if (strcmp(arena_config_keys[i], "max_power_of_two_extend_bytes") == 0) {
       cfg->max_power_of_two_extend_bytes = static_cast<int64_t>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "slab_max_alloc_bytes") == 0) {
+      cfg->slab_max_alloc_bytes = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "slab_region_bytes") == 0) {
+      cfg->slab_region_bytes = static_cast<int64_t>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "slab_thread_cache_blocks") == 0) {
+      cfg->slab_thread_cache_blocks = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "huge_page_bytes") == 0) {
+      cfg->huge_page_bytes = static_cast<int64_t>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "numa_node") == 0) {
+      cfg->numa_node = static_cast<int>(arena_config_values[i]);
     } else {
       std::ostringstream oss;
       oss << "Invalid key found: " << arena_config_keys[i];
@@ -2721,6 +3194,35 @@ static constexpr OrtApi ort_api_1_to_17 = {
     &OrtApis::ShapeInferContext_SetOutputTypeShape,
     &OrtApis::SetSymbolicDimensions,
     &OrtApis::ReadOpAttr,
+    &OrtApis::CompactArena,
+    &OrtApis::CreateAndRegisterActivationPool,
+    &OrtApis::BindOutputToRingBuffer,
+    &OrtApis::CreateRunPipeline,
+    &OrtApis::RunPipelineSubmit,
+    &OrtApis::RunPipelineWait,
+    &OrtApis::ReleaseRunPipeline,
+    &OrtApis::CreateRequestBatcher,
+    &OrtApis::RequestBatcherSubmit,
+    &OrtApis::ReleaseRequestBatcher,
+    &OrtApis::KernelContext_ParallelFor,
+    &OrtApis::KernelContext_GetDegreeOfParallelism,
+    &OrtApis::SessionGetMetricsSnapshot,
+    &OrtApis::SetTraceSpanFunction,
+    &OrtApis::SessionGetKernelDispatches,
+    &OrtApis::SessionGetStartupTimings,
+    &OrtApis::RunBatch,
+    &OrtApis::CreatePreparedRun,
+    &OrtApis::RunPrepared,
+    &OrtApis::ReleasePreparedRun,
+    &OrtApis::CloneSession,
+    &OrtApis::CreateSwappableSession,
+    &OrtApis::SwappableSessionRun,
+    &OrtApis::SwappableSessionSwap,
+    &OrtApis::SwappableSessionWaitForSwap,
+    &OrtApis::ReleaseSwappableSession,
+    &OrtApis::CreateEnsembleSession,
+    &OrtApis::KernelContext_GetScratchBuffer,
+    &OrtApis::PrePackedWeights_AddBuffer,
 };
 
 // OrtApiBase can never change as there is no way to know what version of OrtApiBase is returned by OrtGetApiBase.
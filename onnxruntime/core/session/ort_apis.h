@@ -501,4 +501,97 @@ ORT_API_STATUS_IMPL(ShapeInferContext_SetOutputTypeShape, _In_ const OrtShapeInf
 ORT_API_STATUS_IMPL(SetSymbolicDimensions, _In_ OrtTensorTypeAndShapeInfo* info, _In_ const char* dim_params[], _In_ size_t dim_params_length);
 ORT_API_STATUS_IMPL(ReadOpAttr, _In_ const OrtOpAttr* op_attr, _In_ OrtOpAttrType type, _Inout_ void* data, _In_ size_t len, _Out_ size_t* out);
 
+ORT_API_STATUS_IMPL(CompactArena, _Inout_ OrtSession* sess, _In_ const OrtMemoryInfo* mem_info);
+
+ORT_API_STATUS_IMPL(CreateAndRegisterActivationPool, _Inout_ OrtEnv* env, _In_ const OrtMemoryInfo* mem_info,
+                    size_t max_bytes, int64_t admission_timeout_ms);
+
+ORT_API_STATUS_IMPL(BindOutputToRingBuffer, _Inout_ OrtIoBinding* binding_ptr, _In_ const char* name,
+                    _In_ const OrtMemoryInfo* mem_info, _Inout_ void* base, size_t capacity_bytes, size_t stride_bytes,
+                    _In_ OrtRingBufferPositionFn position_fn, _In_opt_ void* user_data);
+
+ORT_API_STATUS_IMPL(CreateRunPipeline, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    size_t depth, _Outptr_ OrtRunPipeline** out);
+ORT_API_STATUS_IMPL(RunPipelineSubmit, _Inout_ OrtRunPipeline* pipeline,
+                    _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                    _In_ RunAsyncCallbackFn callback, _In_opt_ void* user_data);
+ORT_API_STATUS_IMPL(RunPipelineWait, _Inout_ OrtRunPipeline* pipeline);
+ORT_API(void, ReleaseRunPipeline, _Frees_ptr_opt_ OrtRunPipeline* pipeline);
+
+ORT_API_STATUS_IMPL(CreateRequestBatcher, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    size_t batch_axis, size_t max_batch_size, int64_t max_delay_us,
+                    _In_reads_opt_(num_padding_buckets) const int64_t* padding_buckets, size_t num_padding_buckets,
+                    _Outptr_ OrtRequestBatcher** out);
+ORT_API_STATUS_IMPL(RequestBatcherSubmit, _Inout_ OrtRequestBatcher* batcher,
+                    _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                    _In_ RunAsyncCallbackFn callback, _In_opt_ void* user_data);
+ORT_API(void, ReleaseRequestBatcher, _Frees_ptr_opt_ OrtRequestBatcher* batcher);
+
+ORT_API_STATUS_IMPL(KernelContext_ParallelFor, _In_ const OrtKernelContext* context, _In_ void (*fn)(void*, size_t),
+                    _In_ size_t total, _In_ size_t num_batch, _In_opt_ void* usr_data);
+ORT_API_STATUS_IMPL(KernelContext_GetDegreeOfParallelism, _In_ const OrtKernelContext* context, _Out_ int* out);
+
+ORT_API_STATUS_IMPL(SessionGetMetricsSnapshot, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out);
+
+ORT_API_STATUS_IMPL(SetTraceSpanFunction, _Inout_ OrtSessionOptions* options,
+                    _In_opt_ OrtTraceSpanFunction trace_span_function, _In_opt_ void* trace_span_param);
+
+ORT_API_STATUS_IMPL(SessionGetKernelDispatches, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out);
+
+ORT_API_STATUS_IMPL(SessionGetStartupTimings, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out);
+
+ORT_API_STATUS_IMPL(RunBatch, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len* batch_size) const OrtValue* const* inputs, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len* batch_size) OrtValue** outputs, size_t batch_size,
+                    _Out_writes_all_(batch_size) OrtStatus** statuses);
+
+ORT_API_STATUS_IMPL(CreatePreparedRun, _Inout_ OrtSession* session,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Outptr_ OrtPreparedRun** out);
+ORT_API_STATUS_IMPL(RunPrepared, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                    _In_ const OrtPreparedRun* prepared_run,
+                    _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                    _Inout_updates_all_(output_len) OrtValue** outputs, size_t output_len);
+ORT_API(void, ReleasePreparedRun, _Frees_ptr_opt_ OrtPreparedRun* prepared_run);
+
+ORT_API_STATUS_IMPL(CloneSession, _In_ const OrtSession* session, _Outptr_ OrtSession** out);
+
+ORT_API_STATUS_IMPL(CreateSwappableSession, _In_ const OrtEnv* env, _In_ const ORTCHAR_T* model_path,
+                    _In_opt_ const OrtSessionOptions* options, size_t max_warmup_shapes,
+                    int warmup_max_degree_of_parallelism, _Outptr_ OrtSwappableSession** out);
+ORT_API_STATUS_IMPL(SwappableSessionRun, _Inout_ OrtSwappableSession* session,
+                    _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** outputs);
+ORT_API_STATUS_IMPL(SwappableSessionSwap, _Inout_ OrtSwappableSession* session, _In_ const ORTCHAR_T* model_path);
+ORT_API_STATUS_IMPL(SwappableSessionWaitForSwap, _Inout_ OrtSwappableSession* session);
+ORT_API(void, ReleaseSwappableSession, _Frees_ptr_opt_ OrtSwappableSession* session);
+
+ORT_API_STATUS_IMPL(CreateEnsembleSession, _In_ const OrtEnv* env,
+                    _In_reads_(num_members) const char* const* member_names,
+                    _In_reads_(num_members) const ORTCHAR_T* const* member_paths, size_t num_members,
+                    _In_reads_(num_edges) const char* const* edge_producers,
+                    _In_reads_(num_edges) const char* const* edge_outputs,
+                    _In_reads_(num_edges) const char* const* edge_consumers,
+                    _In_reads_(num_edges) const char* const* edge_inputs, size_t num_edges,
+                    _In_opt_ const OrtSessionOptions* options, _Outptr_ OrtSession** out);
+
+ORT_API_STATUS_IMPL(KernelContext_GetScratchBuffer, _In_ const OrtKernelContext* context,
+                    _In_ const OrtMemoryInfo* mem_info, _In_ size_t size, _Outptr_result_maybenull_ void** out);
+ORT_API_STATUS_IMPL(PrePackedWeights_AddBuffer, _Inout_ OrtPrePackedWeights* prepacked_weights, _In_ void* buffer,
+                    _In_ size_t size);
+
 }  // namespace OrtApis
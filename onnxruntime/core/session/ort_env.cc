@@ -110,3 +110,8 @@ onnxruntime::common::Status OrtEnv::UnregisterAllocator(const OrtMemoryInfo& mem
 onnxruntime::common::Status OrtEnv::CreateAndRegisterAllocatorV2(const std::string& provider_type, const OrtMemoryInfo& mem_info, const std::unordered_map<std::string, std::string>& options, const OrtArenaCfg* arena_cfg) {
   return value_->CreateAndRegisterAllocatorV2(provider_type, mem_info, options, arena_cfg);
 }
+
+onnxruntime::common::Status OrtEnv::CreateAndRegisterActivationPool(const OrtMemoryInfo& mem_info, size_t max_bytes,
+                                                                    int64_t admission_timeout_ms) {
+  return value_->CreateAndRegisterActivationPool(mem_info, max_bytes, admission_timeout_ms);
+}
@@ -65,6 +65,12 @@ struct OrtEnv {
   ~OrtEnv();
   onnxruntime::common::Status CreateAndRegisterAllocatorV2(const std::string& provider_type, const OrtMemoryInfo& mem_info, const std::unordered_map<std::string, std::string>& options, const OrtArenaCfg* arena_cfg = nullptr);
 
+  /**
+   * Creates and registers an activation pool for sharing memory pattern buffers between multiple sessions.
+   */
+  onnxruntime::common::Status CreateAndRegisterActivationPool(const OrtMemoryInfo& mem_info, size_t max_bytes,
+                                                              int64_t admission_timeout_ms);
+
  private:
   static std::unique_ptr<OrtEnv> p_instance_;
   static onnxruntime::OrtMutex m_;
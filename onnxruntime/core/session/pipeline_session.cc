@@ -0,0 +1,374 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/pipeline_session.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "core/framework/execution_provider.h"
+#include "core/framework/tensor.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/graph/model.h"
+#include "core/platform/ort_mutex.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+namespace {
+// Calls func for each input of a node that holds a value, including the values of outer scopes its subgraphs read.
+template <typename TFunc>
+void ForEachInput(const Node& node, TFunc func) {
+  for (const auto* defs : {&node.InputDefs(), &node.ImplicitInputDefs()}) {
+    for (const NodeArg* input : *defs) {
+      if (input->Exists()) {
+        func(input->Name());
+      }
+    }
+  }
+}
+
+// Assigns each node, in topological order, to one of num_stages contiguous stages so that the stages hold about the
+// same bytes of initializers. Every stage gets at least one node.
+std::vector<size_t> AssignStages(const Graph& graph, gsl::span<const NodeIndex> node_order, size_t num_stages) {
+  std::vector<size_t> costs;
+  costs.reserve(node_order.size());
+  std::unordered_set<std::string> initializers_counted;
+  size_t total_cost = 0;
+  for (NodeIndex node_index : node_order) {
+    // a node without weights still costs a little, so that a graph without initializers is split by nodes
+    size_t cost = 1;
+    ForEachInput(*graph.GetNode(node_index), [&](const std::string& name) {
+      const ONNX_NAMESPACE::TensorProto* initializer = nullptr;
+      size_t size_in_bytes = 0;
+      if (graph.GetInitializedTensor(name, initializer) && initializers_counted.insert(name).second &&
+          utils::GetSizeInBytesFromTensorProto<0>(*initializer, &size_in_bytes).IsOK()) {
+        cost += size_in_bytes;
+      }
+    });
+    costs.push_back(cost);
+    total_cost += cost;
+  }
+
+  std::vector<size_t> node_stages(node_order.size());
+  size_t stage = 0;
+  size_t accumulated_cost = 0;
+  for (size_t i = 0; i < node_order.size(); ++i) {
+    node_stages[i] = stage;
+    accumulated_cost += costs[i];
+    const size_t remaining_nodes = node_order.size() - i - 1;
+    const size_t remaining_stages = num_stages - stage - 1;
+    if (remaining_stages > 0 &&
+        (accumulated_cost * num_stages >= total_cost * (stage + 1) || remaining_nodes == remaining_stages)) {
+      ++stage;
+    }
+  }
+
+  return node_stages;
+}
+}  // namespace
+
+PipelineSession::PipelineSession(PipelineSessionOptions options) : options_(std::move(options)) {}
+
+PipelineSession::~PipelineSession() = default;
+
+Status PipelineSession::Create(const SessionOptions& session_options, const Environment& env,
+                               const PathString& model_uri,
+                               std::vector<std::unique_ptr<IExecutionProvider>> stage_providers,
+                               PipelineSessionOptions options, std::unique_ptr<PipelineSession>& pipeline_session) {
+  const size_t num_stages = stage_providers.size();
+  ORT_RETURN_IF(num_stages == 0, "A pipeline needs at least one stage");
+  ORT_RETURN_IF(options.num_micro_batches == 0, "num_micro_batches must be positive");
+  ORT_RETURN_IF(std::any_of(stage_providers.begin(), stage_providers.end(), [](const auto& p) { return !p; }),
+                "The execution provider of a stage is null");
+
+  ONNX_NAMESPACE::ModelProto model_proto;
+  ORT_RETURN_IF_ERROR(Model::Load(model_uri, model_proto));
+
+  // the fields of the model that every stage keeps
+  ONNX_NAMESPACE::ModelProto stage_template;
+  stage_template.set_ir_version(model_proto.ir_version());
+  *stage_template.mutable_opset_import() = model_proto.opset_import();
+  *stage_template.mutable_functions() = model_proto.functions();
+  stage_template.set_producer_name(model_proto.producer_name());
+  stage_template.set_producer_version(model_proto.producer_version());
+  stage_template.set_domain(model_proto.domain());
+  stage_template.set_model_version(model_proto.model_version());
+
+  std::shared_ptr<Model> model;
+  ORT_RETURN_IF_ERROR(Model::Load(std::move(model_proto), model_uri, model, nullptr,
+                                  logging::LoggingManager::DefaultLogger()));
+  const Graph& graph = model->MainGraph();
+
+  GraphViewer graph_viewer(graph);
+  const auto& node_order = graph_viewer.GetNodesInTopologicalOrder();
+  ORT_RETURN_IF(node_order.size() < num_stages, "The model has ", node_order.size(), " nodes, fewer than the ",
+                num_stages, " stages");
+  const std::vector<size_t> node_stages = AssignStages(graph, node_order, num_stages);
+
+  // the last stage that reads each value
+  std::unordered_map<std::string, size_t> last_consumer_stages;
+  for (size_t i = 0; i < node_order.size(); ++i) {
+    ForEachInput(*graph.GetNode(node_order[i]), [&](const std::string& name) {
+      auto& last_stage = last_consumer_stages[name];
+      last_stage = std::max(last_stage, node_stages[i]);
+    });
+  }
+
+  std::unordered_set<std::string> graph_outputs;
+  for (const NodeArg* output : graph.GetOutputs()) {
+    ORT_RETURN_IF(graph.IsInitializedTensor(output->Name()), "Output ", output->Name(),
+                  " is an initializer, which a pipeline doesn't produce");
+    graph_outputs.insert(output->Name());
+  }
+
+  auto session = std::unique_ptr<PipelineSession>(new PipelineSession(std::move(options)));
+  for (const NodeArg* output : graph.GetOutputs()) {
+    session->graph_output_names_.push_back(output->Name());
+  }
+
+  for (size_t s = 0; s < num_stages; ++s) {
+    ONNX_NAMESPACE::ModelProto stage_proto = stage_template;
+    auto& graph_proto = *stage_proto.mutable_graph();
+    graph_proto.set_name(graph.Name() + "_stage_" + std::to_string(s));
+
+    std::unordered_set<std::string> produced;
+    std::unordered_set<std::string> added;
+    std::vector<std::string> input_names;
+    std::vector<std::string> produced_names;
+    for (size_t i = 0; i < node_order.size(); ++i) {
+      if (node_stages[i] != s) {
+        continue;
+      }
+
+      const Node& node = *graph.GetNode(node_order[i]);
+      node.ToProto(*graph_proto.add_node(), /*update_subgraphs*/ true);
+      ForEachInput(node, [&](const std::string& name) {
+        if (produced.count(name) > 0 || !added.insert(name).second) {
+          return;
+        }
+        const ONNX_NAMESPACE::TensorProto* initializer = nullptr;
+        if (graph.GetInitializedTensor(name, initializer)) {
+          *graph_proto.add_initializer() = *initializer;
+        } else {
+          input_names.push_back(name);
+        }
+      });
+      for (const NodeArg* output : node.OutputDefs()) {
+        if (output->Exists()) {
+          produced.insert(output->Name());
+          produced_names.push_back(output->Name());
+        }
+      }
+    }
+
+    Stage stage;
+    const OrtDevice stage_device = stage_providers[s]->GetOrtDeviceByMemType(OrtMemTypeDefault);
+    for (const auto& name : input_names) {
+      *graph_proto.add_input() = graph.GetNodeArg(name)->ToProto();
+    }
+    for (const auto& name : produced_names) {
+      auto last_consumer = last_consumer_stages.find(name);
+      const bool is_graph_output = graph_outputs.count(name) > 0;
+      if (is_graph_output || (last_consumer != last_consumer_stages.end() && last_consumer->second > s)) {
+        *graph_proto.add_output() = graph.GetNodeArg(name)->ToProto();
+        stage.output_names.push_back(name);
+        stage.output_devices.push_back(is_graph_output ? OrtDevice() : stage_device);
+      } else {
+        *graph_proto.add_value_info() = graph.GetNodeArg(name)->ToProto();
+      }
+    }
+    for (const auto& name : input_names) {
+      if (last_consumer_stages[name] == s && graph_outputs.count(name) == 0) {
+        stage.released_names.push_back(name);
+      }
+    }
+    stage.input_names = std::move(input_names);
+
+    SessionOptions stage_session_options = session_options;
+    stage_session_options.session_logid += "_stage_" + std::to_string(s);
+    stage.session = std::make_unique<InferenceSession>(stage_session_options, env);
+    ORT_RETURN_IF_ERROR(stage.session->RegisterExecutionProvider(std::move(stage_providers[s])));
+    ORT_RETURN_IF_ERROR(stage.session->Load(std::move(stage_proto), model_uri));
+    ORT_RETURN_IF_ERROR(stage.session->Initialize());
+    session->stages_.push_back(std::move(stage));
+  }
+
+  pipeline_session = std::move(session);
+  return Status::OK();
+}
+
+Status PipelineSession::RunStage(const RunOptions& run_options, size_t stage_idx, NameMLValMap& values) const {
+  const Stage& stage = stages_[stage_idx];
+  std::vector<OrtValue> feeds;
+  feeds.reserve(stage.input_names.size());
+  for (const auto& name : stage.input_names) {
+    auto value = values.find(name);
+    ORT_RETURN_IF(value == values.end(), "Missing input ", name, " of stage ", stage_idx);
+    feeds.push_back(value->second);
+  }
+
+  std::vector<OrtValue> fetches;
+  ORT_RETURN_IF_ERROR(stage.session->Run(run_options, stage.input_names, feeds, stage.output_names, &fetches,
+                                         &stage.output_devices));
+
+  // release the values no later stage reads, e.g. the activations on the device of the previous stage
+  for (const auto& name : stage.released_names) {
+    values.erase(name);
+  }
+  for (size_t i = 0; i < fetches.size(); ++i) {
+    values[stage.output_names[i]] = std::move(fetches[i]);
+  }
+
+  return Status::OK();
+}
+
+Status PipelineSession::ConcatMicroBatches(const std::string& name, gsl::span<const NameMLValMap> micro_batch_values,
+                                           OrtValue& output) const {
+  if (micro_batch_values.size() == 1) {
+    output = micro_batch_values[0].at(name);
+    return Status::OK();
+  }
+
+  const Tensor& first = micro_batch_values[0].at(name).Get<Tensor>();
+  ORT_RETURN_IF(first.Shape().NumDimensions() == 0, "Output ", name, " has no batch axis");
+  ORT_RETURN_IF(first.IsDataTypeString(), "Output ", name, " is a string tensor, which can't be concatenated");
+  const auto inner_shape = first.Shape().Slice(1);
+
+  int64_t batch_size = 0;
+  for (const auto& values : micro_batch_values) {
+    const Tensor& tensor = values.at(name).Get<Tensor>();
+    ORT_RETURN_IF_NOT(tensor.Location().device.Type() == OrtDevice::CPU, "Output ", name, " is not on CPU");
+    ORT_RETURN_IF_NOT(tensor.DataType() == first.DataType() && tensor.Shape().NumDimensions() > 0 &&
+                          tensor.Shape().Slice(1) == inner_shape,
+                      "Micro-batches of output ", name, " differ in type or in dimensions other than the batch");
+    batch_size += tensor.Shape()[0];
+  }
+
+  TensorShapeVector dims = first.Shape().AsShapeVector();
+  dims[0] = batch_size;
+  auto cpu_allocator = stages_.back().session->GetSessionState().GetAllocator(OrtDevice());
+  ORT_RETURN_IF_NOT(cpu_allocator, "Failed to find a CPU allocator for the outputs");
+  Tensor::InitOrtValue(first.DataType(), TensorShape(dims), cpu_allocator, output);
+
+  auto* dst = static_cast<uint8_t*>(output.GetMutable<Tensor>()->MutableDataRaw());
+  for (const auto& values : micro_batch_values) {
+    const Tensor& tensor = values.at(name).Get<Tensor>();
+    std::memcpy(dst, tensor.DataRaw(), tensor.SizeInBytes());
+    dst += tensor.SizeInBytes();
+  }
+
+  return Status::OK();
+}
+
+Status PipelineSession::Run(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                            gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+                            std::vector<OrtValue>& fetches) {
+  ORT_RETURN_IF_NOT(feed_names.size() == feeds.size(), "Expected as many feeds as feed names");
+  for (const auto& name : output_names) {
+    ORT_RETURN_IF(std::find(graph_output_names_.begin(), graph_output_names_.end(), name) == graph_output_names_.end(),
+                  "Output ", name, " is not an output of the model");
+  }
+
+  int64_t batch_size = -1;
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    ORT_RETURN_IF_NOT(feeds[i].IsTensor(), "Input ", feed_names[i], " is not a tensor");
+    const Tensor& tensor = feeds[i].Get<Tensor>();
+    ORT_RETURN_IF(tensor.Shape().NumDimensions() == 0, "Input ", feed_names[i], " has no batch axis");
+    ORT_RETURN_IF(batch_size >= 0 && tensor.Shape()[0] != batch_size, "All inputs must have the same batch size");
+    batch_size = tensor.Shape()[0];
+  }
+
+  // split the inputs into micro-batches that view rows of them
+  const size_t max_micro_batches = batch_size > 0 ? static_cast<size_t>(batch_size) : 1;
+  const size_t num_micro_batches = std::min(options_.num_micro_batches, max_micro_batches);
+  std::vector<NameMLValMap> micro_batch_values(num_micro_batches);
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    if (num_micro_batches == 1) {
+      micro_batch_values[0][feed_names[i]] = feeds[i];
+      continue;
+    }
+
+    const Tensor& tensor = feeds[i].Get<Tensor>();
+    ORT_RETURN_IF(tensor.IsDataTypeString(), "Input ", feed_names[i], " is a string tensor, which can't be split");
+    const size_t row_bytes = batch_size > 0 ? tensor.SizeInBytes() / static_cast<size_t>(batch_size) : 0;
+    TensorShapeVector dims = tensor.Shape().AsShapeVector();
+    for (size_t m = 0; m < num_micro_batches; ++m) {
+      const int64_t begin = batch_size * static_cast<int64_t>(m) / static_cast<int64_t>(num_micro_batches);
+      const int64_t end = batch_size * static_cast<int64_t>(m + 1) / static_cast<int64_t>(num_micro_batches);
+      dims[0] = end - begin;
+      Tensor::InitOrtValue(tensor.DataType(), TensorShape(dims), const_cast<void*>(tensor.DataRaw()),
+                           tensor.Location(), micro_batch_values[m][feed_names[i]],
+                           static_cast<ptrdiff_t>(begin * row_bytes));
+    }
+  }
+
+  // stage s runs micro-batch m once stage s - 1 completed it. only one stage works on a micro-batch at a time, and
+  // the mutex orders the writes of a stage to the values of a micro-batch before the reads of the next stage.
+  OrtMutex mutex;
+  OrtCondVar cv;
+  std::vector<size_t> completed(stages_.size(), 0);  // GUARDED_BY(mutex)
+  Status status;                                      // GUARDED_BY(mutex)
+
+  const auto run_stage = [&](size_t s) {
+    for (size_t m = 0; m < num_micro_batches; ++m) {
+      {
+        std::unique_lock<OrtMutex> lock(mutex);
+        cv.wait(lock, [&]() { return !status.IsOK() || s == 0 || completed[s - 1] > m; });
+        if (!status.IsOK()) {
+          return;
+        }
+      }
+
+      Status stage_status;
+      ORT_TRY {
+        stage_status = RunStage(run_options, s, micro_batch_values[m]);
+      }
+      ORT_CATCH(const std::exception& ex) {
+        ORT_HANDLE_EXCEPTION([&]() {
+          stage_status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+        });
+      }
+
+      {
+        std::lock_guard<OrtMutex> lock(mutex);
+        if (!stage_status.IsOK()) {
+          if (status.IsOK()) {
+            status = stage_status;
+          }
+        } else {
+          ++completed[s];
+        }
+      }
+      cv.notify_all();
+      if (!stage_status.IsOK()) {
+        return;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(stages_.size() - 1);
+  for (size_t s = 1; s < stages_.size(); ++s) {
+    threads.emplace_back(run_stage, s);
+  }
+  run_stage(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ORT_RETURN_IF_ERROR(status);
+
+  fetches.clear();
+  fetches.resize(output_names.size());
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    ORT_RETURN_IF_ERROR(ConcatMicroBatches(output_names[i], micro_batch_values, fetches[i]));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
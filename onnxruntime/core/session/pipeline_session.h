@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/common/path_string.h"
+#include "core/common/status.h"
+#include "core/framework/framework_common.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+
+namespace onnxruntime {
+class Environment;
+class IExecutionProvider;
+class InferenceSession;
+struct SessionOptions;
+
+struct PipelineSessionOptions {
+  // number of micro-batches a run splits its inputs into along axis 0. stage s runs micro-batch m while stage s + 1
+  // runs micro-batch m - 1, so more micro-batches keep more devices busy, at the cost of smaller kernels.
+  size_t num_micro_batches = 4;
+};
+
+/**
+ * Pipeline-parallel inference of a model that doesn't fit on one device.
+ *
+ * The model is split into contiguous stages in topological order, one per execution provider, balanced by the bytes
+ * of initializers each stage holds. Each stage is a session of its own with one execution provider, e.g. the CUDA
+ * execution provider of one device, so the weights of a stage live on its device only.
+ *
+ * A run splits its inputs into micro-batches along axis 0 and runs them through the stages concurrently, one thread
+ * per stage. The values a stage passes to the next ones stay on its device and are copied to the device of the next
+ * stage as its inputs, peer to peer if the devices allow it. The outputs of the model are on CPU, concatenated along
+ * axis 0, so every input and output must have the batch on axis 0.
+ */
+class PipelineSession {
+ public:
+  static Status Create(const SessionOptions& session_options, const Environment& env, const PathString& model_uri,
+                       std::vector<std::unique_ptr<IExecutionProvider>> stage_providers,
+                       PipelineSessionOptions options, std::unique_ptr<PipelineSession>& pipeline_session);
+
+  ~PipelineSession();
+
+  size_t NumStages() const { return stages_.size(); }
+  const InferenceSession& GetStageSession(size_t stage) const { return *stages_[stage].session; }
+
+  // The outputs are returned in the order of the output names, which must be outputs of the model.
+  Status Run(const RunOptions& run_options, gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+             gsl::span<const std::string> output_names, std::vector<OrtValue>& fetches);
+
+ private:
+  struct Stage {
+    std::unique_ptr<InferenceSession> session;
+    std::vector<std::string> input_names;
+    std::vector<std::string> output_names;
+    // on the device of the stage, or on CPU for the outputs of the model
+    std::vector<OrtDevice> output_devices;
+    // the values that no later stage reads once the stage ran
+    std::vector<std::string> released_names;
+  };
+
+  explicit PipelineSession(PipelineSessionOptions options);
+
+  // Runs a stage on the values of a micro-batch and adds its outputs to them.
+  Status RunStage(const RunOptions& run_options, size_t stage_idx, NameMLValMap& values) const;
+  Status ConcatMicroBatches(const std::string& name, gsl::span<const NameMLValMap> micro_batch_values,
+                            OrtValue& output) const;
+
+  const PipelineSessionOptions options_;
+  std::vector<Stage> stages_;
+  std::vector<std::string> graph_output_names_;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PipelineSession);
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/prepared_run.h"
+
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+PreparedRun::PreparedRun(const InferenceSession& session, InferenceSession& run_session, FeedsFetchesInfo info,
+                         std::vector<FeedInfo> feeds)
+    : session_(session), run_session_(run_session), info_(std::move(info)), feeds_(std::move(feeds)) {
+}
+
+Status PreparedRun::ValidateFeeds(gsl::span<const OrtValue> feeds) const {
+  if (feeds.size() != feeds_.size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The run was prepared for ", feeds_.size(),
+                           " feeds but got ", feeds.size(), ".");
+  }
+
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    const FeedInfo& expected = feeds_[i];
+    if (!feeds[i].IsTensor()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The feed for input '", info_.feed_names[i],
+                             "' of a prepared run must be a tensor.");
+    }
+    const Tensor& tensor = feeds[i].Get<Tensor>();
+    if (tensor.DataType() != expected.type || tensor.Shape() != expected.shape ||
+        tensor.Location().device != expected.device) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The feed for input '", info_.feed_names[i],
+                             "' is a ", DataTypeImpl::ToString(tensor.DataType()), " tensor of shape ",
+                             tensor.Shape(), " on ", tensor.Location().device.ToString(),
+                             " but the run was prepared for a ", DataTypeImpl::ToString(expected.type),
+                             " tensor of shape ", expected.shape, " on ", expected.device.ToString(), ".");
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
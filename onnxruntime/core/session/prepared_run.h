@@ -0,0 +1,64 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/common/status.h"
+#include "core/framework/data_types.h"
+#include "core/framework/feeds_fetches_manager.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/tensor_shape.h"
+
+namespace onnxruntime {
+class InferenceSession;
+
+/**
+ * A Run prepared once for fixed feed and fetch names, and feeds of fixed types, shapes and devices.
+ *
+ * Creating it resolves the names, validates the feeds against the model and looks up the shape specialization of
+ * the session, which InferenceSession::Run otherwise does on every call. A prepared Run only checks that its feeds
+ * match the prepared ones, so that the feeds of a call differ from those of the previous one by their data only.
+ * The memory pattern of the prepared shapes is then found in the cache of the session state on every call.
+ *
+ * Created with InferenceSession::PrepareRun, it must not outlive the session. Several threads may run it at once
+ * if the session supports concurrent runs.
+ */
+class PreparedRun {
+ public:
+  // what a feed of a prepared run must be, except its data
+  struct FeedInfo {
+    MLDataType type;
+    TensorShape shape;
+    OrtDevice device;
+  };
+
+  // session is the one creating the run, run_session the one it runs on: session or its specialization for the
+  // shapes of the feeds. info is resolved for run_session.
+  PreparedRun(const InferenceSession& session, InferenceSession& run_session, FeedsFetchesInfo info,
+              std::vector<FeedInfo> feeds);
+
+  gsl::span<const std::string> GetFeedNames() const { return info_.feed_names; }
+  gsl::span<const std::string> GetFetchNames() const { return info_.output_names; }
+  const FeedsFetchesInfo& GetFeedsFetchesInfo() const { return info_; }
+  const InferenceSession& GetSession() const { return session_; }
+  InferenceSession& GetRunSession() const { return run_session_; }
+
+  // Checks that feeds are tensors of the types, shapes and devices the run was prepared for, in the order of the
+  // feed names
+  Status ValidateFeeds(gsl::span<const OrtValue> feeds) const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PreparedRun);
+
+ private:
+  const InferenceSession& session_;
+  InferenceSession& run_session_;
+  const FeedsFetchesInfo info_;
+  const std::vector<FeedInfo> feeds_;
+};
+
+}  // namespace onnxruntime
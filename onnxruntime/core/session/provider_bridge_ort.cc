@@ -17,6 +17,7 @@
 #include "core/framework/TensorSeq.h"
 #include "core/framework/provider_options.h"
 #include "core/framework/fallback_cpu_capability.h"
+#include "core/framework/kernel_dispatch.h"
 #include "core/framework/random_generator.h"
 #include "core/graph/model.h"
 #include "core/platform/env.h"
@@ -244,6 +245,11 @@ struct ProviderHostImpl : ProviderHost {
 
   std::string GetEnvironmentVar(const std::string& var_name) override { return Env::Default().GetEnvironmentVar(var_name); }
 
+  bool IsRecordingKernelDispatch() noexcept override { return onnxruntime::IsRecordingKernelDispatch(); }
+  void RecordKernelDispatch(const char* key, const char* value) override {
+    onnxruntime::RecordKernelDispatch(key, value);
+  }
+
   unsigned int GetThreadId() override { return onnxruntime::logging::GetThreadId(); }
   unsigned int GetProcessId() override { return onnxruntime::logging::GetProcessId(); }
 
@@ -906,6 +912,8 @@ struct ProviderHostImpl : ProviderHost {
   bool OpKernelContext__GetUseDeterministicCompute(const OpKernelContext* p) override { return p->GetUseDeterministicCompute(); }
   bool OpKernelContext__TryGetInferredOutputShape(const OpKernelContext* p, int index, TensorShape& shape) override { return p->TryGetInferredOutputShape(index, shape); }
   bool OpKernelContext__TryGetInferredInputShape(const OpKernelContext* p, int index, TensorShape& shape) override { return p->TryGetInferredInputShape(index, shape); }
+  bool OpKernelContext__IsInputDeadAfterKernel(const OpKernelContext* p, int index) override { return p->IsInputDeadAfterKernel(index); }
+  Tensor* OpKernelContext__OutputMayReuseInput(OpKernelContext* p, int output_index, int input_index, const TensorShape& shape) override { return p->OutputMayReuseInput(output_index, input_index, shape); }
   Stream* OpKernelContext__GetComputeStream(const OpKernelContext* p) override { return p->GetComputeStream(); }
 
   // OpKernelInfo (wrapped)
@@ -1336,6 +1344,11 @@ OrtCUDAProviderOptionsV2 OrtCUDAProviderOptionsToOrtCUDAProviderOptionsV2(const
   cuda_options_converted.cudnn_conv1d_pad_to_nc1d = 0;
   cuda_options_converted.enable_skip_layer_norm_strict_mode = 0;
   cuda_options_converted.use_ep_level_unified_stream = 0;
+  cuda_options_converted.cudnn_conv_algo_cache_path = nullptr;
+  cuda_options_converted.cuda_graph_max_count = 8;
+  cuda_options_converted.use_cuda_mempool = 0;
+  cuda_options_converted.cuda_mempool_release_threshold = std::numeric_limits<size_t>::max();
+  cuda_options_converted.weight_streaming_budget = 0;
 
   return cuda_options_converted;
 }
@@ -1409,6 +1422,7 @@ OrtTensorRTProviderOptionsV2 OrtTensorRTProviderOptionsToOrtTensorRTProviderOpti
   trt_options_converted.trt_profile_max_shapes = "";
   trt_options_converted.trt_profile_opt_shapes = "";
   trt_options_converted.trt_cuda_graph_enable = 0;
+  trt_options_converted.trt_background_engine_build = 0;
 
   return trt_options_converted;
 }
@@ -2065,6 +2079,10 @@ ORT_API_STATUS_IMPL(OrtApis::GetCUDAProviderOptionsByName,
 
 ORT_API(void, OrtApis::ReleaseCUDAProviderOptions, _Frees_ptr_opt_ OrtCUDAProviderOptionsV2* ptr) {
 #ifdef USE_CUDA
+  if (ptr != nullptr) {
+    delete[] ptr->cudnn_conv_algo_cache_path;
+  }
+
   std::unique_ptr<OrtCUDAProviderOptionsV2> p(ptr);
 #else
   ORT_UNUSED_PARAMETER(ptr);
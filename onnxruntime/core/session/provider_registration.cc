@@ -141,6 +141,10 @@ ORT_API_STATUS_IMPL(OrtApis::SessionOptionsAppendExecutionProvider,
     if (options->value.config_options.TryGetConfigEntry("preferredLayout", preferred_layout)) {
       provider_options["preferred_layout"] = preferred_layout;
     }
+    std::string enable_graph_capture;
+    if (options->value.config_options.TryGetConfigEntry("enableGraphCapture", enable_graph_capture)) {
+      provider_options["enable_graph_capture"] = enable_graph_capture;
+    }
     options->provider_factories.push_back(JsProviderFactoryCreator::Create(provider_options));
 #else
     status = create_not_supported_status();
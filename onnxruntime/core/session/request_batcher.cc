@@ -0,0 +1,275 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/request_batcher.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/framework/session_state.h"
+#include "core/framework/tensor.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+namespace {
+// Copies the box of shape `region` at `src_origin` in src to `dst_origin` in dst. Tensors are dense and row major.
+void CopyRegion(const Tensor& src, gsl::span<const int64_t> src_origin,
+                Tensor& dst, gsl::span<const int64_t> dst_origin, gsl::span<const int64_t> region) {
+  const size_t rank = region.size();
+  const size_t element_size = src.DataType()->Size();
+  const auto src_dims = src.Shape().GetDims();
+  const auto dst_dims = dst.Shape().GetDims();
+
+  if (rank == 0) {
+    std::memcpy(dst.MutableDataRaw(), src.DataRaw(), element_size);
+    return;
+  }
+  if (std::any_of(region.begin(), region.end(), [](int64_t d) { return d == 0; })) {
+    return;
+  }
+
+  // strides in elements
+  std::vector<int64_t> src_strides(rank, 1), dst_strides(rank, 1);
+  for (size_t k = rank - 1; k > 0; --k) {
+    src_strides[k - 1] = src_strides[k] * src_dims[k];
+    dst_strides[k - 1] = dst_strides[k] * dst_dims[k];
+  }
+
+  // copy one row of the innermost dimension at a time
+  const auto* src_data = static_cast<const uint8_t*>(src.DataRaw());
+  auto* dst_data = static_cast<uint8_t*>(dst.MutableDataRaw());
+  const size_t row_bytes = static_cast<size_t>(region[rank - 1]) * element_size;
+  std::vector<int64_t> index(rank, 0);
+  for (;;) {
+    int64_t src_offset = 0, dst_offset = 0;
+    for (size_t k = 0; k < rank; ++k) {
+      src_offset += (src_origin[k] + index[k]) * src_strides[k];
+      dst_offset += (dst_origin[k] + index[k]) * dst_strides[k];
+    }
+    std::memcpy(dst_data + dst_offset * element_size, src_data + src_offset * element_size, row_bytes);
+
+    // next row: advance the index over all but the innermost dimension
+    size_t k = rank - 1;
+    for (; k > 0; --k) {
+      if (++index[k - 1] < region[k - 1]) {
+        break;
+      }
+      index[k - 1] = 0;
+    }
+    if (k == 0) {
+      return;
+    }
+  }
+}
+}  // namespace
+
+RequestBatcher::RequestBatcher(InferenceSession& session, const RunOptions& run_options,
+                               std::vector<std::string> input_names, std::vector<std::string> output_names,
+                               RequestBatcherOptions options)
+    : session_(session),
+      run_options_(run_options),
+      input_names_(std::move(input_names)),
+      output_names_(std::move(output_names)),
+      options_(std::move(options)) {
+  ORT_ENFORCE(options_.max_batch_size > 0, "max_batch_size must be positive");
+  ORT_ENFORCE(std::is_sorted(options_.padding_buckets.begin(), options_.padding_buckets.end()),
+              "padding buckets must be sorted");
+  thread_ = std::thread([this]() { BatchLoop(); });
+}
+
+RequestBatcher::~RequestBatcher() {
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    done_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+}
+
+Status RequestBatcher::Submit(std::vector<OrtValue> inputs, Callback callback) {
+  ORT_RETURN_IF_NOT(inputs.size() == input_names_.size(), "Expected ", input_names_.size(), " inputs, got ",
+                    inputs.size());
+  ORT_RETURN_IF_NOT(callback, "A callback must be provided");
+
+  int64_t batch_size = -1;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    ORT_RETURN_IF_NOT(inputs[i].IsTensor(), "Input ", input_names_[i], " is not a tensor");
+    const Tensor& tensor = inputs[i].Get<Tensor>();
+    ORT_RETURN_IF_NOT(tensor.Location().device.Type() == OrtDevice::CPU, "Input ", input_names_[i],
+                      " must be on CPU");
+    ORT_RETURN_IF(tensor.IsDataTypeString(), "Input ", input_names_[i], " is a string tensor, which can't be batched");
+    ORT_RETURN_IF_NOT(tensor.Shape().NumDimensions() > options_.batch_axis, "Input ", input_names_[i],
+                      " has no batch axis ", options_.batch_axis);
+    const int64_t input_batch_size = tensor.Shape()[options_.batch_axis];
+    ORT_RETURN_IF_NOT(batch_size < 0 || batch_size == input_batch_size,
+                      "All inputs of a request must have the same batch size");
+    batch_size = input_batch_size;
+  }
+
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    ORT_RETURN_IF(done_, "RequestBatcher is shutting down");
+    requests_.push_back({std::move(inputs), std::move(callback), std::max<int64_t>(batch_size, 0),
+                         std::chrono::steady_clock::now()});
+  }
+  cv_.notify_all();
+  return Status::OK();
+}
+
+int64_t RequestBatcher::PaddedSize(int64_t size) const {
+  auto bucket = std::lower_bound(options_.padding_buckets.begin(), options_.padding_buckets.end(), size);
+  return bucket == options_.padding_buckets.end() ? size : *bucket;
+}
+
+void RequestBatcher::BatchLoop() {
+  std::vector<Request> batch;
+  for (;;) {
+    {
+      std::unique_lock<OrtMutex> lock(mutex_);
+      cv_.wait(lock, [this]() { return done_ || !requests_.empty(); });
+      if (requests_.empty()) {
+        return;
+      }
+
+      // wait for more requests until the batch is full or its first request has waited max_delay.
+      // on shutdown the pending requests are run right away.
+      const auto deadline = requests_.front().arrival + options_.max_delay;
+      const auto batch_full = [this]() {
+        int64_t num_samples = 0;
+        for (const auto& request : requests_) {
+          num_samples += request.batch_size;
+        }
+        return num_samples >= static_cast<int64_t>(options_.max_batch_size);
+      };
+      cv_.wait_until(lock, deadline, [&]() { return done_ || batch_full(); });
+
+      // take requests up to max_batch_size samples. a single request may exceed it.
+      int64_t num_samples = 0;
+      while (!requests_.empty() &&
+             (batch.empty() ||
+              num_samples + requests_.front().batch_size <= static_cast<int64_t>(options_.max_batch_size))) {
+        num_samples += requests_.front().batch_size;
+        batch.push_back(std::move(requests_.front()));
+        requests_.pop_front();
+      }
+    }
+
+    RunBatch(batch);
+    batch.clear();
+  }
+}
+
+void RequestBatcher::RunBatch(std::vector<Request>& batch) {
+  std::vector<std::vector<OrtValue>> outputs(batch.size());
+  Status status;
+  ORT_TRY {
+    status = RunBatchImpl(batch, outputs);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+    });
+  }
+
+  for (size_t r = 0; r < batch.size(); ++r) {
+    if (!status.IsOK()) {
+      outputs[r].clear();
+    }
+    ORT_TRY {
+      batch[r].callback(status, outputs[r]);
+    }
+    ORT_CATCH(...) {
+      // a throwing callback must not prevent the other requests from completing
+    }
+  }
+}
+
+Status RequestBatcher::RunBatchImpl(std::vector<Request>& batch, std::vector<std::vector<OrtValue>>& outputs) {
+  const size_t batch_axis = options_.batch_axis;
+  int64_t total_batch_size = 0;
+  for (const auto& request : batch) {
+    total_batch_size += request.batch_size;
+  }
+
+  auto cpu_allocator = session_.GetSessionState().GetAllocator(OrtDevice());
+  ORT_RETURN_IF_NOT(cpu_allocator, "Failed to find a CPU allocator for the batched inputs");
+
+  std::vector<OrtValue> feeds(input_names_.size());
+  if (batch.size() == 1) {
+    feeds = batch[0].inputs;
+  } else {
+    for (size_t i = 0; i < input_names_.size(); ++i) {
+      // the batched shape: the batch sizes add up, other dimensions are padded to the largest one
+      const Tensor& first = batch[0].inputs[i].Get<Tensor>();
+      std::vector<int64_t> batched_dims = first.Shape().AsShapeVector();
+      bool padded = false;
+      for (const auto& request : batch) {
+        const Tensor& tensor = request.inputs[i].Get<Tensor>();
+        ORT_RETURN_IF_NOT(tensor.DataType() == first.DataType() &&
+                              tensor.Shape().NumDimensions() == batched_dims.size(),
+                          "Requests have inputs ", input_names_[i], " of different types or ranks");
+        for (size_t k = 0; k < batched_dims.size(); ++k) {
+          if (k != batch_axis && tensor.Shape()[k] != batched_dims[k]) {
+            batched_dims[k] = std::max(batched_dims[k], tensor.Shape()[k]);
+            padded = true;
+          }
+        }
+      }
+      for (size_t k = 0; padded && k < batched_dims.size(); ++k) {
+        if (k != batch_axis) {
+          batched_dims[k] = PaddedSize(batched_dims[k]);
+        }
+      }
+      batched_dims[batch_axis] = total_batch_size;
+
+      Tensor::InitOrtValue(first.DataType(), TensorShape(batched_dims), cpu_allocator, feeds[i]);
+      Tensor& batched = *feeds[i].GetMutable<Tensor>();
+      if (padded) {
+        std::memset(batched.MutableDataRaw(), 0, batched.SizeInBytes());
+      }
+
+      std::vector<int64_t> src_origin(batched_dims.size(), 0), dst_origin(batched_dims.size(), 0);
+      for (const auto& request : batch) {
+        const Tensor& tensor = request.inputs[i].Get<Tensor>();
+        CopyRegion(tensor, src_origin, batched, dst_origin, tensor.Shape().GetDims());
+        dst_origin[batch_axis] += request.batch_size;
+      }
+    }
+  }
+
+  std::vector<OrtValue> fetches;
+  ORT_RETURN_IF_ERROR(session_.Run(run_options_, input_names_, feeds, output_names_, &fetches));
+
+  if (batch.size() == 1) {
+    outputs[0] = std::move(fetches);
+    return Status::OK();
+  }
+
+  // scatter the slices of the outputs along the batch axis
+  for (size_t o = 0; o < fetches.size(); ++o) {
+    ORT_RETURN_IF_NOT(fetches[o].IsTensor(), "Output ", output_names_[o], " is not a tensor");
+    const Tensor& batched = fetches[o].Get<Tensor>();
+    ORT_RETURN_IF_NOT(batched.Shape().NumDimensions() > batch_axis &&
+                          batched.Shape()[batch_axis] == total_batch_size,
+                      "Output ", output_names_[o], " has shape ", batched.Shape(),
+                      ", which does not have the batch size ", total_batch_size, " on axis ", batch_axis);
+    ORT_RETURN_IF(batched.IsDataTypeString(), "Output ", output_names_[o], " is a string tensor");
+
+    std::vector<int64_t> src_origin(batched.Shape().NumDimensions(), 0);
+    std::vector<int64_t> dst_origin(batched.Shape().NumDimensions(), 0);
+    for (size_t r = 0; r < batch.size(); ++r) {
+      std::vector<int64_t> dims = batched.Shape().AsShapeVector();
+      dims[batch_axis] = batch[r].batch_size;
+      OrtValue output;
+      Tensor::InitOrtValue(batched.DataType(), TensorShape(dims), cpu_allocator, output);
+      CopyRegion(batched, src_origin, *output.GetMutable<Tensor>(), dst_origin, dims);
+      outputs[r].push_back(std::move(output));
+      src_origin[batch_axis] += batch[r].batch_size;
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
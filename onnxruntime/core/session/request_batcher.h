@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+class InferenceSession;
+
+struct RequestBatcherOptions {
+  // axis of the inputs and outputs along which requests are concatenated
+  size_t batch_axis = 0;
+  // a batch is run once the requests in it add up to this many samples
+  size_t max_batch_size = 8;
+  // or once its first request has waited this long
+  std::chrono::microseconds max_delay{1000};
+  // Requests whose inputs differ in other dimensions than the batch axis, e.g. ragged sequences, are zero padded
+  // to the largest of those dimensions in the batch, rounded up to the smallest of these sizes that fits.
+  // Rounding up to buckets keeps the number of distinct shapes, and so of memory patterns and tuned kernels, small.
+  std::vector<int64_t> padding_buckets;
+};
+
+/**
+ * Dynamic batching of requests to a session.
+ *
+ * Requests are tensors of one or more samples along the batch axis. A thread of the batcher concatenates the
+ * requests that arrive within max_delay, up to max_batch_size samples, runs them with one InferenceSession::Run
+ * and returns each request its slice of the outputs along the batch axis. Outputs keep the padded extent of
+ * other dimensions.
+ *
+ * Callbacks are invoked on the thread of the batcher, in submission order.
+ */
+class RequestBatcher {
+ public:
+  using Callback = std::function<void(Status status, std::vector<OrtValue>& outputs)>;
+
+  RequestBatcher(InferenceSession& session, const RunOptions& run_options,
+                 std::vector<std::string> input_names, std::vector<std::string> output_names,
+                 RequestBatcherOptions options);
+
+  // Runs the pending requests before returning.
+  ~RequestBatcher();
+
+  // Queues a request with inputs on CPU in the order of the input names.
+  Status Submit(std::vector<OrtValue> inputs, Callback callback);
+
+ private:
+  struct Request {
+    std::vector<OrtValue> inputs;
+    Callback callback;
+    int64_t batch_size;
+    std::chrono::steady_clock::time_point arrival;
+  };
+
+  void BatchLoop();
+  void RunBatch(std::vector<Request>& batch);
+  Status RunBatchImpl(std::vector<Request>& batch, std::vector<std::vector<OrtValue>>& outputs);
+  int64_t PaddedSize(int64_t size) const;
+
+  InferenceSession& session_;
+  const RunOptions run_options_;
+  const std::vector<std::string> input_names_;
+  const std::vector<std::string> output_names_;
+  const RequestBatcherOptions options_;
+
+  OrtMutex mutex_;
+  OrtCondVar cv_;
+  std::deque<Request> requests_;  // GUARDED_BY(mutex_)
+  bool done_{false};              // GUARDED_BY(mutex_)
+
+  std::thread thread_;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RequestBatcher);
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,296 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/run_pipeline.h"
+
+#include <algorithm>
+
+#include "core/framework/data_transfer_manager.h"
+#include "core/framework/session_state.h"
+#include "core/framework/utils.h"
+#include "core/session/IOBinding.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+namespace {
+Stream* FindCopyStream(const std::vector<std::unique_ptr<OrtDevice>>& devices,
+                       const std::vector<std::unique_ptr<Stream>>& streams, const OrtDevice& device) {
+  for (size_t i = 0; i < devices.size(); ++i) {
+    if (*devices[i] == device) {
+      return streams[i].get();
+    }
+  }
+  return nullptr;
+}
+
+Status CopyTensor(const DataTransferManager& data_transfer_mgr, const Tensor& src, Tensor& dst, Stream* stream) {
+  return stream ? data_transfer_mgr.CopyTensorAsync(src, dst, *stream) : data_transfer_mgr.CopyTensor(src, dst);
+}
+
+void FlushStreams(const std::vector<std::unique_ptr<Stream>>& streams) {
+  for (const auto& stream : streams) {
+    if (stream) {
+      stream->Flush();
+    }
+  }
+}
+}  // namespace
+
+void RunPipeline::SlotQueue::Push(Slot* slot) {
+  {
+    std::lock_guard<OrtMutex> lock(mutex);
+    slots.push_back(slot);
+  }
+  cv.notify_one();
+}
+
+RunPipeline::Slot* RunPipeline::SlotQueue::Pop() {
+  std::unique_lock<OrtMutex> lock(mutex);
+  cv.wait(lock, [this]() { return closed || !slots.empty(); });
+  if (slots.empty()) {
+    return nullptr;
+  }
+  Slot* slot = slots.front();
+  slots.pop_front();
+  return slot;
+}
+
+void RunPipeline::SlotQueue::Close() {
+  {
+    std::lock_guard<OrtMutex> lock(mutex);
+    closed = true;
+  }
+  cv.notify_all();
+}
+
+RunPipeline::RunPipeline(InferenceSession& session, const RunOptions& run_options,
+                         std::vector<std::string> input_names, std::vector<std::string> output_names, size_t depth)
+    : session_(session),
+      run_options_(run_options),
+      input_names_(std::move(input_names)),
+      output_names_(std::move(output_names)),
+      slots_(std::max<size_t>(depth, 1)) {
+}
+
+RunPipeline::~RunPipeline() {
+  Wait();
+  to_copy_in_.Close();
+  to_compute_.Close();
+  to_copy_out_.Close();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+Status RunPipeline::Initialize() {
+  ORT_RETURN_IF_NOT(threads_.empty(), "RunPipeline is already initialized");
+  const auto& session_state = session_.GetSessionState();
+  ORT_RETURN_IF_NOT(session_state.GetExecutionPlan() != nullptr, "Session must be initialized to create a RunPipeline");
+  session_state_ = &session_state;
+
+  input_devices_.reserve(input_names_.size());
+  for (const auto& name : input_names_) {
+    InlinedVector<SessionState::NodeInfo> node_info_vec;
+    ORT_RETURN_IF_ERROR(session_state.GetInputNodeInfo(name, node_info_vec));
+    // all consumers of an input are on the same device. inputs without a consumer stay where they are.
+    const auto& node_info = node_info_vec.front();
+    input_devices_.push_back(node_info.p_node != nullptr ? *node_info.device : OrtDevice());
+  }
+
+  output_devices_.reserve(output_names_.size());
+  for (const auto& name : output_names_) {
+    int idx = -1;
+    ORT_RETURN_IF_ERROR(session_state.GetOrtValueNameIdxMap().GetIdx(name, idx));
+    output_devices_.push_back(utils::FindDeviceForValue(session_state, name));
+  }
+
+#ifdef ORT_ENABLE_STREAM
+  // one copy stream per direction and device, apart from the streams the session computes on
+  const auto add_copy_streams = [&](const OrtDevice& device) {
+    if (device.Type() == OrtDevice::CPU ||
+        std::any_of(stream_devices_.begin(), stream_devices_.end(), [&](const auto& d) { return *d == device; })) {
+      return;
+    }
+    auto create_stream_fn = session_state.GetStreamHandleRegistryInstance().GetCreateStreamFn(device.Type());
+    stream_devices_.push_back(std::make_unique<OrtDevice>(device));
+    copy_in_streams_.push_back(create_stream_fn ? create_stream_fn(*stream_devices_.back()) : nullptr);
+    copy_out_streams_.push_back(create_stream_fn ? create_stream_fn(*stream_devices_.back()) : nullptr);
+  };
+  std::for_each(input_devices_.begin(), input_devices_.end(), add_copy_streams);
+  std::for_each(output_devices_.begin(), output_devices_.end(), add_copy_streams);
+#endif
+
+  for (auto& slot : slots_) {
+    ORT_RETURN_IF_ERROR(session_.NewIOBinding(&slot.binding));
+    slot.device_inputs.resize(input_names_.size());
+    free_slots_.Push(&slot);
+  }
+
+  threads_.emplace_back([this]() { CopyInputsLoop(); });
+  threads_.emplace_back([this]() { ComputeLoop(); });
+  threads_.emplace_back([this]() { CopyOutputsLoop(); });
+  return Status::OK();
+}
+
+Status RunPipeline::Submit(std::vector<OrtValue> inputs, Callback callback) {
+  ORT_RETURN_IF_NOT(!threads_.empty(), "RunPipeline is not initialized");
+  ORT_RETURN_IF_NOT(inputs.size() == input_names_.size(), "Expected ", input_names_.size(), " inputs, got ",
+                    inputs.size());
+  ORT_RETURN_IF_NOT(callback, "A callback must be provided");
+
+  // blocks while all slots are in flight
+  Slot* slot = free_slots_.Pop();
+  {
+    std::lock_guard<OrtMutex> lock(in_flight_mutex_);
+    ++in_flight_;
+  }
+  slot->inputs = std::move(inputs);
+  slot->callback = std::move(callback);
+  slot->status = Status::OK();
+  to_copy_in_.Push(slot);
+  return Status::OK();
+}
+
+void RunPipeline::Wait() {
+  std::unique_lock<OrtMutex> lock(in_flight_mutex_);
+  in_flight_cv_.wait(lock, [this]() { return in_flight_ == 0; });
+}
+
+Status RunPipeline::CopyInputs(Slot& slot) {
+  const auto& data_transfer_mgr = session_state_->GetDataTransferMgr();
+  IOBinding& binding = *slot.binding;
+
+  for (size_t i = 0; i < input_names_.size(); ++i) {
+    const OrtValue& input = slot.inputs[i];
+    const OrtDevice& device = input_devices_[i];
+    if (!input.IsTensor() || input.Get<Tensor>().Location().device == device) {
+      ORT_RETURN_IF_ERROR(binding.BindInput(input_names_[i], input));
+      continue;
+    }
+
+    // reuse the device buffer of the previous Run of this slot if it fits
+    const Tensor& src = input.Get<Tensor>();
+    OrtValue& device_input = slot.device_inputs[i];
+    if (!device_input.IsAllocated() || device_input.Get<Tensor>().DataType() != src.DataType() ||
+        device_input.Get<Tensor>().Shape() != src.Shape()) {
+      auto allocator = session_state_->GetAllocator(device);
+      ORT_RETURN_IF_NOT(allocator, "Failed to find allocator for device ", device.ToString());
+      Tensor::InitOrtValue(src.DataType(), src.Shape(), std::move(allocator), device_input);
+    }
+
+    Stream* stream = FindCopyStream(stream_devices_, copy_in_streams_, device);
+    ORT_RETURN_IF_ERROR(CopyTensor(data_transfer_mgr, src, *device_input.GetMutable<Tensor>(), stream));
+    ORT_RETURN_IF_ERROR(binding.BindInput(input_names_[i], device_input));
+  }
+
+  // outputs stay on the device that produces them, and are copied to CPU by the output stage.
+  // rebinding them makes every Run allocate new outputs, so outputs returned earlier are not overwritten.
+  binding.ClearOutputs();
+  for (size_t i = 0; i < output_names_.size(); ++i) {
+    ORT_RETURN_IF_ERROR(binding.BindOutput(output_names_[i], output_devices_[i]));
+  }
+
+  // wait here, on the copy thread, so the compute stage finds the inputs ready
+  FlushStreams(copy_in_streams_);
+  return Status::OK();
+}
+
+Status RunPipeline::CopyOutputs(Slot& slot) {
+  const auto& data_transfer_mgr = session_state_->GetDataTransferMgr();
+  std::vector<OrtValue>& outputs = slot.binding->GetOutputs();
+  slot.outputs.clear();
+  slot.outputs.reserve(outputs.size());
+
+  AllocatorPtr cpu_allocator;
+  for (auto& output : outputs) {
+    if (!output.IsTensor() || output.Get<Tensor>().Location().device.Type() == OrtDevice::CPU) {
+      slot.outputs.push_back(output);
+      continue;
+    }
+
+    if (!cpu_allocator) {
+      cpu_allocator = session_state_->GetAllocator(OrtDevice());
+      ORT_RETURN_IF_NOT(cpu_allocator, "Failed to find a CPU allocator for the outputs");
+    }
+    const Tensor& src = output.Get<Tensor>();
+    OrtValue cpu_output;
+    Tensor::InitOrtValue(src.DataType(), src.Shape(), cpu_allocator, cpu_output);
+    Stream* stream = FindCopyStream(stream_devices_, copy_out_streams_, src.Location().device);
+    ORT_RETURN_IF_ERROR(CopyTensor(data_transfer_mgr, src, *cpu_output.GetMutable<Tensor>(), stream));
+    slot.outputs.push_back(std::move(cpu_output));
+  }
+
+  FlushStreams(copy_out_streams_);
+  return Status::OK();
+}
+
+void RunPipeline::CopyInputsLoop() {
+  while (Slot* slot = to_copy_in_.Pop()) {
+    ORT_TRY {
+      slot->status = CopyInputs(*slot);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        slot->status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+    to_compute_.Push(slot);
+  }
+}
+
+void RunPipeline::ComputeLoop() {
+  while (Slot* slot = to_compute_.Pop()) {
+    if (slot->status.IsOK()) {
+      ORT_TRY {
+        slot->status = session_.Run(run_options_, *slot->binding);
+      }
+      ORT_CATCH(const std::exception& ex) {
+        ORT_HANDLE_EXCEPTION([&]() {
+          slot->status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+        });
+      }
+    }
+    to_copy_out_.Push(slot);
+  }
+}
+
+void RunPipeline::CopyOutputsLoop() {
+  while (Slot* slot = to_copy_out_.Pop()) {
+    if (slot->status.IsOK()) {
+      ORT_TRY {
+        slot->status = CopyOutputs(*slot);
+      }
+      ORT_CATCH(const std::exception& ex) {
+        ORT_HANDLE_EXCEPTION([&]() {
+          slot->status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+        });
+      }
+    }
+    if (!slot->status.IsOK()) {
+      slot->outputs.clear();
+    }
+
+    ORT_TRY {
+      slot->callback(slot->status, slot->outputs);
+    }
+    ORT_CATCH(...) {
+      // a throwing callback must not take down the pipeline
+    }
+
+    // release the references to the user's inputs and outputs before the slot is reused
+    slot->inputs.clear();
+    slot->outputs.clear();
+    slot->binding->ClearOutputs();
+    slot->callback = nullptr;
+    free_slots_.Push(slot);
+
+    {
+      std::lock_guard<OrtMutex> lock(in_flight_mutex_);
+      --in_flight_;
+    }
+    in_flight_cv_.notify_all();
+  }
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,128 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+#include "core/framework/stream_handles.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+class InferenceSession;
+class IOBinding;
+class SessionState;
+
+/**
+ * Keeps several Runs of one session in flight, so that the copies of the inputs of a Run to the device,
+ * the compute of the previous Run and the copies of the outputs of the Run before it back to CPU overlap.
+ *
+ * Each stage has its own thread. The input and output copies are issued on copy streams owned by the pipeline,
+ * separate from the streams the session computes on. Each of the `depth` slots of the pipeline owns an IOBinding
+ * and the device buffers of its inputs, which are reused by later Runs with inputs of the same shape, so with a
+ * depth of 2 the device inputs are double buffered.
+ *
+ * Usage:
+ *   RunPipeline pipeline(session, run_options, input_names, output_names, 2);
+ *   ORT_RETURN_IF_ERROR(pipeline.Initialize());
+ *   for (...) {
+ *     // blocks while `depth` Runs are in flight
+ *     ORT_RETURN_IF_ERROR(pipeline.Submit(inputs, [](Status status, std::vector<OrtValue>& outputs) {...}));
+ *   }
+ *   pipeline.Wait();
+ *
+ * Callbacks are invoked in submission order on the output copy thread, with the outputs on CPU.
+ */
+class RunPipeline {
+ public:
+  using Callback = std::function<void(Status status, std::vector<OrtValue>& outputs)>;
+
+  RunPipeline(InferenceSession& session, const RunOptions& run_options,
+              std::vector<std::string> input_names, std::vector<std::string> output_names, size_t depth);
+
+  // Waits for the submitted Runs to complete.
+  ~RunPipeline();
+
+  // Looks up the devices of the inputs and outputs and starts the stage threads. The session must be initialized.
+  Status Initialize();
+
+  // Queues a Run with inputs in the order of the input names. Inputs may be on any device and must not be
+  // modified until the callback is invoked.
+  Status Submit(std::vector<OrtValue> inputs, Callback callback);
+
+  // Blocks until all submitted Runs have completed.
+  void Wait();
+
+  size_t Depth() const { return slots_.size(); }
+
+ private:
+  struct Slot {
+    std::unique_ptr<IOBinding> binding;
+    std::vector<OrtValue> inputs;
+    // device copies of the inputs, kept for the next Run of the slot
+    std::vector<OrtValue> device_inputs;
+    std::vector<OrtValue> outputs;
+    Callback callback;
+    Status status;
+  };
+
+  // a queue between two stages
+  struct SlotQueue {
+    void Push(Slot* slot);
+    // returns nullptr once closed and empty
+    Slot* Pop();
+    void Close();
+
+    OrtMutex mutex;
+    OrtCondVar cv;
+    std::deque<Slot*> slots;
+    bool closed{false};
+  };
+
+  void CopyInputsLoop();
+  void ComputeLoop();
+  void CopyOutputsLoop();
+
+  Status CopyInputs(Slot& slot);
+  Status CopyOutputs(Slot& slot);
+
+  InferenceSession& session_;
+  const SessionState* session_state_{nullptr};
+  const RunOptions run_options_;
+  const std::vector<std::string> input_names_;
+  const std::vector<std::string> output_names_;
+
+  // device each input is consumed on, and each output is produced on
+  std::vector<OrtDevice> input_devices_;
+  std::vector<OrtDevice> output_devices_;
+
+  // copy streams by device type. the devices they refer to are owned by stream_devices_.
+  std::vector<std::unique_ptr<OrtDevice>> stream_devices_;
+  std::vector<std::unique_ptr<Stream>> copy_in_streams_;
+  std::vector<std::unique_ptr<Stream>> copy_out_streams_;
+
+  std::vector<Slot> slots_;
+  SlotQueue free_slots_;
+  SlotQueue to_copy_in_;
+  SlotQueue to_compute_;
+  SlotQueue to_copy_out_;
+
+  OrtMutex in_flight_mutex_;
+  OrtCondVar in_flight_cv_;
+  size_t in_flight_{0};
+
+  std::vector<std::thread> threads_;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunPipeline);
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,101 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/session_warmup.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/framework/data_types.h"
+#include "core/framework/session_state.h"
+#include "core/framework/tensor.h"
+#include "core/graph/node_arg.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+std::chrono::microseconds Elapsed(Clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+}
+
+Status CreateInput(const NodeArg& input, const WarmupProfile& profile, const AllocatorPtr& allocator,
+                   OrtValue& value) {
+  const auto* type_proto = input.TypeAsProto();
+  ORT_RETURN_IF_NOT(type_proto != nullptr && type_proto->has_tensor_type(), "Input ", input.Name(),
+                    " is not a tensor");
+  const auto* tensor_type = DataTypeImpl::TypeFromProto(*type_proto)->AsTensorType();
+  ORT_RETURN_IF_NOT(tensor_type != nullptr, "Input ", input.Name(), " has an unsupported type");
+
+  std::vector<int64_t> dims;
+  auto it = profile.find(input.Name());
+  if (it != profile.end()) {
+    dims = it->second;
+  } else {
+    const auto* shape = input.Shape();
+    ORT_RETURN_IF(shape == nullptr, "Input ", input.Name(), " has no shape in the model and none in the profile");
+    for (const auto& dim : shape->dim()) {
+      dims.push_back(dim.has_dim_value() ? dim.dim_value() : 1);
+    }
+  }
+
+  // string tensors are constructed with empty strings
+  Tensor::InitOrtValue(tensor_type->GetElementType(), TensorShape(dims), allocator, value);
+  Tensor& tensor = *value.GetMutable<Tensor>();
+  if (!tensor.IsDataTypeString()) {
+    std::memset(tensor.MutableDataRaw(), 0, tensor.SizeInBytes());
+  }
+  return Status::OK();
+}
+}  // namespace
+
+Status WarmupSession(InferenceSession& session, const RunOptions& run_options,
+                     const std::vector<WarmupProfile>& profiles, WarmupReport& report) {
+  const auto start = Clock::now();
+  report = WarmupReport();
+
+  auto [inputs_status, inputs] = session.GetModelInputs();
+  ORT_RETURN_IF_ERROR(inputs_status);
+  auto [outputs_status, outputs] = session.GetModelOutputs();
+  ORT_RETURN_IF_ERROR(outputs_status);
+
+  auto cpu_allocator = session.GetSessionState().GetAllocator(OrtDevice());
+  ORT_RETURN_IF_NOT(cpu_allocator, "Failed to find a CPU allocator for the warm-up inputs");
+
+  std::vector<std::string> input_names, output_names;
+  for (const auto* input : *inputs) {
+    input_names.push_back(input->Name());
+  }
+  for (const auto* output : *outputs) {
+    output_names.push_back(output->Name());
+  }
+
+  for (const auto& profile : profiles) {
+    for (const auto& entry : profile) {
+      ORT_RETURN_IF_NOT(std::find(input_names.begin(), input_names.end(), entry.first) != input_names.end(),
+                        "The warm-up profile has a shape for ", entry.first, ", which is not an input of the model");
+    }
+
+    WarmupPhaseTimes& times = report.profiles.emplace_back();
+    auto phase_start = Clock::now();
+    std::vector<OrtValue> feeds(inputs->size());
+    for (size_t i = 0; i < inputs->size(); ++i) {
+      ORT_RETURN_IF_ERROR(CreateInput(*(*inputs)[i], profile, cpu_allocator, feeds[i]));
+    }
+    times.create_inputs = Elapsed(phase_start);
+
+    for (auto* run_time : {&times.first_run, &times.second_run}) {
+      std::vector<OrtValue> fetches;
+      phase_start = Clock::now();
+      ORT_RETURN_IF_ERROR(session.Run(run_options, input_names, feeds, output_names, &fetches));
+      *run_time = Elapsed(phase_start);
+    }
+  }
+
+  report.total = Elapsed(start);
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/framework/run_options.h"
+
+namespace onnxruntime {
+class InferenceSession;
+
+// Shapes of the inputs for one warm-up run. Dimensions of inputs that aren't listed are taken from the model,
+// with symbolic dimensions set to 1.
+using WarmupProfile = std::unordered_map<std::string, std::vector<int64_t>>;
+
+struct WarmupPhaseTimes {
+  // allocating and zero filling the inputs
+  std::chrono::microseconds create_inputs{0};
+  // the first run of the shapes, which grows the arenas and searches for kernels and algorithms
+  std::chrono::microseconds first_run{0};
+  // a second run of the same shapes, which should take as long as the runs after the warm-up
+  std::chrono::microseconds second_run{0};
+};
+
+struct WarmupReport {
+  // one entry for each profile, in order
+  std::vector<WarmupPhaseTimes> profiles;
+  std::chrono::microseconds total{0};
+};
+
+/**
+ * Runs the session with zero filled inputs of each profile's shapes, so the lazy work of a first run happens
+ * before the session takes requests: arena extension, memory pattern planning, cuDNN algorithm search, tunable
+ * op selection and loading of device modules. All of it is kept by the session and its execution providers, so
+ * later runs of the same shapes take the steady state path.
+ *
+ * Each profile is run twice. The time of the second run is what a request of those shapes should expect, a second
+ * run much slower than later ones hints at work that isn't cached per shape.
+ *
+ * The session must be initialized. All model inputs must be tensors.
+ */
+Status WarmupSession(InferenceSession& session, const RunOptions& run_options,
+                     const std::vector<WarmupProfile>& profiles, WarmupReport& report);
+
+}  // namespace onnxruntime
@@ -242,6 +242,11 @@ class StandAloneKernelContext : public OpKernelContext {
     return false;
   }
 
+  bool IsInputDeadAfterKernel(int) const override {
+    // the inputs belong to the caller
+    return false;
+  }
+
   int InputCount() const override {
     return input_count_;
   }
@@ -0,0 +1,258 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/swappable_session.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <unordered_set>
+
+#include "core/common/hash_combine.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/allocator.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/session_state.h"
+#include "core/framework/tensor.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/model.h"
+#include "core/session/inference_session.h"
+#include "core/session/onnxruntime_run_options_config_keys.h"
+
+namespace onnxruntime {
+
+SwappableSession::SwappableSession(CreateSessionFn create_session, SwappableSessionOptions options)
+    : create_session_(std::move(create_session)), options_(std::move(options)) {
+  recorded_feeds_full_ = options_.max_warmup_shapes == 0;
+}
+
+SwappableSession::~SwappableSession() {
+  ORT_IGNORE_RETURN_VALUE(WaitForSwap());
+}
+
+Status SwappableSession::Load(const PathString& model_path) {
+  std::shared_ptr<LoadedModel> model;
+  ORT_RETURN_IF_ERROR(LoadModel(model_path, model));
+  std::lock_guard<OrtMutex> lock(mutex_);
+  current_ = std::move(model);
+  return Status::OK();
+}
+
+Status SwappableSession::Run(const RunOptions& run_options, gsl::span<const char* const> feed_names,
+                             gsl::span<const OrtValue* const> feeds, gsl::span<const char* const> fetch_names,
+                             gsl::span<OrtValue*> fetches) {
+  // the Run holds on to the model it started on, which is released after a swap once its Runs end
+  std::shared_ptr<LoadedModel> model;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    model = current_;
+  }
+  ORT_RETURN_IF(model == nullptr, "No model was loaded");
+
+  if (!recorded_feeds_full_.load(std::memory_order_relaxed)) {
+    RecordFeeds(feed_names, feeds);
+  }
+  return model->session->Run(run_options, feed_names, feeds, fetch_names, fetches);
+}
+
+Status SwappableSession::Swap(const PathString& model_path) {
+  std::lock_guard<OrtMutex> lock(swap_mutex_);
+  ORT_RETURN_IF(swapping_, "A swap is in progress");
+  if (swap_thread_.joinable()) {
+    swap_thread_.join();
+  }
+
+  swapping_ = true;
+  swap_thread_ = std::thread([this, model_path]() {
+    std::shared_ptr<LoadedModel> model;
+    Status status;
+    ORT_TRY {
+      status = LoadModel(model_path, model);
+      if (status.IsOK()) {
+        Warmup(*model->session);
+      }
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+    ORT_CATCH(...) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, "Unknown exception while swapping the model");
+    }
+
+    if (status.IsOK()) {
+      std::lock_guard<OrtMutex> current_lock(mutex_);
+      current_.swap(model);
+    }
+    swap_status_ = status;
+    swapping_ = false;
+    // model is now the previous one, released here unless Runs are still in flight on it
+  });
+  return Status::OK();
+}
+
+Status SwappableSession::WaitForSwap() {
+  std::lock_guard<OrtMutex> lock(swap_mutex_);
+  if (swap_thread_.joinable()) {
+    swap_thread_.join();
+  }
+  return swap_status_;
+}
+
+Status SwappableSession::LoadModel(const PathString& model_path, std::shared_ptr<LoadedModel>& model) const {
+  std::shared_ptr<LoadedModel> current;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    current = current_;
+  }
+
+  auto loaded = std::make_shared<LoadedModel>();
+  ORT_RETURN_IF_ERROR(LoadInitializers(model_path, current.get(), *loaded));
+
+  std::unordered_map<std::string, const OrtValue*> initializers;
+  for (const auto& [name, initializer] : loaded->initializers) {
+    initializers.emplace(name, &initializer->value);
+  }
+  ORT_RETURN_IF_ERROR(create_session_(model_path, initializers, loaded->session));
+
+  // the initializers the session didn't use, e.g. as it placed them on another device, are not kept
+  std::unordered_set<const void*> used_data;
+  for (const auto& [idx, value] : loaded->session->GetSessionState().GetInitializedTensors()) {
+    if (value.IsTensor()) {
+      used_data.insert(value.Get<Tensor>().DataRaw());
+    }
+  }
+  auto& shared = loaded->initializers;
+  shared.erase(std::remove_if(shared.begin(), shared.end(),
+                              [&used_data](const auto& initializer) {
+                                return used_data.count(initializer.second->data.data()) == 0;
+                              }),
+               shared.end());
+
+  model = std::move(loaded);
+  return Status::OK();
+}
+
+Status SwappableSession::LoadInitializers(const PathString& model_path, const LoadedModel* current,
+                                          LoadedModel& model) const {
+#if !defined(ORT_MINIMAL_BUILD)
+  ONNX_NAMESPACE::ModelProto model_proto;
+  const auto status = Model::Load(model_path, model_proto);
+  if (!status.IsOK()) {
+    // e.g. an ORT format model. the session loads its initializers itself
+    LOGS_DEFAULT(INFO) << "The initializers of the model are not shared: " << status.ErrorMessage();
+    return Status::OK();
+  }
+
+  // the initializers of the current model, by the first word of their hash
+  std::unordered_multimap<uint32_t, std::shared_ptr<const SharedInitializer>> current_initializers;
+  if (current != nullptr) {
+    for (const auto& [name, initializer] : current->initializers) {
+      current_initializers.emplace(initializer->hash[0], initializer);
+    }
+  }
+  const auto find_current = [&current_initializers](const SharedInitializer& initializer)
+      -> std::shared_ptr<const SharedInitializer> {
+    const Tensor& tensor = initializer.value.Get<Tensor>();
+    const auto [begin, end] = current_initializers.equal_range(initializer.hash[0]);
+    for (auto it = begin; it != end; ++it) {
+      const SharedInitializer& candidate = *it->second;
+      const Tensor& candidate_tensor = candidate.value.Get<Tensor>();
+      if (std::memcmp(candidate.hash, initializer.hash, sizeof(initializer.hash)) == 0 &&
+          candidate_tensor.DataType() == tensor.DataType() && candidate_tensor.Shape() == tensor.Shape() &&
+          candidate.data == initializer.data) {
+        return it->second;
+      }
+    }
+    return nullptr;
+  };
+
+  const Path path = Path::Parse(model_path);
+  const OrtMemoryInfo cpu_memory_info(CPU, OrtDeviceAllocator);
+  for (const auto& tensor_proto : model_proto.graph().initializer()) {
+    if (tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+      continue;
+    }
+
+    auto initializer = std::make_shared<SharedInitializer>();
+    ORT_RETURN_IF_ERROR(utils::UnpackInitializerData(tensor_proto, path, initializer->data));
+    const auto type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+    const TensorShape shape = utils::GetTensorShapeFromTensorProto(tensor_proto);
+    // the unpacked data of e.g. empty or sub-byte tensors isn't a dense buffer of the elements
+    if (initializer->data.empty() || initializer->data.size() > static_cast<size_t>(std::numeric_limits<int>::max()) ||
+        static_cast<size_t>(shape.Size()) * type->Size() != initializer->data.size()) {
+      continue;
+    }
+
+    MurmurHash3::x86_128(initializer->data.data(), static_cast<int>(initializer->data.size()), 0,
+                         initializer->hash);
+    Tensor::InitOrtValue(type, shape, initializer->data.data(), cpu_memory_info, initializer->value);
+
+    auto shared = find_current(*initializer);
+    model.initializers.emplace_back(tensor_proto.name(), shared != nullptr ? std::move(shared)
+                                                                           : std::move(initializer));
+  }
+#else
+  ORT_UNUSED_PARAMETER(model_path);
+  ORT_UNUSED_PARAMETER(current);
+  ORT_UNUSED_PARAMETER(model);
+#endif
+  return Status::OK();
+}
+
+void SwappableSession::Warmup(InferenceSession& session) const {
+  std::vector<WarmupProfile> profiles;
+  {
+    std::lock_guard<OrtMutex> lock(recorded_feeds_mutex_);
+    profiles = recorded_feeds_;
+  }
+  if (profiles.empty()) {
+    return;
+  }
+
+  RunOptions run_options;
+  run_options.run_tag = "warmup";
+  if (options_.warmup_max_degree_of_parallelism > 0) {
+    ORT_IGNORE_RETURN_VALUE(run_options.config_options.AddConfigEntry(
+        kOrtRunOptionsConfigIntraOpMaxDegreeOfParallelism,
+        std::to_string(options_.warmup_max_degree_of_parallelism).c_str()));
+  }
+
+  // a model whose inputs changed may not run with the recorded shapes, it is then swapped in without warm up
+  WarmupReport report;
+  const auto status = WarmupSession(session, run_options, profiles, report);
+  if (!status.IsOK()) {
+    LOGS_DEFAULT(WARNING) << "Could not warm up the new session with the recorded feed shapes: "
+                          << status.ErrorMessage();
+  }
+}
+
+void SwappableSession::RecordFeeds(gsl::span<const char* const> feed_names, gsl::span<const OrtValue* const> feeds) {
+  size_t key = 0;
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    if (feeds[i] == nullptr || !feeds[i]->IsTensor()) {
+      return;
+    }
+    HashCombine(std::string_view(feed_names[i]), key);
+    for (const auto dim : feeds[i]->Get<Tensor>().Shape().GetDims()) {
+      HashCombine(dim, key);
+    }
+  }
+
+  std::lock_guard<OrtMutex> lock(recorded_feeds_mutex_);
+  if (recorded_feeds_.size() >= options_.max_warmup_shapes || !recorded_feeds_keys_.insert(key).second) {
+    return;
+  }
+
+  WarmupProfile profile;
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    const auto dims = feeds[i]->Get<Tensor>().Shape().GetDims();
+    profile.emplace(feed_names[i], std::vector<int64_t>(dims.begin(), dims.end()));
+  }
+  recorded_feeds_.push_back(std::move(profile));
+  recorded_feeds_full_ = recorded_feeds_.size() >= options_.max_warmup_shapes;
+}
+
+}  // namespace onnxruntime
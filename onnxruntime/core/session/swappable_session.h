@@ -0,0 +1,115 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/path_string.h"
+#include "core/common/status.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+#include "core/platform/ort_mutex.h"
+#include "core/session/session_warmup.h"
+
+namespace onnxruntime {
+class InferenceSession;
+
+struct SwappableSessionOptions {
+  // the number of distinct sets of feed shapes of the Runs that are recorded to warm up the replacement sessions
+  size_t max_warmup_shapes = 8;
+  // maximum degree of parallelism of the warm up Runs of a replacement session, so that they take few of the threads
+  // of the intra op thread pool from the Runs of the current session when the pool is shared. 0 means no limit.
+  int warmup_max_degree_of_parallelism = 1;
+};
+
+/**
+ * A session whose model can be replaced while it runs.
+ *
+ * Swap creates and initializes the session of the new model on a background thread and warms it up with
+ * WarmupSession, with a profile for each set of feed shapes recorded from the Runs of the current session. The
+ * initializers of the new model whose data type, shape and content are those of an initializer of the current model
+ * are shared with the current session rather than loaded again. Runs starting after the swap go to the new session
+ * while the Runs in flight finish on the previous one, which is released after the last of them.
+ *
+ * The initializers of the models are loaded from their ONNX protos by the swappable session and added to the
+ * session options as shared initializers, so ORT format models and string initializers aren't shared.
+ */
+class SwappableSession {
+ public:
+  // Creates and initializes a session for the model, with initializers added to its session options with
+  // SessionOptions::AddInitializer.
+  using CreateSessionFn = std::function<Status(const PathString& model_path,
+                                               const std::unordered_map<std::string, const OrtValue*>& initializers,
+                                               std::unique_ptr<InferenceSession>& session)>;
+
+  SwappableSession(CreateSessionFn create_session, SwappableSessionOptions options);
+
+  // Waits for the swap in progress.
+  ~SwappableSession();
+
+  // Creates the first session, synchronously.
+  Status Load(const PathString& model_path);
+
+  // Runs the current session, as InferenceSession::Run.
+  Status Run(const RunOptions& run_options, gsl::span<const char* const> feed_names,
+             gsl::span<const OrtValue* const> feeds, gsl::span<const char* const> fetch_names,
+             gsl::span<OrtValue*> fetches);
+
+  // Starts replacing the model by the one at model_path. Fails if a swap is in progress.
+  Status Swap(const PathString& model_path);
+
+  // Waits for the swap in progress, if any, and returns the status of the last swap. The current session is
+  // unchanged if it failed.
+  Status WaitForSwap();
+
+ private:
+  // an initializer loaded by the swappable session, shared by the sessions of the models that have it
+  struct SharedInitializer {
+    std::vector<uint8_t> data;
+    OrtValue value;  // a tensor over data
+    uint32_t hash[4];
+  };
+
+  struct LoadedModel {
+    // by name in the model
+    std::vector<std::pair<std::string, std::shared_ptr<const SharedInitializer>>> initializers;
+    // declared after the initializers so that it's released before them
+    std::unique_ptr<InferenceSession> session;
+  };
+
+  Status LoadModel(const PathString& model_path, std::shared_ptr<LoadedModel>& model) const;
+  Status LoadInitializers(const PathString& model_path, const LoadedModel* current, LoadedModel& model) const;
+  void Warmup(InferenceSession& session) const;
+  void RecordFeeds(gsl::span<const char* const> feed_names, gsl::span<const OrtValue* const> feeds);
+
+  const CreateSessionFn create_session_;
+  const SwappableSessionOptions options_;
+
+  mutable OrtMutex mutex_;
+  std::shared_ptr<LoadedModel> current_;  // GUARDED_BY(mutex_)
+
+  mutable OrtMutex recorded_feeds_mutex_;
+  std::vector<WarmupProfile> recorded_feeds_;   // GUARDED_BY(recorded_feeds_mutex_)
+  InlinedHashSet<size_t> recorded_feeds_keys_;  // GUARDED_BY(recorded_feeds_mutex_)
+  std::atomic<bool> recorded_feeds_full_{false};
+
+  OrtMutex swap_mutex_;
+  std::thread swap_thread_;  // GUARDED_BY(swap_mutex_)
+  std::atomic<bool> swapping_{false};
+  Status swap_status_;  // written by the swap thread, read after joining it
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SwappableSession);
+};
+
+}  // namespace onnxruntime
@@ -8,6 +8,7 @@
 #include "core/common/narrow.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/float8.h"
+#include <array>
 #include <cmath>
 
 namespace onnxruntime {
@@ -163,6 +164,23 @@ ParQuantizeLinearStd(const MLFloat16* Input,
 
 #if !defined(DISABLE_FLOAT8_TYPES)
 
+/**
+ * @brief Table of the float values of the 256 bit patterns of a float 8 type. The conversions of
+ * whole tensors look the values up instead of decoding each element.
+ */
+template <typename Float8Type>
+typename std::enable_if<boost::mp11::mp_contains<element_type_lists::AllFloat8, Float8Type>::value, const float*>::type
+Float8ToFloatTable() {
+  static const std::array<float, 256> table = [] {
+    std::array<float, 256> values;
+    for (size_t bits = 0; bits < values.size(); ++bits) {
+      values[bits] = Float8Type(static_cast<uint8_t>(bits), Float8Type::FromBits()).ToFloat();
+    }
+    return values;
+  }();
+  return table.data();
+}
+
 template <typename OutputFloat8Type>
 typename std::enable_if<boost::mp11::mp_contains<element_type_lists::AllFloat8, OutputFloat8Type>::value, void>::type
 ParQuantizeLinearSat(const float* Input,
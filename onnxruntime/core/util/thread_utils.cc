@@ -18,7 +18,11 @@ std::ostream& operator<<(std::ostream& os, const OrtThreadPoolParams& params) {
   os << " thread_pool_size: " << params.thread_pool_size;
   os << " auto_set_affinity: " << params.auto_set_affinity;
   os << " allow_spinning: " << params.allow_spinning;
+  os << " prefer_performance_cores: " << params.prefer_performance_cores;
+  os << " cache_domain: " << params.cache_domain;
   os << " dynamic_block_base_: " << params.dynamic_block_base_;
+  os << " work_stealing_loops_: " << params.work_stealing_loops_;
+  os << " adaptive_spinning_: " << params.adaptive_spinning_;
   os << " stack_size: " << params.stack_size;
   os << " affinity_str: " << params.affinity_str;
   // os << " name: " << (params.name ? params.name : L"nullptr");
@@ -88,11 +92,68 @@ static std::vector<LogicalProcessors> ReadThreadAffinityConfig(const std::string
 }
 #endif
 
+// Keeps the cores of the highest efficiency class, if the classes of all cores are known.
+static std::vector<LogicalProcessors> SelectPerformanceCores(std::vector<LogicalProcessors> cores,
+                                                             const std::vector<uint8_t>& efficiency_classes) {
+  if (efficiency_classes.size() != cores.size()) {
+    return cores;
+  }
+
+  const uint8_t performance_class = *std::max_element(efficiency_classes.begin(), efficiency_classes.end());
+  std::vector<LogicalProcessors> performance_cores;
+  for (size_t i = 0; i < cores.size(); ++i) {
+    if (efficiency_classes[i] == performance_class) {
+      performance_cores.push_back(std::move(cores[i]));
+    }
+  }
+
+  LOGS_DEFAULT(VERBOSE) << "Using the " << performance_cores.size() << " performance cores out of "
+                        << efficiency_classes.size() << " cores for the default thread pool size";
+  return performance_cores;
+}
+
+// Keeps the cores, and their efficiency classes if known, of the given cache domain modulo the number of domains.
+static void SelectCacheDomain(std::vector<LogicalProcessors>& cores, std::vector<uint8_t>& efficiency_classes,
+                              const std::vector<int>& cache_domains, int cache_domain) {
+  if (cache_domains.size() != cores.size()) {
+    return;
+  }
+
+  const int num_domains = *std::max_element(cache_domains.begin(), cache_domains.end()) + 1;
+  const int domain = cache_domain % num_domains;
+  const bool has_efficiency_classes = efficiency_classes.size() == cores.size();
+  size_t num_selected = 0;
+  for (size_t i = 0; i < cores.size(); ++i) {
+    if (cache_domains[i] == domain) {
+      cores[num_selected] = std::move(cores[i]);
+      if (has_efficiency_classes) {
+        efficiency_classes[num_selected] = efficiency_classes[i];
+      }
+      ++num_selected;
+    }
+  }
+  cores.resize(num_selected);
+  if (has_efficiency_classes) {
+    efficiency_classes.resize(num_selected);
+  }
+
+  LOGS_DEFAULT(VERBOSE) << "Using the " << num_selected << " cores of cache domain " << domain << " out of "
+                        << num_domains << " for the default thread pool";
+}
+
 static std::unique_ptr<ThreadPool>
 CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   ThreadOptions to;
   if (options.thread_pool_size <= 0) {  // default
     auto default_affinities = Env::Default().GetDefaultThreadAffinities();
+    auto efficiency_classes = Env::Default().GetCoreEfficiencyClasses();
+    if (options.cache_domain >= 0) {
+      SelectCacheDomain(default_affinities, efficiency_classes, Env::Default().GetCoreCacheDomains(),
+                        options.cache_domain);
+    }
+    if (options.prefer_performance_cores) {
+      default_affinities = SelectPerformanceCores(std::move(default_affinities), efficiency_classes);
+    }
     if (default_affinities.size() <= 1) {
       return nullptr;
     }
@@ -132,6 +193,8 @@ CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   to.custom_thread_creation_options = options.custom_thread_creation_options;
   to.custom_join_thread_fn = options.custom_join_thread_fn;
   to.dynamic_block_base_ = options.dynamic_block_base_;
+  to.work_stealing_loops_ = options.work_stealing_loops_;
+  to.adaptive_spinning_ = options.adaptive_spinning_;
   if (to.custom_create_thread_fn) {
     ORT_ENFORCE(to.custom_join_thread_fn, "custom join thread function not set");
   }
@@ -145,7 +208,11 @@ CreateThreadPool(Env* env, OrtThreadPoolParams options, ThreadPoolType tpool_typ
   // If openmp is enabled we don't want to create any additional threadpools for sequential execution.
   // However, parallel execution relies on the existence of a separate threadpool. Hence we allow eigen threadpools
   // to be created for parallel execution.
-  ORT_UNUSED_PARAMETER(tpool_type);
+  // only the intra op pool runs the parallel loops that are held back by slow cores
+  if (tpool_type == ThreadPoolType::INTER_OP) {
+    options.prefer_performance_cores = false;
+    options.cache_domain = -1;
+  }
   return CreateThreadPoolHelper(env, options);
 }
 
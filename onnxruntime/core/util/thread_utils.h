@@ -21,10 +21,28 @@ struct OrtThreadPoolParams {
   // If it is true, the thread pool will spin a while after the queue became empty.
   bool allow_spinning = true;
 
+  // If it is true and thread_pool_size = 0 on a CPU with cores of different efficiency classes, the default pool
+  // size and affinities only cover the performance cores. Parallel loops split evenly across all cores would
+  // otherwise finish at the speed of the slowest ones.
+  bool prefer_performance_cores = true;
+
+  // If it is non-negative and thread_pool_size = 0, the default pool size and affinities only cover the cores that
+  // share the last level cache of this domain, modulo the number of domains, e.g. one CCX of an AMD EPYC CPU.
+  // Sessions confined to different domains don't evict each other's data from the cache.
+  int cache_domain = -1;
+
   // It it is non-negative, thread pool will split a task by a decreasing block size
   // of remaining_of_total_iterations / (num_of_threads * dynamic_block_base_)
   int dynamic_block_base_ = 0;
 
+  // If it is true, parallel loops are scheduled by work stealing, splitting the remaining iterations of a busy
+  // thread in half when an idle thread takes them.
+  bool work_stealing_loops_ = false;
+
+  // If it is true and allow_spinning is set, each thread learns how long it usually waits for work and spins only
+  // when that wait is short, blocking right away during the longer gaps between requests.
+  bool adaptive_spinning_ = false;
+
   unsigned int stack_size = 0;
 
   // A utf-8 string of affinity settings, format be like:
@@ -4,6 +4,7 @@
 # --------------------------------------------------------------------------
 from __future__ import annotations
 
+import asyncio
 import collections
 import collections.abc
 import os
@@ -209,6 +210,12 @@ class Session:
         :return: list of results, every result is either a numpy array,
             a sparse tensor, a list or a dictionary.
 
+        An input value is a numpy array, an `OrtValue`, a list, a dictionary, or any object
+        implementing the buffer protocol, ``__array_interface__`` or ``__array__`` (e.g. a
+        CPU torch tensor), which is fed without a copy when it is C contiguous. In a build
+        with CUDA, an object implementing ``__cuda_array_interface__`` (e.g. a cupy array) is
+        fed without a copy too, and in a training build an object implementing ``__dlpack__``.
+
         ::
 
             sess.run([output_name], {input_name: x})
@@ -228,7 +235,41 @@ class Session:
                 return self._sess.run(output_names, input_feed, run_options)
             raise
 
-    def run_async(self, output_names, input_feed, callback, user_data, run_options=None):
+    def run_with_dlpack_outputs(self, output_names, input_feed, run_options=None):
+        """
+        Compute the predictions, returning the tensors as DLPack capsules which share the
+        memory of the outputs, on the device they were computed on. It requires a training
+        build, which supports DLPack.
+
+        :param output_names: name of the outputs
+        :param input_feed: dictionary ``{ input_name: input_value }``, see :meth:`run`
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+        :return: list of results, every tensor is a DLPack capsule, the others are converted
+            as in :meth:`run`.
+
+        ::
+
+            outputs = sess.run_with_dlpack_outputs([output_name], {input_name: torch_tensor})
+            y = torch.utils.dlpack.from_dlpack(outputs[0])
+        """
+        if not hasattr(self._sess, "run_with_dlpack_outputs"):
+            raise RuntimeError("DLPack outputs are only supported in a training build.")
+        self._validate_input(list(input_feed.keys()))
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+        try:
+            return self._sess.run_with_dlpack_outputs(output_names, input_feed, run_options)
+        except C.EPFail as err:
+            if self._enable_fallback:
+                print(f"EP Error: {err!s} using {self._providers}")
+                print(f"Falling back to {self._fallback_providers} and retrying.")
+                self.set_providers(self._fallback_providers)
+                # Fallback only once.
+                self.disable_fallback()
+                return self._sess.run_with_dlpack_outputs(output_names, input_feed, run_options)
+            raise
+
+    def run_async(self, output_names, input_feed, callback=None, user_data=None, run_options=None):
         """
         Compute the predictions asynchronously in a separate cxx thread from ort intra-op threadpool.
 
@@ -236,8 +277,13 @@ class Session:
         :param input_feed: dictionary ``{ input_name: input_value }``
         :param callback: python function that accept array of results, and a status string on error.
             The callback will be invoked by a cxx thread from ort intra-op threadpool.
+            If None, the method returns an :class:`asyncio.Future` of the results, completed on the
+            running event loop, so that a coroutine can await it. The error of the run is raised as a
+            RuntimeError.
         :param run_options: See :class:`onnxruntime.RunOptions`.
 
+        The session must have an intra-op thread pool, i.e. ``intra_op_num_threads`` must not be 1.
+
         ::
             class MyData:
                 def __init__(self):
@@ -252,12 +298,40 @@ class Session:
                 # save results to user_data
 
             sess.run_async([output_name], {input_name: x}, callback)
+
+            # in a coroutine
+            results = await sess.run_async([output_name], {input_name: x})
         """
         self._validate_input(list(input_feed.keys()))
         if not output_names:
             output_names = [output.name for output in self._outputs_meta]
+        if callback is None:
+            return self._run_async_future(output_names, input_feed, run_options)
         return self._sess.run_async(output_names, input_feed, callback, user_data, run_options)
 
+    def _run_async_future(self, output_names, input_feed, run_options):
+        loop = asyncio.get_running_loop()
+        future = loop.create_future()
+
+        def complete(results, err):
+            if future.cancelled():
+                return
+            if err:
+                future.set_exception(RuntimeError(err))
+            else:
+                future.set_result(results)
+
+        def callback(results, _, err):
+            # invoked by a thread of the intra-op thread pool, which hands the results to the event loop
+            try:
+                loop.call_soon_threadsafe(complete, results, err)
+            except RuntimeError:
+                # the event loop was closed
+                pass
+
+        self._sess.run_async(output_names, input_feed, callback, None, run_options)
+        return future
+
     def run_with_ort_values(self, output_names, input_dict_ort_values, run_options=None):
         """
         Compute the predictions.
@@ -945,6 +945,115 @@ static void CreateGenericIterableMLValue(PyObject* iterator, AllocatorPtr alloc,
   }
 }
 
+// Whether numpy can view the memory of the object: it implements the buffer protocol (memoryview, array.array, ...),
+// __array_interface__ or __array__ (e.g. a torch tensor on the CPU).
+static bool IsArrayLike(PyObject* obj) {
+  return !PyUnicode_Check(obj) && !PyBytes_Check(obj) &&
+         (PyObject_CheckBuffer(obj) || PyObject_HasAttrString(obj, "__array_interface__") ||
+          PyObject_HasAttrString(obj, "__array__"));
+}
+
+// Creates a tensor from an object numpy can view. The tensor uses the memory of the object if it is C contiguous,
+// a contiguous copy otherwise, and keeps the object alive until the tensor is released.
+static void CreateTensorMLValueFromArrayLike(const AllocatorPtr& alloc, const std::string& name_input,
+                                             const py::object& value, OrtValue* p_mlvalue, bool use_numpy_data_memory,
+                                             MemCpyFunc mem_cpy_to_device) {
+  PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(
+      PyArray_FromAny(value.ptr(), nullptr, 0, 0, NPY_ARRAY_CARRAY_RO, nullptr));
+  if (arr == nullptr) {
+    throw py::error_already_set();
+  }
+
+  UniqueDecRefPtr<PyArrayObject> arr_guard(arr, DecRefFn<PyArrayObject>());
+  if (use_numpy_data_memory) {
+    auto pybind_alloc = std::make_shared<OrtPybindSingleUseAllocator>(std::move(arr_guard), name_input, alloc->Info());
+    CreateTensorMLValueOwned(pybind_alloc, alloc, p_mlvalue);
+  } else {
+    CreateTensorMLValue(alloc, name_input, arr, p_mlvalue, false, mem_cpy_to_device);
+  }
+}
+
+#ifdef ENABLE_TRAINING
+static bool IsBoolTensorInput(const InputDefList* input_def_list, const std::string& name_input) {
+  if (input_def_list == nullptr) {
+    return false;
+  }
+  auto it = std::find_if(input_def_list->begin(), input_def_list->end(),
+                         [&name_input](const NodeArg* node_arg) { return name_input == node_arg->Name(); });
+  const onnx::TypeProto* type_proto = it == input_def_list->end() ? nullptr : (*it)->TypeAsProto();
+  return type_proto != nullptr && type_proto->has_tensor_type() &&
+         type_proto->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_BOOL;
+}
+
+// Whether to wrap the object with DLPack: a tensor on a device, or on the CPU if numpy can't view it. numpy takes
+// the CPU tensors it can view, as it copies those which are not contiguous where DLPack would fail.
+static bool IsDlpackTensor(const py::object& value) {
+  if (!PyObject_HasAttrString(value.ptr(), "__dlpack__")) {
+    return false;
+  }
+  if (!PyObject_HasAttrString(value.ptr(), "__dlpack_device__")) {
+    return !IsArrayLike(value.ptr());
+  }
+  auto device = value.attr("__dlpack_device__")().cast<py::tuple>();
+  return device[0].cast<int>() != static_cast<int>(kDLCPU) || !IsArrayLike(value.ptr());
+}
+#endif
+
+#ifdef USE_CUDA
+// Creates a CUDA tensor which uses the memory of an object implementing __cuda_array_interface__ (e.g. a cupy array
+// or a numba device array) and keeps the object alive until the tensor is released. The interface doesn't give the
+// device, the memory is assumed to be on the current one, and the producer must have synchronized its stream.
+static void CreateTensorMLValueFromCudaArrayInterface(const std::string& name_input, const py::object& value,
+                                                      OrtValue* p_mlvalue) {
+  py::dict interface = value.attr("__cuda_array_interface__");
+
+  PyArray_Descr* descr = nullptr;
+  if (!PyArray_DescrConverter(py::object(interface["typestr"]).ptr(), &descr)) {
+    throw py::error_already_set();
+  }
+  const int npy_type = descr->type_num;
+  const int64_t item_size = descr->elsize;
+  Py_DECREF(descr);
+  if (!IsNumericNumpyType(npy_type)) {
+    throw std::runtime_error("Unsupported type of the __cuda_array_interface__ of input '" + name_input + "'.");
+  }
+
+  const auto dims = interface["shape"].cast<std::vector<int64_t>>();
+  if (interface.contains("strides") && !interface["strides"].is_none()) {
+    const auto strides = interface["strides"].cast<std::vector<int64_t>>();
+    int64_t contiguous_stride = item_size;
+    for (size_t i = dims.size(); i-- > 0;) {
+      if (dims[i] != 1 && strides[i] != contiguous_stride) {
+        throw std::runtime_error("The __cuda_array_interface__ of input '" + name_input +
+                                 "' must be C contiguous.");
+      }
+      contiguous_stride *= dims[i];
+    }
+  }
+
+  void* data = reinterpret_cast<void*>(py::tuple(interface["data"])[0].cast<uintptr_t>());
+  int device_id = 0;
+  Ort::Status status(GetProviderInfo_CUDA().GetCurrentGpuDeviceId(&device_id));
+  if (!status.IsOK()) {
+    throw std::runtime_error(status.GetErrorMessage());
+  }
+  const OrtMemoryInfo mem_info = GetMemoryInfoPerDeviceType(
+      OrtDevice(OrtDevice::GPU, OrtDevice::MemType::DEFAULT, static_cast<OrtDevice::DeviceId>(device_id)));
+  auto p_tensor = std::make_unique<Tensor>(NumpyTypeToOnnxRuntimeTensorType(npy_type), TensorShape(dims), data,
+                                           mem_info);
+
+  // the deleter may run without the GIL, e.g. after run_async
+  std::shared_ptr<PyObject> owner(value.inc_ref().ptr(), [](PyObject* obj) {
+    py::gil_scoped_acquire acquire;
+    Py_DECREF(obj);
+  });
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  p_mlvalue->Init(p_tensor.release(), ml_tensor, [owner = std::move(owner)](void* tensor) {
+    delete static_cast<Tensor*>(tensor);
+  });
+}
+#endif
+
 // Setting `use_numpy_data_memory` to `true` will ensure that the underlying numpy array buffer is directly used
 // as the backing data buffer for the ORT Tensor where applicable (for numeric tensors)
 // The numpy object owns the memory and needs to be alive until the corresponding OrtValue is in scope
@@ -996,6 +1105,18 @@ void CreateGenericMLValue(const onnxruntime::InputDefList* input_def_list, const
     // This should just increase the ref counts of the underlying shared_ptrs in the native OrtValue
     // and the ref count will be decreased when the OrtValue used for Run() is destroyed upon exit.
     *p_mlvalue = *value.attr(PYTHON_ORTVALUE_NATIVE_OBJECT_ATTR).cast<OrtValue*>();
+#ifdef ENABLE_TRAINING
+  } else if (!accept_only_numpy_array && IsDlpackTensor(value)) {
+    // e.g. a torch or a cupy tensor on a GPU, the OrtValue uses its memory
+    py::object capsule = value.attr("__dlpack__")();
+    *p_mlvalue = FromDlpack(capsule.ptr(), IsBoolTensorInput(input_def_list, name_input));
+#endif
+#ifdef USE_CUDA
+  } else if (!accept_only_numpy_array && PyObject_HasAttrString(value.ptr(), "__cuda_array_interface__")) {
+    CreateTensorMLValueFromCudaArrayInterface(name_input, value, p_mlvalue);
+#endif
+  } else if (!accept_only_numpy_array && IsArrayLike(value.ptr())) {
+    CreateTensorMLValueFromArrayLike(alloc, name_input, value, p_mlvalue, use_numpy_data_memory, mem_cpy_to_device);
   } else if (!accept_only_numpy_array) {
     auto iterator = PyObject_GetIter(value.ptr());
     if (iterator == NULL) {
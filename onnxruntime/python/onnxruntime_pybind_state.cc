@@ -78,6 +78,8 @@ using PyCallback = std::function<void(std::vector<py::object>, py::object user_d
 struct AsyncResource {
   std::vector<OrtValue> feeds;
   std::vector<const OrtValue*> feeds_raw;
+  // the python objects of the feeds, which may own their memory, released with the GIL in AsyncCallback
+  std::vector<py::object> feed_objects;
 
   std::vector<std::string> feed_names;
   std::vector<const char*> feed_names_raw;
@@ -94,6 +96,7 @@ struct AsyncResource {
   void ReserveFeeds(size_t sz) {
     feeds.reserve(sz);
     feeds_raw.reserve(sz);
+    feed_objects.reserve(sz);
     feed_names.reserve(sz);
     feed_names_raw.reserve(sz);
   }
@@ -713,6 +716,14 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
             } else {
               ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_cuda_graph_enable' should be 'True' or 'False'. Default value is 'False'.\n");
             }
+          } else if (option.first == "trt_background_engine_build") {
+            if (option.second == "True" || option.second == "true") {
+              params.trt_background_engine_build = true;
+            } else if (option.second == "False" || option.second == "false") {
+              params.trt_background_engine_build = false;
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_background_engine_build' should be 'True' or 'False'. Default value is 'False'.\n");
+            }
           } else {
             ORT_THROW("Invalid TensorRT EP option: ", option.first);
           }
@@ -1151,6 +1162,42 @@ bool CheckIfTensor(const std::vector<const NodeArg*>& def_list,
   return type_proto.has_tensor_type();
 }
 
+// Runs the session with the python objects of run, see CreateGenericMLValue. The numeric arrays and tensors are fed
+// without a copy when they are contiguous.
+static std::vector<OrtValue> RunWithPyFeeds(PyInferenceSession* sess, const std::vector<std::string>& output_names,
+                                            const std::map<std::string, py::object>& pyfeeds,
+                                            RunOptions* run_options) {
+  NameMLValMap feeds;
+  for (const auto& feed : pyfeeds) {
+    // No need to process 'None's sent in by the user
+    // to feed Optional inputs in the graph.
+    // We just won't include anything in the feed and ORT
+    // will handle such implicit 'None's internally.
+    if (!feed.second.is(py::none())) {
+      OrtValue ml_value;
+      auto px = sess->GetSessionHandle()->GetModelInputs();
+      if (!px.first.IsOK() || !px.second) {
+        throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
+      }
+      CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
+      ThrowIfPyErrOccured();
+      feeds.insert(std::make_pair(feed.first, ml_value));
+    }
+  }
+
+  std::vector<OrtValue> fetches;
+  {
+    // release GIL to allow multiple python threads to invoke Run() in parallel.
+    py::gil_scoped_release release;
+    if (run_options != nullptr) {
+      OrtPybindThrowIfError(sess->GetSessionHandle()->Run(*run_options, feeds, output_names, &fetches));
+    } else {
+      OrtPybindThrowIfError(sess->GetSessionHandle()->Run(feeds, output_names, &fetches));
+    }
+  }
+  return fetches;
+}
+
 #if defined(USE_OPENVINO) || \
     defined(USE_CUDA) ||     \
     defined(USE_ROCM)
@@ -1324,7 +1371,8 @@ void addObjectMethods(py::module& m, ExecutionProviderRegistrationFn ep_registra
 
   py::enum_<ExecutionOrder>(m, "ExecutionOrder")
       .value("DEFAULT", ExecutionOrder::DEFAULT)
-      .value("PRIORITY_BASED", ExecutionOrder::PRIORITY_BASED);
+      .value("PRIORITY_BASED", ExecutionOrder::PRIORITY_BASED)
+      .value("MEMORY_EFFICIENT", ExecutionOrder::MEMORY_EFFICIENT);
 
   py::enum_<OrtAllocatorType>(m, "OrtAllocatorType")
       .value("INVALID", OrtInvalidAllocator)
@@ -1808,36 +1856,35 @@ including arg name, arg type (contains both type and shape).)pbdoc")
            [](PyInferenceSession* sess, std::vector<std::string> output_names,
               std::map<std::string, py::object> pyfeeds, RunOptions* run_options = nullptr)
                -> std::vector<py::object> {
-             NameMLValMap feeds;
-             for (auto feed : pyfeeds) {
-               // No need to process 'None's sent in by the user
-               // to feed Optional inputs in the graph.
-               // We just won't include anything in the feed and ORT
-               // will handle such implicit 'None's internally.
-               if (!feed.second.is(py::none())) {
-                 OrtValue ml_value;
-                 auto px = sess->GetSessionHandle()->GetModelInputs();
-                 if (!px.first.IsOK() || !px.second) {
-                   throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
-                 }
-                 CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
-                 ThrowIfPyErrOccured();
-                 feeds.insert(std::make_pair(feed.first, ml_value));
-               }
-             }
+             std::vector<OrtValue> fetches = RunWithPyFeeds(sess, output_names, pyfeeds, run_options);
 
-             std::vector<OrtValue> fetches;
-             common::Status status;
-
-             {
-               // release GIL to allow multiple python threads to invoke Run() in parallel.
-               py::gil_scoped_release release;
-               if (run_options != nullptr) {
-                 OrtPybindThrowIfError(sess->GetSessionHandle()->Run(*run_options, feeds, output_names, &fetches));
-               } else {
-                 OrtPybindThrowIfError(sess->GetSessionHandle()->Run(feeds, output_names, &fetches));
+             std::vector<py::object> rfetch;
+             rfetch.reserve(fetches.size());
+             size_t pos = 0;
+             for (auto fet : fetches) {
+               if (fet.IsAllocated()) {
+                 if (fet.IsTensor()) {
+                   rfetch.push_back(AddTensorAsPyObj(fet, nullptr, nullptr));
+                 } else if (fet.IsSparseTensor()) {
+                   rfetch.push_back(GetPyObjectFromSparseTensor(pos, fet, nullptr));
+                 } else {
+                   rfetch.push_back(AddNonTensorAsPyObj(fet, nullptr, nullptr));
+                 }
+               } else {  // Send back None because the corresponding OrtValue was empty
+                 rfetch.push_back(py::none());
                }
+               ++pos;
              }
+             return rfetch;
+           })
+#ifdef ENABLE_TRAINING
+      /// Same as run, but returns the tensors as DLPack capsules which share the memory of the outputs, on the
+      /// device they were computed on. The other outputs are converted as in run.
+      .def("run_with_dlpack_outputs",
+           [](PyInferenceSession* sess, std::vector<std::string> output_names,
+              std::map<std::string, py::object> pyfeeds, RunOptions* run_options = nullptr)
+               -> std::vector<py::object> {
+             std::vector<OrtValue> fetches = RunWithPyFeeds(sess, output_names, pyfeeds, run_options);
 
              std::vector<py::object> rfetch;
              rfetch.reserve(fetches.size());
@@ -1845,7 +1892,7 @@ including arg name, arg type (contains both type and shape).)pbdoc")
              for (auto fet : fetches) {
                if (fet.IsAllocated()) {
                  if (fet.IsTensor()) {
-                   rfetch.push_back(AddTensorAsPyObj(fet, nullptr, nullptr));
+                   rfetch.push_back(py::reinterpret_steal<py::object>(ToDlpack(fet)));
                  } else if (fet.IsSparseTensor()) {
                    rfetch.push_back(GetPyObjectFromSparseTensor(pos, fet, nullptr));
                  } else {
@@ -1858,6 +1905,7 @@ including arg name, arg type (contains both type and shape).)pbdoc")
              }
              return rfetch;
            })
+#endif
       .def("run_async",
            [](PyInferenceSession* sess,
               std::vector<std::string> output_names,
@@ -1881,6 +1929,7 @@ including arg name, arg type (contains both type and shape).)pbdoc")
                  ThrowIfPyErrOccured();
                  async_resource->feeds.push_back(ml_value);
                  async_resource->feeds_raw.push_back(&async_resource->feeds.back());
+                 async_resource->feed_objects.push_back(feed.second);
                  async_resource->feed_names.push_back(feed.first);
                  async_resource->feed_names_raw.push_back(async_resource->feed_names.back().c_str());
                }
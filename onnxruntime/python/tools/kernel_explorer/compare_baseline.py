@@ -0,0 +1,172 @@
+# -------------------------------------------------------------------------
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+# --------------------------------------------------------------------------
+"""Flags the kernel performance regressions of a benchmark run against a baseline.
+
+The results are the JSON written with --benchmark_out=<file> by the native CPU kernel benchmarks: the MLAS kernels of
+onnxruntime_mlas_benchmark and the CPU EP kernels of onnxruntime_benchmark --model_ops=<model>. Run them with
+--benchmark_repetitions so that the median of the repetitions is compared.
+
+The baseline is a JSON file of the times of the kernels on one machine, with the tolerances of the comparison:
+
+    {
+      "mlas_kernel_isa": "sse2 avx avx2 f16c",
+      "tolerance": 0.1,
+      "kernels": {
+        "SGEMM/NORMAL_NoTrans/M:63/N:63/K:63/real_time": {"time_ns": 5210.3},
+        "SOFTMAX/Softmax/N:1/D:32000/Threads:1/real_time": {"time_ns": 40211.0, "tolerance": 0.25}
+      }
+    }
+
+A kernel regresses when its time exceeds the baseline by more than its tolerance, the "tolerance" of the baseline, or
+--tolerance when neither is given. The kernels MLAS dispatches to are recorded as "mlas_kernel_isa": a run where MLAS
+selected other kernels than the baseline fails too, as its times can't be compared.
+
+--update writes the baseline from the results, keeping the tolerances it had.
+
+Example:
+    onnxruntime_mlas_benchmark --benchmark_repetitions=5 --benchmark_out=mlas.json
+    python compare_baseline.py mlas.json baselines/mlas_avx2.json
+"""
+
+import argparse
+import json
+import statistics
+import sys
+
+TIME_UNITS_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def parse_arguments(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("results", help="JSON of the benchmark run, written with --benchmark_out")
+    parser.add_argument("baseline", help="JSON of the baseline, written with --update")
+    parser.add_argument(
+        "--tolerance", type=float, default=0.1, help="relative slowdown allowed when the baseline gives none"
+    )
+    parser.add_argument("--update", action="store_true", help="write the baseline from the results")
+    parser.add_argument(
+        "--allow_missing", action="store_true", help="don't fail on kernels of the baseline the run didn't measure"
+    )
+    parser.add_argument(
+        "--allow_isa_change", action="store_true", help="compare the times even if MLAS selected other kernels"
+    )
+    return parser.parse_args(argv)
+
+
+def load_results(path):
+    """Returns the MLAS kernel ISA of the run and the time in ns of each benchmark, the median of its repetitions."""
+    with open(path, encoding="utf-8") as f:
+        results = json.load(f)
+    if "benchmarks" not in results:
+        raise ValueError(f"{path} is not the JSON output of a benchmark run")
+
+    times = {}
+    medians = {}
+    for benchmark in results["benchmarks"]:
+        if benchmark.get("error_occurred"):
+            continue
+        name = benchmark.get("run_name", benchmark["name"])
+        time_ns = benchmark["real_time"] * TIME_UNITS_NS[benchmark.get("time_unit", "ns")]
+        if benchmark.get("run_type") == "aggregate":
+            if benchmark.get("aggregate_name") == "median":
+                medians[name] = time_ns
+        else:
+            times.setdefault(name, []).append(time_ns)
+
+    kernels = {name: statistics.median(samples) for name, samples in times.items()}
+    kernels.update(medians)
+    return results.get("context", {}).get("mlas_kernel_isa"), kernels
+
+
+def load_baseline(path):
+    try:
+        with open(path, encoding="utf-8") as f:
+            return json.load(f)
+    except FileNotFoundError:
+        return {"kernels": {}}
+
+
+def update_baseline(path, baseline, isa, kernels):
+    previous = baseline.get("kernels", {})
+    updated = {}
+    for name, time_ns in sorted(kernels.items()):
+        entry = {"time_ns": round(time_ns, 1)}
+        if "tolerance" in previous.get(name, {}):
+            entry["tolerance"] = previous[name]["tolerance"]
+        updated[name] = entry
+    baseline["kernels"] = updated
+    if isa is not None:
+        baseline["mlas_kernel_isa"] = isa
+    with open(path, "w", encoding="utf-8") as f:
+        json.dump(baseline, f, indent=2)
+        f.write("\n")
+    print(f"Wrote the baseline of {len(updated)} kernels to {path}")
+
+
+def compare(baseline, isa, kernels, default_tolerance, allow_missing, allow_isa_change):
+    """Prints the comparison and returns whether the run passes."""
+    passed = True
+    baseline_isa = baseline.get("mlas_kernel_isa")
+    if baseline_isa is not None and isa is not None and baseline_isa != isa:
+        print(f"MLAS kernel ISA changed: baseline '{baseline_isa}', run '{isa}'")
+        if not allow_isa_change:
+            print("The times aren't compared (--allow_isa_change to compare them anyway).")
+            return False
+
+    global_tolerance = baseline.get("tolerance", default_tolerance)
+    regressions = []
+    improvements = []
+    missing = []
+    for name, entry in sorted(baseline.get("kernels", {}).items()):
+        if name not in kernels:
+            missing.append(name)
+            continue
+        tolerance = entry.get("tolerance", global_tolerance)
+        change = kernels[name] / entry["time_ns"] - 1.0
+        if change > tolerance:
+            regressions.append((name, entry["time_ns"], kernels[name], change, tolerance))
+        elif change < -tolerance:
+            improvements.append((name, entry["time_ns"], kernels[name], change, tolerance))
+
+    def print_changes(title, changes):
+        print(f"{title}:")
+        print(f"  {'baseline ns':>14} {'run ns':>14} {'change':>8} {'tolerance':>9}  kernel")
+        for name, baseline_ns, run_ns, change, tolerance in sorted(changes, key=lambda c: -abs(c[3])):
+            print(f"  {baseline_ns:14.1f} {run_ns:14.1f} {change:+8.1%} {tolerance:9.1%}  {name}")
+
+    if regressions:
+        print_changes(f"{len(regressions)} kernels regressed", regressions)
+        passed = False
+    if improvements:
+        print_changes(f"{len(improvements)} kernels improved, consider updating the baseline", improvements)
+    if missing:
+        print(f"{len(missing)} kernels of the baseline weren't measured:")
+        for name in missing:
+            print(f"  {name}")
+        passed = passed and allow_missing
+    new = sorted(set(kernels) - set(baseline.get("kernels", {})))
+    if new:
+        print(f"{len(new)} kernels aren't in the baseline yet, e.g. {new[0]}")
+
+    compared = len(baseline.get("kernels", {})) - len(missing)
+    print(f"{'PASSED' if passed else 'FAILED'}: {compared} kernels compared, {len(regressions)} regressions")
+    return passed
+
+
+def main(argv=None):
+    args = parse_arguments(argv)
+    isa, kernels = load_results(args.results)
+    baseline = load_baseline(args.baseline)
+    if args.update:
+        update_baseline(args.baseline, baseline, isa, kernels)
+        return 0
+    if not baseline.get("kernels"):
+        print(f"{args.baseline} has no kernels, create it with --update")
+        return 1
+    return 0 if compare(baseline, isa, kernels, args.tolerance, args.allow_missing, args.allow_isa_change) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
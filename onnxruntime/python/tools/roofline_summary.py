@@ -0,0 +1,127 @@
+# -------------------------------------------------------------------------
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+# --------------------------------------------------------------------------
+"""Summarizes an onnxruntime profile on a roofline.
+
+The kernel events of the profile carry the estimated "flops" of the node and the "bytes" it read and wrote. This
+script totals them per node (or per op type) over the profiled runs and reports the achieved GFLOP/s, GB/s and
+arithmetic intensity, and the fraction of the device peak when it is known.
+
+The peak FLOP/s of the CPU is computed from the "device_peak" event of the profile, which gives the FLOP per cycle
+per core from CPUID, and the clock frequency given with --ghz. Peaks of other devices, and the memory bandwidth, are
+given with --peak_gflops and --peak_gbps.
+
+Example:
+    python roofline_summary.py --ghz 3.0 --peak_gbps 80 onnxruntime_profile__2024-01-01_00-00-00.json
+"""
+
+import argparse
+import collections
+import json
+import sys
+
+
+def parse_arguments(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("profile", help="profile json written by onnxruntime with profiling enabled")
+    parser.add_argument("--ghz", type=float, default=None, help="clock frequency of the CPU cores in GHz")
+    parser.add_argument("--peak_gflops", type=float, default=None, help="peak GFLOP/s, overrides the CPU peak")
+    parser.add_argument("--peak_gbps", type=float, default=None, help="peak memory bandwidth in GB/s")
+    parser.add_argument("--group_by", choices=["node", "op_type"], default="node", help="how to aggregate kernels")
+    parser.add_argument("--provider", default=None, help="only report nodes of this execution provider")
+    parser.add_argument("--top", type=int, default=30, help="number of entries to print, by total time")
+    return parser.parse_args(argv)
+
+
+def load_events(path):
+    with open(path, encoding="utf-8") as f:
+        events = json.load(f)
+    if not isinstance(events, list):
+        raise ValueError(f"{path} is not an onnxruntime profile")
+    return events
+
+
+def get_peak_gflops(events, ghz, peak_gflops):
+    if peak_gflops is not None:
+        return peak_gflops
+    if ghz is None:
+        return None
+    for event in events:
+        if event.get("name") == "device_peak":
+            args = event.get("args", {})
+            return int(args["num_cores"]) * int(args["fp32_flops_per_cycle_per_core"]) * ghz
+    return None
+
+
+def summarize(events, group_by, provider):
+    totals = collections.OrderedDict()
+    for event in events:
+        args = event.get("args", {})
+        if event.get("cat") != "Node" or not event.get("name", "").endswith("_kernel_time"):
+            continue
+        if provider is not None and args.get("provider") != provider:
+            continue
+
+        key = args.get("op_name", "") if group_by == "op_type" else event["name"][: -len("_kernel_time")]
+        entry = totals.setdefault(
+            key, {"op_type": args.get("op_name", ""), "calls": 0, "dur_us": 0, "flops": 0, "bytes": 0, "known": True}
+        )
+        entry["calls"] += 1
+        entry["dur_us"] += int(event.get("dur", 0))
+        entry["bytes"] += int(args.get("bytes", 0) or 0)
+        if args.get("flops"):
+            entry["flops"] += int(args["flops"])
+        else:
+            entry["known"] = False
+    return totals
+
+
+def print_summary(totals, peak_gflops, peak_gbps, top, out=sys.stdout):
+    header = f"{'name':<48} {'op_type':<24} {'calls':>6} {'time_ms':>10} {'GFLOP/s':>10} {'GB/s':>9} {'FLOP/B':>8}"
+    if peak_gflops is not None:
+        header += f" {'%peak_flops':>11}"
+    if peak_gbps is not None:
+        header += f" {'%peak_bw':>9}"
+    if peak_gflops is not None and peak_gbps is not None:
+        header += f" {'bound':>7}"
+    print(header, file=out)
+
+    total_us = sum(entry["dur_us"] for entry in totals.values())
+    entries = sorted(totals.items(), key=lambda item: item[1]["dur_us"], reverse=True)
+    for name, entry in entries[:top]:
+        seconds = entry["dur_us"] * 1e-6
+        gflops = entry["flops"] / seconds * 1e-9 if entry["known"] and seconds > 0 else None
+        gbps = entry["bytes"] / seconds * 1e-9 if seconds > 0 else None
+        intensity = entry["flops"] / entry["bytes"] if entry["known"] and entry["bytes"] > 0 else None
+
+        def fmt(value, width, precision=1):
+            return f"{value:>{width}.{precision}f}" if value is not None else f"{'-':>{width}}"
+
+        line = (
+            f"{name[:48]:<48} {entry['op_type'][:24]:<24} {entry['calls']:>6} {fmt(seconds * 1e3, 10, 3)} "
+            f"{fmt(gflops, 10)} {fmt(gbps, 9)} {fmt(intensity, 8, 2)}"
+        )
+        if peak_gflops is not None:
+            line += f" {fmt(gflops / peak_gflops * 100 if gflops is not None else None, 11)}"
+        if peak_gbps is not None:
+            line += f" {fmt(gbps / peak_gbps * 100 if gbps is not None else None, 9)}"
+        if peak_gflops is not None and peak_gbps is not None:
+            # the ridge point of the roofline separates memory bound from compute bound kernels
+            bound = "-" if intensity is None else ("compute" if intensity >= peak_gflops / peak_gbps else "memory")
+            line += f" {bound:>7}"
+        print(line, file=out)
+
+    print(f"total kernel time: {total_us * 1e-3:.3f} ms in {len(totals)} entries", file=out)
+
+
+def main(argv=None):
+    args = parse_arguments(argv)
+    events = load_events(args.profile)
+    peak_gflops = get_peak_gflops(events, args.ghz, args.peak_gflops)
+    totals = summarize(events, args.group_by, args.provider)
+    print_summary(totals, peak_gflops, args.peak_gbps, args.top)
+
+
+if __name__ == "__main__":
+    main()
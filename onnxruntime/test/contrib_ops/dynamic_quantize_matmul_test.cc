@@ -205,5 +205,53 @@ TEST(DynamicQuantizeMatMul, B_PerColumn_ND) {
   test_case({15, 14, 13}, {15, 13, 27}, {15, 1, 27});
 }
 
+TEST(DynamicQuantizeMatMul, PerRowQuantization) {
+  constexpr int64_t M = 6;
+  constexpr int64_t K = 16;
+  constexpr int64_t N = 8;
+
+  RandomValueGenerator random{};
+  std::vector<float> A_data = random.Uniform<float>(AsSpan<int64_t>({M, K}), -1.0f, 1.0f);
+  // rows with very different ranges are where a single scale for A loses precision
+  for (int64_t k = 0; k < K; k++) {
+    A_data[k] *= 100.0f;
+  }
+  std::vector<int32_t> tmp_B_data = random.Uniform<int32_t>(AsSpan<int64_t>({K, N}), -64, 64);
+  std::vector<int8_t> B_data(tmp_B_data.begin(), tmp_B_data.end());
+  std::vector<float> B_scale = random.Uniform<float>(AsSpan<int64_t>({N}), 0.01f, 0.1f);
+  std::vector<float> Bias = random.Uniform<float>(AsSpan<int64_t>({N}), -0.1f, 0.1f);
+
+  // reference: each row of A quantized symmetrically with its own scale
+  std::vector<float> Y_data(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    float max_abs = 0.0f;
+    for (int64_t k = 0; k < K; k++) {
+      max_abs = std::max(max_abs, std::abs(A_data[m * K + k]));
+    }
+    const float a_scale = max_abs / 127.0f;
+    for (int64_t n = 0; n < N; n++) {
+      int32_t sum = 0;
+      for (int64_t k = 0; k < K; k++) {
+        sum += static_cast<int32_t>(std::nearbyint(A_data[m * K + k] / a_scale)) * B_data[k * N + n];
+      }
+      Y_data[m * N + n] = static_cast<float>(sum) * a_scale * B_scale[n] + Bias[n];
+    }
+  }
+
+  OpTester test("DynamicQuantizeMatMul", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("per_row_quantization", 1);
+  test.AddInput<float>("A", {M, K}, A_data);
+  test.AddInput<int8_t>("B", {K, N}, B_data, true);
+  test.AddInput<float>("b_scale", {N}, B_scale);
+  test.AddOptionalInputEdge<int8_t>();
+  test.AddInput<float>("bias", {N}, Bias);
+  test.AddOutput<float>("Y", {M, N}, Y_data);
+  test.SetOutputAbsErr("Y", 0.002f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(ContribOpTest, EmbeddingBag_Sum) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("table", {3, 2}, {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f});
+  test.AddInput<int64_t>("indices", {2, 2}, {0LL, 2LL, 1LL, -2LL});
+  test.AddOutput<float>("output", {2, 2}, {4.0f, 6.0f, 4.0f, 6.0f});
+  test.Run();
+}
+
+TEST(ContribOpTest, EmbeddingBag_Mean) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("mode", "mean");
+  test.AddInput<float>("table", {3, 2}, {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f});
+  test.AddInput<int32_t>("indices", {2, 1, 3}, {0, 1, 2, 2, 2, 0});
+  test.AddOutput<float>("output", {2, 1, 2}, {2.0f, 3.0f, 8.0f / 3.0f, 11.0f / 3.0f});
+  test.Run();
+}
+
+TEST(ContribOpTest, EmbeddingBag_LargeBags) {
+  constexpr int64_t num_rows = 50;
+  constexpr int64_t dim = 37;
+  constexpr int64_t num_bags = 3;
+  constexpr int64_t bag_size = 70;
+
+  std::vector<float> table(num_rows * dim);
+  for (size_t i = 0; i < table.size(); ++i) {
+    table[i] = static_cast<float>(i % 11) * 0.25f;
+  }
+
+  std::vector<int64_t> indices(num_bags * bag_size);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    indices[i] = static_cast<int64_t>((i * 7) % num_rows);
+  }
+
+  std::vector<float> output(num_bags * dim, 0.0f);
+  for (int64_t b = 0; b < num_bags; ++b) {
+    for (int64_t l = 0; l < bag_size; ++l) {
+      const int64_t row = indices[b * bag_size + l];
+      for (int64_t d = 0; d < dim; ++d) {
+        output[b * dim + d] += table[row * dim + d];
+      }
+    }
+  }
+
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("table", {num_rows, dim}, table);
+  test.AddInput<int64_t>("indices", {num_bags, bag_size}, indices);
+  test.AddOutput<float>("output", {num_bags, dim}, output);
+  test.Run();
+}
+
+TEST(ContribOpTest, EmbeddingBag_InvalidIndex) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("table", {3, 2}, {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f});
+  test.AddInput<int64_t>("indices", {1, 2}, {0LL, 3LL});
+  test.AddOutput<float>("output", {1, 2}, {0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "indices element out of data bounds, idx=3");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
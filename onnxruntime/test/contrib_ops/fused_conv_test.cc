@@ -35,8 +35,8 @@ void TestConvOp(const ConvOpAndTestAttributes& attributes,
                 bool disable_rocm = false,
                 bool use_float16 = false,
                 bool weight_is_initializer = false) {
-  bool enable_cuda = HasCudaEnvironment(0) && !use_float16 && !disable_cuda;
-  // Only ROCm EP supports float16.
+  bool enable_cuda = HasCudaEnvironment(0) && !disable_cuda;
+  // CPU EP doesn't support float16.
   bool enable_rocm = (nullptr != DefaultRocmExecutionProvider().get()) && !disable_rocm;
   bool enable_cpu = (nullptr != DefaultCpuExecutionProvider().get()) && !use_float16 && !disable_cpu;
 
@@ -60,8 +60,9 @@ void TestConvOp(const ConvOpAndTestAttributes& attributes,
       test.AddAttribute("strides", attributes.strides);
     }
 
-    ORT_ENFORCE(!attributes.activation.empty(), "activation must be set");
-    test.AddAttribute("activation", attributes.activation);
+    if (!attributes.activation.empty()) {
+      test.AddAttribute("activation", attributes.activation);
+    }
 
     if (!attributes.activation_parameters.empty()) {
       test.AddAttribute("activation_params", attributes.activation_parameters);
@@ -212,6 +213,82 @@ TEST(FusedConvTest, Conv2D_Bias_Z_Relu) {
 
 #endif
 
+#if defined(USE_CUDA)
+
+TEST(FusedConvTest, Cuda_Conv2D_Bias_Z) {
+  ConvOpAndTestAttributes attrs = {
+      "",                           // auto_pad
+      vector<int64_t>{1, 1},        // dilations
+      1,                            // group
+      vector<int64_t>{2, 2},        // kernel_shape
+      vector<int64_t>{0, 0, 0, 0},  // pads
+      vector<int64_t>{1, 1},        // strides
+      ""                            // activation
+  };
+
+  vector<float> X = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f};
+  vector<int64_t> X_shape = {1, 1, 3, 3};
+  vector<float> W = {1.0f, 1.0f, 1.0f, 1.0f, -1.0f, -1.0f, -1.0f, -1.0f};
+  vector<int64_t> W_shape = {2, 1, 2, 2};
+  vector<int64_t> Y_shape = {1, 2, 2, 2};
+  vector<float> B = {1.0f, -1.0f};
+  vector<int64_t> B_shape = {2};
+  vector<float> Z = {-1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+  vector<int64_t> Z_shape = {1, 2, 2, 2};
+  auto expected_vals = {12.0f, 17.0f, 25.0f, 29.0f, -13.0f, -17.0f, -25.0f, -28.0f};
+  RunConvOp(attrs, {X, W, B, Z}, {X_shape, W_shape, B_shape, Z_shape}, expected_vals, Y_shape, true, false, true);
+}
+
+TEST(FusedConvTest, Cuda_Conv2D_Bias_Z_LeakyRelu) {
+  ConvOpAndTestAttributes attrs = {
+      "",                           // auto_pad
+      vector<int64_t>{1, 1},        // dilations
+      1,                            // group
+      vector<int64_t>{2, 2},        // kernel_shape
+      vector<int64_t>{0, 0, 0, 0},  // pads
+      vector<int64_t>{1, 1},        // strides
+      "LeakyRelu",                  // activation
+      vector<float>{0.5f}           // activation_parameters
+  };
+
+  vector<float> X = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f};
+  vector<int64_t> X_shape = {1, 1, 3, 3};
+  vector<float> W = {1.0f, 1.0f, 1.0f, 1.0f, -1.0f, -1.0f, -1.0f, -1.0f};
+  vector<int64_t> W_shape = {2, 1, 2, 2};
+  vector<int64_t> Y_shape = {1, 2, 2, 2};
+  vector<float> B = {1.0f, -1.0f};
+  vector<int64_t> B_shape = {2};
+  vector<float> Z = {-1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+  vector<int64_t> Z_shape = {1, 2, 2, 2};
+  auto expected_vals = {12.0f, 17.0f, 25.0f, 29.0f, -6.5f, -8.5f, -12.5f, -14.0f};
+  RunConvOp(attrs, {X, W, B, Z}, {X_shape, W_shape, B_shape, Z_shape}, expected_vals, Y_shape, true, false, true);
+}
+
+TEST(FusedConvTest, Cuda_Conv2D_Bias_Clip) {
+  ConvOpAndTestAttributes attrs = {
+      "",                           // auto_pad
+      vector<int64_t>{1, 1},        // dilations
+      1,                            // group
+      vector<int64_t>{2, 2},        // kernel_shape
+      vector<int64_t>{0, 0, 0, 0},  // pads
+      vector<int64_t>{1, 1},        // strides
+      "Clip",                       // activation
+      vector<float>{-14.0f, 20.0f}  // activation_parameters
+  };
+
+  vector<float> X = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f};
+  vector<int64_t> X_shape = {1, 1, 3, 3};
+  vector<float> W = {1.0f, 1.0f, 1.0f, 1.0f, -1.0f, -1.0f, -1.0f, -1.0f};
+  vector<int64_t> W_shape = {2, 1, 2, 2};
+  vector<int64_t> Y_shape = {1, 2, 2, 2};
+  vector<float> B = {1.0f, -1.0f};
+  vector<int64_t> B_shape = {2};
+  auto expected_vals = {13.0f, 17.0f, 20.0f, 20.0f, -13.0f, -14.0f, -14.0f, -14.0f};
+  RunConvOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape, true, false, true);
+}
+
+#endif
+
 TEST(FusedConvTest, Cpu_Conv2D_Bias_Z_Relu) {
   ConvOpAndTestAttributes attrs = {
       "",                           // auto_pad
@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// y = Tanh(x + bias) * Sigmoid(x) / scale
+static void RunFusedElementwiseTest(int64_t rows, int64_t cols) {
+  RandomValueGenerator random{};
+  std::vector<float> x = random.Uniform<float>(AsSpan({rows, cols}), -2.0f, 2.0f);
+  std::vector<float> bias = random.Uniform<float>(AsSpan({cols}), -1.0f, 1.0f);
+  const float scale = 1.5f;
+
+  std::vector<float> y(x.size());
+  for (int64_t r = 0; r < rows; r++) {
+    for (int64_t c = 0; c < cols; c++) {
+      const float v = x[r * cols + c];
+      y[r * cols + c] = std::tanh(v + bias[c]) * (1.0f / (1.0f + std::exp(-v))) / scale;
+    }
+  }
+
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", {"Add", "Tanh", "Sigmoid", "Mul", "Div"});
+  // values: 0 = x, 1 = bias, 2 = scale, 3.. = results of the ops
+  test.AddAttribute<std::vector<int64_t>>("operands", {0, 1, 3, -1, 0, -1, 4, 5, 6, 2});
+  test.AddInput<float>("x", {rows, cols}, x);
+  test.AddInput<float>("bias", {cols}, bias);
+  test.AddInput<float>("scale", {1}, {scale});
+  test.AddOutput<float>("y", {rows, cols}, y);
+  test.SetOutputAbsErr("y", 1e-5f);
+  test.Run();
+}
+
+TEST(FusedElementwiseTest, SingleBlock) {
+  RunFusedElementwiseTest(2, 3);
+}
+
+TEST(FusedElementwiseTest, MultipleBlocks) {
+  // The rows broadcast from bias do not line up with the blocks.
+  RunFusedElementwiseTest(5, 333);
+}
+
+TEST(FusedElementwiseTest, InvalidOperand) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", {"Add", "Relu"});
+  test.AddAttribute<std::vector<int64_t>>("operands", {0, 2, 0, -1});
+  test.AddInput<float>("x", {2}, {1.0f, -1.0f});
+  test.AddInput<float>("y", {2}, {1.0f, -1.0f});
+  test.AddOutput<float>("z", {2}, {0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "Invalid operand 2 for op 0");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
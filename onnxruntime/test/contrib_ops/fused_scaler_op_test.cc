@@ -0,0 +1,64 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <limits>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(ContribOpTest, FusedScaler_PerFeature) {
+  constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+  OpTester test("FusedScaler", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("imputed_value_floats", std::vector<float>{1.f, 2.f, 3.f});
+  test.AddAttribute("replaced_value_float", nan);
+  test.AddAttribute("offset", std::vector<float>{0.5f, 1.f, 1.5f});
+  test.AddAttribute("scale", std::vector<float>{2.f, 0.5f, 4.f});
+  test.AddInput<float>("X", {3, 3}, {nan, 4.f, 1.5f, 1.f, nan, nan, -0.5f, 3.f, 2.f});
+  test.AddOutput<float>("Y", {3, 3}, {1.f, 1.5f, 0.f, 1.f, 0.5f, 6.f, -2.f, 1.f, 2.f});
+  test.Run();
+}
+
+TEST(ContribOpTest, FusedScaler_SingleValues) {
+  OpTester test("FusedScaler", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("imputed_value_floats", std::vector<float>{5.f});
+  test.AddAttribute("replaced_value_float", -1.f);
+  test.AddAttribute("offset", std::vector<float>{1.f});
+  test.AddAttribute("scale", std::vector<float>{0.25f});
+  test.AddInput<float>("X", {2, 2}, {-1.f, 3.f, 9.f, -1.f});
+  test.AddOutput<float>("Y", {2, 2}, {1.f, 0.5f, 2.f, 1.f});
+  test.Run();
+}
+
+TEST(ContribOpTest, FusedScaler_ManyRows) {
+  constexpr int64_t rows = 1000;
+  constexpr int64_t features = 7;
+  std::vector<float> offset(features), scale(features), imputed(features);
+  for (int64_t c = 0; c < features; ++c) {
+    offset[c] = static_cast<float>(c) * 0.5f;
+    scale[c] = 1.f / static_cast<float>(c + 1);
+    imputed[c] = static_cast<float>(-c);
+  }
+
+  std::vector<float> X(rows * features), Y(rows * features);
+  for (int64_t i = 0; i < rows * features; ++i) {
+    const int64_t c = i % features;
+    X[i] = (i % 5 == 0) ? 0.f : static_cast<float>(i % 13);
+    const float value = X[i] == 0.f ? imputed[c] : X[i];
+    Y[i] = (value - offset[c]) * scale[c];
+  }
+
+  OpTester test("FusedScaler", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("imputed_value_floats", imputed);
+  test.AddAttribute("replaced_value_float", 0.f);
+  test.AddAttribute("offset", offset);
+  test.AddAttribute("scale", scale);
+  test.AddInput<float>("X", {rows, features}, X);
+  test.AddOutput<float>("Y", {rows, features}, Y);
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+
 #include "gtest/gtest.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
@@ -101,10 +103,10 @@ void TestGemmFloat8WithFloat8(int64_t dtype) {
   test.AddAttribute("beta", 1.0f);
   test.AddAttribute("activation", "NONE");
   test.AddAttribute("dtype", dtype);
-  test.AddInput<ab_type>("A", {2, 4}, _TypeCvt<ap_type>(std::vector<float>({1.0f, 2.0f, 3.0f, 4.0f, -1.0f, -2.0f, -3.0f, -4.0f})));
-  test.AddInput<ab_type>("B", {3, 4}, _TypeCvt<ap_type>(std::vector<float>({1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f})));
-  test.AddInput<out_type>("C", {2, 3}, _TypeCvt<out_type>(std::vector<float>({1.f, 1.f, 1.f, 1.f, 1.f, 1.f})));
-  test.AddOutput<MLFloat16>("Y", {2, 3}, _TypeCvt<out_type>(std::vector<float>({11.0f, 11.0f, 11.0f, -9.0f, -9.0f, -9.0f})));
+  test.AddInput<ab_type>("A", {2, 4}, _TypedCvt<ab_type>(std::vector<float>({1.0f, 2.0f, 3.0f, 4.0f, -1.0f, -2.0f, -3.0f, -4.0f})));
+  test.AddInput<ab_type>("B", {3, 4}, _TypedCvt<ab_type>(std::vector<float>({1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f})));
+  test.AddInput<out_type>("C", {2, 3}, _TypedCvt<out_type>(std::vector<float>({1.f, 1.f, 1.f, 1.f, 1.f, 1.f})));
+  test.AddOutput<out_type>("Y", {2, 3}, _TypedCvt<out_type>(std::vector<float>({11.0f, 11.0f, 11.0f, -9.0f, -9.0f, -9.0f})));
   std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
   execution_providers.push_back(DefaultCudaExecutionProvider());
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
@@ -118,6 +120,36 @@ TEST(GemmFloat8OpTest, Float8E4M3FNToFloat8E4M3FN) {
   TestGemmFloat8WithFloat8<Float8E4M3FN, Float8E4M3FN>(static_cast<int64_t>(ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E4M3FN));
 }
 
+TEST(GemmFloat8OpTest, Float8E4M3FNWithScalesAndAmax) {
+  // float 8 tensor cores require compute capability 8.9
+  if (!HasCudaEnvironment(890)) {
+    LOGS_DEFAULT(WARNING) << "Hardware NOT support Matrix Multiplication for FLOAT8";
+    return;
+  }
+  // A is 3-D, its leading dimensions are flattened into M.
+  OpTester test("GemmFloat8", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("transA", (int64_t)0);
+  test.AddAttribute("transB", (int64_t)1);
+  test.AddAttribute("dtype", static_cast<int64_t>(ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E4M3FN));
+  test.AddInput<Float8E4M3FN>("A", {1, 2, 16}, _TypedCvt<Float8E4M3FN>(std::vector<float>{
+                                                   1.f, 2.f, 1.f, 2.f, 1.f, 2.f, 1.f, 2.f, 1.f, 2.f, 1.f, 2.f, 1.f, 2.f, 1.f, 2.f,
+                                                   -1.f, -1.f, -1.f, -1.f, -1.f, -1.f, -1.f, -1.f,
+                                                   -1.f, -1.f, -1.f, -1.f, -1.f, -1.f, -1.f, -1.f}));
+  test.AddInput<Float8E4M3FN>("B", {16, 16}, _TypedCvt<Float8E4M3FN>(std::vector<float>(256, 1.f)));
+  test.AddOptionalInputEdge<float>();
+  test.AddInput<float>("scaleA", {}, {0.5f});
+  test.AddInput<float>("scaleB", {}, {2.0f});
+  test.AddInput<float>("scaleY", {}, {0.25f});
+  // The rows of A * B are 24 and -16, scaled by 0.25.
+  std::vector<float> expected_y(32, 6.f);
+  std::fill(expected_y.begin() + 16, expected_y.end(), -4.f);
+  test.AddOutput<Float8E4M3FN>("Y", {1, 2, 16}, _TypedCvt<Float8E4M3FN>(expected_y));
+  test.AddOutput<float>("amaxY", {}, {24.f});
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCudaExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 #endif
 
 #endif
@@ -0,0 +1,421 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "gtest/gtest.h"
+#include "core/mlas/inc/mlas.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+struct GroupQueryAttentionConfig {
+  int batch_size;
+  int sequence_length;
+  int past_sequence_length;  // length of the past_key/past_value buffers
+  int num_heads;
+  int kv_num_heads;
+  int head_size;
+  int local_window_size;
+  int kv_cache_bit_width = 0;
+  bool do_rotary = false;
+  bool rotary_interleaved = false;
+  int kv_block_size = 0;  // rows per block of a paged kv cache, 0 for a contiguous kv cache
+};
+
+// Rotates a head of head_size elements by the angles of cos/sin, pairing element i with i + head_size / 2,
+// or with its neighbour when interleaved.
+void ReferenceRotateHead(float* head, const float* cos, const float* sin, int head_size, bool interleaved) {
+  const int half = head_size / 2;
+  for (int i = 0; i < half; i++) {
+    const int first = interleaved ? 2 * i : i;
+    const int second = interleaved ? 2 * i + 1 : i + half;
+    const float x = head[first];
+    const float y = head[second];
+    head[first] = x * cos[i] - y * sin[i];
+    head[second] = y * cos[i] + x * sin[i];
+  }
+}
+
+// Quantizes rows of head_size elements into the kv cache row format and expands them back, so that the
+// reference attention sees the values the kernel sees.
+std::vector<uint8_t> QuantizeKvCache(const std::vector<float>& rows, int head_size, int bit_width,
+                                     std::vector<float>& dequantized) {
+  const size_t H = static_cast<size_t>(head_size);
+  const size_t row_size = MlasKvCacheQuantRowSize(H, static_cast<size_t>(bit_width));
+  const size_t row_count = rows.size() / H;
+  const size_t block_count = (H + MLAS_KV_CACHE_QUANT_BLOCK_SIZE - 1) / MLAS_KV_CACHE_QUANT_BLOCK_SIZE;
+
+  std::vector<uint8_t> quantized(row_count * row_size);
+  MlasQuantizeKvCacheRows(rows.data(), H, quantized.data(), row_size, row_count, H, static_cast<size_t>(bit_width));
+
+  dequantized.resize(rows.size());
+  for (size_t r = 0; r < row_count; r++) {
+    const uint8_t* row = quantized.data() + r * row_size;
+    const uint8_t* data = row + block_count * sizeof(float);
+    for (size_t h = 0; h < H; h++) {
+      const float scale = reinterpret_cast<const float*>(row)[h / MLAS_KV_CACHE_QUANT_BLOCK_SIZE];
+      int value = bit_width == 8 ? static_cast<int8_t>(data[h]) : (data[h / 2] >> ((h % 2) * 4)) & 0x0F;
+      if (bit_width == 4 && value >= 8) {
+        value -= 16;
+      }
+      dequantized[r * H + h] = scale * static_cast<float>(value);
+    }
+  }
+
+  return quantized;
+}
+
+// Copies the first lengths[b] rows of each head of a BNSH cache with sequence_length rows of row_length elements
+// into the blocks of a paged cache pool (num_blocks, kv_num_heads, kv_block_size, row_length).
+template <typename T>
+void ScatterToBlocks(const GroupQueryAttentionConfig& c, const std::vector<T>& rows, int sequence_length,
+                     int row_length, const std::vector<int>& lengths, const std::vector<int32_t>& block_tables,
+                     int max_blocks, std::vector<T>& pool) {
+  for (int b = 0; b < c.batch_size; b++) {
+    for (int n = 0; n < c.kv_num_heads; n++) {
+      for (int t = 0; t < lengths[b]; t++) {
+        const size_t block = static_cast<size_t>(block_tables[b * max_blocks + t / c.kv_block_size]);
+        const size_t pool_row = (block * c.kv_num_heads + n) * c.kv_block_size + t % c.kv_block_size;
+        const size_t row = (static_cast<size_t>(b) * c.kv_num_heads + n) * sequence_length + t;
+        std::copy_n(rows.begin() + row * row_length, row_length, pool.begin() + pool_row * row_length);
+      }
+    }
+  }
+}
+
+// Reference causal attention. query/output are BSNH, present_key/present_value are BNSH with
+// present_length rows per head, of which total_seqlens[b] are valid.
+std::vector<float> ReferenceGroupQueryAttention(const GroupQueryAttentionConfig& c,
+                                                const std::vector<float>& query,
+                                                const std::vector<float>& present_key,
+                                                const std::vector<float>& present_value,
+                                                const std::vector<int>& total_seqlens,
+                                                int present_length) {
+  const int H = c.head_size;
+  const int group = c.num_heads / c.kv_num_heads;
+  const float scale = 1.0f / std::sqrt(static_cast<float>(H));
+  std::vector<float> output(query.size(), 0.0f);
+
+  for (int b = 0; b < c.batch_size; b++) {
+    for (int n = 0; n < c.num_heads; n++) {
+      const float* k = present_key.data() + ((b * c.kv_num_heads + n / group) * present_length) * H;
+      const float* v = present_value.data() + ((b * c.kv_num_heads + n / group) * present_length) * H;
+      for (int s = 0; s < c.sequence_length; s++) {
+        const int position = total_seqlens[b] - c.sequence_length + s;
+        const int begin = c.local_window_size >= 0 ? std::max(0, position - c.local_window_size) : 0;
+        const float* q = query.data() + ((b * c.sequence_length + s) * c.num_heads + n) * H;
+
+        std::vector<double> scores(position + 1);
+        double maximum = -1e30;
+        for (int t = begin; t <= position; t++) {
+          double dot = 0.0;
+          for (int h = 0; h < H; h++) {
+            dot += q[h] * k[t * H + h];
+          }
+          scores[t] = dot * scale;
+          maximum = std::max(maximum, scores[t]);
+        }
+        double sum = 0.0;
+        for (int t = begin; t <= position; t++) {
+          scores[t] = std::exp(scores[t] - maximum);
+          sum += scores[t];
+        }
+
+        float* out = output.data() + ((b * c.sequence_length + s) * c.num_heads + n) * H;
+        for (int h = 0; h < H; h++) {
+          double value = 0.0;
+          for (int t = begin; t <= position; t++) {
+            value += scores[t] * v[t * H + h];
+          }
+          out[h] = static_cast<float>(value / sum);
+        }
+      }
+    }
+  }
+
+  return output;
+}
+
+void RunGroupQueryAttentionTest(const GroupQueryAttentionConfig& c, const std::vector<int>& seqlens_k) {
+  const int H = c.head_size;
+  const bool is_prompt = c.sequence_length != 1;
+
+  std::vector<int> total_seqlens(c.batch_size);
+  for (int b = 0; b < c.batch_size; b++) {
+    total_seqlens[b] = (is_prompt ? 0 : seqlens_k[b]) + c.sequence_length;
+  }
+  const int total_sequence_length = *std::max_element(total_seqlens.begin(), total_seqlens.end());
+  const int present_length = std::max(total_sequence_length, c.past_sequence_length);
+
+  std::mt19937 generator(123);
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  auto random_vector = [&](size_t size) {
+    std::vector<float> data(size);
+    for (auto& x : data) {
+      x = distribution(generator);
+    }
+    return data;
+  };
+
+  const size_t kv_row = static_cast<size_t>(c.kv_num_heads) * H;
+  std::vector<float> query = random_vector(static_cast<size_t>(c.batch_size) * c.sequence_length * c.num_heads * H);
+  std::vector<float> key = random_vector(static_cast<size_t>(c.batch_size) * c.sequence_length * kv_row);
+  std::vector<float> value = random_vector(static_cast<size_t>(c.batch_size) * c.sequence_length * kv_row);
+  std::vector<float> past_key = random_vector(static_cast<size_t>(c.batch_size) * c.past_sequence_length * kv_row);
+  std::vector<float> past_value = random_vector(static_cast<size_t>(c.batch_size) * c.past_sequence_length * kv_row);
+
+  // The kernel rotates the new query and key rows at the positions that follow the past sequence.
+  const int rotary_positions = present_length + 3;
+  std::vector<float> cos_cache, sin_cache;
+  if (c.do_rotary) {
+    const int half = H / 2;
+    cos_cache.resize(static_cast<size_t>(rotary_positions) * half);
+    sin_cache.resize(cos_cache.size());
+    for (int p = 0; p < rotary_positions; p++) {
+      for (int i = 0; i < half; i++) {
+        const float angle = static_cast<float>(p) * std::pow(10000.0f, -static_cast<float>(i) / half);
+        cos_cache[static_cast<size_t>(p) * half + i] = std::cos(angle);
+        sin_cache[static_cast<size_t>(p) * half + i] = std::sin(angle);
+      }
+    }
+  }
+  std::vector<float> rotated_query = query;
+  std::vector<float> rotated_key = key;
+  if (c.do_rotary) {
+    for (int b = 0; b < c.batch_size; b++) {
+      for (int s = 0; s < c.sequence_length; s++) {
+        const size_t cache_offset = static_cast<size_t>(total_seqlens[b] - c.sequence_length + s) * (H / 2);
+        const size_t token = static_cast<size_t>(b) * c.sequence_length + s;
+        for (int n = 0; n < c.num_heads; n++) {
+          ReferenceRotateHead(rotated_query.data() + (token * c.num_heads + n) * H, cos_cache.data() + cache_offset,
+                              sin_cache.data() + cache_offset, H, c.rotary_interleaved);
+        }
+        for (int n = 0; n < c.kv_num_heads; n++) {
+          ReferenceRotateHead(rotated_key.data() + (token * c.kv_num_heads + n) * H, cos_cache.data() + cache_offset,
+                              sin_cache.data() + cache_offset, H, c.rotary_interleaved);
+        }
+      }
+    }
+  }
+
+  // The present state holds the valid past rows followed by the new rows.
+  std::vector<float> present_key(static_cast<size_t>(c.batch_size) * present_length * kv_row, 0.0f);
+  std::vector<float> present_value(present_key.size(), 0.0f);
+  for (int b = 0; b < c.batch_size; b++) {
+    for (int n = 0; n < c.kv_num_heads; n++) {
+      const int past_seqlen = total_seqlens[b] - c.sequence_length;
+      for (int t = 0; t < total_seqlens[b]; t++) {
+        for (int h = 0; h < H; h++) {
+          const size_t present_index = ((static_cast<size_t>(b) * c.kv_num_heads + n) * present_length + t) * H + h;
+          if (t < past_seqlen) {
+            const size_t past_index =
+                ((static_cast<size_t>(b) * c.kv_num_heads + n) * c.past_sequence_length + t) * H + h;
+            present_key[present_index] = past_key[past_index];
+            present_value[present_index] = past_value[past_index];
+          } else {
+            const size_t new_index = ((static_cast<size_t>(b) * c.sequence_length + t - past_seqlen) * c.kv_num_heads + n) * H + h;
+            present_key[present_index] = rotated_key[new_index];
+            present_value[present_index] = value[new_index];
+          }
+        }
+      }
+    }
+  }
+
+  // A quantized cache is checked byte for byte, and the attention runs over its expanded values.
+  const bool quantized_kv = c.kv_cache_bit_width != 0;
+  std::vector<uint8_t> quantized_past_key, quantized_past_value, quantized_present_key, quantized_present_value;
+  if (quantized_kv) {
+    std::vector<float> unused;
+    quantized_past_key = QuantizeKvCache(past_key, H, c.kv_cache_bit_width, unused);
+    quantized_past_value = QuantizeKvCache(past_value, H, c.kv_cache_bit_width, unused);
+    quantized_present_key = QuantizeKvCache(present_key, H, c.kv_cache_bit_width, present_key);
+    quantized_present_value = QuantizeKvCache(present_value, H, c.kv_cache_bit_width, present_value);
+  }
+
+  // A paged cache spreads the blocks of the sequences over the pool from its end, interleaving the batches, and
+  // leaves block 0 unused. The rows the kernel does not write keep their initial values.
+  const bool paged_kv = c.kv_block_size > 0;
+  const int max_blocks = paged_kv ? (present_length + c.kv_block_size - 1) / c.kv_block_size : 0;
+  const int num_blocks = c.batch_size * max_blocks + 1;
+  std::vector<int32_t> block_tables(static_cast<size_t>(c.batch_size) * max_blocks);
+  for (int i = 0; i < max_blocks; i++) {
+    for (int b = 0; b < c.batch_size; b++) {
+      block_tables[b * max_blocks + i] = num_blocks - 1 - (i * c.batch_size + b);
+    }
+  }
+  const size_t pool_rows = static_cast<size_t>(num_blocks) * c.kv_num_heads * c.kv_block_size;
+  std::vector<int> past_seqlens(c.batch_size);
+  for (int b = 0; b < c.batch_size; b++) {
+    past_seqlens[b] = total_seqlens[b] - c.sequence_length;
+  }
+  std::vector<float> past_key_pool, past_value_pool, present_key_pool, present_value_pool;
+  std::vector<uint8_t> quantized_past_key_pool, quantized_past_value_pool;
+  std::vector<uint8_t> quantized_present_key_pool, quantized_present_value_pool;
+  if (paged_kv && quantized_kv) {
+    const size_t bytes_per_row = quantized_present_key.size() / (present_key.size() / H);
+    quantized_past_key_pool.assign(pool_rows * bytes_per_row, 0x5A);
+    quantized_past_value_pool.assign(pool_rows * bytes_per_row, 0xA5);
+    ScatterToBlocks(c, quantized_past_key, c.past_sequence_length, static_cast<int>(bytes_per_row), past_seqlens,
+                    block_tables, max_blocks, quantized_past_key_pool);
+    ScatterToBlocks(c, quantized_past_value, c.past_sequence_length, static_cast<int>(bytes_per_row), past_seqlens,
+                    block_tables, max_blocks, quantized_past_value_pool);
+    quantized_present_key_pool = quantized_past_key_pool;
+    quantized_present_value_pool = quantized_past_value_pool;
+    ScatterToBlocks(c, quantized_present_key, present_length, static_cast<int>(bytes_per_row), total_seqlens,
+                    block_tables, max_blocks, quantized_present_key_pool);
+    ScatterToBlocks(c, quantized_present_value, present_length, static_cast<int>(bytes_per_row), total_seqlens,
+                    block_tables, max_blocks, quantized_present_value_pool);
+  } else if (paged_kv) {
+    past_key_pool = random_vector(pool_rows * H);
+    past_value_pool = random_vector(pool_rows * H);
+    ScatterToBlocks(c, past_key, c.past_sequence_length, H, past_seqlens, block_tables, max_blocks, past_key_pool);
+    ScatterToBlocks(c, past_value, c.past_sequence_length, H, past_seqlens, block_tables, max_blocks,
+                    past_value_pool);
+    present_key_pool = past_key_pool;
+    present_value_pool = past_value_pool;
+    ScatterToBlocks(c, present_key, present_length, H, total_seqlens, block_tables, max_blocks, present_key_pool);
+    ScatterToBlocks(c, present_value, present_length, H, total_seqlens, block_tables, max_blocks,
+                    present_value_pool);
+  }
+
+  std::vector<float> output =
+      ReferenceGroupQueryAttention(c, rotated_query, present_key, present_value, total_seqlens, present_length);
+
+  OpTester tester("GroupQueryAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", c.num_heads);
+  tester.AddAttribute<int64_t>("kv_num_heads", c.kv_num_heads);
+  tester.AddAttribute<int64_t>("local_window_size", c.local_window_size);
+  if (quantized_kv) {
+    tester.AddAttribute<int64_t>("kv_cache_bit_width", c.kv_cache_bit_width);
+  }
+  if (c.do_rotary) {
+    tester.AddAttribute<int64_t>("do_rotary", 1);
+    tester.AddAttribute<int64_t>("rotary_interleaved", c.rotary_interleaved ? 1 : 0);
+  }
+
+  const int64_t row_size = quantized_kv ? static_cast<int64_t>(MlasKvCacheQuantRowSize(
+                                              static_cast<size_t>(H), static_cast<size_t>(c.kv_cache_bit_width)))
+                                        : H;
+
+  const int64_t kv_hidden_size = static_cast<int64_t>(kv_row);
+  tester.AddInput<float>("query", {c.batch_size, c.sequence_length, c.num_heads * H}, query);
+  tester.AddInput<float>("key", {c.batch_size, c.sequence_length, kv_hidden_size}, key);
+  tester.AddInput<float>("value", {c.batch_size, c.sequence_length, kv_hidden_size}, value);
+  const std::vector<int64_t> pool_shape{num_blocks, c.kv_num_heads, c.kv_block_size, row_size};
+  if (paged_kv && quantized_kv) {
+    tester.AddInput<uint8_t>("past_key", pool_shape, quantized_past_key_pool);
+    tester.AddInput<uint8_t>("past_value", pool_shape, quantized_past_value_pool);
+  } else if (paged_kv) {
+    tester.AddInput<float>("past_key", pool_shape, past_key_pool);
+    tester.AddInput<float>("past_value", pool_shape, past_value_pool);
+  } else if (c.past_sequence_length > 0 && quantized_kv) {
+    tester.AddInput<uint8_t>("past_key", {c.batch_size, c.kv_num_heads, c.past_sequence_length, row_size},
+                             quantized_past_key);
+    tester.AddInput<uint8_t>("past_value", {c.batch_size, c.kv_num_heads, c.past_sequence_length, row_size},
+                             quantized_past_value);
+  } else if (c.past_sequence_length > 0) {
+    tester.AddInput<float>("past_key", {c.batch_size, c.kv_num_heads, c.past_sequence_length, H}, past_key);
+    tester.AddInput<float>("past_value", {c.batch_size, c.kv_num_heads, c.past_sequence_length, H}, past_value);
+  } else {
+    tester.AddOptionalInputEdge<float>();
+    tester.AddOptionalInputEdge<float>();
+  }
+  tester.AddInput<int32_t>("seqlens_k", {c.batch_size}, seqlens_k);
+  tester.AddInput<int32_t>("total_sequence_length", {1}, {total_sequence_length});
+  if (c.do_rotary) {
+    tester.AddInput<float>("cos_cache", {rotary_positions, H / 2}, cos_cache);
+    tester.AddInput<float>("sin_cache", {rotary_positions, H / 2}, sin_cache);
+  } else if (paged_kv) {
+    tester.AddOptionalInputEdge<float>();
+    tester.AddOptionalInputEdge<float>();
+  }
+  if (paged_kv) {
+    tester.AddInput<int32_t>("block_tables", {c.batch_size, max_blocks}, block_tables);
+  }
+
+  tester.AddOutput<float>("output", {c.batch_size, c.sequence_length, c.num_heads * H}, output, false, 0, 1e-4f);
+
+  if (paged_kv && quantized_kv) {
+    tester.AddOutput<uint8_t>("present_key", pool_shape, quantized_present_key_pool);
+    tester.AddOutput<uint8_t>("present_value", pool_shape, quantized_present_value_pool);
+  } else if (paged_kv) {
+    tester.AddOutput<float>("present_key", pool_shape, present_key_pool);
+    tester.AddOutput<float>("present_value", pool_shape, present_value_pool);
+  } else if (quantized_kv) {
+    tester.AddOutput<uint8_t>("present_key", {c.batch_size, c.kv_num_heads, present_length, row_size},
+                              quantized_present_key);
+    tester.AddOutput<uint8_t>("present_value", {c.batch_size, c.kv_num_heads, present_length, row_size},
+                              quantized_present_value);
+  } else {
+    tester.AddOutput<float>("present_key", {c.batch_size, c.kv_num_heads, present_length, H}, present_key);
+    tester.AddOutput<float>("present_value", {c.batch_size, c.kv_num_heads, present_length, H}, present_value);
+  }
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+}  // namespace
+
+TEST(GroupQueryAttentionTest, Prompt) {
+  RunGroupQueryAttentionTest({2, 9, 0, 4, 2, 16, -1}, {0, 0});
+}
+
+TEST(GroupQueryAttentionTest, PromptLong) {
+  RunGroupQueryAttentionTest({1, 150, 0, 8, 2, 32, -1}, {0});
+}
+
+TEST(GroupQueryAttentionTest, PromptLocalWindow) {
+  RunGroupQueryAttentionTest({1, 70, 0, 4, 4, 8, 16}, {0});
+}
+
+TEST(GroupQueryAttentionTest, TokenGeneration) {
+  RunGroupQueryAttentionTest({2, 1, 5, 4, 1, 16, -1}, {5, 5});
+}
+
+TEST(GroupQueryAttentionTest, TokenGenerationLocalWindow) {
+  RunGroupQueryAttentionTest({1, 1, 300, 6, 2, 8, 32}, {300});
+}
+
+TEST(GroupQueryAttentionTest, PromptQuantizedKvCache) {
+  RunGroupQueryAttentionTest({2, 9, 0, 4, 2, 48, -1, 8}, {0, 0});
+  RunGroupQueryAttentionTest({2, 9, 0, 4, 2, 48, -1, 4}, {0, 0});
+}
+
+TEST(GroupQueryAttentionTest, TokenGenerationQuantizedKvCache) {
+  RunGroupQueryAttentionTest({2, 1, 200, 4, 1, 64, -1, 8}, {200, 200});
+  RunGroupQueryAttentionTest({1, 1, 300, 6, 2, 40, 32, 4}, {300});
+}
+
+TEST(GroupQueryAttentionTest, PromptRotary) {
+  RunGroupQueryAttentionTest({2, 9, 0, 4, 2, 16, -1, 0, true}, {0, 0});
+  RunGroupQueryAttentionTest({2, 9, 0, 4, 2, 16, -1, 0, true, true}, {0, 0});
+}
+
+TEST(GroupQueryAttentionTest, TokenGenerationRotary) {
+  RunGroupQueryAttentionTest({2, 1, 5, 4, 1, 16, -1, 0, true}, {3, 5});
+  RunGroupQueryAttentionTest({1, 1, 200, 4, 2, 64, -1, 8, true, true}, {200});
+}
+
+TEST(GroupQueryAttentionTest, PromptPagedKvCache) {
+  RunGroupQueryAttentionTest({2, 9, 0, 4, 2, 16, -1, 0, false, false, 4}, {0, 0});
+  RunGroupQueryAttentionTest({1, 150, 0, 8, 2, 32, -1, 0, true, false, 16}, {0});
+}
+
+TEST(GroupQueryAttentionTest, TokenGenerationPagedKvCache) {
+  RunGroupQueryAttentionTest({2, 1, 40, 4, 1, 16, -1, 0, false, false, 8}, {17, 39});
+  RunGroupQueryAttentionTest({2, 1, 300, 6, 2, 8, 32, 0, false, false, 16}, {300, 131});
+  RunGroupQueryAttentionTest({2, 1, 200, 4, 1, 64, -1, 8, false, false, 16}, {200, 63});
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include <chrono>
 #include <random>
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/session/inference_session.h"
 #include "test/common/dnnl_op_test_utils.h"
 #include "test/common/tensor_op_test_utils.h"
@@ -209,6 +210,19 @@ TEST(LayerNormTest, LayerNorm17_double) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kDnnlExecutionProvider});
 }
 
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+TEST(LayerNormTest, LayerNorm17_fp16) {
+  OpTester test("LayerNormalization", 17);
+  test.AddAttribute<float>("epsilon", 1e-05f);
+
+  std::vector<int64_t> dims{1, 2, 3};
+  test.AddInput<MLFloat16>("x", dims, ToFloat16({1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}));
+  test.AddInput<MLFloat16>("gamma", {3}, ToFloat16({1.0f, 1.0f, 1.0f}));
+  test.AddOutput<MLFloat16>("output", dims, ToFloat16({-1.2247f, 0.0f, 1.2247f, -1.2247f, 0.0f, 1.2247f}));
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kDnnlExecutionProvider});
+}
+#endif
+
 TEST(LayerNormTest, LayerNorm_InvalidScaleBias) {
   OpTester test("LayerNormalization");
   test.AddAttribute<float>("epsilon", 1e-05f);
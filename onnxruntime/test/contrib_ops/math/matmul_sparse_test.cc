@@ -261,6 +261,46 @@ TEST(SparseToDenseMatMul, TestCsr) {
   }
 }
 
+TEST(SparseToDenseMatMul, TestCsrRectangularWithAlpha) {
+  // A = {{0, 2, 0, 0},
+  //      {0, 0, 0, 0},
+  //      {1, 0, 0, 3}}
+  const std::vector<int64_t> A_shape = {3, 4};
+  const std::vector<float> A_values = {2, 1, 3};
+  const std::vector<int64_t> A_inner_indices = {1, 0, 3};
+  const std::vector<int64_t> A_outer_indices = {0, 1, 1, 3};
+
+  const std::vector<int64_t> B_shape = {4, 2};
+  const std::vector<float> B_data = {1, 2, 3, 4, 5, 6, 7, 8};
+
+  {
+    OpTester tester("SparseToDenseMatMul", 1, onnxruntime::kMSDomain);
+    tester.AddAttribute("alpha", 0.5f);
+    tester.AddSparseCsrInput("A", A_shape, A_values, A_inner_indices, A_outer_indices);
+    tester.AddInput("B", B_shape, B_data);
+    tester.AddOutput("X", {3, 2}, std::vector<float>{3, 4, 0, 0, 11, 13});
+    tester.Run(OpTester::ExpectResult::kExpectSuccess);
+  }
+
+  // B^T is {2, 4}
+  {
+    OpTester tester("SparseToDenseMatMul", 1, onnxruntime::kMSDomain);
+    tester.AddAttribute("transB", int64_t{1});
+    tester.AddSparseCsrInput("A", A_shape, A_values, A_inner_indices, A_outer_indices);
+    tester.AddInput("B", {2, 4}, std::vector<float>{1, 3, 5, 7, 2, 4, 6, 8});
+    tester.AddOutput("X", {3, 2}, std::vector<float>{6, 8, 0, 0, 22, 26});
+    tester.Run(OpTester::ExpectResult::kExpectSuccess);
+  }
+
+  {
+    OpTester tester("SparseToDenseMatMul", 1, onnxruntime::kMSDomain);
+    tester.AddSparseCsrInput("A", A_shape, A_values, {1, 0, 4}, A_outer_indices);
+    tester.AddInput("B", B_shape, B_data);
+    tester.AddOutput("X", {3, 2}, std::vector<float>{6, 8, 0, 0, 22, 26});
+    tester.Run(OpTester::ExpectResult::kExpectFailure, "CSR inner index: 4 is out of bounds of columns: 4");
+  }
+}
+
 TEST(SparseToDenseMatMul, TestCoo) {
   constexpr int64_t rows = 9;
   constexpr int64_t cols = 9;
@@ -181,6 +181,20 @@ TEST(MatMulNBits, Float16Large) {
   }
 }
 
+// M > 1 runs the tensor core gemm with each tile size, including partial tiles of M, N and K
+TEST(MatMulNBits, Float16Prefill) {
+  for (auto M : {16, 77, 256}) {
+    for (auto N : {200, 1024}) {
+      for (auto K : {520, 1024}) {
+        for (auto block_size : {16, 32, 128}) {
+          RunTest(M, N, K, block_size, CompUndef, false, true, 0.05f);
+          RunTest(M, N, K, block_size, CompUndef, true, true, 0.05f);
+        }
+      }
+    }
+  }
+}
+
 #endif
 
 void RunSharedPrepackedWeightsTest(int64_t M, int64_t N, int64_t K, int block_size, bool is_asym,
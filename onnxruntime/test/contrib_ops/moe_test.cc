@@ -1,8 +1,6 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-#ifdef USE_CUTLASS
-
 #include "gtest/gtest.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
@@ -24,13 +22,18 @@ static void RunMoETest(
     int hidden_size,
     int inter_size,
     std::string activation_type,
-    bool use_float16 = false) {
+    bool use_float16 = false,
+    int k = 1) {
+#ifdef USE_CUTLASS
   int min_cuda_architecture = use_float16 ? 530 : 0;
-
   bool enable_cuda = HasCudaEnvironment(min_cuda_architecture);
-  if (enable_cuda) {
+#else
+  bool enable_cuda = false;
+#endif
+  bool enable_cpu = !use_float16;
+  if (enable_cuda || enable_cpu) {
     OpTester tester("MoE", 1, onnxruntime::kMSDomain);
-    tester.AddAttribute<int64_t>("k", static_cast<int64_t>(1));
+    tester.AddAttribute<int64_t>("k", static_cast<int64_t>(k));
     tester.AddAttribute<std::string>("activation_type", activation_type);
 
     std::vector<int64_t> input_dims = {num_rows, hidden_size};
@@ -60,7 +63,14 @@ static void RunMoETest(
     }
 
     std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
-    execution_providers.push_back(DefaultCudaExecutionProvider());
+    if (enable_cuda) {
+      execution_providers.push_back(DefaultCudaExecutionProvider());
+    }
+    if (enable_cpu) {
+      // The expected outputs of the single expert tests were computed on CUDA.
+      tester.SetOutputAbsErr("output", 0.002f);
+      execution_providers.push_back(DefaultCpuExecutionProvider());
+    }
     tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
   }
 }
@@ -421,7 +431,79 @@ TEST(MoETest, MoETest_Relu) {
              "relu");
 }
 
+TEST(MoETest, MoETest_Silu_Top2) {
+  int num_rows = 3;
+  int num_experts = 4;
+  int hidden_size = 4;
+  int inter_size = 8;
+
+  const std::vector<float> input = {
+      -0.3523f, -0.6983f, 0.3019f, -0.8551f, 0.0718f, -0.2686f, -0.884f, 0.0149f,
+      -0.925f, -0.1327f, -0.8603f, -0.8186f};
+  const std::vector<float> router_probs = {
+      -0.3019f, 1.3074f, -1.5048f, -1.107f, 0.5097f, 1.7908f, 0.3084f, -0.4133f,
+      1.905f, -1.8137f, 1.4339f, -0.8416f};
+  const std::vector<float> fc1_experts_weights = {
+      -0.7115f, -0.7644f, -0.383f, 0.6323f, -0.6385f, 0.1632f, 0.2778f, -0.2552f,
+      0.0955f, -0.8744f, -0.8808f, -0.5881f, 0.3608f, -0.1448f, -0.3717f, 0.1711f,
+      -0.0936f, -0.4005f, 0.5888f, 0.398f, -0.5118f, 0.1488f, 0.0504f, 0.7503f,
+      0.4589f, -0.4241f, 0.9603f, -0.7639f, -0.1638f, 0.5143f, -0.696f, -0.0221f,
+      -0.9216f, 0.3364f, 0.5291f, 0.1461f, 0.751f, -0.3725f, 0.3906f, 0.1887f,
+      0.1598f, -0.0876f, 0.6799f, 0.8894f, -0.0518f, 0.3283f, -0.8787f, 0.403f,
+      0.2943f, 0.9862f, 0.6438f, -0.4308f, -0.2284f, 0.3373f, -0.9549f, -0.0766f,
+      -0.6639f, -0.7658f, -0.8821f, 0.5365f, -0.7413f, -0.5048f, -0.2181f, 0.7428f,
+      -0.8388f, -0.1016f, 0.0989f, 0.7668f, 0.6386f, 0.728f, -0.4432f, -0.1694f,
+      -0.2825f, 0.7684f, 0.9155f, -0.6982f, -0.6476f, -0.5361f, -0.5333f, -0.0301f,
+      0.1782f, -0.4745f, -0.9918f, -0.1621f, -0.2615f, 0.1327f, 0.9062f, 0.381f,
+      0.031f, 0.2352f, 0.3524f, -0.892f, 0.7991f, 0.5599f, 0.749f, 0.5957f,
+      -0.2152f, -0.202f, -0.7929f, 0.2686f, -0.8755f, -0.8653f, -0.5825f, -0.6754f,
+      -0.3199f, -0.8948f, -0.9995f, -0.6975f, -0.7971f, -0.2728f, -0.949f, 0.7487f,
+      0.2281f, -0.7029f, -0.4955f, -0.3052f, -0.2717f, -0.7543f, 0.6979f, 0.9862f,
+      -0.068f, -0.0323f, -0.8282f, -0.7956f, -0.3147f, -0.4705f, 0.6577f, -0.6771f};
+  const std::vector<float> fc2_experts_weights = {
+      -0.9538f, 0.902f, 0.0565f, -0.7068f, 0.0863f, -0.9459f, 0.0562f, 0.957f,
+      0.7267f, 0.3924f, -0.4778f, -0.2666f, -0.6659f, 0.5439f, 0.0652f, 0.5581f,
+      -0.3407f, -0.5539f, 0.623f, 0.9699f, 0.7053f, 0.6122f, 0.6367f, 0.4797f,
+      -0.5465f, 0.0353f, -0.2889f, -0.942f, -0.9441f, -0.4412f, -0.4817f, 0.385f,
+      0.913f, -0.1055f, 0.874f, 0.9761f, 0.91f, -0.2707f, -0.5591f, -0.5463f,
+      -0.6066f, -0.5913f, 0.2481f, 0.8006f, 0.6809f, -0.0411f, 0.306f, 0.5993f,
+      -0.8304f, 0.3212f, 0.8196f, 0.5646f, 0.5003f, -0.0439f, -0.643f, 0.5783f,
+      -0.335f, 0.6016f, 0.9433f, -0.2083f, -0.1972f, 0.8936f, 0.4496f, -0.66f,
+      -0.7459f, -0.6977f, 0.8097f, 0.613f, -0.7077f, 0.653f, 0.9606f, 0.3145f,
+      -0.2992f, 0.0973f, -0.738f, -0.9715f, 0.9418f, 0.2993f, 0.0532f, 0.8672f,
+      -0.1324f, 0.7435f, 0.6523f, -0.5779f, -0.4963f, -0.4141f, -0.5189f, 0.1729f,
+      -0.4813f, -0.162f, -0.7379f, 0.82f, -0.2924f, -0.0837f, 0.1667f, 0.8086f,
+      -0.1587f, 0.8354f, 0.0033f, 0.0636f, 0.047f, -0.9626f, -0.1198f, -0.6338f,
+      -0.9921f, 0.5983f, -0.6553f, -0.053f, 0.4504f, 0.113f, -0.348f, 0.0367f,
+      0.1109f, 0.5685f, -0.7878f, 0.1206f, -0.503f, -0.4462f, 0.5445f, 0.0154f,
+      0.1235f, 0.52f, 0.825f, -0.1135f, 0.2251f, 0.0111f, 0.0243f, 0.3855f};
+  const std::vector<float> fc1_experts_bias = {
+      -0.0953f, 0.0666f, -0.0439f, 0.883f, 0.3984f, 0.7531f, 0.8844f, -0.4808f,
+      0.119f, 0.8865f, 0.68f, -0.7257f, -0.7568f, -0.1158f, -0.8549f, -0.5187f,
+      -0.8538f, 0.3389f, 0.5679f, 0.7941f, -0.6911f, 0.4322f, 0.3205f, -0.714f,
+      0.7657f, 0.9351f, -0.5608f, 0.905f, -0.2035f, -0.0255f, 0.9797f, 0.6649f};
+  const std::vector<float> fc2_experts_bias = {
+      -0.6771f, -0.137f, 0.0312f, -0.3218f, -0.6085f, -0.3629f, 0.4443f, -0.961f,
+      0.1081f, -0.1191f, -0.9638f, -0.337f, 0.2479f, 0.0245f, -0.8714f, 0.9702f};
+  const std::vector<float> output = {
+      0.5806849f, -1.255907f, -0.1550573f, -0.2545006f, -0.6432031f, -0.3252983f, 0.2876224f, -0.7812653f,
+      -0.7770128f, -0.7956968f, 0.1376445f, 0.6175969f};
+
+  RunMoETest(input,
+             router_probs,
+             fc1_experts_weights,
+             fc2_experts_weights,
+             fc1_experts_bias,
+             fc2_experts_bias,
+             output,
+             num_rows,
+             num_experts,
+             hidden_size,
+             inter_size,
+             "silu",
+             false /*use_float16*/,
+             2 /*k*/);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
-
-#endif
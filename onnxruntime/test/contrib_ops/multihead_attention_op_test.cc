@@ -578,6 +578,28 @@ TEST(MultiHeadAttentionTest, SelfAttention_WithPastAndPresent_NoMask_NoRelPosBia
   RunMultiHeadAttentionTests(data, /*disable_cpu=*/false, /*disable_cuda=*/true);
 }
 
+TEST(MultiHeadAttentionTest, CrossAttention_PastKVSharedByBeams_Mask2D) {
+  // Cross attention of beam search, where the past key and value of each batch are shared by its 2 beams.
+  constexpr int num_heads = 2;
+  OpTester tester("MultiHeadAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(num_heads));
+
+  tester.AddInput<float>("query", {2, 1, 4}, {0.5f, -0.2f, 0.1f, 0.8f, -0.3f, 0.4f, 0.9f, -0.6f});
+  tester.AddInput<float>("key", {1, num_heads, 3, 2},
+                         {0.2f, 0.7f, -0.5f, 0.1f, 0.3f, -0.4f, 0.6f, -0.1f, 0.2f, 0.5f, -0.7f, 0.3f});
+  tester.AddInput<float>("value", {1, num_heads, 3, 2},
+                         {1.0f, 0.5f, -0.2f, 0.3f, 0.8f, -0.6f, 0.4f, -0.9f, 0.7f, 0.2f, -0.3f, 0.6f});
+  tester.AddOptionalInputEdge<float>();
+  tester.AddInput<int32_t>("key_padding_mask", {1, 3}, {1, 1, 0});
+  tester.AddOutput<float>("output", {2, 1, 4},
+                          {0.4486831f, 0.4081139f, 0.5731481f, -0.2651236f,
+                           0.4063637f, 0.4010606f, 0.5126202f, -0.4870594f});
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 // This test is disabled since it is not used in Whisper anymore, and it fails in ROCm.
 TEST(MultiHeadAttentionTest, DISABLED_CrossAttention_WithPastPassedInDirectly_NoMask) {
   // Whisper decoder cross attention with past_kv in place of current KV and no present_kv
@@ -522,5 +522,58 @@ TEST(PackedMultiHeadAttentionTest, PackedQKV_Padding_NoBias_BroadcastRelPosBias_
       data.broadcast_rel_pos_bias);
 }
 
+TEST(PackedMultiHeadAttentionTest, Q_K_V_Padding_Causal_unfused) {
+  // The query is zeros, so each token gets the mean of the values of the tokens of its sequence up to itself.
+  if (!HasCudaEnvironment(0)) {
+    return;
+  }
+
+  ScopedEnvironmentVariables scoped_env_vars{
+      EnvVarMap{
+          {onnxruntime::contrib::attention::kDisableFlashAttention, "1"},
+          {onnxruntime::contrib::attention::kDisableTrtFlashAttention, "1"},
+          {onnxruntime::contrib::attention::kDisableFusedSelfAttention, "1"},
+          {onnxruntime::contrib::attention::kDisableFusedCrossAttention, "1"},
+          {onnxruntime::contrib::attention::kDisableMemoryEfficientAttention, "1"}}};
+
+  constexpr int64_t token_count = 3;
+  constexpr int64_t hidden_size = 2;
+  const std::vector<float> query_data = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+  const std::vector<float> key_value_data = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  const std::vector<float> output_data = {1.0f, 2.0f, 2.0f, 3.0f, 5.0f, 6.0f};
+
+  for (bool use_float16 : {false, true}) {
+    if (use_float16 && !HasCudaEnvironment(530)) {
+      continue;
+    }
+
+    OpTester tester("PackedMultiHeadAttention", 1, onnxruntime::kMSDomain);
+    tester.AddAttribute<int64_t>("num_heads", 1);
+    tester.AddAttribute<int64_t>("unidirectional", 1);
+    if (use_float16) {
+      tester.AddInput<MLFloat16>("query", {token_count, hidden_size}, ToFloat16(query_data));
+      tester.AddInput<MLFloat16>("key", {token_count, hidden_size}, ToFloat16(key_value_data));
+      tester.AddInput<MLFloat16>("value", {token_count, hidden_size}, ToFloat16(key_value_data));
+      tester.AddOptionalInputEdge<MLFloat16>();
+    } else {
+      tester.AddInput<float>("query", {token_count, hidden_size}, query_data);
+      tester.AddInput<float>("key", {token_count, hidden_size}, key_value_data);
+      tester.AddInput<float>("value", {token_count, hidden_size}, key_value_data);
+      tester.AddOptionalInputEdge<float>();
+    }
+    tester.AddInput<int32_t>("token_offset", {2, 2}, {0, 1, 2, 3});
+    tester.AddInput<int32_t>("cumulative_sequence_length", {3}, {0, 2, 3});
+    if (use_float16) {
+      tester.AddOutput<MLFloat16>("output", {token_count, hidden_size}, ToFloat16(output_data));
+    } else {
+      tester.AddOutput<float>("output", {token_count, hidden_size}, output_data);
+    }
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCudaExecutionProvider());
+    tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
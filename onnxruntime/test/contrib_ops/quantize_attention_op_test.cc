@@ -42,7 +42,8 @@ void RunQAttention(const std::vector<float>& input_data,
                    int number_of_heads,
                    bool is_unidirectional = false,
                    bool use_float16 = false,
-                   int input_hidden_size = 0) {
+                   int input_hidden_size = 0,
+                   bool quantized_attention = false) {
   input_hidden_size = (input_hidden_size == 0) ? hidden_size : input_hidden_size;
 
   OpTester tester("QAttention", 1, onnxruntime::kMSDomain);
@@ -50,6 +51,9 @@ void RunQAttention(const std::vector<float>& input_data,
   if (is_unidirectional) {
     tester.AddAttribute<int64_t>("unidirectional", 1);
   }
+  if (quantized_attention) {
+    tester.AddAttribute<int64_t>("quantized_attention", 1);
+  }
 
   std::vector<int64_t> input_dims = {batch_size, sequence_length, input_hidden_size};
   std::vector<int64_t> weights_dims = {input_hidden_size, static_cast<int64_t>(3 * hidden_size)};
@@ -95,6 +99,10 @@ void RunQAttention(const std::vector<float>& input_data,
     tester.AddInput<float>("weight_scale", {1}, {weight_quant_params.scale});
     tester.AddOutput<float>("output", output_dims, output_data);
   }
+  if (quantized_attention) {
+    // Q, K, V and the attention probabilities are quantized as well.
+    tester.SetOutputAbsErr("output", 0.1f);
+  }
 
   if (mask_index_data.size() > 0) {
     tester.AddInput<int32_t>("mask_index", mask_index_dims, mask_index_data);
@@ -558,6 +566,49 @@ TEST(QAttentionTest, QAttentionNoMaskIndex) {
                    batch_size, sequence_length, hidden_size, number_of_heads);
 }
 
+TEST(QAttentionTest, QAttentionQuantizedAttention) {
+  int batch_size = 1;
+  int sequence_length = 2;
+  int hidden_size = 4;
+  int number_of_heads = 2;
+
+  std::vector<float> input_data = {
+      0.8f, -0.5f, 0.0f, 1.f,
+      0.5f, 0.2f, 0.3f, -0.6f};
+
+  std::vector<float> weight_data = {
+      0.1f, -0.2f, 0.3f, 1.0f, 1.1f, 0.3f, 0.5f, 0.2f, 0.3f, -0.6f, 1.5f, 2.0f,
+      0.5f, 0.1f, 0.4f, 1.6f, 1.0f, 2.0f, 0.4f, 0.8f, 0.9f, 0.1f, -1.3f, 0.7f,
+      0.3f, 0.2f, 4.0f, 2.2f, 1.6f, 1.1f, 0.7f, 0.2f, 0.4f, 1.0f, 1.2f, 0.5f,
+      0.2f, 0.1f, 0.4f, 1.6f, 2.4f, 3.3f, 2.1f, 4.2f, 8.4f, 0.0f, 2.1f, 3.2f};
+
+  std::vector<float> bias_data = {
+      -0.5f, 0.6f, 1.2f, 2.1f, 0.5f, 0.7f, 0.2f, 1.2f, 0.5f, 0.4f, 0.3f, 1.2f};
+
+  std::vector<int32_t> mask_index_data = {};
+
+  std::vector<float> output_data = {
+      3.1495983600616455f, 0.10843668878078461f, 4.25f, 5.6499996185302734f,
+      3.9696791172027588f, 0.073143675923347473f, 4.2499995231628418f, 5.6499991416931152f};
+
+  std::vector<float> unidirectional_output_data = {
+      8.69f, -0.13f, 4.25f, 5.65f,
+      3.9696791172027588f, 0.073143675923347473f, 4.2499995231628418f, 5.6499991416931152f};
+
+  quantization::Params<uint8_t> input_quant_params(/*scale=*/0.1f, /*zero_point=*/128);
+  quantization::Params<int8_t> weights_quant_params(/*scale=*/0.1f, /*zero_point=*/1);
+
+  RunQAttention<uint8_t, int8_t, EP::CPU>(
+      input_data, weight_data, bias_data, mask_index_data, output_data, input_quant_params, weights_quant_params,
+      batch_size, sequence_length, hidden_size, number_of_heads, false /*is_unidirectional*/,
+      false /*use_float16*/, 0 /*input_hidden_size*/, true /*quantized_attention*/);
+
+  RunQAttention<uint8_t, int8_t, EP::CPU>(
+      input_data, weight_data, bias_data, mask_index_data, unidirectional_output_data, input_quant_params,
+      weights_quant_params, batch_size, sequence_length, hidden_size, number_of_heads, true /*is_unidirectional*/,
+      false /*use_float16*/, 0 /*input_hidden_size*/, true /*quantized_attention*/);
+}
+
 TEST(QAttentionTest, QAttentionUnidirectional_U8U8) {
   int batch_size = 1;
   int sequence_length = 2;
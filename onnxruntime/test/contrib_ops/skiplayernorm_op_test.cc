@@ -96,9 +96,7 @@ static void RunOneTest(
       execution_providers.push_back(DefaultCpuExecutionProvider());
     }
     test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
-  } else if (HasCudaEnvironment(530 /*min_cuda_architecture*/) ||
-             dml_ep != nullptr ||
-             rocm_ep != nullptr) {
+  } else {
     OpTester test(op_type.c_str(), 1, onnxruntime::kMSDomain);
     test.AddInput<MLFloat16>("input", input_dims, ToFloat16(input_data));
     test.AddInput<MLFloat16>("skip", skip_dims, ToFloat16(skip_data));
@@ -107,7 +105,7 @@ static void RunOneTest(
       if (!no_beta) {
         test.AddInput<MLFloat16>("beta", beta_dims, ToFloat16(beta_data));
       } else {
-        test.AddOptionalInputEdge<float>();
+        test.AddOptionalInputEdge<MLFloat16>();
       }
     }
     test.AddAttribute("epsilon", epsilon);
@@ -136,7 +134,7 @@ static void RunOneTest(
       execution_providers.push_back(DefaultDmlExecutionProvider());
     } else if (rocm_ep != nullptr) {
       execution_providers.push_back(DefaultRocmExecutionProvider());
-    } else {
+    } else if (HasCudaEnvironment(530 /*min_cuda_architecture*/)) {
       if (strict) {
         const auto& api = Ort::GetApi();
         OrtCUDAProviderOptionsV2* cuda_options = nullptr;
@@ -150,6 +148,11 @@ static void RunOneTest(
       } else {
         execution_providers.push_back(DefaultCudaExecutionProvider());
       }
+    } else if (!strict && cpu_ep != nullptr) {
+      // The CPU kernel normalizes half precision rows in single precision.
+      execution_providers.push_back(DefaultCpuExecutionProvider());
+    } else {
+      return;
     }
 
     test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
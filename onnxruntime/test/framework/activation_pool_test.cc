@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/activation_pool.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+static constexpr size_t kMB = 1024 * 1024;
+
+TEST(ActivationPoolTest, ReusesReturnedBlocks) {
+  ActivationPool pool(std::make_shared<CPUAllocator>(), 8 * kMB, std::chrono::milliseconds(0));
+  EXPECT_EQ(pool.Info().alloc_type, OrtAllocatorType::OrtDeviceAllocator);
+
+  void* p1 = pool.Alloc(2 * kMB);
+  ASSERT_NE(p1, nullptr);
+  pool.Free(p1);
+
+  // a smaller request is served best-fit from the returned block
+  void* p2 = pool.Alloc(kMB + 1);
+  EXPECT_EQ(p2, p1);
+
+  AllocatorStats stats;
+  pool.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, static_cast<int64_t>(2 * kMB));
+  EXPECT_EQ(stats.bytes_in_use, static_cast<int64_t>(2 * kMB));
+  EXPECT_EQ(stats.bytes_limit, static_cast<int64_t>(8 * kMB));
+  pool.Free(p2);
+}
+
+TEST(ActivationPoolTest, EvictsSmallBlocksWhenFull) {
+  ActivationPool pool(std::make_shared<CPUAllocator>(), 4 * kMB, std::chrono::milliseconds(0));
+
+  void* small1 = pool.Alloc(kMB);
+  void* small2 = pool.Alloc(kMB);
+  pool.Free(small1);
+  pool.Free(small2);
+
+  // needs 3MB while 2MB are cached in blocks that are too small
+  void* large = pool.Alloc(3 * kMB);
+  ASSERT_NE(large, nullptr);
+
+  AllocatorStats stats;
+  pool.GetStats(&stats);
+  EXPECT_LE(stats.total_allocated_bytes, static_cast<int64_t>(4 * kMB));
+  pool.Free(large);
+
+  EXPECT_THROW(pool.Alloc(5 * kMB), OnnxRuntimeException) << "larger than the pool";
+}
+
+TEST(ActivationPoolTest, AdmissionWaitsForReturnedBlock) {
+  ActivationPool pool(std::make_shared<CPUAllocator>(), 4 * kMB, std::chrono::milliseconds(10000));
+
+  void* held = pool.Alloc(3 * kMB);
+  std::thread releaser([&pool, held]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    pool.Free(held);
+  });
+
+  // blocks until the other 'Run' returns its block, then reuses it
+  void* p = pool.Alloc(2 * kMB);
+  EXPECT_EQ(p, held);
+  releaser.join();
+  pool.Free(p);
+}
+
+TEST(ActivationPoolTest, AdmissionTimesOut) {
+  ActivationPool pool(std::make_shared<CPUAllocator>(), 4 * kMB, std::chrono::milliseconds(20));
+
+  void* held = pool.Alloc(3 * kMB);
+  EXPECT_THROW(pool.Alloc(2 * kMB), OnnxRuntimeException);
+  pool.Free(held);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -500,6 +500,41 @@ TEST_F(PlannerTest, InPlaceTest) {
   CheckFreed(2, {X1});
 }
 
+// DyingInputsTest: Check that the inputs released by their consumer are reported as dead after that consumer.
+TEST_F(PlannerTest, DyingInputsTest) {
+  // tensor variables:
+  std::string W("W"), X("X"), B("B"), Y("Y"), Z("Z");
+
+  ONNX_NAMESPACE::TensorProto tensor;
+  tensor.add_dims(1);
+  tensor.add_float_data(1.0f);
+  tensor.set_data_type(TensorProto_DataType_FLOAT);
+  tensor.set_name("W");
+  GetGraph().AddInitializedTensor(tensor);
+
+  auto* node0 = AddNormalNode(W, X);
+  auto* node1 = AddNormalNode(X, B);
+  auto* node2 = AddNormalNode(B, Y);
+  auto* node3 = AddNormalNode(Y, Z);
+
+  // simulate shape-inference results:
+  Shape shape1{50, 100};
+  auto shape = &shape1.value;
+  SetShape({{X, shape}, {B, shape}, {Y, shape}, {Z, shape}});
+
+  CreatePlan();
+
+  // W is an initializer and Y reuses the buffer of X, which keeps that buffer alive until Y is consumed.
+  // Only B owns a buffer that dies with its consumer.
+  CheckAllocKind(Y, AllocKind::kReuse);
+  const auto& dying_inputs = GetPlan().node_dying_inputs;
+  ASSERT_GT(dying_inputs.size(), node3->Index());
+  EXPECT_TRUE(dying_inputs[node0->Index()].empty());
+  EXPECT_TRUE(dying_inputs[node1->Index()].empty());
+  EXPECT_EQ(dying_inputs[node2->Index()], InlinedVector<int>{0});
+  EXPECT_TRUE(dying_inputs[node3->Index()].empty());
+}
+
 TEST_F(PlannerTest, ExternalOutputsTest) {
   // tensor variables:
   std::string X1("X1"), X2("X2"), X3("X3"), X4("X4");
@@ -529,6 +564,110 @@ TEST_F(PlannerTest, ExternalOutputsTest) {
   CheckFreed(2, {X1});
 }
 
+TEST_F(PlannerTest, ConcatSubBufferTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5"), concat("concat");
+
+  // graph structure: the producers of X2 and X3 write them in place in X4.
+  AddNormalNode(X1, X2);
+  AddNormalNode(X1, X3);
+  auto concat_kernel = KernelDefBuilder().SetName("Concat").Provider(kCpuExecutionProvider).SinceVersion(4, 10).Build();
+  std::vector<onnxruntime::NodeArg*> concat_inputs{Arg(X2), Arg(X3)}, concat_outputs{Arg(X4)};
+  AddNode(*concat_kernel, concat, concat_inputs, concat_outputs)->AddAttribute("axis", static_cast<int64_t>(1));
+  AddNormalNode(X4, X5);
+
+  // simulate shape-inference results:
+  Shape shape1{1, 2, 3}, shape2{1, 4, 3}, shape3{1, 6, 3};
+  SetShape({{X1, &shape1.value}, {X2, &shape1.value}, {X3, &shape2.value}, {X4, &shape3.value},
+            {X5, &shape3.value}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X2, AllocKind::kReuse);
+  CheckAllocKind(X3, AllocKind::kReuse);
+  CheckAllocKind(X4, AllocKind::kAllocate);
+
+  // check the placement of the inputs in the Concat output:
+  const auto& name_idx_map = GetState().GetOrtValueNameIdxMap();
+  int x2_idx, x3_idx, x4_idx;
+  ASSERT_STATUS_OK(name_idx_map.GetIdx(X2, x2_idx));
+  ASSERT_STATUS_OK(name_idx_map.GetIdx(X3, x3_idx));
+  ASSERT_STATUS_OK(name_idx_map.GetIdx(X4, x4_idx));
+  const auto& x2_plan = GetPlan().allocation_plan[x2_idx];
+  const auto& x3_plan = GetPlan().allocation_plan[x3_idx];
+  EXPECT_EQ(x2_plan.reused_buffer, x4_idx);
+  EXPECT_TRUE(x2_plan.is_sub_buffer);
+  EXPECT_EQ(x2_plan.sub_buffer_offset, 0U);
+  EXPECT_EQ(x3_plan.reused_buffer, x4_idx);
+  EXPECT_TRUE(x3_plan.is_sub_buffer);
+  EXPECT_EQ(x3_plan.sub_buffer_offset, 2 * 3 * sizeof(float));
+}
+
+TEST_F(PlannerTest, ConcatSubBufferNotContiguousTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5"), concat("concat");
+
+  // graph structure: the slices of X4 for X2 and X3 are not contiguous, so they are copied by the Concat.
+  AddNormalNode(X1, X2);
+  AddNormalNode(X1, X3);
+  auto concat_kernel = KernelDefBuilder().SetName("Concat").Provider(kCpuExecutionProvider).SinceVersion(4, 10).Build();
+  std::vector<onnxruntime::NodeArg*> concat_inputs{Arg(X2), Arg(X3)}, concat_outputs{Arg(X4)};
+  AddNode(*concat_kernel, concat, concat_inputs, concat_outputs)->AddAttribute("axis", static_cast<int64_t>(1));
+  AddNormalNode(X4, X5);
+
+  // simulate shape-inference results:
+  Shape shape1{2, 3}, shape2{2, 6};
+  SetShape({{X1, &shape1.value}, {X2, &shape1.value}, {X3, &shape1.value}, {X4, &shape2.value},
+            {X5, &shape2.value}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kAllocate);
+}
+
+TEST_F(PlannerTest, SplitSubBufferTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5"), X6("X6"), split("split");
+
+  // graph structure: X3 and X4 are views of X2.
+  AddNormalNode(X1, X2);
+  auto split_kernel = KernelDefBuilder().SetName("Split").Provider(kCpuExecutionProvider).SinceVersion(2, 10).Build();
+  std::vector<onnxruntime::NodeArg*> split_inputs{Arg(X2)}, split_outputs{Arg(X3), Arg(X4)};
+  AddNode(*split_kernel, split, split_inputs, split_outputs)->AddAttribute("axis", static_cast<int64_t>(1));
+  AddNormalNode(X3, X5);
+  AddNormalNode(X4, X6);
+
+  // simulate shape-inference results:
+  Shape shape1{1, 6, 3}, shape2{1, 2, 3}, shape3{1, 4, 3};
+  SetShape({{X1, &shape1.value}, {X2, &shape1.value}, {X3, &shape2.value}, {X4, &shape3.value},
+            {X5, &shape2.value}, {X6, &shape3.value}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kReuse);
+  CheckAllocKind(X4, AllocKind::kReuse);
+
+  // check the placement of the outputs in the Split input:
+  const auto& name_idx_map = GetState().GetOrtValueNameIdxMap();
+  int x2_idx, x3_idx, x4_idx;
+  ASSERT_STATUS_OK(name_idx_map.GetIdx(X2, x2_idx));
+  ASSERT_STATUS_OK(name_idx_map.GetIdx(X3, x3_idx));
+  ASSERT_STATUS_OK(name_idx_map.GetIdx(X4, x4_idx));
+  const auto& x3_plan = GetPlan().allocation_plan[x3_idx];
+  const auto& x4_plan = GetPlan().allocation_plan[x4_idx];
+  EXPECT_EQ(x3_plan.reused_buffer, x2_idx);
+  EXPECT_TRUE(x3_plan.is_sub_buffer);
+  EXPECT_EQ(x3_plan.sub_buffer_offset, 0U);
+  EXPECT_EQ(x4_plan.reused_buffer, x2_idx);
+  EXPECT_TRUE(x4_plan.is_sub_buffer);
+  EXPECT_EQ(x4_plan.sub_buffer_offset, 2 * 3 * sizeof(float));
+}
+
 #ifdef ENABLE_STRIDED_TENSORS
 TEST_F(PlannerTest, MayStridedTest1) {
   // tensor variables:
@@ -1935,6 +2074,78 @@ TEST_F(PlannerTest, TestMultiStreamMismatchDevice) {
   status = sess.Initialize();
   ASSERT_TRUE(!status.IsOK());
 }
+
+// Two independent towers joined by an Add. With costs that make both towers expensive,
+// CostBasedPartitioner puts each of them on its own CPU stream.
+TEST_F(PlannerTest, TestCostBasedPartitionerSplitsIndependentBranches) {
+  const char* config_file_path = "./cost_based_partition_config.json";
+  {
+    std::ofstream of_stream(config_file_path);
+    ASSERT_TRUE(of_stream.is_open());
+    of_stream << R"({"type":"CostBasedPartitioner","num_streams":2,"sync_cost":1.0,)"
+              << R"("node_costs":{"tower_0_0":100,"tower_0_1":100,"tower_1_0":100,"tower_1_1":100,"join":1}})";
+  }
+
+  auto partitioner = IGraphPartitioner::CreateGraphPartitioner(DefaultLoggingManager().DefaultLogger(),
+                                                               ORT_TSTR("./cost_based_partition_config.json"));
+  ASSERT_TRUE(partitioner && strcmp(partitioner->Type(), "CostBasedPartitioner") == 0);
+
+  onnxruntime::Model model("cost_based_partition", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  TypeProto float_type;
+  float_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(16);
+
+  auto& graph_in = graph.GetOrCreateNodeArg("graph_in", &float_type);
+  auto& graph_out = graph.GetOrCreateNodeArg("graph_out", &float_type);
+  std::vector<NodeArg*> tower_outputs;
+  for (int tower = 0; tower < 2; ++tower) {
+    NodeArg* input = &graph_in;
+    for (int layer = 0; layer < 2; ++layer) {
+      const std::string name = "tower_" + std::to_string(tower) + "_" + std::to_string(layer);
+      auto& output = graph.GetOrCreateNodeArg(name + "_out", &float_type);
+      graph.AddNode(name, "Relu", "", {input}, {&output});
+      input = &output;
+    }
+    tower_outputs.push_back(input);
+  }
+  graph.AddNode("join", "Add", "", tower_outputs, {&graph_out});
+  graph.SetInputs({&graph_in});
+  graph.SetOutputs({&graph_out});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  SessionOptions sess_opt;
+  sess_opt.execution_mode = ExecutionMode::ORT_PARALLEL;
+  ASSERT_STATUS_OK(sess_opt.config_options.AddConfigEntry(kNodePartitionConfigFile, config_file_path));
+  InferenceSession sess{sess_opt, GetEnvironment()};
+  ASSERT_STATUS_OK(sess.RegisterExecutionProvider(DefaultCpuExecutionProvider()));
+
+  std::string serialized_model;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&serialized_model));
+  std::stringstream model_stream(serialized_model);
+  ASSERT_STATUS_OK(sess.Load(model_stream));
+  ASSERT_STATUS_OK(sess.Initialize());
+
+  auto& session_state = sess.GetSessionState();
+  auto* exe_plan = const_cast<onnxruntime::SessionState&>(session_state).GetExecutionPlan();
+  ASSERT_EQ(exe_plan->execution_plan.size(), 2u);
+
+  // each tower stays on one stream, and the two towers are on different streams
+  const auto& graph_viewer = session_state.GetGraphViewer();
+  InlinedHashMap<std::string, size_t> node_stream;
+  for (size_t i = 0; i < exe_plan->execution_plan.size(); ++i) {
+    for (auto& step : exe_plan->execution_plan[i]->steps_) {
+      if (strstr(typeid(*step).name(), "LaunchKernelStep") != nullptr) {
+        node_stream[graph_viewer.GetNode(step->GetNodeIndex())->Name()] = i;
+      }
+    }
+  }
+  EXPECT_EQ(node_stream["tower_0_0"], node_stream["tower_0_1"]);
+  EXPECT_EQ(node_stream["tower_1_0"], node_stream["tower_1_1"]);
+  EXPECT_NE(node_stream["tower_0_0"], node_stream["tower_1_0"]);
+
+  std::remove(config_file_path);
+}
 #endif
 
 #if defined(USE_CUDA) && defined(ORT_ENABLE_STREAM)
@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #include "core/framework/allocator.h"
+#include "core/framework/bfc_arena.h"
+#include "core/framework/huge_page_allocator.h"
 
 #include "test_utils.h"
 #include "gtest/gtest.h"
@@ -31,6 +33,31 @@ TEST(AllocatorTest, CPUAllocatorTest) {
   cpu_arena->Free(bytes);
   // todo: test the used / max api.
 }
+
+TEST(AllocatorTest, HugePageCPUAllocatorTest) {
+  // falls back to regular pages if the machine has no huge pages, so this runs everywhere
+  BFCArena arena(std::make_unique<HugePageCPUAllocator>(HugePageCPUAllocator::kHugePage2MB, -1), 1 << 30);
+
+  ASSERT_STREQ(arena.Info().name, CPU);
+
+  std::vector<void*> ptrs;
+  for (size_t size : {size_t{1024}, size_t{3} * 1024 * 1024, size_t{64}}) {
+    void* p = arena.Alloc(size);
+    ASSERT_NE(p, nullptr);
+    memset(p, -1, size);
+    EXPECT_EQ(*static_cast<int*>(p), -1);
+    ptrs.push_back(p);
+  }
+
+  for (void* p : ptrs) {
+    arena.Free(p);
+  }
+  EXPECT_EQ(arena.Shrink(), Status::OK());
+
+  AllocatorStats stats;
+  arena.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 0);
+}
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(disable : 26400)
 #endif
@@ -6,6 +6,9 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <thread>
 #include "core/framework/stream_handles.h"
 
 namespace onnxruntime {
@@ -303,6 +306,167 @@ TEST(BFCArenaTest, TestShrink) {
   EXPECT_EQ(stats.total_allocated_bytes, 10 * 1024 * 1024) << "Expect 10M bytes but actually " << stats.total_allocated_bytes << " bytes";
 }
 
+TEST(BFCArenaTest, FragmentationStatsAndCompact) {
+  AllocatorStats stats;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested);
+  void* p1 = a.Alloc(1 << 20);
+  void* p2 = a.Alloc(1 << 20);
+  void* p3 = a.Alloc(4 << 20);
+  a.Free(p1);
+  a.Free(p3);
+
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_regions, 3);
+  EXPECT_EQ(stats.largest_free_chunk, 4 << 20);
+  ASSERT_FALSE(stats.free_bytes_per_bin.empty());
+  EXPECT_EQ(std::accumulate(stats.free_bytes_per_bin.begin(), stats.free_bytes_per_bin.end(), int64_t{0}),
+            5 << 20);
+
+  EXPECT_EQ(a.Compact(), Status::OK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_regions, 1) << "only the region of p2 is left";
+  EXPECT_EQ(stats.num_arena_shrinkages, 2);
+  EXPECT_EQ(stats.total_allocated_bytes, 1 << 20);
+  EXPECT_EQ(stats.largest_free_chunk, 0);
+  EXPECT_EQ(stats.bytes_in_use, 1 << 20);
+
+  a.Free(p2);
+}
+
+TEST(BFCArenaTest, SlabCacheServesSmallAllocations) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             4096, 1 << 20);
+
+  std::vector<void*> ptrs;
+  for (int s = 1; s <= 4096; s += 17) {
+    void* raw = a.Alloc(s);
+    ASSERT_NE(raw, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(raw) % kAllocAlignment, 0u);
+    EXPECT_GE(a.AllocatedSize(raw), static_cast<size_t>(s));
+    ptrs.push_back(raw);
+  }
+
+  // larger requests go to the bins
+  void* large = a.Alloc(8192);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_slab_allocs, static_cast<int64_t>(ptrs.size()));
+  EXPECT_GT(stats.slab_bytes_in_use, 0);
+  EXPECT_EQ(stats.slab_region_bytes, 1 << 20);
+  EXPECT_EQ(stats.num_allocs, 1);
+  EXPECT_EQ(stats.bytes_in_use, 8192);
+
+  std::sort(ptrs.begin(), ptrs.end());
+  for (size_t i = 1; i < ptrs.size(); i++) {
+    ASSERT_GE(static_cast<size_t>(static_cast<char*>(ptrs[i]) - static_cast<char*>(ptrs[i - 1])),
+              a.AllocatedSize(ptrs[i - 1]));
+  }
+
+  for (void* p : ptrs) {
+    a.Free(p);
+  }
+  a.Free(large);
+
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.slab_bytes_in_use, 0);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+
+  // freed blocks are reused
+  void* p = a.Alloc(100);
+  a.Free(p);
+  void* q = a.Alloc(200);
+  EXPECT_EQ(p, q);
+  a.Free(q);
+}
+
+TEST(BFCArenaTest, SlabCacheFallsBackWhenExhausted) {
+  // a single 64KB page holds 16 blocks of 4KB
+  OrtArenaCfg config(0, -1, -1, -1, -1, -1L);
+  config.slab_max_alloc_bytes = 4096;
+  config.slab_region_bytes = 64 * 1024;
+  AllocatorCreationInfo device_info{
+      [](OrtDevice::DeviceId) { return std::make_unique<CPUAllocator>(); },
+      0, true, config};
+  auto allocator = CreateAllocator(device_info);
+  BFCArena& a = *static_cast<BFCArena*>(allocator.get());
+
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 20; ++i) {
+    ptrs.push_back(a.Alloc(4096));
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_slab_allocs, 16);
+  EXPECT_EQ(stats.num_allocs, 4);
+
+  for (void* p : ptrs) {
+    a.Free(p);
+  }
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.slab_bytes_in_use, 0);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
+TEST(BFCArenaTest, SlabCacheThreadMagazines) {
+  OrtArenaCfg config(0, -1, -1, -1, -1, -1L);
+  config.slab_max_alloc_bytes = 2048;
+  config.slab_region_bytes = 4 * 1024 * 1024;
+  config.slab_thread_cache_blocks = 16;
+  AllocatorCreationInfo device_info{
+      [](OrtDevice::DeviceId) { return std::make_unique<CPUAllocator>(); },
+      0, true, config};
+  auto allocator = CreateAllocator(device_info);
+  BFCArena& a = *static_cast<BFCArena*>(allocator.get());
+
+  constexpr int kNumThreads = 8;
+  constexpr int kNumIterations = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&a, t]() {
+      std::vector<void*> ptrs;
+      for (int i = 0; i < kNumIterations; ++i) {
+        const size_t size = 1 + static_cast<size_t>((i * 37 + t) % 2048);
+        void* p = a.Alloc(size);
+        ASSERT_NE(p, nullptr);
+        // make sure no other thread owns the block at the same time
+        std::memset(p, t, size);
+        ptrs.push_back(p);
+        if (ptrs.size() > 40) {
+          for (void* q : ptrs) {
+            a.Free(q);
+          }
+          ptrs.clear();
+        }
+      }
+      for (void* q : ptrs) {
+        a.Free(q);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_slab_allocs, kNumThreads * kNumIterations);
+  EXPECT_EQ(stats.slab_bytes_in_use, 0);
+  EXPECT_EQ(stats.num_allocs, 0);
+
+  // blocks freed by the exited threads were handed back and can be reused from this thread
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 64; ++i) {
+    ptrs.push_back(a.Alloc(256));
+  }
+  for (void* p : ptrs) {
+    a.Free(p);
+  }
+}
+
 class BadAllocator : public IAllocator {
  public:
   BadAllocator() : IAllocator(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator)) {}
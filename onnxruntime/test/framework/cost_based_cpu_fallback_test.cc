@@ -0,0 +1,121 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/cost_based_cpu_fallback.h"
+#include "core/framework/execution_providers.h"
+#include "core/framework/kernel_registry_manager.h"
+#include "core/graph/model.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
+#include "default_providers.h"
+#include "gtest/gtest.h"
+#include "test/test_environment.h"
+#include "asserts.h"
+
+using namespace ONNX_NAMESPACE;
+namespace onnxruntime {
+namespace test {
+
+#ifdef USE_CUDA
+
+typedef std::vector<onnxruntime::NodeArg*> ArgMap;
+
+static TypeProto FloatTensorType(std::initializer_list<int64_t> dims) {
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  for (int64_t dim : dims) {
+    type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+  }
+  return type;
+}
+
+// X -> Abs (CPU) -> MatMul (CUDA) -> Relu (CUDA) -> Neg (CPU) -> Y
+static void RunFallbackTest(int64_t size, bool expect_fallback) {
+  auto model = std::make_shared<onnxruntime::Model>("test", false, ModelMetaData(), PathString(),
+                                                    IOnnxRuntimeOpSchemaRegistryList(),
+                                                    std::unordered_map<std::string, int>{{kOnnxDomain, 12}},
+                                                    std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                                                    DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model->MainGraph();
+
+  const TypeProto type = FloatTensorType({size, size});
+  auto& x = graph.GetOrCreateNodeArg("X", &type);
+  auto& w = graph.GetOrCreateNodeArg("W", &type);
+  auto& abs_out = graph.GetOrCreateNodeArg("abs_out", &type);
+  auto& matmul_out = graph.GetOrCreateNodeArg("matmul_out", &type);
+  auto& relu_out = graph.GetOrCreateNodeArg("relu_out", &type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &type);
+
+  auto& abs_node = graph.AddNode("abs", "Abs", "", ArgMap{&x}, ArgMap{&abs_out});
+  abs_node.SetExecutionProviderType(kCpuExecutionProvider);
+  auto& matmul_node = graph.AddNode("matmul", "MatMul", "", ArgMap{&abs_out, &w}, ArgMap{&matmul_out});
+  matmul_node.SetExecutionProviderType(kCudaExecutionProvider);
+  auto& relu_node = graph.AddNode("relu", "Relu", "", ArgMap{&matmul_out}, ArgMap{&relu_out});
+  relu_node.SetExecutionProviderType(kCudaExecutionProvider);
+  auto& neg_node = graph.AddNode("neg", "Neg", "", ArgMap{&relu_out}, ArgMap{&y});
+  neg_node.SetExecutionProviderType(kCpuExecutionProvider);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(kCudaExecutionProvider, DefaultCudaExecutionProvider()));
+  ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider,
+                                           std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo())));
+  KernelRegistryManager kernel_registry_manager;
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  bool modified = false;
+  ASSERT_STATUS_OK(FallbackDeviceRegionsToCpu(graph, kernel_registry_manager, modified));
+  EXPECT_EQ(modified, expect_fallback);
+
+  const auto& expected_provider = expect_fallback ? kCpuExecutionProvider : kCudaExecutionProvider;
+  EXPECT_EQ(matmul_node.GetExecutionProviderType(), expected_provider);
+  EXPECT_EQ(relu_node.GetExecutionProviderType(), expected_provider);
+  EXPECT_EQ(abs_node.GetExecutionProviderType(), kCpuExecutionProvider);
+  EXPECT_EQ(neg_node.GetExecutionProviderType(), kCpuExecutionProvider);
+}
+
+TEST(CostBasedCpuFallbackTest, SmallRegionMovesToCpu) {
+  // the copies of the inputs and the output cost more than the small MatMul saves
+  RunFallbackTest(4, true);
+}
+
+TEST(CostBasedCpuFallbackTest, LargeRegionStaysOnDevice) {
+  RunFallbackTest(256, false);
+}
+
+TEST(CostBasedCpuFallbackTest, UnknownShapesStayOnDevice) {
+  auto model = std::make_shared<onnxruntime::Model>("test", false, ModelMetaData(), PathString(),
+                                                    IOnnxRuntimeOpSchemaRegistryList(),
+                                                    std::unordered_map<std::string, int>{{kOnnxDomain, 12}},
+                                                    std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                                                    DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model->MainGraph();
+
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("N");
+  auto& x = graph.GetOrCreateNodeArg("X", &type);
+  auto& relu_out = graph.GetOrCreateNodeArg("relu_out", &type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &type);
+  auto& relu_node = graph.AddNode("relu", "Relu", "", ArgMap{&x}, ArgMap{&relu_out});
+  relu_node.SetExecutionProviderType(kCudaExecutionProvider);
+  auto& neg_node = graph.AddNode("neg", "Neg", "", ArgMap{&relu_out}, ArgMap{&y});
+  neg_node.SetExecutionProviderType(kCpuExecutionProvider);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(kCudaExecutionProvider, DefaultCudaExecutionProvider()));
+  ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider,
+                                           std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo())));
+  KernelRegistryManager kernel_registry_manager;
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  bool modified = false;
+  ASSERT_STATUS_OK(FallbackDeviceRegionsToCpu(graph, kernel_registry_manager, modified));
+  EXPECT_FALSE(modified);
+  EXPECT_EQ(relu_node.GetExecutionProviderType(), kCudaExecutionProvider);
+}
+
+#endif  // USE_CUDA
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -8,6 +8,7 @@
 #include "core/graph/model.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test_utils.h"
 #include "test/test_environment.h"
 #include "test/framework/TestAllocatorManager.h"
@@ -330,6 +331,205 @@ TEST_F(ExecutionFrameTest, MemPatternTest) {
   ASSERT_EQ(p->GetBlock(4)->offset_, kAllocAlignment);
 }
 
+TEST_F(ExecutionFrameTest, ReuseDyingInputForOutputTest) {
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_type = cpu_xp->Type();
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 7;
+  onnxruntime::Model model("test", true, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg input_def1("X1", &tensor_float),
+      input_def2("X2", &tensor_float),
+      abs_out_def("T1", &tensor_float),
+      add_out_def("T2", &tensor_float),
+      neg_out_def("T3", &tensor_float);
+
+  auto& abs_node = graph.AddNode("node1", "Abs", "abs1", ArgMap{&input_def1}, ArgMap{&abs_out_def});
+  abs_node.SetExecutionProviderType(xp_type);
+  auto& add_node = graph.AddNode("node2", "Add", "add1", ArgMap{&abs_out_def, &input_def2}, ArgMap{&add_out_def});
+  add_node.SetExecutionProviderType(xp_type);
+  graph.AddNode("node3", "Neg", "neg1", ArgMap{&add_out_def}, ArgMap{&neg_out_def})
+      .SetExecutionProviderType(xp_type);
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  KernelRegistryManager kernel_registry_manager;
+
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(xp_type, std::move(cpu_xp)));
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  DataTransferManager dtm;
+  profiling::Profiler profiler;
+
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.use_deterministic_compute = false;
+  sess_options.enable_mem_reuse = true;
+
+  SessionState state(graph, execution_providers, &tp_, nullptr, dtm,
+                     DefaultLoggingManager().DefaultLogger(), profiler, sess_options);
+
+  ASSERT_STATUS_OK(state.FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager));
+
+  const OrtValueNameIdxMap& mlvalue_name_idx_map(state.GetOrtValueNameIdxMap());
+
+  int x1_idx = -1, x2_idx = -1, t1_idx = -1, t2_idx = -1, t3_idx = -1;
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("X1", x1_idx).IsOK());
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("X2", x2_idx).IsOK());
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("T1", t1_idx).IsOK());
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("T2", t2_idx).IsOK());
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("T3", t3_idx).IsOK());
+
+  auto cpu_allocator = execution_providers.Get(xp_type)->CreatePreferredAllocators()[0];
+
+  OrtValue v1, v2;
+  CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{2, 3}, std::vector<float>(6, -1.0f), &v1);
+  CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{2, 3}, std::vector<float>(6, 1.0f), &v2);
+
+  std::vector<OrtValue> outputs;
+  ExecutionFrame frame(AsSpan({x1_idx, x2_idx}), AsSpan({v1, v2}), AsSpan({t3_idx}), outputs, {}, {}, state);
+  ASSERT_TRUE(frame.HasMemoryPatternPlanner());
+
+  // T1 is only read by the Add node so it is dead once Add has run. X2 is a graph input.
+  EXPECT_TRUE(frame.IsNodeInputDeadAfterNode(add_node, 0));
+  EXPECT_FALSE(frame.IsNodeInputDeadAfterNode(add_node, 1));
+  EXPECT_FALSE(frame.IsNodeInputDeadAfterNode(abs_node, 0));
+
+  const TensorShape shape(std::vector<int64_t>{2, 3});
+  const int abs_offset = frame.GetNodeOffset(abs_node.Index());
+  OrtValue& t1 = *frame.GetMutableNodeInputOrOutputMLValue(abs_offset + 1);
+  ASSERT_STATUS_OK(frame.AllocateMLValueTensorSelfOwnBuffer(t1, t1_idx, DataTypeImpl::GetType<float>(),
+                                                            cpu_allocator->Info().device, shape));
+
+  // the node args of Add are T1, X2 and T2
+  const int add_offset = frame.GetNodeOffset(add_node.Index());
+  OrtValue* p_t2 = nullptr;
+  ASSERT_STATUS_OK(frame.TryReuseNodeInputForOutput(add_offset, add_offset + 2,
+                                                    TensorShape(std::vector<int64_t>{3, 2}), p_t2));
+  EXPECT_EQ(p_t2, nullptr) << "The input can't be reused for an output with a different shape";
+
+  ASSERT_STATUS_OK(frame.TryReuseNodeInputForOutput(add_offset, add_offset + 2, shape, p_t2));
+  ASSERT_NE(p_t2, nullptr);
+  EXPECT_EQ(p_t2->Get<Tensor>().DataRaw(), t1.Get<Tensor>().DataRaw());
+
+  // the buffer stays in use by T2 after T1 is released
+  const void* t1_data = t1.Get<Tensor>().DataRaw();
+  ASSERT_STATUS_OK(frame.ReleaseMLValue(t1_idx));
+  EXPECT_EQ(frame.GetNodeInputOrOutputMLValue(add_offset + 2)->Get<Tensor>().DataRaw(), t1_data);
+  ASSERT_STATUS_OK(frame.ReleaseMLValue(t2_idx));
+
+  // T2 never got a buffer of its own so only T1 is in the traced pattern
+  MemoryPatternGroup pattern;
+  ASSERT_STATUS_OK(frame.GeneratePatterns(pattern));
+  auto p = pattern.GetPatterns(cpu_allocator->Info().device);
+  ASSERT_NE(p, nullptr);
+  EXPECT_NE(p->GetBlock(t1_idx), nullptr);
+  EXPECT_EQ(p->GetBlock(t2_idx), nullptr);
+}
+
+TEST_F(ExecutionFrameTest, MemPatternBucketingTest) {
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_type = cpu_xp->Type();
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 7;
+  onnxruntime::Model model("test", true, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+  // X1 is {seq, 2}, X2 is {2, 3}
+  TypeProto x1_type;
+  x1_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  x1_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("seq");
+  x1_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  TypeProto x2_type;
+  x2_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  x2_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  x2_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg input_def1("X1", &x1_type),
+      input_def2("X2", &x2_type),
+      gemm_out_def("T1", &tensor_float),
+      clip_out_def("T2", &tensor_float);
+
+  graph.AddNode("node1", "MatMul", "gemm1", ArgMap{&input_def1, &input_def2}, ArgMap{&gemm_out_def})
+      .SetExecutionProviderType(xp_type);
+  graph.AddNode("node2", "Clip", "clip1", ArgMap{&gemm_out_def}, ArgMap{&clip_out_def})
+      .SetExecutionProviderType(xp_type);
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  KernelRegistryManager kernel_registry_manager;
+
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(xp_type, std::move(cpu_xp)));
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  DataTransferManager dtm;
+  profiling::Profiler profiler;
+
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.enable_mem_reuse = true;
+  ASSERT_STATUS_OK(sess_options.config_options.AddConfigEntry(kOrtSessionOptionsMemoryPatternBucketing, "1"));
+
+  SessionState state(graph, execution_providers, &tp_, nullptr, dtm,
+                     DefaultLoggingManager().DefaultLogger(), profiler, sess_options);
+
+  ASSERT_STATUS_OK(state.FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager));
+  state.ResolveMemoryPatternFlag();
+  ASSERT_TRUE(state.GetEnableMemoryPattern());
+  ASSERT_TRUE(state.GetEnableMemoryPatternBucketing());
+
+  const OrtValueNameIdxMap& mlvalue_name_idx_map(state.GetOrtValueNameIdxMap());
+  int x1_idx = -1, x2_idx = -1, t1_idx = -1, t2_idx = -1;
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("X1", x1_idx));
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("X2", x2_idx));
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("T1", t1_idx));
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("T2", t2_idx));
+
+  auto cpu_allocator = execution_providers.Get(xp_type)->CreatePreferredAllocators()[0];
+  const auto& device = cpu_allocator->Info().device;
+
+  OrtValue x2;
+  CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{2, 3}, std::vector<float>(6, 1.0f), &x2);
+
+  // runs the planned part of the graph for X1 of shape {seq, 2} and records the pattern if none was found.
+  // returns whether a cached pattern was used.
+  auto run = [&](int64_t seq) {
+    OrtValue x1;
+    CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{seq, 2},
+                         std::vector<float>(static_cast<size_t>(seq * 2), 1.0f), &x1);
+    std::vector<OrtValue> feeds{x1, x2};
+    std::vector<OrtValue> outputs;
+    ExecutionFrame frame(AsSpan({x1_idx, x2_idx}), feeds, AsSpan({t2_idx}), outputs, {}, {}, state);
+    OrtValue& t1 = *frame.GetMutableNodeInputOrOutputMLValue(t1_idx);
+    ORT_THROW_IF_ERROR(frame.AllocateMLValueTensorSelfOwnBuffer(t1, t1_idx, DataTypeImpl::GetType<float>(), device,
+                                                                TensorShape(std::vector<int64_t>{seq, 3})));
+    if (!frame.HasMemoryPatternPlanner()) {
+      return true;
+    }
+
+    MemoryPatternGroup pattern;
+    ORT_THROW_IF_ERROR(frame.GeneratePatterns(pattern));
+    ORT_THROW_IF_ERROR(state.UpdateMemoryPatternGroupCache(feeds, AsSpan({x1_idx, x2_idx}), std::move(pattern)));
+    return false;
+  };
+
+  EXPECT_FALSE(run(3));  // records the pattern for the bucket of seq 3 and 4
+  EXPECT_TRUE(run(3));
+  EXPECT_FALSE(run(4));  // same bucket but larger than recorded, so the pattern is re-recorded
+  EXPECT_TRUE(run(3));   // served from the pattern recorded for seq 4
+  EXPECT_TRUE(run(4));
+  EXPECT_FALSE(run(5));  // next bucket
+  EXPECT_FALSE(run(2));  // previous bucket
+}
+
 #ifdef ENABLE_TRAINING
 TEST_F(ExecutionFrameTest, MemPatternWithExternalOutputsTest) {
   auto cpu_xp = CreateCPUExecutionProvider();
@@ -6,8 +6,13 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <cmath>
+#include <filesystem>
 #include <functional>
 #include <iterator>
+#include <limits>
+#include <mutex>
+#include <numeric>
 #include <thread>
 #include <fstream>
 
@@ -21,6 +26,7 @@
 #include "core/framework/execution_provider.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/session_metrics.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/bfc_arena.h"
@@ -43,10 +49,18 @@
 #include "core/providers/rocm/gpu_data_transfer.h"
 #endif
 #include "core/session/environment.h"
+#include "core/session/ensemble.h"
 #include "core/session/IOBinding.h"
 #include "core/session/inference_session_utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
+#include "core/session/device_pool_session.h"
+#include "core/session/pipeline_session.h"
+#include "core/session/prepared_run.h"
+#include "core/session/request_batcher.h"
+#include "core/session/run_pipeline.h"
+#include "core/session/session_warmup.h"
+#include "core/session/swappable_session.h"
 #include "dummy_provider.h"
 #include "test_utils.h"
 #include "test/capturing_sink.h"
@@ -428,6 +442,46 @@ TEST(InferenceSessionTests, DisableCPUArena) {
   RunModel(session_object, run_options);
 }
 
+TEST(InferenceSessionTests, LeanExecutor) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.LeanExecutor";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsLeanExecutor, "1"));
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  const auto* lean_plan = session_object.GetSessionState().GetLeanExecutionPlan();
+  ASSERT_NE(lean_plan, nullptr);
+  ASSERT_EQ(lean_plan->Kernels().size(), 1u);
+  EXPECT_EQ(lean_plan->Kernels()[0].kernel->Node().OpType(), "Mul");
+
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  for (int i = 0; i < 3; ++i) {
+    RunModel(session_object, run_options);
+  }
+
+  // the Runs sampled for metrics time their kernels in the regular executor
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsMetricsSamplingRate, "1"));
+  InferenceSession sampled_session{so, GetEnvironment()};
+  ASSERT_STATUS_OK(sampled_session.Load(MODEL_URI));
+  ASSERT_STATUS_OK(sampled_session.Initialize());
+  ASSERT_NE(sampled_session.GetSessionState().GetLeanExecutionPlan(), nullptr);
+  for (int i = 0; i < 2; ++i) {
+    RunModel(sampled_session, run_options);
+  }
+  std::string snapshot;
+  ASSERT_STATUS_OK(sampled_session.GetMetricsSnapshot(snapshot));
+  EXPECT_THAT(snapshot, testing::HasSubstr("op_type=\"Mul\"} 2\n"));
+
+  // disabled by default
+  SessionOptions default_so;
+  InferenceSession default_session{default_so, GetEnvironment()};
+  ASSERT_STATUS_OK(default_session.Load(MODEL_URI));
+  ASSERT_STATUS_OK(default_session.Initialize());
+  EXPECT_EQ(default_session.GetSessionState().GetLeanExecutionPlan(), nullptr);
+}
+
 TEST(InferenceSessionTests, TestModelSerialization) {
   // Load model with level 0 transform level
   // and assert that the model has Identity nodes.
@@ -490,6 +544,656 @@ TEST(InferenceSessionTests, TestModelSerialization) {
   ASSERT_TRUE(session_object_emptyValidation.Initialize().IsOK());
 }
 
+TEST(InferenceSessionTests, OptimizationCache) {
+  const string test_model = "testdata/transform/abs-id-max.onnx";
+  const std::filesystem::path cache_dir =
+      std::filesystem::temp_directory_path() /
+      ("ort_optimization_cache_test_" + std::to_string(Env::Default().GetSelfPid()));
+  std::filesystem::remove_all(cache_dir);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.OptimizationCache";
+  so.graph_optimization_level = TransformerLevel::Level1;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsOptimizationCacheDir,
+                                                    cache_dir.string().c_str()));
+
+  const auto cache_files = [&cache_dir]() {
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(cache_dir)) {
+      files.push_back(entry.path());
+    }
+    return files;
+  };
+  const auto initialize = [&test_model](const SessionOptions& session_options) {
+    InferenceSessionWrapper session_object{session_options, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(test_model));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    // the identity nodes are removed by the transformers or in the cached model
+    ASSERT_EQ(CountOpsInGraph(session_object.GetGraph())["Identity"], 0);
+  };
+
+  // the first session saves the optimized model
+  initialize(so);
+  auto files = cache_files();
+  ASSERT_EQ(files.size(), 1u);
+  EXPECT_EQ(files[0].extension(), ".ort");
+  const auto cache_file = files[0];
+  const auto write_time = std::filesystem::last_write_time(cache_file);
+
+  // the next session loads it
+  initialize(so);
+  EXPECT_EQ(cache_files().size(), 1u);
+  EXPECT_EQ(std::filesystem::last_write_time(cache_file), write_time);
+
+  // other options have their own entry
+  so.graph_optimization_level = TransformerLevel::Level2;
+  initialize(so);
+  EXPECT_EQ(cache_files().size(), 2u);
+
+  // an invalid file is replaced
+  so.graph_optimization_level = TransformerLevel::Level1;
+  const auto cache_file_size = std::filesystem::file_size(cache_file);
+  std::ofstream(cache_file, std::ios::binary | std::ios::trunc) << "not an ORT format model";
+  initialize(so);
+  EXPECT_EQ(std::filesystem::file_size(cache_file), cache_file_size);
+
+  std::filesystem::remove_all(cache_dir);
+}
+
+TEST(InferenceSessionTests, TuningResultsCacheFile) {
+  const std::filesystem::path cache_dir =
+      std::filesystem::temp_directory_path() /
+      ("ort_tuning_results_cache_test_" + std::to_string(Env::Default().GetSelfPid()));
+  std::filesystem::remove_all(cache_dir);
+  const auto cache_file = (cache_dir / "results.json").native();
+
+  TuningResults tuning_results;
+  tuning_results.ep = kRocmExecutionProvider;
+  tuning_results.validators = {{"ORT_VERSION", ORT_VERSION}, {"GCN_ARCH", "gfx90a:sramecc+:xnack-"}};
+  tuning_results.results = {{"GemmTunableOp_float_NN", {{"M_16_N_32_K_64", 3}, {"M_32_N_32_K_64", 5}}}};
+  ASSERT_STATUS_OK(inference_session_utils::SaveTuningResultsToFile(cache_file, tuning_results));
+
+  TuningResults loaded;
+  ASSERT_STATUS_OK(inference_session_utils::LoadTuningResultsFromFile(cache_file, loaded));
+  EXPECT_EQ(loaded.ep, tuning_results.ep);
+  EXPECT_EQ(loaded.validators, tuning_results.validators);
+  EXPECT_EQ(loaded.results, tuning_results.results);
+
+  std::ofstream(cache_file, std::ios::binary | std::ios::trunc) << "{\"ep\": ";
+  EXPECT_FALSE(inference_session_utils::LoadTuningResultsFromFile(cache_file, loaded).IsOK());
+
+  std::filesystem::remove_all(cache_dir);
+}
+
+TEST(InferenceSessionTests, ShapeSpecialization) {
+  onnxruntime::Model model("graph_1", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  // X has a symbolic first dimension that is fixed by the specialized session
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("N");
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& x_arg = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& y_arg = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  auto& z_arg = graph.GetOrCreateNodeArg("Z", &float_tensor);
+  graph.AddNode("node_1", "Add", "node 1.", {&x_arg, &x_arg}, {&y_arg});
+  graph.AddNode("node_2", "Mul", "node 2.", {&y_arg, &x_arg}, {&z_arg});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_str;
+  model.ToProto().SerializeToString(&model_str);
+  std::stringstream model_stream(model_str);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.ShapeSpecialization";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsShapeSpecializationMaxCount, "1"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsShapeSpecializationMinRuns, "2"));
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_stream));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  const std::vector<std::string> output_names{"Z"};
+
+  const auto run = [&](const std::vector<int64_t>& dims, const std::vector<float>& values) {
+    OrtValue ml_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims, values, &ml_value);
+    NameMLValMap feeds{{"X", ml_value}};
+
+    std::vector<float> expected_values;
+    for (float value : values) {
+      expected_values.push_back(2.0f * value * value);
+    }
+
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(run_options, feeds, output_names, &fetches));
+    VerifyOutputs(fetches, dims, expected_values);
+  };
+
+  // the second run with the same shape creates the specialized session, which is used from then on
+  for (int i = 0; i < 4; ++i) {
+    run({3, 2}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  }
+
+  // other shapes use the original session once the maximum number of specializations is reached
+  for (int i = 0; i < 3; ++i) {
+    run({1, 2}, {-1.0f, 0.5f});
+  }
+}
+
+TEST(InferenceSessionTests, StateVariables) {
+  onnxruntime::Model model("graph_1", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  // S accumulates X across the Runs, Y is its negation
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& x_arg = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& s_in_arg = graph.GetOrCreateNodeArg("S_in", &float_tensor);
+  auto& s_out_arg = graph.GetOrCreateNodeArg("S_out", &float_tensor);
+  auto& y_arg = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("node_1", "Add", "node 1.", {&s_in_arg, &x_arg}, {&s_out_arg});
+  graph.AddNode("node_2", "Neg", "node 2.", {&s_out_arg}, {&y_arg});
+  graph.SetOutputs({&s_out_arg, &y_arg});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_str;
+  model.ToProto().SerializeToString(&model_str);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.StateVariables";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsStateVariables, "S_in:S_out"));
+  InferenceSession session_object{so, GetEnvironment()};
+  std::stringstream model_stream(model_str);
+  ASSERT_STATUS_OK(session_object.Load(model_stream));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  const auto make_value = [](const std::vector<float>& values) {
+    OrtValue ml_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {2}, values, &ml_value);
+    return ml_value;
+  };
+  const std::vector<std::string> output_names{"Y"};
+  const auto run = [&](const RunOptions& run_options, NameMLValMap feeds, const std::vector<float>& expected_values) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(run_options, feeds, output_names, &fetches));
+    VerifyOutputs(fetches, {2}, expected_values);
+  };
+
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  const OrtValue x = make_value({1.0f, 2.0f});
+
+  // the first Run feeds the initial state, the next ones the state of the previous Run
+  run(run_options, {{"X", x}, {"S_in", make_value({0.0f, 0.0f})}}, {-1.0f, -2.0f});
+  run(run_options, {{"X", x}}, {-2.0f, -4.0f});
+
+  // another context has its own state, and feeding the state resets it
+  RunOptions other_run_options;
+  ASSERT_STATUS_OK(other_run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigStateContext, "other"));
+  run(other_run_options, {{"X", x}, {"S_in", make_value({10.0f, 10.0f})}}, {-11.0f, -12.0f});
+  run(run_options, {{"X", x}}, {-3.0f, -6.0f});
+  run(other_run_options, {{"X", x}, {"S_in", make_value({0.0f, 1.0f})}}, {-1.0f, -3.0f});
+
+  // the state of an ended context is released, so the next Run must feed it again
+  ASSERT_STATUS_OK(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigEndStateContext, "1"));
+  run(run_options, {{"X", x}}, {-4.0f, -8.0f});
+  const NameMLValMap feeds{{"X", x}};
+  std::vector<OrtValue> fetches;
+  ASSERT_FALSE(session_object.Run(run_options, feeds, output_names, &fetches).IsOK());
+  run(other_run_options, {{"X", x}}, {-2.0f, -5.0f});
+
+  SessionOptions invalid_so;
+  ASSERT_STATUS_OK(invalid_so.config_options.AddConfigEntry(kOrtSessionOptionsStateVariables, "S_in:Z"));
+  InferenceSession invalid_session{invalid_so, GetEnvironment()};
+  std::stringstream invalid_model_stream(model_str);
+  ASSERT_STATUS_OK(invalid_session.Load(invalid_model_stream));
+  ASSERT_FALSE(invalid_session.Initialize().IsOK());
+}
+
+TEST(InferenceSessionTests, LatencyHistogram) {
+  // values below kSubBuckets have a bucket each, then each power of two is split into kSubBuckets buckets
+  for (uint64_t ns : {uint64_t{0}, uint64_t{7}, uint64_t{8}, uint64_t{15}, uint64_t{16}, uint64_t{1000},
+                      uint64_t{123456789}}) {
+    const size_t index = LatencyHistogram::BucketIndex(ns);
+    EXPECT_LE(ns, LatencyHistogram::BucketUpperBoundNs(index));
+    if (index > 0) {
+      EXPECT_GT(ns, LatencyHistogram::BucketUpperBoundNs(index - 1));
+    }
+  }
+  EXPECT_EQ(LatencyHistogram::BucketIndex(std::numeric_limits<uint64_t>::max()), LatencyHistogram::kNumBuckets - 1);
+
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.QuantileNs(0.5), 0u);
+  for (uint64_t ns = 1; ns <= 1000; ++ns) {
+    histogram.Record(ns * 1000);
+  }
+  EXPECT_EQ(histogram.Count(), 1000u);
+  EXPECT_EQ(histogram.SumNs(), 500500u * 1000);
+
+  // quantiles are within the relative error of a bucket
+  for (double q : {0.5, 0.9, 0.99}) {
+    const double expected = q * 1000 * 1000;
+    EXPECT_GE(static_cast<double>(histogram.QuantileNs(q)), expected);
+    EXPECT_LE(static_cast<double>(histogram.QuantileNs(q)), expected * (1.0 + 1.0 / LatencyHistogram::kSubBuckets));
+  }
+  EXPECT_EQ(histogram.QuantileNs(1.0), 1000u * 1000);
+}
+
+TEST(InferenceSessionTests, MetricsSnapshot) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.MetricsSnapshot";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsMetricsSamplingRate, "0.5"));
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  for (int i = 0; i < 4; ++i) {
+    RunModel(session_object, run_options);
+  }
+
+  std::string snapshot;
+  ASSERT_STATUS_OK(session_object.GetMetricsSnapshot(snapshot));
+  EXPECT_THAT(snapshot, testing::HasSubstr("ort_session_run_latency_seconds_count{session=\"" +
+                                           so.session_logid + "\"} 4\n"));
+  // the kernels are timed in every second Run
+  EXPECT_THAT(snapshot, testing::HasSubstr("op_type=\"Mul\"} 2\n"));
+  EXPECT_THAT(snapshot, testing::HasSubstr("ort_allocator_max_bytes_in_use{"));
+
+  // metrics are disabled by default
+  SessionOptions default_so;
+  InferenceSession default_session{default_so, GetEnvironment()};
+  ASSERT_STATUS_OK(default_session.Load(MODEL_URI));
+  ASSERT_STATUS_OK(default_session.Initialize());
+  EXPECT_FALSE(default_session.GetMetricsSnapshot(snapshot).IsOK());
+
+  SessionOptions invalid_so;
+  ASSERT_STATUS_OK(invalid_so.config_options.AddConfigEntry(kOrtSessionOptionsMetricsSamplingRate, "2"));
+  InferenceSession invalid_session{invalid_so, GetEnvironment()};
+  ASSERT_STATUS_OK(invalid_session.Load(MODEL_URI));
+  EXPECT_FALSE(invalid_session.Initialize().IsOK());
+}
+
+TEST(InferenceSessionTests, KernelDispatches) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.KernelDispatches";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsRecordKernelDispatch, "1"));
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load("testdata/matmul_1.onnx"));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // nothing ran yet
+  std::string dispatches;
+  ASSERT_STATUS_OK(session_object.GetKernelDispatches(dispatches));
+  EXPECT_EQ(dispatches, "[]");
+
+  OrtValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {3, 2},
+                       {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &ml_value);
+  NameMLValMap feeds{{"X", ml_value}};
+  const std::vector<std::string> output_names{"Y"};
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  for (int i = 0; i < 2; ++i) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(run_options, feeds, output_names, &fetches));
+  }
+
+  ASSERT_STATUS_OK(session_object.GetKernelDispatches(dispatches));
+  EXPECT_THAT(dispatches, testing::HasSubstr("\"op_type\":\"MatMul\""));
+  EXPECT_THAT(dispatches, testing::HasSubstr("\"provider\":\"CPUExecutionProvider\""));
+  EXPECT_THAT(dispatches, testing::HasSubstr("\"calls\":2"));
+  EXPECT_THAT(dispatches, testing::HasSubstr("\"mlas_sgemm\":"));
+
+  // recording is disabled by default
+  SessionOptions default_so;
+  InferenceSession default_session{default_so, GetEnvironment()};
+  ASSERT_STATUS_OK(default_session.Load("testdata/matmul_1.onnx"));
+  ASSERT_STATUS_OK(default_session.Initialize());
+  EXPECT_FALSE(default_session.GetKernelDispatches(dispatches).IsOK());
+}
+
+TEST(InferenceSessionTests, RunBatch) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.RunBatch";
+  so.intra_op_param.thread_pool_size = 2;
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load("testdata/matmul_1.onnx"));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  constexpr size_t kBatchSize = 4;
+  std::vector<OrtValue> values(kBatchSize);
+  for (size_t r = 0; r < kBatchSize; ++r) {
+    const float v = static_cast<float>(r);
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {3, 2},
+                         {v, v, v, v, v, v}, &values[r]);
+  }
+  // the third request misses its input
+  std::vector<const OrtValue*> feeds{&values[0], &values[1], nullptr, &values[3]};
+  const std::vector<const char*> feed_names{"X"};
+  const std::vector<const char*> fetch_names{"Y"};
+  std::vector<OrtValue*> fetches(kBatchSize, nullptr);
+  std::vector<Status> statuses(kBatchSize);
+  RunOptions run_options;
+  ASSERT_STATUS_OK(session_object.RunBatch(run_options, feed_names, feeds, fetch_names, fetches, statuses));
+
+  for (size_t r = 0; r < kBatchSize; ++r) {
+    if (r == 2) {
+      EXPECT_FALSE(statuses[r].IsOK());
+      EXPECT_EQ(fetches[r], nullptr);
+      continue;
+    }
+    ASSERT_STATUS_OK(statuses[r]);
+    ASSERT_NE(fetches[r], nullptr);
+    std::unique_ptr<OrtValue> fetch(std::exchange(fetches[r], nullptr));
+
+    std::vector<OrtValue> expected;
+    const NameMLValMap request_feeds{{"X", values[r]}};
+    const std::vector<std::string> output_names{"Y"};
+    ASSERT_STATUS_OK(session_object.Run(run_options, request_feeds, output_names, &expected));
+    const auto& tensor = fetch->Get<Tensor>();
+    const auto& expected_tensor = expected[0].Get<Tensor>();
+    ASSERT_EQ(tensor.Shape(), expected_tensor.Shape());
+    for (int64_t i = 0; i < tensor.Shape().Size(); ++i) {
+      EXPECT_EQ(tensor.Data<float>()[i], expected_tensor.Data<float>()[i]);
+    }
+  }
+
+  // the names are checked once for the batch
+  const std::vector<const char*> unknown_names{"Z"};
+  EXPECT_FALSE(session_object.RunBatch(run_options, unknown_names, feeds, fetch_names, fetches, statuses).IsOK());
+}
+
+TEST(InferenceSessionTests, PreparedRun) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.PreparedRun";
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load("testdata/matmul_1.onnx"));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  OrtValue x;
+  CreateMLValue<float>(allocator, {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f}, &x);
+  const std::vector<std::string> feed_names{"X"};
+  const std::vector<std::string> output_names{"Y"};
+  const std::vector<OrtValue> prepared_feeds{x};
+  std::unique_ptr<PreparedRun> prepared_run;
+  ASSERT_STATUS_OK(session_object.PrepareRun(feed_names, prepared_feeds, output_names, prepared_run));
+
+  RunOptions run_options;
+  for (float scale : {1.f, 2.f}) {
+    std::vector<OrtValue> feeds(1);
+    CreateMLValue<float>(allocator, {3, 2}, {scale, 2 * scale, 3 * scale, 4 * scale, 5 * scale, 6 * scale},
+                         &feeds[0]);
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(run_options, *prepared_run, feeds, &fetches));
+
+    std::vector<OrtValue> expected;
+    const NameMLValMap named_feeds{{"X", feeds[0]}};
+    ASSERT_STATUS_OK(session_object.Run(run_options, named_feeds, output_names, &expected));
+    const auto& tensor = fetches[0].Get<Tensor>();
+    const auto& expected_tensor = expected[0].Get<Tensor>();
+    ASSERT_EQ(tensor.Shape(), expected_tensor.Shape());
+    for (int64_t i = 0; i < tensor.Shape().Size(); ++i) {
+      EXPECT_EQ(tensor.Data<float>()[i], expected_tensor.Data<float>()[i]);
+    }
+  }
+
+  // the feeds must have the prepared shape
+  std::vector<OrtValue> wrong_shape(1);
+  CreateMLValue<float>(allocator, {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f}, &wrong_shape[0]);
+  std::vector<OrtValue> fetches;
+  auto status = session_object.Run(run_options, *prepared_run, wrong_shape, &fetches);
+  EXPECT_FALSE(status.IsOK());
+  EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("but the run was prepared for"));
+
+  // the names are resolved when the run is prepared
+  const std::vector<std::string> unknown_names{"Z"};
+  EXPECT_FALSE(session_object.PrepareRun(unknown_names, prepared_feeds, output_names, prepared_run).IsOK());
+}
+
+TEST(InferenceSessionTests, Clone) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.Clone";
+  InferenceSession session_object{so, GetEnvironment()};
+  std::unique_ptr<InferenceSession> clone;
+  ASSERT_STATUS_NOT_OK(session_object.Clone(clone));
+  ASSERT_STATUS_OK(session_object.Load("testdata/matmul_1.onnx"));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  ASSERT_STATUS_OK(session_object.Clone(clone));
+  // the kernels, plans and initializers are shared, not copied
+  EXPECT_EQ(&clone->GetSessionState(), &session_object.GetSessionState());
+
+  auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  OrtValue x;
+  CreateMLValue<float>(allocator, {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f}, &x);
+  const NameMLValMap feeds{{"X", x}};
+  const std::vector<std::string> output_names{"Y"};
+  RunOptions run_options;
+
+  std::vector<OrtValue> expected;
+  ASSERT_STATUS_OK(session_object.Run(run_options, feeds, output_names, &expected));
+  std::vector<OrtValue> fetches;
+  Status clone_status;
+  std::thread worker([&]() { clone_status = clone->Run(run_options, feeds, output_names, &fetches); });
+  worker.join();
+  ASSERT_STATUS_OK(clone_status);
+
+  const auto& tensor = fetches[0].Get<Tensor>();
+  const auto& expected_tensor = expected[0].Get<Tensor>();
+  ASSERT_EQ(tensor.Shape(), expected_tensor.Shape());
+  for (int64_t i = 0; i < tensor.Shape().Size(); ++i) {
+    EXPECT_EQ(tensor.Data<float>()[i], expected_tensor.Data<float>()[i]);
+  }
+}
+
+TEST(InferenceSessionTests, SwappableSession) {
+  const SwappableSession::CreateSessionFn create_session =
+      [](const PathString& model_path, const std::unordered_map<std::string, const OrtValue*>& initializers,
+         std::unique_ptr<InferenceSession>& session) -> Status {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.SwappableSession";
+    for (const auto& [name, value] : initializers) {
+      ORT_RETURN_IF_ERROR(so.AddInitializer(name.c_str(), value));
+    }
+    session = std::make_unique<InferenceSession>(so, GetEnvironment());
+    ORT_RETURN_IF_ERROR(session->Load(model_path));
+    return session->Initialize();
+  };
+  SwappableSession swappable_session{create_session, SwappableSessionOptions()};
+  ASSERT_STATUS_OK(swappable_session.Load(ORT_TSTR("testdata/matmul_1.onnx")));
+
+  auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  OrtValue x;
+  CreateMLValue<float>(allocator, {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f}, &x);
+  const std::vector<const char*> feed_names{"X"};
+  const std::vector<const OrtValue*> feeds{&x};
+  const std::vector<const char*> fetch_names{"Y"};
+  RunOptions run_options;
+  const auto run = [&]() {
+    std::vector<OrtValue*> fetches{nullptr};
+    auto status = swappable_session.Run(run_options, feed_names, feeds, fetch_names, fetches);
+    delete fetches[0];
+    return status;
+  };
+  ASSERT_STATUS_OK(run());
+
+  // the new session is warmed up with the shapes of the Run above
+  ASSERT_STATUS_OK(swappable_session.Swap(ORT_TSTR("testdata/matmul_1.onnx")));
+  ASSERT_STATUS_OK(swappable_session.WaitForSwap());
+  ASSERT_STATUS_OK(run());
+
+  // a failed swap keeps the current session
+  ASSERT_STATUS_OK(swappable_session.Swap(ORT_TSTR("testdata/does_not_exist.onnx")));
+  ASSERT_STATUS_NOT_OK(swappable_session.WaitForSwap());
+  ASSERT_STATUS_OK(run());
+}
+
+TEST(InferenceSessionTests, Ensemble) {
+  const std::vector<EnsembleMember> members{{"a", MODEL_URI}, {"b", MODEL_URI}};
+  const std::vector<EnsembleEdge> edges{{"a", "Y", "b", "X"}};
+  ONNX_NAMESPACE::ModelProto model_proto;
+  PathString model_uri;
+  ASSERT_STATUS_OK(ComposeEnsemble(members, edges, model_proto, model_uri));
+  ASSERT_EQ(model_proto.graph().input_size(), 1);
+  EXPECT_EQ(model_proto.graph().input(0).name(), "a/X");
+  ASSERT_EQ(model_proto.graph().output_size(), 1);
+  EXPECT_EQ(model_proto.graph().output(0).name(), "b/Y");
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.Ensemble";
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(std::move(model_proto), model_uri));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  OrtValue x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {3, 2},
+                       {1.f, 2.f, 3.f, 4.f, 5.f, 6.f}, &x);
+  RunOptions run_options;
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object.Run(run_options, {{"a/X", x}}, {"b/Y"}, &fetches));
+
+  // mul_1 squares its input, so the ensemble raises it to the fourth power
+  const auto& tensor = fetches[0].Get<Tensor>();
+  ASSERT_EQ(tensor.Shape(), TensorShape({3, 2}));
+  for (int64_t i = 0; i < tensor.Shape().Size(); ++i) {
+    const float value = static_cast<float>(i + 1);
+    EXPECT_EQ(tensor.Data<float>()[i], value * value * value * value);
+  }
+
+  EXPECT_FALSE(ComposeEnsemble(members, std::vector<EnsembleEdge>{{"c", "Y", "b", "X"}}, model_proto, model_uri)
+                   .IsOK());
+  EXPECT_FALSE(ComposeEnsemble(members, std::vector<EnsembleEdge>{{"a", "Y", "b", "Z"}}, model_proto, model_uri)
+                   .IsOK());
+  EXPECT_FALSE(ComposeEnsemble(std::vector<EnsembleMember>{{"a", MODEL_URI}, {"a", MODEL_URI}}, {}, model_proto,
+                               model_uri)
+                   .IsOK());
+}
+
+TEST(InferenceSessionTests, StartupTimings) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.StartupTimings";
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load("testdata/matmul_1.onnx"));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  const std::string timings = session_object.GetStartupTimings();
+  EXPECT_THAT(timings, testing::HasSubstr("{\"phase\":\"load\",\"name\":\"\",\"start_us\":0,"));
+  EXPECT_THAT(timings, testing::HasSubstr("\"phase\":\"model_parse\""));
+  EXPECT_THAT(timings, testing::HasSubstr("\"phase\":\"initialize\""));
+  EXPECT_THAT(timings, testing::HasSubstr("\"phase\":\"graph_resolve\""));
+  EXPECT_THAT(timings, testing::HasSubstr("\"phase\":\"graph_transformer\""));
+  EXPECT_THAT(timings, testing::HasSubstr("\"phase\":\"partitioning\""));
+  EXPECT_THAT(timings, testing::HasSubstr("\"phase\":\"kernel_creation\""));
+  EXPECT_THAT(timings, testing::HasSubstr("\"summary\":{"));
+  EXPECT_THAT(timings, testing::HasSubstr("\"total_us\":"));
+}
+
+TEST(InferenceSessionTests, MemoryTimeline) {
+  const std::filesystem::path timeline_dir =
+      std::filesystem::temp_directory_path() /
+      ("ort_memory_timeline_test_" + std::to_string(Env::Default().GetSelfPid()));
+  std::filesystem::remove_all(timeline_dir);
+  std::filesystem::create_directories(timeline_dir);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.MemoryTimeline";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsMemoryTimelineFilePrefix,
+                                                    (timeline_dir / "timeline").string().c_str()));
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  RunModel(session_object, run_options);
+  RunModel(session_object, run_options);
+
+  // only the first Run is recorded by default
+  std::filesystem::path trace_path, report_path;
+  size_t num_files = 0;
+  for (const auto& entry : std::filesystem::directory_iterator(timeline_dir)) {
+    ++num_files;
+    (entry.path().string().find("_peak.txt") != std::string::npos ? report_path : trace_path) = entry.path();
+  }
+  ASSERT_EQ(num_files, 2u);
+  EXPECT_EQ(trace_path.extension(), ".json");
+
+  const auto read_file = [](const std::filesystem::path& path) {
+    std::ifstream file(path);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  };
+  // the output Y of the Mul node, 3x2 floats, is allocated when the node runs
+  const std::string trace = read_file(trace_path);
+  EXPECT_THAT(trace, testing::HasSubstr("\"traceEvents\""));
+  EXPECT_THAT(trace, testing::HasSubstr("\"name\":\"Y\""));
+  EXPECT_THAT(trace, testing::HasSubstr("\"ph\":\"C\""));
+  const std::string report = read_file(report_path);
+  EXPECT_THAT(report, testing::HasSubstr("Memory peaks of Run 0"));
+  EXPECT_THAT(report, testing::HasSubstr("(Mul)"));
+  EXPECT_THAT(report, testing::HasSubstr("output"));
+
+  std::filesystem::remove_all(timeline_dir);
+}
+
+TEST(InferenceSessionTests, TraceSpans) {
+  struct Span {
+    std::string trace_context;
+    uint64_t span_id;
+    uint64_t parent_span_id;
+    std::string name;
+    std::string kind;
+    int64_t start_time_ns;
+    int64_t end_time_ns;
+  };
+  std::mutex mutex;
+  std::vector<Span> spans;
+  const auto sink = [](void* param, const char* trace_context, uint64_t span_id, uint64_t parent_span_id,
+                       const char* name, const char* kind, const char* /*provider*/, int64_t start_time_ns,
+                       int64_t end_time_ns) {
+    auto& [spans_mutex, spans_out] = *static_cast<std::pair<std::mutex&, std::vector<Span>&>*>(param);
+    std::lock_guard<std::mutex> lock(spans_mutex);
+    spans_out.push_back({trace_context, span_id, parent_span_id, name, kind, start_time_ns, end_time_ns});
+  };
+  std::pair<std::mutex&, std::vector<Span>&> sink_param{mutex, spans};
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TraceSpans";
+  so.trace_span_function = sink;
+  so.trace_span_param = &sink_param;
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  const std::string trace_context = "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01";
+  RunOptions run_options;
+  ASSERT_STATUS_OK(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigTraceContext, trace_context.c_str()));
+  RunModel(session_object, run_options);
+  RunModel(session_object, RunOptions{});
+
+  // the CPU EP has neither partitions nor copies, so each Run reports its own span only
+  ASSERT_EQ(spans.size(), 2u);
+  for (const auto& span : spans) {
+    EXPECT_EQ(span.kind, "run");
+    EXPECT_EQ(span.name, so.session_logid);
+    EXPECT_EQ(span.parent_span_id, 0u);
+    EXPECT_LE(span.start_time_ns, span.end_time_ns);
+  }
+  EXPECT_EQ(spans[0].trace_context, trace_context);
+  EXPECT_EQ(spans[1].trace_context, "");
+  EXPECT_NE(spans[0].span_id, spans[1].span_id);
+}
+
 #ifdef ORT_RUN_EXTERNAL_ONNX_TESTS
 static bool Compare(const InputDefList& f_arg, const InputDefList& s_arg) {
   if (f_arg.size() != s_arg.size()) {
@@ -617,6 +1321,87 @@ TEST(InferenceSessionTests, CheckRunLogger) {
 
 // WebAssembly will emit profiling data into console
 #if !defined(__wasm__)
+TEST(InferenceSessionTests, CheckRunProfilerRooflineArgs) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfilerRooflineArgs";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_roofline_test");
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  bool has_kernel_roofline_args = false;
+  bool has_device_peak = false;
+  std::string line;
+  while (std::getline(profile, line)) {
+    // the Mul of two 3x2 float tensors
+    if (line.find("_kernel_time") != string::npos) {
+      EXPECT_THAT(line, testing::HasSubstr("\"flops\" : \"6\""));
+      EXPECT_THAT(line, testing::HasSubstr("\"bytes\" : \"72\""));
+      has_kernel_roofline_args = true;
+    }
+    if (line.find("device_peak") != string::npos) {
+      EXPECT_THAT(line, testing::HasSubstr("fp32_flops_per_cycle_per_core"));
+      has_device_peak = true;
+    }
+  }
+  EXPECT_TRUE(has_kernel_roofline_args);
+  EXPECT_TRUE(has_device_peak);
+}
+
+TEST(InferenceSessionTests, CheckRunProfilerHardwareCounters) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfilerHardwareCounters";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_hardware_counters_test");
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsProfileHardwareCounters,
+                                                    "cycles,instructions"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  // the profile is written without the counters where they can't be opened
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+
+  std::unique_ptr<profiling::HardwareCounters> hardware_counters;
+  std::string warnings;
+  const bool has_counters =
+      profiling::HardwareCounters::Create("cycles,instructions", hardware_counters, warnings).IsOK();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  bool has_kernel_event = false;
+  std::string line;
+  while (std::getline(profile, line)) {
+    if (line.find("_kernel_time") != string::npos) {
+      EXPECT_THAT(line, testing::HasSubstr("\"hw_counters\""));
+      if (has_counters) {
+        EXPECT_THAT(line, testing::HasSubstr("\"instructions\":"));
+      }
+      has_kernel_event = true;
+    }
+  }
+  EXPECT_TRUE(has_kernel_event);
+
+  SessionOptions invalid_so;
+  ASSERT_STATUS_OK(invalid_so.config_options.AddConfigEntry(kOrtSessionOptionsProfileHardwareCounters, "cycles,bogus"));
+  InferenceSession invalid_session{invalid_so, GetEnvironment()};
+  ASSERT_STATUS_OK(invalid_session.Load(MODEL_URI));
+  EXPECT_FALSE(invalid_session.Initialize().IsOK());
+}
+
 TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions) {
   SessionOptions so;
 
@@ -1061,6 +1846,287 @@ TEST(InferenceSessionTests, TestIOBindingReuse) {
   }
 }
 
+TEST(InferenceSessionTests, TestIOBindingRingBufferOutput) {
+  SessionOptions so;
+  InferenceSession session_object(so, GetEnvironment());
+  std::unique_ptr<Model> p_model;
+  CreateMatMulModel(p_model, kCpuExecutionProvider);
+
+  std::string s1;
+  p_model->ToProto().SerializeToString(&s1);
+  std::stringstream sstr(s1);
+  ASSERT_STATUS_OK(session_object.Load(sstr));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  unique_ptr<IOBinding> io_binding;
+  ASSERT_STATUS_OK(session_object.NewIOBinding(&io_binding));
+
+  auto cpu_allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  OrtValue input_a, input_b;
+  CreateMLValue<float>(cpu_allocator, {2, 2}, {1.f, 2.f, 3.f, 4.f}, &input_a);
+  CreateMLValue<float>(cpu_allocator, {2, 2}, {1.f, 0.f, 0.f, 1.f}, &input_b);
+  ASSERT_STATUS_OK(io_binding->BindInput("A", input_a));
+  ASSERT_STATUS_OK(io_binding->BindInput("B", input_b));
+
+  // room for 3 outputs of 4 floats
+  std::vector<float> ring(12, 0.f);
+  size_t next_slot = 0;
+  OutputRingBuffer ring_buffer;
+  ring_buffer.base = ring.data();
+  ring_buffer.capacity_bytes = ring.size() * sizeof(float);
+  ring_buffer.stride_bytes = 4 * sizeof(float);
+  ring_buffer.get_position = [&next_slot](size_t num_bytes) {
+    EXPECT_EQ(num_bytes, 4 * sizeof(float));
+    return next_slot++ % 3;
+  };
+  ASSERT_STATUS_OK(io_binding->BindOutput("Y", std::move(ring_buffer)));
+  ASSERT_FALSE(io_binding->BindOutput("foo", OutputRingBuffer{}).IsOK());
+
+  RunOptions run_options;
+  for (size_t run = 0; run < 4; ++run) {
+    ASSERT_STATUS_OK(session_object.Run(run_options, *io_binding));
+    const auto& y = io_binding->GetOutputs()[0].Get<Tensor>();
+    const size_t slot = run % 3;
+    EXPECT_EQ(y.Data<float>(), ring.data() + slot * 4);
+    VerifyOutputs(y, {2, 2}, {1.f, 2.f, 3.f, 4.f});
+  }
+}
+
+TEST(InferenceSessionTests, TestRunPipeline) {
+  SessionOptions so;
+  InferenceSession session_object(so, GetEnvironment());
+  std::unique_ptr<Model> p_model;
+  CreateMatMulModel(p_model, kCpuExecutionProvider);
+
+  std::string s1;
+  p_model->ToProto().SerializeToString(&s1);
+  std::stringstream sstr(s1);
+  ASSERT_STATUS_OK(session_object.Load(sstr));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunPipeline pipeline(session_object, RunOptions(), {"A", "B"}, {"Y"}, 2);
+  ASSERT_STATUS_OK(pipeline.Initialize());
+  ASSERT_FALSE(pipeline.Submit({}, [](Status, std::vector<OrtValue>&) {}).IsOK());
+
+  auto cpu_allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  constexpr int num_runs = 8;
+  std::vector<float> results;
+  for (int run = 0; run < num_runs; ++run) {
+    // A * (run * I)
+    const float scale = static_cast<float>(run);
+    OrtValue input_a, input_b;
+    CreateMLValue<float>(cpu_allocator, {2, 2}, {1.f, 2.f, 3.f, 4.f}, &input_a);
+    CreateMLValue<float>(cpu_allocator, {2, 2}, {scale, 0.f, 0.f, scale}, &input_b);
+    ASSERT_STATUS_OK(pipeline.Submit({input_a, input_b}, [&results](Status status, std::vector<OrtValue>& outputs) {
+      ASSERT_STATUS_OK(status);
+      ASSERT_EQ(outputs.size(), 1u);
+      // callbacks are invoked one at a time, in submission order
+      results.push_back(outputs[0].Get<Tensor>().Data<float>()[3]);
+    }));
+  }
+  pipeline.Wait();
+
+  ASSERT_EQ(results.size(), static_cast<size_t>(num_runs));
+  for (int run = 0; run < num_runs; ++run) {
+    EXPECT_EQ(results[run], 4.f * run);
+  }
+}
+
+TEST(InferenceSessionTests, TestRequestBatcher) {
+  SessionOptions so;
+  InferenceSession session_object(so, GetEnvironment());
+  std::unique_ptr<Model> p_model;
+  CreateMatMulModel(p_model, kCpuExecutionProvider);
+
+  std::string s1;
+  p_model->ToProto().SerializeToString(&s1);
+  std::stringstream sstr(s1);
+  ASSERT_STATUS_OK(session_object.Load(sstr));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // a batched MatMul of {n, 1, k} and {n, k, 1}. the samples of a batch are independent, and padding k with zeros
+  // doesn't change the results.
+  constexpr int num_requests = 4;
+  std::vector<float> results(num_requests, -1.f);
+  std::vector<int64_t> batch_sizes;
+  {
+    RequestBatcherOptions options;
+    options.max_batch_size = num_requests;
+    options.max_delay = std::chrono::seconds(10);
+    options.padding_buckets = {8};
+    RequestBatcher batcher(session_object, RunOptions(), {"A", "B"}, {"Y"}, options);
+    ASSERT_FALSE(batcher.Submit({}, [](Status, std::vector<OrtValue>&) {}).IsOK());
+
+    auto cpu_allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+    for (int r = 0; r < num_requests; ++r) {
+      // ones dot 1..k
+      const int64_t k = r + 1;
+      std::vector<float> ones(k, 1.f), values(k);
+      std::iota(values.begin(), values.end(), 1.f);
+      OrtValue input_a, input_b;
+      CreateMLValue<float>(cpu_allocator, {1, 1, k}, ones, &input_a);
+      CreateMLValue<float>(cpu_allocator, {1, k, 1}, values, &input_b);
+      ASSERT_STATUS_OK(batcher.Submit({input_a, input_b}, [&, r](Status status, std::vector<OrtValue>& outputs) {
+        ASSERT_STATUS_OK(status);
+        ASSERT_EQ(outputs.size(), 1u);
+        const Tensor& y = outputs[0].Get<Tensor>();
+        batch_sizes.push_back(y.Shape()[0]);
+        results[r] = y.Data<float>()[0];
+      }));
+    }
+    // the batch is full, so it runs long before max_delay. the destructor waits for it.
+  }
+
+  EXPECT_EQ(batch_sizes, std::vector<int64_t>(num_requests, 1));
+  for (int r = 0; r < num_requests; ++r) {
+    const int64_t k = r + 1;
+    EXPECT_EQ(results[r], static_cast<float>(k * (k + 1) / 2));
+  }
+}
+
+TEST(InferenceSessionTests, PipelineSession) {
+  onnxruntime::Model model("graph_1", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  // Y = -(Relu(X + W0) * W1), each weight in its own stage
+  std::vector<NodeArg*> args;
+  for (const char* name : {"X", "A", "B", "C", "Y"}) {
+    args.push_back(&graph.GetOrCreateNodeArg(name, &float_tensor));
+  }
+  const std::vector<float> w0{1.0f, -1.0f}, w1{2.0f, 3.0f};
+  for (const auto& [name, values] : {std::make_pair("W0", w0), std::make_pair("W1", w1)}) {
+    ONNX_NAMESPACE::TensorProto weight;
+    weight.set_name(name);
+    weight.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    weight.add_dims(2);
+    for (float value : values) {
+      weight.add_float_data(value);
+    }
+    graph.AddInitializedTensor(weight);
+  }
+  ONNX_NAMESPACE::TypeProto weight_type;
+  weight_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  weight_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  graph.AddNode("add", "Add", "", {args[0], &graph.GetOrCreateNodeArg("W0", &weight_type)}, {args[1]});
+  graph.AddNode("relu", "Relu", "", {args[1]}, {args[2]});
+  graph.AddNode("mul", "Mul", "", {args[2], &graph.GetOrCreateNodeArg("W1", &weight_type)}, {args[3]});
+  graph.AddNode("neg", "Neg", "", {args[3]}, {args[4]});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  const PathString model_uri = ORT_TSTR("pipeline_session_test.onnx");
+  ASSERT_STATUS_OK(onnxruntime::Model::Save(model, model_uri));
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.PipelineSession";
+  std::vector<std::unique_ptr<IExecutionProvider>> stage_providers;
+  stage_providers.push_back(DefaultCpuExecutionProvider());
+  stage_providers.push_back(DefaultCpuExecutionProvider());
+  PipelineSessionOptions options;
+  options.num_micro_batches = 2;
+  std::unique_ptr<PipelineSession> pipeline_session;
+  ASSERT_STATUS_OK(PipelineSession::Create(so, GetEnvironment(), model_uri, std::move(stage_providers), options,
+                                           pipeline_session));
+  std::filesystem::remove(model_uri);
+
+  ASSERT_EQ(pipeline_session->NumStages(), 2u);
+  EXPECT_EQ(pipeline_session->GetStageSession(0).GetSessionState().GetGraphViewer().NumberOfNodes(), 2);
+  EXPECT_EQ(pipeline_session->GetStageSession(1).GetSessionState().GetGraphViewer().NumberOfNodes(), 2);
+
+  const std::vector<int64_t> dims{5, 2};
+  std::vector<float> values(10), expected_values;
+  std::iota(values.begin(), values.end(), -5.0f);
+  for (size_t i = 0; i < values.size(); ++i) {
+    expected_values.push_back(-std::max(values[i] + w0[i % 2], 0.0f) * w1[i % 2]);
+  }
+
+  OrtValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims, values, &ml_value);
+  const std::vector<std::string> feed_names{"X"}, output_names{"Y"};
+  const std::vector<OrtValue> feeds{ml_value};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(pipeline_session->Run(RunOptions(), feed_names, feeds, output_names, fetches));
+  ASSERT_EQ(1u, fetches.size());
+  const auto& y = fetches.front().Get<Tensor>();
+  ASSERT_EQ(TensorShape(dims), y.Shape());
+  for (size_t i = 0; i < expected_values.size(); ++i) {
+    EXPECT_EQ(expected_values[i], y.Data<float>()[i]);
+  }
+
+  const std::vector<std::string> invalid_output_names{"B"};
+  ASSERT_FALSE(pipeline_session->Run(RunOptions(), feed_names, feeds, invalid_output_names, fetches).IsOK());
+}
+
+TEST(InferenceSessionTests, DevicePoolSession) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.DevicePoolSession";
+  std::vector<std::unique_ptr<IExecutionProvider>> replica_providers;
+  replica_providers.push_back(DefaultCpuExecutionProvider());
+  replica_providers.push_back(DefaultCpuExecutionProvider());
+  std::unique_ptr<DevicePoolSession> device_pool_session;
+  ASSERT_STATUS_OK(DevicePoolSession::Create(so, GetEnvironment(), MODEL_URI, std::move(replica_providers),
+                                             DevicePoolSessionOptions(), device_pool_session));
+  ASSERT_EQ(device_pool_session->NumReplicas(), 2u);
+
+  OrtValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {3, 2},
+                       {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &ml_value);
+  const std::vector<std::string> feed_names{"X"}, output_names{"Y"};
+  const std::vector<OrtValue> feeds{ml_value};
+
+  // more runs than replicas at once, so that some of them wait for a replica
+  constexpr int num_threads = 4, num_runs_per_thread = 3;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < num_runs_per_thread; ++i) {
+        std::vector<OrtValue> fetches;
+        ASSERT_STATUS_OK(device_pool_session->Run(RunOptions(), feed_names, feeds, output_names, fetches));
+        VerifyOutputs(fetches, {3, 2}, {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f});
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  uint64_t completed_runs = 0;
+  for (size_t r = 0; r < device_pool_session->NumReplicas(); ++r) {
+    const auto metrics = device_pool_session->GetReplicaMetrics(r);
+    EXPECT_EQ(metrics.in_flight_runs, 0u);
+    EXPECT_EQ(metrics.failed_runs, 0u);
+    EXPECT_GT(metrics.completed_runs, 0u);
+    completed_runs += metrics.completed_runs;
+  }
+  EXPECT_EQ(completed_runs, static_cast<uint64_t>(num_threads * num_runs_per_thread));
+  EXPECT_EQ(device_pool_session->NumQueuedRuns(), 0u);
+
+  std::vector<OrtValue> fetches;
+  const std::vector<std::string> invalid_output_names{"Z"};
+  ASSERT_FALSE(device_pool_session->Run(RunOptions(), feed_names, feeds, invalid_output_names, fetches).IsOK());
+  EXPECT_EQ(device_pool_session->GetReplicaMetrics(0).failed_runs +
+                device_pool_session->GetReplicaMetrics(1).failed_runs,
+            1u);
+}
+
+TEST(InferenceSessionTests, WarmupSession) {
+  SessionOptions so;
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  WarmupReport report;
+  ASSERT_STATUS_OK(WarmupSession(session_object, RunOptions(), {{}, {{"X", {3, 2}}}}, report));
+  ASSERT_EQ(report.profiles.size(), 2u);
+  EXPECT_GE(report.total, report.profiles[0].first_run + report.profiles[1].first_run);
+
+  ASSERT_FALSE(WarmupSession(session_object, RunOptions(), {{{"Z", {1}}}}, report).IsOK());
+}
+
 TEST(InferenceSessionTests, InvalidInputTypeOfTensorElement) {
   SessionOptions so;
 
@@ -2220,6 +3286,162 @@ TEST(InferenceSessionTests, TestArenaShrinkageAfterRun) {
   ASSERT_EQ(allocated_memory_before_run, allocated_memory_after_run);
 }
 
+// Celu has no CUDA kernel, so the model can't be captured as a whole and the CUDA nodes around it are captured
+// in segments instead.
+TEST(InferenceSessionTests, CudaGraphSegmentCapture) {
+  onnxruntime::Model model("graph_1", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  std::vector<NodeArg*> args;
+  for (const char* name : {"X", "A", "B", "C", "D", "Y"}) {
+    args.push_back(&graph.GetOrCreateNodeArg(name, &float_tensor));
+  }
+  const std::vector<std::string> op_types{"Neg", "Neg", "Celu", "Neg", "Neg"};
+  for (size_t i = 0; i < op_types.size(); ++i) {
+    graph.AddNode("node_" + std::to_string(i), op_types[i], "", {args[i]}, {args[i + 1]});
+  }
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_str;
+  model.ToProto().SerializeToString(&model_str);
+  std::stringstream model_stream(model_str);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.CudaGraphSegmentCapture";
+  InferenceSession session_object{so, GetEnvironment()};
+
+  OrtCUDAProviderOptionsV2 cuda_options{};
+  cuda_options.enable_cuda_graph = 1;
+  ASSERT_STATUS_OK(session_object.RegisterExecutionProvider(CudaExecutionProviderWithOptions(&cuda_options)));
+  ASSERT_STATUS_OK(session_object.Load(model_stream));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  const std::vector<std::string> output_names{"Y"};
+  const std::vector<int64_t> dims{3, 2};
+
+  // the first runs execute the segments as usual, the next one captures them and the later ones replay them
+  for (int i = 1; i <= 5; ++i) {
+    std::vector<float> values{-3.0f, -2.0f, -1.0f, 1.0f, 2.0f, 3.0f};
+    std::vector<float> expected_values;
+    for (auto& value : values) {
+      value *= static_cast<float>(i);
+      expected_values.push_back(value > 0.0f ? value : std::expm1(value));
+    }
+
+    OrtValue ml_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims, values, &ml_value);
+    NameMLValMap feeds{{"X", ml_value}};
+
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(run_options, feeds, output_names, &fetches));
+    ASSERT_EQ(1u, fetches.size());
+    const auto& y = fetches.front().Get<Tensor>();
+    ASSERT_EQ(TensorShape(dims), y.Shape());
+    for (size_t j = 0; j < expected_values.size(); ++j) {
+      EXPECT_NEAR(expected_values[j], y.Data<float>()[j], 1e-5f);
+    }
+  }
+}
+
+TEST(InferenceSessionTests, CudaWeightStreaming) {
+  // a chain of MatMuls with weights of 1 MiB each
+  constexpr int64_t dim = 512;
+  constexpr int num_layers = 4;
+  onnxruntime::Model model("graph_1", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 13}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto activation_type;
+  activation_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  activation_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  activation_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+  ONNX_NAMESPACE::TypeProto weight_type;
+  weight_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  weight_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+  weight_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+
+  NodeArg* input = &graph.GetOrCreateNodeArg("X", &activation_type);
+  for (int layer = 0; layer < num_layers; ++layer) {
+    const std::string weight_name = "W" + std::to_string(layer);
+    ONNX_NAMESPACE::TensorProto weight;
+    weight.set_name(weight_name);
+    weight.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    weight.add_dims(dim);
+    weight.add_dims(dim);
+    for (int64_t i = 0; i < dim * dim; ++i) {
+      weight.add_float_data(static_cast<float>((i * 31 + layer) % 17 - 8) / 256.0f);
+    }
+    graph.AddInitializedTensor(weight);
+
+    NodeArg* output = &graph.GetOrCreateNodeArg(layer + 1 == num_layers ? "Y" : "H" + std::to_string(layer),
+                                                &activation_type);
+    graph.AddNode("matmul_" + std::to_string(layer), "MatMul", "",
+                  {input, &graph.GetOrCreateNodeArg(weight_name, &weight_type)}, {output});
+    input = output;
+  }
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_str;
+  model.ToProto().SerializeToString(&model_str);
+
+  std::vector<float> values(2 * dim);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<float>(static_cast<int>(i % 5) - 2) / 4.0f;
+  }
+  OrtValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {2, dim}, values, &ml_value);
+  NameMLValMap feeds{{"X", ml_value}};
+  const std::vector<std::string> output_names{"Y"};
+
+  // the budget keeps the first weight on the device and streams the others
+  std::vector<float> expected_values;
+  for (size_t budget : {size_t{0}, static_cast<size_t>(dim * dim * sizeof(float) * 3 / 2)}) {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.CudaWeightStreaming";
+    InferenceSession session_object{so, GetEnvironment()};
+
+    OrtCUDAProviderOptionsV2 cuda_options{};
+    cuda_options.weight_streaming_budget = budget;
+    ASSERT_STATUS_OK(session_object.RegisterExecutionProvider(CudaExecutionProviderWithOptions(&cuda_options)));
+    std::stringstream model_stream(model_str);
+    ASSERT_STATUS_OK(session_object.Load(model_stream));
+    ASSERT_STATUS_OK(session_object.Initialize());
+
+    const auto* weight_streamer = session_object.GetSessionState().GetWeightStreamer();
+    if (budget == 0) {
+      ASSERT_EQ(weight_streamer, nullptr);
+    } else {
+      ASSERT_NE(weight_streamer, nullptr);
+      EXPECT_EQ(weight_streamer->NumStreamedInitializers(), static_cast<size_t>(num_layers - 1));
+    }
+
+    // the later runs reuse the copy streams of the first one
+    for (int run = 0; run < 2; ++run) {
+      std::vector<OrtValue> fetches;
+      ASSERT_STATUS_OK(session_object.Run(RunOptions(), feeds, output_names, &fetches));
+      ASSERT_EQ(1u, fetches.size());
+      const auto& y = fetches.front().Get<Tensor>();
+      const auto y_values = y.DataAsSpan<float>();
+      if (expected_values.empty()) {
+        expected_values.assign(y_values.begin(), y_values.end());
+        continue;
+      }
+      ASSERT_EQ(expected_values.size(), y_values.size());
+      for (size_t i = 0; i < expected_values.size(); ++i) {
+        EXPECT_NEAR(expected_values[i], y_values[i], 1e-5f * (1.0f + std::abs(expected_values[i])));
+      }
+    }
+  }
+}
+
 #endif
 
 // The model being tested here triggers a case where the allocation planner (AP) tries to reuse a tensor of type
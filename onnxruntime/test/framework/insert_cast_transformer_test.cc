@@ -32,8 +32,8 @@ TEST(TransformerTest, InsertCastGPUTest) {
       o2_def("O2", &tensor_float_16),
       o3_def("O3", &tensor_float_16);
 
-  auto& node1 = graph.AddNode("node1", "MatMul", "cpu operator1", ArgMap{&i1_def, &i2_def}, ArgMap{&o1_def});
-  auto& node2 = graph.AddNode("node2", "MatMul", "gpu operator1", ArgMap{&o1_def, &i3_def}, ArgMap{&o2_def});
+  auto& node1 = graph.AddNode("node1", "Sub", "cpu operator1", ArgMap{&i1_def, &i2_def}, ArgMap{&o1_def});
+  auto& node2 = graph.AddNode("node2", "Sub", "gpu operator1", ArgMap{&o1_def, &i3_def}, ArgMap{&o2_def});
   node2.SetExecutionProviderType(onnxruntime::kCudaExecutionProvider);
   auto& node3 = graph.AddNode("node3", "Clip", "cpu operator2", ArgMap{&o2_def}, ArgMap{&o3_def});
 
@@ -80,8 +80,8 @@ TEST(TransformerTest, InsertCastAllCPUTest) {
       o2_def("O2", &tensor_float_16),
       o3_def("O3", &tensor_float_16);
 
-  auto& node1 = graph.AddNode("node1", "MatMul", "cpu operator1", ArgMap{&i1_def, &i2_def}, ArgMap{&o1_def});
-  auto& node2 = graph.AddNode("node2", "MatMul", "gpu operator1", ArgMap{&o1_def, &i3_def}, ArgMap{&o2_def});
+  auto& node1 = graph.AddNode("node1", "Sub", "cpu operator1", ArgMap{&i1_def, &i2_def}, ArgMap{&o1_def});
+  auto& node2 = graph.AddNode("node2", "Sub", "gpu operator1", ArgMap{&o1_def, &i3_def}, ArgMap{&o2_def});
   auto& node3 = graph.AddNode("node3", "Clip", "cpu operator2", ArgMap{&o2_def}, ArgMap{&o3_def});
 
   auto status = graph.Resolve();
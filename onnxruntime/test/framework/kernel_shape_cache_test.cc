@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/kernel_shape_cache.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+using Cache = KernelShapeCache<std::vector<int64_t>>;
+
+static Cache::Key MakeKey(const std::vector<int64_t>& dims, const std::vector<int64_t>& values) {
+  Cache::Key key;
+  Cache::AppendToKey(dims, key);
+  Cache::AppendToKey(values, key);
+  return key;
+}
+
+TEST(KernelShapeCacheTest, FindInserted) {
+  Cache cache;
+  std::vector<int64_t> value;
+  EXPECT_FALSE(cache.Find(MakeKey({2, 3}, {1}), value));
+
+  cache.Insert(MakeKey({2, 3}, {1}), {2, 1});
+  ASSERT_TRUE(cache.Find(MakeKey({2, 3}, {1}), value));
+  EXPECT_EQ(value, (std::vector<int64_t>{2, 1}));
+
+  // the counts tell the inputs apart
+  EXPECT_FALSE(cache.Find(MakeKey({2}, {3, 1}), value));
+  EXPECT_FALSE(cache.Find(MakeKey({2, 3}, {2}), value));
+
+  // the first insertion of a key is kept
+  cache.Insert(MakeKey({2, 3}, {1}), {4});
+  ASSERT_TRUE(cache.Find(MakeKey({2, 3}, {1}), value));
+  EXPECT_EQ(value, (std::vector<int64_t>{2, 1}));
+}
+
+TEST(KernelShapeCacheTest, EvictOldest) {
+  Cache cache;
+  for (int64_t i = 0; i <= static_cast<int64_t>(Cache::kMaxEntries); ++i) {
+    cache.Insert(MakeKey({i}, {}), {i});
+  }
+
+  std::vector<int64_t> value;
+  EXPECT_FALSE(cache.Find(MakeKey({0}, {}), value));
+  for (int64_t i = 1; i <= static_cast<int64_t>(Cache::kMaxEntries); ++i) {
+    ASSERT_TRUE(cache.Find(MakeKey({i}, {}), value));
+    EXPECT_EQ(value, (std::vector<int64_t>{i}));
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -322,6 +322,129 @@ TEST(OrtModelOnlyTests, SerializeToOrtFormat) {
   RunOrtModel(test_info);
 }
 
+// X -> Abs -> T -> Neg -> Y with every value of shape {2, 3}, so T is placed by the static memory plan
+static void CreateStaticShapeModel(const PathString& model_path) {
+  onnxruntime::Model model("static_shape", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 13}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& t = graph.GetOrCreateNodeArg("T", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("abs", "Abs", "", {&x}, {&t});
+  graph.AddNode("neg", "Neg", "", {&t}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+  ASSERT_STATUS_OK(Model::Save(model, model_path));
+}
+
+TEST(OrtModelOnlyTests, SerializeStaticMemoryPlan) {
+  const auto onnx_file = ORT_TSTR("static_memory_plan.test_output.onnx");
+  const auto ort_file = ORT_TSTR("static_memory_plan.test_output.ort");
+  CreateStaticShapeModel(onnx_file);
+
+  {
+    SessionOptions so;
+    so.session_logid = "SerializeStaticMemoryPlan";
+    so.optimized_model_filepath = ort_file;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsSaveStaticMemoryPlan, "1"));
+    InferenceSessionWrapper session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(onnx_file));
+    ASSERT_STATUS_OK(session_object.Initialize());
+  }
+
+  // the plan is saved in the ORT format model
+  size_t num_bytes = 0;
+  ASSERT_STATUS_OK(Env::Default().GetFileLength(ort_file, num_bytes));
+  std::vector<uint8_t> bytes(num_bytes);
+  std::ifstream bytes_stream(ort_file, std::ifstream::in | std::ifstream::binary);
+  bytes_stream.read(reinterpret_cast<char*>(bytes.data()), num_bytes);
+  bytes_stream.close();
+
+  flatbuffers::Verifier verifier(bytes.data(), bytes.size());
+  ASSERT_TRUE(fbs::VerifyInferenceSessionBuffer(verifier));
+  const auto* fbs_static_memory_plan = fbs::GetInferenceSession(bytes.data())->static_memory_plan();
+  ASSERT_NE(fbs_static_memory_plan, nullptr);
+  ASSERT_EQ(fbs_static_memory_plan->inputs()->size(), 1u);
+  ASSERT_EQ(fbs_static_memory_plan->buffers()->size(), 1u);
+
+  // and used as the memory pattern for the recorded input shape when loaded
+  SessionOptions so;
+  so.session_logid = "LoadStaticMemoryPlan";
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(ort_file));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  OrtValue x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {2, 3},
+                       {-1.f, 2.f, -3.f, 4.f, -5.f, 6.f}, &x);
+
+  const auto& session_state = session_object.GetSessionState();
+  int x_idx, t_idx;
+  ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx("X", x_idx));
+  ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx("T", t_idx));
+  std::vector<OrtValue> inputs{x};
+  std::vector<int> input_idxs{x_idx};
+  auto entry = session_state.GetMemoryPatternGroup(inputs, input_idxs);
+  ASSERT_NE(entry, nullptr);
+  const auto* pattern = entry->patterns.GetPatterns(OrtDevice());
+  ASSERT_NE(pattern, nullptr);
+  ASSERT_NE(pattern->GetBlock(t_idx), nullptr);
+
+  NameMLValMap feeds{{"X", x}};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object.Run(feeds, {"Y"}, &fetches));
+  const auto& output = fetches[0].Get<Tensor>();
+  EXPECT_THAT(output.DataAsSpan<float>(), ::testing::ElementsAre(-1.f, -2.f, -3.f, -4.f, -5.f, -6.f));
+}
+
+TEST(OrtModelOnlyTests, SerializeSessionSnapshot) {
+  const auto onnx_file = ORT_TSTR("session_snapshot.test_output.onnx");
+  const auto ort_file = ORT_TSTR("session_snapshot.test_output.ort");
+  CreateStaticShapeModel(onnx_file);
+
+  {
+    SessionOptions so;
+    so.session_logid = "SerializeSessionSnapshot";
+    so.optimized_model_filepath = ort_file;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsSaveSessionSnapshot, "1"));
+    InferenceSessionWrapper session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(onnx_file));
+    ASSERT_STATUS_OK(session_object.Initialize());
+  }
+
+  // the snapshot has a static memory plan and names the pre-packed weights file
+  size_t num_bytes = 0;
+  ASSERT_STATUS_OK(Env::Default().GetFileLength(ort_file, num_bytes));
+  std::vector<uint8_t> bytes(num_bytes);
+  std::ifstream bytes_stream(ort_file, std::ifstream::in | std::ifstream::binary);
+  bytes_stream.read(reinterpret_cast<char*>(bytes.data()), num_bytes);
+  bytes_stream.close();
+
+  flatbuffers::Verifier verifier(bytes.data(), bytes.size());
+  ASSERT_TRUE(fbs::VerifyInferenceSessionBuffer(verifier));
+  const auto* fbs_session = fbs::GetInferenceSession(bytes.data());
+  ASSERT_NE(fbs_session->static_memory_plan(), nullptr);
+  ASSERT_NE(fbs_session->prepacked_weights_file(), nullptr);
+  EXPECT_EQ(fbs_session->prepacked_weights_file()->str(), "session_snapshot.test_output.ort.prepacked");
+
+  // a session created from the snapshot uses the file next to the model
+  SessionOptions so;
+  so.session_logid = "LoadSessionSnapshot";
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(ort_file));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  const auto prepacked_weights_file =
+      session_object.GetSessionOptions().config_options.GetConfigEntry(kOrtSessionOptionsConfigPrepackedWeightsFile);
+  ASSERT_TRUE(prepacked_weights_file.has_value());
+  EXPECT_THAT(*prepacked_weights_file, ::testing::EndsWith("session_snapshot.test_output.ort.prepacked"));
+}
+
 TEST(OrtModelOnlyTests, SparseInitializerHandling) {
   const auto ort_file = ORT_TSTR("testdata/ort_minimal_test_models/sparse_initializer_handling.onnx.test_output.ort");
   SaveAndCompareModels(ORT_TSTR("testdata/ort_minimal_test_models/sparse_initializer_handling.onnx"), ort_file);
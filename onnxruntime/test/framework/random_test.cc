@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <vector>
+
 #include "core/framework/random_seed.h"
 #include "core/framework/random_generator.h"
 #include "gtest/gtest.h"
@@ -54,5 +56,32 @@ TEST(RandomTest, PhiloxGeneratorTest) {
   ASSERT_EQ(seeds.second, 0u);
 }
 
+TEST(RandomTest, PhiloxEngineTest) {
+  // known answers of Philox_4x32_10 from the Random123 library
+  uint32_t output[PhiloxEngine::kNumOutputs];
+  PhiloxEngine::Generate(0, 0, 0, 1, output);
+  ASSERT_EQ(output[0], 0x6627e8d5u);
+  ASSERT_EQ(output[1], 0xe169c58du);
+  ASSERT_EQ(output[2], 0xbc57ac4cu);
+  ASSERT_EQ(output[3], 0x9b00dbd8u);
+
+  PhiloxEngine::Generate(0x299f31d0a4093822u, 0x0370734413198a2eu, 0x85a308d3243f6a88u, 1, output);
+  ASSERT_EQ(output[0], 0xd16cfe09u);
+  ASSERT_EQ(output[1], 0x94fdccebu);
+  ASSERT_EQ(output[2], 0x5001e420u);
+  ASSERT_EQ(output[3], 0x24126ea1u);
+
+  // a range of counters generates the same numbers as its counters one at a time
+  constexpr size_t count = 37;
+  std::vector<uint32_t> range_output(count * PhiloxEngine::kNumOutputs);
+  PhiloxEngine::Generate(17, 0, 5, count, range_output.data());
+  for (size_t i = 0; i < count; ++i) {
+    PhiloxEngine::Generate(17, 0, 5 + i, 1, output);
+    for (size_t j = 0; j < PhiloxEngine::kNumOutputs; ++j) {
+      ASSERT_EQ(range_output[i * PhiloxEngine::kNumOutputs + j], output[j]);
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
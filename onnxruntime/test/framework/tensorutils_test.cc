@@ -191,6 +191,32 @@ TEST(TensorProtoUtilsTest, UnpackTensorWithExternalData) {
   TestUnpackExternalTensor<bool>(TensorProto_DataType_BOOL, model_path);
 }
 
+TEST(TensorProtoUtilsTest, GetExternalDataLocation) {
+  std::basic_string<ORTCHAR_T> filename(ORT_TSTR("tensor_XXXXXX"));
+  TensorProto tensor_proto;
+  const std::vector<float> test_data = CreateValues<float>();
+  CreateTensorWithExternalData<float>(TensorProto_DataType_FLOAT, test_data, filename, tensor_proto);
+  std::unique_ptr<ORTCHAR_T, decltype(&DeleteFileFromDisk)> file_deleter(const_cast<ORTCHAR_T*>(filename.c_str()),
+                                                                         DeleteFileFromDisk);
+
+  std::basic_string<ORTCHAR_T> external_file_path;
+  FileOffsetType file_offset = -1;
+  SafeInt<size_t> ext_data_len = 0;
+  ASSERT_STATUS_OK(utils::GetExternalDataLocation(Env::Default(), nullptr, tensor_proto, external_file_path,
+                                                  file_offset, ext_data_len));
+  EXPECT_EQ(external_file_path, filename);
+  EXPECT_EQ(file_offset, 0);
+  EXPECT_EQ(static_cast<size_t>(ext_data_len), test_data.size() * sizeof(float));
+
+  // a range past the end of the file is rejected
+  onnx::StringStringEntryProto* offset = tensor_proto.mutable_external_data()->Add();
+  offset->set_key("offset");
+  offset->set_value("4");
+  EXPECT_FALSE(utils::GetExternalDataLocation(Env::Default(), nullptr, tensor_proto, external_file_path,
+                                              file_offset, ext_data_len)
+                   .IsOK());
+}
+
 template <typename T>
 static NodeProto CreateConstantNode(const std::string& attrib_name, AttributeProto_AttributeType type,
                                     std::function<void(AttributeProto&)> add_data) {
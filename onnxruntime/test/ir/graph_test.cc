@@ -930,6 +930,68 @@ TEST_F(GraphTest, GraphConstruction_PriorityBasedTopologicalSort_CompressDecompr
   }
 }
 
+TEST_F(GraphTest, GraphConstruction_MemoryEfficientTopologicalSort) {
+  Model model("graph_1", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  /*
+                          |
+           expand_0 (big)   expand_1 (big)
+                |                 |
+           reduce_0 (small) reduce_1 (small)
+                      \       /
+                      merge
+                          |
+  */
+
+  TypeProto small_tensor;
+  small_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT32);
+  small_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  TypeProto big_tensor;
+  big_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT32);
+  big_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1000);
+
+  auto& input = graph.GetOrCreateNodeArg("input", &small_tensor);
+  auto& big_0 = graph.GetOrCreateNodeArg("big_0", &big_tensor);
+  auto& big_1 = graph.GetOrCreateNodeArg("big_1", &big_tensor);
+  auto& small_0 = graph.GetOrCreateNodeArg("small_0", &small_tensor);
+  auto& small_1 = graph.GetOrCreateNodeArg("small_1", &small_tensor);
+  auto& output = graph.GetOrCreateNodeArg("output", &small_tensor);
+
+  auto& expand_0 = graph.AddNode("expand_0", "Identity_Fake", "expand 0", {&input}, {&big_0});
+  auto& expand_1 = graph.AddNode("expand_1", "Identity_Fake", "expand 1", {&input}, {&big_1});
+  auto& reduce_0 = graph.AddNode("reduce_0", "Identity_Fake", "reduce 0", {&big_0}, {&small_0});
+  auto& reduce_1 = graph.AddNode("reduce_1", "Identity_Fake", "reduce 1", {&big_1}, {&small_1});
+  auto& merge = graph.AddNode("merge", "Merge_Fake", "merge", {&small_0, &small_1}, {&output});
+
+  auto status = graph.Resolve();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  GraphViewer graph_viewer(graph);
+
+  // running both expands first keeps both big tensors alive
+  const std::vector<NodeIndex> breadth_first_order = {expand_0.Index(), expand_1.Index(), reduce_0.Index(),
+                                                      reduce_1.Index(), merge.Index()};
+  EXPECT_EQ(graph_viewer.EstimatePeakMemoryUsage(breadth_first_order), 8004u);
+
+  // the memory efficient order reduces each big tensor before creating the next
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder(ExecutionOrder::MEMORY_EFFICIENT);
+  ASSERT_EQ(order.size(), 5u);
+  EXPECT_EQ(graph_viewer.EstimatePeakMemoryUsage(order), 4008u);
+  EXPECT_EQ(order.back(), merge.Index());
+
+  InlinedHashSet<NodeIndex> seen;
+  for (auto node_index : order) {
+    for (auto it = graph.GetNode(node_index)->InputNodesBegin(); it != graph.GetNode(node_index)->InputNodesEnd();
+         ++it) {
+      EXPECT_TRUE(seen.count(it->Index()) == 1) << "Memory efficient order is not a topological order.";
+    }
+    seen.insert(node_index);
+  }
+
+  EXPECT_LE(graph_viewer.EstimatePeakMemoryUsage(order),
+            graph_viewer.EstimatePeakMemoryUsage(graph_viewer.GetNodesInTopologicalOrder()));
+}
+
 TEST_F(GraphTest, GraphConstruction_PriorityBasedTopologicalSort_CompressDecompress_Nested) {
   Model model("graph_1", false, *logger_);
   auto& graph = model.MainGraph();
@@ -1509,6 +1571,52 @@ TEST_F(GraphTest, ShapeInferenceErrorHandling) {
                                                         "[ShapeInferenceError] try harder"));
 }
 
+TEST_F(GraphTest, ResolveInfersChangedNodesOnly) {
+  static int num_inferences = 0;
+  OPERATOR_SCHEMA(CountedIdentity_Fake)
+      .SetDoc("Identity that counts its type and shape inferencing.")
+      .Attr("alpha", "unused", AttributeProto::INT, static_cast<int64_t>(0))
+      .Input(0, "input_1", "docstr for input_1.", "tensor(int32)")
+      .Output(0, "output_1", "docstr for output_1.", "tensor(int32)")
+      .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
+        ++num_inferences;
+        propagateShapeAndTypeFromFirstInput(ctx);
+      });
+
+  Model model("graph", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_int32;
+  tensor_int32.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT32);
+
+  auto& x = graph.GetOrCreateNodeArg("x", &tensor_int32);
+  auto& a = graph.GetOrCreateNodeArg("a", nullptr);
+  auto& b = graph.GetOrCreateNodeArg("b", nullptr);
+  auto& c = graph.GetOrCreateNodeArg("c", nullptr);
+  auto& node_1 = graph.AddNode("node_1", "CountedIdentity_Fake", "node 1", {&x}, {&a});
+  auto& node_2 = graph.AddNode("node_2", "CountedIdentity_Fake", "node 2", {&a}, {&b});
+  graph.AddNode("node_3", "CountedIdentity_Fake", "node 3", {&b}, {&c});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(num_inferences, 3);
+
+  // the output of node_2 is inferred as it was, so node_3 is not inferred again
+  node_2.AddAttribute("alpha", static_cast<int64_t>(1));
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(num_inferences, 4);
+
+  // the shape of the input is inferred down to the graph output
+  TensorShapeProto shape;
+  shape.add_dim()->set_dim_value(2);
+  x.SetShape(shape);
+  node_1.AddAttribute("alpha", static_cast<int64_t>(1));
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(num_inferences, 7);
+  ASSERT_NE(c.Shape(), nullptr);
+  ASSERT_EQ(c.Shape()->dim_size(), 1);
+  EXPECT_EQ(c.Shape()->dim(0).dim_value(), 2);
+}
+
 TEST_F(GraphTest, AddTensorAttribute) {
   OPERATOR_SCHEMA(__Constant)
       .SetDoc("Constant Op.")
@@ -3,6 +3,8 @@
 
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <memory>
+#include <numeric>
+#include "core/framework/tensorprotoutils.h"
 #include "core/platform/env.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
@@ -178,6 +180,63 @@ TEST_F(ONNXModelsTest, TestIRv4NonInputInitializers) {
   ASSERT_STATUS_OK(model->MainGraph().Resolve());
 }
 
+TEST_F(ONNXModelsTest, LoadReferencingInitializerData) {
+  ModelProto model_proto;
+  model_proto.set_ir_version(ONNX_NAMESPACE::Version::IR_VERSION);
+  model_proto.add_opset_import()->set_version(13);
+  GraphProto& graph_proto = *model_proto.mutable_graph();
+  graph_proto.set_name("graph");
+
+  // raw data below and above the size that is referenced in place
+  const auto add_initializer = [&graph_proto](const std::string& name, size_t num_elements) {
+    TensorProto& tensor_proto = *graph_proto.add_initializer();
+    tensor_proto.set_name(name);
+    tensor_proto.set_data_type(TensorProto_DataType_FLOAT);
+    tensor_proto.add_dims(static_cast<int64_t>(num_elements));
+    std::vector<float> data(num_elements);
+    std::iota(data.begin(), data.end(), 0.f);
+    tensor_proto.set_raw_data(data.data(), data.size() * sizeof(float));
+  };
+  add_initializer("small", 4);
+  add_initializer("large", 64);
+  NodeProto& node = *graph_proto.add_node();
+  node.set_op_type("Add");
+  node.add_input("small");
+  node.add_input("large");
+  node.add_output("sum");
+
+  const std::string bytes = model_proto.SerializeAsString();
+  ModelProto loaded;
+  ASSERT_STATUS_OK(Model::LoadReferencingInitializerData(
+      gsl::make_span(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size()), loaded));
+
+  EXPECT_EQ(loaded.ir_version(), model_proto.ir_version());
+  EXPECT_EQ(loaded.graph().name(), "graph");
+  ASSERT_EQ(loaded.graph().node_size(), 1);
+  ASSERT_EQ(loaded.graph().initializer_size(), 2);
+
+  const TensorProto& small = loaded.graph().initializer(0);
+  EXPECT_EQ(small.name(), "small");
+  EXPECT_FALSE(utils::HasExternalData(small));
+  EXPECT_EQ(small.raw_data(), model_proto.graph().initializer(0).raw_data());
+
+  const TensorProto& large = loaded.graph().initializer(1);
+  EXPECT_EQ(large.name(), "large");
+  ASSERT_TRUE(utils::HasExternalData(large));
+  std::vector<uint8_t> unpacked;
+  ASSERT_STATUS_OK(utils::UnpackInitializerData(large, Path(), unpacked));
+  const std::string& expected = model_proto.graph().initializer(1).raw_data();
+  ASSERT_EQ(unpacked.size(), expected.size());
+  EXPECT_TRUE(std::equal(unpacked.begin(), unpacked.end(), expected.begin(),
+                         [](uint8_t a, char b) { return a == static_cast<uint8_t>(b); }));
+
+  // truncated bytes are an error
+  ModelProto truncated;
+  EXPECT_FALSE(Model::LoadReferencingInitializerData(
+                   gsl::make_span(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size() - 10), truncated)
+                   .IsOK());
+}
+
 // test a model that has an op with a FunctionBody and one of the nodes within the FunctionBody has a subgraph in it.
 // The test model has is an opset-11 op with a 'Range' node.
 // 'Range' has a FunctionBody and has a 'Loop' node with a subgraph.
@@ -3,4 +3,17 @@
 
 #include <benchmark/benchmark.h>
 
-BENCHMARK_MAIN();
+#include "mlas.h"
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  // the kernels selected for the processor, so that compare_baseline.py of the kernel explorer reports a dispatch
+  // change instead of a mere slowdown
+  ::benchmark::AddCustomContext("mlas_kernel_isa", MlasGetKernelIsa());
+  ::benchmark::RunSpecifiedBenchmarks();
+  ::benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+#include "core/util/thread_utils.h"
+
+#include <stdexcept>
+
+static const std::vector<std::string> softmax_bench_arg_names = {"N", "D", "Threads"};
+
+void SOFTMAX(benchmark::State& state, bool log_softmax) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("D must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+  const size_t D = static_cast<size_t>(state.range(1));
+  const int threads = static_cast<int>(state.range(2));
+
+  auto X = RandomVectorUniform(N * D, -10.0f, 10.0f);
+  std::vector<float> Y(N * D);
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = threads;
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> tp(
+      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                                 tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+
+  MlasComputeSoftmax(X.data(), Y.data(), N, D, log_softmax, tp.get());
+  for (auto _ : state) {
+    MlasComputeSoftmax(X.data(), Y.data(), N, D, log_softmax, tp.get());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * N * D * 2 * sizeof(float)));
+}
+
+template <void(MLASCALL* Activation)(const float*, float*, size_t)>
+void ACTIVATION(benchmark::State& state) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+
+  auto X = RandomVectorUniform(N, -10.0f, 10.0f);
+  std::vector<float> Y(N);
+
+  for (auto _ : state) {
+    Activation(X.data(), Y.data(), N);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * N * 2 * sizeof(float)));
+}
+
+static void SoftmaxSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames(softmax_bench_arg_names);
+  // attention scores of BERT-like models, and the logits of a vocabulary
+  ArgsProduct(b, {{1536, 12288}, {128, 384}, {1, 8}});
+  ArgsProduct(b, {{1, 16}, {32000}, {1, 8}});
+}
+
+BENCHMARK_CAPTURE(SOFTMAX, Softmax, false)->Apply(SoftmaxSizes)->UseRealTime();
+BENCHMARK_CAPTURE(SOFTMAX, LogSoftmax, true)->Apply(SoftmaxSizes)->UseRealTime();
+
+BENCHMARK_TEMPLATE(ACTIVATION, MlasComputeLogistic)->ArgName("N")->Arg(1024)->Arg(1 << 20)->UseRealTime();
+BENCHMARK_TEMPLATE(ACTIVATION, MlasComputeTanh)->ArgName("N")->Arg(1024)->Arg(1 << 20)->UseRealTime();
+BENCHMARK_TEMPLATE(ACTIVATION, MlasComputeErf)->ArgName("N")->Arg(1024)->Arg(1 << 20)->UseRealTime();
@@ -204,7 +204,9 @@ class MlasActivationTest : public MlasTestBase {
     MLAS_ACTIVATION Activation;
     AliasedValue Buffer[_countof(TestData)];
 
-    for (unsigned kind = 0; kind < unsigned(MlasActivationKindCount); kind++) {
+    // N.B. The table covers the activations up to HardSigmoid. The GELU family is
+    //      checked against a reference with a tolerance below.
+    for (unsigned kind = 0; kind <= unsigned(MlasHardSigmoidActivation); kind++) {
       Activation.ActivationKind = MLAS_ACTIVATION_KIND(kind);
 
       if (Activation.ActivationKind == MlasLeakyReluActivation) {
@@ -253,6 +255,35 @@ class MlasActivationTest : public MlasTestBase {
             << std::setw(8) << std::setfill('0') << std::hex << TestData[i][kind].u;
       }
     }
+
+    for (MLAS_ACTIVATION_KIND kind : {MlasGeluActivation, MlasFastGeluActivation, MlasSiluActivation}) {
+      Activation.ActivationKind = kind;
+
+      constexpr size_t N = 67;
+      float Values[N];
+      float Reference[N];
+
+      for (size_t i = 0; i < N; i++) {
+        const double x = -8.0 + 16.0 * double(i) / double(N - 1);
+        Values[i] = float(x);
+        if (kind == MlasGeluActivation) {
+          Reference[i] = float(0.5 * x * (1.0 + std::erf(x * 0.7071067811865476)));
+        } else if (kind == MlasFastGeluActivation) {
+          Reference[i] = float(0.5 * x * (1.0 + std::tanh(0.7978845608028654 * (x + 0.044715 * x * x * x))));
+        } else {
+          Reference[i] = float(x / (1.0 + std::exp(-x)));
+        }
+      }
+
+      // Apply the activation to two rows to exercise the row stride.
+      MlasActivation(&Activation, Values, nullptr, 2, N / 2, N / 2 + 1);
+      MlasActivation(&Activation, Values + N / 2, nullptr, 1, 1, 1);
+
+      for (size_t i = 0; i < N; i++) {
+        EXPECT_NEAR(Values[i], Reference[i], 1e-5f + std::fabs(Reference[i]) * 1e-5f)
+            << ", Activation Kind:" << (int)kind << ", i=" << i;
+      }
+    }
   }
 };
 
@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasEmbeddingBagTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferTable;
+  MatrixGuardBuffer<float> BufferOutput;
+
+  template <typename IndexType>
+  void Test(size_t RowCount, size_t Dim, size_t IndexCount, float Scale) {
+    float* Table = BufferTable.GetBuffer(RowCount * Dim);
+    float* Output = BufferOutput.GetBuffer(Dim, true);
+
+    std::default_random_engine generator(static_cast<unsigned>(RowCount * 131 + Dim * 7 + IndexCount));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::uniform_int_distribution<int64_t> index_distribution(-static_cast<int64_t>(RowCount),
+                                                              static_cast<int64_t>(RowCount) - 1);
+
+    for (size_t i = 0; i < RowCount * Dim; i++) {
+      Table[i] = distribution(generator);
+    }
+
+    std::vector<IndexType> Indices(IndexCount);
+    for (auto& Index : Indices) {
+      Index = static_cast<IndexType>(index_distribution(generator));
+    }
+
+    MlasEmbeddingBag(Table, RowCount, Dim, Indices.data(), IndexCount, Scale, Output);
+
+    for (size_t d = 0; d < Dim; d++) {
+      double Expected = 0.0;
+      for (auto Index : Indices) {
+        const int64_t Row = Index < 0 ? Index + static_cast<int64_t>(RowCount) : Index;
+        Expected += Table[static_cast<size_t>(Row) * Dim + d];
+      }
+      Expected *= Scale;
+      ASSERT_NEAR(Output[d], Expected, 1e-4 + std::fabs(Expected) * 1e-5)
+          << "@" << d << ", RowCount=" << RowCount << ", Dim=" << Dim << ", IndexCount=" << IndexCount;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("EmbeddingBag");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t Dim : {1, 2, 3, 4, 15, 16, 17, 64, 100, 257}) {
+      for (size_t IndexCount : {0, 1, 7, 8, 9, 64, 65, 200}) {
+        Test<int64_t>(1000, Dim, IndexCount, 1.0f);
+        Test<int32_t>(97, Dim, IndexCount, IndexCount == 0 ? 1.0f : 1.0f / IndexCount);
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasEmbeddingBagTest>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -70,6 +70,10 @@ class FgemmShortExecuteTest : public MlasTestFixture<MlasFgemmTest<T, Packed, Th
     test_registered += RegisterTestTransposeABProduct(128, 3072, 768, 1, 1.0f, 0.0f);
     test_registered += RegisterTestTransposeABProduct(128, 768, 3072, 1, 1.0f, 0.0f);
     test_registered += RegisterTestTransposeABProduct(25, 81, 79, 7, 1.0f, 0.0f);
+    // single row with several slices of packed B along N and K
+    test_registered += RegisterTestTransposeABProduct(1, 1000, 600, 1, 1.0f, 0.0f);
+    test_registered += RegisterTestTransposeABProduct(1, 300, 513, 3, 0.5f, 1.0f);
+    test_registered += RegisterTestTransposeABProduct(1, 129, 257, 1, 1.0f, -0.5f);
     return test_registered;
   }
 
@@ -0,0 +1,380 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_flashattn.cpp
+
+Abstract:
+
+    Tests for MLAS fused attention.
+
+--*/
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasFlashAttentionTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferQ;
+  MatrixGuardBuffer<float> BufferK;
+  MatrixGuardBuffer<float> BufferV;
+  MatrixGuardBuffer<float> BufferOutput;
+  MLAS_THREADPOOL* threadpool_;
+
+  static void SmallFloatFill(float* start, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      start[i] = float(int((i * 37) % 23) - 11) / 8.0f;
+    }
+  }
+
+  //
+  // Quantizes rows with MlasQuantizeKvCacheRows and expands them again with
+  // the row format described by MlasKvCacheQuantRowSize. Each value must be
+  // within half a quantization step of its input.
+  //
+  static void QuantizeRows(const float* Input, size_t RowCount, size_t H, size_t BitWidth,
+                           std::vector<uint8_t>& Quantized, std::vector<float>& Dequantized) {
+    const size_t RowSize = MlasKvCacheQuantRowSize(H, BitWidth);
+    const size_t BlockCount = (H + MLAS_KV_CACHE_QUANT_BLOCK_SIZE - 1) / MLAS_KV_CACHE_QUANT_BLOCK_SIZE;
+    ASSERT_GE(RowSize, BlockCount * sizeof(float) + (BitWidth == 8 ? H : (H + 1) / 2));
+    ASSERT_EQ(RowSize % sizeof(float), size_t(0));
+
+    Quantized.assign(RowCount * RowSize, 0xAA);
+    Dequantized.resize(RowCount * H);
+    MlasQuantizeKvCacheRows(Input, H, Quantized.data(), RowSize, RowCount, H, BitWidth);
+
+    for (size_t r = 0; r < RowCount; r++) {
+      const uint8_t* Row = Quantized.data() + r * RowSize;
+      const uint8_t* Data = Row + BlockCount * sizeof(float);
+      for (size_t h = 0; h < H; h++) {
+        const float Scale = reinterpret_cast<const float*>(Row)[h / MLAS_KV_CACHE_QUANT_BLOCK_SIZE];
+        int Value;
+        if (BitWidth == 8) {
+          Value = int8_t(Data[h]);
+        } else {
+          Value = (Data[h / 2] >> ((h % 2) * 4)) & 0x0F;
+          Value = Value >= 8 ? Value - 16 : Value;
+        }
+        const float Expanded = Scale * float(Value);
+        ASSERT_LE(std::fabs(Expanded - Input[r * H + h]), Scale * 0.5f + 1e-6f)
+            << "@[" << r << "x" << h << "], H=" << H << ", BitWidth=" << BitWidth;
+        Dequantized[r * H + h] = Expanded;
+      }
+    }
+  }
+
+  //
+  // Reference attention in double precision. Q and Output are BSNH, K and V
+  // are BNSH.
+  //
+  static void ReferenceAttention(const MLAS_FLASH_ATTENTION_PARAMS& p, std::vector<double>& Output) {
+    const size_t S = p.SequenceLength;
+    const size_t T = p.KvSequenceLength;
+    const size_t N = p.NumHeads;
+    const size_t H = p.HeadSize;
+    const size_t Hv = p.VHeadSize;
+    const size_t Group = p.NumHeads / p.KvNumHeads;
+
+    Output.assign(p.BatchSize * S * N * Hv, 0.0);
+    std::vector<double> scores(T);
+
+    for (size_t b = 0; b < p.BatchSize; b++) {
+      const ptrdiff_t L = p.KvSequenceLengths != nullptr ? p.KvSequenceLengths[b] : ptrdiff_t(T);
+      for (size_t n = 0; n < N; n++) {
+        const float* K = p.K + b * p.KBatchStride + (n / Group) * p.KHeadStride;
+        const float* V = p.V + b * p.VBatchStride + (n / Group) * p.VHeadStride;
+        for (size_t s = 0; s < S; s++) {
+          const ptrdiff_t position = ptrdiff_t(s) + L - ptrdiff_t(S);
+          const ptrdiff_t hi = p.Causal ? std::clamp<ptrdiff_t>(position + 1, 0, L) : L;
+          const ptrdiff_t lo = p.LocalWindowSize < 0 ? 0 : std::max<ptrdiff_t>(0, position - p.LocalWindowSize);
+          const float* Q = p.Q + b * p.QBatchStride + n * p.QHeadStride + s * p.ldq;
+
+          double maximum = std::numeric_limits<double>::lowest();
+          for (ptrdiff_t t = lo; t < hi; t++) {
+            double dot = 0.0;
+            for (size_t h = 0; h < H; h++) {
+              dot += double(Q[h]) * K[t * p.ldk + h];
+            }
+            scores[t] = dot * p.Scale;
+            maximum = std::max(maximum, scores[t]);
+          }
+
+          double sum = 0.0;
+          for (ptrdiff_t t = lo; t < hi; t++) {
+            scores[t] = std::exp(scores[t] - maximum);
+            sum += scores[t];
+          }
+
+          double* O = Output.data() + b * S * N * Hv + s * N * Hv + n * Hv;
+          for (ptrdiff_t t = lo; t < hi; t++) {
+            for (size_t h = 0; h < Hv; h++) {
+              O[h] += scores[t] / sum * V[t * p.ldv + h];
+            }
+          }
+        }
+      }
+    }
+  }
+
+ public:
+  MlasFlashAttentionTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void Test(size_t BatchSize, size_t NumHeads, size_t KvNumHeads, size_t S, size_t T, size_t H, size_t Hv,
+            bool Causal, ptrdiff_t LocalWindowSize, bool RaggedKv, size_t KvBitWidth, size_t KvBlockSize) {
+    // The quantized caches use small fractional values, which exercise the
+    // per block scales better than the default integer fill.
+    const size_t QSize = BatchSize * S * NumHeads * H;
+    const size_t KSize = BatchSize * KvNumHeads * T * H;
+    const size_t VSize = BatchSize * KvNumHeads * T * Hv;
+    const float* Q = KvBitWidth != 0 ? BufferQ.GetFilledBuffer(QSize, SmallFloatFill) : BufferQ.GetBuffer(QSize);
+    const float* K = KvBitWidth != 0 ? BufferK.GetFilledBuffer(KSize, SmallFloatFill) : BufferK.GetBuffer(KSize);
+    const float* V = KvBitWidth != 0 ? BufferV.GetFilledBuffer(VSize, SmallFloatFill) : BufferV.GetBuffer(VSize);
+    float* Output = BufferOutput.GetBuffer(BatchSize * S * NumHeads * Hv, true);
+
+    std::vector<int32_t> kv_lengths(BatchSize);
+    for (size_t b = 0; b < BatchSize; b++) {
+      kv_lengths[b] = int32_t(RaggedKv ? T - (b * 3) % (T > S ? T - S + 1 : 1) : T);
+    }
+
+    MLAS_FLASH_ATTENTION_PARAMS p;
+    p.BatchSize = BatchSize;
+    p.NumHeads = NumHeads;
+    p.KvNumHeads = KvNumHeads;
+    p.SequenceLength = S;
+    p.KvSequenceLength = T;
+    p.HeadSize = H;
+    p.VHeadSize = Hv;
+    p.Scale = 1.0f / std::sqrt(float(H));
+    p.Causal = Causal;
+    p.LocalWindowSize = LocalWindowSize;
+    p.KvSequenceLengths = RaggedKv ? kv_lengths.data() : nullptr;
+    p.Q = Q;
+    p.ldq = NumHeads * H;
+    p.QHeadStride = H;
+    p.QBatchStride = S * NumHeads * H;
+    p.K = K;
+    p.ldk = H;
+    p.KHeadStride = T * H;
+    p.KBatchStride = KvNumHeads * T * H;
+    p.V = V;
+    p.ldv = Hv;
+    p.VHeadStride = T * Hv;
+    p.VBatchStride = KvNumHeads * T * Hv;
+    p.Output = Output;
+    p.ldo = NumHeads * Hv;
+    p.OutputHeadStride = Hv;
+    p.OutputBatchStride = S * NumHeads * Hv;
+
+    //
+    // A quantized key/value cache is compared against the attention over its
+    // expanded values.
+    //
+    MLAS_FLASH_ATTENTION_PARAMS r = p;
+    std::vector<uint8_t> QuantizedK, QuantizedV;
+    std::vector<float> DequantizedK, DequantizedV;
+
+    if (KvBitWidth != 0) {
+      QuantizeRows(K, BatchSize * KvNumHeads * T, H, KvBitWidth, QuantizedK, DequantizedK);
+      QuantizeRows(V, BatchSize * KvNumHeads * T, Hv, KvBitWidth, QuantizedV, DequantizedV);
+      if (testing::Test::HasFatalFailure()) {
+        return;
+      }
+
+      const size_t KRowSize = MlasKvCacheQuantRowSize(H, KvBitWidth);
+      const size_t VRowSize = MlasKvCacheQuantRowSize(Hv, KvBitWidth);
+      p.K = nullptr;
+      p.V = nullptr;
+      p.KvBitWidth = KvBitWidth;
+      p.QuantizedK = QuantizedK.data();
+      p.ldk = KRowSize;
+      p.KHeadStride = T * KRowSize;
+      p.KBatchStride = KvNumHeads * T * KRowSize;
+      p.QuantizedV = QuantizedV.data();
+      p.ldv = VRowSize;
+      p.VHeadStride = T * VRowSize;
+      p.VBatchStride = KvNumHeads * T * VRowSize;
+
+      r.K = DequantizedK.data();
+      r.V = DequantizedV.data();
+    }
+
+    //
+    // A paged cache holds the same rows in blocks of KvBlockSize rows, placed
+    // in the pool in the reverse order of the sequence. The unused rows of
+    // the last blocks are NaN, so reading them fails the comparison.
+    //
+    std::vector<uint8_t> PoolK, PoolV;
+    std::vector<int32_t> BlockTables;
+
+    if (KvBlockSize != 0) {
+      const size_t BlocksPerSequence = (T + KvBlockSize - 1) / KvBlockSize;
+      const size_t BlockCount = BatchSize * BlocksPerSequence;
+      const size_t ElementSize = KvBitWidth != 0 ? 1 : sizeof(float);
+      BlockTables.resize(BlockCount);
+      for (size_t i = 0; i < BlockCount; i++) {
+        BlockTables[i] = int32_t(BlockCount - 1 - i);
+      }
+
+      auto Page = [&](const void* Cache, size_t ld, size_t& HeadStride, size_t& BatchStride,
+                      std::vector<uint8_t>& Pool) {
+        const size_t RowBytes = ld * ElementSize;
+        Pool.assign(BlockCount * KvNumHeads * KvBlockSize * RowBytes, 0xFF);
+        for (size_t b = 0; b < BatchSize; b++) {
+          for (size_t n = 0; n < KvNumHeads; n++) {
+            for (size_t t = 0; t < T; t++) {
+              const size_t Block = size_t(BlockTables[b * BlocksPerSequence + t / KvBlockSize]);
+              memcpy(Pool.data() + ((Block * KvNumHeads + n) * KvBlockSize + t % KvBlockSize) * RowBytes,
+                     static_cast<const uint8_t*>(Cache) + (b * BatchStride + n * HeadStride + t * ld) * ElementSize,
+                     RowBytes);
+            }
+          }
+        }
+        HeadStride = KvBlockSize * ld;
+        BatchStride = KvNumHeads * HeadStride;
+      };
+
+      const void* CacheK = KvBitWidth != 0 ? static_cast<const void*>(p.QuantizedK) : p.K;
+      const void* CacheV = KvBitWidth != 0 ? static_cast<const void*>(p.QuantizedV) : p.V;
+      Page(CacheK, p.ldk, p.KHeadStride, p.KBatchStride, PoolK);
+      Page(CacheV, p.ldv, p.VHeadStride, p.VBatchStride, PoolV);
+      if (KvBitWidth != 0) {
+        p.QuantizedK = PoolK.data();
+        p.QuantizedV = PoolV.data();
+      } else {
+        p.K = reinterpret_cast<const float*>(PoolK.data());
+        p.V = reinterpret_cast<const float*>(PoolV.data());
+      }
+      p.BlockTables = BlockTables.data();
+      p.BlockTableStride = BlocksPerSequence;
+      p.KvBlockSize = KvBlockSize;
+    }
+
+    MlasFlashAttention(&p, threadpool_);
+
+    std::vector<double> reference;
+    ReferenceAttention(r, reference);
+
+    for (size_t f = 0; f < reference.size(); f++) {
+      ASSERT_NEAR(Output[f], reference[f], 1e-4)
+          << "@" << f << ", B=" << BatchSize << ", N=" << NumHeads << ", Nkv=" << KvNumHeads << ", S=" << S
+          << ", T=" << T << ", H=" << H << ", Hv=" << Hv << ", Causal=" << Causal
+          << ", Window=" << LocalWindowSize << ", RaggedKv=" << RaggedKv << ", KvBitWidth=" << KvBitWidth
+          << ", KvBlockSize=" << KvBlockSize;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static std::string suite_name = std::string("FlashAttention") + (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+};
+
+template <bool Threaded>
+class FlashAttentionShortExecuteTest : public MlasTestFixture<MlasFlashAttentionTest<Threaded>> {
+ public:
+  explicit FlashAttentionShortExecuteTest(size_t BatchSize, size_t NumHeads, size_t KvNumHeads, size_t S, size_t T,
+                                          size_t H, size_t Hv, bool Causal, ptrdiff_t LocalWindowSize, bool RaggedKv,
+                                          size_t KvBitWidth, size_t KvBlockSize)
+      : BatchSize_(BatchSize),
+        NumHeads_(NumHeads),
+        KvNumHeads_(KvNumHeads),
+        S_(S),
+        T_(T),
+        H_(H),
+        Hv_(Hv),
+        Causal_(Causal),
+        LocalWindowSize_(LocalWindowSize),
+        RaggedKv_(RaggedKv),
+        KvBitWidth_(KvBitWidth),
+        KvBlockSize_(KvBlockSize) {}
+
+  void TestBody() override {
+    MlasTestFixture<MlasFlashAttentionTest<Threaded>>::mlas_tester->Test(
+        BatchSize_, NumHeads_, KvNumHeads_, S_, T_, H_, Hv_, Causal_, LocalWindowSize_, RaggedKv_, KvBitWidth_,
+        KvBlockSize_);
+  }
+
+  static size_t RegisterSingleTest(size_t BatchSize, size_t NumHeads, size_t KvNumHeads, size_t S, size_t T,
+                                   size_t H, size_t Hv, bool Causal, ptrdiff_t LocalWindowSize, bool RaggedKv,
+                                   size_t KvBitWidth = 0, size_t KvBlockSize = 0) {
+    std::stringstream ss;
+    ss << "/B" << BatchSize << "xN" << NumHeads << "xNkv" << KvNumHeads << "/S" << S << "xT" << T
+       << "/H" << H << "xHv" << Hv << "/Causal" << Causal << "/Window" << LocalWindowSize << "/Ragged" << RaggedKv
+       << "/Bits" << KvBitWidth << "/Block" << KvBlockSize;
+    auto test_name = ss.str();
+
+    testing::RegisterTest(
+        MlasFlashAttentionTest<Threaded>::GetTestSuiteName(),
+        test_name.c_str(),
+        nullptr,
+        test_name.c_str(),
+        __FILE__,
+        __LINE__,
+        // Important to use the fixture type as the return type here.
+        [=]() -> MlasTestFixture<MlasFlashAttentionTest<Threaded>>* {
+          return new FlashAttentionShortExecuteTest<Threaded>(
+              BatchSize, NumHeads, KvNumHeads, S, T, H, Hv, Causal, LocalWindowSize, RaggedKv, KvBitWidth,
+              KvBlockSize);
+        });
+
+    return 1;
+  }
+
+  static size_t RegisterShortExecuteTests() {
+    size_t test_registered = 0;
+
+    for (size_t S : {1, 7, 64, 97}) {
+      for (size_t past : {0, 5, 300}) {
+        for (bool causal : {false, true}) {
+          test_registered += RegisterSingleTest(2, 4, 4, S, S + past, 32, 32, causal, -1, false);
+          test_registered += RegisterSingleTest(2, 8, 2, S, S + past, 24, 16, causal, -1, true);
+        }
+        test_registered += RegisterSingleTest(1, 4, 1, S, S + past, 64, 64, true, 16, false);
+      }
+    }
+    test_registered += RegisterSingleTest(1, 2, 2, 200, 1000, 128, 128, false, -1, false);
+    test_registered += RegisterSingleTest(3, 12, 12, 256, 256, 64, 64, true, -1, false);
+
+    for (size_t bits : {8, 4}) {
+      for (size_t S : {1, 7, 97}) {
+        for (size_t past : {0, 300}) {
+          test_registered += RegisterSingleTest(2, 8, 2, S, S + past, 64, 64, true, -1, true, bits);
+          test_registered += RegisterSingleTest(1, 4, 1, S, S + past, 40, 33, false, -1, false, bits);
+        }
+      }
+      test_registered += RegisterSingleTest(1, 4, 2, 1, 150, 32, 32, true, 16, false, bits);
+    }
+
+    for (size_t block_size : {16, 5, 256}) {
+      for (size_t S : {1, 97}) {
+        test_registered += RegisterSingleTest(2, 8, 2, S, S + 300, 64, 64, true, -1, true, 0, block_size);
+        test_registered += RegisterSingleTest(1, 4, 1, S, S + 300, 64, 64, true, 16, false, 0, block_size);
+        test_registered += RegisterSingleTest(2, 8, 2, S, S + 300, 64, 64, true, -1, true, 8, block_size);
+      }
+      test_registered += RegisterSingleTest(1, 4, 2, 1, 150, 40, 33, false, -1, false, 4, block_size);
+    }
+
+    return test_registered;
+  }
+
+ private:
+  size_t BatchSize_, NumHeads_, KvNumHeads_, S_, T_, H_, Hv_;
+  bool Causal_;
+  ptrdiff_t LocalWindowSize_;
+  bool RaggedKv_;
+  size_t KvBitWidth_;
+  size_t KvBlockSize_;
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  if (is_short_execute) {
+    return FlashAttentionShortExecuteTest<false>::RegisterShortExecuteTests() > 0 &&
+           FlashAttentionShortExecuteTest<true>::RegisterShortExecuteTests() > 0;
+  }
+  return false;
+});
@@ -0,0 +1,190 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_fp16.h"
+
+class MlasLayerNormTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferSkip;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferScale;
+  MatrixGuardBuffer<float> BufferShift;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferSkipOutput;
+
+  static void ReferenceLayerNorm(const float* Input, const float* Skip, const float* Bias, const float* Scale,
+                                 const float* Shift, size_t N, float Epsilon, bool Simplified,
+                                 std::vector<double>& Output, std::vector<double>& SkipOutput,
+                                 double& Mean, double& InvStdDev) {
+    Output.resize(N);
+    SkipOutput.resize(N);
+
+    double Sum = 0.0;
+    for (size_t n = 0; n < N; n++) {
+      double Value = Input[n];
+      if (Skip != nullptr) {
+        Value += Skip[n];
+      }
+      if (Bias != nullptr) {
+        Value += Bias[n];
+      }
+      SkipOutput[n] = Value;
+      Sum += Value;
+    }
+
+    Mean = Simplified ? 0.0 : Sum / N;
+
+    double Variance = 0.0;
+    for (size_t n = 0; n < N; n++) {
+      Variance += (SkipOutput[n] - Mean) * (SkipOutput[n] - Mean);
+    }
+    InvStdDev = 1.0 / std::sqrt(Variance / N + Epsilon);
+
+    for (size_t n = 0; n < N; n++) {
+      Output[n] = (SkipOutput[n] - Mean) * InvStdDev * Scale[n];
+      if (Shift != nullptr && !Simplified) {
+        Output[n] += Shift[n];
+      }
+    }
+  }
+
+  void Test(size_t N, bool UseSkip, bool UseBias, bool UseShift, bool Simplified, float Offset) {
+    float* Input = BufferInput.GetBuffer(N);
+    float* Skip = UseSkip ? BufferSkip.GetBuffer(N) : nullptr;
+    float* Bias = UseBias ? BufferBias.GetBuffer(N) : nullptr;
+    float* Scale = BufferScale.GetBuffer(N);
+    float* Shift = UseShift ? BufferShift.GetBuffer(N) : nullptr;
+    float* Output = BufferOutput.GetBuffer(N, true);
+    float* SkipOutput = (UseSkip || UseBias) ? BufferSkipOutput.GetBuffer(N, true) : nullptr;
+
+    std::default_random_engine generator(static_cast<unsigned>(N));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    for (size_t n = 0; n < N; n++) {
+      Input[n] = distribution(generator) + Offset;
+      if (Skip != nullptr) {
+        Skip[n] = distribution(generator);
+      }
+      if (Bias != nullptr) {
+        Bias[n] = distribution(generator);
+      }
+      Scale[n] = distribution(generator);
+      if (Shift != nullptr) {
+        Shift[n] = distribution(generator);
+      }
+    }
+
+    constexpr float Epsilon = 1e-5f;
+
+    float Mean = 0.0f;
+    float InvStdDev = 0.0f;
+    MlasLayerNormalization(Input, Skip, Bias, Scale, Shift, Output, SkipOutput, N, Epsilon, Simplified,
+                           &Mean, &InvStdDev);
+
+    std::vector<double> OutputReference;
+    std::vector<double> SkipOutputReference;
+    double MeanReference;
+    double InvStdDevReference;
+    ReferenceLayerNorm(Input, Skip, Bias, Scale, Shift, N, Epsilon, Simplified,
+                       OutputReference, SkipOutputReference, MeanReference, InvStdDevReference);
+
+    constexpr double AbsoluteTolerance = 1e-4;
+    constexpr double RelativeTolerance = 1e-4;
+
+    ASSERT_NEAR(Mean, MeanReference, AbsoluteTolerance + std::fabs(MeanReference) * RelativeTolerance)
+        << "Mean, N=" << N << ", Simplified=" << Simplified;
+    ASSERT_NEAR(InvStdDev, InvStdDevReference, AbsoluteTolerance + InvStdDevReference * RelativeTolerance)
+        << "InvStdDev, N=" << N << ", Simplified=" << Simplified;
+
+    for (size_t n = 0; n < N; n++) {
+      ASSERT_NEAR(Output[n], OutputReference[n], AbsoluteTolerance + std::fabs(OutputReference[n]) * RelativeTolerance)
+          << "@" << n << ", N=" << N << ", Skip=" << UseSkip << ", Bias=" << UseBias << ", Shift=" << UseShift
+          << ", Simplified=" << Simplified << ", Offset=" << Offset;
+      if (SkipOutput != nullptr) {
+        ASSERT_NEAR(SkipOutput[n], SkipOutputReference[n], 1e-6 + std::fabs(SkipOutputReference[n]) * 1e-6)
+            << "@" << n << ", N=" << N << ", Skip=" << UseSkip << ", Bias=" << UseBias;
+      }
+    }
+  }
+
+  void TestHalf(size_t N, bool Simplified) {
+    std::vector<MLFp16> Input(N), Skip(N), Bias(N), Scale(N), Shift(N), Output(N), SkipOutput(N);
+    std::vector<float> InputFloat(N), SkipFloat(N), BiasFloat(N), ScaleFloat(N), ShiftFloat(N);
+
+    std::default_random_engine generator(static_cast<unsigned>(N));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    auto Fill = [&](std::vector<MLFp16>& Half, std::vector<float>& Float) {
+      for (size_t n = 0; n < N; n++) {
+        Half[n] = MLFp16(distribution(generator));
+        Float[n] = Half[n].ToFloat();
+      }
+    };
+
+    Fill(Input, InputFloat);
+    Fill(Skip, SkipFloat);
+    Fill(Bias, BiasFloat);
+    Fill(Scale, ScaleFloat);
+    Fill(Shift, ShiftFloat);
+
+    constexpr float Epsilon = 1e-5f;
+
+    MlasLayerNormalization(reinterpret_cast<const MLAS_FP16*>(Input.data()),
+                           reinterpret_cast<const MLAS_FP16*>(Skip.data()),
+                           reinterpret_cast<const MLAS_FP16*>(Bias.data()),
+                           reinterpret_cast<const MLAS_FP16*>(Scale.data()),
+                           reinterpret_cast<const MLAS_FP16*>(Shift.data()),
+                           reinterpret_cast<MLAS_FP16*>(Output.data()),
+                           reinterpret_cast<MLAS_FP16*>(SkipOutput.data()),
+                           N, Epsilon, Simplified, nullptr, nullptr);
+
+    std::vector<double> OutputReference;
+    std::vector<double> SkipOutputReference;
+    double MeanReference;
+    double InvStdDevReference;
+    ReferenceLayerNorm(InputFloat.data(), SkipFloat.data(), BiasFloat.data(), ScaleFloat.data(), ShiftFloat.data(),
+                       N, Epsilon, Simplified, OutputReference, SkipOutputReference, MeanReference, InvStdDevReference);
+
+    for (size_t n = 0; n < N; n++) {
+      ASSERT_NEAR(Output[n].ToFloat(), OutputReference[n], 2e-3 + std::fabs(OutputReference[n]) * 2e-3)
+          << "@" << n << ", N=" << N << ", Simplified=" << Simplified;
+      ASSERT_NEAR(SkipOutput[n].ToFloat(), SkipOutputReference[n], 2e-3 + std::fabs(SkipOutputReference[n]) * 2e-3)
+          << "@" << n << ", N=" << N;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("LayerNorm");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t n = 1; n < 80; n++) {
+      Test(n, false, false, true, false, 0.0f);
+      Test(n, true, true, true, false, 0.0f);
+      Test(n, true, false, false, true, 0.0f);
+    }
+
+    for (size_t n : {255, 256, 768, 1023, 4099}) {
+      for (bool Simplified : {false, true}) {
+        Test(n, false, false, false, Simplified, 0.0f);
+        Test(n, true, false, true, Simplified, 0.0f);
+        Test(n, false, true, true, Simplified, 0.0f);
+        Test(n, true, true, true, Simplified, 0.0f);
+        TestHalf(n, Simplified);
+      }
+      // A large mean relative to the standard deviation.
+      Test(n, true, true, true, false, 100.0f);
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasLayerNormTest>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_fp16.h"
+
+class MlasReduceTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferOutput;
+
+  static double Reference(MLAS_REDUCE_KIND Kind, const float* Input, size_t N, size_t Stride) {
+    double Accumulator = 0.0;
+    double Maximum = -std::numeric_limits<double>::infinity();
+    double Minimum = std::numeric_limits<double>::infinity();
+
+    for (size_t n = 0; n < N; n++) {
+      const double x = Input[n * Stride];
+      Accumulator += (Kind == MlasReduceSumSquare) ? x * x : x;
+      Maximum = std::max(Maximum, x);
+      Minimum = std::min(Minimum, x);
+    }
+
+    switch (Kind) {
+      case MlasReduceMaximum:
+        return Maximum;
+      case MlasReduceMinimum:
+        return Minimum;
+      case MlasReduceLogSumExp: {
+        double SumExp = 0.0;
+        for (size_t n = 0; n < N; n++) {
+          SumExp += std::exp(Input[n * Stride] - Maximum);
+        }
+        return std::log(SumExp) + Maximum;
+      }
+      default:
+        return Accumulator;
+    }
+  }
+
+  void Test(MLAS_REDUCE_KIND Kind, size_t Rows, size_t Columns) {
+    const size_t ldInput = Columns + 3;
+    float* Input = BufferInput.GetBuffer(Rows * ldInput);
+
+    std::default_random_engine generator(static_cast<unsigned>(Rows * 131 + Columns));
+    std::uniform_real_distribution<float> distribution(-4.0f, 4.0f);
+
+    // Round the input to fp16 so both input types compute the same reduction.
+    std::vector<MLFp16> InputHalf(Rows * ldInput);
+    for (size_t i = 0; i < Rows * ldInput; i++) {
+      InputHalf[i] = MLFp16(distribution(generator));
+      Input[i] = InputHalf[i].ToFloat();
+    }
+
+    float* Output = BufferOutput.GetBuffer(std::max(Rows, Columns), true);
+    std::vector<float> OutputHalf(std::max(Rows, Columns));
+
+    // The rows of the last axis reduction are contiguous.
+    for (size_t r = 0; r < Rows; r++) {
+      std::copy_n(Input + r * ldInput, Columns, Input + r * Columns);
+      std::copy_n(InputHalf.data() + r * ldInput, Columns, InputHalf.data() + r * Columns);
+    }
+
+    MlasReduceLastAxis(Kind, Input, Output, Rows, Columns);
+    MlasReduceLastAxis(Kind, reinterpret_cast<const MLAS_FP16*>(InputHalf.data()), OutputHalf.data(), Rows, Columns);
+
+    for (size_t r = 0; r < Rows; r++) {
+      const double Expected = Reference(Kind, Input + r * Columns, Columns, 1);
+      ASSERT_NEAR(Output[r], Expected, 1e-3 + std::fabs(Expected) * 1e-5)
+          << "LastAxis @" << r << ", Rows=" << Rows << ", Columns=" << Columns << ", Kind=" << int(Kind);
+      ASSERT_NEAR(OutputHalf[r], Expected, 1e-3 + std::fabs(Expected) * 1e-5)
+          << "LastAxis fp16 @" << r << ", Rows=" << Rows << ", Columns=" << Columns << ", Kind=" << int(Kind);
+    }
+
+    if (Kind == MlasReduceLogSumExp) {
+      return;
+    }
+
+    for (size_t i = 0; i < Rows * ldInput; i++) {
+      InputHalf[i] = MLFp16(distribution(generator));
+      Input[i] = InputHalf[i].ToFloat();
+    }
+
+    MlasReduceFirstAxis(Kind, Input, Output, Rows, Columns, ldInput);
+    MlasReduceFirstAxis(Kind, reinterpret_cast<const MLAS_FP16*>(InputHalf.data()), OutputHalf.data(), Rows, Columns,
+                        ldInput);
+
+    for (size_t c = 0; c < Columns; c++) {
+      const double Expected = Reference(Kind, Input + c, Rows, ldInput);
+      ASSERT_NEAR(Output[c], Expected, 1e-3 + std::fabs(Expected) * 1e-5)
+          << "FirstAxis @" << c << ", Rows=" << Rows << ", Columns=" << Columns << ", Kind=" << int(Kind);
+      ASSERT_NEAR(OutputHalf[c], Expected, 1e-3 + std::fabs(Expected) * 1e-5)
+          << "FirstAxis fp16 @" << c << ", Rows=" << Rows << ", Columns=" << Columns << ", Kind=" << int(Kind);
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Reduce");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (MLAS_REDUCE_KIND Kind : {MlasReduceSum, MlasReduceSumSquare, MlasReduceMaximum, MlasReduceMinimum,
+                                  MlasReduceLogSumExp}) {
+      for (size_t Rows : {1, 3, 4, 7, 16}) {
+        for (size_t Columns : {1, 3, 4, 15, 16, 17, 63, 255, 256, 257, 1000}) {
+          Test(Kind, Rows, Columns);
+        }
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasReduceTest>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -0,0 +1,161 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_sbgemm.cpp
+
+Abstract:
+
+    Tests for MLAS single precision GEMM with bfloat16 compute.
+
+--*/
+
+#include "test_util.h"
+
+/**
+ * @brief Test class for single precision GEMM with bfloat16 compute.
+ *        The test data are small integers, which bfloat16 represents exactly,
+ *        so the results match a single precision reference.
+ */
+template <bool Threaded>
+class MlasSBGemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferBPacked;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  void ReferenceGemm(size_t M, size_t N, size_t K, bool TransB, const float* A, const float* B, float* C) {
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        float sum = 0.0f;
+        for (size_t k = 0; k < K; k++) {
+          sum += A[m * K + k] * (TransB ? B[n * K + k] : B[k * N + n]);
+        }
+        C[m * N + n] = sum;
+      }
+    }
+  }
+
+ public:
+  MlasSBGemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void Test(size_t M, size_t N, size_t K, size_t BatchSize, bool TransB) {
+    const float* A = BufferA.GetBuffer(K * M * BatchSize);
+    const float* B = BufferB.GetBuffer(N * K * BatchSize);
+    float* C = BufferC.GetBuffer(N * M * BatchSize, true);
+    float* CReference = BufferCReference.GetFilledBuffer(
+        N * M * BatchSize,
+        [](float* start, size_t size) {
+          std::fill_n(start, size, -1.0f);
+        });
+
+    const size_t PackedBSize = MlasSBGemmPackBSize(N, K);
+    uint8_t* PackedB = BufferBPacked.GetBuffer(PackedBSize * BatchSize);
+
+    std::vector<MLAS_SBGEMM_DATA_PARAMS> data(BatchSize);
+    for (size_t i = 0; i < BatchSize; i++) {
+      MlasSBGemmConvertPackB(TransB ? CblasTrans : CblasNoTrans, N, K, B + N * K * i, TransB ? K : N,
+                             PackedB + PackedBSize * i, threadpool_);
+      data[i].A = A + M * K * i;
+      data[i].lda = K;
+      data[i].B = PackedB + PackedBSize * i;
+      data[i].C = C + M * N * i;
+      data[i].ldc = N;
+    }
+    MlasSBGemmBatch(M, N, K, data.data(), BatchSize, threadpool_);
+
+    for (size_t i = 0; i < BatchSize; i++) {
+      ReferenceGemm(M, N, K, TransB, A + M * K * i, B + N * K * i, CReference + M * N * i);
+    }
+
+    for (size_t f = 0; f < M * N * BatchSize; f++) {
+      ASSERT_TRUE(CloseEnough(C[f], CReference[f]))
+          << "Expected: " << CReference[f] << " Actual: " << C[f] << "@" << f << ", "
+          << "M=" << M << ", N=" << N << ", K=" << K << ", Batch=" << BatchSize << ", TransB=" << TransB;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static std::string suite_name = std::string("SBGemm") + (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+};
+
+//
+// Short Execute() test helper to register each test separately by all parameters.
+//
+template <bool Threaded>
+class SBGemmShortExecuteTest : public MlasTestFixture<MlasSBGemmTest<Threaded>> {
+ public:
+  explicit SBGemmShortExecuteTest(size_t M, size_t N, size_t K, size_t BatchSize, bool TransB)
+      : M_(M), N_(N), K_(K), BatchSize_(BatchSize), TransB_(TransB) {}
+
+  void TestBody() override {
+    MlasTestFixture<MlasSBGemmTest<Threaded>>::mlas_tester->Test(M_, N_, K_, BatchSize_, TransB_);
+  }
+
+  static size_t RegisterSingleTest(size_t M, size_t N, size_t K, size_t BatchSize, bool TransB) {
+    std::stringstream ss;
+    ss << "/M" << M << "xN" << N << "xK" << K << "xBatch" << BatchSize << "/"
+       << "TransB" << TransB;
+    auto test_name = ss.str();
+
+    testing::RegisterTest(
+        MlasSBGemmTest<Threaded>::GetTestSuiteName(),
+        test_name.c_str(),
+        nullptr,
+        test_name.c_str(),
+        __FILE__,
+        __LINE__,
+        // Important to use the fixture type as the return type here.
+        [=]() -> MlasTestFixture<MlasSBGemmTest<Threaded>>* {
+          return new SBGemmShortExecuteTest<Threaded>(M, N, K, BatchSize, TransB);
+        });
+
+    return 1;
+  }
+
+  static size_t RegisterShortExecuteTests() {
+    size_t test_registered = 0;
+
+    for (size_t b = 1; b < 16; b++) {
+      test_registered += RegisterSingleTest(b, b, b, 1, false);
+      test_registered += RegisterSingleTest(b, b, b, 1, true);
+    }
+    for (size_t b = 16; b <= 256; b <<= 1) {
+      test_registered += RegisterSingleTest(b, b, b, 1, false);
+      test_registered += RegisterSingleTest(b, b, b, 3, true);
+    }
+    for (size_t b = 1; b < 96; b += 7) {
+      test_registered += RegisterSingleTest(1, b, 32, 1, false);
+      test_registered += RegisterSingleTest(1, 32, b, 1, true);
+    }
+    test_registered += RegisterSingleTest(43, 500, 301, 1, false);
+    test_registered += RegisterSingleTest(128, 768, 320, 2, true);
+
+    return test_registered;
+  }
+
+ private:
+  size_t M_, N_, K_, BatchSize_;
+  bool TransB_;
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  if (MlasSBGemmPackBSize(32, 32) == 0) {
+    return false;  // operation not yet supported on current hardware
+  }
+  if (is_short_execute) {
+    return SBGemmShortExecuteTest<false>::RegisterShortExecuteTests() > 0 &&
+           SBGemmShortExecuteTest<true>::RegisterShortExecuteTests() > 0;
+  }
+  return false;
+});
@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasSgemmEpilogueTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferResidual;
+  MatrixGuardBuffer<float> BufferC;
+  MLAS_THREADPOOL* threadpool_;
+
+  static void SmallFloatFill(float* start, size_t size) {
+    // Small values keep the products near the interesting range of the activations.
+    for (size_t i = 0; i < size; i++) {
+      start[i] = float(int((i * 37) % 17) - 8) / 16.0f;
+    }
+  }
+
+  static double ReferenceActivation(MLAS_ACTIVATION_KIND Kind, double x) {
+    switch (Kind) {
+      case MlasReluActivation:
+        return std::max(x, 0.0);
+      case MlasGeluActivation:
+        return 0.5 * x * (1.0 + std::erf(x * 0.7071067811865476));
+      case MlasFastGeluActivation:
+        return 0.5 * x * (1.0 + std::tanh(0.7978845608028654 * (x + 0.044715 * x * x * x)));
+      case MlasSiluActivation:
+        return x / (1.0 + std::exp(-x));
+      default:
+        return x;
+    }
+  }
+
+  void Test(CBLAS_TRANSPOSE TransA, CBLAS_TRANSPOSE TransB, bool Packed, size_t M, size_t N, size_t K,
+            MLAS_ACTIVATION_KIND Kind, bool UseBias, bool UseResidual) {
+    const float* A = BufferA.GetFilledBuffer(M * K, SmallFloatFill);
+    const float* B = BufferB.GetFilledBuffer(K * N, SmallFloatFill);
+    const float* Bias = UseBias ? BufferBias.GetFilledBuffer(N, SmallFloatFill) : nullptr;
+    const float* Residual = UseResidual ? BufferResidual.GetFilledBuffer(M * N, SmallFloatFill) : nullptr;
+    float* C = BufferC.GetFilledBuffer(M * N, [](float* start, size_t size) {
+      std::fill_n(start, size, -1.0f);
+    });
+
+    const size_t lda = (TransA == CblasNoTrans) ? K : M;
+    const size_t ldb = (TransB == CblasNoTrans) ? N : K;
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = Kind;
+    MLAS_SGEMM_EPILOGUE_PROCESSOR Epilogue(&Activation, Bias, Residual, N);
+
+    MLAS_SGEMM_DATA_PARAMS Data;
+    Data.A = A;
+    Data.lda = lda;
+    Data.C = C;
+    Data.ldc = N;
+    Data.OutputProcessor = &Epilogue;
+
+    if (Packed) {
+      void* PackedB = BufferPackedB.GetBuffer(MlasGemmPackBSize(N, K), true);
+      MlasGemmPackB(TransB, N, K, B, ldb, PackedB);
+      Data.B = static_cast<const float*>(PackedB);
+      Data.BIsPacked = true;
+    } else {
+      Data.B = B;
+      Data.ldb = ldb;
+    }
+
+    MlasGemm(TransA, Packed ? CblasNoTrans : TransB, M, N, K, Data, threadpool_);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double Sum = 0.0;
+        for (size_t k = 0; k < K; k++) {
+          const float a = (TransA == CblasNoTrans) ? A[m * lda + k] : A[k * lda + m];
+          const float b = (TransB == CblasNoTrans) ? B[k * ldb + n] : B[n * ldb + k];
+          Sum += double(a) * double(b);
+        }
+        if (Bias != nullptr) {
+          Sum += Bias[n];
+        }
+        double Reference = ReferenceActivation(Kind, Sum);
+        if (Residual != nullptr) {
+          Reference += Residual[m * N + n];
+        }
+        ASSERT_NEAR(C[m * N + n], Reference, 1e-4 + std::fabs(Reference) * 1e-4)
+            << "@[" << m << "x" << n << "], M=" << M << ", N=" << N << ", K=" << K
+            << ", TransA=" << (TransA != CblasNoTrans) << ", TransB=" << (TransB != CblasNoTrans)
+            << ", Packed=" << Packed << ", Kind=" << int(Kind);
+      }
+    }
+  }
+
+ public:
+  MlasSgemmEpilogueTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "SgemmEpilogue_Threaded" : "SgemmEpilogue_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (MLAS_ACTIVATION_KIND Kind : {MlasIdentityActivation, MlasReluActivation, MlasGeluActivation,
+                                      MlasFastGeluActivation, MlasSiluActivation}) {
+      for (CBLAS_TRANSPOSE TransA : {CblasNoTrans, CblasTrans}) {
+        for (CBLAS_TRANSPOSE TransB : {CblasNoTrans, CblasTrans}) {
+          for (bool Packed : {false, true}) {
+            Test(TransA, TransB, Packed, 1, 37, 19, Kind, true, false);
+            Test(TransA, TransB, Packed, 1, 300, 300, Kind, true, true);
+            Test(TransA, TransB, Packed, 7, 1, 33, Kind, true, true);
+            Test(TransA, TransB, Packed, 17, 63, 70, Kind, false, true);
+            Test(TransA, TransB, Packed, 45, 300, 290, Kind, true, true);
+          }
+        }
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSgemmEpilogueTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasSgemmEpilogueTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
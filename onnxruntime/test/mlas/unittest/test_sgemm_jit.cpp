@@ -0,0 +1,139 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasSgemmJitTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferC;
+  MLAS_THREADPOOL* threadpool_;
+
+  static void SmallFloatFill(float* start, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      start[i] = float(int((i * 37) % 17) - 8) / 16.0f;
+    }
+  }
+
+  static double ReferenceActivation(const MLAS_ACTIVATION& Activation, double x) {
+    switch (Activation.ActivationKind) {
+      case MlasReluActivation:
+        return std::max(x, 0.0);
+      case MlasLeakyReluActivation:
+        return (x < 0.0) ? x * Activation.Parameters.LeakyRelu.alpha : x;
+      case MlasClipActivation:
+        return std::min(std::max(x, double(Activation.Parameters.Clip.minimum)),
+                        double(Activation.Parameters.Clip.maximum));
+      case MlasHardSigmoidActivation:
+        return std::min(std::max(x * Activation.Parameters.HardSigmoid.alpha + Activation.Parameters.HardSigmoid.beta,
+                                 0.0),
+                        1.0);
+      default:
+        return x;
+    }
+  }
+
+  void Test(size_t M, size_t N, size_t K, const MLAS_ACTIVATION& Activation, bool UseBias, float alpha, float beta) {
+    auto Kernel = MlasSgemmJitKernelGet(N, K, &Activation, UseBias);
+    if (!Kernel) {
+      // Kernels are not generated on this platform or for this shape.
+      return;
+    }
+
+    // The kernels of the same specialization are shared.
+    EXPECT_EQ(Kernel, MlasSgemmJitKernelGet(N, K, &Activation, UseBias));
+
+    const float* A = BufferA.GetFilledBuffer(M * K, SmallFloatFill);
+    const float* B = BufferB.GetFilledBuffer(K * N, SmallFloatFill);
+    const float* Bias = UseBias ? BufferBias.GetFilledBuffer(N, SmallFloatFill) : nullptr;
+    float* C = BufferC.GetFilledBuffer(M * N, SmallFloatFill);
+    std::vector<float> CInitial(C, C + M * N);
+
+    void* PackedB = BufferPackedB.GetBuffer(MlasGemmPackBSize(N, K), true);
+    MlasGemmPackB(CblasNoTrans, N, K, B, N, PackedB);
+
+    MLAS_SGEMM_DATA_PARAMS Data;
+    Data.A = A;
+    Data.lda = K;
+    Data.B = static_cast<const float*>(PackedB);
+    Data.BIsPacked = true;
+    Data.C = C;
+    Data.ldc = N;
+    Data.alpha = alpha;
+    Data.beta = beta;
+    Data.JitKernel = Kernel.get();
+    Data.JitBias = Bias;
+
+    // The epilogue computes the same output when the kernel is not used.
+    MLAS_SGEMM_EPILOGUE_PROCESSOR Epilogue(&Activation, Bias);
+    Data.OutputProcessor = &Epilogue;
+
+    MlasGemm(CblasNoTrans, CblasNoTrans, M, N, K, Data, threadpool_);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double Sum = 0.0;
+        for (size_t k = 0; k < K; k++) {
+          Sum += double(A[m * K + k]) * double(B[k * N + n]);
+        }
+        Sum = Sum * alpha + double(beta) * CInitial[m * N + n];
+        if (Bias != nullptr) {
+          Sum += Bias[n];
+        }
+        const double Reference = ReferenceActivation(Activation, Sum);
+        ASSERT_NEAR(C[m * N + n], Reference, 1e-4 + std::fabs(Reference) * 1e-4)
+            << "@[" << m << "x" << n << "], M=" << M << ", N=" << N << ", K=" << K
+            << ", Kind=" << int(Activation.ActivationKind) << ", Bias=" << UseBias
+            << ", alpha=" << alpha << ", beta=" << beta;
+      }
+    }
+  }
+
+ public:
+  MlasSgemmJitTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "SgemmJit_Threaded" : "SgemmJit_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    MLAS_ACTIVATION Activations[5];
+    Activations[0].ActivationKind = MlasIdentityActivation;
+    Activations[1].ActivationKind = MlasReluActivation;
+    Activations[2].ActivationKind = MlasLeakyReluActivation;
+    Activations[2].Parameters.LeakyRelu.alpha = 0.1f;
+    Activations[3].ActivationKind = MlasClipActivation;
+    Activations[3].Parameters.Clip.minimum = -0.5f;
+    Activations[3].Parameters.Clip.maximum = 0.75f;
+    Activations[4].ActivationKind = MlasHardSigmoidActivation;
+    Activations[4].Parameters.HardSigmoid.alpha = 0.2f;
+    Activations[4].Parameters.HardSigmoid.beta = 0.5f;
+
+    for (const MLAS_ACTIVATION& Activation : Activations) {
+      for (bool UseBias : {false, true}) {
+        Test(1, 1, 1, Activation, UseBias, 1.0f, 0.0f);
+        Test(1, 37, 19, Activation, UseBias, 1.0f, 0.0f);
+        Test(5, 16, 64, Activation, UseBias, 0.5f, 1.0f);
+        Test(7, 13, 33, Activation, UseBias, 1.0f, 0.5f);
+        Test(17, 63, 257, Activation, UseBias, 2.0f, 0.0f);
+        Test(45, 300, 290, Activation, UseBias, 1.0f, 0.0f);
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSgemmJitTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasSgemmJitTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
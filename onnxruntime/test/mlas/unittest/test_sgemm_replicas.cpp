@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasSgemmReplicasTest : public MlasTestBase {
+ private:
+  // more than the NUMA nodes of any system running the tests
+  static constexpr size_t ReplicaCount = 64;
+
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<float> BufferZeroB;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<uint8_t> BufferPackedZeroB;
+  MatrixGuardBuffer<float> BufferC;
+  MLAS_THREADPOOL* threadpool_;
+
+  static void SmallFloatFill(float* start, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      start[i] = float(int((i * 37) % 17) - 8) / 16.0f;
+    }
+  }
+
+  static void ZeroFill(float* start, size_t size) {
+    std::fill_n(start, size, 0.0f);
+  }
+
+  void Test(size_t M, size_t N, size_t K) {
+    const float* A = BufferA.GetFilledBuffer(M * K, SmallFloatFill);
+    const float* B = BufferB.GetFilledBuffer(K * N, SmallFloatFill);
+    const float* ZeroB = BufferZeroB.GetFilledBuffer(K * N, ZeroFill);
+    float* C = BufferC.GetBuffer(M * N, true);
+
+    void* PackedB = BufferPackedB.GetBuffer(MlasGemmPackBSize(N, K), true);
+    MlasGemmPackB(CblasNoTrans, N, K, B, N, PackedB);
+    void* PackedZeroB = BufferPackedZeroB.GetBuffer(MlasGemmPackBSize(N, K), true);
+    MlasGemmPackB(CblasNoTrans, N, K, ZeroB, N, PackedZeroB);
+
+    // every thread reads the copy of its node in place of B
+    std::vector<const float*> Replicas(ReplicaCount, static_cast<const float*>(PackedB));
+
+    MLAS_SGEMM_DATA_PARAMS Data;
+    Data.A = A;
+    Data.lda = K;
+    Data.B = static_cast<const float*>(PackedZeroB);
+    Data.BIsPacked = true;
+    Data.C = C;
+    Data.ldc = N;
+    Data.BNodeReplicas = Replicas.data();
+    Data.BNodeReplicaCount = Replicas.size();
+
+    MlasGemm(CblasNoTrans, CblasNoTrans, M, N, K, Data, threadpool_);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double Reference = 0.0;
+        for (size_t k = 0; k < K; k++) {
+          Reference += double(A[m * K + k]) * double(B[k * N + n]);
+        }
+        ASSERT_NEAR(C[m * N + n], Reference, 1e-4 + std::fabs(Reference) * 1e-4)
+            << "@[" << m << "x" << n << "], M=" << M << ", N=" << N << ", K=" << K;
+      }
+    }
+  }
+
+ public:
+  MlasSgemmReplicasTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "SgemmReplicas_Threaded" : "SgemmReplicas_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    Test(1, 1, 1);
+    Test(7, 13, 33);
+    Test(45, 300, 290);
+    Test(128, 64, 256);
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSgemmReplicasTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasSgemmReplicasTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasSparseGemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<float> BufferC;
+  MLAS_THREADPOOL* threadpool_;
+
+  // Fills B with the blocks of BlockK x 4 elements that are kept one in Stride
+  // times, with the given transpose.
+  static void FillSparseB(float* B, CBLAS_TRANSPOSE TransB, size_t N, size_t K, size_t BlockK, size_t Stride) {
+    const size_t ldb = (TransB == CblasNoTrans) ? N : K;
+    std::fill_n(B, N * K, 0.0f);
+    for (size_t k = 0; k < K; k++) {
+      for (size_t n = 0; n < N; n++) {
+        const size_t Block = (n / 4) * 7 + (k / BlockK) * 3;
+        if (Block % Stride == 0) {
+          const float Value = float(int((k * 13 + n * 7) % 17) - 8) / 16.0f;
+          B[(TransB == CblasNoTrans) ? k * ldb + n : n * ldb + k] = Value;
+        }
+      }
+    }
+  }
+
+  void Test(CBLAS_TRANSPOSE TransB, size_t M, size_t N, size_t K, size_t BlockK, size_t Stride,
+            float alpha, float beta, bool UseEpilogue = false) {
+    float* A = BufferA.GetBuffer(M * K);
+    for (size_t i = 0; i < M * K; i++) {
+      A[i] = float(int((i * 11) % 15) - 7) / 8.0f;
+    }
+
+    float* B = BufferB.GetBuffer(N * K);
+    FillSparseB(B, TransB, N, K, BlockK, Stride);
+    const size_t ldb = (TransB == CblasNoTrans) ? N : K;
+
+    const size_t PackedBSize = MlasSparseGemmPackBSize(TransB, N, K, B, ldb);
+    ASSERT_NE(PackedBSize, size_t(0)) << "N=" << N << ", K=" << K << ", BlockK=" << BlockK << ", Stride=" << Stride;
+
+    void* PackedB = BufferPackedB.GetBuffer(PackedBSize, true);
+    MlasSparseGemmPackB(TransB, N, K, B, ldb, PackedB);
+
+    float* C = BufferC.GetBuffer(M * N);
+    std::vector<float> CInitial(C, C + M * N);
+
+    // The epilogue adds a bias and applies Relu to the output blocks.
+    std::vector<float> Bias(N);
+    for (size_t n = 0; n < N; n++) {
+      Bias[n] = float(int(n % 9) - 4) / 4.0f;
+    }
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = MlasReluActivation;
+    MLAS_SGEMM_EPILOGUE_PROCESSOR Epilogue(&Activation, Bias.data());
+
+    MLAS_SPARSE_SGEMM_DATA_PARAMS Data;
+    Data.A = A;
+    Data.lda = K;
+    Data.PackedB = PackedB;
+    Data.C = C;
+    Data.ldc = N;
+    Data.alpha = alpha;
+    Data.beta = beta;
+    Data.OutputProcessor = UseEpilogue ? &Epilogue : nullptr;
+    MlasSparseGemmBatch(M, N, K, &Data, 1, threadpool_);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double Sum = 0.0;
+        for (size_t k = 0; k < K; k++) {
+          const float b = (TransB == CblasNoTrans) ? B[k * ldb + n] : B[n * ldb + k];
+          Sum += double(A[m * K + k]) * double(b);
+        }
+        double Reference = alpha * Sum;
+        if (beta != 0.0f) {
+          Reference += beta * double(CInitial[m * N + n]);
+        }
+        if (UseEpilogue) {
+          Reference = std::max(Reference + Bias[n], 0.0);
+        }
+        ASSERT_NEAR(C[m * N + n], Reference, 1e-4 + std::fabs(Reference) * 1e-5)
+            << "@[" << m << "x" << n << "], M=" << M << ", N=" << N << ", K=" << K
+            << ", TransB=" << (TransB != CblasNoTrans) << ", BlockK=" << BlockK << ", Stride=" << Stride
+            << ", Epilogue=" << UseEpilogue;
+      }
+    }
+  }
+
+ public:
+  MlasSparseGemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "SparseGemm_Threaded" : "SparseGemm_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    // A dense matrix is declined.
+    std::vector<float> Dense(64 * 64, 1.0f);
+    EXPECT_EQ(MlasSparseGemmPackBSize(CblasNoTrans, 64, 64, Dense.data(), 64), size_t(0));
+
+    for (CBLAS_TRANSPOSE TransB : {CblasNoTrans, CblasTrans}) {
+      for (size_t BlockK : {size_t(1), size_t(4)}) {
+        for (size_t Stride : {size_t(5), size_t(10)}) {
+          Test(TransB, 1, 64, 64, BlockK, Stride, 1.0f, 0.0f);
+          Test(TransB, 3, 37, 45, BlockK, Stride, 1.0f, 0.0f);
+          Test(TransB, 16, 128, 255, BlockK, Stride, 0.5f, 1.0f);
+          Test(TransB, 33, 19, 130, BlockK, Stride, 1.0f, 0.5f);
+          Test(TransB, 100, 260, 96, BlockK, Stride, 2.0f, 0.0f);
+          Test(TransB, 9, 150, 64, BlockK, Stride, 1.0f, 0.0f, true);
+          Test(TransB, 2, 261, 33, BlockK, Stride, 1.0f, 1.0f, true);
+        }
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSparseGemmTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasSparseGemmTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
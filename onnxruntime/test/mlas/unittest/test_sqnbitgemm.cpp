@@ -26,6 +26,7 @@ template <size_t BlkBitWidth, size_t BlkLen>
 class MlasSQNBitGemmTest : public MlasTestBase {
  private:
   MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferDequantizedA;
   MatrixGuardBuffer<float> BufferB;
   MatrixGuardBuffer<uint8_t> BufferQuantBData;
   MatrixGuardBuffer<uint8_t> BufferQuantBZeroPoint;
@@ -46,6 +47,7 @@ class MlasSQNBitGemmTest : public MlasTestBase {
                 const float* Bias,
                 float* C,
                 size_t ldc,
+                MLAS_SQNBIT_COMPUTE_TYPE ComputeType,
                 MLAS_THREADPOOL* Threadpool) {
     MLAS_SQNBIT_GEMM_DATA_PARAMS params;
     params.A = A;
@@ -58,7 +60,32 @@ class MlasSQNBitGemmTest : public MlasTestBase {
     params.QuantBZeroPoint = QuantBZeroPoint;
     params.PostProcessor = nullptr;
 
-    MlasSQNBitGemmBatch(M, N, K, 1, BlkBitWidth, BlkLen, &params, Threadpool);
+    MlasSQNBitGemmBatch(M, N, K, 1, BlkBitWidth, BlkLen, ComputeType, &params, Threadpool);
+  }
+
+  // Quantizes each block of the rows of A to int8 the way the int8 compute type does, and dequantizes it back.
+  const float* QuantizeDequantizeA(size_t M, size_t K, const float* A) {
+    float* DequantizedA = BufferDequantizedA.GetBuffer(M * K);
+    for (size_t m = 0; m < M; m++) {
+      for (size_t k = 0; k < K; k += BlkLen) {
+        const size_t k_blk_len = std::min(K - k, BlkLen);
+        const float* a = A + m * K + k;
+        float* dequantized_a = DequantizedA + m * K + k;
+
+        float amax = 0.0f;
+        for (size_t kk = 0; kk < k_blk_len; kk++) {
+          amax = std::max(amax, std::abs(a[kk]));
+        }
+        const float scale = amax / 127.0f;
+        const float scale_reciprocal = (amax != 0.0f) ? 127.0f / amax : 0.0f;
+
+        for (size_t kk = 0; kk < k_blk_len; kk++) {
+          const float q = std::clamp(std::nearbyint(a[kk] * scale_reciprocal), -128.0f, 127.0f);
+          dequantized_a[kk] = q * scale;
+        }
+      }
+    }
+    return DequantizedA;
   }
 
   void CallReferenceGemm(size_t M,
@@ -94,7 +121,7 @@ class MlasSQNBitGemmTest : public MlasTestBase {
   }
 
  public:
-  void Test(size_t M, size_t N, size_t K,
+  void Test(size_t M, size_t N, size_t K, MLAS_SQNBIT_COMPUTE_TYPE ComputeType,
             bool WithBias, bool Symmetric, bool WithThreadpool) {
     MLAS_THREADPOOL* Threadpool = WithThreadpool ? GetMlasThreadPool() : nullptr;
 
@@ -150,8 +177,11 @@ class MlasSQNBitGemmTest : public MlasTestBase {
                                       GetMlasThreadPool());
     }
 
-    CallGemm(M, N, K, A, /* lda */ K, QuantBData, QuantBScale, QuantBZeroPoint, Bias, C, /* ldc */ N, Threadpool);
-    CallReferenceGemm(M, N, K, A, QuantBData, QuantBScale, QuantBZeroPoint, Bias, CReference);
+    CallGemm(M, N, K, A, /* lda */ K, QuantBData, QuantBScale, QuantBZeroPoint, Bias, C, /* ldc */ N, ComputeType,
+             Threadpool);
+    // the int8 compute type quantizes the single row of A of the tests that use it
+    const float* ReferenceA = (ComputeType == CompInt8) ? QuantizeDequantizeA(M, K, A) : A;
+    CallReferenceGemm(M, N, K, ReferenceA, QuantBData, QuantBScale, QuantBZeroPoint, Bias, CReference);
 
     size_t f = 0;
     for (size_t m = 0; m < M; m++) {
@@ -178,23 +208,30 @@ class MlasSQNBitGemmTest : public MlasTestBase {
 template <size_t BlkBitWidth, size_t BlkLen>
 class SQNBitGemmShortExecuteTest : public MlasTestFixture<MlasSQNBitGemmTest<BlkBitWidth, BlkLen>> {
  public:
-  explicit SQNBitGemmShortExecuteTest(size_t M, size_t N, size_t K,
+  explicit SQNBitGemmShortExecuteTest(size_t M, size_t N, size_t K, MLAS_SQNBIT_COMPUTE_TYPE ComputeType,
                                       bool WithThreadpool, bool Symmetric, bool WithBias)
-      : M_(M), N_(N), K_(K), WithThreadpool_(WithThreadpool), Symmetric_(Symmetric), WithBias_(WithBias) {
+      : M_(M),
+        N_(N),
+        K_(K),
+        ComputeType_(ComputeType),
+        WithThreadpool_(WithThreadpool),
+        Symmetric_(Symmetric),
+        WithBias_(WithBias) {
   }
 
   void TestBody() override {
     MlasTestFixture<MlasSQNBitGemmTest<BlkBitWidth, BlkLen>>::mlas_tester->Test(
-        M_, N_, K_, WithThreadpool_, Symmetric_, WithBias_);
+        M_, N_, K_, ComputeType_, WithThreadpool_, Symmetric_, WithBias_);
   }
 
-  static size_t RegisterSingleTest(size_t M, size_t N, size_t K,
+  static size_t RegisterSingleTest(size_t M, size_t N, size_t K, MLAS_SQNBIT_COMPUTE_TYPE ComputeType,
                                    bool WithThreadpool, bool Symmetric, bool WithBias) {
     std::stringstream ss;
     ss << (WithThreadpool ? "SingleThread" : "Threaded")
        << "/isSymmetric" << Symmetric
        << "/M" << M << "xN" << N << "xK" << K
-       << "/hasBias" << WithBias;
+       << "/hasBias" << WithBias
+       << "/computeType" << ComputeType;
     auto test_name = ss.str();
 
     testing::RegisterTest(
@@ -207,7 +244,7 @@ class SQNBitGemmShortExecuteTest : public MlasTestFixture<MlasSQNBitGemmTest<Blk
         // Important to use the fixture type as the return type here.
         [=]() -> MlasTestFixture<MlasSQNBitGemmTest<BlkBitWidth, BlkLen>>* {
           return new SQNBitGemmShortExecuteTest(
-              M, N, K, WithThreadpool, Symmetric, WithBias);
+              M, N, K, ComputeType, WithThreadpool, Symmetric, WithBias);
         });
 
     return 1;
@@ -216,28 +253,43 @@ class SQNBitGemmShortExecuteTest : public MlasTestFixture<MlasSQNBitGemmTest<Blk
   static size_t RegisterShortExecuteTests() {
     size_t test_registered = 0;
 
-    if (MlasIsSQNBitGemmAvailable(BlkBitWidth, BlkLen)) {
+    if (MlasIsSQNBitGemmAvailable(BlkBitWidth, BlkLen, CompFp32)) {
       for (bool WithThreadpool : {false, true}) {
         for (bool Symmetric : {false, true}) {
           for (size_t b = 1; b < 16; b++) {
-            test_registered += RegisterSingleTest(b, b, b, WithThreadpool, Symmetric, false);
-            test_registered += RegisterSingleTest(b, b, b, WithThreadpool, Symmetric, true);
+            test_registered += RegisterSingleTest(b, b, b, CompFp32, WithThreadpool, Symmetric, false);
+            test_registered += RegisterSingleTest(b, b, b, CompFp32, WithThreadpool, Symmetric, true);
           }
           for (size_t b = 16; b <= 256; b <<= 1) {
-            test_registered += RegisterSingleTest(b, b, b, WithThreadpool, Symmetric, false);
-            test_registered += RegisterSingleTest(b, b, b, WithThreadpool, Symmetric, true);
+            test_registered += RegisterSingleTest(b, b, b, CompFp32, WithThreadpool, Symmetric, false);
+            test_registered += RegisterSingleTest(b, b, b, CompFp32, WithThreadpool, Symmetric, true);
           }
           for (size_t b = 256; b < 320; b += 32) {
-            test_registered += RegisterSingleTest(b, b, b, WithThreadpool, Symmetric, true);
+            test_registered += RegisterSingleTest(b, b, b, CompFp32, WithThreadpool, Symmetric, true);
           }
           for (size_t b = 1; b < 96; b++) {
-            test_registered += RegisterSingleTest(1, b, 32, WithThreadpool, Symmetric, false);
-            test_registered += RegisterSingleTest(1, 32, b, WithThreadpool, Symmetric, true);
-            test_registered += RegisterSingleTest(1, b, b, WithThreadpool, Symmetric, false);
+            test_registered += RegisterSingleTest(1, b, 32, CompFp32, WithThreadpool, Symmetric, false);
+            test_registered += RegisterSingleTest(1, 32, b, CompFp32, WithThreadpool, Symmetric, true);
+            test_registered += RegisterSingleTest(1, b, b, CompFp32, WithThreadpool, Symmetric, false);
           }
-          test_registered += RegisterSingleTest(43, 500, 401, WithThreadpool, Symmetric, true);
+          test_registered += RegisterSingleTest(43, 500, 401, CompFp32, WithThreadpool, Symmetric, true);
 
-          // test_registered += RegisterSingleTest(1001, 1027, 1031, WithThreadpool, Symmetric, false);
+          // test_registered += RegisterSingleTest(1001, 1027, 1031, CompFp32, WithThreadpool, Symmetric, false);
+        }
+      }
+    }
+
+    // the int8 compute type quantizes A for a single row, the larger M are computed in fp32
+    if (MlasIsSQNBitGemmAvailable(BlkBitWidth, BlkLen, CompInt8)) {
+      for (bool WithThreadpool : {false, true}) {
+        for (bool Symmetric : {false, true}) {
+          for (size_t b = 1; b < 96; b++) {
+            test_registered += RegisterSingleTest(1, b, 32, CompInt8, WithThreadpool, Symmetric, false);
+            test_registered += RegisterSingleTest(1, 32, b, CompInt8, WithThreadpool, Symmetric, true);
+            test_registered += RegisterSingleTest(1, b, b, CompInt8, WithThreadpool, Symmetric, false);
+          }
+          test_registered += RegisterSingleTest(1, 500, 401, CompInt8, WithThreadpool, Symmetric, true);
+          test_registered += RegisterSingleTest(1, 1024, 4096, CompInt8, WithThreadpool, Symmetric, false);
         }
       }
     }
@@ -247,6 +299,7 @@ class SQNBitGemmShortExecuteTest : public MlasTestFixture<MlasSQNBitGemmTest<Blk
 
  private:
   size_t M_, N_, K_;
+  MLAS_SQNBIT_COMPUTE_TYPE ComputeType_;
   bool WithThreadpool_, Symmetric_, WithBias_;
 };
 
@@ -0,0 +1,127 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_fp16.h"
+
+class MlasUnaryActivationTest : public MlasTestBase {
+ private:
+  enum Kind {
+    Gelu,
+    FastGelu,
+    Swish,
+    Softplus,
+  };
+
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferOutput;
+
+  static double Reference(Kind kind, double x, double Alpha) {
+    switch (kind) {
+      case Gelu:
+        return 0.5 * x * (1.0 + std::erf(x * 0.7071067811865476));
+      case FastGelu:
+        return 0.5 * x * (1.0 + std::tanh(0.7978845608028654 * (x + 0.044715 * x * x * x)));
+      case Swish:
+        return x / (1.0 + std::exp(-Alpha * x));
+      default:
+        return std::max(x, 0.0) + std::log1p(std::exp(-std::fabs(x)));
+    }
+  }
+
+  template <typename T>
+  static void Compute(Kind kind, const T* Input, T* Output, size_t N, float Alpha) {
+    switch (kind) {
+      case Gelu:
+        MlasComputeGelu(Input, Output, N);
+        break;
+      case FastGelu:
+        MlasComputeFastGelu(Input, Output, N);
+        break;
+      case Swish:
+        MlasComputeSwish(Input, Output, N, Alpha);
+        break;
+      default:
+        MlasComputeSoftplus(Input, Output, N);
+        break;
+    }
+  }
+
+  void Test(Kind kind, size_t N, float Range, float Alpha, bool InPlace) {
+    float* Input = BufferInput.GetBuffer(N);
+    float* Output = InPlace ? Input : BufferOutput.GetBuffer(N, true);
+
+    std::default_random_engine generator(static_cast<unsigned>(N));
+    std::uniform_real_distribution<float> distribution(-Range, Range);
+
+    for (size_t n = 0; n < N; n++) {
+      Input[n] = distribution(generator);
+    }
+
+    std::vector<float> InputCopy(Input, Input + N);
+
+    Compute(kind, Input, Output, N, Alpha);
+
+    for (size_t n = 0; n < N; n++) {
+      const double Expected = Reference(kind, InputCopy[n], Alpha);
+      ASSERT_NEAR(Output[n], Expected, 1e-5 + std::fabs(Expected) * 1e-5)
+          << "@" << n << ", x=" << InputCopy[n] << ", N=" << N << ", Kind=" << int(kind)
+          << ", Alpha=" << Alpha << ", InPlace=" << InPlace;
+    }
+  }
+
+  void TestHalf(Kind kind, size_t N, float Alpha) {
+    std::vector<MLFp16> Input(N), Output(N);
+
+    std::default_random_engine generator(static_cast<unsigned>(N));
+    std::uniform_real_distribution<float> distribution(-6.0f, 6.0f);
+
+    for (size_t n = 0; n < N; n++) {
+      Input[n] = MLFp16(distribution(generator));
+    }
+
+    Compute(kind, reinterpret_cast<const MLAS_FP16*>(Input.data()), reinterpret_cast<MLAS_FP16*>(Output.data()),
+            N, Alpha);
+
+    for (size_t n = 0; n < N; n++) {
+      const double Expected = Reference(kind, Input[n].ToFloat(), Alpha);
+      ASSERT_NEAR(Output[n].ToFloat(), Expected, 2e-3 + std::fabs(Expected) * 2e-3)
+          << "@" << n << ", N=" << N << ", Kind=" << int(kind);
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("UnaryActivation");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (Kind kind : {Gelu, FastGelu, Swish, Softplus}) {
+      const float Alpha = (kind == Swish) ? 1.702f : 1.0f;
+
+      for (size_t n = 1; n < 40; n++) {
+        Test(kind, n, 6.0f, Alpha, false);
+        Test(kind, n, 6.0f, Alpha, true);
+      }
+
+      for (size_t n : {255, 256, 257, 1000, 4099}) {
+        Test(kind, n, 6.0f, Alpha, false);
+        Test(kind, n, 6.0f, Alpha, true);
+        // The saturated range of the gates.
+        Test(kind, n, 60.0f, Alpha, false);
+        TestHalf(kind, n, Alpha);
+      }
+    }
+
+    // SiLU.
+    Test(Swish, 1000, 6.0f, 1.0f, false);
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasUnaryActivationTest>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -17,10 +17,14 @@
 #include <core/session/onnxruntime_cxx_api.h>
 #include <core/session/ort_env.h>
 #include <core/util/thread_utils.h>
+#include "core/mlas/inc/mlas.h"
 
 #include <iostream>
+#include <string_view>
 #include <unordered_map>
 
+#include "model_ops.h"
+
 const OrtApi* g_ort = OrtGetApiBase()->GetApi(ORT_API_VERSION);
 OrtEnv* env = nullptr;
 
@@ -75,10 +79,33 @@ BENCHMARK(BM_ResolveGraph);
   } while (0);
 
 int main(int argc, char** argv) {
+  // --model_ops=<model> adds the benchmarks of the kernel calls of the model, run on --model_ops_provider=<cpu|cuda>.
+  // The flags are removed before the benchmark library parses the others.
+  std::string model_ops_path;
+  std::string model_ops_provider = "cpu";
+  int benchmark_argc = 1;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg(argv[i]);
+    if (arg.rfind("--model_ops=", 0) == 0) {
+      model_ops_path = arg.substr(sizeof("--model_ops=") - 1);
+    } else if (arg.rfind("--model_ops_provider=", 0) == 0) {
+      model_ops_provider = arg.substr(sizeof("--model_ops_provider=") - 1);
+    } else {
+      argv[benchmark_argc++] = argv[i];
+    }
+  }
+  argc = benchmark_argc;
+
   ::benchmark::Initialize(&argc, argv);
   if (::benchmark::ReportUnrecognizedArguments(argc, argv))
     return -1;
+  // the MLAS kernels the CPU kernels dispatch to on this processor
+  ::benchmark::AddCustomContext("mlas_kernel_isa", MlasGetKernelIsa());
   ORT_ABORT_ON_ERROR(g_ort->CreateEnv(ORT_LOGGING_LEVEL_ERROR, "test", &env));
+  if (!model_ops_path.empty() && !RegisterModelOpBenchmarks(model_ops_path, model_ops_provider)) {
+    g_ort->ReleaseEnv(env);
+    return -1;
+  }
   ::benchmark::RunSpecifiedBenchmarks();
   g_ort->ReleaseEnv(env);
   return 0;
@@ -0,0 +1,289 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "model_ops.h"
+
+#include <benchmark/benchmark.h>
+#include <core/common/path_string.h>
+#include <core/framework/data_types.h>
+#include <core/framework/float16.h>
+#include <core/framework/tensor_shape.h>
+#include <core/framework/tensorprotoutils.h>
+#include <core/graph/model.h>
+#include <core/session/onnxruntime_cxx_api.h>
+#include <core/session/ort_env.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <unordered_set>
+
+extern OrtEnv* env;
+
+using namespace onnxruntime;
+
+namespace {
+
+struct ModelOp {
+  std::string name;
+  // the one-node model, with the constant initializers of the node
+  std::string model;
+  // the other inputs of the node, fed with random data
+  std::vector<std::string> input_names;
+  std::vector<std::vector<int64_t>> input_shapes;
+  std::vector<ONNXTensorElementDataType> input_types;
+  std::vector<std::string> output_names;
+  size_t input_bytes = 0;
+  // the nodes of the model calling the kernel with these inputs
+  int64_t num_nodes = 0;
+};
+
+size_t ElementSize(int32_t elem_type) {
+  return DataTypeImpl::TensorTypeFromONNXEnum(elem_type)->GetElementType()->Size();
+}
+
+// the element type and static shape of a tensor input, or false if it isn't one
+bool GetStaticShape(const NodeArg& arg, int32_t& elem_type, std::vector<int64_t>& shape) {
+  const auto* type = arg.TypeAsProto();
+  if (type == nullptr || !type->has_tensor_type() || arg.Shape() == nullptr ||
+      type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+    return false;
+  }
+  elem_type = type->tensor_type().elem_type();
+  shape.clear();
+  for (const auto& dim : arg.Shape()->dim()) {
+    if (!utils::HasDimValue(dim)) {
+      return false;
+    }
+    shape.push_back(dim.dim_value());
+  }
+  return true;
+}
+
+std::string ToString(int32_t elem_type, const std::vector<int64_t>& shape) {
+  std::ostringstream ss;
+  ss << ONNX_NAMESPACE::TensorProto_DataType_Name(static_cast<ONNX_NAMESPACE::TensorProto_DataType>(elem_type))
+     << "[";
+  for (size_t i = 0; i < shape.size(); ++i) {
+    ss << (i > 0 ? "," : "") << shape[i];
+  }
+  ss << "]";
+  return ss.str();
+}
+
+// The benchmark of a node, or nullopt if its inputs don't all have static shapes. key identifies the kernel call:
+// the name with the attributes.
+std::optional<ModelOp> MakeModelOp(const Model& model, const Node& node, std::string& key) {
+  const Graph& graph = model.MainGraph();
+  if (node.ContainsSubgraph()) {
+    return std::nullopt;
+  }
+
+  ModelOp op;
+  ONNX_NAMESPACE::ModelProto model_proto;
+  model_proto.set_ir_version(model.IrVersion());
+  for (const auto& [domain, version] : graph.DomainToVersionMap()) {
+    auto* opset = model_proto.add_opset_import();
+    opset->set_domain(domain);
+    opset->set_version(version);
+  }
+  auto* graph_proto = model_proto.mutable_graph();
+  graph_proto->set_name(node.OpType());
+  node.ToProto(*graph_proto->add_node());
+
+  op.name = "ModelOp/" + (node.Domain().empty() ? "" : node.Domain() + ".") + node.OpType() + "/";
+  std::unordered_set<std::string> added;
+  bool first = true;
+  for (const NodeArg* input : node.InputDefs()) {
+    op.name += first ? "" : "x";
+    first = false;
+    if (!input->Exists()) {
+      op.name += "none";
+      continue;
+    }
+
+    int32_t elem_type;
+    std::vector<int64_t> shape;
+    const auto* initializer = graph.GetConstantInitializer(input->Name(), true);
+    if (initializer != nullptr) {
+      elem_type = initializer->data_type();
+      shape.assign(initializer->dims().begin(), initializer->dims().end());
+    } else if (!GetStaticShape(*input, elem_type, shape)) {
+      return std::nullopt;
+    }
+    op.name += ToString(elem_type, shape);
+    op.input_bytes += static_cast<size_t>(std::max<int64_t>(0, TensorShape(shape).Size())) *
+                      (elem_type == ONNX_NAMESPACE::TensorProto_DataType_STRING ? 0 : ElementSize(elem_type));
+
+    // an input used twice is added once
+    if (!added.insert(input->Name()).second) {
+      continue;
+    }
+    if (initializer != nullptr) {
+      auto& copy = *graph_proto->add_initializer() = *initializer;
+      if (utils::HasExternalData(copy)) {
+        std::vector<uint8_t> data;
+        if (!utils::UnpackInitializerData(*initializer, graph.ModelPath(), data).IsOK()) {
+          return std::nullopt;
+        }
+        copy.clear_external_data();
+        copy.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_DEFAULT);
+        copy.set_raw_data(data.data(), data.size());
+      }
+    } else {
+      *graph_proto->add_input() = input->ToProto();
+      op.input_names.push_back(input->Name());
+      op.input_shapes.push_back(std::move(shape));
+      op.input_types.push_back(static_cast<ONNXTensorElementDataType>(elem_type));
+    }
+  }
+
+  for (const NodeArg* output : node.OutputDefs()) {
+    if (!output->Exists()) {
+      continue;
+    }
+    const auto* type = output->TypeAsProto();
+    if (type == nullptr || !type->has_tensor_type()) {
+      return std::nullopt;
+    }
+    auto* value_info = graph_proto->add_output();
+    value_info->set_name(output->Name());
+    value_info->mutable_type()->mutable_tensor_type()->set_elem_type(type->tensor_type().elem_type());
+    op.output_names.push_back(output->Name());
+  }
+
+  key = op.name;
+  std::map<std::string, const ONNX_NAMESPACE::AttributeProto*> attributes;
+  for (const auto& [name, attribute] : node.GetAttributes()) {
+    attributes.emplace(name, &attribute);
+  }
+  for (const auto& [name, attribute] : attributes) {
+    key += "|" + name + "=" + attribute->SerializeAsString();
+  }
+
+  model_proto.SerializeToString(&op.model);
+  return op;
+}
+
+Ort::Value CreateRandomInput(const std::vector<int64_t>& shape, ONNXTensorElementDataType type, std::mt19937& gen) {
+  Ort::AllocatorWithDefaultOptions allocator;
+  Ort::Value value = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), type);
+  const size_t count = value.GetTensorTypeAndShapeInfo().GetElementCount();
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  switch (type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+      std::generate_n(value.GetTensorMutableData<float>(), count, [&]() { return dist(gen); });
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+      std::generate_n(value.GetTensorMutableData<double>(), count, [&]() { return dist(gen); });
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+      std::generate_n(value.GetTensorMutableData<MLFloat16>(), count, [&]() { return MLFloat16(dist(gen)); });
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+      std::generate_n(value.GetTensorMutableData<BFloat16>(), count, [&]() { return BFloat16(dist(gen)); });
+      break;
+    default:
+      // indices, axes and counts in range
+      std::memset(value.GetTensorMutableRawData(), 0, count * ElementSize(type));
+      break;
+  }
+  return value;
+}
+
+void BM_ModelOp(benchmark::State& state, const ModelOp& op, const std::string& provider) {
+  try {
+    // the environment created by main, the OrtEnv being a singleton
+    Ort::Env ort_env(ORT_LOGGING_LEVEL_ERROR, "test");
+    Ort::SessionOptions options;
+    // keep the node from being constant folded or fused
+    options.SetGraphOptimizationLevel(ORT_DISABLE_ALL);
+    if (provider == "cuda") {
+      options.AppendExecutionProvider_CUDA(OrtCUDAProviderOptions{});
+    }
+    Ort::Session session(ort_env, op.model.data(), op.model.size(), options);
+
+    // the inputs are copied to the device when they are bound, and the outputs stay on it, so only the kernel runs
+    Ort::IoBinding binding(session);
+    std::mt19937 gen(0);
+    for (size_t i = 0; i < op.input_names.size(); ++i) {
+      binding.BindInput(op.input_names[i].c_str(), CreateRandomInput(op.input_shapes[i], op.input_types[i], gen));
+    }
+    Ort::MemoryInfo output_location = provider == "cuda"
+                                          ? Ort::MemoryInfo("Cuda", OrtDeviceAllocator, 0, OrtMemTypeDefault)
+                                          : Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
+    for (const auto& name : op.output_names) {
+      binding.BindOutput(name.c_str(), output_location);
+    }
+
+    Ort::RunOptions run_options;
+    // warm up, also reporting the op which can't run with these inputs before the timing
+    session.Run(run_options, binding);
+    for (auto _ : state) {
+      session.Run(run_options, binding);
+    }
+  } catch (const Ort::Exception& e) {
+    state.SkipWithError(e.what());
+    return;
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * op.input_bytes));
+  state.counters["nodes"] = static_cast<double>(op.num_nodes);
+}
+
+}  // namespace
+
+bool RegisterModelOpBenchmarks(const std::string& model_path, const std::string& provider) {
+  if (provider != "cpu" && provider != "cuda") {
+    std::cerr << "Unknown provider for the model op benchmarks: " << provider << std::endl;
+    return false;
+  }
+
+  auto logger = env->GetLoggingManager()->CreateLogger("test");
+  std::shared_ptr<Model> model;
+  auto st = Model::Load(ToPathString(model_path), model, nullptr, *logger);
+  if (!st.IsOK()) {
+    std::cerr << "Parse model failed: " << st.ErrorMessage() << std::endl;
+    return false;
+  }
+
+  // in the order of the graph, numbering the calls of the same name with different attributes
+  const Graph& graph = model->MainGraph();
+  std::vector<std::shared_ptr<ModelOp>> ops;
+  std::unordered_map<std::string, std::shared_ptr<ModelOp>> ops_by_key;
+  std::unordered_map<std::string, int> num_ops_by_name;
+  size_t num_skipped = 0;
+  for (const auto& node : graph.Nodes()) {
+    std::string key;
+    auto op = MakeModelOp(*model, node, key);
+    if (!op.has_value()) {
+      ++num_skipped;
+      continue;
+    }
+    auto& existing = ops_by_key[key];
+    if (existing == nullptr) {
+      const int index = num_ops_by_name[op->name]++;
+      if (index > 0) {
+        op->name += "/" + std::to_string(index);
+      }
+      existing = std::make_shared<ModelOp>(std::move(*op));
+      ops.push_back(existing);
+    }
+    ++existing->num_nodes;
+  }
+
+  for (const auto& op : ops) {
+    benchmark::RegisterBenchmark(op->name.c_str(), [op, provider](benchmark::State& state) {
+      BM_ModelOp(state, *op, provider);
+    })->Unit(benchmark::kMicrosecond)->UseRealTime();
+  }
+  if (num_skipped > 0) {
+    std::cerr << num_skipped << " nodes without static input shapes or with subgraphs are not benchmarked"
+              << std::endl;
+  }
+  return true;
+}
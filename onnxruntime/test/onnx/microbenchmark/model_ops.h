@@ -0,0 +1,18 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+// Registers a benchmark of each kernel call of the model at model_path, so kernel regressions can be measured on the
+// shapes of real models. The nodes with the same op, input shapes, element types and attributes share a benchmark,
+// named "ModelOp/<op>/<input types and shapes>", which runs the node alone in a one-node model on provider ("cpu" or
+// "cuda"). Only nodes whose inputs have static shapes are benchmarked.
+//
+// The constant initializers of the node are kept, its other inputs are random, or zeros for integer inputs so that
+// indices stay in range. Run with --benchmark_format=json or --benchmark_out=<file> to compare the kernels across
+// commits, e.g. with the compare.py tool of Google Benchmark.
+//
+// Must be called after the OrtEnv is created. Returns false if the model can't be loaded.
+bool RegisterModelOpBenchmarks(const std::string& model_path, const std::string& provider);
@@ -39,12 +39,14 @@
 #include "core/optimizer/div_mul_fusion.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_chain_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
 #include "core/optimizer/gather_fusion.h"
 #include "core/optimizer/gelu_approximation.h"
 #include "core/optimizer/gelu_fusion.h"
 #include "core/optimizer/gemm_activation_fusion.h"
+#include "core/optimizer/gemm_float8_fusion.h"
 #include "core/optimizer/gemm_sum_fusion.h"
 #include "core/optimizer/gemm_transpose_fusion.h"
 #include "core/optimizer/graph_transformer.h"
@@ -58,13 +60,16 @@
 #include "core/optimizer/matmul_integer_to_float.h"
 #include "core/optimizer/matmul_scale_fusion.h"
 #include "core/optimizer/matmul_transpose_fusion.h"
+#include "core/optimizer/mixed_precision_conversion.h"
 #include "core/optimizer/noop_elimination.h"
 #include "core/optimizer/not_where_fusion.h"
+#include "core/optimizer/packing_mode_conversion.h"
 #include "core/optimizer/propagate_cast_ops.h"
 #include "core/optimizer/quick_gelu_fusion.h"
 #include "core/optimizer/relu_clip_fusion.h"
 #include "core/optimizer/reshape_fusion.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
+#include "core/optimizer/scaler_fusion.h"
 #include "core/optimizer/slice_elimination.h"
 #include "core/optimizer/unsqueeze_elimination.h"
 #include "core/optimizer/utils.h"
@@ -1004,6 +1009,42 @@ TEST_F(GraphTransformationTests, ConstantFoldingAShapeNodeDeepInTheGraph) {
   ASSERT_TRUE(op_to_count.size() == 0U);
 }
 
+// Test that a folded value is removed once the nodes reading it are folded, and that an Expand whose output is much
+// larger than its inputs is not folded.
+TEST_F(GraphTransformationTests, ConstantFoldingSkipsLargeOutputs) {
+  Model model("ConstantFoldingSkipsLargeOutputs", false, ModelMetaData(), PathString(),
+              IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}}, {}, *logger_);
+  Graph& graph = model.MainGraph();
+  ModelTestBuilder builder(graph);
+
+  auto* input_arg = builder.MakeInput<float>({1024, 1024}, -1.f, 1.f);
+  auto* value_arg = builder.MakeInitializer<float>({1}, {1.f});
+  auto* shape_arg = builder.MakeInitializer<int64_t>({2}, {1024, 1024});
+  auto* neg_out = builder.MakeIntermediate();
+  auto* abs_out = builder.MakeIntermediate();
+  auto* expand_out = builder.MakeIntermediate();
+  auto* output_arg = builder.MakeOutput();
+  builder.AddNode("Neg", {value_arg}, {neg_out});
+  builder.AddNode("Abs", {neg_out}, {abs_out});
+  builder.AddNode("Expand", {abs_out, shape_arg}, {expand_out});
+  builder.AddNode("Add", {input_arg, expand_out}, {output_arg});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::unique_ptr<CPUExecutionProvider> e =
+      std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+  bool modified = false;
+  ConstantFolding constant_folding(*e.get(), false /*skip_dequantize_linear*/);
+  ASSERT_STATUS_OK(constant_folding.Apply(graph, modified, *logger_));
+  ASSERT_TRUE(modified);
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["Neg"], 0);
+  ASSERT_EQ(op_to_count["Abs"], 0);
+  ASSERT_EQ(op_to_count["Expand"], 1);
+  ASSERT_FALSE(graph.IsInitializedTensor(neg_out->Name()));
+  ASSERT_TRUE(graph.IsInitializedTensor(abs_out->Name()));
+}
+
 // Test we don't fail when constant folding hits a string initializer
 TEST_F(GraphTransformationTests, ConstantFoldingStringInitializer) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "gh_issue_17392.onnx";
@@ -1927,18 +1968,8 @@ TEST_F(GraphTransformationTests, FuseCudaConvAddRelu) {
   ASSERT_TRUE(op_to_count["Relu"] == 0);  // Relu removed from graph
 }
 
-// Currently the ConvAddRelu fusion is only backed by a float kernel for the
-// the CUDA EP.
-
-// When we see the corresponding pattern for the fp16 data type, the fusion
-// should not be triggered as there is no kernel to back the fused pattern.
-
-// TODO(hasesh): Limit the test to using the CUDA EP for now as the level of
-// data type support in other compatible EPs is still yet to be ascertained.
-
-// TODO(hasesh): If at all the fp16 type is supported for the fusion, adjust/remove
-// this test.
-TEST_F(GraphTransformationTests, FuseCudaConvAddRelu_UnsupportedType) {
+// The CUDA EP has float16 kernels for FusedConv too.
+TEST_F(GraphTransformationTests, FuseCudaConvAddRelu_Float16) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "fusion/conv_add_relu_fp16.onnx";
   std::shared_ptr<Model> p_model;
   ASSERT_STATUS_OK(Model::Load(model_uri, p_model, nullptr, *logger_));
@@ -1954,8 +1985,8 @@ TEST_F(GraphTransformationTests, FuseCudaConvAddRelu_UnsupportedType) {
       std::make_unique<ConvActivationFusion>(), TransformerLevel::Level2));
   ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2, *logger_));
   op_to_count = CountOpsInGraph(graph);
-  ASSERT_EQ(op_to_count["Add"], 1);   // Add not removed from graph (fusion not triggered)
-  ASSERT_EQ(op_to_count["Relu"], 1);  // Relu not removed from graph (fusion not triggered)
+  ASSERT_EQ(op_to_count["Add"], 0);   // Add removed from graph
+  ASSERT_EQ(op_to_count["Relu"], 0);  // Relu removed from graph
 }
 
 // Conv->Add->Relu will be left intact since there is Identity depend on Add
@@ -1980,7 +2011,7 @@ TEST_F(GraphTransformationTests, FuseCudaConvAddReluIdentity) {
   ASSERT_TRUE(op_to_count["Identity"] == 1);  // Identity remains
 }
 
-// Conv->Add will be left intact since there is no Relu follows
+// Conv->Add will be transformed to FusedConv with the residual as Z and no activation
 TEST_F(GraphTransformationTests, FuseCudaConvAdd) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "fusion/conv_add.onnx";
   std::shared_ptr<Model> p_model;
@@ -1995,7 +2026,57 @@ TEST_F(GraphTransformationTests, FuseCudaConvAdd) {
   ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<ConvActivationFusion>(), TransformerLevel::Level2));
   ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2, *logger_));
   op_to_count = CountOpsInGraph(graph);
-  ASSERT_TRUE(op_to_count["Add"] == 1);  // Add remains, no transform applied to the graph
+  ASSERT_TRUE(op_to_count["Add"] == 0);  // Add removed from graph
+}
+
+// Conv->Add->Sigmoid in NHWC, and Conv->Add whose other input is broadcast, which isn't fused.
+TEST_F(GraphTransformationTests, FuseCudaNhwcConvAddActivation) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<MLFloat16>({1, 8, 8, 3}, MLFloat16(-1.0f), MLFloat16(1.0f));
+    auto* residual_arg = builder.MakeInput<MLFloat16>({1, 8, 8, 4}, MLFloat16(-1.0f), MLFloat16(1.0f));
+    auto* conv_out = builder.MakeIntermediate();
+    auto* add_out = builder.MakeIntermediate();
+    auto* conv2_out = builder.MakeIntermediate();
+    auto* weight_arg = builder.MakeInitializer<MLFloat16>({4, 3, 3, 3}, MLFloat16(-1.0f), MLFloat16(1.0f));
+    auto* bias_arg = builder.MakeInitializer<MLFloat16>({4}, MLFloat16(-1.0f), MLFloat16(1.0f));
+
+    auto& conv_node = builder.AddNode("NhwcConv", {input_arg, weight_arg, bias_arg}, {conv_out}, kMSDomain);
+    conv_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+    builder.AddNode("Add", {conv_out, residual_arg}, {add_out});
+    builder.AddNode("Sigmoid", {add_out}, {builder.MakeOutput()});
+
+    auto& conv2_node = builder.AddNode("NhwcConv", {input_arg, weight_arg, bias_arg}, {conv2_out}, kMSDomain);
+    conv2_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+    builder.AddNode("Add", {conv2_out, builder.MakeInitializer<MLFloat16>({4}, MLFloat16(-1.0f), MLFloat16(1.0f))},
+                    {builder.MakeOutput()});
+  };
+
+  auto pre_graph_checker = [](Graph& graph) {
+    for (auto& node : graph.Nodes()) {
+      node.SetExecutionProviderType(kCudaExecutionProvider);
+    }
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.NhwcFusedConv"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.NhwcConv"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["Add"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["Sigmoid"] == 0);
+
+    for (auto& node : graph.Nodes()) {
+      if (node.OpType() == "NhwcFusedConv") {
+        TEST_RETURN_IF_NOT(node.InputDefs().size() == 4);
+        TEST_RETURN_IF_NOT(node.GetAttributes().at("activation").s() == "Sigmoid");
+      }
+    }
+    return Status::OK();
+  };
+
+  std::unique_ptr<GraphTransformer> transformer = std::make_unique<ConvActivationFusion>();
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::move(transformer),
+                                        TransformerLevel::Level2, 1, pre_graph_checker, post_graph_checker));
 }
 
 #endif
@@ -2101,7 +2182,8 @@ TEST_F(GraphTransformationTests, FuseConvActivation) {
 
     std::map<std::string, int> op_to_count_after_fusion = CountOpsInGraph(graph);
 #if defined(USE_CUDA) || defined(USE_ROCM)
-    std::set<std::string> cuda_rocm_supported = {"Relu"};
+    // The nodes are assigned to the CUDA EP in both builds.
+    std::set<std::string> cuda_rocm_supported = {"Relu", "Clip", "Sigmoid", "Tanh", "LeakyRelu"};
     if (cuda_rocm_supported.find(model.second) == cuda_rocm_supported.end()) {
       ASSERT_EQ(op_to_count_before_fusion[model.second], op_to_count_after_fusion[model.second]);
     } else {
@@ -2653,6 +2735,32 @@ TEST_F(GraphTransformationTests, Gemm_LeakyRelu_Fusion) {
   ASSERT_TRUE(op_to_count["Gemm"] == 0);
   ASSERT_TRUE(op_to_count["com.microsoft.FusedGemm"] == 1);
 }
+
+TEST_F(GraphTransformationTests, Gemm_Gelu_Fusion) {
+  for (const char* activation : {"Gelu", "FastGelu"}) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({{4, 8}});
+      auto* weight_arg = builder.MakeInitializer<float>({8, 16}, -1.0f, 1.0f);
+      auto* bias_arg = builder.MakeInitializer<float>({16}, -1.0f, 1.0f);
+      auto* gemm_out = builder.MakeIntermediate();
+      auto* output_arg = builder.MakeOutput();
+
+      builder.AddNode("Gemm", {input_arg, weight_arg, bias_arg}, {gemm_out});
+      builder.AddNode(activation, {gemm_out}, {output_arg}, kMSDomain);
+    };
+
+    auto post_graph_checker = [&](Graph& graph) {
+      auto op_to_count = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_to_count["Gemm"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count[std::string("com.microsoft.") + activation] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["com.microsoft.FusedGemm"] == 1);
+      return Status::OK();
+    };
+
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::make_unique<GemmActivationFusion>(),
+                                          TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+  }
+}
 #endif
 
 // (A')'B' = AB'
@@ -5150,6 +5258,356 @@ TEST_F(GraphTransformationTests, QuickGelu) {
   }
 }
 
+TEST_F(GraphTransformationTests, ElementwiseChainFusion) {
+  // Sub(Mul(Relu(Add(x, bias)), x), 1), where the output of Relu is a graph output in the second case.
+  for (bool relu_is_graph_output : {false, true}) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({{2, 3, 4}});
+      auto* bias_arg = builder.MakeInitializer<float>({4}, {0.1f, 0.2f, 0.3f, 0.4f});
+      auto* one_arg = builder.MakeInitializer<float>({}, {1.0f});
+      auto* add_out = builder.MakeIntermediate();
+      auto* relu_out = relu_is_graph_output ? builder.MakeOutput() : builder.MakeIntermediate();
+      auto* mul_out = builder.MakeIntermediate();
+      auto* sub_out = builder.MakeOutput();
+
+      builder.AddNode("Add", {input_arg, bias_arg}, {add_out});
+      builder.AddNode("Relu", {add_out}, {relu_out});
+      builder.AddNode("Mul", {relu_out, input_arg}, {mul_out});
+      builder.AddNode("Sub", {mul_out, one_arg}, {sub_out});
+    };
+
+    auto post_graph_checker = [&](Graph& graph) {
+      auto op_to_count = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_to_count["Add"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["Relu"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["Mul"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["Sub"] == 0);
+      // The graph output ends the first chain.
+      TEST_RETURN_IF_NOT(op_to_count["com.microsoft.FusedElementwise"] == (relu_is_graph_output ? 2 : 1));
+
+      if (!relu_is_graph_output) {
+        for (auto& node : graph.Nodes()) {
+          const auto& attrs = node.GetAttributes();
+          const auto& ops = attrs.at("ops").strings();
+          TEST_RETURN_IF_NOT(std::vector<std::string>(ops.begin(), ops.end()) ==
+                             std::vector<std::string>({"Add", "Relu", "Mul", "Sub"}));
+          const auto& operands = attrs.at("operands").ints();
+          // values: 0 = x, 1 = bias, 2 = one, 3.. = results of the ops
+          TEST_RETURN_IF_NOT(std::vector<int64_t>(operands.begin(), operands.end()) ==
+                             std::vector<int64_t>({0, 1, 3, -1, 4, 0, 5, 2}));
+        }
+      }
+      return Status::OK();
+    };
+
+    std::unique_ptr<GraphTransformer> transformer = std::make_unique<ElementwiseChainFusion>();
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::move(transformer),
+                                          TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+  }
+}
+
+TEST_F(GraphTransformationTests, ElementwiseChainFusion_UnsupportedBroadcast) {
+  // The bias is broadcast along the last dimension, which FusedElementwise does not do.
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({{2, 3, 4}});
+    auto* bias_arg = builder.MakeInitializer<float>({3, 1}, {0.1f, 0.2f, 0.3f});
+    auto* add_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {input_arg, bias_arg}, {add_out});
+    builder.AddNode("Tanh", {add_out}, {output_arg});
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["Add"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["Tanh"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.FusedElementwise"] == 0);
+    return Status::OK();
+  };
+
+  std::unique_ptr<GraphTransformer> transformer = std::make_unique<ElementwiseChainFusion>();
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::move(transformer),
+                                        TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+}
+
+#if !defined(DISABLE_FLOAT8_TYPES)
+TEST_F(GraphTransformationTests, GemmFloat8Fusion) {
+  // Q(MatMul(DQ(a), DQ(w))) with float 8 a and w, where the QuantizeLinear node is missing in the second case.
+  for (bool has_q_node : {true, false}) {
+    std::vector<Float8E4M3FN> weight_data;
+    for (int i = 0; i < 16 * 8; ++i) {
+      weight_data.push_back(Float8E4M3FN(static_cast<float>(i % 7) - 3.0f));
+    }
+
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<Float8E4M3FN>({2, 3, 16}, std::vector<Float8E4M3FN>(96, Float8E4M3FN(1.0f)));
+      auto* weight_arg = builder.MakeInitializer<Float8E4M3FN>({16, 8}, weight_data);
+      auto* dq_input_out = builder.MakeIntermediate();
+      auto* dq_weight_out = builder.MakeIntermediate();
+      auto* matmul_out = has_q_node ? builder.MakeIntermediate() : builder.MakeOutput();
+
+      builder.AddNode("DequantizeLinear", {input_arg, builder.MakeScalarInitializer<float>(0.5f)}, {dq_input_out});
+      builder.AddNode("DequantizeLinear",
+                      {weight_arg, builder.MakeScalarInitializer<float>(0.25f),
+                       builder.MakeScalarInitializer<Float8E4M3FN>(Float8E4M3FN(0.0f))},
+                      {dq_weight_out});
+      builder.AddNode("MatMul", {dq_input_out, dq_weight_out}, {matmul_out});
+      if (has_q_node) {
+        builder.AddNode("QuantizeLinear",
+                        {matmul_out, builder.MakeScalarInitializer<float>(2.0f),
+                         builder.MakeScalarInitializer<Float8E4M3FN>(Float8E4M3FN(0.0f))},
+                        {builder.MakeOutput()});
+      }
+    };
+
+    auto post_graph_checker = [&](Graph& graph) {
+      auto op_to_count = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_to_count["DequantizeLinear"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["MatMul"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["QuantizeLinear"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["com.microsoft.GemmFloat8"] == 1);
+
+      for (auto& node : graph.Nodes()) {
+        const auto& attrs = node.GetAttributes();
+        TEST_RETURN_IF_NOT(attrs.at("transA").i() == 0);
+        TEST_RETURN_IF_NOT(attrs.at("transB").i() == 1);
+        TEST_RETURN_IF_NOT(attrs.at("dtype").i() == (has_q_node ? ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E4M3FN
+                                                                 : ONNX_NAMESPACE::TensorProto_DataType_FLOAT));
+
+        const auto& input_defs = node.InputDefs();
+        TEST_RETURN_IF_NOT(input_defs.size() == (has_q_node ? 6u : 5u));
+        TEST_RETURN_IF_NOT(!input_defs[2]->Exists());
+
+        // B is transposed into (N, K).
+        const auto* weight_proto = graph_utils::GetConstantInitializer(graph, input_defs[1]->Name());
+        TEST_RETURN_IF_NOT(weight_proto != nullptr);
+        Initializer weight(*weight_proto, graph.ModelPath());
+        TEST_RETURN_IF_NOT(std::vector<int64_t>(weight.dims().begin(), weight.dims().end()) ==
+                           std::vector<int64_t>({8, 16}));
+        const auto* transposed_data = weight.data<Float8E4M3FN>();
+        for (int k = 0; k < 16; ++k) {
+          for (int n = 0; n < 8; ++n) {
+            TEST_RETURN_IF_NOT(transposed_data[n * 16 + k].val == weight_data[k * 8 + n].val);
+          }
+        }
+
+        std::vector<float> expected_scales{0.5f, 0.25f};
+        if (has_q_node) {
+          // GemmFloat8 multiplies the output by the inverse of the scale of QuantizeLinear.
+          expected_scales.push_back(0.5f);
+        }
+        for (size_t i = 0; i < expected_scales.size(); ++i) {
+          const auto* scale_proto = graph_utils::GetConstantInitializer(graph, input_defs[3 + i]->Name());
+          TEST_RETURN_IF_NOT(scale_proto != nullptr);
+          Initializer scale(*scale_proto, graph.ModelPath());
+          TEST_RETURN_IF_NOT(scale.size() == 1 && *scale.data<float>() == expected_scales[i]);
+        }
+      }
+      return Status::OK();
+    };
+
+    std::unique_ptr<GraphTransformer> transformer = std::make_unique<GemmFloat8Fusion>();
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 19, *logger_, std::move(transformer),
+                                          TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+  }
+}
+
+TEST_F(GraphTransformationTests, GemmFloat8Fusion_NonConstantWeight) {
+  // cuBLASLt multiplies float 8 matrices with B transposed, which the fusion only does for constant weights.
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<Float8E4M3FN>({2, 16}, std::vector<Float8E4M3FN>(32, Float8E4M3FN(1.0f)));
+    auto* weight_arg = builder.MakeInput<Float8E4M3FN>({16, 8}, std::vector<Float8E4M3FN>(128, Float8E4M3FN(1.0f)));
+    auto* dq_input_out = builder.MakeIntermediate();
+    auto* dq_weight_out = builder.MakeIntermediate();
+
+    builder.AddNode("DequantizeLinear", {input_arg, builder.MakeScalarInitializer<float>(0.5f)}, {dq_input_out});
+    builder.AddNode("DequantizeLinear", {weight_arg, builder.MakeScalarInitializer<float>(0.25f)}, {dq_weight_out});
+    builder.AddNode("MatMul", {dq_input_out, dq_weight_out}, {builder.MakeOutput()});
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["DequantizeLinear"] == 2);
+    TEST_RETURN_IF_NOT(op_to_count["MatMul"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.GemmFloat8"] == 0);
+    return Status::OK();
+  };
+
+  std::unique_ptr<GraphTransformer> transformer = std::make_unique<GemmFloat8Fusion>();
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 19, *logger_, std::move(transformer),
+                                        TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+}
+#endif  // !defined(DISABLE_FLOAT8_TYPES)
+
+static int32_t GetElemType(const NodeArg& arg) {
+  return arg.TypeAsProto()->tensor_type().elem_type();
+}
+
+TEST_F(GraphTransformationTests, MixedPrecisionConversion) {
+  // ReduceMean(Relu(Add(MatMul(x, w), bias))), where ReduceMean stays in float.
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({{2, 4}});
+    auto* weight_arg = builder.MakeInitializer<float>({4, 3}, -1.0f, 1.0f);
+    auto* bias_arg = builder.MakeInitializer<float>({3}, {0.1f, 0.2f, 0.3f});
+    auto* matmul_out = builder.MakeIntermediate();
+    auto* add_out = builder.MakeIntermediate();
+    auto* relu_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("MatMul", {input_arg, weight_arg}, {matmul_out});
+    builder.AddNode("Add", {matmul_out, bias_arg}, {add_out});
+    builder.AddNode("Relu", {add_out}, {relu_out});
+    builder.AddNode("ReduceMean", {relu_out}, {output_arg}).AddAttribute("axes", std::vector<int64_t>{-1});
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    // The input is cast to float16, and the output of Relu back to float.
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Cast"] == 2);
+    for (auto& node : graph.Nodes()) {
+      if (node.OpType() == "MatMul" || node.OpType() == "Add" || node.OpType() == "Relu") {
+        for (const NodeArg* arg : node.InputDefs()) {
+          TEST_RETURN_IF_NOT(GetElemType(*arg) == TensorProto_DataType_FLOAT16);
+        }
+        TEST_RETURN_IF_NOT(GetElemType(*node.OutputDefs()[0]) == TensorProto_DataType_FLOAT16);
+      } else if (node.OpType() == "ReduceMean") {
+        TEST_RETURN_IF_NOT(GetElemType(*node.InputDefs()[0]) == TensorProto_DataType_FLOAT);
+      }
+    }
+    TEST_RETURN_IF_NOT(GetElemType(*graph.GetOutputs()[0]) == TensorProto_DataType_FLOAT);
+    return Status::OK();
+  };
+
+  std::unique_ptr<GraphTransformer> transformer =
+      std::make_unique<MixedPrecisionConversion>(TensorProto_DataType_FLOAT16);
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::move(transformer),
+                                        TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+}
+
+TEST_F(GraphTransformationTests, MixedPrecisionConversion_KeepFloat) {
+  // MatMul(x, w) consumed by Softmax stays in float. The initializer of the other MatMul overflows float16 so it
+  // is cast instead of converted, and Transpose, which only moves data, stays in float after a float node.
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({{2, 4}});
+    auto* weight_arg = builder.MakeInitializer<float>({4, 4}, -1.0f, 1.0f);
+    auto* large_weight_arg = builder.MakeInitializer<float>({4, 4}, std::vector<float>(16, 1.0e5f));
+    auto* matmul_out = builder.MakeIntermediate();
+    auto* softmax_out = builder.MakeIntermediate();
+    auto* transpose_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("MatMul", {input_arg, weight_arg}, {matmul_out});
+    builder.AddNode("Softmax", {matmul_out}, {softmax_out});
+    builder.AddNode("Transpose", {softmax_out}, {transpose_out}).AddAttribute("perm", std::vector<int64_t>{1, 0});
+    builder.AddNode("MatMul", {large_weight_arg, transpose_out}, {output_arg});
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    // The large initializer and the output of Transpose are cast to float16, and the output back to float.
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Cast"] == 3);
+    int converted_matmul_count = 0;
+    for (auto& node : graph.Nodes()) {
+      if (node.OpType() == "MatMul" && GetElemType(*node.OutputDefs()[0]) == TensorProto_DataType_FLOAT16) {
+        converted_matmul_count++;
+      } else if (node.OpType() == "Softmax" || node.OpType() == "Transpose") {
+        TEST_RETURN_IF_NOT(GetElemType(*node.InputDefs()[0]) == TensorProto_DataType_FLOAT);
+      }
+    }
+    TEST_RETURN_IF_NOT(converted_matmul_count == 1);
+    return Status::OK();
+  };
+
+  std::unique_ptr<GraphTransformer> transformer =
+      std::make_unique<MixedPrecisionConversion>(TensorProto_DataType_FLOAT16);
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::move(transformer),
+                                        TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+}
+
+TEST_F(GraphTransformationTests, PackingModeConversion) {
+  // A decoder layer: Add(MatMul(Gelu(MatMul(h))), h) with h = Add(Attention(LayerNormalization(x)), x), where the
+  // causal Attention has the sequence lengths as its mask.
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 4, 8}, -1.0f, 1.0f);
+    auto* sequence_lengths_arg = builder.MakeInput<int32_t>({2}, {4, 2});
+    auto* ln_out = builder.MakeIntermediate();
+    auto* attention_out = builder.MakeIntermediate();
+    auto* residual_out = builder.MakeIntermediate();
+    auto* fc1_out = builder.MakeIntermediate();
+    auto* gelu_out = builder.MakeIntermediate();
+    auto* fc2_out = builder.MakeIntermediate();
+
+    builder.AddNode("LayerNormalization",
+                    {input_arg, builder.MakeInitializer<float>({8}, 0.5f, 1.5f),
+                     builder.MakeInitializer<float>({8}, -0.5f, 0.5f)},
+                    {ln_out});
+    auto& attention_node = builder.AddNode("Attention",
+                                           {ln_out, builder.MakeInitializer<float>({8, 24}, -1.0f, 1.0f),
+                                            builder.MakeInitializer<float>({24}, -1.0f, 1.0f), sequence_lengths_arg},
+                                           {attention_out}, kMSDomain);
+    attention_node.AddAttribute("num_heads", static_cast<int64_t>(2));
+    attention_node.AddAttribute("unidirectional", static_cast<int64_t>(1));
+    builder.AddNode("Add", {attention_out, input_arg}, {residual_out});
+    builder.AddNode("MatMul", {residual_out, builder.MakeInitializer<float>({8, 16}, -1.0f, 1.0f)}, {fc1_out});
+    builder.AddNode("Gelu", {fc1_out}, {gelu_out}, kMSDomain);
+    builder.AddNode("MatMul", {gelu_out, builder.MakeInitializer<float>({16, 8}, -1.0f, 1.0f)}, {fc2_out});
+    builder.AddNode("Add", {fc2_out, residual_out}, {builder.MakeOutput()});
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    // x is packed once for LayerNormalization and the residual Add, and only the output is padded again.
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.Attention"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.PackedAttention"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.RemovePadding"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.RestorePadding"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["MatMul"] == 2);
+
+    for (auto& node : graph.Nodes()) {
+      if (node.OpType() == "PackedAttention") {
+        TEST_RETURN_IF_NOT(node.GetAttributes().at("unidirectional").i() == 1);
+        TEST_RETURN_IF_NOT(node.GetAttributes().at("num_heads").i() == 2);
+      } else if (node.OpType() == "LayerNormalization" || node.OpType() == "Add" || node.OpType() == "MatMul" ||
+                 node.OpType() == "Gelu") {
+        TEST_RETURN_IF_NOT(node.InputDefs()[0]->Shape() != nullptr && node.InputDefs()[0]->Shape()->dim_size() == 2);
+        TEST_RETURN_IF_NOT(node.OutputDefs()[0]->Shape()->dim_size() == 2);
+      }
+    }
+
+    const auto* output_shape = graph.GetOutputs()[0]->Shape();
+    TEST_RETURN_IF_NOT(output_shape != nullptr && output_shape->dim_size() == 3);
+    return Status::OK();
+  };
+
+  std::unique_ptr<GraphTransformer> transformer = std::make_unique<PackingModeConversion>();
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 17, *logger_, std::move(transformer),
+                                        TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+}
+
+TEST_F(GraphTransformationTests, PackingModeConversion_RawMask) {
+  // A mask with shape (batch_size, sequence_length) may have padding anywhere, so the graph is not converted.
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 4, 8}, -1.0f, 1.0f);
+    auto* mask_arg = builder.MakeInput<int32_t>({2, 4}, {1, 1, 1, 1, 1, 1, 0, 0});
+    auto& attention_node = builder.AddNode("Attention",
+                                           {input_arg, builder.MakeInitializer<float>({8, 24}, -1.0f, 1.0f),
+                                            builder.MakeInitializer<float>({24}, -1.0f, 1.0f), mask_arg},
+                                           {builder.MakeOutput()}, kMSDomain);
+    attention_node.AddAttribute("num_heads", static_cast<int64_t>(2));
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.Attention"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.PackedAttention"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.RemovePadding"] == 0);
+    return Status::OK();
+  };
+
+  std::unique_ptr<GraphTransformer> transformer = std::make_unique<PackingModeConversion>();
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 17, *logger_, std::move(transformer),
+                                        TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+}
+
 struct BiasSoftmaxFusionTester {
   std::shared_ptr<Model> p_model_;
   Status model_load_;
@@ -7623,5 +8081,143 @@ TEST_F(GraphTransformationTests, GatherToSliceFusion) {
   }
 }
 
+TEST_F(GraphTransformationTests, EmbeddingBagFusion) {
+  auto pre_graph_checker = [&](Graph& graph) {
+    auto op_count_map = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_count_map["Gather"] == 1);
+    return Status::OK();
+  };
+
+  auto check_fused = [](const std::string& mode) {
+    return [mode](Graph& graph) {
+      auto op_count_map = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_count_map["Gather"] == 0);
+      TEST_RETURN_IF_NOT(op_count_map["ReduceSum"] == 0);
+      TEST_RETURN_IF_NOT(op_count_map["ReduceMean"] == 0);
+      TEST_RETURN_IF_NOT(op_count_map["com.microsoft.EmbeddingBag"] == 1);
+      for (auto& node : graph.Nodes()) {
+        if (node.OpType() == "EmbeddingBag") {
+          auto& attrs = node.GetAttributes();
+          TEST_RETURN_IF_NOT(attrs.find("mode") != attrs.end());
+          TEST_RETURN_IF_NOT(attrs.at("mode").s() == mode);
+        }
+      }
+      return Status::OK();
+    };
+  };
+
+  auto check_not_fused = [](Graph& graph) {
+    auto op_count_map = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_count_map["Gather"] == 1);
+    TEST_RETURN_IF_NOT(op_count_map["com.microsoft.EmbeddingBag"] == 0);
+    return Status::OK();
+  };
+
+  // OpSet-13, ReduceSum with the axes input and a negative axis.
+  {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* table_arg = builder.MakeInitializer<float>({100, 16}, std::vector<float>(1600, 1.0f));
+      auto* indices_arg = builder.MakeInput<int64_t>({{4, 10}});
+      auto* axes_arg = builder.MakeInitializer<int64_t>({1}, {static_cast<int64_t>(-2)});
+      auto* gather_output = builder.MakeIntermediate();
+      auto* reduce_output = builder.MakeOutput();
+
+      builder.AddNode("Gather", {table_arg, indices_arg}, {gather_output});
+      builder.AddNode("ReduceSum", {gather_output, axes_arg}, {reduce_output})
+          .AddAttribute("keepdims", static_cast<int64_t>(0));
+    };
+
+    std::unique_ptr<GraphTransformer> transformer = std::make_unique<EmbeddingBagFusion>();
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::move(transformer),
+                                          TransformerLevel::Level2, 1, pre_graph_checker, check_fused("sum")));
+  }
+
+  // OpSet-12, ReduceMean with the axes attribute and 3D indices.
+  {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* table_arg = builder.MakeInput<float>({{100, 16}});
+      auto* indices_arg = builder.MakeInput<int32_t>({{2, 4, 10}});
+      auto* gather_output = builder.MakeIntermediate();
+      auto* reduce_output = builder.MakeOutput();
+
+      builder.AddNode("Gather", {table_arg, indices_arg}, {gather_output})
+          .AddAttribute("axis", static_cast<int64_t>(0));
+      Node& reduce = builder.AddNode("ReduceMean", {gather_output}, {reduce_output});
+      reduce.AddAttribute("axes", std::vector<int64_t>{2});
+      reduce.AddAttribute("keepdims", static_cast<int64_t>(0));
+    };
+
+    std::unique_ptr<GraphTransformer> transformer = std::make_unique<EmbeddingBagFusion>();
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 12, *logger_, std::move(transformer),
+                                          TransformerLevel::Level2, 1, pre_graph_checker, check_fused("mean")));
+  }
+
+  // The reduction over the embedding dim and a reduction that keeps the dims aren't fused.
+  for (bool keep_dims : {false, true}) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* table_arg = builder.MakeInput<float>({{100, 16}});
+      auto* indices_arg = builder.MakeInput<int64_t>({{4, 10}});
+      auto* axes_arg = builder.MakeInitializer<int64_t>({1}, {static_cast<int64_t>(keep_dims ? 1 : 2)});
+      auto* gather_output = builder.MakeIntermediate();
+      auto* reduce_output = builder.MakeOutput();
+
+      builder.AddNode("Gather", {table_arg, indices_arg}, {gather_output});
+      builder.AddNode("ReduceSum", {gather_output, axes_arg}, {reduce_output})
+          .AddAttribute("keepdims", static_cast<int64_t>(keep_dims ? 1 : 0));
+    };
+
+    std::unique_ptr<GraphTransformer> transformer = std::make_unique<EmbeddingBagFusion>();
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::move(transformer),
+                                          TransformerLevel::Level2, 1, pre_graph_checker, check_not_fused));
+  }
+}
+
+#if !defined(DISABLE_ML_OPS)
+TEST_F(GraphTransformationTests, ImputerScalerFusion) {
+  for (bool imputer_output_is_graph_output : {false, true}) {
+    std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 13}, {kMLDomain, 1}, {kMSDomain, 1}};
+    Model model("ImputerScalerFusion", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                domain_to_version, {}, *logger_);
+    Graph& graph = model.MainGraph();
+    ModelTestBuilder builder(graph);
+
+    auto* input_arg = builder.MakeInput<float>({{4, 3}});
+    auto* imputer_output = imputer_output_is_graph_output ? builder.MakeOutput() : builder.MakeIntermediate();
+    auto* scaler_output = builder.MakeOutput();
+    Node& imputer = builder.AddNode("Imputer", {input_arg}, {imputer_output}, kMLDomain);
+    imputer.AddAttribute("imputed_value_floats", std::vector<float>{1.f, 2.f, 3.f});
+    imputer.AddAttribute("replaced_value_float", std::numeric_limits<float>::quiet_NaN());
+    Node& scaler = builder.AddNode("Scaler", {imputer_output}, {scaler_output}, kMLDomain);
+    scaler.AddAttribute("offset", std::vector<float>{0.5f, 1.f, 1.5f});
+    scaler.AddAttribute("scale", std::vector<float>{2.f, 0.5f, 4.f});
+    builder.SetGraphOutputs();
+    ASSERT_STATUS_OK(graph.Resolve());
+
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{1};
+    ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<ImputerScalerFusion>(),
+                                                       TransformerLevel::Level2));
+    ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2, *logger_));
+
+    auto op_to_count = CountOpsInGraph(graph);
+    if (imputer_output_is_graph_output) {
+      ASSERT_EQ(op_to_count["ai.onnx.ml.Imputer"], 1);
+      ASSERT_EQ(op_to_count["com.microsoft.FusedScaler"], 0);
+      continue;
+    }
+
+    ASSERT_EQ(op_to_count["ai.onnx.ml.Imputer"], 0);
+    ASSERT_EQ(op_to_count["ai.onnx.ml.Scaler"], 0);
+    ASSERT_EQ(op_to_count["com.microsoft.FusedScaler"], 1);
+    for (const Node& node : graph.Nodes()) {
+      const auto& attrs = node.GetAttributes();
+      ASSERT_EQ(attrs.at("imputed_value_floats").floats_size(), 3);
+      ASSERT_TRUE(std::isnan(attrs.at("replaced_value_float").f()));
+      ASSERT_EQ(attrs.at("offset").floats(2), 1.5f);
+      ASSERT_EQ(attrs.at("scale").floats(1), 0.5f);
+    }
+  }
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
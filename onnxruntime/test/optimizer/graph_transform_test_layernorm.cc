@@ -636,6 +636,61 @@ TEST_F(GraphTransformationTests, SkipLayerNormFusion_NoBeta) {
   TestSkipLayerNormFusionNoBeta(MODEL_FOLDER "fusion/skip_layer_norm_no_beta_with_cast.onnx", true, logger_.get());
 }
 
+// Residual Add + SimplifiedLayerNormalization, as in the decoder layers of LLaMA, with an optional bias Add.
+static void TestSkipSimplifiedLayerNormFusion(bool with_bias, int64_t axis, bool expect_fusion,
+                                              const logging::Logger& logger) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 4, 8}, -1.0f, 1.0f);
+    auto* skip_arg = builder.MakeInput<float>({2, 4, 8}, -1.0f, 1.0f);
+    auto* gamma_arg = builder.MakeInitializer<float>({8}, -1.0f, 1.0f);
+    auto* add_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    if (with_bias) {
+      auto* bias_arg = builder.MakeInitializer<float>({8}, -1.0f, 1.0f);
+      auto* bias_out = builder.MakeIntermediate();
+      builder.AddNode("Add", {input_arg, bias_arg}, {bias_out});
+      input_arg = bias_out;
+    }
+    builder.AddNode("Add", {input_arg, skip_arg}, {add_out});
+
+    Node& norm_node = builder.AddNode("SimplifiedLayerNormalization", {add_out, gamma_arg}, {output_arg});
+    norm_node.AddAttribute("axis", axis);
+    norm_node.AddAttribute("epsilon", 1e-6f);
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    if (!expect_fusion) {
+      TEST_RETURN_IF_NOT(op_to_count["com.microsoft.SkipSimplifiedLayerNormalization"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["SimplifiedLayerNormalization"] == 1);
+      return Status::OK();
+    }
+
+    TEST_RETURN_IF_NOT(op_to_count["Add"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["SimplifiedLayerNormalization"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.SkipSimplifiedLayerNormalization"] == 1);
+    for (const Node& node : graph.Nodes()) {
+      if (node.OpType() == "SkipSimplifiedLayerNormalization") {
+        TEST_RETURN_IF_NOT(node.InputDefs().size() == (with_bias ? 4u : 3u));
+        TEST_RETURN_IF_NOT(node.GetAttributes().at("epsilon").f() == 1e-6f);
+      }
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, logger, std::make_unique<SkipLayerNormFusion>(),
+                                        TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+}
+
+TEST_F(GraphTransformationTests, SkipSimplifiedLayerNormFusion) {
+  TestSkipSimplifiedLayerNormFusion(false, -1, true, *logger_);
+  TestSkipSimplifiedLayerNormFusion(true, -1, true, *logger_);
+  TestSkipSimplifiedLayerNormFusion(true, 2, true, *logger_);
+  // SkipSimplifiedLayerNormalization only normalizes the last axis.
+  TestSkipSimplifiedLayerNormFusion(false, 1, false, *logger_);
+}
+
 TEST_F(GraphTransformationTests, EmbedLayerNormFusionFormat1) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "fusion/embed_layer_norm_format1.onnx";
   std::shared_ptr<Model> p_model;
@@ -8,6 +8,8 @@
 #include "graph_transform_test_builder.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/graph/graph.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "test/util/include/asserts.h"
 
 namespace onnxruntime {
 namespace test {
@@ -516,6 +518,107 @@ TEST(NhwcTransformerTests, ConvMixTensorRanks) {
                     TransformerLevel::Level3);
 }
 
+static void EnableNhwcFp32(SessionOptions& session_options) {
+  ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsEnableNhwcFp32, "1"));
+}
+
+TEST(NhwcTransformerTests, ConvFp32) {
+  auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& weights_shape,
+                       int64_t group) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>(input_shape, -1.5f, 1.5f);
+      auto* bias_arg = builder.MakeInitializer<float>({weights_shape[0]}, -0.5f, 0.5f);
+      auto* output_arg = builder.MakeOutput();
+      auto* weight_arg = builder.MakeInitializer<float>(weights_shape, -1.5f, 1.5f);
+
+      Node& conv_node = builder.AddNode("Conv", {input_arg, weight_arg, bias_arg}, {output_arg});
+      conv_node.AddAttribute("pads", std::vector<int64_t>((weights_shape.size() - 2) * 2, 1));
+      conv_node.AddAttribute("group", group);
+    };
+
+    auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.NhwcFusedConv"], 1);
+      EXPECT_EQ(op_to_count["Transpose"], 2);
+    };
+
+    TransformerTester(build_test_case,
+                      check_nhwc_graph,
+                      TransformerLevel::Level2,
+                      TransformerLevel::Level3,
+                      12, 1e-4, 1e-4, nullptr, EnableNhwcFp32);
+  };
+
+  // Test the basic case of a single 1D/2D/3D convolution, and the grouped and depthwise 2D convolutions.
+  test_case({1, 12, 37}, {32, 12, 5}, 1);
+  test_case({2, 23, 13, 13}, {30, 23, 3, 3}, 1);
+  test_case({1, 22, 11, 13, 15}, {30, 22, 5, 3, 3}, 1);
+  test_case({1, 24, 13, 13}, {30, 8, 3, 3}, 3);
+  test_case({1, 24, 13, 13}, {24, 1, 3, 3}, 24);
+}
+
+TEST(NhwcTransformerTests, ConvReluPoolFp32) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 23, 13, 13}, -1.5f, 1.5f);
+    auto* conv1_output_arg = builder.MakeIntermediate();
+    auto* relu_output_arg = builder.MakeIntermediate();
+    auto* maxpool_output_arg = builder.MakeIntermediate();
+    auto* conv2_output_arg = builder.MakeIntermediate();
+    auto* avgpool_output_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    auto* conv1_weight_arg = builder.MakeInitializer<float>({30, 23, 3, 3}, -1.5f, 1.5f);
+    auto* conv2_weight_arg = builder.MakeInitializer<float>({16, 30, 1, 1}, -1.5f, 1.5f);
+
+    Node& conv1_node = builder.AddConvNode(input_arg, conv1_weight_arg, conv1_output_arg);
+    conv1_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+    builder.AddNode("Relu", {conv1_output_arg}, {relu_output_arg});
+    Node& maxpool_node = builder.AddNode("MaxPool", {relu_output_arg}, {maxpool_output_arg});
+    maxpool_node.AddAttribute("kernel_shape", std::vector<int64_t>{3, 3});
+    maxpool_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+    builder.AddConvNode(maxpool_output_arg, conv2_weight_arg, conv2_output_arg);
+    Node& avgpool_node = builder.AddNode("AveragePool", {conv2_output_arg}, {avgpool_output_arg});
+    avgpool_node.AddAttribute("kernel_shape", std::vector<int64_t>{3, 3});
+    avgpool_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+    avgpool_node.AddAttribute("count_include_pad", static_cast<int64_t>(1));
+    builder.AddNode("GlobalAveragePool", {avgpool_output_arg}, {output_arg});
+  };
+
+  auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.NhwcFusedConv"], 2);
+    EXPECT_EQ(op_to_count["com.ms.internal.nhwc.MaxPool"], 1);
+    EXPECT_EQ(op_to_count["com.ms.internal.nhwc.AveragePool"], 1);
+    EXPECT_EQ(op_to_count["com.ms.internal.nhwc.GlobalAveragePool"], 1);
+    EXPECT_EQ(op_to_count["Transpose"], 2);
+  };
+
+  TransformerTester(build_test_case,
+                    check_nhwc_graph,
+                    TransformerLevel::Level2,
+                    TransformerLevel::Level3,
+                    12, 1e-4, 1e-4, nullptr, EnableNhwcFp32);
+}
+
+TEST(NhwcTransformerTests, ConvFp32Disabled) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 23, 13, 13}, -1.5f, 1.5f);
+    auto* output_arg = builder.MakeOutput();
+    auto* weight_arg = builder.MakeInitializer<float>({30, 23, 3, 3}, -1.5f, 1.5f);
+
+    builder.AddConvNode(input_arg, weight_arg, output_arg);
+  };
+
+  auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.NhwcFusedConv"], 0);
+  };
+
+  TransformerTester(build_test_case,
+                    check_nhwc_graph,
+                    TransformerLevel::Level2,
+                    TransformerLevel::Level3);
+}
+
 #ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
 
 std::vector<MLFloat16> randomfp16(const std::vector<int64_t>& shape, MLFloat16 min, MLFloat16 max) {
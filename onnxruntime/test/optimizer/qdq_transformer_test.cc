@@ -1811,6 +1811,62 @@ TEST(QDQTransformerTests, ConvRelu) {
   test_case({1, 22, 11, 13, 15}, {30, 22, 5, 3, 3}, false, false /*use_contrib_qdq*/);
 }
 
+TEST(QDQTransformerTests, QLinearConvDepthwisePointwise) {
+  auto test_case = [&](const std::vector<int64_t>& input_shape, int64_t output_channels, bool has_bias) {
+    const int64_t channels = input_shape[1];
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<uint8_t>(input_shape, 0, 255);
+      auto* dw_output = builder.MakeIntermediate();
+      auto* output_arg = builder.MakeOutput();
+
+      std::vector<NodeArg*> dw_inputs{input_arg,
+                                      builder.MakeScalarInitializer<float>(.02f),
+                                      builder.MakeScalarInitializer<uint8_t>(128),
+                                      builder.MakeInitializer<int8_t>({channels, 1, 3, 3}, -63, 63),
+                                      builder.MakeScalarInitializer<float>(.01f),
+                                      builder.MakeScalarInitializer<int8_t>(0),
+                                      builder.MakeScalarInitializer<float>(.05f),
+                                      builder.MakeScalarInitializer<uint8_t>(120)};
+      std::vector<NodeArg*> pw_inputs{dw_output,
+                                      builder.MakeScalarInitializer<float>(.05f),
+                                      builder.MakeScalarInitializer<uint8_t>(120),
+                                      builder.MakeInitializer<int8_t>({output_channels, channels, 1, 1}, -63, 63),
+                                      builder.MakeScalarInitializer<float>(.004f),
+                                      builder.MakeScalarInitializer<int8_t>(0),
+                                      builder.MakeScalarInitializer<float>(.2f),
+                                      builder.MakeScalarInitializer<uint8_t>(131)};
+      if (has_bias) {
+        dw_inputs.push_back(builder.MakeInitializer<int32_t>({channels}, -1000, 1000));
+        pw_inputs.push_back(builder.MakeInitializer<int32_t>({output_channels}, -1000, 1000));
+      }
+
+      Node& dw_node = builder.AddNode("QLinearConv", dw_inputs, {dw_output});
+      dw_node.AddAttribute("group", channels);
+      dw_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+      builder.AddNode("QLinearConv", pw_inputs, {output_arg});
+    };
+
+    // The fusion only applies if the fused MLAS kernel supports the filters.
+    const bool is_fused = MlasConvSymPackWSize(static_cast<size_t>(channels), 1, 1, 9, false) != 0 &&
+                          MlasConvSymPointwisePackWSize(static_cast<size_t>(channels),
+                                                        static_cast<size_t>(output_channels), false) != 0;
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.QLinearConvDepthwisePointwise"], is_fused ? 1 : 0);
+      EXPECT_EQ(op_to_count["QLinearConv"], is_fused ? 0 : 2);
+    };
+
+    // The pointwise requantization may round differently from the standalone QLinearConv.
+    TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2,
+                      12 /*opset_version*/, 1.0 /*per_sample_tolerance*/);
+  };
+
+  test_case({1, 32, 15, 15}, 48, true);
+  test_case({1, 32, 15, 15}, 48, false);
+  test_case({2, 64, 7, 9}, 16, true);
+}
+
 TEST(QDQTransformerTests, ConvAveragePoolReshape_UInt8) {
   auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& weights_shape,
                        bool use_contrib_qdq) {
@@ -28,8 +28,18 @@ namespace perftest {
   printf(
       "perf_test [options...] model_path [result_file]\n"
       "Options:\n"
-      "\t-m [test_mode]: Specifies the test mode. Value could be 'duration' or 'times'.\n"
+      "\t-m [test_mode]: Specifies the test mode. Value could be 'duration', 'times' or 'openloop'.\n"
       "\t\tProvide 'duration' to run the test for a fix duration, and 'times' to repeated for a certain times. \n"
+      "\t\tProvide 'openloop' to send requests at the rate given by -Q for the duration given by -t, and report the \n"
+      "\t\tlatency percentiles, throughput and queueing delay. -c is then the number of requests served concurrently.\n"
+      "\t-Q [queries_per_second]: Target request rate of the 'openloop' test mode. Implies '-m openloop'.\n"
+      "\t-a [poisson|constant]: Arrival process of the 'openloop' requests. Default:poisson.\n"
+      "\t-W [seconds_to_warm_up]: Seconds of 'openloop' requests run before the measured duration. Default:0.\n"
+      "\t-N [sessions_per_model]: Number of sessions per model the 'openloop' requests are spread over. Default:1.\n"
+      "\t-X [model_path:weight]: Adds a model to the 'openloop' load, receiving requests in proportion to weight. \n"
+      "\t\tThe main model has a weight of 1. May be repeated.\n"
+      "\t-j [report_file]: Exports the 'openloop' latencies, as a summary if the file ends with .json, or one CSV line \n"
+      "\t\tper request otherwise.\n"
       "\t-M: Disable memory pattern.\n"
       "\t-A: Disable memory arena\n"
       "\t-I: Generate tensor input binding (Free dimensions are treated as 1.)\n"
@@ -140,9 +150,28 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
   return true;
 }
 
+// model_path, or model_path:weight with a positive weight
+static bool ParseWeightedModel(std::basic_string<ORTCHAR_T>& model_path, double& weight) {
+  model_path = optarg;
+  size_t delimiter_location = model_path.rfind(overrideDelimiter);
+  // a drive letter on Windows is followed by a path separator, not by a weight
+  if (delimiter_location == std::basic_string<ORTCHAR_T>::npos || delimiter_location + 1 >= model_path.size() ||
+      model_path[delimiter_location + 1] == '\\' || model_path[delimiter_location + 1] == '/') {
+    return !model_path.empty();
+  }
+  ORT_TRY {
+    weight = std::stod(model_path.substr(delimiter_location + 1));
+  }
+  ORT_CATCH(...) {
+    return false;
+  }
+  model_path.resize(delimiter_location);
+  return weight > 0 && !model_path.empty();
+}
+
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:AMPIDZvhsqz"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:Q:a:W:N:X:j:AMPIDZvhsqz"))) != -1) {
     switch (ch) {
       case 'f': {
         std::basic_string<ORTCHAR_T> dim_name;
@@ -167,6 +196,8 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
           test_config.run_config.test_mode = TestMode::kFixDurationMode;
         } else if (!CompareCString(optarg, ORT_TSTR("times"))) {
           test_config.run_config.test_mode = TestMode::KFixRepeatedTimesMode;
+        } else if (!CompareCString(optarg, ORT_TSTR("openloop"))) {
+          test_config.run_config.test_mode = TestMode::kOpenLoopMode;
         } else {
           return false;
         }
@@ -319,6 +350,43 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
       case 'Z':
         test_config.run_config.disable_spinning_between_run = true;
         break;
+      case 'Q':
+        test_config.run_config.open_loop_qps = OrtStrtod<PATH_CHAR_TYPE>(optarg, nullptr);
+        if (test_config.run_config.open_loop_qps <= 0) {
+          return false;
+        }
+        test_config.run_config.test_mode = TestMode::kOpenLoopMode;
+        break;
+      case 'a':
+        if (!CompareCString(optarg, ORT_TSTR("poisson"))) {
+          test_config.run_config.arrival_distribution = ArrivalDistribution::kPoisson;
+        } else if (!CompareCString(optarg, ORT_TSTR("constant"))) {
+          test_config.run_config.arrival_distribution = ArrivalDistribution::kConstant;
+        } else {
+          return false;
+        }
+        break;
+      case 'W':
+        test_config.run_config.warmup_in_seconds = static_cast<size_t>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
+        break;
+      case 'N':
+        test_config.run_config.num_sessions = static_cast<size_t>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
+        if (test_config.run_config.num_sessions <= 0) {
+          return false;
+        }
+        break;
+      case 'X': {
+        std::basic_string<ORTCHAR_T> model_path;
+        double weight = 1.0;
+        if (!ParseWeightedModel(model_path, weight)) {
+          return false;
+        }
+        test_config.run_config.mixed_models.emplace_back(std::move(model_path), weight);
+        break;
+      }
+      case 'j':
+        test_config.run_config.latency_report_file = optarg;
+        break;
       case '?':
       case 'h':
       default:
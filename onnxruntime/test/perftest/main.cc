@@ -5,6 +5,7 @@
 #include <core/session/onnxruntime_c_api.h>
 #include <random>
 #include "command_args_parser.h"
+#include "open_loop_runner.h"
 #include "performance_runner.h"
 #include <google/protobuf/stubs/common.h>
 
@@ -42,6 +43,16 @@ int real_main(int argc, char* argv[]) {
       return -1;
   }
   std::random_device rd;
+  if (test_config.run_config.test_mode == perftest::TestMode::kOpenLoopMode) {
+    perftest::OpenLoopRunner open_loop_runner(env, test_config, rd);
+    auto status = open_loop_runner.Run();
+    if (!status.IsOK()) {
+      printf("Run failed:%s\n", status.ErrorMessage().c_str());
+      return -1;
+    }
+    return 0;
+  }
+
   perftest::PerformanceRunner perf_runner(env, test_config, rd);
   auto status = perf_runner.Run();
   if (!status.IsOK()) {
@@ -0,0 +1,287 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "open_loop_runner.h"
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include <core/platform/path_lib.h>
+#include "performance_runner.h"
+
+namespace onnxruntime {
+namespace perftest {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct LatencyStats {
+  static constexpr std::array<double, 4> kQuantiles = {0.5, 0.9, 0.99, 0.999};
+  static constexpr std::array<const char*, 4> kQuantileNames = {"p50", "p90", "p99", "p99.9"};
+
+  explicit LatencyStats(std::vector<double> samples_ms) : samples(std::move(samples_ms)) {
+    std::sort(samples.begin(), samples.end());
+  }
+
+  double Quantile(double q) const {
+    if (samples.empty()) {
+      return 0.0;
+    }
+    return samples[std::min(samples.size() - 1, static_cast<size_t>(samples.size() * q))];
+  }
+
+  double Max() const { return samples.empty() ? 0.0 : samples.back(); }
+
+  std::vector<double> samples;
+};
+
+double ToMilliseconds(Clock::duration duration) {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+struct GroupStats {
+  size_t num_requests = 0;
+  size_t num_failed = 0;
+  LatencyStats latency;
+  LatencyStats queueing;
+  LatencyStats inference;
+};
+
+// the stats of the requests of a model, or of all of them if model is models.size()
+template <typename Requests>
+GroupStats CollectStats(const Requests& requests, size_t model, size_t num_models) {
+  std::vector<double> latency, queueing, inference;
+  size_t num_failed = 0;
+  for (const auto& request : requests) {
+    if (model != num_models && request.model != model) {
+      continue;
+    }
+    num_failed += request.failed ? 1 : 0;
+    latency.push_back(ToMilliseconds(request.end - request.arrival));
+    queueing.push_back(ToMilliseconds(request.start - request.arrival));
+    inference.push_back(ToMilliseconds(request.end - request.start));
+  }
+  const size_t num_requests = latency.size();
+  return {num_requests, num_failed, LatencyStats(std::move(latency)), LatencyStats(std::move(queueing)),
+          LatencyStats(std::move(inference))};
+}
+
+void WriteStatsText(std::ostream& os, const char* label, const LatencyStats& stats) {
+  os << "  " << std::left << std::setw(14) << label << std::right;
+  for (size_t i = 0; i < LatencyStats::kQuantiles.size(); ++i) {
+    os << " " << LatencyStats::kQuantileNames[i] << ":" << std::fixed << std::setprecision(3)
+       << stats.Quantile(LatencyStats::kQuantiles[i]);
+  }
+  os << " max:" << stats.Max() << " ms\n";
+}
+
+void WriteStatsJson(std::ostream& os, const char* label, const LatencyStats& stats) {
+  os << "\"" << label << "\": {";
+  for (size_t i = 0; i < LatencyStats::kQuantiles.size(); ++i) {
+    os << "\"" << LatencyStats::kQuantileNames[i] << "\": " << stats.Quantile(LatencyStats::kQuantiles[i]) << ", ";
+  }
+  os << "\"max\": " << stats.Max() << "}";
+}
+
+}  // namespace
+
+OpenLoopRunner::OpenLoopRunner(Ort::Env& env, const PerformanceTestConfig& test_config, std::random_device& rd)
+    : test_config_(test_config), rng_(rd()) {
+  std::vector<std::pair<std::basic_string<ORTCHAR_T>, double>> models{{test_config.model_info.model_file_path, 1.0}};
+  models.insert(models.end(), test_config.run_config.mixed_models.begin(), test_config.run_config.mixed_models.end());
+
+  for (const auto& [model_path, weight] : models) {
+    PerformanceTestConfig model_config = test_config;
+    model_config.model_info.model_file_path = model_path;
+
+    Model model;
+    model.weight = weight;
+    for (size_t i = 0; i < std::max<size_t>(1, test_config.run_config.num_sessions); ++i) {
+      model.sessions.push_back(std::make_unique<PerformanceRunner>(env, model_config, rd));
+    }
+    models_.push_back(std::move(model));
+  }
+}
+
+OpenLoopRunner::~OpenLoopRunner() = default;
+
+Status OpenLoopRunner::Run() {
+  const auto& run_config = test_config_.run_config;
+  if (run_config.open_loop_qps <= 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "open loop mode needs a positive target QPS.");
+  }
+
+  std::vector<double> weights;
+  for (auto& model : models_) {
+    for (auto& session : model.sessions) {
+      ORT_RETURN_IF_ERROR(session->Prepare());
+    }
+    model.name = model.sessions.front()->GetResult().model_name;
+    weights.push_back(model.weight);
+  }
+
+  // the requests keep their address while more are added, so the workers fill in the timings without holding the
+  // lock
+  std::deque<Request> requests;
+  std::deque<std::pair<Request*, PerformanceRunner*>> pending;
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool done = false;
+
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < std::max<size_t>(1, run_config.concurrent_session_runs); ++i) {
+    workers.emplace_back([&]() {
+      while (true) {
+        std::pair<Request*, PerformanceRunner*> next;
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          cv.wait(lock, [&]() { return done || !pending.empty(); });
+          if (pending.empty()) {
+            return;
+          }
+          next = pending.front();
+          pending.pop_front();
+        }
+
+        Request& request = *next.first;
+        request.start = Clock::now();
+        std::chrono::duration<double> duration;
+        auto status = next.second->RunRequest(duration);
+        request.end = Clock::now();
+        if (!status.IsOK()) {
+          request.failed = true;
+          std::cerr << status.ErrorMessage() << std::endl;
+        }
+      }
+    });
+  }
+
+  // the arrival times are scheduled up front and the latency is measured from them, so a request delayed by the
+  // one before it counts the delay instead of the load generator slowing down
+  std::exponential_distribution<double> poisson_interval(run_config.open_loop_qps);
+  std::discrete_distribution<size_t> pick_model(weights.begin(), weights.end());
+  const auto start = Clock::now();
+  const auto measure_start = start + std::chrono::seconds(run_config.warmup_in_seconds);
+  const auto end = measure_start + std::chrono::seconds(run_config.duration_in_seconds);
+  for (auto arrival = start; arrival < end;) {
+    std::this_thread::sleep_until(arrival);
+
+    const size_t model_index = pick_model(rng_);
+    Model& model = models_[model_index];
+    PerformanceRunner* session = model.sessions[model.next_session++ % model.sessions.size()].get();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      requests.push_back({model_index, arrival, {}, {}, false});
+      pending.emplace_back(&requests.back(), session);
+    }
+    cv.notify_one();
+
+    const double interval_seconds = run_config.arrival_distribution == ArrivalDistribution::kPoisson
+                                        ? poisson_interval(rng_)
+                                        : 1.0 / run_config.open_loop_qps;
+    arrival += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(interval_seconds));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    done = true;
+  }
+  cv.notify_all();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  std::vector<Request> measured;
+  std::copy_if(requests.begin(), requests.end(), std::back_inserter(measured),
+               [&](const Request& request) { return request.arrival >= measure_start; });
+  // the requests which arrived during the measured duration are served until they complete
+  auto last_end = measure_start;
+  for (const auto& request : measured) {
+    last_end = std::max(last_end, request.end);
+  }
+  const double measured_seconds = std::chrono::duration<double>(last_end - measure_start).count();
+
+  Report(measured, measured_seconds);
+  if (!run_config.latency_report_file.empty()) {
+    ORT_RETURN_IF_ERROR(ExportReport(measured, measured_seconds));
+  }
+  return Status::OK();
+}
+
+void OpenLoopRunner::Report(const std::vector<Request>& requests, double measured_seconds) const {
+  const auto& run_config = test_config_.run_config;
+  std::cout << "Open loop test: target " << run_config.open_loop_qps << " QPS ("
+            << (run_config.arrival_distribution == ArrivalDistribution::kPoisson ? "poisson" : "constant")
+            << " arrivals), " << run_config.duration_in_seconds << " s measured after " << run_config.warmup_in_seconds
+            << " s warmup, " << std::max<size_t>(1, run_config.concurrent_session_runs) << " concurrent runs\n";
+
+  // all models first, then each model when the load is mixed
+  const size_t num_models = models_.size();
+  for (size_t group = 0; group <= (num_models > 1 ? num_models : 0); ++group) {
+    const size_t model = group == 0 ? num_models : group - 1;
+    const GroupStats stats = CollectStats(requests, model, num_models);
+    std::cout << (group == 0 ? "All models" : "Model " + models_[model].name) << ": " << stats.num_requests
+              << " requests, " << stats.num_failed << " failed, throughput " << std::fixed << std::setprecision(2)
+              << (measured_seconds > 0 ? stats.num_requests / measured_seconds : 0.0) << " requests/s\n";
+    WriteStatsText(std::cout, "latency", stats.latency);
+    WriteStatsText(std::cout, "queueing delay", stats.queueing);
+    WriteStatsText(std::cout, "inference", stats.inference);
+  }
+  std::cout << std::defaultfloat << std::flush;
+}
+
+Status OpenLoopRunner::ExportReport(const std::vector<Request>& requests, double measured_seconds) const {
+  const auto& path = test_config_.run_config.latency_report_file;
+  std::ofstream out(path, std::ofstream::out | std::ofstream::trunc);
+  if (!out.good()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to open latency report file '", ToUTF8String(path), "'.");
+  }
+
+  if (!HasExtensionOf(path, ORT_TSTR("json"))) {
+    // every request, with the times relative to the arrival of the first measured request
+    out << "model,arrival_s,queueing_delay_ms,inference_ms,latency_ms,failed\n" << std::setprecision(9);
+    const auto origin = requests.empty() ? Clock::time_point{} : requests.front().arrival;
+    for (const auto& request : requests) {
+      out << models_[request.model].name << "," << std::chrono::duration<double>(request.arrival - origin).count()
+          << "," << ToMilliseconds(request.start - request.arrival) << ","
+          << ToMilliseconds(request.end - request.start) << "," << ToMilliseconds(request.end - request.arrival)
+          << "," << (request.failed ? 1 : 0) << "\n";
+    }
+    return Status::OK();
+  }
+
+  const auto& run_config = test_config_.run_config;
+  out << "{\"target_qps\": " << run_config.open_loop_qps << ", \"arrival_distribution\": \""
+      << (run_config.arrival_distribution == ArrivalDistribution::kPoisson ? "poisson" : "constant")
+      << "\", \"warmup_seconds\": " << run_config.warmup_in_seconds
+      << ", \"duration_seconds\": " << run_config.duration_in_seconds
+      << ", \"concurrent_runs\": " << std::max<size_t>(1, run_config.concurrent_session_runs)
+      << ", \"sessions_per_model\": " << std::max<size_t>(1, run_config.num_sessions) << ", \"models\": [";
+  for (size_t model = 0; model < models_.size(); ++model) {
+    const GroupStats stats = CollectStats(requests, model, models_.size());
+    out << (model > 0 ? ", " : "") << "{\"name\": \"" << models_[model].name << "\", \"weight\": "
+        << models_[model].weight << ", \"requests\": " << stats.num_requests << ", \"failed\": " << stats.num_failed
+        << ", \"throughput\": " << (measured_seconds > 0 ? stats.num_requests / measured_seconds : 0.0) << ", ";
+    WriteStatsJson(out, "latency_ms", stats.latency);
+    out << ", ";
+    WriteStatsJson(out, "queueing_delay_ms", stats.queueing);
+    out << ", ";
+    WriteStatsJson(out, "inference_ms", stats.inference);
+    out << "}";
+  }
+  out << "]}\n";
+  return Status::OK();
+}
+
+}  // namespace perftest
+}  // namespace onnxruntime
@@ -0,0 +1,64 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <core/common/common.h>
+#include <core/common/status.h>
+#include <core/session/onnxruntime_cxx_api.h>
+#include "test_configuration.h"
+
+namespace onnxruntime {
+namespace perftest {
+
+class PerformanceRunner;
+
+// Drives sessions with requests arriving at a target rate, as a server would see them, instead of issuing the next
+// request when the previous one completes. A request waits in a queue until one of the concurrent_session_runs
+// workers is free, so once the rate exceeds what the sessions sustain the queueing delay grows instead of the rate
+// dropping, the way latency degrades under overload in production.
+//
+// The load is spread over num_sessions sessions of the main model and of each mixed model, picking the model by
+// weight and its sessions round robin. Latency is measured from the arrival of the request, and split into the
+// queueing delay and the inference time.
+class OpenLoopRunner {
+ public:
+  OpenLoopRunner(Ort::Env& env, const PerformanceTestConfig& test_config, std::random_device& rd);
+  ~OpenLoopRunner();
+
+  Status Run();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(OpenLoopRunner);
+
+ private:
+  struct Request {
+    size_t model;
+    std::chrono::steady_clock::time_point arrival;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point end;
+    bool failed = false;
+  };
+
+  struct Model {
+    std::string name;
+    double weight;
+    std::vector<std::unique_ptr<PerformanceRunner>> sessions;
+    size_t next_session = 0;
+  };
+
+  void Report(const std::vector<Request>& requests, double measured_seconds) const;
+  Status ExportReport(const std::vector<Request>& requests, double measured_seconds) const;
+
+  PerformanceTestConfig test_config_;
+  std::vector<Model> models_;
+  std::mt19937 rng_;
+};
+
+}  // namespace perftest
+}  // namespace onnxruntime
@@ -167,6 +167,14 @@ Status PerformanceRunner::Run() {
   return Status::OK();
 }
 
+Status PerformanceRunner::Prepare() {
+  if (!Initialize()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to initialize.");
+  }
+
+  return RunOneIteration<true>();
+}
+
 Status PerformanceRunner::FixDurationTest() {
   if (performance_test_config_.run_config.concurrent_session_runs <= 1) {
     return RunFixDuration();
@@ -46,6 +46,23 @@ class PerformanceRunner {
   ~PerformanceRunner();
   Status Run();
 
+  // Loads the test data and runs the first inference, for callers scheduling the inferences themselves
+  Status Prepare();
+
+  // Runs one inference with the preloaded test data. May be called concurrently.
+  Status RunRequest(std::chrono::duration<double>& duration) {
+    auto status = Status::OK();
+    ORT_TRY {
+      duration = session_->Run();
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "PerformanceRunner::RunRequest caught exception: ", ex.what());
+      });
+    }
+    return status;
+  }
+
   inline const PerformanceResult& GetResult() const { return performance_result_; }
 
   inline void SerializeResult() const {
@@ -60,17 +77,7 @@ class PerformanceRunner {
   template <bool isWarmup>
   Status RunOneIteration() {
     std::chrono::duration<double> duration_seconds(std::chrono::seconds(0));
-
-    auto status = Status::OK();
-    ORT_TRY {
-      duration_seconds = session_->Run();
-    }
-    ORT_CATCH(const std::exception& ex) {
-      ORT_HANDLE_EXCEPTION([&]() {
-        status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "PerformanceRunner::RunOneIteration caught exception: ", ex.what());
-      });
-    }
-    ORT_RETURN_IF_ERROR(status);
+    ORT_RETURN_IF_ERROR(RunRequest(duration_seconds));
 
     if (!isWarmup) {
       std::lock_guard<OrtMutex> guard(results_mutex_);
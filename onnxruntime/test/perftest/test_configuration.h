@@ -6,6 +6,8 @@
 #include <map>
 #include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "core/graph/constants.h"
 #include "core/framework/session_options.h"
@@ -15,7 +17,14 @@ namespace perftest {
 
 enum class TestMode : std::uint8_t {
   kFixDurationMode = 0,
-  KFixRepeatedTimesMode
+  KFixRepeatedTimesMode,
+  // requests arrive at a target rate regardless of how fast they complete, see OpenLoopRunner
+  kOpenLoopMode
+};
+
+enum class ArrivalDistribution : std::uint8_t {
+  kPoisson = 0,
+  kConstant
 };
 
 enum class Platform : std::uint8_t {
@@ -61,6 +70,16 @@ struct RunConfig {
   std::string intra_op_thread_affinities;
   bool disable_spinning = false;
   bool disable_spinning_between_run = false;
+  // open loop mode: requests per second, how they arrive, the seconds of requests left out of the statistics
+  // before the duration_in_seconds measured, and the sessions created per model
+  double open_loop_qps{0};
+  ArrivalDistribution arrival_distribution{ArrivalDistribution::kPoisson};
+  size_t warmup_in_seconds{0};
+  size_t num_sessions{1};
+  // models sharing the open loop load with the main model, with their weights. The main model has a weight of 1.
+  std::vector<std::pair<std::basic_string<ORTCHAR_T>, double>> mixed_models;
+  // file the open loop latencies are exported to: a summary if it ends with .json, every request as CSV otherwise
+  std::basic_string<ORTCHAR_T> latency_report_file;
 };
 
 struct PerformanceTestConfig {
@@ -3,6 +3,7 @@
 
 #include "core/platform/env.h"
 
+#include <algorithm>
 #include <fstream>
 
 #include "gtest/gtest.h"
@@ -33,5 +34,33 @@ TEST(PlatformEnvTest, DirectoryCreationAndDeletion) {
   ASSERT_FALSE(env.FolderExists(root_dir));
 }
 
+TEST(PlatformEnvTest, CoreEfficiencyClasses) {
+  const auto& env = Env::Default();
+  const auto efficiency_classes = env.GetCoreEfficiencyClasses();
+
+  // one class per core, or none if the cores are all alike
+  if (!efficiency_classes.empty()) {
+    ASSERT_EQ(efficiency_classes.size(), env.GetDefaultThreadAffinities().size());
+    EXPECT_NE(*std::min_element(efficiency_classes.begin(), efficiency_classes.end()),
+              *std::max_element(efficiency_classes.begin(), efficiency_classes.end()));
+  }
+}
+
+TEST(PlatformEnvTest, CoreCacheDomains) {
+  const auto& env = Env::Default();
+  const auto cache_domains = env.GetCoreCacheDomains();
+
+  // one domain per core, numbered in the order of their first core, or none if all cores share one cache
+  if (!cache_domains.empty()) {
+    ASSERT_EQ(cache_domains.size(), env.GetDefaultThreadAffinities().size());
+    int max_domain = -1;
+    for (int domain : cache_domains) {
+      ASSERT_LE(domain, max_domain + 1);
+      max_domain = std::max(max_domain, domain);
+    }
+    EXPECT_GT(max_domain, 0);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
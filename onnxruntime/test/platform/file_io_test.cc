@@ -3,13 +3,15 @@
 
 #include "core/platform/env.h"
 
+#include <algorithm>
 #include <fstream>
 #include <random>
 #include <utility>
 #include <vector>
 
 #ifndef _WIN32
-#include <unistd.h>  // for sysconf() and _SC_PAGESIZE
+#include <sys/mman.h>  // for shm_unlink()
+#include <unistd.h>    // for sysconf() and _SC_PAGESIZE
 #else
 #include <Windows.h>
 #endif
@@ -19,6 +21,7 @@
 #include "gtest/gtest.h"
 
 #include "core/common/span_utils.h"
+#include "test/util/include/asserts.h"
 #include "test/util/include/file_util.h"
 
 namespace onnxruntime {
@@ -208,5 +211,39 @@ TEST(FileIoTest, MapFileIntoMemory) {
 }
 #endif
 
+#if !defined(__ANDROID__)  // POSIX shared memory is not available on Android
+TEST(FileIoTest, MapSharedMemory) {
+  const std::string name = "ort_map_shared_memory_test_" + std::to_string(Env::Default().GetSelfPid());
+  const auto expected_data = GenerateData(10000);
+
+  size_t num_initializations = 0;
+  const auto initialize = [&](gsl::span<char> data) {
+    ++num_initializations;
+    ASSERT_EQ(data.size(), expected_data.size());
+    std::copy(expected_data.begin(), expected_data.end(), data.begin());
+  };
+
+  Env::MappedMemoryPtr first{}, second{};
+  ASSERT_STATUS_OK(Env::Default().MapSharedMemory(name, expected_data.size(), initialize, first));
+  ASSERT_STATUS_OK(Env::Default().MapSharedMemory(name, expected_data.size(), initialize, second));
+  EXPECT_EQ(num_initializations, 1u);
+  EXPECT_TRUE(SpanEq(gsl::make_span(second.get(), expected_data.size()), gsl::make_span(expected_data)));
+
+  // writes are private to a mapping
+  first[0] = static_cast<char>(~expected_data[0]);
+  EXPECT_EQ(second[0], expected_data[0]);
+
+  // a segment of another length is not used
+  Env::MappedMemoryPtr third{};
+  EXPECT_FALSE(Env::Default().MapSharedMemory(name, expected_data.size() / 2, initialize, third).IsOK());
+
+  ASSERT_FALSE(Env::Default().MapSharedMemory("", expected_data.size(), initialize, third).IsOK());
+
+#ifndef _WIN32
+  shm_unlink(("/" + name).c_str());
+#endif
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
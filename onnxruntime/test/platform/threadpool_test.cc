@@ -12,8 +12,11 @@
 
 #include "gtest/gtest.h"
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <functional>
+#include <set>
+#include <thread>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -510,6 +513,199 @@ TEST(ThreadPoolTest, TestStagedMultiLoopSections_4Thread_100Loop) {
   TestStagedMultiLoopSections("TestStagedMultiLoopSections_4Thread_100Loop", 4, 100);
 }
 
+// Loops whose first iterations are much more expensive than the rest, as with sorted ragged batches
+static void TestWorkStealingParallelFor(int num_threads, int num_tasks, bool use_pool_option) {
+  auto test_data = CreateTestData(num_tasks);
+  auto body = [&](ThreadPool* tp) {
+    const auto fn = [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      for (std::ptrdiff_t i = first; i < last; ++i) {
+        if (i < num_tasks / 8) {
+          std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        IncrementElement(*test_data, i);
+      }
+    };
+    const onnxruntime::TensorOpCost cost{0, 0, 100000};
+    if (use_pool_option) {
+      ThreadPool::TryParallelFor(tp, num_tasks, cost, fn);
+    } else {
+      ThreadPool::TryWorkStealingParallelFor(tp, num_tasks, cost, fn);
+    }
+  };
+
+  if (use_pool_option && num_threads > 0) {
+    onnxruntime::ThreadOptions thread_options;
+    thread_options.work_stealing_loops_ = true;
+    ThreadPool tp(&onnxruntime::Env::Default(), thread_options, nullptr, num_threads, true);
+    body(&tp);
+  } else {
+    CreateThreadPoolAndTest("TestWorkStealingParallelFor", num_threads, body);
+  }
+  ValidateTestData(*test_data);
+}
+
+TEST(ThreadPoolTest, TestWorkStealingParallelFor_0Thread) {
+  TestWorkStealingParallelFor(0, 100, false);
+}
+
+TEST(ThreadPoolTest, TestWorkStealingParallelFor_4Thread_1Task) {
+  TestWorkStealingParallelFor(4, 1, false);
+}
+
+TEST(ThreadPoolTest, TestWorkStealingParallelFor_4Thread_1000Tasks) {
+  TestWorkStealingParallelFor(4, 1000, false);
+}
+
+TEST(ThreadPoolTest, TestWorkStealingParallelFor_4Thread_1000Tasks_PoolOption) {
+  TestWorkStealingParallelFor(4, 1000, true);
+}
+
+TEST(ThreadPoolTest, TestSchedulingScopeMaxDegreeOfParallelism) {
+  CreateThreadPoolAndTest("TestSchedulingScopeMaxDegreeOfParallelism", 4, [&](ThreadPool* tp) {
+    const int unlimited_dop = ThreadPool::DegreeOfParallelism(tp);
+    {
+      ThreadPool::SchedulingScope scope(ThreadPool::Priority::kNormal, 2);
+      EXPECT_LE(ThreadPool::DegreeOfParallelism(tp), unlimited_dop / 2);
+
+      constexpr int num_tasks = 64;
+      auto test_data = CreateTestData(num_tasks);
+      std::set<std::thread::id> thread_ids;
+      ThreadPool::TrySimpleParallelFor(tp, num_tasks, [&](std::ptrdiff_t i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::lock_guard<onnxruntime::OrtMutex> lock(test_data->mutex);
+        thread_ids.insert(std::this_thread::get_id());
+        test_data->data[i]++;
+      });
+      ValidateTestData(*test_data);
+      EXPECT_LE(thread_ids.size(), 2u);
+
+      {
+        // a quota of 1 runs loops in the calling thread only
+        ThreadPool::SchedulingScope inner_scope(ThreadPool::Priority::kNormal, 1);
+        thread_ids.clear();
+        ThreadPool::TrySimpleParallelFor(tp, num_tasks, [&](std::ptrdiff_t) {
+          thread_ids.insert(std::this_thread::get_id());
+        });
+        ASSERT_EQ(thread_ids.size(), 1u);
+        EXPECT_EQ(*thread_ids.begin(), std::this_thread::get_id());
+      }
+    }
+    EXPECT_EQ(ThreadPool::DegreeOfParallelism(tp), unlimited_dop);
+  });
+}
+
+// Run normal priority multi-loop sections concurrently with high priority loops, checking
+// that the workers held back from the normal priority sections do not lose any iterations.
+TEST(ThreadPoolTest, TestSchedulingScopeMixedPriorities) {
+  constexpr int num_tasks = 1024;
+  constexpr int num_loops = 50;
+  CreateThreadPoolAndTest("TestSchedulingScopeMixedPriorities", 4, [&](ThreadPool* tp) {
+    auto normal_data = CreateTestData(num_tasks);
+    auto high_data = CreateTestData(num_tasks);
+
+    std::thread normal_thread([&]() {
+      ThreadPool::SchedulingScope scope(ThreadPool::Priority::kNormal, 0);
+      ThreadPool::ParallelSection ps(tp);
+      for (int l = 0; l < num_loops; l++) {
+        ThreadPool::TrySimpleParallelFor(tp, num_tasks, [&](std::ptrdiff_t i) {
+          IncrementElement(*normal_data, i);
+        });
+      }
+    });
+    std::thread high_thread([&]() {
+      ThreadPool::SchedulingScope scope(ThreadPool::Priority::kHigh, 0);
+      for (int l = 0; l < num_loops; l++) {
+        ThreadPool::TrySimpleParallelFor(tp, num_tasks, [&](std::ptrdiff_t i) {
+          IncrementElement(*high_data, i);
+        });
+      }
+    });
+    normal_thread.join();
+    high_thread.join();
+
+    ValidateTestData(*normal_data, num_loops);
+    ValidateTestData(*high_data, num_loops);
+  });
+}
+
+// Bursts of loops separated by gaps much longer than the adaptive spin limit. The loops must
+// complete, and the workers must block in the gaps instead of spinning through them.
+TEST(ThreadPoolTest, TestAdaptiveSpinning) {
+  constexpr int num_tasks = 1024;
+  constexpr int num_bursts = 5;
+  constexpr int num_loops = 20;
+  onnxruntime::ThreadOptions thread_options;
+  thread_options.adaptive_spinning_ = true;
+  ThreadPool tp(&onnxruntime::Env::Default(), thread_options, nullptr, 4, true);
+  auto test_data = CreateTestData(num_tasks);
+
+  ThreadPool::StartProfiling(&tp);
+  for (int b = 0; b < num_bursts; b++) {
+    for (int l = 0; l < num_loops; l++) {
+      ThreadPool::TrySimpleParallelFor(&tp, num_tasks, [&](std::ptrdiff_t i) {
+        IncrementElement(*test_data, i);
+      });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+  const std::string profile = ThreadPool::StopProfiling(&tp);
+
+  ValidateTestData(*test_data, num_bursts * num_loops);
+#if !defined(ORT_MINIMAL_BUILD)
+  uint64_t num_park = 0;
+  const std::string num_park_key = "\"num_park\": ";
+  for (auto pos = profile.find(num_park_key); pos != std::string::npos; pos = profile.find(num_park_key, pos + 1)) {
+    num_park += std::stoull(profile.substr(pos + num_park_key.size()));
+  }
+  EXPECT_GE(num_park, static_cast<uint64_t>(num_bursts - 1)) << profile;
+#endif
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+TEST(ThreadPoolTest, TestTraceEvents) {
+  constexpr int num_tasks = 1024;
+  ThreadPool tp(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions{}, nullptr, 4, true);
+  auto test_data = CreateTestData(num_tasks);
+
+  // nothing is recorded when not profiling
+  ThreadPool::TrySimpleParallelFor(&tp, num_tasks, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+  int num_events = 0;
+  ThreadPool::DrainTraceEvents(&tp, [&](const ThreadPoolTraceEvent&) { ++num_events; });
+  EXPECT_EQ(num_events, 0);
+
+  ThreadPool::StartProfiling(&tp);
+  ThreadPool::TrySimpleParallelFor(&tp, num_tasks, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+  ThreadPool::StopProfiling(&tp);
+  ValidateTestData(*test_data, 2);
+
+  std::set<std::ptrdiff_t> work_items;
+  std::ptrdiff_t num_blocks = 0;
+  ThreadPool::DrainTraceEvents(&tp, [&](const ThreadPoolTraceEvent& e) {
+    EXPECT_LE(e.start, e.end);
+    switch (e.type) {
+      case ThreadPoolTraceEvent::WORK_ITEM:
+        work_items.insert(e.arg);
+        break;
+      case ThreadPoolTraceEvent::BLOCK:
+      case ThreadPoolTraceEvent::STEAL:
+        EXPECT_LT(e.arg, num_tasks);
+        ++num_blocks;
+        break;
+      default:
+        break;
+    }
+  });
+  EXPECT_FALSE(work_items.empty());
+  EXPECT_EQ(work_items.count(0), 1u) << "the calling thread runs the first work item";
+  EXPECT_GT(num_blocks, 0);
+
+  // drained events are not returned again
+  num_events = 0;
+  ThreadPool::DrainTraceEvents(&tp, [&](const ThreadPoolTraceEvent&) { ++num_events; });
+  EXPECT_EQ(num_events, 0);
+}
+#endif
+
 #ifdef _WIN32
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
 #pragma warning(push)
@@ -167,6 +167,54 @@ TEST(CoreMLExecutionProviderTest, ShapeThenSliceAndGather) {
 #endif
 }
 
+TEST(CoreMLExecutionProviderTest, MLProgramTest) {
+  // A MatMul of 2 dynamic 3D inputs followed by an Erf, which are only supported when creating an MLProgram.
+  const ORTCHAR_T* model_file_name = ORT_TSTR("coreml_execution_provider_mlprogram_test_graph.onnx");
+
+  {
+    onnxruntime::Model model("graph_1", false, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    ONNX_NAMESPACE::TypeProto float_tensor;
+    float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+    float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+    float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+    auto& input_arg_1 = graph.GetOrCreateNodeArg("X", &float_tensor);
+    auto& input_arg_2 = graph.GetOrCreateNodeArg("Y", &float_tensor);
+    auto& matmul_output_arg = graph.GetOrCreateNodeArg("matmul_out", &float_tensor);
+    graph.AddNode("node_1", "MatMul", "node 1.", {&input_arg_1, &input_arg_2}, {&matmul_output_arg});
+
+    auto& output_arg = graph.GetOrCreateNodeArg("Z", &float_tensor);
+    graph.AddNode("node_2", "Erf", "node 2.", {&matmul_output_arg}, {&output_arg});
+
+    ASSERT_STATUS_OK(graph.Resolve());
+    ASSERT_STATUS_OK(onnxruntime::Model::Save(model, model_file_name));
+  }
+
+  const uint32_t coreml_flags = s_coreml_flags | COREML_FLAG_CREATE_MLPROGRAM | COREML_FLAG_CACHE_COMPILED_MODEL;
+
+#if defined(__APPLE__)
+  RandomValueGenerator gen{1234};
+  std::vector<int64_t> shape = {2, 3, 3};
+  std::vector<float> X_data = gen.Uniform<float>(shape, -1.0f, 1.0f);
+  std::vector<float> Y_data = gen.Uniform<float>(shape, -1.0f, 1.0f);
+  OrtValue X = CreateInputOrtValueOnCPU<float>(shape, X_data);
+  OrtValue Y = CreateInputOrtValueOnCPU<float>(shape, Y_data);
+
+  // the second run loads the compiled model from the cache
+  for (int i = 0; i < 2; ++i) {
+    RunAndVerifyOutputsWithEP(model_file_name, CurrentTestName(),
+                              MakeCoreMLExecutionProvider(coreml_flags),
+                              {{"X", X}, {"Y", Y}},
+                              EPVerificationParams{ExpectedEPNodeAssignment::All});
+  }
+#else
+  TestModelLoad(model_file_name, MakeCoreMLExecutionProvider(coreml_flags), ExpectedEPNodeAssignment::All);
+#endif
+}
+
 #endif  // !(ORT_MINIMAL_BUILD)
 
 TEST(CoreMLExecutionProviderTest, TestOrtFormatModel) {
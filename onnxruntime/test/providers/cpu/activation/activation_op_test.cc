@@ -585,6 +585,18 @@ TEST_F(ActivationOpTest, Softplus) {
                             else
                               return log1pf(expf(x));
                           });
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+  TestActivationOp<MLFloat16>(
+      "Softplus",
+      input_values_fp16,
+      [](MLFloat16 x) {
+        float value = x.ToFloat();
+        return MLFloat16(value > 0 ? value + log1pf(expf(-value)) : log1pf(expf(value)));
+      },
+      {},
+      /*is_tensorrt_supported=*/false,
+      /*opset_version= */ 1);
+#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
 }
 
 TEST_F(ActivationOpNoInfTest, Softsign) {
@@ -1042,6 +1042,82 @@ TEST(Loop, IterationCountAsOutput) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
 
+// the condition is passed through so the number of iterations is M, and the scan output is written directly to the
+// Loop output
+TEST(Loop, ScanOutputWithKnownTripCount) {
+  auto create_subgraph = []() {
+    Model model("Known trip count subgraph", false, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    /* Inputs: iter_num, cond_in, loop carried state variables.
+
+         iter_num_in    loop_var_0_in      cond_in
+             |               |                |
+           [Cast]            |            [Identity]
+             |               |                |
+             +-----[Add]-----+             cond_out
+                     |
+               loop_var_0_out
+                     |
+                 [Identity]
+                     |
+                loop_out_0
+    */
+
+    TypeProto int64_scalar;
+    int64_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+    int64_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto bool_scalar;
+    bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+    bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto float_scalar;
+    float_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    float_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto float_tensor;
+    float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+    auto& iter_num_in = graph.GetOrCreateNodeArg("iter_num_in", &int64_scalar);
+    auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar);
+    auto& loop_var_0_in = graph.GetOrCreateNodeArg("loop_var_0_in", &float_tensor);
+
+    auto& iter_num_float = graph.GetOrCreateNodeArg("iter_num_float", &float_scalar);
+    auto& cond_out = graph.GetOrCreateNodeArg("cond_out", &bool_scalar);
+    auto& loop_var_0_out = graph.GetOrCreateNodeArg("loop_var_0_out", &float_tensor);
+    auto& loop_out_0 = graph.GetOrCreateNodeArg("loop_out_0", &float_tensor);
+
+    auto& cast = graph.AddNode("cast", "Cast", "Cast iter_num_in to float", {&iter_num_in}, {&iter_num_float});
+    cast.AddAttribute("to", int64_t{TensorProto_DataType_FLOAT});
+    graph.AddNode("add", "Add", "Add iter_num to loop_var_0", {&loop_var_0_in, &iter_num_float}, {&loop_var_0_out});
+    graph.AddNode("loop_out_identity", "Identity", "Output loop_var_0_out", {&loop_var_0_out}, {&loop_out_0});
+    graph.AddNode("cond_in_identity", "Identity", "Forward cond_in to cond_out", {&cond_in}, {&cond_out});
+
+    graph.SetInputs({&iter_num_in, &cond_in, &loop_var_0_in});
+    graph.SetOutputs({&cond_out, &loop_var_0_out, &loop_out_0});
+
+    auto status = graph.Resolve();
+    EXPECT_EQ(status, Status::OK());
+
+    return graph.ToGraphProto();
+  };
+
+  OpTester test("Loop", 11);
+  auto body = create_subgraph();
+  test.AddAttribute<GraphProto>("body", body);
+  test.AddInput<int64_t>("M", {1}, {4});
+  test.AddInput<bool>("cond", {1}, {true});
+  test.AddInput<float>("loop_var_0_orig", {2}, {1.f, 2.f});
+
+  test.AddOutput<float>("loop_var_0_final", {2}, {7.f, 8.f});
+  test.AddOutput<float>("loop_out_0_final", {4, 2}, {1.f, 2.f, 2.f, 3.f, 4.f, 5.f, 7.f, 8.f});
+
+  // Disable TensorRT on unsupported data type BOOL
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM)
 // test that when part of the subgraph run on CUDA/ROCm it executes successfully
 TEST(Loop, MixedExecutionProviders) {
@@ -1166,6 +1242,158 @@ TEST(Loop, SequenceAsLoopCarriedDependency) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
 
+// Test the sequence ops updating the sequences that die with them in place
+TEST(Loop, SequenceUpdatedInPlaceInSubgraph) {
+  auto create_subgraph = []() {
+    Model model("sequence updated in place in Loop subgraph", false, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    std::vector<NodeArg*> inputs;
+    std::vector<NodeArg*> outputs;
+
+    /* Subgraph appends ones_tensor, erases the last element and inserts twos_tensor at the front
+
+    Inputs: iter_num, cond_in, loop_var_0_in
+
+          loop_var_0_in   ones_tensor            cond_in            iter_num
+                |             |                      |                (unused)
+         [SequenceInsert]-----/                  [Identity]
+                |                                    |
+         appended                             cond_out
+                |
+         [SequenceErase]
+                |
+         erased   twos_tensor  insert_pos
+                |       |          |
+         [SequenceInsert]----------/
+                |
+           loop_var_0_out
+   */
+
+    TypeProto int64_scalar;
+    int64_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+    int64_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto bool_scalar;
+    bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+    bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto float_tensor_sequence;
+    auto* tensor_type = float_tensor_sequence
+                            .mutable_sequence_type()
+                            ->mutable_elem_type()
+                            ->mutable_tensor_type();
+
+    tensor_type->set_elem_type(TensorProto_DataType_FLOAT);
+    tensor_type->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto float_tensor;
+    float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    float_tensor.mutable_tensor_type()->mutable_shape()->add_dim();
+
+    TypeProto int64_tensor;
+    int64_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+
+    // graph inputs
+    auto& iter_num_in = graph.GetOrCreateNodeArg("iter_num_in", &int64_scalar);
+    auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar);
+    auto& loop_var_0_in = graph.GetOrCreateNodeArg("loop_var_0_in", &float_tensor_sequence);
+
+    // graph outputs
+    auto& cond_out = graph.GetOrCreateNodeArg("cond_out", &bool_scalar);
+    auto& loop_var_0_out = graph.GetOrCreateNodeArg("loop_var_0_out", &float_tensor_sequence);
+
+    // the sequences that die with the op consuming them
+    auto& appended = graph.GetOrCreateNodeArg("appended", &float_tensor_sequence);
+    auto& erased = graph.GetOrCreateNodeArg("erased", &float_tensor_sequence);
+
+    // outer scope values. need type but not shape.
+    auto& ones_tensor = graph.GetOrCreateNodeArg("ones_tensor", &float_tensor);
+    auto& twos_tensor = graph.GetOrCreateNodeArg("twos_tensor", &float_tensor);
+    auto& insert_pos = graph.GetOrCreateNodeArg("insert_pos", &int64_tensor);
+
+    // add them to the outer scope so that we don't end up with them being considered graph inputs
+    graph.AddOuterScopeNodeArg("ones_tensor");
+    graph.AddOuterScopeNodeArg("twos_tensor");
+    graph.AddOuterScopeNodeArg("insert_pos");
+
+    // cond_in -> cond_out
+    {
+      inputs = {&cond_in};
+      outputs = {&cond_out};
+
+      graph.AddNode("cond_in_identity", "Identity", "Forward cond_in to cond_out", inputs, outputs);
+    }
+
+    // loop_var_0_in -> appended -> erased -> loop_var_0_out
+    {
+      inputs = {&loop_var_0_in, &ones_tensor};
+      outputs = {&appended};
+      graph.AddNode("append", "SequenceInsert", "append to the sequence", inputs, outputs);
+
+      inputs = {&appended};
+      outputs = {&erased};
+      graph.AddNode("erase_last", "SequenceErase", "erase the last element of the sequence", inputs, outputs);
+
+      inputs = {&erased, &twos_tensor, &insert_pos};
+      outputs = {&loop_var_0_out};
+      graph.AddNode("insert_front", "SequenceInsert", "insert at the front of the sequence", inputs, outputs);
+    }
+
+    graph.SetInputs({&iter_num_in, &cond_in, &loop_var_0_in});
+    graph.SetOutputs({&cond_out, &loop_var_0_out});
+
+    // add the initializers for the tensors inserted into the sequence and the insertion position
+    {
+      TensorProto ones_tensor_proto;
+      ones_tensor_proto.set_name("ones_tensor");
+      ones_tensor_proto.add_dims(1);
+      ones_tensor_proto.add_float_data(1.f);
+      ones_tensor_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+      graph.AddInitializedTensor(ones_tensor_proto);
+
+      TensorProto twos_tensor_proto;
+      twos_tensor_proto.set_name("twos_tensor");
+      twos_tensor_proto.add_dims(1);
+      twos_tensor_proto.add_float_data(2.f);
+      twos_tensor_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+      graph.AddInitializedTensor(twos_tensor_proto);
+
+      TensorProto insert_pos_proto;
+      insert_pos_proto.set_name("insert_pos");
+      insert_pos_proto.add_int64_data(0);
+      insert_pos_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+      graph.AddInitializedTensor(insert_pos_proto);
+    }
+
+    auto status = graph.Resolve();
+    EXPECT_EQ(status, Status::OK());
+
+    return graph.ToGraphProto();
+  };
+
+  OpTester test("Loop", 13);
+  auto body = create_subgraph();
+  test.AddAttribute<GraphProto>("body", body);
+
+  test.AddInput<int64_t>("M", {1}, {2});
+  test.AddInput<bool>("cond", {1}, {true});
+
+  SeqTensors<float> seq_input;
+  seq_input.AddTensor({1}, {3.f});
+  test.AddSeqInput("loop_var_0_orig", seq_input);
+
+  // each iteration prepends a 2, the 1 it appends is erased
+  SeqTensors<float> seq_output;
+  seq_output.AddTensor({1}, {2.f});
+  seq_output.AddTensor({1}, {2.f});
+  seq_output.AddTensor({1}, {3.f});
+  test.AddSeqOutput("loop_var_0_final", seq_output);
+
+  // Disable TensorRT on unsupported data type BOOL
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 #if !defined(DISABLE_OPTIONAL_TYPE)
 
 TEST(Loop, OptionalTypeAsLoopCarriedDependency) {
@@ -236,6 +236,31 @@ TEST(Einsum, ExplicitEinsumAsMatmul_Multi_Input) {
   test.Run();
 }
 
+// Contracting the last two inputs first needs fewer multiply-adds than from left to right
+TEST(Einsum, ExplicitEinsumAsMatmul_Multi_Input_ReorderedContraction) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ij,jk,kl->il");
+  test.AddInput<float>("x", {4, 2}, {-1.f, 0.f, 1.f, 2.f, 3.f, -1.f, 0.f, 1.f});
+  test.AddInput<float>("y", {2, 5}, {-1.f, 0.f, 1.f, 2.f, -1.f, 0.f, 1.f, 2.f, -1.f, 0.f});
+  test.AddInput<float>("z", {5, 3}, {1.f, 2.f, 3.f, 1.f, 2.f, 3.f, 1.f, 2.f, 3.f, 1.f, 2.f, 3.f, 1.f, 2.f, 3.f});
+  test.AddOutput<float>("o", {4, 3}, {-1.f, -2.f, -3.f, 5.f, 10.f, 15.f, 1.f, 2.f, 3.f, 2.f, 4.f, 6.f});
+  test.Run();
+}
+
+TEST(Einsum, ExplicitEinsumAsBatchedMatmul_Multi_Input_ReorderedContraction) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "bij,bjk,k->bi");
+  test.AddInput<float>("x", {2, 3, 4}, {-1.f, 0.f, 1.f, -1.f, 0.f, 1.f, -1.f, 0.f, 1.f, -1.f, 0.f, 1.f,
+                                        0.f, 1.f, -1.f, 0.f, 1.f, -1.f, 0.f, 1.f, -1.f, 0.f, 1.f, -1.f});
+  test.AddInput<float>("y", {2, 4, 6}, {-2.f, -1.f, 0.f, 1.f, 2.f, -2.f, -1.f, 0.f, 1.f, 2.f, -2.f, -1.f,
+                                        0.f, 1.f, 2.f, -2.f, -1.f, 0.f, 1.f, 2.f, -2.f, -1.f, 0.f, 1.f,
+                                        0.f, 1.f, 2.f, -2.f, -1.f, 0.f, 1.f, 2.f, -2.f, -1.f, 0.f, 1.f,
+                                        2.f, -2.f, -1.f, 0.f, 1.f, 2.f, -2.f, -1.f, 0.f, 1.f, 2.f, -2.f});
+  test.AddInput<float>("z", {6}, {1.f, 2.f, 3.f, 1.f, 2.f, 3.f});
+  test.AddOutput<float>("o", {2, 3}, {8.f, -7.f, -1.f, -2.f, -2.f, 4.f});
+  test.Run();
+}
+
 TEST(Einsum, ExplicitEinsumAsBatchedMatmul) {
   OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
   test.AddAttribute<std::string>("equation", "bij,bjk->bik");
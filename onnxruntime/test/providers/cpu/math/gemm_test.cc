@@ -761,5 +761,49 @@ TEST(GemmOpTest, SharedPrepackedWeights) {
 }
 #endif
 
+// Most 4x4 blocks of B are zero, so the initializer is pre-packed for the sparse kernels
+TEST(GemmOpTest, GemmBlockSparseInitializer) {
+  OpTester test("Gemm", 13);
+
+  constexpr int64_t M = 6, K = 48, N = 30;
+  constexpr float alpha = 0.5f;
+  test.AddAttribute("transA", (int64_t)0);
+  test.AddAttribute("transB", (int64_t)1);
+  test.AddAttribute("alpha", alpha);
+  test.AddAttribute("beta", 1.0f);
+
+  std::vector<float> a_values(M * K), b_values(N * K, 0.0f), c_values(N), y_values(M * N);
+  for (int64_t i = 0; i < M * K; ++i) {
+    a_values[i] = static_cast<float>(i % 7 - 3);
+  }
+  for (int64_t n = 0; n < N; ++n) {
+    c_values[n] = static_cast<float>(n % 3 - 1);
+    for (int64_t k = 0; k < K; ++k) {
+      if (((k / 4) * 3 + (n / 4) * 7) % 6 == 0) {
+        b_values[n * K + k] = static_cast<float>((k + n) % 5 - 2);
+      }
+    }
+  }
+  for (int64_t m = 0; m < M; ++m) {
+    for (int64_t n = 0; n < N; ++n) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; ++k) {
+        sum += a_values[m * K + k] * b_values[n * K + k];
+      }
+      y_values[m * N + n] = alpha * sum + c_values[n];
+    }
+  }
+
+  test.AddInput<float>("A", {M, K}, a_values);
+  // B is to be an initializer for triggering pre-packing
+  test.AddInput<float>("B", {N, K}, b_values, true);
+  test.AddInput<float>("C", {N}, c_values);
+  test.AddOutput<float>("Y", {M, N}, y_values);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
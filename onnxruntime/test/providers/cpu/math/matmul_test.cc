@@ -2,12 +2,17 @@
 // Licensed under the MIT License.
 
 #include "gtest/gtest.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/providers/run_options_config_keys.h"
 #include "test/common/dnnl_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "default_providers.h"
+#ifdef ENABLE_STRIDED_TENSORS
+#include "test/providers/kernel_compute_test_utils.h"
+#endif
 
 namespace onnxruntime {
 namespace test {
@@ -226,7 +231,7 @@ TEST(MathOpTest, MatMulUint64Type) {
   RunMatMulTest<uint64_t>(9);
 }
 
-#if defined(USE_CUDA) || defined(USE_ROCM)
+#if defined(USE_CUDA) || defined(USE_ROCM) || defined(MLAS_F16GEMM_INTRINSICS_SUPPORTED)
 TEST(MathOpTest, MatMul_Float16) {
 #ifdef USE_CUDA
   int min_cuda_architecture = 530;
@@ -234,6 +239,10 @@ TEST(MathOpTest, MatMul_Float16) {
     LOGS_DEFAULT(WARNING) << "Hardware NOT support FP16";
     return;
   }
+#elif !defined(USE_ROCM)
+  if (!MlasFp16AccelerationSupported()) {
+    GTEST_SKIP() << "Hardware NOT support FP16";
+  }
 #endif
   OpTester test("MatMul", 14);
 
@@ -259,6 +268,41 @@ TEST(MathOpTest, MatMul_Float16) {
 }
 #endif
 
+#ifdef MLAS_F16GEMM_INTRINSICS_SUPPORTED
+TEST(MathOpTest, MatMul_Float16_Broadcast) {
+  if (!MlasFp16AccelerationSupported()) {
+    GTEST_SKIP() << "Hardware NOT support FP16";
+  }
+  OpTester test("MatMul", 13);
+
+  // A is [2, 2, 3], B is [3, 20] and is broadcast across the batch
+  std::vector<float> A{1.0f, 2.0f, 3.0f,
+                       -1.0f, 0.5f, 2.0f,
+                       4.0f, -3.0f, 1.0f,
+                       0.0f, 1.5f, -2.0f};
+  std::vector<float> B(3 * 20);
+  for (size_t i = 0; i < B.size(); i++) {
+    B[i] = static_cast<float>(static_cast<int>(i % 7) - 3);
+  }
+  std::vector<float> Y(4 * 20);
+  for (size_t m = 0; m < 4; m++) {
+    for (size_t n = 0; n < 20; n++) {
+      float sum = 0.0f;
+      for (size_t k = 0; k < 3; k++) {
+        sum += A[m * 3 + k] * B[k * 20 + n];
+      }
+      Y[m * 20 + n] = sum;
+    }
+  }
+
+  test.AddInput<MLFloat16>("A", {2, 2, 3}, FloatsToMLFloat16s(A));
+  test.AddInput<MLFloat16>("B", {3, 20}, FloatsToMLFloat16s(B), true);
+  test.AddOutput<MLFloat16>("Y", {2, 2, 20}, FloatsToMLFloat16s(Y));
+  test.ConfigEp(DefaultCpuExecutionProvider())
+      .RunWithConfig();
+}
+#endif
+
 #if defined(USE_CUDA) || defined(USE_ROCM) || defined(USE_DNNL)
 TEST(MathOpTest, MatMul_bfloat16) {
 #ifdef USE_CUDA
@@ -376,6 +420,106 @@ TEST(MathOpTest, MatMulSharedPrepackedWeights) {
   }
 }
 
+// The values are exact in bfloat16, so the results match whether or not the CPU computes in bfloat16
+TEST(MathOpTest, MatMulFastMathBf16) {
+  OpTester test("MatMul", 13);
+
+  constexpr int64_t M = 3, K = 40, N = 70;
+  std::vector<float> a_values(M * K), b_values(K * N), y_values(M * N, 0.0f);
+  for (int64_t i = 0; i < M * K; ++i) {
+    a_values[i] = static_cast<float>(i % 7 - 3);
+  }
+  for (int64_t i = 0; i < K * N; ++i) {
+    b_values[i] = static_cast<float>(i % 5 - 2);
+  }
+  for (int64_t m = 0; m < M; ++m) {
+    for (int64_t n = 0; n < N; ++n) {
+      for (int64_t k = 0; k < K; ++k) {
+        y_values[m * N + n] += a_values[m * K + k] * b_values[k * N + n];
+      }
+    }
+  }
+
+  test.AddInput<float>("A", {M, K}, a_values);
+  // B is to be an initializer for triggering pre-packing
+  test.AddInput<float>("B", {K, N}, b_values, true);
+  test.AddOutput<float>("Y", {M, N}, y_values);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsMlasGemmFastMathBf16, "1"));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Config(so)
+      .ConfigEps(std::move(execution_providers))
+      .RunWithConfig();
+}
+
+#endif
+
+// Most 4x4 blocks of B are zero, so the initializer is pre-packed for the sparse kernels
+TEST(MathOpTest, MatMulBlockSparseInitializer) {
+  OpTester test("MatMul", 13);
+
+  constexpr int64_t M = 5, K = 64, N = 38;
+  std::vector<float> a_values(M * K), b_values(K * N, 0.0f), y_values(M * N, 0.0f);
+  for (int64_t i = 0; i < M * K; ++i) {
+    a_values[i] = static_cast<float>(i % 7 - 3);
+  }
+  for (int64_t k = 0; k < K; ++k) {
+    for (int64_t n = 0; n < N; ++n) {
+      if (((k / 4) * 3 + (n / 4) * 7) % 6 == 0) {
+        b_values[k * N + n] = static_cast<float>((k + n) % 5 - 2);
+      }
+    }
+  }
+  for (int64_t m = 0; m < M; ++m) {
+    for (int64_t n = 0; n < N; ++n) {
+      for (int64_t k = 0; k < K; ++k) {
+        y_values[m * N + n] += a_values[m * K + k] * b_values[k * N + n];
+      }
+    }
+  }
+
+  test.AddInput<float>("A", {M, K}, a_values);
+  // B is to be an initializer for triggering pre-packing
+  test.AddInput<float>("B", {K, N}, b_values, true);
+  test.AddOutput<float>("Y", {M, N}, y_values);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+#ifdef ENABLE_STRIDED_TENSORS
+TEST(MathOpTest, MatMulStridedInputs) {
+  // A transposed matrix.
+  {
+    KernelComputeTester test("MatMul", kCpuExecutionProvider, 13);
+    test.AddInput<float>("A", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f}, {1, 2});
+    test.AddInput<float>("B", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+    test.AddOutput<float>("Y", {2, 2}, {35.f, 44.f, 44.f, 56.f});
+    test.Run();
+  }
+
+  // Batches of transposed matrices.
+  {
+    KernelComputeTester test("MatMul", kCpuExecutionProvider, 13);
+    test.AddInput<float>("A", {2, 1, 3}, {1.f, 1.f, 1.f, 1.f, 0.f, 0.f});
+    test.AddInput<float>("B", {2, 3, 2}, {0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f}, {6, 1, 3});
+    test.AddOutput<float>("Y", {2, 1, 2}, {3.f, 12.f, 6.f, 9.f});
+    test.Run();
+  }
+
+  // A strided matrix without a unit stride is copied.
+  {
+    KernelComputeTester test("MatMul", kCpuExecutionProvider, 13);
+    test.AddInput<float>("A", {2, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f}, {4, 2});
+    test.AddInput<float>("B", {2, 1}, {1.f, 1.f});
+    test.AddOutput<float>("Y", {2, 1}, {4.f, 12.f});
+    test.Run();
+  }
+}
 #endif
 
 }  // namespace test
@@ -679,6 +679,71 @@ TEST(TopKOperator, NthElementHalf_NegtiveVals) {
   RunTest(11, 4, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions, false);
 }
 
+// rows long enough for the threshold filter and radix select, with repeated values so the indices of the ties
+// are checked too.
+template <typename T>
+static void TestThresholdFilter(int64_t rows, int64_t n, int64_t k, int64_t axis, int64_t largest, int64_t sorted) {
+  std::vector<int64_t> input_dimensions = axis == 0 ? std::vector<int64_t>{n, rows} : std::vector<int64_t>{rows, n};
+  std::vector<int64_t> expected_dimensions = axis == 0 ? std::vector<int64_t>{k, rows} : std::vector<int64_t>{rows, k};
+  const int64_t row_stride = axis == 0 ? 1 : n;
+  const int64_t element_stride = axis == 0 ? rows : 1;
+
+  std::vector<float> input_vals_f(static_cast<size_t>(rows * n));
+  for (size_t i = 0; i < input_vals_f.size(); ++i) {
+    input_vals_f[i] = static_cast<float>(static_cast<int64_t>((i * 7919) % 1021) - 510) * 0.25f;
+  }
+
+  std::vector<float> expected_vals_f(static_cast<size_t>(rows * k));
+  std::vector<int64_t> expected_indices(static_cast<size_t>(rows * k));
+  for (int64_t r = 0; r < rows; ++r) {
+    auto value = [&](int64_t l) { return input_vals_f[static_cast<size_t>(r * row_stride + l * element_stride)]; };
+    std::vector<int64_t> order(static_cast<size_t>(n));
+    std::iota(order.begin(), order.end(), int64_t{0});
+    std::stable_sort(order.begin(), order.end(), [&](int64_t lhs, int64_t rhs) {
+      return largest ? value(lhs) > value(rhs) : value(lhs) < value(rhs);
+    });
+    for (int64_t l = 0; l < k; ++l) {
+      const size_t out = static_cast<size_t>(axis == 0 ? l * rows + r : r * k + l);
+      expected_vals_f[out] = value(order[static_cast<size_t>(l)]);
+      expected_indices[out] = order[static_cast<size_t>(l)];
+    }
+  }
+
+  std::vector<T> input_vals(input_vals_f.size());
+  std::vector<T> expected_vals(expected_vals_f.size());
+  if constexpr (std::is_same<T, MLFloat16>::value) {
+    ConvertFloatToMLFloat16(input_vals_f.data(), input_vals.data(), input_vals_f.size());
+    ConvertFloatToMLFloat16(expected_vals_f.data(), expected_vals.data(), expected_vals_f.size());
+  } else {
+    input_vals = input_vals_f;
+    expected_vals = expected_vals_f;
+  }
+
+  RunTest(11, k, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions, false,
+          axis, largest, sorted);
+}
+
+TEST(TopKOperator, ThresholdFilterLargeRow) {
+  for (int64_t largest : {1, 0}) {
+    for (int64_t sorted : {1, 0}) {
+      TestThresholdFilter<float>(3, 5000, 2, 1, largest, sorted);
+      TestThresholdFilter<float>(3, 5000, 50, 1, largest, sorted);
+      TestThresholdFilter<float>(2, 6000, 1500, 1, largest, sorted);
+    }
+  }
+}
+
+TEST(TopKOperator, ThresholdFilterHalf) {
+  for (int64_t largest : {1, 0}) {
+    for (int64_t sorted : {1, 0}) {
+      TestThresholdFilter<MLFloat16>(3, 5000, 50, 1, largest, sorted);
+      TestThresholdFilter<MLFloat16>(2, 300, 1, 1, largest, sorted);
+      // the axis isn't the innermost dimension
+      TestThresholdFilter<MLFloat16>(3, 700, 20, 0, largest, sorted);
+    }
+  }
+}
+
 // test dimension in range (GridDim::maxThreadsPerBlock, GridDim::maxThreadsPerBlock * 2], ie. [257, 512]
 TEST(TopKOperator, SmallArrayTopKSorted) {
   std::vector<float> input_vals(400, 0.0f);
@@ -760,5 +760,99 @@ TEST(MLOpTest, TreeRegressorTrueNodeBeforeNode) {
   test.Run();
 }
 
+TEST(MLOpTest, TreeRegressorGreaterThanMissingTracks) {
+  // Every tree is small enough to be evaluated with QuickScorer.
+  OpTester test("TreeEnsembleRegressor", 3, onnxruntime::kMLDomain);
+
+  std::vector<int64_t> nodes_treeids = {0, 0, 0, 0, 0, 0, 0, 1, 1, 1};
+  std::vector<int64_t> nodes_nodeids = {0, 1, 2, 3, 4, 5, 6, 0, 1, 2};
+  std::vector<int64_t> nodes_featureids = {0, 1, 1, 0, 0, 0, 0, 1, 0, 0};
+  std::vector<float> nodes_values = {1.0f, 0.5f, 2.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f};
+  std::vector<std::string> nodes_modes = {"BRANCH_GT", "BRANCH_GT", "BRANCH_GT", "LEAF", "LEAF",
+                                          "LEAF", "LEAF", "BRANCH_GT", "LEAF", "LEAF"};
+  std::vector<int64_t> nodes_truenodeids = {1, 3, 5, 0, 0, 0, 0, 1, 0, 0};
+  std::vector<int64_t> nodes_falsenodeids = {2, 4, 6, 0, 0, 0, 0, 2, 0, 0};
+  std::vector<int64_t> nodes_missing_value_tracks_true = {1, 1, 0, 0, 0, 0, 0, 0, 0, 0};
+
+  std::vector<int64_t> target_treeids = {0, 0, 0, 0, 1, 1};
+  std::vector<int64_t> target_nodeids = {3, 4, 5, 6, 1, 2};
+  std::vector<int64_t> target_ids = {0, 0, 0, 0, 0, 0};
+  std::vector<float> target_weights = {1.0f, 2.0f, 3.0f, 4.0f, 10.0f, 20.0f};
+
+  test.AddAttribute("nodes_truenodeids", nodes_truenodeids);
+  test.AddAttribute("nodes_falsenodeids", nodes_falsenodeids);
+  test.AddAttribute("nodes_treeids", nodes_treeids);
+  test.AddAttribute("nodes_nodeids", nodes_nodeids);
+  test.AddAttribute("nodes_featureids", nodes_featureids);
+  test.AddAttribute("nodes_values", nodes_values);
+  test.AddAttribute("nodes_modes", nodes_modes);
+  test.AddAttribute("nodes_missing_value_tracks_true", nodes_missing_value_tracks_true);
+  test.AddAttribute("target_treeids", target_treeids);
+  test.AddAttribute("target_nodeids", target_nodeids);
+  test.AddAttribute("target_ids", target_ids);
+  test.AddAttribute("target_weights", target_weights);
+  test.AddAttribute("n_targets", (int64_t)1);
+
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  std::vector<float> X = {2.0f, 1.0f, 0.0f, 3.0f, nan, 0.0f, 0.0f, nan, nan, nan, 1.0f, 0.5f};
+  std::vector<float> Y = {21.0f, 13.0f, 22.0f, 24.0f, 21.0f, 24.0f};
+  test.AddInput<float>("X", {6, 2}, X);
+  test.AddOutput<float>("Y", {6, 1}, Y);
+  test.Run();
+}
+
+TEST(MLOpTest, TreeRegressorDeepTree) {
+  // A tree with more than 64 leaves is evaluated node by node, several rows at a time.
+  OpTester test("TreeEnsembleRegressor", 3, onnxruntime::kMLDomain);
+
+  // Node 2i tests x <= i, its true branch is leaf 2i+1 with weight i.
+  constexpr int64_t n_tests = 69;
+  std::vector<int64_t> nodes_treeids, nodes_nodeids, nodes_featureids, nodes_truenodeids, nodes_falsenodeids;
+  std::vector<float> nodes_values;
+  std::vector<std::string> nodes_modes;
+  std::vector<int64_t> target_treeids, target_nodeids, target_ids;
+  std::vector<float> target_weights;
+  for (int64_t i = 0; i <= n_tests; ++i) {
+    if (i < n_tests) {
+      nodes_nodeids.push_back(2 * i);
+      nodes_modes.push_back("BRANCH_LEQ");
+      nodes_values.push_back(static_cast<float>(i));
+      nodes_truenodeids.push_back(2 * i + 1);
+      nodes_falsenodeids.push_back(2 * i + 2);
+    }
+    int64_t leaf = i < n_tests ? 2 * i + 1 : 2 * i;
+    nodes_nodeids.push_back(leaf);
+    nodes_modes.push_back("LEAF");
+    nodes_values.push_back(0.0f);
+    nodes_truenodeids.push_back(0);
+    nodes_falsenodeids.push_back(0);
+    target_nodeids.push_back(leaf);
+    target_weights.push_back(static_cast<float>(i));
+  }
+  nodes_treeids.resize(nodes_nodeids.size(), 0);
+  nodes_featureids.resize(nodes_nodeids.size(), 0);
+  target_treeids.resize(target_nodeids.size(), 0);
+  target_ids.resize(target_nodeids.size(), 0);
+
+  test.AddAttribute("nodes_truenodeids", nodes_truenodeids);
+  test.AddAttribute("nodes_falsenodeids", nodes_falsenodeids);
+  test.AddAttribute("nodes_treeids", nodes_treeids);
+  test.AddAttribute("nodes_nodeids", nodes_nodeids);
+  test.AddAttribute("nodes_featureids", nodes_featureids);
+  test.AddAttribute("nodes_values", nodes_values);
+  test.AddAttribute("nodes_modes", nodes_modes);
+  test.AddAttribute("target_treeids", target_treeids);
+  test.AddAttribute("target_nodeids", target_nodeids);
+  test.AddAttribute("target_ids", target_ids);
+  test.AddAttribute("target_weights", target_weights);
+  test.AddAttribute("n_targets", (int64_t)1);
+
+  std::vector<float> X = {-1.0f, 0.5f, 3.0f, 68.0f, 100.0f, 68.5f, 7.0f, 12.0f, 40.0f};
+  std::vector<float> Y = {0.0f, 1.0f, 3.0f, 68.0f, 69.0f, 69.0f, 7.0f, 12.0f, 40.0f};
+  test.AddInput<float>("X", {9, 1}, X);
+  test.AddOutput<float>("Y", {9, 1}, Y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -3,7 +3,7 @@
 
 #include "core/mlas/inc/mlas.h"
 
-#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+#ifdef MLAS_F16GEMM_INTRINSICS_SUPPORTED
 
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
@@ -871,7 +871,8 @@ TEST(ConvFp16Test, Pointwise_3D) {
   TestConvFp16Op(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape, true);
 }
 
-#ifndef DISABLE_CONTRIB_OPS
+// The fp16 NhwcFusedConv kernel is only registered with the ARM64 fp16 kernels
+#if !defined(DISABLE_CONTRIB_OPS) && defined(MLAS_F16VEC_INTRINSICS_SUPPORTED)
 
 TEST(ConvFp16Test, Pointwise_Relu) {
   ConvOpAndTestAttributes attrs = {
@@ -1074,4 +1075,4 @@ TEST(ConvFp16Test, SharedPrepackedWeights) {
 }  // namespace test
 }  // namespace onnxruntime
 
-#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
\ No newline at end of file
+#endif  // MLAS_F16GEMM_INTRINSICS_SUPPORTED
\ No newline at end of file
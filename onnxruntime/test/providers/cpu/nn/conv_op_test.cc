@@ -728,5 +728,63 @@ TEST(ConvTest, Conv_AutoPad_with_non_default_strides) {
   TestConvOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape, true);
 }
 
+// a 3x3 convolution large enough for the CPU EP to use the Winograd algorithm with the weight pre-packed
+TEST(ConvTest, Conv2D_3x3_ManyChannels) {
+  constexpr int64_t N = 2, C = 8, H = 10, W = 13, M = 16;
+
+  vector<float> X(N * C * H * W);
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = static_cast<float>(static_cast<int>(i * 7 % 13) - 6) / 6.0f;
+  }
+  vector<float> Wt(M * C * 3 * 3);
+  for (size_t i = 0; i < Wt.size(); ++i) {
+    Wt[i] = static_cast<float>(static_cast<int>(i * 5 % 11) - 5) / 10.0f;
+  }
+  vector<float> B(M);
+  for (size_t i = 0; i < B.size(); ++i) {
+    B[i] = static_cast<float>(i) / 8.0f - 1.0f;
+  }
+
+  // pads of 1 keep the image size
+  vector<float> Y(N * M * H * W);
+  for (int64_t n = 0; n < N; ++n) {
+    for (int64_t m = 0; m < M; ++m) {
+      for (int64_t oh = 0; oh < H; ++oh) {
+        for (int64_t ow = 0; ow < W; ++ow) {
+          double sum = B[m];
+          for (int64_t c = 0; c < C; ++c) {
+            for (int64_t kh = 0; kh < 3; ++kh) {
+              for (int64_t kw = 0; kw < 3; ++kw) {
+                const int64_t ih = oh + kh - 1;
+                const int64_t iw = ow + kw - 1;
+                if (ih >= 0 && ih < H && iw >= 0 && iw < W) {
+                  sum += static_cast<double>(X[((n * C + c) * H + ih) * W + iw]) *
+                         Wt[((m * C + c) * 3 + kh) * 3 + kw];
+                }
+              }
+            }
+          }
+          Y[((n * M + m) * H + oh) * W + ow] = static_cast<float>(sum);
+        }
+      }
+    }
+  }
+
+  for (bool weight_is_initializer : {false, true}) {
+    OpTester test("Conv", 11);
+    test.AddAttribute("group", int64_t{1});
+    test.AddAttribute("kernel_shape", vector<int64_t>{3, 3});
+    test.AddAttribute("pads", vector<int64_t>{1, 1, 1, 1});
+
+    test.AddInput<float>("X", {N, C, H, W}, X);
+    test.AddInput<float>("W", {M, C, 3, 3}, Wt, weight_is_initializer);
+    test.AddInput<float>("B", {M}, B);
+    test.AddOutput<float>("Y", {N, M, H, W}, Y);
+    test.SetOutputAbsErr("Y", 1e-4f);
+
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kQnnExecutionProvider});
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
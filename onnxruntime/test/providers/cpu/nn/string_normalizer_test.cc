@@ -167,6 +167,25 @@ TEST(ContribOpTest, StringNormalizerTest) {
     test.AddOutput<std::string>("Y", {6}, output);
     test.Run(OpTester::ExpectResult::kExpectSuccess);
   }
+  // - case-INSENSETIVE approach en_US locale
+  // - non ascii stopword compared with its upper case form
+  // - LOWER changes the ascii strings and the non ascii ones alike
+  {
+    OpTester test("StringNormalizer", opset_ver, domain);
+    InitTestAttr(test, "LOWER", false, {u8"Понедельник"}, test_locale);
+    std::vector<int64_t> dims{4};
+    std::vector<std::string> input = {std::string(u8"ПОНЕДЕЛЬНИК"),
+                                      std::string(u8"Monday"),
+                                      std::string(u8"École"),
+                                      std::string(u8"TUESDAY")};
+    test.AddInput<std::string>("T", dims, input);
+
+    std::vector<std::string> output = {std::string(u8"monday"),
+                                       std::string(u8"école"),
+                                       std::string(u8"tuesday")};
+    test.AddOutput<std::string>("Y", {3}, output);
+    test.Run(OpTester::ExpectResult::kExpectSuccess);
+  }
 
   // Empty output case
   // - casesensitive approach
@@ -1,6 +1,11 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -138,6 +143,49 @@ TEST(NonMaxSuppressionOpTest, TwoBatches_TwoClasses) {
   test.Run();
 }
 
+TEST(NonMaxSuppressionOpTest, ManyBatchesAndClasses) {
+  // Boxes 2k and 2k + 1 overlap each other and no other box, so the one with the higher score of each pair is
+  // selected. There are more selected boxes per class than the block size of the IOU test.
+  constexpr int64_t num_batches = 3;
+  constexpr int64_t num_classes = 4;
+  constexpr int64_t num_boxes = 40;
+
+  std::vector<float> boxes;
+  for (int64_t b = 0; b < num_batches; ++b) {
+    for (int64_t i = 0; i < num_boxes; ++i) {
+      const float x = static_cast<float>(i / 2) * 10.0f + static_cast<float>(i % 2) * 0.1f;
+      boxes.insert(boxes.end(), {0.0f, x, 1.0f, x + 1.0f});
+    }
+  }
+
+  std::vector<float> scores;
+  std::vector<int64_t> expected;
+  for (int64_t b = 0; b < num_batches; ++b) {
+    for (int64_t c = 0; c < num_classes; ++c) {
+      std::vector<std::pair<float, int64_t>> selected;
+      for (int64_t i = 0; i < num_boxes; ++i) {
+        scores.push_back(static_cast<float>((i * 13 + c * 7 + b * 3) % num_boxes + 1) / (num_boxes + 1));
+        if (i % 2 == 1) {
+          const int64_t winner = scores[scores.size() - 1] > scores[scores.size() - 2] ? i : i - 1;
+          selected.emplace_back(scores[scores.size() - 1 - (i - winner)], winner);
+        }
+      }
+      std::sort(selected.begin(), selected.end(), std::greater<>());
+      for (const auto& box : selected) {
+        expected.insert(expected.end(), {b, c, box.second});
+      }
+    }
+  }
+
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {num_batches, num_boxes, 4}, boxes);
+  test.AddInput<float>("scores", {num_batches, num_classes, num_boxes}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {num_boxes});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddOutput<int64_t>("selected_indices", {static_cast<int64_t>(expected.size() / 3), 3}, expected);
+  test.Run();
+}
+
 TEST(NonMaxSuppressionOpTest, WithScoreThreshold) {
   OpTester test("NonMaxSuppression", 10, kOnnxDomain);
   test.AddInput<float>("boxes", {1, 6, 4},
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
 #include <vector>
 
@@ -72,6 +74,44 @@ static void TestInverseFloat(int since_version) {
   test.Run();
 }
 
+// Compares the DFT of a real signal of the given length, optionally zero padded or truncated to dft_length, with a
+// direct evaluation of the sum in double precision.
+static void TestDFTFloatReference(int64_t signal_length, int64_t dft_length, bool inverse) {
+  OpTester test("DFT", kMinOpsetVersion);
+
+  RandomValueGenerator random(GetTestRandomSeed());
+  constexpr int64_t num_batches = 2;
+  vector<int64_t> shape = {num_batches, signal_length, 1};
+  vector<float> input = random.Uniform<float>(shape, -1.f, 1.f);
+  const int64_t n = dft_length > 0 ? dft_length : signal_length;
+
+  constexpr double kPi = 3.14159265358979323846;
+  const double sign = inverse ? 1.0 : -1.0;
+  const double scale = inverse ? 1.0 / static_cast<double>(n) : 1.0;
+  vector<float> expected_output(static_cast<size_t>(num_batches * n * 2));
+  for (int64_t b = 0; b < num_batches; ++b) {
+    for (int64_t k = 0; k < n; ++k) {
+      double real = 0, imag = 0;
+      for (int64_t t = 0; t < std::min(n, signal_length); ++t) {
+        const double angle = sign * 2.0 * kPi * static_cast<double>((k * t) % n) / static_cast<double>(n);
+        real += input[b * signal_length + t] * std::cos(angle);
+        imag += input[b * signal_length + t] * std::sin(angle);
+      }
+      expected_output[(b * n + k) * 2] = static_cast<float>(real * scale);
+      expected_output[(b * n + k) * 2 + 1] = static_cast<float>(imag * scale);
+    }
+  }
+
+  test.AddInput<float>("input", shape, input);
+  if (dft_length > 0) {
+    test.AddInput<int64_t>("dft_length", {}, {dft_length});
+  }
+  test.AddAttribute<int64_t>("inverse", static_cast<int64_t>(inverse));
+  test.AddOutput<float>("output", {num_batches, n, 2}, expected_output);
+  test.SetOutputAbsErr("output", 0.002f);
+  test.Run();
+}
+
 TEST(SignalOpsTest, DFT17_Float_naive) {
   TestNaiveDFTFloat(false, kMinOpsetVersion);
 }
@@ -105,6 +145,26 @@ TEST(SignalOpsTest, DFT20_Float_inverse) {
 }
 
 // Tests that FFT(FFT(x), inverse=true) == x
+TEST(SignalOpsTest, DFT17_Float_mixed_radix) {
+  for (int64_t length : {6, 12, 15, 45, 49, 121, 400}) {
+    TestDFTFloatReference(length, 0, false);
+    TestDFTFloatReference(length, 0, true);
+  }
+}
+
+TEST(SignalOpsTest, DFT17_Float_bluestein) {
+  for (int64_t length : {37, 74, 101, 127}) {
+    TestDFTFloatReference(length, 0, false);
+    TestDFTFloatReference(length, 0, true);
+  }
+}
+
+TEST(SignalOpsTest, DFT17_Float_dft_length) {
+  TestDFTFloatReference(10, 16, false);
+  TestDFTFloatReference(20, 12, false);
+  TestDFTFloatReference(5, 37, true);
+}
+
 static void TestDFTInvertible(bool complex, int since_version) {
   // TODO: test dft_length
   class DFTInvertibleTester : public OpTester {
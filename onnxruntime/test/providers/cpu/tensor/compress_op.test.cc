@@ -115,6 +115,28 @@ TEST(CompressTest, Compress_default_axis_issue_9247_cumulative_sum_overflow) {
   test.Run();
 }
 
+// the condition spans several blocks and the true conditions form runs of different lengths
+TEST(CompressTest, Compress_default_axis_many_blocks) {
+  OpTester test("Compress", 11);
+
+  constexpr int64_t elements = 40000;
+  std::vector<int64_t> input;
+  std::unique_ptr<bool[]> condition = std::make_unique<bool[]>(elements);
+  std::vector<int64_t> output;
+  for (int64_t i = 0; i < elements; ++i) {
+    input.push_back(i * 3);
+    condition[i] = (i / 5) % 3 != 0 || i % 7 == 0;
+    if (condition[i]) {
+      output.push_back(i * 3);
+    }
+  }
+
+  test.AddInput<int64_t>("input", {elements}, input);
+  test.AddInput<bool>("condition", {elements}, condition.get(), elements);
+  test.AddOutput<int64_t>("output", {static_cast<int64_t>(output.size())}, output);
+  test.Run();
+}
+
 TEST(CompressTest, Compress0_string) {
   OpTester test("Compress", 9);
 
@@ -430,6 +430,57 @@ TEST(GatherOpTest, Gather_axis1_scalar_indices) {
   run_test(false);
   run_test(true);
 }
+// More indices than the prefetch distance of the CPU kernel, with rows of the fixed copy sizes and a row that is
+// copied with memcpy, gathered along the outer axis and along an inner axis.
+template <typename T>
+static void RunGatherManyIndicesTest(int64_t row_elements, int64_t axis) {
+  constexpr int64_t outer = 3;
+  constexpr int64_t rows = 37;
+  const std::vector<int64_t> indices{5, 36, -1, 0, 12, 12, 7, -37, 20, 3, 35, 1, 9, 30, 2, 11, 18, 24, 6, 29, 14};
+  const auto num_indices = static_cast<int64_t>(indices.size());
+
+  const int64_t batches = axis == 0 ? 1 : outer;
+  std::vector<int64_t> data_dims{rows, row_elements};
+  std::vector<int64_t> output_dims{num_indices, row_elements};
+  if (axis != 0) {
+    data_dims.insert(data_dims.begin(), outer);
+    output_dims.insert(output_dims.begin(), outer);
+  }
+
+  std::vector<T> data(static_cast<size_t>(batches * rows * row_elements));
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<T>(i % 127);
+  }
+
+  std::vector<T> output;
+  for (int64_t b = 0; b < batches; ++b) {
+    for (int64_t index : indices) {
+      const int64_t row = index < 0 ? index + rows : index;
+      const auto begin = data.begin() + static_cast<ptrdiff_t>((b * rows + row) * row_elements);
+      output.insert(output.end(), begin, begin + static_cast<ptrdiff_t>(row_elements));
+    }
+  }
+
+  OpTester test("Gather", 13);
+  test.AddAttribute<int64_t>("axis", axis);
+  test.AddInput<T>("data", data_dims, data);
+  test.AddInput<int64_t>("indices", {num_indices}, indices);
+  test.AddOutput<T>("output", output_dims, output);
+  test.ConfigEp(DefaultCpuExecutionProvider()).RunWithConfig();
+}
+
+TEST(GatherOpTest, Gather_many_indices) {
+  for (int64_t axis : {0, 1}) {
+    RunGatherManyIndicesTest<uint8_t>(1, axis);
+    RunGatherManyIndicesTest<int16_t>(1, axis);
+    RunGatherManyIndicesTest<float>(1, axis);
+    RunGatherManyIndicesTest<float>(2, axis);
+    RunGatherManyIndicesTest<float>(4, axis);
+    RunGatherManyIndicesTest<float>(3, axis);
+    RunGatherManyIndicesTest<float>(67, axis);
+  }
+}
+
 #ifdef ENABLE_TRAINING_OPS
 // Should remove the shrunken_gather include from ENABLE_TRAINING_OPS once 1). compute optimizer is enabled for inference or
 // 2). this is needed by inference for other purpose.
@@ -1015,5 +1015,38 @@ TEST(GridsampleTest, test_grid_sample_20_4D_bicubic_reflection_no_align_corners)
   test.ConfigEp(DefaultCpuExecutionProvider())
       .RunWithConfig();
 }
+
+// Samples the pixel centers of every channel at more output locations than one block of sampling points.
+TEST(GridsampleTest, test_grid_sample_20_4D_linear_many_locations) {
+  constexpr int64_t C = 6, H_in = 4, W_in = 5, W_out = 200, H_out = 3;
+  std::vector<float> X_data(C * H_in * W_in);
+  for (size_t i = 0; i < X_data.size(); i++) {
+    X_data[i] = static_cast<float>(i) * 0.0625f;
+  }
+
+  std::vector<float> Grid_data;
+  std::vector<float> Y_data(C * H_out * W_out);
+  for (int64_t l = 0; l < H_out * W_out; l++) {
+    const int64_t pixel = (l * 7) % (H_in * W_in);
+    const int64_t row = pixel / W_in;
+    const int64_t col = pixel % W_in;
+    Grid_data.push_back(2.f * static_cast<float>(col) / static_cast<float>(W_in - 1) - 1.f);
+    Grid_data.push_back(2.f * static_cast<float>(row) / static_cast<float>(H_in - 1) - 1.f);
+    for (int64_t c = 0; c < C; c++) {
+      Y_data[c * H_out * W_out + l] = X_data[c * H_in * W_in + pixel];
+    }
+  }
+
+  OpTester test("GridSample", 20);
+  test.AddInput<float>("X", {1, C, H_in, W_in}, X_data);
+  test.AddInput<float>("Grid", {1, H_out, W_out, 2}, Grid_data);
+  test.AddAttribute("mode", std::string("linear"));
+  test.AddAttribute("padding_mode", std::string("zeros"));
+  test.AddAttribute("align_corners", static_cast<int64_t>(1));
+  test.AddOutput<float>("Y", {1, C, H_out, W_out}, Y_data);
+  test.SetOutputAbsErr("Y", 1e-5f);
+  test.ConfigEp(DefaultCpuExecutionProvider())
+      .RunWithConfig();
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -99,5 +99,27 @@ TEST(NonZeroOpTest, EmptyInput) {
   test.Run();
 }
 
+// the input spans several blocks of elements, each block writes its coordinates at its own offset
+TEST(NonZeroOpTest, ManyBlocks) {
+  OpTester test{kOpName, kOpVersion};
+  constexpr int64_t rows = 50, cols = 1000;
+  std::vector<int32_t> X(rows * cols, 0);
+  std::vector<int64_t> Y_rows, Y_cols;
+  for (int64_t r = 0; r < rows; ++r) {
+    for (int64_t c = 0; c < cols; ++c) {
+      if ((r * 7 + c * 13) % 11 == 0) {
+        X[r * cols + c] = static_cast<int32_t>(r + c + 1);
+        Y_rows.push_back(r);
+        Y_cols.push_back(c);
+      }
+    }
+  }
+  std::vector<int64_t> Y(Y_rows);
+  Y.insert(Y.end(), Y_cols.begin(), Y_cols.end());
+  test.AddInput<int32_t>("X", {rows, cols}, X);
+  test.AddOutput<int64_t>("Y", {2, static_cast<int64_t>(Y_rows.size())}, Y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
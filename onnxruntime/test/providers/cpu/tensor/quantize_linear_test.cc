@@ -233,6 +233,36 @@ TEST(DequantizeLinearOpTest, Per_Channel_Neg_2) {
   test.Run();
 }
 
+// more channels than threads, each channel is dequantized by one thread
+TEST(DequantizeLinearOpTest, Per_Channel_Many_Channels) {
+  OpTester test("DequantizeLinear", 13);
+  constexpr int64_t channels = 64;
+  std::vector<int64_t> dims{2, channels, 3};
+  std::vector<int8_t> x;
+  std::vector<float> scale;
+  std::vector<int8_t> zero_point;
+  std::vector<float> y;
+  for (int64_t c = 0; c < channels; c++) {
+    scale.push_back(0.5f * static_cast<float>(c + 1));
+    zero_point.push_back(static_cast<int8_t>(c % 7 - 3));
+  }
+  for (int64_t n = 0; n < 2; n++) {
+    for (int64_t c = 0; c < channels; c++) {
+      for (int64_t i = 0; i < 3; i++) {
+        const int8_t value = static_cast<int8_t>((n * 31 + c * 5 + i * 17) % 256 - 128);
+        x.push_back(value);
+        y.push_back(static_cast<float>(value - zero_point[c]) * scale[c]);
+      }
+    }
+  }
+  test.AddInput<int8_t>("X", dims, x);
+  test.AddAttribute<int64_t>("axis", 1);
+  test.AddInput<float>("scale", {channels}, scale);
+  test.AddInput<int8_t>("zero_point", {channels}, zero_point);
+  test.AddOutput<float>("Y", dims, y);
+  test.Run();
+}
+
 // quantize with scalar zero point and scale
 TEST(QuantizeLinearOpTest, Uint8) {
   OpTester test("QuantizeLinear", 10);
@@ -322,6 +352,36 @@ TEST(QuantizeLinearOpTest, 2D) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});  // TensorRT doesn't support support UINT8 for quantization
 }
 
+// more channels than threads, each channel is quantized by one thread
+TEST(QuantizeLinearOpTest, Per_Channel_Many_Channels) {
+  OpTester test("QuantizeLinear", 13);
+  constexpr int64_t channels = 64;
+  std::vector<int64_t> dims{2, channels, 3};
+  std::vector<float> x;
+  std::vector<float> scale;
+  std::vector<uint8_t> zero_point;
+  std::vector<uint8_t> y;
+  for (int64_t c = 0; c < channels; c++) {
+    scale.push_back(0.25f * static_cast<float>(c % 5 + 1));
+    zero_point.push_back(static_cast<uint8_t>(c * 3));
+  }
+  for (int64_t n = 0; n < 2; n++) {
+    for (int64_t c = 0; c < channels; c++) {
+      for (int64_t i = 0; i < 3; i++) {
+        const int32_t value = static_cast<int32_t>((n * 37 + c * 11 + i * 29) % 300) - 40;
+        x.push_back(static_cast<float>(value - zero_point[c]) * scale[c]);
+        y.push_back(static_cast<uint8_t>(std::min(255, std::max(0, value))));
+      }
+    }
+  }
+  test.AddInput<float>("X", dims, x);
+  test.AddAttribute<int64_t>("axis", 1);
+  test.AddInput<float>("scale", {channels}, scale);
+  test.AddInput<uint8_t>("zero_point", {channels}, zero_point);
+  test.AddOutput<uint8_t>("Y", dims, y);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});  // TensorRT doesn't support support UINT8 for quantization
+}
+
 // quantize with scalar data
 TEST(QuantizeLinearOpTest, Scalar) {
   OpTester test("QuantizeLinear", 10);
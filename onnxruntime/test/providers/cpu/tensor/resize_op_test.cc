@@ -1248,6 +1248,81 @@ TEST(ResizeOpTest, ResizeOpCubicDownSampleTest) {
   test.Run();
 }
 
+TEST(ResizeOpTest, NhwcResizeOpCubicDownSampleTest) {
+  OpTester test("Resize", 13);
+  std::vector<float> scales{1.0f, 0.8f, 0.8f, 1.0f};
+  std::vector<float> roi{};
+
+  test.AddAttribute("mode", "cubic");
+
+  // the second channel is twice the first one
+  constexpr int64_t N = 1, H = 4, W = 4, C = 2;
+  std::vector<float> X = {
+      1.0f, 2.0f, 2.0f, 4.0f, 3.0f, 6.0f, 4.0f, 8.0f,
+      5.0f, 10.0f, 6.0f, 12.0f, 7.0f, 14.0f, 8.0f, 16.0f,
+      9.0f, 18.0f, 10.0f, 20.0f, 11.0f, 22.0f, 12.0f, 24.0f,
+      13.0f, 26.0f, 14.0f, 28.0f, 15.0f, 30.0f, 16.0f, 32.0f};
+
+  test.AddInput<float>("X", {N, H, W, C}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+
+  std::vector<float> Y = {1.47119f, 2.94238f, 2.78125f, 5.5625f, 4.08252f, 8.16504f,
+                          6.71143f, 13.42286f, 8.02148f, 16.04296f, 9.32275f, 18.6455f,
+                          11.9165f, 23.833f, 13.2266f, 26.4532f, 14.5278f, 29.0556f};
+
+  test.AddOutput<float>("Y", {N, static_cast<int64_t>(H * scales[1]), static_cast<int64_t>(W * scales[2]), C}, Y);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider, kTensorrtExecutionProvider, kRocmExecutionProvider});
+}
+
+TEST(ResizeOpTest, ResizeOpCubicDownSampleTest_uint8) {
+  OpTester test("Resize", 13);
+  std::vector<float> scales{1.0f, 1.0f, 0.8f, 0.8f};
+  std::vector<float> roi{};
+
+  test.AddAttribute("mode", "cubic");
+
+  constexpr int64_t N = 1, C = 1, H = 4, W = 4;
+  std::vector<uint8_t> X = {
+      10, 20, 30, 40,
+      50, 60, 70, 80,
+      90, 100, 110, 120,
+      130, 140, 150, 160};
+
+  test.AddInput<uint8_t>("X", {N, C, H, W}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+
+  // ten times the float results of ResizeOpCubicDownSampleTest, rounded
+  std::vector<uint8_t> Y = {15, 28, 41,
+                            67, 80, 93,
+                            119, 132, 145};
+
+  test.AddOutput<uint8_t>("Y", {N, C, static_cast<int64_t>(H * scales[2]), static_cast<int64_t>(W * scales[3])}, Y);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider, kTensorrtExecutionProvider, kRocmExecutionProvider});
+}
+
+TEST(ResizeOpTest, NhwcResizeOpCubicUpSampleTest_uint8_Saturate) {
+  OpTester test("Resize", 13);
+  std::vector<float> scales{1.0f, 2.0f, 1.0f, 1.0f};
+  std::vector<float> roi{};
+
+  test.AddAttribute("mode", "cubic");
+
+  // the overshoot of the cubic filter at the edges is clamped to the range of uint8
+  constexpr int64_t N = 1, H = 4, W = 1, C = 1;
+  std::vector<uint8_t> X = {0, 0, 255, 255};
+
+  test.AddInput<uint8_t>("X", {N, H, W, C}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+
+  std::vector<uint8_t> Y = {0, 0, 0, 58, 197, 255, 255, 255};
+
+  test.AddOutput<uint8_t>("Y", {N, H * 2, W, C}, Y);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider, kTensorrtExecutionProvider, kRocmExecutionProvider});
+}
+
 TEST(ResizeOpTest, ResizeOpCubicDownSampleTest_exclude_outside) {
   OpTester test("Resize", 13);
   std::vector<float> roi{};
@@ -180,5 +180,25 @@ TEST(ScatterNDOpTest, ScatterND_batched_3tensor_int64) {
   test3.Run();
 }
 
+TEST(ScatterNDOpTest, ScatterND_18_add_duplicated_indices) {
+  OpTester test("ScatterND", 18);
+  test.AddAttribute<std::string>("reduction", "add");
+  test.AddInput<float>("data", {4, 2}, {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f});
+  test.AddInput<int64_t>("indices", {6, 1}, {1LL, 3LL, 1LL, 0LL, -1LL, 1LL});
+  test.AddInput<float>("updates", {6, 2}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 12.0f});
+  test.AddOutput<float>("output", {4, 2}, {8.0f, 9.0f, 18.0f, 21.0f, 1.0f, 1.0f, 13.0f, 15.0f});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
+TEST(ScatterNDOpTest, ScatterND_18_max_duplicated_indices) {
+  OpTester test("ScatterND", 18);
+  test.AddAttribute<std::string>("reduction", "max");
+  test.AddInput<int64_t>("data", {3}, {4LL, 0LL, 9LL});
+  test.AddInput<int64_t>("indices", {5, 1}, {2LL, 0LL, 2LL, 0LL, 1LL});
+  test.AddInput<int64_t>("updates", {5}, {10LL, 3LL, 7LL, 6LL, -2LL});
+  test.AddOutput<int64_t>("output", {3}, {6LL, 0LL, 10LL});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
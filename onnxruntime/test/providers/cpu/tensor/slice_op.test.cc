@@ -5,6 +5,9 @@
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/util/include/default_providers.h"
+#ifdef ENABLE_STRIDED_TENSORS
+#include "test/providers/kernel_compute_test_utils.h"
+#endif
 
 namespace onnxruntime {
 namespace test {
@@ -761,5 +764,33 @@ TEST(SliceTest, CoalesceDims) {
   RunSliceTest<float>({1, 1, 1}, {1.f}, {0}, {std::numeric_limits<int64_t>::max()}, {1}, {}, {1, 1, 1}, {1.f}, true);
 }
 
+#ifdef ENABLE_STRIDED_TENSORS
+TEST(SliceTest, Strided) {
+  // The output is a view of the input that starts at the first element of the slice.
+  {
+    KernelComputeTester test("Slice", kCpuExecutionProvider, 13);
+    test.AddInput<float>("data", {3, 4}, {0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f});
+    test.AddInput<int64_t>("starts", {2}, {1, 1});
+    test.AddInput<int64_t>("ends", {2}, {3, 4});
+    test.AddInput<int64_t>("axes", {2}, {0, 1});
+    test.AddInput<int64_t>("steps", {2}, {1, 2});
+    test.AddOutput<float>("output", {2, 2}, {5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f}, {4, 2});
+    test.Run({0});
+  }
+
+  // A strided input is copied to a contiguous output.
+  {
+    KernelComputeTester test("Slice", kCpuExecutionProvider, 13);
+    test.AddInput<float>("data", {4, 3}, {0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f}, {1, 4});
+    test.AddInput<int64_t>("starts", {1}, {1});
+    test.AddInput<int64_t>("ends", {1}, {3});
+    test.AddInput<int64_t>("axes", {1}, {0});
+    test.AddInput<int64_t>("steps", {1}, {1});
+    test.AddOutput<float>("output", {2, 3}, {1.f, 5.f, 9.f, 2.f, 6.f, 10.f});
+    test.Run();
+  }
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -4,6 +4,9 @@
 #include "gtest/gtest.h"
 #include "core/framework/to_tensor_proto_element_type.h"
 #include "test/providers/provider_test_utils.h"
+#ifdef ENABLE_STRIDED_TENSORS
+#include "test/providers/kernel_compute_test_utils.h"
+#endif
 
 namespace onnxruntime {
 namespace test {
@@ -815,5 +818,17 @@ TEST(SplitOperatorTest, Split18_NumOutputsUnevenSplitAxis1) {
   RunTest<float>(axis, {}, input, outputs, {kTensorrtExecutionProvider, kQnnExecutionProvider}, false, true, num_outputs, false);
 }
 
+#ifdef ENABLE_STRIDED_TENSORS
+TEST(SplitOperatorTest, Strided) {
+  // Every output is a view of the input.
+  KernelComputeTester test("Split", kCpuExecutionProvider, 13);
+  test.AddAttribute("axis", int64_t{1});
+  test.AddInput<float>("input", {2, 4}, {0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f});
+  test.AddOutput<float>("output_0", {2, 2}, {0.f, 1.f, 2.f, 3.f, 4.f, 5.f}, {4, 1});
+  test.AddOutput<float>("output_1", {2, 2}, {2.f, 3.f, 4.f, 5.f, 6.f, 7.f}, {4, 1});
+  test.Run({0, 1});
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
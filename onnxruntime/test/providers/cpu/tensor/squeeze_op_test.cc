@@ -5,6 +5,9 @@
 #include "test/common/dnnl_op_test_utils.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/util/include/default_providers.h"
+#ifdef ENABLE_STRIDED_TENSORS
+#include "test/providers/kernel_compute_test_utils.h"
+#endif
 
 namespace onnxruntime {
 namespace test {
@@ -381,5 +384,16 @@ TEST(SqueezeOpTest, SqueezeNegAxis_2_opset13_bfloat16) {
 }
 #endif  //  USE_DNNL
 
+#ifdef ENABLE_STRIDED_TENSORS
+TEST(SqueezeOpTest, Strided) {
+  // A strided input gives a strided output.
+  KernelComputeTester test("Squeeze", kCpuExecutionProvider, 13);
+  test.AddInput<float>("data", {1, 3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f}, {6, 1, 3});
+  test.AddInput<int64_t>("axes", {1}, {0});
+  test.AddOutput<float>("squeezed", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f}, {1, 3});
+  test.Run({0});
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -8,6 +8,9 @@
 #include "core/providers/cpu/tensor/transpose.h"
 #include "test/util/include/default_providers.h"
 #include "test/util/include/asserts.h"
+#ifdef ENABLE_STRIDED_TENSORS
+#include "test/providers/kernel_compute_test_utils.h"
+#endif
 
 namespace onnxruntime {
 namespace test {
@@ -821,5 +824,36 @@ TEST(TransposeOpTest, TransposeBigMLFloat16) {  // Exercises CanUse_cublasTransp
 }
 #endif  // defined(USE_CUDA) || defined(USE_ROCM)
 
+#ifdef ENABLE_STRIDED_TENSORS
+TEST(TransposeOpTest, Strided) {
+  // The output is a view of the input with permuted strides.
+  {
+    KernelComputeTester test("Transpose");
+    test.AddAttribute("perm", std::vector<int64_t>{1, 0});
+    test.AddInput<float>("X", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+    test.AddOutput<float>("Y", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f}, {1, 3});
+    test.Run({0});
+  }
+
+  // A view of a strided input.
+  {
+    KernelComputeTester test("Transpose");
+    test.AddAttribute("perm", std::vector<int64_t>{0, 2, 1});
+    test.AddInput<float>("X", {2, 2, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f}, {4, 1, 2});
+    test.AddOutput<float>("Y", {2, 2, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f}, {4, 2, 1});
+    test.Run({0});
+  }
+
+  // A strided input is copied to a contiguous output.
+  {
+    KernelComputeTester test("Transpose");
+    test.AddAttribute("perm", std::vector<int64_t>{1, 0});
+    test.AddInput<float>("X", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f}, {1, 2});
+    test.AddOutput<float>("Y", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+    test.Run();
+  }
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -5,6 +5,7 @@
 #include "gtest/gtest.h"
 #include "cuda_runtime.h"
 #include "core/framework/allocator.h"
+#include "core/framework/stream_handles.h"
 #include "core/providers/cuda/cuda_allocator.h"
 #include "core/providers/cuda/cuda_common.h"
 
@@ -113,5 +114,58 @@ TEST(AllocatorTest, CUDAAllocatorFallbackTest) {
   auto last_error = cudaGetLastError();
   EXPECT_EQ(last_error, cudaSuccess) << "Last error should be cleared if handled gracefully";
 }
+
+TEST(AllocatorTest, CUDAMemPoolAllocatorTest) {
+  OrtDevice::DeviceId cuda_device_id = 0;
+  CUDA_CALL_THROW(cudaSetDevice(cuda_device_id));
+
+  int pools_supported = 0;
+  CUDA_CALL_THROW(cudaDeviceGetAttribute(&pools_supported, cudaDevAttrMemoryPoolsSupported, cuda_device_id));
+  if (pools_supported == 0) {
+    GTEST_SKIP() << "CUDA memory pools are not supported by the device.";
+  }
+
+  constexpr size_t size = 1024;
+  auto cuda_pool = std::make_shared<CUDAMemPoolAllocator>(cuda_device_id, CUDA, 0, 4 * size);
+  EXPECT_STREQ(cuda_pool->Info().name, CUDA);
+  EXPECT_EQ(cuda_pool->Info().alloc_type, OrtDeviceAllocator);
+  EXPECT_TRUE(cuda_pool->IsStreamOrdered());
+
+  cudaStream_t cuda_stream;
+  CUDA_CALL_THROW(cudaStreamCreateWithFlags(&cuda_stream, cudaStreamNonBlocking));
+  Stream stream(cuda_stream, cuda_pool->Info().device);
+
+  // memory allocated without a stream can be used right away
+  void* cuda_addr_a = cuda_pool->Alloc(size);
+  ASSERT_NE(cuda_addr_a, nullptr);
+  CUDA_CALL_THROW(cudaMemset(cuda_addr_a, -1, size));
+
+  // memory allocated on the stream is ordered on it
+  void* cuda_addr_b = AllocateBufferWithOptions(*cuda_pool, size, false, &stream, nullptr);
+  ASSERT_NE(cuda_addr_b, nullptr);
+  CUDA_CALL_THROW(cudaMemcpyAsync(cuda_addr_b, cuda_addr_a, size, cudaMemcpyDeviceToDevice, cuda_stream));
+  int value = 0;
+  CUDA_CALL_THROW(cudaMemcpyAsync(&value, cuda_addr_b, sizeof(value), cudaMemcpyDeviceToHost, cuda_stream));
+  CUDA_CALL_THROW(cudaStreamSynchronize(cuda_stream));
+  EXPECT_EQ(value, -1);
+
+  AllocatorStats stats;
+  cuda_pool->GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 2);
+  EXPECT_EQ(stats.bytes_in_use, static_cast<int64_t>(2 * size));
+
+  // the limit applies to the memory in use
+  EXPECT_THROW(cuda_pool->Alloc(3 * size), OnnxRuntimeException);
+
+  // the stream may be destroyed once the memory allocated on it is detached from it
+  cuda_pool->DetachStream(&stream);
+  CUDA_CALL_THROW(cudaStreamDestroy(cuda_stream));
+
+  cuda_pool->Free(cuda_addr_a);
+  cuda_pool->Free(cuda_addr_b);
+  cuda_pool->GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  CUDA_CALL_THROW(cudaDeviceSynchronize());
+}
 }  // namespace test
 }  // namespace onnxruntime
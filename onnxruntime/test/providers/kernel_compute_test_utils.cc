@@ -98,7 +98,13 @@ void KernelComputeTester::Run(std::unordered_set<int> strided_outputs) {
   // If the tester specifies output i is strided tensor output, we need to check output i for this kernel is
   // MayStridedOutput from the KernelDef, and create an OrtValue as output by sharing the data buffer from
   // its corresponding input. Otherwise, create an OrtValue with contiguous tensor.
-  const auto& may_strided_outputs_map = kernel_create_info->kernel_def->MayStridedOutput();
+  auto may_strided_outputs_map = kernel_create_info->kernel_def->MayStridedOutput();
+  if (const auto& variadic_input = kernel_create_info->kernel_def->VariadicMayStridedOutput();
+      variadic_input.has_value()) {
+    for (size_t i = 0; i < output_data_.size(); ++i) {
+      may_strided_outputs_map.emplace_back(*variadic_input, static_cast<int>(i));
+    }
+  }
   std::vector<OrtValue> outputs;
   for (size_t i = 0; i < output_data_.size(); ++i) {
     OrtValue output;
@@ -154,14 +160,32 @@ void KernelComputeTester::Run(std::unordered_set<int> strided_outputs) {
       bool is_may_strided_output = false;
       for (auto& pair : may_strided_outputs_map) {
         if (pair.second == static_cast<int>(i)) {
-          EXPECT_EQ(outputs[i].Get<Tensor>().DataRaw(),
-                    initializer_map[input_data_[static_cast<size_t>(pair.first)].def_.Name()].Get<Tensor>().DataRaw());
+          // the output may start at an offset into the input, e.g. for Slice.
+          const Tensor& input = initializer_map[input_data_[static_cast<size_t>(pair.first)].def_.Name()].Get<Tensor>();
+          const auto* input_data = static_cast<const char*>(input.DataRaw());
+          const auto* output_data = static_cast<const char*>(outputs[i].Get<Tensor>().DataRaw());
+          EXPECT_GE(output_data, input_data);
+          EXPECT_LE(output_data, input_data + input.SizeInBytes());
           EXPECT_EQ(outputs[i].Get<Tensor>().Strides(), output_data_[i].value_.Get<Tensor>().Strides());
           is_may_strided_output = true;
           break;
         }
       }
       ASSERT_TRUE(is_may_strided_output);
+
+      // the values of a strided output on CPU are compared after copying them to contiguous tensors.
+      if (provider_ == kCpuExecutionProvider) {
+        const Tensor& expected = output_data_[i].value_.Get<Tensor>();
+        const Tensor& actual = outputs[i].Get<Tensor>();
+        auto allocator = execution_providers.Get(cpu_ep_type)->CreatePreferredAllocators()[0];
+        OrtValue expected_value;
+        OrtValue actual_value;
+        Tensor::InitOrtValue(expected.DataType(), expected.Shape(), allocator, expected_value);
+        Tensor::InitOrtValue(actual.DataType(), actual.Shape(), allocator, actual_value);
+        ASSERT_STATUS_OK(dtm.CopyTensor(expected, *expected_value.GetMutable<Tensor>()));
+        ASSERT_STATUS_OK(dtm.CopyTensor(actual, *actual_value.GetMutable<Tensor>()));
+        CheckOrtValuesAreEqual(output_data_[i].def_.Name(), expected_value, actual_value, {}, provider_);
+      }
     } else {
       // If it's contiguous output, check if the data is same as expected. If the output is on GPU, copy them to CPU
       // for comparison.
@@ -839,6 +839,56 @@ TEST_F(QnnHTPBackendTests, ContextBinaryCacheNonEmbedModeTest) {
                        context_binary_file);
 }
 
+// 1st run will generate the Qnn context cache onnx file
+// Then load the Qnn context cache model in 2 sessions sharing the EP contexts, which use the same Qnn backend.
+// The 1st session takes the only graph of the binary, so the 2nd one loads the binary into a Qnn context of its own.
+TEST_F(QnnHTPBackendTests, ContextBinaryCacheShareEpContextsTest) {
+  ProviderOptions provider_options;
+#if defined(_WIN32)
+  provider_options["backend_path"] = "QnnHtp.dll";
+#else
+  provider_options["backend_path"] = "libQnnHtp.so";
+#endif
+  const std::string context_binary_file = "./qnn_context_binary_share_ep_contexts_test.onnx";
+
+  std::unordered_map<std::string, std::string> session_option_pairs;
+  session_option_pairs.emplace(kOrtSessionOptionEpContextEnable, "1");
+  session_option_pairs.emplace(kOrtSessionOptionEpContextFilePath, context_binary_file);
+
+  const TestInputDef<float> input_def({1, 2, 3}, false, -10.0f, 10.0f);
+  const std::string op_type = "Atan";
+
+  // 1st run will generate the Qnn context cache binary file
+  TestQDQModelAccuracy(BuildOpTestCase<float>(op_type, {input_def}, {}, {}),
+                       BuildQDQOpTestCase<uint8_t>(op_type, {input_def}, {}, {}),
+                       provider_options,
+                       14,
+                       ExpectedEPNodeAssignment::All,
+                       QDQTolerance(),
+                       logging::Severity::kERROR,
+                       "",  // context model file path, not required for this inference
+                       session_option_pairs);
+
+  // Make sure the Qnn context cache binary file is generated
+  EXPECT_TRUE(std::filesystem::exists(context_binary_file.c_str()));
+
+  onnx::ModelProto model_proto;
+  onnxruntime::Model qnn_ctx_model;
+  ASSERT_STATUS_OK(qnn_ctx_model.Load(ToPathString(context_binary_file), model_proto));
+  std::string qnn_ctx_model_data;
+  model_proto.SerializeToString(&qnn_ctx_model_data);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionShareEpContexts, "1"));
+  InferenceSessionWrapper session_object_1{so, GetEnvironment()};
+  InferenceSessionWrapper session_object_2{so, GetEnvironment()};
+  for (auto* session_object : {&session_object_1, &session_object_2}) {
+    ASSERT_STATUS_OK(session_object->RegisterExecutionProvider(QnnExecutionProviderWithOptions(provider_options, &so)));
+    ASSERT_STATUS_OK(session_object->Load(qnn_ctx_model_data.data(), static_cast<int>(qnn_ctx_model_data.size())));
+    ASSERT_STATUS_OK(session_object->Initialize());
+  }
+}
+
 // Run QDQ model on HTP 2 times
 // 1st run will generate the Onnx skeleton file + Qnn context cache binary file
 // Then delete the context bin file to make the 2nd sesssion.Initialize() return the status with code INVALID_GRAPH
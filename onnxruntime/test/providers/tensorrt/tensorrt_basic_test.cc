@@ -658,6 +658,65 @@ TEST_P(TensorrtExecutionProviderCacheTest, Run) {
 INSTANTIATE_TEST_SUITE_P(TensorrtExecutionProviderCacheTests, TensorrtExecutionProviderCacheTest, testing::Values("engine_static", "engine_dynamic", "timing_static", "timing_dynamic"),
                          [](const ::testing::TestParamInfo<TensorrtExecutionProviderCacheTest::ParamType>& info) { return info.param; });
 
+TEST(TensorrtExecutionProviderTest, BackgroundEngineBuildTest) {
+  std::string model_name = "trt_execution_provider_background_engine_build_test.onnx";
+  std::vector<int> dims = {1, -1, -1};  // dynamic shape input
+  CreateBaseModel(model_name, "backgroundenginebuildtest", dims);
+
+  SessionOptions so;
+  so.session_logid = "TensorrtExecutionProviderBackgroundEngineBuildTest";
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  InferenceSession session_object{so, GetEnvironment()};
+  auto cuda_provider = DefaultCudaExecutionProvider();
+  auto cpu_allocator = cuda_provider->CreatePreferredAllocators()[1];
+
+  auto make_feeds = [&](const std::vector<int64_t>& input_dims, const std::vector<float>& values) {
+    NameMLValMap feeds;
+    for (const char* name : {"X", "Y", "Z"}) {
+      OrtValue ml_value;
+      CreateMLValue<float>(cpu_allocator, input_dims, values, &ml_value);
+      feeds.insert(std::make_pair(name, ml_value));
+    }
+    return feeds;
+  };
+
+  std::vector<int64_t> small_dims = {1, 3, 2};
+  std::vector<float> small_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<float> expected_small_values = {3.0f, 6.0f, 9.0f, 12.0f, 15.0f, 18.0f};
+  NameMLValMap small_feeds = make_feeds(small_dims, small_values);
+
+  std::vector<int64_t> large_dims = {1, 3, 4};
+  std::vector<float> large_values(12, 1.0f);
+  std::vector<float> expected_large_values(12, 3.0f);
+  NameMLValMap large_feeds = make_feeds(large_dims, large_values);
+
+  std::vector<std::string> output_names{"M"};
+
+  OrtTensorRTProviderOptionsV2 params;
+  params.trt_background_engine_build = 1;
+  std::unique_ptr<IExecutionProvider> execution_provider = TensorrtExecutionProviderWithOptions(&params);
+  EXPECT_TRUE(session_object.RegisterExecutionProvider(std::move(execution_provider)).IsOK());
+  ASSERT_TRUE(session_object.Load(model_name).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  // The first engine is built by the first run
+  RunSession(session_object, run_options, small_feeds, output_names, small_dims, expected_small_values);
+
+  // The engine for the larger shape range is built while the runs covered by the first engine keep using it
+  std::vector<std::thread> threads;
+  threads.push_back(std::thread(RunSession, std::ref(session_object), std::ref(run_options), std::ref(large_feeds), std::ref(output_names), std::ref(large_dims), std::ref(expected_large_values)));
+  for (int i = 0; i < 4; ++i) {
+    threads.push_back(std::thread(RunSession, std::ref(session_object), std::ref(run_options), std::ref(small_feeds), std::ref(output_names), std::ref(small_dims), std::ref(expected_small_values)));
+  }
+  for (auto& th : threads)
+    th.join();
+
+  // Both shapes run on the new engine
+  RunSession(session_object, run_options, large_feeds, output_names, large_dims, expected_large_values);
+  RunSession(session_object, run_options, small_feeds, output_names, small_dims, expected_small_values);
+}
+
 TEST(TensorrtExecutionProviderTest, FunctionTest) {
   onnxruntime::Model model("functiontest", false, DefaultLoggingManager().DefaultLogger());
   auto& graph = model.MainGraph();
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <atomic>
 #include <random>
 #include <string>
 
@@ -8,6 +9,8 @@
 #include "core/common/span_utils.h"
 #include "core/framework/utils.h"
 #include "core/graph/graph.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/xnnpack/detail/ort_pthreadpool.h"
 #include "core/providers/xnnpack/xnnpack_execution_provider.h"
 #include "core/session/inference_session.h"
 #include "core/session/onnxruntime_cxx_api.h"
@@ -171,7 +174,8 @@ TEST(XnnpackEP, TestAddEpUsingPublicApi) {
 static void RunModelTest(
     const GetQDQTestCaseFn& build_test_case,
     const char* test_description,
-    const EPVerificationParams& params = EPVerificationParams()) {
+    const EPVerificationParams& params = EPVerificationParams(),
+    const ProviderOptions& provider_options = {}) {
   onnxruntime::Model model(test_description, false, DefaultLoggingManager().DefaultLogger());
   Graph& graph = model.MainGraph();
   ModelTestBuilder helper(graph);
@@ -184,7 +188,8 @@ static void RunModelTest(
   model.ToProto().SerializeToString(&model_data);
   const auto model_data_span = AsByteSpan(model_data.data(), model_data.size());
   RunAndVerifyOutputsWithEP(model_data_span, "XnnpackEP.TestQDQModel",
-                            DefaultXnnpackExecutionProvider(),
+                            std::make_unique<XnnpackExecutionProvider>(
+                                XnnpackExecutionProviderInfo{provider_options, nullptr}),
                             helper.feeds_, params);
 }
 
@@ -350,6 +355,47 @@ TEST(XnnpackEP, DISABLED_TestQDQMaxPool_s8) {  // [ONNXRuntimeError] : 9 : NOT_I
 
 // xnnpack only support the last dim as reduced axis,
 // we are expected that the other reduce axis would be handled by CPUEP
+// the Conv, Relu, MaxPool and Add nodes should be compiled into a single XNNPACK subgraph.
+TEST(XnnpackEP, TestSubgraphCompile) {
+  auto modelBuilder = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 3, 8, 8}, -1.f, 1.f);
+    auto* weight = builder.MakeInitializer<float>({8, 3, 3, 3}, -1.f, 1.f);
+    auto* bias = builder.MakeInitializer<float>({8}, -1.f, 1.f);
+    auto* residual = builder.MakeInitializer<float>({1, 8, 4, 4}, -1.f, 1.f);
+    auto* conv_output = builder.MakeIntermediate();
+    auto* relu_output = builder.MakeIntermediate();
+    auto* pool_output = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    Node& conv_node = builder.AddNode("Conv", {input_arg, weight, bias}, {conv_output});
+    conv_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+    builder.AddNode("Relu", {conv_output}, {relu_output});
+    Node& pool_node = builder.AddNode("MaxPool", {relu_output}, {pool_output});
+    pool_node.AddAttribute("kernel_shape", std::vector<int64_t>{2, 2});
+    pool_node.AddAttribute("strides", std::vector<int64_t>{2, 2});
+    builder.AddNode("Add", {pool_output, residual}, {output_arg});
+  };
+
+  std::function<void(const Graph&)> verify = [](const Graph& graph) -> void {
+    int xnnpack_nodes = 0;
+    for (const auto& node : graph.Nodes()) {
+      if (node.GetExecutionProviderType() == kXnnpackExecutionProvider) {
+        ++xnnpack_nodes;
+        EXPECT_EQ(node.OpType().rfind("XNNPACK_", 0), 0u) << "The XNNPACK node should be a compiled subgraph";
+      }
+    }
+
+    ASSERT_EQ(xnnpack_nodes, 1) << "All the nodes but the layout Transpose nodes should be in one subgraph";
+  };
+
+  EPVerificationParams params;
+  params.ep_node_assignment = ExpectedEPNodeAssignment::Some;
+  params.fp32_abs_err = 0.0002f;
+  params.graph_verifier = &verify;
+
+  RunModelTest(modelBuilder, "xnnpack_test_graph_subgraph_compile", params, {{"enable_subgraph_compile", "1"}});
+}
+
 TEST(XnnpackEP, TestQDQSoftMax_axisZero_v13) {
   RunModelTest(BuildQDQSoftMaxTestCase<uint8_t, uint8_t>(
                    {1, 2, 3, 32} /* input_shape */,
@@ -559,5 +605,51 @@ TEST(XnnpackEP, DISABLED_TestResize_u8_and_s8_NHWC_pytorch_half_pixel) {  // [ON
 
 #endif
 
+#if defined(XNNPACK_USE_ORT_THREADPOOL)
+// the pthreadpool implementation over ORT's thread pool runs each tile once, and a thread index at a time
+TEST(XnnpackEP, TestOrtPthreadpoolTiles) {
+  concurrency::ThreadPool tp(&Env::Default(), ThreadOptions{}, nullptr, 4, true);
+  pthreadpool threadpool{&tp};
+  const size_t num_threads = pthreadpool_get_threads_count(&threadpool);
+  ASSERT_GE(num_threads, 4u);
+
+  constexpr size_t range_i = 5, range_j = 7, range_k = 9;
+  struct Context {
+    std::vector<std::atomic<int>> visits;
+    std::vector<std::atomic<int>> running;
+    std::atomic<bool> concurrent_thread{false};
+  } context{std::vector<std::atomic<int>>(range_i * range_j * range_k), std::vector<std::atomic<int>>(num_threads)};
+
+  pthreadpool_parallelize_3d_tile_2d_with_uarch(
+      &threadpool,
+      [](void* data, uint32_t, size_t i, size_t j, size_t k, size_t tile_j, size_t tile_k) {
+        auto& ctx = *static_cast<Context*>(data);
+        for (size_t jj = j; jj < j + tile_j; ++jj) {
+          for (size_t kk = k; kk < k + tile_k; ++kk) {
+            ++ctx.visits[(i * range_j + jj) * range_k + kk];
+          }
+        }
+      },
+      &context, 0, 0, range_i, range_j, range_k, 3, 4, 0);
+
+  for (const auto& visits : context.visits) {
+    EXPECT_EQ(visits, 1);
+  }
+
+  pthreadpool_parallelize_3d_tile_1d_with_thread(
+      &threadpool,
+      [](void* data, size_t thread, size_t, size_t, size_t, size_t) {
+        auto& ctx = *static_cast<Context*>(data);
+        if (ctx.running[thread]++ != 0) {
+          ctx.concurrent_thread = true;
+        }
+        --ctx.running[thread];
+      },
+      &context, range_i, range_j, range_k, 2, 0);
+
+  EXPECT_FALSE(context.concurrent_thread);
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
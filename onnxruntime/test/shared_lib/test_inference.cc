@@ -1983,6 +1983,80 @@ TEST(CApiTest, basic_cuda_graph) {
   binding.ClearBoundOutputs();
 }
 
+#if !defined(USE_TENSORRT)
+// Each graph id captures its own graph, which replays with the buffers bound when it was captured.
+TEST(CApiTest, cuda_graph_with_graph_ids) {
+  const auto& api = Ort::GetApi();
+
+  OrtCUDAProviderOptionsV2* cuda_options = nullptr;
+  ASSERT_TRUE(api.CreateCUDAProviderOptions(&cuda_options) == nullptr);
+  std::unique_ptr<OrtCUDAProviderOptionsV2, decltype(api.ReleaseCUDAProviderOptions)>
+      rel_cuda_options(cuda_options, api.ReleaseCUDAProviderOptions);
+  std::vector<const char*> keys{"enable_cuda_graph", "cuda_graph_max_count"};
+  std::vector<const char*> values{"1", "2"};
+  ASSERT_TRUE(api.UpdateCUDAProviderOptions(rel_cuda_options.get(), keys.data(), values.data(), keys.size()) == nullptr);
+
+  Ort::SessionOptions session_options;
+  ASSERT_TRUE(api.SessionOptionsAppendExecutionProvider_CUDA_V2(
+                  static_cast<OrtSessionOptions*>(session_options),
+                  rel_cuda_options.get()) == nullptr);
+
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+  Ort::MemoryInfo info_cuda("Cuda", OrtAllocatorType::OrtArenaAllocator, 0, OrtMemTypeDefault);
+  Ort::Allocator cuda_allocator(session, info_cuda);
+
+  const std::array<int64_t, 2> shape = {3, 2};
+  struct GraphBuffers {
+    Ort::MemoryAllocation x;
+    Ort::MemoryAllocation y;
+    Ort::IoBinding binding;
+  };
+  std::vector<GraphBuffers> graphs;
+  for (int i = 0; i < 2; ++i) {
+    auto x = cuda_allocator.GetAllocation(6 * sizeof(float));
+    auto y = cuda_allocator.GetAllocation(6 * sizeof(float));
+    Ort::IoBinding binding(session);
+    binding.BindInput("X", Ort::Value::CreateTensor(info_cuda, reinterpret_cast<float*>(x.get()), 6,
+                                                    shape.data(), shape.size()));
+    binding.BindOutput("Y", Ort::Value::CreateTensor(info_cuda, reinterpret_cast<float*>(y.get()), 6,
+                                                     shape.data(), shape.size()));
+    graphs.push_back(GraphBuffers{std::move(x), std::move(y), std::move(binding)});
+  }
+
+  auto run = [&](int graph_id, float scale) {
+    std::array<float, 6> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+    for (auto& value : x_values) {
+      value *= scale;
+    }
+    auto& graph = graphs[graph_id];
+    cudaMemcpy(graph.x.get(), x_values.data(), sizeof(float) * x_values.size(), cudaMemcpyHostToDevice);
+    graph.binding.SynchronizeInputs();
+
+    Ort::RunOptions run_options;
+    run_options.AddConfigEntry("gpu_graph_id", std::to_string(graph_id).c_str());
+    session.Run(run_options, graph.binding);
+
+    std::array<float, 6> y_values;
+    cudaMemcpy(y_values.data(), graph.y.get(), sizeof(float) * y_values.size(), cudaMemcpyDeviceToHost);
+    for (size_t i = 0; i < x_values.size(); ++i) {
+      ASSERT_EQ(y_values[i], x_values[i] * x_values[i]);
+    }
+  };
+
+  // the first run of each id captures its graph, the later ones replay it
+  run(0, 1.0f);
+  run(1, 10.0f);
+  run(0, 2.0f);
+  run(1, 20.0f);
+  run(0, 3.0f);
+
+  for (auto& graph : graphs) {
+    graph.binding.ClearBoundInputs();
+    graph.binding.ClearBoundOutputs();
+  }
+}
+#endif
+
 #ifndef REDUCED_OPS_BUILD
 // The following test uses some ops not supported in the reduced ops build
 TEST(CApiTest, cuda_graph_with_shape_nodes) {
@@ -166,4 +166,13 @@ Module['jsepInit'] = (backend, alloc, free, copy, copyAsync, createKernel, relea
   Module['jsepCreateDownloader'] = (gpuBuffer, size, type) => {
     return backend['createDownloader'](gpuBuffer, size, type);
   };
+  Module['jsepCaptureBegin'] = (graphKey) => {
+    backend['captureBegin'](graphKey);
+  };
+  Module['jsepCaptureEnd'] = (graphKey) => {
+    backend['captureEnd'](graphKey);
+  };
+  Module['jsepReplay'] = (graphKey) => {
+    backend['replay'](graphKey);
+  };
 };
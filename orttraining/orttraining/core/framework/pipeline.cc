@@ -577,6 +577,52 @@ int PipelineScheduler::GetBackwardRecvRecordedEvent(const int batch_id, const in
   return GetEventOrDefault(false, batch_id, stage_id, PipelineTask::Pass::Backward, PipelineTask::Type::Recv);
 }
 
+std::vector<std::vector<PipelineComputeTask>> CreateInterleaved1F1BSchedule(const int num_batches,
+                                                                            const int num_stages,
+                                                                            const int num_chunks) {
+  if (num_batches <= 0 || num_stages <= 0 || num_chunks <= 0) {
+    throw std::invalid_argument("The numbers of micro-batches, stages and chunks must be positive.");
+  }
+  if (num_chunks > 1 && num_batches % num_stages != 0) {
+    throw std::invalid_argument("The number of micro-batches must be a multiple of the number of stages.");
+  }
+
+  // The k-th forward of a stage is of micro-batch group * num_stages + k % num_stages through chunk
+  // (k / num_stages) % num_chunks: each group of num_stages micro-batches goes through all the chunks before the next
+  // one. The k-th backward goes through the chunks in the reverse order.
+  const int num_tasks = num_batches * num_chunks;
+  const auto get_task = [num_stages, num_chunks](const int k, const PipelineTask::Pass pass) {
+    const int group_size = num_stages * num_chunks;
+    const int batch = (k / group_size) * num_stages + k % num_stages;
+    const int chunk = (k % group_size) / num_stages;
+    return PipelineComputeTask{batch, pass == PipelineTask::Pass::Forward ? chunk : num_chunks - 1 - chunk, pass};
+  };
+
+  std::vector<std::vector<PipelineComputeTask>> schedule(num_stages);
+  for (int s = 0; s < num_stages; ++s) {
+    // The forwards before the first backward reaches the stage, which runs once the first micro-batch went through
+    // the chunks of all the later virtual stages.
+    const int num_warmup_tasks = std::min(
+        num_tasks, num_chunks == 1 ? num_stages - s - 1 : (num_stages - s - 1) * 2 + (num_chunks - 1) * num_stages);
+
+    auto& order = schedule.at(s);
+    order.reserve(2 * num_tasks);
+    for (int k = 0; k < num_warmup_tasks; ++k) {
+      order.push_back(get_task(k, PipelineTask::Pass::Forward));
+    }
+    // One forward, one backward.
+    for (int k = 0; k < num_tasks - num_warmup_tasks; ++k) {
+      order.push_back(get_task(num_warmup_tasks + k, PipelineTask::Pass::Forward));
+      order.push_back(get_task(k, PipelineTask::Pass::Backward));
+    }
+    // The backwards draining the pipeline.
+    for (int k = num_tasks - num_warmup_tasks; k < num_tasks; ++k) {
+      order.push_back(get_task(k, PipelineTask::Pass::Backward));
+    }
+  }
+  return schedule;
+}
+
 void PipelineWorkerPool::Join(size_t worker_id) {
   auto& worker = workers.at(worker_id);
   if (!worker.joinable())
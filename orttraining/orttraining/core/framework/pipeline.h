@@ -237,6 +237,26 @@ class PipelineScheduler {
   std::vector<int> stage_id_to_rank_id_map_;
 };
 
+// A computation in the order of a pipeline stage: the forward or backward pass of a micro-batch through one of the
+// model chunks of the stage.
+struct PipelineComputeTask {
+  int batch;
+  // Chunk c of stage s is the virtual stage c * num_stages + s of the model.
+  int chunk;
+  PipelineTask::Pass pass;
+};
+
+// Returns for each stage the order of its computations in the interleaved 1F1B schedule, in which each stage holds
+// num_chunks chunks of the model and the micro-batches go through the chunks by groups of num_stages. After warming
+// up with forwards, a stage alternates one forward and one backward, so the activations it holds are bounded by the
+// number of stages rather than of micro-batches: at most 2 * (num_stages - stage - 1) + (num_chunks - 1) * num_stages
+// + 1 forwards are without their backward, num_stages - stage without interleaving. Interleaving divides the time the
+// stages wait in the pipeline fill and drain by num_chunks, for num_chunks times as many sends and receives.
+// num_batches must be a multiple of num_stages when num_chunks > 1.
+std::vector<std::vector<PipelineComputeTask>> CreateInterleaved1F1BSchedule(const int num_batches,
+                                                                            const int num_stages,
+                                                                            const int num_chunks);
+
 struct PipelineWorkerState {
   std::vector<std::string> feed_names;
   std::vector<OrtValue> feeds;
@@ -3,6 +3,12 @@
 
 #include "orttraining/core/graph/allreduce_optimizer_graph_builder.h"
 
+#include <algorithm>
+#include <numeric>
+#include <optional>
+
+#include "core/framework/session_options.h"
+#include "core/graph/graph_viewer.h"
 #include "orttraining/core/framework/distributed_run_context.h"
 
 namespace onnxruntime {
@@ -41,6 +47,119 @@ static Status AddNcclAllReduceForGradients(
   return Status::OK();
 }
 
+// Splits the gradients into buckets of about bucket_size_in_bytes once cast to allreduce_element_type, in the order
+// that the backward pass produces them. A gradient of unknown size ends its bucket.
+static std::vector<std::vector<size_t>> BucketGradients(
+    const Graph& graph,
+    const std::vector<std::string>& gradient_names,
+    const std::vector<ArgDef>& gradient_argdefs,
+    ONNX_NAMESPACE::TensorProto_DataType allreduce_element_type,
+    int64_t bucket_size_in_bytes) {
+  InlinedHashMap<NodeIndex, size_t> node_positions;
+  const auto& topological_order = GraphViewer(graph).GetNodesInTopologicalOrder();
+  for (size_t i = 0; i < topological_order.size(); ++i) {
+    node_positions[topological_order[i]] = i;
+  }
+  std::vector<size_t> gradient_positions(gradient_names.size(), topological_order.size());
+  for (size_t i = 0; i < gradient_names.size(); ++i) {
+    if (const Node* producer = graph.GetProducerNode(gradient_names[i]); producer != nullptr) {
+      gradient_positions[i] = node_positions[producer->Index()];
+    }
+  }
+
+  std::vector<size_t> ready_order(gradient_argdefs.size());
+  std::iota(ready_order.begin(), ready_order.end(), 0);
+  std::stable_sort(ready_order.begin(), ready_order.end(), [&gradient_positions](size_t a, size_t b) {
+    return gradient_positions[a] < gradient_positions[b];
+  });
+
+  const int64_t element_size =
+      static_cast<int64_t>(DataTypeImpl::TensorTypeFromONNXEnum(allreduce_element_type)->GetElementType()->Size());
+  std::vector<std::vector<size_t>> buckets;
+  std::vector<size_t> bucket;
+  int64_t bucket_bytes = 0;
+  for (const size_t i : ready_order) {
+    std::optional<int64_t> num_elements = 1;
+    const auto* type_proto = gradient_argdefs[i].type_proto;
+    if (type_proto == nullptr || !type_proto->tensor_type().has_shape()) {
+      num_elements.reset();
+    } else {
+      for (const auto& dim : type_proto->tensor_type().shape().dim()) {
+        if (!dim.has_dim_value()) {
+          num_elements.reset();
+          break;
+        }
+        *num_elements *= dim.dim_value();
+      }
+    }
+
+    bucket.push_back(i);
+    bucket_bytes += num_elements.value_or(0) * element_size;
+    if (!num_elements.has_value() || bucket_bytes >= bucket_size_in_bytes) {
+      buckets.push_back(std::move(bucket));
+      bucket.clear();
+      bucket_bytes = 0;
+    }
+  }
+  if (!bucket.empty()) {
+    buckets.push_back(std::move(bucket));
+  }
+
+  return buckets;
+}
+
+// Scales and all-reduces each bucket of gradients with its own nodes, which run as soon as the gradients of the
+// bucket are ready rather than after the whole backward pass.
+static Status AddBucketedNcclAllReduceForGradients(
+    const NodeArgNameGeneratorFn& nodearg_name_generator,
+    const std::vector<std::vector<size_t>>& buckets,
+    const float scale,
+    ONNX_NAMESPACE::TensorProto_DataType allreduce_element_type,
+    std::vector<ArgDef>& gradient_argdefs,
+    GraphAugmenter::GraphDefs& graph_defs) {
+  ArgDef pre_allreduce_scale(nodearg_name_generator("pre_allreduce_scale"),
+                             graph_defs.CreateTypeProto({}, ONNX_NAMESPACE::TensorProto_DataType_FLOAT));
+  graph_defs.AddInitializers({CreateTensorProto<float>(pre_allreduce_scale.name, scale, {})});
+
+  // the nodes of a bucket are scheduled before the rest of the backward pass once its gradients are ready
+  const int priority = static_cast<int>(ExecutionPriority::LOCAL_HIGH);
+  std::vector<ArgDef> allreduce_gradient_argdefs(gradient_argdefs.size());
+  for (const auto& bucket : buckets) {
+    std::vector<ArgDef> scale_inputs{pre_allreduce_scale};
+    std::vector<ArgDef> scaled_gradients;
+    std::vector<ArgDef> allreduce_outputs;
+    for (const size_t i : bucket) {
+      scale_inputs.push_back(gradient_argdefs[i]);
+
+      TypeProto* scaled_gradient_type_proto = graph_defs.CopyTypeProto(gradient_argdefs[i]);
+      scaled_gradient_type_proto->mutable_tensor_type()->set_elem_type(allreduce_element_type);
+      scaled_gradients.emplace_back(nodearg_name_generator(gradient_argdefs[i].name + "_scaled"),
+                                    scaled_gradient_type_proto);
+      allreduce_outputs.emplace_back(gradient_argdefs[i].name + "_AllReduce_Out",
+                                     graph_defs.CopyTypeProto(scaled_gradients.back()));
+      allreduce_gradient_argdefs[i] = allreduce_outputs.back();
+    }
+
+    graph_defs.AddNodeDefs({NodeDef(OpDef{"MixedPrecisionScale", kMSDomain, 1},
+                                    scale_inputs,
+                                    scaled_gradients,
+                                    std::vector<AttributeProto>({ONNX_NAMESPACE::MakeAttribute(
+                                        "to", static_cast<int64_t>(allreduce_element_type))}),
+                                    nodearg_name_generator(pre_allreduce_scale.name),
+                                    priority),
+                            NodeDef(OpDef{"NcclAllReduce", kMSDomain, 1},
+                                    scaled_gradients,
+                                    allreduce_outputs,
+                                    {ONNX_NAMESPACE::MakeAttribute(
+                                        "group_type", static_cast<int64_t>(WorkerGroupType::DataParallel))},
+                                    nodearg_name_generator("NcclAllReduce"),
+                                    priority)});
+  }
+
+  gradient_argdefs = allreduce_gradient_argdefs;
+  return Status::OK();
+}
+
 AllreduceOptimizerGraphBuilder::AllreduceOptimizerGraphBuilder(
     const OptimizerBuilderRegistry& opt_builder_registry,
     const OptimizerGraphConfig& opt_graph_config,
@@ -80,10 +199,18 @@ Status AllreduceOptimizerGraphBuilder::BuildInternal(
       opt_graph_config_.gradient_accumulation_steps * opt_graph_config_.data_parallel_group_size;
   ORT_RETURN_IF_NOT(total_num_accumulations > 0, "total_num_accumulations <= 0");
   const float scale = 1.0f / total_num_accumulations;
-  ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, gradient_argdefs, output_gradient_argdef, graph_defs,
-                                              opt_graph_config_.AllReduceDataType()));
-
-  ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(gradient_argdefs, output_gradient_argdef, graph_defs));
+  if (opt_graph_config_.allreduce_bucket_size_in_bytes > 0) {
+    const auto buckets = BucketGradients(graph, gradient_names_, gradient_argdefs,
+                                         opt_graph_config_.AllReduceDataType(),
+                                         opt_graph_config_.allreduce_bucket_size_in_bytes);
+    ORT_RETURN_IF_ERROR(AddBucketedNcclAllReduceForGradients(
+        nodearg_name_generator, buckets, scale, opt_graph_config_.AllReduceDataType(), gradient_argdefs, graph_defs));
+  } else {
+    ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, gradient_argdefs, output_gradient_argdef, graph_defs,
+                                                opt_graph_config_.AllReduceDataType()));
+
+    ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(gradient_argdefs, output_gradient_argdef, graph_defs));
+  }
 
   // check if all gradients are finite
   ArgDef global_grad_norm_argdef;
@@ -2,9 +2,14 @@
 // Licensed under the MIT License.
 
 #include "orttraining/core/graph/mixed_precision_transformer.h"
+
+#include <algorithm>
+#include <map>
+
 #include "core/graph/graph_utils.h"
 #include "core/graph/graph_viewer.h"
 #include "orttraining/core/graph/gradient_builder_base.h"
+#include "orttraining/core/graph/graph_augmenter.h"
 #include "core/optimizer/insert_cast_transformer.h"
 #include "core/optimizer/initializer.h"
 #include "onnx/defs/attr_proto_util.h"
@@ -582,5 +587,217 @@ Status TransformGraphForMixedPrecision(Graph& graph,
   return Status::OK();
 }
 
+namespace {
+
+// A GEMM computing alpha * op(A) * op(B), op transposing its input if trans_a or trans_b is set.
+struct Float8GemmInfo {
+  bool trans_a{};
+  bool trans_b{};
+  float alpha{1.0f};
+};
+
+bool GetFloat8GemmInfo(const Node& node, ONNX_NAMESPACE::TensorProto_DataType mixed_precision_type,
+                       Float8GemmInfo& info) {
+  const auto get_int = [&node](const char* name) {
+    const auto* attr = graph_utils::GetNodeAttribute(node, name);
+    return attr != nullptr ? attr->i() : int64_t{0};
+  };
+  const auto get_alpha = [&node]() {
+    const auto* attr = graph_utils::GetNodeAttribute(node, "alpha");
+    return attr != nullptr ? attr->f() : 1.0f;
+  };
+
+  const auto& input_defs = node.InputDefs();
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", {13})) {
+    info = Float8GemmInfo{};
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gemm", {13})) {
+    // the bias is left to Gemm
+    if (input_defs.size() > 2 && input_defs[2]->Exists()) {
+      return false;
+    }
+    info = Float8GemmInfo{get_int("transA") != 0, get_int("transB") != 0, get_alpha()};
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "FusedMatMul", {1}, kMSDomain)) {
+    if (get_int("transBatchA") != 0 || get_int("transBatchB") != 0) {
+      return false;
+    }
+    info = Float8GemmInfo{get_int("transA") != 0, get_int("transB") != 0, get_alpha()};
+  } else {
+    return false;
+  }
+
+  const NodeArg& a = *input_defs[0];
+  const NodeArg& b = *input_defs[1];
+  const NodeArg& y = *node.OutputDefs()[0];
+  for (const NodeArg* arg : {&a, &b, &y}) {
+    if (arg->TypeAsProto() == nullptr || arg->TypeAsProto()->tensor_type().elem_type() != mixed_precision_type) {
+      return false;
+    }
+  }
+
+  // A may have leading dims flattened into M unless it is transposed, B is a matrix.
+  const auto* shape_a = a.Shape();
+  const auto* shape_b = b.Shape();
+  if (shape_a == nullptr || shape_b == nullptr || shape_a->dim_size() < 2 || shape_b->dim_size() != 2 ||
+      (info.trans_a && shape_a->dim_size() != 2)) {
+    return false;
+  }
+
+  // cuBLASLt multiplies float 8 matrices whose K and N are multiples of 16
+  const auto& k_dim = shape_b->dim(info.trans_b ? 1 : 0);
+  const auto& n_dim = shape_b->dim(info.trans_b ? 0 : 1);
+  return k_dim.has_dim_value() && k_dim.dim_value() % 16 == 0 && n_dim.has_dim_value() &&
+         n_dim.dim_value() % 16 == 0;
+}
+
+bool IsGradientName(const std::string& name) {
+  static const std::string gradient_suffix = GradientBuilderBase::GradientName("");
+  return name.size() > gradient_suffix.size() &&
+         name.compare(name.size() - gradient_suffix.size(), gradient_suffix.size(), gradient_suffix) == 0;
+}
+
+}  // namespace
+
+Status TransformGraphForFloat8Training(Graph& graph,
+                                       const std::unordered_set<std::string>& weights_to_train,
+                                       ONNX_NAMESPACE::TensorProto_DataType mixed_precision_type,
+                                       std::vector<Float8ScaledTensor>& scaled_tensors) {
+  const auto& domain_to_version = graph.DomainToVersionMap();
+  const auto onnx_opset = domain_to_version.find(kOnnxDomain);
+  ORT_RETURN_IF(onnx_opset == domain_to_version.end() || onnx_opset->second < 19,
+                "Float 8 training casts to float 8 types, which requires ONNX opset 19 or later.");
+
+  // The tensors computed from gradients are quantized to FLOAT8E5M2, whose range fits their larger dynamic range.
+  InlinedHashSet<const NodeArg*> gradients;
+  GraphViewer graph_viewer(graph);
+  for (auto node_index : graph_viewer.GetNodesInTopologicalOrder()) {
+    const Node& node = *graph.GetNode(node_index);
+    const bool from_gradient = std::any_of(
+        node.InputDefs().begin(), node.InputDefs().end(), [&gradients](const NodeArg* input) {
+          return gradients.count(input) > 0 || IsGradientName(input->Name());
+        });
+    if (from_gradient) {
+      gradients.insert(node.OutputDefs().begin(), node.OutputDefs().end());
+    }
+  }
+
+  GraphAugmenter::GraphDefs defs{};
+  TypeProto* float_scalar_type = defs.CreateTypeProto();
+  float_scalar_type->mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_scalar_type->mutable_tensor_type()->mutable_shape();
+
+  std::vector<Float8ScaledTensor> scaled_tensors_result;
+  // by tensor name, the index of the scaled tensor and the name of its scale in the mixed precision type
+  std::unordered_map<std::string, std::pair<size_t, std::string>> scales;
+  // by tensor name and whether it is transposed, the name of the float 8 tensor
+  std::map<std::pair<std::string, bool>, std::string> float8_tensors;
+
+  const auto get_scale = [&](const NodeArg& tensor,
+                             ONNX_NAMESPACE::TensorProto_DataType float8_type) -> const std::pair<size_t, std::string>& {
+    auto it = scales.find(tensor.Name());
+    if (it != scales.end()) {
+      return it->second;
+    }
+
+    Float8ScaledTensor scaled_tensor{tensor.Name(), float8_type,
+                                     graph.GenerateNodeArgName(tensor.Name() + "_float8_scale"),
+                                     graph.GenerateNodeArgName(tensor.Name() + "_amax")};
+    const std::string scale_name = graph.GenerateNodeArgName(scaled_tensor.scale_input_name + "_mp");
+    const std::string abs_name = graph.GenerateNodeArgName(tensor.Name() + "_abs");
+    const std::string amax_name = graph.GenerateNodeArgName(tensor.Name() + "_amax_mp");
+    defs.AddNodeDefs({
+        NodeDef("Cast", {ArgDef(scaled_tensor.scale_input_name, float_scalar_type)}, {ArgDef(scale_name)},
+                {ONNX_NAMESPACE::MakeAttribute("to", int64_t(mixed_precision_type))},
+                graph.GenerateNodeName(scale_name)),
+        NodeDef("Abs", {ArgDef(tensor.Name())}, {ArgDef(abs_name)}, NodeAttributes(), graph.GenerateNodeName(abs_name)),
+        NodeDef("ReduceMax", {ArgDef(abs_name)}, {ArgDef(amax_name)},
+                {ONNX_NAMESPACE::MakeAttribute("keepdims", int64_t(0))}, graph.GenerateNodeName(amax_name)),
+        NodeDef("Cast", {ArgDef(amax_name)}, {ArgDef(scaled_tensor.amax_output_name, float_scalar_type)},
+                {ONNX_NAMESPACE::MakeAttribute("to", int64_t(ONNX_NAMESPACE::TensorProto_DataType_FLOAT))},
+                graph.GenerateNodeName(scaled_tensor.amax_output_name))});
+    defs.AddGraphInputs({scaled_tensor.scale_input_name});
+    defs.AddGraphOutputs({scaled_tensor.amax_output_name});
+
+    scaled_tensors_result.push_back(std::move(scaled_tensor));
+    return scales.emplace(tensor.Name(), std::make_pair(scaled_tensors_result.size() - 1, scale_name)).first->second;
+  };
+
+  const auto get_float8_tensor = [&](const NodeArg& tensor, bool transpose,
+                                     ONNX_NAMESPACE::TensorProto_DataType float8_type) -> const std::string& {
+    auto it = float8_tensors.find({tensor.Name(), transpose});
+    if (it != float8_tensors.end()) {
+      return it->second;
+    }
+
+    const std::string& scale_name = get_scale(tensor, float8_type).second;
+    std::string input_name = tensor.Name();
+    if (transpose) {
+      input_name = graph.GenerateNodeArgName(tensor.Name() + "_transposed");
+      defs.AddNodeDef(NodeDef("Transpose", {ArgDef(tensor.Name())}, {ArgDef(input_name)}, NodeAttributes(),
+                              graph.GenerateNodeName(input_name)));
+    }
+    const std::string scaled_name = graph.GenerateNodeArgName(input_name + "_scaled");
+    const std::string float8_name = graph.GenerateNodeArgName(input_name + "_float8");
+    defs.AddNodeDefs({
+        NodeDef("Div", {ArgDef(input_name), ArgDef(scale_name)}, {ArgDef(scaled_name)}, NodeAttributes(),
+                graph.GenerateNodeName(scaled_name)),
+        NodeDef("Cast", {ArgDef(scaled_name)}, {ArgDef(float8_name)},
+                {ONNX_NAMESPACE::MakeAttribute("to", int64_t(float8_type)),
+                 ONNX_NAMESPACE::MakeAttribute("saturate", int64_t(1))},
+                graph.GenerateNodeName(float8_name))});
+    return float8_tensors.emplace(std::make_pair(tensor.Name(), transpose), float8_name).first->second;
+  };
+
+  std::vector<NodeIndex> gemms_to_remove;
+  for (auto node_index : graph_viewer.GetNodesInTopologicalOrder()) {
+    const Node& node = *graph.GetNode(node_index);
+    Float8GemmInfo info;
+    if (!GetFloat8GemmInfo(node, mixed_precision_type, info)) {
+      continue;
+    }
+
+    const NodeArg& a = *node.InputDefs()[0];
+    const NodeArg& b = *node.InputDefs()[1];
+    const auto float8_type_a = gradients.count(&a) > 0 || IsGradientName(a.Name())
+                                   ? ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E5M2
+                                   : ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E4M3FN;
+    const auto float8_type_b = gradients.count(&b) > 0 || IsGradientName(b.Name())
+                                   ? ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E5M2
+                                   : ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E4M3FN;
+    // cuBLASLt does not multiply two FLOAT8E5M2 matrices
+    if (float8_type_a == ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E5M2 &&
+        float8_type_b == ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E5M2) {
+      continue;
+    }
+
+    // GemmFloat8 multiplies float 8 matrices with transA=0 and transB=1, so A is given as (M, K) and B as (N, K).
+    const std::string float8_a = get_float8_tensor(a, info.trans_a, float8_type_a);
+    const std::string float8_b = get_float8_tensor(b, !info.trans_b, float8_type_b);
+    defs.AddNodeDef(NodeDef(OpDef{"GemmFloat8", kMSDomain, 1},
+                            {ArgDef(float8_a), ArgDef(float8_b), ArgDef(),
+                             ArgDef(scaled_tensors_result[scales.at(a.Name()).first].scale_input_name),
+                             ArgDef(scaled_tensors_result[scales.at(b.Name()).first].scale_input_name)},
+                            {ArgDef(node.OutputDefs()[0]->Name())},
+                            {ONNX_NAMESPACE::MakeAttribute("transA", int64_t(0)),
+                             ONNX_NAMESPACE::MakeAttribute("transB", int64_t(1)),
+                             ONNX_NAMESPACE::MakeAttribute("alpha", info.alpha),
+                             ONNX_NAMESPACE::MakeAttribute("dtype", int64_t(mixed_precision_type))},
+                            graph.GenerateNodeName(node.Name() + "_float8")));
+    gemms_to_remove.push_back(node_index);
+  }
+
+  for (auto node_index : gemms_to_remove) {
+    Node& node = *graph.GetNode(node_index);
+    graph_utils::RemoveNodeOutputEdges(graph, node);
+    graph.RemoveNode(node_index);
+  }
+
+  if (!gemms_to_remove.empty()) {
+    ORT_RETURN_IF_ERROR(GraphAugmenter::AugmentGraph(graph, defs, &weights_to_train));
+  }
+
+  scaled_tensors = std::move(scaled_tensors_result);
+  return Status::OK();
+}
+
 }  // namespace training
 }  // namespace onnxruntime
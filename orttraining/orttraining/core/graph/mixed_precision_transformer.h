@@ -29,6 +29,39 @@ Status TransformGraphForMixedPrecision(Graph& graph,
                                        std::unordered_map<std::string, NodeArg*>& fp32_weight_name_to_mixed_precision_node_arg,
                                        bool layernorm_stash_as_fp32);
 
+// A tensor quantized to float 8 by TransformGraphForFloat8Training, with its delayed scaling factor.
+struct Float8ScaledTensor {
+  std::string tensor_name;
+  // FLOAT8E4M3FN for the activations and weights, FLOAT8E5M2 for the gradients.
+  ONNX_NAMESPACE::TensorProto_DataType float8_type;
+  // The float scalar graph input the tensor is divided by before it is cast to float 8.
+  std::string scale_input_name;
+  // The float scalar graph output of the maximum absolute value of the tensor in the step, from which the scale of
+  // the next steps is computed.
+  std::string amax_output_name;
+};
+
+/**
+ * Replaces the GEMMs of a mixed precision training graph (MatMul, Gemm without bias and FusedMatMul) by GemmFloat8,
+ * their inputs being cast to FLOAT8E4M3FN in the forward pass and to FLOAT8E5M2 when they are gradients. Each such
+ * tensor is scaled by a graph input and its amax is a graph output, so that the caller keeps its amax history and
+ * feeds the scale computed from it (delayed scaling). The outputs of the GEMMs stay in the mixed precision type.
+ *
+ * It applies after the gradient graph is built. The GEMMs whose inner and output dims are not multiples of 16, as
+ * cuBLASLt requires for float 8, are left as they are. The ONNX opset of the graph must be 19 or later.
+ *
+ * @param graph The graph.
+ * @param weights_to_train The names of the weights to train, which are preserved.
+ * @param mixed_precision_type The mixed precision element type of the GEMMs to replace.
+ * @param scaled_tensors The tensors quantized to float 8.
+ *
+ * @return The status of the operation.
+ */
+Status TransformGraphForFloat8Training(Graph& graph,
+                                       const std::unordered_set<std::string>& weights_to_train,
+                                       ONNX_NAMESPACE::TensorProto_DataType mixed_precision_type,
+                                       std::vector<Float8ScaledTensor>& scaled_tensors);
+
 /**
  * Checks if a node is an fp32-only node.
  *
@@ -73,6 +73,9 @@ struct OptimizerGraphConfig {
   std::string loss_scale_input_name{};  // empty string means no loss scaling factor is applied
   AdasumReductionType adasum_reduction_type{AdasumReductionType::None};
   bool enable_grad_norm_clip{true};
+  // the size of the buckets of gradients that are all-reduced together as soon as the backward pass produced them.
+  // 0 all-reduces all the gradients together after the backward pass.
+  int64_t allreduce_bucket_size_in_bytes{0};
 
   NameMLValMap shared_optimizer_states{};  // initial states for shared params, eg. 'Step' for lamb
 
@@ -0,0 +1,128 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "core/framework/session_options.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+#include "orttraining/core/optimizer/memory_optimizer/activation_offload.h"
+#include "orttraining/core/optimizer/memory_optimizer/memory_insight.h"
+#include "orttraining/core/optimizer/memory_optimizer/optimization_planner.h"
+#include "orttraining/core/optimizer/memory_optimizer/recompute_analysis.h"
+
+namespace onnxruntime {
+
+Status ActivationOffload::ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/,
+                                    const logging::Logger& logger) const {
+  if (offload_config_.budget_in_bytes < 0) {
+    return Status::OK();
+  }
+
+  ptrdiff_t yield_op_order_in_topological_sort;
+  InlinedHashMap<const Node*, InlinedVector<size_t>> candidate_output_args_map;
+  InlinedHashMap<NodeIndex, ptrdiff_t> node_index_to_its_order_in_topological_sort_map;
+  {
+    GraphViewer graph_viewer(graph);
+    optimizer::memory_optimizer::MemoryOptimizationPlanner memory_opt_planner;
+    ORT_RETURN_IF_ERROR(optimizer::memory_optimizer::FindORTModuleMemoryOpportunity(
+        graph_viewer,
+        optimizer::memory_optimizer::ProbeConfig(),
+        logger,
+        node_index_to_its_order_in_topological_sort_map,
+        yield_op_order_in_topological_sort,
+        candidate_output_args_map,
+        memory_opt_planner));
+  }
+
+  if (yield_op_order_in_topological_sort == -1) {
+    LOGS(logger, VERBOSE) << "No forward/backward boundary is found, skip activation offload.";
+    return Status::OK();
+  }
+
+  size_t offloaded_count = 0;
+  int64_t offloaded_byte_count = 0;
+  for (const auto& [const_node, output_indices] : candidate_output_args_map) {
+    Node* node = graph.GetNode(const_node->Index());
+    const std::string& provider = node->GetExecutionProviderType();
+    // Activations on the host have nowhere to be offloaded to.
+    if (provider.empty() || provider == kCpuExecutionProvider) {
+      continue;
+    }
+
+    for (size_t output_index : output_indices) {
+      NodeArg* activation = node->MutableOutputDefs()[output_index];
+      const auto byte_count = optimizer::memory_optimizer::GetTensorByteCount(*activation,
+                                                                              offload_config_.dim_values);
+      if (!byte_count.has_value() || *byte_count < offload_config_.budget_in_bytes ||
+          graph.IsOutput(activation)) {
+        continue;
+      }
+
+      // The edges to the backward consumers, which are moved to the prefetched activation.
+      std::vector<graph_utils::GraphEdge> backward_edges;
+      for (auto it = node->OutputEdgesBegin(), end = node->OutputEdgesEnd(); it != end; ++it) {
+        if (static_cast<size_t>(it->GetSrcArgIndex()) != output_index) {
+          continue;
+        }
+        const auto order = node_index_to_its_order_in_topological_sort_map.find(it->GetNode().Index());
+        if (order == node_index_to_its_order_in_topological_sort_map.end() ||
+            order->second > yield_op_order_in_topological_sort) {
+          backward_edges.push_back(graph_utils::GraphEdge::CreateGraphEdge(*node, *it, false));
+        }
+      }
+      if (backward_edges.empty()) {
+        continue;
+      }
+
+      NodeArg& offloaded = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(activation->Name() + "_offloaded"),
+                                                    activation->TypeAsProto());
+      Node& to_host_node = graph.AddNode(graph.GenerateNodeName(node->Name() + "_offload"), "MemcpyToHost",
+                                         "Offload of " + activation->Name(), {activation}, {&offloaded});
+      to_host_node.SetExecutionProviderType(provider);
+
+      NodeArg& prefetched = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(activation->Name() + "_prefetched"),
+                                                     activation->TypeAsProto());
+      Node& from_host_node = graph.AddNode(graph.GenerateNodeName(node->Name() + "_prefetch"), "MemcpyFromHost",
+                                           "Prefetch of " + activation->Name(), {&offloaded}, {&prefetched});
+      from_host_node.SetExecutionProviderType(provider);
+      // Like recompute nodes, run as late as possible, i.e. just before the first backward consumer.
+      from_host_node.SetPriority(static_cast<int>(ExecutionPriority::LOCAL_LOW));
+
+      ORT_RETURN_IF_NOT(graph.SetOpSchemaFromRegistryForNode(to_host_node) &&
+                            graph.SetOpSchemaFromRegistryForNode(from_host_node),
+                        "Failed to set op schema for added activation offload nodes.");
+
+      graph.AddEdge(node->Index(), to_host_node.Index(), static_cast<int>(output_index), 0);
+      graph.AddConsumerNode(activation->Name(), &to_host_node);
+      graph.UpdateProducerNode(offloaded.Name(), to_host_node.Index());
+      graph.AddEdge(to_host_node.Index(), from_host_node.Index(), 0, 0);
+      graph.AddConsumerNode(offloaded.Name(), &from_host_node);
+      graph.UpdateProducerNode(prefetched.Name(), from_host_node.Index());
+
+      graph_utils::GraphEdge::RemoveGraphEdges(graph, backward_edges);
+      for (const auto& edge : backward_edges) {
+        Node* consumer = graph.GetNode(edge.dst_node);
+        graph.RemoveConsumerNode(activation->Name(), consumer);
+        // Also replaces the input of the consumer with the prefetched activation.
+        graph.AddEdge(from_host_node.Index(), edge.dst_node, 0, edge.dst_arg_index);
+        graph.AddConsumerNode(prefetched.Name(), consumer);
+      }
+
+      LOGS(logger, INFO) << "Offload activation " << activation->Name() << " (" << *byte_count << " bytes) of node "
+                         << node->Name() << "(" << node->OpType() << ") to host memory.";
+      offloaded_count += 1;
+      offloaded_byte_count += *byte_count;
+      modified = true;
+    }
+  }
+
+  if (offloaded_count > 0) {
+    LOGS(logger, INFO) << "Total number of offloaded activations: " << offloaded_count << ", "
+                       << offloaded_byte_count << " bytes.";
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/optimizer/graph_transformer.h"
+#include "orttraining/core/optimizer/memory_optimizer/common.h"
+
+namespace onnxruntime {
+
+/**
+@Class ActivationOffload
+
+Offload large stashed activations to host memory, as an alternative to recomputing them. For each activation
+produced on a device in the forward pass and consumed in the backward pass:
+1. A MemcpyToHost node copies it to host memory right after it's produced, so that its device buffer is released
+   after its last forward consumer rather than held across the forward/backward boundary.
+2. A MemcpyFromHost node with lower node priority copies it back for its backward consumers. Priority-based
+   ordering runs it as late as possible, i.e. just before the first backward node consuming it.
+
+The host copies are allocated by the output allocator of MemcpyToHost, pinned memory on CUDA and ROCm, so the copies
+can run asynchronously with compute. This trades host/device bandwidth for memory without recomputation.
+*/
+class ActivationOffload : public GraphTransformer {
+ public:
+  /**
+   * @param offload_config The minimum size of the activations to offload, in the format of
+   *  MinSizeInBytes[:DimParam=DimValue,DimParam=DimValue,...], the dim values being used to estimate the size of
+   *  activations with symbolic dimensions. An empty string disables the transformer.
+   */
+  explicit ActivationOffload(const std::string& offload_config) : GraphTransformer("ActivationOffload") {
+    ORT_ENFORCE(optimizer::memory_optimizer::ParseMemoryBudgetConfigFromString(offload_config, offload_config_)
+                    .IsOK());
+  }
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  bool ShouldOnlyApplyOnce() const override { return true; }
+
+ private:
+  // budget_in_bytes is the minimum size of the activations to offload.
+  optimizer::memory_optimizer::MemoryBudgetConfig offload_config_;
+};
+
+}  // namespace onnxruntime
@@ -146,4 +146,59 @@ Status ParseOptimizationConfigFromString(std::string_view memory_optimization_co
   return Status::OK();
 }
 
+Status ParseMemoryBudgetConfigFromString(std::string_view memory_budget_config, MemoryBudgetConfig& budget_config) {
+  budget_config = MemoryBudgetConfig{};
+  if (memory_budget_config.empty()) {
+    return Status::OK();
+  }
+
+  const auto separator = memory_budget_config.find(':');
+  const std::string_view budget_str = memory_budget_config.substr(0, separator);
+  auto result = std::from_chars(budget_str.data(), budget_str.data() + budget_str.size(),
+                                budget_config.budget_in_bytes);
+  ORT_RETURN_IF_NOT(result.ec == std::errc() && result.ptr == budget_str.data() + budget_str.size() &&
+                        budget_config.budget_in_bytes >= 0,
+                    "Invalid memory budget in bytes: ", budget_str);
+
+  if (separator != std::string_view::npos) {
+    const auto dim_value_strs = utils::SplitString(memory_budget_config.substr(separator + 1), ",");
+    for (const auto& dim_value_str : dim_value_strs) {
+      const auto dim_value = utils::SplitString(dim_value_str, "=");
+      ORT_RETURN_IF_NOT(dim_value.size() == 2,
+                        "Dim value should be in the format of DimParam=DimValue, got: ", dim_value_str);
+      int64_t value = 0;
+      result = std::from_chars(dim_value[1].data(), dim_value[1].data() + dim_value[1].size(), value);
+      ORT_RETURN_IF_NOT(result.ec == std::errc() && value >= 0, "Invalid dim value: ", dim_value_str);
+      budget_config.dim_values[std::string(utils::TrimString(std::string(dim_value[0])))] = value;
+    }
+  }
+
+  return Status::OK();
+}
+
+std::optional<int64_t> GetTensorByteCount(const NodeArg& node_arg,
+                                          const InlinedHashMap<std::string, int64_t>& dim_values) {
+  const auto* type_proto = node_arg.TypeAsProto();
+  const auto* shape = node_arg.Shape();
+  if (type_proto == nullptr || !utils::HasTensorType(*type_proto) || shape == nullptr) {
+    return std::nullopt;
+  }
+
+  MLDataType ml_data_type = DataTypeImpl::TypeFromProto(*type_proto);
+  int64_t byte_count = static_cast<int64_t>(ml_data_type->AsTensorType()->GetElementType()->Size());
+  for (const auto& dim : shape->dim()) {
+    if (utils::HasDimValue(dim)) {
+      byte_count *= dim.dim_value();
+    } else {
+      const auto it = dim_values.find(utils::TrimString(dim.dim_param()));
+      if (!utils::HasDimParam(dim) || it == dim_values.end()) {
+        return std::nullopt;
+      }
+      byte_count *= it->second;
+    }
+  }
+
+  return byte_count;
+}
+
 }  // namespace onnxruntime::optimizer::memory_optimizer
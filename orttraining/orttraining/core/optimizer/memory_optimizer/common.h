@@ -4,6 +4,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -73,4 +74,31 @@ int ParseIntValueFromString(std::string_view str);
 Status ParseOptimizationConfigFromString(std::string_view memory_optimization_config,
                                          InlinedHashMap<std::string, UserConfig>& cluster_id_to_config_map);
 
+/**
+ * @brief Config of the automatic mode, picking the recompute subgraphs to fit the stashed activations in a budget.
+ * budget_in_bytes: the budget for the activations stashed from the forward pass for the backward pass. -1 means
+ *   the automatic mode is disabled.
+ * dim_values: the values of the symbolic dimensions (e.g. batch size and sequence length) the activation sizes are
+ *   estimated with.
+ */
+struct MemoryBudgetConfig {
+  int64_t budget_in_bytes{-1};
+  InlinedHashMap<std::string, int64_t> dim_values;
+};
+
+/**
+ * @brief Parse the memory budget config, in the format of
+ *  BudgetInBytes[:DimParam=DimValue,DimParam=DimValue,...], for example "1073741824:batch=8,seq_len=512".
+ *  An empty string disables the automatic mode.
+ */
+Status ParseMemoryBudgetConfigFromString(std::string_view memory_budget_config, MemoryBudgetConfig& budget_config);
+
+/**
+ * @brief Get the byte count of a tensor node arg, with the symbolic dimensions in dim_values.
+ *
+ * @return std::nullopt if the node arg is not a tensor or has an unknown dimension.
+ */
+std::optional<int64_t> GetTensorByteCount(const NodeArg& node_arg,
+                                          const InlinedHashMap<std::string, int64_t>& dim_values);
+
 }  // namespace onnxruntime::optimizer::memory_optimizer
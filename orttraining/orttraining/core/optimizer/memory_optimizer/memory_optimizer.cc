@@ -31,7 +31,8 @@ constexpr bool IsForwardPassOperator(ptrdiff_t op_order_in_topological_sort,
 }  // namespace
 
 Status MemoryOptimizer::ParseOptimizationConfigFromString(const std::string& memory_optimizer_config,
-                                                          const std::string& recompute_probe_config) {
+                                                          const std::string& recompute_probe_config,
+                                                          const std::string& memory_budget_config) {
   optimizer_config_ = memory_optimizer_config;
 
   ORT_RETURN_IF_ERROR(optimizer::memory_optimizer::ParseOptimizationConfigFromString(
@@ -42,6 +43,10 @@ Status MemoryOptimizer::ParseOptimizationConfigFromString(const std::string& mem
       recompute_probe_config,
       recompute_probe_config_));
 
+  ORT_RETURN_IF_ERROR(optimizer::memory_optimizer::ParseMemoryBudgetConfigFromString(
+      memory_budget_config,
+      memory_budget_config_));
+
   return Status::OK();
 }
 
@@ -132,8 +137,8 @@ Status MemoryOptimizer::ApplyImpl(Graph& graph, bool& modified, int /*graph_leve
                         << ", enable_transformer_layer_as_boundary:"
                         << recompute_probe_config_.enable_transformer_layer_as_boundary;
 
-  if (pattern_subgraph_to_user_optimizer_config_map_.empty()) {
-    LOGS(logger, VERBOSE) << "No optimization pattern is specified, skip memory optimization.";
+  if (pattern_subgraph_to_user_optimizer_config_map_.empty() && memory_budget_config_.budget_in_bytes < 0) {
+    LOGS(logger, VERBOSE) << "No optimization pattern or memory budget is specified, skip memory optimization.";
     return Status::OK();
   }
 
@@ -156,12 +161,18 @@ Status MemoryOptimizer::ApplyImpl(Graph& graph, bool& modified, int /*graph_leve
                   memory_opt_planner)
                   .IsOK());
 
-  // Finalize the plan according to user config,
+  // Finalize the plan according to user config and the memory budget,
   // then create a ClusterApplyContext for each unique cluster (having the same node pattern)
   InlinedHashMap<const Node*, std::shared_ptr<optimizer::memory_optimizer::NodeOptimizationPlanBase>>
       node_to_opt_plan_map;
   optimizer::memory_optimizer::NodeToClusterApplyContextMap node_to_apply_context_map;
-  ORT_ENFORCE(memory_opt_planner.FinalizeNodePlansFromUserConfig(pattern_subgraph_to_user_optimizer_config_map_,
+  InlinedHashMap<std::string, optimizer::memory_optimizer::UserConfig> cluster_id_to_config_map =
+      pattern_subgraph_to_user_optimizer_config_map_;
+  ORT_RETURN_IF_ERROR(memory_opt_planner.SelectNodePlansForMemoryBudget(memory_budget_config_,
+                                                                        candidate_output_args_map,
+                                                                        logger,
+                                                                        cluster_id_to_config_map));
+  ORT_ENFORCE(memory_opt_planner.FinalizeNodePlansFromUserConfig(cluster_id_to_config_map,
                                                                  node_to_opt_plan_map,
                                                                  node_to_apply_context_map)
                   .IsOK());
@@ -24,15 +24,21 @@ Find recompute subgraphs and enable them according to user configs. The way we c
   b. otherwise, stop collecting and return the subgraph (could be empty).
 3. Pick up the input node from the queue, and do 2 again. The process ends when the queue is empty or 2.b happens.
 4. Clone the recomputable subgraphs with lower node priority (to execute) and insert them back to the original graph.
+
+Besides the subgraphs the user configs name, the subgraphs to recompute can be picked automatically to fit the stashed
+activations in a memory budget, see MemoryOptimizationPlanner::SelectNodePlansForMemoryBudget.
 */
 
 class MemoryOptimizer : public GraphTransformer {
  private:
  public:
-  MemoryOptimizer(const std::string& memory_optimizer_config, const std::string& recompute_probe_config)
+  MemoryOptimizer(const std::string& memory_optimizer_config, const std::string& recompute_probe_config,
+                  const std::string& memory_budget_config = "")
       : GraphTransformer("MemoryOptimizer") {
     // Parse user-defined configs.
-    ORT_ENFORCE(ParseOptimizationConfigFromString(memory_optimizer_config, recompute_probe_config).IsOK());
+    ORT_ENFORCE(ParseOptimizationConfigFromString(memory_optimizer_config, recompute_probe_config,
+                                                  memory_budget_config)
+                    .IsOK());
   }
 
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
@@ -40,7 +46,9 @@ class MemoryOptimizer : public GraphTransformer {
   bool ShouldOnlyApplyOnce() const override { return true; }
 
  private:
-  Status ParseOptimizationConfigFromString(const std::string& memory_optimizer_config, const std::string& recompute_probe_config);
+  Status ParseOptimizationConfigFromString(const std::string& memory_optimizer_config,
+                                           const std::string& recompute_probe_config,
+                                           const std::string& memory_budget_config);
 
   /**
    * @brief Apply graph modifications based on user configs.
@@ -104,6 +112,8 @@ class MemoryOptimizer : public GraphTransformer {
   InlinedHashMap<std::string, optimizer::memory_optimizer::UserConfig> pattern_subgraph_to_user_optimizer_config_map_;
   std::string optimizer_config_;
   optimizer::memory_optimizer::ProbeConfig recompute_probe_config_;
+  // Automatic mode, picking more subgraphs to recompute to fit in the memory budget.
+  optimizer::memory_optimizer::MemoryBudgetConfig memory_budget_config_;
 };
 
 }  // namespace onnxruntime
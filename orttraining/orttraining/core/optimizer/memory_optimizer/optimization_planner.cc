@@ -1,9 +1,11 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/utils.h"
@@ -12,6 +14,7 @@
 
 #include "orttraining/core/optimizer/memory_optimizer/common.h"
 #include "orttraining/core/optimizer/memory_optimizer/optimization_planner.h"
+#include "orttraining/core/optimizer/memory_optimizer/recompute_analysis.h"
 
 namespace onnxruntime::optimizer::memory_optimizer {
 
@@ -121,11 +124,11 @@ Status MemoryOptimizationPlanner::FinalizeNodePlansFromUserConfig(
           std::shared_ptr<ClusterApplyContext> apply_context = std::make_shared<ClusterApplyContext>();
           apply_context->requested_count = user_config.requested_count;
           apply_context->type = user_config.type;
-          apply_context->total_frequency++;
           cluster_id_to_apply_contexts_map.insert({cluster_id, apply_context});
         }
 
         node_to_apply_context_map[node] = cluster_id_to_apply_contexts_map.at(cluster_id);
+        node_to_apply_context_map[node]->total_frequency++;
 
         // If different plans for the same node have same cluster id, we only need to finalize the first one.
         // The rest of them will be ignored.
@@ -137,4 +140,135 @@ Status MemoryOptimizationPlanner::FinalizeNodePlansFromUserConfig(
   return Status::OK();
 }
 
+Status MemoryOptimizationPlanner::SelectNodePlansForMemoryBudget(
+    const MemoryBudgetConfig& budget_config,
+    const InlinedHashMap<const Node*, InlinedVector<size_t>>& candidate_output_args_map,
+    const logging::Logger& logger,
+    InlinedHashMap<std::string, UserConfig>& cluster_id_to_user_configs) const {
+  if (budget_config.budget_in_bytes < 0) {
+    return Status::OK();
+  }
+
+  int64_t stashed_byte_count = 0;
+  for (const auto& [node, output_indices] : candidate_output_args_map) {
+    for (size_t output_index : output_indices) {
+      const auto byte_count = GetTensorByteCount(*node->OutputDefs()[output_index], budget_config.dim_values);
+      if (byte_count.has_value()) {
+        stashed_byte_count += *byte_count;
+      }
+    }
+  }
+
+  // The subgraphs requested by the user save memory too.
+  int64_t excess_byte_count = stashed_byte_count - budget_config.budget_in_bytes;
+
+  struct ClusterCost {
+    OptimizationType type;
+    int frequency{0};
+    int64_t saved_byte_count{0};       // of all the occurrences
+    int64_t recomputed_elem_count{0};  // of all the occurrences
+  };
+  InlinedHashMap<std::string, ClusterCost> cluster_costs;
+
+  for (const auto& [node, node_plans] : node_to_optimization_plans_map) {
+    // Like for user configs, a node is optimized with the first of its plans that is picked, so only cheaper
+    // recomputes are considered here.
+    for (const auto& node_plan : node_plans) {
+      const auto* recompute_plan = dynamic_cast<const NodeRecomputePlan*>(node_plan.get());
+      if (recompute_plan == nullptr || recompute_plan->IsCompromiseRecompute()) {
+        continue;
+      }
+
+      int64_t saved_byte_count = 0;
+      bool known_size = true;
+      for (size_t output_index : node_plan->GetActivationOutputIndices()) {
+        const auto byte_count = GetTensorByteCount(*node->OutputDefs()[output_index], budget_config.dim_values);
+        known_size = known_size && byte_count.has_value();
+        if (known_size && node_plan->reuse_buffers.find(output_index) == node_plan->reuse_buffers.end()) {
+          saved_byte_count += static_cast<int64_t>(*byte_count * node_plan->GetSaveRatio());
+        }
+      }
+
+      // The number of elements the subgraph outputs approximates its compute cost, its nodes being mostly
+      // element-wise.
+      int64_t recomputed_elem_count = 0;
+      for (const Node* recompute_node : recompute_plan->GetNodesInTopoOrder()) {
+        for (const NodeArg* output_def : recompute_node->OutputDefs()) {
+          const auto byte_count = GetTensorByteCount(*output_def, budget_config.dim_values);
+          known_size = known_size && byte_count.has_value();
+          if (known_size) {
+            MLDataType ml_data_type = DataTypeImpl::TypeFromProto(*output_def->TypeAsProto());
+            recomputed_elem_count +=
+                *byte_count / static_cast<int64_t>(ml_data_type->AsTensorType()->GetElementType()->Size());
+          }
+        }
+      }
+
+      if (!known_size || saved_byte_count == 0) {
+        continue;
+      }
+
+      auto& cluster_cost = cluster_costs[node_plan->GetClusterId()];
+      cluster_cost.type = node_plan->GetOptimizationType();
+      cluster_cost.frequency += 1;
+      cluster_cost.saved_byte_count += saved_byte_count;
+      cluster_cost.recomputed_elem_count += recomputed_elem_count;
+      break;
+    }
+  }
+
+  for (const auto& [cluster_id, user_config] : cluster_id_to_user_configs) {
+    const auto it = cluster_costs.find(cluster_id);
+    if (it != cluster_costs.end() && user_config.type == it->second.type) {
+      const int frequency = it->second.frequency;
+      const int count =
+          user_config.requested_count == -1 ? frequency : std::min(frequency, user_config.requested_count);
+      excess_byte_count -= it->second.saved_byte_count * count / frequency;
+    }
+  }
+
+  if (excess_byte_count <= 0) {
+    LOGS(logger, INFO) << "The stashed activations (" << stashed_byte_count << " bytes) fit in the memory budget of "
+                       << budget_config.budget_in_bytes << " bytes, no recompute subgraph is picked.";
+    return Status::OK();
+  }
+
+  std::vector<std::pair<std::string, ClusterCost>> sorted_cluster_costs;
+  for (const auto& [cluster_id, cluster_cost] : cluster_costs) {
+    if (cluster_id_to_user_configs.find(cluster_id) == cluster_id_to_user_configs.end()) {
+      sorted_cluster_costs.emplace_back(cluster_id, cluster_cost);
+    }
+  }
+  std::sort(sorted_cluster_costs.begin(), sorted_cluster_costs.end(), [](const auto& a, const auto& b) {
+    // a.recomputed / a.saved < b.recomputed / b.saved, ties broken by id to be deterministic
+    const double a_cost = static_cast<double>(a.second.recomputed_elem_count) * b.second.saved_byte_count;
+    const double b_cost = static_cast<double>(b.second.recomputed_elem_count) * a.second.saved_byte_count;
+    return a_cost != b_cost ? a_cost < b_cost : a.first < b.first;
+  });
+
+  for (const auto& [cluster_id, cluster_cost] : sorted_cluster_costs) {
+    if (excess_byte_count <= 0) {
+      break;
+    }
+
+    const int64_t saved_byte_count_per_occurrence =
+        std::max<int64_t>(1, cluster_cost.saved_byte_count / cluster_cost.frequency);
+    const int count = static_cast<int>(std::min<int64_t>(
+        cluster_cost.frequency,
+        (excess_byte_count + saved_byte_count_per_occurrence - 1) / saved_byte_count_per_occurrence));
+    cluster_id_to_user_configs[cluster_id] = UserConfig{cluster_cost.type, count};
+    excess_byte_count -= saved_byte_count_per_occurrence * count;
+    LOGS(logger, INFO) << "Memory budget: recompute " << count << " of " << cluster_cost.frequency
+                       << " occurrence(s) of " << cluster_id;
+  }
+
+  if (excess_byte_count > 0) {
+    LOGS(logger, WARNING) << "The stashed activations (" << stashed_byte_count << " bytes) exceed the memory budget of "
+                          << budget_config.budget_in_bytes << " bytes by " << excess_byte_count
+                          << " bytes after all the recompute subgraphs found.";
+  }
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime::optimizer::memory_optimizer
@@ -124,6 +124,28 @@ class MemoryOptimizationPlanner {
       InlinedHashMap<const Node*, std::shared_ptr<NodeOptimizationPlanBase>>& node_to_opt_plan_map,
       NodeToClusterApplyContextMap& node_to_apply_context_map) const;
 
+  /**
+   * @brief Pick the recompute subgraphs for the stashed activations to fit in the memory budget, with the fewest
+   * recomputed elements, and add them to cluster_id_to_user_configs as if the user requested them. The subgraphs
+   * already configured by the user are kept as they are.
+   *
+   * The stashed activations are all alive at the boundary between the forward and backward passes, where their sum
+   * is the peak they contribute to. The subgraphs are picked greedily, by increasing number of elements recomputed
+   * per byte saved, until the saving covers the part of the sum above the budget. The occurrences of a subgraph
+   * pattern are picked as a number of them, as with user configs.
+   *
+   * @param budget_config The budget and the values of symbolic dimensions to estimate the activation sizes with.
+   *  The activations and subgraphs of unknown size are not considered.
+   * @param candidate_output_args_map  A map from node to its stashed activations.
+   * @param logger Logger.
+   * @param cluster_id_to_user_configs The user configs, updated with the picked subgraphs.
+   */
+  Status SelectNodePlansForMemoryBudget(
+      const MemoryBudgetConfig& budget_config,
+      const InlinedHashMap<const Node*, InlinedVector<size_t>>& candidate_output_args_map,
+      const logging::Logger& logger,
+      InlinedHashMap<std::string, UserConfig>& cluster_id_to_user_configs) const;
+
   std::string GenerateNodeClusterId(const Node* node) const {
     ORT_ENFORCE(node_to_optimization_plans_map.find(node) != node_to_optimization_plans_map.end(),
                 "Node not found in node_to_optimization_plans_map.");
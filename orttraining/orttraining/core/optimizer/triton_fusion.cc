@@ -9,6 +9,7 @@
 #include "orttraining/core/optimizer/triton_fusion.h"
 
 #include "core/framework/compute_capability.h"
+#include "core/framework/murmurhash3.h"
 #include "core/graph/model.h"
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/initializer.h"
@@ -29,13 +30,115 @@ using ConstNodeArgVec = InlinedVector<const NodeArg*>;
 using NodeArgSet = InlinedHashSet<NodeArg*>;
 using IsSupportedFunc = std::function<bool(const Graph&, const Node&)>;
 
-int64_t Hash(const std::string& str) {
-  uint32_t hash = 0;
-  for (char const& c : str) {
-    hash = hash * 101 + c;
+// The ops fused when the config has "ops": "auto": the element-wise, broadcast and reduction ops, Softmax, LayerNorm
+// and Dropout, and the gradients of those that have gradient ops, so that the backward graph is fused as the forward.
+constexpr const char* kAutoOpsJson = R"(
+  {
+    "Add": { "versions": [13, 14] },
+    "Sub": { "versions": [13, 14] },
+    "Mul": { "versions": [13, 14] },
+    "Div": { "versions": [13, 14] },
+    "Pow": { "versions": [13, 15] },
+    "Sqrt": { "versions": [13] },
+    "Exp": { "versions": [13] },
+    "Log": { "versions": [13] },
+    "Neg": { "versions": [13] },
+    "Reciprocal": { "versions": [13] },
+    "Erf": { "versions": [13] },
+    "Tanh": { "versions": [13] },
+    "Sigmoid": { "versions": [13] },
+    "Relu": { "versions": [13, 14] },
+    "Where": { "versions": [9, 16] },
+    "Cast": { "versions": [13] },
+    "Gelu": { "domain": "com.microsoft", "versions": [1] },
+    "ReduceSum": { "versions": [13], "conditions": { "axes": "constant" } },
+    "ReduceMean": { "versions": [13, 18], "conditions": { "axes": "constant" } },
+    "ReduceMax": { "versions": [13, 18], "conditions": { "axes": "constant" } },
+    "ReduceMin": { "versions": [13, 18], "conditions": { "axes": "constant" } },
+    "Softmax": { "versions": [13], "conditions": { "axis": "-1" } },
+    "LayerNormalization": { "versions": [1, 17], "conditions": { "axis": "-1" } },
+    "Dropout": { "versions": [13] },
+    "SoftmaxGrad_13": { "domain": "com.microsoft", "versions": [1], "conditions": { "axis": "-1" } },
+    "LayerNormalizationGrad": { "domain": "com.microsoft", "versions": [1], "conditions": { "axis": "-1" } },
+    "DropoutGrad": { "domain": "com.microsoft", "versions": [1] },
+    "GeluGrad": { "domain": "com.microsoft", "versions": [1] },
+    "ReluGrad": { "domain": "com.microsoft", "versions": [1] },
+    "SigmoidGrad": { "domain": "com.microsoft", "versions": [1] },
+    "TanhGrad": { "domain": "com.microsoft", "versions": [1] }
   }
+)";
+
+// A 64-bit key of the content of the fused model, which names its compiled kernels, also in the on-disk cache of the
+// Triton module, so it must be the same in every process.
+int64_t Hash(const std::string& str) {
+  uint32_t hash[4] = {0, 0, 0, 0};
+  MurmurHash3::x86_128(str.data(), static_cast<int>(str.size()), 0, hash);
+  return static_cast<int64_t>((static_cast<uint64_t>(hash[1]) << 32) | hash[0]);
+}
+
+// Rewrites the fused model so that it only depends on its structure: the values are renamed by their position, the
+// nodes are unnamed and the symbolic dims are renamed by their order of appearance, the unknown dims getting a symbol
+// of their own. The partitions of the same pattern, e.g. in each layer of a model, then have the same model and key
+// and share their kernel, which the Triton module specializes for the dims of the inputs of each run.
+void CanonicalizeModel(ModelProto& model_proto) {
+  auto& graph = *model_proto.mutable_graph();
+  InlinedHashMap<std::string, std::string> names;
+  const auto rename = [&names](std::string& name, const char* prefix) {
+    // an empty name is a missing optional input or output
+    if (name.empty()) return;
+    auto it = names.find(name);
+    if (it == names.end()) {
+      it = names.emplace(name, prefix + std::to_string(names.size())).first;
+    }
+    name = it->second;
+  };
+
+  InlinedHashMap<std::string, std::string> dims;
+  size_t unknown_dims = 0;
+  const auto canonicalize_shape = [&dims, &unknown_dims](ValueInfoProto& value_info) {
+    if (!value_info.type().has_tensor_type() || !value_info.type().tensor_type().has_shape()) return;
+    for (auto& dim : *value_info.mutable_type()->mutable_tensor_type()->mutable_shape()->mutable_dim()) {
+      if (dim.has_dim_value()) continue;
+      if (!dim.has_dim_param()) {
+        dim.set_dim_param("u" + std::to_string(unknown_dims++));
+        continue;
+      }
+      auto it = dims.find(dim.dim_param());
+      if (it == dims.end()) {
+        it = dims.emplace(dim.dim_param(), "s" + std::to_string(dims.size())).first;
+      }
+      dim.set_dim_param(it->second);
+    }
+  };
 
-  return static_cast<int64_t>(hash);
+  for (auto& input : *graph.mutable_input()) {
+    rename(*input.mutable_name(), "i");
+    canonicalize_shape(input);
+  }
+  for (auto& initializer : *graph.mutable_initializer()) {
+    rename(*initializer.mutable_name(), "c");
+  }
+  for (auto& node : *graph.mutable_node()) {
+    node.clear_name();
+    node.clear_doc_string();
+    for (auto& input : *node.mutable_input()) {
+      rename(input, "v");
+    }
+    for (auto& output : *node.mutable_output()) {
+      rename(output, "v");
+    }
+  }
+  for (auto& output : *graph.mutable_output()) {
+    rename(*output.mutable_name(), "v");
+    canonicalize_shape(output);
+  }
+  for (auto& value_info : *graph.mutable_value_info()) {
+    rename(*value_info.mutable_name(), "v");
+    canonicalize_shape(value_info);
+  }
+  // the value infos of a graph are in no particular order
+  std::sort(graph.mutable_value_info()->begin(), graph.mutable_value_info()->end(),
+            [](const ValueInfoProto& lhs, const ValueInfoProto& rhs) { return lhs.name() < rhs.name(); });
 }
 
 bool CheckAxis(const Node& node, int64_t expected_axis) {
@@ -150,7 +253,17 @@ void from_json(const json& j, TritonFusionConfig::OpInfo& op_info) {
 TritonFusionConfig::TritonFusionConfig(std::string_view config_json) {
   const auto& config = json::parse(config_json);
   if (config.contains("ops")) {
-    ops = config.at("ops").get<std::unordered_map<std::string, OpInfo>>();
+    const auto& ops_config = config.at("ops");
+    if (ops_config.is_string() && ops_config.get<std::string>() == "auto") {
+      ops = json::parse(kAutoOpsJson).get<std::unordered_map<std::string, OpInfo>>();
+    } else {
+      ops = ops_config.get<std::unordered_map<std::string, OpInfo>>();
+    }
+  }
+  if (config.contains("exclude_ops")) {
+    for (const auto& op_type : config.at("exclude_ops").get<std::vector<std::string>>()) {
+      ops.erase(op_type);
+    }
   }
   if (config.contains("initializer")) {
     initializer = config.at("initializer").get<std::string>();
@@ -411,6 +524,7 @@ Status TritonFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, co
     sub_graph.SetOutputs(graph_const_outputs);
 
     auto model_proto = sub_model.ToProto();
+    CanonicalizeModel(model_proto);
     std::string model_str;
     model_proto.SerializeToString(&model_str);
 
@@ -18,6 +18,8 @@ struct TritonFusionConfig {
     bool ignore_min_nodes = false;
   };
 
+  // "ops" is either the map from the op types to their OpInfo or "auto" for the built-in set of the element-wise,
+  // broadcast, reduction, Softmax, LayerNorm and Dropout ops and their gradients. "exclude_ops" removes op types.
   TritonFusionConfig(std::string_view config_json = "{}");
 
   bool IsSupported(const Graph& graph, const Node& node) const;
@@ -122,6 +122,7 @@ Status SetupOptimizerParams(
   opt_graph_config.adasum_reduction_type = optimizer_config.adasum_reduction_type;
   opt_graph_config.enable_grad_norm_clip = optimizer_config.enable_grad_norm_clip;
   opt_graph_config.deepspeed_zero = optimizer_config.deepspeed_zero;
+  opt_graph_config.allreduce_bucket_size_in_bytes = optimizer_config.allreduce_bucket_size_in_bytes;
 
   // check if shared initial optimizer states have been provided
   const auto optim_state_it = init_optimizer_states.find(onnxruntime::training::SHARED_OPTIMIZER_STATES_KEY);
@@ -465,6 +466,15 @@ Status TrainingSession::ConfigureForTraining(
   ORT_RETURN_IF_ERROR(BuildGradientGraph(
       weight_names_to_train, loss_name, config.gradient_graph_config, *session_logger_));
 
+  // Replace the GEMMs of the forward and backward passes by float 8 GEMMs.
+  if (is_mixed_precision_enabled_ && config.mixed_precision_config.value().use_float8_gemms) {
+    ORT_RETURN_IF_ERROR(TransformGraphForFloat8Training(model_->MainGraph(), weight_names_to_train,
+                                                        config.mixed_precision_config.value().TensorProtoDataType(),
+                                                        config_result.float8_scaled_tensors));
+    LOGS(*session_logger_, INFO) << "Float 8 training quantizes " << config_result.float8_scaled_tensors.size()
+                                 << " tensors";
+  }
+
   if (IsRootNode(config) && config.model_with_gradient_graph_path.has_value()) {
     ORT_IGNORE_RETURN_VALUE(Save(
         config.model_with_gradient_graph_path.value(), SaveOption::NO_RELOAD));
@@ -9,6 +9,7 @@
 #include "orttraining/core/framework/pipeline.h"
 #include "orttraining/core/graph/loss_func/loss_func_common.h"
 #include "orttraining/core/graph/loss_function_registry.h"
+#include "orttraining/core/graph/mixed_precision_transformer.h"
 #include "orttraining/core/graph/optimizer_graph_output_key.h"
 #include "orttraining/core/graph/optimizer_config.h"
 #include "orttraining/core/graph/gradient_config.h"
@@ -116,6 +117,10 @@ class TrainingSession : public InferenceSession {
 
       bool layernorm_stash_as_fp32{true};
 
+      // Whether to replace the GEMMs of the training graph by float 8 GEMMs with delayed scaling.
+      // See TransformGraphForFloat8Training().
+      bool use_float8_gemms{false};
+
       ONNX_NAMESPACE::TensorProto_DataType TensorProtoDataType() const {
         switch (mixed_precision_type) {
           case MixedPrecisionDataType::FP16:
@@ -192,6 +197,9 @@ class TrainingSession : public InferenceSession {
       AdasumReductionType adasum_reduction_type{AdasumReductionType::None};
       // Whether to enable gradient clipping.
       bool enable_grad_norm_clip{true};
+      // The size of the buckets of gradients all-reduced during the backward pass, 0 for a single all-reduce
+      // after it. Only used with NCCL all-reduce.
+      int64_t allreduce_bucket_size_in_bytes{0};
     };
     // The optimizer configuration.
     // If not provided, no optimizer is added.
@@ -263,6 +271,10 @@ class TrainingSession : public InferenceSession {
     // This is only set if mixed precision is enabled.
     optional<MixedPrecisionConfigurationResult> mixed_precision_config_result;
 
+    // The tensors quantized to float 8, whose scales are fed and amaxes fetched by the caller.
+    // This is only set if float 8 GEMMs are enabled.
+    std::vector<Float8ScaledTensor> float8_scaled_tensors;
+
     struct OptimizerConfigurationResult {
       // The mapping of optimizer output key to graph output name.
       OptimizerOutputKeyMap<std::string> output_key_to_graph_output_name;
@@ -150,8 +150,14 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
       ("use_deterministic_compute", "Whether to enable deterministic compute.", cxxopts::value<bool>()->default_value("false"))
       ("use_mixed_precision", "Whether to use a mix of fp32 and fp16 arithmetic on GPU.", cxxopts::value<bool>()->default_value("false"))
       ("use_bfloat16", "Whether to use BFloat16 arithmetic on GPU.", cxxopts::value<bool>()->default_value("false"))
+      ("use_float8_gemms", "Whether to run the GEMMs in float 8 with delayed scaling on top of mixed precision. "
+        "Requires an ONNX opset 19 model and a GPU with float 8 support.", cxxopts::value<bool>()->default_value("false"))
+      ("float8_amax_history_length", "The number of steps whose amaxes the float 8 scales are computed from.",
+        cxxopts::value<int>()->default_value("1024"))
       ("enable_adasum", "Whether to use Adasum for allreduction.", cxxopts::value<bool>()->default_value("false"))
       ("allreduce_in_fp16", "Whether to do AllReduce in fp16. If false, AllReduce will be done in fp32", cxxopts::value<bool>()->default_value("true"))
+      ("allreduce_bucket_size", "The size in bytes of the buckets of gradients all-reduced during the backward pass. "
+        "0 all-reduces all the gradients after the backward pass.", cxxopts::value<int64_t>()->default_value("0"))
       ("loss_scale", "Loss scaling, positive power of 2 values can improve fp16 convergence. "
         "Set it 0 to uses dynamic scaling; Other none-zero value will used as static scale",
         cxxopts::value<float>()->default_value("0.0"))
@@ -299,6 +305,7 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
 
     params.use_nccl = flags["use_nccl"].as<bool>();
     params.enable_adasum = flags["enable_adasum"].as<bool>();
+    params.allreduce_bucket_size_in_bytes = flags["allreduce_bucket_size"].as<int64_t>();
     params.use_profiler = flags.count("use_profiler") > 0;
     ort_params.max_num_profiling_events = flags["max_profile_records"].as<size_t>();
 
@@ -335,6 +342,8 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
 
     params.use_mixed_precision = flags["use_mixed_precision"].as<bool>();
     params.use_bfloat16 = flags["use_bfloat16"].as<bool>();
+    params.use_float8_gemms = flags["use_float8_gemms"].as<bool>();
+    params.float8_amax_history_length = static_cast<size_t>(flags["float8_amax_history_length"].as<int>());
     params.allreduce_in_mixed_precision_type = flags["allreduce_in_fp16"].as<bool>() && params.use_mixed_precision;
     if (params.use_mixed_precision) {
       printf("Mixed precision training is enabled.\n");
@@ -128,8 +128,11 @@ Status TrainingRunner::Initialize() {
       mp.mixed_precision_type = MixedPrecisionDataType::BF16;
     }
     mp.layernorm_stash_as_fp32 = params_.layernorm_stash_as_fp32;
+    mp.use_float8_gemms = params_.use_float8_gemms;
     config.mixed_precision_config = mp;
   }
+  ORT_RETURN_IF(params_.use_float8_gemms && (!params_.use_mixed_precision || params_.pipeline_parallel_size > 1),
+                "Float 8 GEMMs require mixed precision and are not supported with pipeline parallelism.");
 
   // configure the loss function if no pipeline is used or it's the last stage of pipeline
   auto pipeline_stage_id = GetPipelineStageId(MPIContext::GetInstance().GetWorldRank(),
@@ -156,6 +159,7 @@ Status TrainingRunner::Initialize() {
     opt.deepspeed_zero = params_.deepspeed_zero;
     opt.adasum_reduction_type = params_.GetAdasumReductionType();
     opt.enable_grad_norm_clip = params_.enable_grad_norm_clip;
+    opt.allreduce_bucket_size_in_bytes = params_.allreduce_bucket_size_in_bytes;
     config.optimizer_config = opt;
   }
 
@@ -221,6 +225,12 @@ Status TrainingRunner::Initialize() {
     }
   }
 
+  if (!config_result.float8_scaled_tensors.empty()) {
+    float8_scaler_ = std::make_unique<Float8Scaler>(std::move(config_result.float8_scaled_tensors),
+                                                    params_.float8_amax_history_length,
+                                                    params_.float8_scaling_margin);
+  }
+
   opt_graph_outputs_ = config_result.opt_config_result.value().output_key_to_graph_output_name;
 
   // Retrieve pipeline information from configuration result.
@@ -361,6 +371,17 @@ Status TrainingRunner::PrepareFeedNamesAndFeeds(const SessionMode mode,
     }
   }
 
+  // Pick up feeds from float 8 scaling.
+  if (float8_scaler_) {
+    const auto& scaled_tensors = float8_scaler_->GetScaledTensors();
+    for (size_t i = 0; i < scaled_tensors.size(); ++i) {
+      feed_names.push_back(scaled_tensors[i].scale_input_name);
+      OrtValue scale_val;
+      TrainingUtil::CreateCpuMLScalar(float8_scaler_->GetScale(i), &scale_val, input_allocator_);
+      feeds.push_back(scale_val);
+    }
+  }
+
   // Pick up feed from learning rate schedule.
   {
     const auto name = params_.lr_params.feed_name;
@@ -523,6 +544,13 @@ Status TrainingRunner::PrepareFetchNamesAndFetches(const SessionMode mode,
     }
   }
 
+  // The amaxes of the tensors quantized to float 8 update their scales after each training step.
+  if (float8_scaler_ && mode != EvaluateStep) {
+    for (const auto& scaled_tensor : float8_scaler_->GetScaledTensors()) {
+      fetch_names.push_back(scaled_tensor.amax_output_name);
+    }
+  }
+
   // We need to fetch at least one variable.
   // If there is nothing to fetch, we fetch all model outputs.
   if (fetch_names.empty()) {
@@ -634,6 +662,8 @@ void TrainingRunner::RunWithUpdate(VectorString& feed_names,
     }
   }
 
+  UpdateFloat8Scales(fetch_names, fetches);
+
   // Assume that only the last pipeline stage can see loss, predicted value, and so on.
   // Thus, the error function should only be called when we are at the last stage.
   const bool session_can_see_loss = params_.pipeline_parallel_size == 1 ||
@@ -658,6 +688,30 @@ void TrainingRunner::RunWithUpdate(VectorString& feed_names,
   ++weight_update_step_count_;
 }
 
+void TrainingRunner::UpdateFloat8Scales(const VectorString& fetch_names, const std::vector<OrtValue>& fetches) {
+  if (!float8_scaler_) {
+    return;
+  }
+
+  const auto& scaled_tensors = float8_scaler_->GetScaledTensors();
+  for (size_t i = 0; i < scaled_tensors.size(); ++i) {
+    auto it = std::find(fetch_names.begin(), fetch_names.end(), scaled_tensors[i].amax_output_name);
+    if (it == fetch_names.end()) {
+      continue;
+    }
+    const Tensor& amax_t = fetches[static_cast<size_t>(std::distance(fetch_names.begin(), it))].Get<Tensor>();
+    float amax = 0.0f;
+    if (amax_t.Location().device.Type() == OrtDevice::CPU) {
+      amax = *amax_t.Data<float>();
+    } else {
+      Tensor cpu_amax_t(amax_t.DataType(), amax_t.Shape(), TrainingUtil::GetCpuAllocator());
+      ORT_THROW_IF_ERROR(session_.GetDataTransferManager().CopyTensor(amax_t, cpu_amax_t));
+      amax = *cpu_amax_t.Data<float>();
+    }
+    float8_scaler_->UpdateScale(i, amax);
+  }
+}
+
 // Launch async session.Run on non-main thread.
 void TrainingRunner::RunWithoutUpdate(VectorString& feed_names,
                                       VectorString& fetch_names,
@@ -728,6 +782,7 @@ void TrainingRunner::RunWithoutUpdate(VectorString& feed_names,
         fetch_names,
         &fetches);
     ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
+    UpdateFloat8Scales(fetch_names, fetches);
   }
 
   // The following variables are only read and changed by the main thread, so
@@ -1292,6 +1347,7 @@ constexpr const char* k_round = "round";
 constexpr const char* k_weight_update_step = "weight_update_step";
 constexpr const char* k_training_data_set_index = "training_data_set_index";
 constexpr const char* k_loss_scaler_state = "loss_scaler_state";
+constexpr const char* k_float8_scaler_state = "float8_scaler_state";
 }  // namespace property_names
 
 template <typename T>
@@ -1317,6 +1373,10 @@ Status TrainingRunner::SaveCheckpointProperties(
     properties[property_names::k_loss_scaler_state] = loss_scaler_->SaveToString();
   }
 
+  if (float8_scaler_) {
+    properties[property_names::k_float8_scaler_state] = float8_scaler_->SaveToString();
+  }
+
   return Status::OK();
 }
 
@@ -1342,6 +1402,12 @@ Status TrainingRunner::LoadCheckpointProperties(
     ORT_RETURN_IF_ERROR(loss_scaler_->LoadFromString(prop_it->second));
   }
 
+  if (float8_scaler_) {
+    auto prop_it = properties.find(property_names::k_float8_scaler_state);
+    ORT_RETURN_IF_NOT(prop_it != properties.end(), "prop_it == properties.end()");
+    ORT_RETURN_IF_ERROR(float8_scaler_->LoadFromString(prop_it->second));
+  }
+
   return Status::OK();
 }
 
@@ -95,6 +95,8 @@ class TrainingRunner {
     ZeROConfig deepspeed_zero{};
     // Use Adasum for allreduce.
     bool enable_adasum = false;
+    // The size of the buckets of gradients all-reduced during the backward pass, 0 for a single all-reduce.
+    int64_t allreduce_bucket_size_in_bytes = 0;
     // Use Gist on CPU.
     bool use_gist = false;
     // Whether we collect execution profile trace during this run.
@@ -112,6 +114,12 @@ class TrainingRunner {
     bool use_mixed_precision_initializer = true;
     bool allreduce_in_mixed_precision_type = false;
     bool layernorm_stash_as_fp32 = true;
+    // Whether to run the GEMMs in float 8 with delayed scaling, on top of mixed precision.
+    bool use_float8_gemms = false;
+    // The number of steps whose amaxes the float 8 scale of a tensor is computed from.
+    size_t float8_amax_history_length = 1024;
+    // The float 8 scales are multiplied by 2^margin, leaving headroom to tensors growing from step to step.
+    int float8_scaling_margin = 0;
 
     // GIST configuration
     struct GistConfiguration {
@@ -246,6 +254,8 @@ class TrainingRunner {
                         std::vector<OrtValue>& feeds,
                         size_t& gradient_accumulation_step_count);
   void CheckWorkerException(const std::exception_ptr& p);
+  // Records the amaxes of the tensors quantized to float 8 fetched by a training step.
+  void UpdateFloat8Scales(const VectorString& fetch_names, const std::vector<OrtValue>& fetches);
   Status TrainingLoop(IDataLoader& training_data_loader, IDataLoader* test_data_loader,
                       const MapStringToString& mapped_dimensions);
   Status Evaluate(TrainingSession& session, IDataLoader& data_loader);
@@ -268,6 +278,7 @@ class TrainingRunner {
   OptimizerOutputKeyMap<std::string> opt_graph_outputs_;
 
   std::unique_ptr<LossScaler> loss_scaler_ = nullptr;
+  std::unique_ptr<Float8Scaler> float8_scaler_ = nullptr;
 
   Parameters params_;
   const SessionOptions session_options_;
@@ -3,6 +3,8 @@
 
 #include "orttraining/models/runner/training_util.h"
 
+#include <algorithm>
+#include <cmath>
 #include <sstream>
 #include <random>
 #include "constant.h"
@@ -213,6 +215,58 @@ Status LossScaler::LoadFromString(const std::string& input) {
   return Status::OK();
 }
 
+void Float8Scaler::UpdateScale(size_t index, float amax) {
+  // a step overflowing in mixed precision is skipped, its amax is not recorded
+  if (!std::isfinite(amax)) {
+    return;
+  }
+
+  auto& amax_history = amax_histories_[index];
+  if (amax_history.amaxes.size() < amax_history_length_) {
+    amax_history.amaxes.push_back(amax);
+  } else {
+    amax_history.amaxes[amax_history.next] = amax;
+    amax_history.next = (amax_history.next + 1) % amax_history_length_;
+  }
+
+  const float max_amax = *std::max_element(amax_history.amaxes.begin(), amax_history.amaxes.end());
+  if (max_amax > 0.0f) {
+    const float float8_max = scaled_tensors_[index].float8_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E5M2
+                                 ? 57344.0f
+                                 : 448.0f;
+    scales_[index] = std::ldexp(max_amax / float8_max, margin_);
+  }
+}
+
+std::string Float8Scaler::SaveToString() const {
+  std::ostringstream s{};
+  for (size_t i = 0; i < scaled_tensors_.size(); ++i) {
+    const auto& amax_history = amax_histories_[i];
+    s << (i > 0 ? " " : "") << scales_[i] << " " << amax_history.next << " " << amax_history.amaxes.size();
+    for (const float amax : amax_history.amaxes) {
+      s << " " << amax;
+    }
+  }
+  return s.str();
+}
+
+Status Float8Scaler::LoadFromString(const std::string& input) {
+  std::istringstream s{input};
+  for (size_t i = 0; i < scaled_tensors_.size(); ++i) {
+    auto& amax_history = amax_histories_[i];
+    size_t history_size = 0;
+    ORT_RETURN_IF_NOT((s >> scales_[i] >> amax_history.next >> history_size) &&
+                          history_size <= amax_history_length_ && amax_history.next < amax_history_length_,
+                      "Failed to read the float 8 scale of ", scaled_tensors_[i].tensor_name);
+    amax_history.amaxes.resize(history_size);
+    for (auto& amax : amax_history.amaxes) {
+      ORT_RETURN_IF_NOT(s >> amax, "Failed to read the amax history of ", scaled_tensors_[i].tensor_name);
+    }
+  }
+  ORT_RETURN_IF_NOT((s >> std::ws).eof(), "Unexpected data after the float 8 scaler state.");
+  return Status::OK();
+}
+
 std::unique_ptr<LearningRateScheduler> LearningRateScheduler::Create(LearningRateParameters& lr_params, size_t training_step_count) {
   if (lr_params.warmup_mode == LRSchedule_NoWarmup) {
     return std::make_unique<NoWarmpScheduler>(lr_params, training_step_count);
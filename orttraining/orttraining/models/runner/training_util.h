@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <algorithm>
 #include <vector>
 #include <math.h>
 #include "constant.h"
@@ -9,6 +10,7 @@
 #include "core/framework/ort_value.h"
 #include "core/framework/framework_common.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
+#include "orttraining/core/graph/mixed_precision_transformer.h"
 
 #define RETURN_IF_FAIL(expr)                                \
   do {                                                      \
@@ -232,6 +234,49 @@ class LossScaler {
   size_t stable_steps_;
 };
 
+// Delayed scaling of the tensors quantized to float 8: the scale of a tensor in a step is computed from the amaxes of
+// the tensor in the previous steps, the maximum of its amax history mapping to the largest float 8 value divided by
+// 2^margin.
+class Float8Scaler {
+ public:
+  Float8Scaler(std::vector<Float8ScaledTensor> scaled_tensors,
+               size_t amax_history_length = 1024,
+               int margin = 0)
+      : scaled_tensors_(std::move(scaled_tensors)),
+        amax_history_length_(amax_history_length),
+        margin_(margin),
+        scales_(scaled_tensors_.size(), 1.0f),
+        amax_histories_(scaled_tensors_.size()){};
+
+  const std::vector<Float8ScaledTensor>& GetScaledTensors() const { return scaled_tensors_; }
+
+  float GetScale(size_t index) const { return scales_[index]; }
+
+  // Records the amax of the tensor at index in this step and updates its scale.
+  void UpdateScale(size_t index, float amax);
+
+  void Reset() {
+    std::fill(scales_.begin(), scales_.end(), 1.0f);
+    amax_histories_.assign(scaled_tensors_.size(), {});
+  }
+
+  // for checkpointing
+  std::string SaveToString() const;
+  Status LoadFromString(const std::string& input);
+
+ private:
+  const std::vector<Float8ScaledTensor> scaled_tensors_;
+  const size_t amax_history_length_;
+  const int margin_;
+  std::vector<float> scales_;
+  // the last amax_history_length_ amaxes of a tensor, next being the index of the oldest once it is full
+  struct AmaxHistory {
+    std::vector<float> amaxes;
+    size_t next{0};
+  };
+  std::vector<AmaxHistory> amax_histories_;
+};
+
 class LearningRateScheduler {
  public:
   LearningRateScheduler(LearningRateParameters& lr_params, size_t training_step_count)
@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "orttraining/core/framework/pipeline.h"
 #include "orttraining/core/framework/distributed_run_context.h"
@@ -112,5 +115,94 @@ TEST(Pipeline, ScheduleB5S3) {
   TestPipelineScheduler(num_batches, num_stages, baseline_events);
 }
 
+// Runs the interleaved 1F1B schedule in rounds, in each of which a stage runs its next computation if the
+// computations it depends on ran in an earlier round, and checks that it completes and that each stage holds at most
+// max_in_flight[s] activations.
+void TestInterleaved1F1BSchedule(const int num_batches, const int num_stages, const int num_chunks,
+                                 const std::vector<int>& max_in_flight) {
+  using onnxruntime::training::pipeline::PipelineComputeTask;
+  using Pass = onnxruntime::training::pipeline::PipelineTask::Pass;
+  const auto schedule = onnxruntime::training::pipeline::CreateInterleaved1F1BSchedule(num_batches, num_stages,
+                                                                                       num_chunks);
+  ASSERT_EQ(schedule.size(), static_cast<size_t>(num_stages));
+
+  // the round in which the pass of a micro-batch ran through a chunk of a stage, -1 before.
+  std::vector<int> rounds(2 * num_batches * num_chunks * num_stages, -1);
+  const auto round = [&](int batch, int chunk, int stage, Pass pass) -> int& {
+    return rounds[((batch * num_chunks + chunk) * num_stages + stage) * 2 + (pass == Pass::Forward ? 0 : 1)];
+  };
+  const auto is_ready = [&](const PipelineComputeTask& task, int stage, int current_round) {
+    const auto ran = [&](int chunk, int s, Pass pass) {
+      const int r = round(task.batch, chunk, s, pass);
+      return r >= 0 && r < current_round;
+    };
+    if (task.pass == Pass::Forward) {
+      return stage > 0 ? ran(task.chunk, stage - 1, Pass::Forward)
+                       : task.chunk == 0 || ran(task.chunk - 1, num_stages - 1, Pass::Forward);
+    }
+    if (!ran(task.chunk, stage, Pass::Forward)) {
+      return false;
+    }
+    return stage < num_stages - 1 ? ran(task.chunk, stage + 1, Pass::Backward)
+                                  : task.chunk == num_chunks - 1 || ran(task.chunk + 1, 0, Pass::Backward);
+  };
+
+  std::vector<size_t> next(num_stages, 0);
+  std::vector<int> in_flight(num_stages, 0);
+  std::vector<int> observed_max_in_flight(num_stages, 0);
+  for (int current_round = 0;; ++current_round) {
+    bool done = true;
+    bool progressed = false;
+    for (int s = 0; s < num_stages; ++s) {
+      const auto& order = schedule[s];
+      ASSERT_EQ(order.size(), static_cast<size_t>(2 * num_batches * num_chunks));
+      if (next[s] == order.size()) {
+        continue;
+      }
+      done = false;
+      const auto& task = order[next[s]];
+      if (!is_ready(task, s, current_round)) {
+        continue;
+      }
+      int& task_round = round(task.batch, task.chunk, s, task.pass);
+      ASSERT_EQ(task_round, -1) << "Stage " << s << " runs micro-batch " << task.batch << " twice.";
+      task_round = current_round;
+      in_flight[s] += task.pass == Pass::Forward ? 1 : -1;
+      observed_max_in_flight[s] = std::max(observed_max_in_flight[s], in_flight[s]);
+      ++next[s];
+      progressed = true;
+    }
+    if (done) {
+      break;
+    }
+    ASSERT_TRUE(progressed) << "The schedule deadlocks in round " << current_round << ".";
+  }
+  EXPECT_EQ(observed_max_in_flight, max_in_flight);
+}
+
+TEST(Pipeline, Interleaved1F1BScheduleB8S4) {
+  // without interleaving, stage s holds the activations of num_stages - s micro-batches.
+  TestInterleaved1F1BSchedule(8, 4, 1, {4, 3, 2, 1});
+}
+
+TEST(Pipeline, Interleaved1F1BScheduleB2S4) {
+  // fewer micro-batches than stages.
+  TestInterleaved1F1BSchedule(2, 4, 1, {2, 2, 2, 1});
+}
+
+TEST(Pipeline, Interleaved1F1BScheduleB8S4C2) {
+  TestInterleaved1F1BSchedule(8, 4, 2, {11, 9, 7, 5});
+}
+
+TEST(Pipeline, Interleaved1F1BScheduleB12S3C3) {
+  TestInterleaved1F1BSchedule(12, 3, 3, {11, 9, 7});
+}
+
+TEST(Pipeline, Interleaved1F1BScheduleInvalid) {
+  // the micro-batches must be grouped by stages to interleave.
+  EXPECT_THROW(onnxruntime::training::pipeline::CreateInterleaved1F1BSchedule(6, 4, 2), std::invalid_argument);
+  EXPECT_THROW(onnxruntime::training::pipeline::CreateInterleaved1F1BSchedule(0, 4, 1), std::invalid_argument);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
\ No newline at end of file
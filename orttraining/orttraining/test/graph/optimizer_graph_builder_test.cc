@@ -12,6 +12,7 @@
 
 #include "core/common/common.h"
 #include "core/common/span_utils.h"
+#include "core/framework/session_options.h"
 #include "core/graph/graph.h"
 #include "core/graph/model.h"
 #include "orttraining/core/graph/gradient_builder_base.h"
@@ -478,6 +479,26 @@ TEST_F(OptimizerGraphBuilderTest, Allreduce_WithGradientAccumulation_WithMixedPr
   TestAllreduceOptimizerGraphBuilder(config, graph_);
 }
 
+TEST_F(OptimizerGraphBuilderTest, Allreduce_BucketedGradients) {
+  OptimizerGraphConfig config;
+  config.data_parallel_group_size = 4;
+  config.use_nccl = true;
+  config.gradient_accumulation_steps = 10;
+  // each gradient has one float
+  config.allreduce_bucket_size_in_bytes = sizeof(float);
+  TestAllreduceOptimizerGraphBuilder(config, graph_);
+
+  // each gradient is all-reduced on its own
+  auto op_counts = CountOpsInGraph(graph_, false);
+  ASSERT_EQ(GetOpCount(op_counts, k_all_reduce_op_name), k_weight_names.size());
+  for (const auto& node : graph_.Nodes()) {
+    if (node.OpType() == k_all_reduce_op_name) {
+      ASSERT_EQ(node.InputDefs().size(), 1U);
+      ASSERT_EQ(node.Priority(), static_cast<int>(ExecutionPriority::LOCAL_HIGH));
+    }
+  }
+}
+
 static void TestZeROOptimizerGraphBuilder(OptimizerGraphConfig config, Graph& graph) {
   std::unordered_map<std::string, std::string> updated_weight_names_map;
   std::unordered_map<std::string, training::TrainingSession::PartitionInfo> weight_partition_info;
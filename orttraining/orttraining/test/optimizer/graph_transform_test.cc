@@ -26,6 +26,7 @@
 #include "orttraining/test/optimizer/horizontal_parallel_test_utils.h"
 #include "orttraining/core/session/training_session.h"
 #include "orttraining/core/optimizer/loss_rewriter.h"
+#include "orttraining/core/graph/mixed_precision_transformer.h"
 #include "orttraining/core/optimizer/bias_softmax_dropout_fusion.h"
 #include "orttraining/core/optimizer/qdq_fusion.h"
 #include "orttraining/core/optimizer/scaled_sum_fusion.h"
@@ -1723,6 +1724,74 @@ TEST_F(GraphTransformationTests, ScaledSumFusionTwoInputs) {
 // end of DISABLE_CONTRIB_OPS
 #endif
 
+TEST_F(GraphTransformationTests, Float8Training) {
+  Model model("Float8Training", true, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{"", 19}, {"com.microsoft", 1}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  const auto make_type = [](int64_t rows, int64_t cols) {
+    TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BFLOAT16);
+    type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(rows);
+    type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(cols);
+    return type;
+  };
+  const TypeProto x_type = make_type(16, 32);
+  const TypeProto w_type = make_type(32, 16);
+  const TypeProto y_type = make_type(16, 16);
+  const TypeProto odd_w_type = make_type(32, 24);
+  const TypeProto odd_y_type = make_type(16, 24);
+
+  // Y = X * W and its gradients dX = dY * W' and dW = X' * dY, and a GEMM whose N isn't a multiple of 16
+  auto& x = graph.GetOrCreateNodeArg("X", &x_type);
+  auto& w = graph.GetOrCreateNodeArg("W", &w_type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &y_type);
+  auto& y_grad = graph.GetOrCreateNodeArg("Y_grad", &y_type);
+  auto& x_grad = graph.GetOrCreateNodeArg("X_grad", &x_type);
+  auto& w_grad = graph.GetOrCreateNodeArg("W_grad", &w_type);
+  auto& odd_w = graph.GetOrCreateNodeArg("OddW", &odd_w_type);
+  auto& odd_y = graph.GetOrCreateNodeArg("OddY", &odd_y_type);
+  graph.AddNode("matmul", "MatMul", "", {&x, &w}, {&y});
+  graph.AddNode("x_grad", "Gemm", "", {&y_grad, &w}, {&x_grad}).AddAttribute("transB", int64_t(1));
+  graph.AddNode("w_grad", "Gemm", "", {&x, &y_grad}, {&w_grad}).AddAttribute("transA", int64_t(1));
+  graph.AddNode("odd_matmul", "MatMul", "", {&x, &odd_w}, {&odd_y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::vector<training::Float8ScaledTensor> scaled_tensors;
+  ASSERT_STATUS_OK(training::TransformGraphForFloat8Training(graph, {}, TensorProto_DataType_BFLOAT16,
+                                                             scaled_tensors));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["com.microsoft.GemmFloat8"], 3);
+  ASSERT_EQ(op_to_count["Gemm"], 0);
+  ASSERT_EQ(op_to_count["MatMul"], 1);
+  // W is transposed for Y, X and dY for dW
+  ASSERT_EQ(op_to_count["Transpose"], 3);
+
+  ASSERT_EQ(scaled_tensors.size(), 3u);
+  std::map<std::string, training::Float8ScaledTensor> scaled_tensors_by_name;
+  for (const auto& scaled_tensor : scaled_tensors) {
+    scaled_tensors_by_name.emplace(scaled_tensor.tensor_name, scaled_tensor);
+    ASSERT_NE(std::find(graph.GetInputs().begin(), graph.GetInputs().end(),
+                        graph.GetNodeArg(scaled_tensor.scale_input_name)),
+              graph.GetInputs().end());
+    ASSERT_NE(std::find(graph.GetOutputs().begin(), graph.GetOutputs().end(),
+                        graph.GetNodeArg(scaled_tensor.amax_output_name)),
+              graph.GetOutputs().end());
+  }
+  ASSERT_EQ(scaled_tensors_by_name.at("X").float8_type, TensorProto_DataType_FLOAT8E4M3FN);
+  ASSERT_EQ(scaled_tensors_by_name.at("W").float8_type, TensorProto_DataType_FLOAT8E4M3FN);
+  ASSERT_EQ(scaled_tensors_by_name.at("Y_grad").float8_type, TensorProto_DataType_FLOAT8E5M2);
+
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == "GemmFloat8") {
+      ASSERT_EQ(node.GetAttributes().at("transA").i(), 0);
+      ASSERT_EQ(node.GetAttributes().at("transB").i(), 1);
+      ASSERT_EQ(node.GetAttributes().at("dtype").i(), TensorProto_DataType_BFLOAT16);
+    }
+  }
+}
+
 #ifdef ENABLE_TRITON
 TEST_F(GraphTransformationTests, TritonFusion) {
   auto model_uri = MODEL_FOLDER "bert_toy_opset14.onnx";
@@ -1897,6 +1966,69 @@ TEST_F(GraphTransformationTests, TritonFusion) {
     ASSERT_TRUE(op_to_count["com.microsoft.TritonOp"] == 10);
   }
 }
+
+TEST_F(GraphTransformationTests, TritonFusion_AutoOps) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    // Two forward chains of the same pattern with different symbolic dims, and a backward chain.
+    for (const auto& dim_prefix : {"batch", "other_batch"}) {
+      const std::string batch_dim = dim_prefix;
+      auto* input_arg = builder.MakeSymbolicInput<float>({batch_dim, batch_dim + "_seq", 64});
+      auto* scale_arg = builder.MakeScalarInitializer<float>(0.125f);
+      auto* mul_out = builder.MakeIntermediate();
+      auto* softmax_out = builder.MakeIntermediate();
+      auto* dropout_out = builder.MakeOutput();
+      auto* mask_out = builder.MakeIntermediate();
+      builder.AddNode("Mul", {input_arg, scale_arg}, {mul_out});
+      builder.AddNode("Softmax", {mul_out}, {softmax_out}).AddAttribute("axis", static_cast<int64_t>(-1));
+      builder.AddNode("Dropout", {softmax_out}, {dropout_out, mask_out});
+    }
+
+    auto* dy_arg = builder.MakeSymbolicInput<float>({std::string("batch"), 64});
+    auto* y_arg = builder.MakeSymbolicInput<float>({std::string("batch"), 64});
+    auto* scale_arg = builder.MakeScalarInitializer<float>(0.125f);
+    auto* softmax_grad_out = builder.MakeIntermediate();
+    auto* dx_out = builder.MakeOutput();
+    builder.AddNode("SoftmaxGrad_13", {dy_arg, y_arg}, {softmax_grad_out}, kMSDomain)
+        .AddAttribute("axis", static_cast<int64_t>(-1));
+    builder.AddNode("Mul", {softmax_grad_out, scale_arg}, {dx_out});
+  };
+
+  auto pre_graph_checker = [](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Softmax"] == 2);
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["com.microsoft.SoftmaxGrad_13"] == 1);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["Mul"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Softmax"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Dropout"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.SoftmaxGrad_13"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.TritonOp"] == 3);
+
+    // the forward chains only differ by their names and symbols, so they share their model and kernel
+    std::vector<std::pair<int64_t, std::string>> forward_ops;
+    int64_t backward_key = 0;
+    for (auto& node : graph.Nodes()) {
+      const auto& attrs = node.GetAttributes();
+      if (node.OutputDefs().size() == 2) {
+        forward_ops.emplace_back(attrs.at("onnx_key").i(), attrs.at("onnx_string").s());
+      } else {
+        backward_key = attrs.at("onnx_key").i();
+      }
+    }
+    TEST_RETURN_IF_NOT(forward_ops.size() == 2);
+    TEST_RETURN_IF_NOT(forward_ops[0] == forward_ops[1]);
+    TEST_RETURN_IF_NOT(forward_ops[0].first != backward_key);
+    return Status::OK();
+  };
+
+  const char* config = R"({ "ops": "auto", "initializer": "scalar", "min_nodes": 2 })";
+  std::unique_ptr<GraphTransformer> transformer = std::make_unique<TritonFusion>(config);
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::move(transformer), TransformerLevel::Level1,
+                                        1, pre_graph_checker, post_graph_checker));
+}
 #endif
 
 }  // namespace test
@@ -26,6 +26,7 @@
 #include "test/capturing_sink.h"
 #include "test/test_environment.h"
 #include "test/util/include/asserts.h"
+#include "orttraining/core/optimizer/memory_optimizer/activation_offload.h"
 #include "orttraining/core/optimizer/memory_optimizer/common.h"
 #include "orttraining/core/optimizer/memory_optimizer/memory_optimizer.h"
 #include "orttraining/core/optimizer/memory_optimizer/memory_insight.h"
@@ -92,6 +93,22 @@ TEST(MemoryOptimizerTests, GeluRecompute) {
   ASSERT_EQ(original_gelu_node->Priority(), static_cast<int>(ExecutionPriority::DEFAULT));
 }
 
+TEST(MemoryOptimizerTests, ParseMemoryBudgetConfig) {
+  optimizer::memory_optimizer::MemoryBudgetConfig budget_config;
+  ASSERT_STATUS_OK(optimizer::memory_optimizer::ParseMemoryBudgetConfigFromString("", budget_config));
+  ASSERT_EQ(budget_config.budget_in_bytes, -1);
+
+  ASSERT_STATUS_OK(
+      optimizer::memory_optimizer::ParseMemoryBudgetConfigFromString("1073741824:batch=8,seq_len=512", budget_config));
+  ASSERT_EQ(budget_config.budget_in_bytes, 1073741824);
+  ASSERT_EQ(budget_config.dim_values.size(), 2u);
+  ASSERT_EQ(budget_config.dim_values["batch"], 8);
+  ASSERT_EQ(budget_config.dim_values["seq_len"], 512);
+
+  ASSERT_STATUS_NOT_OK(optimizer::memory_optimizer::ParseMemoryBudgetConfigFromString("1GB", budget_config));
+  ASSERT_STATUS_NOT_OK(optimizer::memory_optimizer::ParseMemoryBudgetConfigFromString("1024:batch", budget_config));
+}
+
 TEST(MemoryOptimizerTests, TileRecompute) {
   const logging::Logger* logger = &logging::LoggingManager::DefaultLogger();
   auto model_uri = MODEL_FOLDER "recompute_tile.onnx";
@@ -312,5 +329,58 @@ TEST(MemoryOptimizerTests, TransformerPerLayerRecompute) {
   }
 }
 
+TEST(MemoryOptimizerTests, ActivationOffload) {
+  const logging::Logger* logger = &logging::LoggingManager::DefaultLogger();
+  Model model("ActivationOffload", true, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{"", 14}, {"com.microsoft", 1}}, {}, *logger);
+  Graph& graph = model.MainGraph();
+
+  TypeProto tensor_type;
+  tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(512);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(512);
+
+  // The activation of Relu is stashed for ReluGrad across the YieldOp.
+  auto& x = graph.GetOrCreateNodeArg("x", &tensor_type);
+  auto& activation = graph.GetOrCreateNodeArg("activation", &tensor_type);
+  auto& activation_grad = graph.GetOrCreateNodeArg("activation_grad", &tensor_type);
+  auto& x_grad = graph.GetOrCreateNodeArg("x_grad", &tensor_type);
+  graph.AddNode("relu", "Relu", "", {&x}, {&activation});
+  Node& yield_node = graph.AddNode("yield", "YieldOp", "", {&activation}, {&activation_grad}, nullptr, kMSDomain);
+  yield_node.AddAttribute("full_shape_outputs", std::vector<int64_t>{0});
+  graph.AddNode("relu_grad", "ReluGrad", "", {&activation_grad, &activation}, {&x_grad}, nullptr, kMSDomain);
+  ASSERT_STATUS_OK(graph.Resolve());
+  for (auto& node : graph.Nodes()) {
+    node.SetExecutionProviderType(kCudaExecutionProvider);
+  }
+
+  // The activation is 1MB, smaller than the minimum size of the first transformer.
+  for (const std::string offload_config : {"2097152", "1048576"}) {
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{1};
+    ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<ActivationOffload>(offload_config),
+                                                       TransformerLevel::Level3));
+    ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level3, *logger));
+  }
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["MemcpyToHost"], 1);
+  ASSERT_EQ(op_to_count["MemcpyFromHost"], 1);
+
+  const Node* relu_grad_node = graph.GetProducerNode("x_grad");
+  ASSERT_TRUE(relu_grad_node != nullptr);
+  const Node* prefetch_node = graph.GetProducerNode(relu_grad_node->InputDefs()[1]->Name());
+  ASSERT_TRUE(prefetch_node != nullptr);
+  ASSERT_EQ(prefetch_node->OpType(), "MemcpyFromHost");
+  ASSERT_EQ(prefetch_node->Priority(), static_cast<int>(ExecutionPriority::LOCAL_LOW));
+  ASSERT_EQ(prefetch_node->GetExecutionProviderType(), kCudaExecutionProvider);
+  const Node* offload_node = graph.GetProducerNode(prefetch_node->InputDefs()[0]->Name());
+  ASSERT_TRUE(offload_node != nullptr);
+  ASSERT_EQ(offload_node->OpType(), "MemcpyToHost");
+  ASSERT_EQ(offload_node->InputDefs()[0]->Name(), "activation");
+
+  // The forward consumer still uses the activation.
+  ASSERT_EQ(yield_node.InputDefs()[0]->Name(), "activation");
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <array>
 #include <unordered_map>
 #include <vector>
 
@@ -16,6 +17,7 @@
 #include "core/framework/tensorprotoutils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
+#include "core/platform/env.h"
 #include "core/platform/path_lib.h"
 
 #include "orttraining/core/framework/checkpoint_common.h"
@@ -435,4 +437,83 @@ TEST(CheckpointApiTest, SaveCustomPropertyAsCheckpoint_ThenLoad_CPU) {
   std::string restored_s_data = restored_property_bag.GetProperty<std::string>(s_property_name);
   ASSERT_EQ(s_data, restored_s_data);
 }
+
+/**
+ * Save a checkpoint then an incremental checkpoint in the background while the states are updated,
+ * Then load them, copied and mapped into memory, compare with the states at the time of each save.
+ */
+TEST(CheckpointApiTest, SaveIncrementalCheckpointAsync_ThenLoad_CPU) {
+  CheckpointState checkpoint_state;
+  checkpoint_state.module_checkpoint_state.train_session_data_transfer_mgr = nullptr;
+  checkpoint_state.optimizer_checkpoint_state.optimizer_session_data_transfer_mgr = nullptr;
+
+  OrtValue trainable, frozen, momentum;
+  GenerateRandomInput(std::array<int64_t, 2>{4, 8}, trainable);
+  GenerateRandomInput(std::array<int64_t, 2>{64, 8}, frozen);
+  GenerateRandomInput(std::array<int64_t, 2>{4, 8}, momentum);
+  auto& named_parameters = checkpoint_state.module_checkpoint_state.named_parameters;
+  named_parameters.emplace("trainable", std::make_shared<Parameter>("trainable", trainable, true));
+  named_parameters.emplace("frozen", std::make_shared<Parameter>("frozen", frozen, false));
+  auto group_state = std::make_shared<GroupOptimizerState>();
+  group_state->step = 1;
+  group_state->param_named_optimizer_states["trainable"].emplace("momentum0", momentum);
+  checkpoint_state.optimizer_checkpoint_state.group_named_optimizer_states.emplace("group0", group_state);
+  checkpoint_state.property_bag.AddProperty("epoch", static_cast<int64_t>(1));
+
+  auto ckpt_test_root_dir = ORT_TSTR("checkpointing_api_test_dir");
+  TemporaryDirectory tmp_dir{ckpt_test_root_dir};
+  PathString full_checkpoint_path{ConcatPathComponent(tmp_dir.Path(), ORT_TSTR("full_ckpt"))};
+  PathString incremental_checkpoint_path{ConcatPathComponent(tmp_dir.Path(), ORT_TSTR("incremental_ckpt"))};
+
+  std::vector<float> trainable_before_update;
+  CpuOrtValueToVec(trainable, trainable_before_update);
+
+  CheckpointWriter writer;
+  // the first checkpoint of the writer is full
+  ASSERT_STATUS_OK(writer.SaveAsync(checkpoint_state, full_checkpoint_path, true, true));
+  // the states can be updated while the checkpoint is written
+  trainable.GetMutable<Tensor>()->MutableData<float>()[0] += 1.0f;
+  group_state->step = 2;
+  checkpoint_state.property_bag.AddProperty("epoch", static_cast<int64_t>(2));
+  ASSERT_STATUS_OK(writer.SaveAsync(checkpoint_state, incremental_checkpoint_path, true, true));
+  ASSERT_STATUS_OK(writer.Wait());
+
+  // the incremental checkpoint has neither the frozen parameter nor the momentum
+  size_t full_checkpoint_size = 0, incremental_checkpoint_size = 0;
+  ASSERT_STATUS_OK(Env::Default().GetFileLength(full_checkpoint_path.c_str(), full_checkpoint_size));
+  ASSERT_STATUS_OK(Env::Default().GetFileLength(incremental_checkpoint_path.c_str(), incremental_checkpoint_size));
+  ASSERT_LT(incremental_checkpoint_size + 64 * 8 * sizeof(float), full_checkpoint_size);
+
+  for (const bool map_tensors : {false, true}) {
+    CheckpointState full_state;
+    ASSERT_STATUS_OK(LoadCheckpoint(full_checkpoint_path, full_state, map_tensors));
+    std::vector<float> restored;
+    CpuOrtValueToVec(full_state.module_checkpoint_state.named_parameters.at("trainable")->Data(), restored);
+    ASSERT_EQ(restored, trainable_before_update);
+    ASSERT_EQ(full_state.optimizer_checkpoint_state.group_named_optimizer_states.at("group0")->step, 1);
+
+    CheckpointState incremental_state;
+    ASSERT_STATUS_OK(LoadCheckpoint(incremental_checkpoint_path, incremental_state, map_tensors));
+    const auto& restored_parameters = incremental_state.module_checkpoint_state.named_parameters;
+    ASSERT_EQ(restored_parameters.size(), 2U);
+    for (const auto& [name, param] : named_parameters) {
+      std::vector<float> expected;
+      CpuOrtValueToVec(param->Data(), expected);
+      CpuOrtValueToVec(restored_parameters.at(name)->Data(), restored);
+      ASSERT_EQ(restored, expected);
+      ASSERT_EQ(restored_parameters.at(name)->RequiresGrad(), param->RequiresGrad());
+    }
+
+    const auto& restored_group_state =
+        incremental_state.optimizer_checkpoint_state.group_named_optimizer_states.at("group0");
+    ASSERT_EQ(restored_group_state->step, 2);
+    std::vector<float> expected_momentum;
+    CpuOrtValueToVec(momentum, expected_momentum);
+    CpuOrtValueToVec(restored_group_state->param_named_optimizer_states.at("trainable").at("momentum0"), restored);
+    ASSERT_EQ(restored, expected_momentum);
+
+    ASSERT_EQ(incremental_state.property_bag.size(), 1U);
+    ASSERT_EQ(incremental_state.property_bag.GetProperty<int64_t>("epoch"), 2);
+  }
+}
 }  // namespace onnxruntime::training::test
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <array>
 #include <thread>
 
 #include "gtest/gtest.h"
@@ -537,6 +538,131 @@ TEST(TrainingApiTest, OptimStep) {
   }
 }
 
+
+TEST(TrainingApiTest, FusedOptimizerStep) {
+  auto model_uri = MODEL_FOLDER "training_model.onnx";
+  auto optim_uri = MODEL_FOLDER "adamw.onnx";
+  auto checkpoint_to_load_path = MODEL_FOLDER "checkpoint.ckpt";
+
+  std::unique_ptr<Environment> env;
+  ASSERT_STATUS_OK(Environment::Create(nullptr, env));
+  std::vector<std::shared_ptr<IExecutionProvider>> providers;
+  auto model_identifier = ModelIdentifiers(onnxruntime::ToUTF8String(model_uri),
+                                           std::nullopt,
+                                           std::optional<std::string>(onnxruntime::ToUTF8String(optim_uri)));
+
+  OrtValue input, target;
+  GenerateRandomInput(std::array<int64_t, 2>{2, 784}, input);
+  target = onnxruntime::test::CreateInputOrtValueOnCPU<int32_t>(
+      std::array<int64_t, 1>{2}, std::vector<int32_t>(2, 1));
+  const std::vector<OrtValue> inputs{input, target};
+  constexpr int step_count = 4;
+
+  // the parameters after training with the optimizer step fused into the train step or not
+  const auto train = [&](bool fused, std::unordered_map<std::string, std::vector<float>>& params) {
+    onnxruntime::training::api::CheckpointState state;
+    ASSERT_STATUS_OK(onnxruntime::training::api::LoadCheckpoint(checkpoint_to_load_path, state));
+    onnxruntime::SessionOptions session_option;
+    if (fused) {
+      ASSERT_STATUS_OK(session_option.config_options.AddConfigEntry(FUSED_OPTIMIZER_STEP_CONFIG, "1"));
+    }
+    auto model = std::make_unique<onnxruntime::training::api::Module>(
+        model_identifier, &state, session_option, *env, providers);
+    auto optim = std::make_unique<onnxruntime::training::api::Optimizer>(
+        model_identifier, &state, session_option, *env, providers);
+
+    for (int step = 0; step < step_count; ++step) {
+      std::vector<OrtValue> fetches;
+      ASSERT_STATUS_OK(model->TrainStep(inputs, fetches));
+      ASSERT_EQ(fetches.size(), model->GetTrainingModelOutputCount());
+      ASSERT_STATUS_OK(optim->Step());
+      ASSERT_STATUS_OK(model->LazyResetGrad());
+    }
+
+    for (const auto& [name, param] : model->NamedParameters()) {
+      if (param->RequiresGrad()) {
+        // no gradient buffer with the fused optimizer step
+        ASSERT_EQ(param->Gradient().IsAllocated(), !fused);
+        CpuOrtValueToVec(param->Data(), params[name]);
+      }
+    }
+  };
+
+  std::unordered_map<std::string, std::vector<float>> params, fused_params;
+  train(false, params);
+  train(true, fused_params);
+  ASSERT_EQ(fused_params.size(), params.size());
+  for (const auto& [name, values] : params) {
+    const auto& fused_values = fused_params.at(name);
+    ASSERT_EQ(fused_values.size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      ASSERT_NEAR(fused_values[i], values[i], 1e-5f) << name << "[" << i << "]";
+    }
+  }
+
+  // the Optimizer holds the states the fused train step uses
+  onnxruntime::training::api::CheckpointState state;
+  ASSERT_STATUS_OK(onnxruntime::training::api::LoadCheckpoint(checkpoint_to_load_path, state));
+  state.optimizer_checkpoint_state.group_named_optimizer_states.clear();
+  onnxruntime::SessionOptions session_option;
+  ASSERT_STATUS_OK(session_option.config_options.AddConfigEntry(FUSED_OPTIMIZER_STEP_CONFIG, "1"));
+  auto model = std::make_unique<onnxruntime::training::api::Module>(
+      model_identifier, &state, session_option, *env, providers);
+  std::vector<OrtValue> fetches;
+  ASSERT_FALSE(model->TrainStep(inputs, fetches).IsOK());
+}
+
+TEST(TrainingApiTest, OptimizerStateShard) {
+  auto model_uri = MODEL_FOLDER "training_model.onnx";
+  auto optim_uri = MODEL_FOLDER "adamw.onnx";
+  auto checkpoint_to_load_path = MODEL_FOLDER "checkpoint.ckpt";
+
+  std::unique_ptr<Environment> env;
+  ASSERT_STATUS_OK(Environment::Create(nullptr, env));
+  std::vector<std::shared_ptr<IExecutionProvider>> providers;
+  auto model_identifier = ModelIdentifiers(onnxruntime::ToUTF8String(model_uri),
+                                           std::nullopt,
+                                           std::optional<std::string>(onnxruntime::ToUTF8String(optim_uri)));
+
+  constexpr int world_size = 2;
+  std::array<onnxruntime::training::api::CheckpointState, world_size> states;
+  InlinedHashSet<std::string> sharded_names;
+  size_t num_trainable_params = 0;
+  for (int rank = 0; rank < world_size; ++rank) {
+    auto& state = states[rank];
+    ASSERT_STATUS_OK(onnxruntime::training::api::LoadCheckpoint(checkpoint_to_load_path, state));
+    onnxruntime::SessionOptions session_option;
+    ASSERT_STATUS_OK(session_option.config_options.AddConfigEntry(
+        "training.optimizer_state_shard", (std::to_string(rank) + ":" + std::to_string(world_size)).c_str()));
+    auto optim = std::make_unique<onnxruntime::training::api::Optimizer>(
+        model_identifier, &state, session_option, *env, providers);
+
+    // the optimizer of a rank has the states of its shard only
+    const auto& shard_names = optim->ShardParameterNames();
+    const auto& param_states =
+        state.optimizer_checkpoint_state.group_named_optimizer_states["group0"]->param_named_optimizer_states;
+    ASSERT_EQ(param_states.size(), shard_names.size());
+    for (const auto& name : shard_names) {
+      ASSERT_EQ(param_states.count(name), 1U);
+      ASSERT_TRUE(sharded_names.insert(name).second) << name << " is in two shards";
+    }
+
+    num_trainable_params = 0;
+    for (const auto& [name, param] : state.module_checkpoint_state.named_parameters) {
+      num_trainable_params += param->RequiresGrad() ? 1 : 0;
+    }
+  }
+  ASSERT_EQ(sharded_names.size(), num_trainable_params);
+
+  onnxruntime::training::api::CheckpointState state;
+  ASSERT_STATUS_OK(onnxruntime::training::api::LoadCheckpoint(checkpoint_to_load_path, state));
+  onnxruntime::SessionOptions session_option;
+  ASSERT_STATUS_OK(session_option.config_options.AddConfigEntry("training.optimizer_state_shard", "2:2"));
+  ASSERT_THROW(std::make_unique<onnxruntime::training::api::Optimizer>(model_identifier, &state, session_option,
+                                                                      *env, providers),
+               OnnxRuntimeException);
+}
+
 }  // namespace test
 }  // namespace training
 }  // namespace onnxruntime
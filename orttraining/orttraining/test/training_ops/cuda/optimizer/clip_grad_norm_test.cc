@@ -52,6 +52,26 @@ void InplaceClipGradNormNoClippingTest(std::vector<std::unique_ptr<IExecutionPro
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, providers);
 }
 
+// The gradients span several chunks of the CPU kernel, whose norms are reduced across threads.
+void InplaceClipGradNormMultipleChunksTest(std::vector<std::unique_ptr<IExecutionProvider>>* providers) {
+  OpTester test("InplaceClipGradNorm", 1, onnxruntime::kMSDomain);
+
+  SeqTensors<float> gradients_input;
+  gradients_input.AddTensor({4, 2500}, std::vector<float>(10000, 1.f));
+  gradients_input.AddTensor({3}, {0.f, 0.f, 0.f});
+
+  test.AddSeqInput<float>("gradients", gradients_input);
+
+  test.AddAttribute("max_norm", 10.f);
+
+  SeqTensors<float> clipped_gradients;
+  clipped_gradients.AddTensor({4, 2500}, std::vector<float>(10000, 0.1f));
+  clipped_gradients.AddTensor({3}, {0.f, 0.f, 0.f});
+  test.AddSeqOutput<float>("clipped_gradients", clipped_gradients);
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, providers);
+}
+
 }  // namespace
 
 TEST(OptimizerTest, InplaceClipGradNorm_CPU) {
@@ -66,6 +86,12 @@ TEST(OptimizerTest, InplaceClipGradNormNoClipping_CPU) {
   InplaceClipGradNormNoClippingTest(&providers);
 }
 
+TEST(OptimizerTest, InplaceClipGradNormMultipleChunks_CPU) {
+  std::vector<std::unique_ptr<IExecutionProvider>> providers;
+  providers.emplace_back(DefaultCpuExecutionProvider());
+  InplaceClipGradNormMultipleChunksTest(&providers);
+}
+
 #ifdef USE_CUDA
 
 TEST(OptimizerTest, InplaceClipGradNorm_CUDA) {
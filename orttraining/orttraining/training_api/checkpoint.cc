@@ -3,15 +3,27 @@
 
 #include "orttraining/training_api/checkpoint.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "core/common/path.h"
 #include "core/flatbuffers/checkpoint_version.h"
 #include "core/flatbuffers/schema/ort_training_checkpoint.fbs.h"
+#include "core/framework/allocator.h"
 #include "core/framework/framework_common.h"
+#include "core/framework/murmurhash3.h"
 #include "core/graph/graph_flatbuffers_utils.h"
 
 namespace onnxruntime::training::api {
 
 namespace {
 
+// The string property of an incremental checkpoint holding the path of its base checkpoint.
+constexpr char kBaseCheckpointProperty[] = "ort.base_checkpoint";
+// Bounds the chain of base checkpoints, which a malformed checkpoint could make cyclic.
+constexpr size_t kMaxBaseCheckpoints = 4096;
+
 /**
  * @brief Sort keys of a hash map.
  * @param hash_map Hash map to sort.
@@ -64,16 +76,65 @@ Status FlatbufferTensorFromOrtValue(
   return Status::OK();
 }
 
+/**
+ * @brief Create OrtValue object over the data of a flatbuffer tensor in a checkpoint mapped into memory.
+ *
+ * @param fbs_tensor Flatbuffer tensor.
+ * @param mapped_checkpoint Mapped checkpoint holding the tensor, kept alive by the OrtValue.
+ * @param tensor_name Name of the tensor.
+ * @param ort_value OrtValue object to be populated, unallocated if the tensor data can't be used in place.
+ * @return Status of the operation.
+ */
+Status MappedOrtValueFromFlatbufferTensor(const fbs::Tensor& fbs_tensor,
+                                          const std::shared_ptr<const void>& mapped_checkpoint,
+                                          std::string& tensor_name, OrtValue& ort_value) {
+  const auto* fbs_tensor_name = fbs_tensor.name();
+  const auto* tensor_dims = fbs_tensor.dims();
+  const auto* raw_data = fbs_tensor.raw_data();
+  if (fbs_tensor_name == nullptr || tensor_dims == nullptr || raw_data == nullptr) {
+    return Status::OK();
+  }
+
+  const auto* tensor_type = DataTypeImpl::TensorTypeFromONNXEnum(static_cast<int32_t>(fbs_tensor.data_type()));
+  const DataTypeImpl* element_type = tensor_type->GetElementType();
+  const TensorShape shape(tensor_dims->data(), tensor_dims->size());
+  // the data of checkpoints saved before it was aligned may not be aligned to the elements
+  if (element_type == DataTypeImpl::GetType<std::string>() ||
+      reinterpret_cast<uintptr_t>(raw_data->Data()) % element_type->Size() != 0 ||
+      static_cast<size_t>(shape.Size()) * element_type->Size() != raw_data->size()) {
+    return Status::OK();
+  }
+
+  tensor_name = fbs_tensor_name->str();
+  // the mapping is copy-on-write, so the tensor may be updated in place like any other parameter
+  auto ort_tensor = std::make_unique<Tensor>(element_type, shape, const_cast<uint8_t*>(raw_data->Data()),
+                                             OrtMemoryInfo(onnxruntime::CPU, OrtDeviceAllocator));
+  ort_value.Init(ort_tensor.release(), DataTypeImpl::GetType<onnxruntime::Tensor>(),
+                 [mapped_checkpoint](void* tensor) { delete static_cast<Tensor*>(tensor); });
+
+  return Status::OK();
+}
+
 /**
  * @brief Create OrtValue object from flatbuffer tensor
  *
  * @param fbs_tensor Flatbuffer tensor.
+ * @param mapped_checkpoint Mapped checkpoint holding the tensor or nullptr. The tensor data is used in place when
+ *                          possible rather than copied if not nullptr.
  * @param tensor_name Name of the tensor.
  * @param ort_value OrtValue object to be populated.
  * @return Status of the operation.
  */
 Status OrtValueFromFlatbufferTensor(const fbs::Tensor& fbs_tensor,
+                                    const std::shared_ptr<const void>& mapped_checkpoint,
                                     std::string& tensor_name, OrtValue& ort_value) {
+  if (mapped_checkpoint != nullptr) {
+    ORT_RETURN_IF_ERROR(MappedOrtValueFromFlatbufferTensor(fbs_tensor, mapped_checkpoint, tensor_name, ort_value));
+    if (ort_value.IsAllocated()) {
+      return Status::OK();
+    }
+  }
+
   // The assumption is that the flatbuffer buffer will be destructed once the checkpoint has been loaded.
   // And so, we must allocate a buffer where the tensor data can be copied using the cpu allocator.
   // This buffer is owned by the OrtValue.
@@ -125,18 +186,20 @@ Status FlatbufferTensorsFromOrtValues(
  * @brief Create OrtValue objects from flatbuffer tensors.
  *
  * @param flatbuffer_tensors Flatbuffer tensors.
+ * @param mapped_checkpoint Mapped checkpoint holding the tensors or nullptr.
  * @param name_to_ort_value Name to OrtValue map to be populated.
  * @return Status of the operation.
  */
 Status OrtValuesFromFlatbufferTensors(
     const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::fbs::Tensor>>& flatbuffer_tensors,
+    const std::shared_ptr<const void>& mapped_checkpoint,
     InlinedHashMap<std::string, OrtValue>& name_to_ort_value) {
   for (const auto* fbs_tensor : flatbuffer_tensors) {
     ORT_RETURN_IF_NOT(fbs_tensor, "Encountered a nullptr flatbuffer tensor. Checkpoint file is invalid.");
 
     std::string tensor_name;
     OrtValue ort_value;
-    ORT_RETURN_IF_ERROR(OrtValueFromFlatbufferTensor(*fbs_tensor, tensor_name, ort_value));
+    ORT_RETURN_IF_ERROR(OrtValueFromFlatbufferTensor(*fbs_tensor, mapped_checkpoint, tensor_name, ort_value));
     name_to_ort_value.emplace(std::move(tensor_name), std::move(ort_value));
   }
 
@@ -452,6 +515,52 @@ Status FromCheckpointState(
   return save::ToFile(checkpoint_path, builder);
 }
 
+/**
+ * @brief Copy a tensor to a host buffer, reused if it has the type and shape of the tensor.
+ *
+ * @param ort_value OrtValue to copy.
+ * @param data_transfer_manager Data transfer manager to copy the OrtValue tensor to a cpu buffer.
+ * @param snapshot OrtValue holding the copy. The previous copy of the tensor or unallocated.
+ * @return Status of the operation.
+ */
+Status SnapshotTensor(const OrtValue& ort_value, const DataTransferManager* data_transfer_manager,
+                      OrtValue& snapshot) {
+  ORT_RETURN_IF_NOT(ort_value.IsTensor(), "Only tensor OrtValues can be saved to a checkpoint.");
+  const onnxruntime::Tensor& src_tensor = ort_value.Get<onnxruntime::Tensor>();
+  ORT_RETURN_IF(src_tensor.IsDataTypeString(), "String tensors cannot be saved to a checkpoint.");
+
+  if (!snapshot.IsAllocated() || snapshot.Get<onnxruntime::Tensor>().DataType() != src_tensor.DataType() ||
+      snapshot.Get<onnxruntime::Tensor>().Shape() != src_tensor.Shape()) {
+    static AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
+    onnxruntime::Tensor::InitOrtValue(src_tensor.DataType(), src_tensor.Shape(), cpu_allocator, snapshot);
+  }
+
+  onnxruntime::Tensor& dst_tensor = *snapshot.GetMutable<onnxruntime::Tensor>();
+  if (src_tensor.Location().device.Type() == OrtDevice::CPU) {
+    std::memcpy(dst_tensor.MutableDataRaw(), src_tensor.DataRaw(), src_tensor.SizeInBytes());
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF_NOT(data_transfer_manager,
+                    "Cannot save OrtValue to a checkpoint. Expected: A valid data transfer manager. ",
+                    "Actual: nullptr.");
+  return data_transfer_manager->CopyTensor(src_tensor, dst_tensor);
+}
+
+/**
+ * @brief Hash the data of a host tensor.
+ *
+ * @param ort_value OrtValue of the tensor.
+ * @param hash Hash of the tensor, all zeros for tensors too large to hash, which are considered to always change.
+ */
+void HashTensor(const OrtValue& ort_value, std::array<uint32_t, 4>& hash) {
+  const onnxruntime::Tensor& tensor = ort_value.Get<onnxruntime::Tensor>();
+  hash = {};
+  if (tensor.SizeInBytes() <= static_cast<size_t>(std::numeric_limits<int>::max())) {
+    MurmurHash3::x86_128(tensor.DataRaw(), static_cast<int>(tensor.SizeInBytes()), 0, hash.data());
+  }
+}
+
 }  // namespace save
 
 namespace load {
@@ -478,22 +587,45 @@ Status FromFile(const PathString& checkpoint_path, InlinedVector<uint8_t>& check
   return Status::OK();
 }
 
+/**
+ * @brief Map checkpoint flatbuffer from file into memory.
+ * @param checkpoint_path Path to the checkpoint file.
+ * @param mapped_checkpoint Mapping of the checkpoint file.
+ * @param checkpoint_bytes Contents of the checkpoint file in bytes.
+ * @return Status of the operation.
+ */
+Status FromMappedFile(const PathString& checkpoint_path, std::shared_ptr<const void>& mapped_checkpoint,
+                      gsl::span<const uint8_t>& checkpoint_bytes) {
+  size_t num_bytes = 0;
+  ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(checkpoint_path.c_str(), num_bytes));
+  ORT_RETURN_IF(num_bytes == 0, "Loading checkpoint from ", ToUTF8String(checkpoint_path), " failed. It is empty.");
+
+  Env::MappedMemoryPtr mapped_memory;
+  ORT_RETURN_IF_ERROR(Env::Default().MapFileIntoMemory(checkpoint_path.c_str(), 0, num_bytes, mapped_memory));
+  checkpoint_bytes = gsl::make_span(reinterpret_cast<const uint8_t*>(mapped_memory.get()), num_bytes);
+  mapped_checkpoint = std::shared_ptr<const void>(std::move(mapped_memory));
+
+  return Status::OK();
+}
+
 /**
  * @brief Load from a flatbuffer checkpoint module state to a module state.
  *
  * @param fbs_module_state Flatbuffer module state.
+ * @param mapped_checkpoint Mapped checkpoint holding the module state or nullptr.
  * @param module_state Module state to be populated.
  * @return Status of the operation.
  */
 Status ToModuleState(
-    const onnxruntime::fbs::ModuleState& fbs_module_state, ModuleCheckpointState& module_state) {
+    const onnxruntime::fbs::ModuleState& fbs_module_state, const std::shared_ptr<const void>& mapped_checkpoint,
+    ModuleCheckpointState& module_state) {
   const auto* requires_grad_params = fbs_module_state.requires_grad_params();
   ORT_RETURN_IF_NOT(requires_grad_params, "Expected: Valid trainable tensors flatbuffer.",
                     " Actual: Encountered a nullptr. Checkpoint file is invalid");
   flatbuffers::uoffset_t trainable_params_size = requires_grad_params->size();
   InlinedHashMap<std::string, OrtValue> trainable_params;
   trainable_params.reserve(trainable_params_size);
-  ORT_RETURN_IF_ERROR(OrtValuesFromFlatbufferTensors(*requires_grad_params, trainable_params));
+  ORT_RETURN_IF_ERROR(OrtValuesFromFlatbufferTensors(*requires_grad_params, mapped_checkpoint, trainable_params));
 
   for (auto& [name, value] : trainable_params) {
     auto param = std::make_shared<Parameter>(name, value, true);
@@ -506,7 +638,7 @@ Status ToModuleState(
   flatbuffers::uoffset_t non_trainable_params_size = frozen_params->size();
   InlinedHashMap<std::string, OrtValue> non_trainable_params;
   non_trainable_params.reserve(non_trainable_params_size);
-  ORT_RETURN_IF_ERROR(OrtValuesFromFlatbufferTensors(*frozen_params, non_trainable_params));
+  ORT_RETURN_IF_ERROR(OrtValuesFromFlatbufferTensors(*frozen_params, mapped_checkpoint, non_trainable_params));
 
   for (auto& [name, value] : non_trainable_params) {
     auto param = std::make_shared<Parameter>(name, value, false);
@@ -520,11 +652,13 @@ Status ToModuleState(
  * @brief Load from a flatbuffer checkpoint optimizer state to an optimizer state.
  *
  * @param optimizer_groups Flatbuffer optimizer groups.
+ * @param mapped_checkpoint Mapped checkpoint holding the optimizer groups or nullptr.
  * @param optimizer_state Optimizer state to be populated.
  * @return Status of the operation.
  */
 Status ToOptimizerState(
     const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::fbs::OptimizerGroup>>& optimizer_groups,
+    const std::shared_ptr<const void>& mapped_checkpoint,
     OptimizerCheckpointState& optimizer_state) {
   for (const auto* optimizer_group : optimizer_groups) {
     ORT_RETURN_IF_NOT(optimizer_group, "Expected: Valid optimizer groups flatbuffer.",
@@ -553,7 +687,7 @@ Status ToOptimizerState(
       ORT_RETURN_IF_NOT(momentums, "Expected: Valid optimizer momentum tensors flatbuffer.",
                         " Actual: Encountered a nullptr. Checkpoint file is invalid");
       ORT_RETURN_IF_ERROR(OrtValuesFromFlatbufferTensors(
-          *momentums, optimizer_state_it->second->param_named_optimizer_states[param_name]));
+          *momentums, mapped_checkpoint, optimizer_state_it->second->param_named_optimizer_states[param_name]));
     }
   }
 
@@ -682,11 +816,13 @@ Status ToModelProto(gsl::span<const uint8_t> checkpoint_bytes,
 /**
  * @brief Load checkpoint from a checkpoint file to a checkpoint state.
  *
- * @param checkpoint_path Path to the checkpoint file.
+ * @param checkpoint_bytes Contents of the checkpoint file in bytes.
+ * @param mapped_checkpoint Mapping of the checkpoint file holding checkpoint_bytes or nullptr.
  * @param state Checkpoint state to be populated.
  * @return Status of the operation.
  */
-Status ToCheckpointState(gsl::span<const uint8_t> checkpoint_bytes, CheckpointState& state) {
+Status ToCheckpointState(gsl::span<const uint8_t> checkpoint_bytes,
+                         const std::shared_ptr<const void>& mapped_checkpoint, CheckpointState& state) {
   flatbuffers::Verifier verifier(checkpoint_bytes.data(), checkpoint_bytes.size());
   ORT_RETURN_IF_NOT(fbs::VerifyCheckpointBuffer(verifier), "Checkpoint verification failed.");
 
@@ -699,12 +835,12 @@ Status ToCheckpointState(gsl::span<const uint8_t> checkpoint_bytes, CheckpointSt
 
   const auto* fbs_module_state = fbs_checkpoint->module_state();
   if (nullptr != fbs_module_state) {
-    ORT_RETURN_IF_ERROR(ToModuleState(*fbs_module_state, state.module_checkpoint_state));
+    ORT_RETURN_IF_ERROR(ToModuleState(*fbs_module_state, mapped_checkpoint, state.module_checkpoint_state));
   }
 
   const auto* fbs_optimizer_groups = fbs_checkpoint->optimizer_groups();
   if (nullptr != fbs_optimizer_groups) {
-    ORT_RETURN_IF_ERROR(ToOptimizerState(*fbs_optimizer_groups, state.optimizer_checkpoint_state));
+    ORT_RETURN_IF_ERROR(ToOptimizerState(*fbs_optimizer_groups, mapped_checkpoint, state.optimizer_checkpoint_state));
   }
 
   const auto* fbs_property_bag = fbs_checkpoint->property_bag();
@@ -715,6 +851,76 @@ Status ToCheckpointState(gsl::span<const uint8_t> checkpoint_bytes, CheckpointSt
   return Status::OK();
 }
 
+/**
+ * @brief Update a checkpoint state with the states of a checkpoint, incremental ones being based on it.
+ *
+ * @param increment States of the checkpoint.
+ * @param state Checkpoint state to be updated.
+ */
+void MergeCheckpointState(CheckpointState& increment, CheckpointState& state) {
+  for (auto& [name, param] : increment.module_checkpoint_state.named_parameters) {
+    state.module_checkpoint_state.named_parameters[name] = std::move(param);
+  }
+
+  for (auto& [group_name, group] : increment.optimizer_checkpoint_state.group_named_optimizer_states) {
+    auto& state_group = state.optimizer_checkpoint_state.group_named_optimizer_states[group_name];
+    if (state_group == nullptr) {
+      state_group = std::move(group);
+      continue;
+    }
+    state_group->step = group->step;
+    state_group->initial_lr = group->initial_lr;
+    for (auto& [param_name, param_optimizer_state] : group->param_named_optimizer_states) {
+      state_group->param_named_optimizer_states[param_name] = std::move(param_optimizer_state);
+    }
+  }
+
+  for (const auto& [name, value] : increment.property_bag) {
+    if (name != kBaseCheckpointProperty) {
+      state.property_bag.AddProperty(name, value);
+    }
+  }
+}
+
+/**
+ * @brief Load checkpoint from a checkpoint file, after the checkpoints it is based on if it is incremental.
+ *
+ * @param checkpoint_path Path to the checkpoint file.
+ * @param map_tensors Whether to map the checkpoint file into memory and use the tensor data in place.
+ * @param num_bases Number of checkpoints loaded after this one.
+ * @param state Checkpoint state to be populated.
+ * @return Status of the operation.
+ */
+Status FromCheckpointFile(const PathString& checkpoint_path, const bool map_tensors, const size_t num_bases,
+                          CheckpointState& state) {
+  ORT_RETURN_IF(num_bases > kMaxBaseCheckpoints, "Checkpoint is invalid. It is based on more than ",
+                kMaxBaseCheckpoints, " checkpoints.");
+
+  std::shared_ptr<const void> mapped_checkpoint;
+  InlinedVector<uint8_t> checkpoint_bytes;
+  gsl::span<const uint8_t> checkpoint_span;
+  if (map_tensors) {
+    ORT_RETURN_IF_ERROR(FromMappedFile(checkpoint_path, mapped_checkpoint, checkpoint_span));
+  } else {
+    ORT_RETURN_IF_ERROR(FromFile(checkpoint_path, checkpoint_bytes));
+    checkpoint_span = checkpoint_bytes;
+  }
+
+  CheckpointState increment;
+  ORT_RETURN_IF_ERROR(ToCheckpointState(checkpoint_span, mapped_checkpoint, increment));
+  if (increment.property_bag.HasProperty(kBaseCheckpointProperty)) {
+    Path base_path =
+        Path::Parse(ToPathString(increment.property_bag.GetProperty<std::string>(kBaseCheckpointProperty)));
+    if (base_path.IsRelative()) {
+      base_path = Path::Parse(checkpoint_path).ParentPath() / base_path;
+    }
+    ORT_RETURN_IF_ERROR(FromCheckpointFile(base_path.ToPathString(), map_tensors, num_bases + 1, state));
+  }
+  MergeCheckpointState(increment, state);
+
+  return Status::OK();
+}
+
 }  // namespace load
 
 }  // namespace
@@ -734,18 +940,190 @@ Status SaveCheckpoint(const CheckpointState& states, const PathString& checkpoin
   return save::FromCheckpointState(states, checkpoint_path, include_optimizer_state);
 }
 
-Status LoadCheckpoint(const PathString& checkpoint_path, CheckpointState& checkpoint_states) {
+CheckpointWriter::~CheckpointWriter() {
+  ORT_IGNORE_RETURN_VALUE(Wait());
+}
+
+Status CheckpointWriter::SaveAsync(const CheckpointState& state, const PathString& checkpoint_path,
+                                   bool include_optimizer_state, bool incremental) {
   ORT_RETURN_IF_NOT(FLATBUFFERS_LITTLEENDIAN, "ORT training checkpoint format only supports little-endian machines");
+  // the previous snapshot is being written
+  ORT_IGNORE_RETURN_VALUE(Wait());
+
+  ORT_RETURN_IF_ERROR(Snapshot(state, include_optimizer_state));
+  write_thread_ = std::thread([this, checkpoint_path, include_optimizer_state, incremental]() {
+    Status status;
+    ORT_TRY {
+      status = Write(checkpoint_path, include_optimizer_state, incremental);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+    ORT_CATCH(...) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, "Unknown exception while saving the checkpoint");
+    }
+    write_status_ = status;
+  });
 
-  InlinedVector<uint8_t> checkpoint_bytes;
-  ORT_RETURN_IF_ERROR(load::FromFile(checkpoint_path, checkpoint_bytes));
-  return load::ToCheckpointState(checkpoint_bytes, checkpoint_states);
+  return Status::OK();
+}
+
+Status CheckpointWriter::Wait() {
+  if (write_thread_.joinable()) {
+    write_thread_.join();
+  }
+  return write_status_;
+}
+
+Status CheckpointWriter::Snapshot(const CheckpointState& state, bool include_optimizer_state) {
+  CheckpointState snapshot;
+  // the snapshot is on the host
+  snapshot.module_checkpoint_state.train_session_data_transfer_mgr = nullptr;
+  snapshot.optimizer_checkpoint_state.optimizer_session_data_transfer_mgr = nullptr;
+
+  const auto& previous_params = snapshot_.module_checkpoint_state.named_parameters;
+  for (const auto& [name, param] : state.module_checkpoint_state.named_parameters) {
+    OrtValue value;
+    if (const auto it = previous_params.find(name); it != previous_params.end()) {
+      value = it->second->Data();
+    }
+    ORT_RETURN_IF_ERROR(
+        save::SnapshotTensor(param->Data(), state.module_checkpoint_state.train_session_data_transfer_mgr, value));
+    snapshot.module_checkpoint_state.named_parameters.emplace(
+        name, std::make_shared<Parameter>(name, value, param->RequiresGrad()));
+  }
+
+  if (include_optimizer_state) {
+    const auto& previous_groups = snapshot_.optimizer_checkpoint_state.group_named_optimizer_states;
+    for (const auto& [group_name, group] : state.optimizer_checkpoint_state.group_named_optimizer_states) {
+      const auto previous_group_it = previous_groups.find(group_name);
+      auto snapshot_group = std::make_shared<GroupOptimizerState>();
+      snapshot_group->step = group->step;
+      snapshot_group->initial_lr = group->initial_lr;
+      snapshot_group->learning_rate = group->learning_rate;
+      for (const auto& [param_name, param_optimizer_state] : group->param_named_optimizer_states) {
+        const ParameterOptimizerState* previous_param_state = nullptr;
+        if (previous_group_it != previous_groups.end()) {
+          const auto& previous_param_states = previous_group_it->second->param_named_optimizer_states;
+          if (const auto it = previous_param_states.find(param_name); it != previous_param_states.end()) {
+            previous_param_state = &it->second;
+          }
+        }
+
+        auto& snapshot_param_state = snapshot_group->param_named_optimizer_states[param_name];
+        for (const auto& [momentum_name, momentum] : param_optimizer_state) {
+          OrtValue value;
+          if (previous_param_state != nullptr) {
+            if (const auto it = previous_param_state->find(momentum_name); it != previous_param_state->end()) {
+              value = it->second;
+            }
+          }
+          ORT_RETURN_IF_ERROR(save::SnapshotTensor(
+              momentum, state.optimizer_checkpoint_state.optimizer_session_data_transfer_mgr, value));
+          snapshot_param_state.emplace(momentum_name, std::move(value));
+        }
+      }
+      snapshot.optimizer_checkpoint_state.group_named_optimizer_states.emplace(group_name,
+                                                                               std::move(snapshot_group));
+    }
+  }
+
+  snapshot.property_bag = state.property_bag;
+  snapshot_ = std::move(snapshot);
+
+  return Status::OK();
+}
+
+Status CheckpointWriter::Write(const PathString& checkpoint_path, bool include_optimizer_state, bool incremental) {
+  InlinedHashMap<std::string, std::array<uint32_t, 4>> tensor_hashes;
+  for (const auto& [name, param] : snapshot_.module_checkpoint_state.named_parameters) {
+    save::HashTensor(param->Data(), tensor_hashes[name]);
+  }
+  for (const auto& [group_name, group] : snapshot_.optimizer_checkpoint_state.group_named_optimizer_states) {
+    for (const auto& [param_name, param_optimizer_state] : group->param_named_optimizer_states) {
+      for (const auto& [momentum_name, momentum] : param_optimizer_state) {
+        save::HashTensor(momentum, tensor_hashes[group_name + "/" + param_name + "/" + momentum_name]);
+      }
+    }
+  }
+  const auto changed = [this, &tensor_hashes](const std::string& key) {
+    const auto it = base_tensor_hashes_.find(key);
+    return it == base_tensor_hashes_.end() || it->second == std::array<uint32_t, 4>{} ||
+           it->second != tensor_hashes.at(key);
+  };
+
+  // an increment can't remove the tensors of its base, nor be its own base
+  bool write_increment = incremental && !base_checkpoint_path_.empty() &&
+                         Path::Parse(base_checkpoint_path_).NormalizedPath().ToPathString() !=
+                             Path::Parse(checkpoint_path).NormalizedPath().ToPathString() &&
+                         std::all_of(base_tensor_hashes_.begin(), base_tensor_hashes_.end(),
+                                     [&tensor_hashes](const auto& base_hash) {
+                                       return tensor_hashes.count(base_hash.first) > 0;
+                                     });
+  Path base_path;
+  if (write_increment) {
+    write_increment = RelativePath(Path::Parse(checkpoint_path).ParentPath(), Path::Parse(base_checkpoint_path_),
+                                   base_path)
+                          .IsOK();
+  }
+
+  CheckpointState increment;
+  if (write_increment) {
+    for (const auto& [name, param] : snapshot_.module_checkpoint_state.named_parameters) {
+      if (changed(name)) {
+        increment.module_checkpoint_state.named_parameters.emplace(name, param);
+      }
+    }
+    // the optimizer states of a parameter are written if any of them changed
+    for (const auto& [group_name, group] : snapshot_.optimizer_checkpoint_state.group_named_optimizer_states) {
+      auto increment_group = std::make_shared<GroupOptimizerState>();
+      increment_group->step = group->step;
+      increment_group->initial_lr = group->initial_lr;
+      increment_group->learning_rate = group->learning_rate;
+      for (const auto& [param_name, param_optimizer_state] : group->param_named_optimizer_states) {
+        if (std::any_of(param_optimizer_state.begin(), param_optimizer_state.end(),
+                        [&](const auto& momentum) {
+                          return changed(group_name + "/" + param_name + "/" + momentum.first);
+                        })) {
+          increment_group->param_named_optimizer_states.emplace(param_name, param_optimizer_state);
+        }
+      }
+      increment.optimizer_checkpoint_state.group_named_optimizer_states.emplace(group_name,
+                                                                                std::move(increment_group));
+    }
+    increment.property_bag = snapshot_.property_bag;
+    increment.property_bag.AddProperty(kBaseCheckpointProperty, ToUTF8String(base_path.ToPathString()));
+  }
+
+  // the hashes of a failed save are not those of the checkpoint at base_checkpoint_path_
+  base_checkpoint_path_.clear();
+  base_tensor_hashes_.clear();
+  ORT_RETURN_IF_ERROR(save::FromCheckpointState(write_increment ? increment : snapshot_, checkpoint_path,
+                                                include_optimizer_state));
+  base_checkpoint_path_ = checkpoint_path;
+  base_tensor_hashes_ = std::move(tensor_hashes);
+
+  return Status::OK();
+}
+
+Status LoadCheckpoint(const PathString& checkpoint_path, CheckpointState& checkpoint_states, bool map_tensors) {
+  ORT_RETURN_IF_NOT(FLATBUFFERS_LITTLEENDIAN, "ORT training checkpoint format only supports little-endian machines");
+
+  return load::FromCheckpointFile(checkpoint_path, map_tensors, 0, checkpoint_states);
 }
 
 Status LoadCheckpointFromBuffer(gsl::span<const uint8_t> checkpoint_bytes, CheckpointState& checkpoint_state) {
   ORT_RETURN_IF_NOT(FLATBUFFERS_LITTLEENDIAN, "ORT training checkpoint format only supports little-endian machines");
 
-  return load::ToCheckpointState(checkpoint_bytes, checkpoint_state);
+  CheckpointState loaded_state;
+  ORT_RETURN_IF_ERROR(load::ToCheckpointState(checkpoint_bytes, nullptr, loaded_state));
+  ORT_RETURN_IF(loaded_state.property_bag.HasProperty(kBaseCheckpointProperty),
+                "An incremental checkpoint cannot be loaded from a buffer. Load it from its file.");
+  load::MergeCheckpointState(loaded_state, checkpoint_state);
+
+  return Status::OK();
 }
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <array>
+#include <string>
+#include <thread>
+
 #include "core/platform/path_lib.h"
 #include "orttraining/training_api/checkpoint_property.h"
 #include "orttraining/training_api/module.h"
@@ -21,6 +25,9 @@
  * The checkpoint file is a single flatbuffer file containing all the states highlighted above.
  * The flatbuffer schema is defined in onnxruntime/core/flatbuffers/schema/ort_training_checkpoint.fbs
  *
+ * An incremental checkpoint, saved by the CheckpointWriter, only holds the tensors that changed since the
+ * checkpoint it is based on, whose path it records relative to its own directory. Loading it loads its base first.
+ *
  */
 
 namespace onnxruntime::training::api {
@@ -56,15 +63,69 @@ Status SaveCheckpoint(gsl::span<const ONNX_NAMESPACE::TensorProto> trainable_ten
                       const PathString& checkpoint_path);
 #endif
 
+/**
+ * @brief Saves training states as ORT checkpoints in the background.
+ *
+ * SaveAsync copies the states to host buffers, which it reuses across checkpoints, and returns while a thread
+ * writes them, so that training only waits for the copy. The states can be updated once SaveAsync returned.
+ *
+ * An incremental save writes the tensors whose content changed since the previous checkpoint of the writer, which
+ * it is based on, e.g. neither the frozen parameters nor the optimizer states of the parameters that had no update.
+ * The checkpoints an incremental checkpoint is based on must be kept to load it. A save is full if there is no
+ * previous checkpoint, it failed, or it had tensors that no longer are in the states.
+ */
+class CheckpointWriter {
+ public:
+  CheckpointWriter() = default;
+
+  // Waits for the save in progress.
+  ~CheckpointWriter();
+
+  /**
+   * @brief Waits for the previous save, copies the states and starts writing them.
+   *
+   * @param state parameter/optimizer and other user defined training states.
+   * @param checkpoint_path file where checkpoint is saved. It must not be a checkpoint that the checkpoints of the
+   *        writer are based on.
+   * @param include_optimizer_state Whether to include optimizer state in the checkpoint.
+   * @param incremental Whether to only write the tensors that changed since the previous checkpoint.
+   * @return Status of the copy. The status of the write is returned by Wait.
+   */
+  Status SaveAsync(const CheckpointState& state, const PathString& checkpoint_path, bool include_optimizer_state,
+                   bool incremental = false);
+
+  // Waits for the save in progress, if any, and returns the status of the last save.
+  Status Wait();
+
+ private:
+  Status Snapshot(const CheckpointState& state, bool include_optimizer_state);
+  Status Write(const PathString& checkpoint_path, bool include_optimizer_state, bool incremental);
+
+  // the copy of the states being written, whose buffers are reused by the next save
+  CheckpointState snapshot_;
+
+  // the previous checkpoint and the hashes of its tensors, by "<parameter>" and "<group>/<parameter>/<momentum>"
+  PathString base_checkpoint_path_;
+  InlinedHashMap<std::string, std::array<uint32_t, 4>> base_tensor_hashes_;
+
+  std::thread write_thread_;
+  Status write_status_;  // written by the write thread, read after joining it
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CheckpointWriter);
+};
+
 /**
  * @brief Load training states from ORT checkpoint.
  *
  * @param checkpoint_path file where checkpoint is stored.
  * @param checkpoint_states parameter/optimizer and other user defined training states.
+ * @param map_tensors Whether to map the checkpoint file into memory and use the tensor data in place rather than
+ *        copying it. The mapping is copy-on-write and lasts as long as the tensors. The file must not be modified
+ *        while it is mapped.
  * @return Status
  */
 Status LoadCheckpoint(const PathString& checkpoint_path,
-                      CheckpointState& checkpoint_state);
+                      CheckpointState& checkpoint_state, bool map_tensors = false);
 
 /**
  * @brief Load training states from ORT checkpoint bytes buffer.
@@ -10,6 +10,7 @@
 #include "core/session/environment.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/graph/graph_utils.h"
+#include "core/graph/node_attr_utils.h"
 
 #include "orttraining/training_api/checkpoint.h"
 
@@ -23,6 +24,13 @@ namespace {
 
 // TODO: consolidate with frontend tooling
 const std::string ACCUMULATE_GRAD_CONTROL_INPUT_NAME{"lazy_reset_grad"};
+const std::string FUSED_UPDATE_LEARNING_RATE_INPUT_NAME{"learning_rate"};
+const std::string GROUP_ZERO_NAME{"group0"};
+
+// The graph input of a state of the fused update of a parameter.
+std::string FusedUpdateInputName(const std::string& param_name, const std::string& state_name) {
+  return param_name + "." + state_name;
+}
 
 #if !defined(ORT_MINIMAL_BUILD)
 std::unordered_set<const Node*> GetReverseReachableNodes(Graph& inference_graph,
@@ -116,6 +124,231 @@ Status TransformModelInputsForInference(Graph& inference_graph,
 
   return Status::OK();
 }
+
+// Replaces the gradient accumulation of each trainable parameter by its update with the optimizer of
+// optimizer_node: SGDOptimizerV2 by SGDOptimizer and AdamWOptimizer by AdamOptimizer, the per tensor ops of the
+// same updates. The update of a parameter runs once its gradient is computed and after the nodes reading the
+// parameter that don't precede its gradient, i.e. the backward nodes, behind a PassThrough barrier.
+Status FuseOptimizerStep(Graph& graph, const Node& optimizer_node,
+                         const std::unordered_map<std::string, std::shared_ptr<Parameter>>& named_parameters,
+                         InlinedVector<std::string>& fused_param_names) {
+  const bool is_adamw = optimizer_node.OpType() == "AdamWOptimizer";
+  NodeAttributes update_attributes;
+  if (is_adamw) {
+    const auto get_float = [&optimizer_node](const std::string& name, float default_value) {
+      const auto* attr = graph_utils::GetNodeAttribute(optimizer_node, name);
+      return attr != nullptr ? attr->f() : default_value;
+    };
+    const auto get_int = [&optimizer_node](const std::string& name, int64_t default_value) {
+      const auto* attr = graph_utils::GetNodeAttribute(optimizer_node, name);
+      return attr != nullptr ? attr->i() : default_value;
+    };
+    // the defaults of AdamWOptimizer
+    for (auto&& attr : {onnxruntime::utils::MakeAttribute("alpha", get_float("alpha", 0.9f)),
+                        onnxruntime::utils::MakeAttribute("beta", get_float("beta", 0.999f)),
+                        onnxruntime::utils::MakeAttribute("epsilon", get_float("epsilon", 1e-8f)),
+                        onnxruntime::utils::MakeAttribute("lambda", get_float("weight_decay", 1e-2f)),
+                        onnxruntime::utils::MakeAttribute("do_bias_correction", get_int("correct_bias", 1)),
+                        onnxruntime::utils::MakeAttribute("weight_decay_mode", get_int("adam_mode", 0))}) {
+      onnxruntime::utils::SetNodeAttribute(attr, update_attributes);
+    }
+  }
+
+  ONNX_NAMESPACE::TypeProto learning_rate_type;
+  learning_rate_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  learning_rate_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  ONNX_NAMESPACE::TypeProto step_type;
+  step_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+  step_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  NodeArg& learning_rate = graph.GetOrCreateNodeArg(FUSED_UPDATE_LEARNING_RATE_INPUT_NAME, &learning_rate_type);
+
+  InlinedVector<Node*> accumulators;
+  for (auto& node : graph.Nodes()) {
+    std::string param_name;
+    if (node.OpType() == "InPlaceAccumulatorV2" && node.Domain() == kMSDomain &&
+        utils::GetParamNameFromSuffix(node.InputDefs()[0]->Name(), "_grad.accumulation.buffer", param_name)) {
+      const auto it = named_parameters.find(param_name);
+      if (it != named_parameters.end() && it->second->RequiresGrad()) {
+        accumulators.push_back(&node);
+      }
+    }
+  }
+  ORT_RETURN_IF(accumulators.empty(), "The training graph has no gradient accumulation to fuse the optimizer step in.");
+
+  InlinedHashSet<const NodeArg*> removed_inputs, removed_outputs;
+  InlinedVector<const NodeArg*> added_inputs{&learning_rate}, added_outputs;
+  for (Node* accumulator : accumulators) {
+    std::string param_name;
+    ORT_ENFORCE(utils::GetParamNameFromSuffix(accumulator->InputDefs()[0]->Name(), "_grad.accumulation.buffer",
+                                              param_name));
+    NodeArg* weight = graph.GetNodeArg(param_name);
+    NodeArg* gradient = accumulator->MutableInputDefs()[1];
+    const Node* gradient_producer = graph.GetProducerNode(gradient->Name());
+    ORT_RETURN_IF(weight == nullptr || !graph.IsInputsIncludingInitializers(weight) || gradient_producer == nullptr,
+                  "The gradient accumulation of parameter ", param_name, " does not accumulate a computed gradient "
+                  "of a graph input.");
+
+    // the nodes that have run when the gradient is computed
+    std::unordered_set<const Node*> gradient_ancestors;
+    graph.ReverseDFSFrom(std::vector<const Node*>{gradient_producer},
+                         [&gradient_ancestors](const Node* node) { gradient_ancestors.insert(node); }, {});
+
+    // The other nodes reading the parameter, also through the values that may be views of it, must run before the
+    // update. Shape and Size only read its shape.
+    InlinedVector<NodeArg*> barrier_inputs{gradient};
+    InlinedHashSet<const Node*> barrier_nodes;
+    InlinedVector<const std::string*> values{&param_name};
+    while (!values.empty()) {
+      const std::string& value = *values.back();
+      values.pop_back();
+      for (Node* consumer : graph.GetMutableConsumerNodes(value)) {
+        const auto& op_type = consumer->OpType();
+        const bool is_view = consumer->Domain() == kOnnxDomain &&
+                             (op_type == "Reshape" || op_type == "Squeeze" || op_type == "Unsqueeze" ||
+                              op_type == "Flatten" || op_type == "Identity");
+        if (is_view && consumer->InputDefs()[0]->Name() == value) {
+          values.push_back(&consumer->OutputDefs()[0]->Name());
+        }
+        if (consumer == accumulator || gradient_ancestors.count(consumer) > 0 ||
+            (consumer->Domain() == kOnnxDomain && (op_type == "Shape" || op_type == "Size")) ||
+            !barrier_nodes.insert(consumer).second) {
+          continue;
+        }
+
+        // PassThrough takes inputs of one type
+        auto& outputs = consumer->MutableOutputDefs();
+        const auto output = std::find_if(outputs.begin(), outputs.end(), [gradient](const NodeArg* arg) {
+          return arg->Exists() && arg->TypeAsProto() != nullptr && gradient->TypeAsProto() != nullptr &&
+                 arg->TypeAsProto()->tensor_type().elem_type() == gradient->TypeAsProto()->tensor_type().elem_type();
+        });
+        ORT_RETURN_IF(output == outputs.end(), "The update of parameter ", param_name, " can't be ordered after node ",
+                      consumer->Name(), " reading it, which has no output of the type of the gradient.");
+        barrier_inputs.push_back(*output);
+      }
+    }
+
+    NodeArg* ready_gradient = gradient;
+    if (barrier_inputs.size() > 1) {
+      InlinedVector<NodeArg*> barrier_outputs;
+      for (NodeArg* input : barrier_inputs) {
+        barrier_outputs.push_back(&graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(input->Name() + "_ready"),
+                                                            input->TypeAsProto()));
+      }
+      graph.AddNode(graph.GenerateNodeName(param_name + "_update_barrier"), "PassThrough",
+                    "Orders the update of " + param_name + " after the nodes reading it.", barrier_inputs,
+                    barrier_outputs, nullptr, kMSDomain);
+      ready_gradient = barrier_outputs.front();
+    }
+
+    NodeArg& updated_weight = graph.GetOrCreateNodeArg(param_name + "_grad.update.out", weight->TypeAsProto());
+    if (is_adamw) {
+      NodeArg& step = graph.GetOrCreateNodeArg(FusedUpdateInputName(param_name, "step"), &step_type);
+      NodeArg& momentum0 = graph.GetOrCreateNodeArg(FusedUpdateInputName(param_name, "momentum0"),
+                                                    weight->TypeAsProto());
+      NodeArg& momentum1 = graph.GetOrCreateNodeArg(FusedUpdateInputName(param_name, "momentum1"),
+                                                    weight->TypeAsProto());
+      // the step and the momentums are updated in place
+      NodeArg& updated_step = graph.GetOrCreateNodeArg(step.Name() + ".out", &step_type);
+      NodeArg& updated_momentum0 = graph.GetOrCreateNodeArg(momentum0.Name() + ".out", weight->TypeAsProto());
+      NodeArg& updated_momentum1 = graph.GetOrCreateNodeArg(momentum1.Name() + ".out", weight->TypeAsProto());
+      graph.AddNode(graph.GenerateNodeName(param_name + "_update"), "AdamOptimizer", "",
+                    {&learning_rate, &step, weight, ready_gradient, &momentum0, &momentum1},
+                    {&updated_step, &updated_momentum0, &updated_momentum1, &updated_weight}, &update_attributes,
+                    kMSDomain);
+      added_inputs.insert(added_inputs.end(), {&step, &momentum0, &momentum1});
+    } else {
+      graph.AddNode(graph.GenerateNodeName(param_name + "_update"), "SGDOptimizer", "",
+                    {&learning_rate, weight, ready_gradient}, {&updated_weight}, nullptr, kMSDomain);
+    }
+    added_outputs.push_back(&updated_weight);
+
+    for (const NodeArg* input : accumulator->InputDefs()) {
+      removed_inputs.insert(input);
+    }
+    for (const NodeArg* output : accumulator->OutputDefs()) {
+      removed_outputs.insert(output);
+    }
+    graph_utils::RemoveNodeOutputEdges(graph, *accumulator);
+    graph.RemoveNode(accumulator->Index());
+    fused_param_names.push_back(param_name);
+  }
+
+  // the gradient buffers and the accumulation control are no longer inputs
+  InlinedVector<const NodeArg*> inputs;
+  for (const NodeArg* input : graph.GetInputsIncludingInitializers()) {
+    if (removed_inputs.count(input) == 0 || !graph.GetConsumerNodes(input->Name()).empty()) {
+      inputs.push_back(input);
+    }
+  }
+  inputs.insert(inputs.end(), added_inputs.begin(), added_inputs.end());
+  graph.SetInputs(inputs);
+
+  InlinedVector<const NodeArg*> outputs;
+  for (const NodeArg* output : graph.GetOutputs()) {
+    if (removed_outputs.count(output) == 0) {
+      outputs.push_back(output);
+    }
+  }
+  outputs.insert(outputs.end(), added_outputs.begin(), added_outputs.end());
+  graph.SetOutputs(outputs);
+
+  return graph.Resolve();
+}
+
+// Loads a model given by a path or bytes.
+Status LoadModelProto(const std::variant<std::string, gsl::span<const uint8_t>>& model_identifier,
+                      ONNX_NAMESPACE::ModelProto& model_proto) {
+  if (std::holds_alternative<std::string>(model_identifier)) {
+    return Model::Load(ToPathString(std::get<std::string>(model_identifier)), model_proto);
+  }
+  const auto model_data = std::get<gsl::span<const uint8_t>>(model_identifier);
+  ORT_RETURN_IF_NOT(model_proto.ParseFromArray(model_data.data(), static_cast<int>(model_data.size())),
+                    "Failed to load model because protobuf parsing failed.");
+  return Status::OK();
+}
+
+// Loads the training model with the optimizer step of the optimizer model fused into it into train_sess.
+Status LoadTrainingModelWithFusedOptimizerStep(
+    const ModelIdentifiers& model_identifiers,
+    const std::unordered_map<std::string, std::shared_ptr<Parameter>>& named_parameters,
+    InferenceSession& train_sess, InlinedVector<std::string>& fused_param_names, bool& has_step) {
+  ORT_RETURN_IF_NOT(model_identifiers.IsOptimizerModelAvailable(),
+                    "The fused optimizer step needs the optimizer model.");
+  const auto& logger = logging::LoggingManager::DefaultLogger();
+
+  ONNX_NAMESPACE::ModelProto optimizer_model_proto;
+  if (std::holds_alternative<std::optional<std::string>>(model_identifiers.optim_model)) {
+    ORT_RETURN_IF_ERROR(LoadModelProto(std::get<std::optional<std::string>>(model_identifiers.optim_model).value(),
+                                       optimizer_model_proto));
+  } else {
+    ORT_RETURN_IF_ERROR(LoadModelProto(std::get<gsl::span<const uint8_t>>(model_identifiers.optim_model),
+                                       optimizer_model_proto));
+  }
+  std::shared_ptr<Model> optimizer_model;
+  ORT_RETURN_IF_ERROR(Model::Load(std::move(optimizer_model_proto), optimizer_model, nullptr, logger));
+  const Node* optimizer_node = nullptr;
+  for (const auto& node : optimizer_model->MainGraph().Nodes()) {
+    if (node.Domain() == kMSDomain && (node.OpType() == "AdamWOptimizer" || node.OpType() == "SGDOptimizerV2")) {
+      ORT_RETURN_IF(optimizer_node != nullptr, "The fused optimizer step supports one optimizer node only.");
+      optimizer_node = &node;
+    }
+  }
+  ORT_RETURN_IF(optimizer_node == nullptr,
+                "The fused optimizer step supports the AdamWOptimizer and SGDOptimizerV2 optimizers only.");
+
+  ONNX_NAMESPACE::ModelProto train_model_proto;
+  ORT_RETURN_IF_ERROR(LoadModelProto(model_identifiers.train_model, train_model_proto));
+  const PathString train_model_uri = std::holds_alternative<std::string>(model_identifiers.train_model)
+                                         ? ToPathString(std::get<std::string>(model_identifiers.train_model))
+                                         : PathString();
+  std::shared_ptr<Model> train_model;
+  ORT_RETURN_IF_ERROR(Model::Load(std::move(train_model_proto), train_model_uri, train_model, nullptr, logger));
+  ORT_RETURN_IF_ERROR(FuseOptimizerStep(train_model->MainGraph(), *optimizer_node, named_parameters,
+                                        fused_param_names));
+
+  has_step = optimizer_node->OpType() == "AdamWOptimizer";
+  return train_sess.Load(train_model->ToProto(), train_model_uri);
+}
 #endif
 }  // namespace
 
@@ -230,10 +463,26 @@ Module::Module(const ModelIdentifiers& model_identifiers,
 #endif
 
   // Load the training model
-  ORT_THROW_IF_ERROR(std::holds_alternative<std::string>(model_identifiers.train_model)
-                         ? train_sess_->Load(std::get<std::string>(model_identifiers.train_model))
-                         : train_sess_->Load(std::get<gsl::span<const uint8_t>>(model_identifiers.train_model).data(),
-                                             static_cast<int>(std::get<gsl::span<const uint8_t>>(model_identifiers.train_model).size())));
+  fused_optimizer_step_ = session_options.config_options.GetConfigOrDefault(FUSED_OPTIMIZER_STEP_CONFIG, "0") == "1";
+  if (fused_optimizer_step_) {
+#if !defined(ORT_MINIMAL_BUILD)
+    ORT_THROW_IF_ERROR(LoadTrainingModelWithFusedOptimizerStep(model_identifiers,
+                                                               state_->module_checkpoint_state.named_parameters,
+                                                               *train_sess_, fused_update_param_names_,
+                                                               fused_update_has_step_));
+    if (fused_update_has_step_) {
+      fused_update_momentum_keys_ = AdamWOptimizerAlgorithm().momentum_keys;
+    }
+#else
+    ORT_THROW("The fused optimizer step is not supported in a minimal build.");
+#endif
+  } else {
+    ORT_THROW_IF_ERROR(
+        std::holds_alternative<std::string>(model_identifiers.train_model)
+            ? train_sess_->Load(std::get<std::string>(model_identifiers.train_model))
+            : train_sess_->Load(std::get<gsl::span<const uint8_t>>(model_identifiers.train_model).data(),
+                                static_cast<int>(std::get<gsl::span<const uint8_t>>(model_identifiers.train_model).size())));
+  }
 
   for (const auto& provider : providers) {
     ORT_THROW_IF_ERROR(train_sess_->RegisterExecutionProvider(provider));
@@ -249,12 +498,31 @@ Module::Module(const ModelIdentifiers& model_identifiers,
 
   // Reorder the extracted input names in the following order:
   // user inputs, weights, gradients, reset_grad
+  // or with the fused optimizer step:
+  // user inputs, weights, learning rate, the step and momentums of each fused parameter
   InlinedVector<std::string> user_input_names, param_input_names, grad_input_names, reset_grad_name;
 
+  InlinedHashSet<std::string> fused_update_input_names;
+  InlinedVector<std::string> ordered_fused_update_input_names;
+  if (fused_optimizer_step_) {
+    ordered_fused_update_input_names.push_back(FUSED_UPDATE_LEARNING_RATE_INPUT_NAME);
+    for (const auto& param_name : fused_update_param_names_) {
+      if (fused_update_has_step_) {
+        ordered_fused_update_input_names.push_back(FusedUpdateInputName(param_name, "step"));
+      }
+      for (const auto& momentum_key : fused_update_momentum_keys_) {
+        ordered_fused_update_input_names.push_back(FusedUpdateInputName(param_name, momentum_key));
+      }
+    }
+    fused_update_input_names.insert(ordered_fused_update_input_names.begin(), ordered_fused_update_input_names.end());
+  }
+
   std::unordered_map<std::string, size_t> param_name_to_grad_input_index_map;
   for (const auto& input_name : train_input_names) {
     auto it = state_->module_checkpoint_state.named_parameters.find(input_name);
-    if (it != state_->module_checkpoint_state.named_parameters.end()) {
+    if (fused_update_input_names.count(input_name) > 0) {
+      continue;
+    } else if (it != state_->module_checkpoint_state.named_parameters.end()) {
       param_input_names.emplace_back(input_name);
     } else if (input_name == ACCUMULATE_GRAD_CONTROL_INPUT_NAME) {
       reset_grad_name.emplace_back(input_name);
@@ -273,6 +541,8 @@ Module::Module(const ModelIdentifiers& model_identifiers,
   train_input_names_.insert(train_input_names_.end(), param_input_names.begin(), param_input_names.end());
   train_input_names_.insert(train_input_names_.end(), grad_input_names.begin(), grad_input_names.end());
   train_input_names_.insert(train_input_names_.end(), reset_grad_name.begin(), reset_grad_name.end());
+  train_input_names_.insert(train_input_names_.end(), ordered_fused_update_input_names.begin(),
+                            ordered_fused_update_input_names.end());
 
   for (const auto& output_name : train_output_names) {
     if (std::string param_name; !utils::GetParamNameFromGradient(output_name, param_name)) {
@@ -317,8 +587,10 @@ Module::Module(const ModelIdentifiers& model_identifiers,
     weights_.push_back(param_data);
     weight_names_.push_back(param_name);
 
-    // Create gradient buffer when parameter requires gradient.
-    if (params_iter->second->RequiresGrad()) {
+    // Create gradient buffer when parameter requires gradient, unless it is updated in the training graph.
+    if (params_iter->second->RequiresGrad() &&
+        std::find(fused_update_param_names_.begin(), fused_update_param_names_.end(), param_name) ==
+            fused_update_param_names_.end()) {
       // Create gradient accumulation buffer.
       auto it = param_name_to_grad_input_index_map.find(param_name);
       ORT_ENFORCE(it != param_name_to_grad_input_index_map.end(), "Gradient buffer input not provided for param: ",
@@ -529,11 +801,15 @@ Status Module::LazyResetGrad() {
 Status Module::TrainStep(const std::vector<OrtValue>& inputs, std::vector<OrtValue>& outputs) {
   std::vector<OrtValue> feeds{inputs};
   feeds.insert(feeds.end(), weights_.begin(), weights_.end());
-  feeds.insert(feeds.end(), gradients_.begin(), gradients_.end());
-  // TODO: consider maintaining this as ortvalue instead of bool
-  OrtValue reset_grad_input;
-  utils::WrapInOrtValue<bool>(!accumulate_gradient_, &reset_grad_input);
-  feeds.push_back(reset_grad_input);
+  if (fused_optimizer_step_) {
+    ORT_RETURN_IF_ERROR(AddFusedUpdateFeeds(feeds));
+  } else {
+    feeds.insert(feeds.end(), gradients_.begin(), gradients_.end());
+    // TODO: consider maintaining this as ortvalue instead of bool
+    OrtValue reset_grad_input;
+    utils::WrapInOrtValue<bool>(!accumulate_gradient_, &reset_grad_input);
+    feeds.push_back(reset_grad_input);
+  }
 
   ORT_THROW_IF_ERROR(train_sess_->Run(RunOptions(), train_input_names_, feeds, train_output_names_, &outputs));
 
@@ -545,6 +821,34 @@ Status Module::TrainStep(const std::vector<OrtValue>& inputs, std::vector<OrtVal
   return Status::OK();
 }
 
+Status Module::AddFusedUpdateFeeds(std::vector<OrtValue>& feeds) const {
+  const auto& group_states = state_->optimizer_checkpoint_state.group_named_optimizer_states;
+  const auto group_state_it = group_states.find(GROUP_ZERO_NAME);
+  ORT_RETURN_IF(group_state_it == group_states.end(),
+                "The Optimizer must be created before a train step with the fused optimizer step.");
+  const GroupOptimizerState& group_state = *group_state_it->second;
+
+  OrtValue learning_rate_input;
+  utils::WrapInOrtValue<float>(group_state.learning_rate, &learning_rate_input);
+  feeds.push_back(learning_rate_input);
+  for (const auto& param_name : fused_update_param_names_) {
+    if (fused_update_has_step_) {
+      // A step for each parameter, as the update increments it in place. As in Optimizer::Step, the bias correction
+      // uses the step count + 1.
+      OrtValue step_input;
+      utils::WrapInOrtValue<int64_t>(group_state.step + 1, &step_input);
+      feeds.push_back(step_input);
+    }
+    const auto param_state_it = group_state.param_named_optimizer_states.find(param_name);
+    ORT_RETURN_IF(param_state_it == group_state.param_named_optimizer_states.end(),
+                  "No optimizer state for parameter ", param_name, ".");
+    for (const auto& momentum_key : fused_update_momentum_keys_) {
+      feeds.push_back(param_state_it->second.at(momentum_key));
+    }
+  }
+  return Status::OK();
+}
+
 Status Module::EvalStep(const std::vector<OrtValue>& inputs, std::vector<OrtValue>& outputs) {
   ORT_ENFORCE(nullptr != eval_sess_, "Evaluation session not initialized.");
   std::vector<OrtValue> feeds{inputs};
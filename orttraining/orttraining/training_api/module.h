@@ -11,6 +11,10 @@ namespace onnxruntime {
 namespace training {
 namespace api {
 
+// Session config to set to "1" on the Module and the Optimizer to run the update of each parameter in the training
+// graph right after its gradient is computed, see Module.
+constexpr char FUSED_OPTIMIZER_STEP_CONFIG[] = "training.fused_optimizer_step";
+
 struct Parameter {
  public:
   Parameter(const std::string& name, const OrtValue& data, const bool requires_grad)
@@ -71,6 +75,14 @@ struct CheckpointState;
  *
  * Currently, we only support load checkpoints from the constructor;
  * no public API to load state dict after Module instance is created.
+ *
+ * With the session config FUSED_OPTIMIZER_STEP_CONFIG, the optimizer step is fused into the backward of the
+ * training model: each trainable parameter is updated by the algorithm of the optimizer model in the training graph
+ * once its gradient is computed and the last node reading the parameter has run, and the gradient is freed right
+ * after. No gradient buffer is allocated, so the gradients of all the parameters never exist at the same time. The
+ * learning rate, step and optimizer states are those of the Optimizer, which must be created before the first
+ * TrainStep, and whose Step then only counts the step. Gradients can't be accumulated over several TrainSteps
+ * in this mode, and it needs the ONNX training and optimizer models of a non minimal build.
  */
 struct Module {
  public:
@@ -149,6 +161,9 @@ struct Module {
   std::pair<common::Status, const InputDefList*> GetEvalModelInputs() const noexcept;
 
  private:
+  // Adds the learning rate, step and momentums of the parameters updated by the fused optimizer step to feeds.
+  Status AddFusedUpdateFeeds(std::vector<OrtValue>& feeds) const;
+
   std::unique_ptr<onnxruntime::InferenceSession> train_sess_{nullptr};
   std::unique_ptr<onnxruntime::InferenceSession> eval_sess_{nullptr};
 
@@ -164,6 +179,13 @@ struct Module {
   CheckpointState* state_;  // Non owning pointer to the state.
 
   bool accumulate_gradient_ = false;
+
+  // The trainable parameters updated in the training graph with the fused optimizer step, in the order of their
+  // states in train_input_names_ after the learning rate.
+  bool fused_optimizer_step_ = false;
+  InlinedVector<std::string> fused_update_param_names_;
+  bool fused_update_has_step_ = false;
+  InlinedVector<std::string> fused_update_momentum_keys_;
   std::optional<std::string> eval_model_path_;
   size_t train_user_input_count_{0U};
   size_t eval_user_input_count_{0U};
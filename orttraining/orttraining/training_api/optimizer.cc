@@ -2,6 +2,11 @@
 // Licensed under the MIT License.
 
 #include "orttraining/training_api/optimizer.h"
+
+#include <algorithm>
+#include <charconv>
+
+#include "core/common/string_utils.h"
 #include "core/flatbuffers/flatbuffers_utils.h"
 #include "core/framework/execution_provider.h"
 #include "core/framework/TensorSeq.h"
@@ -19,6 +24,7 @@ namespace api {
 namespace {
 
 constexpr char GROUP_ZERO_NAME[] = "group0";
+constexpr char OPTIMIZER_STATE_SHARD_CONFIG[] = "training.optimizer_state_shard";
 static constexpr std::array CommonOptimizerInputs{"learning_rate", "step", "params", "gradients"};
 
 Status GraphInputsAreExpected(gsl::span<std::string> actual_graph_inputs,
@@ -58,6 +64,25 @@ Status GraphInputsAreExpected(gsl::span<std::string> actual_graph_inputs,
   return Status::OK();
 }
 
+// Parses "<rank>:<world size>".
+Status ParseShardConfig(const std::string& shard_config, int& rank, int& world_size) {
+  rank = 0;
+  world_size = 1;
+  if (shard_config.empty()) {
+    return Status::OK();
+  }
+
+  const auto values = onnxruntime::utils::SplitString(shard_config, ":");
+  ORT_RETURN_IF_NOT(values.size() == 2, "The optimizer state shard config should be <rank>:<world size>, got: ",
+                    shard_config);
+  const auto rank_result = std::from_chars(values[0].data(), values[0].data() + values[0].size(), rank);
+  const auto world_size_result = std::from_chars(values[1].data(), values[1].data() + values[1].size(), world_size);
+  ORT_RETURN_IF_NOT(rank_result.ec == std::errc() && world_size_result.ec == std::errc() && world_size > 0 &&
+                        rank >= 0 && rank < world_size,
+                    "Invalid optimizer state shard config: ", shard_config);
+  return Status::OK();
+}
+
 }  // namespace
 
 std::unique_ptr<OptimizerAlgorithmBase> OptimizerAlorithmFactory::CreateInstance(
@@ -152,7 +177,7 @@ Status Optimizer::GenerateMomentumNamedStates(OptimizerCheckpointState& optimize
   auto& param_named_optimizer_states = optimizer_state_->param_named_optimizer_states;
   auto& optim_sess_state = optim_sess_->GetSessionState();
   for (auto& pair : state_->module_checkpoint_state.named_parameters) {
-    if (pair.second->RequiresGrad()) {
+    if (shard_parameter_names_.count(pair.first) > 0) {
       param_named_optimizer_states.insert({pair.first, ParameterOptimizerState()});
       ParameterOptimizerState& cur_param_optimizer_states = param_named_optimizer_states[pair.first];
       for (auto& state_name : optimizer_algo_ptr_->momentum_keys) {
@@ -171,6 +196,11 @@ Status Optimizer::GenerateMomentumNamedStates(OptimizerCheckpointState& optimize
 Status Optimizer::ConstructInputs() {
   inputs_.clear();
 
+  // The parameters are updated by the train step of the Module, which has no gradient buffers.
+  if (fused_optimizer_step_) {
+    return Status::OK();
+  }
+
   auto& param_named_optimizer_states = optimizer_state_->param_named_optimizer_states;
 
   InlinedVector<Tensor> params, grads;
@@ -179,7 +209,7 @@ Status Optimizer::ConstructInputs() {
 
   // Collect all the non-user-defined inputs from the named_parameters_.
   for (auto& [parameter_name, parameter] : state_->module_checkpoint_state.named_parameters) {
-    if (parameter->RequiresGrad()) {
+    if (shard_parameter_names_.count(parameter_name) > 0) {
       // Collect parameters and prepare for tensorseq creation
       auto* param_tensor = parameter->Data().GetMutable<Tensor>();
       params.emplace_back(
@@ -205,6 +235,11 @@ Status Optimizer::ConstructInputs() {
     }
   }
 
+  // A rank of a sharded optimizer may own no parameter, it has nothing to update then.
+  if (params.empty()) {
+    return Status::OK();
+  }
+
   const auto tensorseq_inserter = [](auto& tensors, auto* inputs) {
     ORT_ENFORCE(!tensors.empty(), "Tensors vector cannot be empty while building a tensor sequence.");
 
@@ -239,6 +274,15 @@ Optimizer::Optimizer(const ModelIdentifiers& model_identifiers,
   Initialize(model_identifiers, providers, op_domains);
 
   ORT_ENFORCE(state != nullptr, "Checkpoint state cannot be null.");
+  int shard_rank, shard_world_size;
+  ORT_THROW_IF_ERROR(ParseShardConfig(
+      session_options.config_options.GetConfigOrDefault(OPTIMIZER_STATE_SHARD_CONFIG, ""), shard_rank,
+      shard_world_size));
+  fused_optimizer_step_ = session_options.config_options.GetConfigOrDefault(FUSED_OPTIMIZER_STEP_CONFIG, "0") == "1";
+  ORT_ENFORCE(!fused_optimizer_step_ || shard_world_size == 1,
+              "The optimizer states can't be sharded with the fused optimizer step.");
+  ShardParameters(shard_rank, shard_world_size);
+
   auto g_it = state_->optimizer_checkpoint_state.group_named_optimizer_states.find(GROUP_ZERO_NAME);
   bool find_group_zero = g_it != state_->optimizer_checkpoint_state.group_named_optimizer_states.end();
   if (!find_group_zero || g_it->second->param_named_optimizer_states.empty()) {
@@ -252,6 +296,31 @@ Optimizer::Optimizer(const ModelIdentifiers& model_identifiers,
   }
 }
 
+void Optimizer::ShardParameters(int rank, int world_size) {
+  // Ordered by decreasing size then name, so that all the ranks assign the parameters in the same way.
+  std::vector<std::pair<int64_t, std::string>> sized_parameter_names;
+  for (const auto& [parameter_name, parameter] : state_->module_checkpoint_state.named_parameters) {
+    if (parameter->RequiresGrad()) {
+      sized_parameter_names.emplace_back(static_cast<int64_t>(parameter->Data().Get<Tensor>().SizeInBytes()),
+                                         parameter_name);
+    }
+  }
+  std::sort(sized_parameter_names.begin(), sized_parameter_names.end(), [](const auto& a, const auto& b) {
+    return a.first != b.first ? a.first > b.first : a.second < b.second;
+  });
+
+  // Each parameter goes to the rank with the fewest bytes so far, the lowest on ties.
+  std::vector<int64_t> rank_sizes(world_size, 0);
+  shard_parameter_names_.clear();
+  for (const auto& [size, parameter_name] : sized_parameter_names) {
+    const auto owner = static_cast<size_t>(std::min_element(rank_sizes.begin(), rank_sizes.end()) - rank_sizes.begin());
+    rank_sizes[owner] += size;
+    if (owner == static_cast<size_t>(rank)) {
+      shard_parameter_names_.insert(parameter_name);
+    }
+  }
+}
+
 void Optimizer::Initialize(const ModelIdentifiers& model_identifiers,
                            const std::vector<std::shared_ptr<IExecutionProvider>>& providers,
                            [[maybe_unused]] gsl::span<OrtCustomOpDomain* const> op_domains) {
@@ -298,6 +367,12 @@ void Optimizer::Initialize(const ModelIdentifiers& model_identifiers,
 }
 
 Status Optimizer::Step() {
+  if (inputs_.empty()) {
+    // No parameter in the shard of this rank, or the parameters were updated by the fused optimizer step.
+    optimizer_state_->step++;
+    return Status::OK();
+  }
+
   OrtValue learning_rate_input, step_input;
   utils::WrapInOrtValue<float>(optimizer_state_->learning_rate, &learning_rate_input);
   // Use step count + 1 before running optimizer step.
@@ -332,8 +407,17 @@ Status Optimizer::LoadStateDict(OptimizerCheckpointState& optimizer_checkpoint_s
   auto& optim_sess_state = optim_sess_->GetSessionState();
   auto& param_named_optimizer_states = optimizer_state_->param_named_optimizer_states;
 
+  // The states of the parameters of the other shards, e.g. from a checkpoint saved before sharding, are released.
+  for (auto it = param_named_optimizer_states.begin(); it != param_named_optimizer_states.end();) {
+    if (shard_parameter_names_.count(it->first) == 0) {
+      it = param_named_optimizer_states.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
   for (auto& params_iter : state_->module_checkpoint_state.named_parameters) {
-    if (params_iter.second->RequiresGrad()) {
+    if (shard_parameter_names_.count(params_iter.first) > 0) {
       bool src_exist = param_named_optimizer_states.find(params_iter.first) !=
                        param_named_optimizer_states.cend();
 
@@ -91,6 +91,17 @@ struct CheckpointState;
  *
  * Currently, we only support load checkpoints from the constructor;
  * no public API to load state dict after Optimizer instance is created.
+ *
+ * The optimizer states can be sharded across data-parallel ranks with the session config
+ * "training.optimizer_state_shard" set to "<rank>:<world size>". Each trainable parameter is then owned by one rank,
+ * the parameters being balanced by size across the ranks in the same way on all of them, and the optimizer of a rank
+ * only holds the states of and updates the parameters it owns. The states of the other parameters are released
+ * when loaded from a checkpoint, and a checkpoint saved by a rank has the states of its shard only. Before Step,
+ * the gradients of the owned parameters must be reduced to the rank, and after it, the owned parameters must be
+ * broadcast from the rank, see ShardParameterNames.
+ *
+ * With the session config FUSED_OPTIMIZER_STEP_CONFIG, the parameters are updated by Module::TrainStep with the
+ * learning rate, step and states of the optimizer, and Step only counts the step, see Module.
  */
 struct Optimizer {
   friend struct LRSchedulerBase;
@@ -123,6 +134,12 @@ struct Optimizer {
     return Status::OK();
   }
 
+  // The names of the parameters whose optimizer states this rank holds, all the trainable parameters unless the
+  // optimizer states are sharded.
+  const InlinedHashSet<std::string>& ShardParameterNames() const noexcept {
+    return shard_parameter_names_;
+  }
+
  private:
   void Initialize(const ModelIdentifiers& model_identifiers,
                   const std::vector<std::shared_ptr<IExecutionProvider>>& providers,
@@ -132,6 +149,9 @@ struct Optimizer {
     return optimizer_state_->step;
   }
 
+  // Assigns the trainable parameters to the ranks sharing the optimizer states and keeps those of rank.
+  void ShardParameters(int rank, int world_size);
+
   // Generates optimizer momentum states for parameters that require grad.
   Status GenerateMomentumNamedStates(OptimizerCheckpointState& optimizer_checkpoint_states);
   // Constructs the ortvalue inputs to be fed to the graph
@@ -160,6 +180,10 @@ struct Optimizer {
   InlinedVector<OrtValue> inputs_;
 
   int32_t group_count_{0};
+
+  InlinedHashSet<std::string> shard_parameter_names_;
+
+  bool fused_optimizer_step_{false};
 };
 
 }  // namespace api
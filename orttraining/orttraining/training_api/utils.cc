@@ -16,7 +16,8 @@ namespace api {
 namespace utils {
 
 // TODO: consolidate the gradient names with frontend tooling
-const std::vector<std::string> GRAD_SUFFIX{"_grad.accumulation.buffer", "_grad", "_grad.accumulation.out"};
+const std::vector<std::string> GRAD_SUFFIX{"_grad.accumulation.buffer", "_grad", "_grad.accumulation.out",
+                                           "_grad.update.out"};
 
 void GetGraphInputOutputNames(const std::unique_ptr<onnxruntime::InferenceSession>& session_object,
                               InlinedVector<std::string>& input_names,
@@ -6,6 +6,7 @@
 #include "core/providers/cpu/math/element_wise_ops.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/cpu/reduction/reduction_ops.h"
+#include "orttraining/training_ops/cpu/optimizer/common.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -15,25 +16,40 @@ namespace {
 constexpr float Epsilon = 0.000001f;
 
 template <typename T>
-T GetL2Norm(const TensorSeq& gradients) {
+T GetL2Norm(concurrency::ThreadPool* tp, gsl::span<T* const> gradients, gsl::span<const TensorChunk> chunks) {
+  // the sums of the chunks are added in order, so that the norm doesn't depend on the scheduling of the chunks
+  std::vector<T> chunk_sums(chunks.size());
+  static constexpr double cost_per_element = 2.0;
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(chunks.size()), cost_per_element * kMultiTensorChunkSize,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          const TensorChunk& chunk = chunks[i];
+          chunk_sums[i] =
+              ConstEigenVectorArrayMap<T>(gradients[chunk.tensor_index] + chunk.offset, chunk.size).square().sum();
+        }
+      });
+
   T l2_norm = 0;
-  for (const auto& tensor : gradients) {
-    l2_norm +=
-        ReduceAggregatorSumSquare<T>(tensor.Get<Tensor>().Shape().Size(), *tensor.Get<Tensor>().Data<T>()).aggall(tensor.Get<Tensor>().Data<T>());
+  for (const T sum : chunk_sums) {
+    l2_norm += sum;
   }
   return reduce_sqrt<T>(l2_norm);
 }
 
 template <typename T>
-void ClipGradNorm(T total_norm, T max_norm, TensorSeq& gradients) {
+void ClipGradNorm(concurrency::ThreadPool* tp, T total_norm, T max_norm, gsl::span<T* const> gradients,
+                  gsl::span<const TensorChunk> chunks) {
   const T clip_coefficient = std::min(max_norm / (total_norm + static_cast<T>(Epsilon)), static_cast<T>(1.0f));
-
-  auto gradients_size = gradients.Size();
-  for (size_t i = 0; i < gradients_size; i++) {
-    const auto& grad = gradients.Get(i);
-    auto& tensor = const_cast<Tensor&>(grad);
-    MakeEigenArrayMap<T>(tensor) *= clip_coefficient;
+  if (clip_coefficient == static_cast<T>(1.0f)) {
+    return;
   }
+
+  static constexpr double cost_per_element = 1.0;
+  MultiTensorApply(tp, chunks, cost_per_element,
+                   [&gradients, clip_coefficient](size_t i, int64_t offset, int64_t size) {
+                     EigenVectorArrayMap<T>(gradients[i] + offset, size) *= clip_coefficient;
+                   });
 }
 
 Status PopulateOutput(OpKernelContext* ctx, const TensorSeq* gradients, TensorSeq* clipped_gradients) {
@@ -75,10 +91,21 @@ template <typename T>
 Status InplaceClipGradNorm<T>::Compute(OpKernelContext* ctx) const {
   const TensorSeq* gradients = ctx->Input<TensorSeq>(0);
 
-  const T total_norm = GetL2Norm<T>(*gradients);
+  // The gradients are updated in place.
+  std::vector<T*> gradient_pointers;
+  std::vector<int> gradient_sizes;
+  gradient_pointers.reserve(gradients->Size());
+  gradient_sizes.reserve(gradients->Size());
+  for (const auto& gradient : *gradients) {
+    const Tensor& tensor = gradient.Get<Tensor>();
+    gradient_pointers.push_back(const_cast<T*>(tensor.Data<T>()));
+    gradient_sizes.push_back(static_cast<int>(tensor.Shape().Size()));
+  }
+  const std::vector<TensorChunk> chunks = MakeTensorChunks(gradient_sizes);
+  auto* tp = ctx->GetOperatorThreadPool();
 
-  auto grads = const_cast<TensorSeq*>(gradients);
-  ClipGradNorm(total_norm, max_norm_, *grads);
+  const T total_norm = GetL2Norm<T>(tp, gradient_pointers, chunks);
+  ClipGradNorm<T>(tp, total_norm, static_cast<T>(max_norm_), gradient_pointers, chunks);
 
   // Populate the output sequence tensors.
   TensorSeq* clipped_gradients = ctx->Output<TensorSeq>(0);
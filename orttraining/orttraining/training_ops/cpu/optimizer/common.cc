@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/TensorSeq.h"
@@ -10,6 +12,17 @@
 namespace onnxruntime {
 namespace contrib {
 
+std::vector<TensorChunk> MakeTensorChunks(gsl::span<const int> tensor_sizes) {
+  std::vector<TensorChunk> chunks;
+  for (size_t i = 0; i < tensor_sizes.size(); ++i) {
+    const int64_t size = tensor_sizes[i];
+    for (int64_t offset = 0; offset < size; offset += kMultiTensorChunkSize) {
+      chunks.push_back({i, offset, std::min(kMultiTensorChunkSize, size - offset)});
+    }
+  }
+  return chunks;
+}
+
 Status CopyIfNotSameCPUBuffer(OpKernelContext* ctx, size_t number_of_values,
                               const TensorSeq* src_values, TensorSeq* dest_values) {
   if (src_values != dest_values) {
@@ -4,8 +4,11 @@
 #pragma once
 
 #include "core/common/common.h"
+#include "core/common/gsl.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
 #include <cmath>
+#include <vector>
 
 namespace onnxruntime {
 namespace contrib {
@@ -19,6 +22,37 @@ TC compute_bias_correction_coefficient(const TC momentum_update_coefficient, con
   }
 }
 
+// Maximum number of elements of a chunk, so that the chunks of the few tensors an optimizer updates together
+// (e.g. weight, gradient and momentums) stay in the cache across the fused steps of the update.
+constexpr int64_t kMultiTensorChunkSize = 8192;
+
+// A range of the elements of one tensor of a group.
+struct TensorChunk {
+  size_t tensor_index;
+  int64_t offset;
+  int64_t size;
+};
+
+// Splits the tensors of a group, of the given numbers of elements, into chunks of at most kMultiTensorChunkSize
+// elements. Empty tensors have no chunk.
+std::vector<TensorChunk> MakeTensorChunks(gsl::span<const int> tensor_sizes);
+
+// CPU counterpart of the CUDA launch_multi_tensor_functor: applies fn(tensor_index, offset, size) to the chunks of
+// all the tensors of a group, in parallel on the thread pool. Parallelizing over the flattened group rather than
+// per tensor keeps the threads busy for the many small parameters of a model as for its large ones.
+template <typename TFunc>
+void MultiTensorApply(concurrency::ThreadPool* tp, gsl::span<const TensorChunk> chunks, double cost_per_element,
+                      const TFunc& fn) {
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(chunks.size()), cost_per_element * kMultiTensorChunkSize,
+      [&chunks, &fn](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          const TensorChunk& chunk = chunks[i];
+          fn(chunk.tensor_index, chunk.offset, chunk.size);
+        }
+      });
+}
+
 Status CopyIfNotSameCPUBuffer(OpKernelContext* ctx, size_t number_of_values, const TensorSeq* src_values,
                               TensorSeq* dest_values);
 
@@ -64,14 +64,17 @@ Status SGDOptimizerV2<T>::Compute(OpKernelContext* ctx) const {
   if (update_signal == nullptr || *update_signal->template Data<bool>()) {
     const float lr = *p.learning_rate->template Data<float>();
 
-    for (size_t weight_index = 0; weight_index < p.num_of_weights; ++weight_index) {
-      Tensor& weight = const_cast<Tensor&>(p.weights->Get(weight_index));
-      Tensor& gradient = const_cast<Tensor&>(p.gradients->Get(weight_index));
-
-      // new_weight = weight - lr * gradient
-      const auto& delta = -lr * MakeEigenArrayMap<T>(gradient);
-      MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) + delta;
-    }
+    const std::vector<TensorChunk> chunks = MakeTensorChunks(p.grouped_tensor_sizes);
+    static constexpr double cost_per_element = 2.0;
+    MultiTensorApply(ctx->GetOperatorThreadPool(), chunks, cost_per_element,
+                     [&p, lr](size_t i, int64_t offset, int64_t size) {
+                       EigenVectorArrayMap<T> weight(static_cast<T*>(p.grouped_tensor_pointers[i][0]) + offset, size);
+                       ConstEigenVectorArrayMap<T> gradient(
+                           static_cast<const T*>(p.grouped_tensor_pointers[i][1]) + offset, size);
+
+                       // new_weight = weight - lr * gradient
+                       weight -= lr * gradient;
+                     });
 
     *updated_flag_ptr = true;
   } else {